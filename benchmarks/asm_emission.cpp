@@ -0,0 +1,89 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Micro-benchmark of MLIR assembly emission (`Graph::emitAsm()`) for large
+// synthetic graphs: a chain of alternating pointwise ADD / RELU nodes over
+// channels-last tensors, so every node also emits its layout conversions.
+// Reports the emission throughput in nodes per second.
+
+#include <fusilli.h>
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <iostream>
+#include <string>
+
+using namespace fusilli;
+
+// Times `iter` emissions of a chain of `nodes` pointwise nodes, after a
+// warm-up, and prints the mean time and throughput.
+static ErrorObject benchmark(int64_t nodes, int64_t iter) {
+  Graph graph;
+  graph.setName(std::format("benchmark_asm_emission_{}", nodes));
+  graph.setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+  auto xT = graph.tensor(TensorAttr()
+                             .setName("x")
+                             .setDim({2, 16, 8, 8})
+                             .setStride({1024, 1, 128, 16}));
+  auto bT = graph.tensor(TensorAttr()
+                             .setName("b")
+                             .setDim({2, 16, 8, 8})
+                             .setStride({1024, 1, 128, 16}));
+  auto yT = xT;
+  for (int64_t i = 0; i < nodes; ++i) {
+    if (i % 2 == 0)
+      yT = graph.pointwise(yT, bT,
+                           PointwiseAttr()
+                               .setMode(PointwiseAttr::Mode::ADD)
+                               .setName(std::format("add_{}", i)));
+    else
+      yT = graph.pointwise(yT, PointwiseAttr()
+                                   .setMode(PointwiseAttr::Mode::RELU_FWD)
+                                   .setName(std::format("relu_{}", i)));
+  }
+  yT->setName("y").setOutput(true);
+  FUSILLI_CHECK_ERROR(graph.validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(std::string generatedAsm, graph.emitAsm());
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < iter; ++i) {
+    FUSILLI_ASSIGN_OR_RETURN(generatedAsm, graph.emitAsm());
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  double seconds = elapsed.count() / static_cast<double>(iter);
+
+  std::printf("%8s %12s %14s %10s\n", "nodes", "ms", "nodes/s", "MB/s");
+  std::printf("%8lld %12.3f %14.0f %10.1f\n", static_cast<long long>(nodes),
+              seconds * 1e3, static_cast<double>(nodes) / seconds,
+              static_cast<double>(generatedAsm.size()) / seconds / 1e6);
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  CLI::App app{"Fusilli MLIR assembly emission micro-benchmark"};
+  int64_t nodes = 2000;
+  int64_t iter = 10;
+  app.add_option("--nodes", nodes, "Nodes in the synthetic graph")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--iter", iter, "Timed iterations")
+      ->check(CLI::PositiveNumber);
+  CLI11_PARSE(app, argc, argv);
+
+  ErrorObject status = benchmark(nodes, iter);
+  if (isError(status)) {
+    std::cerr << "Fusilli ASM emission benchmark failed: " << status
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,105 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Micro-benchmark of the execution latency of small pointwise graphs on CPU
+// handles executing on the `local-task` executor (the default) and inline on
+// the calling thread (`CpuOptions::inlineExecution`, `local-sync`), to pick
+// the execution mode per graph size.
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+// Returns the mean latency in microseconds of `iter` executions of an
+// elementwise add of two `elements` f32 tensors on `handle`, after a warm-up.
+static ErrorOr<double> timeAdd(const Handle &handle, const char *mode,
+                               int64_t elements, int64_t iter) {
+  Graph graph;
+  graph.setName(std::format("benchmark_cpu_{}_add_{}", mode, elements));
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto aT = graph.tensor(
+      TensorAttr().setName("a").setDim({elements}).setStride({1}));
+  auto bT = graph.tensor(
+      TensorAttr().setName("b").setDim({elements}).setStride({1}));
+  auto resultT = graph.pointwise(
+      aT, bT, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD).setName("add"));
+  resultT->setName("result").setOutput(true);
+  FUSILLI_CHECK_ERROR(graph.validate());
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/true));
+
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto aBuf, allocateBufferOfType(handle, aT, DataType::Float, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto bBuf, allocateBufferOfType(handle, bT, DataType::Float, 2.0f));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto resultBuf,
+      allocateBufferOfType(handle, resultT, DataType::Float, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {{aT, aBuf}, {bT, bBuf}, {resultT, resultBuf}};
+  FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_ASSIGN_OR_RETURN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+  FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < iter; ++i)
+    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return ok(elapsed.count() / static_cast<double>(iter));
+}
+
+static ErrorObject benchmark(const std::vector<int64_t> &sizes,
+                             int64_t iter) {
+  FUSILLI_ASSIGN_OR_RETURN(Handle taskHandle, Handle::create(Backend::CPU));
+  FUSILLI_ASSIGN_OR_RETURN(
+      Handle inlineHandle,
+      Handle::create(Backend::CPU, CpuOptions{.inlineExecution = true}));
+
+  std::printf("%12s %14s %14s\n", "elements", "local-task us", "inline us");
+  for (int64_t elements : sizes) {
+    FUSILLI_ASSIGN_OR_RETURN(double taskUs,
+                             timeAdd(taskHandle, "task", elements, iter));
+    FUSILLI_ASSIGN_OR_RETURN(double inlineUs,
+                             timeAdd(inlineHandle, "inline", elements, iter));
+    std::printf("%12lld %14.2f %14.2f\n", static_cast<long long>(elements),
+                taskUs, inlineUs);
+  }
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  CLI::App app{"Fusilli CPU inline execution micro-benchmark"};
+  std::vector<int64_t> sizes = {64, 1024, 16384, 262144, 4194304};
+  int64_t iter = 100;
+  app.add_option("--sizes", sizes, "Elements of the added tensors")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--iter", iter, "Timed iterations")
+      ->check(CLI::PositiveNumber);
+  CLI11_PARSE(app, argc, argv);
+
+  ErrorObject status = benchmark(sizes, iter);
+  if (isError(status)) {
+    std::cerr << "Fusilli CPU inline execution benchmark failed: " << status
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
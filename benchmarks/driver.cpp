@@ -7,19 +7,37 @@
 #include <fusilli.h>
 
 #include "utils.h"
+#if defined(FUSILLI_BENCHMARK_REFERENCE)
+#include "reference.h"
+#endif
 
 #include <CLI/CLI.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <exception>
 #include <format>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -39,6 +57,14 @@ const auto kIsPositiveDouble = CLI::Range(std::numeric_limits<double>::min(),
 const auto kIsValidLayout =
     CLI::IsMember({"NC", "NCH", "NHC", "NCHW", "NHWC", "NCDHW", "NDHWC"});
 const auto kIsValidDataType = CLI::IsMember({"f32", "f16", "bf16"});
+// Matmul operands may also be quantized, see `benchmarkQuantizedMatmul()`.
+const auto kIsValidMatmulDataType =
+    CLI::IsMember({"f32", "f16", "bf16", "si4", "si8", "f8E4M3FN", "f8E5M2",
+                   "f8E4M3FNUZ", "f8E5M2FNUZ"});
+const auto kIsValidConvLowering =
+    CLI::IsMember({"auto", "direct", "winograd", "im2col"});
+const auto kIsValidActivation =
+    CLI::IsMember({"relu", "sigmoid", "tanh", "gelu", "gelu_tanh", "silu"});
 
 //===---------------------------------------------------------------------===//
 // Option classes for organizing benchmark parameters
@@ -49,6 +75,8 @@ struct ConvOptions {
   int64_t t, u, v, o, p, q, m, l, j, s;
   int64_t mode;
   std::string imageLayout, filterLayout, outputLayout;
+  // Lowering hint of a forward conv, see `ConvFPropAttr::setLoweringHint()`.
+  std::string lowering{"auto"};
   bool fp16{false};
   bool bf16{false};
   bool bias{false};
@@ -71,6 +99,14 @@ struct SdpaOptions {
   bool isCausal{false};
   bool enableGqa{false};
   bool hasAttnMask{false};
+  int64_t blockSize{0};
+  int64_t numPages{0};
+  // Head dimension of V and O; 0 uses `headDim`.
+  int64_t headDimV{0};
+  bool varlen{false};
+  bool dropoutRng{false};
+  bool rope{false};
+  bool stats{false};
 };
 
 struct MatmulOptions {
@@ -79,9 +115,103 @@ struct MatmulOptions {
   std::string b_type;
   std::string out_type;
   std::string bias_type;
+  std::string activation;
+  // Gate activation of a gated (GLU) matmul, where B packs the gate and up
+  // projections [K, 2N] and the result is N wide.
+  std::string gate;
+  float alpha{1.0f};
+  float beta{1.0f};
   bool transA{false};
   bool transB{false};
   bool bias{false};
+  bool residual{false};
+  // Runtime M sizes to compare a graph compiled with a dynamic M against
+  // static ones at, none for a static benchmark.
+  std::vector<int64_t> dynamicM;
+  // Rows (along K) of an int4 B sharing a scale, 0 for K.
+  int64_t groupSize{0};
+  // Slices of K computed in parallel, see `MatmulAttr::setSplitK()`.
+  int64_t splitK{1};
+};
+
+struct GroupedMatmulOptions {
+  int64_t e, m, n, k;
+  std::string type;
+  int64_t groupSize{0};
+};
+
+struct PointwiseOptions {
+  std::string input;
+  std::string type;
+  std::string layout;
+  std::string mode;
+};
+
+struct ReductionOptions {
+  std::string input;
+  std::string outputDims;
+  std::string type;
+  std::string layout;
+  std::string mode;
+};
+
+struct RmsNormOptions {
+  std::string input;
+  std::string type;
+  std::string layout;
+  int64_t forw;
+  float eps;
+  bool scale{false};
+};
+
+struct BatchNormOptions {
+  std::string input;
+  std::string type;
+  std::string layout;
+  int64_t forw;
+  float eps;
+  float momentum;
+  bool scaleBias{false};
+  bool relu{false};
+};
+
+// Pre-norm transformer attention block over `seq` tokens of `heads *
+// headDim` features per batch.
+struct AttentionBlockOptions {
+  int64_t batch, seq, heads, headDim;
+  std::string type;
+  float eps;
+  bool isCausal{false};
+};
+
+// ResNet basic block of `c` channels.
+struct ResNetBlockOptions {
+  int64_t n, c, h, w;
+  std::string type;
+  std::string layout;
+  float eps;
+};
+
+// Execution capture (see `ExecutionCapture`) to replay.
+struct ReplayOptions {
+  std::string capture;
+};
+
+struct RunOptions {
+  int64_t iter;
+  int64_t warmup{0};
+  // Repetitions of the compile latency measurement, none for 0.
+  int64_t measureCompile{0};
+  // Overwrite a scratch buffer larger than the caches before every timed
+  // iteration.
+  bool flushL2{false};
+  // Sets of input and output buffers the iterations cycle through.
+  int64_t rotateBuffers{1};
+  // Read back the graph output for comparison with a reference library, see
+  // `addReference()`.
+  bool reference{false};
+  // Compile with `CompileOptions::cpuPerformance()` on the CPU backend.
+  bool cpuPerformance{false};
 };
 
 //===---------------------------------------------------------------------===//
@@ -90,12 +220,77 @@ struct MatmulOptions {
 
 static std::pair<std::vector<int64_t>, std::vector<int64_t>>
 getBiasDimsAndStride(int64_t spatialDim, int64_t k) {
-  auto biasDims = (spatialDim == 2) ? std::vector<int64_t>{1, k, 1, 1}
-                                    : std::vector<int64_t>{1, k, 1, 1, 1};
+  auto biasDims =
+      std::vector<int64_t>(static_cast<size_t>(spatialDim) + 2, 1);
+  biasDims[1] = k;
   auto biasStride = std::vector<int64_t>(biasDims.size(), 1);
   return {std::move(biasDims), std::move(biasStride)};
 }
 
+// Maps a `--conv_lowering` value to its lowering hint.
+static ConvFPropAttr::LoweringHint
+getConvLoweringHint(const std::string &lowering) {
+  using LoweringHint = ConvFPropAttr::LoweringHint;
+  if (lowering == "direct")
+    return LoweringHint::DIRECT;
+  if (lowering == "winograd")
+    return LoweringHint::WINOGRAD;
+  if (lowering == "im2col")
+    return LoweringHint::IM2COL;
+  return LoweringHint::AUTO;
+}
+
+// Applies the compile options selected by `run` to `graph`, before compiling
+// it for `handle`.
+static void applyRunCompileOptions(Graph &graph, const RunOptions &run,
+                                   const Handle &handle) {
+  if (run.cpuPerformance && handle.getBackend() == Backend::CPU)
+    graph.setCompileOptions(
+        CompileOptions::cpuPerformance(graph.getCompileOptions()));
+}
+
+// Appends the depth `d`, height `h` and width `w` values of a conv option to
+// `dims`, as far as the `--spatial_dim` of the conv has them. A 1D conv only
+// has a width, like a 2D conv with a unit height.
+static std::vector<int64_t> appendConvSpatialDims(const ConvOptions &opts,
+                                                  std::vector<int64_t> dims,
+                                                  int64_t d, int64_t h,
+                                                  int64_t w) {
+  if (opts.s == 3)
+    dims.push_back(d);
+  if (opts.s >= 2)
+    dims.push_back(h);
+  dims.push_back(w);
+  return dims;
+}
+
+static PointwiseAttr::Mode getActivationMode(const std::string &activation) {
+  static const std::unordered_map<std::string, PointwiseAttr::Mode> kModes = {
+      {"relu", PointwiseAttr::Mode::RELU_FWD},
+      {"sigmoid", PointwiseAttr::Mode::SIGMOID_FWD},
+      {"tanh", PointwiseAttr::Mode::TANH_FWD},
+      {"gelu", PointwiseAttr::Mode::GELU_FWD},
+      {"gelu_tanh", PointwiseAttr::Mode::GELU_APPROX_TANH_FWD},
+      {"silu", PointwiseAttr::Mode::SWISH_FWD},
+  };
+  return kModes.at(activation);
+}
+
+// Looks up the mode named `name` in `modeToStr`, case-insensitively (the CLI
+// takes lowercase names, e.g. "relu_fwd" for `PointwiseAttr::Mode::RELU_FWD`).
+template <typename Mode>
+static ErrorOr<Mode>
+getModeFromName(const std::unordered_map<Mode, std::string> &modeToStr,
+                const std::string &name) {
+  for (const auto &[mode, str] : modeToStr)
+    if (std::ranges::equal(str, name, [](char a, char b) {
+          return std::tolower(static_cast<unsigned char>(a)) ==
+                 std::tolower(static_cast<unsigned char>(b));
+        }))
+      return ok(mode);
+  return error(ErrorCode::InvalidArgument, "Unknown mode: " + name);
+}
+
 static std::vector<int64_t>
 parseDimensionsFromString(const std::string &dimStr) {
   std::vector<int64_t> dims;
@@ -109,44 +304,485 @@ parseDimensionsFromString(const std::string &dimStr) {
   return dims;
 }
 
-//===---------------------------------------------------------------------===//
-// Benchmark functions
-//===---------------------------------------------------------------------===//
+// Peak throughput of a device: dense (no sparsity) matrix TFLOP/s in 16-bit
+// and 32-bit floating point, and memory bandwidth in GB/s.
+struct DevicePeak {
+  double tflopsF16;
+  double tflopsF32;
+  double memoryGBs;
+};
+
+// Returns the spec sheet peaks of the IREE ROCm SKU target `target` (see
+// `getIreeRocmTargetForAmdgpu()`), if known. Architecture targets (e.g.
+// `gfx942`) are shared by SKUs with different peaks, so have none.
+static std::optional<DevicePeak> getDevicePeak(const std::string &target) {
+  static const std::unordered_map<std::string, DevicePeak> kPeaks = {
+      // CDNA4
+      {"mi355x", {2516.6, 157.3, 8000.0}},
+      {"mi350x", {2306.9, 144.2, 8000.0}},
+      // CDNA3
+      {"mi325x", {1307.4, 163.4, 6000.0}},
+      {"mi300x", {1307.4, 163.4, 5300.0}},
+      {"mi300a", {980.6, 122.6, 5300.0}},
+      // CDNA2
+      {"mi250x", {383.0, 95.7, 3276.8}},
+      {"mi250", {362.1, 90.5, 3276.8}},
+      {"mi210", {181.0, 45.3, 1638.4}},
+      // CDNA1
+      {"mi100", {184.6, 46.1, 1228.8}},
+      // RDNA3
+      {"w7900", {122.6, 61.3, 864.0}},
+      {"rx7900xtx", {122.8, 61.4, 960.0}},
+  };
+  auto it = kPeaks.find(target);
+  if (it == kPeaks.end())
+    return std::nullopt;
+  return it->second;
+}
+
+// Backend benchmarks run on unless `--backend` is given.
+#if defined(FUSILLI_ENABLE_AMDGPU)
+constexpr Backend kDefaultBackend = Backend::AMDGPU;
+#else
+constexpr Backend kDefaultBackend = Backend::CPU;
+#endif
 
-static ErrorObject benchmarkConvFprop(const ConvOptions &opts,
-                                      DataType convIOType, int64_t iter,
-                                      int64_t deviceId, bool dump) {
+// Creates the handle benchmarks execute on. AMDGPU handles own a HIP stream
+// so that `Graph::executeTimed()` can record its events on it; the stream is
+// intentionally never destroyed, it lives until the process exits. CPU
+// handles run `cpuThreads` worker threads (all physical cores for 0), and
+// ignore `deviceId`.
+static ErrorOr<Handle> createBenchmarkHandle(Backend backend, int64_t deviceId,
+                                             uint32_t cpuThreads = 0) {
+  if (backend == Backend::CPU)
+    return Handle::create(Backend::CPU, CpuOptions{.threads = cpuThreads});
 #if defined(FUSILLI_ENABLE_AMDGPU)
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle,
-                           Handle::create(Backend::AMDGPU, deviceId));
+  FUSILLI_ASSIGN_OR_RETURN(const detail::HipApi *hip, detail::getHipApi());
+  FUSILLI_CHECK_ERROR(hip->check(hip->hipSetDevice(static_cast<int>(deviceId)),
+                                 "hipSetDevice"));
+  detail::HipApi::hipStream_t stream = nullptr;
+  FUSILLI_CHECK_ERROR(
+      hip->check(hip->hipStreamCreate(&stream), "hipStreamCreate"));
+  return Handle::create(Backend::AMDGPU, static_cast<int>(deviceId),
+                        reinterpret_cast<uintptr_t>(stream));
 #else
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(Backend::CPU));
+  (void)deviceId;
+  return error(ErrorCode::InvalidArgument,
+               "The AMDGPU backend is not enabled in this build");
+#endif
+}
+
+// Statistics of a set of timing samples, in milliseconds.
+struct TimingStatistics {
+  double min, median, p90, p99, mean, stddev;
+};
+
+// Wall times of the phases of bringing up a graph from scratch, see
+// `measureCompileLatency()`.
+struct CompileLatency {
+  TimingStatistics validate, emitAsm, compileMiss, compileHit, load;
+};
+
+// Run of the same configuration through a reference library, see
+// `addReference()`.
+struct ReferenceComparison {
+  std::string library;
+  double medianMs;
+  double speedup;    // Reference median over the Fusilli median.
+  double maxAbsDiff; // Largest elementwise difference of the outputs.
+};
+
+// Measurements of a benchmark: timings of its measured executions and
+// properties of its compiled graph.
+struct BenchmarkResult {
+  int64_t iter;
+  TimingStatistics device; // Host time on CPU, see `ExecutionTiming`.
+  TimingStatistics launch; // Time `executeTimed()` takes to return.
+  double compileMs;        // Wall time of `Graph::compile()`.
+  bool cacheHit;
+  std::optional<uint64_t> dispatchCount; // See `CompileStatistics`.
+  size_t workspaceSize;
+  // Bytes of the graph inputs and outputs, read or written once per
+  // execution, and the effective bandwidth at the median device time.
+  size_t bytes;
+  double bandwidthGBs;
+  // Achieved compute throughput, and the achieved compute and bandwidth as a
+  // percentage of the device peaks (unknown off known AMDGPU SKUs), see
+  // `addRoofline()`.
+  double tflops;
+  std::optional<double> peakFlopsPercent;
+  std::optional<double> peakBandwidthPercent;
+  // Set with `--measure-compile`, see `measureCompileLatency()`.
+  std::optional<CompileLatency> compileLatency;
+  // Peak device memory held through the handle for the graph, by category
+  // (see `MemoryStats`), and peak host resident set size of the process
+  // (unknown off Linux).
+  MemoryStats memory;
+  std::optional<size_t> hostPeakRss;
+  // Set with `--reference`: the graph output as f32 (only until it is
+  // compared) and the comparison.
+  std::vector<float> output;
+  std::optional<ReferenceComparison> reference;
+};
+
+// Returns min / median / p90 / p99 (nearest-rank) / mean / stddev of the
+// non-empty `samples`.
+static TimingStatistics computeStatistics(std::vector<double> samples) {
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&](double p) {
+    auto rank = static_cast<size_t>(
+        std::ceil(p / 100.0 * static_cast<double>(samples.size())));
+    return samples[std::max<size_t>(rank, 1) - 1];
+  };
+  double mean = 0.0;
+  for (double sample : samples)
+    mean += sample;
+  mean /= static_cast<double>(samples.size());
+  double variance = 0.0;
+  for (double sample : samples)
+    variance += (sample - mean) * (sample - mean);
+  variance /= static_cast<double>(samples.size());
+  return {samples.front(), percentile(50), percentile(90),
+          percentile(99),  mean,           std::sqrt(variance)};
+}
+
+static void printStatistics(const char *label, const TimingStatistics &stats,
+                            int64_t iter) {
+  std::printf("%-12s min %10.4f  median %10.4f  p90 %10.4f  p99 %10.4f  "
+              "mean %10.4f  stddev %10.4f  (ms, %lld iters)\n",
+              label, stats.min, stats.median, stats.p90, stats.p99,
+              stats.mean, stats.stddev, static_cast<long long>(iter));
+}
+
+// Times the phases of bringing up `graph` from scratch `repetitions` times,
+// each on a fresh copy of it (see `Graph::deserialize()`): `validate()`,
+// `emitAsm()`, `compileToArtifact()` missing every cache, a second
+// `compileToArtifact()` hitting the in-process cache of the first, and
+// `loadFromArtifact()` onto `handle`. The kernel cache is disabled meanwhile,
+// so that kernels already cached on disk still miss.
+static ErrorOr<CompileLatency>
+measureCompileLatency(const Graph &graph, const Handle &handle,
+                      int64_t repetitions) {
+  FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> serialized, graph.serialize());
+
+  const char *kDisableEnv = "FUSILLI_DISABLE_KERNEL_CACHE";
+  std::optional<std::string> previous;
+  if (const char *value = std::getenv(kDisableEnv))
+    previous = value;
+  FUSILLI_RETURN_ERROR_IF(setEnv(kDisableEnv, "1") != 0,
+                          ErrorCode::RuntimeFailure,
+                          "Failed to disable the kernel cache");
+  auto restore = ScopeExit([&] {
+    if (previous)
+      setEnv(kDisableEnv, previous->c_str());
+    else
+      unsetEnv(kDisableEnv);
+  });
+
+  using Clock = std::chrono::steady_clock;
+  auto elapsedMs = [](Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - start).count();
+  };
+  std::vector<double> validateMs, emitAsmMs, missMs, hitMs, loadMs;
+  for (int64_t i = 0; i < repetitions; ++i) {
+    FUSILLI_ASSIGN_OR_RETURN(std::unique_ptr<Graph> copy,
+                             Graph::deserialize(serialized));
+    // A name of its own keeps the per-graph cache files of `graph` (e.g.
+    // dumped with `--dump`) from being overwritten and removed.
+    copy->setName(graph.getName() + "_measure_compile")
+        .setCompileOptions(graph.getCompileOptions());
+
+    auto start = Clock::now();
+    FUSILLI_CHECK_ERROR(copy->validate());
+    auto validated = Clock::now();
+    FUSILLI_CHECK_ERROR(copy->emitAsm());
+    auto emitted = Clock::now();
+    CompileReport missReport;
+    FUSILLI_CHECK_ERROR(copy->compileToArtifact(
+        handle.getBackend(), /*remove=*/true, &missReport));
+    auto missed = Clock::now();
+    CompileReport hitReport;
+    FUSILLI_ASSIGN_OR_RETURN(
+        std::vector<uint8_t> vmfbBytes,
+        copy->compileToArtifact(handle.getBackend(), /*remove=*/true,
+                                &hitReport));
+    auto hit = Clock::now();
+    FUSILLI_CHECK_ERROR(copy->loadFromArtifact(handle, std::move(vmfbBytes)));
+    auto loaded = Clock::now();
+    FUSILLI_RETURN_ERROR_IF(missReport.cacheHit || !hitReport.cacheHit,
+                            ErrorCode::RuntimeFailure,
+                            "Unexpected compile cache behavior while "
+                            "measuring compile latency");
+
+    validateMs.push_back(elapsedMs(start, validated));
+    emitAsmMs.push_back(elapsedMs(validated, emitted));
+    missMs.push_back(elapsedMs(emitted, missed));
+    hitMs.push_back(elapsedMs(missed, hit));
+    loadMs.push_back(elapsedMs(hit, loaded));
+  }
+
+  CompileLatency latency{
+      .validate = computeStatistics(std::move(validateMs)),
+      .emitAsm = computeStatistics(std::move(emitAsmMs)),
+      .compileMiss = computeStatistics(std::move(missMs)),
+      .compileHit = computeStatistics(std::move(hitMs)),
+      .load = computeStatistics(std::move(loadMs)),
+  };
+  printStatistics("validate", latency.validate, repetitions);
+  printStatistics("emit asm", latency.emitAsm, repetitions);
+  printStatistics("compile miss", latency.compileMiss, repetitions);
+  printStatistics("compile hit", latency.compileHit, repetitions);
+  printStatistics("load", latency.load, repetitions);
+  return ok(latency);
+}
+
+// Resets the peak resident set size of the process (`VmHWM`), so
+// `getHostPeakRss()` measures the work that follows. Linux only.
+static void resetHostPeakRss() {
+#if defined(__linux__)
+  std::ofstream("/proc/self/clear_refs") << "5";
+#endif
+}
+
+// Returns the peak resident set size of the process in bytes, unknown off
+// Linux.
+static std::optional<size_t> getHostPeakRss() {
+#if defined(__linux__)
+  std::ifstream status("/proc/self/status");
+  for (std::string line; std::getline(status, line);)
+    if (line.starts_with("VmHWM:"))
+      return std::stoull(line.substr(6)) * 1024; // Reported in kB.
 #endif
+  return std::nullopt;
+}
+
+// Size of the scratch buffer overwritten before every timed iteration with
+// `--flush-l2`: twice the largest last level cache of the supported GPUs (the
+// 256 MiB Infinity Cache of MI300X), so none of the previous iteration's data
+// stays cached.
+constexpr size_t kFlushBytes = size_t{512} * 1024 * 1024;
+
+// Overwrites `scratch` on the device of `handle` and waits for it, evicting
+// the data of earlier executions from the caches.
+static ErrorObject flushCaches(const Handle &handle, const Buffer &scratch) {
+  FUSILLI_ASSIGN_OR_RETURN(Fence fence, Fence::create(handle));
+  iree_hal_buffer_t *target = iree_hal_buffer_view_buffer(scratch);
+  uint32_t pattern = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_device_queue_fill(
+      handle, IREE_HAL_QUEUE_AFFINITY_ANY, iree_hal_semaphore_list_empty(),
+      fence.getSemaphoreList(), target, /*target_offset=*/0,
+      iree_hal_buffer_byte_length(target), &pattern, sizeof(pattern),
+      IREE_HAL_FILL_FLAG_NONE));
+  return fence.wait();
+}
+
+// Returns a new buffer of `dataType` elements with the shape and contents of
+// `source`, copied on the device.
+static ErrorOr<std::shared_ptr<Buffer>>
+cloneBuffer(const Handle &handle, const Buffer &source, DataType dataType) {
+  iree_hal_buffer_view_t *view = source;
+  const iree_hal_dim_t *dims = iree_hal_buffer_view_shape_dims(view);
+  std::vector<iree_hal_dim_t> shape(
+      dims, dims + iree_hal_buffer_view_shape_rank(view));
+  FUSILLI_ASSIGN_OR_RETURN(
+      Buffer clone, Buffer::allocateUninitialized(handle, shape, dataType));
+
+  FUSILLI_ASSIGN_OR_RETURN(Fence fence, Fence::create(handle));
+  FUSILLI_CHECK_ERROR(iree_hal_device_queue_copy(
+      handle, IREE_HAL_QUEUE_AFFINITY_ANY, iree_hal_semaphore_list_empty(),
+      fence.getSemaphoreList(), iree_hal_buffer_view_buffer(view),
+      /*source_offset=*/0, iree_hal_buffer_view_buffer(clone),
+      /*target_offset=*/0, iree_hal_buffer_view_byte_length(view),
+      IREE_HAL_COPY_FLAG_NONE));
+  FUSILLI_CHECK_ERROR(fence.wait());
+  return ok(std::make_shared<Buffer>(std::move(clone)));
+}
+
+// Executes `graph` `run.warmup` times untimed, then `run.iter` times timed,
+// and prints and returns the statistics of the timed executions along with
+// the compilation `report`, dispatch count, workspace size and effective
+// bandwidth of the graph. The bandwidth counts every input and output once,
+// which is the traffic of memory-bound graphs (e.g. pointwise, reductions and
+// norms).
+//
+// With `run.rotateBuffers` > 1, the iterations cycle through that many copies
+// of the buffers of `variantPack`, and with `run.flushL2` the caches are
+// flushed before every timed iteration, so that inputs are not hot in the
+// caches as they are when one small graph is executed repeatedly.
+// Reads `buffer` of `dataType` elements back to the host as f32.
+static ErrorOr<std::vector<float>>
+readAsFloat(const Handle &handle, Buffer &buffer, DataType dataType) {
+  std::vector<float> values;
+  switch (dataType) {
+  case DataType::Float:
+    FUSILLI_CHECK_ERROR(buffer.read(handle, values));
+    return ok(std::move(values));
+  case DataType::Half: {
+    std::vector<half> raw;
+    FUSILLI_CHECK_ERROR(buffer.read(handle, raw));
+    values.resize(raw.size());
+    convert(std::span<const half>(raw), std::span<float>(values));
+    return ok(std::move(values));
+  }
+  case DataType::BFloat16: {
+    std::vector<bf16> raw;
+    FUSILLI_CHECK_ERROR(buffer.read(handle, raw));
+    values.resize(raw.size());
+    convert(std::span<const bf16>(raw), std::span<float>(values));
+    return ok(std::move(values));
+  }
+  default:
+    return error(ErrorCode::NotImplemented,
+                 "Reading back outputs is only supported for f32, f16 and "
+                 "bf16");
+  }
+}
+
+// Prints the timing, bandwidth, graph and memory figures of `result`.
+static void printIterations(const BenchmarkResult &result) {
+  printStatistics("device time", result.device, result.iter);
+  printStatistics("launch", result.launch, result.iter);
+  std::printf("%-12s %10.2f GB/s  (%zu bytes)\n", "bandwidth",
+              result.bandwidthGBs, result.bytes);
+  std::string dispatches =
+      result.dispatchCount ? std::to_string(*result.dispatchCount) : "N.A.";
+  std::printf("%-12s %10s dispatches  (%zu workspace bytes)\n", "graph",
+              dispatches.c_str(), result.workspaceSize);
+  const MemoryStats &memory = result.memory;
+  std::printf("%-12s %10zu peak device bytes  (buffers %zu, workspace %zu, "
+              "modules %zu)\n",
+              "memory", memory.total.peakBytes, memory.buffers.peakBytes,
+              memory.workspace.peakBytes, memory.modules.peakBytes);
+  if (result.hostPeakRss)
+    std::printf("%-12s %10zu peak host RSS bytes\n", "", *result.hostPeakRss);
+}
+
+static ErrorOr<BenchmarkResult> runIterations(
+    Graph &graph, const Handle &handle,
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>> &variantPack,
+    const std::shared_ptr<Buffer> &workspace, const RunOptions &run,
+    const CompileReport &report, std::optional<size_t> workspaceSize) {
+  // Memory peaks so far (see `runDriverCommand()`), taken before the rotated
+  // buffer copies and the flush scratch buffer are allocated: those of the
+  // graph's inputs and outputs, workspace and module.
+  MemoryStats memory = handle.getMemoryStats();
+  std::optional<size_t> hostPeakRss = getHostPeakRss();
+
+  std::vector<std::unordered_map<std::shared_ptr<TensorAttr>,
+                                 std::shared_ptr<Buffer>>>
+      variantPacks = {variantPack};
+  for (int64_t i = 1; i < run.rotateBuffers; ++i) {
+    auto &pack = variantPacks.emplace_back();
+    for (const auto &[tensor, buffer] : variantPack) {
+      FUSILLI_ASSIGN_OR_RETURN(
+          auto clone, cloneBuffer(handle, *buffer, tensor->getDataType()));
+      pack.insert({tensor, clone});
+    }
+  }
+  auto packFor = [&](int64_t i) -> const auto & {
+    return variantPacks[static_cast<size_t>(i) % variantPacks.size()];
+  };
+
+  std::shared_ptr<Buffer> scratch;
+  if (run.flushL2) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        Buffer buffer,
+        Buffer::allocateUninitialized(handle, {kFlushBytes}, DataType::Uint8));
+    scratch = std::make_shared<Buffer>(std::move(buffer));
+  }
+
+  for (int64_t i = 0; i < run.warmup; ++i)
+    FUSILLI_CHECK_ERROR(graph.execute(handle, packFor(i), workspace));
+
+  std::vector<ExecutionTiming> timings;
+  std::vector<double> launchMs;
+  timings.reserve(run.iter);
+  launchMs.reserve(run.iter);
+  for (int64_t i = 0; i < run.iter; ++i) {
+    if (scratch)
+      FUSILLI_CHECK_ERROR(flushCaches(handle, *scratch));
+    auto start = std::chrono::steady_clock::now();
+    FUSILLI_ASSIGN_OR_RETURN(
+        ExecutionTiming timing,
+        graph.executeTimed(handle, packFor(run.warmup + i), workspace));
+    std::chrono::duration<double, std::milli> launch =
+        std::chrono::steady_clock::now() - start;
+    timings.push_back(std::move(timing));
+    launchMs.push_back(launch.count());
+  }
+
+  // Read the device times after the loop, to not serialize the executions.
+  std::vector<double> deviceMs;
+  deviceMs.reserve(timings.size());
+  for (const ExecutionTiming &timing : timings) {
+    FUSILLI_ASSIGN_OR_RETURN(float ms, timing.getElapsedMilliseconds());
+    deviceMs.push_back(ms);
+  }
+
+  BenchmarkResult result{
+      .iter = run.iter,
+      .device = computeStatistics(std::move(deviceMs)),
+      .launch = computeStatistics(std::move(launchMs)),
+      .compileMs =
+          std::chrono::duration<double, std::milli>(report.total()).count(),
+      .cacheHit = report.cacheHit,
+      .dispatchCount = std::nullopt,
+      .workspaceSize = workspaceSize.value_or(0),
+      .bytes = 0,
+      .bandwidthGBs = 0.0,
+      .tflops = 0.0,
+      .peakFlopsPercent = std::nullopt,
+      .peakBandwidthPercent = std::nullopt,
+      .compileLatency = std::nullopt,
+      .memory = memory,
+      .hostPeakRss = hostPeakRss,
+      .output = {},
+      .reference = std::nullopt,
+  };
+  for (const auto &[tensor, buffer] : variantPack)
+    result.bytes += iree_hal_buffer_view_byte_length(buffer->getBufferView());
+  if (result.device.median > 0.0)
+    result.bandwidthGBs =
+        static_cast<double>(result.bytes) / (result.device.median * 1e6);
+  // Statistics are not dumped by every compiler (and compile profile), so
+  // their absence only leaves the dispatch count unknown.
+  ErrorOr<CompileStatistics> stats = graph.getCompileStatistics();
+  if (isOk(stats))
+    result.dispatchCount = stats->dispatchCount;
+  printIterations(result);
+
+  if (run.measureCompile > 0) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        CompileLatency latency,
+        measureCompileLatency(graph, handle, run.measureCompile));
+    result.compileLatency = latency;
+  }
+  return ok(result);
+}
+
+//===---------------------------------------------------------------------===//
+// Benchmark functions
+//===---------------------------------------------------------------------===//
 
+static ErrorOr<BenchmarkResult>
+benchmarkConvFprop(const ConvOptions &opts, DataType convIOType,
+                   const RunOptions &run, const Handle &handle, bool dump) {
   // Calculate filter channels
   auto fc = opts.c / opts.g;
 
-  // Build attributes based on 2D/3D conv and layouts.
-  auto xDims =
-      (opts.s == 2)
-          ? std::vector<int64_t>{opts.n, opts.c, opts.h, opts.w}
-          : std::vector<int64_t>{opts.n, opts.c, opts.d, opts.h, opts.w};
-  auto wDims = (opts.s == 2)
-                   ? std::vector<int64_t>{opts.k, fc, opts.y, opts.x}
-                   : std::vector<int64_t>{opts.k, fc, opts.z, opts.y, opts.x};
+  // Build attributes based on 1D/2D/3D conv and layouts.
+  auto xDims = appendConvSpatialDims(opts, {opts.n, opts.c}, opts.d, opts.h,
+                                     opts.w);
+  auto wDims =
+      appendConvSpatialDims(opts, {opts.k, fc}, opts.z, opts.y, opts.x);
   FUSILLI_ASSIGN_OR_RETURN(auto xStride,
                            generateStrideFromLayout(xDims, opts.imageLayout));
   FUSILLI_ASSIGN_OR_RETURN(auto wStride,
                            generateStrideFromLayout(wDims, opts.filterLayout));
-  auto convStride = (opts.s == 2)
-                        ? std::vector<int64_t>{opts.u, opts.v}
-                        : std::vector<int64_t>{opts.t, opts.u, opts.v};
-  auto convPadding = (opts.s == 2)
-                         ? std::vector<int64_t>{opts.p, opts.q}
-                         : std::vector<int64_t>{opts.o, opts.p, opts.q};
-  auto convDilation = (opts.s == 2)
-                          ? std::vector<int64_t>{opts.l, opts.j}
-                          : std::vector<int64_t>{opts.m, opts.l, opts.j};
+  auto convStride = appendConvSpatialDims(opts, {}, opts.t, opts.u, opts.v);
+  auto convPadding = appendConvSpatialDims(opts, {}, opts.o, opts.p, opts.q);
+  auto convDilation = appendConvSpatialDims(opts, {}, opts.m, opts.l, opts.j);
 
   // Build graph for the given handle (device), validate and compile it.
   Graph graph;
@@ -155,12 +791,14 @@ static ErrorObject benchmarkConvFprop(const ConvOptions &opts,
   // from polluting the same cache files leading to race conditions.
   auto graphName = std::format("benchmark_conv_fprop_n{}_c{}_d{}_h{}_w{}_g{}_k{"
                                "}_z{}_y{}_x{}_t{}_u{}_v{}_o{}"
-                               "_p{}_q{}_m{}_l{}_j{}_S{}_I{}_O{}_F{}_bias{}",
+                               "_p{}_q{}_m{}_l{}_j{}_S{}_I{}_O{}_F{}_bias{}"
+                               "_L{}",
                                opts.n, opts.c, opts.d, opts.h, opts.w, opts.g,
                                opts.k, opts.z, opts.y, opts.x, opts.t, opts.u,
                                opts.v, opts.o, opts.p, opts.q, opts.m, opts.l,
                                opts.j, opts.s, opts.imageLayout,
-                               opts.outputLayout, opts.filterLayout, opts.bias);
+                               opts.outputLayout, opts.filterLayout, opts.bias,
+                               opts.lowering);
   graph.setName(graphName);
 
   // Types on the graph are kept at fp32 but we explicitly set
@@ -187,6 +825,7 @@ static ErrorObject benchmarkConvFprop(const ConvOptions &opts,
                       .setStride(convStride)
                       .setPadding(convPadding)
                       .setDilation(convDilation)
+                      .setLoweringHint(getConvLoweringHint(opts.lowering))
                       .setName("conv_fprop");
 
   auto yT = graph.convFProp(xT, wT, convAttr);
@@ -210,7 +849,9 @@ static ErrorObject benchmarkConvFprop(const ConvOptions &opts,
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump));
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
 
   // Allocate input, weight and output buffers.
   FUSILLI_ASSIGN_OR_RETURN(auto xBuf,
@@ -239,43 +880,31 @@ static ErrorObject benchmarkConvFprop(const ConvOptions &opts,
   FUSILLI_ASSIGN_OR_RETURN(auto workspace,
                            allocateWorkspace(handle, workspaceSize));
 
-  // Execute graph a few times.
-  for (size_t i = 0; i < iter; ++i)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
-
-  return ok();
+  // Execute graph `run.warmup` + `run.iter` times.
+  FUSILLI_ASSIGN_OR_RETURN(BenchmarkResult result,
+                           runIterations(graph, handle, variantPack, workspace,
+                                         run, report, workspaceSize));
+  if (run.reference) {
+    FUSILLI_ASSIGN_OR_RETURN(result.output,
+                             readAsFloat(handle, *yBuf, convIOType));
+  }
+  return ok(std::move(result));
 }
 
-static ErrorObject benchmarkConvWGrad(const ConvOptions &opts,
-                                      DataType convIOType, int64_t iter,
-                                      int64_t deviceId, bool dump) {
-#if defined(FUSILLI_ENABLE_AMDGPU)
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle,
-                           Handle::create(Backend::AMDGPU, deviceId));
-#else
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(Backend::CPU));
-#endif
-
+static ErrorOr<BenchmarkResult>
+benchmarkConvWGrad(const ConvOptions &opts, DataType convIOType,
+                   const RunOptions &run, const Handle &handle, bool dump) {
   // Calculate filter channels
   auto fc = opts.c / opts.g;
 
-  // Build attributes based on 2D/3D conv and layouts.
-  auto xDims =
-      (opts.s == 2)
-          ? std::vector<int64_t>{opts.n, opts.c, opts.h, opts.w}
-          : std::vector<int64_t>{opts.n, opts.c, opts.d, opts.h, opts.w};
-  auto wDims = (opts.s == 2)
-                   ? std::vector<int64_t>{opts.k, fc, opts.y, opts.x}
-                   : std::vector<int64_t>{opts.k, fc, opts.z, opts.y, opts.x};
-  auto convStride = (opts.s == 2)
-                        ? std::vector<int64_t>{opts.u, opts.v}
-                        : std::vector<int64_t>{opts.t, opts.u, opts.v};
-  auto convPadding = (opts.s == 2)
-                         ? std::vector<int64_t>{opts.p, opts.q}
-                         : std::vector<int64_t>{opts.o, opts.p, opts.q};
-  auto convDilation = (opts.s == 2)
-                          ? std::vector<int64_t>{opts.l, opts.j}
-                          : std::vector<int64_t>{opts.m, opts.l, opts.j};
+  // Build attributes based on 1D/2D/3D conv and layouts.
+  auto xDims = appendConvSpatialDims(opts, {opts.n, opts.c}, opts.d, opts.h,
+                                     opts.w);
+  auto wDims =
+      appendConvSpatialDims(opts, {opts.k, fc}, opts.z, opts.y, opts.x);
+  auto convStride = appendConvSpatialDims(opts, {}, opts.t, opts.u, opts.v);
+  auto convPadding = appendConvSpatialDims(opts, {}, opts.o, opts.p, opts.q);
+  auto convDilation = appendConvSpatialDims(opts, {}, opts.m, opts.l, opts.j);
 
   // Calculate output dimensions (DY shape) using the same inference as forward
   auto dyDims = getConvInferredOutputShape(xDims, wDims, convDilation,
@@ -342,7 +971,9 @@ static ErrorObject benchmarkConvWGrad(const ConvOptions &opts,
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump));
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
 
   // Allocate buffers.
   FUSILLI_ASSIGN_OR_RETURN(auto dyBuf,
@@ -371,43 +1002,25 @@ static ErrorObject benchmarkConvWGrad(const ConvOptions &opts,
   FUSILLI_ASSIGN_OR_RETURN(auto workspace,
                            allocateWorkspace(handle, workspaceSize));
 
-  // Execute graph a few times.
-  for (size_t i = 0; i < iter; ++i)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
-
-  return ok();
+  // Execute graph `run.warmup` + `run.iter` times.
+  return runIterations(graph, handle, variantPack, workspace, run, report,
+                       workspaceSize);
 }
 
-static ErrorObject benchmarkConvDGrad(const ConvOptions &opts,
-                                      DataType convIOType, int64_t iter,
-                                      int64_t deviceId, bool dump) {
-#if defined(FUSILLI_ENABLE_AMDGPU)
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle,
-                           Handle::create(Backend::AMDGPU, deviceId));
-#else
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(Backend::CPU));
-#endif
-
+static ErrorOr<BenchmarkResult>
+benchmarkConvDGrad(const ConvOptions &opts, DataType convIOType,
+                   const RunOptions &run, const Handle &handle, bool dump) {
   // Calculate filter channels
   auto fc = opts.c / opts.g;
 
-  // Build attributes based on 2D/3D conv and layouts.
-  auto xDims =
-      (opts.s == 2)
-          ? std::vector<int64_t>{opts.n, opts.c, opts.h, opts.w}
-          : std::vector<int64_t>{opts.n, opts.c, opts.d, opts.h, opts.w};
-  auto wDims = (opts.s == 2)
-                   ? std::vector<int64_t>{opts.k, fc, opts.y, opts.x}
-                   : std::vector<int64_t>{opts.k, fc, opts.z, opts.y, opts.x};
-  auto convStride = (opts.s == 2)
-                        ? std::vector<int64_t>{opts.u, opts.v}
-                        : std::vector<int64_t>{opts.t, opts.u, opts.v};
-  auto convPadding = (opts.s == 2)
-                         ? std::vector<int64_t>{opts.p, opts.q}
-                         : std::vector<int64_t>{opts.o, opts.p, opts.q};
-  auto convDilation = (opts.s == 2)
-                          ? std::vector<int64_t>{opts.l, opts.j}
-                          : std::vector<int64_t>{opts.m, opts.l, opts.j};
+  // Build attributes based on 1D/2D/3D conv and layouts.
+  auto xDims = appendConvSpatialDims(opts, {opts.n, opts.c}, opts.d, opts.h,
+                                     opts.w);
+  auto wDims =
+      appendConvSpatialDims(opts, {opts.k, fc}, opts.z, opts.y, opts.x);
+  auto convStride = appendConvSpatialDims(opts, {}, opts.t, opts.u, opts.v);
+  auto convPadding = appendConvSpatialDims(opts, {}, opts.o, opts.p, opts.q);
+  auto convDilation = appendConvSpatialDims(opts, {}, opts.m, opts.l, opts.j);
 
   // Calculate output dimensions (DY shape) using the same inference as forward
   auto dyDims = getConvInferredOutputShape(xDims, wDims, convDilation,
@@ -474,7 +1087,9 @@ static ErrorObject benchmarkConvDGrad(const ConvOptions &opts,
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump));
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
 
   // Allocate buffers.
   FUSILLI_ASSIGN_OR_RETURN(auto dyBuf,
@@ -503,24 +1118,248 @@ static ErrorObject benchmarkConvDGrad(const ConvOptions &opts,
   FUSILLI_ASSIGN_OR_RETURN(auto workspace,
                            allocateWorkspace(handle, workspaceSize));
 
-  // Execute graph a few times.
-  for (size_t i = 0; i < iter; ++i)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
-
-  return ok();
+  // Execute graph `run.warmup` + `run.iter` times.
+  return runIterations(graph, handle, variantPack, workspace, run, report,
+                       workspaceSize);
 }
 
-static ErrorObject benchmarkLayerNormFwd(const LayerNormOptions &opts,
-                                         const std::vector<int64_t> &dims,
-                                         DataType layernormIOType, int64_t iter,
-                                         int64_t deviceId, bool dump) {
-#if defined(FUSILLI_ENABLE_AMDGPU)
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle,
-                           Handle::create(Backend::AMDGPU, deviceId));
-#else
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(Backend::CPU));
-#endif
+// Benchmarks a training step of the convolution (`-F 0`): its forward, data
+// gradient and weight gradient graphs are compiled separately, as a training
+// framework would, and executed in sequence every iteration on shared
+// buffers (the forward and weight gradient passes read one input, the
+// forward and data gradient passes one filter, and both gradient passes one
+// output gradient). The statistics are those of the whole step, followed by
+// the median of each pass and its share of the step.
+static ErrorOr<BenchmarkResult>
+benchmarkConvTrainingStep(const ConvOptions &opts, DataType convIOType,
+                          const RunOptions &run, const Handle &handle,
+                          bool dump) {
+  // Calculate filter channels
+  auto fc = opts.c / opts.g;
+
+  // Build attributes based on 1D/2D/3D conv and layouts.
+  auto xDims = appendConvSpatialDims(opts, {opts.n, opts.c}, opts.d, opts.h,
+                                     opts.w);
+  auto wDims =
+      appendConvSpatialDims(opts, {opts.k, fc}, opts.z, opts.y, opts.x);
+  auto convStride = appendConvSpatialDims(opts, {}, opts.t, opts.u, opts.v);
+  auto convPadding = appendConvSpatialDims(opts, {}, opts.o, opts.p, opts.q);
+  auto convDilation = appendConvSpatialDims(opts, {}, opts.m, opts.l, opts.j);
+  auto dyDims = getConvInferredOutputShape(xDims, wDims, convDilation,
+                                           convPadding, convStride);
+
+  FUSILLI_ASSIGN_OR_RETURN(auto xStride,
+                           generateStrideFromLayout(xDims, opts.imageLayout));
+  FUSILLI_ASSIGN_OR_RETURN(auto dyStride,
+                           generateStrideFromLayout(dyDims, opts.outputLayout));
+  FUSILLI_ASSIGN_OR_RETURN(auto wStride,
+                           generateStrideFromLayout(wDims, opts.filterLayout));
+
+  // Build the graph of each pass.
+  auto shape = std::format("n{}_c{}_d{}_h{}_w{}_g{}_k{}_z{}_y{}_x{}_t{}_u{}_"
+                           "v{}_o{}_p{}_q{}_m{}_l{}_j{}_S{}_I{}_O{}_F{}",
+                           opts.n, opts.c, opts.d, opts.h, opts.w, opts.g,
+                           opts.k, opts.z, opts.y, opts.x, opts.t, opts.u,
+                           opts.v, opts.o, opts.p, opts.q, opts.m, opts.l,
+                           opts.j, opts.s, opts.imageLayout, opts.outputLayout,
+                           opts.filterLayout);
+  Graph fprop, dgrad, wgrad;
+  for (auto [graph, pass] : {std::pair{&fprop, "fprop"},
+                             std::pair{&dgrad, "dgrad"},
+                             std::pair{&wgrad, "wgrad"}}) {
+    graph->setName(std::format("benchmark_conv_step_{}_{}", pass, shape));
+    graph->setIODataType(DataType::Float)
+        .setComputeDataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float);
+  }
+  auto tensor = [&](Graph &graph, const std::string &name,
+                    const std::vector<int64_t> &dims,
+                    const std::vector<int64_t> &stride) {
+    return graph.tensor(TensorAttr()
+                            .setName(name)
+                            .setDim(dims)
+                            .setStride(stride)
+                            .setDataType(convIOType));
+  };
+
+  auto xFT = tensor(fprop, "input", xDims, xStride);
+  auto wFT = tensor(fprop, "filter", wDims, wStride);
+  auto yT = fprop.convFProp(xFT, wFT,
+                            ConvFPropAttr()
+                                .setStride(convStride)
+                                .setPadding(convPadding)
+                                .setDilation(convDilation)
+                                .setName("conv_fprop"));
+  yT->setOutput(true).setDataType(convIOType);
+
+  auto dyDT = tensor(dgrad, "dy", dyDims, dyStride);
+  auto wDT = tensor(dgrad, "filter", wDims, wStride);
+  auto dxT = dgrad.convDGrad(dyDT, wDT,
+                             ConvDGradAttr()
+                                 .setStride(convStride)
+                                 .setPadding(convPadding)
+                                 .setDilation(convDilation)
+                                 .setName("conv_dgrad"));
+  dxT->setDim(xDims).setOutput(true).setDataType(convIOType);
+
+  auto dyWT = tensor(wgrad, "dy", dyDims, dyStride);
+  auto xWT = tensor(wgrad, "input", xDims, xStride);
+  auto dwT = wgrad.convWGrad(dyWT, xWT,
+                             ConvWGradAttr()
+                                 .setStride(convStride)
+                                 .setPadding(convPadding)
+                                 .setDilation(convDilation)
+                                 .setName("conv_wgrad"));
+  dwT->setDim(wDims).setOutput(true).setDataType(convIOType);
+
+  // Validate and compile every pass. The passes run one at a time, so they
+  // share the largest workspace.
+  double compileMs = 0.0;
+  bool cacheHit = true;
+  std::optional<size_t> workspaceSize;
+  for (Graph *graph : {&fprop, &dgrad, &wgrad}) {
+    FUSILLI_CHECK_ERROR(graph->validate());
+    CompileReport report;
+    applyRunCompileOptions(*graph, run, handle);
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/!dump, &report));
+    compileMs +=
+        std::chrono::duration<double, std::milli>(report.total()).count();
+    cacheHit = cacheHit && report.cacheHit;
+    FUSILLI_ASSIGN_OR_RETURN(auto size, graph->getWorkspaceSize());
+    if (size)
+      workspaceSize = std::max(workspaceSize.value_or(0), *size);
+  }
 
+  // Allocate the shared buffers.
+  FUSILLI_ASSIGN_OR_RETURN(auto xBuf,
+                           allocateBufferOfType(handle, xFT, convIOType, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(auto wBuf,
+                           allocateBufferOfType(handle, wFT, convIOType, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto dyBuf, allocateBufferOfType(handle, dyDT, convIOType, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(auto yBuf,
+                           allocateBufferOfType(handle, yT, convIOType, 0.0f));
+  FUSILLI_ASSIGN_OR_RETURN(auto dxBuf,
+                           allocateBufferOfType(handle, dxT, convIOType, 0.0f));
+  FUSILLI_ASSIGN_OR_RETURN(auto dwBuf,
+                           allocateBufferOfType(handle, dwT, convIOType, 0.0f));
+  FUSILLI_ASSIGN_OR_RETURN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+  struct Pass {
+    const char *name;
+    Graph *graph;
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+        variantPack;
+  };
+  std::vector<Pass> passes = {
+      {"fprop", &fprop, {{xFT, xBuf}, {wFT, wBuf}, {yT, yBuf}}},
+      {"dgrad", &dgrad, {{dyDT, dyBuf}, {wDT, wBuf}, {dxT, dxBuf}}},
+      {"wgrad", &wgrad, {{dyWT, dyBuf}, {xWT, xBuf}, {dwT, dwBuf}}},
+  };
+
+  // Memory peaks of the buffers, workspace and modules of all passes, see
+  // `runIterations()`.
+  MemoryStats memory = handle.getMemoryStats();
+  std::optional<size_t> hostPeakRss = getHostPeakRss();
+
+  std::shared_ptr<Buffer> scratch;
+  if (run.flushL2) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        Buffer buffer,
+        Buffer::allocateUninitialized(handle, {kFlushBytes}, DataType::Uint8));
+    scratch = std::make_shared<Buffer>(std::move(buffer));
+  }
+
+  for (int64_t i = 0; i < run.warmup; ++i)
+    for (const Pass &pass : passes)
+      FUSILLI_CHECK_ERROR(
+          pass.graph->execute(handle, pass.variantPack, workspace));
+
+  // Caches are flushed once per step: the passes of a step run back to back.
+  std::vector<std::vector<ExecutionTiming>> timings(passes.size());
+  std::vector<double> launchMs;
+  launchMs.reserve(run.iter);
+  for (int64_t i = 0; i < run.iter; ++i) {
+    if (scratch)
+      FUSILLI_CHECK_ERROR(flushCaches(handle, *scratch));
+    auto start = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < passes.size(); ++p) {
+      FUSILLI_ASSIGN_OR_RETURN(ExecutionTiming timing,
+                               passes[p].graph->executeTimed(
+                                   handle, passes[p].variantPack, workspace));
+      timings[p].push_back(std::move(timing));
+    }
+    std::chrono::duration<double, std::milli> launch =
+        std::chrono::steady_clock::now() - start;
+    launchMs.push_back(launch.count());
+  }
+
+  // Read the device times after the loop, to not serialize the executions.
+  std::vector<double> stepMs(run.iter, 0.0);
+  std::vector<double> passMedians;
+  for (const std::vector<ExecutionTiming> &passTimings : timings) {
+    std::vector<double> deviceMs;
+    deviceMs.reserve(passTimings.size());
+    for (const ExecutionTiming &timing : passTimings) {
+      FUSILLI_ASSIGN_OR_RETURN(float ms, timing.getElapsedMilliseconds());
+      stepMs[deviceMs.size()] += ms;
+      deviceMs.push_back(ms);
+    }
+    passMedians.push_back(computeStatistics(std::move(deviceMs)).median);
+  }
+
+  BenchmarkResult result{
+      .iter = run.iter,
+      .device = computeStatistics(std::move(stepMs)),
+      .launch = computeStatistics(std::move(launchMs)),
+      .compileMs = compileMs,
+      .cacheHit = cacheHit,
+      .dispatchCount = 0,
+      .workspaceSize = workspaceSize.value_or(0),
+      .bytes = 0,
+      .bandwidthGBs = 0.0,
+      .tflops = 0.0,
+      .peakFlopsPercent = std::nullopt,
+      .peakBandwidthPercent = std::nullopt,
+      .compileLatency = std::nullopt,
+      .memory = memory,
+      .hostPeakRss = hostPeakRss,
+      .output = {},
+      .reference = std::nullopt,
+  };
+  // Every pass reads its inputs and writes its output once.
+  for (const Pass &pass : passes) {
+    for (const auto &[tensor, buffer] : pass.variantPack)
+      result.bytes +=
+          iree_hal_buffer_view_byte_length(buffer->getBufferView());
+    ErrorOr<CompileStatistics> stats = pass.graph->getCompileStatistics();
+    if (isOk(stats) && result.dispatchCount)
+      *result.dispatchCount += stats->dispatchCount;
+    else
+      result.dispatchCount = std::nullopt;
+  }
+  if (result.device.median > 0.0)
+    result.bandwidthGBs =
+        static_cast<double>(result.bytes) / (result.device.median * 1e6);
+  printIterations(result);
+
+  double passTotalMs = 0.0;
+  for (double ms : passMedians)
+    passTotalMs += ms;
+  std::printf("%-12s %14s %8s\n", "pass", "median ms", "share");
+  for (size_t p = 0; p < passes.size(); ++p)
+    std::printf("%-12s %14.4f %7.1f%%\n", passes[p].name, passMedians[p],
+                passTotalMs > 0.0 ? 100.0 * passMedians[p] / passTotalMs
+                                  : 0.0);
+  return ok(result);
+}
+
+static ErrorOr<BenchmarkResult>
+benchmarkLayerNormFwd(const LayerNormOptions &opts,
+                      const std::vector<int64_t> &dims,
+                      DataType layernormIOType, const RunOptions &run,
+                      const Handle &handle, bool dump) {
   constexpr NormFwdPhase phase = NormFwdPhase::TRAINING;
 
   auto xDims = dims;
@@ -566,7 +1405,9 @@ static ErrorObject benchmarkLayerNormFwd(const LayerNormOptions &opts,
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump));
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
 
   // Allocate input and output buffers.
   FUSILLI_ASSIGN_OR_RETURN(
@@ -600,40 +1441,50 @@ static ErrorObject benchmarkLayerNormFwd(const LayerNormOptions &opts,
   FUSILLI_ASSIGN_OR_RETURN(auto workspace,
                            allocateWorkspace(handle, workspaceSize));
 
-  // Execute graph `iter` times.
-  for (size_t i = 0; i < iter; ++i)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
-
-  return ok();
+  // Execute graph `run.warmup` + `run.iter` times.
+  return runIterations(graph, handle, variantPack, workspace, run, report,
+                       workspaceSize);
 }
 
-static ErrorObject benchmarkSdpaFwd(const SdpaOptions &opts,
-                                    DataType sdpaIOType, int64_t iter,
-                                    int64_t deviceId, bool dump) {
-#if defined(FUSILLI_ENABLE_AMDGPU)
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle,
-                           Handle::create(Backend::AMDGPU, deviceId));
-#else
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(Backend::CPU));
-#endif
-
+static ErrorOr<BenchmarkResult>
+benchmarkSdpaFwd(const SdpaOptions &opts, DataType sdpaIOType,
+                 const RunOptions &run, const Handle &handle, bool dump) {
   std::optional<float> scale = opts.scale;
-
-  // Q: [batch, headsQ, seqQ, headDim]
-  std::vector<int64_t> qDim = {opts.batch, opts.headsQ, opts.seqQ,
-                               opts.headDim};
+  int64_t headDimV = opts.headDimV > 0 ? opts.headDimV : opts.headDim;
+
+  // Q: [batch, headsQ, seqQ, headDim], or [batch * seqQ, headsQ, headDim]
+  // when varlen packs the (equal length) sequences back to back.
+  std::vector<int64_t> qDim =
+      opts.varlen ? std::vector<int64_t>{opts.batch * opts.seqQ, opts.headsQ,
+                                         opts.headDim}
+                  : std::vector<int64_t>{opts.batch, opts.headsQ, opts.seqQ,
+                                         opts.headDim};
   auto qStride =
       generateStrideFromDim(qDim, getContiguousStrideOrder(qDim.size()));
 
-  // K: [batch, headsKV, seqKV, headDim]
-  std::vector<int64_t> kDim = {opts.batch, opts.headsKV, opts.seqKV,
-                               opts.headDim};
+  // K: [batch, headsKV, seqKV, headDim], the page pool
+  // [numPages, headsKV, blockSize, headDim] when paged, or
+  // [batch * seqKV, headsKV, headDim] when varlen.
+  bool paged = opts.blockSize > 0;
+  int64_t pagesPerSeq = paged ? opts.seqKV / opts.blockSize : 0;
+  int64_t numPages =
+      opts.numPages > 0 ? opts.numPages : opts.batch * pagesPerSeq;
+  std::vector<int64_t> kDim =
+      paged ? std::vector<int64_t>{numPages, opts.headsKV, opts.blockSize,
+                                   opts.headDim}
+      : opts.varlen
+          ? std::vector<int64_t>{opts.batch * opts.seqKV, opts.headsKV,
+                                 opts.headDim}
+          : std::vector<int64_t>{opts.batch, opts.headsKV, opts.seqKV,
+                                 opts.headDim};
   auto kStride =
       generateStrideFromDim(kDim, getContiguousStrideOrder(kDim.size()));
 
-  // V: [batch, headsKV, seqKV, headDim]
+  // V: like K, with headDimV.
   std::vector<int64_t> vDim = kDim;
-  auto vStride = kStride;
+  vDim.back() = headDimV;
+  auto vStride =
+      generateStrideFromDim(vDim, getContiguousStrideOrder(vDim.size()));
 
   Graph graph;
   std::string causalSuffix = opts.isCausal ? "_causal" : "";
@@ -643,12 +1494,21 @@ static ErrorObject benchmarkSdpaFwd(const SdpaOptions &opts,
       scale.has_value() ? std::format("_scale{:g}", *scale) : "";
   std::string dropoutSuffix =
       opts.dropoutP > 0.0f ? std::format("_dropout{:g}", opts.dropoutP) : "";
+  std::string pagedSuffix =
+      paged ? std::format("_paged_bs{}np{}", opts.blockSize, numPages) : "";
+  std::string featureSuffix =
+      std::format("{}{}{}{}{}",
+                  headDimV != opts.headDim ? std::format("_dv{}", headDimV)
+                                           : "",
+                  opts.varlen ? "_varlen" : "", opts.dropoutRng ? "_rng" : "",
+                  opts.rope ? "_rope" : "", opts.stats ? "_stats" : "");
 
   auto graphName = std::format(
-      "benchmark_sdpa_b{}hq{}hkv{}sq{}skv{}d{}_type{}{}{}{}{}{}", opts.batch,
-      opts.headsQ, opts.headsKV, opts.seqQ, opts.seqKV, opts.headDim,
-      kDataTypeToMlirTypeAsm.at(sdpaIOType), causalSuffix, maskSuffix,
-      gqaSuffix, scaleSuffix, dropoutSuffix);
+      "benchmark_sdpa_b{}hq{}hkv{}sq{}skv{}d{}_type{}{}{}{}{}{}{}{}",
+      opts.batch, opts.headsQ, opts.headsKV, opts.seqQ, opts.seqKV,
+      opts.headDim, kDataTypeToMlirTypeAsm.at(sdpaIOType), causalSuffix,
+      maskSuffix, gqaSuffix, scaleSuffix, dropoutSuffix, pagedSuffix,
+      featureSuffix);
   graph.setName(graphName);
 
   graph.setIODataType(DataType::Float)
@@ -680,18 +1540,87 @@ static ErrorObject benchmarkSdpaFwd(const SdpaOptions &opts,
                              .setDataType(sdpaIOType));
   }
 
+  // Page table: [batch, pagesPerSeq] block table into the K/V page pools.
+  std::shared_ptr<TensorAttr> pageTableT;
+  if (paged) {
+    pageTableT = graph.tensor(TensorAttr()
+                                  .setName("page_table")
+                                  .setDim({opts.batch, pagesPerSeq})
+                                  .setStride({pagesPerSeq, 1})
+                                  .setDataType(DataType::Int32));
+  }
+
+  // Cumulative sequence offsets: [batch + 1] when varlen.
+  std::shared_ptr<TensorAttr> cuSeqlensQT, cuSeqlensKVT;
+  if (opts.varlen) {
+    auto cuSeqlens = [&](const char *name) {
+      return graph.tensor(TensorAttr()
+                              .setName(name)
+                              .setDim({opts.batch + 1})
+                              .setStride({1})
+                              .setDataType(DataType::Int32));
+    };
+    cuSeqlensQT = cuSeqlens("cu_seqlens_q");
+    cuSeqlensKVT = cuSeqlens("cu_seqlens_kv");
+  }
+
+  // Runtime dropout seed and offset: [1] each.
+  std::shared_ptr<TensorAttr> dropoutSeedT, dropoutOffsetT;
+  if (opts.dropoutRng) {
+    auto rngTensor = [&](const char *name) {
+      return graph.tensor(TensorAttr()
+                              .setName(name)
+                              .setDim({1})
+                              .setStride({1})
+                              .setDataType(DataType::Int64));
+    };
+    dropoutSeedT = rngTensor("dropout_seed");
+    dropoutOffsetT = rngTensor("dropout_offset");
+  }
+
+  // Rotary embedding tables: [seqQ, headDim] each.
+  std::shared_ptr<TensorAttr> ropeCosT, ropeSinT;
+  if (opts.rope) {
+    auto ropeTable = [&](const char *name) {
+      return graph.tensor(TensorAttr()
+                              .setName(name)
+                              .setDim({opts.seqQ, opts.headDim})
+                              .setStride({opts.headDim, 1})
+                              .setDataType(sdpaIOType));
+    };
+    ropeCosT = ropeTable("rope_cos");
+    ropeSinT = ropeTable("rope_sin");
+  }
+
   SdpaAttr sdpaAttr;
   sdpaAttr.setName("sdpa")
       .setDropout(opts.dropoutP)
       .setIsCausal(opts.isCausal)
       .setScale(scale)
       .setEnableGqa(opts.enableGqa);
+  if (paged)
+    sdpaAttr.setPAGE_TABLE(pageTableT).setBlockSize(opts.blockSize);
+  if (opts.varlen)
+    sdpaAttr.setCU_SEQLENS_Q(cuSeqlensQT).setCU_SEQLENS_KV(cuSeqlensKVT);
+  if (opts.dropoutRng)
+    sdpaAttr.setDROPOUT_SEED(dropoutSeedT).setDROPOUT_OFFSET(dropoutOffsetT);
+  if (opts.rope)
+    sdpaAttr.setROPE_COS(ropeCosT).setROPE_SIN(ropeSinT);
+
+  std::shared_ptr<TensorAttr> oT, statsT;
+  if (opts.stats) {
+    auto [o, stats] = graph.sdpaWithStats(qT, kT, vT, maskT, sdpaAttr);
+    oT = o;
+    statsT = stats;
+    statsT->setDataType(DataType::Float).setOutput(true);
+  } else {
+    oT = graph.sdpa(qT, kT, vT, maskT, sdpaAttr);
+  }
 
-  auto oT = graph.sdpa(qT, kT, vT, maskT, sdpaAttr);
-
-  // Output: [batch, headsQ, seqQ, headDim]
-  std::vector<int64_t> outDim = {opts.batch, opts.headsQ, opts.seqQ,
-                                 opts.headDim};
+  // Output: [batch, headsQ, seqQ, headDimV], or
+  // [batch * seqQ, headsQ, headDimV] when varlen.
+  std::vector<int64_t> outDim = qDim;
+  outDim.back() = headDimV;
   auto outStride =
       generateStrideFromDim(outDim, getContiguousStrideOrder(outDim.size()));
   oT->setDim(outDim)
@@ -703,7 +1632,9 @@ static ErrorObject benchmarkSdpaFwd(const SdpaOptions &opts,
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump));
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
 
   // Allocate input and output buffers.
   FUSILLI_ASSIGN_OR_RETURN(auto qBuf,
@@ -725,48 +1656,100 @@ static ErrorObject benchmarkSdpaFwd(const SdpaOptions &opts,
     variantPack[maskT] = maskBuf;
   }
 
+  if (paged) {
+    // Spread the sequences over the page pool, wrapping around when the
+    // pool is smaller than batch * pagesPerSeq.
+    std::vector<int32_t> pageTable(opts.batch * pagesPerSeq);
+    for (size_t i = 0; i < pageTable.size(); ++i)
+      pageTable[i] = static_cast<int32_t>(i % numPages);
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto pageTableBuf, allocateBufferOfType(handle, pageTableT, pageTable));
+    variantPack[pageTableT] = pageTableBuf;
+  }
+
+  if (opts.varlen) {
+    std::vector<int32_t> cuSeqlensQ(opts.batch + 1);
+    std::vector<int32_t> cuSeqlensKV(opts.batch + 1);
+    for (int64_t i = 0; i <= opts.batch; ++i) {
+      cuSeqlensQ[i] = static_cast<int32_t>(i * opts.seqQ);
+      cuSeqlensKV[i] = static_cast<int32_t>(i * opts.seqKV);
+    }
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto cuSeqlensQBuf,
+        allocateBufferOfType(handle, cuSeqlensQT, cuSeqlensQ));
+    variantPack[cuSeqlensQT] = cuSeqlensQBuf;
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto cuSeqlensKVBuf,
+        allocateBufferOfType(handle, cuSeqlensKVT, cuSeqlensKV));
+    variantPack[cuSeqlensKVT] = cuSeqlensKVBuf;
+  }
+
+  if (opts.dropoutRng) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto dropoutSeedBuf,
+        allocateBufferOfType(handle, dropoutSeedT, std::vector<int64_t>{42}));
+    variantPack[dropoutSeedT] = dropoutSeedBuf;
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto dropoutOffsetBuf,
+        allocateBufferOfType(handle, dropoutOffsetT, std::vector<int64_t>{0}));
+    variantPack[dropoutOffsetT] = dropoutOffsetBuf;
+  }
+
+  if (opts.rope) {
+    // Identity rotation: only the cost of rotating Q and K matters here.
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto ropeCosBuf,
+        allocateBufferOfType(handle, ropeCosT, sdpaIOType, 1.0f));
+    variantPack[ropeCosT] = ropeCosBuf;
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto ropeSinBuf,
+        allocateBufferOfType(handle, ropeSinT, sdpaIOType, 0.0f));
+    variantPack[ropeSinT] = ropeSinBuf;
+  }
+
+  if (opts.stats) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto statsBuf,
+        allocateBufferOfType(handle, statsT, DataType::Float, 0.0f));
+    variantPack[statsT] = statsBuf;
+  }
+
   // Allocate workspace buffer if needed.
   FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph.getWorkspaceSize());
   FUSILLI_ASSIGN_OR_RETURN(auto workspace,
                            allocateWorkspace(handle, workspaceSize));
 
-  // Execute graph `iter` times.
-  for (size_t i = 0; i < iter; ++i)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
-
-  return ok();
+  // Execute graph `run.warmup` + `run.iter` times.
+  return runIterations(graph, handle, variantPack, workspace, run, report,
+                       workspaceSize);
 }
 
-static ErrorObject benchmarkMatmul(const MatmulOptions &opts, DataType aType,
-                                   DataType bType, DataType outType,
-                                   DataType biasType, int64_t iter,
-                                   int64_t deviceId, bool dump) {
-#if defined(FUSILLI_ENABLE_AMDGPU)
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle,
-                           Handle::create(Backend::AMDGPU, deviceId));
-#else
-  FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(Backend::CPU));
-#endif
+static ErrorOr<BenchmarkResult>
+benchmarkMatmul(const MatmulOptions &opts, DataType aType, DataType bType,
+                DataType outType, DataType biasType, const RunOptions &run,
+                const Handle &handle, bool dump) {
+  // A gated B packs the gate and up projections side by side.
+  int64_t bN = opts.gate.empty() ? opts.n : 2 * opts.n;
 
   // Build attributes based on transpose flags and batch count.
   auto aDims = (opts.b > 1) ? std::vector<int64_t>{opts.b, opts.m, opts.k}
                             : std::vector<int64_t>{opts.m, opts.k};
-  auto bDims = (opts.b > 1) ? std::vector<int64_t>{opts.b, opts.k, opts.n}
-                            : std::vector<int64_t>{opts.k, opts.n};
+  auto bDims = (opts.b > 1) ? std::vector<int64_t>{opts.b, opts.k, bN}
+                            : std::vector<int64_t>{opts.k, bN};
 
   std::vector<int64_t> aStride, bStride;
   if (opts.b > 1) {
     // Batched matmul strides
     aStride = opts.transA ? std::vector<int64_t>{opts.m * opts.k, 1, opts.m}
                           : std::vector<int64_t>{opts.m * opts.k, opts.k, 1};
-    bStride = opts.transB ? std::vector<int64_t>{opts.k * opts.n, 1, opts.k}
-                          : std::vector<int64_t>{opts.k * opts.n, opts.n, 1};
+    bStride = opts.transB ? std::vector<int64_t>{opts.k * bN, 1, opts.k}
+                          : std::vector<int64_t>{opts.k * bN, bN, 1};
   } else {
     // Non-batched matmul strides
     aStride = opts.transA ? std::vector<int64_t>{1, opts.m}
                           : std::vector<int64_t>{opts.k, 1};
     bStride = opts.transB ? std::vector<int64_t>{1, opts.k}
-                          : std::vector<int64_t>{opts.n, 1};
+                          : std::vector<int64_t>{bN, 1};
   }
 
   Graph graph;
@@ -780,6 +1763,19 @@ static ErrorObject benchmarkMatmul(const MatmulOptions &opts, DataType aType,
     graphName +=
         std::format("_biastype{}", kDataTypeToMlirTypeAsm.at(biasType));
   }
+  // Activation, scaling and residual add run as the matmul node's epilogue,
+  // which then also takes the bias.
+  bool epilogue = !opts.activation.empty() || opts.alpha != 1.0f ||
+                  opts.beta != 1.0f || opts.residual;
+  if (epilogue) {
+    graphName += std::format("_act{}_alpha{}_beta{}_residual{}",
+                             opts.activation.empty() ? "none" : opts.activation,
+                             opts.alpha, opts.beta, opts.residual);
+  }
+  if (!opts.gate.empty())
+    graphName += std::format("_gate{}", opts.gate);
+  if (opts.splitK > 1)
+    graphName += std::format("_splitk{}", opts.splitK);
   graph.setName(graphName);
 
   // Types on the graph are kept at fp32 but we explicitly set
@@ -802,12 +1798,9 @@ static ErrorObject benchmarkMatmul(const MatmulOptions &opts, DataType aType,
                              .setStride(bStride)
                              .setDataType(bType));
 
-  auto matmulAttr = MatmulAttr().setName("matmul");
-
-  auto outT = graph.matmul(aT, bT, matmulAttr);
-  // Use `biasType` as the intermediate type when bias is present,
-  // and `outType` otherwise.
-  outT->setDataType(opts.bias ? biasType : outType);
+  auto matmulAttr = MatmulAttr().setSplitK(opts.splitK).setName("matmul");
+  if (!opts.gate.empty())
+    matmulAttr.setGate(getActivationMode(opts.gate));
 
   std::shared_ptr<TensorAttr> biasT;
   if (opts.bias) {
@@ -821,6 +1814,37 @@ static ErrorObject benchmarkMatmul(const MatmulOptions &opts, DataType aType,
                              .setDim(biasDims)
                              .setStride(biasStride)
                              .setDataType(biasType));
+  }
+
+  std::shared_ptr<TensorAttr> residualT;
+  if (epilogue) {
+    if (opts.residual) {
+      auto residualDims = (opts.b > 1)
+                              ? std::vector<int64_t>{opts.b, opts.m, opts.n}
+                              : std::vector<int64_t>{opts.m, opts.n};
+      residualT = graph.tensor(
+          TensorAttr()
+              .setName("residual")
+              .setDim(residualDims)
+              .setStride(generateStrideFromDim(
+                  residualDims,
+                  getContiguousStrideOrder(residualDims.size())))
+              .setDataType(outType));
+      matmulAttr.setRESIDUAL(residualT);
+    }
+    if (!opts.activation.empty())
+      matmulAttr.setActivation(getActivationMode(opts.activation));
+    if (biasT)
+      matmulAttr.setBIAS(biasT);
+    matmulAttr.setAlpha(opts.alpha).setBeta(opts.beta);
+  }
+
+  auto outT = graph.matmul(aT, bT, matmulAttr);
+  // Use `biasType` as the intermediate type when an unfused bias is present,
+  // and `outType` otherwise.
+  outT->setDataType(opts.bias && !epilogue ? biasType : outType);
+
+  if (opts.bias && !epilogue) {
     auto biasAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::ADD);
     outT = graph.pointwise(outT, biasT, biasAttr);
     outT->setDataType(outType);
@@ -831,7 +1855,9 @@ static ErrorObject benchmarkMatmul(const MatmulOptions &opts, DataType aType,
   FUSILLI_CHECK_ERROR(graph.validate());
 
   // Compile
-  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump));
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
 
   // Allocate input, weight and output buffers.
   FUSILLI_ASSIGN_OR_RETURN(auto aBuf,
@@ -855,23 +1881,857 @@ static ErrorObject benchmarkMatmul(const MatmulOptions &opts, DataType aType,
     variantPack.insert({biasT, biasBuf});
   }
 
+  if (residualT) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto residualBuf,
+        allocateBufferOfType(handle, residualT, outType, 1.0f));
+    variantPack.insert({residualT, residualBuf});
+  }
+
   // Allocate workspace buffer if needed.
   FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph.getWorkspaceSize());
   FUSILLI_ASSIGN_OR_RETURN(auto workspace,
                            allocateWorkspace(handle, workspaceSize));
 
-  // Execute graph `iter` times.
-  for (size_t i = 0; i < iter; ++i)
-    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
-
-  return ok();
+  // Execute graph `run.warmup` + `run.iter` times.
+  FUSILLI_ASSIGN_OR_RETURN(BenchmarkResult result,
+                           runIterations(graph, handle, variantPack, workspace,
+                                         run, report, workspaceSize));
+  if (run.reference) {
+    FUSILLI_ASSIGN_OR_RETURN(result.output,
+                             readAsFloat(handle, *outBuf, outType));
+  }
+  return ok(std::move(result));
 }
 
-//===---------------------------------------------------------------------===//
-// CLI registration functions
-//===---------------------------------------------------------------------===//
-
-static CLI::App *registerConvOptions(CLI::App &mainApp, ConvOptions &convOpts) {
+// Compiles the matmul once with a dynamic M and runs it at each of
+// `opts.dynamicM`, comparing every size with a matmul compiled for it, then
+// returns the result of the dynamic matmul at `opts.m`. This prices the
+// generality of a dynamic shape against static specializations.
+static ErrorOr<BenchmarkResult>
+benchmarkMatmulDynamicM(const MatmulOptions &opts, DataType aType,
+                        DataType bType, DataType outType,
+                        const RunOptions &run, const Handle &handle,
+                        bool dump) {
+  auto aDims = (opts.b > 1) ? std::vector<int64_t>{opts.b, opts.m, opts.k}
+                            : std::vector<int64_t>{opts.m, opts.k};
+  auto bDims = (opts.b > 1) ? std::vector<int64_t>{opts.b, opts.k, opts.n}
+                            : std::vector<int64_t>{opts.k, opts.n};
+  std::vector<int64_t> bStride;
+  if (opts.b > 1)
+    bStride = opts.transB ? std::vector<int64_t>{opts.k * opts.n, 1, opts.k}
+                          : std::vector<int64_t>{opts.k * opts.n, opts.n, 1};
+  else
+    bStride = opts.transB ? std::vector<int64_t>{1, opts.k}
+                          : std::vector<int64_t>{opts.n, 1};
+  const size_t mIndex = aDims.size() - 2;
+
+  Graph graph;
+  graph.setName(std::format(
+      "benchmark_matmul_dynamic_m_b{}_n{}_k{}_transB{}_atype{}_btype{}_"
+      "outtype{}",
+      opts.b, opts.n, opts.k, opts.transB, kDataTypeToMlirTypeAsm.at(aType),
+      kDataTypeToMlirTypeAsm.at(bType), kDataTypeToMlirTypeAsm.at(outType)));
+  graph.setIODataType(DataType::Float)
+      .setComputeDataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
+
+  auto aT = graph.tensor(
+      TensorAttr()
+          .setName("matrix_a")
+          .setDim(aDims)
+          .setDynamicDims({mIndex})
+          .setStride(generateStrideFromDim(
+              aDims, getContiguousStrideOrder(aDims.size())))
+          .setDataType(aType));
+  auto bT = graph.tensor(TensorAttr()
+                             .setName("matrix_b")
+                             .setDim(bDims)
+                             .setStride(bStride)
+                             .setDataType(bType));
+  auto outT = graph.matmul(aT, bT, MatmulAttr().setName("matmul"));
+  outT->setDynamicDims({mIndex}).setOutput(true).setDataType(outType);
+
+  FUSILLI_CHECK_ERROR(graph.validate());
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
+
+  FUSILLI_ASSIGN_OR_RETURN(auto bBuf,
+                           allocateBufferOfType(handle, bT, bType, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_ASSIGN_OR_RETURN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+  // Runs the dynamic matmul on buffers of the runtime size `m`, which give
+  // the graph its M.
+  auto runAt = [&](int64_t m,
+                   const RunOptions &runOpts) -> ErrorOr<BenchmarkResult> {
+    std::vector<int64_t> runtimeADims = aDims, runtimeOutDims = aDims;
+    runtimeADims[mIndex] = runtimeOutDims[mIndex] = m;
+    runtimeOutDims.back() = opts.n;
+    FUSILLI_ASSIGN_OR_RETURN(
+        Buffer aBuf, Buffer::allocateFilled(handle, castToSizeT(runtimeADims),
+                                            aType, 1.0));
+    FUSILLI_ASSIGN_OR_RETURN(
+        Buffer outBuf,
+        Buffer::allocateFilled(handle, castToSizeT(runtimeOutDims), outType,
+                               0.0));
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>>
+        variantPack = {
+            {aT, std::make_shared<Buffer>(std::move(aBuf))},
+            {bT, bBuf},
+            {outT, std::make_shared<Buffer>(std::move(outBuf))},
+        };
+    return runIterations(graph, handle, variantPack, workspace, runOpts,
+                         report, workspaceSize);
+  };
+
+  // The sweep leaves compile latency to the returned run.
+  RunOptions sweepRun = run;
+  sweepRun.measureCompile = 0;
+  std::vector<std::pair<double, double>> medians;
+  for (int64_t m : opts.dynamicM) {
+    std::printf("M=%lld dynamic:\n", static_cast<long long>(m));
+    FUSILLI_ASSIGN_OR_RETURN(BenchmarkResult dynamic, runAt(m, sweepRun));
+    MatmulOptions staticOpts = opts;
+    staticOpts.m = m;
+    staticOpts.dynamicM.clear();
+    std::printf("M=%lld static:\n", static_cast<long long>(m));
+    FUSILLI_ASSIGN_OR_RETURN(BenchmarkResult specialized,
+                             benchmarkMatmul(staticOpts, aType, bType, outType,
+                                             outType, sweepRun, handle, dump));
+    medians.emplace_back(dynamic.device.median, specialized.device.median);
+  }
+
+  std::printf("%10s %14s %14s %10s\n", "M", "dynamic ms", "static ms",
+              "slowdown");
+  for (size_t i = 0; i < medians.size(); ++i) {
+    auto [dynamicMs, staticMs] = medians[i];
+    std::printf("%10lld %14.4f %14.4f %9.2fx\n",
+                static_cast<long long>(opts.dynamicM[i]), dynamicMs, staticMs,
+                staticMs > 0.0 ? dynamicMs / staticMs : 0.0);
+  }
+
+  std::printf("M=%lld dynamic:\n", static_cast<long long>(opts.m));
+  return runAt(opts.m, run);
+}
+
+// Whether matmul operands of `type` are quantized, see
+// `benchmarkQuantizedMatmul()`.
+static bool isQuantizedType(DataType type) {
+  return type == DataType::Int4 || type == DataType::Int8 ||
+         isFloat8Type(type);
+}
+
+// Benchmarks the quantized matmul paths:
+// - si8 or f8 A and B of one type, dequantized by f32 scales per row of A and
+//   per column of B applied to the accumulator (see `MatmulAttr::setSCALE_A()`
+//   and `setSCALE_B()`);
+// - f16 / bf16 activations A by si4 weights B, with a scale of A's type per
+//   `opts.groupSize` rows (along K) of each column of B. The groups are the
+//   batch of a mixed precision batched matmul, whose partial products are
+//   scaled and summed:
+//     C = sum_g (A[:, g] @ B[g, :]) * scale[g, :]
+//   A's row-major [M, K] buffer is read in place as [K / G, M, G], and B's
+//   [K, N] one as [K / G, G, N].
+static ErrorOr<BenchmarkResult>
+benchmarkQuantizedMatmul(const MatmulOptions &opts, DataType aType,
+                         DataType bType, DataType outType,
+                         const RunOptions &run, const Handle &handle,
+                         bool dump) {
+  bool isInt4Weights = bType == DataType::Int4;
+  int64_t groupSize = opts.groupSize > 0 ? opts.groupSize : opts.k;
+  int64_t groups = isInt4Weights ? opts.k / groupSize : 1;
+
+  Graph graph;
+  graph.setName(std::format(
+      "benchmark_quantized_matmul_b{}_m{}_n{}_k{}_group{}_atype{}_btype{}_"
+      "outtype{}",
+      opts.b, opts.m, opts.n, opts.k, isInt4Weights ? groupSize : 0,
+      kDataTypeToMlirTypeAsm.at(aType), kDataTypeToMlirTypeAsm.at(bType),
+      kDataTypeToMlirTypeAsm.at(outType)));
+  graph.setIODataType(outType)
+      .setComputeDataType(DataType::Float)
+      .setIntermediateDataType(isInt4Weights ? aType : DataType::Float);
+
+  std::vector<std::shared_ptr<TensorAttr>> inputs;
+  std::shared_ptr<TensorAttr> outT;
+  if (isInt4Weights) {
+    inputs.push_back(
+        graph.tensor(TensorAttr()
+                         .setName("matrix_a")
+                         .setDim({groups, opts.m, groupSize})
+                         .setStride({groupSize, opts.k, 1})
+                         .setDataType(aType)));
+    inputs.push_back(
+        graph.tensor(TensorAttr()
+                         .setName("matrix_b")
+                         .setDim({groups, groupSize, opts.n})
+                         .setStride({groupSize * opts.n, opts.n, 1})
+                         .setDataType(bType)));
+    inputs.push_back(graph.tensor(TensorAttr()
+                                      .setName("scale")
+                                      .setDim({groups, 1, opts.n})
+                                      .setStride({opts.n, opts.n, 1})
+                                      .setDataType(aType)));
+    auto partialT = graph.matmul(inputs[0], inputs[1],
+                                 MatmulAttr().setName("matmul"));
+    auto scaledT = graph.pointwise(partialT, inputs[2],
+                                   PointwiseAttr()
+                                       .setMode(PointwiseAttr::Mode::MUL)
+                                       .setName("dequantize"));
+    outT = scaledT;
+    // A single group (the default) needs no sum.
+    if (groups > 1) {
+      outT = graph.reduction(scaledT,
+                             ReductionAttr()
+                                 .setMode(ReductionAttr::Mode::SUM)
+                                 .setName("group_sum"));
+      outT->setDim({1, opts.m, opts.n})
+          .setStride({opts.m * opts.n, opts.n, 1});
+    }
+  } else {
+    bool batched = opts.b > 1;
+    auto dims = [&](int64_t rows, int64_t cols) {
+      return batched ? std::vector<int64_t>{opts.b, rows, cols}
+                     : std::vector<int64_t>{rows, cols};
+    };
+    auto contiguous = [&](const std::string &name,
+                          const std::vector<int64_t> &dim, DataType type) {
+      return graph.tensor(TensorAttr()
+                              .setName(name)
+                              .setDim(dim)
+                              .setStride(generateStrideFromDim(
+                                  dim, getContiguousStrideOrder(dim.size())))
+                              .setDataType(type));
+    };
+    inputs.push_back(contiguous("matrix_a", dims(opts.m, opts.k), aType));
+    inputs.push_back(contiguous("matrix_b", dims(opts.k, opts.n), bType));
+    inputs.push_back(
+        contiguous("scale_a", dims(opts.m, 1), DataType::Float));
+    inputs.push_back(
+        contiguous("scale_b", dims(1, opts.n), DataType::Float));
+    outT = graph.matmul(inputs[0], inputs[1],
+                        MatmulAttr()
+                            .setSCALE_A(inputs[2])
+                            .setSCALE_B(inputs[3])
+                            .setName("matmul"));
+  }
+  outT->setOutput(true).setDataType(outType);
+
+  // Validate, infer missing properties
+  FUSILLI_CHECK_ERROR(graph.validate());
+
+  // Compile
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
+
+  // Allocate input and output buffers, with unit scales.
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack;
+  for (const std::shared_ptr<TensorAttr> &t : inputs) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto buf, allocateBufferOfType(handle, t, t->getDataType(), 1.0f));
+    variantPack.insert({t, buf});
+  }
+  FUSILLI_ASSIGN_OR_RETURN(auto outBuf,
+                           allocateBufferOfType(handle, outT, outType, 0.0f));
+  variantPack.insert({outT, outBuf});
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_ASSIGN_OR_RETURN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph `run.warmup` + `run.iter` times.
+  return runIterations(graph, handle, variantPack, workspace, run, report,
+                       workspaceSize);
+}
+
+static ErrorOr<BenchmarkResult>
+benchmarkGroupedMatmul(const GroupedMatmulOptions &opts, DataType ioType,
+                       const RunOptions &run, const Handle &handle,
+                       bool dump) {
+  // A: [E, M, K] rows routed to each expert, padded to M.
+  // B: [E, K, N] expert weights.
+  std::vector<int64_t> aDims = {opts.e, opts.m, opts.k};
+  std::vector<int64_t> bDims = {opts.e, opts.k, opts.n};
+
+  Graph graph;
+  graph.setName(std::format(
+      "benchmark_grouped_matmul_e{}_m{}_n{}_k{}_type{}", opts.e, opts.m,
+      opts.n, opts.k, kDataTypeToMlirTypeAsm.at(ioType)));
+  graph.setIODataType(ioType)
+      .setComputeDataType(DataType::Float)
+      .setIntermediateDataType(ioType);
+
+  auto aT = graph.tensor(TensorAttr()
+                             .setName("tokens")
+                             .setDim(aDims)
+                             .setStride(generateStrideFromDim(
+                                 aDims, getContiguousStrideOrder(aDims.size())))
+                             .setDataType(ioType));
+
+  auto bT = graph.tensor(TensorAttr()
+                             .setName("experts")
+                             .setDim(bDims)
+                             .setStride(generateStrideFromDim(
+                                 bDims, getContiguousStrideOrder(bDims.size())))
+                             .setDataType(ioType));
+
+  auto groupSizesT = graph.tensor(TensorAttr()
+                                      .setName("group_sizes")
+                                      .setDim({opts.e})
+                                      .setStride({1})
+                                      .setDataType(DataType::Int32));
+
+  auto matmulAttr =
+      MatmulAttr().setGROUP_SIZES(groupSizesT).setName("grouped_matmul");
+  auto outT = graph.matmul(aT, bT, matmulAttr);
+  outT->setOutput(true);
+
+  // Validate, infer missing properties
+  FUSILLI_CHECK_ERROR(graph.validate());
+
+  // Compile
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
+
+  // Allocate input, weight, group size and output buffers. Every expert gets
+  // `groupSize` rows (all M rows by default).
+  int64_t groupSize = opts.groupSize > 0 ? opts.groupSize : opts.m;
+  FUSILLI_ASSIGN_OR_RETURN(auto aBuf,
+                           allocateBufferOfType(handle, aT, ioType, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(auto bBuf,
+                           allocateBufferOfType(handle, bT, ioType, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto groupSizesBuf,
+      allocateBufferOfType(handle, groupSizesT, DataType::Int32,
+                           static_cast<double>(groupSize)));
+  FUSILLI_ASSIGN_OR_RETURN(auto outBuf,
+                           allocateBufferOfType(handle, outT, ioType, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {aT, aBuf},
+          {bT, bBuf},
+          {groupSizesT, groupSizesBuf},
+          {outT, outBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_ASSIGN_OR_RETURN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph `run.warmup` + `run.iter` times.
+  return runIterations(graph, handle, variantPack, workspace, run, report,
+                       workspaceSize);
+}
+
+// Shared body of the memory-bound (pointwise, reduction and norm) and
+// composite block benchmarks: `build` adds the nodes to `graph` and returns
+// its inputs and outputs, which are then validated, compiled, allocated and
+// executed. Buffers have `ioType`, except for outputs inferred to another type
+// (e.g. of comparisons).
+template <typename BuildFn>
+static ErrorOr<BenchmarkResult>
+runMemoryBoundGraph(Graph &graph, DataType ioType, const RunOptions &run,
+                    const Handle &handle, bool dump, BuildFn build) {
+  graph.setIODataType(ioType)
+      .setComputeDataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
+  auto [inputs, outputs] = build(graph);
+  for (const std::shared_ptr<TensorAttr> &t : outputs)
+    t->setOutput(true);
+
+  // Validate, infer missing properties
+  FUSILLI_CHECK_ERROR(graph.validate());
+
+  // Compile
+  CompileReport report;
+  applyRunCompileOptions(graph, run, handle);
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/!dump, &report));
+
+  // Allocate input and output buffers. Inputs are initialized to non-trivial
+  // values to avoid possible compiler-side optimization of e.g. a multiply by
+  // one.
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack;
+  for (const std::shared_ptr<TensorAttr> &t : inputs) {
+    FUSILLI_ASSIGN_OR_RETURN(auto buf,
+                             allocateBufferOfType(handle, t, ioType, 1.5f));
+    variantPack.insert({t, buf});
+  }
+  for (const std::shared_ptr<TensorAttr> &t : outputs) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto buf, allocateBufferOfType(handle, t, t->getDataType(), 0.0f));
+    variantPack.insert({t, buf});
+  }
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_ASSIGN_OR_RETURN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph `run.warmup` + `run.iter` times.
+  return runIterations(graph, handle, variantPack, workspace, run, report,
+                       workspaceSize);
+}
+
+using TensorList = std::vector<std::shared_ptr<TensorAttr>>;
+
+static ErrorOr<BenchmarkResult>
+benchmarkPointwise(const PointwiseOptions &opts,
+                   const std::vector<int64_t> &dims, DataType ioType,
+                   PointwiseAttr::Mode mode, const RunOptions &run,
+                   const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(auto stride,
+                           generateStrideFromLayout(dims, opts.layout));
+
+  Graph graph;
+  graph.setName(std::format("benchmark_pointwise_{}_input{}_layout{}_type{}",
+                            opts.mode, opts.input, opts.layout, opts.type));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        TensorList inputs;
+        for (int i = 0; i < PointwiseAttr::kModeToRequiredInputCount.at(mode);
+             ++i)
+          inputs.push_back(g.tensor(TensorAttr()
+                                        .setName(std::format("in_{}", i))
+                                        .setDim(dims)
+                                        .setStride(stride)));
+        auto attr = PointwiseAttr().setMode(mode).setName("pointwise");
+        std::shared_ptr<TensorAttr> yT;
+        if (inputs.size() == 1)
+          yT = g.pointwise(inputs[0], attr);
+        else if (inputs.size() == 2)
+          yT = g.pointwise(inputs[0], inputs[1], attr);
+        else
+          yT = g.pointwise(inputs[0], inputs[1], inputs[2], attr);
+        yT->setName("y");
+        return std::pair{inputs, TensorList{yT}};
+      });
+}
+
+static ErrorOr<BenchmarkResult>
+benchmarkReduction(const ReductionOptions &opts,
+                   const std::vector<int64_t> &xDims,
+                   const std::vector<int64_t> &yDims, DataType ioType,
+                   ReductionAttr::Mode mode, const RunOptions &run,
+                   const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(auto xStride,
+                           generateStrideFromLayout(xDims, opts.layout));
+  FUSILLI_ASSIGN_OR_RETURN(auto yStride,
+                           generateStrideFromLayout(yDims, opts.layout));
+
+  Graph graph;
+  graph.setName(std::format(
+      "benchmark_reduction_{}_input{}_output{}_layout{}_type{}", opts.mode,
+      opts.input, opts.outputDims, opts.layout, opts.type));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        auto xT = g.tensor(
+            TensorAttr().setName("x").setDim(xDims).setStride(xStride));
+        auto attr = ReductionAttr().setMode(mode).setName("reduction");
+        TensorList outputs;
+        if (ReductionAttr::isMultiOutputMode(mode)) {
+          auto [yT, y2T] = g.multiOutputReduction(xT, attr);
+          y2T->setName("y2").setDim(yDims).setStride(yStride);
+          outputs = {yT, y2T};
+        } else {
+          outputs = {g.reduction(xT, attr)};
+        }
+        outputs[0]->setName("y").setDim(yDims).setStride(yStride);
+        return std::pair{TensorList{xT}, outputs};
+      });
+}
+
+static ErrorOr<BenchmarkResult>
+benchmarkLayerNormBwd(const LayerNormOptions &opts,
+                      const std::vector<int64_t> &dims, DataType ioType,
+                      const RunOptions &run, const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(auto stride,
+                           generateStrideFromLayout(dims, opts.layout));
+
+  Graph graph;
+  graph.setName(std::format("benchmark_layernorm_input{}_forw{}_layout{}_"
+                            "type{}_elementwise_affine{}",
+                            opts.input, opts.forw, opts.layout, opts.type,
+                            opts.elementwiseAffine));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        auto dyT = g.tensor(
+            TensorAttr().setName("dy").setDim(dims).setStride(stride));
+        auto xT =
+            g.tensor(TensorAttr().setName("x").setDim(dims).setStride(stride));
+        // Shape and strides will be inferred later in inferPropertiesNode()
+        auto meanT = g.tensor(TensorAttr().setName("mean"));
+        auto invVarianceT = g.tensor(TensorAttr().setName("inv_variance"));
+        TensorList inputs = {dyT, xT, meanT, invVarianceT};
+        std::shared_ptr<TensorAttr> sT = nullptr;
+        if (opts.elementwiseAffine)
+          inputs.push_back(sT = g.tensor(TensorAttr().setName("scale")));
+        auto attr = LayernormBwdAttr().setName("layernorm_bwd");
+        auto [dxT, dsT, dbT] =
+            g.layernormBackward(dyT, xT, sT, meanT, invVarianceT, attr);
+        dxT->setName("dx");
+        TensorList outputs = {dxT};
+        if (opts.elementwiseAffine) {
+          dsT->setName("dscale");
+          dbT->setName("dbias");
+          outputs.push_back(dsT);
+          outputs.push_back(dbT);
+        }
+        return std::pair{inputs, outputs};
+      });
+}
+
+static ErrorOr<BenchmarkResult>
+benchmarkRmsNormFwd(const RmsNormOptions &opts,
+                    const std::vector<int64_t> &dims, DataType ioType,
+                    const RunOptions &run, const Handle &handle, bool dump) {
+  NormFwdPhase phase =
+      opts.forw == 1 ? NormFwdPhase::TRAINING : NormFwdPhase::INFERENCE;
+  FUSILLI_ASSIGN_OR_RETURN(auto stride,
+                           generateStrideFromLayout(dims, opts.layout));
+
+  Graph graph;
+  graph.setName(std::format(
+      "benchmark_rmsnorm_input{}_forw{}_layout{}_type{}_scale{}_eps{}",
+      opts.input, opts.forw, opts.layout, opts.type, opts.scale, opts.eps));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        auto xT =
+            g.tensor(TensorAttr().setName("x").setDim(dims).setStride(stride));
+        TensorList inputs = {xT};
+        // Shape and strides will be inferred later in inferPropertiesNode()
+        std::shared_ptr<TensorAttr> sT = nullptr;
+        if (opts.scale)
+          inputs.push_back(sT = g.tensor(TensorAttr().setName("scale")));
+        auto attr = RmsnormAttr()
+                        .setForwardPhase(phase)
+                        .setEpsilon(g.tensor(TensorAttr(opts.eps)))
+                        .setName("rmsnorm_fwd");
+        auto [yT, rT] = g.rmsnorm(xT, sT, attr);
+        yT->setName("y");
+        TensorList outputs = {yT};
+        if (phase == NormFwdPhase::TRAINING) {
+          rT->setName("inv_rms");
+          outputs.push_back(rT);
+        }
+        return std::pair{inputs, outputs};
+      });
+}
+
+static ErrorOr<BenchmarkResult>
+benchmarkRmsNormBwd(const RmsNormOptions &opts,
+                    const std::vector<int64_t> &dims, DataType ioType,
+                    const RunOptions &run, const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(auto stride,
+                           generateStrideFromLayout(dims, opts.layout));
+
+  Graph graph;
+  graph.setName(
+      std::format("benchmark_rmsnorm_input{}_forw{}_layout{}_type{}_scale{}",
+                  opts.input, opts.forw, opts.layout, opts.type, opts.scale));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        auto dyT = g.tensor(
+            TensorAttr().setName("dy").setDim(dims).setStride(stride));
+        auto xT =
+            g.tensor(TensorAttr().setName("x").setDim(dims).setStride(stride));
+        // Shape and strides will be inferred later in inferPropertiesNode()
+        auto invRmsT = g.tensor(TensorAttr().setName("inv_rms"));
+        TensorList inputs = {dyT, xT, invRmsT};
+        std::shared_ptr<TensorAttr> sT = nullptr;
+        if (opts.scale)
+          inputs.push_back(sT = g.tensor(TensorAttr().setName("scale")));
+        auto attr = RmsnormBwdAttr().setName("rmsnorm_bwd");
+        auto [dxT, dsT] = g.rmsnormBackward(dyT, xT, sT, invRmsT, attr);
+        dxT->setName("dx");
+        TensorList outputs = {dxT};
+        if (opts.scale) {
+          dsT->setName("dscale");
+          outputs.push_back(dsT);
+        }
+        return std::pair{inputs, outputs};
+      });
+}
+
+static ErrorOr<BenchmarkResult>
+benchmarkBatchNormFwd(const BatchNormOptions &opts,
+                      const std::vector<int64_t> &dims, DataType ioType,
+                      const RunOptions &run, const Handle &handle, bool dump) {
+  NormFwdPhase phase =
+      opts.forw == 1 ? NormFwdPhase::TRAINING : NormFwdPhase::INFERENCE;
+  FUSILLI_ASSIGN_OR_RETURN(auto stride,
+                           generateStrideFromLayout(dims, opts.layout));
+
+  Graph graph;
+  graph.setName(std::format("benchmark_batchnorm_input{}_forw{}_layout{}_"
+                            "type{}_scale_bias{}_eps{}_momentum{}",
+                            opts.input, opts.forw, opts.layout, opts.type,
+                            opts.scaleBias, opts.eps, opts.momentum));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        auto xT =
+            g.tensor(TensorAttr().setName("x").setDim(dims).setStride(stride));
+        TensorList inputs = {xT};
+        // Shape and strides will be inferred later in inferPropertiesNode()
+        auto optionalInput = [&](bool enabled, const char *name) {
+          std::shared_ptr<TensorAttr> t = nullptr;
+          if (enabled)
+            inputs.push_back(t = g.tensor(TensorAttr().setName(name)));
+          return t;
+        };
+        auto sT = optionalInput(opts.scaleBias, "scale");
+        auto bT = optionalInput(opts.scaleBias, "bias");
+        // Inference normalizes with running statistics, training computes
+        // (and outputs) the batch statistics.
+        auto meanT = optionalInput(phase == NormFwdPhase::INFERENCE, "mean");
+        auto varT = optionalInput(phase == NormFwdPhase::INFERENCE, "var");
+        auto attr = BatchnormAttr()
+                        .setForwardPhase(phase)
+                        .setEpsilon(g.tensor(TensorAttr(opts.eps)))
+                        .setMomentum(g.tensor(TensorAttr(opts.momentum)))
+                        .setName("batchnorm_fwd");
+        auto [yT, smT, sivT] = g.batchnorm(xT, sT, bT, meanT, varT, attr);
+        yT->setName("y");
+        TensorList outputs = {yT};
+        if (phase == NormFwdPhase::TRAINING) {
+          smT->setName("saved_mean");
+          sivT->setName("saved_inv_variance");
+          outputs.insert(outputs.end(), {smT, sivT});
+        }
+        return std::pair{inputs, outputs};
+      });
+}
+
+static ErrorOr<BenchmarkResult>
+benchmarkBatchNormBwd(const BatchNormOptions &opts,
+                      const std::vector<int64_t> &dims, DataType ioType,
+                      const RunOptions &run, const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(auto stride,
+                           generateStrideFromLayout(dims, opts.layout));
+
+  Graph graph;
+  graph.setName(std::format("benchmark_batchnorm_input{}_forw{}_layout{}_"
+                            "type{}_scale_bias{}_relu{}",
+                            opts.input, opts.forw, opts.layout, opts.type,
+                            opts.scaleBias, opts.relu));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        auto fullInput = [&](const char *name) {
+          return g.tensor(
+              TensorAttr().setName(name).setDim(dims).setStride(stride));
+        };
+        auto dyT = fullInput("dy");
+        auto xT = fullInput("x");
+        // Shape and strides will be inferred later in inferPropertiesNode()
+        auto smT = g.tensor(TensorAttr().setName("saved_mean"));
+        auto sivT = g.tensor(TensorAttr().setName("saved_inv_variance"));
+        TensorList inputs = {dyT, xT, smT, sivT};
+        std::shared_ptr<TensorAttr> sT = nullptr;
+        if (opts.scaleBias)
+          inputs.push_back(sT = g.tensor(TensorAttr().setName("scale")));
+        auto attr = BatchnormBwdAttr().setName("batchnorm_bwd");
+        if (opts.relu) {
+          auto yT = fullInput("y");
+          inputs.push_back(yT);
+          attr.setY(yT);
+        }
+        auto [dxT, dsT, dbT] =
+            g.batchnormBackward(dyT, xT, sT, smT, sivT, attr);
+        dxT->setName("dx");
+        TensorList outputs = {dxT};
+        if (opts.scaleBias) {
+          dsT->setName("dscale");
+          dbT->setName("dbias");
+          outputs.insert(outputs.end(), {dsT, dbT});
+        }
+        return std::pair{inputs, outputs};
+      });
+}
+
+// Pre-norm attention block of a transformer layer, as one graph: RMSNorm,
+// fused QKV projection, split into heads, SDPA, output projection and
+// residual add. Tokens are rows of `x`, so the norm is per token.
+static ErrorOr<BenchmarkResult>
+benchmarkAttentionBlock(const AttentionBlockOptions &opts, DataType ioType,
+                        const RunOptions &run, const Handle &handle,
+                        bool dump) {
+  int64_t tokens = opts.batch * opts.seq;
+  int64_t hidden = opts.heads * opts.headDim;
+
+  Graph graph;
+  graph.setName(std::format(
+      "benchmark_attention_block_b{}_s{}_h{}_d{}_type{}_causal{}_eps{}",
+      opts.batch, opts.seq, opts.heads, opts.headDim, opts.type,
+      opts.isCausal, opts.eps));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        // Intermediates stay in the I/O type, as between the layers of a
+        // model.
+        g.setIntermediateDataType(ioType);
+        auto matrix = [&](const char *name, int64_t rows, int64_t cols) {
+          return g.tensor(TensorAttr()
+                              .setName(name)
+                              .setDim({rows, cols})
+                              .setStride({cols, 1}));
+        };
+        auto xT = matrix("x", tokens, hidden);
+        // Shape and strides will be inferred later in inferPropertiesNode()
+        auto scaleT = g.tensor(TensorAttr().setName("norm_scale"));
+        auto wQkvT = matrix("w_qkv", hidden, 3 * hidden);
+        auto wOutT = matrix("w_out", hidden, hidden);
+
+        auto normAttr = RmsnormAttr()
+                            .setForwardPhase(NormFwdPhase::INFERENCE)
+                            .setEpsilon(g.tensor(TensorAttr(opts.eps)))
+                            .setName("rmsnorm");
+        auto xNormT = g.rmsnorm(xT, scaleT, normAttr)[0];
+        auto qkvAttr = MatmulAttr().setName("qkv_proj");
+        auto qkvT = g.matmul(xNormT, wQkvT, qkvAttr);
+
+        // [tokens, hidden] columns `i` of QKV -> [batch, heads, seq, dim].
+        auto splitHeads = [&](int64_t i, const std::string &name) {
+          auto sliceAttr = SliceAttr()
+                               .setStart({0, i * hidden})
+                               .setEnd({tokens, (i + 1) * hidden})
+                               .setName(name + "_slice");
+          auto reshapeAttr =
+              ReshapeAttr()
+                  .setShape({opts.batch, opts.seq, opts.heads, opts.headDim})
+                  .setName(name + "_reshape");
+          auto permuteAttr =
+              PermuteAttr().setOrder({0, 2, 1, 3}).setName(name + "_heads");
+          return g.permute(g.reshape(g.slice(qkvT, sliceAttr), reshapeAttr),
+                           permuteAttr);
+        };
+        auto qT = splitHeads(0, "q");
+        auto kT = splitHeads(1, "k");
+        auto vT = splitHeads(2, "v");
+
+        auto sdpaAttr =
+            SdpaAttr().setIsCausal(opts.isCausal).setName("attention");
+        auto oT = g.sdpa(qT, kT, vT, /*mask=*/nullptr, sdpaAttr);
+        auto mergeAttr =
+            PermuteAttr().setOrder({0, 2, 1, 3}).setName("merge_heads");
+        auto flattenAttr =
+            ReshapeAttr().setShape({tokens, hidden}).setName("flatten");
+        auto attnT = g.reshape(g.permute(oT, mergeAttr), flattenAttr);
+
+        auto outAttr = MatmulAttr().setName("out_proj");
+        auto residualAttr = PointwiseAttr()
+                                .setMode(PointwiseAttr::Mode::ADD)
+                                .setName("residual");
+        auto yT = g.pointwise(g.matmul(attnT, wOutT, outAttr), xT,
+                              residualAttr);
+        yT->setName("y");
+        return std::pair{TensorList{xT, scaleT, wQkvT, wOutT}, TensorList{yT}};
+      });
+}
+
+// ResNet basic block, as one graph: two 3x3 convolutions, each followed by
+// inference batch normalization, with a ReLU in between and after the
+// residual add.
+static ErrorOr<BenchmarkResult>
+benchmarkResNetBlock(const ResNetBlockOptions &opts, DataType ioType,
+                     const RunOptions &run, const Handle &handle, bool dump) {
+  std::vector<int64_t> xDims = {opts.n, opts.c, opts.h, opts.w};
+  std::vector<int64_t> wDims = {opts.c, opts.c, 3, 3};
+  FUSILLI_ASSIGN_OR_RETURN(auto xStride,
+                           generateStrideFromLayout(xDims, opts.layout));
+  FUSILLI_ASSIGN_OR_RETURN(auto wStride,
+                           generateStrideFromLayout(wDims, opts.layout));
+
+  Graph graph;
+  graph.setName(std::format(
+      "benchmark_resnet_block_n{}_c{}_h{}_w{}_layout{}_type{}_eps{}", opts.n,
+      opts.c, opts.h, opts.w, opts.layout, opts.type, opts.eps));
+
+  return runMemoryBoundGraph(
+      graph, ioType, run, handle, dump, [&](Graph &g) {
+        // Intermediates stay in the I/O type, as between the layers of a
+        // model.
+        g.setIntermediateDataType(ioType);
+        auto xT = g.tensor(
+            TensorAttr().setName("x").setDim(xDims).setStride(xStride));
+        TensorList inputs = {xT};
+
+        // conv (3x3, same padding) -> batchnorm (inference) -> optional ReLU.
+        auto convBn = [&](const std::shared_ptr<TensorAttr> &inT, int i,
+                          bool relu) {
+          auto wT = g.tensor(TensorAttr()
+                                 .setName(std::format("conv{}_w", i))
+                                 .setDim(wDims)
+                                 .setStride(wStride));
+          inputs.push_back(wT);
+          auto convAttr = ConvFPropAttr()
+                              .setStride({1, 1})
+                              .setPadding({1, 1})
+                              .setDilation({1, 1})
+                              .setName(std::format("conv{}", i));
+          auto convT = g.convFProp(inT, wT, convAttr);
+
+          // Shape and strides will be inferred later in
+          // inferPropertiesNode()
+          auto bnInput = [&](const char *name) {
+            inputs.push_back(g.tensor(
+                TensorAttr().setName(std::format("bn{}_{}", i, name))));
+            return inputs.back();
+          };
+          auto sT = bnInput("scale");
+          auto bT = bnInput("bias");
+          auto meanT = bnInput("mean");
+          auto varT = bnInput("var");
+          auto bnAttr = BatchnormAttr()
+                            .setForwardPhase(NormFwdPhase::INFERENCE)
+                            .setEpsilon(g.tensor(TensorAttr(opts.eps)))
+                            .setMomentum(g.tensor(TensorAttr(0.1f)))
+                            .setName(std::format("bn{}", i));
+          auto yT = g.batchnorm(convT, sT, bT, meanT, varT, bnAttr)[0];
+          if (!relu)
+            return yT;
+          auto reluAttr = PointwiseAttr()
+                              .setMode(PointwiseAttr::Mode::RELU_FWD)
+                              .setName(std::format("relu{}", i));
+          return g.pointwise(yT, reluAttr);
+        };
+        auto hT = convBn(xT, 1, /*relu=*/true);
+        auto bnT = convBn(hT, 2, /*relu=*/false);
+
+        auto residualAttr = PointwiseAttr()
+                                .setMode(PointwiseAttr::Mode::ADD)
+                                .setName("residual");
+        auto reluAttr = PointwiseAttr()
+                            .setMode(PointwiseAttr::Mode::RELU_FWD)
+                            .setName("relu_out");
+        auto yT = g.pointwise(g.pointwise(bnT, xT, residualAttr), reluAttr);
+        yT->setName("y");
+        return std::pair{inputs, TensorList{yT}};
+      });
+}
+
+//===---------------------------------------------------------------------===//
+// CLI registration functions
+//===---------------------------------------------------------------------===//
+
+static CLI::App *registerConvOptions(CLI::App &mainApp, ConvOptions &convOpts) {
   // Conv flags are kept in sync with MIOpen's ConvDriver:
   // https://github.com/ROCm/rocm-libraries/blob/db0544fb61f2c7bd5a86dce98d4963420c1c741a/projects/miopen/driver/conv_driver.hpp#L878
   CLI::App *convApp =
@@ -880,9 +2740,10 @@ static CLI::App *registerConvOptions(CLI::App &mainApp, ConvOptions &convOpts) {
   // convApp CLI Options - bind to ConvOptions members
   convApp
       ->add_option("--mode,-F", convOpts.mode,
-                   "Conv mode: 1=forward, 2=data_grad, 4=weight_grad")
+                   "Conv mode: 1=forward, 2=data_grad, 4=weight_grad, "
+                   "0=all three (a training step)")
       ->required()
-      ->check(CLI::IsMember({1, 2, 4}));
+      ->check(CLI::IsMember({0, 1, 2, 4}));
   convApp->add_option("--batchsize,-n", convOpts.n, "Input batch size")
       ->required()
       ->check(kIsPositiveInteger);
@@ -951,9 +2812,10 @@ static CLI::App *registerConvOptions(CLI::App &mainApp, ConvOptions &convOpts) {
       ->check(kIsValidLayout);
   convApp
       ->add_option("--spatial_dim", convOpts.s,
-                   "Number of spatial dimensions (2 for conv2d, 3 for conv3d)")
+                   "Number of spatial dimensions (1 for conv1d, 2 for conv2d, "
+                   "3 for conv3d)")
       ->required()
-      ->check(CLI::IsMember({2, 3}));
+      ->check(CLI::IsMember({1, 2, 3}));
 
   // convApp CLI Flags:
   auto *f1 = convApp->add_flag("--fp16", convOpts.fp16, "Run fp16 convolution");
@@ -961,6 +2823,12 @@ static CLI::App *registerConvOptions(CLI::App &mainApp, ConvOptions &convOpts) {
   // Can't specify both flags.
   f1->excludes(f2);
   convApp->add_flag("--bias,-b", convOpts.bias, "Run with bias");
+  convApp
+      ->add_option("--conv_lowering", convOpts.lowering,
+                   "Forward conv lowering strategy: auto, direct, winograd "
+                   "or im2col")
+      ->default_val("auto")
+      ->check(kIsValidConvLowering);
 
   return convApp;
 }
@@ -985,15 +2853,13 @@ static CLI::App *registerLayerNormOptions(CLI::App &mainApp,
       ->required()
       ->check(kIsValidDataType);
   // TODO: Please add other kernel kinds here when they are supported:
-  // forward (1), backward input (2), backward weight (4),
-  // backward bias (8), full backward (14).
+  // backward input (2), backward weight (4), backward bias (8).
   layerNormApp
-      ->add_option(
-          "--forw,-F", layerNormOpts.forw,
-          "Kind of kernel to run: 1 - forward (training mode). Currently, "
-          "only one kernel type is supported.")
+      ->add_option("--forw,-F", layerNormOpts.forw,
+                   "Kind of kernel to run: 1 - forward (training mode), "
+                   "14 - full backward")
       ->required()
-      ->check(CLI::IsMember({1}));
+      ->check(CLI::IsMember({1, 14}));
   layerNormApp
       ->add_option("--layout,-l", layerNormOpts.layout, "Input/Output layout")
       ->required()
@@ -1035,14 +2901,16 @@ static CLI::App *registerMatmulOptions(CLI::App &mainApp,
       ->check(kIsPositiveInteger);
   matmulApp
       ->add_option("--a_type", matmulOpts.a_type,
-                   "Matrix A data type (f32, f16, bf16)")
+                   "Matrix A data type (f32, f16, bf16, or si8 and the "
+                   "f8 types for quantized matmuls)")
       ->required()
-      ->check(kIsValidDataType);
+      ->check(kIsValidMatmulDataType);
   matmulApp
       ->add_option("--b_type", matmulOpts.b_type,
-                   "Matrix B data type (f32, f16, bf16)")
+                   "Matrix B data type (f32, f16, bf16, or si4, si8 and the "
+                   "f8 types for quantized matmuls)")
       ->required()
-      ->check(kIsValidDataType);
+      ->check(kIsValidMatmulDataType);
   matmulApp
       ->add_option("--out_type", matmulOpts.out_type,
                    "Result data type (f32, f16, bf16)")
@@ -1052,6 +2920,41 @@ static CLI::App *registerMatmulOptions(CLI::App &mainApp,
       ->add_option("--bias_type", matmulOpts.bias_type,
                    "Bias data type (f32, f16, bf16)")
       ->check(kIsValidDataType);
+  matmulApp
+      ->add_option("--activation", matmulOpts.activation,
+                   "Epilogue activation (relu, sigmoid, tanh, gelu, gelu_tanh, "
+                   "silu)")
+      ->check(kIsValidActivation);
+  matmulApp
+      ->add_option("--gate", matmulOpts.gate,
+                   "Gated (GLU) matmul with this gate activation (e.g. silu "
+                   "for SwiGLU, gelu for GeGLU): B packs the gate and up "
+                   "projections [K, 2N] and the result is [M, N]")
+      ->check(kIsValidActivation);
+  matmulApp->add_option("--alpha", matmulOpts.alpha,
+                        "Epilogue scale applied to the product")
+      ->default_val(1.0f);
+  matmulApp->add_option("--beta", matmulOpts.beta,
+                        "Epilogue scale applied to the residual")
+      ->default_val(1.0f);
+  matmulApp
+      ->add_option("--dynamic_m", matmulOpts.dynamicM,
+                   "Compile the matmul with a dynamic M and compare it with "
+                   "static matmuls at each of these M (e.g. 1,16,128); the "
+                   "result is that of the dynamic matmul at -M")
+      ->delimiter(',')
+      ->check(kIsPositiveInteger);
+  matmulApp
+      ->add_option("--group_size", matmulOpts.groupSize,
+                   "Rows of K sharing a dequantization scale of an si4 "
+                   "matrix B (default: K, one scale per column)")
+      ->check(kIsPositiveInteger);
+  matmulApp
+      ->add_option("--split_k", matmulOpts.splitK,
+                   "Split the contraction dim K into this many slices "
+                   "computed in parallel and summed")
+      ->default_val(1)
+      ->check(kIsPositiveInteger);
 
   // matmulApp CLI Flags:
   matmulApp->add_flag("--transA", matmulOpts.transA, "Transpose matrix A");
@@ -1059,10 +2962,52 @@ static CLI::App *registerMatmulOptions(CLI::App &mainApp,
   matmulApp->add_flag(
       "--bias", matmulOpts.bias,
       "Add bias vector to result (after broadcasting to result shape)");
+  matmulApp->add_flag(
+      "--residual", matmulOpts.residual,
+      "Add residual tensor to result in the epilogue (fuses the bias too)");
 
   return matmulApp;
 }
 
+// Register grouped matmul options to CLI app
+static CLI::App *
+registerGroupedMatmulOptions(CLI::App &mainApp,
+                             GroupedMatmulOptions &groupedMatmulOpts) {
+  CLI::App *groupedMatmulApp = mainApp.add_subcommand(
+      "grouped_matmul",
+      "Fusilli Benchmark Grouped (Mixture-of-Experts) Matrix Multiplication");
+
+  // groupedMatmulApp CLI Options - bind to GroupedMatmulOptions members
+  groupedMatmulApp
+      ->add_option("--e,-E", groupedMatmulOpts.e, "Number of groups (experts)")
+      ->required()
+      ->check(kIsPositiveInteger);
+  groupedMatmulApp
+      ->add_option("--m,-M", groupedMatmulOpts.m,
+                   "Rows per group (padded capacity)")
+      ->required()
+      ->check(kIsPositiveInteger);
+  groupedMatmulApp
+      ->add_option("--n,-N", groupedMatmulOpts.n, "Matrix N dimension")
+      ->required()
+      ->check(kIsPositiveInteger);
+  groupedMatmulApp
+      ->add_option("--k,-K", groupedMatmulOpts.k, "Matrix K dimension")
+      ->required()
+      ->check(kIsPositiveInteger);
+  groupedMatmulApp
+      ->add_option("--type,-t", groupedMatmulOpts.type,
+                   "Data type (f32, f16, bf16)")
+      ->required()
+      ->check(kIsValidDataType);
+  groupedMatmulApp
+      ->add_option("--group_size", groupedMatmulOpts.groupSize,
+                   "Valid rows in every group (default: M)")
+      ->check(kIsPositiveInteger);
+
+  return groupedMatmulApp;
+}
+
 // Register SDPA options to CLI app
 static CLI::App *registerSdpaOptions(CLI::App &mainApp, SdpaOptions &sdpaOpts) {
   CLI::App *sdpaApp = mainApp.add_subcommand(
@@ -1096,6 +3041,17 @@ static CLI::App *registerSdpaOptions(CLI::App &mainApp, SdpaOptions &sdpaOpts) {
   sdpaApp->add_option("--dropout,-p", sdpaOpts.dropoutP, "Dropout probability")
       ->default_val(0.0f)
       ->check(CLI::Range(0.0f, 1.0f));
+  auto *blockSizeOpt =
+      sdpaApp
+          ->add_option("--block_size", sdpaOpts.blockSize,
+                       "Paged KV-cache block size (default: contiguous K/V)")
+          ->check(kIsPositiveInteger);
+  sdpaApp
+      ->add_option("--num_pages", sdpaOpts.numPages,
+                   "Pages in the paged K/V pools (default: batch * seq_kv / "
+                   "block_size)")
+      ->check(kIsPositiveInteger)
+      ->needs(blockSizeOpt);
 
   // sdpaApp CLI Flags:
   auto *maskFlag = sdpaApp->add_flag("--mask", sdpaOpts.hasAttnMask,
@@ -1107,75 +3063,382 @@ static CLI::App *registerSdpaOptions(CLI::App &mainApp, SdpaOptions &sdpaOpts) {
   sdpaApp->add_flag("--gqa", sdpaOpts.enableGqa,
                     "Enable grouped query attention (headsQ must be a "
                     "multiple of headsKV)");
+  sdpaApp
+      ->add_option("--head_dim_v", sdpaOpts.headDimV,
+                   "Head dimension of V and the output (default: head_dim)")
+      ->check(kIsPositiveInteger);
+  auto *varlenFlag =
+      sdpaApp->add_flag("--varlen", sdpaOpts.varlen,
+                        "Pack the batch as varlen sequences of seq_q / seq_kv "
+                        "tokens, with cumulative sequence offset tensors");
+  varlenFlag->excludes(maskFlag)->excludes(blockSizeOpt);
+  sdpaApp
+      ->add_flag("--dropout_rng", sdpaOpts.dropoutRng,
+                 "Draw the dropout mask from runtime seed and offset tensors "
+                 "(requires --dropout)")
+      ->excludes(varlenFlag);
+  sdpaApp
+      ->add_flag("--rope", sdpaOpts.rope,
+                 "Apply rotary position embedding tables to Q and K "
+                 "(requires seq_q == seq_kv)")
+      ->excludes(varlenFlag);
+  sdpaApp->add_flag("--stats", sdpaOpts.stats,
+                    "Also output the logsumexp STATS for the backward pass");
 
   return sdpaApp;
 }
 
-// Validate and run convolution benchmark
-static ErrorObject runConvBenchmark(const ConvOptions &convOpts, int64_t iter,
-                                    int64_t deviceId, bool dump) {
-  // Additional validation of convApp options (apart from default CLI checks)
-  if (convOpts.s == 2) {
-    // Reject 3D layouts for 2D conv
-    FUSILLI_RETURN_ERROR_IF(
-        convOpts.imageLayout.size() != 4 || convOpts.filterLayout.size() != 4 ||
-            convOpts.outputLayout.size() != 4,
-        ErrorCode::InvalidArgument,
-        "Detected at least one invalid {input, filter, output} "
-        "layout for 2D convolution.");
-  }
-  if (convOpts.s == 3) {
-    // Reject 2D layouts for 3D conv
-    FUSILLI_RETURN_ERROR_IF(
-        convOpts.imageLayout.size() != 5 || convOpts.filterLayout.size() != 5 ||
-            convOpts.outputLayout.size() != 5,
-        ErrorCode::InvalidArgument,
-        "Detected at least one invalid {input, filter, output} "
-        "layout for 3D convolution.");
-    // Reject default (sentinel) values for optional args in 3D conv
-    FUSILLI_RETURN_ERROR_IF(
-        convOpts.d == -1 || convOpts.z == -1 || convOpts.t == -1 ||
-            convOpts.o == -1 || convOpts.m == -1,
-        ErrorCode::InvalidArgument,
-        "Detected at least one of {in_d, fil_d, conv_stride_d, "
-        "pad_d, dilation_d} that was not set for 3D convolution.");
-  }
+// Register pointwise options to CLI app
+static CLI::App *registerPointwiseOptions(CLI::App &mainApp,
+                                          PointwiseOptions &pointwiseOpts) {
+  CLI::App *pointwiseApp =
+      mainApp.add_subcommand("pointwise", "Fusilli Benchmark Pointwise");
+
+  // pointwiseApp CLI Options - bind to PointwiseOptions members
+  pointwiseApp
+      ->add_option("--input,-X", pointwiseOpts.input,
+                   "Input tensor dimensions, shared by all inputs of binary "
+                   "and ternary modes")
+      ->required();
+  pointwiseApp
+      ->add_option("--type,-t", pointwiseOpts.type,
+                   "Pointwise data type (f32, f16, bf16)")
+      ->required()
+      ->check(kIsValidDataType);
+  pointwiseApp
+      ->add_option("--layout,-l", pointwiseOpts.layout, "Input/Output layout")
+      ->required()
+      ->check(kIsValidLayout);
+  pointwiseApp
+      ->add_option("--mode,-m", pointwiseOpts.mode,
+                   "Pointwise mode, lowercase (e.g. add, mul, relu_fwd)")
+      ->required();
 
-  // Validation of group count
-  FUSILLI_RETURN_ERROR_IF(
-      convOpts.c % convOpts.g != 0 || convOpts.k % convOpts.g != 0,
-      ErrorCode::InvalidArgument, "Detected invalid group count.");
+  return pointwiseApp;
+}
 
-  DataType convIOType;
-  if (convOpts.fp16)
-    convIOType = DataType::Half;
-  else if (convOpts.bf16)
-    convIOType = DataType::BFloat16;
-  else
-    // When unspecified, default to fp32 conv.
-    convIOType = DataType::Float;
+// Register reduction options to CLI app
+static CLI::App *registerReductionOptions(CLI::App &mainApp,
+                                          ReductionOptions &reductionOpts) {
+  CLI::App *reductionApp =
+      mainApp.add_subcommand("reduction", "Fusilli Benchmark Reduction");
 
-  ErrorObject status = ok();
-  if (convOpts.mode == 1) {
-    // Forward convolution
-    status = benchmarkConvFprop(convOpts, convIOType, iter, deviceId, dump);
-  } else if (convOpts.mode == 2) {
-    // Data gradient
-    status = benchmarkConvDGrad(convOpts, convIOType, iter, deviceId, dump);
-  } else if (convOpts.mode == 4) {
-    // Weight gradient
-    status = benchmarkConvWGrad(convOpts, convIOType, iter, deviceId, dump);
-  }
+  // reductionApp CLI Options - bind to ReductionOptions members
+  reductionApp
+      ->add_option("--input,-X", reductionOpts.input, "Input tensor dimensions")
+      ->required();
+  reductionApp
+      ->add_option("--output_dims,-Y", reductionOpts.outputDims,
+                   "Output tensor dimensions, 1 in the reduced dimensions "
+                   "(e.g. 16x64x1x1)")
+      ->required();
+  reductionApp
+      ->add_option("--type,-t", reductionOpts.type,
+                   "Reduction data type (f32, f16, bf16)")
+      ->required()
+      ->check(kIsValidDataType);
+  reductionApp
+      ->add_option("--layout,-l", reductionOpts.layout, "Input/Output layout")
+      ->required()
+      ->check(kIsValidLayout);
+  reductionApp
+      ->add_option("--mode,-m", reductionOpts.mode,
+                   "Reduction mode, lowercase (e.g. add, max, norm2, mean_var)")
+      ->required();
 
-  FUSILLI_CHECK_ERROR(status);
+  return reductionApp;
+}
 
-  return ok();
+// Register RMSNorm options to CLI app
+static CLI::App *registerRmsNormOptions(CLI::App &mainApp,
+                                        RmsNormOptions &rmsNormOpts) {
+  CLI::App *rmsNormApp = mainApp.add_subcommand(
+      "rmsnorm", "Fusilli Benchmark Root Mean Square Normalization");
+
+  // rmsNormApp CLI Options - bind to RmsNormOptions members
+  rmsNormApp
+      ->add_option("--input,-X", rmsNormOpts.input,
+                   "Input tensor dimensions. The shapes with rank 2 to 5 are "
+                   "supported.")
+      ->required();
+  rmsNormApp
+      ->add_option("--type,-t", rmsNormOpts.type,
+                   "RMSNorm data type (f32, f16, bf16)")
+      ->required()
+      ->check(kIsValidDataType);
+  rmsNormApp
+      ->add_option("--forw,-F", rmsNormOpts.forw,
+                   "Kind of kernel to run: 1 - forward training (also "
+                   "outputs inv_rms), 2 - forward inference, 14 - full "
+                   "backward")
+      ->required()
+      ->check(CLI::IsMember({1, 2, 14}));
+  rmsNormApp
+      ->add_option("--layout,-l", rmsNormOpts.layout, "Input/Output layout")
+      ->required()
+      ->check(kIsValidLayout);
+  rmsNormApp
+      ->add_option("--eps,-e", rmsNormOpts.eps, "Epsilon, 1e-5 by default")
+      ->default_val(1e-5f)
+      ->check(kIsPositiveDouble);
+
+  // rmsNormApp CLI flags:
+  rmsNormApp->add_flag("--scale", rmsNormOpts.scale,
+                       "Apply a learnable per-element scale initialized to a "
+                       "non-trivial value");
+
+  return rmsNormApp;
+}
+
+// Register BatchNorm options to CLI app
+static CLI::App *registerBatchNormOptions(CLI::App &mainApp,
+                                          BatchNormOptions &batchNormOpts) {
+  // BatchNorm `--forw` follows MIOpen's BatchNormDriver, where 1 is forward
+  // training and 2 forward inference. 0 runs the backward, which MIOpen
+  // selects with `-F 0 --back 1`.
+  CLI::App *batchNormApp = mainApp.add_subcommand(
+      "batchnorm", "Fusilli Benchmark Batch Normalization");
+
+  // batchNormApp CLI Options - bind to BatchNormOptions members
+  batchNormApp
+      ->add_option("--input,-X", batchNormOpts.input,
+                   "Input tensor dimensions. The shapes with rank 2 to 5 are "
+                   "supported.")
+      ->required();
+  batchNormApp
+      ->add_option("--type,-t", batchNormOpts.type,
+                   "BatchNorm data type (f32, f16, bf16)")
+      ->required()
+      ->check(kIsValidDataType);
+  batchNormApp
+      ->add_option("--forw,-F", batchNormOpts.forw,
+                   "Kind of kernel to run: 0 - backward (from the saved batch "
+                   "statistics), 1 - forward training (also outputs the batch "
+                   "statistics), 2 - forward inference")
+      ->required()
+      ->check(CLI::IsMember({0, 1, 2}));
+  batchNormApp
+      ->add_option("--layout,-l", batchNormOpts.layout, "Input/Output layout")
+      ->required()
+      ->check(kIsValidLayout);
+  batchNormApp
+      ->add_option("--eps,-e", batchNormOpts.eps, "Epsilon, 1e-5 by default")
+      ->default_val(1e-5f)
+      ->check(kIsPositiveDouble);
+  batchNormApp
+      ->add_option("--momentum", batchNormOpts.momentum,
+                   "Running statistics momentum, 0.1 by default")
+      ->default_val(0.1f)
+      ->check(CLI::Range(0.0f, 1.0f));
+
+  // batchNormApp CLI flags:
+  batchNormApp->add_flag("--scale_bias", batchNormOpts.scaleBias,
+                         "Apply learnable per-channel scale and bias "
+                         "initialized to non-trivial values");
+  batchNormApp->add_flag("--relu", batchNormOpts.relu,
+                         "Fuse the backward of a ReLU on the forward output "
+                         "(backward only)");
+
+  return batchNormApp;
+}
+
+// Register attention block options to CLI app
+static CLI::App *
+registerAttentionBlockOptions(CLI::App &mainApp,
+                              AttentionBlockOptions &attentionBlockOpts) {
+  CLI::App *attentionBlockApp = mainApp.add_subcommand(
+      "attention_block",
+      "Fusilli Benchmark Transformer Attention Block (RMSNorm, QKV "
+      "projection, SDPA, output projection and residual add)");
+
+  // attentionBlockApp CLI Options - bind to AttentionBlockOptions members
+  attentionBlockApp
+      ->add_option("--batch,-B", attentionBlockOpts.batch, "Batch size")
+      ->required()
+      ->check(kIsPositiveInteger);
+  attentionBlockApp
+      ->add_option("--seq,-S", attentionBlockOpts.seq, "Sequence length")
+      ->required()
+      ->check(kIsPositiveInteger);
+  attentionBlockApp
+      ->add_option("--heads", attentionBlockOpts.heads, "Number of heads")
+      ->required()
+      ->check(kIsPositiveInteger);
+  attentionBlockApp
+      ->add_option("--head_dim,-d", attentionBlockOpts.headDim,
+                   "Head dimension")
+      ->required()
+      ->check(kIsPositiveInteger);
+  attentionBlockApp
+      ->add_option("--type,-t", attentionBlockOpts.type,
+                   "Data type (f32, f16, bf16)")
+      ->required()
+      ->check(kIsValidDataType);
+  attentionBlockApp
+      ->add_option("--eps,-e", attentionBlockOpts.eps,
+                   "RMSNorm epsilon, 1e-5 by default")
+      ->default_val(1e-5f)
+      ->check(kIsPositiveDouble);
+
+  // attentionBlockApp CLI flags:
+  attentionBlockApp->add_flag("--causal", attentionBlockOpts.isCausal,
+                              "Use causal attention mask");
+
+  return attentionBlockApp;
+}
+
+// Register ResNet block options to CLI app
+static CLI::App *
+registerResNetBlockOptions(CLI::App &mainApp,
+                           ResNetBlockOptions &resNetBlockOpts) {
+  CLI::App *resNetBlockApp = mainApp.add_subcommand(
+      "resnet_block", "Fusilli Benchmark ResNet Basic Block (conv, "
+                      "batchnorm and ReLU, twice, with a residual add)");
+
+  // resNetBlockApp CLI Options - bind to ResNetBlockOptions members
+  resNetBlockApp
+      ->add_option("--batchsize,-n", resNetBlockOpts.n, "Input batch size")
+      ->required()
+      ->check(kIsPositiveInteger);
+  resNetBlockApp
+      ->add_option("--channels,-c", resNetBlockOpts.c,
+                   "Input (and output) channels")
+      ->required()
+      ->check(kIsPositiveInteger);
+  resNetBlockApp->add_option("--in_h,-H", resNetBlockOpts.h, "Input height")
+      ->required()
+      ->check(kIsPositiveInteger);
+  resNetBlockApp->add_option("--in_w,-W", resNetBlockOpts.w, "Input width")
+      ->required()
+      ->check(kIsPositiveInteger);
+  resNetBlockApp
+      ->add_option("--type,-t", resNetBlockOpts.type,
+                   "Data type (f32, f16, bf16)")
+      ->required()
+      ->check(kIsValidDataType);
+  resNetBlockApp
+      ->add_option("--layout,-l", resNetBlockOpts.layout,
+                   "Input/Output and filter layout")
+      ->required()
+      ->check(CLI::IsMember({"NCHW", "NHWC"}));
+  resNetBlockApp
+      ->add_option("--eps,-e", resNetBlockOpts.eps,
+                   "BatchNorm epsilon, 1e-5 by default")
+      ->default_val(1e-5f)
+      ->check(kIsPositiveDouble);
+
+  return resNetBlockApp;
+}
+
+// Register replay options to CLI app
+static CLI::App *registerReplayOptions(CLI::App &mainApp,
+                                       ReplayOptions &replayOpts) {
+  CLI::App *replayApp = mainApp.add_subcommand(
+      "replay", "Fusilli Benchmark Replay of an execution capture (see "
+                "ExecutionCapture)");
+
+  // replayApp CLI Options - bind to ReplayOptions members
+  replayApp
+      ->add_option("--capture", replayOpts.capture,
+                   "Capture file written by ExecutionCapture::write()")
+      ->required()
+      ->check(CLI::ExistingFile);
+
+  return replayApp;
+}
+
+// Validate and run convolution benchmark
+static ErrorOr<BenchmarkResult>
+runConvBenchmark(const ConvOptions &convOpts, const RunOptions &run,
+                 const Handle &handle, bool dump) {
+  // Additional validation of convApp options (apart from default CLI checks)
+  if (convOpts.s == 1) {
+    // Reject 2D/3D layouts for 1D conv
+    FUSILLI_RETURN_ERROR_IF(
+        convOpts.imageLayout.size() != 3 || convOpts.filterLayout.size() != 3 ||
+            convOpts.outputLayout.size() != 3,
+        ErrorCode::InvalidArgument,
+        "Detected at least one invalid {input, filter, output} "
+        "layout for 1D convolution.");
+    // A 1D conv runs along the width, reject a non-unit height
+    FUSILLI_RETURN_ERROR_IF(
+        convOpts.h != 1 || convOpts.y != 1 || convOpts.u != 1 ||
+            convOpts.p != 0 || convOpts.l != 1,
+        ErrorCode::InvalidArgument,
+        "Detected at least one of {in_h, fil_h, conv_stride_h, pad_h, "
+        "dilation_h} that is not a unit height for 1D convolution.");
+  }
+  if (convOpts.s == 2) {
+    // Reject 3D layouts for 2D conv
+    FUSILLI_RETURN_ERROR_IF(
+        convOpts.imageLayout.size() != 4 || convOpts.filterLayout.size() != 4 ||
+            convOpts.outputLayout.size() != 4,
+        ErrorCode::InvalidArgument,
+        "Detected at least one invalid {input, filter, output} "
+        "layout for 2D convolution.");
+  }
+  if (convOpts.s == 3) {
+    // Reject 2D layouts for 3D conv
+    FUSILLI_RETURN_ERROR_IF(
+        convOpts.imageLayout.size() != 5 || convOpts.filterLayout.size() != 5 ||
+            convOpts.outputLayout.size() != 5,
+        ErrorCode::InvalidArgument,
+        "Detected at least one invalid {input, filter, output} "
+        "layout for 3D convolution.");
+    // Reject default (sentinel) values for optional args in 3D conv
+    FUSILLI_RETURN_ERROR_IF(
+        convOpts.d == -1 || convOpts.z == -1 || convOpts.t == -1 ||
+            convOpts.o == -1 || convOpts.m == -1,
+        ErrorCode::InvalidArgument,
+        "Detected at least one of {in_d, fil_d, conv_stride_d, "
+        "pad_d, dilation_d} that was not set for 3D convolution.");
+  }
+
+  // Validation of group count
+  FUSILLI_RETURN_ERROR_IF(
+      convOpts.c % convOpts.g != 0 || convOpts.k % convOpts.g != 0,
+      ErrorCode::InvalidArgument, "Detected invalid group count.");
+
+  // Lowering hints only apply to forward convolutions
+  FUSILLI_RETURN_ERROR_IF(convOpts.lowering != "auto" && convOpts.mode != 1,
+                          ErrorCode::InvalidArgument,
+                          "Detected --conv_lowering for a conv mode other "
+                          "than forward.");
+
+  DataType convIOType;
+  if (convOpts.fp16)
+    convIOType = DataType::Half;
+  else if (convOpts.bf16)
+    convIOType = DataType::BFloat16;
+  else
+    // When unspecified, default to fp32 conv.
+    convIOType = DataType::Float;
+
+  if (convOpts.mode == 0) {
+    // Training step
+    FUSILLI_RETURN_ERROR_IF(
+        convOpts.bias || run.rotateBuffers > 1 || run.measureCompile > 0,
+        ErrorCode::InvalidArgument,
+        "-F 0 does not support --bias, --rotate-buffers or "
+        "--measure-compile");
+    return benchmarkConvTrainingStep(convOpts, convIOType, run, handle, dump);
+  }
+  if (convOpts.mode == 2) {
+    // Data gradient
+    return benchmarkConvDGrad(convOpts, convIOType, run, handle, dump);
+  }
+  if (convOpts.mode == 4) {
+    // Weight gradient
+    return benchmarkConvWGrad(convOpts, convIOType, run, handle, dump);
+  }
+  // Forward convolution (mode 1, the CLI rejects other modes)
+  return benchmarkConvFprop(convOpts, convIOType, run, handle, dump);
 }
 
 // Validate and run layernorm benchmark
-static ErrorObject runLayerNormBenchmark(const LayerNormOptions &layerNormOpts,
-                                         int64_t iter, int64_t deviceId,
-                                         bool dump) {
+static ErrorOr<BenchmarkResult>
+runLayerNormBenchmark(const LayerNormOptions &layerNormOpts,
+                      const RunOptions &run, const Handle &handle, bool dump) {
   // Parse dimensions string into vector
   auto dims = parseDimensionsFromString(layerNormOpts.input);
   FUSILLI_RETURN_ERROR_IF(std::any_of(dims.begin(), dims.end(),
@@ -1194,23 +3457,37 @@ static ErrorObject runLayerNormBenchmark(const LayerNormOptions &layerNormOpts,
   // Parse data type strings using direct map lookup
   DataType type = kMlirTypeAsmToDataType.at(layerNormOpts.type);
 
-  ErrorObject status =
-      benchmarkLayerNormFwd(layerNormOpts, dims, type, iter, deviceId, dump);
-
-  FUSILLI_CHECK_ERROR(status);
-
-  return ok();
+  if (layerNormOpts.forw == 14)
+    return benchmarkLayerNormBwd(layerNormOpts, dims, type, run, handle, dump);
+  return benchmarkLayerNormFwd(layerNormOpts, dims, type, run, handle, dump);
 }
 
 // Validate and run matmul benchmark
-static ErrorObject runMatmulBenchmark(const MatmulOptions &matmulOpts,
-                                      int64_t iter, int64_t deviceId,
-                                      bool dump) {
+static ErrorOr<BenchmarkResult>
+runMatmulBenchmark(const MatmulOptions &matmulOpts, const RunOptions &run,
+                   const Handle &handle, bool dump) {
   // Validate that bias_type is set when --bias is used
   FUSILLI_RETURN_ERROR_IF(
       matmulOpts.bias && matmulOpts.bias_type.empty(),
       ErrorCode::InvalidArgument,
       "bias_type must be specified when --bias flag is set");
+  FUSILLI_RETURN_ERROR_IF(
+      matmulOpts.beta != 1.0f && !matmulOpts.residual,
+      ErrorCode::InvalidArgument,
+      "--residual must be specified when --beta is set");
+  FUSILLI_RETURN_ERROR_IF(
+      !matmulOpts.dynamicM.empty() &&
+          (matmulOpts.transA || matmulOpts.bias || matmulOpts.residual ||
+           !matmulOpts.activation.empty() || matmulOpts.alpha != 1.0f),
+      ErrorCode::InvalidArgument,
+      "--dynamic_m does not support --transA, --bias or an epilogue");
+  FUSILLI_RETURN_ERROR_IF(
+      !matmulOpts.gate.empty() &&
+          (matmulOpts.bias || matmulOpts.residual ||
+           !matmulOpts.activation.empty() || matmulOpts.alpha != 1.0f ||
+           !matmulOpts.dynamicM.empty()),
+      ErrorCode::InvalidArgument,
+      "--gate does not support --bias, an epilogue or --dynamic_m");
 
   // Parse data type strings using direct map lookup
   DataType aType = kMlirTypeAsmToDataType.at(matmulOpts.a_type);
@@ -1221,17 +3498,65 @@ static ErrorObject runMatmulBenchmark(const MatmulOptions &matmulOpts,
     biasType = kMlirTypeAsmToDataType.at(matmulOpts.bias_type);
   }
 
-  ErrorObject status = benchmarkMatmul(matmulOpts, aType, bType, outType,
-                                       biasType, iter, deviceId, dump);
+  if (isQuantizedType(aType) || isQuantizedType(bType)) {
+    FUSILLI_RETURN_ERROR_IF(
+        matmulOpts.transA || matmulOpts.transB || matmulOpts.bias ||
+            matmulOpts.residual || !matmulOpts.activation.empty() ||
+            matmulOpts.alpha != 1.0f || !matmulOpts.dynamicM.empty() ||
+            !matmulOpts.gate.empty(),
+        ErrorCode::InvalidArgument,
+        "Quantized matmuls do not support --transA, --transB, --bias, an "
+        "epilogue, --gate or --dynamic_m");
+    bool isInt4Weights =
+        bType == DataType::Int4 &&
+        (aType == DataType::Half || aType == DataType::BFloat16);
+    FUSILLI_RETURN_ERROR_IF(
+        !isInt4Weights && (aType != bType || bType == DataType::Int4),
+        ErrorCode::InvalidArgument,
+        "Quantized matmuls take si8 or f8 A and B of one type, or f16 / "
+        "bf16 A and si4 B");
+    FUSILLI_RETURN_ERROR_IF(
+        isInt4Weights && (outType != aType || matmulOpts.b != 1),
+        ErrorCode::InvalidArgument,
+        "Matmuls with si4 B require --out_type equal to --a_type and -B 1");
+    FUSILLI_RETURN_ERROR_IF(
+        matmulOpts.groupSize != 0 &&
+            (!isInt4Weights || matmulOpts.k % matmulOpts.groupSize != 0),
+        ErrorCode::InvalidArgument,
+        "--group_size requires si4 B and must divide K");
+    return benchmarkQuantizedMatmul(matmulOpts, aType, bType, outType, run,
+                                    handle, dump);
+  }
+  FUSILLI_RETURN_ERROR_IF(matmulOpts.groupSize != 0,
+                          ErrorCode::InvalidArgument,
+                          "--group_size requires si4 B");
+  if (!matmulOpts.dynamicM.empty())
+    return benchmarkMatmulDynamicM(matmulOpts, aType, bType, outType, run,
+                                   handle, dump);
+  return benchmarkMatmul(matmulOpts, aType, bType, outType, biasType, run,
+                         handle, dump);
+}
+
+// Validate and run grouped matmul benchmark
+static ErrorOr<BenchmarkResult>
+runGroupedMatmulBenchmark(const GroupedMatmulOptions &groupedMatmulOpts,
+                          const RunOptions &run, const Handle &handle,
+                          bool dump) {
+  FUSILLI_RETURN_ERROR_IF(
+      groupedMatmulOpts.groupSize > groupedMatmulOpts.m,
+      ErrorCode::InvalidArgument,
+      "Grouped matmul requires group_size to be at most M.");
 
-  FUSILLI_CHECK_ERROR(status);
+  DataType ioType = kMlirTypeAsmToDataType.at(groupedMatmulOpts.type);
 
-  return ok();
+  return benchmarkGroupedMatmul(groupedMatmulOpts, ioType, run, handle, dump);
 }
 
 // Run SDPA benchmark
-static ErrorObject runSdpaBenchmark(const SdpaOptions &sdpaOpts, int64_t iter,
-                                    int64_t deviceId, bool dump) {
+static ErrorOr<BenchmarkResult> runSdpaBenchmark(const SdpaOptions &sdpaOpts,
+                                                 const RunOptions &run,
+                                                 const Handle &handle,
+                                                 bool dump) {
   if (sdpaOpts.enableGqa) {
     // GQA constraint: query heads must be a multiple of KV heads.
     FUSILLI_RETURN_ERROR_IF(sdpaOpts.headsQ % sdpaOpts.headsKV != 0,
@@ -1244,97 +3569,1323 @@ static ErrorObject runSdpaBenchmark(const SdpaOptions &sdpaOpts, int64_t iter,
         "MHA requires headsQ == headsKV (use --gqa for grouped query "
         "attention).");
   }
+  FUSILLI_RETURN_ERROR_IF(
+      sdpaOpts.blockSize > 0 && sdpaOpts.seqKV % sdpaOpts.blockSize != 0,
+      ErrorCode::InvalidArgument,
+      "Paged SDPA requires seq_kv to be a multiple of block_size.");
+  FUSILLI_RETURN_ERROR_IF(sdpaOpts.dropoutRng && sdpaOpts.dropoutP == 0.0f,
+                          ErrorCode::InvalidArgument,
+                          "--dropout_rng requires a non-zero --dropout.");
 
   DataType sdpaIOType = kMlirTypeAsmToDataType.at(sdpaOpts.type);
 
-  ErrorObject status =
-      benchmarkSdpaFwd(sdpaOpts, sdpaIOType, iter, deviceId, dump);
+  return benchmarkSdpaFwd(sdpaOpts, sdpaIOType, run, handle, dump);
+}
 
-  FUSILLI_CHECK_ERROR(status);
+// Parses the dimensions of a norm, pointwise or reduction benchmark and
+// checks them against `layout`.
+static ErrorOr<std::vector<int64_t>>
+parseLayoutDimensions(const std::string &dimStr, const std::string &layout) {
+  auto dims = parseDimensionsFromString(dimStr);
+  FUSILLI_RETURN_ERROR_IF(std::any_of(dims.begin(), dims.end(),
+                                      [](int64_t dim) { return dim <= 0; }),
+                          ErrorCode::InvalidArgument,
+                          "Invalid dimensions: they must be positive");
+  FUSILLI_RETURN_ERROR_IF(dims.size() < 2 || dims.size() > 5,
+                          ErrorCode::InvalidArgument,
+                          "Dimensions must have rank between 2 and 5");
+  FUSILLI_RETURN_ERROR_IF(dims.size() != layout.size(),
+                          ErrorCode::InvalidArgument,
+                          "Dimensions and layout must have the same rank");
+  return ok(dims);
+}
 
-  return ok();
+// Validate and run pointwise benchmark
+static ErrorOr<BenchmarkResult>
+runPointwiseBenchmark(const PointwiseOptions &pointwiseOpts,
+                      const RunOptions &run, const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto dims,
+      parseLayoutDimensions(pointwiseOpts.input, pointwiseOpts.layout));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto mode,
+      getModeFromName(PointwiseAttr::kModeToStr, pointwiseOpts.mode));
+  FUSILLI_RETURN_ERROR_IF(mode == PointwiseAttr::Mode::NOT_SET,
+                          ErrorCode::InvalidArgument,
+                          "Pointwise mode must be set");
+
+  DataType type = kMlirTypeAsmToDataType.at(pointwiseOpts.type);
+
+  return benchmarkPointwise(pointwiseOpts, dims, type, mode, run, handle,
+                            dump);
+}
+
+// Validate and run reduction benchmark
+static ErrorOr<BenchmarkResult>
+runReductionBenchmark(const ReductionOptions &reductionOpts,
+                      const RunOptions &run, const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto xDims,
+      parseLayoutDimensions(reductionOpts.input, reductionOpts.layout));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto yDims,
+      parseLayoutDimensions(reductionOpts.outputDims, reductionOpts.layout));
+  for (size_t i = 0; i < xDims.size(); ++i)
+    FUSILLI_RETURN_ERROR_IF(
+        yDims[i] != xDims[i] && yDims[i] != 1, ErrorCode::InvalidArgument,
+        "Output dimensions must match the input or be 1 (reduced)");
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto mode,
+      getModeFromName(ReductionAttr::kModeToStr, reductionOpts.mode));
+  // SUM is a deprecated alias of ADD.
+  FUSILLI_RETURN_ERROR_IF(
+      mode == ReductionAttr::Mode::NOT_SET || mode == ReductionAttr::Mode::SUM,
+      ErrorCode::InvalidArgument, "Reduction mode must be set (and not sum)");
+
+  DataType type = kMlirTypeAsmToDataType.at(reductionOpts.type);
+
+  return benchmarkReduction(reductionOpts, xDims, yDims, type, mode, run,
+                            handle, dump);
+}
+
+// Validate and run RMSNorm benchmark
+static ErrorOr<BenchmarkResult>
+runRmsNormBenchmark(const RmsNormOptions &rmsNormOpts, const RunOptions &run,
+                    const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto dims, parseLayoutDimensions(rmsNormOpts.input, rmsNormOpts.layout));
+
+  DataType type = kMlirTypeAsmToDataType.at(rmsNormOpts.type);
+
+  if (rmsNormOpts.forw == 14)
+    return benchmarkRmsNormBwd(rmsNormOpts, dims, type, run, handle, dump);
+  return benchmarkRmsNormFwd(rmsNormOpts, dims, type, run, handle, dump);
+}
+
+// Validate and run BatchNorm benchmark
+static ErrorOr<BenchmarkResult>
+runBatchNormBenchmark(const BatchNormOptions &batchNormOpts,
+                      const RunOptions &run, const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto dims,
+      parseLayoutDimensions(batchNormOpts.input, batchNormOpts.layout));
+
+  DataType type = kMlirTypeAsmToDataType.at(batchNormOpts.type);
+
+  FUSILLI_RETURN_ERROR_IF(batchNormOpts.relu && batchNormOpts.forw != 0,
+                          ErrorCode::InvalidArgument,
+                          "--relu is only supported with the backward (-F 0)");
+
+  if (batchNormOpts.forw == 0)
+    return benchmarkBatchNormBwd(batchNormOpts, dims, type, run, handle, dump);
+  return benchmarkBatchNormFwd(batchNormOpts, dims, type, run, handle, dump);
+}
+
+// Run attention block benchmark
+static ErrorOr<BenchmarkResult>
+runAttentionBlockBenchmark(const AttentionBlockOptions &attentionBlockOpts,
+                           const RunOptions &run, const Handle &handle,
+                           bool dump) {
+  DataType type = kMlirTypeAsmToDataType.at(attentionBlockOpts.type);
+
+  return benchmarkAttentionBlock(attentionBlockOpts, type, run, handle, dump);
+}
+
+// Run ResNet block benchmark
+static ErrorOr<BenchmarkResult>
+runResNetBlockBenchmark(const ResNetBlockOptions &resNetBlockOpts,
+                        const RunOptions &run, const Handle &handle,
+                        bool dump) {
+  DataType type = kMlirTypeAsmToDataType.at(resNetBlockOpts.type);
+
+  return benchmarkResNetBlock(resNetBlockOpts, type, run, handle, dump);
+}
+
+// Replay an execution capture: its graph is loaded from the captured
+// artifact, or compiled on a backend other than the captured one, and run on
+// the captured buffers.
+static ErrorOr<BenchmarkResult>
+runReplayBenchmark(const ReplayOptions &replayOpts, const RunOptions &run,
+                   const Handle &handle, bool dump) {
+  FUSILLI_ASSIGN_OR_RETURN(ExecutionCapture capture,
+                           ExecutionCapture::read(replayOpts.capture));
+  bool recompile =
+      capture.artifact.empty() || capture.backend != handle.getBackend();
+  std::cout << "Replaying graph '" << capture.graphName << "' (fingerprint "
+            << capture.fingerprint << ", " << capture.buffers.size()
+            << " buffers, " << (recompile ? "recompiled" : "captured artifact")
+            << ")" << std::endl;
+
+  CompileReport report;
+  FUSILLI_ASSIGN_OR_RETURN(std::unique_ptr<Graph> graph,
+                           capture.loadGraph(handle, /*remove=*/!dump,
+                                             &report));
+  FUSILLI_ASSIGN_OR_RETURN(auto variantPack,
+                           capture.allocateBuffers(handle, *graph));
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_ASSIGN_OR_RETURN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph `run.warmup` + `run.iter` times.
+  return runIterations(*graph, handle, variantPack, workspace, run, report,
+                       workspaceSize);
 }
 
 //===---------------------------------------------------------------------===//
-// Main function
+// Driver command line
 //===---------------------------------------------------------------------===//
 
-static int benchmark(int argc, char **argv) {
-  CLI::App mainApp{"Fusilli Benchmark Driver"};
-  mainApp.require_subcommand(1);
+// Options and sub-commands of one benchmark command line.
+struct DriverOptions {
+  ConvOptions conv;
+  MatmulOptions matmul;
+  GroupedMatmulOptions groupedMatmul;
+  LayerNormOptions layerNorm;
+  SdpaOptions sdpa;
+  PointwiseOptions pointwise;
+  ReductionOptions reduction;
+  RmsNormOptions rmsNorm;
+  BatchNormOptions batchNorm;
+  AttentionBlockOptions attentionBlock;
+  ResNetBlockOptions resNetBlock;
+  ReplayOptions replay;
+
+  RunOptions run;
+  int64_t deviceId;
+  bool dump{false};
 
-  // Create option objects
-  ConvOptions convOpts;
-  MatmulOptions matmulOpts;
-  LayerNormOptions layerNormOpts;
-  SdpaOptions sdpaOpts;
+  CLI::App *convApp, *matmulApp, *groupedMatmulApp, *layerNormApp, *sdpaApp,
+      *pointwiseApp, *reductionApp, *rmsNormApp, *batchNormApp,
+      *attentionBlockApp, *resNetBlockApp, *replayApp;
 
-  // Shared options between subcommands
-  int64_t iter, deviceId;
-  bool dump{false};
+  std::vector<CLI::App *> subcommands() const {
+    return {convApp,           matmulApp,      groupedMatmulApp,
+            layerNormApp,      sdpaApp,        pointwiseApp,
+            reductionApp,      rmsNormApp,     batchNormApp,
+            attentionBlockApp, resNetBlockApp, replayApp};
+  }
+};
 
+// Registers the options shared between subcommands and the subcommands on
+// `app`. Returns the `--iter` option, required unless in batch mode.
+static CLI::Option *registerDriverOptions(CLI::App &app, DriverOptions &opts) {
   // mainApp CLI Options - shared between subcommands
-  mainApp.add_option("--iter,-i", iter, "Benchmark iterations")
-      ->required()
+  CLI::Option *iterOpt =
+      app.add_option("--iter,-i", opts.run.iter, "Timed benchmark iterations")
+          ->check(kIsPositiveInteger);
+  app.add_option("--warmup,-w", opts.run.warmup,
+                 "Untimed warm-up iterations run before the timed ones")
+      ->default_val("0")
+      ->check(kIsNonNegativeInteger);
+  app.add_option("--measure-compile", opts.run.measureCompile,
+                 "Also time validation, assembly emission, compilation "
+                 "(cache miss and hit) and artifact loading of the graph from "
+                 "scratch, over this many repetitions")
+      ->default_val("0")
+      ->check(kIsNonNegativeInteger);
+  app.add_option("--rotate-buffers", opts.run.rotateBuffers,
+                 "Cycle the iterations through this many sets of input and "
+                 "output buffers, so they don't stay hot in the caches")
+      ->default_val("1")
       ->check(kIsPositiveInteger);
-  mainApp
-      .add_option("--device,-D", deviceId,
-                  "AMDGPU Device ID (ignored for CPU backend)")
+  app.add_option("--device,-D", opts.deviceId,
+                 "AMDGPU Device ID (ignored for CPU backend)")
       ->default_val("0")
       ->check(kIsNonNegativeInteger);
 
   // mainApp CLI Flags:
-  mainApp.add_flag("--dump,-d", dump,
-                   "Dump compilation artifacts to disk at "
-                   "'${FUSILLI_CACHE_DIR}/.cache/fusilli'. "
-                   "When not set, it defaults to '${HOME}/.cache/fusilli'.");
+  app.add_flag("--flush-l2", opts.run.flushL2,
+               "Flush the caches before every timed iteration by overwriting "
+               "a 512 MiB scratch buffer");
+  app.add_flag("--cpu-perf", opts.run.cpuPerformance,
+               "Compile for the CPU backend with data-tiled matmuls and "
+               "convolutions, microkernels and constant weights pre-packed at "
+               "compile time (ignored for AMDGPU backend)");
+  app.add_flag("--reference", opts.run.reference,
+               "Also run matmuls through hipBLASLt and forward convolutions "
+               "through MIOpen, and report their speed ratio and output "
+               "difference (needs a -DFUSILLI_BENCHMARK_REFERENCE=ON build)");
+  app.add_flag("--dump,-d", opts.dump,
+               "Dump compilation artifacts to disk at "
+               "'${FUSILLI_CACHE_DIR}/.cache/fusilli'. "
+               "When not set, it defaults to '${HOME}/.cache/fusilli'.");
 
   // Register subcommands
-  CLI::App *convApp = registerConvOptions(mainApp, convOpts);
-  CLI::App *matmulApp = registerMatmulOptions(mainApp, matmulOpts);
-  CLI::App *layerNormApp = registerLayerNormOptions(mainApp, layerNormOpts);
-  CLI::App *sdpaApp = registerSdpaOptions(mainApp, sdpaOpts);
+  opts.convApp = registerConvOptions(app, opts.conv);
+  opts.matmulApp = registerMatmulOptions(app, opts.matmul);
+  opts.groupedMatmulApp =
+      registerGroupedMatmulOptions(app, opts.groupedMatmul);
+  opts.layerNormApp = registerLayerNormOptions(app, opts.layerNorm);
+  opts.sdpaApp = registerSdpaOptions(app, opts.sdpa);
+  opts.pointwiseApp = registerPointwiseOptions(app, opts.pointwise);
+  opts.reductionApp = registerReductionOptions(app, opts.reduction);
+  opts.rmsNormApp = registerRmsNormOptions(app, opts.rmsNorm);
+  opts.batchNormApp = registerBatchNormOptions(app, opts.batchNorm);
+  opts.attentionBlockApp =
+      registerAttentionBlockOptions(app, opts.attentionBlock);
+  opts.resNetBlockApp = registerResNetBlockOptions(app, opts.resNetBlock);
+  opts.replayApp = registerReplayOptions(app, opts.replay);
+  return iterOpt;
+}
+
+// Runs the benchmark of the parsed subcommand of `opts` on `handle`.
+static ErrorOr<BenchmarkResult> runSubcommand(const DriverOptions &opts,
+                                              const Handle &handle) {
+  if (opts.convApp->parsed())
+    return runConvBenchmark(opts.conv, opts.run, handle, opts.dump);
+  if (opts.layerNormApp->parsed())
+    return runLayerNormBenchmark(opts.layerNorm, opts.run, handle, opts.dump);
+  if (opts.matmulApp->parsed())
+    return runMatmulBenchmark(opts.matmul, opts.run, handle, opts.dump);
+  if (opts.groupedMatmulApp->parsed())
+    return runGroupedMatmulBenchmark(opts.groupedMatmul, opts.run, handle,
+                                     opts.dump);
+  if (opts.sdpaApp->parsed())
+    return runSdpaBenchmark(opts.sdpa, opts.run, handle, opts.dump);
+  if (opts.pointwiseApp->parsed())
+    return runPointwiseBenchmark(opts.pointwise, opts.run, handle, opts.dump);
+  if (opts.reductionApp->parsed())
+    return runReductionBenchmark(opts.reduction, opts.run, handle, opts.dump);
+  if (opts.rmsNormApp->parsed())
+    return runRmsNormBenchmark(opts.rmsNorm, opts.run, handle, opts.dump);
+  if (opts.batchNormApp->parsed())
+    return runBatchNormBenchmark(opts.batchNorm, opts.run, handle, opts.dump);
+  if (opts.attentionBlockApp->parsed())
+    return runAttentionBlockBenchmark(opts.attentionBlock, opts.run, handle,
+                                      opts.dump);
+  if (opts.resNetBlockApp->parsed())
+    return runResNetBlockBenchmark(opts.resNetBlock, opts.run, handle,
+                                   opts.dump);
+  if (opts.replayApp->parsed())
+    return runReplayBenchmark(opts.replay, opts.run, handle, opts.dump);
+  return error(ErrorCode::InvalidArgument, "No benchmark sub-command given");
+}
+
+// Returns the number of elements of the "AxBxC" dimensions `dimStr`.
+static double getElementCount(const std::string &dimStr) {
+  double count = 1.0;
+  for (int64_t dim : parseDimensionsFromString(dimStr))
+    count *= static_cast<double>(dim);
+  return count;
+}
+
+// Returns the floating point operations of one execution of the parsed
+// subcommand of `opts`. Multiply-adds count as two operations; memory-bound
+// operations count their per-element arithmetic, which is approximate but
+// only matters relative to their (far higher) bandwidth bound. Replays are
+// of unknown graphs, and report their bandwidth only.
+static double getFlops(const DriverOptions &opts) {
+  if (opts.convApp->parsed()) {
+    // Data and weight gradients perform the same multiply-adds as forward.
+    const ConvOptions &c = opts.conv;
+    auto xDims = (c.s == 2) ? std::vector<int64_t>{c.n, c.c, c.h, c.w}
+                            : std::vector<int64_t>{c.n, c.c, c.d, c.h, c.w};
+    auto wDims = (c.s == 2)
+                     ? std::vector<int64_t>{c.k, c.c / c.g, c.y, c.x}
+                     : std::vector<int64_t>{c.k, c.c / c.g, c.z, c.y, c.x};
+    auto dilation = (c.s == 2) ? std::vector<int64_t>{c.l, c.j}
+                               : std::vector<int64_t>{c.m, c.l, c.j};
+    auto padding = (c.s == 2) ? std::vector<int64_t>{c.p, c.q}
+                              : std::vector<int64_t>{c.o, c.p, c.q};
+    auto stride = (c.s == 2) ? std::vector<int64_t>{c.u, c.v}
+                             : std::vector<int64_t>{c.t, c.u, c.v};
+    double flops = 2.0;
+    for (int64_t dim : getConvInferredOutputShape(xDims, wDims, dilation,
+                                                  padding, stride))
+      flops *= static_cast<double>(dim);
+    // Every output element reduces over C/G input channels and the filter.
+    for (size_t i = 1; i < wDims.size(); ++i)
+      flops *= static_cast<double>(wDims[i]);
+    // A training step (`-F 0`) runs all three.
+    return c.mode == 0 ? 3.0 * flops : flops;
+  }
+  if (opts.matmulApp->parsed()) {
+    const MatmulOptions &mm = opts.matmul;
+    // A gated matmul multiplies by both the gate and up projections.
+    int64_t n = mm.gate.empty() ? mm.n : 2 * mm.n;
+    return 2.0 * static_cast<double>(mm.b) * static_cast<double>(mm.m) *
+           static_cast<double>(n) * static_cast<double>(mm.k);
+  }
+  if (opts.groupedMatmulApp->parsed()) {
+    // Only the valid rows of every group are multiplied.
+    const GroupedMatmulOptions &gm = opts.groupedMatmul;
+    int64_t rows = gm.groupSize > 0 ? gm.groupSize : gm.m;
+    return 2.0 * static_cast<double>(gm.e) * static_cast<double>(rows) *
+           static_cast<double>(gm.n) * static_cast<double>(gm.k);
+  }
+  if (opts.sdpaApp->parsed()) {
+    // Two matmuls (Q * K^T and P * V) per query head; causal masking skips
+    // about half of them.
+    const SdpaOptions &a = opts.sdpa;
+    int64_t headDimV = a.headDimV > 0 ? a.headDimV : a.headDim;
+    double flops = 2.0 * static_cast<double>(a.batch) *
+                   static_cast<double>(a.headsQ) *
+                   static_cast<double>(a.seqQ) * static_cast<double>(a.seqKV) *
+                   static_cast<double>(a.headDim + headDimV);
+    return a.isCausal ? flops / 2.0 : flops;
+  }
+  if (opts.layerNormApp->parsed())
+    return getElementCount(opts.layerNorm.input) *
+           (opts.layerNorm.elementwiseAffine ? 7.0 : 5.0);
+  if (opts.rmsNormApp->parsed())
+    return getElementCount(opts.rmsNorm.input) *
+           (opts.rmsNorm.scale ? 4.0 : 3.0);
+  if (opts.batchNormApp->parsed())
+    return getElementCount(opts.batchNorm.input) *
+           (opts.batchNorm.scaleBias ? 7.0 : 5.0);
+  if (opts.pointwiseApp->parsed())
+    return getElementCount(opts.pointwise.input);
+  if (opts.reductionApp->parsed())
+    return getElementCount(opts.reduction.input);
+  if (opts.attentionBlockApp->parsed()) {
+    // QKV and output projections, SDPA as above, and the per-element norm
+    // and residual add.
+    const AttentionBlockOptions &a = opts.attentionBlock;
+    double tokens = static_cast<double>(a.batch) * static_cast<double>(a.seq);
+    double hidden =
+        static_cast<double>(a.heads) * static_cast<double>(a.headDim);
+    double sdpa = 4.0 * tokens * static_cast<double>(a.seq) * hidden;
+    return 2.0 * tokens * hidden * 4.0 * hidden +
+           (a.isCausal ? sdpa / 2.0 : sdpa) + 5.0 * tokens * hidden;
+  }
+  if (opts.resNetBlockApp->parsed()) {
+    // Two 3x3 same-padded convolutions, and the per-element batchnorms,
+    // ReLUs and residual add.
+    const ResNetBlockOptions &r = opts.resNetBlock;
+    double elements = static_cast<double>(r.n) * static_cast<double>(r.c) *
+                      static_cast<double>(r.h) * static_cast<double>(r.w);
+    return 2.0 * 2.0 * elements * static_cast<double>(r.c) * 9.0 +
+           9.0 * elements;
+  }
+  return 0.0;
+}
+
+// Returns whether the parsed subcommand of `opts` computes in 16-bit floating
+// point, and so is bound by the f16 rather than the f32 peak.
+static bool isHalfPrecision(const DriverOptions &opts) {
+  if (opts.convApp->parsed())
+    return opts.conv.fp16 || opts.conv.bf16;
+  if (opts.matmulApp->parsed())
+    return opts.matmul.a_type != "f32";
+  for (auto [app, type] :
+       {std::pair{opts.groupedMatmulApp, &opts.groupedMatmul.type},
+        std::pair{opts.layerNormApp, &opts.layerNorm.type},
+        std::pair{opts.sdpaApp, &opts.sdpa.type},
+        std::pair{opts.pointwiseApp, &opts.pointwise.type},
+        std::pair{opts.reductionApp, &opts.reduction.type},
+        std::pair{opts.rmsNormApp, &opts.rmsNorm.type},
+        std::pair{opts.batchNormApp, &opts.batchNorm.type},
+        std::pair{opts.attentionBlockApp, &opts.attentionBlock.type},
+        std::pair{opts.resNetBlockApp, &opts.resNetBlock.type}})
+    if (app->parsed())
+      return *type != "f32";
+  return false;
+}
+
+// Fills in the roofline metrics of `result`, the benchmark of the parsed
+// subcommand of `opts` on `handle`, and prints them. Percentages of peak are
+// only known on AMDGPU devices whose target (see
+// `getIreeRocmTargetForAmdgpu()`) is in `getDevicePeak()`.
+static void addRoofline(BenchmarkResult &result, const DriverOptions &opts,
+                        const Handle &handle) {
+  double flops = getFlops(opts);
+  if (result.device.median > 0.0)
+    result.tflops = flops / (result.device.median * 1e9);
+
+  std::string target;
+  if (handle.getBackend() == Backend::AMDGPU)
+    target = getIreeRocmTargetForAmdgpu(handle.getDeviceId());
+  std::optional<DevicePeak> peak = getDevicePeak(target);
+  if (peak) {
+    double peakTflops =
+        isHalfPrecision(opts) ? peak->tflopsF16 : peak->tflopsF32;
+    if (flops > 0.0)
+      result.peakFlopsPercent = 100.0 * result.tflops / peakTflops;
+    result.peakBandwidthPercent = 100.0 * result.bandwidthGBs / peak->memoryGBs;
+  }
+
+  std::printf("%-12s %10.3f TFLOP/s", "roofline", result.tflops);
+  if (result.peakFlopsPercent)
+    std::printf(" (%.1f%% of peak)", *result.peakFlopsPercent);
+  std::printf("  %10.2f GB/s", result.bandwidthGBs);
+  if (result.peakBandwidthPercent)
+    std::printf(" (%.1f%% of peak)", *result.peakBandwidthPercent);
+  if (peak)
+    std::printf("  [%s]", target.c_str());
+  std::printf("\n");
+}
+
+#if defined(FUSILLI_BENCHMARK_REFERENCE)
+// Runs the parsed subcommand of `opts` through its reference library: plain
+// matmuls of a single data type through hipBLASLt, and forward convolutions
+// without bias, all channels-first or all channels-last, through MIOpen.
+static ErrorOr<ReferenceRun> runReference(const DriverOptions &opts,
+                                          const Handle &handle) {
+  if (opts.matmulApp->parsed()) {
+    const MatmulOptions &matmul = opts.matmul;
+    FUSILLI_RETURN_ERROR_IF(
+        matmul.bias || matmul.residual || !matmul.activation.empty() ||
+            matmul.alpha != 1.0f || !matmul.dynamicM.empty() ||
+            !matmul.gate.empty(),
+        ErrorCode::InvalidArgument,
+        "--reference does not support --bias, an epilogue, --gate or "
+        "--dynamic_m");
+    FUSILLI_RETURN_ERROR_IF(matmul.a_type != matmul.b_type ||
+                                matmul.a_type != matmul.out_type,
+                            ErrorCode::InvalidArgument,
+                            "--reference requires matmul operands and "
+                            "output of one data type");
+    return runReferenceMatmul(
+        ReferenceMatmul{
+            .b = matmul.b,
+            .m = matmul.m,
+            .n = matmul.n,
+            .k = matmul.k,
+            .transA = matmul.transA,
+            .transB = matmul.transB,
+            .type = kMlirTypeAsmToDataType.at(matmul.a_type),
+        },
+        handle.getDeviceId(), opts.run.warmup, opts.run.iter);
+  }
+  if (opts.convApp->parsed()) {
+    const ConvOptions &conv = opts.conv;
+    FUSILLI_RETURN_ERROR_IF(conv.mode != 1 || conv.bias,
+                            ErrorCode::InvalidArgument,
+                            "--reference only supports forward convolutions "
+                            "without --bias");
+    auto isChannelsLast = [](const std::string &layout) {
+      return layout.back() == 'C';
+    };
+    bool channelsLast = isChannelsLast(conv.imageLayout);
+    FUSILLI_RETURN_ERROR_IF(
+        isChannelsLast(conv.filterLayout) != channelsLast ||
+            isChannelsLast(conv.outputLayout) != channelsLast,
+        ErrorCode::InvalidArgument,
+        "--reference requires all convolution layouts to be channels-first "
+        "or all to be channels-last");
+    DataType type = conv.fp16   ? DataType::Half
+                    : conv.bf16 ? DataType::BFloat16
+                                : DataType::Float;
+    bool is2d = conv.s == 2;
+    return runReferenceConvFprop(
+        ReferenceConvFprop{
+            .n = conv.n,
+            .c = conv.c,
+            .k = conv.k,
+            .g = conv.g,
+            .image = is2d ? std::vector<int64_t>{conv.h, conv.w}
+                          : std::vector<int64_t>{conv.d, conv.h, conv.w},
+            .filter = is2d ? std::vector<int64_t>{conv.y, conv.x}
+                           : std::vector<int64_t>{conv.z, conv.y, conv.x},
+            .stride = is2d ? std::vector<int64_t>{conv.u, conv.v}
+                           : std::vector<int64_t>{conv.t, conv.u, conv.v},
+            .padding = is2d ? std::vector<int64_t>{conv.p, conv.q}
+                            : std::vector<int64_t>{conv.o, conv.p, conv.q},
+            .dilation = is2d ? std::vector<int64_t>{conv.l, conv.j}
+                             : std::vector<int64_t>{conv.m, conv.l, conv.j},
+            .channelsLast = channelsLast,
+            .type = type,
+        },
+        handle.getDeviceId(), opts.run.warmup, opts.run.iter);
+  }
+  return error(ErrorCode::InvalidArgument,
+               "--reference only supports the matmul and conv subcommands");
+}
+#endif
+
+// With `--reference`, runs the configuration of `opts` through its reference
+// library (see `runReference()`) and adds the comparison of its median time
+// and output with `result`'s.
+static ErrorObject addReference(BenchmarkResult &result,
+                                const DriverOptions &opts,
+                                const Handle &handle) {
+  if (!opts.run.reference)
+    return ok();
+#if defined(FUSILLI_BENCHMARK_REFERENCE)
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != Backend::AMDGPU,
+                          ErrorCode::InvalidArgument,
+                          "--reference requires the AMDGPU backend");
+  FUSILLI_ASSIGN_OR_RETURN(ReferenceRun reference,
+                           runReference(opts, handle));
+  FUSILLI_RETURN_ERROR_IF(reference.output.size() != result.output.size(),
+                          ErrorCode::RuntimeFailure,
+                          "Reference output has " +
+                              std::to_string(reference.output.size()) +
+                              " elements, Fusilli's " +
+                              std::to_string(result.output.size()));
+  double maxAbsDiff = 0.0;
+  for (size_t i = 0; i < result.output.size(); ++i)
+    maxAbsDiff = std::max(
+        maxAbsDiff, std::fabs(static_cast<double>(result.output[i]) -
+                              static_cast<double>(reference.output[i])));
+  // Only the comparison is kept.
+  result.output = {};
+  result.reference = ReferenceComparison{
+      .library = reference.library,
+      .medianMs = reference.medianMs,
+      .speedup = result.device.median > 0.0
+                     ? reference.medianMs / result.device.median
+                     : 0.0,
+      .maxAbsDiff = maxAbsDiff,
+  };
+  std::printf("%-12s %10.4f ms  %s (Fusilli speedup %.2fx, max abs diff %g)\n",
+              "reference", reference.medianMs, reference.library.c_str(),
+              result.reference->speedup, maxAbsDiff);
+  return ok();
+#else
+  (void)result;
+  (void)handle;
+  return error(ErrorCode::InvalidArgument,
+               "--reference needs a driver built with "
+               "-DFUSILLI_BENCHMARK_REFERENCE=ON");
+#endif
+}
+
+// Runs the benchmark of the parsed subcommand of `opts` on `handle`, with
+// the memory peaks reset, and adds its roofline metrics and reference
+// comparison.
+static ErrorOr<BenchmarkResult> runDriverCommand(const DriverOptions &opts,
+                                                  const Handle &handle) {
+  handle.resetPeakMemoryStats();
+  resetHostPeakRss();
+  FUSILLI_ASSIGN_OR_RETURN(BenchmarkResult result,
+                           runSubcommand(opts, handle));
+  addRoofline(result, opts, handle);
+  FUSILLI_CHECK_ERROR(addReference(result, opts, handle));
+  return ok(result);
+}
+
+// Runs the benchmark of the parsed subcommand of `opts` on CPU handles with
+// each of `threads` worker threads, and prints the throughput (executions per
+// second at the median time) and scaling efficiency of each thread count:
+// its speedup over the first one divided by the ratio of their threads.
+static ErrorOr<std::vector<BenchmarkResult>>
+runThreadSweep(const DriverOptions &opts,
+               const std::vector<uint32_t> &threads) {
+  std::vector<BenchmarkResult> results;
+  for (uint32_t count : threads) {
+    std::cout << "Running on " << count << " CPU worker thread(s)"
+              << std::endl;
+    FUSILLI_ASSIGN_OR_RETURN(
+        Handle handle,
+        createBenchmarkHandle(Backend::CPU, opts.deviceId, count));
+    FUSILLI_ASSIGN_OR_RETURN(BenchmarkResult result,
+                             runDriverCommand(opts, handle));
+    results.push_back(std::move(result));
+  }
+
+  std::printf("%8s %12s %14s %10s %12s\n", "threads", "median ms",
+              "executions/s", "speedup", "efficiency");
+  double baseMs = results.front().device.median;
+  for (size_t i = 0; i < threads.size(); ++i) {
+    double ms = results[i].device.median;
+    double speedup = ms > 0.0 ? baseMs / ms : 0.0;
+    double efficiency = speedup * static_cast<double>(threads.front()) /
+                        static_cast<double>(threads[i]);
+    std::printf("%8u %12.4f %14.1f %9.2fx %11.1f%%\n", threads[i], ms,
+                ms > 0.0 ? 1e3 / ms : 0.0, speedup, 100.0 * efficiency);
+  }
+  return ok(std::move(results));
+}
+
+//===---------------------------------------------------------------------===//
+// Results
+//===---------------------------------------------------------------------===//
+
+// Outcome of one benchmark command.
+struct CommandResult {
+  std::string command;
+  // The subcommand and its arguments, which identify the benchmark in
+  // baselines (see `checkBaseline()`).
+  std::string config;
+  std::string status; // "ok", "failed" or "skipped"
+  std::optional<BenchmarkResult> result;
+};
+
+// Returns the subcommand parsed into `opts` and the arguments following it in
+// `args`, joined by spaces.
+static std::string getConfig(const std::vector<std::string> &args,
+                             const DriverOptions &opts) {
+  std::string name;
+  for (const CLI::App *subcommand : opts.subcommands())
+    if (subcommand->parsed())
+      name = subcommand->get_name();
+  std::string config;
+  auto it = std::find(args.begin(), args.end(), name);
+  for (; it != args.end(); ++it)
+    config += (config.empty() ? "" : " ") + *it;
+  return config;
+}
+
+static std::vector<std::string> splitWhitespace(const std::string &line) {
+  std::vector<std::string> tokens;
+  std::istringstream stream(line);
+  for (std::string token; stream >> token;)
+    tokens.push_back(token);
+  return tokens;
+}
+
+static std::string escapeCsv(const std::string &value) {
+  std::string escaped = "\"";
+  for (char c : value)
+    escaped += c == '"' ? std::string("\"\"") : std::string(1, c);
+  return escaped + "\"";
+}
+
+static std::string escapeJson(const std::string &value) {
+  std::string escaped = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped + "\"";
+}
+
+// Writes `results` to `path`, as JSON if it ends in ".json" and as CSV
+// otherwise. Timings are in milliseconds; commands that did not run have
+// "N.A." (CSV) or null (JSON) measurements. The JSON document has one result
+// per line, which `checkBaseline()` relies on.
+static ErrorObject writeResults(const std::string &path,
+                                const std::vector<CommandResult> &results) {
+  std::ofstream out(path);
+  FUSILLI_RETURN_ERROR_IF(!out.is_open(), ErrorCode::FileSystemFailure,
+                          "Failed to create file: " + path);
+  const char *kStats[] = {"min", "median", "p90", "p99", "mean", "stddev"};
+  auto values = [](const TimingStatistics &stats) {
+    return std::vector<double>{stats.min, stats.median, stats.p90,
+                               stats.p99, stats.mean,   stats.stddev};
+  };
+  auto dispatchCount = [](const BenchmarkResult &result, const char *none) {
+    return result.dispatchCount ? std::to_string(*result.dispatchCount)
+                                : std::string(none);
+  };
+  auto percent = [](const std::optional<double> &value, const char *none) {
+    return value ? std::format("{:.2f}", *value) : std::string(none);
+  };
+  auto bytes = [](const std::optional<size_t> &value, const char *none) {
+    return value ? std::to_string(*value) : std::string(none);
+  };
+  // Compile latency phases, reported by their median.
+  const char *kPhases[] = {"validate", "emit_asm", "compile_miss",
+                           "compile_hit", "load"};
+  auto phaseMedians = [](const CompileLatency &latency) {
+    return std::vector<double>{
+        latency.validate.median, latency.emitAsm.median,
+        latency.compileMiss.median, latency.compileHit.median,
+        latency.load.median};
+  };
+
+  if (path.ends_with(".json")) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+      const CommandResult &entry = results[i];
+      out << "  {\"command\": " << escapeJson(entry.command)
+          << ", \"config\": " << escapeJson(entry.config)
+          << ", \"status\": " << escapeJson(entry.status);
+      if (const std::optional<BenchmarkResult> &result = entry.result) {
+        out << ", \"iter\": " << result->iter;
+        for (auto [label, stats] :
+             {std::pair{"device_ms", &result->device},
+              std::pair{"launch_ms", &result->launch}}) {
+          out << ", \"" << label << "\": {";
+          std::vector<double> v = values(*stats);
+          for (size_t j = 0; j < v.size(); ++j)
+            out << (j ? ", " : "") << "\"" << kStats[j] << "\": "
+                << std::format("{:.6f}", v[j]);
+          out << "}";
+        }
+        out << ", \"compile_ms\": " << std::format("{:.3f}", result->compileMs)
+            << ", \"cache_hit\": " << (result->cacheHit ? "true" : "false")
+            << ", \"dispatch_count\": " << dispatchCount(*result, "null")
+            << ", \"workspace_size\": " << result->workspaceSize
+            << ", \"bytes\": " << result->bytes << ", \"bandwidth_gbps\": "
+            << std::format("{:.3f}", result->bandwidthGBs)
+            << ", \"tflops\": " << std::format("{:.3f}", result->tflops)
+            << ", \"peak_flops_pct\": "
+            << percent(result->peakFlopsPercent, "null")
+            << ", \"peak_bandwidth_pct\": "
+            << percent(result->peakBandwidthPercent, "null")
+            << ", \"compile_latency_ms\": ";
+        if (result->compileLatency) {
+          std::vector<double> v = phaseMedians(*result->compileLatency);
+          out << "{";
+          for (size_t j = 0; j < v.size(); ++j)
+            out << (j ? ", " : "") << "\"" << kPhases[j] << "\": "
+                << std::format("{:.3f}", v[j]);
+          out << "}";
+        } else {
+          out << "null";
+        }
+        const MemoryStats &memory = result->memory;
+        out << ", \"peak_device_bytes\": {\"total\": "
+            << memory.total.peakBytes
+            << ", \"buffers\": " << memory.buffers.peakBytes
+            << ", \"workspace\": " << memory.workspace.peakBytes
+            << ", \"modules\": " << memory.modules.peakBytes
+            << "}, \"peak_host_rss_bytes\": "
+            << bytes(result->hostPeakRss, "null");
+        out << ", \"reference\": ";
+        if (const std::optional<ReferenceComparison> &reference =
+                result->reference)
+          out << "{\"library\": " << escapeJson(reference->library)
+              << ", \"median_ms\": "
+              << std::format("{:.6f}", reference->medianMs)
+              << ", \"speedup\": " << std::format("{:.3f}", reference->speedup)
+              << ", \"max_abs_diff\": "
+              << std::format("{:g}", reference->maxAbsDiff) << "}";
+        else
+          out << "null";
+      } else {
+        out << ", \"iter\": null, \"device_ms\": null, \"launch_ms\": null"
+            << ", \"compile_ms\": null, \"cache_hit\": null"
+            << ", \"dispatch_count\": null, \"workspace_size\": null"
+            << ", \"bytes\": null, \"bandwidth_gbps\": null"
+            << ", \"tflops\": null, \"peak_flops_pct\": null"
+            << ", \"peak_bandwidth_pct\": null, \"compile_latency_ms\": null"
+            << ", \"peak_device_bytes\": null"
+            << ", \"peak_host_rss_bytes\": null, \"reference\": null";
+      }
+      out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+  } else {
+    out << "command,config,status,iter";
+    for (const char *prefix : {"device", "launch"})
+      for (const char *stat : kStats)
+        out << "," << prefix << "_" << stat << " (ms)";
+    out << ",compile (ms),cache_hit,dispatch_count,workspace_size,bytes"
+        << ",bandwidth (GB/s),TFLOP/s,peak_flops (%),peak_bandwidth (%)";
+    for (const char *phase : kPhases)
+      out << "," << phase << " (ms)";
+    out << ",peak_device_bytes,peak_buffer_bytes,peak_workspace_bytes"
+        << ",peak_module_bytes,peak_host_rss_bytes";
+    out << ",reference,reference (ms),reference_speedup"
+        << ",reference_max_abs_diff\n";
+    for (const CommandResult &entry : results) {
+      out << escapeCsv(entry.command) << "," << escapeCsv(entry.config) << ","
+          << entry.status;
+      if (const std::optional<BenchmarkResult> &result = entry.result) {
+        out << "," << result->iter;
+        for (const TimingStatistics *stats :
+             {&result->device, &result->launch})
+          for (double value : values(*stats))
+            out << "," << std::format("{:.6f}", value);
+        out << "," << std::format("{:.3f}", result->compileMs) << ","
+            << (result->cacheHit ? "true" : "false") << ","
+            << dispatchCount(*result, "N.A.") << ","
+            << result->workspaceSize << "," << result->bytes << ","
+            << std::format("{:.3f}", result->bandwidthGBs) << ","
+            << std::format("{:.3f}", result->tflops) << ","
+            << percent(result->peakFlopsPercent, "N.A.") << ","
+            << percent(result->peakBandwidthPercent, "N.A.");
+        if (result->compileLatency)
+          for (double value : phaseMedians(*result->compileLatency))
+            out << "," << std::format("{:.3f}", value);
+        else
+          for (size_t j = 0; j < std::size(kPhases); ++j)
+            out << ",N.A.";
+        const MemoryStats &memory = result->memory;
+        out << "," << memory.total.peakBytes << ","
+            << memory.buffers.peakBytes << "," << memory.workspace.peakBytes
+            << "," << memory.modules.peakBytes << ","
+            << bytes(result->hostPeakRss, "N.A.");
+        if (const std::optional<ReferenceComparison> &reference =
+                result->reference)
+          out << "," << reference->library << ","
+              << std::format("{:.6f}", reference->medianMs) << ","
+              << std::format("{:.3f}", reference->speedup) << ","
+              << std::format("{:g}", reference->maxAbsDiff);
+        else
+          out << ",N.A.,N.A.,N.A.,N.A.";
+      } else {
+        for (size_t j = 0;
+             j < 19 + 2 * std::size(kStats) + std::size(kPhases); ++j)
+          out << ",N.A.";
+      }
+      out << "\n";
+    }
+  }
+  FUSILLI_RETURN_ERROR_IF(!out.good(), ErrorCode::FileSystemFailure,
+                          "Failed to write file: " + path);
+  return ok();
+}
+
+//===---------------------------------------------------------------------===//
+// Baseline regression checks
+//===---------------------------------------------------------------------===//
+
+// Returns the position after `"key": ` in `line`, at or after `from`.
+static std::optional<size_t> findJsonMember(std::string_view line,
+                                            std::string_view key,
+                                            size_t from = 0) {
+  std::string member = "\"" + std::string(key) + "\": ";
+  size_t pos = line.find(member, from);
+  if (pos == std::string_view::npos)
+    return std::nullopt;
+  return pos + member.size();
+}
+
+// Returns the string value of the `"key": "<value>"` member of `line`.
+static std::optional<std::string> findJsonString(std::string_view line,
+                                                 std::string_view key) {
+  std::optional<size_t> pos = findJsonMember(line, key);
+  if (!pos || *pos >= line.size() || line[*pos] != '"')
+    return std::nullopt;
+  std::string value;
+  for (size_t i = *pos + 1; i < line.size(); ++i) {
+    if (line[i] == '"')
+      return value;
+    if (line[i] == '\\' && i + 1 < line.size())
+      ++i;
+    value += line[i];
+  }
+  return std::nullopt;
+}
+
+// Returns the numeric value of the first `"key": <value>` member of `line` at
+// or after `from` (none for null values).
+template <typename T>
+static std::optional<T> findJsonNumber(std::string_view line,
+                                       std::string_view key, size_t from = 0) {
+  std::optional<size_t> pos = findJsonMember(line, key, from);
+  if (!pos)
+    return std::nullopt;
+  T value{};
+  auto [ptr, errc] =
+      std::from_chars(line.data() + *pos, line.data() + line.size(), value);
+  if (errc != std::errc())
+    return std::nullopt;
+  return value;
+}
+
+// Compares `results` to the baseline results in `baselinePath` (JSON written
+// by `writeResults()`), matched by config. A result regresses when its median
+// device time exceeds the baseline's by more than `tolerance` (a fraction) or
+// when its dispatch count grew. Prints and returns the number of regressions.
+static ErrorOr<size_t> checkBaseline(const std::vector<CommandResult> &results,
+                                     const std::string &baselinePath,
+                                     double tolerance) {
+  std::ifstream in(baselinePath);
+  FUSILLI_RETURN_ERROR_IF(!in.is_open(), ErrorCode::FileSystemFailure,
+                          "Failed to open baseline file: " + baselinePath);
+
+  struct Baseline {
+    double medianMs;
+    std::optional<uint64_t> dispatchCount;
+  };
+  std::unordered_map<std::string, Baseline> baselines;
+  for (std::string line; std::getline(in, line);) {
+    std::optional<std::string> config = findJsonString(line, "config");
+    std::optional<size_t> device = findJsonMember(line, "device_ms");
+    if (!config || !device)
+      continue;
+    std::optional<double> median =
+        findJsonNumber<double>(line, "median", *device);
+    if (median)
+      baselines[*config] = {*median,
+                            findJsonNumber<uint64_t>(line, "dispatch_count")};
+  }
+  FUSILLI_RETURN_ERROR_IF(baselines.empty(), ErrorCode::InvalidArgument,
+                          "Baseline file has no results: " + baselinePath);
+
+  size_t regressions = 0;
+  for (const CommandResult &entry : results) {
+    if (!entry.result)
+      continue;
+    auto it = baselines.find(entry.config);
+    if (it == baselines.end()) {
+      std::cout << "No baseline for: " << entry.config << std::endl;
+      continue;
+    }
+    const Baseline &baseline = it->second;
+    double median = entry.result->device.median;
+    if (median > baseline.medianMs * (1.0 + tolerance)) {
+      std::cout << std::format("REGRESSION: median device time {:.4f} ms vs "
+                               "baseline {:.4f} ms (+{:.1f}%): {}",
+                               median, baseline.medianMs,
+                               (median / baseline.medianMs - 1.0) * 100.0,
+                               entry.config)
+                << std::endl;
+      ++regressions;
+    }
+    if (entry.result->dispatchCount && baseline.dispatchCount &&
+        *entry.result->dispatchCount > *baseline.dispatchCount) {
+      std::cout << std::format("REGRESSION: {} dispatches vs baseline {}: {}",
+                               *entry.result->dispatchCount,
+                               *baseline.dispatchCount, entry.config)
+                << std::endl;
+      ++regressions;
+    }
+  }
+  std::cout << "Baseline check: " << regressions << " regression(s) at "
+            << std::format("{:g}", tolerance * 100.0) << "% tolerance"
+            << std::endl;
+  return ok(regressions);
+}
+
+// Parses a tolerance given in percent, with or without a trailing '%' (e.g.
+// "5%"), into a fraction.
+static std::optional<double> parseTolerance(std::string_view tolerance) {
+  if (tolerance.ends_with('%'))
+    tolerance.remove_suffix(1);
+  double percent = 0.0;
+  auto [ptr, errc] = std::from_chars(
+      tolerance.data(), tolerance.data() + tolerance.size(), percent);
+  if (errc != std::errc() || ptr != tolerance.data() + tolerance.size() ||
+      percent < 0.0)
+    return std::nullopt;
+  return percent / 100.0;
+}
+
+//===---------------------------------------------------------------------===//
+// Batch mode
+//===---------------------------------------------------------------------===//
+
+// Parses and runs one command of a commands file, on the `backend` handle of
+// its device in `handles` (created on first use), or of `device` when given
+// (overriding the `--device` of the command). Sets `config` once parsed.
+static ErrorOr<BenchmarkResult>
+runBatchCommand(const std::string &command, std::string &config,
+                Backend backend, std::map<int64_t, Handle> &handles,
+                std::optional<int64_t> device) {
+  // Options are parsed into a fresh app per command, as CLI11 does not reset
+  // the variables bound to options between parses.
+  DriverOptions opts;
+  CLI::App lineApp{"Fusilli Benchmark Driver"};
+  lineApp.require_subcommand(1);
+  registerDriverOptions(lineApp, opts)->required();
+  try {
+    lineApp.parse(command, /*program_name_included=*/false);
+  } catch (const CLI::ParseError &e) {
+    return error(ErrorCode::InvalidArgument,
+                 std::string("Invalid command: ") + e.what());
+  }
+  config = getConfig(splitWhitespace(command), opts);
+  if (device) {
+    // The compile latency measurement disables the kernel cache through the
+    // (process wide) environment, which would affect concurrent commands.
+    FUSILLI_RETURN_ERROR_IF(opts.run.measureCompile > 0,
+                            ErrorCode::InvalidArgument,
+                            "--measure-compile is not supported with "
+                            "--devices");
+    opts.deviceId = *device;
+  }
+
+  auto it = handles.find(opts.deviceId);
+  if (it == handles.end()) {
+    FUSILLI_ASSIGN_OR_RETURN(Handle handle,
+                             createBenchmarkHandle(backend, opts.deviceId));
+    it = handles.emplace(opts.deviceId, std::move(handle)).first;
+  }
+  return runDriverCommand(opts, it->second);
+}
+
+// Returns the number of `backend` devices benchmarks can run on: the visible
+// AMD GPUs, or the host for the CPU backend.
+static ErrorOr<int64_t> getVisibleDeviceCount(Backend backend) {
+  if (backend == Backend::CPU)
+    return ok(int64_t{1});
+#if defined(FUSILLI_ENABLE_AMDGPU)
+  FUSILLI_ASSIGN_OR_RETURN(const detail::HipApi *hip, detail::getHipApi());
+  int count = 0;
+  FUSILLI_CHECK_ERROR(
+      hip->check(hip->hipGetDeviceCount(&count), "hipGetDeviceCount"));
+  return ok(static_cast<int64_t>(count));
+#else
+  return ok(int64_t{0});
+#endif
+}
+
+// Parses the `--devices` of a batch: "all" for every visible `backend` device
+// (see `getVisibleDeviceCount()`) or a comma separated list of device IDs.
+static ErrorOr<std::vector<int64_t>> parseDevices(const std::string &str,
+                                                  Backend backend) {
+  std::vector<int64_t> devices;
+  if (str == "all") {
+    FUSILLI_ASSIGN_OR_RETURN(int64_t count, getVisibleDeviceCount(backend));
+    FUSILLI_RETURN_ERROR_IF(count == 0, ErrorCode::RuntimeFailure,
+                            "No visible devices");
+    for (int64_t device = 0; device < count; ++device)
+      devices.push_back(device);
+    return ok(std::move(devices));
+  }
+  for (std::string_view rest = str; !rest.empty();) {
+    std::string_view id = rest.substr(0, rest.find(','));
+    rest.remove_prefix(std::min(rest.size(), id.size() + 1));
+    int64_t device = -1;
+    auto [ptr, errc] =
+        std::from_chars(id.data(), id.data() + id.size(), device);
+    FUSILLI_RETURN_ERROR_IF(errc != std::errc() ||
+                                ptr != id.data() + id.size() || device < 0,
+                            ErrorCode::InvalidArgument,
+                            "Invalid --devices: " + str);
+    devices.push_back(device);
+  }
+  FUSILLI_RETURN_ERROR_IF(devices.empty(), ErrorCode::InvalidArgument,
+                          "Invalid --devices: " + str);
+  return ok(std::move(devices));
+}
+
+// Runs every command of `commandsFile` (one set of driver arguments per line,
+// as taken by `run_benchmark.py`: empty lines and lines starting with '#' are
+// ignored, lines starting with "[SKIP]" are reported but not run) in this
+// process on `backend`, sharing one handle per device.
+//
+// Without `devices`, commands run one after the other on their `--device`.
+// Otherwise one worker thread per device of `devices` runs the next command
+// not yet taken on its device, until all ran. Results are in the order of the
+// commands either way; the output of concurrent commands interleaves.
+static ErrorOr<std::vector<CommandResult>>
+runBatch(const std::string &commandsFile, Backend backend,
+         const std::vector<int64_t> &devices) {
+  std::ifstream in(commandsFile);
+  FUSILLI_RETURN_ERROR_IF(!in.is_open(), ErrorCode::FileSystemFailure,
+                          "Failed to open commands file: " + commandsFile);
+
+  std::vector<std::string> commands;
+  std::string line;
+  while (std::getline(in, line)) {
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#')
+      continue;
+    commands.push_back(
+        line.substr(first, line.find_last_not_of(" \t\r") - first + 1));
+  }
+
+  // Runs command `i` into its slot of `results`; workers write to distinct
+  // slots and only share the console.
+  std::vector<CommandResult> results(commands.size());
+  std::mutex consoleMutex;
+  auto runCommand = [&](size_t i, std::map<int64_t, Handle> &handles,
+                        std::optional<int64_t> device) {
+    const std::string &command = commands[i];
+    {
+      std::lock_guard<std::mutex> lock(consoleMutex);
+      std::cout << "Running command " << i + 1
+                << (device ? std::format(" on device {}", *device) : "")
+                << ": " << command << std::endl;
+    }
+    if (command.starts_with("[SKIP]")) {
+      results[i] = {command, "", "skipped", std::nullopt};
+      return;
+    }
+
+    std::string config;
+    ErrorOr<BenchmarkResult> result =
+        runBatchCommand(command, config, backend, handles, device);
+    if (isError(result)) {
+      std::lock_guard<std::mutex> lock(consoleMutex);
+      std::cerr << "Fusilli Benchmark command failed: " << ErrorObject(result)
+                << std::endl;
+      results[i] = {command, config, "failed", std::nullopt};
+      return;
+    }
+    results[i] = {command, config, "ok", *result};
+  };
+
+  if (devices.empty()) {
+    std::map<int64_t, Handle> handles;
+    for (size_t i = 0; i < commands.size(); ++i)
+      runCommand(i, handles, std::nullopt);
+    return ok(std::move(results));
+  }
+
+  // Workers pull the next command, so devices stay busy when commands take
+  // different times. Each worker owns the handle of its device.
+  std::atomic<size_t> nextCommand = 0;
+  std::vector<std::thread> workers;
+  workers.reserve(devices.size());
+  for (int64_t device : devices)
+    workers.emplace_back([&, device]() {
+      std::map<int64_t, Handle> handles;
+      for (size_t i = nextCommand++; i < commands.size(); i = nextCommand++)
+        runCommand(i, handles, device);
+    });
+  for (std::thread &worker : workers)
+    worker.join();
+  return ok(std::move(results));
+}
+
+//===---------------------------------------------------------------------===//
+// Main function
+//===---------------------------------------------------------------------===//
+
+static int benchmark(int argc, char **argv) {
+  CLI::App mainApp{"Fusilli Benchmark Driver"};
+  mainApp.require_subcommand(0, 1);
+
+  DriverOptions opts;
+  CLI::Option *iterOpt = registerDriverOptions(mainApp, opts);
+
+  // Batch mode: run the commands of a file in this process.
+  std::string commandsFile;
+  CLI::Option *commandsOpt =
+      mainApp
+          .add_option("--commands-file,-f", commandsFile,
+                      "File of benchmark commands (driver arguments, one per "
+                      "line) to run in this process instead of a sub-command")
+          ->check(CLI::ExistingFile)
+          ->excludes(iterOpt);
+  for (CLI::App *subcommand : opts.subcommands())
+    subcommand->excludes(commandsOpt);
+  Backend backend = kDefaultBackend;
+  mainApp
+      .add_option("--backend", backend,
+                  "Backend to benchmark on (amdgpu, cpu), amdgpu when "
+                  "enabled in the build by default")
+      ->transform(CLI::CheckedTransformer(
+          std::map<std::string, Backend>{{"amdgpu", Backend::AMDGPU},
+                                         {"cpu", Backend::CPU}},
+          CLI::ignore_case));
+  std::vector<uint32_t> threads;
+  mainApp
+      .add_option("--threads", threads,
+                  "CPU backend: run the benchmark with each of these worker "
+                  "thread counts (e.g. 1,2,4,8) and report the throughput "
+                  "and scaling efficiency")
+      ->delimiter(',')
+      ->check(CLI::PositiveNumber)
+      ->excludes(commandsOpt);
+  std::string devicesStr;
+  mainApp
+      .add_option("--devices", devicesStr,
+                  "Devices to distribute the commands of --commands-file "
+                  "across, one worker per device: 'all' visible devices or "
+                  "a comma separated list of IDs (overrides the --device of "
+                  "the commands)")
+      ->needs(commandsOpt);
+
+  // Machine-readable results and regression checks against a baseline.
+  std::string outputPath;
+  std::string baselinePath;
+  std::string toleranceStr = "5%";
+  CLI::Option *outputOpt = mainApp.add_option(
+      "--output,-o", outputPath,
+      "Results file, written as JSON if it ends in '.json' and as CSV "
+      "otherwise (default for --commands-file: benchmark_results.csv)");
+  CLI::Option *baselineOpt =
+      mainApp
+          .add_option("--baseline", baselinePath,
+                      "JSON results (see --output) to compare the median "
+                      "device time and dispatch count against; exits "
+                      "non-zero on regressions")
+          ->check(CLI::ExistingFile);
+  mainApp
+      .add_option("--tolerance", toleranceStr,
+                  "Allowed median device time increase over --baseline, in "
+                  "percent (e.g. '5%')")
+      ->capture_default_str()
+      ->needs(baselineOpt);
 
   CLI11_PARSE(mainApp, argc, argv);
 
+  std::optional<double> tolerance = parseTolerance(toleranceStr);
+  if (!tolerance) {
+    std::cerr << "Invalid --tolerance: " << toleranceStr << std::endl;
+    return 1;
+  }
+  if (commandsFile.empty() &&
+      (mainApp.get_subcommands().empty() || iterOpt->count() == 0)) {
+    std::cerr << "A sub-command and --iter are required (unless "
+                 "--commands-file is given)"
+              << std::endl;
+    return 1;
+  }
+
   std::cout << "Fusilli Benchmark started..." << std::endl;
 
-  if (convApp->parsed()) {
-    ErrorObject status = runConvBenchmark(convOpts, iter, deviceId, dump);
-    if (isError(status)) {
-      std::cerr << "Fusilli Conv Benchmark failed: " << status << std::endl;
+  // The command line of a single benchmark, as reported in its results.
+  std::vector<std::string> args(argv + 1, argv + argc);
+  std::string command;
+  for (const std::string &arg : args)
+    command += (command.empty() ? "" : " ") + arg;
+
+  std::vector<CommandResult> results;
+  if (!commandsFile.empty()) {
+    std::vector<int64_t> devices;
+    if (!devicesStr.empty()) {
+      ErrorOr<std::vector<int64_t>> parsed = parseDevices(devicesStr, backend);
+      if (isError(parsed)) {
+        std::cerr << "Fusilli Benchmark failed: " << ErrorObject(parsed)
+                  << std::endl;
+        return 1;
+      }
+      devices = std::move(*parsed);
+    }
+    ErrorOr<std::vector<CommandResult>> batch =
+        runBatch(commandsFile, backend, devices);
+    if (isError(batch)) {
+      std::cerr << "Fusilli Benchmark failed: " << ErrorObject(batch)
+                << std::endl;
       return 1;
     }
-  }
-
-  if (layerNormApp->parsed()) {
-    ErrorObject status =
-        runLayerNormBenchmark(layerNormOpts, iter, deviceId, dump);
-    if (isError(status)) {
-      std::cerr << "Fusilli LayerNorm Benchmark failed: " << status
+    results = std::move(*batch);
+    if (outputOpt->count() == 0)
+      outputPath = "benchmark_results.csv";
+  } else if (!threads.empty()) {
+    if (backend != Backend::CPU) {
+      std::cerr << "--threads requires --backend cpu" << std::endl;
+      return 1;
+    }
+    std::string name = mainApp.get_subcommands().front()->get_name();
+    ErrorOr<std::vector<BenchmarkResult>> sweep = runThreadSweep(opts, threads);
+    if (isError(sweep)) {
+      std::cerr << "Fusilli " << name
+                << " Benchmark failed: " << ErrorObject(sweep) << std::endl;
+      return 1;
+    }
+    // One result per thread count, told apart in baselines by the config.
+    for (size_t i = 0; i < threads.size(); ++i)
+      results.push_back(
+          {command,
+           getConfig(args, opts) + std::format(" --threads {}", threads[i]),
+           "ok", (*sweep)[i]});
+  } else {
+    ErrorOr<Handle> handle = createBenchmarkHandle(backend, opts.deviceId);
+    if (isError(handle)) {
+      std::cerr << "Fusilli Benchmark failed: " << ErrorObject(handle)
                 << std::endl;
       return 1;
     }
+    std::string name = mainApp.get_subcommands().front()->get_name();
+    ErrorOr<BenchmarkResult> result = runDriverCommand(opts, *handle);
+    if (isError(result)) {
+      std::cerr << "Fusilli " << name
+                << " Benchmark failed: " << ErrorObject(result) << std::endl;
+      return 1;
+    }
+    results.push_back({command, getConfig(args, opts), "ok", *result});
   }
 
-  if (matmulApp->parsed()) {
-    ErrorObject status = runMatmulBenchmark(matmulOpts, iter, deviceId, dump);
+  size_t failed = std::count_if(
+      results.begin(), results.end(),
+      [](const CommandResult &entry) { return entry.status == "failed"; });
+  if (!outputPath.empty()) {
+    ErrorObject status = writeResults(outputPath, results);
     if (isError(status)) {
-      std::cerr << "Fusilli Matmul Benchmark failed: " << status << std::endl;
+      std::cerr << "Fusilli Benchmark failed: " << status << std::endl;
       return 1;
     }
+    std::cout << "Ran " << results.size() << " command(s) (" << failed
+              << " failed), results written to " << outputPath << std::endl;
   }
 
-  if (sdpaApp->parsed()) {
-    ErrorObject status = runSdpaBenchmark(sdpaOpts, iter, deviceId, dump);
-    if (isError(status)) {
-      std::cerr << "Fusilli SDPA Benchmark failed: " << status << std::endl;
+  size_t regressions = 0;
+  if (!baselinePath.empty()) {
+    ErrorOr<size_t> checked = checkBaseline(results, baselinePath, *tolerance);
+    if (isError(checked)) {
+      std::cerr << "Fusilli Benchmark failed: " << ErrorObject(checked)
+                << std::endl;
       return 1;
     }
+    regressions = *checked;
   }
 
   std::cout << "Fusilli Benchmark complete!" << std::endl;
-  return 0;
+  return failed == 0 && regressions == 0 ? 0 : 1;
 }
 
 int main(int argc, char **argv) {
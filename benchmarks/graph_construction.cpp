@@ -0,0 +1,102 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Micro-benchmark of graph construction: builds (and destroys) a chain of
+// alternating pointwise ADD / RELU nodes, with nodes and tensors allocated
+// one by one on the heap and from a per-graph arena (see
+// `Graph::setArenaSize()`). Reports the construction throughput of both in
+// nodes per second.
+
+#include <fusilli.h>
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <iostream>
+#include <string>
+#include <utility>
+
+using namespace fusilli;
+
+// Builds a chain of `nodes` pointwise nodes, allocating from an arena of
+// `arenaBytes` (none for 0). The graph is destroyed on return.
+static void buildGraph(int64_t nodes, size_t arenaBytes) {
+  Graph graph;
+  graph.setName(std::format("benchmark_graph_construction_{}", nodes))
+      .setArenaSize(arenaBytes);
+  graph.setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+  auto xT = graph.tensor(
+      TensorAttr().setName("x").setDim({2, 16}).setStride({16, 1}));
+  auto bT = graph.tensor(
+      TensorAttr().setName("b").setDim({2, 16}).setStride({16, 1}));
+  auto yT = xT;
+  for (int64_t i = 0; i < nodes; ++i) {
+    if (i % 2 == 0)
+      yT = graph.pointwise(yT, bT,
+                           PointwiseAttr()
+                               .setMode(PointwiseAttr::Mode::ADD)
+                               .setName(std::format("add_{}", i)));
+    else
+      yT = graph.pointwise(yT, PointwiseAttr()
+                                   .setMode(PointwiseAttr::Mode::RELU_FWD)
+                                   .setName(std::format("relu_{}", i)));
+  }
+  yT->setName("y").setOutput(true);
+}
+
+// Returns the mean time in seconds of `iter` constructions, after a warm-up.
+static double timeConstruction(int64_t nodes, int64_t iter,
+                               size_t arenaBytes) {
+  buildGraph(nodes, arenaBytes);
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < iter; ++i)
+    buildGraph(nodes, arenaBytes);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(iter);
+}
+
+static ErrorObject benchmark(int64_t nodes, int64_t iter, size_t arenaBytes) {
+  FUSILLI_RETURN_ERROR_IF(arenaBytes == 0, ErrorCode::InvalidArgument,
+                          "Arena size must be positive");
+  double heap = timeConstruction(nodes, iter, /*arenaBytes=*/0);
+  double arena = timeConstruction(nodes, iter, arenaBytes);
+
+  std::printf("%8s %8s %12s %14s\n", "nodes", "alloc", "ms", "nodes/s");
+  for (auto [label, seconds] :
+       {std::pair{"heap", heap}, std::pair{"arena", arena}})
+    std::printf("%8lld %8s %12.3f %14.0f\n", static_cast<long long>(nodes),
+                label, seconds * 1e3, static_cast<double>(nodes) / seconds);
+  std::printf("arena speedup: %.2fx\n", heap / arena);
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  CLI::App app{"Fusilli graph construction micro-benchmark"};
+  int64_t nodes = 2000;
+  int64_t iter = 20;
+  size_t arenaBytes = 256 * 1024;
+  app.add_option("--nodes", nodes, "Nodes in the synthetic graph")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--iter", iter, "Timed iterations")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--arena-bytes", arenaBytes, "Initial arena block size");
+  CLI11_PARSE(app, argc, argv);
+
+  ErrorObject status = benchmark(nodes, iter, arenaBytes);
+  if (isError(status)) {
+    std::cerr << "Fusilli graph construction benchmark failed: " << status
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,183 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Generates random but valid graphs of a given size from the graph builders,
+// to measure how validation, emission, hashing and compilation scale with
+// graph size (see graph_scaling.cpp).
+//
+// Graphs are a chain over an activation of constant shape [N, C, H, W]:
+// every node consumes the latest activation, so none is dead and removed by
+// validation. Node kinds are drawn with the weights of the options:
+//   - conv: 1x1 or 3x3 (padded) convolution with C filters;
+//   - matmul: batched [H, W] x [W, W] product over the N and C batch dims;
+//   - pointwise: RELU, scaling by a per-channel input, or adding an earlier
+//     activation (making the graph a DAG);
+//   - layernorm: inference layer normalization;
+//   - reduction: sum over H and W, added back onto the activation (two
+//     nodes).
+// Inputs and convolution outputs are channels-last with probability
+// `channelsLastFraction`, and contiguous otherwise. Matmuls need contiguous
+// batch dims, so a channels-last activation gets a convolution with a
+// contiguous output instead.
+
+#ifndef FUSILLI_BENCHMARKS_GRAPH_GENERATOR_H
+#define FUSILLI_BENCHMARKS_GRAPH_GENERATOR_H
+
+#include <fusilli.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+struct GraphGeneratorOptions {
+  // Number of nodes of the graph.
+  int64_t nodes = 100;
+  // Relative weights of the node kinds.
+  double convWeight = 1;
+  double matmulWeight = 1;
+  double pointwiseWeight = 4;
+  double layernormWeight = 1;
+  double reductionWeight = 1;
+  // Probability of a graph input or convolution output being channels-last.
+  double channelsLastFraction = 0.5;
+  // Shape [N, C, H, W] of the activation, with H == W.
+  std::vector<int64_t> dim = {1, 16, 16, 16};
+  uint64_t seed = 0;
+};
+
+// Builds a graph as described above, not yet validated. Equal options build
+// structurally identical graphs.
+inline fusilli::ErrorOr<std::shared_ptr<fusilli::Graph>>
+generateGraph(const GraphGeneratorOptions &options) {
+  using namespace fusilli;
+  FUSILLI_RETURN_ERROR_IF(options.dim.size() != 4 ||
+                              options.dim[2] != options.dim[3],
+                          ErrorCode::InvalidArgument,
+                          "Generated graphs need an [N, C, H, W] activation "
+                          "with H == W");
+  FUSILLI_RETURN_ERROR_IF(options.nodes <= 0, ErrorCode::InvalidArgument,
+                          "Generated graphs need at least one node");
+  const std::vector<int64_t> &dim = options.dim;
+  int64_t n = dim[0], c = dim[1], w = dim[3];
+
+  std::mt19937_64 rng(options.seed);
+  std::bernoulli_distribution channelsLast(options.channelsLastFraction);
+  enum Kind : size_t { Conv, Matmul, Pointwise, Layernorm, Reduction };
+  std::discrete_distribution<size_t> kinds(
+      {options.convWeight, options.matmulWeight, options.pointwiseWeight,
+       options.layernormWeight, options.reductionWeight});
+  auto pick = [&](size_t count) {
+    return std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+  };
+  auto stride = [](const std::vector<int64_t> &dims, bool isChannelsLast) {
+    return generateStrideFromDim(
+        dims, isChannelsLast ? getChannelsLastStrideOrder(dims.size())
+                             : getContiguousStrideOrder(dims.size()));
+  };
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName(std::format("generated_graph_{}_{}", options.nodes,
+                             options.seed));
+  graph->setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+  size_t inputCount = 0;
+  auto input = [&](const std::vector<int64_t> &dims, bool isChannelsLast) {
+    return graph->tensor(TensorAttr()
+                             .setName(std::format("input_{}", inputCount++))
+                             .setDim(dims)
+                             .setStride(stride(dims, isChannelsLast)));
+  };
+
+  bool isChannelsLast = channelsLast(rng);
+  std::vector<std::shared_ptr<TensorAttr>> activations = {
+      input(dim, isChannelsLast)};
+  for (int64_t node = 0; node < options.nodes; ++node) {
+    const std::shared_ptr<TensorAttr> &x = activations.back();
+    std::string name = std::format("node_{}", node);
+    size_t kind = kinds(rng);
+    if (kind == Matmul && isChannelsLast)
+      kind = Conv;
+    if (kind == Reduction && node + 1 == options.nodes)
+      kind = Pointwise;
+
+    std::shared_ptr<TensorAttr> y;
+    switch (kind) {
+    case Conv: {
+      int64_t r = pick(2) == 0 ? 1 : 3;
+      auto wT = input({c, c, r, r}, channelsLast(rng));
+      auto attr = ConvFPropAttr()
+                      .setStride({1, 1})
+                      .setPadding({r / 2, r / 2})
+                      .setDilation({1, 1})
+                      .setName(name);
+      y = graph->convFProp(x, wT, attr);
+      isChannelsLast = channelsLast(rng);
+      y->setDim(dim).setStride(stride(dim, isChannelsLast));
+      break;
+    }
+    case Matmul: {
+      auto bT = input({n, c, w, w}, /*isChannelsLast=*/false);
+      auto attr = MatmulAttr().setName(name);
+      y = graph->matmul(x, bT, attr);
+      break;
+    }
+    case Pointwise: {
+      size_t op = pick(3);
+      if (op == 0) {
+        auto attr = PointwiseAttr()
+                        .setMode(PointwiseAttr::Mode::RELU_FWD)
+                        .setName(name);
+        y = graph->pointwise(x, attr);
+      } else if (op == 1) {
+        auto scaleT = input({1, c, 1, 1}, isChannelsLast);
+        auto attr =
+            PointwiseAttr().setMode(PointwiseAttr::Mode::MUL).setName(name);
+        y = graph->pointwise(x, scaleT, attr);
+      } else {
+        const auto &earlier = activations[pick(activations.size())];
+        auto attr =
+            PointwiseAttr().setMode(PointwiseAttr::Mode::ADD).setName(name);
+        y = graph->pointwise(x, earlier, attr);
+      }
+      break;
+    }
+    case Layernorm: {
+      auto scaleT = graph->tensor(
+          TensorAttr().setName(std::format("input_{}", inputCount++)));
+      auto biasT = graph->tensor(
+          TensorAttr().setName(std::format("input_{}", inputCount++)));
+      auto epsilonT = graph->tensor(TensorAttr(1e-5f));
+      auto attr = LayernormAttr()
+                      .setForwardPhase(NormFwdPhase::INFERENCE)
+                      .setEpsilon(epsilonT)
+                      .setName(name);
+      y = graph->layernorm(x, scaleT, biasT, attr)[0];
+      break;
+    }
+    case Reduction: {
+      auto attr =
+          ReductionAttr().setMode(ReductionAttr::Mode::ADD).setName(name);
+      auto sumT = graph->reduction(x, attr);
+      sumT->setDim({n, c, 1, 1});
+      auto addAttr = PointwiseAttr()
+                         .setMode(PointwiseAttr::Mode::ADD)
+                         .setName(std::format("node_{}", ++node));
+      y = graph->pointwise(x, sumT, addAttr);
+      break;
+    }
+    }
+    activations.push_back(y);
+  }
+  activations.back()->setName("output").setOutput(true);
+  return ok(std::move(graph));
+}
+
+#endif // FUSILLI_BENCHMARKS_GRAPH_GENERATOR_H
@@ -0,0 +1,153 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Scalability benchmark of the graph phases over synthetic graphs of growing
+// size (see graph_generator.h): building, validation, MLIR assembly emission,
+// structural hashing and, optionally, compilation for the CPU backend.
+// Reports the mean time of each phase per graph size, to catch phases
+// growing superlinearly with the node count.
+
+#include "graph_generator.h"
+
+#include <fusilli.h>
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+using Clock = std::chrono::steady_clock;
+
+// Returns the milliseconds elapsed since `start`.
+static double elapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+// Time of each phase summed over runs, in milliseconds.
+struct PhaseTimes {
+  double build = 0;
+  double validate = 0;
+  double emit = 0;
+  double hash = 0;
+  double compile = 0;
+};
+
+// Builds, validates, emits, hashes and (if `compile` is set) compiles the
+// graph generated from `options` once, adding the time of each phase to
+// `times`.
+static ErrorObject runOnce(const GraphGeneratorOptions &options,
+                           bool compile, PhaseTimes &times) {
+  auto start = Clock::now();
+  FUSILLI_ASSIGN_OR_RETURN(std::shared_ptr<Graph> graph,
+                           generateGraph(options));
+  times.build += elapsedMs(start);
+
+  start = Clock::now();
+  FUSILLI_CHECK_ERROR(graph->validate());
+  times.validate += elapsedMs(start);
+
+  start = Clock::now();
+  FUSILLI_ASSIGN_OR_RETURN(std::string generatedAsm, graph->emitAsm());
+  times.emit += elapsedMs(start);
+
+  start = Clock::now();
+  Fingerprinter fp;
+  graph->hashSubtree(fp);
+  std::string digest = fp.hexDigest();
+  times.hash += elapsedMs(start);
+
+  if (compile) {
+    start = Clock::now();
+    FUSILLI_ASSIGN_OR_RETURN(
+        std::vector<uint8_t> artifact,
+        graph->compileToArtifact(Backend::CPU, /*remove=*/true));
+    times.compile += elapsedMs(start);
+  }
+  return ok();
+}
+
+// Times `iter` runs per graph size of `sizes`, after a warm-up, and prints
+// the mean time of each phase.
+static ErrorObject benchmark(GraphGeneratorOptions options,
+                             const std::vector<int64_t> &sizes, int64_t iter,
+                             bool compile) {
+  std::printf("%8s %10s %10s %10s %10s %10s\n", "nodes", "build ms",
+              "valid ms", "emit ms", "hash ms", "compile ms");
+  for (int64_t nodes : sizes) {
+    options.nodes = nodes;
+    PhaseTimes warmup;
+    FUSILLI_CHECK_ERROR(runOnce(options, /*compile=*/false, warmup));
+    PhaseTimes times;
+    for (int64_t i = 0; i < iter; ++i)
+      FUSILLI_CHECK_ERROR(runOnce(options, compile, times));
+    double n = static_cast<double>(iter);
+    std::printf("%8lld %10.3f %10.3f %10.3f %10.3f ",
+                static_cast<long long>(nodes), times.build / n,
+                times.validate / n, times.emit / n, times.hash / n);
+    if (compile)
+      std::printf("%10.3f\n", times.compile / n);
+    else
+      std::printf("%10s\n", "-");
+  }
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  CLI::App app{"Fusilli graph phase scalability benchmark"};
+  GraphGeneratorOptions options;
+  std::vector<int64_t> sizes = {100, 1000, 5000};
+  int64_t iter = 3;
+  bool compile = false;
+  app.add_option("--nodes", sizes, "Node counts of the synthetic graphs")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--iter", iter, "Timed iterations per node count")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--seed", options.seed, "Seed of the graph generator");
+  app.add_option("--conv", options.convWeight, "Weight of convolutions")
+      ->check(CLI::NonNegativeNumber);
+  app.add_option("--matmul", options.matmulWeight, "Weight of matmuls")
+      ->check(CLI::NonNegativeNumber);
+  app.add_option("--pointwise", options.pointwiseWeight,
+                 "Weight of pointwise nodes")
+      ->check(CLI::NonNegativeNumber);
+  app.add_option("--layernorm", options.layernormWeight,
+                 "Weight of layer normalizations")
+      ->check(CLI::NonNegativeNumber);
+  app.add_option("--reduction", options.reductionWeight,
+                 "Weight of reductions")
+      ->check(CLI::NonNegativeNumber);
+  app.add_option("--channels-last", options.channelsLastFraction,
+                 "Fraction of channels-last inputs and convolution outputs")
+      ->check(CLI::Range(0.0, 1.0));
+  app.add_option("--dim", options.dim, "Activation shape N C H W (H == W)")
+      ->expected(4)
+      ->check(CLI::PositiveNumber);
+  app.add_flag("--compile", compile,
+               "Also time compiling for the CPU backend, bypassing the "
+               "kernel cache");
+  CLI11_PARSE(app, argc, argv);
+
+  // Cache hits would time the cache lookup rather than the compiler.
+  if (compile)
+    setenv("FUSILLI_DISABLE_KERNEL_CACHE", "1", /*overwrite=*/1);
+
+  ErrorObject status = benchmark(options, sizes, iter, compile);
+  if (isError(status)) {
+    std::cerr << "Fusilli graph scaling benchmark failed: " << status
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
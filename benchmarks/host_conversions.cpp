@@ -0,0 +1,109 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Micro-benchmark of the host-side element conversions used to fill buffers
+// and check outputs: Int4 pack/unpack (run on every `Buffer::allocate<Int4>`
+// and `Buffer::read<Int4>`) and bulk f32 <-> f16/bf16 conversions.
+
+#include <fusilli.h>
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+using namespace fusilli;
+
+// Returns the mean time in seconds of `iter` calls to `fn`, after a warm-up.
+template <typename Fn> static double timeMean(int64_t iter, Fn &&fn) {
+  fn();
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < iter; ++i)
+    fn();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(iter);
+}
+
+// Prints the time and the throughput in elements per nanosecond.
+static void report(const char *name, size_t count, double seconds) {
+  std::printf("%-14s %10.3f ms %8.2f Gelem/s\n", name, seconds * 1e3,
+              static_cast<double>(count) / seconds / 1e9);
+}
+
+static int benchmarkInt4(size_t count, int64_t iter) {
+  std::vector<Int4> unpacked(count);
+  for (size_t i = 0; i < count; ++i)
+    unpacked[i] = Int4(static_cast<int8_t>(static_cast<int>(i % 16) - 8));
+  std::vector<uint8_t> packed((count + 1) / 2);
+  std::vector<Int4> roundTrip(count);
+
+  report("int4 pack", count, timeMean(iter, [&] {
+           Int4::pack(unpacked.data(), count, packed.data());
+         }));
+  report("int4 unpack", count, timeMean(iter, [&] {
+           Int4::unpack(packed.data(), count, roundTrip.data());
+         }));
+  for (size_t i = 0; i < count; ++i) {
+    if (roundTrip[i].toInt() != unpacked[i].toInt()) {
+      std::fprintf(stderr, "Int4 round trip mismatch at element %zu\n", i);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template <typename T>
+static int benchmarkFloat(const char *toName, const char *fromName,
+                          size_t count, int64_t iter) {
+  std::vector<float> source(count);
+  for (size_t i = 0; i < count; ++i)
+    source[i] = static_cast<float>(i % 1024) * 0.25f;
+  std::vector<T> narrow(count);
+  std::vector<float> roundTrip(count);
+
+  report(toName, count, timeMean(iter, [&] {
+           (void)convert(std::span<const float>(source), std::span<T>(narrow));
+         }));
+  report(fromName, count, timeMean(iter, [&] {
+           (void)convert(std::span<const T>(narrow),
+                         std::span<float>(roundTrip));
+         }));
+  // Multiples of 0.25 below 256 are exact in both f16 and bf16.
+  for (size_t i = 0; i < count; ++i) {
+    if (source[i] < 256.0f && roundTrip[i] != source[i]) {
+      std::fprintf(stderr, "%s round trip mismatch at element %zu\n", toName,
+                   i);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  CLI::App app{"Fusilli host element conversion micro-benchmark"};
+  int64_t elements = int64_t{1} << 26;
+  int64_t iter = 10;
+  app.add_option("--elements", elements, "Number of elements")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--iter", iter, "Timed iterations")
+      ->check(CLI::PositiveNumber);
+  CLI11_PARSE(app, argc, argv);
+
+  auto count = static_cast<size_t>(elements);
+  std::printf("Elements: %zu\n", count);
+  if (benchmarkInt4(count, iter))
+    return 1;
+  if (benchmarkFloat<half>("f32 -> f16", "f16 -> f32", count, iter))
+    return 1;
+  if (benchmarkFloat<bf16>("f32 -> bf16", "bf16 -> f32", count, iter))
+    return 1;
+  return 0;
+}
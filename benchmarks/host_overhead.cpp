@@ -0,0 +1,187 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Micro-benchmark of the host overhead of the runtime API, which device
+// profilers don't see: `Handle::create()` (the first creation, which creates
+// the device, and later ones, which reuse it), `Buffer::allocate()` and
+// `Buffer::read()` across sizes, and the per-call cost of executing a trivial
+// graph through `Graph::execute()` with a variant pack, with buffers indexed
+// by tensor UID, and through a pre-bound `ExecutionPlan`. The differences
+// between the three attribute the `execute()` overhead to variant pack
+// lookups, VM list creation, and the invocation (including its fences).
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+#if defined(FUSILLI_ENABLE_AMDGPU)
+constexpr Backend kBackend = Backend::AMDGPU;
+#else
+constexpr Backend kBackend = Backend::CPU;
+#endif
+
+// Returns the mean time in microseconds of `iter` calls of `fn`, after a
+// warm-up call.
+template <typename Fn> static ErrorOr<double> timeCalls(int64_t iter, Fn fn) {
+  FUSILLI_CHECK_ERROR(fn());
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < iter; ++i)
+    FUSILLI_CHECK_ERROR(fn());
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return ok(elapsed.count() / static_cast<double>(iter));
+}
+
+// Prints the time of the first `Handle::create()` of the process and the
+// mean time of `iter` more.
+static ErrorObject benchmarkHandleCreation(int64_t iter) {
+  auto start = std::chrono::steady_clock::now();
+  FUSILLI_ASSIGN_OR_RETURN(Handle first, Handle::create(kBackend));
+  std::chrono::duration<double, std::micro> firstUs =
+      std::chrono::steady_clock::now() - start;
+  FUSILLI_ASSIGN_OR_RETURN(double laterUs, timeCalls(iter, [] {
+                             return ErrorObject(Handle::create(kBackend));
+                           }));
+
+  std::printf("%-24s %14s\n", "Handle::create", "us");
+  std::printf("%-24s %14.2f\n", "first (creates device)", firstUs.count());
+  std::printf("%-24s %14.2f\n", "later (reuses device)", laterUs);
+  return ok();
+}
+
+// Prints the mean `Buffer::allocate()` and `Buffer::read()` times of f32
+// buffers of each of `sizes` elements.
+static ErrorObject benchmarkBuffers(const Handle &handle,
+                                    const std::vector<int64_t> &sizes,
+                                    int64_t iter) {
+  std::printf("%12s %14s %14s\n", "elements", "allocate us", "read us");
+  for (int64_t elements : sizes) {
+    // Host data is set up once, so only the runtime calls are timed.
+    std::vector<float> data(elements, 1.0f);
+    std::vector<float> out(elements);
+    std::vector<iree_hal_dim_t> shape = {
+        static_cast<iree_hal_dim_t>(elements)};
+    FUSILLI_ASSIGN_OR_RETURN(double allocateUs, timeCalls(iter, [&] {
+                               return ErrorObject(
+                                   Buffer::allocate(handle, shape, data));
+                             }));
+    FUSILLI_ASSIGN_OR_RETURN(Buffer buffer,
+                             Buffer::allocate(handle, shape, data));
+    FUSILLI_ASSIGN_OR_RETURN(double readUs, timeCalls(iter, [&] {
+                               return buffer.read(handle,
+                                                  std::span<float>(out));
+                             }));
+    std::printf("%12lld %14.2f %14.2f\n", static_cast<long long>(elements),
+                allocateUs, readUs);
+  }
+  return ok();
+}
+
+// Prints the mean per-call time of executing an elementwise add of two
+// `elements` f32 tensors through each execution API.
+static ErrorObject benchmarkExecute(const Handle &handle, int64_t elements,
+                                    int64_t iter) {
+  Graph graph;
+  graph.setName(std::format("benchmark_host_overhead_add_{}", elements));
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto aT = graph.tensor(
+      TensorAttr().setName("a").setDim({elements}).setStride({1}));
+  auto bT = graph.tensor(
+      TensorAttr().setName("b").setDim({elements}).setStride({1}));
+  auto resultT = graph.pointwise(
+      aT, bT, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD).setName("add"));
+  resultT->setName("result").setOutput(true);
+  FUSILLI_CHECK_ERROR(graph.validate());
+  FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/true));
+
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto aBuf, allocateBufferOfType(handle, aT, DataType::Float, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto bBuf, allocateBufferOfType(handle, bT, DataType::Float, 2.0f));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto resultBuf,
+      allocateBufferOfType(handle, resultT, DataType::Float, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {{aT, aBuf}, {bT, bBuf}, {resultT, resultBuf}};
+  FUSILLI_ASSIGN_OR_RETURN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_ASSIGN_OR_RETURN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+  std::vector<Buffer *> buffers(graph.getTensorUidCount());
+  for (const auto &[tensor, buffer] : variantPack) {
+    FUSILLI_ASSIGN_OR_RETURN(size_t uid, graph.getTensorUid(tensor));
+    buffers[uid] = buffer.get();
+  }
+  FUSILLI_ASSIGN_OR_RETURN(ExecutionPlan plan,
+                           graph.bind(variantPack, workspace));
+
+  FUSILLI_ASSIGN_OR_RETURN(double variantPackUs, timeCalls(iter, [&] {
+                             return graph.execute(handle, variantPack,
+                                                  workspace);
+                           }));
+  FUSILLI_ASSIGN_OR_RETURN(double indexedUs, timeCalls(iter, [&] {
+                             return graph.execute(
+                                 handle, std::span<Buffer *const>(buffers),
+                                 workspace.get());
+                           }));
+  FUSILLI_ASSIGN_OR_RETURN(double planUs, timeCalls(iter, [&] {
+                             return plan.run(handle);
+                           }));
+
+  std::printf("%-24s %14s %14s\n", "execute", "us/call", "overhead us");
+  std::printf("%-24s %14.2f %14.2f\n", "variant pack", variantPackUs,
+              variantPackUs - indexedUs);
+  std::printf("%-24s %14.2f %14.2f\n", "indexed buffers", indexedUs,
+              indexedUs - planUs);
+  std::printf("%-24s %14.2f %14s\n", "execution plan", planUs, "-");
+  return ok();
+}
+
+static ErrorObject benchmark(const std::vector<int64_t> &sizes,
+                             int64_t elements, int64_t iter) {
+  // Before any other handle, so the first creation creates the device.
+  FUSILLI_CHECK_ERROR(benchmarkHandleCreation(iter));
+  FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(kBackend));
+  FUSILLI_CHECK_ERROR(benchmarkBuffers(handle, sizes, iter));
+  return benchmarkExecute(handle, elements, iter);
+}
+
+int main(int argc, char **argv) {
+  CLI::App app{"Fusilli host overhead micro-benchmark"};
+  std::vector<int64_t> sizes = {1, 1024, 262144, 4194304};
+  int64_t elements = 1;
+  int64_t iter = 1000;
+  app.add_option("--sizes", sizes, "Elements of the allocated and read buffers")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--elements", elements,
+                 "Elements of the tensors of the executed graph")
+      ->check(CLI::PositiveNumber);
+  app.add_option("--iter", iter, "Timed iterations")
+      ->check(CLI::PositiveNumber);
+  CLI11_PARSE(app, argc, argv);
+
+  ErrorObject status = benchmark(sizes, elements, iter);
+  if (isError(status)) {
+    std::cerr << "Fusilli host overhead benchmark failed: " << status
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
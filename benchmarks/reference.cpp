@@ -0,0 +1,468 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// hipBLASLt and MIOpen runs of the driver's `--reference` mode, see
+// reference.h.
+
+#include "reference.h"
+
+#include <hip/hip_runtime.h>
+#if defined(FUSILLI_BENCHMARK_HIPBLASLT)
+#include <hipblaslt/hipblaslt.h>
+#endif
+#if defined(FUSILLI_BENCHMARK_MIOPEN)
+#include <miopen/miopen.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+namespace {
+
+// `std::unique_ptr` deleter calling the destroy function `Destroy` of a HIP
+// library handle.
+template <auto Destroy> struct Deleter {
+  template <typename T> void operator()(T *ptr) const {
+    if (ptr)
+      (void)Destroy(ptr);
+  }
+};
+template <typename Handle, auto Destroy>
+using Owned = std::unique_ptr<std::remove_pointer_t<Handle>, Deleter<Destroy>>;
+
+ErrorObject checkHip(hipError_t err, const std::string &call) {
+  if (err == hipSuccess)
+    return ok();
+  return error(ErrorCode::RuntimeFailure,
+               call + " failed: " + hipGetErrorString(err));
+}
+
+// Device allocation of `count` elements of `type`.
+class DeviceTensor {
+public:
+  // Allocates the tensor with all elements `value`.
+  static ErrorOr<DeviceTensor> create(DataType type, size_t count,
+                                      float value) {
+    switch (type) {
+    case DataType::Float:
+      return create<float>(type, count, value);
+    case DataType::Half:
+      return create<half>(type, count, value);
+    case DataType::BFloat16:
+      return create<bf16>(type, count, value);
+    default:
+      return error(ErrorCode::NotImplemented,
+                   "Reference libraries only run f32, f16 and bf16");
+    }
+  }
+
+  ErrorOr<std::vector<float>> read() const {
+    switch (type_) {
+    case DataType::Float:
+      return read<float>();
+    case DataType::Half:
+      return read<half>();
+    default:
+      return read<bf16>();
+    }
+  }
+
+  void *get() const { return ptr_.get(); }
+
+private:
+  DeviceTensor(Owned<void *, hipFree> ptr, DataType type, size_t count)
+      : ptr_(std::move(ptr)), type_(type), count_(count) {}
+
+  template <typename T>
+  static ErrorOr<DeviceTensor> create(DataType type, size_t count,
+                                      float value) {
+    void *raw = nullptr;
+    FUSILLI_CHECK_ERROR(checkHip(hipMalloc(&raw, count * sizeof(T)),
+                                 "hipMalloc"));
+    DeviceTensor tensor(Owned<void *, hipFree>(raw), type, count);
+    std::vector<T> host(count, T(value));
+    FUSILLI_CHECK_ERROR(checkHip(hipMemcpy(raw, host.data(), count * sizeof(T),
+                                           hipMemcpyHostToDevice),
+                                 "hipMemcpy"));
+    return ok(std::move(tensor));
+  }
+
+  template <typename T> ErrorOr<std::vector<float>> read() const {
+    std::vector<T> host(count_);
+    FUSILLI_CHECK_ERROR(checkHip(hipMemcpy(host.data(), ptr_.get(),
+                                           count_ * sizeof(T),
+                                           hipMemcpyDeviceToHost),
+                                 "hipMemcpy"));
+    if constexpr (std::is_same_v<T, float>) {
+      return ok(std::move(host));
+    } else {
+      std::vector<float> values(count_);
+      convert(std::span<const T>(host), std::span<float>(values));
+      return ok(std::move(values));
+    }
+  }
+
+  Owned<void *, hipFree> ptr_;
+  DataType type_;
+  size_t count_;
+};
+
+// Selects device `deviceId` and returns a new stream on it.
+ErrorOr<Owned<hipStream_t, hipStreamDestroy>> createStream(int64_t deviceId) {
+  FUSILLI_CHECK_ERROR(
+      checkHip(hipSetDevice(static_cast<int>(deviceId)), "hipSetDevice"));
+  hipStream_t stream = nullptr;
+  FUSILLI_CHECK_ERROR(checkHip(hipStreamCreate(&stream), "hipStreamCreate"));
+  return ok(Owned<hipStream_t, hipStreamDestroy>(stream));
+}
+
+// Returns the median time in milliseconds of `iter` launches of `launch` on
+// `stream`, each timed with events, after `warmup` untimed ones.
+ErrorOr<double> timeLaunches(hipStream_t stream, int64_t warmup, int64_t iter,
+                             const std::function<ErrorObject()> &launch) {
+  hipEvent_t rawStart = nullptr, rawStop = nullptr;
+  FUSILLI_CHECK_ERROR(checkHip(hipEventCreate(&rawStart), "hipEventCreate"));
+  Owned<hipEvent_t, hipEventDestroy> start(rawStart);
+  FUSILLI_CHECK_ERROR(checkHip(hipEventCreate(&rawStop), "hipEventCreate"));
+  Owned<hipEvent_t, hipEventDestroy> stop(rawStop);
+
+  for (int64_t i = 0; i < warmup; ++i)
+    FUSILLI_CHECK_ERROR(launch());
+  std::vector<double> samples;
+  samples.reserve(iter);
+  for (int64_t i = 0; i < iter; ++i) {
+    FUSILLI_CHECK_ERROR(
+        checkHip(hipEventRecord(start.get(), stream), "hipEventRecord"));
+    FUSILLI_CHECK_ERROR(launch());
+    FUSILLI_CHECK_ERROR(
+        checkHip(hipEventRecord(stop.get(), stream), "hipEventRecord"));
+    FUSILLI_CHECK_ERROR(
+        checkHip(hipEventSynchronize(stop.get()), "hipEventSynchronize"));
+    float ms = 0.0f;
+    FUSILLI_CHECK_ERROR(
+        checkHip(hipEventElapsedTime(&ms, start.get(), stop.get()),
+                 "hipEventElapsedTime"));
+    samples.push_back(ms);
+  }
+  std::nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+                   samples.end());
+  return ok(samples[samples.size() / 2]);
+}
+
+#if defined(FUSILLI_BENCHMARK_HIPBLASLT)
+ErrorObject checkHipblaslt(hipblasStatus_t status, const std::string &call) {
+  FUSILLI_RETURN_ERROR_IF(status != HIPBLAS_STATUS_SUCCESS,
+                          ErrorCode::RuntimeFailure,
+                          call + " failed with status " +
+                              std::to_string(static_cast<int>(status)));
+  return ok();
+}
+
+hipDataType getHipDataType(DataType type) {
+  switch (type) {
+  case DataType::Half:
+    return HIP_R_16F;
+  case DataType::BFloat16:
+    return HIP_R_16BF;
+  default:
+    return HIP_R_32F;
+  }
+}
+
+// Creates the column-major layout of a `rows x cols` matrix with leading
+// dimension `ld`, `batch` of them `batchStride` elements apart.
+ErrorOr<Owned<hipblasLtMatrixLayout_t, hipblasLtMatrixLayoutDestroy>>
+createLayout(DataType type, int64_t rows, int64_t cols, int64_t ld,
+             int32_t batch, int64_t batchStride) {
+  hipblasLtMatrixLayout_t raw = nullptr;
+  FUSILLI_CHECK_ERROR(checkHipblaslt(
+      hipblasLtMatrixLayoutCreate(&raw, getHipDataType(type), rows, cols, ld),
+      "hipblasLtMatrixLayoutCreate"));
+  Owned<hipblasLtMatrixLayout_t, hipblasLtMatrixLayoutDestroy> layout(raw);
+  FUSILLI_CHECK_ERROR(checkHipblaslt(
+      hipblasLtMatrixLayoutSetAttribute(
+          raw, HIPBLASLT_MATRIX_LAYOUT_BATCH_COUNT, &batch, sizeof(batch)),
+      "hipblasLtMatrixLayoutSetAttribute"));
+  FUSILLI_CHECK_ERROR(checkHipblaslt(
+      hipblasLtMatrixLayoutSetAttribute(
+          raw, HIPBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET, &batchStride,
+          sizeof(batchStride)),
+      "hipblasLtMatrixLayoutSetAttribute"));
+  return ok(std::move(layout));
+}
+#endif
+
+#if defined(FUSILLI_BENCHMARK_MIOPEN)
+ErrorObject checkMiopen(miopenStatus_t status, const std::string &call) {
+  if (status == miopenStatusSuccess)
+    return ok();
+  return error(ErrorCode::RuntimeFailure,
+               call + " failed: " + miopenGetErrorString(status));
+}
+
+miopenDataType_t getMiopenDataType(DataType type) {
+  switch (type) {
+  case DataType::Half:
+    return miopenHalf;
+  case DataType::BFloat16:
+    return miopenBFloat16;
+  default:
+    return miopenFloat;
+  }
+}
+
+// Creates the descriptor of a tensor of channels-first `dims`, laid out
+// channels-last in memory if `channelsLast`.
+ErrorOr<Owned<miopenTensorDescriptor_t, miopenDestroyTensorDescriptor>>
+createTensorDescriptor(DataType type, const std::vector<int> &dims,
+                       bool channelsLast) {
+  std::vector<int> strides(dims.size());
+  // Memory order of the dims, innermost first.
+  std::vector<size_t> order;
+  if (channelsLast) {
+    order.push_back(1);
+    for (size_t i = dims.size() - 1; i >= 2; --i)
+      order.push_back(i);
+    order.push_back(0);
+  } else {
+    for (size_t i = dims.size(); i-- > 0;)
+      order.push_back(i);
+  }
+  int stride = 1;
+  for (size_t dim : order) {
+    strides[dim] = stride;
+    stride *= dims[dim];
+  }
+
+  miopenTensorDescriptor_t raw = nullptr;
+  FUSILLI_CHECK_ERROR(checkMiopen(miopenCreateTensorDescriptor(&raw),
+                                  "miopenCreateTensorDescriptor"));
+  Owned<miopenTensorDescriptor_t, miopenDestroyTensorDescriptor> desc(raw);
+  FUSILLI_CHECK_ERROR(checkMiopen(
+      miopenSetTensorDescriptor(raw, getMiopenDataType(type),
+                                static_cast<int>(dims.size()), dims.data(),
+                                strides.data()),
+      "miopenSetTensorDescriptor"));
+  return ok(std::move(desc));
+}
+
+std::vector<int> toInt(const std::vector<int64_t> &values) {
+  return std::vector<int>(values.begin(), values.end());
+}
+#endif
+
+} // namespace
+
+ErrorOr<ReferenceRun> runReferenceMatmul(const ReferenceMatmul &matmul,
+                                         int64_t deviceId, int64_t warmup,
+                                         int64_t iter) {
+#if defined(FUSILLI_BENCHMARK_HIPBLASLT)
+  FUSILLI_ASSIGN_OR_RETURN(auto stream, createStream(deviceId));
+  const int64_t b = matmul.b, m = matmul.m, n = matmul.n, k = matmul.k;
+  FUSILLI_ASSIGN_OR_RETURN(DeviceTensor a,
+                           DeviceTensor::create(matmul.type, b * m * k, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(DeviceTensor bMat,
+                           DeviceTensor::create(matmul.type, b * k * n, 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(DeviceTensor c,
+                           DeviceTensor::create(matmul.type, b * m * n, 0.0f));
+
+  hipblasLtHandle_t rawHandle = nullptr;
+  FUSILLI_CHECK_ERROR(
+      checkHipblaslt(hipblasLtCreate(&rawHandle), "hipblasLtCreate"));
+  Owned<hipblasLtHandle_t, hipblasLtDestroy> handle(rawHandle);
+
+  // hipBLASLt is column-major, where the row-major C = A * B is
+  // C^T = B^T * A^T: B is the first operand and A the second. Untransposed
+  // row-major operands are their column-major transposes as is.
+  hipblasOperation_t opB = matmul.transB ? HIPBLAS_OP_T : HIPBLAS_OP_N;
+  hipblasOperation_t opA = matmul.transA ? HIPBLAS_OP_T : HIPBLAS_OP_N;
+  hipblasLtMatmulDesc_t rawDesc = nullptr;
+  FUSILLI_CHECK_ERROR(checkHipblaslt(
+      hipblasLtMatmulDescCreate(&rawDesc, HIPBLAS_COMPUTE_32F, HIP_R_32F),
+      "hipblasLtMatmulDescCreate"));
+  Owned<hipblasLtMatmulDesc_t, hipblasLtMatmulDescDestroy> desc(rawDesc);
+  FUSILLI_CHECK_ERROR(checkHipblaslt(
+      hipblasLtMatmulDescSetAttribute(rawDesc, HIPBLASLT_MATMUL_DESC_TRANSA,
+                                      &opB, sizeof(opB)),
+      "hipblasLtMatmulDescSetAttribute"));
+  FUSILLI_CHECK_ERROR(checkHipblaslt(
+      hipblasLtMatmulDescSetAttribute(rawDesc, HIPBLASLT_MATMUL_DESC_TRANSB,
+                                      &opA, sizeof(opA)),
+      "hipblasLtMatmulDescSetAttribute"));
+
+  auto batch = static_cast<int32_t>(b);
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto firstLayout,
+      matmul.transB ? createLayout(matmul.type, k, n, k, batch, k * n)
+                    : createLayout(matmul.type, n, k, n, batch, k * n));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto secondLayout,
+      matmul.transA ? createLayout(matmul.type, m, k, m, batch, m * k)
+                    : createLayout(matmul.type, k, m, k, batch, m * k));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto outLayout, createLayout(matmul.type, n, m, n, batch, m * n));
+
+  constexpr uint64_t kMaxWorkspaceBytes = 128ull * 1024 * 1024;
+  hipblasLtMatmulPreference_t rawPreference = nullptr;
+  FUSILLI_CHECK_ERROR(
+      checkHipblaslt(hipblasLtMatmulPreferenceCreate(&rawPreference),
+                     "hipblasLtMatmulPreferenceCreate"));
+  Owned<hipblasLtMatmulPreference_t, hipblasLtMatmulPreferenceDestroy>
+      preference(rawPreference);
+  FUSILLI_CHECK_ERROR(checkHipblaslt(
+      hipblasLtMatmulPreferenceSetAttribute(
+          rawPreference, HIPBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+          &kMaxWorkspaceBytes, sizeof(kMaxWorkspaceBytes)),
+      "hipblasLtMatmulPreferenceSetAttribute"));
+  hipblasLtMatmulHeuristicResult_t heuristic{};
+  int returned = 0;
+  FUSILLI_CHECK_ERROR(checkHipblaslt(
+      hipblasLtMatmulAlgoGetHeuristic(
+          rawHandle, rawDesc, firstLayout.get(), secondLayout.get(),
+          outLayout.get(), outLayout.get(), rawPreference, 1, &heuristic,
+          &returned),
+      "hipblasLtMatmulAlgoGetHeuristic"));
+  FUSILLI_RETURN_ERROR_IF(returned == 0, ErrorCode::NotImplemented,
+                          "hipBLASLt has no algorithm for the matmul");
+  FUSILLI_ASSIGN_OR_RETURN(
+      DeviceTensor workspace,
+      DeviceTensor::create(DataType::Float,
+                           (heuristic.workspaceSize + 4) / 4,
+                           0.0f));
+
+  const float alpha = 1.0f, beta = 0.0f;
+  FUSILLI_ASSIGN_OR_RETURN(
+      double medianMs, timeLaunches(stream.get(), warmup, iter, [&] {
+        return checkHipblaslt(
+            hipblasLtMatmul(rawHandle, rawDesc, &alpha, bMat.get(),
+                            firstLayout.get(), a.get(), secondLayout.get(),
+                            &beta, c.get(), outLayout.get(), c.get(),
+                            outLayout.get(), &heuristic.algo, workspace.get(),
+                            heuristic.workspaceSize, stream.get()),
+            "hipblasLtMatmul");
+      }));
+  FUSILLI_ASSIGN_OR_RETURN(std::vector<float> output, c.read());
+  return ok(ReferenceRun{"hipBLASLt", medianMs, std::move(output)});
+#else
+  return error(ErrorCode::NotImplemented,
+               "The benchmark driver was built without hipBLASLt");
+#endif
+}
+
+ErrorOr<ReferenceRun> runReferenceConvFprop(const ReferenceConvFprop &conv,
+                                            int64_t deviceId, int64_t warmup,
+                                            int64_t iter) {
+#if defined(FUSILLI_BENCHMARK_MIOPEN)
+  FUSILLI_ASSIGN_OR_RETURN(auto stream, createStream(deviceId));
+  miopenHandle_t rawHandle = nullptr;
+  FUSILLI_CHECK_ERROR(checkMiopen(
+      miopenCreateWithStream(&rawHandle, stream.get()), "miopenCreate"));
+  Owned<miopenHandle_t, miopenDestroy> handle(rawHandle);
+
+  std::vector<int> xDims = {static_cast<int>(conv.n),
+                            static_cast<int>(conv.c)};
+  std::vector<int> wDims = {static_cast<int>(conv.k),
+                            static_cast<int>(conv.c / conv.g)};
+  for (int64_t size : conv.image)
+    xDims.push_back(static_cast<int>(size));
+  for (int64_t size : conv.filter)
+    wDims.push_back(static_cast<int>(size));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto xDesc, createTensorDescriptor(conv.type, xDims, conv.channelsLast));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto wDesc, createTensorDescriptor(conv.type, wDims, conv.channelsLast));
+
+  miopenConvolutionDescriptor_t rawConvDesc = nullptr;
+  FUSILLI_CHECK_ERROR(
+      checkMiopen(miopenCreateConvolutionDescriptor(&rawConvDesc),
+                  "miopenCreateConvolutionDescriptor"));
+  Owned<miopenConvolutionDescriptor_t, miopenDestroyConvolutionDescriptor>
+      convDesc(rawConvDesc);
+  std::vector<int> padding = toInt(conv.padding), stride = toInt(conv.stride),
+                   dilation = toInt(conv.dilation);
+  FUSILLI_CHECK_ERROR(checkMiopen(
+      miopenInitConvolutionNdDescriptor(
+          rawConvDesc, static_cast<int>(conv.image.size()), padding.data(),
+          stride.data(), dilation.data(), miopenConvolution),
+      "miopenInitConvolutionNdDescriptor"));
+  FUSILLI_CHECK_ERROR(checkMiopen(
+      miopenSetConvolutionGroupCount(rawConvDesc, static_cast<int>(conv.g)),
+      "miopenSetConvolutionGroupCount"));
+
+  int rank = static_cast<int>(xDims.size());
+  std::vector<int> yDims(xDims.size());
+  FUSILLI_CHECK_ERROR(checkMiopen(
+      miopenGetConvolutionNdForwardOutputDim(rawConvDesc, xDesc.get(),
+                                             wDesc.get(), &rank, yDims.data()),
+      "miopenGetConvolutionNdForwardOutputDim"));
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto yDesc, createTensorDescriptor(conv.type, yDims, conv.channelsLast));
+
+  auto volume = [](const std::vector<int> &dims) {
+    size_t count = 1;
+    for (int size : dims)
+      count *= static_cast<size_t>(size);
+    return count;
+  };
+  FUSILLI_ASSIGN_OR_RETURN(
+      DeviceTensor x, DeviceTensor::create(conv.type, volume(xDims), 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(
+      DeviceTensor w, DeviceTensor::create(conv.type, volume(wDims), 1.0f));
+  FUSILLI_ASSIGN_OR_RETURN(
+      DeviceTensor y, DeviceTensor::create(conv.type, volume(yDims), 0.0f));
+
+  size_t workspaceBytes = 0;
+  FUSILLI_CHECK_ERROR(checkMiopen(
+      miopenConvolutionForwardGetWorkSpaceSize(rawHandle, wDesc.get(),
+                                               xDesc.get(), rawConvDesc,
+                                               yDesc.get(), &workspaceBytes),
+      "miopenConvolutionForwardGetWorkSpaceSize"));
+  FUSILLI_ASSIGN_OR_RETURN(
+      DeviceTensor workspace,
+      DeviceTensor::create(DataType::Float,
+                           (workspaceBytes + 4) / 4, 0.0f));
+
+  // Let MIOpen pick (and tune, through its find database) the fastest
+  // algorithm, like Fusilli picks its kernels at compile time.
+  miopenConvAlgoPerf_t perf{};
+  int returned = 0;
+  FUSILLI_CHECK_ERROR(checkMiopen(
+      miopenFindConvolutionForwardAlgorithm(
+          rawHandle, xDesc.get(), x.get(), wDesc.get(), w.get(), rawConvDesc,
+          yDesc.get(), y.get(), 1, &returned, &perf, workspace.get(),
+          workspaceBytes, /*exhaustiveSearch=*/false),
+      "miopenFindConvolutionForwardAlgorithm"));
+  FUSILLI_RETURN_ERROR_IF(returned == 0, ErrorCode::NotImplemented,
+                          "MIOpen has no algorithm for the convolution");
+
+  const float alpha = 1.0f, beta = 0.0f;
+  FUSILLI_ASSIGN_OR_RETURN(
+      double medianMs, timeLaunches(stream.get(), warmup, iter, [&] {
+        return checkMiopen(
+            miopenConvolutionForward(rawHandle, &alpha, xDesc.get(), x.get(),
+                                     wDesc.get(), w.get(), rawConvDesc,
+                                     perf.fwd_algo, &beta, yDesc.get(),
+                                     y.get(), workspace.get(),
+                                     workspaceBytes),
+            "miopenConvolutionForward");
+      }));
+  FUSILLI_ASSIGN_OR_RETURN(std::vector<float> output, y.read());
+  return ok(ReferenceRun{"MIOpen", medianMs, std::move(output)});
+#else
+  return error(ErrorCode::NotImplemented,
+               "The benchmark driver was built without MIOpen");
+#endif
+}
@@ -0,0 +1,56 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Runs benchmark configurations through the ROCm reference libraries, hipBLASLt
+// for matmuls and MIOpen for convolutions, so the driver's `--reference` mode
+// can compare them with Fusilli. Only built with
+// `-DFUSILLI_BENCHMARK_REFERENCE=ON` (see benchmarks/CMakeLists.txt), and a
+// library that was not found at configure time fails at run time.
+//
+// Inputs are filled with ones, like the driver's inputs, and outputs are read
+// back as f32 in their memory order, for comparison with Fusilli's outputs.
+
+#ifndef FUSILLI_BENCHMARKS_REFERENCE_H
+#define FUSILLI_BENCHMARKS_REFERENCE_H
+
+#include <fusilli.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Row-major `[b x] m x k` by `[b x] k x n` matmul, with the operands
+// transposed in memory as by the driver's `--transA` / `--transB`.
+struct ReferenceMatmul {
+  int64_t b, m, n, k;
+  bool transA, transB;
+  fusilli::DataType type;
+};
+
+// Forward convolution of an `n x c x spatial` image by a `k x c / g x filter`
+// filter, all channels-first or all channels-last in memory.
+struct ReferenceConvFprop {
+  int64_t n, c, k, g;
+  std::vector<int64_t> image, filter, stride, padding, dilation;
+  bool channelsLast;
+  fusilli::DataType type;
+};
+
+struct ReferenceRun {
+  std::string library;
+  double medianMs; // Median of the timed launches, timed with HIP events.
+  std::vector<float> output;
+};
+
+// Run `warmup` untimed and `iter` timed launches on AMDGPU device `deviceId`.
+fusilli::ErrorOr<ReferenceRun> runReferenceMatmul(const ReferenceMatmul &matmul,
+                                                  int64_t deviceId,
+                                                  int64_t warmup, int64_t iter);
+fusilli::ErrorOr<ReferenceRun>
+runReferenceConvFprop(const ReferenceConvFprop &conv, int64_t deviceId,
+                      int64_t warmup, int64_t iter);
+
+#endif // FUSILLI_BENCHMARKS_REFERENCE_H
@@ -66,4 +66,63 @@ if [ "${NUM_ROWS_TUNED}" -ne "${EXPECTED_ROWS}" ]; then
 fi
 echo "PASSED: fusilli_benchmark_runner_tests (with --Xiree-compile flags)"
 
-rm -f "${OUTPUT_CSV}" "${OUTPUT_CSV_TUNED}"
+# Test the driver's batch mode, which runs all commands in one process
+OUTPUT_CSV_BATCH=$(mktemp --suffix=.csv)
+OUTPUT_JSON_BATCH=$(mktemp --suffix=.json)
+"${BENCHMARK_DRIVER}" --commands-file "${TEST_COMMANDS}" \
+  --output "${OUTPUT_CSV_BATCH}"
+NUM_ROWS_BATCH=$(tail -n +2 "${OUTPUT_CSV_BATCH}" | wc -l)
+if [ "${NUM_ROWS_BATCH}" -ne "${EXPECTED_ROWS}" ]; then
+  echo "ERROR: Expected ${EXPECTED_ROWS} rows (batch), got ${NUM_ROWS_BATCH}"
+  exit 1
+fi
+if ! grep -q ",skipped," "${OUTPUT_CSV_BATCH}"; then
+  echo "ERROR: Expected a skipped command in the batch results"
+  exit 1
+fi
+"${BENCHMARK_DRIVER}" --commands-file "${TEST_COMMANDS}" \
+  --output "${OUTPUT_JSON_BATCH}"
+python3 -c "import json, sys; assert len(json.load(open(sys.argv[1]))) == int(sys.argv[2])" \
+  "${OUTPUT_JSON_BATCH}" "${EXPECTED_ROWS}"
+echo "PASSED: fusilli_benchmark_runner_tests (driver batch mode)"
+
+# Test the compile latency measurement, reported in the results file
+OUTPUT_JSON_COMPILE=$(mktemp --suffix=.json)
+"${BENCHMARK_DRIVER}" --iter 2 --measure-compile 2 \
+  --output "${OUTPUT_JSON_COMPILE}" \
+  matmul -M 16 -N 32 -K 64 --a_type f32 --b_type f32 --out_type f32
+python3 -c "import json, sys; assert json.load(open(sys.argv[1]))[0]['compile_latency_ms']['compile_miss'] > 0" \
+  "${OUTPUT_JSON_COMPILE}"
+echo "PASSED: fusilli_benchmark_runner_tests (driver compile latency)"
+
+# Test the peak memory reporting: the matmul's inputs and output alone take
+# (16 * 64 + 64 * 32 + 16 * 32) * 4 bytes
+python3 -c "import json, sys; assert json.load(open(sys.argv[1]))[0]['peak_device_bytes']['buffers'] >= 14336" \
+  "${OUTPUT_JSON_COMPILE}"
+echo "PASSED: fusilli_benchmark_runner_tests (driver peak memory)"
+
+# Test distributing the batch across devices, with results in command order
+OUTPUT_JSON_DEVICES=$(mktemp --suffix=.json)
+"${BENCHMARK_DRIVER}" --commands-file "${TEST_COMMANDS}" --devices all \
+  --output "${OUTPUT_JSON_DEVICES}"
+python3 -c "import json, sys; a, b = (json.load(open(p)) for p in sys.argv[1:]); assert [r['command'] for r in a] == [r['command'] for r in b]" \
+  "${OUTPUT_JSON_DEVICES}" "${OUTPUT_JSON_BATCH}"
+echo "PASSED: fusilli_benchmark_runner_tests (driver multi-device batch)"
+
+# Test baseline checks: comparing against the results just written passes
+# with a generous tolerance, and fails against a baseline that is too fast.
+"${BENCHMARK_DRIVER}" --commands-file "${TEST_COMMANDS}" \
+  --baseline "${OUTPUT_JSON_BATCH}" --tolerance 1000%
+FAST_BASELINE=$(mktemp --suffix=.json)
+sed -E 's/"median": [0-9.]+/"median": 0.000001/' "${OUTPUT_JSON_BATCH}" \
+  > "${FAST_BASELINE}"
+if "${BENCHMARK_DRIVER}" --commands-file "${TEST_COMMANDS}" \
+  --baseline "${FAST_BASELINE}" --tolerance 5%; then
+  echo "ERROR: Expected the baseline check to report regressions"
+  exit 1
+fi
+echo "PASSED: fusilli_benchmark_runner_tests (driver baseline checks)"
+
+rm -f "${OUTPUT_CSV}" "${OUTPUT_CSV_TUNED}" "${OUTPUT_CSV_BATCH}" \
+  "${OUTPUT_JSON_BATCH}" "${FAST_BASELINE}" "${OUTPUT_JSON_COMPILE}" \
+  "${OUTPUT_JSON_DEVICES}"
@@ -0,0 +1,227 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Micro-benchmark of host/device transfer latency and bandwidth across
+// buffer sizes and element types:
+//   - pageable: `Buffer::allocate()` (H2D) and `Buffer::read()` (D2H),
+//     transferring straight from and to pageable host memory;
+//   - pinned: `Buffer::writeAsync()` (H2D) and `Buffer::readAsync()` (D2H)
+//     into an existing buffer, staged through the pinned staging buffers of
+//     the handle, waited on right away.
+// Int4 buffers are transferred in their packed encoding, so their times
+// include packing and unpacking on the host; pinned transfers, which are
+// byte-aligned only, pack into (or unpack from) bytes around the transfer.
+// Bandwidths are of the bytes on the device. Also reports the latency of
+// `Buffer::allocateRaw()` and releasing the buffer.
+
+#include <fusilli.h>
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+#if defined(FUSILLI_ENABLE_AMDGPU)
+constexpr Backend kBackend = Backend::AMDGPU;
+#else
+constexpr Backend kBackend = Backend::CPU;
+#endif
+
+// Returns the mean time in microseconds of `iter` calls of `fn`, after a
+// warm-up call.
+template <typename Fn> static ErrorOr<double> timeCalls(int64_t iter, Fn fn) {
+  FUSILLI_CHECK_ERROR(fn());
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < iter; ++i)
+    FUSILLI_CHECK_ERROR(fn());
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return ok(elapsed.count() / static_cast<double>(iter));
+}
+
+// Returns the bandwidth in GB/s of moving `bytes` in `us` microseconds.
+static double getBandwidth(int64_t bytes, double us) {
+  return static_cast<double>(bytes) / us / 1e3;
+}
+
+static void printRow(const char *type, int64_t bytes, const char *staging,
+                     double h2dUs, double d2hUs) {
+  std::printf("%-12s %12lld %-9s %12.2f %10.2f %12.2f %10.2f\n", type,
+              static_cast<long long>(bytes), staging, h2dUs,
+              getBandwidth(bytes, h2dUs), d2hUs, getBandwidth(bytes, d2hUs));
+}
+
+// Prints the pageable and pinned transfer times of `T` buffers of each of
+// `sizes` bytes on the device.
+template <typename T>
+static ErrorObject benchmarkType(const Handle &handle, const char *name,
+                                 DataType dataType, int64_t bits,
+                                 const std::vector<int64_t> &sizes,
+                                 int64_t iter) {
+  for (int64_t bytes : sizes) {
+    // Host data is set up once, so only the transfers (and sub-byte packing)
+    // are timed.
+    int64_t elements = bytes * 8 / bits;
+    std::vector<T> data(elements, T(1));
+    std::vector<T> out(elements);
+    std::vector<iree_hal_dim_t> shape = {
+        static_cast<iree_hal_dim_t>(elements)};
+
+    FUSILLI_ASSIGN_OR_RETURN(double allocateUs, timeCalls(iter, [&] {
+                               return ErrorObject(
+                                   Buffer::allocate(handle, shape, data));
+                             }));
+    FUSILLI_ASSIGN_OR_RETURN(Buffer buffer,
+                             Buffer::allocate(handle, shape, data));
+    FUSILLI_ASSIGN_OR_RETURN(double readUs, timeCalls(iter, [&] {
+                               return buffer.read(handle, std::span<T>(out));
+                             }));
+    printRow(name, bytes, "pageable", allocateUs, readUs);
+
+    auto write = [&]() -> ErrorObject {
+      if constexpr (kIsSubByteElement<T>) {
+        std::vector<uint8_t> packed = T::pack(data);
+        FUSILLI_ASSIGN_OR_RETURN(
+            HostTransfer transfer,
+            buffer.writeAsync(handle, std::span<const uint8_t>(packed)));
+        return transfer.wait();
+      } else {
+        FUSILLI_ASSIGN_OR_RETURN(
+            HostTransfer transfer,
+            buffer.writeAsync(handle, std::span<const T>(data)));
+        return transfer.wait();
+      }
+    };
+    auto read = [&]() -> ErrorObject {
+      if constexpr (kIsSubByteElement<T>) {
+        std::vector<uint8_t> packed(bytes);
+        FUSILLI_ASSIGN_OR_RETURN(
+            HostTransfer transfer,
+            buffer.readAsync(handle, std::span<uint8_t>(packed)));
+        FUSILLI_CHECK_ERROR(transfer.wait());
+        T::unpack(packed.data(), elements, out.data());
+        return ok();
+      } else {
+        FUSILLI_ASSIGN_OR_RETURN(
+            HostTransfer transfer,
+            buffer.readAsync(handle, std::span<T>(out)));
+        return transfer.wait();
+      }
+    };
+    FUSILLI_ASSIGN_OR_RETURN(
+        buffer, Buffer::allocateUninitialized(handle, shape, dataType));
+    FUSILLI_ASSIGN_OR_RETURN(double writeAsyncUs, timeCalls(iter, write));
+    FUSILLI_ASSIGN_OR_RETURN(double readAsyncUs, timeCalls(iter, read));
+    printRow(name, bytes, "pinned", writeAsyncUs, readAsyncUs);
+  }
+  return ok();
+}
+
+// Prints the mean `Buffer::allocateRaw()` time, including releasing the
+// buffer, of each of `sizes` bytes.
+static ErrorObject benchmarkAllocateRaw(const Handle &handle,
+                                        const std::vector<int64_t> &sizes,
+                                        int64_t iter) {
+  std::printf("%12s %16s\n", "bytes", "allocateRaw us");
+  for (int64_t bytes : sizes) {
+    FUSILLI_ASSIGN_OR_RETURN(double allocateRawUs, timeCalls(iter, [&] {
+                               return ErrorObject(
+                                   Buffer::allocateRaw(handle, bytes));
+                             }));
+    std::printf("%12lld %16.2f\n", static_cast<long long>(bytes),
+                allocateRawUs);
+  }
+  return ok();
+}
+
+static ErrorObject benchmark(const std::vector<int64_t> &sizes,
+                             const std::vector<std::string> &types,
+                             int64_t iter) {
+  FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(kBackend));
+  std::printf("%-12s %12s %-9s %12s %10s %12s %10s\n", "type", "bytes",
+              "staging", "h2d us", "h2d GB/s", "d2h us", "d2h GB/s");
+  for (const std::string &type : types) {
+    const char *name = type.c_str();
+    if (type == "f32") {
+      FUSILLI_CHECK_ERROR(benchmarkType<float>(handle, name, DataType::Float,
+                                               32, sizes, iter));
+    } else if (type == "f16") {
+      FUSILLI_CHECK_ERROR(benchmarkType<half>(handle, name, DataType::Half, 16,
+                                              sizes, iter));
+    } else if (type == "bf16") {
+      FUSILLI_CHECK_ERROR(benchmarkType<bf16>(handle, name, DataType::BFloat16,
+                                              16, sizes, iter));
+    } else if (type == "i64") {
+      FUSILLI_CHECK_ERROR(benchmarkType<int64_t>(handle, name, DataType::Int64,
+                                                 64, sizes, iter));
+    } else if (type == "i32") {
+      FUSILLI_CHECK_ERROR(
+          benchmarkType<int>(handle, name, DataType::Int32, 32, sizes, iter));
+    } else if (type == "i16") {
+      FUSILLI_CHECK_ERROR(benchmarkType<int16_t>(handle, name, DataType::Int16,
+                                                 16, sizes, iter));
+    } else if (type == "i8") {
+      FUSILLI_CHECK_ERROR(benchmarkType<int8_t>(handle, name, DataType::Int8,
+                                                8, sizes, iter));
+    } else if (type == "f8e5m2") {
+      FUSILLI_CHECK_ERROR(benchmarkType<fp8e5m2>(
+          handle, name, DataType::FP8E5M2, 8, sizes, iter));
+    } else if (type == "f8e4m3fn") {
+      FUSILLI_CHECK_ERROR(benchmarkType<fp8e4m3fn>(
+          handle, name, DataType::FP8E4M3FN, 8, sizes, iter));
+    } else if (type == "f8e5m2fnuz") {
+      FUSILLI_CHECK_ERROR(benchmarkType<fp8e5m2fnuz>(
+          handle, name, DataType::FP8E5M2FNUZ, 8, sizes, iter));
+    } else if (type == "f8e4m3fnuz") {
+      FUSILLI_CHECK_ERROR(benchmarkType<fp8e4m3fnuz>(
+          handle, name, DataType::FP8E4M3FNUZ, 8, sizes, iter));
+    } else {
+      FUSILLI_CHECK_ERROR(
+          benchmarkType<Int4>(handle, name, DataType::Int4, 4, sizes, iter));
+    }
+  }
+  return benchmarkAllocateRaw(handle, sizes, iter);
+}
+
+int main(int argc, char **argv) {
+  CLI::App app{"Fusilli host/device transfer bandwidth micro-benchmark"};
+  int64_t minBytes = int64_t(4) << 10;
+  int64_t maxBytes = int64_t(4) << 30;
+  std::vector<std::string> types = {"f32",        "f16",        "bf16",
+                                    "i64",        "i32",        "i16",
+                                    "i8",         "f8e5m2",     "f8e4m3fn",
+                                    "f8e5m2fnuz", "f8e4m3fnuz", "i4"};
+  int64_t iter = 10;
+  app.add_option("--min-bytes", minBytes, "Smallest transfer, in bytes")
+      ->check(CLI::Range(int64_t(64), int64_t(1) << 40));
+  app.add_option("--max-bytes", maxBytes,
+                 "Largest transfer, in bytes (sizes grow 4x up to it)")
+      ->check(CLI::Range(int64_t(64), int64_t(1) << 40));
+  app.add_option("--types", types, "Element types of the buffers")
+      ->check(CLI::IsMember(std::vector<std::string>(types)));
+  app.add_option("--iter", iter, "Timed iterations")
+      ->check(CLI::PositiveNumber);
+  CLI11_PARSE(app, argc, argv);
+
+  std::vector<int64_t> sizes;
+  for (int64_t bytes = minBytes; bytes <= maxBytes; bytes *= 4)
+    sizes.push_back(bytes);
+
+  ErrorObject status = benchmark(sizes, types, iter);
+  if (isError(status)) {
+    std::cerr << "Fusilli transfer bandwidth benchmark failed: " << status
+              << std::endl;
+    return 1;
+  }
+  return 0;
+}
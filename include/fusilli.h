@@ -17,56 +17,113 @@
 #include "fusilli/external/torch_types.h" // IWYU pragma: export
 
 // Support:
-#include "fusilli/support/asm_emitter.h"     // IWYU pragma: export
-#include "fusilli/support/cache.h"           // IWYU pragma: export
-#include "fusilli/support/dllib.h"           // IWYU pragma: export
-#include "fusilli/support/external_tools.h"  // IWYU pragma: export
-#include "fusilli/support/extras.h"          // IWYU pragma: export
-#include "fusilli/support/float_types.h"     // IWYU pragma: export
-#include "fusilli/support/int_types.h"       // IWYU pragma: export
-#include "fusilli/support/logging.h"         // IWYU pragma: export
-#include "fusilli/support/memstream.h"       // IWYU pragma: export
-#include "fusilli/support/process.h"         // IWYU pragma: export
-#include "fusilli/support/python_utils.h"    // IWYU pragma: export
-#include "fusilli/support/target_platform.h" // IWYU pragma: export
+#include "fusilli/support/archive.h"             // IWYU pragma: export
+#include "fusilli/support/arena.h"               // IWYU pragma: export
+#include "fusilli/support/asm_emitter.h"         // IWYU pragma: export
+#include "fusilli/support/cache.h"               // IWYU pragma: export
+#include "fusilli/support/compression.h"         // IWYU pragma: export
+#include "fusilli/support/dllib.h"               // IWYU pragma: export
+#include "fusilli/support/event_log.h"           // IWYU pragma: export
+#include "fusilli/support/external_tools.h"      // IWYU pragma: export
+#include "fusilli/support/extras.h"              // IWYU pragma: export
+#include "fusilli/support/file_lock.h"           // IWYU pragma: export
+#include "fusilli/support/fingerprint.h"         // IWYU pragma: export
+#include "fusilli/support/float_types.h"         // IWYU pragma: export
+#include "fusilli/support/hash.h"                // IWYU pragma: export
+#include "fusilli/support/hip_runtime.h"         // IWYU pragma: export
+#include "fusilli/support/int_types.h"           // IWYU pragma: export
+#include "fusilli/support/kernel_cache.h"        // IWYU pragma: export
+#include "fusilli/support/kernel_cache_index.h"  // IWYU pragma: export
+#include "fusilli/support/logging.h"             // IWYU pragma: export
+#include "fusilli/support/mapped_file.h"         // IWYU pragma: export
+#include "fusilli/support/memstream.h"           // IWYU pragma: export
+#include "fusilli/support/process.h"             // IWYU pragma: export
+#include "fusilli/support/python_utils.h"        // IWYU pragma: export
+#include "fusilli/support/remote_kernel_cache.h" // IWYU pragma: export
+#include "fusilli/support/single_flight.h"       // IWYU pragma: export
+#include "fusilli/support/sparsity.h"            // IWYU pragma: export
+#include "fusilli/support/target_platform.h"     // IWYU pragma: export
+#include "fusilli/support/tracing.h"             // IWYU pragma: export
 
 // Attributes / Types:
-#include "fusilli/attributes/attributes.h"           // IWYU pragma: export
-#include "fusilli/attributes/batchnorm_attributes.h" // IWYU pragma: export
-#include "fusilli/attributes/common.h"               // IWYU pragma: export
-#include "fusilli/attributes/conv_attributes.h"      // IWYU pragma: export
-#include "fusilli/attributes/custom_op_attributes.h" // IWYU pragma: export
-#include "fusilli/attributes/layernorm_attributes.h" // IWYU pragma: export
-#include "fusilli/attributes/matmul_attributes.h"    // IWYU pragma: export
-#include "fusilli/attributes/pointwise_attributes.h" // IWYU pragma: export
-#include "fusilli/attributes/reduction_attributes.h" // IWYU pragma: export
-#include "fusilli/attributes/rmsnorm_attributes.h"   // IWYU pragma: export
-#include "fusilli/attributes/sdpa_attributes.h"      // IWYU pragma: export
-#include "fusilli/attributes/tensor_attributes.h"    // IWYU pragma: export
-#include "fusilli/attributes/types.h"                // IWYU pragma: export
+#include "fusilli/attributes/attributes.h"            // IWYU pragma: export
+#include "fusilli/attributes/batchnorm_attributes.h"  // IWYU pragma: export
+#include "fusilli/attributes/collective_attributes.h" // IWYU pragma: export
+#include "fusilli/attributes/common.h"                // IWYU pragma: export
+#include "fusilli/attributes/conv_attributes.h"       // IWYU pragma: export
+#include "fusilli/attributes/custom_op_attributes.h"  // IWYU pragma: export
+#include "fusilli/attributes/layernorm_attributes.h"  // IWYU pragma: export
+#include "fusilli/attributes/matmul_attributes.h"     // IWYU pragma: export
+#include "fusilli/attributes/optimizer_attributes.h"  // IWYU pragma: export
+#include "fusilli/attributes/pointwise_attributes.h"  // IWYU pragma: export
+#include "fusilli/attributes/pooling_attributes.h"    // IWYU pragma: export
+#include "fusilli/attributes/reduction_attributes.h"  // IWYU pragma: export
+#include "fusilli/attributes/rmsnorm_attributes.h"    // IWYU pragma: export
+#include "fusilli/attributes/sdpa_attributes.h"       // IWYU pragma: export
+#include "fusilli/attributes/shape_attributes.h"      // IWYU pragma: export
+#include "fusilli/attributes/softmax_attributes.h"    // IWYU pragma: export
+#include "fusilli/attributes/tensor_attributes.h"     // IWYU pragma: export
+#include "fusilli/attributes/types.h"                 // IWYU pragma: export
 
 // Nodes:
-#include "fusilli/node/batchnorm_node.h" // IWYU pragma: export
-#include "fusilli/node/conv_node.h"      // IWYU pragma: export
-#include "fusilli/node/custom_op_node.h" // IWYU pragma: export
-#include "fusilli/node/layernorm_node.h" // IWYU pragma: export
-#include "fusilli/node/matmul_node.h"    // IWYU pragma: export
-#include "fusilli/node/node.h"           // IWYU pragma: export
-#include "fusilli/node/pointwise_node.h" // IWYU pragma: export
-#include "fusilli/node/reduction_node.h" // IWYU pragma: export
-#include "fusilli/node/rmsnorm_node.h"   // IWYU pragma: export
-#include "fusilli/node/sdpa_node.h"      // IWYU pragma: export
+#include "fusilli/node/batchnorm_node.h"  // IWYU pragma: export
+#include "fusilli/node/collective_node.h" // IWYU pragma: export
+#include "fusilli/node/conv_node.h"       // IWYU pragma: export
+#include "fusilli/node/custom_op_node.h"  // IWYU pragma: export
+#include "fusilli/node/layernorm_node.h"  // IWYU pragma: export
+#include "fusilli/node/matmul_node.h"     // IWYU pragma: export
+#include "fusilli/node/node.h"            // IWYU pragma: export
+#include "fusilli/node/optimizer_node.h"  // IWYU pragma: export
+#include "fusilli/node/pointwise_node.h"  // IWYU pragma: export
+#include "fusilli/node/pooling_node.h"    // IWYU pragma: export
+#include "fusilli/node/reduction_node.h"  // IWYU pragma: export
+#include "fusilli/node/rmsnorm_node.h"    // IWYU pragma: export
+#include "fusilli/node/sdpa_node.h"       // IWYU pragma: export
+#include "fusilli/node/shape_node.h"      // IWYU pragma: export
+#include "fusilli/node/softmax_node.h"    // IWYU pragma: export
 
 // Backend:
-#include "fusilli/backend/backend.h"         // IWYU pragma: export
-#include "fusilli/backend/buffer.h"          // IWYU pragma: export
-#include "fusilli/backend/compile_command.h" // IWYU pragma: export
-#include "fusilli/backend/compile_session.h" // IWYU pragma: export
-#include "fusilli/backend/handle.h"          // IWYU pragma: export
-#include "fusilli/backend/runtime.h"         // IWYU pragma: export
+#include "fusilli/backend/backend.h"            // IWYU pragma: export
+#include "fusilli/backend/buffer.h"             // IWYU pragma: export
+#include "fusilli/backend/compile_command.h"    // IWYU pragma: export
+#include "fusilli/backend/compile_options.h"    // IWYU pragma: export
+#include "fusilli/backend/compile_report.h"     // IWYU pragma: export
+#include "fusilli/backend/compile_resources.h"  // IWYU pragma: export
+#include "fusilli/backend/compile_server.h"     // IWYU pragma: export
+#include "fusilli/backend/compile_session.h"    // IWYU pragma: export
+#include "fusilli/backend/compile_statistics.h" // IWYU pragma: export
+#include "fusilli/backend/completion_poller.h"  // IWYU pragma: export
+#include "fusilli/backend/cost_model.h"         // IWYU pragma: export
+#include "fusilli/backend/cpu_options.h"        // IWYU pragma: export
+#include "fusilli/backend/execution_stats.h"    // IWYU pragma: export
+#include "fusilli/backend/execution_timing.h"   // IWYU pragma: export
+#include "fusilli/backend/fence.h"              // IWYU pragma: export
+#include "fusilli/backend/handle.h"             // IWYU pragma: export
+#include "fusilli/backend/host_transfer.h"      // IWYU pragma: export
+#include "fusilli/backend/memory_tracker.h"     // IWYU pragma: export
+#include "fusilli/backend/parameters.h"         // IWYU pragma: export
+#include "fusilli/backend/runtime.h"            // IWYU pragma: export
+#include "fusilli/backend/usage_journal.h"      // IWYU pragma: export
+#include "fusilli/backend/workspace_report.h"   // IWYU pragma: export
 
 // Graph:
-#include "fusilli/graph/context.h" // IWYU pragma: export
-#include "fusilli/graph/graph.h"   // IWYU pragma: export
+#include "fusilli/graph/artifact_bundle.h"    // IWYU pragma: export
+#include "fusilli/graph/autotune.h"           // IWYU pragma: export
+#include "fusilli/graph/batch_scheduler.h"    // IWYU pragma: export
+#include "fusilli/graph/capture.h"            // IWYU pragma: export
+#include "fusilli/graph/compile_all.h"        // IWYU pragma: export
+#include "fusilli/graph/compile_queue.h"      // IWYU pragma: export
+#include "fusilli/graph/context.h"            // IWYU pragma: export
+#include "fusilli/graph/graph.h"              // IWYU pragma: export
+#include "fusilli/graph/graph_sequence.h"     // IWYU pragma: export
+#include "fusilli/graph/graph_template.h"     // IWYU pragma: export
+#include "fusilli/graph/hip_graph.h"          // IWYU pragma: export
+#include "fusilli/graph/journal_replay.h"     // IWYU pragma: export
+#include "fusilli/graph/partition.h"          // IWYU pragma: export
+#include "fusilli/graph/priority_scheduler.h" // IWYU pragma: export
+#include "fusilli/graph/split_executor.h"     // IWYU pragma: export
+#include "fusilli/graph/streaming_executor.h" // IWYU pragma: export
+#include "fusilli/graph/training_module.h"    // IWYU pragma: export
+#include "fusilli/graph/warmup.h"             // IWYU pragma: export
 
 #endif // FUSILLI_H
@@ -21,9 +21,15 @@
 #include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/attributes/types.h"
 #include "fusilli/graph/context.h"
+#include "fusilli/support/archive.h"
+#include "fusilli/support/fingerprint.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace fusilli {
 
@@ -98,6 +104,90 @@ public:
     }
   }
 
+  // Appends the (set) input and output tensors to `ins` and `outs`, in key
+  // order so that nodes with the same attributes list them alike.
+  void collectTensors(std::vector<std::shared_ptr<TensorAttr>> &ins,
+                      std::vector<std::shared_ptr<TensorAttr>> &outs) const {
+    auto visit = [](const auto &map, auto &tensors) {
+      using KeyT = typename std::decay_t<decltype(map)>::key_type;
+      std::vector<KeyT> keys;
+      keys.reserve(map.size());
+      for (const auto &kv : map)
+        if (kv.second)
+          keys.push_back(kv.first);
+      std::sort(keys.begin(), keys.end());
+      for (KeyT key : keys)
+        tensors.push_back(map.at(key));
+    };
+    visit(self().inputs, ins);
+    visit(self().outputs, outs);
+  }
+
+  // Rewires every input that is `from` to `to`.
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) {
+    for (auto &kv : self().inputs)
+      if (kv.second == from)
+        kv.second = to;
+  }
+
+  // Rewires every output that is `from` to `to`.
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) {
+    for (auto &kv : self().outputs)
+      if (kv.second == from)
+        kv.second = to;
+  }
+
+  // Mixes the compute data type and the input and output tensors into `fp`.
+  // Tensors are visited in deterministic (key) order, as `unordered_map`
+  // iteration order is not.
+  void hashTensors(Fingerprinter &fp) const {
+    fp.update(computeDataType);
+    auto visit = [&](const auto &map) {
+      using KeyT = typename std::decay_t<decltype(map)>::key_type;
+      std::vector<KeyT> keys;
+      keys.reserve(map.size());
+      for (const auto &kv : map)
+        keys.push_back(kv.first);
+      std::sort(keys.begin(), keys.end());
+      fp.update(keys.size());
+      for (KeyT key : keys)
+        fp.update(key).tensor(map.at(key));
+    };
+    visit(self().inputs);
+    visit(self().outputs);
+  }
+
+  // Reads or writes the name, compute data type and the input and output
+  // tensors (in key order) from or to `ar`, see `Graph::serialize()`.
+  void archiveTensors(Archive &ar) {
+    ar.io(name_).io(computeDataType);
+    auto visit = [&](auto &map) {
+      using KeyT = typename std::decay_t<decltype(map)>::key_type;
+      std::vector<KeyT> keys;
+      keys.reserve(map.size());
+      for (const auto &kv : map)
+        keys.push_back(kv.first);
+      std::sort(keys.begin(), keys.end());
+      size_t size = keys.size();
+      ar.io(size);
+      if (ar.isReading()) {
+        map.clear();
+        for (size_t i = 0; i < size && ar.status().isOk(); ++i) {
+          KeyT key{};
+          ar.io(key);
+          ar.io(map[key]);
+        }
+        return;
+      }
+      for (KeyT key : keys)
+        ar.io(key).io(map.at(key));
+    };
+    visit(self().inputs);
+    visit(self().outputs);
+  }
+
 private:
   DerivedT &self() { return static_cast<DerivedT &>(*this); }
   const DerivedT &self() const { return static_cast<const DerivedT &>(*this); }
@@ -85,10 +85,64 @@ public:
 
   NormFwdPhase getForwardPhase() const { return forwardPhase_; }
 
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(forwardPhase_);
+  }
+
 private:
   NormFwdPhase forwardPhase_ = NormFwdPhase::NOT_SET;
 };
 
+// Attributes of the batch normalization backward, computed from the
+// statistics saved by the training forward (SAVED_MEAN and
+// SAVED_INV_VARIANCE), so no epsilon is needed. When the optional Y is set,
+// the backward of a ReLU applied to Y in the forward is fused in: DY is zeroed
+// where Y is not positive.
+class BatchnormBwdAttr : public AttributesCRTP<BatchnormBwdAttr> {
+public:
+  // Names for Tensor Inputs and Outputs.
+  enum class InputNames : uint8_t {
+    DY,
+    X,
+    SCALE,
+    SAVED_MEAN,
+    SAVED_INV_VARIANCE,
+    Y
+  };
+  enum class OutputNames : uint8_t { DX, DSCALE, DBIAS };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormBwdAttr, InputNames, DY)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormBwdAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormBwdAttr, InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormBwdAttr, InputNames, SAVED_MEAN)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormBwdAttr, InputNames,
+                                      SAVED_INV_VARIANCE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(BatchnormBwdAttr, InputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(BatchnormBwdAttr, OutputNames, DX)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(BatchnormBwdAttr, OutputNames, DSCALE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(BatchnormBwdAttr, OutputNames, DBIAS)
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, DY)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SAVED_MEAN)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SAVED_INV_VARIANCE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DX)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DSCALE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DBIAS)
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) { archiveTensors(ar); }
+};
+
 } // namespace fusilli
 
 #endif // FUSILLI_ATTRIBUTES_BATCHNORM_ATTRIBUTES_H
@@ -0,0 +1,121 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains attributes (compile-time constant metadata) for
+// collective communication nodes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_ATTRIBUTES_COLLECTIVE_ATTRIBUTES_H
+#define FUSILLI_ATTRIBUTES_COLLECTIVE_ATTRIBUTES_H
+
+#include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fusilli {
+
+class CollectiveAttr : public AttributesCRTP<CollectiveAttr> {
+public:
+  // Names for Tensor Inputs and Outputs. X is the shard of this rank.
+  enum class InputNames : uint8_t { X };
+  enum class OutputNames : uint8_t { Y };
+
+  // ALL_REDUCE:     Y = reduction of X over the ranks
+  // ALL_GATHER:     Y = concatenation of X over the ranks along the axis
+  // REDUCE_SCATTER: Y = shard (along the axis) of this rank of the reduction
+  //                 of X over the ranks
+  enum class Mode : uint8_t { NOT_SET, ALL_REDUCE, ALL_GATHER, REDUCE_SCATTER };
+
+  enum class ReduceOp : uint8_t { SUM, AVG, MIN, MAX };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Tensor setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(CollectiveAttr, InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(CollectiveAttr, OutputNames, Y)
+
+  // Tensor getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  // Scalar attribute setters:
+  CollectiveAttr &setMode(Mode mode) {
+    mode_ = mode;
+    return *this;
+  }
+
+  // Reduction of ALL_REDUCE and REDUCE_SCATTER.
+  CollectiveAttr &setReduceOp(ReduceOp reduceOp) {
+    reduceOp_ = reduceOp;
+    return *this;
+  }
+
+  // Ranks of the group taking part in the collective, in shard order.
+  CollectiveAttr &setRanks(const std::vector<int64_t> &ranks) {
+    ranks_ = ranks;
+    return *this;
+  }
+
+  // Logical dimension gathered or scattered along. Negative values count
+  // from the end.
+  CollectiveAttr &setAxis(int64_t axis) {
+    axis_ = axis;
+    return *this;
+  }
+
+  // Scalar attribute getters:
+  Mode getMode() const { return mode_; }
+  ReduceOp getReduceOp() const { return reduceOp_; }
+  const std::vector<int64_t> &getRanks() const { return ranks_; }
+  int64_t getGroupSize() const { return static_cast<int64_t>(ranks_.size()); }
+  int64_t getAxis() const { return axis_; }
+
+  // Utilities for collective modes and reductions.
+  static const std::unordered_map<Mode, std::string> kModeToStr;
+  static const std::unordered_map<ReduceOp, std::string> kReduceOpToStr;
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(mode_).io(reduceOp_).io(ranks_).io(axis_);
+  }
+
+private:
+  Mode mode_ = Mode::NOT_SET;
+  ReduceOp reduceOp_ = ReduceOp::SUM;
+  std::vector<int64_t> ranks_;
+  int64_t axis_ = 0;
+};
+
+inline const std::unordered_map<CollectiveAttr::Mode, std::string>
+    CollectiveAttr::kModeToStr = {
+        {CollectiveAttr::Mode::NOT_SET, "NOT_SET"},
+        {CollectiveAttr::Mode::ALL_REDUCE, "ALL_REDUCE"},
+        {CollectiveAttr::Mode::ALL_GATHER, "ALL_GATHER"},
+        {CollectiveAttr::Mode::REDUCE_SCATTER, "REDUCE_SCATTER"},
+};
+
+// Names of the reductions in the `c10d_functional` ops.
+inline const std::unordered_map<CollectiveAttr::ReduceOp, std::string>
+    CollectiveAttr::kReduceOpToStr = {
+        {CollectiveAttr::ReduceOp::SUM, "sum"},
+        {CollectiveAttr::ReduceOp::AVG, "avg"},
+        {CollectiveAttr::ReduceOp::MIN, "min"},
+        {CollectiveAttr::ReduceOp::MAX, "max"},
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_ATTRIBUTES_COLLECTIVE_ATTRIBUTES_H
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -27,15 +28,26 @@ namespace fusilli {
 class ConvFPropAttr : public AttributesCRTP<ConvFPropAttr> {
 public:
   // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
-  enum class InputNames : uint8_t { X, W };
+  enum class InputNames : uint8_t { X, W, SCALE_X, SCALE_W };
   enum class OutputNames : uint8_t { Y };
 
+  // How the compiler should lower the convolution, see `setLoweringHint()`.
+  //   AUTO:     the compiler's choice
+  //   DIRECT:   direct convolution, without the implicit GEMM (im2col fused
+  //             into the matmul) IREE uses on AMDGPU by default
+  //   WINOGRAD: Winograd F(6x6, 3x3) transforms, trading FLOPs for the
+  //             bandwidth of the input and output transforms
+  //   IM2COL:   explicit im2col followed by a matmul
+  enum class LoweringHint : uint8_t { AUTO, DIRECT, WINOGRAD, IM2COL };
+
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
   std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
 
   // Setters:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvFPropAttr, InputNames, X)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvFPropAttr, InputNames, W)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvFPropAttr, InputNames, SCALE_X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvFPropAttr, InputNames, SCALE_W)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ConvFPropAttr, OutputNames, Y)
 
   ConvFPropAttr &setPadding(const std::vector<int64_t> &padding) {
@@ -65,25 +77,63 @@ public:
     return *this;
   }
 
+  // Requests a lowering strategy. Hints map onto compiler flags, which apply
+  // to the whole graph, so all convolutions of a graph with a hint other than
+  // AUTO must agree (see `Graph::getConvLoweringHint()`). WINOGRAD and IM2COL
+  // are limited to ungrouped, unquantized 2D convolutions, WINOGRAD further
+  // to 3x3 filters with unit stride and dilation.
+  ConvFPropAttr &setLoweringHint(LoweringHint hint) {
+    loweringHint_ = hint;
+    return *this;
+  }
+
   // Getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, W)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE_X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE_W)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
 
   const std::vector<int64_t> &getPadding() const { return padding_; }
   const std::vector<int64_t> &getStride() const { return stride_; }
   const std::vector<int64_t> &getDilation() const { return dilation_; }
+  LoweringHint getLoweringHint() const { return loweringHint_; }
+
+  static const std::unordered_map<LoweringHint, std::string>
+      kLoweringHintToStr;
+
+  // Quantized convolution: X and W hold FP8 or int8 values whose real values
+  // are X * SCALE_X and W * SCALE_W. SCALE_X is per tensor (all dims 1),
+  // SCALE_W per tensor or per output channel, given in the broadcast shape of
+  // Y ([1, K, 1, ...]). Both are applied to the f32 (int32 for int8)
+  // accumulator of the convolution.
+  bool hasScales() const { return getSCALE_X() || getSCALE_W(); }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(padding_).io(stride_).io(dilation_).io(loweringHint_);
+  }
 
 private:
   std::vector<int64_t> padding_;
   std::vector<int64_t> stride_;
   std::vector<int64_t> dilation_;
+  LoweringHint loweringHint_ = LoweringHint::AUTO;
+};
+
+inline const std::unordered_map<ConvFPropAttr::LoweringHint, std::string>
+    ConvFPropAttr::kLoweringHintToStr = {
+        {ConvFPropAttr::LoweringHint::AUTO, "AUTO"},
+        {ConvFPropAttr::LoweringHint::DIRECT, "DIRECT"},
+        {ConvFPropAttr::LoweringHint::WINOGRAD, "WINOGRAD"},
+        {ConvFPropAttr::LoweringHint::IM2COL, "IM2COL"},
 };
 
 class ConvWGradAttr : public AttributesCRTP<ConvWGradAttr> {
 public:
   enum class InputNames : uint8_t { DY, X };
-  enum class OutputNames : uint8_t { DW };
+  enum class OutputNames : uint8_t { DW, DBIAS };
 
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
   std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
@@ -92,6 +142,7 @@ public:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvWGradAttr, InputNames, DY)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvWGradAttr, InputNames, X)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ConvWGradAttr, OutputNames, DW)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ConvWGradAttr, OutputNames, DBIAS)
 
   ConvWGradAttr &setPadding(const std::vector<int64_t> &padding) {
     padding_ = padding;
@@ -124,11 +175,20 @@ public:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, DY)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DW)
+  // Optional bias gradient [K], DY summed over all but the channel dim. It is
+  // computed by the same op as DW, so DY is read once for both.
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DBIAS)
 
   const std::vector<int64_t> &getPadding() const { return padding_; }
   const std::vector<int64_t> &getStride() const { return stride_; }
   const std::vector<int64_t> &getDilation() const { return dilation_; }
 
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(padding_).io(stride_).io(dilation_);
+  }
+
 private:
   std::vector<int64_t> padding_;
   std::vector<int64_t> stride_;
@@ -184,10 +244,106 @@ public:
   const std::vector<int64_t> &getStride() const { return stride_; }
   const std::vector<int64_t> &getDilation() const { return dilation_; }
 
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(padding_).io(stride_).io(dilation_);
+  }
+
+private:
+  std::vector<int64_t> padding_;
+  std::vector<int64_t> stride_;
+  std::vector<int64_t> dilation_;
+};
+
+// Transposed convolution (a.k.a. fractionally strided convolution), as used by
+// decoders to upsample. The filter W uses the transposed layout [C, K/G, ...]
+// of the input channels C and output channels K, i.e. the layout of the
+// forward filter whose data gradient this computes. Unlike `ConvDGradAttr`,
+// the output shape is inferred, so the group count and the output padding
+// (extra size on one side of each spatial output dim, to disambiguate shapes
+// of strided convolutions) are attributes.
+class ConvTransposeAttr : public AttributesCRTP<ConvTransposeAttr> {
+public:
+  enum class InputNames : uint8_t { X, W };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvTransposeAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ConvTransposeAttr, InputNames, W)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ConvTransposeAttr, OutputNames, Y)
+
+  ConvTransposeAttr &setPadding(const std::vector<int64_t> &padding) {
+    padding_ = padding;
+    return *this;
+  }
+  template <Int64Range R> ConvTransposeAttr &setPadding(R &&padding) {
+    padding_.assign(padding.begin(), padding.end());
+    return *this;
+  }
+
+  ConvTransposeAttr &setStride(const std::vector<int64_t> &stride) {
+    stride_ = stride;
+    return *this;
+  }
+  template <Int64Range R> ConvTransposeAttr &setStride(R &&stride) {
+    stride_.assign(stride.begin(), stride.end());
+    return *this;
+  }
+
+  ConvTransposeAttr &setDilation(const std::vector<int64_t> &dilation) {
+    dilation_ = dilation;
+    return *this;
+  }
+  template <Int64Range R> ConvTransposeAttr &setDilation(R &&dilation) {
+    dilation_.assign(dilation.begin(), dilation.end());
+    return *this;
+  }
+
+  // Optional, zero in every spatial dim when not set.
+  ConvTransposeAttr &setOutputPadding(const std::vector<int64_t> &padding) {
+    outputPadding_ = padding;
+    return *this;
+  }
+  template <Int64Range R> ConvTransposeAttr &setOutputPadding(R &&padding) {
+    outputPadding_.assign(padding.begin(), padding.end());
+    return *this;
+  }
+
+  ConvTransposeAttr &setGroupCount(int64_t groupCount) {
+    groupCount_ = groupCount;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, W)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  const std::vector<int64_t> &getPadding() const { return padding_; }
+  const std::vector<int64_t> &getStride() const { return stride_; }
+  const std::vector<int64_t> &getDilation() const { return dilation_; }
+  const std::vector<int64_t> &getOutputPadding() const {
+    return outputPadding_;
+  }
+  int64_t getGroupCount() const { return groupCount_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(padding_).io(stride_).io(dilation_);
+    ar.io(outputPadding_).io(groupCount_);
+  }
+
 private:
   std::vector<int64_t> padding_;
   std::vector<int64_t> stride_;
   std::vector<int64_t> dilation_;
+  std::vector<int64_t> outputPadding_;
+  int64_t groupCount_ = 1;
 };
 
 } // namespace fusilli
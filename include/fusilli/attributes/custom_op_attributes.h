@@ -16,12 +16,75 @@
 #ifndef FUSILLI_ATTRIBUTES_CUSTOM_OP_ATTRIBUTES_H
 #define FUSILLI_ATTRIBUTES_CUSTOM_OP_ATTRIBUTES_H
 
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/support/archive.h"
+#include "fusilli/support/hash.h"
+#include "fusilli/support/logging.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fusilli {
 
+// A precompiled kernel implementing a custom op (e.g. a hand-tuned HIP
+// kernel built into a HSACO code object, or a ukernel object file), see
+// `CustomOpAttr::setExternalKernel()`.
+//
+// ABI: the kernel takes one storage buffer binding per custom op input
+// (read-only) followed by one per output, in order, and no push constants.
+// Every buffer holds the tensor densely in logical dim order (row-major over
+// `getDim()`), whatever its strides in the graph. Shapes are static.
+struct ExternalKernel {
+  // Executable target the object was built for, as in
+  // `#hal.executable.target<"{backend}", "{format}", {target_arch = ...}>`.
+  std::string backend = "rocm";
+  std::string format = "rocm-hsaco-fb";
+  std::string targetArch = "gfx942";
+  // Path to the code object. It is read when the graph is compiled.
+  std::string objectPath;
+  // Name of the kernel exported by the object.
+  std::string entryPoint;
+  // Launch configuration.
+  std::array<int64_t, 3> workgroupSize = {1, 1, 1};
+  std::array<int64_t, 3> workgroupCount = {1, 1, 1};
+
+  void archive(Archive &ar) {
+    ar.io(backend)
+        .io(format)
+        .io(targetArch)
+        .io(objectPath)
+        .io(entryPoint)
+        .io(workgroupSize)
+        .io(workgroupCount);
+  }
+};
+
 class CustomOpAttr {
 public:
+  // Callback inferring output properties from the (context filled) inputs,
+  // see `setShapeInference()`.
+  using ShapeInferenceFn = std::function<ErrorObject(
+      std::span<const std::shared_ptr<TensorAttr>> inputs,
+      std::span<const std::shared_ptr<TensorAttr>> outputs)>;
+
+  // Declarative inference rule of a single output.
+  enum class OutputRule : uint8_t {
+    // Set by the caller (or the shape inference callback).
+    None,
+    // Same dims, dynamic dims, stride and data type as input `input`.
+    SameAsInput,
+    // Broadcast of the dims of all inputs, with the data type of input 0.
+    BroadcastOfInputs,
+  };
+
   // Setters:
   CustomOpAttr &setName(const std::string &name) {
     name_ = name;
@@ -79,6 +142,16 @@ public:
   //   }
   CustomOpAttr &setMlir(const std::string &mlir) {
     mlir_ = mlir;
+    mlirHash_ = Hasher().update(mlir).digest();
+    return *this;
+  }
+
+  // Implements the custom op with a precompiled kernel instead of MLIR (the
+  // two are exclusive). The emitter embeds the kernel in the module as a
+  // `hal.executable.source` and generates the function `@<setName()>`
+  // dispatching it, so it runs inside the graph like any other op.
+  CustomOpAttr &setExternalKernel(ExternalKernel kernel) {
+    externalKernel_ = std::move(kernel);
     return *this;
   }
 
@@ -87,18 +160,92 @@ public:
     return *this;
   }
 
+  // Output shape inference.
+  //
+  // By default custom op outputs are not inferred: the caller sets dim,
+  // stride and data type on every tensor returned by `Graph::customOp()`.
+  // Instead, an output may follow a declarative rule, or a callback may
+  // compute any output property from the inputs. Rules are applied first
+  // and the callback runs after them. Properties already set on an output
+  // are never overwritten by a rule, so a rule can be partially overridden.
+  //
+  //   CustomOpAttr attr;
+  //   attr.setNumOutputs(2)
+  //       .setOutputSameAsInput(/*output=*/0, /*input=*/0)
+  //       .setOutputBroadcastOfInputs(/*output=*/1);
+  CustomOpAttr &setOutputSameAsInput(size_t output, size_t input) {
+    return setOutputRule(output, OutputRule::SameAsInput, input);
+  }
+
+  CustomOpAttr &setOutputBroadcastOfInputs(size_t output) {
+    return setOutputRule(output, OutputRule::BroadcastOfInputs);
+  }
+
+  CustomOpAttr &setShapeInference(ShapeInferenceFn fn) {
+    shapeInference_ = std::move(fn);
+    return *this;
+  }
+
   // Getters:
   const std::string &getName() const { return name_; }
 
   // Returns the MLIR template string (may contain unresolved placeholders).
   const std::string &getMlir() const { return mlir_; }
 
+  // Stable hash of the MLIR template, computed once by `setMlir()`.
+  uint64_t getMlirHash() const { return mlirHash_; }
+
+  const std::optional<ExternalKernel> &getExternalKernel() const {
+    return externalKernel_;
+  }
+
   size_t getNumOutputs() const { return numOutputs_; }
 
+  OutputRule getOutputRule(size_t output) const {
+    return output < outputRules_.size() ? outputRules_[output].rule
+                                        : OutputRule::None;
+  }
+
+  // Returns the input of a `SameAsInput` output.
+  size_t getOutputRuleInput(size_t output) const {
+    return output < outputRules_.size() ? outputRules_[output].input : 0;
+  }
+
+  const ShapeInferenceFn &getShapeInference() const { return shapeInference_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  // The shape inference callback is code and can't be serialized: it must be
+  // set again on deserialized custom ops that rely on it.
+  void archive(Archive &ar) {
+    ar.io(name_).io(mlir_).io(externalKernel_).io(numOutputs_);
+    ar.io(outputRules_);
+    if (ar.isReading())
+      mlirHash_ = Hasher().update(mlir_).digest();
+  }
+
 private:
+  struct OutputRuleEntry {
+    OutputRule rule = OutputRule::None;
+    size_t input = 0;
+
+    void archive(Archive &ar) { ar.io(rule).io(input); }
+  };
+
+  CustomOpAttr &setOutputRule(size_t output, OutputRule rule,
+                              size_t input = 0) {
+    if (output >= outputRules_.size())
+      outputRules_.resize(output + 1);
+    outputRules_[output] = {rule, input};
+    return *this;
+  }
+
   std::string name_;
   std::string mlir_;
+  uint64_t mlirHash_ = 0;
+  std::optional<ExternalKernel> externalKernel_;
   size_t numOutputs_ = 0;
+  std::vector<OutputRuleEntry> outputRules_;
+  ShapeInferenceFn shapeInference_;
 };
 
 } // namespace fusilli
@@ -27,8 +27,8 @@ namespace fusilli {
 class LayernormAttr : public AttributesCRTP<LayernormAttr> {
 public:
   // Names for Tensor Inputs and Outputs.
-  enum class InputNames : uint8_t { X, SCALE, BIAS, EPSILON };
-  enum class OutputNames : uint8_t { Y, MEAN, INV_VARIANCE };
+  enum class InputNames : uint8_t { X, SCALE, BIAS, EPSILON, RESIDUAL };
+  enum class OutputNames : uint8_t { Y, MEAN, INV_VARIANCE, SUM };
 
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
   std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
@@ -37,9 +37,11 @@ public:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormAttr, InputNames, X)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormAttr, InputNames, SCALE)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormAttr, InputNames, BIAS)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormAttr, InputNames, RESIDUAL)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormAttr, OutputNames, Y)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormAttr, OutputNames, MEAN)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormAttr, OutputNames, INV_VARIANCE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormAttr, OutputNames, SUM)
 
   LayernormAttr &setEpsilon(const std::shared_ptr<TensorAttr> &epsilon) {
     return setInput(InputNames::EPSILON, epsilon);
@@ -54,9 +56,11 @@ public:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, BIAS)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, RESIDUAL)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, MEAN)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, INV_VARIANCE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, SUM)
 
   std::shared_ptr<TensorAttr> getEpsilon() const {
     return getInput(InputNames::EPSILON);
@@ -64,10 +68,53 @@ public:
 
   NormFwdPhase getForwardPhase() const { return forwardPhase_; }
 
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(forwardPhase_);
+  }
+
 private:
   NormFwdPhase forwardPhase_ = NormFwdPhase::NOT_SET;
 };
 
+// Attributes of the LayerNorm backward node. The gradients are computed from
+// the MEAN and INV_VARIANCE saved by the training forward pass, so no epsilon
+// is needed.
+class LayernormBwdAttr : public AttributesCRTP<LayernormBwdAttr> {
+public:
+  // Names for Tensor Inputs and Outputs.
+  enum class InputNames : uint8_t { DY, X, SCALE, MEAN, INV_VARIANCE };
+  enum class OutputNames : uint8_t { DX, DSCALE, DBIAS };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormBwdAttr, InputNames, DY)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormBwdAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormBwdAttr, InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormBwdAttr, InputNames, MEAN)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(LayernormBwdAttr, InputNames,
+                                      INV_VARIANCE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormBwdAttr, OutputNames, DX)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormBwdAttr, OutputNames, DSCALE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(LayernormBwdAttr, OutputNames, DBIAS)
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, DY)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, MEAN)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, INV_VARIANCE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DX)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DSCALE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DBIAS)
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) { archiveTensors(ar); }
+};
+
 } // namespace fusilli
 
 #endif // FUSILLI_ATTRIBUTES_LAYERNORM_ATTRIBUTES_H
@@ -15,19 +15,34 @@
 #define FUSILLI_ATTRIBUTES_MATMUL_ATTRIBUTES_H
 
 #include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/pointwise_attributes.h"
 #include "fusilli/attributes/tensor_attributes.h"
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace fusilli {
 
 class MatmulAttr : public AttributesCRTP<MatmulAttr> {
 public:
   // Names for Tensor Inputs and Outputs (doesn't include constant attributes).
-  enum class InputNames : uint8_t { A, B };
-  enum class OutputNames : uint8_t { C };
+  enum class InputNames : uint8_t {
+    A,
+    B,
+    BIAS,
+    RESIDUAL,
+    SCALE_A,
+    SCALE_B,
+    GROUP_SIZES,
+    B_META,
+    B_SCALE,
+    B_ZERO
+  };
+  enum class OutputNames : uint8_t { C, DBIAS };
 
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
   std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
@@ -35,12 +50,187 @@ public:
   // Setters:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, A)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, B)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, BIAS)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, RESIDUAL)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, SCALE_A)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, SCALE_B)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, GROUP_SIZES)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, B_META)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, B_SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(MatmulAttr, InputNames, B_ZERO)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(MatmulAttr, OutputNames, C)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(MatmulAttr, OutputNames, DBIAS)
+
+  // Epilogue applied to the product before it is written to C:
+  //   C = activation(alpha * (A @ B) + BIAS) + beta * RESIDUAL
+  // BIAS, RESIDUAL and the activation are optional.
+  MatmulAttr &setActivation(PointwiseAttr::Mode activation) {
+    activation_ = activation;
+    return *this;
+  }
+
+  MatmulAttr &setAlpha(float alpha) {
+    alpha_ = alpha;
+    return *this;
+  }
+
+  MatmulAttr &setBeta(float beta) {
+    beta_ = beta;
+    return *this;
+  }
+
+  // Gated (GLU) epilogue of a transformer MLP: B packs the gate and up
+  // projections side by side [..., K, 2N], gate first, and
+  //   C = gate(A @ B[..., :N]) * (A @ B[..., N:])
+  // so A is read by a single matmul and only the gated product is written.
+  // SWISH_FWD gives SwiGLU, GELU_FWD and GELU_APPROX_TANH_FWD give GeGLU.
+  MatmulAttr &setGate(PointwiseAttr::Mode gate) {
+    gate_ = gate;
+    return *this;
+  }
+
+  // Group size along K of the group-wise quantized weights, see
+  // `isGroupQuantized()`.
+  MatmulAttr &setGroupSize(int64_t groupSize) {
+    groupSize_ = groupSize;
+    return *this;
+  }
+
+  // Lowering hints of this matmul alone, where compiler flags apply to every
+  // op of the graph, so one graph can mix strategies.
+  //
+  // Split-K: the contraction dim K is split into `splitK` slices whose
+  // partial products are computed by a single batched matmul and summed in
+  // f32. This exposes parallelism for skinny shapes with a long K, at the
+  // cost of writing the partial products.
+  MatmulAttr &setSplitK(int64_t splitK) {
+    splitK_ = splitK;
+    return *this;
+  }
+
+  // Lowering config of the matmul dispatch on AMDGPU, passed to the compiler
+  // in a tuning spec generated for the graph (see
+  // `Graph::emitTuningSpecAsm()`). Tile sizes cover the iteration space
+  // [..., M, N, K], batch dims first, with 0 for untiled dims: `workgroup`
+  // for the parallel dims and `reduction` for K. `workgroupSize` is the
+  // number of threads of a workgroup in [x, y, z].
+  MatmulAttr &setTileSizes(std::vector<int64_t> workgroup,
+                           std::vector<int64_t> reduction,
+                           std::vector<int64_t> workgroupSize,
+                           int64_t subgroupSize = 64) {
+    workgroupTile_ = std::move(workgroup);
+    reductionTile_ = std::move(reduction);
+    workgroupSize_ = std::move(workgroupSize);
+    subgroupSize_ = subgroupSize;
+    return *this;
+  }
+
+  // Matrix core intrinsic of the lowering config, e.g.
+  // "MFMA_F32_16x16x16_F16", see `setTileSizes()`.
+  MatmulAttr &setMmaIntrinsic(std::string intrinsic) {
+    mmaIntrinsic_ = std::move(intrinsic);
+    return *this;
+  }
 
   // Getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, A)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, B)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, BIAS)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, RESIDUAL)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE_A)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE_B)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, GROUP_SIZES)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, B_META)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, B_SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, B_ZERO)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, C)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DBIAS)
+
+  PointwiseAttr::Mode getActivation() const { return activation_; }
+  float getAlpha() const { return alpha_; }
+  float getBeta() const { return beta_; }
+  PointwiseAttr::Mode getGate() const { return gate_; }
+  int64_t getGroupSize() const { return groupSize_; }
+  int64_t getSplitK() const { return splitK_; }
+  const std::vector<int64_t> &getWorkgroupTile() const {
+    return workgroupTile_;
+  }
+  const std::vector<int64_t> &getReductionTile() const {
+    return reductionTile_;
+  }
+  const std::vector<int64_t> &getWorkgroupSize() const {
+    return workgroupSize_;
+  }
+  int64_t getSubgroupSize() const { return subgroupSize_; }
+  const std::string &getMmaIntrinsic() const { return mmaIntrinsic_; }
+
+  bool isSplitK() const { return splitK_ > 1; }
+  bool hasLoweringConfig() const { return !workgroupTile_.empty(); }
+
+  bool isGated() const { return gate_ != PointwiseAttr::Mode::NOT_SET; }
+
+  // Quantized matmul: A and B hold FP8 or int8 values whose real values are
+  // A * SCALE_A and B * SCALE_B. SCALE_A is per tensor or per row of A
+  // ([..., M, 1]), SCALE_B per tensor or per column of B ([..., 1, N]), so
+  // both factor out of the product and are applied to the f32 (int32 for
+  // int8) accumulator before the epilogue.
+  bool hasScales() const { return getSCALE_A() || getSCALE_B(); }
+
+  // Grouped (mixture-of-experts) matmul: A [E, M, K] holds the rows routed to
+  // each of the E groups, padded to M, and B [E, K, N] the per-group weights.
+  // The [E] GROUP_SIZES tensor holds the number of valid rows of each group;
+  // the rows of C past a group's size are zero. M may be dynamic, so one
+  // compiled graph serves any routing in a single batched dispatch.
+  bool isGrouped() const { return getGROUP_SIZES() != nullptr; }
+
+  // 2:4 structured-sparse weights: every group of four consecutive rows of B
+  // along K holds at most two non-zeros per column. B then holds only the
+  // kept values [..., K/2, N], and the Int8 B_META [..., K/2, N] the position
+  // (0-3) of each within its group, as packed by `packSparse24()`. B is
+  // expanded to its dense [..., K, N] form in the producer of the matmul
+  // operand, so the weights are read from memory at half their dense size.
+  bool isSparse() const { return getB_META() != nullptr; }
+
+  // Group-wise quantized weights (e.g. GPTQ or AWQ int4 checkpoints): B holds
+  // Int4 or Int8 values [..., K, N] whose real values are
+  //   (B - B_ZERO) * B_SCALE
+  // where B_SCALE and the optional B_ZERO [..., K/G, N] hold one value per
+  // group of G = `getGroupSize()` consecutive rows along K and column. B is
+  // dequantized to the data type of A in the producer of the matmul operand,
+  // so the weights are read from memory at their quantized size.
+  bool isGroupQuantized() const { return getB_SCALE() != nullptr; }
+
+  // Weight gradient of a linear layer: with A = DY^T [..., N, M] and
+  // B = X [..., M, K], C is DW [..., N, K] and the optional DBIAS [..., N] is
+  // A summed over the contraction dim, computed alongside the product so DY
+  // is read once for both gradients.
+  bool hasBiasGradient() const { return getDBIAS() != nullptr; }
+
+  bool hasEpilogue() const {
+    return getBIAS() || getRESIDUAL() ||
+           activation_ != PointwiseAttr::Mode::NOT_SET || alpha_ != 1.0f;
+  }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(activation_).io(alpha_).io(beta_).io(gate_).io(groupSize_);
+    ar.io(splitK_).io(workgroupTile_).io(reductionTile_).io(workgroupSize_);
+    ar.io(subgroupSize_).io(mmaIntrinsic_);
+  }
+
+private:
+  PointwiseAttr::Mode activation_ = PointwiseAttr::Mode::NOT_SET;
+  float alpha_ = 1.0f;
+  float beta_ = 1.0f;
+  PointwiseAttr::Mode gate_ = PointwiseAttr::Mode::NOT_SET;
+  int64_t groupSize_ = 0;
+  int64_t splitK_ = 1;
+  std::vector<int64_t> workgroupTile_;
+  std::vector<int64_t> reductionTile_;
+  std::vector<int64_t> workgroupSize_;
+  int64_t subgroupSize_ = 64;
+  std::string mmaIntrinsic_;
 };
 
 } // namespace fusilli
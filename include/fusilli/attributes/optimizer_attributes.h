@@ -0,0 +1,182 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains attributes (compile-time constant metadata) for
+// optimizer update nodes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_ATTRIBUTES_OPTIMIZER_ATTRIBUTES_H
+#define FUSILLI_ATTRIBUTES_OPTIMIZER_ATTRIBUTES_H
+
+#include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fusilli {
+
+class OptimizerAttr : public AttributesCRTP<OptimizerAttr> {
+public:
+  // Names for the scalar hyperparameter inputs: [1] float tensors, either
+  // inlined constants (e.g. `TensorAttr(0.9f)`) or runtime inputs (e.g. a
+  // scheduled learning rate, or the step count).
+  enum class InputNames : uint8_t {
+    LR,
+    BETA1,
+    BETA2,
+    EPSILON,
+    WEIGHT_DECAY,
+    MOMENTUM,
+    STEP
+  };
+  // The updated tensors are lists, see `setNewParams()` and the likes.
+  enum class OutputNames : uint8_t {};
+
+  // SGD:   G' = G + WEIGHT_DECAY * P
+  //        with MOMENTUM: M = MOMENTUM * M + G',
+  //                       U = G' + MOMENTUM * M (Nesterov) or M
+  //        without:       U = G'
+  //        P = P - LR * U
+  // ADAM:  G' = G + WEIGHT_DECAY * P (L2 regularization)
+  // ADAMW: G' = G, P = P * (1 - LR * WEIGHT_DECAY) (decoupled decay)
+  //        then for both
+  //        M = BETA1 * M + (1 - BETA1) * G'
+  //        V = BETA2 * V + (1 - BETA2) * G'^2
+  //        P = P - LR / (1 - BETA1^STEP) * M /
+  //                (sqrt(V) / sqrt(1 - BETA2^STEP) + EPSILON)
+  // where WEIGHT_DECAY defaults to 0 (no decay) when not set.
+  enum class Mode : uint8_t { NOT_SET, SGD, ADAM, ADAMW };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Scalar hyperparameter setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(OptimizerAttr, InputNames, LR)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(OptimizerAttr, InputNames, BETA1)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(OptimizerAttr, InputNames, BETA2)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(OptimizerAttr, InputNames, EPSILON)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(OptimizerAttr, InputNames, WEIGHT_DECAY)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(OptimizerAttr, InputNames, MOMENTUM)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(OptimizerAttr, InputNames, STEP)
+
+  // Scalar hyperparameter getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, LR)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, BETA1)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, BETA2)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, EPSILON)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, WEIGHT_DECAY)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, MOMENTUM)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, STEP)
+
+  // Tensor list setters. The i-th gradient and moments belong to the i-th
+  // parameter. Moments 1 are the SGD momentum buffers or the Adam first
+  // moments, moments 2 the Adam second moments.
+  using TensorList = std::vector<std::shared_ptr<TensorAttr>>;
+  OptimizerAttr &setParams(const TensorList &params) {
+    params_ = params;
+    return *this;
+  }
+  OptimizerAttr &setGrads(const TensorList &grads) {
+    grads_ = grads;
+    return *this;
+  }
+  OptimizerAttr &setMoments1(const TensorList &moments1) {
+    moments1_ = moments1;
+    return *this;
+  }
+  OptimizerAttr &setMoments2(const TensorList &moments2) {
+    moments2_ = moments2;
+    return *this;
+  }
+  OptimizerAttr &setNewParams(const TensorList &newParams) {
+    newParams_ = newParams;
+    return *this;
+  }
+  OptimizerAttr &setNewMoments1(const TensorList &newMoments1) {
+    newMoments1_ = newMoments1;
+    return *this;
+  }
+  OptimizerAttr &setNewMoments2(const TensorList &newMoments2) {
+    newMoments2_ = newMoments2;
+    return *this;
+  }
+
+  // Tensor list getters:
+  const TensorList &getParams() const { return params_; }
+  const TensorList &getGrads() const { return grads_; }
+  const TensorList &getMoments1() const { return moments1_; }
+  const TensorList &getMoments2() const { return moments2_; }
+  const TensorList &getNewParams() const { return newParams_; }
+  const TensorList &getNewMoments1() const { return newMoments1_; }
+  const TensorList &getNewMoments2() const { return newMoments2_; }
+
+  // Scalar attribute setters:
+  OptimizerAttr &setMode(Mode mode) {
+    mode_ = mode;
+    return *this;
+  }
+
+  // Nesterov momentum, for SGD with MOMENTUM.
+  OptimizerAttr &setNesterov(bool nesterov) {
+    nesterov_ = nesterov;
+    return *this;
+  }
+
+  // Scalar attribute getters:
+  Mode getMode() const { return mode_; }
+  bool getNesterov() const { return nesterov_; }
+
+  // Returns whether the mode keeps first moments (momentum buffers), resp.
+  // second moments.
+  bool hasMoments1() const {
+    return mode_ == Mode::ADAM || mode_ == Mode::ADAMW ||
+           (mode_ == Mode::SGD && getMOMENTUM());
+  }
+  bool hasMoments2() const {
+    return mode_ == Mode::ADAM || mode_ == Mode::ADAMW;
+  }
+
+  // Utilities for optimizer modes.
+  static const std::unordered_map<Mode, std::string> kModeToStr;
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(mode_).io(nesterov_);
+    ar.io(params_).io(grads_).io(moments1_).io(moments2_);
+    ar.io(newParams_).io(newMoments1_).io(newMoments2_);
+  }
+
+private:
+  Mode mode_ = Mode::NOT_SET;
+  bool nesterov_ = false;
+  TensorList params_;
+  TensorList grads_;
+  TensorList moments1_;
+  TensorList moments2_;
+  TensorList newParams_;
+  TensorList newMoments1_;
+  TensorList newMoments2_;
+};
+
+inline const std::unordered_map<OptimizerAttr::Mode, std::string>
+    OptimizerAttr::kModeToStr = {
+        {OptimizerAttr::Mode::NOT_SET, "NOT_SET"},
+        {OptimizerAttr::Mode::SGD, "SGD"},
+        {OptimizerAttr::Mode::ADAM, "ADAM"},
+        {OptimizerAttr::Mode::ADAMW, "ADAMW"},
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_ATTRIBUTES_OPTIMIZER_ATTRIBUTES_H
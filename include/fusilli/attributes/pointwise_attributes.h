@@ -138,6 +138,16 @@ public:
   static const std::unordered_map<PointwiseAttr::Mode, int>
       kModeToRequiredInputCount;
 
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(mode_)
+        .io(eluAlpha_)
+        .io(softplusBeta_)
+        .io(softplusThreshold_)
+        .io(swishBeta_);
+  }
+
 private:
   Mode mode_ = Mode::NOT_SET;
   float eluAlpha_ = 1.0f;
@@ -0,0 +1,146 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains attributes (compile-time constant metadata) for
+// pooling nodes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_ATTRIBUTES_POOLING_ATTRIBUTES_H
+#define FUSILLI_ATTRIBUTES_POOLING_ATTRIBUTES_H
+
+#include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fusilli {
+
+#define FUSILLI_POOLING_MODES(OP)                                              \
+  OP(NOT_SET)                                                                  \
+  OP(MAX)                                                                      \
+  OP(AVG)
+
+class PoolingAttr : public AttributesCRTP<PoolingAttr> {
+public:
+  // Names for Tensor Inputs and Outputs. Pooling has a single input.
+  enum class InputNames : uint8_t { X };
+  enum class OutputNames : uint8_t { Y };
+
+  enum class Mode : uint8_t {
+#define FUSILLI_POOLING_MODE_ENUM(mode) mode,
+    FUSILLI_POOLING_MODES(FUSILLI_POOLING_MODE_ENUM)
+#undef FUSILLI_POOLING_MODE_ENUM
+  };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(PoolingAttr, InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(PoolingAttr, OutputNames, Y)
+
+  PoolingAttr &setMode(Mode mode) {
+    mode_ = mode;
+    return *this;
+  }
+
+  // Size of the pooling window along each spatial dim.
+  PoolingAttr &setWindow(const std::vector<int64_t> &window) {
+    window_ = window;
+    return *this;
+  }
+  template <Int64Range R> PoolingAttr &setWindow(R &&window) {
+    window_.assign(window.begin(), window.end());
+    return *this;
+  }
+
+  PoolingAttr &setPadding(const std::vector<int64_t> &padding) {
+    padding_ = padding;
+    return *this;
+  }
+  template <Int64Range R> PoolingAttr &setPadding(R &&padding) {
+    padding_.assign(padding.begin(), padding.end());
+    return *this;
+  }
+
+  PoolingAttr &setStride(const std::vector<int64_t> &stride) {
+    stride_ = stride;
+    return *this;
+  }
+  template <Int64Range R> PoolingAttr &setStride(R &&stride) {
+    stride_.assign(stride.begin(), stride.end());
+    return *this;
+  }
+
+  // Optional, a dilation of 1 along each spatial dim when not set. Only MAX
+  // pooling supports other dilations.
+  PoolingAttr &setDilation(const std::vector<int64_t> &dilation) {
+    dilation_ = dilation;
+    return *this;
+  }
+  template <Int64Range R> PoolingAttr &setDilation(R &&dilation) {
+    dilation_.assign(dilation.begin(), dilation.end());
+    return *this;
+  }
+
+  // Whether AVG pooling counts the padded elements of a window in the
+  // divisor (the default, as in PyTorch). Ignored by MAX pooling.
+  PoolingAttr &setCountIncludePad(bool v) {
+    countIncludePad_ = v;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  Mode getMode() const { return mode_; }
+  const std::vector<int64_t> &getWindow() const { return window_; }
+  const std::vector<int64_t> &getPadding() const { return padding_; }
+  const std::vector<int64_t> &getStride() const { return stride_; }
+  const std::vector<int64_t> &getDilation() const { return dilation_; }
+  bool getCountIncludePad() const { return countIncludePad_; }
+
+  // Utilities for pooling modes.
+  static const std::unordered_map<Mode, std::string> kModeToStr;
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(mode_)
+        .io(window_)
+        .io(padding_)
+        .io(stride_)
+        .io(dilation_)
+        .io(countIncludePad_);
+  }
+
+private:
+  Mode mode_ = Mode::NOT_SET;
+  std::vector<int64_t> window_;
+  std::vector<int64_t> padding_;
+  std::vector<int64_t> stride_;
+  std::vector<int64_t> dilation_;
+  bool countIncludePad_ = true;
+};
+
+inline const std::unordered_map<PoolingAttr::Mode, std::string>
+#define FUSILLI_POOLING_MODE_MAP(mode) {PoolingAttr::Mode::mode, #mode},
+    PoolingAttr::kModeToStr = {FUSILLI_POOLING_MODES(FUSILLI_POOLING_MODE_MAP)};
+#undef FUSILLI_POOLING_MODE_MAP
+
+#undef FUSILLI_POOLING_MODES
+
+} // namespace fusilli
+
+#endif // FUSILLI_ATTRIBUTES_POOLING_ATTRIBUTES_H
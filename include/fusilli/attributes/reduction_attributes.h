@@ -35,13 +35,20 @@ namespace fusilli {
   OP(AVG)                                                                      \
   OP(NORM1)                                                                    \
   OP(NORM2)                                                                    \
-  OP(MUL_NO_ZEROS)
+  OP(MUL_NO_ZEROS)                                                             \
+  OP(MIN_MAX)                                                                  \
+  OP(SUM_SUMSQ)                                                                \
+  OP(MEAN_VAR)                                                                 \
+  OP(ARGMAX)                                                                   \
+  OP(ARGMIN)                                                                   \
+  OP(TOPK)
 
 class ReductionAttr : public AttributesCRTP<ReductionAttr> {
 public:
-  // Names for Tensor Inputs and Outputs. Reduction has a single input.
+  // Names for Tensor Inputs and Outputs. Reduction has a single input. The
+  // multi-output modes (see `isMultiOutputMode`) also write Y2.
   enum class InputNames : uint8_t { X };
-  enum class OutputNames : uint8_t { Y };
+  enum class OutputNames : uint8_t { Y, Y2 };
 
   enum class Mode : uint8_t {
 #define FUSILLI_REDUCTION_MODE_ENUM(mode) mode,
@@ -55,6 +62,7 @@ public:
   // Setters:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ReductionAttr, InputNames, X)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ReductionAttr, OutputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ReductionAttr, OutputNames, Y2)
 
   ReductionAttr &setMode(Mode mode) {
     mode_ = mode;
@@ -64,12 +72,38 @@ public:
   // Getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y2)
 
   Mode getMode() const { return mode_; }
 
+  // Multi-output modes compute two statistics of X in a single pass over it:
+  //   MIN_MAX:   Y = min, Y2 = max
+  //   SUM_SUMSQ: Y = sum, Y2 = sum of squares
+  //   MEAN_VAR:  Y = mean, Y2 = (population) variance
+  //   TOPK:      Y = k largest values, Y2 = their indices
+  static bool isMultiOutputMode(Mode mode) {
+    return mode == Mode::MIN_MAX || mode == Mode::SUM_SUMSQ ||
+           mode == Mode::MEAN_VAR || mode == Mode::TOPK;
+  }
+
+  // Index modes reduce a single dimension of X to Int64 indices along it:
+  //   ARGMAX: Y = index of the max
+  //   ARGMIN: Y = index of the min
+  //   TOPK:   Y2 = indices of the k largest values (in descending order),
+  //           with k the size of Y along the reduced dimension
+  static bool isIndexMode(Mode mode) {
+    return mode == Mode::ARGMAX || mode == Mode::ARGMIN || mode == Mode::TOPK;
+  }
+
   // Utilities for reduction modes.
   static const std::unordered_map<Mode, std::string> kModeToStr;
 
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(mode_);
+  }
+
 private:
   Mode mode_ = Mode::NOT_SET;
 };
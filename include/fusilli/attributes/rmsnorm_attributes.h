@@ -27,8 +27,8 @@ namespace fusilli {
 class RmsnormAttr : public AttributesCRTP<RmsnormAttr> {
 public:
   // Names for Tensor Inputs and Outputs.
-  enum class InputNames : uint8_t { X, SCALE, EPSILON };
-  enum class OutputNames : uint8_t { Y, INV_RMS };
+  enum class InputNames : uint8_t { X, SCALE, EPSILON, RESIDUAL };
+  enum class OutputNames : uint8_t { Y, INV_RMS, SUM };
 
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
   std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
@@ -36,8 +36,10 @@ public:
   // Setters:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormAttr, InputNames, X)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormAttr, InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormAttr, InputNames, RESIDUAL)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(RmsnormAttr, OutputNames, Y)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(RmsnormAttr, OutputNames, INV_RMS)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(RmsnormAttr, OutputNames, SUM)
 
   RmsnormAttr &setEpsilon(const std::shared_ptr<TensorAttr> &epsilon) {
     return setInput(InputNames::EPSILON, epsilon);
@@ -51,8 +53,10 @@ public:
   // Getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, RESIDUAL)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, INV_RMS)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, SUM)
 
   std::shared_ptr<TensorAttr> getEpsilon() const {
     return getInput(InputNames::EPSILON);
@@ -60,10 +64,47 @@ public:
 
   NormFwdPhase getForwardPhase() const { return forwardPhase_; }
 
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(forwardPhase_);
+  }
+
 private:
   NormFwdPhase forwardPhase_ = NormFwdPhase::NOT_SET;
 };
 
+// Attributes of the RmsNorm backward node. The gradients are computed from
+// the INV_RMS of the forward pass, so no epsilon is needed.
+class RmsnormBwdAttr : public AttributesCRTP<RmsnormBwdAttr> {
+public:
+  // Names for Tensor Inputs and Outputs.
+  enum class InputNames : uint8_t { DY, X, SCALE, INV_RMS };
+  enum class OutputNames : uint8_t { DX, DSCALE };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormBwdAttr, InputNames, DY)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormBwdAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormBwdAttr, InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(RmsnormBwdAttr, InputNames, INV_RMS)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(RmsnormBwdAttr, OutputNames, DX)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(RmsnormBwdAttr, OutputNames, DSCALE)
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, DY)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SCALE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, INV_RMS)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DX)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DSCALE)
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) { archiveTensors(ar); }
+};
+
 } // namespace fusilli
 
 #endif // FUSILLI_ATTRIBUTES_RMSNORM_ATTRIBUTES_H
@@ -27,8 +27,20 @@ namespace fusilli {
 class SdpaAttr : public AttributesCRTP<SdpaAttr> {
 public:
   // Names for Tensor Inputs and Outputs.
-  enum class InputNames : uint8_t { Q, K, V, MASK };
-  enum class OutputNames : uint8_t { O };
+  enum class InputNames : uint8_t {
+    Q,
+    K,
+    V,
+    MASK,
+    PAGE_TABLE,
+    CU_SEQLENS_Q,
+    CU_SEQLENS_KV,
+    DROPOUT_SEED,
+    DROPOUT_OFFSET,
+    ROPE_COS,
+    ROPE_SIN
+  };
+  enum class OutputNames : uint8_t { O, STATS };
 
   std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
   std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
@@ -38,14 +50,30 @@ public:
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, K)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, V)
   FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, MASK)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, PAGE_TABLE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, CU_SEQLENS_Q)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, CU_SEQLENS_KV)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, DROPOUT_SEED)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, DROPOUT_OFFSET)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, ROPE_COS)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaAttr, InputNames, ROPE_SIN)
   FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SdpaAttr, OutputNames, O)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SdpaAttr, OutputNames, STATS)
 
   // Tensor getters:
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, Q)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, K)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, V)
   FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, MASK)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, PAGE_TABLE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, CU_SEQLENS_Q)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, CU_SEQLENS_KV)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, DROPOUT_SEED)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, DROPOUT_OFFSET)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, ROPE_COS)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, ROPE_SIN)
   FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, O)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, STATS)
 
   // Scalar attribute setters:
   SdpaAttr &setDropout(float p) {
@@ -68,17 +96,117 @@ public:
     return *this;
   }
 
+  // Paged KV-cache mode: K and V are page pools of shape
+  // [num_pages, heads_kv, block_size, head_dim] and PAGE_TABLE is the
+  // [batch, pages_per_seq] block table mapping each sequence to its pages.
+  SdpaAttr &setBlockSize(int64_t v) {
+    blockSize_ = v;
+    return *this;
+  }
+
   // Scalar attribute getters:
   float getDropout() const { return dropout_; }
   bool getIsCausal() const { return isCausal_; }
   std::optional<float> getScale() const { return scale_; }
   bool getEnableGqa() const { return enableGqa_; }
+  int64_t getBlockSize() const { return blockSize_; }
+  bool isPaged() const { return getPAGE_TABLE() != nullptr; }
+  // Varlen mode: Q, K and V pack the sequences of a batch back to back as
+  // [total_q, heads_q, head_dim] and [total_kv, heads_kv, head_dim], and the
+  // [batch + 1] CU_SEQLENS_Q / CU_SEQLENS_KV tensors hold the cumulative
+  // sequence offsets (0, len_0, len_0 + len_1, ...).
+  bool isVarlen() const {
+    return getCU_SEQLENS_Q() != nullptr || getCU_SEQLENS_KV() != nullptr;
+  }
+  // Runtime dropout RNG: DROPOUT_SEED and DROPOUT_OFFSET are [1] int64
+  // tensors bound at execution, which select the dropout mask through a
+  // counter-based Philox generator. One compiled graph then draws a new,
+  // reproducible mask per step (e.g. by advancing the offset) without
+  // recompiling.
+  bool hasDropoutRng() const {
+    return getDROPOUT_SEED() != nullptr || getDROPOUT_OFFSET() != nullptr;
+  }
+  // Rotary position embedding: ROPE_COS and ROPE_SIN are the
+  // [seq, head_dim] cos/sin tables of the positions of Q and K (each
+  // frequency repeated over both halves of head_dim). Q and K are rotated as
+  // `x * cos + rotate_half(x) * sin`, with rotate_half(x) = [-x2, x1], by the
+  // attention node itself rather than by separate ops writing Q and K back.
+  bool hasRope() const {
+    return getROPE_COS() != nullptr || getROPE_SIN() != nullptr;
+  }
+  // Training mode: STATS is the [batch, heads_q, seq_q, 1] logsumexp of the
+  // scaled attention scores, saved for `SdpaBwdAttr`.
+  bool hasStats() const { return getSTATS() != nullptr; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(dropout_).io(isCausal_).io(scale_).io(enableGqa_).io(blockSize_);
+  }
 
 private:
   float dropout_ = 0.0f;
   bool isCausal_ = false;
   std::optional<float> scale_ = std::nullopt;
   bool enableGqa_ = false;
+  int64_t blockSize_ = 0;
+};
+
+class SdpaBwdAttr : public AttributesCRTP<SdpaBwdAttr> {
+public:
+  // Names for Tensor Inputs and Outputs.
+  enum class InputNames : uint8_t { Q, K, V, O, DO, STATS };
+  enum class OutputNames : uint8_t { DQ, DK, DV };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Tensor setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaBwdAttr, InputNames, Q)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaBwdAttr, InputNames, K)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaBwdAttr, InputNames, V)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaBwdAttr, InputNames, O)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaBwdAttr, InputNames, DO)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SdpaBwdAttr, InputNames, STATS)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SdpaBwdAttr, OutputNames, DQ)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SdpaBwdAttr, OutputNames, DK)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SdpaBwdAttr, OutputNames, DV)
+
+  // Tensor getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, Q)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, K)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, V)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, O)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, DO)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, STATS)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DQ)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DK)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, DV)
+
+  // Scalar attribute setters (must match the forward pass):
+  SdpaBwdAttr &setIsCausal(bool v) {
+    isCausal_ = v;
+    return *this;
+  }
+
+  SdpaBwdAttr &setScale(std::optional<float> s) {
+    scale_ = s;
+    return *this;
+  }
+
+  // Scalar attribute getters:
+  bool getIsCausal() const { return isCausal_; }
+  std::optional<float> getScale() const { return scale_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(isCausal_).io(scale_);
+  }
+
+private:
+  bool isCausal_ = false;
+  std::optional<float> scale_ = std::nullopt;
 };
 
 } // namespace fusilli
@@ -0,0 +1,339 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains attributes (compile-time constant metadata) for the
+// shape manipulation nodes like `ReshapeNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_ATTRIBUTES_SHAPE_ATTRIBUTES_H
+#define FUSILLI_ATTRIBUTES_SHAPE_ATTRIBUTES_H
+
+#include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fusilli {
+
+class ReshapeAttr : public AttributesCRTP<ReshapeAttr> {
+public:
+  enum class InputNames : uint8_t { X };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(ReshapeAttr, InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ReshapeAttr, OutputNames, Y)
+
+  // Logical dims of Y. A single -1 entry is inferred from the element count
+  // of X. Optional when the dims of Y are set.
+  ReshapeAttr &setShape(const std::vector<int64_t> &shape) {
+    shape_ = shape;
+    return *this;
+  }
+  template <Int64Range R> ReshapeAttr &setShape(R &&shape) {
+    shape_.assign(shape.begin(), shape.end());
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  const std::vector<int64_t> &getShape() const { return shape_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(shape_);
+  }
+
+private:
+  std::vector<int64_t> shape_;
+};
+
+class PermuteAttr : public AttributesCRTP<PermuteAttr> {
+public:
+  enum class InputNames : uint8_t { X };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(PermuteAttr, InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(PermuteAttr, OutputNames, Y)
+
+  // Logical dim i of Y is logical dim `order[i]` of X.
+  PermuteAttr &setOrder(const std::vector<int64_t> &order) {
+    order_ = order;
+    return *this;
+  }
+  template <Int64Range R> PermuteAttr &setOrder(R &&order) {
+    order_.assign(order.begin(), order.end());
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  const std::vector<int64_t> &getOrder() const { return order_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(order_);
+  }
+
+private:
+  std::vector<int64_t> order_;
+};
+
+class SliceAttr : public AttributesCRTP<SliceAttr> {
+public:
+  enum class InputNames : uint8_t { X };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SliceAttr, InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SliceAttr, OutputNames, Y)
+
+  // Per logical dim of X, the slice keeps the indices start, start + step,
+  // ... below end. Step is optional and defaults to 1.
+  SliceAttr &setStart(const std::vector<int64_t> &start) {
+    start_ = start;
+    return *this;
+  }
+  template <Int64Range R> SliceAttr &setStart(R &&start) {
+    start_.assign(start.begin(), start.end());
+    return *this;
+  }
+
+  SliceAttr &setEnd(const std::vector<int64_t> &end) {
+    end_ = end;
+    return *this;
+  }
+  template <Int64Range R> SliceAttr &setEnd(R &&end) {
+    end_.assign(end.begin(), end.end());
+    return *this;
+  }
+
+  SliceAttr &setStep(const std::vector<int64_t> &step) {
+    step_ = step;
+    return *this;
+  }
+  template <Int64Range R> SliceAttr &setStep(R &&step) {
+    step_.assign(step.begin(), step.end());
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  const std::vector<int64_t> &getStart() const { return start_; }
+  const std::vector<int64_t> &getEnd() const { return end_; }
+  const std::vector<int64_t> &getStep() const { return step_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(start_).io(end_).io(step_);
+  }
+
+private:
+  std::vector<int64_t> start_;
+  std::vector<int64_t> end_;
+  std::vector<int64_t> step_;
+};
+
+class ConcatAttr : public AttributesCRTP<ConcatAttr> {
+public:
+  // Concat has a variable number of inputs, keyed by their position.
+  using InputNames = size_t;
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  ConcatAttr &setX(const std::vector<std::shared_ptr<TensorAttr>> &xs) {
+    inputs.clear();
+    for (size_t i = 0; i < xs.size(); ++i)
+      setInput(i, xs[i]);
+    return *this;
+  }
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(ConcatAttr, OutputNames, Y)
+
+  // Logical dimension concatenated along. Negative values count from the end.
+  ConcatAttr &setAxis(int64_t axis) {
+    axis_ = axis;
+    return *this;
+  }
+
+  // Getters:
+  // Returns the inputs in order.
+  std::vector<std::shared_ptr<TensorAttr>> getX() const {
+    std::vector<std::shared_ptr<TensorAttr>> xs;
+    xs.reserve(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+      xs.push_back(getInput(i));
+    return xs;
+  }
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  int64_t getAxis() const { return axis_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(axis_);
+  }
+
+private:
+  int64_t axis_ = 0;
+};
+
+class SliceUpdateAttr : public AttributesCRTP<SliceUpdateAttr> {
+public:
+  enum class InputNames : uint8_t { X, UPDATE, START };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SliceUpdateAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SliceUpdateAttr, InputNames, UPDATE)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SliceUpdateAttr, InputNames, START)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SliceUpdateAttr, OutputNames, Y)
+
+  // Logical dimension of X that UPDATE is written along, at the runtime
+  // offset held by START. Negative values count from the end.
+  SliceUpdateAttr &setAxis(int64_t axis) {
+    axis_ = axis;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, UPDATE)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, START)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  int64_t getAxis() const { return axis_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(axis_);
+  }
+
+private:
+  int64_t axis_ = 0;
+};
+
+class IndexSelectAttr : public AttributesCRTP<IndexSelectAttr> {
+public:
+  enum class InputNames : uint8_t { X, INDEX };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(IndexSelectAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(IndexSelectAttr, InputNames, INDEX)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(IndexSelectAttr, OutputNames, Y)
+
+  // Logical dimension of X gathered along. Negative values count from the
+  // end.
+  IndexSelectAttr &setAxis(int64_t axis) {
+    axis_ = axis;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, INDEX)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  int64_t getAxis() const { return axis_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(axis_);
+  }
+
+private:
+  int64_t axis_ = 0;
+};
+
+class IndexAddAttr : public AttributesCRTP<IndexAddAttr> {
+public:
+  enum class InputNames : uint8_t { X, INDEX, SOURCE };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(IndexAddAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(IndexAddAttr, InputNames, INDEX)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(IndexAddAttr, InputNames, SOURCE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(IndexAddAttr, OutputNames, Y)
+
+  // Logical dimension of Y accumulated into. Negative values count from the
+  // end.
+  IndexAddAttr &setAxis(int64_t axis) {
+    axis_ = axis;
+    return *this;
+  }
+
+  // Size of Y along the axis when X is not set and the accumulation starts
+  // from zeros (e.g. the number of rows of an embedding table).
+  IndexAddAttr &setSize(int64_t size) {
+    size_ = size;
+    return *this;
+  }
+
+  // Getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, INDEX)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, SOURCE)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  int64_t getAxis() const { return axis_; }
+  int64_t getSize() const { return size_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(axis_).io(size_);
+  }
+
+private:
+  int64_t axis_ = 0;
+  int64_t size_ = 0;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_ATTRIBUTES_SHAPE_ATTRIBUTES_H
@@ -0,0 +1,85 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains attributes (compile-time constant metadata) for
+// softmax nodes.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_ATTRIBUTES_SOFTMAX_ATTRIBUTES_H
+#define FUSILLI_ATTRIBUTES_SOFTMAX_ATTRIBUTES_H
+
+#include "fusilli/attributes/attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace fusilli {
+
+class SoftmaxAttr : public AttributesCRTP<SoftmaxAttr> {
+public:
+  // Names for Tensor Inputs and Outputs. MASK is an optional additive mask
+  // broadcastable to X.
+  enum class InputNames : uint8_t { X, MASK };
+  enum class OutputNames : uint8_t { Y };
+
+  std::unordered_map<InputNames, std::shared_ptr<TensorAttr>> inputs;
+  std::unordered_map<OutputNames, std::shared_ptr<TensorAttr>> outputs;
+
+  // Tensor setters:
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SoftmaxAttr, InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_SETTER(SoftmaxAttr, InputNames, MASK)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_SETTER(SoftmaxAttr, OutputNames, Y)
+
+  // Tensor getters:
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, X)
+  FUSILLI_GENERIC_INPUT_TENSOR_GETTER(InputNames, MASK)
+  FUSILLI_GENERIC_OUTPUT_TENSOR_GETTER(OutputNames, Y)
+
+  // Scalar attribute setters:
+  // Logical dimension normalized over. Negative values count from the end.
+  SoftmaxAttr &setAxis(int64_t axis) {
+    axis_ = axis;
+    return *this;
+  }
+
+  // Computes log(softmax(x)) instead of softmax(x).
+  SoftmaxAttr &setLogSoftmax(bool v) {
+    logSoftmax_ = v;
+    return *this;
+  }
+
+  // Scale applied to X before the mask is added.
+  SoftmaxAttr &setScale(std::optional<float> s) {
+    scale_ = s;
+    return *this;
+  }
+
+  // Scalar attribute getters:
+  int64_t getAxis() const { return axis_; }
+  bool getLogSoftmax() const { return logSoftmax_; }
+  std::optional<float> getScale() const { return scale_; }
+
+  // Reads or writes the attributes from or to `ar`, see `Graph::serialize()`.
+  void archive(Archive &ar) {
+    archiveTensors(ar);
+    ar.io(axis_).io(logSoftmax_).io(scale_);
+  }
+
+private:
+  int64_t axis_ = -1;
+  bool logSoftmax_ = false;
+  std::optional<float> scale_ = std::nullopt;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_ATTRIBUTES_SOFTMAX_ATTRIBUTES_H
@@ -129,10 +129,13 @@
 #include "fusilli/support/logging.h"
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <limits>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -371,6 +374,32 @@ computeBroadcastShape(const std::vector<std::vector<int64_t>> &shapes) {
   return ok(std::move(commonShape));
 }
 
+// Range and divisibility of the runtime extents of a dynamic dim, e.g.
+// `{.min = 16, .max = 4096, .divisor = 16}` for "a multiple of 16 up to
+// 4096". See `TensorAttr::setDynamicDimHint()`.
+struct DynamicDimHint {
+  static constexpr int64_t kUnbounded = std::numeric_limits<int64_t>::max();
+
+  int64_t min = 1;
+  int64_t max = kUnbounded;
+  int64_t divisor = 1;
+
+  bool isSatisfiedBy(int64_t extent) const {
+    return extent >= min && extent <= max && extent % divisor == 0;
+  }
+
+  bool operator==(const DynamicDimHint &) const = default;
+};
+
+// Blocked layout of a tensor, see `TensorAttr::setBlockedLayout()`. E.g. the
+// NCHW16c layout of an NCHW tensor blocks dim 1 (channels) by 16.
+struct BlockedLayout {
+  size_t dim = 0;
+  int64_t blockSize = 1;
+
+  bool operator==(const BlockedLayout &) const = default;
+};
+
 class TensorAttr {
 public:
   using scalar_t = std::variant<int64_t, int32_t, float, double>;
@@ -408,6 +437,24 @@ public:
               " with representative size 1, which is not supported");
     }
 
+    for (const auto &[index, hint] : dynamicDimHints_) {
+      FUSILLI_RETURN_ERROR_IF(
+          !isDynamicDim(index), ErrorCode::InvalidAttribute,
+          "Tensor '" + name_ + "' has a hint for dim " +
+              std::to_string(index) + ", which is not dynamic");
+      FUSILLI_RETURN_ERROR_IF(
+          hint.min < 1 || hint.max < hint.min || hint.divisor < 1,
+          ErrorCode::InvalidAttribute,
+          "Tensor '" + name_ + "' has an invalid hint for dynamic dim " +
+              std::to_string(index) +
+              ": it needs 1 <= min <= max and a positive divisor");
+      FUSILLI_RETURN_ERROR_IF(
+          !hint.isSatisfiedBy(dim_[index]), ErrorCode::InvalidAttribute,
+          "Tensor '" + name_ + "' has representative size " +
+              std::to_string(dim_[index]) + " at dynamic dim " +
+              std::to_string(index) + ", which doesn't satisfy its hint");
+    }
+
     FUSILLI_RETURN_ERROR_IF(
         hasBroadcastDims() && hasDynamicDims(), ErrorCode::InvalidAttribute,
         "Tensor '" + name_ +
@@ -420,6 +467,14 @@ public:
             "' has invalid physical representation. It must be a valid "
             "permutation of the logical dimensions");
 
+    FUSILLI_RETURN_ERROR_IF(
+        hasPaddedStrides() && (hasDynamicDims() || hasConstantData() ||
+                               isParameter() || isScalar_),
+        ErrorCode::InvalidAttribute,
+        "Tensor '" + name_ +
+            "' with padded strides cannot have dynamic dims, constant data, "
+            "be a parameter or be a scalar");
+
     FUSILLI_RETURN_ERROR_IF(dataType_ == DataType::NotSet,
                             ErrorCode::AttributeNotSet,
                             "Tensor '" + name_ + "' data type not set");
@@ -439,6 +494,74 @@ public:
         "Tensor '" + name_ +
             "' is marked as a scalar but does not have a scalar value set");
 
+    FUSILLI_RETURN_ERROR_IF(
+        isRuntimeScalar_ && !isScalar_, ErrorCode::InvalidAttribute,
+        "Tensor '" + name_ +
+            "' is marked as a runtime scalar but is not a scalar");
+
+    FUSILLI_RETURN_ERROR_IF(
+        isVirtual_ && isConstant_, ErrorCode::InvalidAttribute,
+        "Tensor '" + name_ +
+            "' cannot be both virtual (intermediate) and constant");
+
+    FUSILLI_RETURN_ERROR_IF(
+        hasConstantData() && (isScalar_ || hasDynamicDims() ||
+                              hasBroadcastDims()),
+        ErrorCode::InvalidAttribute,
+        "Tensor '" + name_ +
+            "' with constant data cannot be a scalar or have dynamic or "
+            "broadcast dims");
+
+    FUSILLI_RETURN_ERROR_IF(
+        isParameter() && (hasConstantData() || isScalar_ ||
+                          hasDynamicDims() || hasBroadcastDims()),
+        ErrorCode::InvalidAttribute,
+        "Parameter tensor '" + name_ +
+            "' cannot have constant data, be a scalar or have dynamic or "
+            "broadcast dims");
+
+    FUSILLI_RETURN_ERROR_IF(
+        alignment_ != 0 && !std::has_single_bit(alignment_), // C++20
+        ErrorCode::InvalidAttribute,
+        "Tensor '" + name_ + "' has alignment " + std::to_string(alignment_) +
+            ", which is not a power of two");
+
+    FUSILLI_RETURN_ERROR_IF(
+        alignment_ != 0 && (isVirtual_ || isEmbedded()),
+        ErrorCode::InvalidAttribute,
+        "Tensor '" + name_ +
+            "' declares a buffer alignment but is not bound to a buffer");
+
+    if (blockedLayout_.has_value()) {
+      const BlockedLayout &layout = *blockedLayout_;
+      FUSILLI_RETURN_ERROR_IF(
+          layout.dim >= dim_.size() || layout.blockSize < 2 ||
+              dim_[layout.dim] % layout.blockSize != 0,
+          ErrorCode::InvalidAttribute,
+          "Tensor '" + name_ + "' has an invalid blocked layout: the block "
+              "size must be at least 2 and divide the blocked dim");
+      FUSILLI_RETURN_ERROR_IF(
+          isVirtual_ || isEmbedded() || hasDynamicDims() ||
+              hasBroadcastDims() || hasPaddedStrides(),
+          ErrorCode::InvalidAttribute,
+          "Tensor '" + name_ +
+              "' with a blocked layout must be bound to a buffer, without "
+              "dynamic or broadcast dims or padded strides");
+    }
+
+    // Keys and scopes are emitted as quoted MLIR strings.
+    auto isQuotable = [](const std::string &str) {
+      return str.find_first_of("\"\\") == std::string::npos;
+    };
+    FUSILLI_RETURN_ERROR_IF(
+        isParameter() && (parameterScope_.empty() ||
+                          !isQuotable(parameterKey_) ||
+                          !isQuotable(parameterScope_)),
+        ErrorCode::InvalidAttribute,
+        "Parameter tensor '" + name_ +
+            "' needs a scope, and a key and scope without quotes or "
+            "backslashes");
+
     return ok();
   }
 
@@ -531,6 +654,17 @@ public:
     return *this;
   }
 
+  // Hints the range and divisibility of the runtime extents of dynamic dim
+  // `index` to the compiler, so that kernels over dynamic shapes can be tiled
+  // and vectorized close to static ones. The hints of graph inputs are bound
+  // to their function arguments, and propagate from there to the tensors
+  // computed from them. They are promises: executing the graph with extents
+  // that don't satisfy them is undefined behavior.
+  TensorAttr &setDynamicDimHint(size_t index, DynamicDimHint hint) {
+    dynamicDimHints_[index] = hint;
+    return *this;
+  }
+
   TensorAttr &setStride(const std::vector<int64_t> &stride) {
     stride_ = stride;
     return *this;
@@ -552,6 +686,103 @@ public:
     return *this;
   }
 
+  // Passes a scalar to the compiled function as a 1-element tensor argument
+  // bound through the variant pack, instead of inlining its value in the
+  // emitted assembly. The same kernel then serves every value (e.g. of an
+  // alpha or epsilon) without recompiling. The value set at construction is
+  // ignored by the compiled graph.
+  TensorAttr &setRuntimeScalar(bool isRuntimeScalar = true) {
+    isRuntimeScalar_ = isRuntimeScalar;
+    return *this;
+  }
+
+  // Marks a graph input whose contents don't change across executions, such
+  // as the weights or running statistics of an inference graph. The tensor
+  // is still bound through the variant pack, so its contents are unknown
+  // until execution; embed them with `setConstantData()` for graph rewrites
+  // to compute on them at compile time (see `Graph::foldConvBatchNorms()`).
+  TensorAttr &setConstant(bool isConstant = true) {
+    isConstant_ = isConstant;
+    return *this;
+  }
+
+  // Embeds the contents of a constant graph input in the compiled graph
+  // instead of binding it through the variant pack, and marks it constant.
+  // `data` holds the raw bytes of the tensor as its buffer would: packed in
+  // the physical layout of its dims and strides. Seeing the values lets the
+  // compiler transpose, pack or data-tile weights once at compile time rather
+  // than on every execution. The contents are part of the graph fingerprint,
+  // so each set of weights compiles to its own artifact.
+  TensorAttr &setConstantData(std::vector<uint8_t> data) {
+    constantData_ =
+        std::make_shared<const std::vector<uint8_t>>(std::move(data));
+    isConstant_ = true;
+    return *this;
+  }
+
+  // Reads a constant graph input from the external parameter `key` of
+  // `scope` (see `Handle::loadParameters()`) instead of binding it through
+  // the variant pack, and marks it constant. The parameter, stored like a
+  // buffer of the tensor, is loaded to the device with the compiled graph,
+  // which only references it: artifacts stay small, and graphs compiled into
+  // one module (see `compileModule()`) share a single copy.
+  TensorAttr &setParameter(const std::string &key,
+                           const std::string &scope = "model") {
+    parameterKey_ = key;
+    parameterScope_ = scope;
+    isConstant_ = true;
+    return *this;
+  }
+
+  // Declares that this graph output is written into the buffer of the graph
+  // input `input` rather than into a buffer of its own, halving the
+  // activation memory of e.g. a pointwise or normalization graph. `input`
+  // must have the dims, stride and data type of this tensor, and is
+  // overwritten by the execution. The output is not bound through the
+  // variant pack (or bound to the buffer of `input`); its result is read from
+  // the buffer of `input`.
+  TensorAttr &setInPlace(const std::shared_ptr<TensorAttr> &input) {
+    inPlaceInput_ = input;
+    return *this;
+  }
+
+  // Declares that the buffers bound to this graph input or output start at
+  // an address that is a multiple of `alignment` bytes, a power of two. The
+  // compiler may then use wide aligned memory accesses on the tensor (see
+  // `Graph::getBufferAlignment()`), and `Graph::execute()` rejects buffers
+  // that break the promise. Buffers allocated through a handle are aligned
+  // to `Handle::getBufferAlignment()`. 0, the default, declares nothing.
+  TensorAttr &setAlignment(size_t alignment) {
+    alignment_ = alignment;
+    return *this;
+  }
+
+  // Stores dim `layout.dim` in blocks of `layout.blockSize` elements, e.g.
+  // NCHW16c with `{.dim = 1, .blockSize = 16}` on a contiguous NCHW tensor.
+  // The buffer holds the physical dims of the strides (see
+  // `getPhysicalDim()`), with the blocked dim divided by the block size,
+  // followed by an innermost dim of the block size, so that vectors of
+  // channels stay contiguous for SIMD loads and stores along a chain of CPU
+  // convolutions. The strides only order the outer dims. Only graph inputs and outputs bound to
+  // buffers can be blocked; the ASM emitters convert them from and to their
+  // logical dims (see `getLayoutConversionOpsAsm()`).
+  TensorAttr &setBlockedLayout(BlockedLayout layout) {
+    blockedLayout_ = layout;
+    return *this;
+  }
+
+  TensorAttr &clearBlockedLayout() {
+    blockedLayout_.reset();
+    return *this;
+  }
+
+  // Set by `Graph::optimizeLayouts()` on virtual tensors that are passed
+  // between nodes in logical dim order, see `isLogicalLayout()`.
+  TensorAttr &setIsLogicalLayout(bool isLogicalLayout) {
+    isLogicalLayout_ = isLogicalLayout;
+    return *this;
+  }
+
   // Getters:
   const std::string &getName() const { return name_; }
 
@@ -569,6 +800,17 @@ public:
 
   const std::vector<size_t> &getDynamicDims() const { return dynamicDims_; }
 
+  // Returns the hint of dynamic dim `index`, the default (unconstrained) one
+  // if it has none.
+  DynamicDimHint getDynamicDimHint(size_t index) const {
+    auto it = dynamicDimHints_.find(index);
+    return it == dynamicDimHints_.end() ? DynamicDimHint{} : it->second;
+  }
+
+  const std::map<size_t, DynamicDimHint> &getDynamicDimHints() const {
+    return dynamicDimHints_;
+  }
+
   int64_t getVolume() const {
     int64_t volume = 1;
     for (const auto &d : dim_)
@@ -580,16 +822,66 @@ public:
 
   bool isScalar() const { return isScalar_; }
 
+  bool isRuntimeScalar() const { return isRuntimeScalar_; }
+
+  // Scalars are inlined as constants in the emitted assembly (and are not
+  // part of the variant pack), unless they are runtime scalars.
+  bool isInlinedScalar() const { return isScalar_ && !isRuntimeScalar_; }
+
+  bool isConstant() const { return isConstant_; }
+
+  // Contents set by `setConstantData()`, or null.
+  const std::shared_ptr<const std::vector<uint8_t>> &getConstantData() const {
+    return constantData_;
+  }
+
+  bool hasConstantData() const { return constantData_ != nullptr; }
+
+  // Key and scope set by `setParameter()`, empty otherwise.
+  const std::string &getParameterKey() const { return parameterKey_; }
+  const std::string &getParameterScope() const { return parameterScope_; }
+
+  bool isParameter() const { return !parameterKey_.empty(); }
+
+  // Graph inputs embedded in (or referenced by) the emitted assembly rather
+  // than bound through the variant pack: inlined scalars, tensors with
+  // constant data and parameters.
+  bool isEmbedded() const {
+    return isInlinedScalar() || hasConstantData() || isParameter();
+  }
+
+  // The graph input this output is written into, see `setInPlace()`.
+  const std::shared_ptr<TensorAttr> &getInPlace() const {
+    return inPlaceInput_;
+  }
+
+  bool isInPlace() const { return inPlaceInput_ != nullptr; }
+
+  bool isLogicalLayout() const { return isLogicalLayout_; }
+
+  // Layout set by `setBlockedLayout()`, if any.
+  const std::optional<BlockedLayout> &getBlockedLayout() const {
+    return blockedLayout_;
+  }
+
+  bool isBlocked() const { return blockedLayout_.has_value(); }
+
+  // Alignment set by `setAlignment()`, 0 if none was declared.
+  size_t getAlignment() const { return alignment_; }
+
+  // Whether the dimension order of the layout is contiguous (or channels
+  // last). Padded strides (see `hasPaddedStrides()`) only affect how the
+  // tensor is read from or written to its buffer, so they are ignored.
   bool isContiguous() const {
     std::vector<int64_t> expectedStride =
         generateStrideFromDim(dim_, getContiguousStrideOrder(dim_.size()));
-    return expectedStride == stride_;
+    return expectedStride == getCompactStride();
   }
 
   bool isChannelsLast() const {
     std::vector<int64_t> expectedStride =
         generateStrideFromDim(dim_, getChannelsLastStrideOrder(dim_.size()));
-    return expectedStride == stride_;
+    return expectedStride == getCompactStride();
   }
 
   // Returns true if any dimension is a broadcast dimension (size > 1 with
@@ -619,47 +911,78 @@ public:
 
   // Check if the stride pattern is valid and can represent a physical tensor.
   // A valid stride pattern must satisfy:
-  // 1. Each stride is a product of dimensions in faster-changing positions
+  // 1. Each stride is a product of dimensions in faster-changing positions,
+  //    or, for padded strides (see `hasPaddedStrides()`), a multiple of the
+  //    next faster stride spanning at least its dimension
   // 2. The strides are consistent with some permutation of dimensions
-  // 3. Broadcast dimensions (stride == 0, size > 1) are allowed and skipped
+  // 3. Broadcast dimensions (stride == 0, size > 1) are allowed and skipped,
+  //    but not combined with padded strides
   bool hasValidPhysicalRepresentation() const {
-    size_t numDims = dim_.size();
-    if (numDims != stride_.size())
-      return false;
-    if (numDims == 0)
-      return true;
+    return checkStrides(/*allowPadding=*/!hasBroadcastDims());
+  }
 
-    // Create pairs of (stride, dimSize) and sort by stride
-    std::vector<std::pair<int64_t, int64_t>> strideAndDim;
-    for (size_t i = 0; i < numDims; ++i) {
-      if (stride_[i] < 0)
-        return false; // Negative strides not supported
-      strideAndDim.push_back({stride_[i], dim_[i]});
-    }
-    std::stable_sort(
-        strideAndDim.begin(), strideAndDim.end(),
-        [](const auto &a, const auto &b) { return a.first < b.first; });
+  // Returns true if the tensor is a view of a larger buffer whose rows (or
+  // any other dimension) are padded, e.g. a slice `x[:, :6]` of a `[4, 8]`
+  // tensor (dim={4, 6}, stride={8, 1}), or rows aligned to a pitch. The
+  // fastest-changing dimension must have unit stride, and broadcast
+  // dimensions are not supported. Graph inputs and outputs with padded
+  // strides are read from and written to buffers of shape `getStorageDim()`
+  // in place, without compaction copies.
+  bool hasPaddedStrides() const {
+    return !hasBroadcastDims() && checkStrides(/*allowPadding=*/true) &&
+           !checkStrides(/*allowPadding=*/false);
+  }
 
-    // The smallest stride should divide evenly into all larger strides
-    // and the expected product of dimensions should match
+  // Returns the strides of the dense layout with the same dimension order,
+  // i.e. the strides without padding (see `hasPaddedStrides()`). Nodes infer
+  // the strides of their outputs from these, so padding is not propagated.
+  //
+  // Example: dim={4, 6}, stride={8, 1}
+  //   Returns: {6, 1}
+  std::vector<int64_t> getCompactStride() const {
+    if (!hasPaddedStrides())
+      return stride_;
+    std::vector<int64_t> compactStride = stride_;
+    std::vector<int64_t> permuteOrder = getLogicalToPhysicalPermuteOrder();
     int64_t expectedStride = 1;
-    for (size_t i = 0; i < numDims; ++i) {
-      int64_t actualStride = strideAndDim[i].first;
-      int64_t dimSize = strideAndDim[i].second;
-
-      // Unit dimensions and broadcast dimensions (stride == 0) don't
-      // participate in the physical layout check.
-      if (dimSize == 1 || actualStride == 0)
+    for (size_t i = permuteOrder.size(); i-- > 0;) {
+      size_t logicalIdx = static_cast<size_t>(permuteOrder[i]);
+      if (dim_[logicalIdx] == 1 || stride_[logicalIdx] == 0)
         continue;
-
-      // Check if actual stride matches expected stride
-      if (actualStride != expectedStride)
-        return false;
-
-      expectedStride = actualStride * dimSize;
+      compactStride[logicalIdx] = expectedStride;
+      expectedStride *= dim_[logicalIdx];
     }
+    return compactStride;
+  }
 
-    return true;
+  // Returns the shape (in physical order) of the buffer holding the tensor:
+  // the physical dims (see `getPhysicalDim()`) with each dimension extended
+  // to the padding of its stride (see `hasPaddedStrides()`).
+  //
+  // Examples:
+  //   1. Dense layout: dim={2, 3, 4}, stride={12, 1, 3}
+  //      Returns: {2, 4, 3} (same as `getPhysicalDim()`)
+  //
+  //   2. Padded rows: dim={4, 6}, stride={8, 1}
+  //      Returns: {4, 8}
+  //
+  //   3. Padded channels-last: dim={2, 3, 4}, stride={64, 1, 16}
+  //      Returns: {2, 4, 16}
+  std::vector<int64_t> getStorageDim() const {
+    std::vector<int64_t> storageDims = getPhysicalDim();
+    if (!hasPaddedStrides())
+      return storageDims;
+    std::vector<int64_t> permuteOrder = getLogicalToPhysicalPermuteOrder();
+    int64_t slowerStride = 0;
+    for (size_t i = 0; i < permuteOrder.size(); ++i) {
+      size_t logicalIdx = static_cast<size_t>(permuteOrder[i]);
+      if (dim_[logicalIdx] == 1 || stride_[logicalIdx] == 0)
+        continue;
+      if (slowerStride != 0)
+        storageDims[i] = slowerStride / stride_[logicalIdx];
+      slowerStride = stride_[logicalIdx];
+    }
+    return storageDims;
   }
 
   // Convert logical dims + stride into physical dims. The stride
@@ -690,6 +1013,10 @@ public:
   //
   //   6. Broadcast: dim={8, 2, 64, 128}, stride={0, 0, 128, 1}
   //      Returns: {1, 1, 64, 128} (broadcast dims collapse to 1)
+  //
+  //   7. Blocked NCHW16c (see `setBlockedLayout()`): dim={2, 32, 4, 4},
+  //      stride={512, 16, 4, 1}, blocked layout {.dim = 1, .blockSize = 16}
+  //      Returns: {2, 2, 4, 4, 16} (one more dim than the logical dims)
   std::vector<int64_t> getPhysicalDim() const {
     assert(hasValidPhysicalRepresentation() &&
            "Tensor has invalid physical representation");
@@ -701,6 +1028,13 @@ public:
       bool isBroadcast = dim_[srcIdx] > 1 && stride_[srcIdx] == 0;
       physicalDims[i] = isBroadcast ? 1 : dim_[srcIdx];
     }
+    if (blockedLayout_.has_value()) {
+      auto blocked = static_cast<int64_t>(blockedLayout_->dim);
+      auto it = std::find(permuteOrder.begin(), permuteOrder.end(), blocked);
+      physicalDims[static_cast<size_t>(it - permuteOrder.begin())] /=
+          blockedLayout_->blockSize;
+      physicalDims.push_back(blockedLayout_->blockSize);
+    }
     return physicalDims;
   }
 
@@ -783,17 +1117,73 @@ public:
   std::optional<scalar_t> getScalarValue() const { return scalarValue_; }
 
 private:
+  // Checks the strides as described in `hasValidPhysicalRepresentation()`,
+  // allowing padding (see `hasPaddedStrides()`) if `allowPadding` is set.
+  bool checkStrides(bool allowPadding) const {
+    size_t numDims = dim_.size();
+    if (numDims != stride_.size())
+      return false;
+    if (numDims == 0)
+      return true;
+
+    // Create pairs of (stride, dimSize) and sort by stride
+    std::vector<std::pair<int64_t, int64_t>> strideAndDim;
+    for (size_t i = 0; i < numDims; ++i) {
+      if (stride_[i] < 0)
+        return false; // Negative strides not supported
+      strideAndDim.push_back({stride_[i], dim_[i]});
+    }
+    std::stable_sort(
+        strideAndDim.begin(), strideAndDim.end(),
+        [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    // The smallest stride should divide evenly into all larger strides
+    // and the expected product of dimensions should match
+    int64_t expectedStride = 1;
+    int64_t fasterStride = 0;
+    for (size_t i = 0; i < numDims; ++i) {
+      int64_t actualStride = strideAndDim[i].first;
+      int64_t dimSize = strideAndDim[i].second;
+
+      // Unit dimensions and broadcast dimensions (stride == 0) don't
+      // participate in the physical layout check.
+      if (dimSize == 1 || actualStride == 0)
+        continue;
+
+      // Check if actual stride matches expected stride. Padded strides may
+      // exceed it by a multiple of the next faster stride, except for the
+      // fastest-changing dimension.
+      bool isPadded = allowPadding && fasterStride != 0 &&
+                      expectedStride != 0 && actualStride > expectedStride &&
+                      actualStride % fasterStride == 0;
+      if (actualStride != expectedStride && !isPadded)
+        return false;
+
+      fasterStride = actualStride;
+      expectedStride = actualStride * dimSize;
+    }
+
+    return true;
+  }
+
   std::string name_;
   DataType dataType_ = DataType::NotSet;
   std::vector<int64_t> dim_ = {};
   std::vector<int64_t> stride_ = {};
   std::vector<size_t> dynamicDims_ = {};
+  // Set by `setDynamicDimHint()`, by dim index.
+  std::map<size_t, DynamicDimHint> dynamicDimHints_;
 
   // Intermediate tensors that are not inputs/outputs are virtual
   // and not stored/read as they appear internal to the kernel.
   // They also don't need their shapes and sizes specified.
   bool isVirtual_ = false;
 
+  // Virtual tensors only produced and consumed by nodes computing in logical
+  // dim order never materialize their physical layout, so the ASM emitters
+  // skip the permutes to and from it (see `getLayoutConversionOpsAsm()`).
+  bool isLogicalLayout_ = false;
+
   // To represent scalar constants either obtained through
   // constant folding, or passed in as scalars during execution.
   // These constants are inlined in the ASM emitters,
@@ -801,6 +1191,29 @@ private:
   bool isScalar_ = false;
   std::optional<scalar_t> scalarValue_;
 
+  // Set by `setRuntimeScalar()`.
+  bool isRuntimeScalar_ = false;
+
+  // Set by `setConstant()`.
+  bool isConstant_ = false;
+
+  // Set by `setConstantData()`. Shared, as tensors are copied into runtime
+  // graphs and specializations.
+  std::shared_ptr<const std::vector<uint8_t>> constantData_;
+
+  // Set by `setParameter()`.
+  std::string parameterKey_;
+  std::string parameterScope_;
+
+  // Set by `setInPlace()`.
+  std::shared_ptr<TensorAttr> inPlaceInput_;
+
+  // Set by `setAlignment()`, in bytes.
+  size_t alignment_ = 0;
+
+  // Set by `setBlockedLayout()`.
+  std::optional<BlockedLayout> blockedLayout_;
+
   void canonicalizeDynamicDims() {
     std::sort(dynamicDims_.begin(), dynamicDims_.end());
     dynamicDims_.erase(std::unique(dynamicDims_.begin(), dynamicDims_.end()),
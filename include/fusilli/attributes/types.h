@@ -36,7 +36,10 @@ namespace fusilli {
   _(Int32, Int, "si32")                                                        \
   _(Int64, Long, "si64")                                                       \
   _(Boolean, Bool, "i1")                                                       \
-  _(FP8E5M2, Float8_e5m2, "f8E5M2")
+  _(FP8E5M2, Float8_e5m2, "f8E5M2")                                            \
+  _(FP8E4M3FN, Float8_e4m3fn, "f8E4M3FN")                                      \
+  _(FP8E5M2FNUZ, Float8_e5m2fnuz, "f8E5M2FNUZ")                                \
+  _(FP8E4M3FNUZ, Float8_e4m3fnuz, "f8E4M3FNUZ")
 
 enum class DataType : uint8_t {
   NotSet,
@@ -63,6 +66,31 @@ inline bool isIntegralOrBoolType(DataType type) {
   return isIntegerType(type) || type == DataType::Boolean;
 }
 
+// The OCP FP8 formats (E4M3FN, E5M2) and their FNUZ variants, which are the
+// native FP8 formats of gfx942 (MI300).
+inline bool isFloat8Type(DataType type) {
+  switch (type) {
+  case DataType::FP8E5M2:
+  case DataType::FP8E4M3FN:
+  case DataType::FP8E5M2FNUZ:
+  case DataType::FP8E4M3FNUZ:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Element type that a matmul or convolution over quantized (FP8 or int8)
+// operands accumulates in before its scales are applied, or `NotSet` when
+// `type` is not a quantized type.
+inline DataType getQuantizedAccumulatorType(DataType type) {
+  if (isFloat8Type(type))
+    return DataType::Float;
+  if (type == DataType::Int8)
+    return DataType::Int32;
+  return DataType::NotSet;
+}
+
 // Map from Fusilli types to MLIR types.
 static const std::unordered_map<DataType, std::string> kDataTypeToMlirTypeAsm =
     {
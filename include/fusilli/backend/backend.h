@@ -15,7 +15,9 @@
 #define FUSILLI_BACKEND_BACKEND_H
 
 #include "fusilli/attributes/types.h"
+#include "fusilli/external/dlpack.h"
 #include "fusilli/support/external_tools.h"
+#include "fusilli/support/hip_runtime.h"
 #include "fusilli/support/logging.h"
 #include "fusilli/support/process.h"
 
@@ -25,14 +27,20 @@
 #include <iree/vm/api.h>
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <format>
 #include <iomanip>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <ostream>
 #include <sstream>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -69,6 +77,10 @@ static const std::unordered_map<Backend, const char *> kHalDriver = {
     {Backend::AMDGPU, "hip"},
 };
 
+// HAL driver of CPU handles executing inline on the calling thread, see
+// `CpuOptions::inlineExecution`.
+static constexpr const char *kCpuInlineHalDriver = "local-sync";
+
 // Maps GPU marketing name to IREE SKU target name.
 // Returns empty string if not recognized.
 // Supported marketing names (from IREE's KnownTargets.cpp):
@@ -131,11 +143,56 @@ getGpuSkuFromMarketingName(const std::string &marketingName) {
   return "";
 }
 
+// Marketing name (e.g. `AMD Instinct MI300X`) and architecture (e.g.
+// `gfx942`) of a GPU, empty when unknown.
+struct GpuInfo {
+  std::string marketingName;
+  std::string arch;
+};
+
+// Queries the marketing name and architecture of HIP device `deviceId`
+// through the HIP runtime, without spawning a process. Returns empty fields
+// when the runtime (or the queries) are not available.
+inline GpuInfo getGpuInfoFromHipRuntime(int deviceId) {
+  GpuInfo info;
+  ErrorOr<const detail::HipApi *> hipOrError = detail::getHipApi();
+  if (isError(hipOrError))
+    return info;
+  const detail::HipApi *hip = *hipOrError;
+
+  std::array<char, 256> name{};
+  if (hip->hipDeviceGetName &&
+      hip->hipDeviceGetName(name.data(), static_cast<int>(name.size()),
+                            deviceId) == detail::HipApi::hipSuccess)
+    info.marketingName = name.data();
+
+  // `hipDeviceProp_t` is large and its layout changes across HIP versions,
+  // so it is read into an oversized buffer, and `gcnArchName` (e.g.
+  // `gfx942:sramecc+:xnack-`), the only field holding a `gfx` string, is
+  // located by its prefix after `name`.
+  if (hip->hipGetDevicePropertiesR0600) {
+    std::vector<char> props(16384, '\0');
+    if (hip->hipGetDevicePropertiesR0600(props.data(), deviceId) ==
+        detail::HipApi::hipSuccess) {
+      std::string_view fields(props.data() + name.size(),
+                              props.size() - name.size());
+      size_t archPos = fields.find("gfx");
+      if (archPos != std::string_view::npos) {
+        std::string_view arch = fields.substr(archPos);
+        arch = arch.substr(0, arch.find_first_of(std::string_view(":\0", 2)));
+        info.arch = std::string(arch);
+      }
+    }
+  }
+  return info;
+}
+
 // Queries amd-smi for GPU marketing name.
-// Runs `amd-smi static --gpu 0 --json` and extracts market_name field.
-// Returns empty string on failure.
-inline std::string getGpuMarketingNameFromAmdSmi() {
-  std::string cmd = getAmdSmiPath() + " static --gpu 0 --json 2>/dev/null";
+// Runs `amd-smi static --gpu <gpuIndex> --json` and extracts market_name
+// field. Returns empty string on failure.
+inline std::string getGpuMarketingNameFromAmdSmi(int gpuIndex = 0) {
+  std::string cmd = getAmdSmiPath() + " static --gpu " +
+                    std::to_string(gpuIndex) + " --json 2>/dev/null";
 
   auto outputOrNone = execCommand(cmd);
   if (!outputOrNone.has_value() || outputOrNone->empty())
@@ -163,8 +220,9 @@ inline std::string getGpuMarketingNameFromAmdSmi() {
   return output.substr(valueStart, valueEnd - valueStart);
 }
 
-// Parses AMDGPU arch (e.g. `gfx942`) from `rocm_agent_enumerator` CLI output.
-inline std::string getArchFromRocmAgentEnumerator() {
+// Parses AMDGPU arch (e.g. `gfx942`) of GPU `gpuIndex` from
+// `rocm_agent_enumerator` CLI output.
+inline std::string getArchFromRocmAgentEnumerator(int gpuIndex = 0) {
   auto cmd = getRocmAgentEnumeratorPath();
 
   auto outputOrNone = execCommand(cmd);
@@ -173,26 +231,42 @@ inline std::string getArchFromRocmAgentEnumerator() {
 
   std::istringstream stream(std::move(*outputOrNone));
   std::string target;
+  int index = 0;
   while (std::getline(stream, target)) {
     target.erase(target.find_last_not_of(" \n\r\t") + 1);
     if (target == "gfx000")
       continue;
-    break;
+    if (index++ == gpuIndex)
+      return target;
   }
 
-  return target;
+  return "";
 }
 
-// Returns the best available IREE ROCm target for the current AMD GPU.
-// Attempts to get SKU name (e.g., `mi300x`) via amd-smi for optimal tuning,
-// falls back to architecture (e.g., `gfx942`) via rocm_agent_enumerator.
-// See:
-// https://iree.dev/guides/deployment-configurations/gpu-rocm/#choosing-hip-targets
-inline std::string getIreeRocmTargetForAmdgpu() {
-  // Try to get SKU name first via amd-smi for better compiler tuning.
-  FUSILLI_LOG_LABEL_ENDL("INFO: Detecting IREE ROCm target for AMD GPU");
+// Detects the best available IREE ROCm target for HIP device `deviceId`, see
+// `getIreeRocmTargetForAmdgpu()`.
+inline std::string detectIreeRocmTargetForAmdgpu(int deviceId) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Detecting IREE ROCm target for AMD GPU "
+                         << deviceId);
 
-  std::string marketingName = getGpuMarketingNameFromAmdSmi();
+  // Query the HIP runtime first, which is much faster than the CLI tools.
+  GpuInfo info = getGpuInfoFromHipRuntime(deviceId);
+  if (!info.marketingName.empty()) {
+    std::string sku = getGpuSkuFromMarketingName(info.marketingName);
+    if (!sku.empty()) {
+      FUSILLI_LOG_LABEL_ENDL("INFO: Using SKU target: \""
+                             << sku << "\" (from the HIP runtime)");
+      return sku;
+    }
+  }
+  if (!info.arch.empty()) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Using architecture target: \""
+                           << info.arch << "\" (from the HIP runtime)");
+    return info.arch;
+  }
+
+  // Try to get SKU name first via amd-smi for better compiler tuning.
+  std::string marketingName = getGpuMarketingNameFromAmdSmi(deviceId);
   if (!marketingName.empty()) {
     FUSILLI_LOG_LABEL_ENDL("INFO: amd-smi returned marketing name: \""
                            << marketingName << "\"");
@@ -208,12 +282,58 @@ inline std::string getIreeRocmTargetForAmdgpu() {
   FUSILLI_LOG_LABEL_ENDL(
       "INFO: Marketing name / SKU not recognized from amd-smi; falling back to "
       "architecture from rocm_agent_enumerator");
-  std::string arch = getArchFromRocmAgentEnumerator();
+  std::string arch = getArchFromRocmAgentEnumerator(deviceId);
   FUSILLI_LOG_LABEL_ENDL("INFO: Using architecture target: \""
                          << arch << "\" (from rocm_agent_enumerator)");
   return arch;
 }
 
+// Returns the best available IREE ROCm target for HIP device `deviceId`,
+// detected once per device. Prefers the SKU name (e.g., `mi300x`) for optimal
+// tuning over the architecture (e.g., `gfx942`), both queried through the
+// HIP runtime, with amd-smi and rocm_agent_enumerator as fallbacks when it is
+// not available (their GPU indices may not match HIP device ids under
+// `HIP_VISIBLE_DEVICES`).
+// See:
+// https://iree.dev/guides/deployment-configurations/gpu-rocm/#choosing-hip-targets
+inline std::string getIreeRocmTargetForAmdgpu(int deviceId = 0) {
+  static std::mutex targetsMutex;
+  static std::map<int, std::string> targets;
+  std::lock_guard<std::mutex> lock(targetsMutex);
+  auto it = targets.find(deviceId);
+  if (it == targets.end())
+    it = targets.emplace(deviceId, detectIreeRocmTargetForAmdgpu(deviceId))
+             .first;
+  return it->second;
+}
+
+// Returns the IREE ROCm targets of artifacts that run on HIP device
+// `deviceId`, most specific first: the detected target (see
+// `getIreeRocmTargetForAmdgpu()`), followed by the architecture when that is
+// a SKU, e.g. {`mi300x`, `gfx942`}. Detected once per device.
+inline std::vector<std::string>
+getIreeRocmTargetCandidatesForAmdgpu(int deviceId = 0) {
+  static std::mutex candidatesMutex;
+  static std::map<int, std::vector<std::string>> candidates;
+  std::string target = getIreeRocmTargetForAmdgpu(deviceId);
+  std::lock_guard<std::mutex> lock(candidatesMutex);
+  auto it = candidates.find(deviceId);
+  if (it != candidates.end())
+    return it->second;
+
+  std::vector<std::string> targets;
+  if (!target.empty())
+    targets.push_back(target);
+  if (!target.starts_with("gfx")) {
+    std::string arch = getGpuInfoFromHipRuntime(deviceId).arch;
+    if (arch.empty())
+      arch = getArchFromRocmAgentEnumerator(deviceId);
+    if (!arch.empty())
+      targets.push_back(arch);
+  }
+  return candidates.emplace(deviceId, std::move(targets)).first->second;
+}
+
 // Parses space-separated compiler flags from a string.
 // Supports double-quote quoting for flags with spaces.
 // Single quotes (') are treated as literal characters, not delimiters.
@@ -251,9 +371,10 @@ inline std::span<const std::string> getBackendFlags(Backend backend) {
         "--iree-torch-externalize-transients",
     };
 
-    // Specify a ROCm target for AMD GPU. First attempts to get the SKU name
-    // (e.g., `mi300x`) via `amd-smi` for optimal compiler tuning, then falls
-    // back to architecture (e.g., `gfx942`) via `rocm_agent_enumerator`.
+    // Specify a ROCm target for AMD GPU (device 0, see
+    // `Graph::resolveCompileOptions()` for handles on other devices). First
+    // attempts to get the SKU name (e.g., `mi300x`) for optimal compiler
+    // tuning, then falls back to architecture (e.g., `gfx942`).
     // See:
     // https://iree.dev/guides/deployment-configurations/gpu-rocm/#choosing-hip-targets
     auto rocmTarget = getIreeRocmTargetForAmdgpu();
@@ -307,6 +428,11 @@ setDefaultIreeHalHipDeviceParams(iree_hal_hip_device_params_t *params) {
   params->async_caching = false;
   // Fusilli use cases shouldn't require transfering files.
   params->file_transfer_buffer_size = kMinimalFileTransferBufferSize;
+#if defined(FUSILLI_ENABLE_TRACING)
+  // Forward device-side queue operations to the trace timeline (coarse
+  // verbosity: one zone per queue operation rather than per dispatch).
+  params->stream_tracing = 1;
+#endif
 }
 
 // Template specializations to map from primitive types
@@ -336,6 +462,11 @@ template <> struct IreeHalElementType<int> {
   static constexpr iree_hal_element_type_t kType = IREE_HAL_ELEMENT_TYPE_INT_32;
 };
 //
+// int64 -> IREE_HAL_ELEMENT_TYPE_INT_64:
+template <> struct IreeHalElementType<int64_t> {
+  static constexpr iree_hal_element_type_t kType = IREE_HAL_ELEMENT_TYPE_INT_64;
+};
+//
 // int16 -> IREE_HAL_ELEMENT_TYPE_INT_16:
 template <> struct IreeHalElementType<int16_t> {
   static constexpr iree_hal_element_type_t kType = IREE_HAL_ELEMENT_TYPE_INT_16;
@@ -351,6 +482,30 @@ template <> struct IreeHalElementType<int8_t> {
   static constexpr iree_hal_element_type_t kType = IREE_HAL_ELEMENT_TYPE_INT_8;
 };
 //
+// fp8e5m2 -> IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2:
+template <> struct IreeHalElementType<fp8e5m2> {
+  static constexpr iree_hal_element_type_t kType =
+      IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2;
+};
+//
+// fp8e4m3fn -> IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FN:
+template <> struct IreeHalElementType<fp8e4m3fn> {
+  static constexpr iree_hal_element_type_t kType =
+      IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FN;
+};
+//
+// fp8e5m2fnuz -> IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2_FNUZ:
+template <> struct IreeHalElementType<fp8e5m2fnuz> {
+  static constexpr iree_hal_element_type_t kType =
+      IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2_FNUZ;
+};
+//
+// fp8e4m3fnuz -> IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FNUZ:
+template <> struct IreeHalElementType<fp8e4m3fnuz> {
+  static constexpr iree_hal_element_type_t kType =
+      IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FNUZ;
+};
+//
 // Assert for unsupported types:
 template <typename T> struct IreeHalElementType {
   static_assert(sizeof(T) == 0, "Unsupported type for IREE_HAL_ELEMENT_TYPE");
@@ -361,6 +516,133 @@ template <typename T> iree_hal_element_type_t getIreeHalElementTypeForT() {
   return IreeHalElementType<T>::kType;
 }
 
+// Maps a Fusilli `DataType` to the IREE HAL element type of its buffers.
+// Booleans are stored one per byte, as `i8`.
+inline ErrorOr<iree_hal_element_type_t> getIreeHalElementType(DataType type) {
+  switch (type) {
+  case DataType::Half:
+    return ok(IREE_HAL_ELEMENT_TYPE_FLOAT_16);
+  case DataType::BFloat16:
+    return ok(IREE_HAL_ELEMENT_TYPE_BFLOAT_16);
+  case DataType::Float:
+    return ok(IREE_HAL_ELEMENT_TYPE_FLOAT_32);
+  case DataType::Double:
+    return ok(IREE_HAL_ELEMENT_TYPE_FLOAT_64);
+  case DataType::Uint8:
+    return ok(IREE_HAL_ELEMENT_TYPE_UINT_8);
+  case DataType::Int4:
+    return ok(IREE_HAL_ELEMENT_TYPE_SINT_4);
+  case DataType::Int8:
+  case DataType::Boolean:
+    return ok(IREE_HAL_ELEMENT_TYPE_INT_8);
+  case DataType::Int16:
+    return ok(IREE_HAL_ELEMENT_TYPE_INT_16);
+  case DataType::Int32:
+    return ok(IREE_HAL_ELEMENT_TYPE_INT_32);
+  case DataType::Int64:
+    return ok(IREE_HAL_ELEMENT_TYPE_INT_64);
+  case DataType::FP8E5M2:
+    return ok(IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2);
+  case DataType::FP8E4M3FN:
+    return ok(IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FN);
+  case DataType::FP8E5M2FNUZ:
+    return ok(IREE_HAL_ELEMENT_TYPE_FLOAT_8_E5M2_FNUZ);
+  case DataType::FP8E4M3FNUZ:
+    return ok(IREE_HAL_ELEMENT_TYPE_FLOAT_8_E4M3_FNUZ);
+  default:
+    return error(ErrorCode::InvalidArgument,
+                 "No IREE HAL element type for DataType");
+  }
+}
+
+// DLPack data types of the IREE HAL element types Fusilli buffers hold.
+// Booleans are exchanged as `i8` like in `getIreeHalElementType()`.
+struct DLPackElementType {
+  DLDataType dlType;
+  iree_hal_element_type_t halType;
+};
+inline constexpr DLPackElementType kDLPackElementTypes[] = {
+    {{kDLFloat, 16, 1}, IREE_HAL_ELEMENT_TYPE_FLOAT_16},
+    {{kDLBfloat, 16, 1}, IREE_HAL_ELEMENT_TYPE_BFLOAT_16},
+    {{kDLFloat, 32, 1}, IREE_HAL_ELEMENT_TYPE_FLOAT_32},
+    {{kDLFloat, 64, 1}, IREE_HAL_ELEMENT_TYPE_FLOAT_64},
+    {{kDLUInt, 8, 1}, IREE_HAL_ELEMENT_TYPE_UINT_8},
+    {{kDLInt, 4, 1}, IREE_HAL_ELEMENT_TYPE_SINT_4},
+    {{kDLInt, 8, 1}, IREE_HAL_ELEMENT_TYPE_INT_8},
+    {{kDLInt, 16, 1}, IREE_HAL_ELEMENT_TYPE_INT_16},
+    {{kDLInt, 32, 1}, IREE_HAL_ELEMENT_TYPE_INT_32},
+    {{kDLInt, 64, 1}, IREE_HAL_ELEMENT_TYPE_INT_64},
+    {{kDLBool, 8, 1}, IREE_HAL_ELEMENT_TYPE_INT_8},
+};
+
+inline ErrorOr<iree_hal_element_type_t>
+getIreeHalElementType(const DLDataType &dlType) {
+  for (const DLPackElementType &entry : kDLPackElementTypes)
+    if (entry.dlType.code == dlType.code && entry.dlType.bits == dlType.bits &&
+        entry.dlType.lanes == dlType.lanes)
+      return ok(entry.halType);
+  return error(ErrorCode::NotImplemented,
+               "Unsupported DLPack data type (code " +
+                   std::to_string(dlType.code) + ", bits " +
+                   std::to_string(dlType.bits) + ", lanes " +
+                   std::to_string(dlType.lanes) + ")");
+}
+
+inline ErrorOr<DLDataType> getDLDataType(iree_hal_element_type_t halType) {
+  // The first match wins, so `i8` is exported as a signed integer.
+  for (const DLPackElementType &entry : kDLPackElementTypes)
+    if (entry.halType == halType)
+      return ok(entry.dlType);
+  return error(ErrorCode::NotImplemented,
+               "No DLPack data type for IREE HAL element type");
+}
+
+// Fill pattern of a buffer of `type` elements set to `value`, for
+// `iree_hal_device_queue_fill`.
+struct IreeHalFillPattern {
+  uint32_t bits = 0;
+  size_t length = 0; // in bytes: 1, 2 or 4
+};
+
+// Returns the fill pattern repeating `value` converted to `type`. Patterns
+// are at most 4 bytes wide, so 64-bit types are not supported.
+inline ErrorOr<IreeHalFillPattern> getIreeHalFillPattern(DataType type,
+                                                         double value) {
+  switch (type) {
+  case DataType::Half:
+    return ok(IreeHalFillPattern{std::bit_cast<uint16_t>(half(value)), 2});
+  case DataType::BFloat16:
+    return ok(IreeHalFillPattern{std::bit_cast<uint16_t>(bf16(value)), 2});
+  case DataType::Float:
+    return ok(IreeHalFillPattern{std::bit_cast<uint32_t>(float(value)), 4});
+  case DataType::Uint8:
+    return ok(IreeHalFillPattern{uint8_t(value), 1});
+  case DataType::Int4: {
+    // Two nibbles per byte (see `Int4::pack`).
+    uint8_t nibble = uint8_t(int8_t(value)) & 0xF;
+    return ok(IreeHalFillPattern{uint32_t(nibble | (nibble << 4)), 1});
+  }
+  case DataType::Int8:
+  case DataType::Boolean:
+    return ok(IreeHalFillPattern{uint8_t(int8_t(value)), 1});
+  case DataType::Int16:
+    return ok(IreeHalFillPattern{uint16_t(int16_t(value)), 2});
+  case DataType::Int32:
+    return ok(IreeHalFillPattern{uint32_t(int32_t(value)), 4});
+  case DataType::FP8E5M2:
+    return ok(IreeHalFillPattern{fp8e5m2(value).toBits(), 1});
+  case DataType::FP8E4M3FN:
+    return ok(IreeHalFillPattern{fp8e4m3fn(value).toBits(), 1});
+  case DataType::FP8E5M2FNUZ:
+    return ok(IreeHalFillPattern{fp8e5m2fnuz(value).toBits(), 1});
+  case DataType::FP8E4M3FNUZ:
+    return ok(IreeHalFillPattern{fp8e4m3fnuz(value).toBits(), 1});
+  default:
+    return error(ErrorCode::NotImplemented,
+                 "Device fill is not supported for DataType");
+  }
+}
+
 // Custom deleter for IREE VM instance.
 struct IreeVmInstanceDeleter {
   void operator()(iree_vm_instance_t *instance) const {
@@ -393,6 +675,14 @@ struct IreeVmContextDeleter {
   }
 };
 
+// Custom deleter for IREE VM module.
+struct IreeVmModuleDeleter {
+  void operator()(iree_vm_module_t *module) const {
+    if (module)
+      iree_vm_module_release(module);
+  }
+};
+
 // Custom deleter for IREE async frontier tracker.
 struct IreeAsyncFrontierTrackerDeleter {
   void operator()(iree_async_frontier_tracker_t *tracker) const {
@@ -409,6 +699,22 @@ struct IreeVmListDeleter {
   }
 };
 
+// Custom deleter for IREE HAL fence.
+struct IreeHalFenceDeleter {
+  void operator()(iree_hal_fence_t *fence) const {
+    if (fence)
+      iree_hal_fence_release(fence);
+  }
+};
+
+// Custom deleter for IREE HAL buffer.
+struct IreeHalBufferDeleter {
+  void operator()(iree_hal_buffer_t *buffer) const {
+    if (buffer)
+      iree_hal_buffer_release(buffer);
+  }
+};
+
 // Custom deleter for IREE HAL buffer view.
 struct IreeHalBufferViewDeleter {
   void operator()(iree_hal_buffer_view_t *bufferView) const {
@@ -425,13 +731,19 @@ using IreeHalDeviceGroupUniquePtrType =
     std::unique_ptr<iree_hal_device_group_t, IreeHalDeviceGroupDeleter>;
 using IreeVmContextUniquePtrType =
     std::unique_ptr<iree_vm_context_t, IreeVmContextDeleter>;
+using IreeVmModuleUniquePtrType =
+    std::unique_ptr<iree_vm_module_t, IreeVmModuleDeleter>;
 using IreeAsyncFrontierTrackerUniquePtrType =
     std::unique_ptr<iree_async_frontier_tracker_t,
                     IreeAsyncFrontierTrackerDeleter>;
 using IreeVmListUniquePtrType =
     std::unique_ptr<iree_vm_list_t, IreeVmListDeleter>;
+using IreeHalBufferUniquePtrType =
+    std::unique_ptr<iree_hal_buffer_t, IreeHalBufferDeleter>;
 using IreeHalBufferViewUniquePtrType =
     std::unique_ptr<iree_hal_buffer_view_t, IreeHalBufferViewDeleter>;
+using IreeHalFenceUniquePtrType =
+    std::unique_ptr<iree_hal_fence_t, IreeHalFenceDeleter>;
 
 } // namespace fusilli
 
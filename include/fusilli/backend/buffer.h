@@ -16,10 +16,21 @@
 #define FUSILLI_BACKEND_BUFFER_H
 
 #include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer_pool.h"
+#include "fusilli/backend/memory_tracker.h"
+#include "fusilli/backend/fence.h"
+#include "fusilli/backend/host_transfer.h"
+#include "fusilli/external/dlpack.h"
 #include "fusilli/support/logging.h"
 
 #include <iree/hal/api.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -28,6 +39,22 @@ namespace fusilli {
 // Forward declaration of Handle class.
 class Handle;
 
+// Handle to the device memory of a buffer on an AMDGPU handle, exported with
+// `Buffer::exportIpcHandle()` and opened by other processes on the same
+// machine with `Buffer::importIpcHandle()`. It is plain data, so it can be
+// sent over any channel (socket, pipe, shared memory) as is.
+struct BufferIpcHandle {
+  // HIP IPC handle (`hipIpcMemHandle_t`) of the allocation holding the
+  // buffer.
+  std::array<uint8_t, 64> memHandle = {};
+  // Offset of the buffer in the allocation, and its size, in bytes.
+  uint64_t byteOffset = 0;
+  uint64_t byteLength = 0;
+};
+
+// Forward declaration of the result of `Buffer::allocateAsync()`.
+struct QueueAllocation;
+
 class Buffer {
 public:
   // Factory: Allocates a new buffer view and takes ownership.
@@ -37,10 +64,122 @@ public:
   allocate(const Handle &handle, const std::vector<iree_hal_dim_t> &bufferShape,
            const std::vector<T> &bufferData);
 
+  // Factory: Allocates a buffer of `dataType` elements of shape `bufferShape`
+  // without initializing its contents, e.g. for outputs. Nothing is copied
+  // from (or allocated on) the host.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer>
+  allocateUninitialized(const Handle &handle,
+                        const std::vector<iree_hal_dim_t> &bufferShape,
+                        DataType dataType);
+
+  // Factory: Allocates a buffer of `dataType` elements of shape `bufferShape`
+  // with every element set to `value` by a fill on the device, so no host
+  // copy of the contents is made. Not supported for 64-bit types.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer>
+  allocateFilled(const Handle &handle,
+                 const std::vector<iree_hal_dim_t> &bufferShape,
+                 DataType dataType, double value);
+
+  // Factory: Queues the allocation of an uninitialized buffer of `dataType`
+  // elements of shape `bufferShape` on the device, after `waitFence` is
+  // signaled, and returns it with a fence signaled once its memory is
+  // available. Neither the host nor the queue synchronizes with the device
+  // allocator, so temporaries of a pipelined loop are allocated in order with
+  // the work using them: order that work after the returned fence, and free
+  // the buffer with `deallocateAsync()`. The memory comes from the device's
+  // queue-ordered pool, bypassing the caching allocator.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<QueueAllocation>
+  allocateAsync(const Handle &handle,
+                const std::vector<iree_hal_dim_t> &bufferShape,
+                DataType dataType, const Fence &waitFence = Fence());
+
+  // Factory: Allocates a buffer of `dataType` elements of shape `bufferShape`
+  // holding the bytes stored `offset` bytes into the file at `path`, in the
+  // dense encoding of `dataType`, e.g. a tensor of a checkpoint. The file is
+  // memory mapped and uploaded in chunks through pinned staging buffers of
+  // `handle`, so no host copy of the whole tensor is made and reading a chunk
+  // overlaps with the device copying the previous one.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer>
+  allocateFromFile(const Handle &handle, const std::filesystem::path &path,
+                   uint64_t offset,
+                   const std::vector<iree_hal_dim_t> &bufferShape,
+                   DataType dataType);
+
   // Factory: Imports an existing buffer view and retains ownership.
   // Definition in `fusilli/backend/runtime.h`.
   static ErrorOr<Buffer> import(iree_hal_buffer_view_t *externalBufferView);
 
+  // Factory: Wraps external memory at `devicePtr` (a HIP device pointer on
+  // AMDGPU, host memory on CPU) holding a `bufferShape` tensor of `dataType`
+  // elements, without copying, e.g. to pass framework tensors straight to
+  // `Graph::execute()`. The caller keeps the memory alive while the buffer
+  // and any work using it are. `strides` are in elements and must describe
+  // a row-major layout (empty means row-major); padded strides (see
+  // `TensorAttr::hasPaddedStrides()`) import the whole padded storage, whose
+  // shape the buffer takes.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer>
+  importDevicePtr(const Handle &handle, void *devicePtr,
+                  const std::vector<iree_hal_dim_t> &bufferShape,
+                  DataType dataType, const std::vector<int64_t> &strides = {});
+
+  // Factory: Wraps the host memory of `data` as a `bufferShape` tensor on a
+  // CPU handle without copying, so graphs executed on it read and write
+  // `data` in place, and `read()` is not needed to see results once the
+  // execution completes. The caller keeps `data` alive while the buffer and
+  // any work using it are. Aligning `data` to 64 bytes avoids slower
+  // unaligned accesses in dispatches. Byte-aligned element types only; on
+  // AMDGPU use `allocate()` or `importDevicePtr()`.
+  // Definition in `fusilli/backend/runtime.h`.
+  template <typename T>
+  static ErrorOr<Buffer>
+  wrapHost(const Handle &handle, std::span<T> data,
+           const std::vector<iree_hal_dim_t> &bufferShape);
+
+  // Factory: Wraps the memory of a DLPack tensor without copying and takes
+  // ownership of `tensor`, whose deleter is called once the buffer (and all
+  // work using it) releases the memory; on errors the caller keeps it. The
+  // tensor must be row-major, optionally with padded strides (imported as
+  // their storage, like `importDevicePtr()`), and live on the device of
+  // `handle`.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer> importDLPack(const Handle &handle,
+                                      DLManagedTensor *tensor);
+
+  // Exports the device memory of the buffer for other processes on the same
+  // machine (see `importIpcHandle()`), AMDGPU only. The memory is not
+  // copied: the exporting process keeps the buffer alive while importers use
+  // it, and orders their accesses (e.g. by waiting on the fence of the
+  // writing execution before sending the handle).
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<BufferIpcHandle> exportIpcHandle(const Handle &handle) const;
+
+  // Factory: Opens the device memory exported by another process with
+  // `exportIpcHandle()` as a `bufferShape` tensor of `dataType` elements,
+  // without copying. The memory is mapped into this process until the
+  // buffer, and all work using it, releases it.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer>
+  importIpcHandle(const Handle &handle, const BufferIpcHandle &ipc,
+                  const std::vector<iree_hal_dim_t> &bufferShape,
+                  DataType dataType);
+
+  // Exports the buffer as a DLPack tensor sharing its memory. The returned
+  // tensor keeps the memory alive until its deleter is called, which the
+  // consumer (e.g. `torch.from_dlpack`) does once done with it.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<DLManagedTensor *> toDLPack(const Handle &handle) const;
+
+  // Returns the address of the first element of the buffer in the memory of
+  // the device of `handle`: a HIP device pointer on AMDGPU, a host pointer
+  // otherwise, e.g. to check the alignment of imported memory.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<uintptr_t> getAddress(const Handle &handle) const;
+
   // Allocate unstructured buffer for transient/workspace usage.
   // This allocates a raw HAL buffer without typed data initialization.
   // The buffer is wrapped in a buffer view with shape [sizeInBytes] and i8
@@ -49,23 +188,125 @@ public:
   // Definition in `fusilli/backend/runtime.h`.
   static ErrorOr<Buffer> allocateRaw(const Handle &handle, size_t sizeInBytes);
 
+  // Returns a buffer viewing `bufferShape` elements of `dataType` stored
+  // `byteOffset` bytes into this buffer, without copying, e.g. to pack all
+  // weights of a model into one allocation uploaded at once and pass each
+  // tensor in a variant pack. The subview keeps the device memory alive and
+  // aliases it: writes through either buffer are visible through the other.
+  // Keep offsets aligned to the device's buffer alignment (64 bytes is safe
+  // on all backends) so subviews can be bound to dispatches.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<Buffer> subview(size_t byteOffset,
+                          const std::vector<iree_hal_dim_t> &bufferShape,
+                          DataType dataType) const;
+
   // Reads device buffer by initiating a device-to-host transfer then
   // populating `outData`. Definition in `fusilli/backend/runtime.h`.
   template <typename T>
   ErrorObject read(const Handle &handle, std::vector<T> &outData);
 
+  // Reads the device buffer into `outData`, which must hold exactly one
+  // element per buffer element. Unlike the `std::vector` overload, nothing
+  // is allocated or initialized on the host, so preallocated (e.g. pinned)
+  // host memory can be reused across reads.
+  // Definition in `fusilli/backend/runtime.h`.
+  template <typename T>
+  ErrorObject read(const Handle &handle, std::span<T> outData);
+
+  // Reads the raw contents of the device buffer into `outData`, which must
+  // be `byteLength` bytes, the size of the buffer. Sub-byte element types are
+  // read in their packed encoding. Definition in `fusilli/backend/runtime.h`.
+  ErrorObject readBytes(const Handle &handle, void *outData,
+                        size_t byteLength);
+
+  // Queues a device-to-host copy of the buffer into `outData`, which must
+  // hold exactly the buffer's contents and stay alive until the returned
+  // transfer is waited on. The copy runs through a pinned staging buffer of
+  // `handle` after `waitFence` is signaled, without blocking the host, so
+  // downloads overlap with later work on the queue. Byte-aligned element
+  // types only. Definition in `fusilli/backend/runtime.h`.
+  template <typename T>
+  ErrorOr<HostTransfer> readAsync(const Handle &handle, std::span<T> outData,
+                                  const Fence &waitFence = Fence());
+
+  // Queues a host-to-device copy of `data` (of `T` or `const T` elements),
+  // which must hold exactly the buffer's contents, through a pinned staging
+  // buffer of `handle`. `data` is copied into the staging buffer before
+  // returning, so it may be reused right away; the device side of the copy
+  // runs after `waitFence` is signaled. Byte-aligned element types only.
+  // Definition in `fusilli/backend/runtime.h`.
+  template <typename T>
+  ErrorOr<HostTransfer> writeAsync(const Handle &handle, std::span<T> data,
+                                   const Fence &waitFence = Fence());
+
+  // Queues the release of the buffer's device memory after `waitFence` is
+  // signaled, e.g. by the last execution reading it, and returns a fence
+  // signaled once the memory is back in the device's pool. The buffer is
+  // empty afterwards; its subviews must not be used past `waitFence`. Memory
+  // not from `allocateAsync()` is released when its last reference is.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<Fence> deallocateAsync(const Handle &handle,
+                                 const Fence &waitFence = Fence());
+
   // Automatic (implicit) conversion operator for
   // `Buffer` -> `iree_hal_buffer_view_t *`.
   operator iree_hal_buffer_view_t *() const { return getBufferView(); }
 
-  // Delete copy constructors, keep default move constructor and destructor.
+  // Delete copy constructors, keep default move constructor. Buffers from a
+  // caching allocator (see `Handle::enableCachingAllocator()`) return their
+  // device memory to it on destruction.
   Buffer(const Buffer &) = delete;
   Buffer &operator=(const Buffer &) = delete;
   Buffer(Buffer &&) noexcept = default;
-  Buffer &operator=(Buffer &&) noexcept = default;
-  ~Buffer() = default;
+  Buffer &operator=(Buffer &&other) noexcept {
+    if (this != &other) {
+      releaseStorage();
+      bufferView_ = std::move(other.bufferView_);
+      pooled_ = std::move(other.pooled_);
+      tracked_ = std::move(other.tracked_);
+    }
+    return *this;
+  }
+  ~Buffer() { releaseStorage(); }
 
 private:
+  // Size of the chunks `allocateFromFile()` uploads at a time.
+  static constexpr size_t kFileUploadChunkSize = 16 * 1024 * 1024;
+
+  // Allocates a device buffer of `byteLength` bytes viewed with `shape` and
+  // `elementType`, from the caching allocator of `handle` when enabled, and
+  // accounts it as `category` memory of `handle` (see `MemoryStats`).
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer> allocateView(const Handle &handle, size_t byteLength,
+                                      std::span<const iree_hal_dim_t> shape,
+                                      iree_hal_element_type_t elementType,
+                                      detail::MemoryCategory category);
+
+  // Wraps the external memory at `ptr` of `byteLength` bytes in a buffer
+  // view, calling `releaseCallback` once IREE releases the memory.
+  // Definition in `fusilli/backend/runtime.h`.
+  static ErrorOr<Buffer>
+  importExternal(const Handle &handle, void *ptr, size_t byteLength,
+                 std::span<const iree_hal_dim_t> shape,
+                 iree_hal_element_type_t elementType,
+                 iree_hal_buffer_release_callback_t releaseCallback);
+
+  // Queues a copy of `byteLength` bytes between the buffer and a pinned
+  // staging buffer of `handle`, filled from `writeSource` for writes or
+  // copied out to `readTarget` on completion for reads.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<HostTransfer> queueHostTransfer(const Handle &handle,
+                                          const void *writeSource,
+                                          void *readTarget, size_t byteLength,
+                                          const Fence &waitFence);
+
+  // Releases the buffer view, then the pooled device memory it views.
+  void releaseStorage() {
+    bufferView_.reset();
+    pooled_.reset();
+    tracked_.reset();
+  }
+
   // Returns a raw pointer to the underlying IREE HAL buffer view.
   // WARNING: The returned raw pointer is not safe to store since
   // its lifetime is tied to the `Buffer` object and only valid
@@ -78,6 +319,23 @@ private:
       : bufferView_(std::move(bufferView)) {}
 
   IreeHalBufferViewUniquePtrType bufferView_;
+
+  // Allocation from the caching allocator that the buffer view is a subspan
+  // of, shared with subviews of this buffer (see `subview()`).
+  std::shared_ptr<detail::PooledAllocation> pooled_;
+
+  // Accounting of the device memory allocated for the buffer in its handle
+  // (see `Handle::getMemoryStats()`), shared with subviews of this buffer,
+  // which keep the memory alive.
+  std::shared_ptr<detail::TrackedMemory> tracked_;
+};
+
+// A buffer queued for allocation on a device queue (see
+// `Buffer::allocateAsync()`).
+struct QueueAllocation {
+  Buffer buffer;
+  // Signaled once the memory of `buffer` is available on the device.
+  Fence readyFence;
 };
 
 } // namespace fusilli
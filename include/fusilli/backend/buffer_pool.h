@@ -0,0 +1,128 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the caching device allocator of a Fusilli handle (see
+// `Handle::enableCachingAllocator()`): device buffers released by `Buffer`
+// objects are kept in per size class free lists and handed out again to later
+// allocations of the same size class, instead of going back to the HAL
+// allocator.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_BUFFER_POOL_H
+#define FUSILLI_BACKEND_BUFFER_POOL_H
+
+#include "fusilli/backend/backend.h"
+
+#include <iree/hal/api.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Counters of the caching allocator of a handle.
+struct AllocatorStats {
+  // Buffers allocated through the handle while caching is enabled.
+  size_t allocations = 0;
+  // Allocations served from cached device memory.
+  size_t cacheHits = 0;
+  // Device memory held by the allocator, in use or cached.
+  size_t bytesReserved = 0;
+  // Device memory cached for reuse (not in use by any buffer).
+  size_t bytesCached = 0;
+};
+
+namespace detail {
+
+// Free lists of device buffers by size class. Size classes are powers of two,
+// which bounds the memory wasted per buffer to half its size while letting
+// the varying shapes of a pipeline share buffers.
+class BufferPool {
+public:
+  // Smallest size class, in bytes.
+  static constexpr size_t kMinSizeClass = 256;
+
+  static size_t getSizeClass(size_t size) {
+    return std::bit_ceil(std::max(size, kMinSizeClass)); // C++20
+  }
+
+  // Returns a cached buffer of `sizeClass` bytes, or null if there is none,
+  // in which case the caller allocates it and reports it with
+  // `recordAllocation()`.
+  IreeHalBufferUniquePtrType acquire(size_t sizeClass) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.allocations++;
+    auto it = idle_.find(sizeClass);
+    if (it == idle_.end() || it->second.empty())
+      return nullptr;
+    IreeHalBufferUniquePtrType buffer = std::move(it->second.back());
+    it->second.pop_back();
+    stats_.cacheHits++;
+    stats_.bytesCached -= sizeClass;
+    return buffer;
+  }
+
+  // Accounts for a buffer allocated after a miss in `acquire()`.
+  void recordAllocation(size_t sizeClass) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.bytesReserved += sizeClass;
+  }
+
+  // Caches `buffer`, of `sizeClass` bytes, for reuse. Stream ordering makes
+  // reuse safe for work on the queue of the handle, like for the HAL
+  // allocator's own stream-ordered allocations.
+  void release(IreeHalBufferUniquePtrType buffer, size_t sizeClass) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_[sizeClass].push_back(std::move(buffer));
+    stats_.bytesCached += sizeClass;
+  }
+
+  // Returns the cached device memory to the HAL allocator.
+  void trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.clear();
+    stats_.bytesReserved -= stats_.bytesCached;
+    stats_.bytesCached = 0;
+  }
+
+  AllocatorStats getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::unordered_map<size_t, std::vector<IreeHalBufferUniquePtrType>> idle_;
+  AllocatorStats stats_;
+};
+
+// A buffer borrowed from a `BufferPool`, returned to it once the last
+// reference (a `Buffer` or one of its subviews) is dropped.
+struct PooledAllocation {
+  std::shared_ptr<BufferPool> pool;
+  IreeHalBufferUniquePtrType buffer;
+  size_t sizeClass = 0;
+
+  ~PooledAllocation() {
+    if (pool && buffer)
+      pool->release(std::move(buffer), sizeClass);
+  }
+};
+
+} // namespace detail
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_BUFFER_POOL_H
@@ -14,13 +14,18 @@
 #define FUSILLI_BACKEND_COMPILE_COMMAND_H
 
 #include "fusilli/backend/backend.h"
+#include "fusilli/backend/compile_options.h"
+#include "fusilli/backend/compile_resources.h"
+#include "fusilli/backend/compile_server.h"
 #include "fusilli/support/cache.h"
 #include "fusilli/support/external_tools.h"
 #include "fusilli/support/extras.h"
 #include "fusilli/support/logging.h"
 #include "fusilli/support/target_platform.h"
+#include "fusilli/support/tracing.h"
 
 #include <cstdlib>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -48,32 +53,24 @@ public:
   // This constructs the full command with:
   // - iree-compile executable path
   // - input file path
-  // - backend-specific flags
+  // - backend-specific flags, with `options` applied
   // - statistics output flags
   // - output file specification
   //
   // Returns CompileCommand containing the built command or error.
   static CompileCommand build(Backend backend, const CacheFile &input,
                               const CacheFile &output,
-                              const CacheFile &statistics) {
-    std::vector<std::string> args = {getIreeCompilePath(), input.path.string()};
-
-    // Get backend-specific flags.
-    auto flags = getBackendFlags(backend);
-    for (const auto &flag : flags) {
-      args.push_back(flag);
-    }
-
-    // TODO(#12): Make this conditional (enabled only for testing/debug).
-    args.push_back("--iree-scheduling-dump-statistics-format=json");
-    args.push_back("--iree-scheduling-dump-statistics-file=" +
-                   statistics.path.string());
-
-    // Add output specification.
-    args.push_back("-o");
-    args.push_back(output.path.string());
+                              const CacheFile &statistics,
+                              const CompileOptions &options = {}) {
+    return build(backend, input, output, &statistics, options);
+  }
 
-    return CompileCommand(std::move(args));
+  // Overload of the above without statistics output flags, used for the
+  // production compile profile (see `CompileProfile`).
+  static CompileCommand build(Backend backend, const CacheFile &input,
+                              const CacheFile &output,
+                              const CompileOptions &options) {
+    return build(backend, input, output, /*statistics=*/nullptr, options);
   }
 
   // Move constructors (RAII pattern).
@@ -120,7 +117,11 @@ public:
     return cacheFile.write(toString());
   }
 
-  // Executes the compile command using std::system().
+  // Executes the compile command using std::system(), or on the compile
+  // server at `FUSILLI_COMPILE_SERVER_SOCKET` if set (see `CompileServer`).
+  // Compilation falls back to std::system() when the server can't be reached.
+  // `iree-compile` runs under the process wide resource limits (see
+  // `getCompileResourceLimits()`), while the server applies its own.
   //
   // Returns ErrorObject:
   // - ok() if compilation succeeds (return code 0)
@@ -128,11 +129,24 @@ public:
   //
   // Note: stderr output from failed compilation is currently not captured
   ErrorObject execute() {
+    FUSILLI_TRACE_ZONE("fusilli::CompileCommand::execute");
     FUSILLI_LOG_LABEL_ENDL("INFO: Executing compile command");
 
+#if !defined(FUSILLI_PLATFORM_WINDOWS)
+    if (std::optional<std::string> socket = getCompileServerSocketEnv()) {
+      ErrorObject status = compileOnServer(*socket, args_);
+      if (isOk(status) || status.getCode() != ErrorCode::RuntimeFailure)
+        return status;
+      FUSILLI_LOG_LABEL_ENDL("WARNING: " << status.getMessage()
+                                         << ", running iree-compile directly");
+    }
+#endif
+
     // TODO(#11): in the error case, std::system will dump to stderr, it would
     // be great to capture this for better logging + reproducer production.
-    int returnCode = std::system(toString().c_str());
+    int returnCode = runWithCompileResourceLimits(
+        getCompileResourceLimits(),
+        [&] { return std::system(toString().c_str()); });
     FUSILLI_RETURN_ERROR_IF(returnCode, ErrorCode::CompileFailure,
                             "iree-compile command failed");
 
@@ -143,6 +157,33 @@ public:
   const std::vector<std::string> &getArgs() const { return args_; }
 
 private:
+  // Shared implementation of the `build()` overloads. Statistics are only
+  // dumped when a `statistics` file is given.
+  static CompileCommand build(Backend backend, const CacheFile &input,
+                              const CacheFile &output,
+                              const CacheFile *statistics,
+                              const CompileOptions &options) {
+    std::vector<std::string> args = {getIreeCompilePath(), input.path.string()};
+
+    // Get backend-specific flags.
+    auto flags = options.resolveFlags(backend);
+    for (const auto &flag : flags) {
+      args.push_back(flag);
+    }
+
+    if (statistics) {
+      args.push_back("--iree-scheduling-dump-statistics-format=json");
+      args.push_back("--iree-scheduling-dump-statistics-file=" +
+                     statistics->path.string());
+    }
+
+    // Add output specification.
+    args.push_back("-o");
+    args.push_back(output.path.string());
+
+    return CompileCommand(std::move(args));
+  }
+
   // Private constructor - use factory method build().
   explicit CompileCommand(std::vector<std::string> args)
       : args_(std::move(args)) {}
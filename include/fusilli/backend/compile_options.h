@@ -0,0 +1,284 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains CompileOptions, per-graph IREE compiler settings layered
+// on top of the process wide backend flags (see `getBackendFlags()`).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_COMPILE_OPTIONS_H
+#define FUSILLI_BACKEND_COMPILE_OPTIONS_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/support/cache.h"
+#include "fusilli/support/hash.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+namespace detail {
+
+// Returns the ROCm target `flags` compile for, or an empty string if none.
+inline std::string getRocmTarget(std::span<const std::string> flags) {
+  constexpr std::string_view kRocmTargetFlag = "--iree-rocm-target=";
+  std::string target;
+  for (const auto &flag : flags)
+    if (flag.starts_with(kRocmTargetFlag))
+      target = flag.substr(kRocmTargetFlag.size());
+  return target;
+}
+
+} // namespace detail
+
+// Selects which compile-side assets are written next to each compiled artifact
+// (see `CompileOptions::setProfile()`).
+enum class CompileProfile : uint8_t {
+  // Writes the input assembly, the equivalent `iree-compile` command, the
+  // scheduling statistics and the digest sidecar along with the VMFB, so any
+  // compilation can be inspected and reproduced. This is the default.
+  Diagnostic,
+  // Writes only the VMFB and keeps the cache key in memory, skipping the
+  // statistics dump in the compiler, for latency sensitive services.
+  Production,
+};
+
+// CompileOptions holds IREE compiler flags that override or extend the
+// defaults for a backend. It is attached to a `Graph` (see
+// `Graph::setCompileOptions()`) or passed to `Graph::compileToArtifact()`, and
+// participates in the kernel cache key, so changing options never needs a
+// process restart and never reuses artifacts compiled with other flags.
+//
+// Usage:
+//   CompileOptions options;
+//   options.setOptLevel("O1").setSplitReduction(false).setFlag("--foo=bar");
+//   graph.setCompileOptions(options);
+//
+// A flag replaces any default (or previously set) flag with the same name, so
+// e.g. `setOptLevel("O1")` overrides the AMDGPU default of `O3` rather than
+// passing both to the compiler.
+class CompileOptions {
+public:
+  // Sets an IREE compiler flag of the form "--flag-name=value" or
+  // "--flag-name".
+  CompileOptions &setFlag(const std::string &flag) {
+    std::string_view name = getFlagName(flag);
+    if (name == kTuningSpecFlag)
+      tuningSpecAsm_.reset();
+    std::erase_if(flags_, [&](const std::string &existing) { // C++20
+      return getFlagName(existing) == name;
+    });
+    flags_.push_back(flag);
+    return *this;
+  }
+
+  // Sets multiple IREE compiler flags, in order.
+  CompileOptions &setFlags(std::span<const std::string> flags) {
+    for (const auto &flag : flags)
+      setFlag(flag);
+    return *this;
+  }
+
+  // Sets the IREE optimization level, e.g. "O0" through "O3".
+  CompileOptions &setOptLevel(const std::string &level) {
+    return setFlag("--iree-opt-level=" + level);
+  }
+
+  // Sets the ROCm target (SKU such as "mi300x" or architecture such as
+  // "gfx942") instead of the one detected for the AMDGPU backend.
+  CompileOptions &setRocmTarget(const std::string &target) {
+    return setFlag("--iree-rocm-target=" + target);
+  }
+
+  // Enables or disables split reductions during dispatch creation.
+  CompileOptions &setSplitReduction(bool enable) {
+    return setFlag(std::string(kSplitReductionFlag) + "=" +
+                   (enable ? "true" : "false"));
+  }
+
+  // Returns whether split reductions are enabled when compiling for
+  // `backend`, by these options or else the backend defaults (see
+  // `resolveFlags()`), or std::nullopt if neither sets them and the compiler
+  // default applies.
+  std::optional<bool> getSplitReduction(Backend backend) const {
+    std::optional<bool> enabled;
+    for (const auto &flag : resolveFlags(backend)) {
+      if (getFlagName(flag) != kSplitReductionFlag)
+        continue;
+      std::string_view value = std::string_view(flag).substr(
+          std::min(flag.size(), kSplitReductionFlag.size() + 1));
+      enabled = value.empty() || value == "true" || value == "1";
+    }
+    return enabled;
+  }
+
+  // Sets the compile profile, see `CompileProfile`. The profile participates
+  // in the cache key, so kernel cache entries always hold the full set of
+  // assets of the profile they were compiled with.
+  CompileOptions &setProfile(CompileProfile profile) {
+    profile_ = profile;
+    return *this;
+  }
+
+  // Returns the compile profile.
+  CompileProfile getProfile() const { return profile_; }
+
+  // Returns `base` with overrides that trade the performance of the compiled
+  // artifact for compilation time: a lower optimization level and no
+  // optional dispatch creation transformations. Used for the first tier of
+  // `Graph::compileTiered()`.
+  static CompileOptions fastCompile(CompileOptions base) {
+    return std::move(base.setOptLevel("O1").setSplitReduction(false).setFlag(
+        "--iree-dispatch-creation-enable-aggressive-reshape-movement=false"));
+  }
+
+  // Overload of the above applying the overrides to default options.
+  static CompileOptions fastCompile() { return fastCompile(CompileOptions()); }
+
+  // Returns `base` with overrides that favor the performance of artifacts
+  // compiled for the CPU backend over compilation time: matmuls and
+  // convolutions use data-tiled (packed) layouts with the IREE microkernels,
+  // and constant weights (e.g. embedded tensors) are packed once at compile
+  // time rather than on every execution. Tile sizes follow the cache sizes of
+  // the target CPU, which defaults to the host (see `getBackendFlags()`).
+  static CompileOptions cpuPerformance(CompileOptions base) {
+    return std::move(base.setOptLevel("O3")
+                         .setFlag("--iree-opt-data-tiling=true")
+                         .setFlag("--iree-llvmcpu-enable-ukernels=all")
+                         .setFlag("--iree-opt-const-eval=true"));
+  }
+
+  // Overload of the above applying the overrides to default options.
+  static CompileOptions cpuPerformance() {
+    return cpuPerformance(CompileOptions());
+  }
+
+  // Attaches the tuning spec (transform dialect library) held in `mlir`. The
+  // spec is written to a content-addressed file in the cache directory when
+  // compiling (see `writeTuningSpec()`) and passed to the compiler through
+  // `--iree-codegen-tuning-spec-path`, so its content is part of the cache key.
+  CompileOptions &setTuningSpecAsm(std::string mlir) {
+    std::string key = Hasher().update(mlir).hexDigest();
+    setFlag(std::string(kTuningSpecFlag) + "=" +
+            CacheFile::getTuningSpecPath(key).string());
+    tuningSpecAsm_ = std::move(mlir);
+    return *this;
+  }
+
+  // Reads the tuning spec at `path` and attaches it as `setTuningSpecAsm()`
+  // does. The contents are captured now; later edits to the file require
+  // calling this again.
+  ErrorObject setTuningSpec(const std::filesystem::path &path) {
+    FUSILLI_ASSIGN_OR_RETURN(CacheFile file, CacheFile::open(path));
+    FUSILLI_ASSIGN_OR_RETURN(std::string mlir, file.read());
+    setTuningSpecAsm(std::move(mlir));
+    return ok();
+  }
+
+  // Returns the attached tuning spec, if any.
+  const std::optional<std::string> &getTuningSpecAsm() const {
+    return tuningSpecAsm_;
+  }
+
+  // Writes the attached tuning spec to its content-addressed path, unless it
+  // already exists. Must be called before compiling with these options.
+  // Tuning spec files are never removed, since IREE may keep referring to them
+  // for the lifetime of the process.
+  ErrorObject writeTuningSpec() const {
+    if (!tuningSpecAsm_.has_value())
+      return ok();
+    std::filesystem::path path = CacheFile::getTuningSpecPath(
+        Hasher().update(*tuningSpecAsm_).hexDigest());
+    if (std::filesystem::exists(path))
+      return ok();
+    return CacheFile::publish(path, *tuningSpecAsm_);
+  }
+
+  // Returns the flags set on these options, in order.
+  const std::vector<std::string> &getFlags() const { return flags_; }
+
+  // Returns the complete set of compiler flags for `backend`: the backend
+  // defaults (`getBackendFlags()`) with these options applied.
+  std::vector<std::string> resolveFlags(Backend backend) const {
+    std::vector<std::string> resolved;
+    for (const auto &flag : getBackendFlags(backend)) {
+      std::string_view name = getFlagName(flag);
+      if (std::none_of(flags_.begin(), flags_.end(),
+                       [&](const std::string &option) {
+                         return getFlagName(option) == name;
+                       }))
+        resolved.push_back(flag);
+    }
+    resolved.insert(resolved.end(), flags_.begin(), flags_.end());
+    return resolved;
+  }
+
+  // Serializes the flags set on these options, one per line. The contents of
+  // an attached tuning spec are not included, only its content-addressed path,
+  // and neither is the profile.
+  std::string toString() const {
+    std::ostringstream oss;
+    for (const auto &flag : flags_)
+      oss << flag << "\n";
+    return oss.str();
+  }
+
+  // Inverse of `toString()`.
+  static CompileOptions fromString(const std::string &serialized) {
+    CompileOptions options;
+    std::istringstream iss(serialized);
+    std::string flag;
+    while (std::getline(iss, flag))
+      if (!flag.empty())
+        options.setFlag(flag);
+    return options;
+  }
+
+  // Returns the tuning spec path these options pass to the compiler, if any.
+  std::optional<std::filesystem::path> getTuningSpecPath() const {
+    for (const auto &flag : flags_)
+      if (getFlagName(flag) == kTuningSpecFlag)
+        return std::filesystem::path(flag.substr(kTuningSpecFlag.size() + 1));
+    return std::nullopt;
+  }
+
+  bool operator==(const CompileOptions &) const = default; // C++20
+
+private:
+  static constexpr std::string_view kTuningSpecFlag =
+      "--iree-codegen-tuning-spec-path";
+  static constexpr std::string_view kSplitReductionFlag =
+      "--iree-dispatch-creation-enable-split-reduction";
+
+  // Returns the part of `flag` preceding the value, e.g. "--iree-opt-level"
+  // for "--iree-opt-level=O3".
+  static std::string_view getFlagName(std::string_view flag) {
+    return flag.substr(0, flag.find('='));
+  }
+
+  std::vector<std::string> flags_;
+
+  CompileProfile profile_ = CompileProfile::Diagnostic;
+
+  // Set by `setTuningSpecAsm()`.
+  std::optional<std::string> tuningSpecAsm_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_COMPILE_OPTIONS_H
@@ -0,0 +1,102 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains CompileReport, the per-phase wall time breakdown filled
+// by `Graph::compile()` and `Graph::compileToArtifact()`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_COMPILE_REPORT_H
+#define FUSILLI_BACKEND_COMPILE_REPORT_H
+
+#include <chrono>
+
+namespace fusilli {
+
+// Wall time spent in each phase of compiling (and, for `compile()`, loading)
+// a graph, e.g. to budget cold-start latency. Phases that did not run, such
+// as the compiler phases on a cache hit, are left at zero.
+//
+// Usage:
+//   CompileReport report;
+//   FUSILLI_CHECK_ERROR(graph.compile(handle, /*remove=*/false, &report));
+//   if (!report.cacheHit) ... report.compilerPipeline ...
+struct CompileReport {
+  // Checking that the graph was validated (validation itself is
+  // `Graph::validate()`).
+  std::chrono::nanoseconds validation{0};
+
+  // Emitting the MLIR assembly of the graph.
+  std::chrono::nanoseconds asmEmission{0};
+
+  // Looking up the in-process, fingerprint, kernel and remote caches,
+  // including waiting on the cache locks held by concurrent compilations.
+  std::chrono::nanoseconds cacheValidation{0};
+
+  // Parsing the assembly in the IREE compiler. Compilations through the
+  // `iree-compile` CLI report their whole run as `compilerPipeline`.
+  std::chrono::nanoseconds compilerParse{0};
+
+  // Running the IREE compiler pipeline and serializing the VMFB.
+  std::chrono::nanoseconds compilerPipeline{0};
+
+  // Reading (or memory-mapping) the compiled artifact.
+  std::chrono::nanoseconds artifactRead{0};
+
+  // Creating the VM context, i.e. loading the artifact on the device
+  // (`compile()` only).
+  std::chrono::nanoseconds vmContextCreation{0};
+
+  // Querying the workspace size of the loaded module (`compile()` only).
+  std::chrono::nanoseconds workspaceQuery{0};
+
+  // Whether the artifact came from a compile-side cache rather than the
+  // compiler.
+  bool cacheHit = false;
+
+  // Returns the sum of all phases.
+  std::chrono::nanoseconds total() const {
+    return validation + asmEmission + cacheValidation + compilerParse +
+           compilerPipeline + artifactRead + vmContextCreation +
+           workspaceQuery;
+  }
+};
+
+namespace detail {
+
+// Adds the wall time between its construction and `stop()` (or its
+// destruction) to `*phase`. A null `phase` is not timed, so call sites don't
+// need to check whether a report was requested.
+class PhaseTimer {
+public:
+  explicit PhaseTimer(std::chrono::nanoseconds *phase)
+      : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+  void stop() {
+    if (!phase_)
+      return;
+    *phase_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_);
+    phase_ = nullptr;
+  }
+
+  ~PhaseTimer() { stop(); }
+
+  PhaseTimer(const PhaseTimer &) = delete;
+  PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+private:
+  std::chrono::nanoseconds *phase_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace detail
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_COMPILE_REPORT_H
@@ -0,0 +1,271 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains CompileResourceLimits, which bound the CPU time the IREE
+// compiler takes from the rest of the process (e.g. request threads of a
+// serving process compiling graphs in the background).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_COMPILE_RESOURCES_H
+#define FUSILLI_BACKEND_COMPILE_RESOURCES_H
+
+#include "fusilli/support/logging.h"
+#include "fusilli/support/target_platform.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(FUSILLI_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+namespace fusilli {
+
+// Limits on the CPU resources of compilations, for processes where compiling
+// competes with latency sensitive work. By default the compiler runs at the
+// priority of the calling thread and its threading spreads over every core
+// the process may use.
+//
+// Compilations with limits run on a dedicated thread that applies them
+// first, so they never change the calling thread. Both the threads the
+// compiler spawns from it and `iree-compile` subprocesses inherit them. The
+// in-process compiler creates its worker threads lazily and keeps them for
+// the lifetime of the process, so set limits before the first in-process
+// compilation for them to apply to its workers too.
+//
+// Limits are only applied on Linux and ignored elsewhere. Failing to apply
+// one (e.g. a core outside the affinity mask of the process) is logged and
+// does not fail the compilation.
+//
+// Usage:
+//   getCompileResourceLimits() = CompileResourceLimits{
+//       .maxThreads = 2, .niceness = 10};
+struct CompileResourceLimits {
+  // Maximum number of cores the compiler runs on, enforced by restricting its
+  // affinity (LLVM sizes its thread pools from the affinity mask). The last
+  // `maxThreads` cores of `cpus` (or of the cores of the process) are used,
+  // away from core 0 which commonly serves interrupts and the main thread.
+  // Unset leaves the number of cores unbounded.
+  std::optional<unsigned> maxThreads;
+
+  // Increment added to the nice value of compiling threads, e.g. 10 or 19 to
+  // only compile when cores would otherwise idle. Unprivileged processes can
+  // only lower their priority, so negative values typically fail.
+  std::optional<int> niceness;
+
+  // Cores the compiler may run on. Empty leaves its affinity unrestricted.
+  std::vector<unsigned> cpus;
+
+  // Returns whether no limit is set.
+  bool isUnlimited() const {
+    return !maxThreads.has_value() && !niceness.has_value() && cpus.empty();
+  }
+
+  // Returns the cores compiling threads run on when the cores `allowed`
+  // (e.g. the affinity mask of the process) are available, or an empty list
+  // to leave their affinity unchanged.
+  std::vector<unsigned>
+  resolveCpus(const std::vector<unsigned> &allowed) const {
+    std::vector<unsigned> resolved;
+    if (cpus.empty()) {
+      resolved = allowed;
+    } else {
+      for (unsigned cpu : cpus)
+        if (std::find(allowed.begin(), allowed.end(), cpu) != allowed.end())
+          resolved.push_back(cpu);
+    }
+    std::sort(resolved.begin(), resolved.end());
+    resolved.erase(std::unique(resolved.begin(), resolved.end()),
+                   resolved.end());
+    if (maxThreads.has_value() && *maxThreads > 0 &&
+        resolved.size() > *maxThreads)
+      resolved.erase(resolved.begin(), resolved.end() - *maxThreads);
+    if (cpus.empty() && resolved.size() == allowed.size())
+      resolved.clear();
+    return resolved;
+  }
+
+  // Parses a list of cores in the format of `taskset --cpu-list`, e.g.
+  // "0-3,8,10-11".
+  static ErrorOr<std::vector<unsigned>> parseCpuList(std::string_view list) {
+    auto parseCpu = [](std::string_view str) -> std::optional<unsigned> {
+      unsigned cpu = 0;
+      auto [ptr, errc] = std::from_chars(str.data(), str.data() + str.size(),
+                                         cpu);
+      if (str.empty() || errc != std::errc() || ptr != str.data() + str.size())
+        return std::nullopt;
+      return cpu;
+    };
+    std::vector<unsigned> cpus;
+    if (list.empty())
+      return ok(std::move(cpus));
+    for (size_t begin = 0; begin <= list.size();) {
+      size_t comma = std::min(list.find(',', begin), list.size());
+      std::string_view range = list.substr(begin, comma - begin);
+      begin = comma + 1;
+      size_t dash = range.find('-');
+      std::optional<unsigned> first = parseCpu(range.substr(0, dash));
+      std::optional<unsigned> last =
+          dash == std::string_view::npos ? first
+                                         : parseCpu(range.substr(dash + 1));
+      FUSILLI_RETURN_ERROR_IF(!first || !last || *last < *first,
+                              ErrorCode::InvalidArgument,
+                              "Invalid CPU list entry: " + std::string(range));
+      for (unsigned cpu = *first; cpu <= *last; ++cpu)
+        cpus.push_back(cpu);
+    }
+    return ok(std::move(cpus));
+  }
+
+  // Returns the limits configured through `FUSILLI_COMPILE_MAX_THREADS`,
+  // `FUSILLI_COMPILE_NICENESS` and `FUSILLI_COMPILE_CPUS` (a list of cores as
+  // accepted by `parseCpuList()`). Invalid values are logged and ignored.
+  static CompileResourceLimits fromEnv() {
+    CompileResourceLimits limits;
+    auto parseInt = [](const char *name) -> std::optional<int> {
+      const char *envVal = std::getenv(name);
+      if (!envVal || std::string_view(envVal).empty())
+        return std::nullopt;
+      std::string_view str(envVal);
+      int parsed = 0;
+      auto [ptr, errc] =
+          std::from_chars(str.data(), str.data() + str.size(), parsed);
+      if (errc != std::errc() || ptr != str.data() + str.size()) {
+        FUSILLI_LOG_LABEL_ENDL("WARNING: Ignoring invalid " << name << "="
+                                                            << envVal);
+        return std::nullopt;
+      }
+      return parsed;
+    };
+    if (std::optional<int> threads = parseInt("FUSILLI_COMPILE_MAX_THREADS")) {
+      if (*threads > 0)
+        limits.maxThreads = static_cast<unsigned>(*threads);
+      else
+        FUSILLI_LOG_LABEL_ENDL(
+            "WARNING: Ignoring non-positive FUSILLI_COMPILE_MAX_THREADS");
+    }
+    limits.niceness = parseInt("FUSILLI_COMPILE_NICENESS");
+    if (const char *envVal = std::getenv("FUSILLI_COMPILE_CPUS")) {
+      ErrorOr<std::vector<unsigned>> cpus = parseCpuList(envVal);
+      if (isOk(cpus))
+        limits.cpus = std::move(*cpus);
+      else
+        FUSILLI_LOG_LABEL_ENDL("WARNING: Ignoring FUSILLI_COMPILE_CPUS: "
+                               << ErrorObject(cpus).getMessage());
+    }
+    return limits;
+  }
+
+  // Serializes the limits for logging.
+  std::string toString() const {
+    std::ostringstream oss;
+    oss << "maxThreads=";
+    if (maxThreads.has_value())
+      oss << *maxThreads;
+    else
+      oss << "unbounded";
+    oss << " niceness=" << niceness.value_or(0) << " cpus=";
+    if (cpus.empty())
+      oss << "all";
+    for (size_t i = 0; i < cpus.size(); ++i)
+      oss << (i ? "," : "") << cpus[i];
+    return oss.str();
+  }
+};
+
+// Process wide limits applied to every compilation, i.e. in-process
+// `CompileSession`s (unless overridden with
+// `CompileSession::setResourceLimits()`) and `iree-compile` subprocesses.
+// Initialized from the environment (see `CompileResourceLimits::fromEnv()`);
+// assign to it, before compiling, to override the environment.
+inline CompileResourceLimits &getCompileResourceLimits() {
+  static CompileResourceLimits limits = CompileResourceLimits::fromEnv();
+  return limits;
+}
+
+namespace detail {
+
+// Applies `limits` to the calling thread, logging the ones that fail.
+inline void applyCompileResourceLimits(const CompileResourceLimits &limits) {
+#if defined(FUSILLI_PLATFORM_LINUX)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask) == 0) {
+    std::vector<unsigned> allowed;
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET(cpu, &mask))
+        allowed.push_back(cpu);
+    std::vector<unsigned> cpus = limits.resolveCpus(allowed);
+    if (!limits.cpus.empty() && cpus.empty()) {
+      FUSILLI_LOG_LABEL_ENDL("WARNING: None of the compile CPUs are available "
+                             "to the process, leaving affinity unchanged");
+    } else if (!cpus.empty()) {
+      CPU_ZERO(&mask);
+      for (unsigned cpu : cpus)
+        CPU_SET(cpu, &mask);
+      if (pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) != 0)
+        FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to set compile CPU affinity");
+    }
+  }
+  if (limits.niceness.has_value() && *limits.niceness != 0) {
+    // On Linux, the nice value is per thread.
+    auto tid = static_cast<id_t>(syscall(SYS_gettid));
+    int current = getpriority(PRIO_PROCESS, tid);
+    if (setpriority(PRIO_PROCESS, tid, current + *limits.niceness) != 0)
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to change compile niceness by "
+                             << *limits.niceness);
+  }
+#else
+  (void)limits;
+#endif
+}
+
+} // namespace detail
+
+// Calls `fn` under `limits` and returns its result. Without limits, `fn` is
+// called on the calling thread; otherwise on a dedicated thread, which the
+// calling thread waits for (see `CompileResourceLimits`).
+template <typename Fn>
+std::invoke_result_t<Fn> runWithCompileResourceLimits(
+    const CompileResourceLimits &limits, Fn &&fn) {
+#if defined(FUSILLI_PLATFORM_LINUX)
+  if (limits.isUnlimited())
+    return fn();
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling with resource limits: "
+                         << limits.toString());
+  std::optional<std::invoke_result_t<Fn>> result;
+  std::thread worker([&] {
+    detail::applyCompileResourceLimits(limits);
+    result.emplace(fn());
+  });
+  worker.join();
+  return std::move(*result);
+#else
+  (void)limits;
+  return fn();
+#endif
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_COMPILE_RESOURCES_H
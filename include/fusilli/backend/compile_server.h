@@ -0,0 +1,408 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains CompileServer, a long-lived compile daemon serving
+// `iree-compile` command lines over a Unix domain socket, and the client used
+// by `CompileCommand::execute()` when `FUSILLI_COMPILE_SERVER_SOCKET` is set.
+//
+// The server keeps the IREE compiler loaded (and its sessions pooled, see
+// `CompileContext::createSession()`) across requests, so processes using the
+// CLI backend avoid the cost of starting `iree-compile` for every graph while
+// a compiler crash still only takes down the server, not the client.
+//
+// Messages are a 32-bit part count followed by, for each part, its 32-bit
+// size and bytes (host byte order, as both ends share a machine). A request
+// holds the arguments of the command line; the response holds the status
+// ("0" on success) and the diagnostics of a failed compilation.
+//
+// The socket is only accessible to the user running the server, which also
+// checks the user of every client and only writes outputs into the cache
+// directory (see `CacheFile::getCacheDir()`), which clients must share.
+//
+// Unix domain sockets are not supported on Windows, where `CompileCommand`
+// always runs `iree-compile` directly.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_COMPILE_SERVER_H
+#define FUSILLI_BACKEND_COMPILE_SERVER_H
+
+#include "fusilli/support/logging.h"
+#include "fusilli/support/target_platform.h"
+
+#include <cstdlib>
+#include <optional>
+#include <string>
+
+#if !defined(FUSILLI_PLATFORM_WINDOWS)
+#include "fusilli/backend/compile_session.h"
+#include "fusilli/support/cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <semaphore>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace fusilli {
+
+// Returns the socket of the compile server to send CLI backend compilations
+// to, as set by `FUSILLI_COMPILE_SERVER_SOCKET`, or std::nullopt to run
+// `iree-compile` directly.
+inline std::optional<std::string> getCompileServerSocketEnv() {
+  const char *envVal = std::getenv("FUSILLI_COMPILE_SERVER_SOCKET");
+  if (!envVal || std::string(envVal).empty())
+    return std::nullopt;
+  return std::string(envVal);
+}
+
+#if !defined(FUSILLI_PLATFORM_WINDOWS)
+
+namespace detail {
+
+// Upper bound on the size of a message part, so a corrupt or hostile peer
+// can't make us allocate arbitrary amounts of memory.
+inline constexpr uint32_t kMaxCompileServerPartSize = 64u << 20;
+
+inline bool writeAll(int fd, const void *data, size_t size) {
+  const char *ptr = static_cast<const char *>(data);
+  while (size > 0) {
+    // MSG_NOSIGNAL: a peer that went away must not kill us with SIGPIPE.
+    ssize_t written = ::send(fd, ptr, size, MSG_NOSIGNAL);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      return false;
+    ptr += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+inline bool readAll(int fd, void *data, size_t size) {
+  char *ptr = static_cast<char *>(data);
+  while (size > 0) {
+    ssize_t received = ::recv(fd, ptr, size, 0);
+    if (received < 0 && errno == EINTR)
+      continue;
+    if (received <= 0)
+      return false;
+    ptr += received;
+    size -= static_cast<size_t>(received);
+  }
+  return true;
+}
+
+inline bool writeMessage(int fd, std::span<const std::string> parts) {
+  uint32_t count = static_cast<uint32_t>(parts.size());
+  if (!writeAll(fd, &count, sizeof(count)))
+    return false;
+  for (const auto &part : parts) {
+    uint32_t size = static_cast<uint32_t>(part.size());
+    if (!writeAll(fd, &size, sizeof(size)) ||
+        !writeAll(fd, part.data(), part.size()))
+      return false;
+  }
+  return true;
+}
+
+inline std::optional<std::vector<std::string>> readMessage(int fd) {
+  uint32_t count = 0;
+  if (!readAll(fd, &count, sizeof(count)))
+    return std::nullopt;
+  std::vector<std::string> parts;
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t size = 0;
+    if (!readAll(fd, &size, sizeof(size)) || size > kMaxCompileServerPartSize)
+      return std::nullopt;
+    std::string part(size, '\0');
+    if (!readAll(fd, part.data(), size))
+      return std::nullopt;
+    parts.push_back(std::move(part));
+  }
+  return parts;
+}
+
+// Closes a socket when going out of scope.
+struct SocketCloser {
+  int fd;
+  ~SocketCloser() {
+    if (fd >= 0)
+      ::close(fd);
+  }
+};
+
+// Fills `addr` with `path`, failing if it does not fit in `sun_path`.
+inline bool makeSocketAddress(const std::string &path, sockaddr_un &addr) {
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(addr.sun_path))
+    return false;
+  std::memcpy(addr.sun_path, path.data(), path.size());
+  return true;
+}
+
+} // namespace detail
+
+// Compiles the `iree-compile` command line `args` on the compile server
+// listening at `socketPath`.
+//
+// Returns ErrorObject:
+// - ok() if compilation succeeds
+// - error(ErrorCode::CompileFailure, msg) with the diagnostics of the server
+//   if compilation fails
+// - error(ErrorCode::RuntimeFailure, msg) if the server can't be reached or
+//   goes away before responding, in which case callers may compile locally
+inline ErrorObject compileOnServer(const std::string &socketPath,
+                                   std::span<const std::string> args) {
+  sockaddr_un addr;
+  FUSILLI_RETURN_ERROR_IF(!detail::makeSocketAddress(socketPath, addr),
+                          ErrorCode::RuntimeFailure,
+                          "Invalid compile server socket path: " + socketPath);
+  detail::SocketCloser socket{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+  FUSILLI_RETURN_ERROR_IF(
+      socket.fd < 0 || ::connect(socket.fd,
+                                 reinterpret_cast<const sockaddr *>(&addr),
+                                 sizeof(addr)) != 0,
+      ErrorCode::RuntimeFailure,
+      "Failed to connect to compile server at " + socketPath);
+
+  std::optional<std::vector<std::string>> response;
+  if (detail::writeMessage(socket.fd, args))
+    response = detail::readMessage(socket.fd);
+  FUSILLI_RETURN_ERROR_IF(!response.has_value() || response->size() != 2,
+                          ErrorCode::RuntimeFailure,
+                          "Compile server at " + socketPath +
+                              " closed the connection without responding");
+  FUSILLI_RETURN_ERROR_IF((*response)[0] != "0", ErrorCode::CompileFailure,
+                          "iree-compile command failed on compile server: " +
+                              (*response)[1]);
+  return ok();
+}
+
+// CompileServer accepts `iree-compile` command lines (as built by
+// `CompileCommand`) over a Unix domain socket and compiles them in-process
+// through the IREE compiler C API, sharing one loaded compiler and a pool of
+// sessions across all clients.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(CompileServer server,
+//                            CompileServer::listen("/tmp/fusilli.sock"));
+//   FUSILLI_CHECK_ERROR(server.serve(/*parallelism=*/4));
+//
+// and in clients using the CLI backend:
+//   FUSILLI_COMPILE_SERVER_SOCKET=/tmp/fusilli.sock ./app
+class CompileServer {
+public:
+  // Listens at `socketPath`, replacing a stale socket left by a previous
+  // server. The socket is only accessible to the current user.
+  static ErrorOr<CompileServer>
+  listen(const std::filesystem::path &socketPath) {
+    sockaddr_un addr;
+    FUSILLI_RETURN_ERROR_IF(
+        !detail::makeSocketAddress(socketPath.string(), addr),
+        ErrorCode::InvalidArgument,
+        "Invalid compile server socket path: " + socketPath.string());
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    FUSILLI_RETURN_ERROR_IF(fd < 0, ErrorCode::RuntimeFailure,
+                            "Failed to create compile server socket");
+    ::unlink(socketPath.c_str());
+    // Clients can't connect before `listen()`, so restricting the socket in
+    // between leaves no window for other users.
+    if (::bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) !=
+            0 ||
+        ::chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0) {
+      ::close(fd);
+      return error(ErrorCode::RuntimeFailure,
+                   "Failed to listen at " + socketPath.string());
+    }
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compile server listening at "
+                           << socketPath.string());
+    return ok(CompileServer(fd, socketPath));
+  }
+
+  // Non-copyable.
+  CompileServer(const CompileServer &) = delete;
+  CompileServer &operator=(const CompileServer &) = delete;
+
+  // Movable.
+  CompileServer(CompileServer &&other) noexcept
+      : fd_(std::exchange(other.fd_, -1)),
+        socketPath_(std::move(other.socketPath_)),
+        stopping_(std::move(other.stopping_)) {}
+
+  CompileServer &operator=(CompileServer &&other) noexcept {
+    if (this != &other) {
+      close();
+      fd_ = std::exchange(other.fd_, -1);
+      socketPath_ = std::move(other.socketPath_);
+      stopping_ = std::move(other.stopping_);
+    }
+    return *this;
+  }
+
+  ~CompileServer() { close(); }
+
+  // Serves requests until `stop()` is called, compiling up to `parallelism`
+  // requests concurrently. Returns once the requests in flight are done.
+  ErrorObject serve(size_t parallelism) {
+    FUSILLI_ASSIGN_OR_RETURN(CompileContext * context,
+                             CompileContext::create());
+    parallelism = std::max<size_t>(parallelism, 1);
+    // Shared with the workers, which may still be releasing their slot when
+    // this returns.
+    auto slots = std::make_shared<std::counting_semaphore<>>(
+        static_cast<ptrdiff_t>(parallelism));
+    while (!stopping_->load()) {
+      slots->acquire();
+      int client = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+      if (client < 0) {
+        slots->release();
+        if (errno == EINTR || errno == ECONNABORTED)
+          continue;
+        // `stop()` shuts the socket down, which fails the pending accept.
+        if (stopping_->load())
+          break;
+        return error(ErrorCode::RuntimeFailure,
+                     "Compile server failed to accept a connection");
+      }
+      std::thread([context, client, slots]() {
+        handleConnection(context, client);
+        slots->release();
+      }).detach();
+    }
+    // Wait for the requests in flight.
+    for (size_t i = 0; i < parallelism; ++i)
+      slots->acquire();
+    return ok();
+  }
+
+  // Makes `serve()` return. Safe to call from any thread (but not from a
+  // signal handler).
+  void stop() {
+    stopping_->store(true);
+    if (fd_ >= 0)
+      ::shutdown(fd_, SHUT_RDWR);
+  }
+
+  // Returns the path of the socket the server listens at.
+  const std::filesystem::path &getSocketPath() const { return socketPath_; }
+
+  // Compiles a single request, the arguments of an `iree-compile` command
+  // line: the executable, the input file, the flags, and "-o" followed by the
+  // output file. The output and statistics files must be in the cache
+  // directory. Returns the diagnostics on failure.
+  static ErrorObject compileRequest(CompileContext *context,
+                                    std::span<const std::string> args) {
+    auto outputFlag = std::find(args.begin(), args.end(), "-o");
+    FUSILLI_RETURN_ERROR_IF(args.size() < 4 || outputFlag == args.end() ||
+                                outputFlag < args.begin() + 2 ||
+                                outputFlag + 2 != args.end(),
+                            ErrorCode::InvalidArgument,
+                            "Malformed compile server request");
+    FUSILLI_CHECK_ERROR(checkInCacheDir(*(outputFlag + 1)));
+    constexpr std::string_view kStatisticsFileFlag =
+        "--iree-scheduling-dump-statistics-file=";
+    for (auto flag = args.begin() + 2; flag != outputFlag; ++flag)
+      if (flag->starts_with(kStatisticsFileFlag))
+        FUSILLI_CHECK_ERROR(
+            checkInCacheDir(flag->substr(kStatisticsFileFlag.size())));
+    FUSILLI_ASSIGN_OR_RETURN(
+        CompileSession session,
+        context->createSession(std::span(args.begin() + 2, outputFlag)));
+    return session.compile(args[1], *(outputFlag + 1));
+  }
+
+private:
+  // Class should be constructed using the `listen()` factory function.
+  CompileServer(int fd, std::filesystem::path socketPath)
+      : fd_(fd), socketPath_(std::move(socketPath)),
+        stopping_(std::make_unique<std::atomic<bool>>(false)) {}
+
+  // Returns an error unless `path` is in the cache directory, so clients can
+  // only make the server write compilation outputs.
+  static ErrorObject checkInCacheDir(const std::string &path) {
+    std::error_code rootEc, pathEc;
+    std::filesystem::path root =
+        std::filesystem::weakly_canonical(CacheFile::getCacheDir(), rootEc);
+    std::filesystem::path target =
+        std::filesystem::weakly_canonical(path, pathEc);
+    std::filesystem::path relative = target.lexically_relative(root);
+    FUSILLI_RETURN_ERROR_IF(rootEc || pathEc || relative.empty() ||
+                                *relative.begin() == "..",
+                            ErrorCode::InvalidArgument,
+                            "Compile server only writes into the cache "
+                            "directory " +
+                                root.string() + ", not " + path);
+    return ok();
+  }
+
+  // Returns whether the peer of the connection `fd` runs as the same user as
+  // the server.
+  static bool isSameUser(int fd) {
+    ucred credentials;
+    socklen_t size = sizeof(credentials);
+    return ::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &size) ==
+               0 &&
+           credentials.uid == ::geteuid();
+  }
+
+  static void handleConnection(CompileContext *context, int fd) {
+    detail::SocketCloser socket{fd};
+    if (!isSameUser(fd)) {
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Compile server rejected a connection "
+                             "from another user");
+      return;
+    }
+    std::optional<std::vector<std::string>> request = detail::readMessage(fd);
+    if (!request.has_value())
+      return;
+    ErrorObject status = compileRequest(context, *request);
+    std::vector<std::string> response = {
+        isOk(status) ? "0" : "1", isOk(status) ? "" : status.getMessage()};
+    detail::writeMessage(fd, response);
+  }
+
+  void close() {
+    if (fd_ < 0)
+      return;
+    ::close(fd_);
+    fd_ = -1;
+    std::error_code ec;
+    std::filesystem::remove(socketPath_, ec);
+  }
+
+  int fd_ = -1;
+  std::filesystem::path socketPath_;
+
+  // Heap allocated so the server stays movable; set by `stop()`.
+  std::unique_ptr<std::atomic<bool>> stopping_;
+};
+
+#endif // !defined(FUSILLI_PLATFORM_WINDOWS)
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_COMPILE_SERVER_H
@@ -21,16 +21,28 @@
 #define FUSILLI_BACKEND_COMPILE_SESSION_H
 
 #include "fusilli/backend/backend.h"
+#include "fusilli/backend/compile_options.h"
+#include "fusilli/backend/compile_report.h"
+#include "fusilli/backend/compile_resources.h"
 #include "fusilli/support/cache.h"
 #include "fusilli/support/dllib.h"
 #include "fusilli/support/external_tools.h"
 #include "fusilli/support/extras.h"
 #include "fusilli/support/logging.h"
+#include "fusilli/support/tracing.h"
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace fusilli {
@@ -51,7 +63,7 @@ class CompileSession;
 // - Dynamically loads the IREE compiler shared library
 // - Initializes global compiler state
 // - Provides function pointers to IREE compiler API
-// - Can create multiple CompileSessions
+// - Can create multiple CompileSessions, pooling idle ones for reuse
 //
 // Usage:
 //   ErrorOr<CompileContext*> ctx =
@@ -84,11 +96,28 @@ public:
   // Destructor - cleans up global state and unloads library.
   ~CompileContext();
 
-  // Creates a new compiler session.
-  // Sessions can have different flags and configurations.
+  // Creates a compiler session with the flags for `backend`, with `options`
+  // applied, followed by `extraFlags`. Sessions can have different flags and
+  // configurations.
+  //
+  // Sessions are pooled: once a session is destroyed, it is kept idle (unless
+  // flags were added to it through `CompileSession::addFlag()`) and handed out
+  // again by a later call with the same backend and flags. Compiles with the
+  // same configuration therefore only create a new invocation, rather than
+  // also creating a session and parsing every flag again.
   //
   // Returns ErrorOr<CompileSession> containing the session or error.
-  ErrorOr<CompileSession> createSession(Backend backend);
+  ErrorOr<CompileSession>
+  createSession(Backend backend, const CompileOptions &options = {},
+                std::span<const std::string> extraFlags = {});
+
+  // Overload of the above with exactly `flags` rather than the flags of a
+  // backend, e.g. as parsed from an `iree-compile` command line (see
+  // `CompileServer`).
+  ErrorOr<CompileSession> createSession(std::span<const std::string> flags);
+
+  // Returns the number of idle sessions in the pool.
+  size_t getIdleSessionCount() const;
 
   // Gets the API version of the loaded compiler.
   int getAPIVersion() const;
@@ -105,8 +134,36 @@ private:
   // Loads all required function pointers from the shared library.
   ErrorObject loadSymbols() noexcept;
 
+  // Maximum number of idle sessions kept in the pool. The least recently
+  // released session is destroyed when the pool is full.
+  static constexpr size_t kMaxIdleSessions = 16;
+
+  // Returns the key identifying sessions created for `backend` (if any) with
+  // `flags` in the session pool.
+  static std::string getPoolKey(std::optional<Backend> backend,
+                                std::span<const std::string> flags);
+
+  // Shared implementation of the `createSession()` overloads. `key` identifies
+  // `flags` in the session pool.
+  ErrorOr<CompileSession> createSession(std::optional<Backend> backend,
+                                        std::vector<std::string> flags,
+                                        std::string key);
+
+  // Removes and returns an idle session created with the flags identified by
+  // `key`, or nullptr if there is none.
+  iree_compiler_session_t *acquireIdleSession(const std::string &key);
+
+  // Returns `session`, created with the flags identified by `key`, to the
+  // pool.
+  void releaseSession(std::string key, iree_compiler_session_t *session);
+
   friend class CompileSession;
 
+  // Idle sessions (and the key of their flags), least recently released
+  // first. The pool is small, so it is simply searched linearly.
+  mutable std::mutex sessionPoolMutex_;
+  std::list<std::pair<std::string, iree_compiler_session_t *>> idleSessions_;
+
   // Handle to the dynamically loaded library.
   DynamicLibrary lib_;
 
@@ -144,11 +201,20 @@ private:
   iree_compiler_error_t *(*ireeCompilerSourceOpenFile_)(
       iree_compiler_session_t *, const char *,
       iree_compiler_source_t **) = nullptr;
+  iree_compiler_error_t *(*ireeCompilerSourceWrapBuffer_)(
+      iree_compiler_session_t *, const char * /*bufferName*/,
+      const char * /*buffer*/, size_t /*length*/, bool /*isNullTerminated*/,
+      iree_compiler_source_t **) = nullptr;
   void (*ireeCompilerSourceDestroy_)(iree_compiler_source_t *) = nullptr;
 
   // Output management.
   iree_compiler_error_t *(*ireeCompilerOutputOpenFile_)(
       const char *, iree_compiler_output_t **) = nullptr;
+  iree_compiler_error_t *(*ireeCompilerOutputOpenMembuffer_)(
+      iree_compiler_output_t **) = nullptr;
+  iree_compiler_error_t *(*ireeCompilerOutputMapMemory_)(
+      iree_compiler_output_t *, void ** /*contents*/,
+      uint64_t * /*size*/) = nullptr;
   void (*ireeCompilerOutputKeep_)(iree_compiler_output_t *) = nullptr;
   void (*ireeCompilerOutputDestroy_)(iree_compiler_output_t *) = nullptr;
   iree_compiler_error_t *(*ireeCompilerInvocationOutputVMBytecode_)(
@@ -176,7 +242,8 @@ public:
   // Static factory method matching CompileCommand::build().
   static ErrorOr<CompileSession> build(Backend backend, const CacheFile &input,
                                        const CacheFile &output,
-                                       const CacheFile &statistics);
+                                       const CacheFile &statistics,
+                                       const CompileOptions &options = {});
 
   // Move constructors (RAII pattern).
   CompileSession(CompileSession &&other) noexcept;
@@ -210,6 +277,19 @@ public:
   // Returns ErrorObject indicating success or failure.
   ErrorObject compile(std::string_view input, std::string_view output);
 
+  // Compiles MLIR assembly held in memory to an output file, without writing
+  // the source to the file system first.
+  //
+  // Returns ErrorObject indicating success or failure.
+  ErrorObject compileSource(const std::string &source, std::string_view output);
+
+  // Compiles MLIR assembly held in memory and returns the VM bytecode, without
+  // touching the file system. Flags referring to files (e.g. statistics dumps)
+  // still write those files.
+  //
+  // Returns ErrorOr<std::vector<uint8_t>> with the VMFB bytes or error.
+  ErrorOr<std::vector<uint8_t>> compileToMemory(const std::string &source);
+
   // Serialize to string (for caching/logging).
   std::string toString() const;
 
@@ -222,10 +302,36 @@ public:
   // Get arguments (for compatibility/testing).
   const std::vector<std::string> &getArgs() const;
 
+  // Sets the file the scheduling statistics of the following compilations are
+  // dumped to. Unlike a flag added through `addFlag()`, the path is
+  // per-compile state: sessions created by `build()` stay pooled, and are only
+  // handed out again by `build()`, which sets its own path. Other sessions
+  // setting a path are not reused.
+  ErrorObject setStatisticsFile(const std::filesystem::path &path);
+
+  // Sets the resource limits the compilations of this session run under,
+  // which default to the process wide ones (see `getCompileResourceLimits()`).
+  void setResourceLimits(CompileResourceLimits limits) {
+    limits_ = std::move(limits);
+  }
+
+  // Returns the resource limits the compilations of this session run under.
+  const CompileResourceLimits &getResourceLimits() const { return limits_; }
+
+  // Returns the wall time the compilations of this session spent parsing
+  // sources, and running the pipeline and serializing the VM bytecode (see
+  // `CompileReport`).
+  std::chrono::nanoseconds getParseTime() const { return parseTime_; }
+  std::chrono::nanoseconds getPipelineTime() const { return pipelineTime_; }
+
 private:
   // Private constructor - use CompileContext::createSession().
   CompileSession(CompileContext *context, iree_compiler_session_t *session,
-                 Backend backend);
+                 std::optional<Backend> backend);
+
+  // Returns the session to the pool of the context if it may be reused,
+  // destroys it otherwise.
+  void releaseSession();
 
   // Destroys an IREE compiler error object.
   void destroyError(iree_compiler_error_t *error);
@@ -233,6 +339,31 @@ private:
   // Gets the error message from an IREE compiler error object.
   std::string getErrorMessage(iree_compiler_error_t *error);
 
+  // Creates an invocation, parses `source` and runs the standard compilation
+  // pipeline. `source` is destroyed on return. On success the caller owns the
+  // returned invocation and must destroy it.
+  ErrorOr<iree_compiler_invocation_t *>
+  parseAndRunPipeline(iree_compiler_source_t *source);
+
+  // Wraps the null terminated MLIR assembly in `source` as a compiler source.
+  // `source` must outlive the returned source.
+  ErrorOr<iree_compiler_source_t *> wrapSource(const std::string &source);
+
+  // Implementation of `compileToMemory()`, run under the resource limits.
+  ErrorOr<std::vector<uint8_t>> compileToMemoryImpl(const std::string &source);
+
+  // Flag setting the statistics file of `setStatisticsFile()`, and the
+  // suffix of the pool keys of `build()` sessions, which set one per compile.
+  static constexpr std::string_view kStatisticsFileFlag =
+      "--iree-scheduling-dump-statistics-file";
+  static constexpr std::string_view kPerCompileStatisticsKey =
+      "\n--iree-scheduling-dump-statistics-file=<per-compile>";
+
+  // Writes the VM bytecode of the compiled invocation `inv` to the file at
+  // `output`. `inv` is destroyed on return.
+  ErrorObject outputToFile(iree_compiler_invocation_t *inv,
+                           std::string_view output);
+
   friend class CompileContext;
 
   // Shared pointer to the compiler context (keeps library loaded).
@@ -241,8 +372,8 @@ private:
   // IREE compiler session.
   iree_compiler_session_t *session_ = nullptr;
 
-  // Backend type for this session.
-  Backend backend_;
+  // Backend type for this session, if created for one.
+  std::optional<Backend> backend_;
 
   // Store input/output paths for execute().
   std::string inputPath_;
@@ -250,6 +381,18 @@ private:
 
   // Store flags for toString() and getArgs().
   std::vector<std::string> flags_;
+
+  // Identifies `flags_` in the session pool of the context (see
+  // `CompileContext::createSession()`). Cleared when flags are added after
+  // creation, so the session is destroyed rather than reused.
+  std::string poolKey_;
+
+  // Accumulated phase times, see `getParseTime()`.
+  std::chrono::nanoseconds parseTime_{0};
+  std::chrono::nanoseconds pipelineTime_{0};
+
+  // See `setResourceLimits()`.
+  CompileResourceLimits limits_ = getCompileResourceLimits();
 };
 
 // ============================================================================
@@ -327,6 +470,11 @@ inline CompileContext::~CompileContext() {
   //
   // [1]:
   // https://github.com/iree-org/iree/blob/76fa637be19b40ec12bb0ac34e852142fb8604f5/compiler/bindings/c/iree/compiler/embedding_api.h#L74-L77
+  if (ireeCompilerSessionDestroy_) {
+    for (auto &[key, session] : idleSessions_)
+      ireeCompilerSessionDestroy_(session);
+  }
+  idleSessions_.clear();
   if (lib_.isLoaded()) {
     auto err = lib_.close();
     assert(isOk(err) &&
@@ -359,8 +507,11 @@ inline ErrorObject CompileContext::loadSymbols() noexcept {
   LOAD_SYMBOL(ireeCompilerInvocationParseSource);
   LOAD_SYMBOL(ireeCompilerInvocationPipeline);
   LOAD_SYMBOL(ireeCompilerSourceOpenFile);
+  LOAD_SYMBOL(ireeCompilerSourceWrapBuffer);
   LOAD_SYMBOL(ireeCompilerSourceDestroy);
   LOAD_SYMBOL(ireeCompilerOutputOpenFile);
+  LOAD_SYMBOL(ireeCompilerOutputOpenMembuffer);
+  LOAD_SYMBOL(ireeCompilerOutputMapMemory);
   LOAD_SYMBOL(ireeCompilerOutputDestroy);
   LOAD_SYMBOL(ireeCompilerOutputKeep);
   LOAD_SYMBOL(ireeCompilerInvocationOutputVMBytecode);
@@ -370,9 +521,47 @@ inline ErrorObject CompileContext::loadSymbols() noexcept {
   return ok();
 }
 
-inline ErrorOr<CompileSession> CompileContext::createSession(Backend backend) {
+inline ErrorOr<CompileSession>
+CompileContext::createSession(Backend backend, const CompileOptions &options,
+                              std::span<const std::string> extraFlags) {
+  // Get backend-specific flags.
+  std::vector<std::string> flags = options.resolveFlags(backend);
+  flags.insert(flags.end(), extraFlags.begin(), extraFlags.end());
+  std::string key = getPoolKey(backend, flags);
+  return createSession(backend, std::move(flags), std::move(key));
+}
+
+inline ErrorOr<CompileSession>
+CompileContext::createSession(std::span<const std::string> flags) {
+  return createSession(std::nullopt,
+                       std::vector<std::string>(flags.begin(), flags.end()),
+                       getPoolKey(std::nullopt, flags));
+}
+
+inline std::string
+CompileContext::getPoolKey(std::optional<Backend> backend,
+                           std::span<const std::string> flags) {
+  std::string key = backend.has_value() ? kBackendToStr.at(*backend) : "";
+  for (const auto &flag : flags)
+    key += "\n" + flag;
+  return key;
+}
+
+inline ErrorOr<CompileSession>
+CompileContext::createSession(std::optional<Backend> backend,
+                              std::vector<std::string> flags,
+                              std::string key) {
   FUSILLI_LOG_LABEL_ENDL("INFO: Creating compiler session");
 
+  // Reuse an idle session with the same flags.
+  if (iree_compiler_session_t *session = acquireIdleSession(key)) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Reusing pooled compiler session");
+    CompileSession compileSession(this, session, backend);
+    compileSession.flags_ = std::move(flags);
+    compileSession.poolKey_ = std::move(key);
+    return ok(std::move(compileSession));
+  }
+
   // Create a new IREE compiler session.
   iree_compiler_session_t *session = ireeCompilerSessionCreate_();
   if (!session) {
@@ -383,13 +572,47 @@ inline ErrorOr<CompileSession> CompileContext::createSession(Backend backend) {
   // Create the CompileSession object.
   CompileSession compileSession(this, session, backend);
 
-  // Get backend-specific flags and apply them.
-  auto flags = getBackendFlags(backend);
+  // Apply the flags.
   FUSILLI_CHECK_ERROR(compileSession.addFlags(flags));
+  compileSession.poolKey_ = std::move(key);
 
   return ok(std::move(compileSession));
 }
 
+inline size_t CompileContext::getIdleSessionCount() const {
+  std::lock_guard<std::mutex> lock(sessionPoolMutex_);
+  return idleSessions_.size();
+}
+
+inline iree_compiler_session_t *
+CompileContext::acquireIdleSession(const std::string &key) {
+  std::lock_guard<std::mutex> lock(sessionPoolMutex_);
+  // Prefer the most recently released session.
+  for (auto it = idleSessions_.rbegin(); it != idleSessions_.rend(); ++it) {
+    if (it->first != key)
+      continue;
+    iree_compiler_session_t *session = it->second;
+    idleSessions_.erase(std::next(it).base());
+    return session;
+  }
+  return nullptr;
+}
+
+inline void CompileContext::releaseSession(std::string key,
+                                           iree_compiler_session_t *session) {
+  iree_compiler_session_t *evicted = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(sessionPoolMutex_);
+    idleSessions_.emplace_back(std::move(key), session);
+    if (idleSessions_.size() > kMaxIdleSessions) {
+      evicted = idleSessions_.front().second;
+      idleSessions_.pop_front();
+    }
+  }
+  if (evicted)
+    ireeCompilerSessionDestroy_(evicted);
+}
+
 inline int CompileContext::getAPIVersion() const {
   return ireeCompilerGetAPIVersion_();
 }
@@ -405,14 +628,16 @@ inline std::string CompileContext::getRevision() const {
 
 inline CompileSession::CompileSession(CompileContext *context,
                                       iree_compiler_session_t *session,
-                                      Backend backend)
+                                      std::optional<Backend> backend)
     : context_(context), session_(session), backend_(backend) {}
 
 inline CompileSession::CompileSession(CompileSession &&other) noexcept
     : context_(other.context_), session_(other.session_),
       backend_(other.backend_), inputPath_(std::move(other.inputPath_)),
       outputPath_(std::move(other.outputPath_)),
-      flags_(std::move(other.flags_)) {
+      flags_(std::move(other.flags_)), poolKey_(std::move(other.poolKey_)),
+      parseTime_(other.parseTime_), pipelineTime_(other.pipelineTime_),
+      limits_(std::move(other.limits_)) {
   other.session_ = nullptr;
 }
 
@@ -420,9 +645,7 @@ inline CompileSession &
 CompileSession::operator=(CompileSession &&other) noexcept {
   if (this != &other) {
     // Clean up current session.
-    if (session_ && context_) {
-      context_->ireeCompilerSessionDestroy_(session_);
-    }
+    releaseSession();
 
     // Move from other.
     context_ = other.context_;
@@ -431,6 +654,10 @@ CompileSession::operator=(CompileSession &&other) noexcept {
     inputPath_ = std::move(other.inputPath_);
     outputPath_ = std::move(other.outputPath_);
     flags_ = std::move(other.flags_);
+    poolKey_ = std::move(other.poolKey_);
+    parseTime_ = other.parseTime_;
+    pipelineTime_ = other.pipelineTime_;
+    limits_ = std::move(other.limits_);
 
     // Clear the other object's state.
     other.session_ = nullptr;
@@ -438,10 +665,16 @@ CompileSession::operator=(CompileSession &&other) noexcept {
   return *this;
 }
 
-inline CompileSession::~CompileSession() {
-  if (session_ && context_) {
+inline CompileSession::~CompileSession() { releaseSession(); }
+
+inline void CompileSession::releaseSession() {
+  if (!session_ || !context_)
+    return;
+  if (poolKey_.empty())
     context_->ireeCompilerSessionDestroy_(session_);
-  }
+  else
+    context_->releaseSession(std::move(poolKey_), session_);
+  session_ = nullptr;
 }
 
 inline void CompileSession::destroyError(iree_compiler_error_t *error) {
@@ -475,6 +708,9 @@ inline ErrorObject CompileSession::addFlag(const std::string &flag) {
   // Store flag for toString() and getArgs().
   flags_.push_back(flag);
 
+  // The session no longer matches the flags it was pooled under.
+  poolKey_.clear();
+
   return ok();
 }
 
@@ -486,32 +722,48 @@ CompileSession::addFlags(std::span<const std::string> flags) {
   return ok();
 }
 
-inline ErrorObject CompileSession::compile(std::string_view input,
-                                           std::string_view output) {
-  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling " << input << " to " << output);
+inline ErrorObject
+CompileSession::setStatisticsFile(const std::filesystem::path &path) {
+  std::string flag = std::string(kStatisticsFileFlag) + "=" + path.string();
+  FUSILLI_LOG_LABEL_ENDL("INFO: Setting compiler statistics file: " << path);
+
+  const char *flagPtr = flag.c_str();
+  iree_compiler_error_t *error =
+      context_->ireeCompilerSessionSetFlags_(session_, 1, &flagPtr);
+  if (error) {
+    std::string errMsg = getErrorMessage(error);
+    destroyError(error);
+    return fusilli::error(ErrorCode::CompileFailure,
+                          "Failed to set flag: " + errMsg);
+  }
+
+  // Replaces the path of a previous call in toString() and getArgs().
+  std::erase_if(flags_, [](const std::string &existing) { // C++20
+    return existing.starts_with(kStatisticsFileFlag);
+  });
+  flags_.push_back(std::move(flag));
 
+  // Only sessions pooled for per-compile paths may carry a stale one.
+  if (!poolKey_.ends_with(kPerCompileStatisticsKey))
+    poolKey_.clear();
+  return ok();
+}
+
+inline ErrorOr<iree_compiler_invocation_t *>
+CompileSession::parseAndRunPipeline(iree_compiler_source_t *source) {
   // Create a new invocation.
   iree_compiler_invocation_t *inv =
       context_->ireeCompilerInvocationCreate_(session_);
   if (!inv) {
+    context_->ireeCompilerSourceDestroy_(source);
     return fusilli::error(ErrorCode::CompileFailure,
                           "Failed to create compiler invocation");
   }
 
-  // Open the source file.
-  iree_compiler_source_t *source = nullptr;
-  iree_compiler_error_t *error =
-      context_->ireeCompilerSourceOpenFile_(session_, input.data(), &source);
-  if (error) {
-    std::string errMsg = getErrorMessage(error);
-    destroyError(error);
-    context_->ireeCompilerInvocationDestroy_(inv);
-    return fusilli::error(ErrorCode::CompileFailure,
-                          "Failed to open source file: " + errMsg);
-  }
-
   // Parse the source.
+  detail::PhaseTimer parseTimer(&parseTime_);
   bool parseSuccess = context_->ireeCompilerInvocationParseSource_(inv, source);
+  parseTimer.stop();
   context_->ireeCompilerSourceDestroy_(source);
 
   if (!parseSuccess) {
@@ -521,17 +773,80 @@ inline ErrorObject CompileSession::compile(std::string_view input,
   }
 
   // Run the standard compilation pipeline.
+  detail::PhaseTimer pipelineTimer(&pipelineTime_);
   bool pipelineSuccess = context_->ireeCompilerInvocationPipeline_(
       inv, IREE_COMPILER_PIPELINE_STD);
+  pipelineTimer.stop();
   if (!pipelineSuccess) {
     context_->ireeCompilerInvocationDestroy_(inv);
     return fusilli::error(ErrorCode::CompileFailure,
                           "Compilation pipeline failed");
   }
+  return ok(inv);
+}
 
+inline ErrorObject CompileSession::compile(std::string_view input,
+                                           std::string_view output) {
+  FUSILLI_TRACE_ZONE("fusilli::CompileSession::compile");
+  FUSILLI_TRACE_ZONE_TEXT(input);
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling " << input << " to " << output);
+
+  return runWithCompileResourceLimits(limits_, [&]() -> ErrorObject {
+    // Open the source file.
+    iree_compiler_source_t *source = nullptr;
+    iree_compiler_error_t *error =
+        context_->ireeCompilerSourceOpenFile_(session_, input.data(), &source);
+    if (error) {
+      std::string errMsg = getErrorMessage(error);
+      destroyError(error);
+      return fusilli::error(ErrorCode::CompileFailure,
+                            "Failed to open source file: " + errMsg);
+    }
+
+    FUSILLI_ASSIGN_OR_RETURN(iree_compiler_invocation_t * inv,
+                             parseAndRunPipeline(source));
+    return outputToFile(inv, output);
+  });
+}
+
+inline ErrorObject CompileSession::compileSource(const std::string &source,
+                                                 std::string_view output) {
+  FUSILLI_TRACE_ZONE("fusilli::CompileSession::compileSource");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling in-memory source to " << output);
+
+  return runWithCompileResourceLimits(limits_, [&]() -> ErrorObject {
+    FUSILLI_ASSIGN_OR_RETURN(iree_compiler_source_t * sourceHandle,
+                             wrapSource(source));
+    FUSILLI_ASSIGN_OR_RETURN(iree_compiler_invocation_t * inv,
+                             parseAndRunPipeline(sourceHandle));
+    return outputToFile(inv, output);
+  });
+}
+
+inline ErrorOr<iree_compiler_source_t *>
+CompileSession::wrapSource(const std::string &source) {
+  // Text sources must be null terminated, with the terminator accounted for
+  // in the length.
+  iree_compiler_source_t *sourceHandle = nullptr;
+  iree_compiler_error_t *error = context_->ireeCompilerSourceWrapBuffer_(
+      session_, "fusilli_graph.mlir", source.c_str(), source.size() + 1,
+      /*isNullTerminated=*/true, &sourceHandle);
+  if (error) {
+    std::string errMsg = getErrorMessage(error);
+    destroyError(error);
+    return fusilli::error(ErrorCode::CompileFailure,
+                          "Failed to wrap source buffer: " + errMsg);
+  }
+  return ok(sourceHandle);
+}
+
+inline ErrorObject
+CompileSession::outputToFile(iree_compiler_invocation_t *inv,
+                             std::string_view output) {
   // Open the output file.
   iree_compiler_output_t *outputHandle = nullptr;
-  error = context_->ireeCompilerOutputOpenFile_(output.data(), &outputHandle);
+  iree_compiler_error_t *error =
+      context_->ireeCompilerOutputOpenFile_(output.data(), &outputHandle);
   if (error) {
     std::string errMsg = getErrorMessage(error);
     destroyError(error);
@@ -541,7 +856,9 @@ inline ErrorObject CompileSession::compile(std::string_view input,
   }
 
   // Output VM bytecode.
+  detail::PhaseTimer outputTimer(&pipelineTime_);
   error = context_->ireeCompilerInvocationOutputVMBytecode_(inv, outputHandle);
+  outputTimer.stop();
 
   // Specify that the written file should be kept after destroying the output
   context_->ireeCompilerOutputKeep_(outputHandle);
@@ -569,26 +886,91 @@ inline ErrorObject CompileSession::compile(std::string_view input,
   return ok();
 }
 
+inline ErrorOr<std::vector<uint8_t>>
+CompileSession::compileToMemory(const std::string &source) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling in-memory source");
+  return runWithCompileResourceLimits(
+      limits_, [&] { return compileToMemoryImpl(source); });
+}
+
+inline ErrorOr<std::vector<uint8_t>>
+CompileSession::compileToMemoryImpl(const std::string &source) {
+  FUSILLI_ASSIGN_OR_RETURN(iree_compiler_source_t * sourceHandle,
+                           wrapSource(source));
+  FUSILLI_ASSIGN_OR_RETURN(iree_compiler_invocation_t * inv,
+                           parseAndRunPipeline(sourceHandle));
+
+  // Open an in-memory output.
+  iree_compiler_output_t *outputHandle = nullptr;
+  iree_compiler_error_t *error =
+      context_->ireeCompilerOutputOpenMembuffer_(&outputHandle);
+  if (error) {
+    std::string errMsg = getErrorMessage(error);
+    destroyError(error);
+    context_->ireeCompilerInvocationDestroy_(inv);
+    return fusilli::error(ErrorCode::CompileFailure,
+                          "Failed to open output buffer: " + errMsg);
+  }
+
+  // Output VM bytecode and copy it out before the output is destroyed.
+  std::vector<uint8_t> bytes;
+  detail::PhaseTimer outputTimer(&pipelineTime_);
+  error = context_->ireeCompilerInvocationOutputVMBytecode_(inv, outputHandle);
+  outputTimer.stop();
+  if (!error) {
+    void *contents = nullptr;
+    uint64_t size = 0;
+    error =
+        context_->ireeCompilerOutputMapMemory_(outputHandle, &contents, &size);
+    if (!error) {
+      const auto *data = static_cast<const uint8_t *>(contents);
+      bytes.assign(data, data + size);
+    }
+  }
+
+  context_->ireeCompilerOutputDestroy_(outputHandle);
+  context_->ireeCompilerInvocationDestroy_(inv);
+
+  if (error) {
+    std::string errMsg = getErrorMessage(error);
+    destroyError(error);
+    return fusilli::error(ErrorCode::CompileFailure,
+                          "Failed to output VM bytecode: " + errMsg);
+  }
+  if (bytes.empty()) {
+    return fusilli::error(ErrorCode::CompileFailure,
+                          "Compiled output buffer is empty");
+  }
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compilation successful");
+  return ok(std::move(bytes));
+}
+
 // ----------------------------------------------------------------------------
 // Interface that matches the build behavior of CompileCommand
 // ----------------------------------------------------------------------------
 
 inline ErrorOr<CompileSession>
 CompileSession::build(Backend backend, const CacheFile &input,
-                      const CacheFile &output, const CacheFile &statistics) {
+                      const CacheFile &output, const CacheFile &statistics,
+                      const CompileOptions &options) {
   FUSILLI_LOG_LABEL_ENDL("INFO: Building compile session");
 
   // Create compiler context.
   FUSILLI_ASSIGN_OR_RETURN(auto *context, CompileContext::create());
 
-  // Create session with backend-specific flags.
-  FUSILLI_ASSIGN_OR_RETURN(auto session, context->createSession(backend));
-
-  // Add statistics flags (matching CompileCommand behavior).
-  FUSILLI_CHECK_ERROR(
-      session.addFlag("--iree-scheduling-dump-statistics-format=json"));
-  FUSILLI_CHECK_ERROR(session.addFlag(
-      "--iree-scheduling-dump-statistics-file=" + statistics.path.string()));
+  // Create session with backend-specific flags and statistics flags
+  // (matching CompileCommand behavior). The statistics file is in the cache
+  // directory of the graph, so it is set per compile rather than keying the
+  // pooled session to a single graph.
+  std::vector<std::string> flags = options.resolveFlags(backend);
+  flags.push_back("--iree-scheduling-dump-statistics-format=json");
+  std::string key = CompileContext::getPoolKey(backend, flags) +
+                    std::string(kPerCompileStatisticsKey);
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto session,
+      context->createSession(backend, std::move(flags), std::move(key)));
+  FUSILLI_CHECK_ERROR(session.setStatisticsFile(statistics.path));
 
   // Store paths for later execution.
   session.inputPath_ = input.path.string();
@@ -0,0 +1,100 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains CompileStatistics, the parsed form of the scheduling
+// statistics the IREE compiler dumps for every compilation (see the
+// `--iree-scheduling-dump-statistics-*` flags set by `CompileCommand` and
+// `CompileSession`).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_COMPILE_STATISTICS_H
+#define FUSILLI_BACKEND_COMPILE_STATISTICS_H
+
+#include "fusilli/support/logging.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace fusilli {
+
+// Scheduling statistics of a compiled graph, e.g. to flag graphs whose
+// dispatch count or transient memory use grew between compiler versions.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(CompileStatistics stats,
+//                            graph.getCompileStatistics());
+//   if (stats.dispatchCount > 1) ...
+struct CompileStatistics {
+  // Number of dispatches launched by one execution of the graph.
+  uint64_t dispatchCount = 0;
+
+  // Number of executables the dispatches are compiled into.
+  uint64_t executableCount = 0;
+
+  // Size in bytes of the transient memory (scratch space between dispatches)
+  // required by one execution of the graph.
+  uint64_t transientMemorySize = 0;
+
+  // Parses the JSON statistics dump of the IREE compiler. Only the counters
+  // above are extracted; fields missing from the dump (e.g. with older
+  // compilers) are left at 0, except `dispatch-count` which is required.
+  static ErrorOr<CompileStatistics> parse(std::string_view json) {
+    std::optional<uint64_t> dispatchCount = findCounter(json, "dispatch-count");
+    FUSILLI_RETURN_ERROR_IF(!dispatchCount.has_value(),
+                            ErrorCode::InvalidArgument,
+                            "Compile statistics lack \"dispatch-count\"");
+    CompileStatistics stats;
+    stats.dispatchCount = *dispatchCount;
+    stats.executableCount = findCounter(json, "executable-count").value_or(0);
+    stats.transientMemorySize =
+        findCounter(json, "transient-memory-size").value_or(0);
+    return ok(stats);
+  }
+
+  bool operator==(const CompileStatistics &) const = default; // C++20
+
+private:
+  // Returns the integer value of the first `"key": <value>` member in the
+  // statistics dump. The dump is a small, compiler generated document, so a
+  // scan for the member is sufficient and avoids a JSON dependency.
+  static std::optional<uint64_t> findCounter(std::string_view json,
+                                             std::string_view key) {
+    std::string quoted = "\"" + std::string(key) + "\"";
+    for (size_t pos = json.find(quoted); pos != std::string_view::npos;
+         pos = json.find(quoted, pos + 1)) {
+      size_t i = pos + quoted.size();
+      auto skipSpace = [&]() {
+        while (i < json.size() &&
+               std::isspace(static_cast<unsigned char>(json[i])))
+          ++i;
+      };
+      skipSpace();
+      if (i >= json.size() || json[i] != ':')
+        continue;
+      ++i;
+      skipSpace();
+      uint64_t value = 0;
+      auto [ptr, errc] =
+          std::from_chars(json.data() + i, json.data() + json.size(), value);
+      if (errc == std::errc())
+        return value;
+    }
+    return std::nullopt;
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_COMPILE_STATISTICS_H
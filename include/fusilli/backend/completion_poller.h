@@ -0,0 +1,194 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains CompletionPoller, which calls completion callbacks of
+// asynchronous work (see `Graph::executeAsync()`) from a single thread once
+// their fences are signaled.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_COMPLETION_POLLER_H
+#define FUSILLI_BACKEND_COMPLETION_POLLER_H
+
+#include "fusilli/backend/fence.h"
+#include "fusilli/support/logging.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Options of a `CompletionPoller`.
+struct CompletionPollerOptions {
+  // How long the poller blocks on the oldest pending fence before checking
+  // the others again. Bounds the latency added to the callback of work
+  // completing out of order.
+  std::chrono::microseconds pollInterval{200};
+};
+
+// CompletionPoller tracks any number of in-flight asynchronous executions
+// with one thread, so event-driven servers don't block a thread per request
+// in `Fence::wait()` or `Buffer::read()`. Each fence registered with
+// `notify()` has its callback called, with the status of the work, from the
+// poller thread once the fence is signaled (or failed).
+//
+// The poller thread blocks on the oldest pending fence, as executions on a
+// queue mostly complete in order, and checks the other fences without
+// blocking every `pollInterval`. Callbacks run on the poller thread in
+// completion order: they should hand their work off (e.g. to an event loop)
+// rather than block, as they delay the callbacks of later completions.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(auto poller, CompletionPoller::create());
+//   // Per request:
+//   FUSILLI_CHECK_ERROR(graph.executeAsync(
+//       handle, variantPack, workspace, Fence(), *poller,
+//       [request](ErrorObject status) { request->respond(status); }));
+class CompletionPoller {
+public:
+  // Called once with the status of the work: ok, or the error the fence
+  // failed with.
+  using Callback = std::function<void(ErrorObject)>;
+
+  static ErrorOr<std::unique_ptr<CompletionPoller>>
+  create(const CompletionPollerOptions &options = {}) {
+    FUSILLI_RETURN_ERROR_IF(options.pollInterval.count() <= 0,
+                            ErrorCode::InvalidArgument,
+                            "CompletionPoller requires a positive poll "
+                            "interval");
+    std::unique_ptr<CompletionPoller> poller(new CompletionPoller(options));
+    poller->worker_ = std::thread([raw = poller.get()] { raw->run(); });
+    return ok(std::move(poller));
+  }
+
+  // Calls `onComplete` from the poller thread once `fence` is signaled. An
+  // empty fence is signaled already, and completes on the next poll.
+  ErrorObject notify(Fence fence, Callback onComplete) {
+    FUSILLI_RETURN_ERROR_IF(!onComplete, ErrorCode::InvalidArgument,
+                            "CompletionPoller callback is empty");
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      FUSILLI_RETURN_ERROR_IF(stopping_, ErrorCode::RuntimeFailure,
+                              "CompletionPoller is stopping");
+      registered_.push_back({std::move(fence), std::move(onComplete)});
+      pendingCount_++;
+    }
+    cv_.notify_one();
+    return ok();
+  }
+
+  // Number of registered fences whose callbacks weren't called yet.
+  size_t getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pendingCount_;
+  }
+
+  // Number of callbacks called.
+  uint64_t getCompletedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completedCount_;
+  }
+
+  const CompletionPollerOptions &getOptions() const { return options_; }
+
+  // Delete copy and move constructors, the worker thread refers to `this`.
+  CompletionPoller(const CompletionPoller &) = delete;
+  CompletionPoller &operator=(const CompletionPoller &) = delete;
+  CompletionPoller(CompletionPoller &&) = delete;
+  CompletionPoller &operator=(CompletionPoller &&) = delete;
+
+  // Waits for all registered fences and calls their callbacks, then joins
+  // the worker thread.
+  ~CompletionPoller() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable())
+      worker_.join();
+  }
+
+private:
+  struct Pending {
+    Fence fence;
+    Callback onComplete;
+  };
+
+  explicit CompletionPoller(const CompletionPollerOptions &options)
+      : options_(options) {}
+
+  // Calls the callbacks of the signaled fences of `inFlight` and removes
+  // them, keeping the others in registration order. Returns the number of
+  // callbacks called.
+  size_t complete(std::vector<Pending> &inFlight) {
+    std::vector<Pending> remaining;
+    size_t completed = 0;
+    for (Pending &pending : inFlight) {
+      ErrorOr<bool> signaled = pending.fence.isSignaled();
+      if (!isError(signaled) && !*signaled) {
+        remaining.push_back(std::move(pending));
+        continue;
+      }
+      pending.onComplete(ErrorObject(signaled));
+      completed++;
+    }
+    inFlight = std::move(remaining);
+    if (completed > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pendingCount_ -= completed;
+      completedCount_ += completed;
+    }
+    return completed;
+  }
+
+  // Body of the worker thread: takes in newly registered fences and
+  // completes the signaled ones until stopped with nothing pending.
+  void run() {
+    std::vector<Pending> inFlight;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (inFlight.empty())
+          cv_.wait(lock, [&] { return stopping_ || !registered_.empty(); });
+        if (inFlight.empty() && registered_.empty())
+          return;
+        for (Pending &pending : registered_)
+          inFlight.push_back(std::move(pending));
+        registered_.clear();
+      }
+      // Failed fences are reported to their callbacks on the next poll.
+      if (complete(inFlight) == 0 && !inFlight.empty())
+        (void)inFlight.front().fence.waitFor(options_.pollInterval);
+    }
+  }
+
+  CompletionPollerOptions options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  // Fences registered since the worker last took them in.
+  std::vector<Pending> registered_;
+  bool stopping_ = false;
+  size_t pendingCount_ = 0;
+  uint64_t completedCount_ = 0;
+
+  std::thread worker_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_COMPLETION_POLLER_H
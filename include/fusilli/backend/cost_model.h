@@ -0,0 +1,132 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains DeviceCostModel, the peak rates of a device that
+// `Graph::estimateCost()` estimates execution times from, and CostEstimate,
+// the estimate it returns.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_COST_MODEL_H
+#define FUSILLI_BACKEND_COST_MODEL_H
+
+#include "fusilli/attributes/types.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace fusilli {
+
+// Peak rates of a device, for estimating execution times analytically (see
+// `Graph::estimateCost()`). Rates are dense (i.e. without structured
+// sparsity) peaks in operations or bytes per second. Rates a device lacks
+// are left at zero, and fall back to the next wider type.
+struct DeviceCostModel {
+  // Matrix core rates, by operand type. The FP8 rate also covers int8.
+  double matrixFp8Flops = 0;
+  double matrixFp16Flops = 0; // Also covers bf16.
+  double matrixFp32Flops = 0;
+  // Rate of vector (non-matrix) FP32 operations.
+  double vectorFp32Flops = 0;
+  // Bandwidth of device memory.
+  double memoryBandwidth = 0;
+  // Fixed cost of executing a graph, e.g. dispatch launch latency.
+  std::chrono::nanoseconds launchLatency{0};
+
+  // Returns the peak rate of operations on operands of `type`, on the matrix
+  // cores if `matrix` is set, or 0 if unknown.
+  double getPeakFlops(DataType type, bool matrix) const {
+    if (!matrix)
+      return vectorFp32Flops;
+    double fp32 = matrixFp32Flops > 0 ? matrixFp32Flops : vectorFp32Flops;
+    double fp16 = matrixFp16Flops > 0 ? matrixFp16Flops : fp32;
+    if (isFloat8Type(type) || type == DataType::Int8)
+      return matrixFp8Flops > 0 ? matrixFp8Flops : fp16;
+    if (type == DataType::Half || type == DataType::BFloat16)
+      return fp16;
+    return fp32;
+  }
+};
+
+// Returns the cost model of the IREE ROCm target `target`, a SKU (e.g.
+// `mi300x`) or an architecture (e.g. `gfx942`, standing for its flagship
+// SKU) as returned by `getIreeRocmTargetForAmdgpu()`, or std::nullopt if
+// unknown. Rates are taken from the datasheets of the SKUs.
+inline std::optional<DeviceCostModel>
+getDeviceCostModel(const std::string &target) {
+  auto model = [](double fp8, double fp16, double fp32, double vectorFp32,
+                  double bandwidth) {
+    return DeviceCostModel{.matrixFp8Flops = fp8,
+                           .matrixFp16Flops = fp16,
+                           .matrixFp32Flops = fp32,
+                           .vectorFp32Flops = vectorFp32,
+                           .memoryBandwidth = bandwidth,
+                           .launchLatency = std::chrono::microseconds(5)};
+  };
+  static const std::unordered_map<std::string, DeviceCostModel> models = {
+      // CDNA4
+      {"mi355x", model(5.0e15, 2.5e15, 157.3e12, 157.3e12, 8.0e12)},
+      {"mi350x", model(4.6e15, 2.3e15, 144.2e12, 144.2e12, 8.0e12)},
+      // CDNA3
+      {"mi325x", model(2.6149e15, 1.3074e15, 163.4e12, 163.4e12, 6.0e12)},
+      {"mi300x", model(2.6149e15, 1.3074e15, 163.4e12, 163.4e12, 5.3e12)},
+      {"mi300a", model(1.9612e15, 980.6e12, 122.6e12, 122.6e12, 5.3e12)},
+      // CDNA2
+      {"mi250x", model(0, 383.0e12, 95.7e12, 47.9e12, 3.2768e12)},
+      {"mi250", model(0, 362.1e12, 90.5e12, 45.3e12, 3.2768e12)},
+      {"mi210", model(0, 181.0e12, 45.3e12, 22.6e12, 1.6384e12)},
+      // CDNA1
+      {"mi100", model(0, 184.6e12, 46.1e12, 23.1e12, 1.2288e12)},
+      // RDNA3
+      {"w7900", model(0, 122.6e12, 0, 61.3e12, 864.0e9)},
+      {"rx7900xtx", model(0, 122.8e12, 0, 61.4e12, 960.0e9)},
+  };
+  static const std::unordered_map<std::string, std::string> archSkus = {
+      {"gfx950", "mi355x"}, {"gfx942", "mi300x"},    {"gfx90a", "mi250x"},
+      {"gfx908", "mi100"},  {"gfx1100", "rx7900xtx"},
+  };
+  auto arch = archSkus.find(target);
+  auto it = models.find(arch == archSkus.end() ? target : arch->second);
+  if (it == models.end())
+    return std::nullopt;
+  return it->second;
+}
+
+// Analytic estimate of the cost of executing a graph, see
+// `Graph::estimateCost()`.
+struct CostEstimate {
+  // Floating point (or integer) operations of the nodes of the graph.
+  double flops = 0;
+  // Bytes of the graph inputs and outputs, i.e. the least memory traffic of
+  // an execution, assuming every intermediate tensor stays on chip.
+  int64_t bytes = 0;
+  // Execution time estimated from the above and the peak rates of the
+  // device: the slower of computing and moving memory at peak, plus the
+  // launch latency. A lower bound in practice.
+  std::chrono::nanoseconds time{0};
+  // Execution time measured by `fusilli::autotune()` for the graph, when
+  // estimating for a `Handle` the graph was autotuned on.
+  std::optional<std::chrono::nanoseconds> measuredTime;
+
+  // Returns the measured time if any, and the estimated time otherwise.
+  std::chrono::nanoseconds getTime() const {
+    return measuredTime.value_or(time);
+  }
+
+  // Returns the ratio of operations to bytes moved, or 0 without bytes.
+  double getArithmeticIntensity() const {
+    return bytes > 0 ? flops / static_cast<double>(bytes) : 0;
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_COST_MODEL_H
@@ -0,0 +1,64 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains CpuOptions, the execution configuration of CPU handles
+// created with `Handle::create(Backend::CPU, CpuOptions{...})`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_CPU_OPTIONS_H
+#define FUSILLI_BACKEND_CPU_OPTIONS_H
+
+#include <cstdint>
+#include <optional>
+
+namespace fusilli {
+
+// How a CPU handle executes dispatches: the topology of the worker threads
+// of its task executor, or inline on the calling thread. By default, the IREE
+// task executor of a CPU handle spans the physical cores of the host, which
+// on multi-socket hosts crosses NUMA nodes. Restricting each handle to the
+// cores of one node keeps its workers and their memory local, so several
+// handles can partition a host, e.g. one per socket:
+//
+//   FUSILLI_ASSIGN_OR_RETURN(
+//       Handle socket0,
+//       Handle::create(Backend::CPU, CpuOptions{.numaNode = 0}));
+//   FUSILLI_ASSIGN_OR_RETURN(
+//       Handle socket1,
+//       Handle::create(Backend::CPU, CpuOptions{.numaNode = 1}));
+struct CpuOptions {
+  // Number of worker threads, at most one per physical core of the selected
+  // NUMA node. 0 uses all of its physical cores.
+  uint32_t threads = 0;
+
+  // NUMA node whose physical cores run the worker threads. When unset, the
+  // workers use the cores of node 0.
+  std::optional<uint32_t> numaNode;
+
+  // Whether to pin each worker thread to its core. Unpinned workers may be
+  // migrated by the OS scheduler, including to other NUMA nodes.
+  bool pinThreads = true;
+
+  // Whether to execute dispatches inline on the thread calling
+  // `Graph::execute()` (IREE's `local-sync` driver) instead of on a task
+  // executor. This avoids the hand-off and worker wake-up latency of the
+  // executor, which dominates for tiny graphs (e.g. small pointwise and
+  // normalization graphs), at the cost of running single-threaded. The
+  // worker topology options above do not apply and must be left unset.
+  bool inlineExecution = false;
+
+  // Returns whether the options configure a worker topology other than the
+  // default one of the `local-task` device (configurable with IREE's task
+  // flags).
+  bool hasTopology() const { return threads != 0 || numaNode || !pinThreads; }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_CPU_OPTIONS_H
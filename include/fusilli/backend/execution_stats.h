@@ -0,0 +1,152 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the always-on execution counters of a Fusilli handle
+// (see `Handle::getExecutionStats()`): executions and their host overhead,
+// compilations and cache hits, and bytes transferred through buffers.
+//
+// Unlike trace zones (see `fusilli/support/tracing.h`), the counters are
+// always compiled in and cheap enough for production: an execution adds two
+// clock reads and a few relaxed atomic increments.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_EXECUTION_STATS_H
+#define FUSILLI_BACKEND_EXECUTION_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace fusilli {
+
+// Cumulative counts of the work done through a handle and its queues since
+// it was created or `Handle::resetExecutionStats()` was last called.
+struct ExecutionStats {
+  // Graph executions (`Graph::execute()`, `Graph::executeTimed()`,
+  // `Graph::executeAsync()` and `ExecutionPlan::run()`), and the host time
+  // spent in them: checking arguments, building the argument list and
+  // enqueuing the work, plus the work itself on synchronous backends (CPU).
+  uint64_t executes = 0;
+  uint64_t executeHostNs = 0;
+
+  // Successful `Graph::compile()` calls, split by whether the graph's
+  // artifact was found in the cache, and their wall time.
+  uint64_t compiles = 0;
+  uint64_t cacheHits = 0;
+  uint64_t cacheMisses = 0;
+  uint64_t compileNs = 0;
+
+  // Bytes uploaded by `Buffer::allocate()` and read back by `Buffer::read()`
+  // and `Buffer::readBytes()`.
+  uint64_t bytesUploaded = 0;
+  uint64_t bytesRead = 0;
+};
+
+namespace detail {
+
+// Counters behind `ExecutionStats`, shared by the queues of a handle. Updates
+// are relaxed: each counter is exact, but a snapshot taken while other
+// threads execute may mix counts from before and after one execution.
+class ExecutionCounters {
+public:
+  void recordExecute(uint64_t hostNs) {
+    executes_.fetch_add(1, std::memory_order_relaxed);
+    executeHostNs_.fetch_add(hostNs, std::memory_order_relaxed);
+  }
+
+  void recordCompile(bool cacheHit, uint64_t ns) {
+    compiles_.fetch_add(1, std::memory_order_relaxed);
+    (cacheHit ? cacheHits_ : cacheMisses_)
+        .fetch_add(1, std::memory_order_relaxed);
+    compileNs_.fetch_add(ns, std::memory_order_relaxed);
+  }
+
+  void recordUpload(uint64_t bytes) {
+    bytesUploaded_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void recordRead(uint64_t bytes) {
+    bytesRead_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  ExecutionStats getStats() const {
+    return {
+        .executes = executes_.load(std::memory_order_relaxed),
+        .executeHostNs = executeHostNs_.load(std::memory_order_relaxed),
+        .compiles = compiles_.load(std::memory_order_relaxed),
+        .cacheHits = cacheHits_.load(std::memory_order_relaxed),
+        .cacheMisses = cacheMisses_.load(std::memory_order_relaxed),
+        .compileNs = compileNs_.load(std::memory_order_relaxed),
+        .bytesUploaded = bytesUploaded_.load(std::memory_order_relaxed),
+        .bytesRead = bytesRead_.load(std::memory_order_relaxed),
+    };
+  }
+
+  void reset() {
+    for (std::atomic<uint64_t> *counter :
+         {&executes_, &executeHostNs_, &compiles_, &cacheHits_, &cacheMisses_,
+          &compileNs_, &bytesUploaded_, &bytesRead_})
+      counter->store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> executes_{0};
+  std::atomic<uint64_t> executeHostNs_{0};
+  std::atomic<uint64_t> compiles_{0};
+  std::atomic<uint64_t> cacheHits_{0};
+  std::atomic<uint64_t> cacheMisses_{0};
+  std::atomic<uint64_t> compileNs_{0};
+  std::atomic<uint64_t> bytesUploaded_{0};
+  std::atomic<uint64_t> bytesRead_{0};
+};
+
+// Counts one execution, in `counters` and in the executed graph's
+// `executeCount`, with the host time until the end of the scope. Executions
+// entered from another one on the same thread (e.g. of a static
+// specialization, or by `Graph::executeTimed()`) are only counted once, by
+// the outermost scope.
+class ExecuteScope {
+public:
+  ExecuteScope(ExecutionCounters &counters,
+               std::atomic<uint64_t> &executeCount)
+      : counters_(nesting() == 0 ? &counters : nullptr) {
+    ++nesting();
+    if (counters_) {
+      executeCount.fetch_add(1, std::memory_order_relaxed);
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ExecuteScope() {
+    --nesting();
+    if (counters_)
+      counters_->recordExecute(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start_)
+              .count()));
+  }
+
+  ExecuteScope(const ExecuteScope &) = delete;
+  ExecuteScope &operator=(const ExecuteScope &) = delete;
+
+private:
+  static int &nesting() {
+    thread_local int depth = 0;
+    return depth;
+  }
+
+  ExecutionCounters *counters_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace detail
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_EXECUTION_STATS_H
@@ -0,0 +1,164 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains ExecutionTiming, the device time measurement returned by
+// `Graph::executeTimed()`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_EXECUTION_TIMING_H
+#define FUSILLI_BACKEND_EXECUTION_TIMING_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/support/hip_runtime.h"
+#include "fusilli/support/logging.h"
+
+#include <chrono>
+#include <utility>
+
+namespace fusilli {
+
+// ExecutionTiming measures the device time of one graph execution. On AMDGPU
+// handles, HIP events are recorded on the stream of the queue before and
+// after the invocation, so the measurement covers the kernels of the graph
+// (and any work queued between them by other threads on that stream) without
+// synchronizing with the host. Backends executing synchronously (CPU) measure
+// the host time of the invocation instead.
+//
+// The elapsed time becomes available once the execution completes on the
+// device: `isReady()` polls for it without blocking, so production code can
+// collect timings of past executions from a monitoring thread.
+// Destroying a pending timing does not wait for the execution.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(ExecutionTiming timing,
+//                            graph.executeTimed(handle, variantPack, ws));
+//   ... // enqueue more work
+//   FUSILLI_ASSIGN_OR_RETURN(bool ready, timing.isReady());
+//   if (ready) {
+//     FUSILLI_ASSIGN_OR_RETURN(float ms, timing.getElapsedMilliseconds());
+//     ...
+//   }
+class ExecutionTiming {
+public:
+  // Returns whether the timed execution completed on the device, without
+  // blocking.
+  ErrorOr<bool> isReady() const {
+    if (!end_)
+      return ok(true);
+    detail::HipApi::hipError_t err = hip_->hipEventQuery(end_);
+    if (err == detail::HipApi::hipErrorNotReady)
+      return ok(false);
+    FUSILLI_CHECK_ERROR(hip_->check(err, "hipEventQuery"));
+    return ok(true);
+  }
+
+  // Returns the device time of the execution in milliseconds, blocking until
+  // the execution completes if it is still pending (see `isReady()`).
+  ErrorOr<float> getElapsedMilliseconds() const {
+    if (!end_)
+      return ok(hostMilliseconds_);
+    FUSILLI_CHECK_ERROR(
+        hip_->check(hip_->hipEventSynchronize(end_), "hipEventSynchronize"));
+    float milliseconds = 0.0f;
+    FUSILLI_CHECK_ERROR(
+        hip_->check(hip_->hipEventElapsedTime(&milliseconds, start_, end_),
+                    "hipEventElapsedTime"));
+    return ok(milliseconds);
+  }
+
+  // Delete copy constructors, keep move constructors and destructor.
+  ExecutionTiming(const ExecutionTiming &) = delete;
+  ExecutionTiming &operator=(const ExecutionTiming &) = delete;
+  ExecutionTiming(ExecutionTiming &&other) noexcept
+      : hip_(other.hip_), stream_(other.stream_),
+        start_(std::exchange(other.start_, nullptr)),
+        end_(std::exchange(other.end_, nullptr)),
+        hostStart_(other.hostStart_),
+        hostMilliseconds_(other.hostMilliseconds_) {}
+  ExecutionTiming &operator=(ExecutionTiming &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      hip_ = other.hip_;
+      stream_ = other.stream_;
+      start_ = std::exchange(other.start_, nullptr);
+      end_ = std::exchange(other.end_, nullptr);
+      hostStart_ = other.hostStart_;
+      hostMilliseconds_ = other.hostMilliseconds_;
+    }
+    return *this;
+  }
+  ~ExecutionTiming() { destroy(); }
+
+private:
+  // Class should be constructed through `Graph::executeTimed()`.
+  friend class Graph;
+
+  ExecutionTiming() = default;
+
+  // Factory: Starts timing the work queued next on `handle`, which must be
+  // the (single-queue) handle of the queue the graph executes on.
+  static ErrorOr<ExecutionTiming> start(const Handle &handle) {
+    ExecutionTiming timing;
+    if (!kBackendExecuteAsync.at(handle.getBackend())) {
+      timing.hostStart_ = std::chrono::steady_clock::now();
+      return ok(std::move(timing));
+    }
+    // The null stream is not the stream IREE queues the work on.
+    FUSILLI_RETURN_ERROR_IF(handle.getStream() == 0,
+                            ErrorCode::InvalidArgument,
+                            "Graph::executeTimed requires a handle created "
+                            "with a non-default HIP stream");
+    FUSILLI_ASSIGN_OR_RETURN(timing.hip_, detail::getHipApi());
+    timing.stream_ =
+        reinterpret_cast<detail::HipApi::hipStream_t>(handle.getStream());
+    FUSILLI_CHECK_ERROR(timing.hip_->check(
+        timing.hip_->hipEventCreate(&timing.start_), "hipEventCreate"));
+    FUSILLI_CHECK_ERROR(timing.hip_->check(
+        timing.hip_->hipEventCreate(&timing.end_), "hipEventCreate"));
+    FUSILLI_CHECK_ERROR(timing.hip_->check(
+        timing.hip_->hipEventRecord(timing.start_, timing.stream_),
+        "hipEventRecord"));
+    return ok(std::move(timing));
+  }
+
+  // Stops timing after the invocation was queued.
+  ErrorObject stop() {
+    if (!hip_) {
+      hostMilliseconds_ = std::chrono::duration<float, std::milli>(
+                              std::chrono::steady_clock::now() - hostStart_)
+                              .count();
+      return ok();
+    }
+    FUSILLI_CHECK_ERROR(
+        hip_->check(hip_->hipEventRecord(end_, stream_), "hipEventRecord"));
+    return ok();
+  }
+
+  void destroy() {
+    if (start_)
+      hip_->hipEventDestroy(start_);
+    if (end_)
+      hip_->hipEventDestroy(end_);
+    start_ = nullptr;
+    end_ = nullptr;
+  }
+
+  const detail::HipApi *hip_ = nullptr;
+  detail::HipApi::hipStream_t stream_ = nullptr;
+  detail::HipApi::hipEvent_t start_ = nullptr;
+  detail::HipApi::hipEvent_t end_ = nullptr;
+  // Host time measurement of synchronous backends.
+  std::chrono::steady_clock::time_point hostStart_;
+  float hostMilliseconds_ = 0.0f;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_EXECUTION_TIMING_H
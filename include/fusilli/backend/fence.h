@@ -0,0 +1,155 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the code to create and manage a Fusilli fence which is
+// an RAII wrapper around IREE HAL fence (a set of semaphore timepoints) for
+// proper initialization, cleanup and lifetime management.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_FENCE_H
+#define FUSILLI_BACKEND_FENCE_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/support/logging.h"
+
+#include <iree/hal/api.h>
+
+#include <chrono>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Fence orders work across queues (and the host) without synchronizing a
+// whole stream: `Graph::executeAsync()` waits on a fence before reading its
+// inputs and returns a fence signaled once its outputs are written, so
+// transfers and graphs can be pipelined by chaining fences.
+//
+// A default constructed (empty) fence is always signaled.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(Fence first,
+//                            graphA.executeAsync(handle, packA, wsA, Fence()));
+//   FUSILLI_ASSIGN_OR_RETURN(Fence second,
+//                            graphB.executeAsync(handle, packB, wsB, first));
+//   FUSILLI_CHECK_ERROR(second.wait());
+class Fence {
+public:
+  // Creates an empty (always signaled) fence.
+  Fence() = default;
+
+  // Factory: Imports an existing fence and retains ownership, e.g. one
+  // signaled by transfers the caller queued directly through IREE.
+  static ErrorOr<Fence> import(iree_hal_fence_t *externalFence) {
+    FUSILLI_RETURN_ERROR_IF(externalFence == nullptr, ErrorCode::RuntimeFailure,
+                            "Fence::import failed as externalFence* is NULL");
+    iree_hal_fence_retain(externalFence);
+    return ok(Fence(IreeHalFenceUniquePtrType(externalFence)));
+  }
+
+  // Factory: Creates an unsignaled fence on a fresh semaphore of `device`,
+  // to be signaled by queue operations through `getSemaphoreList()`.
+  static ErrorOr<Fence> create(iree_hal_device_t *device) {
+    iree_hal_semaphore_t *rawSemaphore = nullptr;
+    FUSILLI_CHECK_ERROR(iree_hal_semaphore_create(
+        device, IREE_HAL_QUEUE_AFFINITY_ANY, /*initial_value=*/0,
+        IREE_HAL_SEMAPHORE_FLAG_NONE, &rawSemaphore));
+    // A timepoint reached (0 -> 1) once the operation completes. The fence
+    // retains the semaphore.
+    iree_hal_fence_t *rawFence = nullptr;
+    iree_status_t status = iree_hal_fence_create_at(
+        rawSemaphore, /*value=*/1, iree_allocator_system(), &rawFence);
+    iree_hal_semaphore_release(rawSemaphore);
+    FUSILLI_CHECK_ERROR(status);
+    return ok(Fence(IreeHalFenceUniquePtrType(rawFence)));
+  }
+
+  // Factory: Returns a fence signaled once all of `fences` are.
+  static ErrorOr<Fence> join(std::span<const Fence *const> fences) {
+    std::vector<iree_hal_fence_t *> rawFences;
+    for (const Fence *fence : fences)
+      if (fence && fence->fence_)
+        rawFences.push_back(fence->fence_.get());
+    if (rawFences.empty())
+      return ok(Fence());
+    iree_hal_fence_t *joined = nullptr;
+    FUSILLI_CHECK_ERROR(iree_hal_fence_join(rawFences.size(), rawFences.data(),
+                                            iree_allocator_system(), &joined));
+    return ok(Fence(IreeHalFenceUniquePtrType(joined)));
+  }
+
+  // Blocks the calling thread until the fence is signaled.
+  ErrorObject wait() const {
+    if (!fence_)
+      return ok();
+    FUSILLI_CHECK_ERROR(iree_hal_fence_wait(
+        fence_.get(), iree_infinite_timeout(), IREE_HAL_WAIT_FLAG_DEFAULT));
+    return ok();
+  }
+
+  // Blocks the calling thread until the fence is signaled or `timeout` has
+  // passed, and returns whether it is signaled.
+  ErrorOr<bool> waitFor(std::chrono::nanoseconds timeout) const {
+    if (!fence_)
+      return ok(true);
+    iree_status_t status =
+        iree_hal_fence_wait(fence_.get(), iree_make_timeout_ns(timeout.count()),
+                            IREE_HAL_WAIT_FLAG_DEFAULT);
+    if (iree_status_code(status) == IREE_STATUS_DEADLINE_EXCEEDED) {
+      iree_status_ignore(status);
+      return ok(false);
+    }
+    FUSILLI_CHECK_ERROR(status);
+    return ok(true);
+  }
+
+  // Returns whether the fence is signaled, without blocking.
+  ErrorOr<bool> isSignaled() const {
+    if (!fence_)
+      return ok(true);
+    iree_status_t status = iree_hal_fence_query(fence_.get());
+    if (iree_status_code(status) == IREE_STATUS_DEFERRED) {
+      iree_status_ignore(status);
+      return ok(false);
+    }
+    FUSILLI_CHECK_ERROR(status);
+    return ok(true);
+  }
+
+  // Returns the semaphore timepoints of the fence for queue operations, empty
+  // for an empty fence.
+  iree_hal_semaphore_list_t getSemaphoreList() const {
+    return fence_ ? iree_hal_fence_semaphore_list(fence_.get())
+                  : iree_hal_semaphore_list_empty();
+  }
+
+  // Automatic (implicit) conversion operator for
+  // `Fence` -> `iree_hal_fence_t *`, null for an empty fence.
+  operator iree_hal_fence_t *() const { return fence_.get(); }
+
+  // Delete copy constructors, keep default move constructor and destructor.
+  Fence(const Fence &) = delete;
+  Fence &operator=(const Fence &) = delete;
+  Fence(Fence &&) noexcept = default;
+  Fence &operator=(Fence &&) noexcept = default;
+  ~Fence() = default;
+
+private:
+  // Allow Graph to wrap the signal fences it creates.
+  friend class Graph;
+
+  explicit Fence(IreeHalFenceUniquePtrType fence) : fence_(std::move(fence)) {}
+
+  IreeHalFenceUniquePtrType fence_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_FENCE_H
@@ -17,16 +17,75 @@
 #define FUSILLI_BACKEND_HANDLE_H
 
 #include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer_pool.h"
+#include "fusilli/backend/cpu_options.h"
+#include "fusilli/backend/execution_stats.h"
+#include "fusilli/backend/memory_tracker.h"
+#include "fusilli/backend/parameters.h"
 #include "fusilli/support/logging.h"
 
 #include <iree/hal/api.h>
 #include <iree/vm/api.h>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace fusilli {
 
+// Forward declaration of Buffer class.
+class Buffer;
+
+namespace detail {
+
+// HAL device and device group of a handle, shared by the handles created on
+// the same device and stream (see `Handle::initDevice()`).
+struct SharedDevice {
+  // HIP stream created for the device by the handle, if any (see the
+  // prioritized `Handle::create()` overload). Declared first, so the stream
+  // is destroyed after the device using it.
+  std::shared_ptr<void> ownedStream;
+  // Declared before the device group, so the group is released first.
+  IreeHalDeviceUniquePtrType device;
+  IreeHalDeviceGroupUniquePtrType deviceGroup;
+  // HAL module over the device group, created by the first graph loaded on
+  // the device and shared by the VM contexts of all graphs loaded on it
+  // since, see `Handle::getHalModule()`. Declared last, so it is released
+  // before the device group it references.
+  std::mutex halModuleMutex;
+  IreeVmModuleUniquePtrType halModule;
+};
+
+} // namespace detail
+
+// Scheduling priority of the HIP stream of a handle queue, see the
+// prioritized `Handle::create()` overload and `PriorityScheduler`.
+enum class StreamPriority {
+  Low,
+  Normal,
+  High,
+};
+
+static const std::unordered_map<StreamPriority, std::string>
+    kStreamPriorityToStr = {
+        {StreamPriority::Low, "LOW"},
+        {StreamPriority::Normal, "NORMAL"},
+        {StreamPriority::High, "HIGH"},
+};
+
 // An application using Fusilli to run operations on a given device
 // must first initialize a handle on that device by calling
 // `Handle::create()`. This allocates the necessary resources
@@ -34,6 +93,9 @@ namespace fusilli {
 // by the handle(s).
 class Handle {
 public:
+  // Default alignment of allocated buffers, see `setBufferAlignment()`.
+  static constexpr size_t kDefaultBufferAlignment = 64;
+
   // Creates a Handle for the specified backend. For AMDGPU backend, created
   // handle will use device 0 with the default (null) stream. Other create
   // overloads offer more specificity when setting device and stream.
@@ -46,21 +108,52 @@ public:
     FUSILLI_ASSIGN_OR_RETURN(auto instance, Handle::createSharedInstance());
     auto handle = Handle(backend, std::move(instance));
 
-    // Lazy create handle-specific IREE HAL device and populate the handle.
+    // Lazy create (or reuse) the IREE HAL device and populate the handle.
+    std::function<ErrorObject()> createDevice;
     switch (backend) {
     case Backend::CPU:
-      FUSILLI_CHECK_ERROR(handle.createCPUDevice());
+      createDevice = [&] { return handle.createCPUDevice(CpuOptions()); };
       break;
     case Backend::AMDGPU:
-      FUSILLI_CHECK_ERROR(
-          handle.createAMDGPUDevice(/*deviceId=*/0, /*stream=*/0));
+      createDevice = [&] {
+        return handle.createAMDGPUDevice(/*deviceId=*/0, /*stream=*/0);
+      };
       break;
     default:
       return ErrorObject(ErrorCode::InternalError,
                          "Handle::create got an unknown backend");
     }
+    FUSILLI_CHECK_ERROR(handle.initDevice(
+        DeviceKey(kHalDriver.at(backend), /*deviceId=*/0, /*stream=*/0),
+        createDevice));
+
+    return ok(std::move(handle));
+  }
 
-    FUSILLI_CHECK_ERROR(handle.createDeviceGroup());
+  // Creates a CPU Handle whose task executor runs the worker thread topology
+  // described by `options`, e.g. restricted to the cores of one NUMA node so
+  // that several handles can partition a multi-socket host (see
+  // `CpuOptions`). Only supported for the CPU backend.
+  static ErrorOr<Handle> create(Backend backend, const CpuOptions &options) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Creating handle for backend: "
+                           << backend << " with " << options.threads
+                           << " threads on NUMA node: "
+                           << options.numaNode.value_or(0));
+
+    FUSILLI_RETURN_ERROR_IF(backend != Backend::CPU,
+                            ErrorCode::InvalidArgument,
+                            "CPU options can only be set on CPU backend");
+
+    FUSILLI_ASSIGN_OR_RETURN(auto instance, Handle::createSharedInstance());
+    auto handle = Handle(backend, std::move(instance));
+    // Handles with a worker topology own their task executor.
+    std::optional<DeviceKey> key;
+    if (!options.hasTopology())
+      key = DeviceKey(options.inlineExecution ? kCpuInlineHalDriver
+                                              : kHalDriver.at(backend),
+                      /*deviceId=*/0, /*stream=*/0);
+    FUSILLI_CHECK_ERROR(handle.initDevice(
+        key, [&] { return handle.createCPUDevice(options); }));
 
     return ok(std::move(handle));
   }
@@ -103,14 +196,144 @@ public:
     FUSILLI_ASSIGN_OR_RETURN(auto instance, Handle::createSharedInstance());
     auto handle = Handle(backend, std::move(instance));
 
-    // Lazy create handle-specific IREE HAL device and populate the handle.
+    // Lazy create (or reuse) the IREE HAL device and populate the handle.
+    FUSILLI_CHECK_ERROR(handle.initDevice(
+        DeviceKey(kHalDriver.at(backend), deviceId, stream), [&] {
+          return handle.createAMDGPUDevice(deviceId, stream);
+        }));
+
+    return ok(std::move(handle));
+  }
+
+  // Creates a Handle with one queue per stream in `streams`, all on the
+  // specified device, so independent graphs can overlap on one GPU using a
+  // single compiled graph: `Graph::execute()` picks the queues round-robin,
+  // or takes an explicit queue index. Queue 0 (`streams[0]`) is the queue of
+  // the handle itself, used for buffer allocations and transfers; buffers are
+  // usable on every queue. Only supported for the AMDGPU backend.
+  //
+  // WARNING: like for the single stream overload, all streams must be
+  // attached to the device identified with deviceId.
+  static ErrorOr<Handle> create(Backend backend, int deviceId,
+                                std::span<const uintptr_t> streams) {
+    FUSILLI_RETURN_ERROR_IF(streams.empty(), ErrorCode::InvalidArgument,
+                            "Handle::create requires at least one stream");
+    FUSILLI_ASSIGN_OR_RETURN(Handle handle,
+                             create(backend, deviceId, streams[0]));
+    for (uintptr_t stream : streams.subspan(1)) {
+      FUSILLI_ASSIGN_OR_RETURN(Handle queue,
+                               create(backend, deviceId, stream));
+      queue.memoryTracker_ = handle.memoryTracker_;
+      queue.executionCounters_ = handle.executionCounters_;
+      queue.parameters_ = handle.parameters_;
+      handle.extraQueues_.push_back(std::move(queue));
+    }
+    if (!handle.extraQueues_.empty())
+      handle.nextQueue_ = std::make_unique<std::atomic<size_t>>(0);
+    return ok(std::move(handle));
+  }
+
+  // Creates a Handle with one queue per entry of `priorities`, each on a new
+  // non-blocking HIP stream of that scheduling priority on the specified
+  // device, e.g. {High, Low} for latency-critical inference sharing the GPU
+  // with bulk work. The GPU dispatches the kernels of higher priority streams
+  // first, so their work overtakes queued lower priority work at kernel
+  // granularity. Queues are laid out like in the multi-stream overload;
+  // route executions to them by priority with `PriorityScheduler`. The
+  // streams are owned by the handle. Only supported for the AMDGPU backend.
+  static ErrorOr<Handle> create(Backend backend, int deviceId,
+                                std::span<const StreamPriority> priorities) {
+    FUSILLI_RETURN_ERROR_IF(priorities.empty(), ErrorCode::InvalidArgument,
+                            "Handle::create requires at least one stream "
+                            "priority");
+    FUSILLI_RETURN_ERROR_IF(backend != Backend::AMDGPU,
+                            ErrorCode::InvalidArgument,
+                            "Stream priorities can only be set on AMDGPU "
+                            "backend");
+    FUSILLI_ASSIGN_OR_RETURN(const detail::HipApi *hip, detail::getHipApi());
     FUSILLI_CHECK_ERROR(
-        handle.createAMDGPUDevice(/*deviceId=*/deviceId, /*stream=*/stream));
-    FUSILLI_CHECK_ERROR(handle.createDeviceGroup());
+        hip->check(hip->hipSetDevice(deviceId), "hipSetDevice"));
+    // Lower values are higher priorities, with 0 the default priority.
+    int least = 0, greatest = 0;
+    FUSILLI_CHECK_ERROR(
+        hip->check(hip->hipDeviceGetStreamPriorityRange(&least, &greatest),
+                   "hipDeviceGetStreamPriorityRange"));
+
+    std::vector<std::shared_ptr<void>> ownedStreams;
+    std::vector<uintptr_t> streams;
+    for (StreamPriority priority : priorities) {
+      int value = std::clamp(0, greatest, least);
+      if (priority == StreamPriority::Low)
+        value = least;
+      else if (priority == StreamPriority::High)
+        value = greatest;
+      detail::HipApi::hipStream_t stream = nullptr;
+      FUSILLI_CHECK_ERROR(hip->check(
+          hip->hipStreamCreateWithPriority(
+              &stream, detail::HipApi::hipStreamNonBlocking, value),
+          "hipStreamCreateWithPriority"));
+      ownedStreams.emplace_back(
+          stream, [hip](void *owned) { hip->hipStreamDestroy(owned); });
+      streams.push_back(reinterpret_cast<uintptr_t>(stream));
+    }
+    FUSILLI_LOG_LABEL_ENDL("INFO: Created " << streams.size()
+                                            << " prioritized streams");
+
+    FUSILLI_ASSIGN_OR_RETURN(
+        Handle handle,
+        create(backend, deviceId, std::span<const uintptr_t>(streams)));
+    for (size_t i = 0; i < priorities.size(); ++i) {
+      Handle &queue = i == 0 ? handle : handle.extraQueues_[i - 1];
+      queue.device_->ownedStream = std::move(ownedStreams[i]);
+      queue.priority_ = priorities[i];
+    }
+    return ok(std::move(handle));
+  }
 
+  // Creates a Handle spanning several devices, with one queue per device in
+  // `deviceIds` (using its default stream), so a graph compiled once on the
+  // handle can run on any of them: `Graph::execute()` takes the queue index
+  // of the device to run on. As buffers live on a single device, allocate
+  // them on `getQueue(index)`; executions without a queue index run on queue
+  // 0 (`deviceIds[0]`) instead of round-robin. Only supported for the AMDGPU
+  // backend, and all devices must share the target architecture.
+  static ErrorOr<Handle> create(Backend backend,
+                                std::span<const int> deviceIds) {
+    FUSILLI_RETURN_ERROR_IF(deviceIds.empty(), ErrorCode::InvalidArgument,
+                            "Handle::create requires at least one device");
+    FUSILLI_ASSIGN_OR_RETURN(Handle handle,
+                             create(backend, deviceIds[0], /*stream=*/0));
+    for (int deviceId : deviceIds.subspan(1)) {
+      FUSILLI_ASSIGN_OR_RETURN(Handle queue,
+                               create(backend, deviceId, /*stream=*/0));
+      queue.memoryTracker_ = handle.memoryTracker_;
+      queue.executionCounters_ = handle.executionCounters_;
+      queue.parameters_ = handle.parameters_;
+      handle.extraQueues_.push_back(std::move(queue));
+    }
     return ok(std::move(handle));
   }
 
+  // Returns the number of queues of the handle, see the multi-stream and
+  // multi-device `create()` overloads.
+  size_t getQueueCount() const { return 1 + extraQueues_.size(); }
+
+  // Returns the single-queue handle of queue `index` (the handle itself for
+  // 0), e.g. to allocate buffers on its device. `index` must be less than
+  // `getQueueCount()`.
+  const Handle &getQueue(size_t index) const {
+    return index == 0 ? *this : extraQueues_[index - 1];
+  }
+
+  // Returns the next queue index in round-robin order (thread-safe), or
+  // always 0 for handles spanning several devices.
+  size_t nextQueueIndex() const {
+    if (!nextQueue_)
+      return 0;
+    return nextQueue_->fetch_add(1, std::memory_order_relaxed) %
+           getQueueCount();
+  }
+
   // Automatic (implicit) conversion operator for
   // `Handle` -> `iree_hal_device_t *`.
   operator iree_hal_device_t *() const { return getDevice(); }
@@ -124,8 +347,150 @@ public:
 
   Backend getBackend() const { return backend_; }
 
-  // Allow Graph and Buffer to access private Handle methods.
+  // Returns the HIP stream (`hipStream_t`) executions are ordered on, or `0`
+  // for the default (null) stream and for non-AMDGPU backends.
+  uintptr_t getStream() const { return stream_; }
+
+  // Returns the scheduling priority of the stream of the handle, `Normal`
+  // unless created with the prioritized `create()` overload.
+  StreamPriority getStreamPriority() const { return priority_; }
+
+  // Returns the index of the GPU of the handle (0 for CPU handles).
+  int getDeviceId() const { return deviceId_; }
+
+  // Enables the caching allocator of the handle: device memory of buffers
+  // allocated through it (`Buffer::allocate()`, `Buffer::allocateRaw()`) is
+  // kept in size class free lists when the buffers are destroyed, and reused
+  // by later allocations. This removes the device allocation cost from
+  // pipelines allocating buffers per iteration. Reuse is stream ordered, so
+  // it is safe for work on this handle's queue; each queue of a multi-stream
+  // handle has its own cache. Call before allocating buffers.
+  void enableCachingAllocator() {
+    if (!bufferPool_)
+      bufferPool_ = std::make_shared<detail::BufferPool>();
+    for (Handle &queue : extraQueues_)
+      queue.enableCachingAllocator();
+  }
+
+  bool isCachingAllocatorEnabled() const { return bufferPool_ != nullptr; }
+
+  // Returns the counters of the caching allocator (all zero when disabled).
+  AllocatorStats getAllocatorStats() const {
+    return bufferPool_ ? bufferPool_->getStats() : AllocatorStats{};
+  }
+
+  // Sets the alignment, in bytes, of the device memory of buffers allocated
+  // through the handle and its queues (`Buffer::allocate()`,
+  // `Buffer::allocateRaw()` and the likes), `kDefaultBufferAlignment` unless
+  // set. Raise it to the largest `TensorAttr::setAlignment()` of the graphs
+  // executed on those buffers. Call before allocating buffers, as buffers
+  // reused by the caching allocator keep the alignment they were allocated
+  // with.
+  ErrorObject setBufferAlignment(size_t alignment) {
+    FUSILLI_RETURN_ERROR_IF(!std::has_single_bit(alignment), // C++20
+                            ErrorCode::InvalidArgument,
+                            "Buffer alignment " + std::to_string(alignment) +
+                                " is not a power of two");
+    bufferAlignment_ = alignment;
+    for (Handle &queue : extraQueues_)
+      FUSILLI_CHECK_ERROR(queue.setBufferAlignment(alignment));
+    return ok();
+  }
+
+  size_t getBufferAlignment() const { return bufferAlignment_; }
+
+  // Returns the live and peak device memory Fusilli holds through the handle
+  // and its queues (buffers, workspaces and loaded modules), and the
+  // workspace sizes of the graphs loaded on it (see `MemoryStats`).
+  MemoryStats getMemoryStats() const { return memoryTracker_->getStats(); }
+
+  // Resets the peaks of `getMemoryStats()` to the memory live now, so they
+  // measure the peak of the work that follows, e.g. of a single graph.
+  void resetPeakMemoryStats() const { memoryTracker_->resetPeaks(); }
+
+  // Returns the execution, compilation and transfer counters of the handle
+  // and its queues (see `ExecutionStats`). Cheap enough to poll, e.g. from a
+  // stats endpoint.
+  ExecutionStats getExecutionStats() const {
+    return executionCounters_->getStats();
+  }
+
+  // Resets the counters of `getExecutionStats()` to zero.
+  void resetExecutionStats() const { executionCounters_->reset(); }
+
+  // Makes the parameters of the IREE parameter archive at `path` (an IRPA,
+  // safetensors or GGUF file) available under `scope` to the graphs loaded
+  // on this handle afterwards, see `TensorAttr::setParameter()`. The archive
+  // is memory mapped rather than read, and only the parameters a graph
+  // references are transferred to the device when it is loaded. Archives
+  // added to the same scope are searched together.
+  ErrorObject loadParameters(const std::filesystem::path &path,
+                             const std::string &scope = "model") {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Loading parameters '"
+                           << path.string() << "' into scope '" << scope
+                           << "'");
+    return parameters_->add(scope, path);
+  }
+
+  // Returns the device memory cached by the caching allocator.
+  void trimCachingAllocator() const {
+    if (bufferPool_)
+      bufferPool_->trim();
+  }
+
+  // A workspace buffer of the arena of a queue borrowed for one execution,
+  // returned to the arena when the lease is destroyed. A lease without a
+  // handle wraps a caller-provided workspace and returns nothing.
+  class WorkspaceLease {
+  public:
+    WorkspaceLease(const Handle *handle, std::shared_ptr<Buffer> buffer,
+                   size_t size)
+        : handle_(handle), buffer_(std::move(buffer)), size_(size) {}
+    WorkspaceLease(WorkspaceLease &&other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr)),
+          buffer_(std::move(other.buffer_)), size_(other.size_) {}
+    WorkspaceLease &operator=(WorkspaceLease &&) = delete;
+    WorkspaceLease(const WorkspaceLease &) = delete;
+    WorkspaceLease &operator=(const WorkspaceLease &) = delete;
+    ~WorkspaceLease() {
+      if (handle_)
+        handle_->releaseWorkspace(std::move(buffer_), size_);
+    }
+
+    const std::shared_ptr<Buffer> &get() const { return buffer_; }
+
+  private:
+    const Handle *handle_;
+    std::shared_ptr<Buffer> buffer_;
+    size_t size_;
+  };
+
+  // Borrows a workspace of at least `minSize` bytes from the arena of the
+  // handle: an idle buffer when one is left by a completed execution, else a
+  // new one. Graphs executed without a workspace buffer borrow one, so graphs
+  // run one after another reuse a single workspace sized to the largest one
+  // (see `Graph::getWorkspaceSize()`) rather than each owning one. Stream
+  // ordering makes reuse safe for executions on one queue, and executions
+  // that overlap (e.g. from several threads on the CPU backend) hold
+  // distinct buffers. Each queue has its own arena. Requesting a larger size
+  // grows the arena, dropping its smaller idle buffers. Definition in
+  // `fusilli/backend/runtime.h`.
+  ErrorOr<WorkspaceLease> acquireWorkspace(size_t minSize) const;
+
+  // Returns the current size in bytes of the workspace arena of queue 0.
+  size_t getWorkspaceArenaSize() const {
+    std::lock_guard<std::mutex> lock(workspaceArena_->mutex);
+    return workspaceArena_->size;
+  }
+
+  // Blocks until all work submitted to the device of this handle (e.g. by
+  // asynchronous `Graph::execute()` calls), on any of its queues, has
+  // completed. Definition in `fusilli/backend/runtime.h`.
+  ErrorObject synchronize() const;
+
+  // Allow Graph, ExecutionPlan and Buffer to access private Handle methods.
   friend class Graph;
+  friend class ExecutionPlan;
   friend class Buffer;
 
 private:
@@ -133,9 +498,22 @@ private:
   // handles/threads. Definition in `fusilli/backend/runtime.h`.
   static ErrorOr<IreeVmInstanceSharedPtrType> createSharedInstance();
 
-  // Creates IREE HAL CPU device for this handle. Definition in
+  // Identifies the HAL devices shared across handles: driver name, device
+  // and stream.
+  using DeviceKey = std::tuple<std::string, int, uintptr_t>;
+
+  // Initializes the device of this handle. Like the VM instance, devices are
+  // shared without prolonging their lifetime: the device of a live handle
+  // created with the same `key` is reused, otherwise `createDevice` creates
+  // it (setting `device_`) and its device group is created. Devices without
+  // a key are owned by this handle only. Definition in
   // `fusilli/backend/runtime.h`.
-  ErrorObject createCPUDevice();
+  ErrorObject initDevice(const std::optional<DeviceKey> &key,
+                         const std::function<ErrorObject()> &createDevice);
+
+  // Creates IREE HAL CPU device for this handle, with the task executor
+  // topology of `options`. Definition in `fusilli/backend/runtime.h`.
+  ErrorObject createCPUDevice(const CpuOptions &options);
 
   // Creates a IREE HAL HIP device for this handle around the provided stream.
   // Definition in `fusilli/backend/runtime.h`.
@@ -145,6 +523,12 @@ private:
   // `fusilli/backend/runtime.h`.
   ErrorObject createDeviceGroup();
 
+  // Returns the HAL module of the handle's device, creating it on first use.
+  // Module creation is the same for every graph loaded on a device, so
+  // graphs loaded concurrently (see `compileAll()`) share one module instead
+  // of each creating theirs. Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<IreeVmModuleUniquePtrType> getHalModule() const;
+
   // Private constructor (use factory `create` method for handle creation).
   Handle(Backend backend, IreeVmInstanceSharedPtrType instance)
       : backend_(backend), instance_(std::move(instance)) {}
@@ -153,13 +537,17 @@ private:
   // WARNING: The returned raw pointer is not safe to store since
   // its lifetime is tied to the `Handle` object and only
   // valid as long as this handle exists.
-  iree_hal_device_t *getDevice() const { return device_.get(); }
+  iree_hal_device_t *getDevice() const {
+    return device_ ? device_->device.get() : nullptr;
+  }
 
   // Returns a raw pointer to the underlying IREE HAL device group.
   // WARNING: The returned raw pointer is not safe to store since
   // its lifetime is tied to the `Handle` object and only
   // valid as long as this handle exists.
-  iree_hal_device_group_t *getDeviceGroup() const { return deviceGroup_.get(); }
+  iree_hal_device_group_t *getDeviceGroup() const {
+    return device_ ? device_->deviceGroup.get() : nullptr;
+  }
 
   // Returns a raw pointer to the underlying IREE VM instance.
   // WARNING: The returned raw pointer is not safe to store since
@@ -171,8 +559,61 @@ private:
   // `device_` depends on `backend_` and `instance_`.
   Backend backend_;
   IreeVmInstanceSharedPtrType instance_;
-  IreeHalDeviceUniquePtrType device_;
-  IreeHalDeviceGroupUniquePtrType deviceGroup_;
+  std::shared_ptr<detail::SharedDevice> device_;
+  int deviceId_ = 0;
+  uintptr_t stream_ = 0;
+  StreamPriority priority_ = StreamPriority::Normal;
+
+  // Single-queue handles over the additional streams or devices of the
+  // handle, and the round-robin cursor over all queues (null when there is
+  // only one queue or the queues span devices; heap allocated so the handle
+  // stays movable).
+  std::vector<Handle> extraQueues_;
+  std::unique_ptr<std::atomic<size_t>> nextQueue_;
+
+  // Returns a workspace borrowed with `acquireWorkspace()`, which is kept for
+  // reuse unless the arena has grown past `size` since. Definition in
+  // `fusilli/backend/runtime.h`.
+  void releaseWorkspace(std::shared_ptr<Buffer> buffer, size_t size) const;
+
+  // Workspaces of the graphs executed on this queue that are not in use, all
+  // `size` bytes, see `acquireWorkspace()`.
+  struct WorkspaceArena {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Buffer>> idle;
+    size_t size = 0;
+  };
+  std::unique_ptr<WorkspaceArena> workspaceArena_ =
+      std::make_unique<WorkspaceArena>();
+
+  // Alignment of allocated buffers, see `setBufferAlignment()`.
+  size_t bufferAlignment_ = kDefaultBufferAlignment;
+
+  // Caching allocator, see `enableCachingAllocator()`. Shared with the
+  // buffers allocated from it, which may outlive the handle.
+  std::shared_ptr<detail::BufferPool> bufferPool_;
+
+  // Pinned host staging buffers of `Buffer::readAsync()` and
+  // `Buffer::writeAsync()`, reused across transfers since pinned allocations
+  // are expensive.
+  std::shared_ptr<detail::BufferPool> stagingPool_ =
+      std::make_shared<detail::BufferPool>();
+
+  // Memory accounting of the handle, shared by its queues, see
+  // `getMemoryStats()`. Shared with the buffers and graphs holding memory
+  // through it, which may outlive the handle.
+  std::shared_ptr<detail::MemoryTracker> memoryTracker_ =
+      std::make_shared<detail::MemoryTracker>();
+
+  // Always-on counters of the handle, shared by its queues, see
+  // `getExecutionStats()`.
+  std::shared_ptr<detail::ExecutionCounters> executionCounters_ =
+      std::make_shared<detail::ExecutionCounters>();
+
+  // Parameter archives of the handle, shared by its queues, see
+  // `loadParameters()`.
+  std::shared_ptr<detail::ParameterArchives> parameters_ =
+      std::make_shared<detail::ParameterArchives>();
 };
 
 } // namespace fusilli
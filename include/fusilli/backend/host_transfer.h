@@ -0,0 +1,136 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains HostTransfer, the future returned by the asynchronous
+// host transfers of a Fusilli buffer (`Buffer::readAsync()` and
+// `Buffer::writeAsync()`).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_HOST_TRANSFER_H
+#define FUSILLI_BACKEND_HOST_TRANSFER_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer_pool.h"
+#include "fusilli/backend/fence.h"
+#include "fusilli/support/logging.h"
+
+#include <iree/hal/api.h>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace fusilli {
+
+// HostTransfer tracks a copy between a device buffer and host memory queued
+// through a pinned (host local, device visible) staging buffer. The copy is
+// ordered on the device queue after the wait fence it was queued with, and
+// `getFence()` is signaled once the device side of the copy completes, so it
+// can be passed to `Graph::executeAsync()` to chain work after an upload.
+//
+// For reads, the data reaches the caller's memory in `wait()`, which copies
+// it out of the staging buffer; `wait()` must be called before reading it.
+// Destroying a pending transfer waits for the device side to complete.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(HostTransfer download,
+//                            output.readAsync(handle, std::span(hostOut)));
+//   ... // enqueue the next batch
+//   FUSILLI_CHECK_ERROR(download.wait());
+class HostTransfer {
+public:
+  // Creates a completed transfer.
+  HostTransfer() = default;
+
+  // Blocks until the transfer completes and, for reads, copies the data into
+  // the caller's memory. Returns immediately once completed.
+  ErrorObject wait() {
+    if (!staging_)
+      return ok();
+    FUSILLI_CHECK_ERROR(fence_.wait());
+    if (readTarget_) {
+      FUSILLI_CHECK_ERROR(iree_hal_buffer_map_read(
+          staging_.get(), /*source_offset=*/0, readTarget_, readLength_));
+      readTarget_ = nullptr;
+    }
+    // The device is done with the staging buffer, so it may be reused.
+    if (pool_)
+      pool_->release(std::move(staging_), sizeClass_);
+    staging_.reset();
+    return ok();
+  }
+
+  // Returns whether the device side of the transfer completed, without
+  // blocking. Reads still need `wait()` to copy the data out.
+  ErrorOr<bool> isReady() const { return fence_.isSignaled(); }
+
+  // Returns the fence signaled once the device side of the transfer
+  // completes.
+  const Fence &getFence() const { return fence_; }
+
+  // Delete copy constructors, keep move constructors and destructor.
+  HostTransfer(const HostTransfer &) = delete;
+  HostTransfer &operator=(const HostTransfer &) = delete;
+  HostTransfer(HostTransfer &&other) noexcept
+      : fence_(std::move(other.fence_)), pool_(std::move(other.pool_)),
+        staging_(std::move(other.staging_)), sizeClass_(other.sizeClass_),
+        readTarget_(std::exchange(other.readTarget_, nullptr)),
+        readLength_(other.readLength_) {}
+  HostTransfer &operator=(HostTransfer &&other) noexcept {
+    if (this != &other) {
+      drain();
+      fence_ = std::move(other.fence_);
+      pool_ = std::move(other.pool_);
+      staging_ = std::move(other.staging_);
+      sizeClass_ = other.sizeClass_;
+      readTarget_ = std::exchange(other.readTarget_, nullptr);
+      readLength_ = other.readLength_;
+    }
+    return *this;
+  }
+  ~HostTransfer() { drain(); }
+
+private:
+  // Class should be constructed through `Buffer::readAsync()` or
+  // `Buffer::writeAsync()`.
+  friend class Buffer;
+
+  HostTransfer(Fence fence, std::shared_ptr<detail::BufferPool> pool,
+               IreeHalBufferUniquePtrType staging, size_t sizeClass,
+               void *readTarget, size_t readLength)
+      : fence_(std::move(fence)), pool_(std::move(pool)),
+        staging_(std::move(staging)), sizeClass_(sizeClass),
+        readTarget_(readTarget), readLength_(readLength) {}
+
+  // Waits for a pending transfer without reporting errors. If waiting fails
+  // the staging buffer is not reused; the queued copy keeps it alive.
+  void drain() {
+    if (!staging_)
+      return;
+    readTarget_ = nullptr;
+    if (isError(fence_.wait()))
+      pool_.reset();
+    if (pool_)
+      pool_->release(std::move(staging_), sizeClass_);
+    staging_.reset();
+  }
+
+  Fence fence_;
+  // Staging buffer pool of the handle, and the buffer borrowed from it.
+  std::shared_ptr<detail::BufferPool> pool_;
+  IreeHalBufferUniquePtrType staging_;
+  size_t sizeClass_ = 0;
+  // Caller memory that `wait()` fills, for reads.
+  void *readTarget_ = nullptr;
+  size_t readLength_ = 0;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_HOST_TRANSFER_H
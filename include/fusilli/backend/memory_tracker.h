@@ -0,0 +1,181 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the device memory accounting of a Fusilli handle (see
+// `Handle::getMemoryStats()`): live and peak bytes of the memory Fusilli
+// allocates or loads through the handle, by what it is used for.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_MEMORY_TRACKER_H
+#define FUSILLI_BACKEND_MEMORY_TRACKER_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace fusilli {
+
+// Live and peak bytes of one category of memory.
+struct MemoryUsage {
+  size_t liveBytes = 0;
+  size_t peakBytes = 0;
+};
+
+// Memory held through a handle (and its queues). Buffers from a caching
+// allocator count while in use; the memory it caches for reuse is reported
+// by `Handle::getAllocatorStats()` instead. Imported buffers are not
+// counted, as their memory is owned by the caller.
+struct MemoryStats {
+  // Typed buffers, e.g. graph inputs and outputs (`Buffer::allocate()`,
+  // `Buffer::allocateUninitialized()`, `Buffer::allocateFilled()`,
+  // `Buffer::allocateAsync()`).
+  MemoryUsage buffers;
+
+  // Raw buffers (`Buffer::allocateRaw()`), including the workspace arenas of
+  // the queues (see `Handle::acquireWorkspace()`).
+  MemoryUsage workspace;
+
+  // Loaded VMFB artifacts, which embed the module constants (weights folded
+  // into the graph) the device copies at load time.
+  MemoryUsage modules;
+
+  // Sum of the three categories above. Its peak is the peak of the sum,
+  // not the sum of the peaks.
+  MemoryUsage total;
+
+  // Sum of the workspace sizes of the graphs loaded on the handle (see
+  // `Graph::getWorkspaceSize()`): the workspace memory they need if each
+  // owned its workspace, to compare with `workspace.liveBytes`.
+  size_t graphWorkspaceBytes = 0;
+};
+
+namespace detail {
+
+// What tracked memory is used for, see `MemoryStats`.
+enum class MemoryCategory : uint8_t {
+  Buffers,
+  Workspace,
+  Modules,
+  // Not allocated memory: the workspace requirements of loaded graphs.
+  GraphWorkspace,
+};
+
+// Counters of the memory held through a handle, shared by its queues and by
+// the allocations still referring to it.
+class MemoryTracker {
+public:
+  void add(MemoryCategory category, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MemoryUsage &usage = usage_[static_cast<size_t>(category)];
+    usage.liveBytes += bytes;
+    usage.peakBytes = std::max(usage.peakBytes, usage.liveBytes);
+    if (category != MemoryCategory::GraphWorkspace) {
+      total_.liveBytes += bytes;
+      total_.peakBytes = std::max(total_.peakBytes, total_.liveBytes);
+    }
+  }
+
+  void remove(MemoryCategory category, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    usage_[static_cast<size_t>(category)].liveBytes -= bytes;
+    if (category != MemoryCategory::GraphWorkspace)
+      total_.liveBytes -= bytes;
+  }
+
+  // Lowers the peaks to the live bytes, see `Handle::resetPeakMemoryStats()`.
+  void resetPeaks() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (MemoryUsage &usage : usage_)
+      usage.peakBytes = usage.liveBytes;
+    total_.peakBytes = total_.liveBytes;
+  }
+
+  MemoryStats getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MemoryStats stats;
+    stats.buffers = usage_[static_cast<size_t>(MemoryCategory::Buffers)];
+    stats.workspace = usage_[static_cast<size_t>(MemoryCategory::Workspace)];
+    stats.modules = usage_[static_cast<size_t>(MemoryCategory::Modules)];
+    stats.total = total_;
+    stats.graphWorkspaceBytes =
+        usage_[static_cast<size_t>(MemoryCategory::GraphWorkspace)].liveBytes;
+    return stats;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::array<MemoryUsage, 4> usage_;
+  MemoryUsage total_;
+};
+
+// Bytes accounted in a `MemoryTracker` for as long as this object lives.
+class TrackedMemory {
+public:
+  // Creates an empty record, not accounted anywhere.
+  TrackedMemory() = default;
+
+  TrackedMemory(std::shared_ptr<MemoryTracker> tracker,
+                MemoryCategory category, size_t bytes)
+      : tracker_(std::move(tracker)), category_(category), bytes_(bytes) {
+    if (tracker_)
+      tracker_->add(category_, bytes_);
+  }
+
+  size_t getBytes() const { return bytes_; }
+
+  // Accounts `bytes` instead of the current size.
+  void resize(size_t bytes) {
+    if (!tracker_)
+      return;
+    if (bytes > bytes_)
+      tracker_->add(category_, bytes - bytes_);
+    else
+      tracker_->remove(category_, bytes_ - bytes);
+    bytes_ = bytes;
+  }
+
+  // Delete copy constructors, keep move constructors and destructor.
+  TrackedMemory(const TrackedMemory &) = delete;
+  TrackedMemory &operator=(const TrackedMemory &) = delete;
+  TrackedMemory(TrackedMemory &&other) noexcept
+      : tracker_(std::move(other.tracker_)), category_(other.category_),
+        bytes_(std::exchange(other.bytes_, 0)) {}
+  TrackedMemory &operator=(TrackedMemory &&other) noexcept {
+    if (this != &other) {
+      release();
+      tracker_ = std::move(other.tracker_);
+      category_ = other.category_;
+      bytes_ = std::exchange(other.bytes_, 0);
+    }
+    return *this;
+  }
+  ~TrackedMemory() { release(); }
+
+private:
+  void release() {
+    if (tracker_)
+      tracker_->remove(category_, bytes_);
+    tracker_.reset();
+    bytes_ = 0;
+  }
+
+  std::shared_ptr<MemoryTracker> tracker_;
+  MemoryCategory category_ = MemoryCategory::Buffers;
+  size_t bytes_ = 0;
+};
+
+} // namespace detail
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_MEMORY_TRACKER_H
@@ -0,0 +1,140 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the external parameters of a Fusilli handle (see
+// `Handle::loadParameters()`): IREE parameter archives (IRPA, safetensors or
+// GGUF files) indexed per scope, and served to the graphs loaded on the
+// handle through the IREE `io_parameters` module.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_PARAMETERS_H
+#define FUSILLI_BACKEND_PARAMETERS_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/support/logging.h"
+
+#include <iree/io/file_handle.h>
+#include <iree/io/formats/parser_registry.h>
+#include <iree/io/parameter_index.h>
+#include <iree/io/parameter_index_provider.h>
+#include <iree/modules/io/parameters/module.h>
+#include <iree/vm/api.h>
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Custom deleter for IREE parameter index.
+struct IreeIoParameterIndexDeleter {
+  void operator()(iree_io_parameter_index_t *index) const {
+    if (index)
+      iree_io_parameter_index_release(index);
+  }
+};
+
+using IreeIoParameterIndexUniquePtrType =
+    std::unique_ptr<iree_io_parameter_index_t, IreeIoParameterIndexDeleter>;
+
+namespace detail {
+
+// Parameter archives of a handle, indexed per scope. Files are memory mapped
+// by the index, so parameters are streamed from the page cache to the device
+// when a module referencing them is loaded, without a host copy.
+class ParameterArchives {
+public:
+  // Indexes the parameters of the archive at `path` into `scope`. The format
+  // is picked from the file extension (`.irpa`, `.safetensors` or `.gguf`).
+  ErrorObject add(const std::string &scope,
+                  const std::filesystem::path &path) {
+    iree_allocator_t allocator = iree_allocator_system();
+    std::string pathStr = path.string();
+    iree_string_view_t pathView =
+        iree_make_string_view(pathStr.data(), pathStr.size());
+    iree_io_file_handle_t *file = nullptr;
+    FUSILLI_CHECK_ERROR(iree_io_file_handle_open(
+        IREE_IO_FILE_MODE_READ, pathView, allocator, &file));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    iree_io_parameter_index_t *index = nullptr;
+    for (auto &[name, scopeIndex] : scopes_)
+      if (name == scope)
+        index = scopeIndex.get();
+    if (!index) {
+      ErrorObject status =
+          iree_io_parameter_index_create(allocator, &index);
+      if (isError(status)) {
+        iree_io_file_handle_release(file);
+        return status;
+      }
+      scopes_.emplace_back(scope, IreeIoParameterIndexUniquePtrType(index));
+    }
+    // The index retains the file.
+    ErrorObject status =
+        iree_io_parse_file_index(pathView, file, index, allocator);
+    iree_io_file_handle_release(file);
+    FUSILLI_CHECK_ERROR(status);
+    // Modules created before see only the parameters indexed then.
+    module_.reset();
+    return ok();
+  }
+
+  bool empty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return scopes_.empty();
+  }
+
+  // Returns the `io_parameters` module serving every scope, created on first
+  // use, with a reference retained for the caller.
+  ErrorOr<IreeVmModuleUniquePtrType> getModule(iree_vm_instance_t *instance) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!module_) {
+      iree_allocator_t allocator = iree_allocator_system();
+      std::vector<iree_io_parameter_provider_t *> providers;
+      ErrorObject status = ok();
+      for (const auto &[name, index] : scopes_) {
+        iree_io_parameter_provider_t *provider = nullptr;
+        status = iree_io_parameter_index_provider_create(
+            iree_make_string_view(name.data(), name.size()), index.get(),
+            IREE_IO_PARAMETER_INDEX_PROVIDER_DEFAULT_MAX_CONCURRENT_OPERATIONS,
+            allocator, &provider);
+        if (isError(status))
+          break;
+        providers.push_back(provider);
+      }
+      // The module retains the providers.
+      iree_vm_module_t *module = nullptr;
+      if (isOk(status))
+        status = iree_io_parameters_module_create(
+            instance, providers.size(), providers.data(), allocator, &module);
+      for (iree_io_parameter_provider_t *provider : providers)
+        iree_io_parameter_provider_release(provider);
+      FUSILLI_CHECK_ERROR(status);
+      module_ = IreeVmModuleUniquePtrType(module);
+    }
+    iree_vm_module_retain(module_.get());
+    return ok(IreeVmModuleUniquePtrType(module_.get()));
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<std::pair<std::string, IreeIoParameterIndexUniquePtrType>>
+      scopes_;
+  IreeVmModuleUniquePtrType module_;
+};
+
+} // namespace detail
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_PARAMETERS_H
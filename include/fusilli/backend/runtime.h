@@ -35,23 +35,39 @@
 #include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/backend/backend.h"
 #include "fusilli/backend/buffer.h"
+#include "fusilli/backend/execution_timing.h"
+#include "fusilli/backend/fence.h"
 #include "fusilli/backend/handle.h"
 #include "fusilli/graph/graph.h"
 #include "fusilli/support/logging.h"
+#include "fusilli/support/mapped_file.h"
+#include "fusilli/support/tracing.h"
 
 #include <iree/async/util/proactor_pool.h>
 #include <iree/base/threading/numa.h>
 #include <iree/hal/api.h>
 #include <iree/hal/drivers/hip/api.h>
 #include <iree/hal/drivers/init.h>
+#include <iree/hal/drivers/local_task/task_driver.h>
+#include <iree/hal/local/loaders/registration/init.h>
 #include <iree/modules/hal/module.h>
+#include <iree/task/api.h>
 #include <iree/vm/api.h>
 #include <iree/vm/bytecode/module.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -123,15 +139,126 @@ inline ErrorOr<IreeVmInstanceSharedPtrType> Handle::createSharedInstance() {
   return ok(sharedInstance);
 }
 
-inline ErrorObject Handle::createCPUDevice() {
+// Creates a `local-task` driver whose devices run on a task executor with the
+// worker topology of `options`, instead of the default topology of the
+// registered driver.
+inline ErrorOr<iree_hal_driver_t *>
+createCpuTaskDriver(const CpuOptions &options) {
+  iree_allocator_t hostAllocator = iree_allocator_system();
+  iree_task_topology_node_id_t nodeId = options.numaNode.value_or(0);
+  iree_host_size_t nodeCount = iree_task_topology_query_node_count();
+  FUSILLI_RETURN_ERROR_IF(nodeId >= nodeCount, ErrorCode::InvalidArgument,
+                          "CpuOptions NUMA node " + std::to_string(nodeId) +
+                              " is out of range, the host has " +
+                              std::to_string(nodeCount) + " nodes");
+
+  // One worker group per physical core of the node, up to `threads`.
+  iree_task_topology_t topology;
+  iree_task_topology_initialize(&topology);
+  iree_status_t status = iree_task_topology_initialize_from_physical_cores(
+      nodeId, IREE_TASK_TOPOLOGY_PERFORMANCE_LEVEL_ANY,
+      options.threads == 0 ? IREE_TASK_TOPOLOGY_GROUP_BIT_COUNT
+                           : options.threads,
+      &topology);
+  if (!iree_status_is_ok(status)) {
+    iree_task_topology_deinitialize(&topology);
+    FUSILLI_CHECK_ERROR(status);
+  }
+  if (!options.pinThreads) {
+    for (iree_host_size_t i = 0; i < iree_task_topology_group_count(&topology);
+         ++i)
+      iree_thread_affinity_set_any(&topology.groups[i].ideal_thread_affinity);
+  }
+
+  iree_task_executor_options_t executorOptions;
+  iree_task_executor_options_initialize(&executorOptions);
+  iree_task_executor_t *executor = nullptr;
+  status = iree_task_executor_create(executorOptions, &topology, hostAllocator,
+                                     &executor);
+  iree_task_topology_deinitialize(&topology);
+  FUSILLI_CHECK_ERROR(status);
+
+  // Executable loaders and the heap allocator of the device, as set up by the
+  // registered `local-task` driver.
+  iree_hal_executable_loader_t *loaders[8] = {nullptr};
+  iree_host_size_t loaderCount = 0;
+  iree_hal_allocator_t *deviceAllocator = nullptr;
+  status = iree_hal_create_all_available_executable_loaders(
+      /*plugin_manager=*/nullptr, IREE_ARRAYSIZE(loaders), &loaderCount,
+      loaders, hostAllocator);
+  if (iree_status_is_ok(status))
+    status = iree_hal_allocator_create_heap(iree_make_cstring_view("local"),
+                                            hostAllocator, hostAllocator,
+                                            &deviceAllocator);
+
+  iree_hal_driver_t *driver = nullptr;
+  if (iree_status_is_ok(status)) {
+    iree_hal_task_device_params_t deviceParams;
+    iree_hal_task_device_params_initialize(&deviceParams);
+    status = iree_hal_task_driver_create(
+        iree_make_cstring_view(kHalDriver.at(Backend::CPU)), &deviceParams,
+        /*queue_count=*/1, &executor, loaderCount, loaders, deviceAllocator,
+        hostAllocator, &driver);
+  }
+
+  // The driver retains what it needs.
+  iree_hal_allocator_release(deviceAllocator);
+  for (iree_host_size_t i = 0; i < loaderCount; ++i)
+    iree_hal_executable_loader_release(loaders[i]);
+  iree_task_executor_release(executor);
+  FUSILLI_CHECK_ERROR(status);
+  return ok(driver);
+}
+
+inline ErrorObject
+Handle::initDevice(const std::optional<DeviceKey> &key,
+                   const std::function<ErrorObject()> &createDevice) {
+  if (!key) {
+    FUSILLI_CHECK_ERROR(createDevice());
+    return createDeviceGroup();
+  }
+  deviceId_ = std::get<1>(*key);
+  stream_ = std::get<2>(*key);
+
+  // Static weak_ptrs to the devices of live handles, see the VM instance in
+  // `createSharedInstance()`. Creation is serialized so that concurrent
+  // handles on the same device create it only once.
+  static std::mutex devicesMutex;
+  static std::map<DeviceKey, std::weak_ptr<detail::SharedDevice>> weakDevices;
+  std::lock_guard<std::mutex> lock(devicesMutex);
+
+  std::weak_ptr<detail::SharedDevice> &weakDevice = weakDevices[*key];
+  if (std::shared_ptr<detail::SharedDevice> device = weakDevice.lock()) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Reusing shared IREE HAL device");
+    device_ = std::move(device);
+    return ok();
+  }
+  FUSILLI_CHECK_ERROR(createDevice());
+  FUSILLI_CHECK_ERROR(createDeviceGroup());
+  weakDevice = device_;
+  return ok();
+}
+
+inline ErrorObject Handle::createCPUDevice(const CpuOptions &options) {
   FUSILLI_LOG_LABEL_ENDL("INFO: Creating per-handle IREE HAL device");
 
-  // Create a driver from the global driver registry.
+  FUSILLI_RETURN_ERROR_IF(options.inlineExecution && options.hasTopology(),
+                          ErrorCode::InvalidArgument,
+                          "CpuOptions worker topology cannot be set with "
+                          "inline execution");
+
+  // Create a driver from the global driver registry, or one with the
+  // requested task executor topology.
   iree_hal_driver_t *driver = nullptr;
-  FUSILLI_CHECK_ERROR(iree_hal_driver_registry_try_create(
-      iree_hal_driver_registry_default(),
-      iree_make_cstring_view(kHalDriver.at(backend_)), iree_allocator_system(),
-      &driver));
+  if (options.hasTopology()) {
+    FUSILLI_ASSIGN_OR_RETURN(driver, createCpuTaskDriver(options));
+  } else {
+    const char *driverName = options.inlineExecution ? kCpuInlineHalDriver
+                                                     : kHalDriver.at(backend_);
+    FUSILLI_CHECK_ERROR(iree_hal_driver_registry_try_create(
+        iree_hal_driver_registry_default(),
+        iree_make_cstring_view(driverName), iree_allocator_system(), &driver));
+  }
 
   // Create a proactor pool for async I/O.
   iree_async_proactor_pool_t *proactorPool = nullptr;
@@ -153,7 +280,8 @@ inline ErrorObject Handle::createCPUDevice() {
 
   // Wrap the raw device ptr with a unique_ptr and custom deleter
   // for lifetime management.
-  device_ = IreeHalDeviceUniquePtrType(rawDevice);
+  device_ = std::make_shared<detail::SharedDevice>();
+  device_->device = IreeHalDeviceUniquePtrType(rawDevice);
 
   return ok();
 }
@@ -171,8 +299,61 @@ inline ErrorObject Handle::createDeviceGroup() {
   iree_hal_device_group_t *rawDeviceGroup = nullptr;
   FUSILLI_CHECK_ERROR(iree_hal_device_group_create_from_device(
       getDevice(), frontierTracker.get(), allocator, &rawDeviceGroup));
-  deviceGroup_ = IreeHalDeviceGroupUniquePtrType(rawDeviceGroup);
+  device_->deviceGroup = IreeHalDeviceGroupUniquePtrType(rawDeviceGroup);
+
+  return ok();
+}
 
+inline ErrorOr<IreeVmModuleUniquePtrType> Handle::getHalModule() const {
+  std::lock_guard<std::mutex> lock(device_->halModuleMutex);
+  if (!device_->halModule) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Creating per-device IREE HAL module");
+    iree_vm_module_t *halModule = nullptr;
+    FUSILLI_CHECK_ERROR(iree_hal_module_create(
+        getInstance(), iree_hal_module_device_policy_default(),
+        getDeviceGroup(), IREE_HAL_MODULE_FLAG_NONE,
+        iree_hal_module_debug_sink_null(), iree_allocator_system(),
+        &halModule));
+    device_->halModule = IreeVmModuleUniquePtrType(halModule);
+  }
+  iree_vm_module_retain(device_->halModule.get());
+  return ok(IreeVmModuleUniquePtrType(device_->halModule.get()));
+}
+
+inline ErrorOr<Handle::WorkspaceLease>
+Handle::acquireWorkspace(size_t minSize) const {
+  std::lock_guard<std::mutex> lock(workspaceArena_->mutex);
+  if (workspaceArena_->size < minSize) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Growing handle workspace arena to "
+                           << minSize << " bytes");
+    // Executions still using the smaller buffers retain them until they
+    // complete.
+    workspaceArena_->idle.clear();
+    workspaceArena_->size = minSize;
+  }
+  size_t size = workspaceArena_->size;
+  if (!workspaceArena_->idle.empty()) {
+    std::shared_ptr<Buffer> buffer = std::move(workspaceArena_->idle.back());
+    workspaceArena_->idle.pop_back();
+    return ok(WorkspaceLease(this, std::move(buffer), size));
+  }
+  FUSILLI_ASSIGN_OR_RETURN(Buffer buffer, Buffer::allocateRaw(*this, size));
+  return ok(
+      WorkspaceLease(this, std::make_shared<Buffer>(std::move(buffer)), size));
+}
+
+inline void Handle::releaseWorkspace(std::shared_ptr<Buffer> buffer,
+                                     size_t size) const {
+  std::lock_guard<std::mutex> lock(workspaceArena_->mutex);
+  if (size == workspaceArena_->size)
+    workspaceArena_->idle.push_back(std::move(buffer));
+}
+
+inline ErrorObject Handle::synchronize() const {
+  FUSILLI_CHECK_ERROR(
+      iree_hal_device_wait_idle(getDevice(), iree_infinite_timeout()));
+  for (const Handle &queue : extraQueues_)
+    FUSILLI_CHECK_ERROR(queue.synchronize());
   return ok();
 }
 
@@ -222,7 +403,8 @@ inline ErrorObject Handle::createAMDGPUDevice(int deviceId, uintptr_t stream) {
 
   // Wrap the raw device ptr with a unique_ptr and custom deleter
   // for lifetime management.
-  device_ = IreeHalDeviceUniquePtrType(rawDevice);
+  device_ = std::make_shared<detail::SharedDevice>();
+  device_->device = IreeHalDeviceUniquePtrType(rawDevice);
   return ok();
 #else
   return ErrorObject(ErrorCode::InternalError,
@@ -243,78 +425,225 @@ inline ErrorObject Graph::createVmContext(const Handle &handle) {
   // Create a context even if one was created earlier, since the handle
   // (hence device) might have changed and we might be re-compiling the graph
   // for the new device.
+  FUSILLI_TRACE_ZONE("fusilli::Graph::createVmContext");
+  FUSILLI_TRACE_ZONE_TEXT(getName());
   FUSILLI_LOG_LABEL_ENDL("INFO: Creating per-graph IREE VM context");
   iree_allocator_t allocator = iree_allocator_system();
 
-  // Create the context and immediately take ownership via unique_ptr so
-  // any early return from module registration or loading cleans up.
-  iree_vm_context_t *rawContext = nullptr;
-  FUSILLI_CHECK_ERROR(iree_vm_context_create(
-      handle.getInstance(), IREE_VM_CONTEXT_FLAG_NONE, allocator, &rawContext));
-  vmContext_ = IreeVmContextUniquePtrType(rawContext);
-
-  // Create HAL module and register it with the context.
-  {
-    iree_vm_module_t *halModule = nullptr;
-    FUSILLI_CHECK_ERROR(iree_hal_module_create(
-        handle.getInstance(), iree_hal_module_device_policy_default(),
-        handle.getDeviceGroup(), IREE_HAL_MODULE_FLAG_NONE,
-        iree_hal_module_debug_sink_null(), allocator, &halModule));
-    iree_status_t status = iree_vm_context_register_modules(
-        vmContext_.get(), /*module_count=*/1, &halModule);
-    iree_vm_module_release(halModule);
-    FUSILLI_CHECK_ERROR(status);
+  // Drop the contexts and modules of a previously loaded artifact.
+  vmContextPool_.reset();
+  vmContext_.reset();
+  bytecodeModule_.reset();
+  parametersModule_.reset();
+  halModule_.reset();
+  vmInstance_ = handle.instance_;
+
+  // Share the HAL module of the device, held by the graph so that pooled
+  // contexts (see `createPooledVmContext()`) use it too.
+  FUSILLI_ASSIGN_OR_RETURN(halModule_, handle.getHalModule());
+
+  // Serve the parameters loaded on the handle (see `Handle::loadParameters()`)
+  // to the globals the graph reads them into.
+  if (!handle.parameters_->empty()) {
+    FUSILLI_ASSIGN_OR_RETURN(parametersModule_,
+                             handle.parameters_->getModule(
+                                 handle.getInstance()));
+  } else {
+    for (const auto &input : fullGraphInputsSorted_)
+      FUSILLI_RETURN_ERROR_IF(input->isParameter(), ErrorCode::NotFound,
+                              "Graph input '" + input->getName() +
+                                  "' reads a parameter, but no parameter "
+                                  "archive was loaded on the handle");
   }
 
   // Create a bytecode module from the graph-owned VMFB bytes.
   FUSILLI_LOG_LABEL_ENDL("INFO: Loading bytecode module into IREE VM context");
   {
     iree_vm_module_t *bytecodeModule = nullptr;
-    iree_status_t status = iree_vm_bytecode_module_create(
+    FUSILLI_CHECK_ERROR(iree_vm_bytecode_module_create(
         handle.getInstance(), IREE_VM_BYTECODE_MODULE_FLAG_NONE,
         iree_make_const_byte_span(loadedArtifactBytes_.data(),
                                   loadedArtifactBytes_.size()),
-        iree_allocator_null(), allocator, &bytecodeModule);
-    FUSILLI_CHECK_ERROR(status);
+        iree_allocator_null(), allocator, &bytecodeModule));
+    bytecodeModule_ = IreeVmModuleUniquePtrType(bytecodeModule);
+  }
 
-    status =
-        iree_vm_context_register_modules(vmContext_.get(),
-                                         /*module_count=*/1, &bytecodeModule);
-    iree_vm_module_release(bytecodeModule);
-    FUSILLI_CHECK_ERROR(status);
+  // Create the primary context with both modules registered.
+  FUSILLI_ASSIGN_OR_RETURN(vmContext_, createPooledVmContext());
+  vmContextPool_ = std::make_shared<VmContextPool>();
+
+  return resolveEntryPoint(handle);
+}
+
+// Share the VM context and modules of `module` with this graph, and resolve
+// the function of this graph in them.
+inline ErrorObject Graph::shareVmContext(const Handle &handle,
+                                         const Graph &module) {
+  FUSILLI_TRACE_ZONE("fusilli::Graph::shareVmContext");
+  FUSILLI_TRACE_ZONE_TEXT(getName());
+  vmInstance_ = module.vmInstance_;
+  iree_vm_module_retain(module.halModule_.get());
+  halModule_ = IreeVmModuleUniquePtrType(module.halModule_.get());
+  if (module.parametersModule_) {
+    iree_vm_module_retain(module.parametersModule_.get());
+    parametersModule_ =
+        IreeVmModuleUniquePtrType(module.parametersModule_.get());
   }
+  iree_vm_module_retain(module.bytecodeModule_.get());
+  bytecodeModule_ = IreeVmModuleUniquePtrType(module.bytecodeModule_.get());
+  iree_vm_context_retain(module.vmContext_.get());
+  vmContext_ = IreeVmContextUniquePtrType(module.vmContext_.get());
+  vmContextPool_ = module.vmContextPool_;
+  return resolveEntryPoint(handle);
+}
 
-  // Resolve and cache the function handle for `module.main` or
-  // `module.main$async`.
+// Resolve the function of this graph in the loaded VM context.
+inline ErrorObject Graph::resolveEntryPoint(const Handle &handle) {
+  iree_allocator_t allocator = iree_allocator_system();
+
+  // Resolve and cache the function handle for `module.<entry point>` or
+  // `module.<entry point>$async`.
   bool executeAsync = kBackendExecuteAsync.at(handle.getBackend());
+  std::string syncName = "module." + entryPoint_;
+  std::string asyncName = syncName + "$async";
   iree_vm_function_t function;
   FUSILLI_CHECK_ERROR(iree_vm_context_resolve_function(
       vmContext_.get(),
-      iree_make_cstring_view(executeAsync ? "module.main$async"
-                                          : "module.main"),
+      iree_make_cstring_view(executeAsync ? asyncName.c_str()
+                                          : syncName.c_str()),
       &function));
   vmFunction_ = function;
 
+  // Resolve the data-dependent workspace size function, if the module has one
+  // (see `queryTransientSize()`). Like the constant size, it is named in the
+  // reflection attributes of the async entry point.
+  transientSizeFunction_.reset();
+  {
+    iree_vm_function_t asyncFunction;
+    FUSILLI_CHECK_ERROR(iree_vm_context_resolve_function(
+        vmContext_.get(), iree_make_cstring_view(asyncName.c_str()),
+        &asyncFunction));
+    iree_string_view_t sizeFunctionName = iree_vm_function_lookup_attr_by_name(
+        &asyncFunction, IREE_SV("iree.abi.transients.size"));
+    if (!iree_string_view_is_empty(sizeFunctionName)) {
+      std::string qualifiedName =
+          "module." + std::string(sizeFunctionName.data,
+                                  sizeFunctionName.size);
+      iree_vm_function_t sizeFunction;
+      FUSILLI_CHECK_ERROR(iree_vm_context_resolve_function(
+          vmContext_.get(), iree_make_cstring_view(qualifiedName.c_str()),
+          &sizeFunction));
+      transientSizeFunction_ = sizeFunction;
+    }
+  }
+
   // Pre-compute the VM input list capacity for execute().
   vmInputListCapacity_ = 0;
   // Count the number of output buffers.
   for (const auto &output : fullGraphOutputsSorted_)
-    if (!output->isVirtual())
+    if (!output->isVirtual() && !output->isInPlace())
       vmInputListCapacity_++;
   // Count the number of input buffers.
   for (const auto &input : fullGraphInputsSorted_)
-    if (!input->isScalar())
+    if (!input->isEmbedded())
       vmInputListCapacity_++;
   // Count the workspace buffer (or null ref when size = 0).
   vmInputListCapacity_++;
-  // Count the wait fence and signal fence for asynchronous execution.
-  if (executeAsync)
+  // Count the wait fence and signal fence for asynchronous execution, and
+  // create the already signaled (zero timepoint) fences passed for them.
+  dummyWaitFence_.reset();
+  dummySignalFence_.reset();
+  if (executeAsync) {
     vmInputListCapacity_ += 2;
+    constexpr iree_host_size_t kDummyFenceCapacity = 0;
+    iree_hal_fence_t *waitFence = nullptr;
+    FUSILLI_CHECK_ERROR(
+        iree_hal_fence_create(kDummyFenceCapacity, allocator, &waitFence));
+    dummyWaitFence_ = IreeHalFenceUniquePtrType(waitFence);
+    iree_hal_fence_t *signalFence = nullptr;
+    FUSILLI_CHECK_ERROR(
+        iree_hal_fence_create(kDummyFenceCapacity, allocator, &signalFence));
+    dummySignalFence_ = IreeHalFenceUniquePtrType(signalFence);
+  }
 
   return ok();
 }
 
+inline ErrorOr<IreeVmContextUniquePtrType>
+Graph::createPooledVmContext(iree_vm_module_t *halModule) const {
+  // Modules are registered in dependency order: the bytecode module imports
+  // from the HAL and parameters modules.
+  std::vector<iree_vm_module_t *> modules = {halModule ? halModule
+                                                       : halModule_.get()};
+  if (parametersModule_)
+    modules.push_back(parametersModule_.get());
+  modules.push_back(bytecodeModule_.get());
+  iree_vm_context_t *rawContext = nullptr;
+  FUSILLI_CHECK_ERROR(iree_vm_context_create_with_modules(
+      vmInstance_.get(), IREE_VM_CONTEXT_FLAG_NONE, modules.size(),
+      modules.data(), iree_allocator_system(), &rawContext));
+  return ok(IreeVmContextUniquePtrType(rawContext));
+}
+
+inline ErrorOr<Graph::VmContextLease>
+Graph::acquireVmContext(const Handle &handle, size_t queue) const {
+  // Fast path: the primary context is idle.
+  if (queue == 0 &&
+      !vmContextPool_->primaryBusy.test_and_set(std::memory_order_acquire)) {
+    iree_vm_context_retain(vmContext_.get());
+    return ok(VmContextLease(this, queue,
+                             IreeVmContextUniquePtrType(vmContext_.get())));
+  }
+  iree_vm_module_t *halModule = halModule_.get();
+  {
+    std::lock_guard<std::mutex> lock(vmContextPool_->mutex);
+    VmContextPool &pool = *vmContextPool_;
+    if (pool.idle.size() < handle.getQueueCount()) {
+      pool.idle.resize(handle.getQueueCount());
+      pool.queueHalModules.resize(handle.getQueueCount() - 1);
+    }
+    if (!pool.idle[queue].empty()) {
+      IreeVmContextUniquePtrType context = std::move(pool.idle[queue].back());
+      pool.idle[queue].pop_back();
+      return ok(VmContextLease(this, queue, std::move(context)));
+    }
+    // The HAL module dispatches to the device of the queue.
+    if (queue > 0) {
+      IreeVmModuleUniquePtrType &queueModule = pool.queueHalModules[queue - 1];
+      if (!queueModule) {
+        FUSILLI_ASSIGN_OR_RETURN(queueModule,
+                                 handle.getQueue(queue).getHalModule());
+      }
+      halModule = queueModule.get();
+    }
+  }
+  FUSILLI_LOG_LABEL_ENDL("INFO: Creating pooled IREE VM context for queue "
+                         << queue);
+  FUSILLI_ASSIGN_OR_RETURN(IreeVmContextUniquePtrType context,
+                           createPooledVmContext(halModule));
+  return ok(VmContextLease(this, queue, std::move(context)));
+}
+
+inline void
+Graph::releaseVmContext(size_t queue,
+                        IreeVmContextUniquePtrType context) const {
+  if (context.get() == vmContext_.get()) {
+    // Drops the reference retained by acquireVmContext().
+    context.reset();
+    vmContextPool_->primaryBusy.clear(std::memory_order_release);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(vmContextPool_->mutex);
+  vmContextPool_->idle[queue].push_back(std::move(context));
+}
+
 inline ErrorOr<std::optional<size_t>> Graph::getWorkspaceSize() {
+  FUSILLI_RETURN_ERROR_IF(pendingCompile_.isPending(), ErrorCode::NotCompiled,
+                          "Graph::getWorkspaceSize called while compileAsync() "
+                          "is pending");
+  // Once loaded, `compileOnFirstUse()` queries the size itself.
+  if (vmContext_ == nullptr)
+    FUSILLI_CHECK_ERROR(compileOnFirstUse());
   if (vmContext_ == nullptr)
     return ok(std::optional<size_t>());
 
@@ -322,6 +651,13 @@ inline ErrorOr<std::optional<size_t>> Graph::getWorkspaceSize() {
   FUSILLI_ASSIGN_OR_RETURN(size_t workspaceSize, queryTransientSize());
   if (!workspaceSize_.has_value() || workspaceSize > *workspaceSize_)
     workspaceSize_ = workspaceSize;
+  if (workspaceSize > workspaceMemory_.getBytes())
+    workspaceMemory_.resize(workspaceSize);
+  // A workspace sized for the graph also fits the specializations it may
+  // dispatch to (queried when they were compiled).
+  for (const Specialization &specialization : specializations_)
+    workspaceSize_ = std::max(
+        *workspaceSize_, specialization.graph->workspaceSize_.value_or(0));
 
   return ok(workspaceSize_);
 }
@@ -334,16 +670,17 @@ inline ErrorOr<std::optional<size_t>> Graph::getWorkspaceSizeOrError() {
 // module. The --iree-torch-externalize-transients compiler flag adds an
 // attribute "iree.abi.transients.size.constant" with the required buffer size
 // for the constant workspace size case, or an "iree.abi.transients.size"
-// function for the data-dependent workspace size case. Only the former is
-// supported by Fusilli at the moment.
+// function for the data-dependent workspace size case. The latter is invoked
+// with the bound buffers at execution, see `getRequiredWorkspaceSize()`.
 inline ErrorOr<size_t> Graph::queryTransientSize() const {
   // Always resolve the async function for attribute queries. The
   // iree.abi.transients.size.constant attribute is stored in the
   // iree.reflection dict on the @main$async entry point. The sync wrapper
   // @main is auto-generated and does not carry reflection attributes.
+  std::string asyncName = "module." + entryPoint_ + "$async";
   iree_vm_function_t mainFunc;
   FUSILLI_CHECK_ERROR(iree_vm_context_resolve_function(
-      vmContext_.get(), iree_make_cstring_view("module.main$async"),
+      vmContext_.get(), iree_make_cstring_view(asyncName.c_str()),
       &mainFunc));
 
   // First check for constant transient size attribute.
@@ -358,15 +695,13 @@ inline ErrorOr<size_t> Graph::queryTransientSize() const {
     }
   }
 
-  // Check if dynamic transient size function is present. Fusilli doesn't
-  // support dynamic transient sizes yet.
-  iree_string_view_t dynamicSizeAttr = iree_vm_function_lookup_attr_by_name(
-      &mainFunc, IREE_SV("iree.abi.transients.size"));
-  FUSILLI_RETURN_ERROR_IF(
-      !iree_string_view_is_empty(dynamicSizeAttr), ErrorCode::NotImplemented,
-      "Dynamic workspace sizes are not supported. The compiled module "
-      "requires a data-dependent transient size that must be queried at "
-      "runtime.");
+  // The dynamic transient size function is resolved by createVmContext(), and
+  // the size is only known once buffers are bound.
+  if (hasDynamicWorkspaceSize()) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Workspace size is data-dependent, queried "
+                           "at execution");
+    return ok(static_cast<size_t>(0));
+  }
 
   // No transient size attributes found, no workspace needed.
   // This is a catch-all for cases where the module was compiled without
@@ -376,52 +711,242 @@ inline ErrorOr<size_t> Graph::queryTransientSize() const {
   return ok(static_cast<size_t>(0));
 }
 
-// Executes the graph using IREE runtime. Requires a `variantPack` which is a
-// map from `TensorAttr` to `Buffer` wrapping the `iree_hal_buffer_view_t *`.
-// The `workspace` parameter provides transient storage for intermediate values
-// when required by the compiled module.
-inline ErrorObject
-Graph::execute(const Handle &handle,
-               const std::unordered_map<std::shared_ptr<TensorAttr>,
-                                        std::shared_ptr<Buffer>> &variantPack,
-               const std::shared_ptr<Buffer> &workspace) const {
-  FUSILLI_LOG_LABEL_ENDL("INFO: Executing Graph");
+inline const Graph *
+Graph::findSpecialization(std::span<Buffer *const> buffers,
+                          const Buffer *workspace) const {
+  for (const Specialization &specialization : specializations_) {
+    bool matches = true;
+    for (const auto &[uid, dims] : specialization.shapes) {
+      iree_hal_buffer_view_t *view = *buffers[uid];
+      if (iree_hal_buffer_view_shape_rank(view) != dims.size()) {
+        matches = false;
+        break;
+      }
+      for (size_t i = 0; i < dims.size() && matches; ++i)
+        matches = static_cast<int64_t>(iree_hal_buffer_view_shape_dim(
+                      view, i)) == dims[i];
+      if (!matches)
+        break;
+    }
+    if (matches)
+      return specialization.graph.get();
+  }
+  if (hotShapes_)
+    return profileShape(buffers, workspace);
+  return nullptr;
+}
+
+inline const Graph *
+Graph::profileShape(std::span<Buffer *const> buffers,
+                    const Buffer *workspace) const {
+  HotShapeProfile &profile = *hotShapes_;
+  auto getShape = [&](size_t uid) {
+    iree_hal_buffer_view_t *view = *buffers[uid];
+    std::vector<int64_t> dims(iree_hal_buffer_view_shape_rank(view));
+    for (size_t i = 0; i < dims.size(); ++i)
+      dims[i] = static_cast<int64_t>(iree_hal_buffer_view_shape_dim(view, i));
+    return dims;
+  };
+  std::vector<int64_t> key;
+  for (size_t uid : profile.dynamicUids) {
+    std::vector<int64_t> dims = getShape(uid);
+    key.push_back(static_cast<int64_t>(dims.size()));
+    key.insert(key.end(), dims.begin(), dims.end());
+  }
+
+  std::lock_guard<std::mutex> lock(profile.mutex);
+  if (auto it = profile.ready.find(key); it != profile.ready.end()) {
+    // A provided workspace is sized with `getWorkspaceSize()`, which doesn't
+    // cover specializations compiled afterwards.
+    const Graph *specialization = it->second.get();
+    if (workspace != nullptr &&
+        iree_hal_buffer_byte_length(iree_hal_buffer_view_buffer(*workspace)) <
+            specialization->workspaceSize_.value_or(0))
+      return nullptr;
+    return specialization;
+  }
+  if (++profile.counts[key] != profile.threshold ||
+      profile.launched >= profile.maxSpecializations)
+    return nullptr;
+
+  ShapeBucket bucket;
+  for (size_t uid : profile.dynamicUids)
+    bucket.emplace(tensorsByUid_[uid], getShape(uid));
+  ErrorOr<std::string> generatedAsm = emitSpecializedAsm(bucket);
+  if (isError(generatedAsm)) {
+    FUSILLI_LOG_LABEL_ENDL("WARNING: Not specializing hot shape: "
+                           << ErrorObject(generatedAsm));
+    return nullptr;
+  }
+  Specialization specialization = makeSpecialization(bucket);
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling hot-shape specialization \""
+                         << specialization.graph->getName()
+                         << "\" in the background");
+  profile.launched++;
+  profile.pending.push_back(std::async(
+      std::launch::async,
+      [&profile, key = std::move(key),
+       graph = std::move(specialization.graph),
+       generatedAsm = std::move(*generatedAsm)]() mutable {
+        ErrorObject status = [&]() -> ErrorObject {
+          FUSILLI_ASSIGN_OR_RETURN(
+              CompiledArtifact artifact,
+              graph->compileGeneratedAsm(profile.handle->getBackend(),
+                                         profile.options, generatedAsm,
+                                         profile.remove));
+          FUSILLI_CHECK_ERROR(graph->loadCompiledArtifact(*profile.handle,
+                                                          std::move(artifact)));
+          FUSILLI_CHECK_ERROR(graph->getWorkspaceSize());
+          return ok();
+        }();
+        if (isError(status)) {
+          FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to compile hot-shape "
+                                 "specialization: "
+                                 << status);
+          return;
+        }
+        std::lock_guard<std::mutex> lock(profile.mutex);
+        profile.ready.emplace(std::move(key), std::move(graph));
+      }).share());
+  return nullptr;
+}
+
+inline ErrorObject Graph::checkExecutable() const {
+  FUSILLI_CHECK_ERROR(compileOnFirstUse());
+  FUSILLI_RETURN_ERROR_IF(pendingCompile_.isPending(), ErrorCode::NotCompiled,
+                          "Graph::execute called while compileAsync() is "
+                          "pending");
   FUSILLI_RETURN_ERROR_IF(vmContext_ == nullptr, ErrorCode::NotCompiled,
                           "Graph::execute requires a successful compile() first"
                           " (VM context not created)");
   FUSILLI_RETURN_ERROR_IF(!vmFunction_.has_value(), ErrorCode::NotCompiled,
                           "Graph::execute requires a successful compile() first"
                           " (VM function not resolved)");
-
-  if (!kBackendExecuteAsync.contains(handle.getBackend())) // C++20
-    return ErrorObject(ErrorCode::InternalError,
-                       "Graph::execute got an unknown backend");
   FUSILLI_RETURN_ERROR_IF(!loadedBackend_.has_value(), ErrorCode::NotCompiled,
                           "Graph::execute requires a successful compile() first"
                           " (loaded backend not set)");
-  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != *loadedBackend_,
-                          ErrorCode::InvalidArgument,
-                          "Graph::execute got a handle for backend " +
-                              kBackendToStr.at(handle.getBackend()) +
-                              ", but the loaded artifact uses backend " +
-                              kBackendToStr.at(*loadedBackend_));
-  bool executeAsync = kBackendExecuteAsync.at(handle.getBackend());
+  if (!kBackendExecuteAsync.contains(*loadedBackend_)) // C++20
+    return ErrorObject(ErrorCode::InternalError,
+                       "Graph::execute got an unknown backend");
   FUSILLI_RETURN_ERROR_IF(
       !workspaceSize_.has_value(), ErrorCode::InvalidArgument,
       "Graph::execute requires getWorkspaceSize() to be called before "
       "workspace allocation and execution");
+  return ok();
+}
 
-  iree_allocator_t allocator = iree_allocator_system();
+inline ErrorOr<size_t>
+Graph::getRequiredWorkspaceSize(iree_vm_context_t *context,
+                                std::span<Buffer *const> buffers) const {
+  if (!transientSizeFunction_.has_value())
+    return ok(*workspaceSize_);
 
-  // Create input list. No output list needed since compiled functions write
-  // results in-place to the buffer views passed as inputs (void return).
-  iree_vm_list_t *rawInputList = nullptr;
+  // The size function takes the buffer views of the main function (without
+  // the workspace and fences) and returns the size in bytes.
+  iree_vm_list_t *rawArgs = nullptr;
   FUSILLI_CHECK_ERROR(iree_vm_list_create(iree_vm_make_undefined_type_def(),
-                                          vmInputListCapacity_, allocator,
-                                          &rawInputList));
-  // The unique_ptr ensures the list is released on all exit paths
-  // (success or error).
-  IreeVmListUniquePtrType inputList(rawInputList);
+                                          buffers.size(),
+                                          iree_allocator_system(), &rawArgs));
+  IreeVmListUniquePtrType args(rawArgs);
+  for (Buffer *buffer : buffers) {
+    iree_vm_ref_t ref = iree_hal_buffer_view_retain_ref(*buffer);
+    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(args.get(), &ref));
+  }
+  iree_vm_list_t *rawResults = nullptr;
+  FUSILLI_CHECK_ERROR(iree_vm_list_create(iree_vm_make_undefined_type_def(),
+                                          /*initial_capacity=*/1,
+                                          iree_allocator_system(),
+                                          &rawResults));
+  IreeVmListUniquePtrType results(rawResults);
+  FUSILLI_CHECK_ERROR(iree_vm_invoke(
+      context, *transientSizeFunction_, IREE_VM_INVOCATION_FLAG_NONE,
+      /*policy=*/nullptr, args.get(), results.get(), iree_allocator_system()));
+
+  iree_vm_value_t size;
+  FUSILLI_CHECK_ERROR(iree_vm_list_get_value_as(
+      results.get(), /*i=*/0, IREE_VM_VALUE_TYPE_I64, &size));
+  FUSILLI_RETURN_ERROR_IF(size.i64 < 0, ErrorCode::RuntimeFailure,
+                          "Transient size function returned a negative "
+                          "size: " +
+                              std::to_string(size.i64));
+  FUSILLI_LOG_LABEL_ENDL("INFO: Workspace size required for the bound "
+                         "shapes: "
+                         << size.i64 << " bytes");
+  return ok(static_cast<size_t>(size.i64));
+}
+
+inline ErrorOr<Handle::WorkspaceLease>
+Graph::resolveWorkspace(const Handle &queueHandle,
+                        const std::shared_ptr<Buffer> &workspace,
+                        size_t requiredSize) const {
+  if (workspace != nullptr || requiredSize == 0)
+    return ok(Handle::WorkspaceLease(/*handle=*/nullptr, workspace, 0));
+  return queueHandle.acquireWorkspace(requiredSize);
+}
+
+inline ErrorObject Graph::pushArguments(iree_vm_list_t *list,
+                                        std::span<Buffer *const> buffers,
+                                        const Buffer *workspace,
+                                        size_t requiredSize,
+                                        iree_hal_fence_t *waitFence,
+                                        iree_hal_fence_t *signalFence) const {
+  // Populate output and input buffers, in UID order.
+  for (Buffer *buffer : buffers) {
+    iree_vm_ref_t ref = iree_hal_buffer_view_retain_ref(*buffer);
+    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(list, &ref));
+  }
+
+  // Push workspace buffer. The --iree-torch-externalize-transients flag always
+  // adds a !hal.buffer argument to the generated function signature, even when
+  // no transient storage is needed (size = 0). We must always push a buffer
+  // (or null ref when size = 0) to satisfy the function signature.
+  if (requiredSize > 0) {
+    FUSILLI_RETURN_ERROR_IF(
+        workspace == nullptr, ErrorCode::InvalidArgument,
+        "Workspace buffer required but not provided (size=" +
+            std::to_string(requiredSize) + " bytes)");
+    iree_hal_buffer_t *halBuffer = iree_hal_buffer_view_buffer(*workspace);
+    FUSILLI_RETURN_ERROR_IF(
+        iree_hal_buffer_byte_length(halBuffer) < requiredSize,
+        ErrorCode::InvalidArgument,
+        "Workspace buffer too small: provided " +
+            std::to_string(iree_hal_buffer_byte_length(halBuffer)) +
+            " bytes, required " + std::to_string(requiredSize) + " bytes");
+    iree_vm_ref_t bufferRef = iree_hal_buffer_retain_ref(halBuffer);
+    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(list, &bufferRef));
+  } else {
+    // Size is 0 - no workspace needed. Accept (and ignore) a non-null
+    // workspace buffer for caller convenience.
+    if (workspace != nullptr)
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Workspace buffer provided but not "
+                             "needed (size=0), ignoring");
+    // Push a null ref to satisfy IREE function signature.
+    iree_vm_ref_t nullRef = iree_vm_ref_null();
+    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(list, &nullRef));
+  }
+
+  // In the asynchronous case, the IREE generated `@main$async` function
+  // expects two additional `hal.fence` arguments. Unless `executeAsync()`
+  // provides real fences, we rely on stream-ordered synchronization and pass
+  // the already signaled dummies created by createVmContext(), just to align
+  // with the function signature without doing anything useful.
+  if (kBackendExecuteAsync.at(*loadedBackend_)) {
+    iree_vm_ref_t waitFenceRef = iree_hal_fence_retain_ref(
+        waitFence ? waitFence : dummyWaitFence_.get());
+    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(list, &waitFenceRef));
+    iree_vm_ref_t signalFenceRef = iree_hal_fence_retain_ref(
+        signalFence ? signalFence : dummySignalFence_.get());
+    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(list, &signalFenceRef));
+  }
+  return ok();
+}
+
+inline ErrorOr<std::vector<Buffer *>> Graph::getBoundBuffers(
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>> &variantPack) const {
+  // Look up the buffers in UID order (see `tensorsByUid_`).
+  std::vector<Buffer *> buffers;
+  buffers.reserve(tensorsByUid_.size());
 
   // Populate output buffers.
   for (const auto &output : fullGraphOutputsSorted_) {
@@ -433,98 +958,418 @@ Graph::execute(const Handle &handle,
                               "Virtual output tensor found in variantPack");
       continue;
     }
+    // In-place outputs are written into the buffer of their input, so they
+    // may only be bound to that buffer.
+    if (output->isInPlace()) {
+      auto it = variantPack.find(output);
+      auto inputIt = variantPack.find(output->getInPlace());
+      FUSILLI_RETURN_ERROR_IF(
+          it != variantPack.end() &&
+              (inputIt == variantPack.end() || it->second != inputIt->second),
+          ErrorCode::VariantPackError,
+          "In-place output tensor bound to a buffer other than its input's");
+      continue;
+    }
     FUSILLI_RETURN_ERROR_IF(!variantPack.contains(output), // C++20
                             ErrorCode::VariantPackError,
                             "Output tensor missing from variantPack");
-    iree_vm_ref_t ref =
-        iree_hal_buffer_view_retain_ref(*(variantPack.at(output)));
-    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(inputList.get(), &ref));
+    buffers.push_back(variantPack.at(output).get());
   }
 
   // Populate input buffers.
   for (const auto &input : fullGraphInputsSorted_) {
-    // Scalar constants are inlined in the function and aren't exposed
-    // in the call's signature (not part of the variantPack).
-    if (input->isScalar()) {
+    // Scalar constants (unless they are runtime scalars) and tensors with
+    // constant data are embedded in the function and aren't exposed in the
+    // call's signature (not part of the variantPack).
+    if (input->isEmbedded()) {
       FUSILLI_RETURN_ERROR_IF(variantPack.contains(input),
                               ErrorCode::VariantPackError,
-                              "Scalar constant tensor found in variantPack");
+                              "Embedded constant tensor found in variantPack");
       continue;
     }
 
     FUSILLI_RETURN_ERROR_IF(!variantPack.contains(input), // C++20
                             ErrorCode::VariantPackError,
                             "Input tensor missing from variantPack");
-    iree_vm_ref_t ref =
-        iree_hal_buffer_view_retain_ref(*(variantPack.at(input)));
-    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(inputList.get(), &ref));
+    buffers.push_back(variantPack.at(input).get());
   }
+  return ok(std::move(buffers));
+}
 
-  // Push workspace buffer. The --iree-torch-externalize-transients flag always
-  // adds a !hal.buffer argument to the generated function signature, even when
-  // no transient storage is needed (size = 0). We must always push a buffer
-  // (or null ref when size = 0) to satisfy the function signature.
-  if (*workspaceSize_ > 0) {
-    FUSILLI_RETURN_ERROR_IF(
-        workspace == nullptr, ErrorCode::InvalidArgument,
-        "Workspace buffer required but not provided (size=" +
-            std::to_string(*workspaceSize_) + " bytes)");
-    iree_hal_buffer_t *halBuffer = iree_hal_buffer_view_buffer(*workspace);
-    FUSILLI_RETURN_ERROR_IF(
-        iree_hal_buffer_byte_length(halBuffer) < *workspaceSize_,
-        ErrorCode::InvalidArgument,
-        "Workspace buffer too small: provided " +
-            std::to_string(iree_hal_buffer_byte_length(halBuffer)) +
-            " bytes, required " + std::to_string(*workspaceSize_) + " bytes");
-    iree_vm_ref_t bufferRef = iree_hal_buffer_retain_ref(halBuffer);
-    FUSILLI_CHECK_ERROR(
-        iree_vm_list_push_ref_move(inputList.get(), &bufferRef));
-  } else {
-    // Size is 0 - no workspace needed. Accept (and ignore) a non-null
-    // workspace buffer for caller convenience.
-    if (workspace != nullptr)
-      FUSILLI_LOG_LABEL_ENDL("WARNING: Workspace buffer provided but not "
-                             "needed (size=0), ignoring");
-    // Push a null ref to satisfy IREE function signature.
-    iree_vm_ref_t nullRef = iree_vm_ref_null();
-    FUSILLI_CHECK_ERROR(iree_vm_list_push_ref_move(inputList.get(), &nullRef));
+inline ErrorObject
+Graph::checkBufferAlignments(const Handle &handle,
+                             std::span<Buffer *const> buffers) const {
+  for (size_t uid = 0; uid < tensorsByUid_.size(); ++uid) {
+    size_t alignment = tensorsByUid_[uid]->getAlignment();
+    if (alignment == 0)
+      continue;
+    FUSILLI_ASSIGN_OR_RETURN(uintptr_t address,
+                             buffers[uid]->getAddress(handle));
+    FUSILLI_RETURN_ERROR_IF(address % alignment != 0,
+                            ErrorCode::VariantPackError,
+                            "Buffer of tensor '" +
+                                tensorsByUid_[uid]->getName() +
+                                "' is not aligned to " +
+                                std::to_string(alignment) + " bytes");
   }
+  return ok();
+}
 
-  // In the asynchronous case, the IREE generated `@main$async` function
-  // expects two additional `hal.fence` arguments. Since we rely on
-  // stream-ordered synchronization, the fences may be dummy just to
-  // align with the function signature without doing anything useful.
-  if (executeAsync) {
-    constexpr iree_host_size_t kDummyFenceCapacity = 0;
-    // Create dummy wait fence (tells generated function that inputs are ready)
-    // that's already completed.
-    {
-      iree_hal_fence_t *waitFence;
-      FUSILLI_CHECK_ERROR(
-          iree_hal_fence_create(kDummyFenceCapacity, allocator, &waitFence));
-
-      iree_vm_ref_t waitFenceRef = iree_hal_fence_move_ref(waitFence);
-      FUSILLI_CHECK_ERROR(
-          iree_vm_list_push_ref_move(inputList.get(), &waitFenceRef));
+inline ErrorOr<IreeVmListUniquePtrType>
+Graph::buildInputList(std::span<Buffer *const> buffers,
+                      const std::shared_ptr<Buffer> &workspace,
+                      size_t requiredSize, iree_hal_fence_t *waitFence,
+                      iree_hal_fence_t *signalFence) const {
+  // Create input list. No output list needed since compiled functions write
+  // results in-place to the buffer views passed as inputs (void return).
+  iree_vm_list_t *rawInputList = nullptr;
+  FUSILLI_CHECK_ERROR(iree_vm_list_create(iree_vm_make_undefined_type_def(),
+                                          vmInputListCapacity_,
+                                          iree_allocator_system(),
+                                          &rawInputList));
+  // The unique_ptr ensures the list is released on all exit paths
+  // (success or error).
+  IreeVmListUniquePtrType inputList(rawInputList);
+  FUSILLI_CHECK_ERROR(pushArguments(inputList.get(), buffers, workspace.get(),
+                                    requiredSize, waitFence, signalFence));
+  return ok(std::move(inputList));
+}
+
+// Executes the graph using IREE runtime. Requires a `variantPack` which is a
+// map from `TensorAttr` to `Buffer` wrapping the `iree_hal_buffer_view_t *`.
+// The `workspace` parameter provides transient storage for intermediate values
+// when required by the compiled module.
+inline ErrorObject
+Graph::execute(const Handle &handle,
+               const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                        std::shared_ptr<Buffer>> &variantPack,
+               const std::shared_ptr<Buffer> &workspace,
+               size_t queueIndex) const {
+  FUSILLI_TRACE_ZONE("fusilli::Graph::execute");
+  FUSILLI_TRACE_ZONE_TEXT(getName());
+  FUSILLI_LOG_LABEL_ENDL("INFO: Executing Graph");
+  detail::ExecuteScope executeScope(*handle.executionCounters_,
+                                    *executeCount_);
+  detail::EventScope eventScope(EventPhase::Execute, eventTag_);
+  FUSILLI_CHECK_ERROR(checkExecutable());
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != *loadedBackend_,
+                          ErrorCode::InvalidArgument,
+                          "Graph::execute got a handle for backend " +
+                              kBackendToStr.at(handle.getBackend()) +
+                              ", but the loaded artifact uses backend " +
+                              kBackendToStr.at(*loadedBackend_));
+  FUSILLI_RETURN_ERROR_IF(queueIndex >= handle.getQueueCount(),
+                          ErrorCode::InvalidArgument,
+                          "Graph::execute got queue " +
+                              std::to_string(queueIndex) +
+                              " on a handle with " +
+                              std::to_string(handle.getQueueCount()) +
+                              " queues");
+  FUSILLI_ASSIGN_OR_RETURN(std::vector<Buffer *> buffers,
+                           getBoundBuffers(variantPack));
+  FUSILLI_CHECK_ERROR(checkBufferAlignments(handle, buffers));
+  if (const Graph *specialization =
+          findSpecialization(buffers, workspace.get()))
+    return specialization->execute(handle, variantPack, workspace, queueIndex);
+  FUSILLI_ASSIGN_OR_RETURN(VmContextLease context,
+                           acquireVmContext(handle, queueIndex));
+  FUSILLI_ASSIGN_OR_RETURN(size_t requiredSize,
+                           getRequiredWorkspaceSize(context.get(), buffers));
+  FUSILLI_ASSIGN_OR_RETURN(
+      Handle::WorkspaceLease resolvedWorkspace,
+      resolveWorkspace(handle.getQueue(queueIndex), workspace, requiredSize));
+  FUSILLI_ASSIGN_OR_RETURN(
+      IreeVmListUniquePtrType inputList,
+      buildInputList(buffers, resolvedWorkspace.get(), requiredSize));
+
+  // Invoke the function.
+  FUSILLI_CHECK_ERROR(iree_vm_invoke(
+      context.get(), *vmFunction_, IREE_VM_INVOCATION_FLAG_NONE,
+      /*policy=*/nullptr, inputList.get(), /*outputs=*/nullptr,
+      iree_allocator_system()));
+
+  return ok();
+}
+
+inline ErrorObject Graph::executeBatch(
+    const Handle &handle,
+    std::span<const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                       std::shared_ptr<Buffer>>>
+        variantPacks,
+    const std::shared_ptr<Buffer> &workspace) const {
+  FUSILLI_TRACE_ZONE("fusilli::Graph::executeBatch");
+  FUSILLI_TRACE_ZONE_TEXT(getName());
+  FUSILLI_LOG_LABEL_ENDL("INFO: Executing Graph on " << variantPacks.size()
+                                                     << " variant packs");
+  FUSILLI_CHECK_ERROR(checkExecutable());
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != *loadedBackend_,
+                          ErrorCode::InvalidArgument,
+                          "Graph::executeBatch got a handle for backend " +
+                              kBackendToStr.at(handle.getBackend()) +
+                              ", but the loaded artifact uses backend " +
+                              kBackendToStr.at(*loadedBackend_));
+  if (variantPacks.empty())
+    return ok();
+
+  // Look up and validate the buffers of every pack before queuing anything.
+  std::vector<std::vector<Buffer *>> packBuffers;
+  std::vector<const Graph *> specializations;
+  packBuffers.reserve(variantPacks.size());
+  specializations.reserve(variantPacks.size());
+  for (const auto &variantPack : variantPacks) {
+    FUSILLI_ASSIGN_OR_RETURN(std::vector<Buffer *> buffers,
+                             getBoundBuffers(variantPack));
+    FUSILLI_CHECK_ERROR(checkBufferAlignments(handle, buffers));
+    specializations.push_back(findSpecialization(buffers, workspace.get()));
+    packBuffers.push_back(std::move(buffers));
+  }
+
+  size_t queueIndex = handle.nextQueueIndex();
+  FUSILLI_ASSIGN_OR_RETURN(VmContextLease context,
+                           acquireVmContext(handle, queueIndex));
+  std::vector<size_t> requiredSizes(variantPacks.size(), 0);
+  size_t maxRequiredSize = 0;
+  for (size_t i = 0; i < variantPacks.size(); ++i) {
+    if (specializations[i])
+      continue;
+    FUSILLI_ASSIGN_OR_RETURN(
+        requiredSizes[i],
+        getRequiredWorkspaceSize(context.get(), packBuffers[i]));
+    maxRequiredSize = std::max(maxRequiredSize, requiredSizes[i]);
+  }
+  FUSILLI_ASSIGN_OR_RETURN(Handle::WorkspaceLease resolvedWorkspace,
+                           resolveWorkspace(handle.getQueue(queueIndex),
+                                            workspace, maxRequiredSize));
+
+  // The argument list is refilled for each invocation.
+  iree_vm_list_t *rawInputList = nullptr;
+  FUSILLI_CHECK_ERROR(iree_vm_list_create(iree_vm_make_undefined_type_def(),
+                                          vmInputListCapacity_,
+                                          iree_allocator_system(),
+                                          &rawInputList));
+  IreeVmListUniquePtrType inputList(rawInputList);
+  for (size_t i = 0; i < variantPacks.size(); ++i) {
+    detail::ExecuteScope executeScope(*handle.executionCounters_,
+                                      *executeCount_);
+    detail::EventScope eventScope(EventPhase::Execute, eventTag_);
+    if (specializations[i]) {
+      FUSILLI_CHECK_ERROR(specializations[i]->execute(
+          handle, variantPacks[i], workspace, queueIndex));
+      continue;
     }
-    // Create dummy signal fence (tells downstream consumers that kernel has
-    // ran) that's already completed.
-    {
-      iree_hal_fence_t *signalFence;
-      FUSILLI_CHECK_ERROR(
-          iree_hal_fence_create(kDummyFenceCapacity, allocator, &signalFence));
-
-      iree_vm_ref_t signalFenceRef = iree_hal_fence_move_ref(signalFence);
-      FUSILLI_CHECK_ERROR(
-          iree_vm_list_push_ref_move(inputList.get(), &signalFenceRef));
+    iree_vm_list_clear(inputList.get());
+    FUSILLI_CHECK_ERROR(pushArguments(inputList.get(), packBuffers[i],
+                                      resolvedWorkspace.get().get(),
+                                      requiredSizes[i]));
+    FUSILLI_CHECK_ERROR(iree_vm_invoke(
+        context.get(), *vmFunction_, IREE_VM_INVOCATION_FLAG_NONE,
+        /*policy=*/nullptr, inputList.get(), /*outputs=*/nullptr,
+        iree_allocator_system()));
+  }
+  return ok();
+}
+
+inline ErrorObject Graph::execute(const Handle &handle,
+                                  std::span<Buffer *const> buffers,
+                                  const Buffer *workspace) const {
+  FUSILLI_TRACE_ZONE("fusilli::Graph::execute");
+  FUSILLI_TRACE_ZONE_TEXT(getName());
+  FUSILLI_LOG_LABEL_ENDL("INFO: Executing Graph");
+  detail::ExecuteScope executeScope(*handle.executionCounters_,
+                                    *executeCount_);
+  detail::EventScope eventScope(EventPhase::Execute, eventTag_);
+  FUSILLI_CHECK_ERROR(checkExecutable());
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != *loadedBackend_,
+                          ErrorCode::InvalidArgument,
+                          "Graph::execute got a handle for backend " +
+                              kBackendToStr.at(handle.getBackend()) +
+                              ", but the loaded artifact uses backend " +
+                              kBackendToStr.at(*loadedBackend_));
+  FUSILLI_RETURN_ERROR_IF(buffers.size() != tensorsByUid_.size(),
+                          ErrorCode::VariantPackError,
+                          "Graph::execute expected " +
+                              std::to_string(tensorsByUid_.size()) +
+                              " buffers, got " +
+                              std::to_string(buffers.size()));
+  for (Buffer *buffer : buffers)
+    FUSILLI_RETURN_ERROR_IF(buffer == nullptr, ErrorCode::VariantPackError,
+                            "Graph::execute got a null buffer");
+  FUSILLI_CHECK_ERROR(checkBufferAlignments(handle, buffers));
+  if (const Graph *specialization = findSpecialization(buffers, workspace))
+    return specialization->execute(handle, buffers, workspace);
+
+  // Build the input list in stack storage when it fits, so this path does not
+  // allocate. Lists in caller storage are deinitialized rather than
+  // released.
+  alignas(iree_max_align_t) uint8_t storage[kInlineInputListStorageSize];
+  auto elementType = iree_vm_make_undefined_type_def();
+  iree_vm_list_t *inputList = nullptr;
+  IreeVmListUniquePtrType heapInputList;
+  if (iree_vm_list_storage_size(elementType, vmInputListCapacity_) <=
+      sizeof(storage)) {
+    FUSILLI_CHECK_ERROR(iree_vm_list_initialize(
+        iree_make_byte_span(storage, sizeof(storage)), elementType,
+        vmInputListCapacity_, &inputList));
+  } else {
+    FUSILLI_CHECK_ERROR(iree_vm_list_create(elementType, vmInputListCapacity_,
+                                            iree_allocator_system(),
+                                            &inputList));
+    heapInputList.reset(inputList);
+  }
+  struct InlineListDeinitializer {
+    iree_vm_list_t *list;
+    ~InlineListDeinitializer() {
+      if (list)
+        iree_vm_list_deinitialize(list);
     }
+  } deinitializer{heapInputList ? nullptr : inputList};
+
+  // Fall back to the workspace arena of the queue, see `resolveWorkspace()`.
+  size_t queue = handle.nextQueueIndex();
+  FUSILLI_ASSIGN_OR_RETURN(VmContextLease context,
+                           acquireVmContext(handle, queue));
+  FUSILLI_ASSIGN_OR_RETURN(size_t requiredSize,
+                           getRequiredWorkspaceSize(context.get(), buffers));
+  std::optional<Handle::WorkspaceLease> arena;
+  if (workspace == nullptr && requiredSize > 0) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        Handle::WorkspaceLease lease,
+        handle.getQueue(queue).acquireWorkspace(requiredSize));
+    arena.emplace(std::move(lease));
+    workspace = arena->get().get();
   }
+  FUSILLI_CHECK_ERROR(pushArguments(inputList, buffers, workspace,
+                                    requiredSize));
 
   // Invoke the function.
   FUSILLI_CHECK_ERROR(iree_vm_invoke(
-      vmContext_.get(), *vmFunction_, IREE_VM_INVOCATION_FLAG_NONE,
-      /*policy=*/nullptr, inputList.get(), /*outputs=*/nullptr, allocator));
+      context.get(), *vmFunction_, IREE_VM_INVOCATION_FLAG_NONE,
+      /*policy=*/nullptr, inputList, /*outputs=*/nullptr,
+      iree_allocator_system()));
+
+  return ok();
+}
+
+// Brackets the invocation with the timing events on the stream of the queue
+// it executes on, see `ExecutionTiming`.
+inline ErrorOr<ExecutionTiming> Graph::executeTimed(
+    const Handle &handle,
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>> &variantPack,
+    const std::shared_ptr<Buffer> &workspace) const {
+  detail::ExecuteScope executeScope(*handle.executionCounters_,
+                                    *executeCount_);
+  size_t queueIndex = handle.nextQueueIndex();
+  FUSILLI_ASSIGN_OR_RETURN(ExecutionTiming timing,
+                           ExecutionTiming::start(handle.getQueue(queueIndex)));
+  FUSILLI_CHECK_ERROR(execute(handle, variantPack, workspace, queueIndex));
+  FUSILLI_CHECK_ERROR(timing.stop());
+  return ok(std::move(timing));
+}
+
+inline ErrorOr<Fence> Graph::executeAsync(
+    const Handle &handle,
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>> &variantPack,
+    const std::shared_ptr<Buffer> &workspace, const Fence &waitFence) const {
+  FUSILLI_TRACE_ZONE("fusilli::Graph::executeAsync");
+  FUSILLI_TRACE_ZONE_TEXT(getName());
+  FUSILLI_LOG_LABEL_ENDL("INFO: Executing Graph asynchronously");
+  detail::ExecuteScope executeScope(*handle.executionCounters_,
+                                    *executeCount_);
+  detail::EventScope eventScope(EventPhase::ExecuteAsync, eventTag_);
+  FUSILLI_CHECK_ERROR(checkExecutable());
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != *loadedBackend_,
+                          ErrorCode::InvalidArgument,
+                          "Graph::executeAsync got a handle for backend " +
+                              kBackendToStr.at(handle.getBackend()) +
+                              ", but the loaded artifact uses backend " +
+                              kBackendToStr.at(*loadedBackend_));
+
+  // Synchronous backends have no fence arguments: order on the host instead.
+  if (!kBackendExecuteAsync.at(*loadedBackend_)) {
+    FUSILLI_CHECK_ERROR(waitFence.wait());
+    FUSILLI_CHECK_ERROR(execute(handle, variantPack, workspace));
+    return ok(Fence());
+  }
+
+  FUSILLI_ASSIGN_OR_RETURN(std::vector<Buffer *> buffers,
+                           getBoundBuffers(variantPack));
+  FUSILLI_CHECK_ERROR(checkBufferAlignments(handle, buffers));
+  if (const Graph *specialization =
+          findSpecialization(buffers, workspace.get()))
+    return specialization->executeAsync(handle, variantPack, workspace,
+                                        waitFence);
+
+  // Signal fence, reached once the invocation completes on the device.
+  size_t queue = handle.nextQueueIndex();
+  FUSILLI_ASSIGN_OR_RETURN(Fence signalFence,
+                           Fence::create(handle.getQueue(queue).getDevice()));
+
+  FUSILLI_ASSIGN_OR_RETURN(VmContextLease context,
+                           acquireVmContext(handle, queue));
+  FUSILLI_ASSIGN_OR_RETURN(size_t requiredSize,
+                           getRequiredWorkspaceSize(context.get(), buffers));
+  FUSILLI_ASSIGN_OR_RETURN(
+      Handle::WorkspaceLease resolvedWorkspace,
+      resolveWorkspace(handle.getQueue(queue), workspace, requiredSize));
+  FUSILLI_ASSIGN_OR_RETURN(IreeVmListUniquePtrType inputList,
+                           buildInputList(buffers, resolvedWorkspace.get(),
+                                          requiredSize, waitFence,
+                                          signalFence));
+
+  // Invoke the function, which only enqueues the work.
+  FUSILLI_CHECK_ERROR(iree_vm_invoke(
+      context.get(), *vmFunction_, IREE_VM_INVOCATION_FLAG_NONE,
+      /*policy=*/nullptr, inputList.get(), /*outputs=*/nullptr,
+      iree_allocator_system()));
+
+  return ok(std::move(signalFence));
+}
 
+inline ErrorOr<ExecutionPlan>
+Graph::bind(const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                     std::shared_ptr<Buffer>> &variantPack,
+            const std::shared_ptr<Buffer> &workspace) const {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Binding Graph execution plan");
+  FUSILLI_CHECK_ERROR(checkExecutable());
+  FUSILLI_ASSIGN_OR_RETURN(std::vector<Buffer *> buffers,
+                           getBoundBuffers(variantPack));
+  if (const Graph *specialization =
+          findSpecialization(buffers, workspace.get()))
+    return specialization->bind(variantPack, workspace);
+  // Each plan owns a VM context, so plans and `execute()` calls of the same
+  // graph may run concurrently.
+  FUSILLI_ASSIGN_OR_RETURN(IreeVmContextUniquePtrType context,
+                           createPooledVmContext());
+  // The bound shapes are fixed, so a data-dependent workspace size is only
+  // queried once.
+  FUSILLI_ASSIGN_OR_RETURN(size_t requiredSize,
+                           getRequiredWorkspaceSize(context.get(), buffers));
+  // The input list retains the bound buffers (and, in the asynchronous case,
+  // the dummy fences, which are no-ops and may be reused across calls).
+  FUSILLI_ASSIGN_OR_RETURN(IreeVmListUniquePtrType inputList,
+                           buildInputList(buffers, workspace, requiredSize));
+  return ok(ExecutionPlan(loadedArtifactOwner_, std::move(context),
+                          *vmFunction_, std::move(inputList),
+                          *loadedBackend_, executeCount_, eventTag_));
+}
+
+inline ErrorObject ExecutionPlan::run(const Handle &handle) const {
+  FUSILLI_TRACE_ZONE("fusilli::ExecutionPlan::run");
+  detail::ExecuteScope executeScope(*handle.executionCounters_,
+                                    *executeCount_);
+  detail::EventScope eventScope(EventPhase::PlanRun, eventTag_);
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != backend_,
+                          ErrorCode::InvalidArgument,
+                          "ExecutionPlan::run got a handle for backend " +
+                              kBackendToStr.at(handle.getBackend()) +
+                              ", but the bound artifact uses backend " +
+                              kBackendToStr.at(backend_));
+  FUSILLI_CHECK_ERROR(iree_vm_invoke(
+      vmContext_.get(), vmFunction_, IREE_VM_INVOCATION_FLAG_NONE,
+      /*policy=*/nullptr, inputList_.get(), /*outputs=*/nullptr,
+      iree_allocator_system()));
   return ok();
 }
 
@@ -563,6 +1408,23 @@ Buffer::allocate(const Handle &handle,
                                            bufferData.size() * sizeof(T));
   }
 
+  // With the caching allocator enabled, upload into (possibly reused) pooled
+  // device memory instead of allocating a new buffer.
+  if (handle.bufferPool_) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        Buffer buffer,
+        allocateView(handle, uploadData.data_length, bufferShape,
+                     getIreeHalElementTypeForT<T>(),
+                     detail::MemoryCategory::Buffers));
+    FUSILLI_CHECK_ERROR(iree_hal_device_transfer_h2d(
+        handle.getDevice(), uploadData.data,
+        iree_hal_buffer_view_buffer(buffer.getBufferView()), 0,
+        uploadData.data_length, IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT,
+        iree_infinite_timeout()));
+    handle.executionCounters_->recordUpload(uploadData.data_length);
+    return ok(std::move(buffer));
+  }
+
   iree_hal_buffer_view_t *rawBufferView = nullptr;
   iree_hal_buffer_params_t bufferParams = {
       // Intended usage of this buffer (transfers, dispatches, etc):
@@ -571,6 +1433,8 @@ Buffer::allocate(const Handle &handle,
       .access = IREE_HAL_MEMORY_ACCESS_ALL,
       // Where to allocate (host or device):
       .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
+      // Alignment of the allocation (see `Handle::setBufferAlignment()`):
+      .min_alignment = handle.getBufferAlignment(),
   };
   FUSILLI_CHECK_ERROR(iree_hal_buffer_view_allocate_buffer_copy(
       // IREE HAL device and allocator:
@@ -587,7 +1451,12 @@ Buffer::allocate(const Handle &handle,
       // (this Buffer object in this case):
       &rawBufferView));
 
-  return ok(Buffer(IreeHalBufferViewUniquePtrType(rawBufferView)));
+  Buffer buffer{IreeHalBufferViewUniquePtrType(rawBufferView)};
+  buffer.tracked_ = std::make_shared<detail::TrackedMemory>(
+      handle.memoryTracker_, detail::MemoryCategory::Buffers,
+      uploadData.data_length);
+  handle.executionCounters_->recordUpload(uploadData.data_length);
+  return ok(std::move(buffer));
 }
 
 //===----------------------------------------------------------------------===//
@@ -616,29 +1485,638 @@ inline ErrorOr<Buffer> Buffer::allocateRaw(const Handle &handle,
                           "Buffer::allocateRaw failed: cannot allocate "
                           "zero-size buffer");
 
-  // Allocate raw buffer using IREE HAL allocator.
-  iree_hal_buffer_t *rawBuffer = nullptr;
+  // Wrap in buffer view for API compatibility (1D i8 shape).
+  iree_hal_dim_t shape[] = {static_cast<iree_hal_dim_t>(sizeInBytes)};
+  return allocateView(handle, sizeInBytes, shape, IREE_HAL_ELEMENT_TYPE_INT_8,
+                      detail::MemoryCategory::Workspace);
+}
+
+// Factory: Allocates a typed buffer with uninitialized contents.
+inline ErrorOr<Buffer>
+Buffer::allocateUninitialized(const Handle &handle,
+                              const std::vector<iree_hal_dim_t> &bufferShape,
+                              DataType dataType) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Allocating uninitialized device buffer");
+  FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                           getIreeHalElementType(dataType));
+  iree_device_size_t byteLength = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+      bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+  FUSILLI_RETURN_ERROR_IF(byteLength == 0 || bufferShape.empty(),
+                          ErrorCode::RuntimeFailure,
+                          "Buffer::allocateUninitialized failed: cannot "
+                          "allocate a buffer with zero size");
+  return allocateView(handle, byteLength, bufferShape, elementType,
+                      detail::MemoryCategory::Buffers);
+}
+
+// Factory: Allocates a typed buffer filled with `value` on the device.
+inline ErrorOr<Buffer>
+Buffer::allocateFilled(const Handle &handle,
+                       const std::vector<iree_hal_dim_t> &bufferShape,
+                       DataType dataType, double value) {
+  FUSILLI_ASSIGN_OR_RETURN(IreeHalFillPattern pattern,
+                           getIreeHalFillPattern(dataType, value));
+  FUSILLI_ASSIGN_OR_RETURN(
+      Buffer buffer, allocateUninitialized(handle, bufferShape, dataType));
+  FUSILLI_LOG_LABEL_ENDL("INFO: Filling device buffer");
+
+  // Queue the fill and wait for it, so the buffer is ready for use on any
+  // queue (and the host) when returned, like with `Buffer::allocate`.
+  FUSILLI_ASSIGN_OR_RETURN(Fence fence, Fence::create(handle.getDevice()));
+  iree_hal_buffer_t *target =
+      iree_hal_buffer_view_buffer(buffer.getBufferView());
+  FUSILLI_CHECK_ERROR(iree_hal_device_queue_fill(
+      handle.getDevice(), IREE_HAL_QUEUE_AFFINITY_ANY,
+      iree_hal_semaphore_list_empty(), fence.getSemaphoreList(), target,
+      /*target_offset=*/0, iree_hal_buffer_byte_length(target), &pattern.bits,
+      pattern.length, IREE_HAL_FILL_FLAG_NONE));
+  FUSILLI_CHECK_ERROR(fence.wait());
+  return ok(std::move(buffer));
+}
+
+// Factory: Allocates a typed buffer holding a region of a file.
+inline ErrorOr<Buffer>
+Buffer::allocateFromFile(const Handle &handle,
+                         const std::filesystem::path &path, uint64_t offset,
+                         const std::vector<iree_hal_dim_t> &bufferShape,
+                         DataType dataType) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Uploading device buffer from file '"
+                         << path.string() << "'");
+  FUSILLI_ASSIGN_OR_RETURN(MappedFile file, MappedFile::open(path));
+  FUSILLI_ASSIGN_OR_RETURN(
+      Buffer buffer, allocateUninitialized(handle, bufferShape, dataType));
+  size_t byteLength = iree_hal_buffer_view_byte_length(buffer.getBufferView());
+  std::span<const uint8_t> bytes = file.bytes();
+  FUSILLI_RETURN_ERROR_IF(offset > bytes.size() ||
+                              byteLength > bytes.size() - offset,
+                          ErrorCode::InvalidArgument,
+                          "Buffer::allocateFromFile failed: range [" +
+                              std::to_string(offset) + ", " +
+                              std::to_string(offset + byteLength) +
+                              ") exceeds the size of '" + path.string() +
+                              "' (" + std::to_string(bytes.size()) +
+                              " bytes)");
+
+  // Alternate between two staging buffers: while the device copies one
+  // chunk, the next is read from the mapping into the other. Only the pages
+  // of the chunks in flight are resident.
+  std::array<HostTransfer, 2> inFlight;
+  for (size_t done = 0, i = 0; done < byteLength;
+       done += kFileUploadChunkSize, ++i) {
+    size_t chunkLength = std::min(kFileUploadChunkSize, byteLength - done);
+    HostTransfer &slot = inFlight[i % inFlight.size()];
+    FUSILLI_CHECK_ERROR(slot.wait());
+    FUSILLI_ASSIGN_OR_RETURN(
+        Buffer chunk,
+        buffer.subview(done, {static_cast<iree_hal_dim_t>(chunkLength)},
+                       DataType::Int8));
+    FUSILLI_ASSIGN_OR_RETURN(
+        slot, chunk.queueHostTransfer(handle, bytes.data() + offset + done,
+                                      /*readTarget=*/nullptr, chunkLength,
+                                      Fence()));
+  }
+  // Return once uploaded, like `Buffer::allocate`.
+  for (HostTransfer &transfer : inFlight)
+    FUSILLI_CHECK_ERROR(transfer.wait());
+  handle.executionCounters_->recordUpload(byteLength);
+  return ok(std::move(buffer));
+}
+
+// Factory: Queues the allocation of a typed buffer with uninitialized
+// contents on the device.
+inline ErrorOr<QueueAllocation>
+Buffer::allocateAsync(const Handle &handle,
+                      const std::vector<iree_hal_dim_t> &bufferShape,
+                      DataType dataType, const Fence &waitFence) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Queueing device buffer allocation");
+  FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                           getIreeHalElementType(dataType));
+  iree_device_size_t byteLength = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+      bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+  FUSILLI_RETURN_ERROR_IF(byteLength == 0 || bufferShape.empty(),
+                          ErrorCode::RuntimeFailure,
+                          "Buffer::allocateAsync failed: cannot allocate a "
+                          "buffer with zero size");
+
+  // The allocation is ordered on the queue like any other operation: the
+  // returned buffer is a reservation whose memory is committed once `ready`
+  // is signaled.
+  FUSILLI_ASSIGN_OR_RETURN(Fence ready, Fence::create(handle.getDevice()));
   iree_hal_buffer_params_t bufferParams = {
       .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
       .access = IREE_HAL_MEMORY_ACCESS_ALL,
       .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
+      .min_alignment = handle.getBufferAlignment(),
   };
-  FUSILLI_CHECK_ERROR(iree_hal_allocator_allocate_buffer(
-      iree_hal_device_allocator(handle.getDevice()), bufferParams, sizeInBytes,
-      &rawBuffer));
+  iree_hal_buffer_t *rawBuffer = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_device_queue_alloca(
+      handle.getDevice(), IREE_HAL_QUEUE_AFFINITY_ANY,
+      waitFence.getSemaphoreList(), ready.getSemaphoreList(),
+      IREE_HAL_ALLOCATOR_POOL_DEFAULT, bufferParams, byteLength,
+      IREE_HAL_ALLOCA_FLAG_NONE, &rawBuffer));
 
-  // Wrap in buffer view for API compatibility (1D i8 shape).
   iree_hal_buffer_view_t *bufferView = nullptr;
-  iree_hal_dim_t shape[] = {static_cast<iree_hal_dim_t>(sizeInBytes)};
-  FUSILLI_CHECK_ERROR(iree_hal_buffer_view_create(
-      rawBuffer, IREE_ARRAYSIZE(shape), shape, IREE_HAL_ELEMENT_TYPE_INT_8,
+  iree_status_t status = iree_hal_buffer_view_create(
+      rawBuffer, bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, iree_allocator_system(),
+      &bufferView);
+  iree_hal_buffer_release(rawBuffer); // buffer view now owns it
+  FUSILLI_CHECK_ERROR(status);
+
+  Buffer buffer{IreeHalBufferViewUniquePtrType(bufferView)};
+  buffer.tracked_ = std::make_shared<detail::TrackedMemory>(
+      handle.memoryTracker_, detail::MemoryCategory::Buffers, byteLength);
+  return ok(QueueAllocation{std::move(buffer), std::move(ready)});
+}
+
+// Queues the release of the buffer's device memory on the device.
+inline ErrorOr<Fence> Buffer::deallocateAsync(const Handle &handle,
+                                              const Fence &waitFence) {
+  FUSILLI_RETURN_ERROR_IF(!bufferView_, ErrorCode::InvalidArgument,
+                          "Buffer::deallocateAsync failed: buffer is empty");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Queueing device buffer deallocation");
+  FUSILLI_ASSIGN_OR_RETURN(Fence released, Fence::create(handle.getDevice()));
+  FUSILLI_CHECK_ERROR(iree_hal_device_queue_dealloca(
+      handle.getDevice(), IREE_HAL_QUEUE_AFFINITY_ANY,
+      waitFence.getSemaphoreList(), released.getSemaphoreList(),
+      iree_hal_buffer_view_buffer(getBufferView()),
+      IREE_HAL_DEALLOCA_FLAG_NONE));
+  // The queue holds its own reference until the release executes.
+  releaseStorage();
+  return ok(std::move(released));
+}
+
+// Allocates device memory for a buffer view of `byteLength` bytes. With the
+// caching allocator of `handle` enabled, the memory is a size class buffer
+// from its free lists (or newly allocated), of which the view covers the
+// first `byteLength` bytes; the buffer is returned to the free lists when the
+// `Buffer` is destroyed.
+inline ErrorOr<Buffer>
+Buffer::allocateView(const Handle &handle, size_t byteLength,
+                     std::span<const iree_hal_dim_t> shape,
+                     iree_hal_element_type_t elementType,
+                     detail::MemoryCategory category) {
+  const std::shared_ptr<detail::BufferPool> &pool = handle.bufferPool_;
+  size_t allocationSize =
+      pool ? detail::BufferPool::getSizeClass(byteLength) : byteLength;
+
+  // Set up the storage first, so it is returned to the pool on errors.
+  Buffer buffer(IreeHalBufferViewUniquePtrType(nullptr));
+  if (pool) {
+    buffer.pooled_ = std::make_shared<detail::PooledAllocation>();
+    buffer.pooled_->pool = pool;
+    buffer.pooled_->sizeClass = allocationSize;
+    buffer.pooled_->buffer = pool->acquire(allocationSize);
+  }
+
+  iree_hal_buffer_t *rawBuffer = nullptr;
+  if (pool && buffer.pooled_->buffer) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Reusing cached device buffer of size "
+                           << allocationSize << " bytes");
+  } else {
+    // Allocate raw buffer using IREE HAL allocator.
+    iree_hal_buffer_params_t bufferParams = {
+        .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
+        .access = IREE_HAL_MEMORY_ACCESS_ALL,
+        .type = IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
+        .min_alignment = handle.getBufferAlignment(),
+    };
+    FUSILLI_CHECK_ERROR(iree_hal_allocator_allocate_buffer(
+        iree_hal_device_allocator(handle.getDevice()), bufferParams,
+        allocationSize, &rawBuffer));
+    if (pool) {
+      pool->recordAllocation(allocationSize);
+      buffer.pooled_->buffer = IreeHalBufferUniquePtrType(rawBuffer);
+    }
+  }
+  if (pool) {
+    // View the requested length of the size class buffer.
+    FUSILLI_CHECK_ERROR(iree_hal_buffer_subspan(
+        buffer.pooled_->buffer.get(), /*byte_offset=*/0, byteLength,
+        iree_allocator_system(), &rawBuffer));
+  }
+
+  iree_hal_buffer_view_t *bufferView = nullptr;
+  iree_status_t status = iree_hal_buffer_view_create(
+      rawBuffer, shape.size(), shape.data(), elementType,
       IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, iree_allocator_system(),
-      &bufferView));
+      &bufferView);
+  iree_hal_buffer_release(rawBuffer); // buffer view now owns it
+  FUSILLI_CHECK_ERROR(status);
+
+  buffer.bufferView_ = IreeHalBufferViewUniquePtrType(bufferView);
+  buffer.tracked_ = std::make_shared<detail::TrackedMemory>(
+      handle.memoryTracker_, category, allocationSize);
+  return ok(std::move(buffer));
+}
+
+namespace detail {
+
+// Returns whether `strides` (in elements) lay out `shape` densely in
+// row-major order. Strides of unit dimensions are ignored.
+inline bool isDenseRowMajor(std::span<const iree_hal_dim_t> shape,
+                            std::span<const int64_t> strides) {
+  if (strides.empty())
+    return true;
+  if (strides.size() != shape.size())
+    return false;
+  int64_t expected = 1;
+  for (size_t i = shape.size(); i-- > 0;) {
+    if (shape[i] != 1 && strides[i] != expected)
+      return false;
+    expected *= static_cast<int64_t>(shape[i]);
+  }
+  return true;
+}
 
+// Returns the shape of the storage laid out by `strides` (in elements) for
+// `shape` in row-major order, with padded rows (or any other padded dimension,
+// see `TensorAttr::hasPaddedStrides()`) extended to their stride, e.g.
+// {4, 8} for shape {4, 6} and strides {8, 1}. Returns std::nullopt when the
+// strides are not row-major with unit innermost stride. Strides of unit
+// dimensions are ignored.
+inline std::optional<std::vector<iree_hal_dim_t>>
+getRowMajorStorageShape(std::span<const iree_hal_dim_t> shape,
+                        std::span<const int64_t> strides) {
+  std::vector<iree_hal_dim_t> storageShape(shape.begin(), shape.end());
+  if (isDenseRowMajor(shape, strides))
+    return storageShape;
+  if (strides.size() != shape.size())
+    return std::nullopt;
+  int64_t expected = 1;
+  std::optional<size_t> faster;
+  for (size_t i = shape.size(); i-- > 0;) {
+    if (shape[i] == 1)
+      continue;
+    if (!faster ? strides[i] != 1
+                : strides[i] < expected || strides[i] % strides[*faster] != 0)
+      return std::nullopt;
+    if (faster)
+      storageShape[*faster] =
+          static_cast<iree_hal_dim_t>(strides[i] / strides[*faster]);
+    faster = i;
+    expected = strides[i] * static_cast<int64_t>(shape[i]);
+  }
+  return storageShape;
+}
+
+} // namespace detail
+
+// Factory: Wraps external device memory without copying.
+inline ErrorOr<Buffer>
+Buffer::importDevicePtr(const Handle &handle, void *devicePtr,
+                        const std::vector<iree_hal_dim_t> &bufferShape,
+                        DataType dataType,
+                        const std::vector<int64_t> &strides) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Importing external device pointer");
+  FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                           getIreeHalElementType(dataType));
+  // Padded strides are imported as their storage, which graphs read tensors
+  // with the same padded strides from in place.
+  std::optional<std::vector<iree_hal_dim_t>> storageShape =
+      detail::getRowMajorStorageShape(bufferShape, strides);
+  FUSILLI_RETURN_ERROR_IF(!storageShape, ErrorCode::NotImplemented,
+                          "Buffer::importDevicePtr failed: only row-major "
+                          "strides (optionally padded) are supported");
+  iree_device_size_t byteLength = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+      storageShape->size(), storageShape->data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+  // The caller owns the memory.
+  return importExternal(handle, devicePtr, byteLength, *storageShape,
+                        elementType, iree_hal_buffer_release_callback_null());
+}
+
+// Factory: Wraps host memory without copying on the CPU backend.
+template <typename T>
+inline ErrorOr<Buffer>
+Buffer::wrapHost(const Handle &handle, std::span<T> data,
+                 const std::vector<iree_hal_dim_t> &bufferShape) {
+  static_assert(!kIsSubByteElement<T>,
+                "Buffer::wrapHost requires a byte-aligned element type");
+  static_assert(!std::is_const_v<T>,
+                "Buffer::wrapHost requires writable memory");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Wrapping host memory");
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() == Backend::AMDGPU,
+                          ErrorCode::NotImplemented,
+                          "Buffer::wrapHost failed: host memory can only be "
+                          "wrapped on the CPU backend");
+  size_t expectedSize = 1;
+  for (auto dim : bufferShape)
+    expectedSize *= dim;
+  FUSILLI_RETURN_ERROR_IF(
+      bufferShape.empty() || data.size() != expectedSize,
+      ErrorCode::InvalidArgument,
+      "Buffer::wrapHost failed: data size (" + std::to_string(data.size()) +
+          ") does not match product of bufferShape dimensions (" +
+          std::to_string(expectedSize) + ")");
+  // The caller owns the memory.
+  return importExternal(handle, data.data(), data.size_bytes(), bufferShape,
+                        getIreeHalElementTypeForT<T>(),
+                        iree_hal_buffer_release_callback_null());
+}
+
+// Factory: Imports a DLPack tensor without copying, taking ownership of it.
+inline ErrorOr<Buffer> Buffer::importDLPack(const Handle &handle,
+                                            DLManagedTensor *tensor) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Importing DLPack tensor");
+  FUSILLI_RETURN_ERROR_IF(tensor == nullptr, ErrorCode::RuntimeFailure,
+                          "Buffer::importDLPack failed as tensor* is NULL");
+  const DLTensor &dl = tensor->dl_tensor;
+  DLDeviceType expectedDevice =
+      handle.getBackend() == Backend::AMDGPU ? kDLROCM : kDLCPU;
+  FUSILLI_RETURN_ERROR_IF(
+      dl.device.device_type != expectedDevice ||
+          (expectedDevice == kDLROCM &&
+           dl.device.device_id != handle.getDeviceId()),
+      ErrorCode::InvalidArgument,
+      "Buffer::importDLPack failed: tensor is not on the handle's device");
+  FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                           getIreeHalElementType(dl.dtype));
+
+  std::vector<iree_hal_dim_t> shape(dl.shape, dl.shape + dl.ndim);
+  std::vector<int64_t> strides;
+  if (dl.strides)
+    strides.assign(dl.strides, dl.strides + dl.ndim);
+  // Padded tensors (e.g. slices of rows) are imported as their storage.
+  std::optional<std::vector<iree_hal_dim_t>> storageShape =
+      detail::getRowMajorStorageShape(shape, strides);
+  FUSILLI_RETURN_ERROR_IF(!storageShape, ErrorCode::NotImplemented,
+                          "Buffer::importDLPack failed: only row-major "
+                          "tensors (optionally padded) are supported");
+  shape = std::move(*storageShape);
+  iree_device_size_t byteLength = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+      shape.size(), shape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+
+  // Hand the tensor back to its framework once IREE releases the memory.
+  iree_hal_buffer_release_callback_t release = {
+      .fn =
+          [](void *userData, iree_hal_buffer_t *) {
+            auto *managed = static_cast<DLManagedTensor *>(userData);
+            if (managed->deleter)
+              managed->deleter(managed);
+          },
+      .user_data = tensor,
+  };
+  void *data = static_cast<uint8_t *>(dl.data) + dl.byte_offset;
+  return importExternal(handle, data, byteLength, shape, elementType, release);
+}
+
+inline ErrorOr<Buffer>
+Buffer::importExternal(const Handle &handle, void *ptr, size_t byteLength,
+                       std::span<const iree_hal_dim_t> shape,
+                       iree_hal_element_type_t elementType,
+                       iree_hal_buffer_release_callback_t releaseCallback) {
+  FUSILLI_RETURN_ERROR_IF(ptr == nullptr || byteLength == 0,
+                          ErrorCode::InvalidArgument,
+                          "Buffer import failed: memory is NULL or empty");
+  bool isHost = handle.getBackend() != Backend::AMDGPU;
+  iree_hal_external_buffer_t external = {};
+  external.flags = IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE;
+  external.size = byteLength;
+  if (isHost) {
+    external.type = IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION;
+    external.handle.host_allocation.ptr = ptr;
+  } else {
+    external.type = IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION;
+    external.handle.device_allocation.ptr = reinterpret_cast<uint64_t>(ptr);
+  }
+  iree_hal_buffer_params_t bufferParams = {
+      .usage = IREE_HAL_BUFFER_USAGE_DEFAULT,
+      .access = IREE_HAL_MEMORY_ACCESS_ALL,
+      .type = isHost ? IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
+                           IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE
+                     : IREE_HAL_MEMORY_TYPE_DEVICE_LOCAL,
+  };
+  iree_hal_buffer_t *rawBuffer = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_allocator_import_buffer(
+      iree_hal_device_allocator(handle.getDevice()), bufferParams, &external,
+      releaseCallback, &rawBuffer));
+
+  iree_hal_buffer_view_t *bufferView = nullptr;
+  iree_status_t status = iree_hal_buffer_view_create(
+      rawBuffer, shape.size(), shape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, iree_allocator_system(),
+      &bufferView);
   iree_hal_buffer_release(rawBuffer); // buffer view now owns it
+  FUSILLI_CHECK_ERROR(status);
   return ok(Buffer(IreeHalBufferViewUniquePtrType(bufferView)));
 }
 
+// Exports the buffer as a DLPack tensor sharing its memory.
+// Returns the address of the buffer from the exported memory of its
+// allocation, which a subview is offset into.
+inline ErrorOr<uintptr_t> Buffer::getAddress(const Handle &handle) const {
+  iree_hal_buffer_t *buffer = iree_hal_buffer_view_buffer(getBufferView());
+  bool isHost = handle.getBackend() != Backend::AMDGPU;
+  iree_hal_external_buffer_t external = {};
+  FUSILLI_CHECK_ERROR(iree_hal_allocator_export_buffer(
+      iree_hal_device_allocator(handle.getDevice()),
+      iree_hal_buffer_allocated_buffer(buffer),
+      isHost ? IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION
+             : IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION,
+      IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE, &external));
+  uintptr_t base =
+      isHost ? reinterpret_cast<uintptr_t>(external.handle.host_allocation.ptr)
+             : static_cast<uintptr_t>(external.handle.device_allocation.ptr);
+  return ok(base + static_cast<uintptr_t>(iree_hal_buffer_byte_offset(buffer)));
+}
+
+inline ErrorOr<DLManagedTensor *> Buffer::toDLPack(const Handle &handle) const {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Exporting buffer as DLPack tensor");
+  iree_hal_buffer_view_t *view = getBufferView();
+  FUSILLI_ASSIGN_OR_RETURN(
+      DLDataType dlType,
+      getDLDataType(iree_hal_buffer_view_element_type(view)));
+
+  // The memory of the allocation the buffer (maybe a subspan) is part of.
+  iree_hal_buffer_t *buffer = iree_hal_buffer_view_buffer(view);
+  bool isHost = handle.getBackend() != Backend::AMDGPU;
+  iree_hal_external_buffer_t external = {};
+  FUSILLI_CHECK_ERROR(iree_hal_allocator_export_buffer(
+      iree_hal_device_allocator(handle.getDevice()),
+      iree_hal_buffer_allocated_buffer(buffer),
+      isHost ? IREE_HAL_EXTERNAL_BUFFER_TYPE_HOST_ALLOCATION
+             : IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION,
+      IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE, &external));
+
+  // The exported tensor owns its shape and a reference to the buffer view
+  // (and through it, this buffer's pooled allocation, if any).
+  struct Exported {
+    DLManagedTensor managed;
+    std::vector<int64_t> shape;
+    IreeHalBufferViewUniquePtrType view;
+    std::shared_ptr<detail::PooledAllocation> pooled;
+  };
+  auto exported = std::make_unique<Exported>();
+  size_t rank = iree_hal_buffer_view_shape_rank(view);
+  for (size_t i = 0; i < rank; ++i)
+    exported->shape.push_back(
+        static_cast<int64_t>(iree_hal_buffer_view_shape_dim(view, i)));
+  iree_hal_buffer_view_retain(view);
+  exported->view = IreeHalBufferViewUniquePtrType(view);
+  exported->pooled = pooled_;
+
+  DLTensor &dl = exported->managed.dl_tensor;
+  dl.data = isHost ? external.handle.host_allocation.ptr
+                   : reinterpret_cast<void *>(
+                         external.handle.device_allocation.ptr);
+  dl.device = {isHost ? kDLCPU : kDLROCM, isHost ? 0 : handle.getDeviceId()};
+  dl.ndim = static_cast<int32_t>(rank);
+  dl.dtype = dlType;
+  dl.shape = exported->shape.data();
+  dl.strides = nullptr; // dense row-major
+  dl.byte_offset = iree_hal_buffer_byte_offset(buffer);
+  exported->managed.manager_ctx = exported.get();
+  exported->managed.deleter = [](DLManagedTensor *self) {
+    delete static_cast<Exported *>(self->manager_ctx);
+  };
+  return ok(&exported.release()->managed);
+}
+
+// Exports an IPC handle to the device memory of the buffer.
+inline ErrorOr<BufferIpcHandle>
+Buffer::exportIpcHandle(const Handle &handle) const {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Exporting buffer IPC handle");
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != Backend::AMDGPU,
+                          ErrorCode::NotImplemented,
+                          "Buffer::exportIpcHandle failed: IPC handles are "
+                          "only supported on the AMDGPU backend");
+  FUSILLI_ASSIGN_OR_RETURN(const detail::HipApi *hip, detail::getHipApi());
+
+  // The device pointer of the allocation the buffer (maybe a subspan) is
+  // part of, and the HIP allocation holding it, which may be larger (e.g.
+  // when pooled by the device allocator).
+  iree_hal_buffer_t *buffer = iree_hal_buffer_view_buffer(getBufferView());
+  iree_hal_external_buffer_t external = {};
+  FUSILLI_CHECK_ERROR(iree_hal_allocator_export_buffer(
+      iree_hal_device_allocator(handle.getDevice()),
+      iree_hal_buffer_allocated_buffer(buffer),
+      IREE_HAL_EXTERNAL_BUFFER_TYPE_DEVICE_ALLOCATION,
+      IREE_HAL_EXTERNAL_BUFFER_FLAG_NONE, &external));
+  void *ptr = reinterpret_cast<void *>(external.handle.device_allocation.ptr);
+  void *base = nullptr;
+  size_t rangeSize = 0;
+  FUSILLI_CHECK_ERROR(hip->check(
+      hip->hipMemGetAddressRange(&base, &rangeSize, ptr),
+      "hipMemGetAddressRange"));
+
+  detail::HipApi::hipIpcMemHandle_t memHandle;
+  FUSILLI_CHECK_ERROR(hip->check(hip->hipIpcGetMemHandle(&memHandle, base),
+                                 "hipIpcGetMemHandle"));
+  BufferIpcHandle ipc;
+  static_assert(sizeof(memHandle) == sizeof(ipc.memHandle));
+  std::memcpy(ipc.memHandle.data(), &memHandle, sizeof(memHandle));
+  ipc.byteOffset = static_cast<uint64_t>(static_cast<uint8_t *>(ptr) -
+                                         static_cast<uint8_t *>(base)) +
+                   iree_hal_buffer_byte_offset(buffer);
+  ipc.byteLength = iree_hal_buffer_view_byte_length(getBufferView());
+  return ok(ipc);
+}
+
+// Factory: Opens device memory exported by another process.
+inline ErrorOr<Buffer>
+Buffer::importIpcHandle(const Handle &handle, const BufferIpcHandle &ipc,
+                        const std::vector<iree_hal_dim_t> &bufferShape,
+                        DataType dataType) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Importing buffer IPC handle");
+  FUSILLI_RETURN_ERROR_IF(handle.getBackend() != Backend::AMDGPU,
+                          ErrorCode::NotImplemented,
+                          "Buffer::importIpcHandle failed: IPC handles are "
+                          "only supported on the AMDGPU backend");
+  FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                           getIreeHalElementType(dataType));
+  iree_device_size_t byteLength = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+      bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+  FUSILLI_RETURN_ERROR_IF(byteLength > ipc.byteLength,
+                          ErrorCode::InvalidArgument,
+                          "Buffer::importIpcHandle failed: viewing " +
+                              std::to_string(byteLength) +
+                              " bytes of an exported buffer of " +
+                              std::to_string(ipc.byteLength) + " bytes");
+
+  // The memory is mapped on the current HIP device of the thread.
+  FUSILLI_ASSIGN_OR_RETURN(const detail::HipApi *hip, detail::getHipApi());
+  FUSILLI_CHECK_ERROR(
+      hip->check(hip->hipSetDevice(handle.getDeviceId()), "hipSetDevice"));
+  detail::HipApi::hipIpcMemHandle_t memHandle;
+  std::memcpy(&memHandle, ipc.memHandle.data(), sizeof(memHandle));
+  void *base = nullptr;
+  FUSILLI_CHECK_ERROR(hip->check(
+      hip->hipIpcOpenMemHandle(&base, memHandle,
+                               detail::HipApi::hipIpcMemLazyEnablePeerAccess),
+      "hipIpcOpenMemHandle"));
+
+  // Unmap the memory once IREE releases it.
+  iree_hal_buffer_release_callback_t release = {
+      .fn =
+          [](void *userData, iree_hal_buffer_t *) {
+            if (auto hipApi = detail::getHipApi(); !isError(hipApi))
+              (*hipApi)->hipIpcCloseMemHandle(userData);
+          },
+      .user_data = base,
+  };
+  ErrorOr<Buffer> buffer =
+      importExternal(handle, static_cast<uint8_t *>(base) + ipc.byteOffset,
+                     byteLength, bufferShape, elementType, release);
+  if (isError(buffer))
+    hip->hipIpcCloseMemHandle(base);
+  return buffer;
+}
+
+// Views a region of the buffer as a typed buffer sharing its memory.
+inline ErrorOr<Buffer>
+Buffer::subview(size_t byteOffset,
+                const std::vector<iree_hal_dim_t> &bufferShape,
+                DataType dataType) const {
+  FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                           getIreeHalElementType(dataType));
+  iree_device_size_t byteLength = 0;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+      bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+  iree_device_size_t parentLength =
+      iree_hal_buffer_view_byte_length(getBufferView());
+  FUSILLI_RETURN_ERROR_IF(
+      byteLength == 0 || bufferShape.empty(), ErrorCode::InvalidArgument,
+      "Buffer::subview failed: cannot create a subview with zero size");
+  FUSILLI_RETURN_ERROR_IF(byteOffset > parentLength ||
+                              byteLength > parentLength - byteOffset,
+                          ErrorCode::InvalidArgument,
+                          "Buffer::subview failed: range [" +
+                              std::to_string(byteOffset) + ", " +
+                              std::to_string(byteOffset + byteLength) +
+                              ") exceeds the buffer size (" +
+                              std::to_string(parentLength) + " bytes)");
+
+  // The subspan retains the underlying allocation.
+  iree_hal_buffer_t *rawBuffer = nullptr;
+  FUSILLI_CHECK_ERROR(iree_hal_buffer_subspan(
+      iree_hal_buffer_view_buffer(getBufferView()), byteOffset, byteLength,
+      iree_allocator_system(), &rawBuffer));
+  iree_hal_buffer_view_t *bufferView = nullptr;
+  iree_status_t status = iree_hal_buffer_view_create(
+      rawBuffer, bufferShape.size(), bufferShape.data(), elementType,
+      IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, iree_allocator_system(),
+      &bufferView);
+  iree_hal_buffer_release(rawBuffer); // buffer view now owns it
+  FUSILLI_CHECK_ERROR(status);
+
+  Buffer view(IreeHalBufferViewUniquePtrType{bufferView});
+  // Keep pooled memory out of the caching allocator while the view is alive.
+  view.pooled_ = pooled_;
+  view.tracked_ = tracked_;
+  return ok(std::move(view));
+}
+
 // Reads device buffer by initiating a device-to-host transfer and
 // populating `outData`. For sub-byte types (Int4), unpacks the IREE dense
 // encoding (nibble-packed) back to one element per vector entry.
@@ -669,10 +2147,130 @@ inline ErrorObject Buffer::read(const Handle &handle, std::vector<T> &outData) {
         handle.getDevice(), buffer, 0, outData.data(), byteLength,
         IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT, iree_infinite_timeout()));
   }
+  handle.executionCounters_->recordRead(byteLength);
 
   return ok();
 }
 
+// Reads device buffer into caller-owned storage of one `T` per element.
+template <typename T>
+inline ErrorObject Buffer::read(const Handle &handle, std::span<T> outData) {
+  iree_host_size_t elementCount =
+      iree_hal_buffer_view_element_count(getBufferView());
+  FUSILLI_RETURN_ERROR_IF(outData.size() != elementCount,
+                          ErrorCode::InvalidArgument,
+                          "Buffer::read failed: outData holds " +
+                              std::to_string(outData.size()) +
+                              " elements but the buffer has " +
+                              std::to_string(elementCount));
+  if constexpr (kIsSubByteElement<T>) {
+    // Sub-byte: D2H of the packed encoding, then unpack into outData.
+    std::vector<uint8_t> rawBytes(
+        iree_hal_buffer_view_byte_length(getBufferView()));
+    FUSILLI_CHECK_ERROR(readBytes(handle, rawBytes.data(), rawBytes.size()));
+    T::unpack(rawBytes.data(), elementCount, outData.data());
+    return ok();
+  } else {
+    return readBytes(handle, outData.data(), outData.size_bytes());
+  }
+}
+
+// Reads the raw device buffer contents into caller-owned memory.
+inline ErrorObject Buffer::readBytes(const Handle &handle, void *outData,
+                                     size_t byteLength) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Reading device buffer through D2H transfer");
+  iree_device_size_t bufferLength =
+      iree_hal_buffer_view_byte_length(getBufferView());
+  FUSILLI_RETURN_ERROR_IF(byteLength != bufferLength,
+                          ErrorCode::InvalidArgument,
+                          "Buffer::readBytes failed: reading " +
+                              std::to_string(byteLength) +
+                              " bytes from a buffer of " +
+                              std::to_string(bufferLength) + " bytes");
+  FUSILLI_RETURN_ERROR_IF(outData == nullptr, ErrorCode::InvalidArgument,
+                          "Buffer::readBytes failed as outData is NULL");
+  FUSILLI_CHECK_ERROR(iree_hal_device_transfer_d2h(
+      handle.getDevice(), iree_hal_buffer_view_buffer(getBufferView()), 0,
+      outData, byteLength, IREE_HAL_TRANSFER_BUFFER_FLAG_DEFAULT,
+      iree_infinite_timeout()));
+  handle.executionCounters_->recordRead(byteLength);
+  return ok();
+}
+
+// Queues a device-to-host copy through a pinned staging buffer.
+template <typename T>
+inline ErrorOr<HostTransfer> Buffer::readAsync(const Handle &handle,
+                                               std::span<T> outData,
+                                               const Fence &waitFence) {
+  static_assert(!kIsSubByteElement<T>,
+                "Buffer::readAsync requires a byte-aligned element type");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Queueing async D2H transfer");
+  return queueHostTransfer(handle, /*writeSource=*/nullptr, outData.data(),
+                           outData.size_bytes(), waitFence);
+}
+
+// Queues a host-to-device copy through a pinned staging buffer.
+template <typename T>
+inline ErrorOr<HostTransfer> Buffer::writeAsync(const Handle &handle,
+                                                std::span<T> data,
+                                                const Fence &waitFence) {
+  static_assert(!kIsSubByteElement<std::remove_const_t<T>>,
+                "Buffer::writeAsync requires a byte-aligned element type");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Queueing async H2D transfer");
+  return queueHostTransfer(handle, data.data(), /*readTarget=*/nullptr,
+                           data.size_bytes(), waitFence);
+}
+
+inline ErrorOr<HostTransfer>
+Buffer::queueHostTransfer(const Handle &handle, const void *writeSource,
+                          void *readTarget, size_t byteLength,
+                          const Fence &waitFence) {
+  iree_hal_buffer_t *buffer = iree_hal_buffer_view_buffer(getBufferView());
+  iree_device_size_t bufferLength =
+      iree_hal_buffer_view_byte_length(getBufferView());
+  FUSILLI_RETURN_ERROR_IF(byteLength != bufferLength,
+                          ErrorCode::InvalidArgument,
+                          "Buffer async transfer of " +
+                              std::to_string(byteLength) +
+                              " bytes does not match the buffer size (" +
+                              std::to_string(bufferLength) + " bytes)");
+
+  // Borrow a staging buffer of the handle, allocating one on a miss.
+  const std::shared_ptr<detail::BufferPool> &pool = handle.stagingPool_;
+  size_t sizeClass = detail::BufferPool::getSizeClass(byteLength);
+  IreeHalBufferUniquePtrType staging = pool->acquire(sizeClass);
+  if (!staging) {
+    iree_hal_buffer_params_t stagingParams = {
+        .usage = IREE_HAL_BUFFER_USAGE_TRANSFER | IREE_HAL_BUFFER_USAGE_MAPPING,
+        .access = IREE_HAL_MEMORY_ACCESS_ALL,
+        // Pinned host memory the device can DMA to and from:
+        .type = IREE_HAL_MEMORY_TYPE_HOST_LOCAL |
+                IREE_HAL_MEMORY_TYPE_DEVICE_VISIBLE,
+    };
+    iree_hal_buffer_t *rawStaging = nullptr;
+    FUSILLI_CHECK_ERROR(iree_hal_allocator_allocate_buffer(
+        iree_hal_device_allocator(handle.getDevice()), stagingParams,
+        sizeClass, &rawStaging));
+    pool->recordAllocation(sizeClass);
+    staging = IreeHalBufferUniquePtrType(rawStaging);
+  }
+  if (writeSource) {
+    FUSILLI_CHECK_ERROR(iree_hal_buffer_map_write(
+        staging.get(), /*target_offset=*/0, writeSource, byteLength));
+  }
+
+  FUSILLI_ASSIGN_OR_RETURN(Fence fence, Fence::create(handle.getDevice()));
+  iree_hal_buffer_t *source = writeSource ? staging.get() : buffer;
+  iree_hal_buffer_t *target = writeSource ? buffer : staging.get();
+  FUSILLI_CHECK_ERROR(iree_hal_device_queue_copy(
+      handle.getDevice(), IREE_HAL_QUEUE_AFFINITY_ANY,
+      waitFence.getSemaphoreList(), fence.getSemaphoreList(), source,
+      /*source_offset=*/0, target, /*target_offset=*/0, byteLength,
+      IREE_HAL_COPY_FLAG_NONE));
+  return ok(HostTransfer(std::move(fence), pool, std::move(staging), sizeClass,
+                         readTarget, byteLength));
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_BACKEND_RUNTIME_H
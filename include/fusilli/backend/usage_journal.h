@@ -0,0 +1,202 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the usage journal of Fusilli: a directory holding one
+// entry per distinct graph (structure, backend and compile options) that
+// processes compiled or loaded, so that a build machine can compile every one
+// of them ahead of the next rollout (see `replayUsageJournal()`).
+//
+// The journal is enabled by setting `FUSILLI_USAGE_JOURNAL` to a directory,
+// which may be shared by every process of a deployment. Each process writes
+// an entry the first time it sees a graph, unless the entry already exists,
+// so journaling costs one file write per distinct graph and nothing on the
+// execution path.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_USAGE_JOURNAL_H
+#define FUSILLI_BACKEND_USAGE_JOURNAL_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/support/archive.h"
+#include "fusilli/support/cache.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// One graph of the usage journal.
+struct UsageJournalEntry {
+  // Graph as of `Graph::serialize()`, its name and structural fingerprint.
+  std::vector<uint8_t> graph;
+  std::string graphName;
+  std::string fingerprint;
+  // Backend and compile options (see `CompileOptions::toString()`) the graph
+  // was compiled or loaded with, and the ROCm target it ran on (empty on
+  // CPU), which the build machine need not have.
+  Backend backend = Backend::CPU;
+  std::string compileOptions;
+  std::string target;
+
+  // Reads or writes the entry from or to `ar`.
+  void archive(Archive &ar) {
+    uint32_t magic = kUsageJournalMagic;
+    uint32_t version = kUsageJournalVersion;
+    ar.io(magic).io(version);
+    if (magic != kUsageJournalMagic || version != kUsageJournalVersion) {
+      ar.fail(ErrorCode::InvalidArgument,
+              "Not a usage journal entry, or journaled by an unsupported "
+              "version of Fusilli");
+      return;
+    }
+    ar.ioBytes(graph).io(graphName).io(fingerprint).io(backend);
+    ar.io(compileOptions).io(target);
+  }
+
+  // Leading fields of the entry format. Bump the version whenever it
+  // changes.
+  static constexpr uint32_t kUsageJournalMagic = 0x46534a52; // "FSJR"
+  static constexpr uint32_t kUsageJournalVersion = 1;
+};
+
+// UsageJournal records the graphs a process compiles (see `Graph::compile()`)
+// or loads from an artifact bundle (see `ArtifactBundle::load()`) into the
+// journal directory, one file per entry named after its key, a digest of
+// everything the compiled artifact depends on.
+//
+// Usage (production):
+//   FUSILLI_USAGE_JOURNAL=/shared/fusilli-journal ./server
+//
+// Usage (build machine, see `replayUsageJournal()`):
+//   FUSILLI_ASSIGN_OR_RETURN(auto entries,
+//                            UsageJournal::read("/shared/fusilli-journal"));
+class UsageJournal {
+public:
+  static UsageJournal &get() {
+    static UsageJournal journal;
+    return journal;
+  }
+
+  bool isEnabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !dir_.empty();
+  }
+
+  // Starts journaling into `dir`, which is created when the first entry is
+  // written.
+  void enable(std::filesystem::path dir) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dir_ = std::move(dir);
+    recorded_.clear();
+  }
+
+  // Stops journaling. Written entries are kept.
+  void disable() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dir_.clear();
+  }
+
+  // Returns whether the entry with `key` has yet to be written: the journal
+  // is enabled and neither this process nor another one wrote it. Claims the
+  // key, so only the first caller of a process writes the entry.
+  bool claim(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir_.empty() || !recorded_.insert(key).second)
+      return false;
+    std::error_code ec;
+    return !std::filesystem::exists(getPath(dir_, key), ec);
+  }
+
+  // Writes `entry` under `key` (see `claim()`). Entries are replaced
+  // atomically, so processes writing the same entry concurrently are safe.
+  // Taken by value as the (symmetric) archive needs a mutable entry; move the
+  // entry in to avoid copying the serialized graph.
+  ErrorObject write(const std::string &key, UsageJournalEntry entry) {
+    std::filesystem::path path;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      FUSILLI_RETURN_ERROR_IF(dir_.empty(), ErrorCode::InvalidArgument,
+                              "Usage journal is not enabled");
+      path = getPath(dir_, key);
+    }
+    Archive ar = Archive::writer();
+    entry.archive(ar);
+    FUSILLI_CHECK_ERROR(ar.status());
+    std::vector<uint8_t> bytes = ar.takeBytes();
+    FUSILLI_LOG_LABEL_ENDL("INFO: Journaling graph '" << entry.graphName
+                                                      << "' to " << path);
+    return CacheFile::publish(path, std::string(bytes.begin(), bytes.end()));
+  }
+
+  // Reads every entry of the journal in `dir`, in the order of their keys.
+  static ErrorOr<std::vector<UsageJournalEntry>>
+  read(const std::filesystem::path &dir) {
+    std::error_code ec;
+    std::filesystem::directory_iterator it(dir, ec);
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to open usage journal: " + dir.string() +
+                                " - " + ec.message());
+    std::vector<std::filesystem::path> paths;
+    for (const auto &file : it)
+      if (file.path().extension() == kEntryExtension)
+        paths.push_back(file.path());
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<UsageJournalEntry> entries;
+    entries.reserve(paths.size());
+    for (const auto &path : paths) {
+      FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> bytes,
+                               readFileBytes(path));
+      UsageJournalEntry entry;
+      Archive ar = Archive::reader(bytes);
+      entry.archive(ar);
+      FUSILLI_CHECK_ERROR(ar.status());
+      FUSILLI_RETURN_ERROR_IF(!ar.atEnd(), ErrorCode::InvalidArgument,
+                              "Trailing bytes after usage journal entry: " +
+                                  path.string());
+      entries.push_back(std::move(entry));
+    }
+    return ok(std::move(entries));
+  }
+
+  UsageJournal(const UsageJournal &) = delete;
+  UsageJournal &operator=(const UsageJournal &) = delete;
+
+private:
+  static constexpr const char *kEntryExtension = ".journal";
+
+  UsageJournal() {
+    const char *dir = std::getenv("FUSILLI_USAGE_JOURNAL");
+    if (dir && *dir != '\0')
+      dir_ = dir;
+  }
+
+  static std::filesystem::path getPath(const std::filesystem::path &dir,
+                                       const std::string &key) {
+    return dir / (key + kEntryExtension);
+  }
+
+  mutable std::mutex mutex_;
+  std::filesystem::path dir_;
+  // Keys claimed by this process.
+  std::unordered_set<std::string> recorded_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_USAGE_JOURNAL_H
@@ -0,0 +1,112 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains WorkspaceReport, the breakdown of the workspace of a
+// compiled graph returned by `Graph::getWorkspaceReport()`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_BACKEND_WORKSPACE_REPORT_H
+#define FUSILLI_BACKEND_WORKSPACE_REPORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fusilli {
+
+// Breakdown of the workspace (transient memory) of a compiled graph, e.g. to
+// find out why a graph needs GBs of workspace.
+//
+// The compiled module only reports the total size, so the intermediates of
+// the graph are attributed to the nodes producing them, with the bytes each
+// one takes if it is materialized between dispatches. Intermediates fused
+// into their consumers take none, and the compiler may alias the others, so
+// their sum is an upper bound of what they contribute. Workspace beyond that
+// sum is scratch the compiler introduced, e.g. the partial results of split
+// reductions (see `Graph::setMaxWorkspaceSize()`).
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(WorkspaceReport report,
+//                            graph.getWorkspaceReport());
+//   std::cout << report.toString();
+struct WorkspaceReport {
+  // An intermediate tensor of the graph and the node producing it.
+  struct Intermediate {
+    std::string node;
+    std::string tensor;
+    // Size in bytes of the tensor, dynamic dims counting at their current
+    // extent.
+    uint64_t bytes = 0;
+  };
+
+  // Workspace size of the loaded artifact, see `Graph::getWorkspaceSize()`.
+  uint64_t workspaceSize = 0;
+
+  // Whether the workspace size is data-dependent (see
+  // `Graph::hasDynamicWorkspaceSize()`), in which case `workspaceSize` is 0.
+  bool dynamic = false;
+
+  // Transient memory size of the compiler's scheduling statistics, when the
+  // graph was compiled with a profile dumping them (see
+  // `Graph::getCompileStatistics()`).
+  std::optional<uint64_t> transientMemorySize;
+
+  // Whether split reductions were disabled to fit the workspace cap of the
+  // graph, see `Graph::setMaxWorkspaceSize()`.
+  bool splitReductionDisabled = false;
+
+  // Intermediates of the graph, largest first.
+  std::vector<Intermediate> intermediates;
+
+  // Returns the sum of the bytes of `intermediates`.
+  uint64_t getIntermediateBytes() const {
+    uint64_t bytes = 0;
+    for (const Intermediate &intermediate : intermediates)
+      bytes += intermediate.bytes;
+    return bytes;
+  }
+
+  // Returns the workspace not accounted for by the intermediates, a lower
+  // bound of the scratch the compiler introduced.
+  uint64_t getCompilerScratchBytes() const {
+    return workspaceSize - std::min(workspaceSize, getIntermediateBytes());
+  }
+
+  // Returns a human-readable rendering of the report, one line per
+  // intermediate.
+  std::string toString() const {
+    std::ostringstream os;
+    os << "Workspace: ";
+    if (dynamic)
+      os << "data-dependent";
+    else
+      os << workspaceSize << " bytes";
+    if (splitReductionDisabled)
+      os << " (split reductions disabled to fit the cap)";
+    os << "\n";
+    if (transientMemorySize.has_value())
+      os << "Compiler transient memory: " << *transientMemorySize
+         << " bytes\n";
+    if (!dynamic)
+      os << "Compiler scratch: at least " << getCompilerScratchBytes()
+         << " bytes\n";
+    os << "Intermediates: at most " << getIntermediateBytes() << " bytes\n";
+    for (const Intermediate &intermediate : intermediates)
+      os << "  " << intermediate.node << " -> " << intermediate.tensor << ": "
+         << intermediate.bytes << " bytes\n";
+    return os.str();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_BACKEND_WORKSPACE_REPORT_H
@@ -0,0 +1,418 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains artifact bundles: single files holding precompiled VMFBs
+// for many graphs, backends and GPU targets, written ahead of time by a build
+// step and memory-mapped at deploy time so graphs load without invoking the
+// compiler.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_ARTIFACT_BUNDLE_H
+#define FUSILLI_GRAPH_ARTIFACT_BUNDLE_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/compile_options.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/compile_all.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/cache.h"
+#include "fusilli/support/compression.h"
+#include "fusilli/support/hash.h"
+#include "fusilli/support/logging.h"
+#include "fusilli/support/mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// On-disk layout of an artifact bundle (host endianness, all offsets from the
+// start of the file):
+//
+//   Header:  magic (8 bytes) | version (uint32) | entry count (uint32)
+//   Entries: key offset | key size | VMFB offset | VMFB size (uint64 each)
+//   Keys:    key bytes, back to back
+//   VMFBs:   VMFB bytes, each aligned to `kArtifactBundleAlignment`
+//
+// Entries are sorted by key. A VMFB may be stored compressed, as a zstd frame
+// (see `isCompressedArtifact()`).
+inline constexpr char kArtifactBundleMagic[8] = {'F', 'U', 'S', 'I',
+                                                  'L', 'L', 'I', 'B'};
+inline constexpr uint32_t kArtifactBundleVersion = 2;
+inline constexpr uint64_t kArtifactBundleAlignment = 64;
+
+namespace detail {
+
+struct ArtifactBundleHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t entryCount;
+};
+
+struct ArtifactBundleEntry {
+  uint64_t keyOffset;
+  uint64_t keySize;
+  uint64_t dataOffset;
+  uint64_t dataSize;
+};
+
+} // namespace detail
+
+// Returns the key under which the artifact of `graph` for `backend` and
+// ROCm `target` (empty on CPU) is stored in an artifact bundle: a digest of
+// the structural fingerprint of the graph (see `Graph::getFingerprint()`),
+// the backend and the target. Unlike the kernel cache keys it does not depend
+// on the compiler, which need not be present where bundles are loaded.
+inline ErrorOr<std::string> getArtifactBundleKey(const Graph &graph,
+                                                 Backend backend,
+                                                 const std::string &target) {
+  FUSILLI_ASSIGN_OR_RETURN(std::string fingerprint, graph.getFingerprint());
+  return ok(Hasher()
+                .update(fingerprint)
+                .update(kBackendToStr.at(backend))
+                .update(target)
+                .hexDigest());
+}
+
+// ArtifactBundleWriter collects compiled artifacts and writes them out as an
+// artifact bundle (see `ArtifactBundle`). AMDGPU artifacts are stored per
+// ROCm target, so one bundle can hold a graph for every GPU of a mixed
+// fleet, e.g. MI300X and MI250 nodes, and each node loads its own.
+//
+// Usage (build step):
+//   ArtifactBundleWriter writer;
+//   std::vector<std::string> targets = {"gfx942", "gfx90a"};
+//   for (Graph *graph : graphs)
+//     FUSILLI_CHECK_ERROR(writer.compileAndAdd(*graph, targets));
+//   FUSILLI_CHECK_ERROR(writer.write("kernels.fusilli"));
+//
+class ArtifactBundleWriter {
+public:
+  // Adds `vmfb`, compiled from `graph` for `backend` and ROCm `target`
+  // (empty on CPU). It is an error to add an artifact for the same graph
+  // structure, backend and target twice.
+  ErrorObject add(const Graph &graph, Backend backend,
+                  std::vector<uint8_t> vmfb, const std::string &target = "") {
+    FUSILLI_ASSIGN_OR_RETURN(std::string key,
+                             getArtifactBundleKey(graph, backend, target));
+    FUSILLI_RETURN_ERROR_IF(vmfb.empty(), ErrorCode::InvalidArgument,
+                            "Artifact bundle entries must not be empty");
+    FUSILLI_RETURN_ERROR_IF(artifacts_.contains(key),
+                            ErrorCode::InvalidArgument,
+                            "Artifact bundle already holds an artifact for "
+                            "graph '" +
+                                graph.getName() + "' on backend " +
+                                kBackendToStr.at(backend) +
+                                (target.empty() ? "" : " (" + target + ")"));
+    if (compressionLevel_.has_value() && !isCompressedArtifact(vmfb)) {
+      FUSILLI_ASSIGN_OR_RETURN(vmfb,
+                               compressArtifact(vmfb, *compressionLevel_));
+    }
+    artifacts_.emplace(key, std::move(vmfb));
+    return ok();
+  }
+
+  // Compiles `graph` for `backend` (see `Graph::compileToArtifact()`) and
+  // adds the result, under the ROCm target it was compiled for on AMDGPU
+  // (the local GPU unless the graph's compile options set one).
+  ErrorObject compileAndAdd(Graph &graph, Backend backend) {
+    std::string target;
+    if (backend == Backend::AMDGPU)
+      target = detail::getRocmTarget(
+          graph.getCompileOptions().resolveFlags(backend));
+    FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> vmfb,
+                             graph.compileToArtifact(backend,
+                                                     /*remove=*/true));
+    return add(graph, backend, std::move(vmfb), target);
+  }
+
+  // Compiles `graph` for the AMDGPU backend once per ROCm target in
+  // `targets` (SKUs such as "mi300x" or architectures such as "gfx942"),
+  // none of which needs to be present on the build machine, and adds each
+  // result. Prefer architectures to cover every SKU of a fleet.
+  ErrorObject compileAndAdd(Graph &graph,
+                            std::span<const std::string> targets) {
+    for (const std::string &target : targets) {
+      CompileOptions options = graph.getCompileOptions();
+      options.setRocmTarget(target);
+      FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> vmfb,
+                               graph.compileToArtifact(Backend::AMDGPU,
+                                                       options,
+                                                       /*remove=*/true));
+      FUSILLI_CHECK_ERROR(
+          add(graph, Backend::AMDGPU, std::move(vmfb), target));
+    }
+    return ok();
+  }
+
+  // Returns the number of artifacts added.
+  size_t size() const { return artifacts_.size(); }
+
+  // Sets the zstd level at which artifacts added from now on are compressed,
+  // or std::nullopt to store them uncompressed. Defaults to
+  // `getArtifactCompressionLevel()`. Compressed artifacts shrink the bundle
+  // but are decompressed into memory when loaded, rather than loaded in place
+  // from the mapping.
+  ArtifactBundleWriter &setCompressionLevel(std::optional<int> level) {
+    compressionLevel_ = level;
+    return *this;
+  }
+
+  // Writes the bundle to `path`, replacing any existing file atomically so
+  // processes that mapped the previous bundle are unaffected.
+  ErrorObject write(const std::filesystem::path &path) const {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Writing artifact bundle with "
+                           << artifacts_.size() << " artifacts to " << path);
+    std::vector<detail::ArtifactBundleEntry> entries;
+    entries.reserve(artifacts_.size());
+    uint64_t offset = sizeof(detail::ArtifactBundleHeader) +
+                      artifacts_.size() * sizeof(detail::ArtifactBundleEntry);
+    for (const auto &[key, vmfb] : artifacts_) {
+      entries.push_back({offset, key.size(), 0, vmfb.size()});
+      offset += key.size();
+    }
+    for (auto &entry : entries) {
+      offset = alignUp(offset);
+      entry.dataOffset = offset;
+      offset += entry.dataSize;
+    }
+
+    std::error_code ec;
+    if (path.has_parent_path())
+      std::filesystem::create_directories(path.parent_path(), ec);
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to create directory: " +
+                                path.parent_path().string());
+    std::filesystem::path tempPath = CacheFile::getTempPath(path);
+    {
+      std::ofstream file(tempPath, std::ios::out | std::ios::binary);
+      FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                              "Failed to open file: " + tempPath.string());
+      detail::ArtifactBundleHeader header = {};
+      std::memcpy(header.magic, kArtifactBundleMagic, sizeof(header.magic));
+      header.version = kArtifactBundleVersion;
+      header.entryCount = static_cast<uint32_t>(entries.size());
+      file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char *>(entries.data()),
+                 static_cast<std::streamsize>(entries.size() *
+                                              sizeof(entries[0])));
+      for (const auto &[key, vmfb] : artifacts_)
+        file.write(key.data(), static_cast<std::streamsize>(key.size()));
+      size_t i = 0;
+      for (const auto &[key, vmfb] : artifacts_) {
+        // Pad up to the aligned offset of this artifact.
+        std::streamsize pad =
+            static_cast<std::streamsize>(entries[i++].dataOffset) -
+            static_cast<std::streamsize>(file.tellp());
+        file.write(std::string(pad, '\0').data(), pad);
+        file.write(reinterpret_cast<const char *>(vmfb.data()),
+                   static_cast<std::streamsize>(vmfb.size()));
+      }
+      file.close();
+      if (!file.good()) {
+        std::filesystem::remove(tempPath, ec);
+        return error(ErrorCode::FileSystemFailure,
+                     "Failed to write artifact bundle: " + path.string());
+      }
+    }
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+      std::error_code removeEc;
+      std::filesystem::remove(tempPath, removeEc);
+      return error(ErrorCode::FileSystemFailure,
+                   "Failed to write artifact bundle: " + path.string() +
+                       " - " + ec.message());
+    }
+    return ok();
+  }
+
+private:
+  static uint64_t alignUp(uint64_t offset) {
+    return (offset + kArtifactBundleAlignment - 1) /
+           kArtifactBundleAlignment * kArtifactBundleAlignment;
+  }
+
+  // Ordered so bundles are deterministic for the same set of artifacts.
+  std::map<std::string, std::vector<uint8_t>> artifacts_;
+  std::optional<int> compressionLevel_ = getArtifactCompressionLevel();
+};
+
+// ArtifactBundle is a memory-mapped artifact bundle written by
+// `ArtifactBundleWriter`. Artifacts are loaded in place from the mapping,
+// which stays alive for as long as the bundle or any graph loaded from it.
+//
+// Usage (deploy time):
+//   FUSILLI_ASSIGN_OR_RETURN(ArtifactBundle bundle,
+//                            ArtifactBundle::open("kernels.fusilli"));
+//   FUSILLI_CHECK_ERROR(graph.validate());
+//   FUSILLI_CHECK_ERROR(bundle.load(graph, handle));
+//   FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
+//
+class ArtifactBundle {
+public:
+  // Maps the artifact bundle at `path` and indexes its entries.
+  static ErrorOr<ArtifactBundle> open(const std::filesystem::path &path) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Opening artifact bundle " << path);
+    FUSILLI_ASSIGN_OR_RETURN(MappedFile mapped, MappedFile::open(path));
+    ArtifactBundle bundle;
+    bundle.file_ = std::make_shared<const MappedFile>(std::move(mapped));
+    std::span<const uint8_t> bytes = bundle.file_->bytes();
+
+    detail::ArtifactBundleHeader header;
+    FUSILLI_RETURN_ERROR_IF(bytes.size() < sizeof(header),
+                            ErrorCode::InvalidArgument,
+                            "Truncated artifact bundle: " + path.string());
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    FUSILLI_RETURN_ERROR_IF(
+        std::memcmp(header.magic, kArtifactBundleMagic,
+                    sizeof(header.magic)) != 0,
+        ErrorCode::InvalidArgument, "Not an artifact bundle: " + path.string());
+    FUSILLI_RETURN_ERROR_IF(header.version != kArtifactBundleVersion,
+                            ErrorCode::InvalidArgument,
+                            "Unsupported artifact bundle version " +
+                                std::to_string(header.version) + ": " +
+                                path.string());
+    uint64_t entriesEnd =
+        sizeof(header) +
+        uint64_t(header.entryCount) * sizeof(detail::ArtifactBundleEntry);
+    FUSILLI_RETURN_ERROR_IF(entriesEnd > bytes.size(),
+                            ErrorCode::InvalidArgument,
+                            "Truncated artifact bundle: " + path.string());
+
+    auto inBounds = [&](uint64_t offset, uint64_t size) {
+      return offset <= bytes.size() && size <= bytes.size() - offset;
+    };
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+      detail::ArtifactBundleEntry entry;
+      std::memcpy(&entry, bytes.data() + sizeof(header) + i * sizeof(entry),
+                  sizeof(entry));
+      FUSILLI_RETURN_ERROR_IF(
+          !inBounds(entry.keyOffset, entry.keySize) ||
+              !inBounds(entry.dataOffset, entry.dataSize),
+          ErrorCode::InvalidArgument,
+          "Corrupt artifact bundle entry " + std::to_string(i) + ": " +
+              path.string());
+      std::string key(
+          reinterpret_cast<const char *>(bytes.data() + entry.keyOffset),
+          entry.keySize);
+      bundle.artifacts_.emplace(
+          std::move(key), bytes.subspan(entry.dataOffset, entry.dataSize));
+    }
+    return ok(std::move(bundle));
+  }
+
+  // Returns the number of artifacts in the bundle.
+  size_t size() const { return artifacts_.size(); }
+
+  // Returns the artifact of `graph` for `backend` and ROCm `target` (empty on
+  // CPU), or std::nullopt if the bundle holds none. The returned bytes are
+  // valid for the lifetime of the bundle, and are compressed if the artifact
+  // was stored compressed (see `decompressArtifact()`).
+  ErrorOr<std::optional<std::span<const uint8_t>>>
+  find(const Graph &graph, Backend backend,
+       const std::string &target = "") const {
+    FUSILLI_ASSIGN_OR_RETURN(std::string key,
+                             getArtifactBundleKey(graph, backend, target));
+    auto it = artifacts_.find(key);
+    if (it == artifacts_.end())
+      return ok(std::optional<std::span<const uint8_t>>());
+    return ok(std::optional(it->second));
+  }
+
+  // Loads the artifact of `graph` for the backend of `handle` into `graph`
+  // (see `Graph::loadFromArtifact()`) without copying it out of the mapping,
+  // unless it was stored compressed, in which case it is decompressed from
+  // the mapping straight into the loaded artifact.
+  // On AMDGPU, the artifact of the most specific ROCm target of the handle's
+  // GPU is selected (see `getIreeRocmTargetCandidatesForAmdgpu()`), e.g. one
+  // for `mi300x` over one for `gfx942`. `graph` must be validated. Returns
+  // NotCompiled if the bundle holds no artifact for it. Loaded graphs are
+  // recorded in the usage journal (see `Graph::recordUsage()`).
+  ErrorObject load(Graph &graph, const Handle &handle) const {
+    Backend backend = handle.getBackend();
+    std::vector<std::string> targets = {""};
+    if (backend == Backend::AMDGPU)
+      targets = getIreeRocmTargetCandidatesForAmdgpu(handle.getDeviceId());
+    for (const std::string &target : targets) {
+      FUSILLI_ASSIGN_OR_RETURN(auto vmfb, find(graph, backend, target));
+      if (!vmfb.has_value())
+        continue;
+      FUSILLI_LOG_LABEL_ENDL("INFO: Loading bundled artifact of graph '"
+                             << graph.getName() << "' for target '" << target
+                             << "'");
+      if (isCompressedArtifact(*vmfb)) {
+        FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> decompressed,
+                                 decompressArtifact(*vmfb));
+        FUSILLI_CHECK_ERROR(
+            graph.loadFromArtifact(handle, std::move(decompressed)));
+      } else {
+        FUSILLI_CHECK_ERROR(graph.loadFromArtifact(handle, *vmfb, file_));
+      }
+      // Journaled under the target of the artifact, so the next bundle
+      // built from the journal holds it too.
+      CompileOptions options = graph.getCompileOptions();
+      if (!target.empty())
+        options.setRocmTarget(target);
+      graph.recordUsage(backend, options);
+      return ok();
+    }
+    return error(ErrorCode::NotCompiled,
+                 "Artifact bundle holds no artifact for graph '" +
+                     graph.getName() + "' on backend " +
+                     kBackendToStr.at(backend));
+  }
+
+  // Loads the artifacts of `graphs` as `load()` does, concurrently on up to
+  // `parallelism` worker threads (0 picks the hardware concurrency), e.g. to
+  // load every graph of an application at startup. Returns one status per
+  // graph, in the same order as `graphs`.
+  std::vector<ErrorObject> loadAll(std::span<Graph *const> graphs,
+                                   const Handle &handle,
+                                   size_t parallelism = 0) const {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Loading " << graphs.size()
+                                            << " Graphs from artifact bundle");
+    std::vector<std::vector<size_t>> groups(graphs.size());
+    for (size_t i = 0; i < graphs.size(); ++i)
+      groups[i] = {i};
+    std::vector<ErrorObject> statuses(graphs.size(), ok());
+    detail::runGroupsInParallel(
+        groups, parallelism, [&](const std::vector<size_t> &group) {
+          for (size_t i : group)
+            statuses[i] = graphs[i] ? load(*graphs[i], handle)
+                                    : error(ErrorCode::InvalidArgument,
+                                            "Graph is null");
+        });
+    return statuses;
+  }
+
+private:
+  // Class should be constructed using the `open()` factory function.
+  ArtifactBundle() = default;
+
+  std::shared_ptr<const MappedFile> file_;
+  std::unordered_map<std::string, std::span<const uint8_t>> artifacts_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_ARTIFACT_BUNDLE_H
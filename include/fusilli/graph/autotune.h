@@ -0,0 +1,172 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the compile options autotuner, which times candidate
+// compiler flag and tuning spec variants of a graph on the device and
+// persists the fastest one in the kernel cache.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_AUTOTUNE_H
+#define FUSILLI_GRAPH_AUTOTUNE_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/compile_options.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Controls how `autotune()` measures candidates.
+struct AutotuneConfig {
+  // Untimed executions per candidate, e.g. to warm up caches and clocks.
+  size_t warmupIterations = 2;
+
+  // Timed executions per candidate.
+  size_t iterations = 10;
+
+  // Passed as `remove` when compiling the winning candidate, see
+  // `Graph::compileToArtifact()`. Losing candidates are always compiled with
+  // `remove = true`, so they are never published to the kernel cache.
+  bool remove = false;
+};
+
+// Outcome of `autotune()`.
+struct AutotuneResult {
+  // Index into the candidates of the fastest one.
+  size_t bestIndex = 0;
+
+  // Mean execution time of each candidate, in the same order as the
+  // candidates. std::nullopt for candidates that failed to compile or run.
+  std::vector<std::optional<std::chrono::nanoseconds>> timings;
+};
+
+namespace detail {
+
+// Compiles `graph` with `options`, loads it on `handle` and returns the mean
+// time of executing it with `variantPack`.
+inline ErrorOr<std::chrono::nanoseconds> timeAutotuneCandidate(
+    Graph &graph, const Handle &handle, const CompileOptions &options,
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>> &variantPack,
+    const AutotuneConfig &config) {
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto vmfbBytes,
+      graph.compileToArtifact(handle.getBackend(), options, /*remove=*/true));
+  FUSILLI_CHECK_ERROR(graph.loadFromArtifact(handle, std::move(vmfbBytes)));
+
+  FUSILLI_ASSIGN_OR_RETURN(std::optional<size_t> workspaceSize,
+                           graph.getWorkspaceSize());
+  std::shared_ptr<Buffer> workspace;
+  if (workspaceSize.value_or(0) > 0) {
+    FUSILLI_ASSIGN_OR_RETURN(Buffer workspaceBuf,
+                             Buffer::allocateRaw(handle, *workspaceSize));
+    workspace = std::make_shared<Buffer>(std::move(workspaceBuf));
+  }
+
+  for (size_t i = 0; i < config.warmupIterations; ++i)
+    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
+  FUSILLI_CHECK_ERROR(handle.synchronize());
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < config.iterations; ++i)
+    FUSILLI_CHECK_ERROR(graph.execute(handle, variantPack, workspace));
+  FUSILLI_CHECK_ERROR(handle.synchronize());
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  return ok(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) /
+            config.iterations);
+}
+
+} // namespace detail
+
+// Compiles `graph` with each of `candidates` (compiler flag and tuning spec
+// variants, see `CompileOptions`), times executing each on `handle` with
+// `variantPack`, and returns the timings with the fastest candidate.
+//
+// The winner is recorded in the kernel cache against the options attached to
+// `graph` (see `Graph::saveTunedCompileOptions()`), so later `compile()` calls
+// for the same graph, in this or any other process, use it automatically.
+// Its timing is recorded too, refining `Graph::estimateCost()`.
+// Nothing is recorded when `FUSILLI_DISABLE_KERNEL_CACHE` is set.
+//
+// Candidates that fail to compile or execute are skipped; it is an error if
+// all of them do. On success `graph` is left loaded with the winner.
+//
+// `variantPack` is executed `warmupIterations + iterations` times per
+// candidate, so output buffers must tolerate being overwritten.
+inline ErrorOr<AutotuneResult>
+autotune(Graph &graph, const Handle &handle,
+         std::span<const CompileOptions> candidates,
+         const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                  std::shared_ptr<Buffer>> &variantPack,
+         const AutotuneConfig &config = {}) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Autotuning Graph over " << candidates.size()
+                                                         << " candidates");
+  FUSILLI_RETURN_ERROR_IF(candidates.empty(), ErrorCode::InvalidArgument,
+                          "Autotuning requires at least one candidate");
+  FUSILLI_RETURN_ERROR_IF(config.iterations == 0, ErrorCode::InvalidArgument,
+                          "Autotuning requires at least one timed iteration");
+
+  AutotuneResult result;
+  result.timings.reserve(candidates.size());
+  std::optional<std::chrono::nanoseconds> bestTiming;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    ErrorOr<std::chrono::nanoseconds> timing = detail::timeAutotuneCandidate(
+        graph, handle, candidates[i], variantPack, config);
+    if (isError(timing)) {
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Autotuning candidate "
+                             << i << " failed: " << ErrorObject(timing));
+      result.timings.emplace_back(std::nullopt);
+      continue;
+    }
+    FUSILLI_LOG_LABEL_ENDL("INFO: Autotuning candidate "
+                           << i << " took " << timing->count() << " ns");
+    if (!bestTiming.has_value() || *timing < *bestTiming) {
+      bestTiming = *timing;
+      result.bestIndex = i;
+    }
+    result.timings.emplace_back(*timing);
+  }
+  FUSILLI_RETURN_ERROR_IF(!bestTiming.has_value(), ErrorCode::CompileFailure,
+                          "All autotuning candidates failed");
+
+  const CompileOptions &winner = candidates[result.bestIndex];
+  if (!checkKernelCacheDisabledEnv()) {
+    ErrorObject status =
+        graph.saveTunedCompileOptions(handle.getBackend(), winner);
+    if (isError(status))
+      FUSILLI_LOG_LABEL_ENDL(
+          "WARNING: Failed to record autotuned compile options: " << status);
+    status = graph.saveMeasuredTime(handle.getBackend(), *bestTiming);
+    if (isError(status))
+      FUSILLI_LOG_LABEL_ENDL(
+          "WARNING: Failed to record autotuned execution time: " << status);
+  }
+
+  FUSILLI_ASSIGN_OR_RETURN(
+      auto vmfbBytes,
+      graph.compileToArtifact(handle.getBackend(), winner, config.remove));
+  FUSILLI_CHECK_ERROR(graph.loadFromArtifact(handle, std::move(vmfbBytes)));
+  return ok(std::move(result));
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_AUTOTUNE_H
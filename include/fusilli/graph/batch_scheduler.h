@@ -0,0 +1,471 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains BatchScheduler, which coalesces concurrent requests to a
+// dynamic-batch graph into batched executions, and BatchRequest, the rows of
+// one request in a batch.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_BATCH_SCHEDULER_H
+#define FUSILLI_GRAPH_BATCH_SCHEDULER_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+class BatchRequest;
+
+// Options of a `BatchScheduler`.
+struct BatchSchedulerOptions {
+  // Largest number of rows (along the batch dim) executed at once.
+  int64_t maxBatchSize = 8;
+  // How long a batch waits for more requests after its first one was
+  // submitted. Bounds the latency added to a request by batching.
+  std::chrono::microseconds maxDelay{500};
+  // Number of batches whose buffers are allocated, so requests fill the next
+  // batch while the previous one executes and is read back.
+  size_t frameCount = 2;
+};
+
+// BatchScheduler trades a bounded latency increase for throughput on graphs
+// mostly executed with small batches, e.g. serving requests of batch 1: it
+// queues the requests of concurrent threads and executes them as one batch
+// of the graph.
+//
+// The graph must be compiled with dim 0 of all its batched inputs and outputs
+// dynamic (see `TensorAttr::setDynamicDims()`) and outermost in memory; its
+// other inputs (e.g. weights) are shared by all requests and bound once at
+// creation. The scheduler allocates the batch buffers of each tensor, and a
+// request acquires consecutive rows of them: the buffers returned by
+// `BatchRequest::getBuffer()` are subviews of the batch buffers, so inputs
+// are written and outputs read in place, without gathering or scattering
+// copies. Once all requests of a batch are submitted and the batch is either
+// full or `maxDelay` has passed since its first submission, a background
+// thread executes the graph once over the rows in use.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(
+//       auto scheduler,
+//       BatchScheduler::create(handle, graph, {{wT, wBuf}}, options));
+//   // Per request, from any thread:
+//   FUSILLI_ASSIGN_OR_RETURN(BatchRequest request, scheduler->acquire());
+//   FUSILLI_ASSIGN_OR_RETURN(auto xBuf, request.getBuffer(xT));
+//   ... write the input rows to xBuf ...
+//   FUSILLI_CHECK_ERROR(request.submit());
+//   FUSILLI_CHECK_ERROR(request.wait());
+//   FUSILLI_ASSIGN_OR_RETURN(auto yBuf, request.getBuffer(yT));
+//   FUSILLI_CHECK_ERROR(yBuf->read(handle, result));
+class BatchScheduler {
+public:
+  // Creates a scheduler executing the compiled `graph` on `handle`, which
+  // must outlive the scheduler. `sharedBuffers` binds the graph inputs
+  // without a dynamic batch dim, read by all requests.
+  static ErrorOr<std::unique_ptr<BatchScheduler>>
+  create(const Handle &handle, std::shared_ptr<const Graph> graph,
+         const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                  std::shared_ptr<Buffer>> &sharedBuffers,
+         const BatchSchedulerOptions &options = {}) {
+    FUSILLI_RETURN_ERROR_IF(graph == nullptr, ErrorCode::InvalidArgument,
+                            "BatchScheduler graph is null");
+    FUSILLI_RETURN_ERROR_IF(options.maxBatchSize <= 0 ||
+                                options.frameCount == 0,
+                            ErrorCode::InvalidArgument,
+                            "BatchScheduler requires a positive max batch "
+                            "size and frame count");
+    std::unique_ptr<BatchScheduler> scheduler(
+        new BatchScheduler(handle, std::move(graph), options));
+    FUSILLI_CHECK_ERROR(scheduler->initialize(sharedBuffers));
+    scheduler->worker_ = std::thread([raw = scheduler.get()] { raw->run(); });
+    return ok(std::move(scheduler));
+  }
+
+  // Reserves `rows` rows of the batch being filled for a request, blocking
+  // while no batch has room for them.
+  ErrorOr<BatchRequest> acquire(int64_t rows = 1);
+
+  // Number of batched executions, and of requests they served.
+  uint64_t getBatchCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batchCount_;
+  }
+  uint64_t getRequestCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requestCount_;
+  }
+
+  const BatchSchedulerOptions &getOptions() const { return options_; }
+
+  // Delete copy and move constructors, the worker thread refers to `this`.
+  BatchScheduler(const BatchScheduler &) = delete;
+  BatchScheduler &operator=(const BatchScheduler &) = delete;
+  BatchScheduler(BatchScheduler &&) = delete;
+  BatchScheduler &operator=(BatchScheduler &&) = delete;
+
+  // Executes the submitted requests of the batch being filled, then joins the
+  // worker thread. All requests must be destroyed before the scheduler.
+  ~BatchScheduler() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable())
+      worker_.join();
+  }
+
+private:
+  friend class BatchRequest;
+
+  // A graph input or output and the byte size of one of its rows.
+  struct BatchedTensor {
+    size_t uid;
+    std::vector<iree_hal_dim_t> rowShape;
+    size_t rowBytes;
+  };
+
+  // The buffers of one batch and the requests sharing them. A frame is
+  // filled by requests, then executed, then recycled once all its requests
+  // are destroyed.
+  struct Frame {
+    enum class State { Filling, Executing, Done };
+
+    // Batch buffers, indexed like `batched_`.
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    State state = State::Filling;
+    // Set when a request didn't fit, so the batch executes without waiting
+    // for `maxDelay`.
+    bool full = false;
+    int64_t rows = 0;
+    size_t acquired = 0, submitted = 0, alive = 0;
+    std::chrono::steady_clock::time_point firstSubmit;
+    ErrorObject status = ok();
+  };
+
+  BatchScheduler(const Handle &handle, std::shared_ptr<const Graph> graph,
+                 const BatchSchedulerOptions &options)
+      : handle_(handle), graph_(std::move(graph)), options_(options),
+        frames_(options.frameCount), uidBuffers_(graph_->getTensorUidCount()),
+        shared_(uidBuffers_.size()) {}
+
+  // Splits the graph tensors into batched and shared ones and allocates the
+  // batch buffers.
+  ErrorObject initialize(
+      const std::unordered_map<std::shared_ptr<TensorAttr>,
+                               std::shared_ptr<Buffer>> &sharedBuffers) {
+    const auto &tensors = graph_->getTensorsByUid();
+    for (size_t uid = 0; uid < tensors.size(); ++uid) {
+      const std::shared_ptr<TensorAttr> &tensor = tensors[uid];
+      if (!tensor->hasDynamicDims()) {
+        auto it = sharedBuffers.find(tensor);
+        FUSILLI_RETURN_ERROR_IF(
+            it == sharedBuffers.end() || it->second == nullptr,
+            ErrorCode::VariantPackError,
+            "BatchScheduler has no shared buffer for tensor '" +
+                tensor->getName() + "' without a dynamic batch dim");
+        shared_[uid] = it->second;
+        uidBuffers_[uid] = it->second.get();
+        continue;
+      }
+      FUSILLI_RETURN_ERROR_IF(
+          tensor->getDynamicDims() != std::vector<size_t>{0} ||
+              tensor->getLogicalToPhysicalPermuteOrder().front() != 0,
+          ErrorCode::NotImplemented,
+          "BatchScheduler requires tensor '" + tensor->getName() +
+              "' to only have its outermost dim 0 dynamic");
+      FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                               getIreeHalElementType(tensor->getDataType()));
+      FUSILLI_RETURN_ERROR_IF(
+          iree_hal_element_bit_count(elementType) % 8 != 0,
+          ErrorCode::NotImplemented,
+          "BatchScheduler requires byte-aligned elements for tensor '" +
+              tensor->getName() + "'");
+      BatchedTensor batched{uid, {}, 0};
+      for (int64_t dim : tensor->getStorageDim())
+        batched.rowShape.push_back(static_cast<iree_hal_dim_t>(dim));
+      batched.rowShape[0] = 1;
+      iree_device_size_t rowBytes = 0;
+      FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+          batched.rowShape.size(), batched.rowShape.data(), elementType,
+          IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &rowBytes));
+      batched.rowBytes = static_cast<size_t>(rowBytes);
+      batched_.push_back(std::move(batched));
+    }
+    FUSILLI_RETURN_ERROR_IF(batched_.empty(), ErrorCode::InvalidArgument,
+                            "BatchScheduler graph has no tensor with a "
+                            "dynamic batch dim");
+
+    for (Frame &frame : frames_) {
+      for (const BatchedTensor &batched : batched_) {
+        FUSILLI_ASSIGN_OR_RETURN(
+            Buffer buffer,
+            Buffer::allocateRaw(handle_, batched.rowBytes *
+                                             static_cast<size_t>(
+                                                 options_.maxBatchSize)));
+        frame.buffers.push_back(std::make_shared<Buffer>(std::move(buffer)));
+      }
+    }
+    return ok();
+  }
+
+  // Returns the shape of `rows` rows of `batched`.
+  static std::vector<iree_hal_dim_t> getShape(const BatchedTensor &batched,
+                                              int64_t rows) {
+    std::vector<iree_hal_dim_t> shape = batched.rowShape;
+    shape[0] = static_cast<iree_hal_dim_t>(rows);
+    return shape;
+  }
+
+  // Executes the rows of `frame` in use with the graph.
+  ErrorObject execute(Frame &frame) {
+    const auto &tensors = graph_->getTensorsByUid();
+    std::vector<Buffer> views;
+    views.reserve(batched_.size());
+    for (size_t i = 0; i < batched_.size(); ++i) {
+      FUSILLI_ASSIGN_OR_RETURN(
+          Buffer view,
+          frame.buffers[i]->subview(
+              /*byteOffset=*/0, getShape(batched_[i], frame.rows),
+              tensors[batched_[i].uid]->getDataType()));
+      views.push_back(std::move(view));
+    }
+    std::vector<Buffer *> buffers = uidBuffers_;
+    for (size_t i = 0; i < batched_.size(); ++i)
+      buffers[batched_[i].uid] = &views[i];
+    FUSILLI_LOG_LABEL_ENDL("INFO: Executing batch of "
+                           << frame.acquired << " requests (" << frame.rows
+                           << " rows)");
+    return graph_->execute(handle_, buffers, /*workspace=*/nullptr);
+  }
+
+  // Body of the worker thread: executes the frames in turn.
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      Frame &frame = frames_[current_];
+      cv_.wait(lock, [&] {
+        return stopping_ ||
+               (frame.state == Frame::State::Filling && frame.submitted > 0);
+      });
+      if (frame.state != Frame::State::Filling || frame.submitted == 0)
+        return;
+      // Wait for more requests until the batch is full or its deadline.
+      cv_.wait_until(lock, frame.firstSubmit + options_.maxDelay, [&] {
+        return stopping_ || frame.full || frame.rows == options_.maxBatchSize;
+      });
+      // Close the batch and let new requests fill the next frame, then wait
+      // for the requests still writing their inputs.
+      frame.state = Frame::State::Executing;
+      current_ = (current_ + 1) % frames_.size();
+      cv_.notify_all();
+      cv_.wait(lock, [&] { return frame.submitted == frame.acquired; });
+
+      lock.unlock();
+      ErrorObject status = execute(frame);
+      lock.lock();
+      frame.status = std::move(status);
+      frame.state = Frame::State::Done;
+      batchCount_++;
+      requestCount_ += frame.acquired;
+      cv_.notify_all();
+    }
+  }
+
+  const Handle &handle_;
+  std::shared_ptr<const Graph> graph_;
+  BatchSchedulerOptions options_;
+
+  std::vector<BatchedTensor> batched_;
+  std::vector<Frame> frames_;
+  // Buffers of the shared tensors indexed by UID, with null entries for the
+  // batched tensors.
+  std::vector<Buffer *> uidBuffers_;
+  std::vector<std::shared_ptr<Buffer>> shared_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  // Frame being filled by new requests.
+  size_t current_ = 0;
+  bool stopping_ = false;
+  uint64_t batchCount_ = 0;
+  uint64_t requestCount_ = 0;
+
+  std::thread worker_;
+};
+
+// The rows of one request in a batch of a `BatchScheduler`. A request is
+// used by a single thread: it writes its inputs through `getBuffer()`, is
+// submitted, waited on, and its outputs read. Destroying the request
+// releases its rows; until then the batch buffers aren't reused.
+class BatchRequest {
+public:
+  // Returns the rows of the request in the batch buffer of the batched graph
+  // input or output `tensor`, a `getRows()` x ... buffer.
+  ErrorOr<std::shared_ptr<Buffer>>
+  getBuffer(const std::shared_ptr<TensorAttr> &tensor) const {
+    FUSILLI_ASSIGN_OR_RETURN(size_t uid,
+                             scheduler_->graph_->getTensorUid(tensor));
+    for (size_t i = 0; i < scheduler_->batched_.size(); ++i) {
+      const BatchScheduler::BatchedTensor &batched = scheduler_->batched_[i];
+      if (batched.uid != uid)
+        continue;
+      FUSILLI_ASSIGN_OR_RETURN(
+          Buffer view,
+          frame_->buffers[i]->subview(
+              batched.rowBytes * static_cast<size_t>(firstRow_),
+              BatchScheduler::getShape(batched, rows_),
+              tensor->getDataType()));
+      return ok(std::make_shared<Buffer>(std::move(view)));
+    }
+    return error(ErrorCode::InvalidArgument,
+                 "BatchScheduler tensor '" + tensor->getName() +
+                     "' has no dynamic batch dim");
+  }
+
+  // Hands the request to the scheduler once its inputs are written. Inputs
+  // written asynchronously must be complete (see `HostTransfer::wait()`).
+  ErrorObject submit() {
+    FUSILLI_RETURN_ERROR_IF(submitted_, ErrorCode::InvalidArgument,
+                            "BatchRequest was already submitted");
+    markSubmitted();
+    return ok();
+  }
+
+  // Blocks until the batch of the submitted request executed, returning the
+  // error of its execution, if any. The outputs are then ready to be read.
+  ErrorObject wait() {
+    FUSILLI_RETURN_ERROR_IF(!submitted_, ErrorCode::InvalidArgument,
+                            "BatchRequest must be submitted before waiting");
+    std::unique_lock<std::mutex> lock(scheduler_->mutex_);
+    scheduler_->cv_.wait(lock, [&] {
+      return frame_->state == BatchScheduler::Frame::State::Done;
+    });
+    return frame_->status;
+  }
+
+  int64_t getRows() const { return rows_; }
+
+  // Delete copy constructors, keep move constructors.
+  BatchRequest(const BatchRequest &) = delete;
+  BatchRequest &operator=(const BatchRequest &) = delete;
+  BatchRequest(BatchRequest &&other) noexcept
+      : scheduler_(std::exchange(other.scheduler_, nullptr)),
+        frame_(other.frame_), firstRow_(other.firstRow_), rows_(other.rows_),
+        submitted_(other.submitted_) {}
+  BatchRequest &operator=(BatchRequest &&other) noexcept {
+    if (this != &other) {
+      release();
+      scheduler_ = std::exchange(other.scheduler_, nullptr);
+      frame_ = other.frame_;
+      firstRow_ = other.firstRow_;
+      rows_ = other.rows_;
+      submitted_ = other.submitted_;
+    }
+    return *this;
+  }
+  ~BatchRequest() { release(); }
+
+private:
+  friend class BatchScheduler;
+
+  BatchRequest(BatchScheduler *scheduler, BatchScheduler::Frame *frame,
+               int64_t firstRow, int64_t rows)
+      : scheduler_(scheduler), frame_(frame), firstRow_(firstRow),
+        rows_(rows) {}
+
+  void markSubmitted() {
+    submitted_ = true;
+    {
+      std::lock_guard<std::mutex> lock(scheduler_->mutex_);
+      if (frame_->submitted++ == 0)
+        frame_->firstSubmit = std::chrono::steady_clock::now();
+    }
+    scheduler_->cv_.notify_all();
+  }
+
+  // Submits the request if it wasn't (its rows are then computed on whatever
+  // they hold) so the batch isn't held up, and recycles the frame once its
+  // last request is released.
+  void release() {
+    if (scheduler_ == nullptr)
+      return;
+    if (!submitted_)
+      markSubmitted();
+    std::unique_lock<std::mutex> lock(scheduler_->mutex_);
+    scheduler_->cv_.wait(lock, [&] {
+      return frame_->state == BatchScheduler::Frame::State::Done;
+    });
+    if (--frame_->alive == 0) {
+      frame_->state = BatchScheduler::Frame::State::Filling;
+      frame_->full = false;
+      frame_->rows = 0;
+      frame_->acquired = frame_->submitted = 0;
+      frame_->status = ok();
+    }
+    lock.unlock();
+    scheduler_->cv_.notify_all();
+    scheduler_ = nullptr;
+  }
+
+  BatchScheduler *scheduler_;
+  BatchScheduler::Frame *frame_;
+  int64_t firstRow_;
+  int64_t rows_;
+  bool submitted_ = false;
+};
+
+inline ErrorOr<BatchRequest> BatchScheduler::acquire(int64_t rows) {
+  FUSILLI_RETURN_ERROR_IF(rows <= 0 || rows > options_.maxBatchSize,
+                          ErrorCode::InvalidArgument,
+                          "BatchScheduler request of " + std::to_string(rows) +
+                              " rows exceeds the max batch size " +
+                              std::to_string(options_.maxBatchSize));
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    FUSILLI_RETURN_ERROR_IF(stopping_, ErrorCode::RuntimeFailure,
+                            "BatchScheduler is shutting down");
+    Frame &frame = frames_[current_];
+    if (frame.state == Frame::State::Filling && !frame.full) {
+      if (frame.rows + rows <= options_.maxBatchSize)
+        break;
+      // Execute the batch right away, the request goes to the next one.
+      frame.full = true;
+      cv_.notify_all();
+    }
+    cv_.wait(lock);
+  }
+  Frame &frame = frames_[current_];
+  int64_t firstRow = frame.rows;
+  frame.rows += rows;
+  frame.acquired++;
+  frame.alive++;
+  if (frame.rows == options_.maxBatchSize)
+    cv_.notify_all();
+  return ok(BatchRequest(this, &frame, firstRow, rows));
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_BATCH_SCHEDULER_H
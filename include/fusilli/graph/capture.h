@@ -0,0 +1,294 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains execution captures: self-contained repros of one graph
+// execution (the serialized graph, its compiled artifact and compile inputs,
+// and the shapes and optionally the contents of its buffers) written to a
+// single file, so that a slow or failing execution seen in production can be
+// replayed elsewhere, e.g. by the benchmark driver's `replay` sub-command.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_CAPTURE_H
+#define FUSILLI_GRAPH_CAPTURE_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/compile_options.h"
+#include "fusilli/backend/compile_report.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/archive.h"
+#include "fusilli/support/cache.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// What `ExecutionCapture::capture()` stores besides the graph and the shapes
+// of its buffers.
+struct CaptureOptions {
+  // Contents of the buffers, read back from the device, so the replay runs
+  // on the same data (e.g. for data-dependent slowdowns or failures).
+  // Otherwise inputs are replayed as ones.
+  bool data = false;
+  // Compiled artifact of the graph, so the replay runs the exact kernels
+  // even where a different compiler is installed.
+  bool artifact = true;
+};
+
+// A buffer bound to a captured execution.
+struct CapturedBuffer {
+  // Graph input or output the buffer is bound to.
+  std::string name;
+  // Shape of the buffer, with dynamic dims resolved.
+  std::vector<int64_t> dims;
+  DataType dataType = DataType::NotSet;
+  // Raw contents, see `CaptureOptions::data`.
+  std::optional<std::vector<uint8_t>> data;
+
+  void archive(Archive &ar) {
+    bool hasData = data.has_value();
+    ar.io(name).io(dims).io(dataType).io(hasData);
+    if (!hasData) {
+      data.reset();
+      return;
+    }
+    if (!data.has_value())
+      data.emplace();
+    ar.ioBytes(*data);
+  }
+};
+
+// One graph execution captured to replay it in another process.
+//
+// Usage (capture, e.g. next to a slow `execute()` call):
+//   FUSILLI_ASSIGN_OR_RETURN(
+//       ExecutionCapture capture,
+//       ExecutionCapture::capture(graph, handle, variantPack));
+//   FUSILLI_CHECK_ERROR(capture.write("slow_case.fusilli-capture"));
+//
+// Usage (replay):
+//   FUSILLI_ASSIGN_OR_RETURN(ExecutionCapture capture,
+//                            ExecutionCapture::read(path));
+//   FUSILLI_ASSIGN_OR_RETURN(std::unique_ptr<Graph> graph,
+//                            capture.loadGraph(handle));
+//   FUSILLI_ASSIGN_OR_RETURN(auto variantPack,
+//                            capture.allocateBuffers(handle, *graph));
+//   FUSILLI_CHECK_ERROR(graph->execute(handle, variantPack, nullptr));
+struct ExecutionCapture {
+  // Graph as of `Graph::serialize()`, its name and structural fingerprint.
+  std::vector<uint8_t> graph;
+  std::string graphName;
+  std::string fingerprint;
+  // Backend and attached compile options (see `CompileOptions::toString()`)
+  // the graph was compiled with.
+  Backend backend = Backend::CPU;
+  std::string compileOptions;
+  // Emitted MLIR assembly and, when the graph was compiled through the
+  // per-graph cache, the compile command. For reading only: the replay
+  // recompiles from `graph` when there is no matching artifact.
+  std::string asmSource;
+  std::string compileCommand;
+  // Compiled artifact, empty unless captured, see `CaptureOptions`.
+  std::vector<uint8_t> artifact;
+  std::vector<CapturedBuffer> buffers;
+
+  // Captures an execution of `graph`, which must be compiled for `handle`,
+  // on the buffers of `variantPack`. Capture before executing to record the
+  // inputs the execution saw.
+  static ErrorOr<ExecutionCapture>
+  capture(Graph &graph, const Handle &handle,
+          const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                   std::shared_ptr<Buffer>> &variantPack,
+          const CaptureOptions &options = {}) {
+    ExecutionCapture result;
+    FUSILLI_ASSIGN_OR_RETURN(result.graph, graph.serialize());
+    result.graphName = graph.getName();
+    FUSILLI_ASSIGN_OR_RETURN(result.fingerprint, graph.getFingerprint());
+    result.backend = handle.getBackend();
+    result.compileOptions = graph.getCompileOptions().toString();
+    FUSILLI_ASSIGN_OR_RETURN(result.asmSource, graph.emitAsm());
+    std::filesystem::path commandPath =
+        CacheFile::getPath(graph.getName(), IREE_COMPILE_COMMAND_FILENAME);
+    std::error_code ec;
+    if (std::filesystem::exists(commandPath, ec)) {
+      FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> command,
+                               readFileBytes(commandPath));
+      result.compileCommand.assign(command.begin(), command.end());
+    }
+    if (options.artifact) {
+      // Served from the compile-side caches of the compiled graph.
+      FUSILLI_ASSIGN_OR_RETURN(result.artifact,
+                               graph.compileToArtifact(handle.getBackend()));
+    }
+
+    for (const auto &[tensor, buffer] : variantPack) {
+      FUSILLI_RETURN_ERROR_IF(!tensor || !buffer, ErrorCode::VariantPackError,
+                              "Cannot capture a null tensor or buffer");
+      iree_hal_buffer_view_t *view = buffer->getBufferView();
+      const iree_hal_dim_t *dims = iree_hal_buffer_view_shape_dims(view);
+      CapturedBuffer captured{
+          .name = tensor->getName(),
+          .dims = std::vector<int64_t>(
+              dims, dims + iree_hal_buffer_view_shape_rank(view)),
+          .dataType = tensor->getDataType(),
+          .data = std::nullopt,
+      };
+      if (options.data) {
+        std::vector<uint8_t> bytes(iree_hal_buffer_view_byte_length(view));
+        FUSILLI_CHECK_ERROR(
+            buffer->readBytes(handle, bytes.data(), bytes.size()));
+        captured.data = std::move(bytes);
+      }
+      result.buffers.push_back(std::move(captured));
+    }
+    // Name order keeps the bytes of a capture reproducible.
+    std::sort(result.buffers.begin(), result.buffers.end(),
+              [](const CapturedBuffer &a, const CapturedBuffer &b) {
+                return a.name < b.name;
+              });
+    return ok(std::move(result));
+  }
+
+  // Writes the capture to `path`.
+  ErrorObject write(const std::filesystem::path &path) const {
+    Archive ar = Archive::writer();
+    const_cast<ExecutionCapture *>(this)->archive(ar);
+    FUSILLI_CHECK_ERROR(ar.status());
+    std::vector<uint8_t> bytes = ar.takeBytes();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    FUSILLI_RETURN_ERROR_IF(!file, ErrorCode::FileSystemFailure,
+                            "Failed to open file: " + path.string());
+    file.write(reinterpret_cast<const char *>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+    FUSILLI_RETURN_ERROR_IF(!file, ErrorCode::FileSystemFailure,
+                            "Failed to write capture: " + path.string());
+    return ok();
+  }
+
+  // Reads a capture written by `write()`.
+  static ErrorOr<ExecutionCapture> read(const std::filesystem::path &path) {
+    FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> bytes, readFileBytes(path));
+    ExecutionCapture capture;
+    Archive ar = Archive::reader(bytes);
+    capture.archive(ar);
+    FUSILLI_CHECK_ERROR(ar.status());
+    FUSILLI_RETURN_ERROR_IF(!ar.atEnd(), ErrorCode::InvalidArgument,
+                            "Trailing bytes after capture: " + path.string());
+    return ok(std::move(capture));
+  }
+
+  // Rebuilds the captured graph, validated and loaded onto `handle`: from
+  // the captured artifact when it was compiled for the backend of `handle`,
+  // by compiling it otherwise. Set `remove = false` to keep the compilation
+  // artifacts, e.g. to inspect them, and `report` to time the compilation
+  // (see `Graph::compile()`), which stays empty when the artifact is used.
+  ErrorOr<std::unique_ptr<Graph>>
+  loadGraph(const Handle &handle, bool remove = true,
+            CompileReport *report = nullptr) const {
+    FUSILLI_ASSIGN_OR_RETURN(std::unique_ptr<Graph> replay,
+                             Graph::deserialize(graph));
+    replay->setName(graphName).setCompileOptions(
+        CompileOptions::fromString(compileOptions));
+    FUSILLI_CHECK_ERROR(replay->validate());
+    FUSILLI_ASSIGN_OR_RETURN(std::string replayFingerprint,
+                             replay->getFingerprint());
+    bool useArtifact = !artifact.empty() && handle.getBackend() == backend;
+    // The artifact takes arguments in the order of the captured graph, which
+    // a different fingerprint would not guarantee.
+    FUSILLI_RETURN_ERROR_IF(useArtifact && replayFingerprint != fingerprint,
+                            ErrorCode::InvalidArgument,
+                            "Captured graph '" + graphName +
+                                "' no longer matches its artifact, which "
+                                "was captured with another Fusilli version");
+    if (useArtifact)
+      FUSILLI_CHECK_ERROR(replay->loadFromArtifact(handle, artifact));
+    else
+      FUSILLI_CHECK_ERROR(replay->compile(handle, remove, report));
+    return ok(std::move(replay));
+  }
+
+  // Allocates the captured buffers on `handle` for `replay` (see
+  // `loadGraph()`): with the captured contents when there are, otherwise
+  // filled with ones.
+  ErrorOr<
+      std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>>
+  allocateBuffers(const Handle &handle, const Graph &replay) const {
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+        variantPack;
+    for (const CapturedBuffer &captured : buffers) {
+      std::shared_ptr<TensorAttr> tensor = replay.getTensor(captured.name);
+      FUSILLI_RETURN_ERROR_IF(!tensor, ErrorCode::VariantPackError,
+                              "Captured buffer '" + captured.name +
+                                  "' has no tensor in the replayed graph");
+      std::vector<iree_hal_dim_t> shape(captured.dims.begin(),
+                                        captured.dims.end());
+      std::optional<Buffer> buffer;
+      if (captured.data) {
+        // Upload the raw bytes, then view them with the captured type.
+        std::vector<int8_t> bytes(captured.data->begin(),
+                                  captured.data->end());
+        FUSILLI_ASSIGN_OR_RETURN(
+            Buffer raw, Buffer::allocate(handle, {bytes.size()}, bytes));
+        FUSILLI_ASSIGN_OR_RETURN(
+            Buffer view, raw.subview(/*byteOffset=*/0, shape,
+                                     captured.dataType));
+        buffer.emplace(std::move(view));
+      } else {
+        FUSILLI_ASSIGN_OR_RETURN(
+            Buffer filled, Buffer::allocateFilled(handle, shape,
+                                                  captured.dataType, 1.0));
+        buffer.emplace(std::move(filled));
+      }
+      variantPack.insert(
+          {tensor, std::make_shared<Buffer>(std::move(*buffer))});
+    }
+    return ok(std::move(variantPack));
+  }
+
+  // Reads or writes the capture from or to `ar`.
+  void archive(Archive &ar) {
+    uint32_t magic = kCaptureMagic;
+    uint32_t version = kCaptureVersion;
+    ar.io(magic).io(version);
+    if (magic != kCaptureMagic || version != kCaptureVersion) {
+      ar.fail(ErrorCode::InvalidArgument,
+              "Not an execution capture, or captured by an unsupported "
+              "version of Fusilli");
+      return;
+    }
+    ar.ioBytes(graph).io(graphName).io(fingerprint).io(backend);
+    ar.io(compileOptions).io(asmSource).io(compileCommand).ioBytes(artifact);
+    ar.io(buffers);
+  }
+
+  // Leading fields of the capture format. Bump the version whenever it
+  // changes.
+  static constexpr uint32_t kCaptureMagic = 0x46534350; // "FSCP"
+  static constexpr uint32_t kCaptureVersion = 1;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_CAPTURE_H
@@ -0,0 +1,295 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains batch compilation APIs that compile many graphs
+// concurrently on a pool of worker threads, or together as the functions of
+// one module.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_COMPILE_ALL_H
+#define FUSILLI_GRAPH_COMPILE_ALL_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/cache.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+namespace detail {
+
+// Partitions `graphs` into groups that must be compiled back to back on one
+// worker. Graphs sharing a per-graph cache directory would otherwise race on
+// the same cache files, and graphs sharing a fingerprint cache key (see
+// `Graph::getFingerprintCacheKey()`) would compile the same artifact twice.
+// Graphs whose key can't be computed are left out and their error is recorded
+// in `results`.
+inline std::vector<std::vector<size_t>> groupGraphsForCompileAll(
+    std::span<Graph *const> graphs, Backend backend,
+    std::vector<std::optional<ErrorOr<std::vector<uint8_t>>>> &results) {
+  std::vector<size_t> parent(graphs.size());
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&](size_t i) {
+    while (parent[i] != i)
+      i = parent[i] = parent[parent[i]];
+    return i;
+  };
+  std::unordered_map<std::string, size_t> firstByKey;
+  auto unite = [&](const std::string &key, size_t i) {
+    auto [it, inserted] = firstByKey.try_emplace(key, i);
+    if (!inserted)
+      parent[find(i)] = find(it->second);
+  };
+
+  for (size_t i = 0; i < graphs.size(); ++i) {
+    if (graphs[i] == nullptr) {
+      results[i].emplace(error(ErrorCode::InvalidArgument, "Graph is null"));
+      continue;
+    }
+    ErrorOr<std::string> fingerprintKey =
+        graphs[i]->getFingerprintCacheKey(backend);
+    if (isError(fingerprintKey)) {
+      results[i].emplace(ErrorObject(fingerprintKey));
+      continue;
+    }
+    unite("fingerprint:" + *fingerprintKey, i);
+    unite("dir:" + CacheFile::getPath(graphs[i]->getName(), "")
+                       .parent_path()
+                       .string(),
+          i);
+  }
+
+  // Keep groups (and graphs within a group) in input order.
+  std::vector<std::vector<size_t>> groups;
+  std::unordered_map<size_t, size_t> groupByRoot;
+  for (size_t i = 0; i < graphs.size(); ++i) {
+    if (results[i].has_value())
+      continue;
+    auto [it, inserted] = groupByRoot.try_emplace(find(i), groups.size());
+    if (inserted)
+      groups.emplace_back();
+    groups[it->second].push_back(i);
+  }
+  return groups;
+}
+
+// Runs `task(g)` for each group `g` of `groups` on up to `parallelism` worker
+// threads (0 picks the hardware concurrency). Workers pull whole groups so
+// graphs within a group never run concurrently.
+template <typename Task>
+inline void runGroupsInParallel(const std::vector<std::vector<size_t>> &groups,
+                                size_t parallelism, Task &&task) {
+  if (parallelism == 0)
+    parallelism = std::max(1u, std::thread::hardware_concurrency());
+  parallelism = std::min(parallelism, groups.size());
+
+  std::atomic<size_t> nextGroup = 0;
+  auto worker = [&]() {
+    for (size_t g = nextGroup++; g < groups.size(); g = nextGroup++)
+      task(groups[g]);
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(parallelism);
+  for (size_t t = 0; t < parallelism; ++t)
+    workers.emplace_back(worker);
+  for (auto &thread : workers)
+    thread.join();
+}
+
+} // namespace detail
+
+// Compiles each of `graphs` to a VMFB artifact for `backend`, equivalent to
+// calling `Graph::compileToArtifact(backend, remove)` on each of them, using
+// up to `parallelism` worker threads (0 picks the hardware concurrency).
+//
+// Compilations share the process wide `CompileContext` (or spawn independent
+// `iree-compile` processes with the CLI backend). Graphs that share a name or
+// are structurally identical are compiled back to back on the same worker; with
+// `remove = false` the latter are then served from the kernel cache.
+//
+// Returns one result per graph, in the same order as `graphs`. A failure to
+// compile one graph does not affect the others.
+inline std::vector<ErrorOr<std::vector<uint8_t>>>
+compileAllToArtifacts(std::span<Graph *const> graphs, Backend backend,
+                      size_t parallelism = 0, bool remove = false) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling " << graphs.size()
+                                            << " Graphs to artifacts");
+  std::vector<std::optional<ErrorOr<std::vector<uint8_t>>>> slots(
+      graphs.size());
+  std::vector<std::vector<size_t>> groups =
+      detail::groupGraphsForCompileAll(graphs, backend, slots);
+
+  // Each worker writes to distinct slots.
+  detail::runGroupsInParallel(
+      groups, parallelism, [&](const std::vector<size_t> &group) {
+        for (size_t i : group)
+          slots[i].emplace(graphs[i]->compileToArtifact(backend, remove));
+      });
+
+  std::vector<ErrorOr<std::vector<uint8_t>>> results;
+  results.reserve(graphs.size());
+  for (size_t i = 0; i < graphs.size(); ++i) {
+    if (isError(*slots[i]))
+      FUSILLI_LOG_LABEL_ENDL("ERROR: Failed to compile Graph " << i << ": "
+                                                               << *slots[i]);
+    results.push_back(std::move(*slots[i]));
+  }
+  return results;
+}
+
+// Compiles each of `graphs` for `handle` and loads the resulting artifacts,
+// equivalent to calling `Graph::compile(handle, remove)` on each of them,
+// using up to `parallelism` worker threads as in `compileAllToArtifacts()`.
+//
+// Both compiling and loading run on the workers, so at startup, when the
+// artifacts of most graphs are already in the kernel cache, the VM context
+// creation of each graph (bytecode module parsing, function resolution)
+// proceeds concurrently rather than one graph at a time. The graphs share
+// the HAL module of the device.
+//
+// Returns one status per graph, in the same order as `graphs`.
+inline std::vector<ErrorObject> compileAll(std::span<Graph *const> graphs,
+                                           const Handle &handle,
+                                           size_t parallelism = 0,
+                                           bool remove = false) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling and loading " << graphs.size()
+                                                        << " Graphs");
+  std::vector<std::optional<ErrorOr<std::vector<uint8_t>>>> invalid(
+      graphs.size());
+  std::vector<std::vector<size_t>> groups =
+      detail::groupGraphsForCompileAll(graphs, handle.getBackend(), invalid);
+
+  std::vector<ErrorObject> statuses(graphs.size(), ok());
+  for (size_t i = 0; i < graphs.size(); ++i)
+    if (invalid[i].has_value())
+      statuses[i] = ErrorObject(*invalid[i]);
+  detail::runGroupsInParallel(
+      groups, parallelism, [&](const std::vector<size_t> &group) {
+        for (size_t i : group)
+          statuses[i] = graphs[i]->compile(handle, remove);
+      });
+  for (size_t i = 0; i < graphs.size(); ++i)
+    if (isError(statuses[i]))
+      FUSILLI_LOG_LABEL_ENDL("ERROR: Failed to compile Graph " << i << ": "
+                                                               << statuses[i]);
+  return statuses;
+}
+
+// Returns the name of the function of the `index`-th graph in a module emitted
+// by `emitModuleAsm()`.
+inline std::string getModuleEntryPoint(size_t index) {
+  return "main_" + std::to_string(index);
+}
+
+// Emits the MLIR assembly of one module holding each of `graphs` as a separate
+// function (see `getModuleEntryPoint()`). Module-scope declarations repeated
+// across graphs, like the function of a custom op used by several of them, are
+// emitted once.
+inline ErrorOr<std::string> emitModuleAsm(std::span<Graph *const> graphs) {
+  FUSILLI_RETURN_ERROR_IF(graphs.empty(), ErrorCode::InvalidArgument,
+                          "Module has no graphs");
+  std::vector<std::string> moduleScope;
+  std::string functions;
+  for (size_t i = 0; i < graphs.size(); ++i) {
+    FUSILLI_RETURN_ERROR_IF(graphs[i] == nullptr, ErrorCode::InvalidArgument,
+                            "Graph is null");
+    FUSILLI_ASSIGN_OR_RETURN(
+        std::string function,
+        graphs[i]->emitFunctionAsm(getModuleEntryPoint(i), moduleScope));
+    functions += function;
+  }
+
+  std::string declarations;
+  std::unordered_set<std::string> seen;
+  for (const auto &decl : moduleScope)
+    if (seen.insert(decl).second)
+      declarations += decl;
+
+  constexpr std::string_view schema = R"(
+module @module {{
+  {0}{1}
+}}
+  )";
+
+  std::string output = std::format(schema,
+                                   declarations, // {0}
+                                   functions     // {1}
+  );
+  FUSILLI_LOG_ENDL(output);
+  return ok(output);
+}
+
+// Compiles `graphs` into one VMFB artifact for `backend` holding a function
+// per graph (see `emitModuleAsm()`). One compiler invocation replaces one per
+// graph, and the artifact is loaded once for all of them (see
+// `compileModule()`).
+//
+// The module is compiled with the compile options attached to the first graph
+// and cached like a graph named after it with a `_module` suffix; set
+// `remove = true` to remove its cache files once compiled.
+inline ErrorOr<std::vector<uint8_t>>
+compileModuleToArtifact(std::span<Graph *const> graphs, Backend backend,
+                        bool remove = false) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Compiling " << graphs.size()
+                                            << " Graphs to one module");
+  FUSILLI_ASSIGN_OR_RETURN(std::string generatedAsm, emitModuleAsm(graphs));
+  Graph module;
+  module.setName(graphs.front()->getName() + "_module")
+      .setCompileOptions(graphs.front()->getCompileOptions());
+  FUSILLI_ASSIGN_OR_RETURN(
+      std::filesystem::path vmfbPath,
+      module.getCompiledArtifact(backend, generatedAsm, remove));
+  return readArtifactBytes(vmfbPath);
+}
+
+// Compiles `graphs` into one module for `handle` (see
+// `compileModuleToArtifact()`) and loads it once: the graphs share one VM
+// context, with each graph executing its own function of the module (see
+// `Graph::loadFromModule()`). As a VM context runs one invocation at a time,
+// concurrent executions of the graphs borrow from one shared pool of contexts.
+//
+// The first graph owns the loaded module, and must stay loaded while the
+// others execute.
+inline ErrorObject compileModule(std::span<Graph *const> graphs,
+                                 const Handle &handle, bool remove = false) {
+  FUSILLI_ASSIGN_OR_RETURN(
+      std::vector<uint8_t> vmfbBytes,
+      compileModuleToArtifact(graphs, handle.getBackend(), remove));
+  auto owner =
+      std::make_shared<const std::vector<uint8_t>>(std::move(vmfbBytes));
+  std::span<const uint8_t> view(*owner);
+  FUSILLI_CHECK_ERROR(graphs.front()->loadFromArtifact(
+      handle, view, std::move(owner), getModuleEntryPoint(0)));
+  for (size_t i = 1; i < graphs.size(); ++i)
+    FUSILLI_CHECK_ERROR(graphs[i]->loadFromModule(handle, *graphs.front(),
+                                                  getModuleEntryPoint(i)));
+  return ok();
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_COMPILE_ALL_H
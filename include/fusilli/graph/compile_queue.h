@@ -0,0 +1,307 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains CompileQueue, which compiles graphs on a pool of worker
+// threads in priority order, within optional per-graph time budgets.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_COMPILE_QUEUE_H
+#define FUSILLI_GRAPH_COMPILE_QUEUE_H
+
+#include "fusilli/backend/compile_options.h"
+#include "fusilli/backend/compile_report.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/cache.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Options of a `CompileQueue`.
+struct CompileQueueOptions {
+  // Number of worker threads compiling graphs. 0 picks the hardware
+  // concurrency.
+  size_t parallelism = 0;
+  // Whether to remove the cache files of each graph once it is destroyed, see
+  // `Graph::compile()`.
+  bool remove = false;
+};
+
+// Outcome of a graph compiled by a `CompileQueue`.
+struct CompileQueueResult {
+  // Whether the graph was compiled with the cheap compiler settings of
+  // `CompileOptions::fastCompile()` to meet its budget. Call
+  // `Graph::compile()` later (e.g. once the process is idle) to replace the
+  // artifact with the fully optimized one.
+  bool fastCompiled = false;
+  // Time the graph waited in the queue, and then spent compiling and loading.
+  std::chrono::nanoseconds queueTime{0};
+  std::chrono::nanoseconds compileTime{0};
+};
+
+// CompileQueue orders the compiles enqueued at model load so that the few
+// graphs gating the first request don't wait behind hundreds of others:
+// workers always take the pending graph of highest priority (first enqueued
+// among equals), and compile and load it like `Graph::compile()`.
+//
+// A graph may also get a budget, the time from enqueuing until it must be
+// loaded. When a worker takes a graph whose remaining budget can't fit a
+// full compile, estimated from the compiles the queue ran so far, it
+// compiles the graph with `CompileOptions::fastCompile()` instead, unless the
+// fully optimized artifact is already in the kernel cache. Budgets are
+// best effort: a compile that started is never interrupted.
+//
+// Like with `compileAll()`, graphs sharing a cache directory (i.e. a name)
+// never compile concurrently, and structurally identical graphs compiling at
+// the same time share one compilation.
+//
+// Usage:
+//   CompileQueue queue(handle);
+//   auto first = queue.enqueue(prefillGraph, /*priority=*/10,
+//                              std::chrono::seconds(2));
+//   for (Graph &graph : otherGraphs)
+//     queue.enqueue(graph);
+//   FUSILLI_CHECK_ERROR(first.get());
+//   ... serve the first request ...
+//   queue.wait();
+class CompileQueue {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Starts the workers compiling for `handle`, which must outlive the queue.
+  explicit CompileQueue(const Handle &handle,
+                        const CompileQueueOptions &options = {})
+      : handle_(handle), options_(options) {
+    size_t parallelism = options.parallelism;
+    if (parallelism == 0)
+      parallelism = std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(parallelism);
+    for (size_t t = 0; t < parallelism; ++t)
+      workers_.emplace_back([this] { run(); });
+  }
+
+  // Enqueues `graph`, which must outlive its compilation and not be used
+  // otherwise until then, for compiling with `priority` (higher first) and
+  // within `budget` of now, if set. Returns a future holding the outcome.
+  std::shared_future<ErrorOr<CompileQueueResult>>
+  enqueue(Graph &graph, int priority = 0,
+          std::optional<std::chrono::nanoseconds> budget = std::nullopt) {
+    Entry entry;
+    entry.graph = &graph;
+    entry.priority = priority;
+    entry.enqueued = Clock::now();
+    if (budget.has_value())
+      entry.deadline = entry.enqueued + *budget;
+    entry.cacheDir =
+        CacheFile::getPath(graph.getName(), "").parent_path().string();
+    std::shared_future<ErrorOr<CompileQueueResult>> future =
+        entry.promise.get_future().share();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entry.sequence = nextSequence_++;
+      pending_.push_back(std::move(entry));
+    }
+    workAvailable_.notify_one();
+    return future;
+  }
+
+  // Blocks until every enqueued graph finished compiling.
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [&] { return pending_.empty() && running_ == 0; });
+  }
+
+  // Returns the number of enqueued graphs no worker took yet.
+  size_t getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+  }
+
+  // Returns the estimated time of a full compile that misses the kernel
+  // cache, once the queue ran one.
+  std::optional<std::chrono::nanoseconds> getCompileTimeEstimate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return compileTimeEstimate_;
+  }
+
+  // Delete copy and move constructors, the workers refer to `this`.
+  CompileQueue(const CompileQueue &) = delete;
+  CompileQueue &operator=(const CompileQueue &) = delete;
+  CompileQueue(CompileQueue &&) = delete;
+  CompileQueue &operator=(CompileQueue &&) = delete;
+
+  // Waits for the compiles in progress. Graphs no worker took yet are not
+  // compiled, and their futures hold `ErrorCode::NotCompiled`.
+  ~CompileQueue() {
+    std::vector<Entry> dropped;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+      dropped.swap(pending_);
+    }
+    workAvailable_.notify_all();
+    for (Entry &entry : dropped)
+      entry.promise.set_value(error(ErrorCode::NotCompiled,
+                                    "CompileQueue destroyed before compiling "
+                                    "Graph " +
+                                        entry.graph->getName()));
+    for (std::thread &worker : workers_)
+      worker.join();
+  }
+
+private:
+  struct Entry {
+    Graph *graph = nullptr;
+    int priority = 0;
+    uint64_t sequence = 0;
+    Clock::time_point enqueued;
+    std::optional<Clock::time_point> deadline;
+    std::string cacheDir;
+    std::promise<ErrorOr<CompileQueueResult>> promise;
+  };
+
+  // Weight of the latest compile in the running compile time estimate.
+  static constexpr double kEstimateWeight = 0.25;
+
+  // Removes and returns the pending entry of highest priority whose cache
+  // directory no worker is compiling in, if any.
+  std::optional<Entry> takeNext() {
+    auto best = pending_.end();
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+      if (busyCacheDirs_.contains(it->cacheDir))
+        continue;
+      if (best == pending_.end() || it->priority > best->priority ||
+          (it->priority == best->priority && it->sequence < best->sequence))
+        best = it;
+    }
+    if (best == pending_.end())
+      return std::nullopt;
+    Entry entry = std::move(*best);
+    pending_.erase(best);
+    return entry;
+  }
+
+  // Returns whether the remaining budget of `entry` can't fit a full compile.
+  bool isOverBudget(const Entry &entry, Clock::time_point now) const {
+    if (!entry.deadline.has_value())
+      return false;
+    std::chrono::nanoseconds remaining = *entry.deadline - now;
+    return remaining <= compileTimeEstimate_.value_or(
+                            std::chrono::nanoseconds(0));
+  }
+
+  // Compiles and loads the graph of `entry`, fast if `fast` is set and its
+  // fully optimized artifact isn't cached.
+  ErrorOr<CompileQueueResult> compileEntry(Entry &entry, bool fast,
+                                      Clock::time_point start) {
+    Graph &graph = *entry.graph;
+    CompileQueueResult result;
+    result.queueTime = start - entry.enqueued;
+    if (fast) {
+      CompileOptions options = graph.resolveCompileOptions(handle_);
+      FUSILLI_ASSIGN_OR_RETURN(
+          bool cached, graph.isArtifactCached(handle_.getBackend(), options));
+      fast = !cached;
+    }
+    if (fast) {
+      FUSILLI_LOG_LABEL_ENDL("INFO: Graph " << graph.getName()
+                                            << " is over its compile budget, "
+                                               "compiling it fast");
+      FUSILLI_CHECK_ERROR(graph.compileFastTier(
+          handle_, graph.resolveCompileOptions(handle_), options_.remove));
+      result.fastCompiled = true;
+    } else {
+      CompileReport report;
+      FUSILLI_CHECK_ERROR(graph.compile(handle_, options_.remove, &report));
+      if (!report.cacheHit)
+        recordCompileTime(Clock::now() - start);
+    }
+    result.compileTime = Clock::now() - start;
+    return ok(result);
+  }
+
+  // Updates the running estimate of full compile times with `elapsed`.
+  void recordCompileTime(std::chrono::nanoseconds elapsed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!compileTimeEstimate_.has_value()) {
+      compileTimeEstimate_ = elapsed;
+      return;
+    }
+    compileTimeEstimate_ = std::chrono::nanoseconds(static_cast<int64_t>(
+        kEstimateWeight * static_cast<double>(elapsed.count()) +
+        (1 - kEstimateWeight) *
+            static_cast<double>(compileTimeEstimate_->count())));
+  }
+
+  // Worker loop, taking entries until the queue is destroyed.
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      std::optional<Entry> entry;
+      workAvailable_.wait(lock, [&] {
+        return stopping_ || (entry = takeNext()).has_value();
+      });
+      if (!entry.has_value())
+        return;
+      Clock::time_point start = Clock::now();
+      bool fast = isOverBudget(*entry, start);
+      busyCacheDirs_.insert(entry->cacheDir);
+      ++running_;
+      lock.unlock();
+
+      ErrorOr<CompileQueueResult> result = compileEntry(*entry, fast, start);
+      if (isError(result))
+        FUSILLI_LOG_LABEL_ENDL("ERROR: Failed to compile Graph "
+                               << entry->graph->getName() << ": "
+                               << ErrorObject(result));
+      entry->promise.set_value(std::move(result));
+
+      lock.lock();
+      busyCacheDirs_.erase(entry->cacheDir);
+      --running_;
+      // Entries of the released cache directory may be taken now.
+      workAvailable_.notify_all();
+      if (pending_.empty() && running_ == 0)
+        idle_.notify_all();
+    }
+  }
+
+  const Handle &handle_;
+  CompileQueueOptions options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable workAvailable_;
+  std::condition_variable idle_;
+  std::vector<Entry> pending_;
+  std::unordered_set<std::string> busyCacheDirs_;
+  size_t running_ = 0;
+  uint64_t nextSequence_ = 0;
+  std::optional<std::chrono::nanoseconds> compileTimeEstimate_;
+  bool stopping_ = false;
+
+  std::vector<std::thread> workers_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_COMPILE_QUEUE_H
@@ -15,46 +15,86 @@
 #define FUSILLI_GRAPH_GRAPH_H
 
 #include "fusilli/attributes/batchnorm_attributes.h"
+#include "fusilli/attributes/collective_attributes.h"
 #include "fusilli/attributes/common.h"
 #include "fusilli/attributes/conv_attributes.h"
 #include "fusilli/attributes/custom_op_attributes.h"
 #include "fusilli/attributes/layernorm_attributes.h"
 #include "fusilli/attributes/matmul_attributes.h"
+#include "fusilli/attributes/optimizer_attributes.h"
 #include "fusilli/attributes/pointwise_attributes.h"
 #include "fusilli/attributes/reduction_attributes.h"
 #include "fusilli/attributes/rmsnorm_attributes.h"
 #include "fusilli/attributes/sdpa_attributes.h"
+#include "fusilli/attributes/shape_attributes.h"
 #include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/attributes/types.h"
 #include "fusilli/backend/backend.h"
 #include "fusilli/backend/buffer.h"
 #include "fusilli/backend/compile_command.h"
+#include "fusilli/backend/compile_options.h"
+#include "fusilli/backend/compile_report.h"
 #include "fusilli/backend/compile_session.h"
+#include "fusilli/backend/compile_statistics.h"
+#include "fusilli/backend/completion_poller.h"
+#include "fusilli/backend/cost_model.h"
+#include "fusilli/backend/execution_timing.h"
+#include "fusilli/backend/fence.h"
 #include "fusilli/backend/handle.h"
+#include "fusilli/backend/usage_journal.h"
+#include "fusilli/backend/workspace_report.h"
 #include "fusilli/graph/context.h"
 #include "fusilli/node/batchnorm_node.h"
+#include "fusilli/node/collective_node.h"
 #include "fusilli/node/conv_node.h"
 #include "fusilli/node/custom_op_node.h"
 #include "fusilli/node/layernorm_node.h"
 #include "fusilli/node/matmul_node.h"
 #include "fusilli/node/node.h"
+#include "fusilli/node/optimizer_node.h"
 #include "fusilli/node/pointwise_node.h"
+#include "fusilli/node/pooling_node.h"
 #include "fusilli/node/reduction_node.h"
 #include "fusilli/node/rmsnorm_node.h"
 #include "fusilli/node/sdpa_node.h"
+#include "fusilli/node/shape_node.h"
+#include "fusilli/node/softmax_node.h"
+#include "fusilli/support/arena.h"
 #include "fusilli/support/cache.h"
+#include "fusilli/support/compression.h"
+#include "fusilli/support/event_log.h"
 #include "fusilli/support/external_tools.h"
 #include "fusilli/support/extras.h"
+#include "fusilli/support/file_lock.h"
+#include "fusilli/support/hash.h"
+#include "fusilli/support/kernel_cache.h"
 #include "fusilli/support/logging.h"
-
+#include "fusilli/support/mapped_file.h"
+#include "fusilli/support/remote_kernel_cache.h"
+#include "fusilli/support/single_flight.h"
+#include "fusilli/support/tracing.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -64,6 +104,8 @@
 #define IREE_COMPILE_OUTPUT_FILENAME "iree-compile-output.vmfb"
 #define IREE_COMPILE_COMMAND_FILENAME "iree-compile-command.txt"
 #define IREE_COMPILE_STATISTICS_FILENAME "iree-compile-statistics.json"
+#define IREE_COMPILE_DIGEST_FILENAME "iree-compile-digest.txt"
+#define IREE_COMPILE_OUTPUT_DIGEST_FILENAME "iree-compile-output-digest.txt"
 
 namespace fusilli {
 
@@ -72,46 +114,238 @@ inline bool checkCompileBackendEnv() {
   return backend && strcmp(backend, "0") != 0;
 }
 
+inline bool checkKernelCacheDisabledEnv() {
+  const char *disable = std::getenv("FUSILLI_DISABLE_KERNEL_CACHE");
+  return disable && strcmp(disable, "0") != 0;
+}
+
+// ExecutionPlan is a graph invocation with its buffers bound ahead of time
+// (see `Graph::bind()`): the VM input list is built and validated once, so
+// `run()` only invokes the compiled function. This removes the per-call host
+// overhead of `Graph::execute()` (variant pack lookups, list creation and
+// reference counting) for small graphs executed many times.
+//
+// A plan keeps the loaded artifact and the bound buffers alive, so it stays
+// valid (and keeps running the artifact it was bound to) even if the graph is
+// recompiled or destroyed. As each plan owns its VM context, different plans
+// (and `Graph::execute()` calls) may run concurrently, but a plan may only be
+// run by one thread at a time.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(ExecutionPlan plan,
+//                            graph.bind(variantPack, workspace));
+//   for (...)
+//     FUSILLI_CHECK_ERROR(plan.run(handle));
+class ExecutionPlan {
+public:
+  // Invokes the bound graph on `handle`, which must be for the backend the
+  // graph was compiled for.
+  ErrorObject run(const Handle &handle) const;
+
+  // Delete copy constructors and keep default move operations.
+  ExecutionPlan(const ExecutionPlan &) = delete;
+  ExecutionPlan &operator=(const ExecutionPlan &) = delete;
+  ExecutionPlan(ExecutionPlan &&) noexcept = default;
+  ExecutionPlan &operator=(ExecutionPlan &&) noexcept = default;
+  ~ExecutionPlan() = default;
+
+private:
+  friend class Graph;
+
+  // Class should be constructed using `Graph::bind()`.
+  ExecutionPlan(std::shared_ptr<const void> artifactOwner,
+                IreeVmContextUniquePtrType vmContext,
+                iree_vm_function_t vmFunction,
+                IreeVmListUniquePtrType inputList, Backend backend,
+                std::shared_ptr<std::atomic<uint64_t>> executeCount,
+                const EventTag &eventTag)
+      : artifactOwner_(std::move(artifactOwner)),
+        vmContext_(std::move(vmContext)), vmFunction_(vmFunction),
+        inputList_(std::move(inputList)), backend_(backend),
+        executeCount_(std::move(executeCount)), eventTag_(eventTag) {}
+
+  // Keeps the VMFB bytes backing `vmContext_` alive, see
+  // `Graph::loadedArtifactOwner_`. Declared before vmContext_ so the context
+  // is released first.
+  std::shared_ptr<const void> artifactOwner_;
+
+  // VM context over the modules of the graph when bound, owned by the plan.
+  IreeVmContextUniquePtrType vmContext_;
+  iree_vm_function_t vmFunction_;
+
+  // Prebuilt arguments of `vmFunction_`, retaining the bound buffers.
+  IreeVmListUniquePtrType inputList_;
+
+  Backend backend_;
+
+  // Execution count of the bound graph, see `Graph::getExecuteCount()`.
+  std::shared_ptr<std::atomic<uint64_t>> executeCount_;
+
+  // Identifies the bound graph in the event log, see `Graph::eventTag_`.
+  EventTag eventTag_;
+};
+
+// Concrete dims of tensors with dynamic dimensions, selecting a static
+// specialization of a dynamic graph (see `Graph::setShapeBuckets()`).
+using ShapeBucket =
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::vector<int64_t>>;
+
+class PartitionedGraph;
+
 class Graph : public INode {
 public:
   Graph() : INode(Context{}) {}
 
   // Validates the graph for correctness and infers missing properties.
   ErrorObject validate() {
+    FUSILLI_TRACE_ZONE("fusilli::Graph::validate");
+    FUSILLI_TRACE_ZONE_TEXT(getName());
     FUSILLI_LOG_LABEL_ENDL("INFO: Validating Graph");
+    detail::EventScope eventScope(EventPhase::Validate, eventTag_);
     FUSILLI_RETURN_ERROR_IF(getName().empty(), ErrorCode::AttributeNotSet,
                             "Graph name not set");
+    if (!dirtyTensors_.empty())
+      return revalidate();
+    if (autocast_)
+      FUSILLI_CHECK_ERROR(autocast());
+    // Remember which properties of operation outputs are left to inference,
+    // so that `revalidate()` can infer them again.
+    recordInferredProperties();
     // Validate nodes:
     // This infers missing tensor properties such as dims,
     // stride, dtype based on context.
     FUSILLI_CHECK_ERROR(validateSubtree());
+    // Fold scalar-only subgraphs and drop duplicated and unused nodes before
+    // anything else looks at them, so they are neither validated further,
+    // fingerprinted nor emitted.
+    foldConstants();
+    eliminateCommonSubexpressions();
+    eliminateDeadNodes();
+    foldConvBatchNorms();
+    FUSILLI_CHECK_ERROR(fuseHorizontalMatmuls());
+    FUSILLI_CHECK_ERROR(getConvLoweringHint());
     // Validate inputs:
     // This has to happen after `validateSubtree` to infer any
     // missing properties on inputs first.
     for (const auto &input : fullGraphInputs_) {
-      FUSILLI_CHECK_ERROR(input->validate());
+      FUSILLI_CHECK_ERROR(validateInput(input));
     }
     // Validate outputs:
     // This has to happen after `validateSubtree` to infer any
     // missing properties on outputs first. fullGraphOutputs_ contains all
     // operation outputs (both graph-level and intermediates), so this also
     // catches broadcast strides on intermediate tensors between operations.
+    inPlaceDonors_.clear();
     for (const auto &output : fullGraphOutputs_) {
-      FUSILLI_CHECK_ERROR(output->validate());
-      // TODO(fusilli#276): Support broadcast strides on operation outputs.
-      // This requires logical→physical broadcast conversion in the ASM
-      // emitter. For now, reject broadcast on any operation output.
-      FUSILLI_RETURN_ERROR_IF(
-          output->hasBroadcastDims(), ErrorCode::InvalidAttribute,
-          "Tensor '" + output->getName() +
-              "' has broadcast strides (stride=0) on an operation output, "
-              "which is not yet supported");
+      FUSILLI_CHECK_ERROR(validateOutput(output));
     }
+    // Drop layout conversions of intermediate tensors where possible. This
+    // only affects the emitted assembly, not the tensors' properties.
+    optimizeLayouts();
+    shareCustomOpFunctions();
+    // Fingerprint the validated graph so compile-side cache lookups can skip
+    // emitting assembly (see `compileToArtifact()`).
+    fingerprint_ = computeFingerprint();
+    eventTag_ = computeEventTag();
     FUSILLI_LOG_LABEL_ENDL("INFO: Graph validation completed successfully");
     isValidated_ = true;
     return ok();
   }
 
+  // Returns the structural fingerprint of this graph computed by `validate()`.
+  // The fingerprint covers the context, every node (type and attributes) and
+  // every tensor (dtype, dims, strides and how it connects nodes), but not
+  // graph, node or tensor names. Graphs with equal fingerprints emit MLIR
+  // assembly that differs at most in SSA value names, and therefore share
+  // compiled artifacts.
+  //
+  // Graph inputs and outputs are bound positionally, in order of their names,
+  // so that order is part of the fingerprint: renaming tensors such that they
+  // sort differently yields a different fingerprint.
+  ErrorOr<std::string> getFingerprint() const {
+    FUSILLI_RETURN_ERROR_IF(
+        !isValidated_, ErrorCode::NotValidated,
+        "Graph must be validated before computing its fingerprint");
+    return ok(fingerprint_);
+  }
+
+  // Marks `tensor` as edited after validation (e.g. through `setDim()` or
+  // `setStride()`), so that the next `validate()` only infers and checks the
+  // nodes downstream of the edited tensors again instead of the whole graph.
+  // Properties of operation outputs that were inferred are inferred anew;
+  // properties set explicitly, including all properties of `tensor` itself,
+  // are kept. Edits that change the structure of the graph, its names or
+  // in-place declarations need a new graph. Has no effect on a graph that
+  // was not validated yet.
+  //
+  // Usage (e.g. a shape sweep):
+  //   x->setDim({n, 64}).setStride({64, 1});
+  //   FUSILLI_CHECK_ERROR(graph.markDirty(x).validate());
+  Graph &markDirty(const std::shared_ptr<TensorAttr> &tensor) {
+    if (!isValidated_ && dirtyTensors_.empty())
+      return *this;
+    isValidated_ = false;
+    inferredProperties_.erase(tensor);
+    dirtyTensors_.push_back(tensor);
+    return *this;
+  }
+
+  // Serializes the graph to a compact binary format: its context, graph
+  // inputs and outputs, and every node with its attributes and tensors.
+  // `deserialize()` turns the bytes back into an equivalent graph, e.g. to
+  // replay a graph captured in another process. Graphs may be serialized
+  // before or after validation. Compile settings (options, shape buckets,
+  // tuning specs) and custom op shape inference callbacks are code or
+  // process state and are not serialized.
+  ErrorOr<std::vector<uint8_t>> serialize() const;
+
+  // Rebuilds a graph from the bytes of `serialize()`. The graph has to be
+  // validated before it is compiled; its tensors can be looked up by name
+  // with `getTensor()` to bind buffers.
+  static ErrorOr<std::unique_ptr<Graph>>
+  deserialize(std::span<const uint8_t> bytes);
+
+  // Records the graph, compiled or loaded for `backend` with `options`, in
+  // the usage journal when it is enabled (see `UsageJournal`). Called by
+  // `compile()`, `compileTiered()` and `ArtifactBundle::load()`. Failures are
+  // logged rather than returned, as the graph is usable regardless.
+  void recordUsage(Backend backend, const CompileOptions &options) const {
+    UsageJournal &journal = UsageJournal::get();
+    if (!journal.isEnabled())
+      return;
+    ErrorObject status = [&]() -> ErrorObject {
+      UsageJournalEntry entry;
+      FUSILLI_ASSIGN_OR_RETURN(entry.fingerprint, getFingerprint());
+      entry.backend = backend;
+      entry.compileOptions = options.toString();
+      if (backend == Backend::AMDGPU)
+        entry.target = detail::getRocmTarget(options.resolveFlags(backend));
+      std::string key = Hasher()
+                            .update(entry.fingerprint)
+                            .update(kBackendToStr.at(backend))
+                            .update(entry.compileOptions)
+                            .update(entry.target)
+                            .hexDigest();
+      if (!journal.claim(key))
+        return ok();
+      FUSILLI_ASSIGN_OR_RETURN(entry.graph, serialize());
+      entry.graphName = getName();
+      return journal.write(key, std::move(entry));
+    }();
+    if (isError(status))
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to journal graph '"
+                             << getName() << "': " << status);
+  }
+
+  // Returns the graph input or output named `name`, or nullptr.
+  std::shared_ptr<TensorAttr> getTensor(const std::string &name) const {
+    for (const auto *tensors : {&fullGraphInputs_, &fullGraphOutputs_})
+      for (const auto &t : *tensors)
+        if (t->getName() == name)
+          return t;
+    return nullptr;
+  }
+
   // Compiles the graph using IREE compiler and sets up the IREE VM context for
   // future g->execute calls. This is the default JIT convenience API.
   //
@@ -122,13 +356,202 @@ public:
   // The compiled artifact is backend-specific and is immediately loaded using
   // the same backend from `handle`.
   //
+  // Artifacts served from the kernel cache are memory-mapped rather than read
+  // (see `loadFromArtifactFile()`), so graphs sharing a kernel share its pages.
+  //
   // Set `remove = true` to remove compilation artifacts (cache files) when
   // this `Graph` instance goes out of scope.
-  ErrorObject compile(const Handle &handle, bool remove = false) {
+  //
+  // With shape buckets attached (see `setShapeBuckets()`), their static
+  // specializations are compiled and loaded too, and with a hot-shape
+  // threshold set (see `setHotShapeThreshold()`), shape profiling starts
+  // over. With a workspace cap set (see `setMaxWorkspaceSize()`), an
+  // artifact over the cap is recompiled without split reductions.
+  //
+  // If `report` is set, it is reset and filled with the wall time of each
+  // phase of compiling and loading the graph's own artifact (specializations
+  // are not included), and the workspace size is queried as part of the
+  // compilation.
+  ErrorObject compile(const Handle &handle, bool remove = false,
+                      CompileReport *report = nullptr) {
     FUSILLI_LOG_LABEL_ENDL("INFO: Compiling Graph");
-    FUSILLI_ASSIGN_OR_RETURN(auto vmfbBytes,
-                             compileToArtifact(handle.getBackend(), remove));
-    return loadFromArtifact(handle, vmfbBytes);
+    detail::EventScope eventScope(EventPhase::Compile, eventTag_);
+    // Replaces a pending lazy compilation, unless called by it.
+    if (lazyCompile_ && !lazyCompile_->compiling)
+      lazyCompile_.reset();
+    auto start = std::chrono::steady_clock::now();
+    // A report is gathered even when the caller passes none, for the cache
+    // hit counters of the handle (see `Handle::getExecutionStats()`).
+    CompileReport ownReport;
+    ReportScope reportScope(*this, report ? report : &ownReport);
+    CompileOptions options = resolveCompileOptions(handle);
+    FUSILLI_ASSIGN_OR_RETURN(
+        CompiledArtifact artifact,
+        compileArtifact(handle.getBackend(), options, remove));
+    FUSILLI_CHECK_ERROR(loadCompiledArtifact(handle, std::move(artifact)));
+    FUSILLI_CHECK_ERROR(enforceMaxWorkspaceSize(handle, options, remove));
+    if (report) {
+      detail::PhaseTimer timer(&report->workspaceQuery);
+      FUSILLI_CHECK_ERROR(getWorkspaceSize());
+    }
+    for (const ShapeBucket &bucket : shapeBuckets_) {
+      FUSILLI_ASSIGN_OR_RETURN(
+          Specialization specialization,
+          compileSpecialization(handle, bucket, options, remove));
+      specializations_.push_back(std::move(specialization));
+    }
+    recordUsage(handle.getBackend(), options);
+    handle.executionCounters_->recordCompile(
+        report_->cacheHit,
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count()));
+    if (hotShapeThreshold_ > 0) {
+      hotShapes_ = std::make_unique<HotShapeProfile>();
+      hotShapes_->handle = &handle;
+      hotShapes_->options = std::move(options);
+      hotShapes_->remove = remove;
+      hotShapes_->threshold = hotShapeThreshold_;
+      hotShapes_->maxSpecializations = maxHotSpecializations_;
+      for (size_t uid = 0; uid < tensorsByUid_.size(); ++uid)
+        if (tensorsByUid_[uid]->hasDynamicDims())
+          hotShapes_->dynamicUids.push_back(uid);
+    }
+    return ok();
+  }
+
+  // Non-blocking variant of `compile()`. Compiles and loads the graph on a
+  // background thread and returns a future holding the resulting status, so
+  // callers can keep serving requests on a fallback path in the meantime.
+  //
+  // Until the future is ready, `execute()` and `getWorkspaceSize()` return
+  // `ErrorCode::NotCompiled`; no other method of this `Graph` may be called
+  // concurrently. `handle` must outlive the compilation. Destroying the
+  // `Graph` waits for a pending compilation to finish.
+  std::shared_future<ErrorObject> compileAsync(const Handle &handle,
+                                               bool remove = false) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compiling Graph asynchronously");
+    if (pendingCompile_.isPending()) {
+      std::promise<ErrorObject> busy;
+      busy.set_value(error(ErrorCode::InvalidArgument,
+                           "Graph already has a pending compileAsync()"));
+      return busy.get_future().share();
+    }
+    pendingCompile_.future =
+        std::async(std::launch::async, [this, &handle, remove]() {
+          return compile(handle, remove);
+        }).share();
+    return pendingCompile_.future;
+  }
+
+  // Lazy variant of `compile()` for applications constructing many graphs,
+  // of which a given run may execute few. Only checks that the graph is
+  // validated and computes its fingerprint; the first `execute()` (or any
+  // other execution, or `getWorkspaceSize()`) then compiles and loads the
+  // graph as `compile(handle, remove)` would and returns its errors, so the
+  // startup cost is proportional to the graphs actually executed.
+  //
+  // With `prefetch = true`, the artifact is compiled on a background thread
+  // right away, and the first execution waits for it and only loads it from
+  // the kernel cache. Concurrent first executions compile once. Call
+  // `getWorkspaceSize()` first to allocate the workspace up front, which
+  // compiles the graph, or execute with a null workspace. `handle` must
+  // outlive the graph, and calling `compile()` or `compileTiered()` replaces
+  // the lazy compilation.
+  ErrorObject compileLazy(const Handle &handle, bool remove = false,
+                          bool prefetch = false) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compiling Graph lazily");
+    FUSILLI_RETURN_ERROR_IF(
+        pendingCompile_.isPending() || pendingTierUp_.future.valid(),
+        ErrorCode::InvalidArgument,
+        "Graph already has a pending compileAsync() or compileTiered()");
+    FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
+                            "Graph must be validated before compileLazy()");
+    FUSILLI_CHECK_ERROR(getFingerprint());
+    clearRuntimeState();
+    lazyCompile_ = std::make_unique<LazyCompile>();
+    // Bound here, where the graph is mutable, so that the const executions
+    // calling `compileOnFirstUse()` never cast constness away.
+    lazyCompile_->compile = [this, &handle, remove]() -> ErrorObject {
+      FUSILLI_CHECK_ERROR(compile(handle, remove));
+      return ErrorObject(getWorkspaceSize());
+    };
+    if (prefetch)
+      lazyCompile_->prefetch = std::async(
+          std::launch::async,
+          [this, backend = handle.getBackend(),
+           options = resolveCompileOptions(handle), remove]() {
+            return ErrorObject(compileToArtifact(backend, options, remove));
+          });
+    return ok();
+  }
+
+  // Tiered variant of `compile()` for latency sensitive callers. Compiles and
+  // loads the graph with cheap compiler settings (see
+  // `CompileOptions::fastCompile()`) so it can execute right away, while the
+  // fully optimized artifact is compiled on a background thread. Call
+  // `tierUp()` between executions to swap it in once it is ready. If the
+  // optimized artifact is already cached, it is loaded directly instead.
+  //
+  // Until the background compilation finishes, only `execute()`,
+  // `getWorkspaceSize()` and `tierUp()` may be called on this `Graph`.
+  // Destroying the `Graph` waits for the background compilation to finish.
+  ErrorObject compileTiered(const Handle &handle, bool remove = false) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compiling Graph in tiers");
+    FUSILLI_RETURN_ERROR_IF(
+        pendingCompile_.isPending() || pendingTierUp_.future.valid(),
+        ErrorCode::InvalidArgument,
+        "Graph already has a pending compileAsync() or compileTiered()");
+    lazyCompile_.reset();
+    Backend backend = handle.getBackend();
+    CompileOptions options = resolveCompileOptions(handle);
+
+    FUSILLI_ASSIGN_OR_RETURN(bool cached, isArtifactCached(backend, options));
+    if (cached) {
+      FUSILLI_LOG_LABEL_ENDL("INFO: Optimized artifact cached, skipping tiers");
+      return compile(handle, remove);
+    }
+
+    FUSILLI_CHECK_ERROR(compileFastTier(handle, options, remove));
+    recordUsage(backend, options);
+
+    // Only compile-side state is touched in the background, which `execute()`
+    // and `getWorkspaceSize()` never read.
+    pendingTierUp_.future = std::async(
+        std::launch::async, [this, backend, options = std::move(options),
+                             remove]() {
+          return compileToArtifact(backend, options, remove);
+        });
+    return ok();
+  }
+
+  // Loads the fully optimized artifact compiled in the background by
+  // `compileTiered()` once it is ready, replacing the fast one. Returns
+  // whether it was swapped in; with `wait = true`, blocks until the
+  // background compilation finishes rather than returning false.
+  //
+  // Swapping resets the workspace size, so call `getWorkspaceSize()` (and
+  // reallocate the workspace if it grew) before the next `execute()`. If the
+  // optimized artifact fails to compile or load, the error is returned and
+  // the fast artifact stays loaded.
+  ErrorOr<bool> tierUp(const Handle &handle, bool wait = false) {
+    if (!pendingTierUp_.future.valid())
+      return ok(false);
+    if (!wait && pendingTierUp_.isPending())
+      return ok(false);
+    ErrorOr<std::vector<uint8_t>> optimized = pendingTierUp_.future.get();
+    FUSILLI_CHECK_ERROR(optimized);
+    FUSILLI_LOG_LABEL_ENDL("INFO: Swapping in optimized artifact");
+    std::shared_ptr<const void> fastOwner = loadedArtifactOwner_;
+    std::span<const uint8_t> fastBytes = loadedArtifactBytes_;
+    ErrorObject status = loadFromArtifact(handle, std::move(*optimized));
+    if (isError(status)) {
+      if (fastOwner != nullptr)
+        FUSILLI_CHECK_ERROR(loadFromArtifact(handle, fastBytes, fastOwner));
+      return status;
+    }
+    return ok(true);
   }
 
   // Compiles the graph using IREE compiler to produce a backend-specific VMFB
@@ -137,8 +560,11 @@ public:
   //
   // If callers need artifacts for multiple backends, they should keep or
   // serialize each returned VMFB byte buffer before compiling the next backend.
-  // Fusilli owns only the in-process `cache_` for the most recent compile-side
-  // artifact; it does not provide persistent artifact storage or invalidation.
+  // Fusilli keeps the in-process `cache_` for the most recent compile-side
+  // artifact. When `remove = false`, compiled artifacts are also published to
+  // the persistent kernel cache (see `getCompiledArtifact()`) and reused by
+  // later `Graph` instances and processes with the same generated assembly,
+  // backend flags and compiler revision.
   //
   // Compiling a new artifact does not load or unload runtime state. If this
   // `Graph` already has an artifact loaded, that artifact remains executable
@@ -146,23 +572,33 @@ public:
   //
   // Set `remove = true` to remove compilation artifacts (cache files) when
   // this `Graph` instance goes out of scope.
-  ErrorOr<std::vector<uint8_t>> compileToArtifact(Backend backend,
-                                                  bool remove = false) {
-    FUSILLI_LOG_LABEL_ENDL("INFO: Compiling Graph to artifact");
-    FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
-                            "Graph must be validated before being compiled");
-
-    // Generate MLIR assembly for this graph.
-    FUSILLI_ASSIGN_OR_RETURN(std::string generatedAsm, emitAsm());
-
-    // Compile using IREE compiler or reuse cached artifact.
-    FUSILLI_ASSIGN_OR_RETURN(
-        auto vmfbPath, getCompiledArtifact(backend, generatedAsm, remove));
-
-    FUSILLI_LOG_LABEL_ENDL("INFO: Compiled Graph cached at \"" +
-                           vmfbPath.string() + "\"");
+  //
+  // Compiler flags come from the options attached with `setCompileOptions()`,
+  // or from the autotuned options recorded for them (see
+  // `saveTunedCompileOptions()`).
+  //
+  // If `report` is set, it is reset and filled with the wall time of each
+  // compilation phase, like for `compile()`.
+  ErrorOr<std::vector<uint8_t>>
+  compileToArtifact(Backend backend, bool remove = false,
+                    CompileReport *report = nullptr) {
+    return compileToArtifact(backend, resolveCompileOptions(backend), remove,
+                             report);
+  }
 
-    return readFileBytes(vmfbPath);
+  // Overload of the above compiling with `options` instead of the attached
+  // compile options.
+  ErrorOr<std::vector<uint8_t>>
+  compileToArtifact(Backend backend, const CompileOptions &options,
+                    bool remove = false, CompileReport *report = nullptr) {
+    ReportScope reportScope(*this, report);
+    FUSILLI_ASSIGN_OR_RETURN(CompiledArtifact artifact,
+                             compileArtifact(backend, options, remove));
+    if (artifact.path.has_value()) {
+      detail::PhaseTimer timer(reportPhase(&CompileReport::artifactRead));
+      return readArtifactBytes(*artifact.path);
+    }
+    return ok(std::move(artifact.bytes));
   }
 
   // Loads a compiled VMFB artifact onto the device owned by `handle`, creating
@@ -181,17 +617,47 @@ public:
   // before `execute()`.
   ErrorObject loadFromArtifact(const Handle &handle,
                                std::span<const uint8_t> vmfbBytes) {
+    return loadFromArtifact(
+        handle, std::vector<uint8_t>(vmfbBytes.begin(), vmfbBytes.end()));
+  }
+
+  // Overload of the above that takes ownership of `vmfbBytes` instead of
+  // copying them.
+  ErrorObject loadFromArtifact(const Handle &handle,
+                               std::vector<uint8_t> &&vmfbBytes) {
+    auto owner = std::make_shared<const std::vector<uint8_t>>(
+        std::move(vmfbBytes));
+    std::span<const uint8_t> view(*owner);
+    return loadFromArtifact(handle, view, std::move(owner));
+  }
+
+  // Zero-copy overload of the above. The loaded module references `vmfbBytes`
+  // in place; `owner` must keep them alive and unmodified, and is retained
+  // until the artifact is replaced or this `Graph` is destroyed. This lets
+  // several `Graph` instances share one buffer.
+  //
+  // `entryPoint` names the function of the module the graph executes, see
+  // `compileModule()` for artifacts holding the functions of several graphs.
+  ErrorObject loadFromArtifact(const Handle &handle,
+                               std::span<const uint8_t> vmfbBytes,
+                               std::shared_ptr<const void> owner,
+                               const std::string &entryPoint = "main") {
     FUSILLI_LOG_LABEL_ENDL("INFO: Loading compiled artifact into VM context");
     FUSILLI_RETURN_ERROR_IF(
         !isValidated_, ErrorCode::NotValidated,
         "Graph must be validated before loading a compiled artifact");
-    std::vector<uint8_t> artifactBytes(vmfbBytes.begin(), vmfbBytes.end());
+    FUSILLI_RETURN_ERROR_IF(owner == nullptr, ErrorCode::InvalidArgument,
+                            "Compiled artifact owner is null");
     // Loading replaces the currently executable artifact. Clear first so a
     // failed load cannot leave execute() using stale runtime state from an
     // older artifact.
     clearRuntimeState();
-    loadedArtifactBytes_ = std::move(artifactBytes);
+    loadedArtifactOwner_ = std::move(owner);
+    loadedArtifactBytes_ = vmfbBytes;
+    entryPoint_ = entryPoint;
+    detail::PhaseTimer timer(reportPhase(&CompileReport::vmContextCreation));
     ErrorObject status = createVmContext(handle);
+    timer.stop();
     if (isError(status)) {
       // createVmContext may have partially populated runtime state before
       // failing; leave the graph in a clean "not loaded" state.
@@ -199,13 +665,92 @@ public:
       return status;
     }
     loadedBackend_ = handle.getBackend();
+    moduleMemory_ = detail::TrackedMemory(
+        handle.memoryTracker_, detail::MemoryCategory::Modules,
+        vmfbBytes.size());
+    workspaceMemory_ = detail::TrackedMemory(
+        handle.memoryTracker_, detail::MemoryCategory::GraphWorkspace, 0);
+    return ok();
+  }
+
+  // Loads function `entryPoint` of the module `module` was loaded from (see
+  // `compileModule()`), sharing its VM context, modules and VMFB bytes
+  // instead of loading another copy of them. The graphs of a module then
+  // also share the pool of VM contexts of concurrent executions.
+  //
+  // `module` must stay loaded while this graph executes; loading another
+  // artifact into either graph only replaces the runtime state of that graph.
+  ErrorObject loadFromModule(const Handle &handle, const Graph &module,
+                             const std::string &entryPoint) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Loading function '"
+                           << entryPoint << "' of a shared VM context");
+    FUSILLI_RETURN_ERROR_IF(
+        !isValidated_, ErrorCode::NotValidated,
+        "Graph must be validated before loading a compiled artifact");
+    FUSILLI_RETURN_ERROR_IF(&module == this, ErrorCode::InvalidArgument,
+                            "Graph can't share its own VM context");
+    FUSILLI_RETURN_ERROR_IF(module.vmContext_ == nullptr,
+                            ErrorCode::NotCompiled,
+                            "Shared module has no loaded artifact");
+    FUSILLI_RETURN_ERROR_IF(
+        module.loadedBackend_ != handle.getBackend() ||
+            module.vmInstance_ != handle.instance_,
+        ErrorCode::InvalidArgument,
+        "Shared module was loaded on a different handle");
+    clearRuntimeState();
+    loadedArtifactOwner_ = module.loadedArtifactOwner_;
+    loadedArtifactBytes_ = module.loadedArtifactBytes_;
+    entryPoint_ = entryPoint;
+    detail::PhaseTimer timer(reportPhase(&CompileReport::vmContextCreation));
+    ErrorObject status = shareVmContext(handle, module);
+    timer.stop();
+    if (isError(status)) {
+      clearRuntimeState();
+      return status;
+    }
+    loadedBackend_ = handle.getBackend();
+    // The module is accounted for once, by the graph that loaded it.
+    workspaceMemory_ = detail::TrackedMemory(
+        handle.memoryTracker_, detail::MemoryCategory::GraphWorkspace, 0);
     return ok();
   }
 
+  // Memory-maps the VMFB file at `path` and loads it as `loadFromArtifact()`
+  // does, without copying it into memory. The mapping is shared with other
+  // mappings of the same file and lives as long as the loaded artifact, so
+  // `path` must not be rewritten in place in the meantime (removing it is fine
+  // on POSIX systems). A compressed VMFB (see `getArtifactCompressionLevel()`)
+  // is decompressed from the mapping straight into the loaded artifact.
+  ErrorObject loadFromArtifactFile(const Handle &handle,
+                                   const std::filesystem::path &path) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Mapping compiled artifact \"" +
+                           path.string() + "\"");
+    detail::PhaseTimer timer(reportPhase(&CompileReport::artifactRead));
+    FUSILLI_ASSIGN_OR_RETURN(MappedFile file, MappedFile::open(path));
+    if (isCompressedArtifact(file.bytes())) {
+      FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> vmfbBytes,
+                               decompressArtifact(file.bytes()));
+      timer.stop();
+      return loadFromArtifact(handle, std::move(vmfbBytes));
+    }
+    auto owner = std::make_shared<const MappedFile>(std::move(file));
+    timer.stop();
+    return loadFromArtifact(handle, owner->bytes(), owner);
+  }
+
   // Executes the graph using IREE runtime. Requires a `variantPack` which is a
   // map from `TensorAttr` to `Buffer` wrapping the `iree_hal_buffer_view_t *`.
   // Definition in `fusilli/backend/runtime.h`.
   //
+  // Thread Safety
+  //   `execute()` (and its overloads) may be called concurrently from multiple
+  //   threads on the same compiled graph, as long as each call passes its own
+  //   output and workspace buffers. A VM context can only run one invocation
+  //   at a time, so concurrent calls borrow additional VM contexts over the
+  //   same loaded modules, created on demand and pooled; the VMFB itself is
+  //   loaded once. `compile()` and the other non-const methods must not run
+  //   concurrently with execution.
+  //
   // Backend Specific Execution Behavior
   //   For some backends execution will be async. The specifics of how one
   //   should launch a kernel and synchronize work items vary per backend.
@@ -284,6 +829,9 @@ public:
   //   Buffer::allocateRaw() and pass it to execute(). Calling
   //   getWorkspaceSize() before execute() is required, and the same
   //   workspace buffer can be reused across multiple execute() calls.
+  //   Passing a null workspace instead borrows a workspace from the arena
+  //   of the handle for the execution (see `Handle::acquireWorkspace()`),
+  //   reused by the graphs executed on it.
   //
   //   Example:
   //     graph.compile(handle);
@@ -296,11 +844,133 @@ public:
   //       workspace = std::make_shared<Buffer>(std::move(wsBuf));
   //     }
   //     graph.execute(handle, variantPack, workspace);
+  //
+  // On a handle with several queues (see the multi-stream `Handle::create()`
+  // overload), executions are distributed over the queues round-robin.
   ErrorObject
   execute(const Handle &handle,
           const std::unordered_map<std::shared_ptr<TensorAttr>,
                                    std::shared_ptr<Buffer>> &variantPack,
-          const std::shared_ptr<Buffer> &workspace) const;
+          const std::shared_ptr<Buffer> &workspace) const {
+    return execute(handle, variantPack, workspace, handle.nextQueueIndex());
+  }
+
+  // Overload of the above executing on queue `queueIndex` of `handle`, so
+  // independent graphs can be placed on different queues explicitly.
+  ErrorObject
+  execute(const Handle &handle,
+          const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                   std::shared_ptr<Buffer>> &variantPack,
+          const std::shared_ptr<Buffer> &workspace, size_t queueIndex) const;
+
+  // Overload of the above taking the buffers of the graph inputs and outputs
+  // indexed by their dense UIDs (see `getTensorUid()`) rather than a variant
+  // pack, so the hot path neither hashes nor allocates. `buffers` must hold
+  // `getTensorUidCount()` non-null buffers.
+  ErrorObject execute(const Handle &handle, std::span<Buffer *const> buffers,
+                      const Buffer *workspace) const;
+
+  // Executes the graph once per variant pack of `variantPacks`, in order on
+  // one queue of `handle`, e.g. for many independent small problems. All
+  // packs are validated before any execution is queued, and the executions
+  // share one VM context, one argument list and the workspace: `workspace`,
+  // or the workspace arena of the queue grown once for the largest. This
+  // amortizes the host overhead of calling `execute()` per pack.
+  ErrorObject executeBatch(
+      const Handle &handle,
+      std::span<const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                         std::shared_ptr<Buffer>>>
+          variantPacks,
+      const std::shared_ptr<Buffer> &workspace = nullptr) const;
+
+  // Asynchronous variant of `execute()` for pipelining: the graph waits on
+  // `waitFence` (e.g. signaled by the upload of its inputs) on the device
+  // rather than on the host, and the returned fence is signaled once its
+  // outputs are written. Pass an empty `Fence()` to not wait on anything.
+  // Backends without asynchronous execution (CPU) wait for `waitFence` on the
+  // host, execute synchronously and return an empty (signaled) fence.
+  ErrorOr<Fence>
+  executeAsync(const Handle &handle,
+               const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                        std::shared_ptr<Buffer>> &variantPack,
+               const std::shared_ptr<Buffer> &workspace,
+               const Fence &waitFence) const;
+
+  // Overload of the above calling `onComplete` with the status of the
+  // execution from the thread of `poller` once it completes, rather than
+  // returning its fence, so servers track their in-flight executions with
+  // one thread instead of one blocked per request (see `CompletionPoller`).
+  // `onComplete` is not called when the execution fails to be queued, whose
+  // error is returned instead.
+  ErrorObject
+  executeAsync(const Handle &handle,
+               const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                        std::shared_ptr<Buffer>> &variantPack,
+               const std::shared_ptr<Buffer> &workspace,
+               const Fence &waitFence, CompletionPoller &poller,
+               CompletionPoller::Callback onComplete) const {
+    FUSILLI_ASSIGN_OR_RETURN(
+        Fence done, executeAsync(handle, variantPack, workspace, waitFence));
+    return poller.notify(std::move(done), std::move(onComplete));
+  }
+
+  // Variant of `execute()` that also measures the device time of the
+  // execution, readable from the returned `ExecutionTiming` once the graph
+  // completed, without synchronizing here. This is meant for monitoring
+  // kernel durations in production rather than under a profiler. AMDGPU
+  // handles must own non-default HIP streams (see `Handle::create(Backend,
+  // int, uintptr_t)`), on which the timing events are recorded.
+  ErrorOr<ExecutionTiming>
+  executeTimed(const Handle &handle,
+               const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                        std::shared_ptr<Buffer>> &variantPack,
+               const std::shared_ptr<Buffer> &workspace) const;
+
+  // Returns the dense UID of the graph input or output `tensor`: its index in
+  // the buffers taken by the indexed `execute()` overload. UIDs follow the
+  // argument order of the compiled function, i.e. non-virtual outputs then
+  // non-inlined-scalar inputs, each sorted by name (see
+  // `fullGraphOutputsSorted_`). In-place outputs have no UID, their input's
+  // buffer holds them (see `TensorAttr::setInPlace()`).
+  // Requires `validate()` to have been run.
+  ErrorOr<size_t>
+  getTensorUid(const std::shared_ptr<TensorAttr> &tensor) const {
+    FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
+                            "Graph must be validated before querying tensor "
+                            "UIDs");
+    auto it = std::find(tensorsByUid_.begin(), tensorsByUid_.end(), tensor);
+    FUSILLI_RETURN_ERROR_IF(it == tensorsByUid_.end(),
+                            ErrorCode::InvalidArgument,
+                            "Tensor is not a graph input or output bound at "
+                            "execution");
+    return ok(static_cast<size_t>(it - tensorsByUid_.begin()));
+  }
+
+  // Returns the number of tensor UIDs, see `getTensorUid()`.
+  size_t getTensorUidCount() const { return tensorsByUid_.size(); }
+
+  // Returns the graph inputs and outputs indexed by their UIDs, see
+  // `getTensorUid()`.
+  const std::vector<std::shared_ptr<TensorAttr>> &getTensorsByUid() const {
+    return tensorsByUid_;
+  }
+
+  // Returns the number of times the graph was executed, through any of the
+  // `execute()` variants or a plan bound from it (see `bind()`), including
+  // executions of its static specializations. Also counted in the handle's
+  // `ExecutionStats`.
+  uint64_t getExecuteCount() const {
+    return executeCount_->load(std::memory_order_relaxed);
+  }
+
+  // Binds `variantPack` and `workspace` ahead of time and returns a plan that
+  // executes the graph with them, see `ExecutionPlan`. The same requirements
+  // as for `execute()` apply, and the same errors are reported here rather
+  // than when running the plan.
+  ErrorOr<ExecutionPlan>
+  bind(const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                std::shared_ptr<Buffer>> &variantPack,
+       const std::shared_ptr<Buffer> &workspace) const;
 
   // Delete copy constructors and keep default move operations.
   Graph(const Graph &) = delete;
@@ -335,6 +1005,418 @@ public:
     return *this;
   }
 
+  // When enabled, `validate()` runs the graph in mixed precision (see
+  // `autocast()`): numerically safe operations (convolutions, matmuls and
+  // pointwise operations) compute in the compute data type, which must be
+  // Half or BFloat16, while reductions, softmax and normalization statistics
+  // stay in Float. Only intermediate tensors without a data type are
+  // affected, so explicit annotations always win.
+  Graph &setAutocast(bool enable) {
+    autocast_ = enable;
+    return *this;
+  }
+
+  // Allocates the nodes and tensors added from now on from an arena owned by
+  // the graph, whose first block holds `initialBytes`, rather than one heap
+  // allocation each. This speeds up building (and destroying) large graphs,
+  // e.g. graphs built per request. Handles stay ordinary `shared_ptr`s that
+  // keep the arena alive, so they remain valid after the graph is destroyed;
+  // the arena's memory is released with the last of them. 0 turns the arena
+  // off again (see `Arena`).
+  Graph &setArenaSize(size_t initialBytes) {
+    arena_ = initialBytes ? Arena::create(initialBytes) : nullptr;
+    return *this;
+  }
+
+  // When enabled, `compileToArtifact(backend, /*remove=*/true)` compiles the
+  // generated assembly to VMFB bytes entirely in memory instead of writing
+  // the input and output to the cache directory. Cache lookups still happen,
+  // and persisted compiles (`remove = false`) are unaffected. No compile-side
+  // assets are kept, so `readCompilationCacheFile()` fails afterwards. Only
+  // supported by the C API compile backend, the CLI always uses files.
+  Graph &setCompileInMemory(bool inMemory) {
+    compileInMemory_ = inMemory;
+    return *this;
+  }
+
+  // Attaches IREE compiler options used by `compile()` and
+  // `compileToArtifact()` for this graph. Options are part of the cache key,
+  // so changing them takes effect on the next compilation.
+  Graph &setCompileOptions(CompileOptions options) {
+    compileOptions_ = std::move(options);
+    return *this;
+  }
+
+  const CompileOptions &getCompileOptions() const { return compileOptions_; }
+
+  // Returns the lowering hint requested by the convolutions of this graph, or
+  // AUTO if none requests one. Hints map onto compiler flags for the whole
+  // graph, so conflicting hints are an error, see
+  // `ConvFPropAttr::setLoweringHint()`.
+  ErrorOr<ConvFPropAttr::LoweringHint> getConvLoweringHint() const {
+    using LoweringHint = ConvFPropAttr::LoweringHint;
+    LoweringHint hint = LoweringHint::AUTO;
+    for (const auto &node : subNodes_) {
+      if (node->getType() != Type::Convolution)
+        continue;
+      const ConvFPropAttr &attr =
+          static_cast<const ConvFPropNode *>(node.get())->convFPropAttr;
+      LoweringHint nodeHint = attr.getLoweringHint();
+      if (nodeHint == LoweringHint::AUTO)
+        continue;
+      FUSILLI_RETURN_ERROR_IF(
+          hint != LoweringHint::AUTO && hint != nodeHint,
+          ErrorCode::InvalidAttribute,
+          "Conv lowering hint " +
+              ConvFPropAttr::kLoweringHintToStr.at(nodeHint) + " of '" +
+              attr.getName() + "' conflicts with " +
+              ConvFPropAttr::kLoweringHintToStr.at(hint) +
+              " requested by another convolution of the graph");
+      hint = nodeHint;
+    }
+    return ok(hint);
+  }
+
+  // Returns `options` with the compiler flags implementing the convolution
+  // lowering hint of this graph (see `getConvLoweringHint()`) on `backend`:
+  //   DIRECT:   disables implicit GEMM on AMDGPU (CPU convolutions are
+  //             direct already)
+  //   WINOGRAD: adds the Winograd rewrite to the preprocessing pipeline
+  //   IM2COL:   adds the im2col rewrite to the preprocessing pipeline
+  // Flags set explicitly on `options` win over the hint.
+  ErrorOr<CompileOptions>
+  applyConvLoweringHint(Backend backend, CompileOptions options) const {
+    using LoweringHint = ConvFPropAttr::LoweringHint;
+    FUSILLI_ASSIGN_OR_RETURN(LoweringHint hint, getConvLoweringHint());
+    auto isSet = [&](std::string_view name) {
+      return std::ranges::any_of(options.getFlags(),
+                                 [&](const std::string &flag) {
+                                   return flag.starts_with(name);
+                                 });
+    };
+
+    constexpr std::string_view kIgemmFlag =
+        "--iree-codegen-llvmgpu-use-igemm";
+    constexpr std::string_view kPipelineFlag =
+        "--iree-preprocessing-pass-pipeline";
+    switch (hint) {
+    case LoweringHint::AUTO:
+      return ok(std::move(options));
+    case LoweringHint::DIRECT:
+      if (backend == Backend::AMDGPU && !isSet(kIgemmFlag))
+        options.setFlag(std::string(kIgemmFlag) + "=false");
+      return ok(std::move(options));
+    case LoweringHint::WINOGRAD:
+    case LoweringHint::IM2COL:
+      break;
+    }
+    if (isSet(kPipelineFlag))
+      return ok(std::move(options));
+
+    // Appends to the backend's default pipeline, e.g. the backward data
+    // convolution pipeline on AMDGPU.
+    std::string pipeline = "builtin.module()";
+    for (const auto &flag : options.resolveFlags(backend))
+      if (flag.starts_with(std::string(kPipelineFlag) + "="))
+        pipeline = flag.substr(kPipelineFlag.size() + 1);
+    std::string pass =
+        hint == LoweringHint::WINOGRAD
+            ? "util.func(iree-linalg-ext-convert-conv2d-to-winograd{"
+              "replace-all-convs=true})"
+            : "util.func(iree-preprocessing-convert-conv2d-to-img2col)";
+    size_t end = pipeline.rfind(')');
+    FUSILLI_RETURN_ERROR_IF(end == std::string::npos || end == 0,
+                            ErrorCode::InvalidArgument,
+                            "Malformed preprocessing pass pipeline '" +
+                                pipeline + "'");
+    pipeline.insert(end, pipeline[end - 1] == '(' ? pass : "," + pass);
+    options.setFlag(std::string(kPipelineFlag) + "=" + pipeline);
+    return ok(std::move(options));
+  }
+
+  // Returns the alignment, in bytes, of all buffers bound at execution (see
+  // `TensorAttr::setAlignment()`): the smallest alignment declared by the
+  // graph inputs and outputs with a UID, or 0 if any of them declares none.
+  // Requires `validate()` to have been run.
+  size_t getBufferAlignment() const {
+    if (tensorsByUid_.empty())
+      return 0;
+    size_t alignment = std::numeric_limits<size_t>::max();
+    for (const auto &tensor : tensorsByUid_)
+      alignment = std::min(alignment, tensor->getAlignment());
+    return alignment;
+  }
+
+  // Returns `options` with the buffer alignment of this graph (see
+  // `getBufferAlignment()`) passed to the compiler as the alignment of
+  // resource offsets, so dispatches may use wide aligned loads and stores
+  // on their bindings. Alignments up to `Handle::kDefaultBufferAlignment`,
+  // which the compiler assumes already, are left to the compiler. Flags set
+  // explicitly on `options` win over the alignment.
+  CompileOptions applyBufferAlignment(CompileOptions options) const {
+    constexpr std::string_view kAlignmentFlag =
+        "--iree-stream-resource-min-offset-alignment";
+    size_t alignment = getBufferAlignment();
+    if (alignment <= Handle::kDefaultBufferAlignment ||
+        std::ranges::any_of(options.getFlags(), [&](const std::string &flag) {
+          return flag.starts_with(kAlignmentFlag);
+        }))
+      return options;
+    return std::move(options.setFlag(std::string(kAlignmentFlag) + "=" +
+                                     std::to_string(alignment)));
+  }
+
+  // Attaches shape buckets to a graph with dynamic dimensions (see
+  // `TensorAttr::setDynamicDims()`). Each bucket gives the concrete dims of
+  // dynamic graph inputs and outputs, and `compile()` compiles a static
+  // specialization of the graph for it next to the dynamic artifact, since
+  // static kernels are typically faster than generic ones at hot shapes.
+  //
+  // `execute()` (and its overloads, `executeAsync()` and `bind()`) dispatch
+  // to the first bucket whose dims all match the shapes of the bound buffers,
+  // and to the dynamic artifact otherwise. Specializing an input or output
+  // usually requires specializing the tensors sharing its dynamic extent too:
+  // the same batch size on the image and the output of a convolution, say.
+  // Virtual tensors with dynamic dimensions may be specialized as well, and are
+  // ignored for dispatch.
+  //
+  // Buckets take effect on the next `compile()`; `compileToArtifact()`,
+  // `loadFromArtifact()` and `compileTiered()` only handle the dynamic
+  // artifact.
+  Graph &setShapeBuckets(std::vector<ShapeBucket> buckets) {
+    shapeBuckets_ = std::move(buckets);
+    return *this;
+  }
+
+  const std::vector<ShapeBucket> &getShapeBuckets() const {
+    return shapeBuckets_;
+  }
+
+  // Returns the number of static specializations loaded by `compile()`.
+  size_t getSpecializationCount() const { return specializations_.size(); }
+
+  // Enables automatic specialization of a graph with dynamic dimensions for
+  // the shapes it is executed with most, complementing `setShapeBuckets()`
+  // when the hot shapes aren't known ahead of time or drift.
+  //
+  // `execute()` (and its overloads, `executeAsync()` and `bind()`) count the
+  // shapes of the bound buffers of dynamic inputs and outputs that no
+  // specialization matches. When a shape has been seen `threshold` times, the
+  // static specialization for it is emitted on the executing thread and
+  // compiled and loaded on a background thread, while executions keep using
+  // the dynamic artifact. Once loaded, executions with that shape dispatch to
+  // it, unless the provided workspace is too small for it. At most
+  // `maxSpecializations` shapes are specialized.
+  //
+  // Takes effect on the next `compile()`, which resets the counters and
+  // compiles with the same options and `remove` flag; the handle passed to it
+  // must outlive the graph. Destroying or recompiling the graph waits for the
+  // background compilations to finish. Pass a `threshold` of 0 to disable.
+  Graph &setHotShapeThreshold(size_t threshold, size_t maxSpecializations = 8) {
+    hotShapeThreshold_ = threshold;
+    maxHotSpecializations_ = maxSpecializations;
+    return *this;
+  }
+
+  // Caps the workspace of the artifact `compile()` loads at `bytes`. Split
+  // reductions parallelize large reductions at the cost of workspace for
+  // their partial results, which can reach GBs; when the compiled artifact
+  // needs more workspace than the cap, `compile()` recompiles it with split
+  // reductions disabled (see `CompileOptions::setSplitReduction()`) and
+  // fails with `ErrorCode::CompileFailure` if it still does not fit. The
+  // specializations it compiles use the same options. Graphs with a
+  // data-dependent workspace size (see `hasDynamicWorkspaceSize()`) are not
+  // capped. Takes effect on the next `compile()`; pass `std::nullopt` to
+  // remove the cap. `getWorkspaceReport()` breaks the workspace down.
+  Graph &setMaxWorkspaceSize(std::optional<size_t> bytes) {
+    maxWorkspaceSize_ = bytes;
+    return *this;
+  }
+
+  // Returns the number of hot-shape specializations loaded so far, see
+  // `setHotShapeThreshold()`.
+  size_t getHotSpecializationCount() const {
+    if (!hotShapes_)
+      return 0;
+    std::lock_guard<std::mutex> lock(hotShapes_->mutex);
+    return hotShapes_->ready.size();
+  }
+
+  // Blocks until the hot-shape specializations compiling in the background
+  // are loaded (or failed to compile), e.g. to warm up before serving.
+  void waitForHotSpecializations() const {
+    if (!hotShapes_)
+      return;
+    std::vector<std::shared_future<void>> pending;
+    {
+      std::lock_guard<std::mutex> lock(hotShapes_->mutex);
+      pending = hotShapes_->pending;
+    }
+    for (const std::shared_future<void> &compilation : pending)
+      compilation.wait();
+  }
+
+  // Attaches a tuning spec to the compile options of this graph, held in
+  // `mlir` (see `CompileOptions::setTuningSpecAsm()`). Only this graph is
+  // affected, unlike passing the spec through `FUSILLI_EXTRA_COMPILER_FLAGS`.
+  Graph &setTuningSpecAsm(std::string mlir) {
+    compileOptions_.setTuningSpecAsm(std::move(mlir));
+    return *this;
+  }
+
+  // Overload of the above reading the tuning spec from the file at `path`
+  // (see `CompileOptions::setTuningSpec()`).
+  ErrorObject setTuningSpec(const std::filesystem::path &path) {
+    return compileOptions_.setTuningSpec(path);
+  }
+
+  // Records `tuned` in the kernel cache as the options to compile this graph
+  // with on `backend` in place of the attached compile options. Later
+  // `compile()` and `compileToArtifact()` calls from any process with the
+  // same (structural) graph and attached options pick them up. Written by
+  // `fusilli::autotune()`.
+  //
+  // Records are shared between compile profiles (see `CompileProfile`), so
+  // options tuned with the diagnostic profile also apply in production; the
+  // profile of the attached options is kept when loading them.
+  ErrorObject saveTunedCompileOptions(Backend backend,
+                                      const CompileOptions &tuned) {
+    FUSILLI_ASSIGN_OR_RETURN(std::string fingerprintKey,
+                             getTunedCompileOptionsKey(backend));
+    return CacheFile::publish(
+        CacheFile::getKernelCacheTunedPath(fingerprintKey), tuned.toString());
+  }
+
+  // Returns the options recorded by `saveTunedCompileOptions()` for `backend`,
+  // or std::nullopt if there are none (or their tuning spec is gone).
+  ErrorOr<std::optional<CompileOptions>>
+  loadTunedCompileOptions(Backend backend) const {
+    FUSILLI_ASSIGN_OR_RETURN(std::string fingerprintKey,
+                             getTunedCompileOptionsKey(backend));
+    std::filesystem::path recordPath =
+        CacheFile::getKernelCacheTunedPath(fingerprintKey);
+    if (!std::filesystem::exists(recordPath))
+      return ok(std::optional<CompileOptions>());
+    FUSILLI_ASSIGN_OR_RETURN(CacheFile record, CacheFile::open(recordPath));
+    FUSILLI_ASSIGN_OR_RETURN(std::string serialized, record.read());
+    CompileOptions tuned = CompileOptions::fromString(serialized);
+    std::optional<std::filesystem::path> specPath = tuned.getTuningSpecPath();
+    if (specPath.has_value() && !std::filesystem::exists(*specPath))
+      return ok(std::optional<CompileOptions>());
+    tuned.setProfile(compileOptions_.getProfile());
+    return ok(std::optional(std::move(tuned)));
+  }
+
+  // Records `time` in the kernel cache as the measured execution time of this
+  // graph on `backend` with its autotuned options, see `estimateCost()`.
+  // Written by `fusilli::autotune()`.
+  ErrorObject saveMeasuredTime(Backend backend,
+                               std::chrono::nanoseconds time) {
+    FUSILLI_ASSIGN_OR_RETURN(std::string fingerprintKey,
+                             getTunedCompileOptionsKey(backend));
+    return CacheFile::publish(
+        CacheFile::getKernelCacheMeasuredTimePath(fingerprintKey),
+        std::to_string(time.count()));
+  }
+
+  // Returns the time recorded by `saveMeasuredTime()` for `backend`, or
+  // std::nullopt if there is none.
+  ErrorOr<std::optional<std::chrono::nanoseconds>>
+  loadMeasuredTime(Backend backend) const {
+    FUSILLI_ASSIGN_OR_RETURN(std::string fingerprintKey,
+                             getTunedCompileOptionsKey(backend));
+    std::filesystem::path recordPath =
+        CacheFile::getKernelCacheMeasuredTimePath(fingerprintKey);
+    if (!std::filesystem::exists(recordPath))
+      return ok(std::optional<std::chrono::nanoseconds>());
+    FUSILLI_ASSIGN_OR_RETURN(CacheFile record, CacheFile::open(recordPath));
+    FUSILLI_ASSIGN_OR_RETURN(std::string serialized, record.read());
+    int64_t count = 0;
+    auto [ptr, errc] = std::from_chars(
+        serialized.data(), serialized.data() + serialized.size(), count);
+    FUSILLI_RETURN_ERROR_IF(errc != std::errc() || count < 0,
+                            ErrorCode::FileSystemFailure,
+                            "Invalid measured time record: " +
+                                recordPath.string());
+    return ok(std::optional(std::chrono::nanoseconds(count)));
+  }
+
+  // Estimates the cost of executing this graph on a device with the peak
+  // rates of `device`, analytically from the node attributes and tensor
+  // shapes: the operations of every node (see `INode::estimateFlops()`), the
+  // bytes of the graph inputs and outputs, and the time a roofline model
+  // derives from them. Convolutions, matmuls and attention run at the matrix
+  // core rate of their operand type, other nodes at the vector rate.
+  // Dynamic dims count at their current extent. Meant for routing decisions
+  // (e.g. which device or fallback path a graph should take) made without
+  // compiling. Requires `validate()` to have been run.
+  ErrorOr<CostEstimate> estimateCost(const DeviceCostModel &device) const {
+    FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
+                            "Graph must be validated before estimating its "
+                            "cost");
+    CostEstimate estimate;
+    double computeSeconds = 0;
+    for (const auto &node : subNodes_) {
+      double flops = node->estimateFlops();
+      if (flops <= 0)
+        continue;
+      std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+      node->collectTensors(ins, outs);
+      DataType type = ins.empty() ? context.getIODataType()
+                                  : ins.front()->getDataType();
+      double peak = device.getPeakFlops(type, isMatrixNode(*node));
+      estimate.flops += flops;
+      if (peak > 0)
+        computeSeconds += flops / peak;
+    }
+    for (const auto &tensor : tensorsByUid_) {
+      FUSILLI_ASSIGN_OR_RETURN(
+          iree_hal_element_type_t elementType,
+          getIreeHalElementType(tensor->getDataType()));
+      estimate.bytes +=
+          tensor->getVolume() *
+          std::max<int64_t>(
+              static_cast<int64_t>(
+                  iree_hal_element_dense_byte_count(elementType)),
+              1);
+    }
+    double memorySeconds =
+        device.memoryBandwidth > 0
+            ? static_cast<double>(estimate.bytes) / device.memoryBandwidth
+            : 0;
+    estimate.time =
+        device.launchLatency +
+        std::chrono::nanoseconds(
+            std::llround(std::max(computeSeconds, memorySeconds) * 1e9));
+    return ok(estimate);
+  }
+
+  // Overload of the above for the IREE ROCm target `target` (e.g. `mi300x`
+  // or `gfx942`, see `getDeviceCostModel()`).
+  ErrorOr<CostEstimate> estimateCost(const std::string &target) const {
+    std::optional<DeviceCostModel> device = getDeviceCostModel(target);
+    FUSILLI_RETURN_ERROR_IF(!device.has_value(), ErrorCode::NotImplemented,
+                            "No cost model for target '" + target + "'");
+    return estimateCost(*device);
+  }
+
+  // Overload of the above for the GPU of `handle`, refined with the
+  // execution time measured when autotuning this graph on it, if any (see
+  // `CostEstimate::measuredTime`). CPU handles have no cost model.
+  ErrorOr<CostEstimate> estimateCost(const Handle &handle) const {
+    FUSILLI_RETURN_ERROR_IF(handle.getBackend() != Backend::AMDGPU,
+                            ErrorCode::NotImplemented,
+                            "Cost models are only available for AMDGPU");
+    FUSILLI_ASSIGN_OR_RETURN(
+        CostEstimate estimate,
+        estimateCost(getIreeRocmTargetForAmdgpu(handle.getDeviceId())));
+    if (!checkKernelCacheDisabledEnv()) {
+      FUSILLI_ASSIGN_OR_RETURN(estimate.measuredTime,
+                               loadMeasuredTime(handle.getBackend()));
+    }
+    return ok(estimate);
+  }
+
   // Declarations for tensor and op builder methods go here.
   // Definitions are towards the end of this file below.
   std::shared_ptr<TensorAttr> tensor(const TensorAttr &tensor);
@@ -345,15 +1427,38 @@ public:
   std::shared_ptr<TensorAttr> convWGrad(const std::shared_ptr<TensorAttr> &dy,
                                         const std::shared_ptr<TensorAttr> &x,
                                         ConvWGradAttr &attributes);
+  // Also returns the bias gradient DBIAS [K], computed by the same op as DW
+  // so DY is read once for both, as the last element.
+  std::array<std::shared_ptr<TensorAttr>, 2>
+  convWGradWithBias(const std::shared_ptr<TensorAttr> &dy,
+                    const std::shared_ptr<TensorAttr> &x,
+                    ConvWGradAttr &attributes);
   std::shared_ptr<TensorAttr> convDGrad(const std::shared_ptr<TensorAttr> &dy,
                                         const std::shared_ptr<TensorAttr> &w,
                                         ConvDGradAttr &attributes);
+  // Transposed convolution of `x` with the filter `w` in the transposed
+  // layout, see `ConvTransposeAttr`.
+  std::shared_ptr<TensorAttr>
+  convTranspose(const std::shared_ptr<TensorAttr> &x,
+                const std::shared_ptr<TensorAttr> &w,
+                ConvTransposeAttr &attributes);
   std::array<std::shared_ptr<TensorAttr>, 3>
   batchnorm(const std::shared_ptr<TensorAttr> &x,
             const std::shared_ptr<TensorAttr> &scale,
             const std::shared_ptr<TensorAttr> &bias,
             const std::shared_ptr<TensorAttr> &mean,
             const std::shared_ptr<TensorAttr> &var, BatchnormAttr &attributes);
+  // Backward of a training batch normalization, from the statistics saved by
+  // the forward. Returns the gradients {DX, DSCALE, DBIAS}, where the
+  // gradients of the parameters are nullptr without `scale`. The backward of
+  // a ReLU on the forward output is fused in when the attributes have Y set.
+  std::array<std::shared_ptr<TensorAttr>, 3>
+  batchnormBackward(const std::shared_ptr<TensorAttr> &dy,
+                    const std::shared_ptr<TensorAttr> &x,
+                    const std::shared_ptr<TensorAttr> &scale,
+                    const std::shared_ptr<TensorAttr> &savedMean,
+                    const std::shared_ptr<TensorAttr> &savedInvVariance,
+                    BatchnormBwdAttr &attributes);
 
   std::array<std::shared_ptr<TensorAttr>, 3>
   layernorm(const std::shared_ptr<TensorAttr> &x,
@@ -362,9 +1467,45 @@ public:
   std::array<std::shared_ptr<TensorAttr>, 2>
   rmsnorm(const std::shared_ptr<TensorAttr> &x,
           const std::shared_ptr<TensorAttr> &scale, RmsnormAttr &attributes);
+
+  // Fused residual-add + normalization: normalizes `x + residual` without
+  // materializing the sum in between, and returns the sum (SUM) as the last
+  // element, for the residual stream of the next block.
+  std::array<std::shared_ptr<TensorAttr>, 4>
+  layernorm(const std::shared_ptr<TensorAttr> &x,
+            const std::shared_ptr<TensorAttr> &residual,
+            const std::shared_ptr<TensorAttr> &scale,
+            const std::shared_ptr<TensorAttr> &bias, LayernormAttr &attributes);
+  std::array<std::shared_ptr<TensorAttr>, 3>
+  rmsnorm(const std::shared_ptr<TensorAttr> &x,
+          const std::shared_ptr<TensorAttr> &residual,
+          const std::shared_ptr<TensorAttr> &scale, RmsnormAttr &attributes);
+  // Backward of a normalization, from the statistics saved by the forward
+  // pass. Returns the gradients {DX, DSCALE, DBIAS} (resp. {DX, DSCALE}),
+  // where the gradients of the parameters are nullptr without `scale`.
+  std::array<std::shared_ptr<TensorAttr>, 3>
+  layernormBackward(const std::shared_ptr<TensorAttr> &dy,
+                    const std::shared_ptr<TensorAttr> &x,
+                    const std::shared_ptr<TensorAttr> &scale,
+                    const std::shared_ptr<TensorAttr> &mean,
+                    const std::shared_ptr<TensorAttr> &invVariance,
+                    LayernormBwdAttr &attributes);
+  std::array<std::shared_ptr<TensorAttr>, 2>
+  rmsnormBackward(const std::shared_ptr<TensorAttr> &dy,
+                  const std::shared_ptr<TensorAttr> &x,
+                  const std::shared_ptr<TensorAttr> &scale,
+                  const std::shared_ptr<TensorAttr> &invRms,
+                  RmsnormBwdAttr &attributes);
   std::shared_ptr<TensorAttr> matmul(const std::shared_ptr<TensorAttr> &a,
                                      const std::shared_ptr<TensorAttr> &b,
                                      MatmulAttr &attributes);
+  // Weight gradient of a linear layer, with A = DY^T and B = X: also returns
+  // the bias gradient DBIAS, A summed over the contraction dim, as the last
+  // element (see `MatmulAttr::hasBiasGradient()`).
+  std::array<std::shared_ptr<TensorAttr>, 2>
+  matmulWithBiasGrad(const std::shared_ptr<TensorAttr> &a,
+                     const std::shared_ptr<TensorAttr> &b,
+                     MatmulAttr &attributes);
   std::shared_ptr<TensorAttr> pointwise(const std::shared_ptr<TensorAttr> &in,
                                         PointwiseAttr &attributes);
 
@@ -379,6 +1520,11 @@ public:
 
   std::shared_ptr<TensorAttr> reduction(const std::shared_ptr<TensorAttr> &x,
                                         ReductionAttr &attributes);
+  // Multi-output modes (e.g. MEAN_VAR): returns {Y, Y2}, both statistics
+  // computed in a single pass over X. For TOPK, {values, indices}.
+  std::array<std::shared_ptr<TensorAttr>, 2>
+  multiOutputReduction(const std::shared_ptr<TensorAttr> &x,
+                       ReductionAttr &attributes);
 
   std::shared_ptr<TensorAttr> sdpa(const std::shared_ptr<TensorAttr> &q,
                                    const std::shared_ptr<TensorAttr> &k,
@@ -386,16 +1532,97 @@ public:
                                    const std::shared_ptr<TensorAttr> &mask,
                                    SdpaAttr &attributes);
 
+  // Training forward: also returns the logsumexp STATS that `sdpaBackward`
+  // consumes, as the last element.
+  std::array<std::shared_ptr<TensorAttr>, 2>
+  sdpaWithStats(const std::shared_ptr<TensorAttr> &q,
+                const std::shared_ptr<TensorAttr> &k,
+                const std::shared_ptr<TensorAttr> &v,
+                const std::shared_ptr<TensorAttr> &mask, SdpaAttr &attributes);
+  // Returns the gradients {DQ, DK, DV}.
+  std::array<std::shared_ptr<TensorAttr>, 3>
+  sdpaBackward(const std::shared_ptr<TensorAttr> &q,
+               const std::shared_ptr<TensorAttr> &k,
+               const std::shared_ptr<TensorAttr> &v,
+               const std::shared_ptr<TensorAttr> &o,
+               const std::shared_ptr<TensorAttr> &dO,
+               const std::shared_ptr<TensorAttr> &stats,
+               SdpaBwdAttr &attributes);
+
+  std::shared_ptr<TensorAttr> softmax(const std::shared_ptr<TensorAttr> &x,
+                                      const std::shared_ptr<TensorAttr> &mask,
+                                      SoftmaxAttr &attributes);
+
+  std::shared_ptr<TensorAttr> pooling(const std::shared_ptr<TensorAttr> &x,
+                                      PoolingAttr &attributes);
+
+  std::shared_ptr<TensorAttr> reshape(const std::shared_ptr<TensorAttr> &x,
+                                      ReshapeAttr &attributes);
+  std::shared_ptr<TensorAttr> permute(const std::shared_ptr<TensorAttr> &x,
+                                      PermuteAttr &attributes);
+  std::shared_ptr<TensorAttr> slice(const std::shared_ptr<TensorAttr> &x,
+                                    SliceAttr &attributes);
+  std::shared_ptr<TensorAttr>
+  concat(const std::vector<std::shared_ptr<TensorAttr>> &xs,
+         ConcatAttr &attributes);
+  // Writes `update` into a copy of `x` at the runtime offset `start`, see
+  // `SliceUpdateNode`. Declaring the result in-place on `x` writes `update`
+  // into the buffer of `x` directly (e.g. a KV-cache append).
+  std::shared_ptr<TensorAttr>
+  sliceUpdate(const std::shared_ptr<TensorAttr> &x,
+              const std::shared_ptr<TensorAttr> &update,
+              const std::shared_ptr<TensorAttr> &start,
+              SliceUpdateAttr &attributes);
+  // Gathers the slices of `x` at `index` along the axis, see
+  // `IndexSelectNode` (e.g. an embedding lookup from token ids).
+  std::shared_ptr<TensorAttr>
+  indexSelect(const std::shared_ptr<TensorAttr> &x,
+              const std::shared_ptr<TensorAttr> &index,
+              IndexSelectAttr &attributes);
+  // Accumulates the slices of `source` at `index` along the axis into `x`,
+  // or into zeros of `attributes.getSize()` along the axis when `x` is null,
+  // see `IndexAddNode` (e.g. the gradient of an embedding lookup).
+  std::shared_ptr<TensorAttr>
+  indexAdd(const std::shared_ptr<TensorAttr> &x,
+           const std::shared_ptr<TensorAttr> &index,
+           const std::shared_ptr<TensorAttr> &source, IndexAddAttr &attributes);
+  // All-reduce, all-gather or reduce-scatter of `x` over the ranks of
+  // `attributes`, see `CollectiveNode`.
+  std::shared_ptr<TensorAttr> collective(const std::shared_ptr<TensorAttr> &x,
+                                         CollectiveAttr &attributes);
+  // Updates each of `params` with the gradient of the same index in `grads`,
+  // see `OptimizerNode`. `moments1` holds the momentum buffers of SGD with
+  // MOMENTUM or the first moments of Adam, `moments2` the second moments of
+  // Adam, and are otherwise empty. Returns the new params, moments1 and
+  // moments2, each declared in-place on the tensor it updates (see
+  // `TensorAttr::setInPlace()`): one graph execution updates the buffers of
+  // all parameters and moments, and binds no buffers for the results.
+  std::array<std::vector<std::shared_ptr<TensorAttr>>, 3>
+  optimizerUpdate(const std::vector<std::shared_ptr<TensorAttr>> &params,
+                  const std::vector<std::shared_ptr<TensorAttr>> &grads,
+                  const std::vector<std::shared_ptr<TensorAttr>> &moments1,
+                  const std::vector<std::shared_ptr<TensorAttr>> &moments2,
+                  OptimizerAttr &attributes);
+
   std::vector<std::shared_ptr<TensorAttr>>
   customOp(std::vector<std::shared_ptr<TensorAttr>> inputs,
            CustomOpAttr &customOpAttr);
 
   // Query required workspace buffer size. Returns std::nullopt if no runtime
   // artifact is loaded, 0 if no workspace is needed, or the maximum required
-  // size in bytes seen for the currently loaded runtime state. Dynamic
-  // workspace sizes are not supported yet and return an error.
+  // size in bytes seen for the currently loaded runtime state. Modules with a
+  // data-dependent workspace size (see `hasDynamicWorkspaceSize()`) return 0.
   ErrorOr<std::optional<size_t>> getWorkspaceSize();
 
+  // Returns whether the loaded module computes its workspace size from the
+  // bound buffer shapes (dynamic-shape graphs needing shape-dependent scratch
+  // space). Such graphs query the size at every execution: executing with a
+  // null workspace grows the workspace arena of the handle as needed, and a
+  // provided workspace must be large enough for the bound shapes.
+  bool hasDynamicWorkspaceSize() const {
+    return transientSizeFunction_.has_value();
+  }
+
   // Deprecated alias for getWorkspaceSize().
   [[deprecated("Use Graph::getWorkspaceSize() instead.")]]
   ErrorOr<std::optional<size_t>> getWorkspaceSizeOrError();
@@ -405,14 +1632,48 @@ public:
   // TODO(#13): Make this private. It is public for now to aid testing and
   // debuggability, however the intended user facing API is `Graph::compile()`.
   ErrorOr<std::string> emitAsm() {
+    FUSILLI_TRACE_ZONE("fusilli::Graph::emitAsm");
+    FUSILLI_TRACE_ZONE_TEXT(getName());
     FUSILLI_LOG_LABEL_ENDL("INFO: Emitting MLIR assembly for Graph");
     FUSILLI_RETURN_ERROR_IF(
         !isValidated_, ErrorCode::NotValidated,
         "Graph must be validated before emitting MLIR assembly");
-    std::ostringstream oss;
-    emitAsmSubtree(oss);
-    FUSILLI_LOG_ENDL(oss.str());
-    return ok(oss.str());
+    std::string out;
+    out.reserve(getAsmSizeEstimate());
+    emitAsmSubtree(out);
+    FUSILLI_LOG_ENDL(out);
+    return ok(std::move(out));
+  }
+
+  // Emits the tuning spec (transform dialect library) applying the lowering
+  // configs set on nodes of this graph, e.g. `MatmulAttr::setTileSizes()`,
+  // or std::nullopt if none sets one. `compile()` passes it to the compiler
+  // on AMDGPU unless the compile options attach a tuning spec already.
+  ErrorOr<std::optional<std::string>> emitTuningSpecAsm() const;
+
+  // Emits the graph as function `@entryPoint` of a multi-function module (see
+  // `emitModuleAsm()`), without the enclosing module. The module-scope
+  // declarations of its nodes and parameters are appended to `moduleScope`
+  // instead, one entry per parameter so that graphs sharing parameters
+  // declare their globals once.
+  ErrorOr<std::string>
+  emitFunctionAsm(const std::string &entryPoint,
+                  std::vector<std::string> &moduleScope) const {
+    FUSILLI_TRACE_ZONE("fusilli::Graph::emitFunctionAsm");
+    FUSILLI_TRACE_ZONE_TEXT(getName());
+    FUSILLI_RETURN_ERROR_IF(
+        !isValidated_, ErrorCode::NotValidated,
+        "Graph must be validated before emitting MLIR assembly");
+    std::vector<std::string> globals = getParameterGlobalsAsm();
+    moduleScope.insert(moduleScope.end(), globals.begin(), globals.end());
+    for (const auto &subNode : subNodes_)
+      subNode->collectModuleScopeAsm(moduleScope);
+    std::string out;
+    out.reserve(getAsmSizeEstimate());
+    out += getFunctionPreAsm(entryPoint);
+    emitSubNodesAsm(out);
+    out += getFunctionPostAsm();
+    return ok(std::move(out));
   }
 
   // Return compiled artifact. The first invocation will always generate
@@ -420,6 +1681,12 @@ public:
   // assuming cache invalidation checks pass. Set `remove = true` to remove
   // cache files when this `Graph` instance goes out of scope.
   //
+  // Lookups that miss the in-process cache fall back to the persistent,
+  // content-addressed kernel cache in `${FUSILLI_CACHE_DIR}/kernels/<key>`
+  // (see `getKernelCacheKey()`), which is shared across `Graph` instances and
+  // processes. Artifacts compiled with `remove = false` are published there.
+  // Set `FUSILLI_DISABLE_KERNEL_CACHE=1` to bypass the kernel cache.
+  //
   // `reCompiled` will be set to true if a value is passed and the cache was
   // (re)generated; this parameter is useful for testing.
   //
@@ -428,71 +1695,877 @@ public:
   ErrorOr<std::filesystem::path>
   getCompiledArtifact(Backend backend, const std::string &generatedAsm,
                       bool remove, std::optional<bool> *reCompiled = nullptr) {
+    return getCompiledArtifact(backend, compileOptions_, generatedAsm, remove,
+                               reCompiled);
+  }
+
+  // Overload of the above compiling with `options` instead of the attached
+  // compile options.
+  ErrorOr<std::filesystem::path>
+  getCompiledArtifact(Backend backend, const CompileOptions &options,
+                      const std::string &generatedAsm, bool remove,
+                      std::optional<bool> *reCompiled = nullptr) {
+    FUSILLI_TRACE_ZONE("fusilli::Graph::getCompiledArtifact");
+    FUSILLI_TRACE_ZONE_TEXT(getName());
+    detail::PhaseTimer lookupTimer(
+        reportPhase(&CompileReport::cacheValidation));
+    // Every path but the generation below is a cache hit.
+    if (report_)
+      report_->cacheHit = true;
+    FUSILLI_ASSIGN_OR_RETURN(std::string cacheKey,
+                             getKernelCacheKey(backend, options, generatedAsm));
+
     // Check for cache hit.
-    FUSILLI_ASSIGN_OR_RETURN(bool cacheValid,
-                             validateCache(backend, generatedAsm));
+    FUSILLI_ASSIGN_OR_RETURN(bool cacheValid, validateCache(cacheKey));
     if (cacheValid) {
       if (reCompiled)
         *reCompiled = false;
       return ok(cache_->output.path);
     }
+    // Check for a kernel cache hit from another instance or process.
+    bool useKernelCache = !checkKernelCacheDisabledEnv();
+    if (useKernelCache) {
+      std::optional<CachedAssets> kernelCache = openKernelCache(cacheKey);
+      if (kernelCache.has_value()) {
+        FUSILLI_LOG_LABEL_ENDL("INFO: Kernel cache hit for key " << cacheKey);
+        ++detail::getKernelCacheCounters().hits;
+        cache_ = std::move(kernelCache);
+        cacheFingerprintKey_.reset();
+        if (reCompiled)
+          *reCompiled = false;
+        return ok(cache_->output.path);
+      }
+    }
+    // Serialize compiling the same artifact across processes: the first to
+    // take the kernel cache lock compiles and publishes it, the others wait and
+    // then pick up the published entry instead of compiling it again.
+    std::optional<FileLock> kernelCacheLock;
+    if (!remove && useKernelCache) {
+      FUSILLI_ASSIGN_OR_RETURN(
+          kernelCacheLock,
+          FileLock::acquire(CacheFile::getKernelCachePath(cacheKey, ".lock")));
+      std::optional<CachedAssets> kernelCache = openKernelCache(cacheKey);
+      if (kernelCache.has_value()) {
+        FUSILLI_LOG_LABEL_ENDL("INFO: Kernel cache hit for key "
+                               << cacheKey << " after waiting on its lock");
+        ++detail::getKernelCacheCounters().hits;
+        cache_ = std::move(kernelCache);
+        cacheFingerprintKey_.reset();
+        if (reCompiled)
+          *reCompiled = false;
+        return ok(cache_->output.path);
+      }
+      // Another node may have compiled it already.
+      kernelCache = fetchRemoteKernelCache(cacheKey);
+      if (kernelCache.has_value()) {
+        FUSILLI_LOG_LABEL_ENDL("INFO: Remote kernel cache hit for key "
+                               << cacheKey);
+        ++detail::getKernelCacheCounters().hits;
+        ++detail::getKernelCacheCounters().remoteHits;
+        cache_ = std::move(kernelCache);
+        cacheFingerprintKey_.reset();
+        if (reCompiled)
+          *reCompiled = false;
+        return ok(cache_->output.path);
+      }
+    }
+    // Processes (or instances) compiling graphs with the same name share the
+    // per-graph cache directory, so only one may write to it at a time. This
+    // lock is always taken after the kernel cache lock, never before it.
+    FUSILLI_ASSIGN_OR_RETURN(
+        FileLock graphCacheLock,
+        FileLock::acquire(CacheFile::getPath(getName(), ".lock")));
     // (Re)generate cache.
+    lookupTimer.stop();
+    if (report_)
+      report_->cacheHit = false;
+    if (useKernelCache)
+      ++detail::getKernelCacheCounters().misses;
     FUSILLI_ASSIGN_OR_RETURN(
         auto generatedCache,
-        generateCompiledArtifact(backend, generatedAsm, remove));
+        generateCompiledArtifact(backend, options, generatedAsm, cacheKey,
+                                 remove));
     cache_ = std::move(generatedCache);
+    cacheFingerprintKey_.reset();
+    // Artifacts that outlive this instance are shared through the kernel
+    // cache. Failing to publish is not fatal, the compiled artifact is valid.
+    if (!remove && useKernelCache) {
+      ErrorObject status = publishKernelCache(cacheKey, *cache_);
+      if (isError(status))
+        FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to publish to kernel cache: "
+                               << status);
+      detail::touchKernelCacheEntry(cacheKey);
+      // Share the entry with other nodes once waiters can pick it up, which
+      // also enforces the size cap below.
+      kernelCacheLock.reset();
+      if (std::shared_ptr<RemoteKernelCache> remote = getRemoteKernelCache();
+          remote && isOk(status)) {
+        std::filesystem::path entryDir =
+            CacheFile::getKernelCachePath(cacheKey, "").parent_path();
+        ErrorObject storeStatus = remote->store(cacheKey, entryDir);
+        if (isError(storeStatus))
+          FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to store to remote kernel "
+                                 "cache: "
+                                 << storeStatus);
+      }
+      if (std::optional<uintmax_t> maxSize = getKernelCacheMaxSize()) {
+        ErrorOr<size_t> evicted = evictKernelCache(*maxSize);
+        if (isError(evicted))
+          FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to evict from kernel cache: "
+                                 << ErrorObject(evicted));
+      }
+    }
     if (reCompiled)
       *reCompiled = true;
     return ok(cache_->output.path);
   }
 
+  // Returns the content-addressed kernel cache key for compiling
+  // `generatedAsm` on `backend`. The key is a digest of everything that
+  // determines the compiled artifact:
+  //  - Generated assembly
+  //  - Backend and its compiler flags (`CompileOptions::resolveFlags()` for
+  //    the attached compile options)
+  //  - Compiler identity (C API revision, or `iree-compile` path for the CLI)
+  //
+  // Graph names do not participate beyond their appearance in the assembly.
+  ErrorOr<std::string> getKernelCacheKey(Backend backend,
+                                         const std::string &generatedAsm) {
+    return getKernelCacheKey(backend, compileOptions_, generatedAsm);
+  }
+
+  // Overload of the above for compiling with `options`.
+  ErrorOr<std::string> getKernelCacheKey(Backend backend,
+                                         const CompileOptions &options,
+                                         const std::string &generatedAsm) {
+    Hasher hasher;
+    hasher.update(generatedAsm);
+    FUSILLI_CHECK_ERROR(hashCompileEnvironment(hasher, backend, options));
+    return ok(hasher.hexDigest());
+  }
+
+  // Returns the key used to look up compiled artifacts for this graph on
+  // `backend` without emitting assembly. Like `getKernelCacheKey()` but keyed
+  // on the structural fingerprint (see `getFingerprint()`) rather than the
+  // generated assembly.
+  ErrorOr<std::string> getFingerprintCacheKey(Backend backend) const {
+    return getFingerprintCacheKey(backend, compileOptions_);
+  }
+
+  // Overload of the above for compiling with `options`.
+  ErrorOr<std::string>
+  getFingerprintCacheKey(Backend backend, const CompileOptions &options) const {
+    FUSILLI_ASSIGN_OR_RETURN(std::string fingerprint, getFingerprint());
+    Hasher hasher;
+    hasher.update("fingerprint").update(fingerprint);
+    FUSILLI_CHECK_ERROR(hashCompileEnvironment(hasher, backend, options));
+    return ok(hasher.hexDigest());
+  }
+
+  // Reads a compile-side asset of the most recent compilation. Only the output
+  // is available for graphs compiled with the production compile profile
+  // (see `CompileProfile`).
   ErrorOr<std::string> readCompilationCacheFile(CachedAssetsType type) {
     FUSILLI_LOG_LABEL_ENDL("INFO: Getting cached assets path");
     FUSILLI_RETURN_ERROR_IF(!cache_.has_value(), ErrorCode::FileSystemFailure,
                             "Cache not populated yet");
 
-    // `CacheFile::read` already returns an `ErrorOr<std::string>`
-    // so don't wrap it in another `ok()` here.
+    std::optional<CacheFile> *asset = nullptr;
     switch (type) {
     case CachedAssetsType::Input:
-      return cache_->input.read();
+      asset = &cache_->input;
+      break;
     case CachedAssetsType::Command:
-      return cache_->command.read();
+      asset = &cache_->command;
+      break;
     case CachedAssetsType::Output:
+      // `CacheFile::read` already returns an `ErrorOr<std::string>`
+      // so don't wrap it in another `ok()` here.
       return cache_->output.read();
     case CachedAssetsType::Statistics:
-      return cache_->statistics.read();
+      asset = &cache_->statistics;
+      break;
+    case CachedAssetsType::Digest:
+      asset = &cache_->digest;
+      break;
     default:
       return error(ErrorCode::InvalidAttribute, "Unknown CachedAssetsType");
     }
+    FUSILLI_RETURN_ERROR_IF(!asset->has_value(), ErrorCode::FileSystemFailure,
+                            "Cached asset not written by the production "
+                            "compile profile");
+    return (*asset)->read();
+  }
+
+  // Returns the parsed scheduling statistics of the most recent compilation
+  // of this graph (see `CompileStatistics`). Like
+  // `readCompilationCacheFile()`, requires the graph to have been compiled
+  // (or looked up in the kernel cache) in this process.
+  ErrorOr<CompileStatistics> getCompileStatistics() {
+    FUSILLI_ASSIGN_OR_RETURN(
+        std::string json,
+        readCompilationCacheFile(CachedAssetsType::Statistics));
+    return CompileStatistics::parse(json);
+  }
+
+  // Returns the workspace of the loaded artifact broken down by the nodes
+  // producing the intermediates it may hold (see `WorkspaceReport`), and
+  // the transient memory size of `getCompileStatistics()` when the graph was
+  // compiled with a profile dumping it. Requires the graph to be compiled.
+  ErrorOr<WorkspaceReport> getWorkspaceReport() {
+    FUSILLI_ASSIGN_OR_RETURN(std::optional<size_t> workspaceSize,
+                             getWorkspaceSize());
+    FUSILLI_RETURN_ERROR_IF(!workspaceSize.has_value(), ErrorCode::NotCompiled,
+                            "Graph must be compiled before reporting its "
+                            "workspace");
+    WorkspaceReport report;
+    report.workspaceSize = *workspaceSize;
+    report.dynamic = hasDynamicWorkspaceSize();
+    report.splitReductionDisabled = splitReductionDisabledForWorkspace_;
+    ErrorOr<CompileStatistics> stats = getCompileStatistics();
+    if (isOk(stats))
+      report.transientMemorySize = stats->transientMemorySize;
+
+    for (const auto &node : subNodes_) {
+      std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+      node->collectTensors(ins, outs);
+      for (const auto &out : outs) {
+        if (!out->isVirtual())
+          continue;
+        FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                                 getIreeHalElementType(out->getDataType()));
+        uint64_t bytes = static_cast<uint64_t>(out->getVolume()) *
+                         std::max<uint64_t>(
+                             iree_hal_element_dense_byte_count(elementType), 1);
+        report.intermediates.push_back({.node = node->getName(),
+                                        .tensor = out->getName(),
+                                        .bytes = bytes});
+      }
+    }
+    std::stable_sort(report.intermediates.begin(), report.intermediates.end(),
+                     [](const WorkspaceReport::Intermediate &a,
+                        const WorkspaceReport::Intermediate &b) {
+                       return a.bytes > b.bytes;
+                     });
+    return ok(std::move(report));
   }
 
 private:
+  // Splits graphs into partitions, see `fusilli/graph/partition.h`.
+  friend class PartitionedGraph;
+
+  // Falls back to the first tier of `compileTiered()` for graphs over their
+  // compile budget, see `fusilli/graph/compile_queue.h`.
+  friend class CompileQueue;
+
   // Definition in `fusilli/backend/runtime.h`.
   ErrorObject createVmContext(const Handle &handle);
 
-  void clearRuntimeState() {
-    vmFunction_.reset();
-    vmContext_.reset();
-    workspaceSize_.reset();
-    loadedBackend_.reset();
-    loadedArtifactBytes_.clear();
-    vmInputListCapacity_ = 0;
+  // Resolves `entryPoint_` in the loaded VM context and pre-computes the
+  // per-function runtime state. Definition in `fusilli/backend/runtime.h`.
+  ErrorObject resolveEntryPoint(const Handle &handle);
+
+  // Shares the VM context and modules loaded by `module`. Definition in
+  // `fusilli/backend/runtime.h`.
+  ErrorObject shareVmContext(const Handle &handle, const Graph &module);
+
+  // Idle VM contexts for concurrent invocations, see `execute()`. Heap
+  // allocated so the graph stays movable.
+  struct VmContextPool {
+    // Set while an invocation uses the primary context (`vmContext_`).
+    std::atomic_flag primaryBusy;
+    std::mutex mutex;
+    // Idle contexts per queue of the handle (see `Handle::getQueueCount()`),
+    // and the HAL modules of the devices of the extra queues (index =
+    // queue - 1, see `Handle::getHalModule()`), retained on first use of the
+    // queue.
+    std::vector<std::vector<IreeVmContextUniquePtrType>> idle;
+    std::vector<IreeVmModuleUniquePtrType> queueHalModules;
+  };
+
+  // A VM context borrowed for one invocation, returned to the graph when the
+  // lease is destroyed.
+  class VmContextLease {
+  public:
+    VmContextLease(const Graph *graph, size_t queue,
+                   IreeVmContextUniquePtrType context)
+        : graph_(graph), queue_(queue), context_(std::move(context)) {}
+    VmContextLease(VmContextLease &&other) noexcept
+        : graph_(std::exchange(other.graph_, nullptr)), queue_(other.queue_),
+          context_(std::move(other.context_)) {}
+    VmContextLease &operator=(VmContextLease &&) = delete;
+    VmContextLease(const VmContextLease &) = delete;
+    VmContextLease &operator=(const VmContextLease &) = delete;
+    ~VmContextLease() {
+      if (graph_)
+        graph_->releaseVmContext(queue_, std::move(context_));
+    }
+
+    iree_vm_context_t *get() const { return context_.get(); }
+
+  private:
+    const Graph *graph_;
+    size_t queue_;
+    IreeVmContextUniquePtrType context_;
+  };
+
+  // Creates a VM context over the bytecode module and `halModule` (the HAL
+  // module of queue 0 by default), for `vmContextPool_` or an
+  // `ExecutionPlan`. Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<IreeVmContextUniquePtrType>
+  createPooledVmContext(iree_vm_module_t *halModule = nullptr) const;
+
+  // Borrows a VM context for queue `queue` of `handle`: the primary context
+  // when idle (queue 0), else a pooled one (creating it if none is idle).
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorOr<VmContextLease> acquireVmContext(const Handle &handle,
+                                           size_t queue) const;
+
+  // Returns a context borrowed with `acquireVmContext()`. Definition in
+  // `fusilli/backend/runtime.h`.
+  void releaseVmContext(size_t queue,
+                        IreeVmContextUniquePtrType context) const;
+
+  void clearRuntimeState() {
+    vmFunction_.reset();
+    vmContextPool_.reset();
+    vmContext_.reset();
+    bytecodeModule_.reset();
+    parametersModule_.reset();
+    halModule_.reset();
+    vmInstance_.reset();
+    workspaceSize_.reset();
+    splitReductionDisabledForWorkspace_ = false;
+    transientSizeFunction_.reset();
+    specializations_.clear();
+    hotShapes_.reset();
+    loadedBackend_.reset();
+    loadedArtifactBytes_ = {};
+    loadedArtifactOwner_.reset();
+    vmInputListCapacity_ = 0;
+    dummyWaitFence_.reset();
+    dummySignalFence_.reset();
+    moduleMemory_ = detail::TrackedMemory();
+    workspaceMemory_ = detail::TrackedMemory();
+  }
+
+  // Returns whether `node` runs on the matrix cores, see `estimateCost()`.
+  static bool isMatrixNode(const INode &node) {
+    switch (node.getType()) {
+    case INode::Type::Convolution:
+    case INode::Type::WGrad:
+    case INode::Type::DGrad:
+    case INode::Type::ConvTranspose:
+    case INode::Type::Matmul:
+    case INode::Type::Sdpa:
+    case INode::Type::SdpaBwd:
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  // Returns the fingerprint key of the attached compile options that tuned
+  // compile options are recorded under, see `saveTunedCompileOptions()`.
+  ErrorOr<std::string> getTunedCompileOptionsKey(Backend backend) const {
+    CompileOptions options = compileOptions_;
+    options.setProfile(CompileProfile::Diagnostic);
+    return getFingerprintCacheKey(backend, options);
+  }
+
+  // Returns the options to compile with on `backend` when none are passed in:
+  // the autotuned options recorded for the attached ones, if any, otherwise
+  // the attached options themselves.
+  CompileOptions resolveCompileOptions(Backend backend) const {
+    if (!isValidated_ || checkKernelCacheDisabledEnv())
+      return compileOptions_;
+    ErrorOr<std::optional<CompileOptions>> tuned =
+        loadTunedCompileOptions(backend);
+    if (isError(tuned)) {
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to load autotuned compile "
+                             "options: "
+                             << ErrorObject(tuned));
+      return compileOptions_;
+    }
+    if (!tuned->has_value())
+      return compileOptions_;
+    FUSILLI_LOG_LABEL_ENDL("INFO: Using autotuned compile options");
+    return std::move(**tuned);
+  }
+
+  // Returns `resolveCompileOptions(handle.getBackend())`, targeting the GPU of
+  // `handle` when it is not the one the default AMDGPU flags target (device 0,
+  // see `getBackendFlags()`) and no ROCm target was set explicitly.
+  CompileOptions resolveCompileOptions(const Handle &handle) const {
+    CompileOptions options = resolveCompileOptions(handle.getBackend());
+    if (handle.getBackend() != Backend::AMDGPU || handle.getDeviceId() == 0 ||
+        std::ranges::any_of(options.getFlags(), [](const std::string &flag) {
+          return flag.starts_with("--iree-rocm-target=");
+        }))
+      return options;
+    std::string target = getIreeRocmTargetForAmdgpu(handle.getDeviceId());
+    if (!target.empty() && target != getIreeRocmTargetForAmdgpu())
+      options.setRocmTarget(target);
+    return options;
+  }
+
+  // Returns whether the artifact compiled with `options` for `backend` is in
+  // the kernel cache, so compiling it only takes a lookup.
+  ErrorOr<bool> isArtifactCached(Backend backend,
+                                 const CompileOptions &options) {
+    FUSILLI_ASSIGN_OR_RETURN(std::string fingerprintKey,
+                             getFingerprintCacheKey(backend, options));
+    FUSILLI_ASSIGN_OR_RETURN(std::optional<std::filesystem::path> cachedPath,
+                             lookupFingerprintCache(fingerprintKey));
+    return ok(cachedPath.has_value());
+  }
+
+  // Compiles the graph with `options` traded for compilation time (see
+  // `CompileOptions::fastCompile()`) and loads the result, the first tier of
+  // `compileTiered()`.
+  ErrorObject compileFastTier(const Handle &handle,
+                              const CompileOptions &options, bool remove) {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto fastBytes,
+        compileToArtifact(handle.getBackend(),
+                          CompileOptions::fastCompile(options), remove));
+    return loadFromArtifact(handle, std::move(fastBytes));
+  }
+
+  // Attaches a `CompileReport` to the graph for the scope of a `compile()` or
+  // `compileToArtifact()` call, after resetting it. Without a report, the
+  // attached one (if any) is kept.
+  class ReportScope {
+  public:
+    ReportScope(Graph &graph, CompileReport *report)
+        : graph_(graph), previous_(graph.report_) {
+      if (report) {
+        *report = CompileReport();
+        graph.report_ = report;
+      }
+    }
+    ~ReportScope() { graph_.report_ = previous_; }
+
+    ReportScope(const ReportScope &) = delete;
+    ReportScope &operator=(const ReportScope &) = delete;
+
+  private:
+    Graph &graph_;
+    CompileReport *previous_;
+  };
+
+  // Returns the `phase` member of the attached report, or null without one
+  // (see `detail::PhaseTimer`).
+  std::chrono::nanoseconds *
+  reportPhase(std::chrono::nanoseconds CompileReport::*phase) {
+    return report_ ? &(report_->*phase) : nullptr;
+  }
+
+  // Adds the compiler phase times of `session` to the attached report.
+  void recordCompilerTimes(const CompileSession &session) {
+    if (!report_)
+      return;
+    report_->compilerParse += session.getParseTime();
+    report_->compilerPipeline += session.getPipelineTime();
+  }
+
+  // Result of `compileArtifact()`: the path to the VMFB file in the
+  // compile-side cache, or the bytes of an in-memory compilation.
+  struct CompiledArtifact {
+    std::optional<std::filesystem::path> path;
+    std::vector<uint8_t> bytes;
+  };
+
+  // Shared implementation of `compile()` and `compileToArtifact()`, which
+  // leaves reading (or mapping) the artifact to the caller.
+  ErrorOr<CompiledArtifact> compileArtifact(Backend backend,
+                                            const CompileOptions &requested,
+                                            bool remove) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compiling Graph to artifact");
+    detail::PhaseTimer validationTimer(reportPhase(&CompileReport::validation));
+    FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
+                            "Graph must be validated before being compiled");
+    validationTimer.stop();
+    FUSILLI_ASSIGN_OR_RETURN(CompileOptions options,
+                             applyConvLoweringHint(backend, requested));
+    options = applyBufferAlignment(std::move(options));
+    if (backend == Backend::AMDGPU && !options.getTuningSpecPath()) {
+      FUSILLI_ASSIGN_OR_RETURN(std::optional<std::string> tuningSpec,
+                               emitTuningSpecAsm());
+      if (tuningSpec)
+        options.setTuningSpecAsm(std::move(*tuningSpec));
+    }
+
+    // Look up cached artifacts by structural fingerprint first, which avoids
+    // emitting assembly altogether on a hit.
+    detail::PhaseTimer lookupTimer(
+        reportPhase(&CompileReport::cacheValidation));
+    FUSILLI_ASSIGN_OR_RETURN(std::string fingerprintKey,
+                             getFingerprintCacheKey(backend, options));
+    FUSILLI_ASSIGN_OR_RETURN(std::optional<std::filesystem::path> cachedPath,
+                             lookupFingerprintCache(fingerprintKey));
+    lookupTimer.stop();
+    if (cachedPath.has_value()) {
+      FUSILLI_LOG_LABEL_ENDL("INFO: Compiled Graph cached at \"" +
+                             cachedPath->string() + "\" (fingerprint hit)");
+      if (report_)
+        report_->cacheHit = true;
+      return ok(CompiledArtifact{std::move(cachedPath), {}});
+    }
+
+    // Concurrent compilations of the same structure on other `Graph`
+    // instances of this process run once: later callers wait for the first
+    // and pick up its artifact, through the kernel cache if it was published
+    // there. If the first fails, they compile on their own.
+    SingleFlight<std::vector<uint8_t>>::Ticket flight =
+        getCompileFlights().join(fingerprintKey);
+    if (!flight.isLeader()) {
+      FUSILLI_LOG_LABEL_ENDL("INFO: Waiting for a concurrent compilation of "
+                             "the same Graph structure");
+      std::shared_ptr<const std::vector<uint8_t>> shared = flight.wait();
+      FUSILLI_ASSIGN_OR_RETURN(cachedPath,
+                               lookupFingerprintCache(fingerprintKey));
+      if (cachedPath.has_value()) {
+        FUSILLI_LOG_LABEL_ENDL("INFO: Compiled Graph cached at \"" +
+                               cachedPath->string() +
+                               "\" (concurrent compilation)");
+        if (report_)
+          report_->cacheHit = true;
+        return ok(CompiledArtifact{std::move(cachedPath), {}});
+      }
+      if (shared && !shared->empty()) {
+        FUSILLI_LOG_LABEL_ENDL("INFO: Sharing artifact of a concurrent "
+                               "compilation");
+        cache_.reset();
+        cacheFingerprintKey_.reset();
+        return ok(CompiledArtifact{std::nullopt, *shared});
+      }
+    }
+
+    // Generate MLIR assembly for this graph.
+    detail::PhaseTimer emissionTimer(reportPhase(&CompileReport::asmEmission));
+    FUSILLI_ASSIGN_OR_RETURN(std::string generatedAsm, emitAsm());
+    emissionTimer.stop();
+    FUSILLI_ASSIGN_OR_RETURN(
+        CompiledArtifact artifact,
+        compileGeneratedAsm(backend, options, generatedAsm, remove));
+    if (artifact.path.has_value())
+      recordFingerprintCache(fingerprintKey, remove);
+    // Waiters find published artifacts in the kernel cache, the others are
+    // handed a copy of the bytes.
+    flight.finish([&]() -> std::vector<uint8_t> {
+      if (!artifact.path.has_value())
+        return artifact.bytes;
+      if (!remove && !checkKernelCacheDisabledEnv())
+        return {};
+      ErrorOr<std::vector<uint8_t>> bytes = readArtifactBytes(*artifact.path);
+      return isOk(bytes) ? std::move(*bytes) : std::vector<uint8_t>();
+    });
+    return ok(std::move(artifact));
+  }
+
+  // Returns the compilations in flight in this process, by fingerprint cache
+  // key (see `getFingerprintCacheKey()`).
+  static SingleFlight<std::vector<uint8_t>> &getCompileFlights() {
+    static SingleFlight<std::vector<uint8_t>> flights;
+    return flights;
+  }
+
+  // Compiles `generatedAsm`, in memory or through the compile-side caches,
+  // see `compileArtifact()`.
+  ErrorOr<CompiledArtifact> compileGeneratedAsm(Backend backend,
+                                                const CompileOptions &options,
+                                                const std::string &generatedAsm,
+                                                bool remove) {
+    // Without persistence, skip the file system round trip entirely when
+    // requested (see `setCompileInMemory()`).
+    if (compileInMemory_ && remove && !checkCompileBackendEnv()) {
+      FUSILLI_LOG_LABEL_ENDL("INFO: Compiling Graph in memory");
+      FUSILLI_CHECK_ERROR(options.writeTuningSpec());
+      FUSILLI_ASSIGN_OR_RETURN(auto *context, CompileContext::create());
+      FUSILLI_ASSIGN_OR_RETURN(CompileSession session,
+                               context->createSession(backend, options));
+      // In-memory compilations leave no compile-side assets behind.
+      cache_.reset();
+      cacheFingerprintKey_.reset();
+      FUSILLI_ASSIGN_OR_RETURN(auto vmfbBytes,
+                               session.compileToMemory(generatedAsm));
+      recordCompilerTimes(session);
+      return ok(CompiledArtifact{std::nullopt, std::move(vmfbBytes)});
+    }
+
+    // Compile using IREE compiler or reuse cached artifact.
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto vmfbPath,
+        getCompiledArtifact(backend, options, generatedAsm, remove));
+
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compiled Graph cached at \"" +
+                           vmfbPath.string() + "\"");
+
+    return ok(CompiledArtifact{std::move(vmfbPath), {}});
+  }
+
+  // Loads `artifact` returned by `compileArtifact()`, see `compile()`.
+  ErrorObject loadCompiledArtifact(const Handle &handle,
+                                   CompiledArtifact artifact) {
+    if (!artifact.path.has_value())
+      return loadFromArtifact(handle, std::move(artifact.bytes));
+    // Kernel cache entries are never rewritten in place, unlike per-graph
+    // cache files which a later compilation may overwrite while mapped.
+    if (CacheFile::isKernelCachePath(*artifact.path))
+      return loadFromArtifactFile(handle, *artifact.path);
+    detail::PhaseTimer timer(reportPhase(&CompileReport::artifactRead));
+    FUSILLI_ASSIGN_OR_RETURN(auto vmfbBytes, readFileBytes(*artifact.path));
+    timer.stop();
+    return loadFromArtifact(handle, std::move(vmfbBytes));
+  }
+
+  // Recompiles and reloads the loaded artifact without split reductions when
+  // its workspace exceeds the cap of `setMaxWorkspaceSize()`, and disables
+  // them in `options` for the rest of `compile()`.
+  ErrorObject enforceMaxWorkspaceSize(const Handle &handle,
+                                      CompileOptions &options, bool remove) {
+    if (!maxWorkspaceSize_.has_value() || hasDynamicWorkspaceSize())
+      return ok();
+    FUSILLI_ASSIGN_OR_RETURN(size_t workspaceSize, queryTransientSize());
+    if (workspaceSize <= *maxWorkspaceSize_)
+      return ok();
+
+    std::string capMessage = "Graph '" + getName() + "' needs " +
+                             std::to_string(workspaceSize) +
+                             " bytes of workspace, over its cap of " +
+                             std::to_string(*maxWorkspaceSize_) + " bytes";
+    FUSILLI_RETURN_ERROR_IF(
+        options.getSplitReduction(handle.getBackend()) == false,
+        ErrorCode::CompileFailure,
+        capMessage + ", with split reductions already disabled");
+    CompileOptions capped = options;
+    capped.setSplitReduction(false);
+    FUSILLI_LOG_LABEL_ENDL("INFO: " << capMessage
+                                    << ", recompiling without split "
+                                       "reductions");
+    FUSILLI_ASSIGN_OR_RETURN(
+        CompiledArtifact artifact,
+        compileArtifact(handle.getBackend(), capped, remove));
+    FUSILLI_CHECK_ERROR(loadCompiledArtifact(handle, std::move(artifact)));
+    FUSILLI_ASSIGN_OR_RETURN(workspaceSize, queryTransientSize());
+    FUSILLI_RETURN_ERROR_IF(
+        workspaceSize > *maxWorkspaceSize_, ErrorCode::CompileFailure,
+        "Graph '" + getName() + "' needs " + std::to_string(workspaceSize) +
+            " bytes of workspace without split reductions, over its cap of " +
+            std::to_string(*maxWorkspaceSize_) + " bytes");
+    options = std::move(capped);
+    splitReductionDisabledForWorkspace_ = true;
+    return ok();
+  }
+
+  // A static specialization of the graph (see `setShapeBuckets()`): the
+  // shapes of the bound buffers it is selected for, by tensor UID, and a
+  // graph holding its runtime state.
+  struct Specialization {
+    std::vector<std::pair<size_t, std::vector<int64_t>>> shapes;
+    std::unique_ptr<Graph> graph;
+  };
+
+  // Emits the MLIR assembly of the graph with the dynamic dims of the
+  // tensors in `bucket` replaced by its concrete dims.
+  ErrorOr<std::string> emitSpecializedAsm(const ShapeBucket &bucket) const {
+    for (const auto &[tensor, dims] : bucket) {
+      FUSILLI_RETURN_ERROR_IF(
+          tensor == nullptr || (!fullGraphInputs_.contains(tensor) &&
+                                !fullGraphOutputs_.contains(tensor)),
+          ErrorCode::InvalidArgument,
+          "Shape bucket tensor is not part of the graph");
+      FUSILLI_RETURN_ERROR_IF(!tensor->hasDynamicDims(),
+                              ErrorCode::InvalidArgument,
+                              "Shape bucket tensor '" + tensor->getName() +
+                                  "' has no dynamic dims");
+      const std::vector<int64_t> &representative = tensor->getDim();
+      FUSILLI_RETURN_ERROR_IF(dims.size() != representative.size(),
+                              ErrorCode::InvalidArgument,
+                              "Shape bucket dims of tensor '" +
+                                  tensor->getName() +
+                                  "' don't match its rank");
+      for (size_t i = 0; i < dims.size(); ++i) {
+        FUSILLI_RETURN_ERROR_IF(
+            tensor->isDynamicDim(i) ? dims[i] <= 0
+                                    : dims[i] != representative[i],
+            ErrorCode::InvalidArgument,
+            "Shape bucket dim " + std::to_string(i) + " of tensor '" +
+                tensor->getName() + "' must be positive for dynamic dims and " +
+                "match the tensor's dim otherwise");
+        FUSILLI_RETURN_ERROR_IF(
+            tensor->isDynamicDim(i) &&
+                !tensor->getDynamicDimHint(i).isSatisfiedBy(dims[i]),
+            ErrorCode::InvalidArgument,
+            "Shape bucket dim " + std::to_string(i) + " of tensor '" +
+                tensor->getName() + "' doesn't satisfy its dynamic dim hint");
+      }
+    }
+
+    // Emit a copy of the graph in which the bucket tensors are replaced by
+    // static copies, as concurrent executions read the tensors of this graph.
+    // The dims of the other tensors are representative extents for dynamic
+    // dims anyway, which the emitter overlays with `?`.
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<TensorAttr>>
+        copies;
+    for (const auto &[tensor, dims] : bucket) {
+      auto copy = std::make_shared<TensorAttr>(*tensor);
+      copy->setDim(dims).clearDynamicDims();
+      copies.emplace(tensor, std::move(copy));
+    }
+    auto remap = [&](const std::shared_ptr<TensorAttr> &tensor) {
+      auto it = copies.find(tensor);
+      return it == copies.end() ? tensor : it->second;
+    };
+    Graph specialized;
+    specialized.context = context;
+    for (const auto &input : fullGraphInputsSorted_)
+      specialized.fullGraphInputsSorted_.insert(remap(input));
+    for (const auto &output : fullGraphOutputsSorted_)
+      specialized.fullGraphOutputsSorted_.insert(remap(output));
+    for (const auto &donor : inPlaceDonors_)
+      specialized.inPlaceDonors_.insert(remap(donor));
+    for (const auto &node : subNodes_) {
+      std::shared_ptr<INode> clone = node->cloneNode();
+      FUSILLI_RETURN_ERROR_IF(clone == nullptr, ErrorCode::NotImplemented,
+                              "Node '" + node->getName() +
+                                  "' can't be specialized");
+      for (const auto &[tensor, copy] : copies) {
+        clone->replaceInput(tensor, copy);
+        clone->replaceOutput(tensor, copy);
+      }
+      specialized.subNodes_.push_back(std::move(clone));
+    }
+    specialized.isValidated_ = true;
+
+    std::string out;
+    out.reserve(getAsmSizeEstimate());
+    specialized.emitAsmSubtree(out);
+    FUSILLI_LOG_ENDL(out);
+    return ok(std::move(out));
+  }
+
+  // Returns an unloaded graph sharing the inputs and outputs of this graph
+  // (but none of its nodes), which can load and execute artifacts compiled
+  // from it. Its cache files are named after `name`.
+  std::unique_ptr<Graph> makeRuntimeGraph(const std::string &name) const {
+    auto runtime = std::make_unique<Graph>();
+    runtime->setName(name);
+    runtime->fullGraphInputs_ = fullGraphInputs_;
+    runtime->fullGraphOutputs_ = fullGraphOutputs_;
+    runtime->fullGraphInputsSorted_ = fullGraphInputsSorted_;
+    runtime->fullGraphOutputsSorted_ = fullGraphOutputsSorted_;
+    runtime->tensorsByUid_ = tensorsByUid_;
+    runtime->inPlaceDonors_ = inPlaceDonors_;
+    runtime->compileInMemory_ = compileInMemory_;
+    runtime->compileOptions_ = compileOptions_;
+    runtime->isValidated_ = true;
+    runtime->executeCount_ = executeCount_;
+    runtime->eventTag_ = eventTag_;
+    return runtime;
   }
 
+  // Returns the (unloaded) specialization for `bucket`. Its graph is named
+  // after the concrete extents of the dynamic dims, in UID order, so its cache
+  // files don't collide with the other ones.
+  Specialization makeSpecialization(const ShapeBucket &bucket) const {
+    Specialization specialization;
+    std::string name = getName() + "_static";
+    for (size_t uid = 0; uid < tensorsByUid_.size(); ++uid) {
+      auto it = bucket.find(tensorsByUid_[uid]);
+      if (it == bucket.end())
+        continue;
+      for (size_t i = 0; i < it->second.size(); ++i)
+        if (it->first->isDynamicDim(i))
+          name += "_" + std::to_string(it->second[i]);
+      specialization.shapes.emplace_back(uid, it->second);
+    }
+    specialization.graph = makeRuntimeGraph(name);
+    return specialization;
+  }
+
+  // Compiles and loads the static specialization of the graph for `bucket`.
+  ErrorOr<Specialization>
+  compileSpecialization(const Handle &handle, const ShapeBucket &bucket,
+                        const CompileOptions &options, bool remove) {
+    FUSILLI_RETURN_ERROR_IF(!isValidated_, ErrorCode::NotValidated,
+                            "Graph must be validated before being compiled");
+    FUSILLI_ASSIGN_OR_RETURN(std::string generatedAsm,
+                             emitSpecializedAsm(bucket));
+    Specialization specialization = makeSpecialization(bucket);
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compiling static specialization \""
+                           << specialization.graph->getName() << "\"");
+    FUSILLI_ASSIGN_OR_RETURN(CompiledArtifact artifact,
+                             specialization.graph->compileGeneratedAsm(
+                                 handle.getBackend(), options, generatedAsm,
+                                 remove));
+    FUSILLI_CHECK_ERROR(specialization.graph->loadCompiledArtifact(
+        handle, std::move(artifact)));
+    FUSILLI_CHECK_ERROR(specialization.graph->getWorkspaceSize());
+    return ok(std::move(specialization));
+  }
+
+  // Counters and specializations of `setHotShapeThreshold()`, created by
+  // `compile()`. Heap allocated so the graph stays movable and the background
+  // compilations can refer to it.
+  struct HotShapeProfile {
+    const Handle *handle = nullptr;
+    CompileOptions options;
+    bool remove = false;
+    size_t threshold = 0;
+    size_t maxSpecializations = 0;
+    // UIDs of the graph inputs and outputs with dynamic dims, whose bound
+    // shapes key the counters.
+    std::vector<size_t> dynamicUids;
+
+    std::mutex mutex;
+    std::map<std::vector<int64_t>, size_t> counts;
+    size_t launched = 0;
+    std::map<std::vector<int64_t>, std::unique_ptr<Graph>> ready;
+    // Background compilations, which use the members above.
+    std::vector<std::shared_future<void>> pending;
+
+    ~HotShapeProfile() {
+      for (const std::shared_future<void> &compilation : pending)
+        compilation.wait();
+    }
+  };
+
+  // Returns the graph of the first specialization matching the shapes of
+  // `buffers` (indexed by UID), or null to execute the dynamic artifact.
+  // Hot-shape specializations are looked up (and the shape counted, see
+  // `setHotShapeThreshold()`) when no bucket matches; they are only returned
+  // if `workspace`, when provided, is large enough for them. Definition in
+  // `fusilli/backend/runtime.h`.
+  const Graph *findSpecialization(std::span<Buffer *const> buffers,
+                                  const Buffer *workspace) const;
+
+  // Counts the shapes of `buffers` and returns the matching hot-shape
+  // specialization, if loaded. Launches its compilation when the shape
+  // reaches the threshold. Definition in `fusilli/backend/runtime.h`.
+  const Graph *profileShape(std::span<Buffer *const> buffers,
+                            const Buffer *workspace) const;
+
   // Queries the required transient/workspace buffer size from the compiled
-  // module. Returns the size in bytes, or 0 if no transients are needed.
-  // Returns an error if the module requires dynamic transient sizes.
+  // module. Returns the size in bytes, or 0 if no transients are needed or
+  // if the size is data-dependent (see `hasDynamicWorkspaceSize()`).
   // Definition in `fusilli/backend/runtime.h`.
   ErrorOr<size_t> queryTransientSize() const;
 
   // Create compiled artifacts from graph writing results to the cache. Set
   // `remove = true` to remove cache files when returned `CachedAssets` lifetime
-  // ends.
+  // ends. With the diagnostic compile profile, `cacheKey` is written to the
+  // digest sidecar once compilation succeeds, which lets other processes
+  // verify the assets with one small read.
   ErrorOr<CachedAssets>
-  generateCompiledArtifact(Backend backend, const std::string &generatedAsm,
-                           bool remove) {
+  generateCompiledArtifact(Backend backend, const CompileOptions &options,
+                           const std::string &generatedAsm,
+                           const std::string &cacheKey, bool remove) {
     FUSILLI_LOG_LABEL_ENDL("INFO: Generating compiled artifacts");
+    if (options.getProfile() == CompileProfile::Production)
+      return generateProductionArtifact(backend, options, generatedAsm,
+                                        cacheKey, remove);
 
     // Create cache files.
     FUSILLI_ASSIGN_OR_RETURN(auto inputCache,
@@ -515,47 +2588,421 @@ private:
                                  /*graphName=*/getName(),
                                  /*fileName=*/IREE_COMPILE_STATISTICS_FILENAME,
                                  /*remove=*/remove));
+    FUSILLI_ASSIGN_OR_RETURN(auto digestCache,
+                             CacheFile::create(
+                                 /*graphName=*/getName(),
+                                 /*fileName=*/IREE_COMPILE_DIGEST_FILENAME,
+                                 /*remove=*/remove));
     CachedAssets cache = CachedAssets(
         /*in=*/std::move(inputCache),
         /*out=*/std::move(outputCache),
         /*cmd=*/std::move(commandCache),
-        /*stats=*/std::move(statisticsCache));
+        /*stats=*/std::move(statisticsCache),
+        /*dgst=*/std::move(digestCache),
+        /*cacheKey=*/cacheKey);
 
     // Write input asm to cache.
-    FUSILLI_CHECK_ERROR(cache.input.write(generatedAsm));
+    FUSILLI_CHECK_ERROR(cache.input->write(generatedAsm));
+    FUSILLI_CHECK_ERROR(options.writeTuningSpec());
 
     // determine which implementation to use.
     if (checkCompileBackendEnv()) {
       // Use CompileCommand (CLI).
       CompileCommand cmd = CompileCommand::build(
-          backend, cache.input, cache.output, cache.statistics);
-      FUSILLI_CHECK_ERROR(cmd.writeTo(cache.command));
+          backend, *cache.input, cache.output, *cache.statistics, options);
+      FUSILLI_CHECK_ERROR(cmd.writeTo(*cache.command));
       FUSILLI_LOG_LABEL_ENDL("INFO: iree-compile command (CLI)");
       FUSILLI_LOG_ENDL(cmd.toString());
+      detail::PhaseTimer timer(reportPhase(&CompileReport::compilerPipeline));
       FUSILLI_CHECK_ERROR(cmd.execute());
     } else {
       // Use CompileSession (C API) - DEFAULT.
-      FUSILLI_ASSIGN_OR_RETURN(CompileSession session,
-                               CompileSession::build(backend, cache.input,
-                                                     cache.output,
-                                                     cache.statistics));
-      FUSILLI_CHECK_ERROR(session.writeTo(cache.command));
+      FUSILLI_ASSIGN_OR_RETURN(
+          CompileSession session,
+          CompileSession::build(backend, *cache.input, cache.output,
+                                *cache.statistics, options));
+      FUSILLI_CHECK_ERROR(session.writeTo(*cache.command));
       FUSILLI_LOG_LABEL_ENDL("INFO: iree-compile command (C API)");
       FUSILLI_LOG_ENDL(session.toString());
       FUSILLI_CHECK_ERROR(session.execute());
+      recordCompilerTimes(session);
     }
 
+    // Only record the digest once the artifact is complete, so a failed
+    // compilation can never validate.
+    FUSILLI_CHECK_ERROR(cache.digest->write(cacheKey));
+
     return ok(std::move(cache));
   }
 
+  // Production profile variant of `generateCompiledArtifact()`, which writes
+  // the VMFB and nothing else: the C API compiles the assembly from memory
+  // and the CLI reads it from a temporary input file, neither dumps
+  // statistics, and the cache key only lives in the returned assets.
+  ErrorOr<CachedAssets>
+  generateProductionArtifact(Backend backend, const CompileOptions &options,
+                             const std::string &generatedAsm,
+                             const std::string &cacheKey, bool remove) {
+    FUSILLI_ASSIGN_OR_RETURN(auto outputCache,
+                             CacheFile::create(
+                                 /*graphName=*/getName(),
+                                 /*fileName=*/IREE_COMPILE_OUTPUT_FILENAME,
+                                 /*remove=*/remove));
+    CachedAssets cache = CachedAssets(std::move(outputCache), cacheKey);
+    FUSILLI_CHECK_ERROR(options.writeTuningSpec());
+
+    if (checkCompileBackendEnv()) {
+      FUSILLI_ASSIGN_OR_RETURN(auto inputCache,
+                               CacheFile::create(
+                                   /*graphName=*/getName(),
+                                   /*fileName=*/IREE_COMPILE_INPUT_FILENAME,
+                                   /*remove=*/true));
+      FUSILLI_CHECK_ERROR(inputCache.write(generatedAsm));
+      CompileCommand cmd =
+          CompileCommand::build(backend, inputCache, cache.output, options);
+      FUSILLI_LOG_LABEL_ENDL("INFO: iree-compile command (CLI)");
+      FUSILLI_LOG_ENDL(cmd.toString());
+      detail::PhaseTimer timer(reportPhase(&CompileReport::compilerPipeline));
+      FUSILLI_CHECK_ERROR(cmd.execute());
+    } else {
+      FUSILLI_ASSIGN_OR_RETURN(auto *context, CompileContext::create());
+      FUSILLI_ASSIGN_OR_RETURN(CompileSession session,
+                               context->createSession(backend, options));
+      FUSILLI_CHECK_ERROR(session.compileSource(generatedAsm,
+                                                cache.output.path.string()));
+      recordCompilerTimes(session);
+    }
+    return ok(std::move(cache));
+  }
+
+  // Opens the kernel cache entry for `key` if a complete entry exists. Entries
+  // are never removed through the returned `CachedAssets`.
+  std::optional<CachedAssets> openKernelCache(const std::string &key) {
+    // The output artifact is published last, so its absence is a cheap and
+    // quiet miss.
+    ErrorOr<CacheFile> output = CacheFile::open(
+        CacheFile::getKernelCachePath(key, IREE_COMPILE_OUTPUT_FILENAME));
+    if (isError(output))
+      return std::nullopt;
+    // Keep recently used entries from being evicted (see
+    // `evictKernelCache()`).
+    detail::touchKernelCacheEntry(key);
+
+    // Entries recorded in the index are complete, so the index tells which
+    // assets they hold without probing for each.
+    if (std::optional<detail::KernelCacheIndexSlot> indexed =
+            detail::KernelCacheIndex::find(detail::KernelCacheIndexKind::Entry,
+                                           key)) {
+      if (indexed->outputOnly)
+        return CachedAssets(std::move(*output), key);
+      auto openIndexed = [&](const char *fileName) {
+        return CacheFile::openUnchecked(
+            CacheFile::getKernelCachePath(key, fileName));
+      };
+      return CachedAssets(openIndexed(IREE_COMPILE_INPUT_FILENAME),
+                          std::move(*output),
+                          openIndexed(IREE_COMPILE_COMMAND_FILENAME),
+                          openIndexed(IREE_COMPILE_STATISTICS_FILENAME),
+                          openIndexed(IREE_COMPILE_DIGEST_FILENAME), key);
+    }
+
+    // Entries published by the production compile profile only hold the
+    // output, see `publishKernelCache()`.
+    auto open = [&](const char *fileName) {
+      return CacheFile::open(CacheFile::getKernelCachePath(key, fileName));
+    };
+    ErrorOr<CacheFile> digest = open(IREE_COMPILE_DIGEST_FILENAME);
+    if (isError(digest))
+      return CachedAssets(std::move(*output), key);
+    ErrorOr<CacheFile> input = open(IREE_COMPILE_INPUT_FILENAME);
+    ErrorOr<CacheFile> command = open(IREE_COMPILE_COMMAND_FILENAME);
+    ErrorOr<CacheFile> statistics = open(IREE_COMPILE_STATISTICS_FILENAME);
+    if (isError(input) || isError(command) || isError(statistics))
+      return std::nullopt;
+    return CachedAssets(std::move(*input), std::move(*output),
+                        std::move(*command), std::move(*statistics),
+                        std::move(*digest), key);
+  }
+
+  // Fetches the entry for `key` from the remote kernel cache (see
+  // `getRemoteKernelCache()`) into the local kernel cache and opens it. Must
+  // be called with the kernel cache lock for `key` held. Failures to fetch,
+  // and entries whose output does not match its recorded content digest, are
+  // not fatal and are treated as misses.
+  std::optional<CachedAssets> fetchRemoteKernelCache(const std::string &key) {
+    std::shared_ptr<RemoteKernelCache> remote = getRemoteKernelCache();
+    if (!remote)
+      return std::nullopt;
+    std::filesystem::path entryDir =
+        CacheFile::getKernelCachePath(key, "").parent_path();
+    // Fetch into a staging directory and move the files into place with the
+    // output last, as its presence marks the entry complete.
+    std::filesystem::path stagingDir = CacheFile::getTempPath(entryDir);
+    std::error_code ec;
+    std::filesystem::create_directories(stagingDir, ec);
+    if (ec)
+      return std::nullopt;
+    ErrorOr<bool> fetched = remote->fetch(key, stagingDir);
+    if (isError(fetched))
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to fetch from remote kernel "
+                             "cache: "
+                             << ErrorObject(fetched));
+    std::filesystem::path stagedOutput =
+        stagingDir / IREE_COMPILE_OUTPUT_FILENAME;
+    bool fetchedEntry = isOk(fetched) && *fetched &&
+                        std::filesystem::exists(stagedOutput, ec);
+    // Only publish outputs matching the content digest recorded by the node
+    // that compiled them (see `publishKernelCache()`).
+    if (fetchedEntry && !verifyOutputDigest(stagingDir)) {
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Discarding remote kernel cache entry "
+                             << key << " that fails digest verification");
+      fetchedEntry = false;
+    }
+    if (fetchedEntry) {
+      std::vector<std::filesystem::path> files;
+      using DirIt = std::filesystem::directory_iterator;
+      for (DirIt it(stagingDir, ec); !ec && it != DirIt(); it.increment(ec))
+        if (it->path() != stagedOutput)
+          files.push_back(it->path());
+      for (size_t i = 0; !ec && i < files.size(); ++i)
+        std::filesystem::rename(files[i], entryDir / files[i].filename(), ec);
+      if (!ec)
+        std::filesystem::rename(
+            stagedOutput, entryDir / IREE_COMPILE_OUTPUT_FILENAME, ec);
+    }
+    std::error_code removeEc;
+    std::filesystem::remove_all(stagingDir, removeEc);
+    if (!ec && fetchedEntry) {
+      ErrorObject status = detail::indexKernelCacheEntry(key);
+      if (isError(status))
+        FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to index kernel cache entry: "
+                               << status);
+    }
+    return openKernelCache(key);
+  }
+
+  // Returns the content digest of the (uncompressed) output artifact
+  // `bytes`, recorded next to the output of kernel cache entries.
+  static std::string getOutputDigest(std::span<const uint8_t> bytes) {
+    return Hasher().update(bytes).hexDigest();
+  }
+
+  // Returns whether the output artifact in the entry directory `dir` matches
+  // the content digest recorded in its sidecar. Entries without the sidecar
+  // do not verify.
+  static bool verifyOutputDigest(const std::filesystem::path &dir) {
+    ErrorOr<CacheFile> digestFile =
+        CacheFile::open(dir / IREE_COMPILE_OUTPUT_DIGEST_FILENAME);
+    if (isError(digestFile))
+      return false;
+    ErrorOr<std::string> digest = digestFile->read();
+    ErrorOr<std::vector<uint8_t>> bytes =
+        readArtifactBytes(dir / IREE_COMPILE_OUTPUT_FILENAME);
+    return isOk(digest) && isOk(bytes) && *digest == getOutputDigest(*bytes);
+  }
+
+  // Mixes everything besides the graph itself that determines the compiled
+  // artifact into `hasher`: the backend, its compiler flags with `options`
+  // applied, the compile profile and the compiler identity (C API revision, or
+  // `iree-compile` path for the CLI).
+  static ErrorObject hashCompileEnvironment(Hasher &hasher, Backend backend,
+                                            const CompileOptions &options) {
+    hasher.update(kBackendToStr.at(backend));
+    for (const auto &flag : options.resolveFlags(backend))
+      hasher.update(flag);
+    // Kernel cache entries of the diagnostic profile (the default, keyed as
+    // before profiles existed) must always hold the full set of assets.
+    if (options.getProfile() == CompileProfile::Production)
+      hasher.update("production");
+    if (checkCompileBackendEnv()) {
+      hasher.update("cli").update(getIreeCompilePath());
+    } else {
+      FUSILLI_ASSIGN_OR_RETURN(auto *context, CompileContext::create());
+      hasher.update("capi").update(context->getRevision());
+    }
+    return ok();
+  }
+
+  // Hashes the structure of the graph: everything `emitAsm()` depends on,
+  // besides names. Graph inputs and outputs are visited in sorted order first,
+  // so tensor ids (see `Fingerprinter::tensor`) follow the positional order in
+  // which `execute()` binds buffers rather than hash set iteration order.
+  std::string computeFingerprint() const {
+    Fingerprinter fp;
+    fp.update(context.getIODataType())
+        .update(context.getIntermediateDataType())
+        .update(context.getComputeDataType());
+    fp.update(fullGraphInputsSorted_.size());
+    for (const auto &input : fullGraphInputsSorted_)
+      fp.tensor(input);
+    fp.update(fullGraphOutputsSorted_.size());
+    for (const auto &output : fullGraphOutputsSorted_)
+      fp.tensor(output);
+    hashSubtree(fp);
+    return fp.hexDigest();
+  }
+
+  // Returns the tag of this graph's events (see `EventLog`): its fingerprint
+  // and the dims of its first argument.
+  EventTag computeEventTag() const {
+    static const std::vector<int64_t> kNoDims;
+    return EventTag::of(fingerprint_, tensorsByUid_.empty()
+                                          ? kNoDims
+                                          : tensorsByUid_.front()->getDim());
+  }
+
+  // Returns the path to cached artifacts for `fingerprintKey` (see
+  // `getFingerprintCacheKey()`), or std::nullopt on a miss. The in-process
+  // `cache_` is checked first, then the kernel cache alias written by
+  // `recordFingerprintCache()`. Either way, the assets are still validated
+  // against their digest sidecar.
+  ErrorOr<std::optional<std::filesystem::path>>
+  lookupFingerprintCache(const std::string &fingerprintKey) {
+    if (cache_.has_value() && cacheFingerprintKey_ == fingerprintKey) {
+      FUSILLI_ASSIGN_OR_RETURN(bool cacheValid, validateCache(cache_->key));
+      if (cacheValid)
+        return ok(std::optional(cache_->output.path));
+    }
+
+    if (checkKernelCacheDisabledEnv())
+      return ok(std::optional<std::filesystem::path>());
+    // Aliases recorded in the index point at entries that were complete when
+    // recorded, so neither the alias file nor the digest sidecar is read.
+    std::string cacheKey;
+    std::optional<detail::KernelCacheIndexSlot> indexed =
+        detail::KernelCacheIndex::find(detail::KernelCacheIndexKind::Alias,
+                                       fingerprintKey);
+    if (indexed.has_value()) {
+      cacheKey = indexed->getTarget();
+    } else {
+      std::filesystem::path aliasPath =
+          CacheFile::getKernelCacheAliasPath(fingerprintKey);
+      if (!std::filesystem::exists(aliasPath))
+        return ok(std::optional<std::filesystem::path>());
+      FUSILLI_ASSIGN_OR_RETURN(CacheFile alias, CacheFile::open(aliasPath));
+      FUSILLI_ASSIGN_OR_RETURN(cacheKey, alias.read());
+    }
+    std::optional<CachedAssets> kernelCache = openKernelCache(cacheKey);
+    if (!kernelCache.has_value())
+      return ok(std::optional<std::filesystem::path>());
+    if (!indexed.has_value() && kernelCache->digest.has_value()) {
+      ErrorOr<std::string> digest = kernelCache->digest->read();
+      if (isError(digest) || *digest != cacheKey)
+        return ok(std::optional<std::filesystem::path>());
+    }
+    FUSILLI_LOG_LABEL_ENDL("INFO: Kernel cache hit for fingerprint key "
+                           << fingerprintKey);
+    ++detail::getKernelCacheCounters().hits;
+    cache_ = std::move(kernelCache);
+    cacheFingerprintKey_ = fingerprintKey;
+    return ok(std::optional(cache_->output.path));
+  }
+
+  // Associates `fingerprintKey` with the artifacts in `cache_` so later
+  // lookups can skip assembly emission. When the artifacts were published to
+  // the kernel cache (`remove = false`), an alias is written there too so
+  // other `Graph` instances and processes benefit. Failing to write the alias
+  // is not fatal.
+  void recordFingerprintCache(const std::string &fingerprintKey, bool remove) {
+    cacheFingerprintKey_ = fingerprintKey;
+    if (remove || checkKernelCacheDisabledEnv())
+      return;
+    ErrorObject status = writeKernelCacheAlias(fingerprintKey);
+    if (isError(status))
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to write kernel cache alias: "
+                             << status);
+  }
+
+  // Writes the kernel cache alias from `fingerprintKey` to the kernel cache
+  // key of `cache_`.
+  ErrorObject writeKernelCacheAlias(const std::string &fingerprintKey) {
+    FUSILLI_CHECK_ERROR(CacheFile::publish(
+        CacheFile::getKernelCacheAliasPath(fingerprintKey), cache_->key));
+    return detail::indexKernelCacheAlias(fingerprintKey, cache_->key);
+  }
+
+  // Copies freshly compiled `assets` into the kernel cache entry for `key`.
+  // The output artifact is copied last, so an entry is only considered
+  // complete by `openKernelCache` when all the files are present. An existing
+  // output artifact is left alone: it is identical by construction and may be
+  // memory-mapped by other graphs (see `compile()`).
+  ErrorObject publishKernelCache(const std::string &key,
+                                 const CachedAssets &assets) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Publishing to kernel cache with key " << key);
+    std::filesystem::path entryDir =
+        CacheFile::getKernelCachePath(key, "").parent_path();
+    std::error_code ec;
+    std::filesystem::create_directories(entryDir, ec);
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to create kernel cache directory: " +
+                                entryDir.string() + " - " + ec.message());
+    // Assets of the production compile profile only consist of the output.
+    std::vector<const CacheFile *> files;
+    for (const std::optional<CacheFile> *asset :
+         {&assets.input, &assets.command, &assets.statistics, &assets.digest})
+      if (asset->has_value())
+        files.push_back(&**asset);
+    files.push_back(&assets.output);
+    std::optional<int> compressionLevel = getArtifactCompressionLevel();
+    for (const CacheFile *file : files) {
+      std::filesystem::path entryPath = entryDir / file->path.filename();
+      if (file == &assets.output && std::filesystem::exists(entryPath))
+        break;
+      if (file == &assets.output) {
+        // Record the content digest of the output before the output itself,
+        // so nodes fetching the entry from the remote kernel cache can verify
+        // it (see `fetchRemoteKernelCache()`). The output is mapped rather
+        // than read, so neither this nor compressing it copies the artifact.
+        FUSILLI_ASSIGN_OR_RETURN(MappedFile mapped,
+                                 MappedFile::open(file->path));
+        FUSILLI_CHECK_ERROR(
+            CacheFile::publish(entryDir / IREE_COMPILE_OUTPUT_DIGEST_FILENAME,
+                               getOutputDigest(mapped.bytes())));
+        // The output is stored compressed if requested, which also shrinks
+        // the transfers of the entry to and from the remote kernel cache.
+        if (compressionLevel.has_value()) {
+          FUSILLI_CHECK_ERROR(CacheFile::publish(entryPath, mapped.bytes(),
+                                                 compressionLevel));
+          break;
+        }
+      }
+      // Copy to a temporary file and rename it into place, so readers never
+      // observe (or map) a partially copied file. The output is copied last,
+      // as its presence marks the entry complete (see `openKernelCache()`).
+      std::filesystem::path tempPath = CacheFile::getTempPath(entryPath);
+      std::filesystem::copy_file(
+          file->path, tempPath,
+          std::filesystem::copy_options::overwrite_existing, ec);
+      if (!ec)
+        std::filesystem::rename(tempPath, entryPath, ec);
+      if (ec) {
+        std::error_code removeEc;
+        std::filesystem::remove(tempPath, removeEc);
+        return error(ErrorCode::FileSystemFailure,
+                     "Failed to copy " + file->path.string() +
+                         " to kernel cache - " + ec.message());
+      }
+    }
+    // The index only speeds up later lookups, so failing to update it is not
+    // fatal.
+    ErrorObject status = detail::indexKernelCacheEntry(key);
+    if (isError(status))
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to index kernel cache entry: "
+                             << status);
+    return ok();
+  }
+
   // Check for cache validity. Cache should be invalidated if:
   //  - Cache has not been generated for this instance yet
   //  - Graph name (and therefore cache path) has changed
   //  - Generated assembly differs
-  //  - Compile commands have changed
-  //  - Backend (and therefore compile command) has changed
-  ErrorOr<bool> validateCache(Backend backend,
-                              const std::string &generatedAsm) {
+  //  - Compile flags, compiler or backend have changed
+  //
+  // All but the first two are covered by `cacheKey` (see
+  // `getKernelCacheKey()`), which is compared against the key of the cached
+  // assets. A hit therefore costs no more than a single small read rather than
+  // re-reading the input assembly and rebuilding the compile command.
+  ErrorOr<bool> validateCache(const std::string &cacheKey) {
     FUSILLI_LOG_LABEL_ENDL("INFO: Validating cache");
 
     // Check for cache miss if cache hasn't been generated.
@@ -565,80 +3012,35 @@ private:
     }
 
     // Check for cache miss if paths don't match (e.g., if graph name changed).
-    if (cache_->input.path != CacheFile::getPath(
-                                  /*graphName=*/getName(),
-                                  /*fileName=*/IREE_COMPILE_INPUT_FILENAME)) {
-      FUSILLI_LOG_ENDL("Cache input paths differ.");
-      return ok(false);
-    }
-    if (cache_->output.path != CacheFile::getPath(
-                                   /*graphName=*/getName(),
-                                   /*fileName=*/IREE_COMPILE_OUTPUT_FILENAME)) {
-      FUSILLI_LOG_ENDL("Cache output paths differ.");
-      return ok(false);
-    }
-    if (cache_->command.path !=
-        CacheFile::getPath(
-            /*graphName=*/getName(),
-            /*fileName=*/IREE_COMPILE_COMMAND_FILENAME)) {
-      FUSILLI_LOG_ENDL("Cache compile command paths differ.");
-      return ok(false);
-    }
-    if (cache_->statistics.path !=
-        CacheFile::getPath(
-            /*graphName=*/getName(),
-            /*fileName=*/IREE_COMPILE_STATISTICS_FILENAME)) {
-      FUSILLI_LOG_ENDL("Cache compile statistics paths differ.");
+    // Assets opened from the kernel cache live in the entry for their key.
+    std::filesystem::path cacheDir = cache_->output.path.parent_path();
+    if (cacheDir != CacheFile::getPath(getName(), "").parent_path() &&
+        cacheDir != CacheFile::getKernelCachePath(cacheKey, "").parent_path()) {
+      FUSILLI_LOG_ENDL("Cache paths differ.");
       return ok(false);
     }
 
-    // Open expected files.
-    FUSILLI_ASSIGN_OR_RETURN(CacheFile input,
-                             CacheFile::open(
-                                 /*graphName=*/getName(),
-                                 /*fileName=*/IREE_COMPILE_INPUT_FILENAME));
-    FUSILLI_ASSIGN_OR_RETURN(CacheFile output,
-                             CacheFile::open(
-                                 /*graphName=*/getName(),
-                                 /*fileName=*/IREE_COMPILE_OUTPUT_FILENAME));
-    FUSILLI_ASSIGN_OR_RETURN(CacheFile command,
-                             CacheFile::open(
-                                 /*graphName=*/getName(),
-                                 /*fileName=*/IREE_COMPILE_COMMAND_FILENAME));
-    FUSILLI_ASSIGN_OR_RETURN(
-        CacheFile statistics,
-        CacheFile::open(
-            /*graphName=*/getName(),
-            /*fileName=*/IREE_COMPILE_STATISTICS_FILENAME));
-
-    // Check for a cache miss on generated assembly.
-    FUSILLI_ASSIGN_OR_RETURN(std::string inputContents, input.read());
-    if (inputContents != generatedAsm) {
-      FUSILLI_LOG_ENDL("Generated assembly does not match");
+    // Check for a cache miss on the digest of assembly, flags and compiler.
+    if (cache_->key != cacheKey) {
+      FUSILLI_LOG_ENDL("Cache key does not match");
       return ok(false);
     }
-
-    // Check for a cache miss on compile command.
-    std::string cmdString;
-
-    if (checkCompileBackendEnv()) {
-      // Use CompileCommand (CLI).
-      CompileCommand cmd =
-          CompileCommand::build(backend, input, output, statistics);
-      cmdString = cmd.toString();
-    } else {
-      // Use CompileSession (C API) - DEFAULT.
-      FUSILLI_ASSIGN_OR_RETURN(
-          auto session,
-          CompileSession::build(backend, input, output, statistics));
-      cmdString = session.toString();
-    }
-
-    FUSILLI_ASSIGN_OR_RETURN(std::string commandContents, command.read());
-    if (commandContents != cmdString) {
-      FUSILLI_LOG_ENDL("Compile command does not match");
+    if (!std::filesystem::exists(cache_->output.path) ||
+        (cache_->digest.has_value() &&
+         !std::filesystem::exists(cache_->digest->path))) {
+      FUSILLI_LOG_ENDL("Cached files missing.");
       return ok(false);
     }
+    // The digest sidecar also catches assets overwritten by another process
+    // compiling a graph with the same name.
+    if (cache_->digest.has_value()) {
+      FUSILLI_ASSIGN_OR_RETURN(std::string digestContents,
+                               cache_->digest->read());
+      if (digestContents != cacheKey) {
+        FUSILLI_LOG_ENDL("Cache digest does not match");
+        return ok(false);
+      }
+    }
 
     return ok(true);
   }
@@ -646,7 +3048,7 @@ private:
   std::shared_ptr<TensorAttr> outputTensor(const std::string &name) {
     FUSILLI_LOG_LABEL_ENDL("INFO: Adding output tensor '"
                            << name << "' to Graph outputs");
-    auto tensor = std::make_shared<TensorAttr>();
+    auto tensor = makeShared<TensorAttr>();
     tensor->setName(name).setIsVirtual(true);
     fullGraphOutputs_.insert(tensor);
     return tensor;
@@ -654,21 +3056,19 @@ private:
 
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating Graph");
-    // Validate input/output names are unique (requirement for SSA).
-    std::unordered_set<std::string> usedSymbols;
-    for (const auto &t : fullGraphInputs_) {
-      FUSILLI_RETURN_ERROR_IF(usedSymbols.contains(t->getName()), // C++20
-                              ErrorCode::InvalidAttribute,
-                              "Symbol name '" + t->getName() +
-                                  "' already in use");
-      usedSymbols.insert(t->getName());
-    }
-    for (const auto &t : fullGraphOutputs_) {
-      FUSILLI_RETURN_ERROR_IF(usedSymbols.contains(t->getName()), // C++20
-                              ErrorCode::InvalidAttribute,
-                              "Symbol name '" + t->getName() +
-                                  "' already in use");
-      usedSymbols.insert(t->getName());
+    // Validate input/output names are unique (requirement for SSA). Names
+    // are looked up once each, without copies, so this stays linear in the
+    // size of the graph.
+    std::unordered_set<std::string_view> usedSymbols;
+    usedSymbols.reserve(fullGraphInputs_.size() + fullGraphOutputs_.size() +
+                        getSubtreeNodeCount());
+    for (const auto *tensors : {&fullGraphInputs_, &fullGraphOutputs_}) {
+      for (const auto &t : *tensors) {
+        FUSILLI_RETURN_ERROR_IF(!usedSymbols.insert(t->getName()).second,
+                                ErrorCode::InvalidAttribute,
+                                "Symbol name '" + t->getName() +
+                                    "' already in use");
+      }
     }
     // Recursively validate node names are unique (requirement for SSA).
     FUSILLI_CHECK_ERROR(checkNodeNamesAreUnique(usedSymbols));
@@ -684,33 +3084,1032 @@ private:
                                   fullGraphInputs_.end());
     fullGraphOutputsSorted_.insert(fullGraphOutputs_.begin(),
                                    fullGraphOutputs_.end());
+    // Assign dense UIDs in the argument order of the compiled function.
+    tensorsByUid_.clear();
+    for (const auto &output : fullGraphOutputsSorted_)
+      if (!output->isVirtual() && !output->isInPlace())
+        tensorsByUid_.push_back(output);
+    for (const auto &input : fullGraphInputsSorted_)
+      if (!input->isEmbedded())
+        tensorsByUid_.push_back(input);
     return ok();
   }
 
   ErrorObject postValidateNode() const override final { return ok(); }
 
+  // Autocast pass run by `validate()` before inference, see `setAutocast()`.
+  //
+  // Nodes are visited in topological order. Convolutions and matmuls compute
+  // in the compute data type and reductions, softmax and normalizations in
+  // Float: their floating point operands in another data type are converted
+  // by an IDENTITY pointwise node (emitted as a cast), inserted before the
+  // first consumer and shared by all consumers wanting that data type, so
+  // casts only appear where precisions meet. Their intermediate outputs
+  // without a data type get the one they are computed in. Pointwise outputs
+  // get the compute data type too (pointwise operations convert their
+  // operands themselves), pooling outputs the data type of their input. The
+  // shape nodes already follow their input. Custom ops, SDPA, index
+  // reductions (e.g. ARGMAX) and quantized (scaled) convolutions and matmuls
+  // pick their own precisions and are left alone.
+  ErrorObject autocast() {
+    const DataType low = context.getComputeDataType();
+    FUSILLI_RETURN_ERROR_IF(
+        low != DataType::Half && low != DataType::BFloat16,
+        ErrorCode::InvalidAttribute,
+        "Autocast requires a Half or BFloat16 compute data type");
+
+    // The data type of `t` once inferred (see `TensorAttr::fillFromContext`).
+    auto dataTypeOf = [&](const std::shared_ptr<TensorAttr> &t) {
+      if (t->getDataType() != DataType::NotSet)
+        return t->getDataType();
+      return t->isVirtual() ? context.getIntermediateDataType()
+                            : context.getIODataType();
+    };
+    auto assign = [](const std::shared_ptr<TensorAttr> &t, DataType type) {
+      if (t->isVirtual() && t->getDataType() == DataType::NotSet)
+        t->setDataType(type);
+    };
+
+    std::vector<std::shared_ptr<INode>> nodes;
+    nodes.reserve(subNodes_.size());
+    std::map<std::pair<std::shared_ptr<TensorAttr>, DataType>,
+             std::shared_ptr<TensorAttr>>
+        casts;
+    // Feeds the floating point operand `t` to `node` in data type `type`.
+    auto castOperand = [&](INode &node, const std::shared_ptr<TensorAttr> &t,
+                           DataType type) {
+      DataType from = dataTypeOf(t);
+      if (t->isScalar() || from == type ||
+          (from != DataType::Half && from != DataType::BFloat16 &&
+           from != DataType::Float && from != DataType::Double))
+        return;
+      std::shared_ptr<TensorAttr> &cast = casts[{t, type}];
+      if (!cast) {
+        std::string name =
+            t->getName() + "_autocast_" + kDataTypeToMlirTypeAsm.at(type);
+        cast = makeShared<TensorAttr>();
+        cast->setName(name).setIsVirtual(true).setDataType(type);
+        fullGraphOutputs_.insert(cast);
+        auto attr = PointwiseAttr()
+                        .setMode(PointwiseAttr::Mode::IDENTITY)
+                        .setName(name + "_cast");
+        attr.setIN_0(t).setOUT_0(cast);
+        nodes.push_back(makeShared<PointwiseNode>(std::move(attr), context));
+      }
+      node.replaceInput(t, cast);
+    };
+
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    for (const auto &node : subNodes_) {
+      DataType type = DataType::NotSet;
+      switch (node->getType()) {
+      case Type::Convolution: {
+        const auto &attr = static_cast<ConvFPropNode &>(*node).convFPropAttr;
+        if (!attr.getSCALE_X() && !attr.getSCALE_W())
+          type = low;
+        break;
+      }
+      case Type::Matmul: {
+        const auto &attr = static_cast<MatmulNode &>(*node).matmulAttr;
+        if (!attr.getSCALE_A() && !attr.getSCALE_B())
+          type = low;
+        break;
+      }
+      case Type::WGrad:
+      case Type::DGrad:
+      case Type::ConvTranspose:
+        type = low;
+        break;
+      case Type::Reduction:
+        // Index modes only compare the elements of X.
+        if (!ReductionAttr::isIndexMode(
+                static_cast<ReductionNode &>(*node).reductionAttr.getMode()))
+          type = DataType::Float;
+        break;
+      case Type::Softmax:
+      case Type::BatchNorm:
+      case Type::LayerNorm:
+      case Type::RmsNorm:
+        type = DataType::Float;
+        break;
+      case Type::Pointwise:
+        assign(static_cast<PointwiseNode &>(*node).pointwiseAttr.getOUT_0(),
+               low);
+        break;
+      case Type::Pooling: {
+        const auto &attr = static_cast<PoolingNode &>(*node).poolingAttr;
+        assign(attr.getY(), dataTypeOf(attr.getX()));
+        break;
+      }
+      default:
+        break;
+      }
+      if (type != DataType::NotSet) {
+        ins.clear();
+        outs.clear();
+        node->collectTensors(ins, outs);
+        for (const auto &t : ins)
+          castOperand(*node, t, type);
+        for (const auto &t : outs)
+          assign(t, type);
+      }
+      nodes.push_back(node);
+    }
+    subNodes_ = std::move(nodes);
+    return ok();
+  }
+
+  // Constant folding pass run by `validate()`.
+  //
+  // Nodes that can be evaluated on the host (see `INode::foldConstants()`)
+  // turn their outputs into scalar constants, which are then emitted like any
+  // other scalar graph input. Nodes are visited in topological order, so whole
+  // scalar-only subgraphs (e.g. scale and epsilon arithmetic) fold into a
+  // single constant. Scalar inputs only consumed by folded nodes are dropped.
+  void foldConstants() {
+    std::unordered_set<std::shared_ptr<TensorAttr>> foldedInputs;
+    std::vector<std::shared_ptr<INode>> kept;
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    for (const auto &node : subNodes_) {
+      if (!node->foldConstants()) {
+        kept.push_back(node);
+        continue;
+      }
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      foldedInputs.insert(ins.begin(), ins.end());
+      for (const auto &t : outs) {
+        eraseGraphOutput(t);
+        fullGraphInputs_.insert(t);
+        fullGraphInputsSorted_.insert(t);
+      }
+    }
+    subNodes_ = std::move(kept);
+
+    for (const auto &node : subNodes_) {
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      for (const auto &t : ins)
+        foldedInputs.erase(t);
+    }
+    for (const auto &t : foldedInputs) {
+      fullGraphInputs_.erase(t);
+      fullGraphInputsSorted_.erase(t);
+    }
+  }
+
+  // Common subexpression elimination pass run by `validate()`.
+  //
+  // A node with the same type, attributes and input tensors as an earlier node
+  // computes the same values, so consumers of its outputs are rewired to the
+  // outputs of the earlier node and it is dropped. Nodes with graph outputs
+  // are kept (their outputs must be written), as are custom ops, whose MLIR is
+  // opaque to the graph. A merge that would feed the same tensor to several
+  // operands of a consumer is skipped too, as the ASM emitters name operands
+  // after their tensor.
+  void eliminateCommonSubexpressions() {
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::vector<INode *>>
+        consumers;
+    for (const auto &node : subNodes_) {
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      for (const auto &t : ins)
+        consumers[t].push_back(node.get());
+    }
+
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<TensorAttr>>
+        replacements;
+    auto resolve = [&](const std::shared_ptr<TensorAttr> &t) {
+      auto it = replacements.find(t);
+      return it == replacements.end() ? t : it->second;
+    };
+    // Whether replacing `dupOuts` by `canonicalOuts` makes a consumer of
+    // `dupOuts` take the same tensor twice.
+    auto aliasesOperands =
+        [&](const std::vector<std::shared_ptr<TensorAttr>> &dupOuts,
+            const std::vector<std::shared_ptr<TensorAttr>> &canonicalOuts) {
+          std::vector<std::shared_ptr<TensorAttr>> consumerIns, consumerOuts;
+          for (const auto &t : dupOuts) {
+            for (INode *consumer : consumers[t]) {
+              consumerIns.clear();
+              consumerOuts.clear();
+              consumer->collectTensors(consumerIns, consumerOuts);
+              std::unordered_set<std::shared_ptr<TensorAttr>> resolved;
+              for (const auto &in : consumerIns) {
+                std::shared_ptr<TensorAttr> r = resolve(in);
+                for (size_t i = 0; i < dupOuts.size(); ++i)
+                  if (r == dupOuts[i])
+                    r = canonicalOuts[i];
+                if (!resolved.insert(r).second)
+                  return true;
+              }
+            }
+          }
+          return false;
+        };
+
+    std::unordered_map<std::string, std::shared_ptr<INode>> seen;
+    std::vector<std::shared_ptr<INode>> kept;
+    for (const auto &node : subNodes_) {
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      for (const auto &t : ins)
+        if (std::shared_ptr<TensorAttr> r = resolve(t); r != t)
+          node->replaceInput(t, r);
+      if (node->getType() == Type::Custom) {
+        kept.push_back(node);
+        continue;
+      }
+
+      // Nodes are keyed by their structural fingerprint (type, attributes and
+      // tensor properties) and the identity of their input tensors.
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      Fingerprinter fp;
+      node->hashSubtree(fp);
+      std::ostringstream key;
+      key << fp.hexDigest();
+      for (const auto &t : ins)
+        key << ":" << t.get();
+
+      auto [it, inserted] = seen.try_emplace(key.str(), node);
+      if (inserted || !std::ranges::all_of( // C++20
+                          outs, [](const auto &t) { return t->isVirtual(); })) {
+        kept.push_back(node);
+        continue;
+      }
+      std::vector<std::shared_ptr<TensorAttr>> canonicalIns, canonicalOuts;
+      it->second->collectTensors(canonicalIns, canonicalOuts);
+      if (aliasesOperands(outs, canonicalOuts)) {
+        kept.push_back(node);
+        continue;
+      }
+
+      FUSILLI_LOG_LABEL_ENDL("INFO: Eliminating node '"
+                             << node->getName() << "', a duplicate of '"
+                             << it->second->getName() << "'");
+      for (size_t i = 0; i < outs.size(); ++i) {
+        replacements[outs[i]] = canonicalOuts[i];
+        eraseGraphOutput(outs[i]);
+      }
+    }
+    subNodes_ = std::move(kept);
+  }
+
+  // Dead node elimination pass run by `validate()`.
+  //
+  // A node whose outputs are all virtual and consumed by no other node does
+  // not contribute to the graph outputs: it is dropped along with its outputs.
+  // Nodes are visited in reverse topological order, so chains of nodes only
+  // feeding dead nodes are dropped as well.
+  void eliminateDeadNodes() {
+    std::unordered_set<std::shared_ptr<TensorAttr>> consumed;
+    std::vector<std::shared_ptr<INode>> kept;
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    for (auto it = subNodes_.rbegin(); it != subNodes_.rend(); ++it) {
+      ins.clear();
+      outs.clear();
+      (*it)->collectTensors(ins, outs);
+      bool isDead = std::ranges::all_of( // C++20
+          outs, [&](const auto &t) {
+            return t->isVirtual() && !consumed.contains(t);
+          });
+      if (isDead) {
+        FUSILLI_LOG_LABEL_ENDL("INFO: Eliminating dead node '"
+                               << (*it)->getName() << "'");
+        for (const auto &t : outs)
+          eraseGraphOutput(t);
+        continue;
+      }
+      consumed.insert(ins.begin(), ins.end());
+      kept.push_back(*it);
+    }
+    std::reverse(kept.begin(), kept.end());
+    subNodes_ = std::move(kept);
+  }
+
+  // Conv + BatchNorm folding pass run by `validate()`.
+  //
+  // An inference batch normalization is a per channel affine transform, so
+  // when it is the only consumer of the (virtual) output of a convolution
+  // whose filter and statistics are embedded in the graph (see
+  // `TensorAttr::setConstantData()`), it is folded on the host into a new
+  // constant filter and bias of the convolution (see
+  // `ConvFPropNode::foldBatchNorm()`), which then produces its output. The
+  // normalization and its intermediate tensor disappear from the graph, and
+  // the inputs only they read (the former filter, statistics, epsilon and
+  // momentum) are dropped. Other batch normalizations are left unfolded.
+  void foldConvBatchNorms() {
+    std::unordered_map<std::shared_ptr<TensorAttr>, ConvFPropNode *> producers;
+    std::unordered_map<std::shared_ptr<TensorAttr>, size_t> useCounts;
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    for (const auto &node : subNodes_) {
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      for (const auto &t : ins)
+        ++useCounts[t];
+      if (node->getType() == Type::Convolution) {
+        auto *conv = static_cast<ConvFPropNode *>(node.get());
+        producers[conv->convFPropAttr.getY()] = conv;
+      }
+    }
+
+    std::vector<std::shared_ptr<INode>> kept;
+    for (const auto &node : subNodes_) {
+      if (node->getType() != Type::BatchNorm) {
+        kept.push_back(node);
+        continue;
+      }
+      const BatchnormAttr &bn =
+          static_cast<const BatchNormNode *>(node.get())->batchnormAttr;
+      std::shared_ptr<TensorAttr> xT = bn.getX();
+      auto it = producers.find(xT);
+      ConvFPropNode *conv = it == producers.end() ? nullptr : it->second;
+      // The filter read by the convolution before folding.
+      std::shared_ptr<TensorAttr> wT =
+          conv ? conv->convFPropAttr.getW() : nullptr;
+      if (!conv || !xT->isVirtual() || useCounts[xT] != 1 ||
+          !conv->foldBatchNorm(bn)) {
+        kept.push_back(node);
+        continue;
+      }
+      eraseGraphOutput(xT);
+      for (const auto &t :
+           {conv->convFPropAttr.getW(), conv->getFoldedBias()}) {
+        fullGraphInputs_.insert(t);
+        fullGraphInputsSorted_.insert(t);
+      }
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      ins.push_back(wT);
+      for (const auto &t : ins) {
+        if (t == xT || --useCounts[t] != 0)
+          continue;
+        fullGraphInputs_.erase(t);
+        fullGraphInputsSorted_.erase(t);
+      }
+    }
+    subNodes_ = std::move(kept);
+  }
+
+  // Horizontal matmul fusion pass run by `validate()`.
+  //
+  // Matmuls reading the same A with weights B embedded in the graph (see
+  // `TensorAttr::setConstantData()` and `TensorAttr::setParameter()`), such
+  // as the Q, K and V projections of attention or the gate and up
+  // projections of an MLP, are merged into one matmul over the weights
+  // concatenated along N, whose output is sliced back into the outputs of
+  // the merged matmuls. A is then read once, by one larger kernel. As the
+  // weights are constant, the compiler concatenates them once rather than on
+  // every execution; weights bound through the variant pack are left alone.
+  // Only plain matmuls (without epilogue, quantization, sparsity, grouping,
+  // gating, split-K or lowering config) whose weights agree on their data
+  // type and their dims outside of N, and whose outputs agree on their data
+  // type, are merged. The merged nodes take the place of the first matmul.
+  ErrorObject fuseHorizontalMatmuls() {
+    auto isFusible = [&](const INode &node) {
+      if (node.getType() != Type::Matmul)
+        return false;
+      const MatmulAttr &attr = static_cast<const MatmulNode &>(node).matmulAttr;
+      std::shared_ptr<TensorAttr> bT = attr.getB();
+      return !attr.hasEpilogue() && !attr.hasScales() && !attr.isGrouped() &&
+             !attr.isSparse() && !attr.isGroupQuantized() &&
+             !attr.hasBiasGradient() && !attr.isGated() && !attr.isSplitK() &&
+             !attr.hasLoweringConfig() && fullGraphInputs_.contains(bT) &&
+             (bT->hasConstantData() || bT->isParameter()) &&
+             !attr.getC()->isInPlace();
+    };
+    auto matmulAttrAt = [&](size_t index) -> MatmulAttr & {
+      return static_cast<MatmulNode &>(*subNodes_[index]).matmulAttr;
+    };
+
+    // Groups of fusible matmuls (indices into `subNodes_`), in order of their
+    // first member.
+    std::vector<std::vector<size_t>> groups;
+    std::unordered_map<std::string, size_t> groupOfKey;
+    for (size_t i = 0; i < subNodes_.size(); ++i) {
+      if (!isFusible(*subNodes_[i]))
+        continue;
+      const MatmulAttr &attr = matmulAttrAt(i);
+      std::shared_ptr<TensorAttr> bT = attr.getB();
+      std::ostringstream key;
+      key << attr.getA().get() << ':'
+          << static_cast<int>(bT->getDataType()) << ':'
+          << static_cast<int>(attr.getC()->getDataType());
+      const std::vector<int64_t> &bDim = bT->getDim();
+      for (size_t d = 0; d + 1 < bDim.size(); ++d)
+        key << ':' << bDim[d];
+      auto [it, inserted] = groupOfKey.try_emplace(key.str(), groups.size());
+      if (inserted)
+        groups.emplace_back();
+      groups[it->second].push_back(i);
+    }
+
+    // Nodes replacing the first matmul of each fused group, by its index.
+    std::unordered_map<size_t, std::vector<std::shared_ptr<INode>>> fused;
+    std::unordered_set<size_t> removed;
+    for (const std::vector<size_t> &group : groups) {
+      if (group.size() < 2)
+        continue;
+      const MatmulAttr &first = matmulAttrAt(group.front());
+      std::string name = first.getName() + "_hfused";
+      FUSILLI_LOG_LABEL_ENDL("INFO: Fusing " << group.size()
+                                             << " matmuls of '"
+                                             << first.getA()->getName()
+                                             << "' into '" << name << "'");
+
+      std::vector<std::shared_ptr<TensorAttr>> bs;
+      for (size_t i : group)
+        bs.push_back(matmulAttrAt(i).getB());
+      std::shared_ptr<TensorAttr> bT = outputTensor(name + "_B");
+      auto concatAttr = ConcatAttr().setAxis(-1).setName(name + "_concat");
+      concatAttr.setX(bs).setY(bT);
+
+      std::shared_ptr<TensorAttr> cT = outputTensor(name + "_C");
+      cT->setDataType(first.getC()->getDataType());
+      auto matmulAttr = MatmulAttr().setName(name);
+      matmulAttr.setA(first.getA()).setB(bT).setC(cT);
+
+      std::vector<std::shared_ptr<INode>> &nodes = fused[group.front()];
+      nodes.push_back(makeShared<ConcatNode>(std::move(concatAttr), context));
+      nodes.push_back(makeShared<MatmulNode>(std::move(matmulAttr), context));
+      int64_t offset = 0;
+      for (size_t i : group) {
+        const MatmulAttr &attr = matmulAttrAt(i);
+        std::shared_ptr<TensorAttr> yT = attr.getC();
+        std::vector<int64_t> end = yT->getDim();
+        std::vector<int64_t> start(end.size(), 0);
+        start.back() = offset;
+        end.back() += offset;
+        offset = end.back();
+        auto sliceAttr = SliceAttr()
+                             .setStart(start)
+                             .setEnd(end)
+                             .setName(attr.getName() + "_hslice");
+        sliceAttr.setX(cT).setY(yT);
+        nodes.push_back(makeShared<SliceNode>(std::move(sliceAttr), context));
+        if (i != group.front())
+          removed.insert(i);
+      }
+    }
+    if (fused.empty())
+      return ok();
+
+    // The new intermediates are inferred by the nodes validated below.
+    recordInferredProperties();
+    std::vector<std::shared_ptr<INode>> kept;
+    for (size_t i = 0; i < subNodes_.size(); ++i) {
+      if (auto it = fused.find(i); it != fused.end()) {
+        for (const auto &node : it->second) {
+          FUSILLI_CHECK_ERROR(node->validateSubtree());
+          kept.push_back(node);
+        }
+      } else if (!removed.contains(i)) {
+        kept.push_back(subNodes_[i]);
+      }
+    }
+    subNodes_ = std::move(kept);
+    return ok();
+  }
+
+  // Records, for every operation output not seen before, which of its
+  // properties are left to inference (see `markDirty()`).
+  void recordInferredProperties() {
+    for (const auto &t : fullGraphOutputs_)
+      inferredProperties_.try_emplace(
+          t, InferredProperties{
+                 .dim = t->getDim().empty() && !t->hasDynamicDims(),
+                 .stride = t->getStride().empty(),
+                 .dataType = t->getDataType() == DataType::NotSet,
+             });
+  }
+
+  // Clears the inferred properties of `t`, for its producer to infer them
+  // again.
+  void resetInferredProperties(const std::shared_ptr<TensorAttr> &t) {
+    auto it = inferredProperties_.find(t);
+    if (it == inferredProperties_.end())
+      return;
+    if (it->second.dim)
+      t->setDim(std::vector<int64_t>{}).clearDynamicDims();
+    if (it->second.stride)
+      t->setStride(std::vector<int64_t>{});
+    if (it->second.dataType)
+      t->setDataType(DataType::NotSet);
+  }
+
+  // Incremental variant of `validate()` after `markDirty()`.
+  //
+  // Nodes are visited in topological order: a node with a dirty input has
+  // the inferred properties of its outputs cleared, is validated again and
+  // its outputs become dirty in turn. Only dirty tensors are checked again.
+  // The graph-level passes that drop or merge nodes are not run again (edits
+  // to properties keep their results valid), the cheap ones that only tag
+  // tensors and nodes for emission are, and so is the fingerprint. On error
+  // the edited tensors stay dirty, so the edit can be fixed and retried.
+  ErrorObject revalidate() {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Revalidating Graph incrementally");
+    std::unordered_set<std::shared_ptr<TensorAttr>> dirty(
+        dirtyTensors_.begin(), dirtyTensors_.end());
+
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    for (const auto &node : subNodes_) {
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      if (std::ranges::none_of(ins, [&](const auto &t) { // C++20
+            return dirty.contains(t);
+          }))
+        continue;
+      for (const auto &t : outs) {
+        resetInferredProperties(t);
+        dirty.insert(t);
+      }
+      FUSILLI_CHECK_ERROR(node->validateSubtree());
+    }
+
+    for (const auto &input : fullGraphInputs_) {
+      if (dirty.contains(input))
+        FUSILLI_CHECK_ERROR(validateInput(input));
+    }
+    for (const auto &output : fullGraphOutputs_) {
+      const std::shared_ptr<TensorAttr> &donor = output->getInPlace();
+      if (!dirty.contains(output) && !(donor && dirty.contains(donor)))
+        continue;
+      // The donor is recorded again by `validateInPlace()`.
+      if (donor)
+        inPlaceDonors_.erase(donor);
+      FUSILLI_CHECK_ERROR(validateOutput(output));
+    }
+
+    optimizeLayouts();
+    shareCustomOpFunctions();
+    fingerprint_ = computeFingerprint();
+    eventTag_ = computeEventTag();
+    FUSILLI_LOG_LABEL_ENDL("INFO: Graph revalidation completed successfully");
+    dirtyTensors_.clear();
+    isValidated_ = true;
+    return ok();
+  }
+
+  // Checks the properties of the operation output `output`, once inferred.
+  // Validates the graph input `input`, and that its constant data (see
+  // `TensorAttr::setConstantData()`), if any, holds exactly its elements in
+  // a data type the emitted tensor literal can hold byte by byte.
+  ErrorObject validateInput(const std::shared_ptr<TensorAttr> &input) const {
+    FUSILLI_CHECK_ERROR(input->validate());
+    if (!input->hasConstantData())
+      return ok();
+    DataType type = input->getDataType();
+    FUSILLI_RETURN_ERROR_IF(type == DataType::Int4 ||
+                                type == DataType::Boolean,
+                            ErrorCode::NotImplemented,
+                            "Constant data of tensor '" + input->getName() +
+                                "' is not supported for sub-byte and "
+                                "boolean data types");
+    FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                             getIreeHalElementType(type));
+    size_t expectedBytes = static_cast<size_t>(input->getVolume()) *
+                           iree_hal_element_dense_byte_count(elementType);
+    size_t actualBytes = input->getConstantData()->size();
+    FUSILLI_RETURN_ERROR_IF(actualBytes != expectedBytes,
+                            ErrorCode::InvalidAttribute,
+                            "Constant data of tensor '" + input->getName() +
+                                "' has " + std::to_string(actualBytes) +
+                                " bytes, expected " +
+                                std::to_string(expectedBytes));
+    return ok();
+  }
+
+  ErrorObject validateOutput(const std::shared_ptr<TensorAttr> &output) {
+    FUSILLI_CHECK_ERROR(output->validate());
+    // TODO(fusilli#276): Support broadcast strides on operation outputs.
+    // This requires logical→physical broadcast conversion in the ASM
+    // emitter. For now, reject broadcast on any operation output.
+    FUSILLI_RETURN_ERROR_IF(
+        output->hasBroadcastDims(), ErrorCode::InvalidAttribute,
+        "Tensor '" + output->getName() +
+            "' has broadcast strides (stride=0) on an operation output, "
+            "which is not yet supported");
+    return validateInPlace(output);
+  }
+
+  // Checks the in-place declaration of `output`, if any (see
+  // `TensorAttr::setInPlace()`): the donor has to be a graph input bound
+  // through the variant pack, with the buffer layout of `output`, and donated
+  // to no other output. Donors are recorded in `inPlaceDonors_`, which
+  // detects repeated donations in a single pass over the outputs.
+  ErrorObject validateInPlace(const std::shared_ptr<TensorAttr> &output) {
+    const std::shared_ptr<TensorAttr> &donor = output->getInPlace();
+    if (!donor)
+      return ok();
+
+    FUSILLI_RETURN_ERROR_IF(output->isVirtual(), ErrorCode::InvalidAttribute,
+                            "In-place tensor '" + output->getName() +
+                                "' is not a graph output");
+    FUSILLI_RETURN_ERROR_IF(!fullGraphInputs_.contains(donor) ||
+                                donor->isScalar(),
+                            ErrorCode::InvalidAttribute,
+                            "In-place tensor '" + output->getName() +
+                                "' is written into '" + donor->getName() +
+                                "', which is not a non-scalar graph input");
+    FUSILLI_RETURN_ERROR_IF(donor->isConstant(), ErrorCode::InvalidAttribute,
+                            "In-place tensor '" + output->getName() +
+                                "' is written into constant tensor '" +
+                                donor->getName() + "'");
+    // Shape buckets specialize the dynamic dims of bound tensors only.
+    FUSILLI_RETURN_ERROR_IF(output->hasDynamicDims() ||
+                                donor->hasDynamicDims(),
+                            ErrorCode::NotImplemented,
+                            "In-place tensor '" + output->getName() +
+                                "' with dynamic dims is not supported");
+    FUSILLI_RETURN_ERROR_IF(output->hasPaddedStrides(),
+                            ErrorCode::NotImplemented,
+                            "In-place tensor '" + output->getName() +
+                                "' with padded strides is not supported");
+    FUSILLI_RETURN_ERROR_IF(
+        donor->getDim() != output->getDim() ||
+            donor->getStride() != output->getStride() ||
+            donor->getDataType() != output->getDataType(),
+        ErrorCode::InvalidAttribute,
+        "In-place tensor '" + output->getName() +
+            "' must have the dims, stride and data type of '" +
+            donor->getName() + "'");
+    FUSILLI_RETURN_ERROR_IF(
+        donor->getBlockedLayout() != output->getBlockedLayout(),
+        ErrorCode::InvalidAttribute,
+        "In-place tensor '" + output->getName() +
+            "' must have the blocked layout of '" + donor->getName() + "'");
+    FUSILLI_RETURN_ERROR_IF(
+        !inPlaceDonors_.insert(donor).second, ErrorCode::InvalidAttribute,
+        "Tensor '" + donor->getName() +
+            "' is written into by more than one in-place output");
+    return ok();
+  }
+
+  // Whether the graph input `input` is overwritten by an in-place output (see
+  // `TensorAttr::setInPlace()`).
+  bool isInPlaceDonor(const std::shared_ptr<TensorAttr> &input) const {
+    return inPlaceDonors_.contains(input); // C++20
+  }
+
+  // Removes an (intermediate) tensor of an eliminated node from the graph.
+  void eraseGraphOutput(const std::shared_ptr<TensorAttr> &tensor) {
+    fullGraphOutputs_.erase(tensor);
+    fullGraphOutputsSorted_.erase(tensor);
+    inferredProperties_.erase(tensor);
+  }
+
+  // Layout optimization pass run by `validate()`.
+  //
+  // Every node permutes its operands from their physical layout to logical
+  // dim order and its results back, so a virtual tensor with, say, NHWC
+  // strides between two nodes costs a permute into NHWC and another one out
+  // of it, which IREE has to cancel. A virtual tensor only produced and
+  // consumed by layout agnostic nodes (see `INode::isLayoutAgnostic()`)
+  // never materializes, so it is kept in logical dim order instead: the
+  // logical layout propagates across those nodes and permutes are only
+  // emitted where tensors enter or leave such a region.
+  void optimizeLayouts() {
+    std::unordered_set<std::shared_ptr<TensorAttr>> candidates;
+    for (const auto &t : fullGraphOutputs_)
+      if (t->isVirtual() && !t->isScalar())
+        candidates.insert(t);
+
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    for (const auto &node : subNodes_) {
+      if (node->isLayoutAgnostic())
+        continue;
+      ins.clear();
+      outs.clear();
+      node->collectTensors(ins, outs);
+      for (const auto &t : ins)
+        candidates.erase(t);
+      for (const auto &t : outs)
+        candidates.erase(t);
+    }
+
+    for (const auto &t : fullGraphOutputs_)
+      t->setIsLogicalLayout(candidates.contains(t)); // C++20
+  }
+
+  // Custom op pass run by `validate()`.
+  //
+  // Custom ops instantiating the same MLIR template with the same types (see
+  // `CustomOpNode::getInstantiationKey()`) call the function emitted by the
+  // first of them instead of each emitting an identical copy under its own
+  // name.
+  void shareCustomOpFunctions() {
+    std::unordered_map<std::string, std::string> callees;
+    for (const auto &node : subNodes_) {
+      if (node->getType() != Type::Custom)
+        continue;
+      auto &customOp = static_cast<CustomOpNode &>(*node);
+      customOp.setSharedCallee("");
+      std::string key = customOp.getInstantiationKey();
+      if (key.empty())
+        continue;
+      auto [it, inserted] = callees.try_emplace(key, customOp.getName());
+      if (!inserted)
+        customOp.setSharedCallee(it->second);
+    }
+  }
+
+  // Checks that the graph is ready to execute, see `execute()`.
+  ErrorObject checkExecutable() const;
+
+  // Compiles a graph set up by `compileLazy()` on its first use, once: the
+  // first caller compiles while concurrent ones wait, and all of them get
+  // its status. Const as executions are.
+  ErrorObject compileOnFirstUse() const {
+    LazyCompile *lazy = lazyCompile_.get();
+    if (!lazy)
+      return ok();
+    if (lazy->done.load(std::memory_order_acquire))
+      return lazy->status;
+    std::lock_guard<std::mutex> lock(lazy->mutex);
+    if (lazy->done.load(std::memory_order_relaxed))
+      return lazy->status;
+    FUSILLI_LOG_LABEL_ENDL("INFO: Compiling lazily compiled Graph on first "
+                           "use");
+    if (lazy->prefetch.valid()) {
+      // A failed prefetch fails `compile()` again, which reports it.
+      ErrorObject prefetched = lazy->prefetch.get();
+      if (isError(prefetched))
+        FUSILLI_LOG_LABEL_ENDL("WARNING: Prefetch failed: " << prefetched);
+    }
+    lazy->compiling = true;
+    ErrorObject status = lazy->compile();
+    lazy->compiling = false;
+    lazy->status = status;
+    lazy->done.store(true, std::memory_order_release);
+    return status;
+  }
+
+  // Returns the workspace size in bytes the execution on `buffers` (indexed
+  // by UID) requires: the size queried by `getWorkspaceSize()`, or for a
+  // data-dependent size, the result of the module's transient size function
+  // invoked in `context` with the bound buffers.
+  ErrorOr<size_t>
+  getRequiredWorkspaceSize(iree_vm_context_t *context,
+                           std::span<Buffer *const> buffers) const;
+
+  // Returns `workspace`, or a workspace of at least `requiredSize` bytes
+  // borrowed from the arena of `queueHandle` for the execution (see
+  // `Handle::acquireWorkspace()`) when the graph needs a workspace but none
+  // is provided.
+  ErrorOr<Handle::WorkspaceLease>
+  resolveWorkspace(const Handle &queueHandle,
+                   const std::shared_ptr<Buffer> &workspace,
+                   size_t requiredSize) const;
+
+  // Pushes the arguments of the compiled function to `list`: `buffers`
+  // indexed by UID, the workspace of at least `requiredSize` bytes and, for
+  // asynchronous execution, the fences. Null fences are replaced by the
+  // already signaled dummies.
+  ErrorObject pushArguments(iree_vm_list_t *list,
+                            std::span<Buffer *const> buffers,
+                            const Buffer *workspace, size_t requiredSize,
+                            iree_hal_fence_t *waitFence = nullptr,
+                            iree_hal_fence_t *signalFence = nullptr) const;
+
+  // Checks that `buffers` (indexed by UID) start at addresses aligned to the
+  // alignments their tensors declare, see `TensorAttr::setAlignment()`.
+  // Definition in `fusilli/backend/runtime.h`.
+  ErrorObject checkBufferAlignments(const Handle &handle,
+                                    std::span<Buffer *const> buffers) const;
+
+  // Looks up the buffers of `variantPack` in UID order, validating them
+  // against the graph.
+  ErrorOr<std::vector<Buffer *>>
+  getBoundBuffers(const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                           std::shared_ptr<Buffer>>
+                      &variantPack) const;
+
+  // Builds the VM input list of the compiled function for `buffers` (indexed
+  // by UID) and `workspace`, see `pushArguments()`.
+  ErrorOr<IreeVmListUniquePtrType>
+  buildInputList(std::span<Buffer *const> buffers,
+                 const std::shared_ptr<Buffer> &workspace, size_t requiredSize,
+                 iree_hal_fence_t *waitFence = nullptr,
+                 iree_hal_fence_t *signalFence = nullptr) const;
+
   // MLIR assembly emitter helper methods.
   std::string emitNodePreAsm() const override final;
   std::string emitNodePostAsm() const override final;
+  std::string emitModuleScopeAsm() const override final;
+  std::vector<std::string> getParameterGlobalsAsm() const;
+  std::string getFunctionPreAsm(const std::string &entryPoint) const;
+  std::string getFunctionPostAsm() const;
   std::string getOperandNamesAndTypesAsm() const;
   std::string getResultNamesAndTypesAsm() const;
 
+  // Allocates the nodes and tensors of the graph, see `setArenaSize()`.
+  template <typename T, typename... Args>
+  std::shared_ptr<T> makeShared(Args &&...args) const {
+    if (arena_)
+      return arena_->makeShared<T>(std::forward<Args>(args)...);
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+
+  // Leading fields of the `serialize()` format. Bump the version whenever the
+  // format of any archived type changes.
+  static constexpr uint32_t kSerializationMagic = 0x46534752; // "FSGR"
+  static constexpr uint32_t kSerializationVersion = 7;
+
+  // Reads or writes the graph `self` from or to `ar`, see `serialize()`.
+  // Writing only reads the graph, so `serialize()` passes it const, which
+  // compiles out the branches restoring it.
+  template <typename Self> static void archiveGraph(Self &self, Archive &ar) {
+    constexpr bool kRestorable = !std::is_const_v<Self>;
+    uint32_t magic = kSerializationMagic;
+    uint32_t version = kSerializationVersion;
+    ar.io(magic).io(version);
+    if (magic != kSerializationMagic || version != kSerializationVersion) {
+      ar.fail(ErrorCode::InvalidArgument,
+              "Not a serialized graph, or serialized by an unsupported "
+              "version of Fusilli");
+      return;
+    }
+
+    std::string name = self.context.getName();
+    DataType ioDataType = self.context.getIODataType();
+    DataType intermediateDataType = self.context.getIntermediateDataType();
+    DataType computeDataType = self.context.getComputeDataType();
+    ar.io(name).io(ioDataType).io(intermediateDataType).io(computeDataType);
+    if constexpr (kRestorable)
+      if (ar.isReading())
+        self.context.setName(name)
+            .setIODataType(ioDataType)
+            .setIntermediateDataType(intermediateDataType)
+            .setComputeDataType(computeDataType);
+
+    // Graph inputs and outputs go in name order so that the bytes of a graph
+    // are reproducible.
+    auto archiveTensors = [&](auto &set) {
+      std::vector<std::shared_ptr<TensorAttr>> tensors(set.begin(), set.end());
+      std::sort(tensors.begin(), tensors.end(), TensorAttrSortByName());
+      ar.io(tensors);
+      if constexpr (kRestorable) {
+        if (!ar.isReading())
+          return;
+        if (std::ranges::any_of(tensors, [](const auto &t) { return !t; }))
+          ar.fail(ErrorCode::InvalidArgument,
+                  "Serialized graph has a null input or output");
+        set = {tensors.begin(), tensors.end()};
+      }
+    };
+    archiveTensors(self.fullGraphInputs_);
+    archiveTensors(self.fullGraphOutputs_);
+
+    size_t numNodes = self.subNodes_.size();
+    ar.io(numNodes);
+    if constexpr (kRestorable)
+      if (ar.isReading())
+        self.subNodes_.clear();
+    for (size_t i = 0; i < numNodes && ar.status().isOk(); ++i) {
+      std::shared_ptr<INode> node =
+          ar.isReading() ? nullptr : self.subNodes_[i];
+      Type type = node ? node->getType() : Type::Composite;
+      ar.io(type);
+      if constexpr (kRestorable) {
+        if (ar.isReading()) {
+          node = self.makeNode(type);
+          if (!node) {
+            ar.fail(ErrorCode::InvalidArgument,
+                    "Serialized graph has a node of unknown type " +
+                        std::to_string(static_cast<int>(type)));
+            return;
+          }
+          self.subNodes_.push_back(node);
+        }
+      }
+      node->archiveNode(ar);
+    }
+  }
+
+  // Returns a node of `type` with default attributes to deserialize into, or
+  // nullptr for types that can't be serialized.
+  std::shared_ptr<INode> makeNode(Type type) const {
+    switch (type) {
+    case Type::Convolution:
+      return makeShared<ConvFPropNode>(ConvFPropAttr(), context);
+    case Type::Pointwise:
+      return makeShared<PointwiseNode>(PointwiseAttr(), context);
+    case Type::WGrad:
+      return makeShared<ConvWGradNode>(ConvWGradAttr(), context);
+    case Type::DGrad:
+      return makeShared<ConvDGradNode>(ConvDGradAttr(), context);
+    case Type::LayerNorm:
+      return makeShared<LayerNormNode>(LayernormAttr(), context);
+    case Type::BatchNorm:
+      return makeShared<BatchNormNode>(BatchnormAttr(), context);
+    case Type::RmsNorm:
+      return makeShared<RmsNormNode>(RmsnormAttr(), context);
+    case Type::Matmul:
+      return makeShared<MatmulNode>(MatmulAttr(), context);
+    case Type::Reduction:
+      return makeShared<ReductionNode>(ReductionAttr(), context);
+    case Type::Custom:
+      return makeShared<CustomOpNode>(CustomOpAttr(), context);
+    case Type::Sdpa:
+      return makeShared<SdpaNode>(SdpaAttr(), context);
+    case Type::SdpaBwd:
+      return makeShared<SdpaBwdNode>(SdpaBwdAttr(), context);
+    case Type::Softmax:
+      return makeShared<SoftmaxNode>(SoftmaxAttr(), context);
+    case Type::Pooling:
+      return makeShared<PoolingNode>(PoolingAttr(), context);
+    case Type::Reshape:
+      return makeShared<ReshapeNode>(ReshapeAttr(), context);
+    case Type::Permute:
+      return makeShared<PermuteNode>(PermuteAttr(), context);
+    case Type::Slice:
+      return makeShared<SliceNode>(SliceAttr(), context);
+    case Type::Concat:
+      return makeShared<ConcatNode>(ConcatAttr(), context);
+    case Type::LayerNormBwd:
+      return makeShared<LayerNormBwdNode>(LayernormBwdAttr(), context);
+    case Type::RmsNormBwd:
+      return makeShared<RmsNormBwdNode>(RmsnormBwdAttr(), context);
+    case Type::BatchNormBwd:
+      return makeShared<BatchNormBwdNode>(BatchnormBwdAttr(), context);
+    case Type::SliceUpdate:
+      return makeShared<SliceUpdateNode>(SliceUpdateAttr(), context);
+    case Type::IndexSelect:
+      return makeShared<IndexSelectNode>(IndexSelectAttr(), context);
+    case Type::IndexAdd:
+      return makeShared<IndexAddNode>(IndexAddAttr(), context);
+    case Type::Collective:
+      return makeShared<CollectiveNode>(CollectiveAttr(), context);
+    case Type::ConvTranspose:
+      return makeShared<ConvTransposeNode>(ConvTransposeAttr(), context);
+    case Type::Optimizer:
+      return makeShared<OptimizerNode>(OptimizerAttr(), context);
+    case Type::Composite:
+      break;
+    }
+    return nullptr;
+  }
+
+  // Rough upper bound of the emitted MLIR assembly size, used to reserve the
+  // output buffer once instead of growing it node by node. Most nodes emit
+  // well under `kAsmBytesPerNode` bytes, including layout conversions.
+  static constexpr size_t kAsmBytesPerNode = 2048;
+  size_t getAsmSizeEstimate() const {
+    return kAsmBytesPerNode *
+           (getSubtreeNodeCount() + fullGraphInputsSorted_.size() +
+            fullGraphOutputsSorted_.size());
+  }
+
   // This is set after `validate()` is run at least once successfully.
   bool isValidated_ = false;
 
-  // Bytes backing the currently loaded VMFB artifact. IREE's bytecode module
-  // may retain references to this archive, so keep it alive for as long as the
-  // VM context is alive.
+  // See `setAutocast()`.
+  bool autocast_ = false;
+
+  // Bytes backing the currently loaded VMFB artifact, and the object keeping
+  // them alive (an owned buffer, a caller-provided buffer or a memory-mapped
+  // file). IREE's bytecode module may retain references to this archive, so
+  // keep it alive for as long as the VM context is alive.
   //
-  // Keep this declared before vmContext_: members destruct in reverse
+  // Keep these declared before vmContext_: members destruct in reverse
   // declaration order, and the context must be released before the backing VMFB
   // bytes.
-  std::vector<uint8_t> loadedArtifactBytes_;
+  std::shared_ptr<const void> loadedArtifactOwner_;
+  std::span<const uint8_t> loadedArtifactBytes_;
+
+  // VM instance and modules of the loaded artifact, shared by all VM contexts
+  // of the graph (per-invocation module state lives in the contexts).
+  IreeVmInstanceSharedPtrType vmInstance_;
+  IreeVmModuleUniquePtrType halModule_;
+  // Serves the external parameters of the graph (see
+  // `TensorAttr::setParameter()`), null for graphs loaded on a handle without
+  // parameter archives.
+  IreeVmModuleUniquePtrType parametersModule_;
+  IreeVmModuleUniquePtrType bytecodeModule_;
 
   // IREE VM context lifetime managed by the `Graph` object
   // (deleted when the `Graph` object goes out of scope).
   IreeVmContextUniquePtrType vmContext_;
 
+  // Additional VM contexts for concurrent execution, see `VmContextPool`.
+  // Shared with the graphs loaded from the same module (see
+  // `loadFromModule()`), as they invoke functions of the same contexts.
+  std::shared_ptr<VmContextPool> vmContextPool_;
+
+  // Function of the loaded module executed by the graph: `@main`, or the
+  // function of the graph in a multi-function module (see `compileModule()`).
+  std::string entryPoint_ = "main";
+
   // Memoized function handle resolved during createVmContext().
   // Avoids repeated function lookup on every execute() call.
   std::optional<iree_vm_function_t> vmFunction_;
@@ -720,10 +4119,46 @@ private:
   // currently loaded runtime state.
   std::optional<size_t> workspaceSize_;
 
+  // Accounting of the loaded artifact and of the workspace size of this graph
+  // (excluding its specializations, accounted by their own graphs) in the
+  // handle it was loaded on, see `Handle::getMemoryStats()`.
+  detail::TrackedMemory moduleMemory_;
+  detail::TrackedMemory workspaceMemory_;
+
+  // Function computing the data-dependent workspace size from the bound
+  // buffers, resolved during createVmContext() when the module has one.
+  std::optional<iree_vm_function_t> transientSizeFunction_;
+
+  // Set by `setShapeBuckets()`, and the specializations compiled for them by
+  // `compile()` (runtime state, like the loaded dynamic artifact).
+  std::vector<ShapeBucket> shapeBuckets_;
+  std::vector<Specialization> specializations_;
+
+  // Set by `setMaxWorkspaceSize()`, and whether `compile()` disabled split
+  // reductions to honor it.
+  std::optional<size_t> maxWorkspaceSize_;
+  bool splitReductionDisabledForWorkspace_ = false;
+
+  // Set by `setHotShapeThreshold()`, and the profile `compile()` creates for
+  // them (runtime state).
+  size_t hotShapeThreshold_ = 0;
+  size_t maxHotSpecializations_ = 0;
+  std::unique_ptr<HotShapeProfile> hotShapes_;
+
   // Pre-computed VM input list capacity for iree_vm_list_create().
   // Set during createVmContext() to avoid recomputing on every execute().
   iree_host_size_t vmInputListCapacity_ = 0;
 
+  // Already signaled fences passed to asynchronous functions, which rely on
+  // stream ordering rather than fences. Created once by createVmContext().
+  IreeHalFenceUniquePtrType dummyWaitFence_;
+  IreeHalFenceUniquePtrType dummySignalFence_;
+
+  // Bytes of stack storage the indexed `execute()` overload builds the VM
+  // input list in, falling back to the heap for functions with more
+  // arguments.
+  static constexpr size_t kInlineInputListStorageSize = 1024;
+
   // Backend for the currently loaded runtime state. `execute()` requires a
   // handle for this backend because VMFB artifacts are backend-specific.
   std::optional<Backend> loadedBackend_;
@@ -732,11 +4167,43 @@ private:
   // `loadFromArtifact()` API uses caller-provided VMFB bytes directly and does
   // not consult this cache.
   //
-  // Note: new instances should always re-generate cache even if the results
-  // could be read from the file system. Old results may have been generated
-  // with a different version of IREE, it would not be safe to use them.
+  // Note: new instances never trust per-graph cache files left on the file
+  // system by older instances; those may have been generated with a different
+  // version of IREE. Results from other instances are only reused through the
+  // kernel cache, whose key includes the compiler revision.
   std::optional<CachedAssets> cache_;
 
+  // Fingerprint cache key (see `getFingerprintCacheKey()`) that `cache_` was
+  // last looked up or compiled for by `compileToArtifact()`. Reset whenever
+  // `getCompiledArtifact()` replaces `cache_`.
+  std::optional<std::string> cacheFingerprintKey_;
+
+  // Report filled by the ongoing `compile()` or `compileToArtifact()` call,
+  // see `ReportScope`.
+  CompileReport *report_ = nullptr;
+
+  // See `getExecuteCount()`. Shared with the runtime graphs of the graph
+  // (see `makeRuntimeGraph()`) and the plans bound from it, and heap
+  // allocated so the graph stays movable.
+  std::shared_ptr<std::atomic<uint64_t>> executeCount_ =
+      std::make_shared<std::atomic<uint64_t>>(0);
+
+  // Structural fingerprint computed by `validate()`.
+  std::string fingerprint_;
+
+  // Identifies the graph in the event log, computed by `validate()` and
+  // shared with the runtime graphs of the graph.
+  EventTag eventTag_;
+
+  // Set by `setCompileInMemory()`.
+  bool compileInMemory_ = false;
+
+  // Set by `setArenaSize()`.
+  std::shared_ptr<Arena> arena_;
+
+  // Set by `setCompileOptions()`.
+  CompileOptions compileOptions_;
+
   // This is safe for post-insertion updates of TensorAttr (e.g. setting name
   // or other properties) since it uses the pointer value itself for hashing.
   std::unordered_set<std::shared_ptr<TensorAttr>> fullGraphInputs_;
@@ -749,6 +4216,85 @@ private:
       fullGraphInputsSorted_;
   std::set<std::shared_ptr<TensorAttr>, TensorAttrSortByName>
       fullGraphOutputsSorted_;
+
+  // Graph inputs and outputs bound at execution, indexed by their dense UID
+  // (see `getTensorUid()`). Populated along with the sorted sets above.
+  std::vector<std::shared_ptr<TensorAttr>> tensorsByUid_;
+
+  // Graph inputs overwritten by in-place outputs, recorded by
+  // `validateInPlace()` (see `isInPlaceDonor()`).
+  std::unordered_set<std::shared_ptr<TensorAttr>> inPlaceDonors_;
+
+  // Properties of an operation output left to inference by the user.
+  struct InferredProperties {
+    bool dim = false; // Including dynamic dims.
+    bool stride = false;
+    bool dataType = false;
+  };
+  // See `recordInferredProperties()` and `markDirty()`.
+  std::unordered_map<std::shared_ptr<TensorAttr>, InferredProperties>
+      inferredProperties_;
+  // Tensors edited since the last validation, see `markDirty()`.
+  std::vector<std::shared_ptr<TensorAttr>> dirtyTensors_;
+
+  // Compilation deferred by `compileLazy()` to the first use of the graph.
+  // Its prefetch, if any, is waited for when destroyed, as futures of
+  // `std::async` are, so it is declared among the members below.
+  struct LazyCompile {
+    // Compiles and loads the graph, then queries its workspace size.
+    std::function<ErrorObject()> compile;
+    std::future<ErrorObject> prefetch;
+    std::mutex mutex;
+    // Set while `compileOnFirstUse()` calls `compile()`, under `mutex`.
+    bool compiling = false;
+    // Set once compiled, along with the status of the compilation.
+    std::atomic<bool> done = false;
+    ErrorObject status = ok();
+  };
+  std::unique_ptr<LazyCompile> lazyCompile_;
+
+  // Optimized artifact being compiled in the background by `compileTiered()`,
+  // consumed by `tierUp()`. Waits for the compilation when destroyed, see
+  // `PendingCompile` below.
+  struct PendingTierUp {
+    std::future<ErrorOr<std::vector<uint8_t>>> future;
+
+    PendingTierUp() = default;
+    PendingTierUp(PendingTierUp &&) = default;
+    PendingTierUp &operator=(PendingTierUp &&) = default;
+    ~PendingTierUp() {
+      if (future.valid())
+        future.wait();
+    }
+
+    bool isPending() const {
+      return future.valid() && future.wait_for(std::chrono::seconds(0)) !=
+                                   std::future_status::ready;
+    }
+  };
+  PendingTierUp pendingTierUp_;
+
+  // Result of the last `compileAsync()`. Waits for the background compilation
+  // when destroyed, so it must remain the last member (along with
+  // `pendingTierUp_`): members are destroyed in reverse declaration order, and
+  // the compilation uses all of the above.
+  struct PendingCompile {
+    std::shared_future<ErrorObject> future;
+
+    PendingCompile() = default;
+    PendingCompile(PendingCompile &&) = default;
+    PendingCompile &operator=(PendingCompile &&) = default;
+    ~PendingCompile() {
+      if (future.valid())
+        future.wait();
+    }
+
+    bool isPending() const {
+      return future.valid() && future.wait_for(std::chrono::seconds(0)) !=
+                                   std::future_status::ready;
+    }
+  };
+  PendingCompile pendingCompile_;
 };
 
 // Given a TensorAttr, create a shared pointer and add it to the graph's
@@ -756,11 +4302,31 @@ private:
 inline std::shared_ptr<TensorAttr> Graph::tensor(const TensorAttr &tensor) {
   FUSILLI_LOG_LABEL_ENDL("INFO: Adding input tensor '" << tensor.getName()
                                                        << "' to Graph inputs");
-  auto tensorPtr = std::make_shared<TensorAttr>(tensor);
+  auto tensorPtr = makeShared<TensorAttr>(tensor);
   fullGraphInputs_.insert(tensorPtr);
   return tensorPtr;
 }
 
+inline ErrorOr<std::vector<uint8_t>> Graph::serialize() const {
+  FUSILLI_TRACE_ZONE("fusilli::Graph::serialize");
+  Archive ar = Archive::writer();
+  archiveGraph(*this, ar);
+  FUSILLI_CHECK_ERROR(ar.status());
+  return ok(ar.takeBytes());
+}
+
+inline ErrorOr<std::unique_ptr<Graph>>
+Graph::deserialize(std::span<const uint8_t> bytes) {
+  FUSILLI_TRACE_ZONE("fusilli::Graph::deserialize");
+  auto graph = std::make_unique<Graph>();
+  Archive ar = Archive::reader(bytes);
+  archiveGraph(*graph, ar);
+  FUSILLI_CHECK_ERROR(ar.status());
+  FUSILLI_RETURN_ERROR_IF(!ar.atEnd(), ErrorCode::InvalidArgument,
+                          "Trailing bytes after serialized graph");
+  return ok(std::move(graph));
+}
+
 // Create a ConvFPropNode, populate it with the specified attributes, create
 // output tensors and add the node to the graph's sub nodes.
 inline std::shared_ptr<TensorAttr>
@@ -774,6 +4340,10 @@ Graph::convFProp(const std::shared_ptr<TensorAttr> &x,
     x->setName(convAttr.getName() + "_X");
   if (w && w->getName().empty())
     w->setName(convAttr.getName() + "_W");
+  if (auto scaleX = convAttr.getSCALE_X(); scaleX && scaleX->getName().empty())
+    scaleX->setName(convAttr.getName() + "_SCALE_X");
+  if (auto scaleW = convAttr.getSCALE_W(); scaleW && scaleW->getName().empty())
+    scaleW->setName(convAttr.getName() + "_SCALE_W");
 
   FUSILLI_LOG_LABEL_ENDL("INFO: Adding ConvFPropNode '" << convAttr.getName()
                                                         << "' to Graph");
@@ -787,7 +4357,7 @@ Graph::convFProp(const std::shared_ptr<TensorAttr> &x,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<ConvFPropNode>(std::move(convAttr), context));
+      makeShared<ConvFPropNode>(std::move(convAttr), context));
 
   return y;
 }
@@ -818,11 +4388,28 @@ Graph::convWGrad(const std::shared_ptr<TensorAttr> &dy,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<ConvWGradNode>(std::move(convWGradAttr), context));
+      makeShared<ConvWGradNode>(std::move(convWGradAttr), context));
 
   return dw;
 }
 
+// Create a ConvWGradNode that also writes the bias gradient DBIAS, and add it
+// to the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 2>
+Graph::convWGradWithBias(const std::shared_ptr<TensorAttr> &dy,
+                         const std::shared_ptr<TensorAttr> &x,
+                         ConvWGradAttr &convWGradAttr) {
+  // Populate the name here as well, to derive the DBIAS name from it.
+  if (convWGradAttr.getName().empty())
+    convWGradAttr.setName("conv_wgrad_" + std::to_string(subNodes_.size()));
+
+  auto db = outputTensor(convWGradAttr.getName() + "_DBIAS");
+  convWGradAttr.setDBIAS(db);
+  auto dw = convWGrad(dy, x, convWGradAttr);
+
+  return {dw, db};
+}
+
 // Create a ConvDGradNode, populate it with the specified attributes, create
 // output tensors and add the node to the graph's sub nodes.
 inline std::shared_ptr<TensorAttr>
@@ -849,11 +4436,43 @@ Graph::convDGrad(const std::shared_ptr<TensorAttr> &dy,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<ConvDGradNode>(std::move(convDGradAttr), context));
+      makeShared<ConvDGradNode>(std::move(convDGradAttr), context));
 
   return dx;
 }
 
+// Create a ConvTransposeNode, populate it with the specified attributes,
+// create output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::convTranspose(const std::shared_ptr<TensorAttr> &x,
+                     const std::shared_ptr<TensorAttr> &w,
+                     ConvTransposeAttr &convTransposeAttr) {
+  // Populate names when not set.
+  if (convTransposeAttr.getName().empty())
+    convTransposeAttr.setName("conv_transpose_" +
+                              std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(convTransposeAttr.getName() + "_X");
+  if (w && w->getName().empty())
+    w->setName(convTransposeAttr.getName() + "_W");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding ConvTransposeNode '"
+                         << convTransposeAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  convTransposeAttr.setX(x).setW(w);
+
+  // Set outputs.
+  auto y = outputTensor(convTransposeAttr.getName() + "_Y");
+  convTransposeAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<ConvTransposeNode>(std::move(convTransposeAttr), context));
+
+  return y;
+}
+
 // Create a BatchNormNode, populate it with the specified attributes, create
 // output tensors and add the node to the graph's sub nodes.
 inline std::array<std::shared_ptr<TensorAttr>, 3>
@@ -903,11 +4522,62 @@ Graph::batchnorm(const std::shared_ptr<TensorAttr> &x,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<BatchNormNode>(std::move(batchnormAttr), context));
+      makeShared<BatchNormNode>(std::move(batchnormAttr), context));
 
   return {std::move(y), std::move(savedMean), std::move(savedInvVar)};
 }
 
+// Create a BatchNormBwdNode, populate it with the specified attributes,
+// create the gradient tensors and add the node to the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 3>
+Graph::batchnormBackward(const std::shared_ptr<TensorAttr> &dy,
+                         const std::shared_ptr<TensorAttr> &x,
+                         const std::shared_ptr<TensorAttr> &scale,
+                         const std::shared_ptr<TensorAttr> &savedMean,
+                         const std::shared_ptr<TensorAttr> &savedInvVariance,
+                         BatchnormBwdAttr &batchnormBwdAttr) {
+  // Populate names when not set.
+  if (batchnormBwdAttr.getName().empty())
+    batchnormBwdAttr.setName("batchnorm_bwd_" +
+                             std::to_string(subNodes_.size()));
+  const std::string &name = batchnormBwdAttr.getName();
+  if (dy && dy->getName().empty())
+    dy->setName(name + "_DY");
+  if (x && x->getName().empty())
+    x->setName(name + "_X");
+  if (scale && scale->getName().empty())
+    scale->setName(name + "_SCALE");
+  if (savedMean && savedMean->getName().empty())
+    savedMean->setName(name + "_SAVED_MEAN");
+  if (savedInvVariance && savedInvVariance->getName().empty())
+    savedInvVariance->setName(name + "_SAVED_INV_VARIANCE");
+  if (auto y = batchnormBwdAttr.getY(); y && y->getName().empty())
+    y->setName(name + "_Y");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding BatchNormBwdNode '" << name
+                                                           << "' to Graph");
+
+  // Set inputs.
+  batchnormBwdAttr.setDY(dy).setX(x).setSCALE(scale).setSAVED_MEAN(savedMean);
+  batchnormBwdAttr.setSAVED_INV_VARIANCE(savedInvVariance);
+
+  // Set outputs.
+  std::shared_ptr<TensorAttr> dx = outputTensor(name + "_DX");
+  std::shared_ptr<TensorAttr> dscale = nullptr;
+  std::shared_ptr<TensorAttr> dbias = nullptr;
+  if (scale) {
+    dscale = outputTensor(name + "_DSCALE");
+    dbias = outputTensor(name + "_DBIAS");
+  }
+  batchnormBwdAttr.setDX(dx).setDSCALE(dscale).setDBIAS(dbias);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<BatchNormBwdNode>(std::move(batchnormBwdAttr), context));
+
+  return {std::move(dx), std::move(dscale), std::move(dbias)};
+}
+
 // Create a LayerNormNode, populate it with the specified attributes, create
 // output tensors and add the node to the graph's sub nodes
 inline std::array<std::shared_ptr<TensorAttr>, 3>
@@ -928,76 +4598,208 @@ Graph::layernorm(const std::shared_ptr<TensorAttr> &x,
   if (eps && eps->getName().empty())
     eps->setName(layernormAttr.getName() + "_EPSILON");
 
-  FUSILLI_LOG_LABEL_ENDL("INFO: Adding LayerNorm '" << layernormAttr.getName()
-                                                    << "' to Graph");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding LayerNorm '" << layernormAttr.getName()
+                                                    << "' to Graph");
+
+  // Set inputs.
+  layernormAttr.setX(x);
+  layernormAttr.setSCALE(scale);
+  layernormAttr.setBIAS(bias);
+
+  // Set outputs.
+  std::shared_ptr<TensorAttr> y = outputTensor(layernormAttr.getName() + "_Y");
+  std::shared_ptr<TensorAttr> m = nullptr;
+  std::shared_ptr<TensorAttr> v = nullptr;
+  if (layernormAttr.getForwardPhase() == NormFwdPhase::TRAINING) {
+    m = outputTensor(layernormAttr.getName() + "_MEAN");
+    v = outputTensor(layernormAttr.getName() + "_INV_VARIANCE");
+  }
+  layernormAttr.setY(y);
+  layernormAttr.setMEAN(m);
+  layernormAttr.setINV_VARIANCE(v);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<LayerNormNode>(std::move(layernormAttr), context));
+
+  // `std::move` is useful for this case because we're returning an
+  // array initialized from lvalues and `std::move` avoids unnecessary
+  // copy and ref count operations on the shared pointers. This isn't
+  // necessary in methods where a single local variable is returned
+  // as NRVO would handle it.
+  return {std::move(y), std::move(m), std::move(v)};
+}
+
+// Create a RmsNormNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 2>
+Graph::rmsnorm(const std::shared_ptr<TensorAttr> &x,
+               const std::shared_ptr<TensorAttr> &scale,
+               RmsnormAttr &rmsnormAttr) {
+  // Populate names when not set.
+  if (rmsnormAttr.getName().empty())
+    rmsnormAttr.setName("rmsnorm_" + std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(rmsnormAttr.getName() + "_X");
+  if (scale && scale->getName().empty())
+    scale->setName(rmsnormAttr.getName() + "_SCALE");
+  auto eps = rmsnormAttr.getEpsilon();
+  if (eps && eps->getName().empty())
+    eps->setName(rmsnormAttr.getName() + "_EPSILON");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding RmsNorm '" << rmsnormAttr.getName()
+                                                  << "' to Graph");
+
+  // Set inputs.
+  rmsnormAttr.setX(x);
+  rmsnormAttr.setSCALE(scale);
+
+  // Set outputs.
+  std::shared_ptr<TensorAttr> y = outputTensor(rmsnormAttr.getName() + "_Y");
+  rmsnormAttr.setY(y);
+
+  std::shared_ptr<TensorAttr> r = nullptr;
+  if (rmsnormAttr.getForwardPhase() == NormFwdPhase::TRAINING)
+    r = outputTensor(rmsnormAttr.getName() + "_INV_RMS");
+  rmsnormAttr.setINV_RMS(r);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<RmsNormNode>(std::move(rmsnormAttr), context));
+
+  return {std::move(y), std::move(r)};
+}
+
+// Create a LayerNormNode with a fused residual add: set the RESIDUAL input
+// and SUM output on the attributes, then create the node as above.
+inline std::array<std::shared_ptr<TensorAttr>, 4>
+Graph::layernorm(const std::shared_ptr<TensorAttr> &x,
+                 const std::shared_ptr<TensorAttr> &residual,
+                 const std::shared_ptr<TensorAttr> &scale,
+                 const std::shared_ptr<TensorAttr> &bias,
+                 LayernormAttr &layernormAttr) {
+  if (layernormAttr.getName().empty())
+    layernormAttr.setName("layernorm_" + std::to_string(subNodes_.size()));
+  if (residual && residual->getName().empty())
+    residual->setName(layernormAttr.getName() + "_RESIDUAL");
+
+  std::shared_ptr<TensorAttr> sum =
+      outputTensor(layernormAttr.getName() + "_SUM");
+  layernormAttr.setRESIDUAL(residual);
+  layernormAttr.setSUM(sum);
+
+  auto [y, m, v] = layernorm(x, scale, bias, layernormAttr);
+  return {std::move(y), std::move(m), std::move(v), std::move(sum)};
+}
+
+// Create a RmsNormNode with a fused residual add: set the RESIDUAL input and
+// SUM output on the attributes, then create the node as above.
+inline std::array<std::shared_ptr<TensorAttr>, 3>
+Graph::rmsnorm(const std::shared_ptr<TensorAttr> &x,
+               const std::shared_ptr<TensorAttr> &residual,
+               const std::shared_ptr<TensorAttr> &scale,
+               RmsnormAttr &rmsnormAttr) {
+  if (rmsnormAttr.getName().empty())
+    rmsnormAttr.setName("rmsnorm_" + std::to_string(subNodes_.size()));
+  if (residual && residual->getName().empty())
+    residual->setName(rmsnormAttr.getName() + "_RESIDUAL");
+
+  std::shared_ptr<TensorAttr> sum =
+      outputTensor(rmsnormAttr.getName() + "_SUM");
+  rmsnormAttr.setRESIDUAL(residual);
+  rmsnormAttr.setSUM(sum);
+
+  auto [y, r] = rmsnorm(x, scale, rmsnormAttr);
+  return {std::move(y), std::move(r), std::move(sum)};
+}
+
+// Create a LayerNormBwdNode, populate it with the specified attributes,
+// create the gradient tensors and add the node to the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 3>
+Graph::layernormBackward(const std::shared_ptr<TensorAttr> &dy,
+                         const std::shared_ptr<TensorAttr> &x,
+                         const std::shared_ptr<TensorAttr> &scale,
+                         const std::shared_ptr<TensorAttr> &mean,
+                         const std::shared_ptr<TensorAttr> &invVariance,
+                         LayernormBwdAttr &layernormBwdAttr) {
+  // Populate names when not set.
+  if (layernormBwdAttr.getName().empty())
+    layernormBwdAttr.setName("layernorm_bwd_" +
+                             std::to_string(subNodes_.size()));
+  const std::string &name = layernormBwdAttr.getName();
+  if (dy && dy->getName().empty())
+    dy->setName(name + "_DY");
+  if (x && x->getName().empty())
+    x->setName(name + "_X");
+  if (scale && scale->getName().empty())
+    scale->setName(name + "_SCALE");
+  if (mean && mean->getName().empty())
+    mean->setName(name + "_MEAN");
+  if (invVariance && invVariance->getName().empty())
+    invVariance->setName(name + "_INV_VARIANCE");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding LayerNormBwdNode '" << name
+                                                           << "' to Graph");
 
   // Set inputs.
-  layernormAttr.setX(x);
-  layernormAttr.setSCALE(scale);
-  layernormAttr.setBIAS(bias);
+  layernormBwdAttr.setDY(dy).setX(x).setSCALE(scale).setMEAN(mean);
+  layernormBwdAttr.setINV_VARIANCE(invVariance);
 
   // Set outputs.
-  std::shared_ptr<TensorAttr> y = outputTensor(layernormAttr.getName() + "_Y");
-  std::shared_ptr<TensorAttr> m = nullptr;
-  std::shared_ptr<TensorAttr> v = nullptr;
-  if (layernormAttr.getForwardPhase() == NormFwdPhase::TRAINING) {
-    m = outputTensor(layernormAttr.getName() + "_MEAN");
-    v = outputTensor(layernormAttr.getName() + "_INV_VARIANCE");
+  std::shared_ptr<TensorAttr> dx = outputTensor(name + "_DX");
+  std::shared_ptr<TensorAttr> dscale = nullptr;
+  std::shared_ptr<TensorAttr> dbias = nullptr;
+  if (scale) {
+    dscale = outputTensor(name + "_DSCALE");
+    dbias = outputTensor(name + "_DBIAS");
   }
-  layernormAttr.setY(y);
-  layernormAttr.setMEAN(m);
-  layernormAttr.setINV_VARIANCE(v);
+  layernormBwdAttr.setDX(dx).setDSCALE(dscale).setDBIAS(dbias);
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<LayerNormNode>(std::move(layernormAttr), context));
+      makeShared<LayerNormBwdNode>(std::move(layernormBwdAttr), context));
 
-  // `std::move` is useful for this case because we're returning an
-  // array initialized from lvalues and `std::move` avoids unnecessary
-  // copy and ref count operations on the shared pointers. This isn't
-  // necessary in methods where a single local variable is returned
-  // as NRVO would handle it.
-  return {std::move(y), std::move(m), std::move(v)};
+  return {std::move(dx), std::move(dscale), std::move(dbias)};
 }
 
-// Create a RmsNormNode, populate it with the specified attributes, create
-// output tensors and add the node to the graph's sub nodes.
+// Create a RmsNormBwdNode, populate it with the specified attributes, create
+// the gradient tensors and add the node to the graph's sub nodes.
 inline std::array<std::shared_ptr<TensorAttr>, 2>
-Graph::rmsnorm(const std::shared_ptr<TensorAttr> &x,
-               const std::shared_ptr<TensorAttr> &scale,
-               RmsnormAttr &rmsnormAttr) {
+Graph::rmsnormBackward(const std::shared_ptr<TensorAttr> &dy,
+                       const std::shared_ptr<TensorAttr> &x,
+                       const std::shared_ptr<TensorAttr> &scale,
+                       const std::shared_ptr<TensorAttr> &invRms,
+                       RmsnormBwdAttr &rmsnormBwdAttr) {
   // Populate names when not set.
-  if (rmsnormAttr.getName().empty())
-    rmsnormAttr.setName("rmsnorm_" + std::to_string(subNodes_.size()));
+  if (rmsnormBwdAttr.getName().empty())
+    rmsnormBwdAttr.setName("rmsnorm_bwd_" + std::to_string(subNodes_.size()));
+  const std::string &name = rmsnormBwdAttr.getName();
+  if (dy && dy->getName().empty())
+    dy->setName(name + "_DY");
   if (x && x->getName().empty())
-    x->setName(rmsnormAttr.getName() + "_X");
+    x->setName(name + "_X");
   if (scale && scale->getName().empty())
-    scale->setName(rmsnormAttr.getName() + "_SCALE");
-  auto eps = rmsnormAttr.getEpsilon();
-  if (eps && eps->getName().empty())
-    eps->setName(rmsnormAttr.getName() + "_EPSILON");
+    scale->setName(name + "_SCALE");
+  if (invRms && invRms->getName().empty())
+    invRms->setName(name + "_INV_RMS");
 
-  FUSILLI_LOG_LABEL_ENDL("INFO: Adding RmsNorm '" << rmsnormAttr.getName()
-                                                  << "' to Graph");
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding RmsNormBwdNode '" << name
+                                                         << "' to Graph");
 
   // Set inputs.
-  rmsnormAttr.setX(x);
-  rmsnormAttr.setSCALE(scale);
+  rmsnormBwdAttr.setDY(dy).setX(x).setSCALE(scale).setINV_RMS(invRms);
 
   // Set outputs.
-  std::shared_ptr<TensorAttr> y = outputTensor(rmsnormAttr.getName() + "_Y");
-  rmsnormAttr.setY(y);
-
-  std::shared_ptr<TensorAttr> r = nullptr;
-  if (rmsnormAttr.getForwardPhase() == NormFwdPhase::TRAINING)
-    r = outputTensor(rmsnormAttr.getName() + "_INV_RMS");
-  rmsnormAttr.setINV_RMS(r);
+  std::shared_ptr<TensorAttr> dx = outputTensor(name + "_DX");
+  std::shared_ptr<TensorAttr> dscale =
+      scale ? outputTensor(name + "_DSCALE") : nullptr;
+  rmsnormBwdAttr.setDX(dx).setDSCALE(dscale);
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<RmsNormNode>(std::move(rmsnormAttr), context));
+      makeShared<RmsNormBwdNode>(std::move(rmsnormBwdAttr), context));
 
-  return {std::move(y), std::move(r)};
+  return {std::move(dx), std::move(dscale)};
 }
 
 // Create a MatmulNode, populate it with the specified attributes, create
@@ -1012,6 +4814,27 @@ Graph::matmul(const std::shared_ptr<TensorAttr> &a,
     a->setName(matmulAttr.getName() + "_A");
   if (b && b->getName().empty())
     b->setName(matmulAttr.getName() + "_B");
+  if (auto bias = matmulAttr.getBIAS(); bias && bias->getName().empty())
+    bias->setName(matmulAttr.getName() + "_BIAS");
+  if (auto residual = matmulAttr.getRESIDUAL();
+      residual && residual->getName().empty())
+    residual->setName(matmulAttr.getName() + "_RESIDUAL");
+  if (auto scaleA = matmulAttr.getSCALE_A();
+      scaleA && scaleA->getName().empty())
+    scaleA->setName(matmulAttr.getName() + "_SCALE_A");
+  if (auto scaleB = matmulAttr.getSCALE_B();
+      scaleB && scaleB->getName().empty())
+    scaleB->setName(matmulAttr.getName() + "_SCALE_B");
+  if (auto groupSizes = matmulAttr.getGROUP_SIZES();
+      groupSizes && groupSizes->getName().empty())
+    groupSizes->setName(matmulAttr.getName() + "_GROUP_SIZES");
+  if (auto bMeta = matmulAttr.getB_META(); bMeta && bMeta->getName().empty())
+    bMeta->setName(matmulAttr.getName() + "_B_META");
+  if (auto bScale = matmulAttr.getB_SCALE();
+      bScale && bScale->getName().empty())
+    bScale->setName(matmulAttr.getName() + "_B_SCALE");
+  if (auto bZero = matmulAttr.getB_ZERO(); bZero && bZero->getName().empty())
+    bZero->setName(matmulAttr.getName() + "_B_ZERO");
 
   FUSILLI_LOG_LABEL_ENDL("INFO: Adding MatmulNode '" << matmulAttr.getName()
                                                      << "' to Graph");
@@ -1025,11 +4848,28 @@ Graph::matmul(const std::shared_ptr<TensorAttr> &a,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<MatmulNode>(std::move(matmulAttr), context));
+      makeShared<MatmulNode>(std::move(matmulAttr), context));
 
   return c;
 }
 
+// Create a MatmulNode that also writes the bias gradient DBIAS, and add it to
+// the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 2>
+Graph::matmulWithBiasGrad(const std::shared_ptr<TensorAttr> &a,
+                          const std::shared_ptr<TensorAttr> &b,
+                          MatmulAttr &matmulAttr) {
+  // Populate the name here as well, to derive the DBIAS name from it.
+  if (matmulAttr.getName().empty())
+    matmulAttr.setName("matmul_" + std::to_string(subNodes_.size()));
+
+  auto db = outputTensor(matmulAttr.getName() + "_DBIAS");
+  matmulAttr.setDBIAS(db);
+  auto c = matmul(a, b, matmulAttr);
+
+  return {c, db};
+}
+
 // Create a PointwiseNode for single operand cases (e.g. RELU), populate it with
 // the specified attributes, create output tensors and add the node to the
 // graph's sub nodes.
@@ -1054,7 +4894,7 @@ Graph::pointwise(const std::shared_ptr<TensorAttr> &in,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<PointwiseNode>(std::move(pointwiseAttr), context));
+      makeShared<PointwiseNode>(std::move(pointwiseAttr), context));
 
   return out;
 }
@@ -1086,7 +4926,7 @@ Graph::pointwise(const std::shared_ptr<TensorAttr> &in0,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<PointwiseNode>(std::move(pointwiseAttr), context));
+      makeShared<PointwiseNode>(std::move(pointwiseAttr), context));
 
   return out;
 }
@@ -1121,7 +4961,7 @@ Graph::pointwise(const std::shared_ptr<TensorAttr> &in0,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<PointwiseNode>(std::move(pointwiseAttr), context));
+      makeShared<PointwiseNode>(std::move(pointwiseAttr), context));
 
   return out;
 }
@@ -1149,11 +4989,27 @@ Graph::reduction(const std::shared_ptr<TensorAttr> &x,
 
   // Create node and add to Graph's subNodes_.
   subNodes_.emplace_back(
-      std::make_unique<ReductionNode>(std::move(reductionAttr), context));
+      makeShared<ReductionNode>(std::move(reductionAttr), context));
 
   return y;
 }
 
+// Create a ReductionNode that also writes the second statistic Y2 of a
+// multi-output mode, and add it to the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 2>
+Graph::multiOutputReduction(const std::shared_ptr<TensorAttr> &x,
+                            ReductionAttr &reductionAttr) {
+  // Populate the name here as well, to derive the Y2 name from it.
+  if (reductionAttr.getName().empty())
+    reductionAttr.setName("reduction_" + std::to_string(subNodes_.size()));
+
+  auto y2 = outputTensor(reductionAttr.getName() + "_Y2");
+  reductionAttr.setY2(y2);
+  auto y = reduction(x, reductionAttr);
+
+  return {y, y2};
+}
+
 // Create an SdpaNode, populate it with the specified attributes, create
 // output tensors and add the node to the graph's sub nodes.
 inline std::shared_ptr<TensorAttr>
@@ -1172,6 +5028,22 @@ Graph::sdpa(const std::shared_ptr<TensorAttr> &q,
     v->setName(sdpaAttr.getName() + "_V");
   if (mask && mask->getName().empty())
     mask->setName(sdpaAttr.getName() + "_MASK");
+  if (auto pageTable = sdpaAttr.getPAGE_TABLE();
+      pageTable && pageTable->getName().empty())
+    pageTable->setName(sdpaAttr.getName() + "_PAGE_TABLE");
+  if (auto cuQ = sdpaAttr.getCU_SEQLENS_Q(); cuQ && cuQ->getName().empty())
+    cuQ->setName(sdpaAttr.getName() + "_CU_SEQLENS_Q");
+  if (auto cuKV = sdpaAttr.getCU_SEQLENS_KV(); cuKV && cuKV->getName().empty())
+    cuKV->setName(sdpaAttr.getName() + "_CU_SEQLENS_KV");
+  if (auto seed = sdpaAttr.getDROPOUT_SEED(); seed && seed->getName().empty())
+    seed->setName(sdpaAttr.getName() + "_DROPOUT_SEED");
+  if (auto offset = sdpaAttr.getDROPOUT_OFFSET();
+      offset && offset->getName().empty())
+    offset->setName(sdpaAttr.getName() + "_DROPOUT_OFFSET");
+  if (auto cos = sdpaAttr.getROPE_COS(); cos && cos->getName().empty())
+    cos->setName(sdpaAttr.getName() + "_ROPE_COS");
+  if (auto sin = sdpaAttr.getROPE_SIN(); sin && sin->getName().empty())
+    sin->setName(sdpaAttr.getName() + "_ROPE_SIN");
 
   FUSILLI_LOG_LABEL_ENDL("INFO: Adding SdpaNode '" << sdpaAttr.getName()
                                                    << "' to Graph");
@@ -1186,12 +5058,432 @@ Graph::sdpa(const std::shared_ptr<TensorAttr> &q,
   sdpaAttr.setO(o);
 
   // Create node and add to Graph's subNodes_.
-  subNodes_.emplace_back(
-      std::make_unique<SdpaNode>(std::move(sdpaAttr), context));
+  subNodes_.emplace_back(makeShared<SdpaNode>(std::move(sdpaAttr), context));
 
   return o;
 }
 
+// Create an SdpaNode that also writes the logsumexp STATS of its scores for
+// the backward pass, and add it to the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 2>
+Graph::sdpaWithStats(const std::shared_ptr<TensorAttr> &q,
+                     const std::shared_ptr<TensorAttr> &k,
+                     const std::shared_ptr<TensorAttr> &v,
+                     const std::shared_ptr<TensorAttr> &mask,
+                     SdpaAttr &sdpaAttr) {
+  // Populate the name here as well, to derive the STATS name from it.
+  if (sdpaAttr.getName().empty())
+    sdpaAttr.setName("sdpa_" + std::to_string(subNodes_.size()));
+
+  auto stats = outputTensor(sdpaAttr.getName() + "_STATS");
+  sdpaAttr.setSTATS(stats);
+  auto o = sdpa(q, k, v, mask, sdpaAttr);
+
+  return {o, stats};
+}
+
+// Create an SdpaBwdNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::array<std::shared_ptr<TensorAttr>, 3>
+Graph::sdpaBackward(const std::shared_ptr<TensorAttr> &q,
+                    const std::shared_ptr<TensorAttr> &k,
+                    const std::shared_ptr<TensorAttr> &v,
+                    const std::shared_ptr<TensorAttr> &o,
+                    const std::shared_ptr<TensorAttr> &dO,
+                    const std::shared_ptr<TensorAttr> &stats,
+                    SdpaBwdAttr &sdpaBwdAttr) {
+  // Populate names when not set.
+  if (sdpaBwdAttr.getName().empty())
+    sdpaBwdAttr.setName("sdpa_bwd_" + std::to_string(subNodes_.size()));
+  if (q && q->getName().empty())
+    q->setName(sdpaBwdAttr.getName() + "_Q");
+  if (k && k->getName().empty())
+    k->setName(sdpaBwdAttr.getName() + "_K");
+  if (v && v->getName().empty())
+    v->setName(sdpaBwdAttr.getName() + "_V");
+  if (o && o->getName().empty())
+    o->setName(sdpaBwdAttr.getName() + "_O");
+  if (dO && dO->getName().empty())
+    dO->setName(sdpaBwdAttr.getName() + "_DO");
+  if (stats && stats->getName().empty())
+    stats->setName(sdpaBwdAttr.getName() + "_STATS");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding SdpaBwdNode '" << sdpaBwdAttr.getName()
+                                                      << "' to Graph");
+
+  // Set inputs.
+  sdpaBwdAttr.setQ(q).setK(k).setV(v).setO(o).setDO(dO).setSTATS(stats);
+
+  // Set outputs.
+  auto dq = outputTensor(sdpaBwdAttr.getName() + "_DQ");
+  auto dk = outputTensor(sdpaBwdAttr.getName() + "_DK");
+  auto dv = outputTensor(sdpaBwdAttr.getName() + "_DV");
+  sdpaBwdAttr.setDQ(dq).setDK(dk).setDV(dv);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<SdpaBwdNode>(std::move(sdpaBwdAttr), context));
+
+  return {dq, dk, dv};
+}
+
+// Create a SoftmaxNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::softmax(const std::shared_ptr<TensorAttr> &x,
+               const std::shared_ptr<TensorAttr> &mask,
+               SoftmaxAttr &softmaxAttr) {
+  // Populate names when not set.
+  if (softmaxAttr.getName().empty())
+    softmaxAttr.setName("softmax_" + std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(softmaxAttr.getName() + "_X");
+  if (mask && mask->getName().empty())
+    mask->setName(softmaxAttr.getName() + "_MASK");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding SoftmaxNode '" << softmaxAttr.getName()
+                                                      << "' to Graph");
+
+  // Set inputs.
+  softmaxAttr.setX(x);
+  if (mask)
+    softmaxAttr.setMASK(mask);
+
+  // Set outputs.
+  auto y = outputTensor(softmaxAttr.getName() + "_Y");
+  softmaxAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<SoftmaxNode>(std::move(softmaxAttr), context));
+
+  return y;
+}
+
+// Create a PoolingNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::pooling(const std::shared_ptr<TensorAttr> &x, PoolingAttr &poolingAttr) {
+  // Populate names when not set.
+  if (poolingAttr.getName().empty())
+    poolingAttr.setName("pooling_" + std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(poolingAttr.getName() + "_X");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding PoolingNode '" << poolingAttr.getName()
+                                                      << "' to Graph");
+
+  // Set inputs.
+  poolingAttr.setX(x);
+
+  // Set outputs.
+  auto y = outputTensor(poolingAttr.getName() + "_Y");
+  poolingAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<PoolingNode>(std::move(poolingAttr), context));
+
+  return y;
+}
+
+// Create a ReshapeNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::reshape(const std::shared_ptr<TensorAttr> &x, ReshapeAttr &reshapeAttr) {
+  // Populate names when not set.
+  if (reshapeAttr.getName().empty())
+    reshapeAttr.setName("reshape_" + std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(reshapeAttr.getName() + "_X");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding ReshapeNode '" << reshapeAttr.getName()
+                                                      << "' to Graph");
+
+  // Set inputs.
+  reshapeAttr.setX(x);
+
+  // Set outputs.
+  auto y = outputTensor(reshapeAttr.getName() + "_Y");
+  reshapeAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<ReshapeNode>(std::move(reshapeAttr), context));
+
+  return y;
+}
+
+// Create a PermuteNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::permute(const std::shared_ptr<TensorAttr> &x, PermuteAttr &permuteAttr) {
+  // Populate names when not set.
+  if (permuteAttr.getName().empty())
+    permuteAttr.setName("permute_" + std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(permuteAttr.getName() + "_X");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding PermuteNode '" << permuteAttr.getName()
+                                                      << "' to Graph");
+
+  // Set inputs.
+  permuteAttr.setX(x);
+
+  // Set outputs.
+  auto y = outputTensor(permuteAttr.getName() + "_Y");
+  permuteAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<PermuteNode>(std::move(permuteAttr), context));
+
+  return y;
+}
+
+// Create a SliceNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::slice(const std::shared_ptr<TensorAttr> &x, SliceAttr &sliceAttr) {
+  // Populate names when not set.
+  if (sliceAttr.getName().empty())
+    sliceAttr.setName("slice_" + std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(sliceAttr.getName() + "_X");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding SliceNode '" << sliceAttr.getName()
+                                                    << "' to Graph");
+
+  // Set inputs.
+  sliceAttr.setX(x);
+
+  // Set outputs.
+  auto y = outputTensor(sliceAttr.getName() + "_Y");
+  sliceAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(makeShared<SliceNode>(std::move(sliceAttr), context));
+
+  return y;
+}
+
+// Create a ConcatNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::concat(const std::vector<std::shared_ptr<TensorAttr>> &xs,
+              ConcatAttr &concatAttr) {
+  // Populate names when not set.
+  if (concatAttr.getName().empty())
+    concatAttr.setName("concat_" + std::to_string(subNodes_.size()));
+  for (size_t i = 0; i < xs.size(); ++i)
+    if (xs[i] && xs[i]->getName().empty())
+      xs[i]->setName(concatAttr.getName() + "_X_" + std::to_string(i));
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding ConcatNode '" << concatAttr.getName()
+                                                     << "' to Graph");
+
+  // Set inputs.
+  concatAttr.setX(xs);
+
+  // Set outputs.
+  auto y = outputTensor(concatAttr.getName() + "_Y");
+  concatAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<ConcatNode>(std::move(concatAttr), context));
+
+  return y;
+}
+
+// Create a SliceUpdateNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::sliceUpdate(const std::shared_ptr<TensorAttr> &x,
+                   const std::shared_ptr<TensorAttr> &update,
+                   const std::shared_ptr<TensorAttr> &start,
+                   SliceUpdateAttr &sliceUpdateAttr) {
+  // Populate names when not set.
+  if (sliceUpdateAttr.getName().empty())
+    sliceUpdateAttr.setName("slice_update_" +
+                            std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(sliceUpdateAttr.getName() + "_X");
+  if (update && update->getName().empty())
+    update->setName(sliceUpdateAttr.getName() + "_UPDATE");
+  if (start && start->getName().empty())
+    start->setName(sliceUpdateAttr.getName() + "_START");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding SliceUpdateNode '"
+                         << sliceUpdateAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  sliceUpdateAttr.setX(x).setUPDATE(update).setSTART(start);
+
+  // Set outputs.
+  auto y = outputTensor(sliceUpdateAttr.getName() + "_Y");
+  sliceUpdateAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<SliceUpdateNode>(std::move(sliceUpdateAttr), context));
+
+  return y;
+}
+
+// Create an IndexSelectNode, populate it with the specified attributes,
+// create output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::indexSelect(const std::shared_ptr<TensorAttr> &x,
+                   const std::shared_ptr<TensorAttr> &index,
+                   IndexSelectAttr &indexSelectAttr) {
+  // Populate names when not set.
+  if (indexSelectAttr.getName().empty())
+    indexSelectAttr.setName("index_select_" +
+                            std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(indexSelectAttr.getName() + "_X");
+  if (index && index->getName().empty())
+    index->setName(indexSelectAttr.getName() + "_INDEX");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding IndexSelectNode '"
+                         << indexSelectAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  indexSelectAttr.setX(x).setINDEX(index);
+
+  // Set outputs.
+  auto y = outputTensor(indexSelectAttr.getName() + "_Y");
+  indexSelectAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<IndexSelectNode>(std::move(indexSelectAttr), context));
+
+  return y;
+}
+
+// Create an IndexAddNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::indexAdd(const std::shared_ptr<TensorAttr> &x,
+                const std::shared_ptr<TensorAttr> &index,
+                const std::shared_ptr<TensorAttr> &source,
+                IndexAddAttr &indexAddAttr) {
+  // Populate names when not set.
+  if (indexAddAttr.getName().empty())
+    indexAddAttr.setName("index_add_" + std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(indexAddAttr.getName() + "_X");
+  if (index && index->getName().empty())
+    index->setName(indexAddAttr.getName() + "_INDEX");
+  if (source && source->getName().empty())
+    source->setName(indexAddAttr.getName() + "_SOURCE");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding IndexAddNode '"
+                         << indexAddAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  indexAddAttr.setX(x).setINDEX(index).setSOURCE(source);
+
+  // Set outputs.
+  auto y = outputTensor(indexAddAttr.getName() + "_Y");
+  indexAddAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<IndexAddNode>(std::move(indexAddAttr), context));
+
+  return y;
+}
+
+// Create a CollectiveNode, populate it with the specified attributes, create
+// output tensors and add the node to the graph's sub nodes.
+inline std::shared_ptr<TensorAttr>
+Graph::collective(const std::shared_ptr<TensorAttr> &x,
+                  CollectiveAttr &collectiveAttr) {
+  // Populate names when not set.
+  if (collectiveAttr.getName().empty())
+    collectiveAttr.setName("collective_" + std::to_string(subNodes_.size()));
+  if (x && x->getName().empty())
+    x->setName(collectiveAttr.getName() + "_X");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding CollectiveNode '"
+                         << collectiveAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  collectiveAttr.setX(x);
+
+  // Set outputs.
+  auto y = outputTensor(collectiveAttr.getName() + "_Y");
+  collectiveAttr.setY(y);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<CollectiveNode>(std::move(collectiveAttr), context));
+
+  return y;
+}
+
+// Create an OptimizerNode, populate it with the specified attributes, create
+// in-place output tensors and add the node to the graph's sub nodes.
+inline std::array<std::vector<std::shared_ptr<TensorAttr>>, 3>
+Graph::optimizerUpdate(const std::vector<std::shared_ptr<TensorAttr>> &params,
+                       const std::vector<std::shared_ptr<TensorAttr>> &grads,
+                       const std::vector<std::shared_ptr<TensorAttr>> &moments1,
+                       const std::vector<std::shared_ptr<TensorAttr>> &moments2,
+                       OptimizerAttr &optimizerAttr) {
+  // Populate names when not set.
+  if (optimizerAttr.getName().empty())
+    optimizerAttr.setName("optimizer_" + std::to_string(subNodes_.size()));
+  auto nameTensors = [&](const std::vector<std::shared_ptr<TensorAttr>> &list,
+                         const std::string &prefix) {
+    for (size_t i = 0; i < list.size(); ++i)
+      if (list[i] && list[i]->getName().empty())
+        list[i]->setName(optimizerAttr.getName() + "_" + prefix + "_" +
+                         std::to_string(i));
+  };
+  nameTensors(params, "PARAM");
+  nameTensors(grads, "GRAD");
+  nameTensors(moments1, "MOMENT1");
+  nameTensors(moments2, "MOMENT2");
+
+  FUSILLI_LOG_LABEL_ENDL("INFO: Adding OptimizerNode '"
+                         << optimizerAttr.getName() << "' to Graph");
+
+  // Set inputs.
+  optimizerAttr.setParams(params)
+      .setGrads(grads)
+      .setMoments1(moments1)
+      .setMoments2(moments2);
+
+  // Set outputs, written into the buffers of the inputs they update.
+  auto newTensors = [&](const std::vector<std::shared_ptr<TensorAttr>> &list,
+                        const std::string &prefix) {
+    std::vector<std::shared_ptr<TensorAttr>> outs;
+    outs.reserve(list.size());
+    for (size_t i = 0; i < list.size(); ++i) {
+      auto out = outputTensor(optimizerAttr.getName() + "_" + prefix + "_" +
+                              std::to_string(i));
+      out->setOutput(true).setInPlace(list[i]);
+      outs.push_back(std::move(out));
+    }
+    return outs;
+  };
+  std::array<std::vector<std::shared_ptr<TensorAttr>>, 3> outs = {
+      newTensors(params, "NEW_PARAM"), newTensors(moments1, "NEW_MOMENT1"),
+      newTensors(moments2, "NEW_MOMENT2")};
+  optimizerAttr.setNewParams(outs[0])
+      .setNewMoments1(outs[1])
+      .setNewMoments2(outs[2]);
+
+  // Create node and add to Graph's subNodes_.
+  subNodes_.emplace_back(
+      makeShared<OptimizerNode>(std::move(optimizerAttr), context));
+
+  return outs;
+}
+
 inline std::vector<std::shared_ptr<TensorAttr>>
 Graph::customOp(std::vector<std::shared_ptr<TensorAttr>> inputTensors,
                 CustomOpAttr &customOpAttr) {
@@ -1209,8 +5501,9 @@ Graph::customOp(std::vector<std::shared_ptr<TensorAttr>> inputTensors,
   FUSILLI_LOG_LABEL_ENDL("INFO: Adding CustomOpNode '" << customOpAttr.getName()
                                                        << "' to Graph");
 
-  // Create output tensors. The caller sets dim/stride/datatype on the
-  // returned tensors (same pattern as convDGrad/convWGrad).
+  // Create output tensors. Unless the attribute has inference rules or a
+  // callback for them (see `CustomOpAttr::setShapeInference()`), the caller
+  // sets dim/stride/datatype on the returned tensors.
   std::vector<std::shared_ptr<TensorAttr>> outputTensors;
   outputTensors.reserve(customOpAttr.getNumOutputs());
   for (size_t i = 0; i < customOpAttr.getNumOutputs(); ++i)
@@ -1218,7 +5511,7 @@ Graph::customOp(std::vector<std::shared_ptr<TensorAttr>> inputTensors,
         outputTensor(customOpAttr.getName() + "_OUT_" + std::to_string(i)));
 
   // Create node and add to Graph's subNodes_.
-  auto node = std::make_unique<CustomOpNode>(std::move(customOpAttr), context);
+  auto node = makeShared<CustomOpNode>(std::move(customOpAttr), context);
   node->inputs = std::move(inputTensors);
   node->outputs = outputTensors;
   subNodes_.emplace_back(std::move(node));
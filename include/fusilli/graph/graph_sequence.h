@@ -0,0 +1,88 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains GraphSequence, which records several compiled graphs with
+// their buffers and submits them back to back.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_GRAPH_SEQUENCE_H
+#define FUSILLI_GRAPH_GRAPH_SEQUENCE_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// GraphSequence submits a fixed chain of graphs, e.g. the ~dozen graphs of a
+// transformer layer, for the cost of one submission on the host. Each graph
+// is bound once when appended (see `Graph::bind()`), so `submit()` only
+// issues the prebuilt invocations in order, with no validation, allocation or
+// host synchronization in between. On asynchronous backends the invocations
+// are ordered on the device stream, so intermediates passed as the output
+// buffer of one graph and an input buffer of a later one never leave the
+// device.
+//
+// Like `ExecutionPlan`, a sequence keeps the bound artifacts and buffers alive
+// and may only be submitted by one thread at a time.
+//
+// Usage:
+//   GraphSequence layer;
+//   FUSILLI_CHECK_ERROR(layer.append(qkvGraph, qkvPack, qkvWorkspace));
+//   FUSILLI_CHECK_ERROR(layer.append(sdpaGraph, sdpaPack, sdpaWorkspace));
+//   for (...)
+//     FUSILLI_CHECK_ERROR(layer.submit(handle));
+class GraphSequence {
+public:
+  // Binds the compiled `graph` to `variantPack` and `workspace` and appends it
+  // to the sequence.
+  ErrorObject
+  append(const Graph &graph,
+         const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                  std::shared_ptr<Buffer>> &variantPack,
+         const std::shared_ptr<Buffer> &workspace) {
+    FUSILLI_ASSIGN_OR_RETURN(ExecutionPlan plan,
+                             graph.bind(variantPack, workspace));
+    plans_.push_back(std::move(plan));
+    return ok();
+  }
+
+  // Invokes the appended graphs in order on `handle`. Stops at the first
+  // failing graph, whose error is returned.
+  ErrorObject submit(const Handle &handle) const {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Submitting GraphSequence of "
+                           << plans_.size() << " graphs");
+    for (const ExecutionPlan &plan : plans_)
+      FUSILLI_CHECK_ERROR(plan.run(handle));
+    return ok();
+  }
+
+  // Number of appended graphs.
+  size_t size() const { return plans_.size(); }
+
+  bool empty() const { return plans_.empty(); }
+
+  // Removes all graphs, releasing their bound artifacts and buffers.
+  void clear() { plans_.clear(); }
+
+private:
+  std::vector<ExecutionPlan> plans_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_GRAPH_SEQUENCE_H
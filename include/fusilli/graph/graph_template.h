@@ -0,0 +1,135 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains GraphTemplate, a graph validated and compiled once, and
+// GraphInstance, a cheap instance of it owning only its buffers.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_GRAPH_TEMPLATE_H
+#define FUSILLI_GRAPH_GRAPH_TEMPLATE_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+class GraphInstance;
+
+// GraphTemplate serves requests sharing one graph structure without a `Graph`
+// per request: the graph is validated, compiled and loaded once, and
+// `instantiate()` hands out instances that execute its loaded module and
+// function read-only (through the pooled VM contexts of concurrent
+// executions, see `Graph::execute()`) and only own their buffers. Creating an
+// instance allocates a single vector, with no validation, compilation or
+// artifact loading.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(GraphTemplate tmpl,
+//                            GraphTemplate::create(handle, graph));
+//   // Per request:
+//   GraphInstance instance = tmpl.instantiate();
+//   FUSILLI_CHECK_ERROR(instance.bind(x, xBuf));
+//   FUSILLI_CHECK_ERROR(instance.bind(y, yBuf));
+//   FUSILLI_CHECK_ERROR(instance.execute(handle, workspace));
+class GraphTemplate {
+public:
+  // Validates `graph` and compiles it for `handle`. The template takes shared
+  // ownership of the graph, which must not be modified afterwards.
+  static ErrorOr<GraphTemplate> create(const Handle &handle,
+                                       std::shared_ptr<Graph> graph,
+                                       bool remove = false) {
+    FUSILLI_RETURN_ERROR_IF(graph == nullptr, ErrorCode::InvalidArgument,
+                            "GraphTemplate graph is null");
+    FUSILLI_CHECK_ERROR(graph->validate());
+    FUSILLI_CHECK_ERROR(graph->compile(handle, remove));
+    return ok(GraphTemplate(std::move(graph)));
+  }
+
+  // Returns the compiled graph, e.g. to query tensor UIDs or the workspace
+  // size shared by all instances.
+  const Graph &getGraph() const { return *graph_; }
+
+  // Returns an instance with no buffers bound. Instances keep the compiled
+  // graph alive, so they may outlive the template.
+  GraphInstance instantiate() const;
+
+private:
+  explicit GraphTemplate(std::shared_ptr<const Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  std::shared_ptr<const Graph> graph_;
+};
+
+// An instance of a `GraphTemplate`: its buffers, indexed by tensor UID (see
+// `Graph::getTensorUid()`), and a reference to the compiled graph. Instances
+// of one template may execute concurrently from several threads; a single
+// instance is not synchronized.
+class GraphInstance {
+public:
+  // Binds `buffer` to the graph input or output `tensor` of the template.
+  ErrorObject bind(const std::shared_ptr<TensorAttr> &tensor,
+                   std::shared_ptr<Buffer> buffer) {
+    FUSILLI_RETURN_ERROR_IF(buffer == nullptr, ErrorCode::InvalidArgument,
+                            "GraphInstance buffer is null");
+    FUSILLI_ASSIGN_OR_RETURN(size_t uid, graph_->getTensorUid(tensor));
+    buffers_[uid] = buffer.get();
+    owned_[uid] = std::move(buffer);
+    return ok();
+  }
+
+  // Overload of the above binding the tensor named `name`, see
+  // `Graph::getTensor()`.
+  ErrorObject bind(const std::string &name, std::shared_ptr<Buffer> buffer) {
+    std::shared_ptr<TensorAttr> tensor = graph_->getTensor(name);
+    FUSILLI_RETURN_ERROR_IF(tensor == nullptr, ErrorCode::InvalidArgument,
+                            "Graph has no input or output named '" + name +
+                                "'");
+    return bind(tensor, std::move(buffer));
+  }
+
+  // Executes the template's graph with the bound buffers, all of which must
+  // be bound. A null `workspace` borrows the handle's workspace arena.
+  ErrorObject
+  execute(const Handle &handle,
+          const std::shared_ptr<Buffer> &workspace = nullptr) const {
+    return graph_->execute(handle, buffers_, workspace.get());
+  }
+
+  const Graph &getGraph() const { return *graph_; }
+
+private:
+  friend class GraphTemplate;
+
+  explicit GraphInstance(std::shared_ptr<const Graph> graph)
+      : graph_(std::move(graph)), buffers_(graph_->getTensorUidCount()),
+        owned_(buffers_.size()) {}
+
+  std::shared_ptr<const Graph> graph_;
+  // Raw views of `owned_`, in the form taken by the indexed
+  // `Graph::execute()` overload.
+  std::vector<Buffer *> buffers_;
+  std::vector<std::shared_ptr<Buffer>> owned_;
+};
+
+inline GraphInstance GraphTemplate::instantiate() const {
+  return GraphInstance(graph_);
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_GRAPH_TEMPLATE_H
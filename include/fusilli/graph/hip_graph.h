@@ -0,0 +1,152 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains HipGraph, which captures the execution of bound graphs
+// on a HIP stream into a HIP graph that is replayed with a single launch.
+//
+// The HIP runtime is loaded dynamically (see `detail::getHipApi()`), so
+// Fusilli does not link against it and builds without AMDGPU support are
+// unaffected.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_HIP_GRAPH_H
+#define FUSILLI_GRAPH_HIP_GRAPH_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph_sequence.h"
+#include "fusilli/support/hip_runtime.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace fusilli {
+
+// HipGraph records the invocations of a `GraphSequence` on the stream of an
+// AMDGPU handle (see `Handle::create(Backend, int, uintptr_t)`) into a HIP
+// graph, so `replay()` launches all of their kernels with one host call. This
+// targets launch-bound workloads, e.g. decode steps of LLM serving, that run
+// the same graphs on the same buffers many times.
+//
+// The capture is keyed by the bound buffers: the HIP graph bakes in their
+// device addresses, so the sequence is owned by the HipGraph and new buffers
+// require a new capture. Replays are stream-ordered like `Graph::execute()`.
+//
+// Capturing requires the handle to own a non-default stream (the null stream
+// can't be captured) and fails with `ErrorCode::RuntimeFailure` if the
+// execution synchronizes with the host, e.g. while the first execution of a
+// graph still allocates its transient resources. Run the sequence once before
+// capturing it.
+//
+// Usage:
+//   FUSILLI_CHECK_ERROR(sequence.submit(handle)); // warm up
+//   FUSILLI_ASSIGN_OR_RETURN(HipGraph step,
+//                            HipGraph::capture(handle, std::move(sequence)));
+//   for (...)
+//     FUSILLI_CHECK_ERROR(step.replay(handle));
+class HipGraph {
+public:
+  // Factory: Captures one submission of `sequence` on the stream of `handle`.
+  static ErrorOr<HipGraph> capture(const Handle &handle,
+                                   GraphSequence sequence) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Capturing HIP graph of "
+                           << sequence.size() << " graphs");
+    FUSILLI_RETURN_ERROR_IF(handle.getBackend() != Backend::AMDGPU,
+                            ErrorCode::InvalidArgument,
+                            "HipGraph::capture requires an AMDGPU handle");
+    FUSILLI_RETURN_ERROR_IF(handle.getStream() == 0,
+                            ErrorCode::InvalidArgument,
+                            "HipGraph::capture requires a handle created with "
+                            "a non-default HIP stream");
+    FUSILLI_ASSIGN_OR_RETURN(const detail::HipApi *hip, detail::getHipApi());
+    auto stream = reinterpret_cast<detail::HipApi::hipStream_t>(
+        handle.getStream());
+
+    FUSILLI_CHECK_ERROR(hip->check(
+        hip->hipStreamBeginCapture(
+            stream, detail::HipApi::hipStreamCaptureModeThreadLocal),
+        "hipStreamBeginCapture"));
+    ErrorObject submitted = sequence.submit(handle);
+    // Always end the capture, so the stream is usable again on errors.
+    detail::HipApi::hipGraph_t graph = nullptr;
+    detail::HipApi::hipError_t endErr =
+        hip->hipStreamEndCapture(stream, &graph);
+    HipGraph captured(hip, std::move(sequence), graph);
+    FUSILLI_CHECK_ERROR(submitted);
+    FUSILLI_CHECK_ERROR(hip->check(endErr, "hipStreamEndCapture"));
+
+    FUSILLI_CHECK_ERROR(hip->check(
+        hip->hipGraphInstantiate(&captured.exec_, graph, /*pErrorNode=*/nullptr,
+                                 /*pLogBuffer=*/nullptr, /*bufferSize=*/0),
+        "hipGraphInstantiate"));
+    return ok(std::move(captured));
+  }
+
+  // Launches the captured kernels on the stream of `handle`, which must be
+  // the handle the graph was captured on.
+  ErrorObject replay(const Handle &handle) const {
+    FUSILLI_RETURN_ERROR_IF(handle.getBackend() != Backend::AMDGPU ||
+                                handle.getStream() == 0,
+                            ErrorCode::InvalidArgument,
+                            "HipGraph::replay requires an AMDGPU handle with "
+                            "a non-default HIP stream");
+    FUSILLI_CHECK_ERROR(hip_->check(
+        hip_->hipGraphLaunch(
+            exec_, reinterpret_cast<detail::HipApi::hipStream_t>(
+                       handle.getStream())),
+        "hipGraphLaunch"));
+    return ok();
+  }
+
+  // Delete copy constructors, keep move constructors and destructor.
+  HipGraph(const HipGraph &) = delete;
+  HipGraph &operator=(const HipGraph &) = delete;
+  HipGraph(HipGraph &&other) noexcept
+      : hip_(other.hip_), sequence_(std::move(other.sequence_)),
+        graph_(std::exchange(other.graph_, nullptr)),
+        exec_(std::exchange(other.exec_, nullptr)) {}
+  HipGraph &operator=(HipGraph &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      hip_ = other.hip_;
+      sequence_ = std::move(other.sequence_);
+      graph_ = std::exchange(other.graph_, nullptr);
+      exec_ = std::exchange(other.exec_, nullptr);
+    }
+    return *this;
+  }
+  ~HipGraph() { destroy(); }
+
+private:
+  // Class should be constructed using `capture()`.
+  HipGraph(const detail::HipApi *hip, GraphSequence sequence,
+           detail::HipApi::hipGraph_t graph)
+      : hip_(hip), sequence_(std::move(sequence)), graph_(graph) {}
+
+  void destroy() {
+    if (exec_)
+      hip_->hipGraphExecDestroy(exec_);
+    if (graph_)
+      hip_->hipGraphDestroy(graph_);
+    exec_ = nullptr;
+    graph_ = nullptr;
+  }
+
+  const detail::HipApi *hip_;
+  // Keeps the captured artifacts and buffers alive, see `ExecutionPlan`.
+  GraphSequence sequence_;
+  detail::HipApi::hipGraph_t graph_ = nullptr;
+  detail::HipApi::hipGraphExec_t exec_ = nullptr;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_HIP_GRAPH_H
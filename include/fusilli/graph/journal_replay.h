@@ -0,0 +1,152 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the replay of usage journals (see `UsageJournal`) on a
+// build machine: every journaled graph is compiled ahead of a rollout, to
+// warm the kernel cache and optionally to write an artifact bundle, so new
+// deployments start with every kernel used in production already compiled.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_JOURNAL_REPLAY_H
+#define FUSILLI_GRAPH_JOURNAL_REPLAY_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/compile_options.h"
+#include "fusilli/backend/usage_journal.h"
+#include "fusilli/graph/artifact_bundle.h"
+#include "fusilli/graph/compile_all.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Options of `replayUsageJournal()`.
+struct JournalReplayOptions {
+  // Only entries of this backend are replayed, all of them when unset.
+  std::optional<Backend> backend;
+  // When set, the compiled artifacts are added to this writer under the ROCm
+  // target their entry ran on. Entries differing only in compile options
+  // are added once, as the bundle keys artifacts by graph structure.
+  ArtifactBundleWriter *bundle = nullptr;
+  // Number of graphs compiled concurrently, 0 for the hardware concurrency.
+  size_t parallelism = 0;
+};
+
+// Compiles the graphs of `entries` (see `UsageJournal::read()`) with their
+// journaled compile options, leaving the artifacts in the kernel cache of
+// this machine, and adds them to `options.bundle` when set. On AMDGPU, each
+// graph is compiled for the ROCm target it ran on, which this machine need
+// not have.
+//
+// Entries skipped for `options.backend` succeed. A failure to replay one
+// entry does not affect the others, e.g. a graph journaled by another
+// version of Fusilli whose fingerprint no longer matches. Returns one status
+// per entry, in the same order as `entries`.
+//
+// Usage (build machine):
+//   FUSILLI_ASSIGN_OR_RETURN(auto entries, UsageJournal::read(journalDir));
+//   ArtifactBundleWriter writer;
+//   replayUsageJournal(entries, {.bundle = &writer});
+//   FUSILLI_CHECK_ERROR(writer.write("kernels.fusilli"));
+inline std::vector<ErrorObject>
+replayUsageJournal(std::span<const UsageJournalEntry> entries,
+                   const JournalReplayOptions &options = {}) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Replaying usage journal of "
+                         << entries.size() << " graphs");
+  std::vector<ErrorObject> statuses(entries.size(), ok());
+  std::vector<std::unique_ptr<Graph>> graphs(entries.size());
+  std::vector<std::vector<uint8_t>> vmfbs(entries.size());
+
+  // Graphs sharing a name share a per-graph cache directory, so they are
+  // compiled back to back (see `compileAll()`).
+  std::vector<std::vector<size_t>> groups;
+  std::unordered_map<std::string, size_t> groupOfName;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (options.backend.has_value() && entries[i].backend != *options.backend)
+      continue;
+    auto [it, inserted] =
+        groupOfName.try_emplace(entries[i].graphName, groups.size());
+    if (inserted)
+      groups.emplace_back();
+    groups[it->second].push_back(i);
+  }
+
+  auto replay = [&](size_t i) -> ErrorObject {
+    const UsageJournalEntry &entry = entries[i];
+    FUSILLI_ASSIGN_OR_RETURN(std::unique_ptr<Graph> graph,
+                             Graph::deserialize(entry.graph));
+    CompileOptions compileOptions =
+        CompileOptions::fromString(entry.compileOptions);
+    // Only pinned when it differs from the default target, which would
+    // change the kernel cache key of the artifact.
+    if (!entry.target.empty() &&
+        detail::getRocmTarget(compileOptions.resolveFlags(entry.backend)) !=
+            entry.target)
+      compileOptions.setRocmTarget(entry.target);
+    graph->setName(entry.graphName).setCompileOptions(compileOptions);
+    FUSILLI_CHECK_ERROR(graph->validate());
+    FUSILLI_ASSIGN_OR_RETURN(std::string fingerprint, graph->getFingerprint());
+    FUSILLI_RETURN_ERROR_IF(fingerprint != entry.fingerprint,
+                            ErrorCode::InvalidArgument,
+                            "Journaled graph '" + entry.graphName +
+                                "' no longer matches its fingerprint, it was "
+                                "journaled with another Fusilli version");
+    FUSILLI_ASSIGN_OR_RETURN(vmfbs[i],
+                             graph->compileToArtifact(entry.backend,
+                                                      compileOptions,
+                                                      /*remove=*/false));
+    graphs[i] = std::move(graph);
+    return ok();
+  };
+  // Each worker writes to distinct slots.
+  detail::runGroupsInParallel(
+      groups, options.parallelism, [&](const std::vector<size_t> &group) {
+        for (size_t i : group)
+          statuses[i] = replay(i);
+      });
+
+  if (options.bundle) {
+    std::unordered_set<std::string> added;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      if (!graphs[i])
+        continue;
+      const UsageJournalEntry &entry = entries[i];
+      ErrorOr<std::string> key =
+          getArtifactBundleKey(*graphs[i], entry.backend, entry.target);
+      if (isError(key)) {
+        statuses[i] = ErrorObject(key);
+        continue;
+      }
+      if (added.insert(*key).second)
+        statuses[i] = options.bundle->add(*graphs[i], entry.backend,
+                                          std::move(vmfbs[i]), entry.target);
+    }
+  }
+
+  for (size_t i = 0; i < entries.size(); ++i)
+    if (isError(statuses[i]))
+      FUSILLI_LOG_LABEL_ENDL("ERROR: Failed to replay journaled graph '"
+                             << entries[i].graphName << "': " << statuses[i]);
+  return statuses;
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_JOURNAL_REPLAY_H
@@ -0,0 +1,323 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains PartitionedGraph, which splits a large graph into
+// subgraphs that compile concurrently and execute back to back.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_PARTITION_H
+#define FUSILLI_GRAPH_PARTITION_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/compile_all.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/graph/graph_sequence.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// PartitionedGraph trades a little fusion for much faster compiles of very
+// large graphs, e.g. during development. IREE compiles one module on one
+// thread, so a graph of hundreds of nodes can take minutes; split into
+// partitions, it compiles on a pool of worker threads (see
+// `compileAllToArtifacts()`).
+//
+// The (top-level, topologically ordered) nodes of the graph are split into
+// contiguous runs of at most `maxNodesPerPartition` nodes. Each cut is placed
+// at the cheapest point near its balanced position, the one where the fewest
+// bytes of intermediate tensors cross it. Crossing intermediates become
+// outputs of the partition producing them and inputs of the ones consuming
+// them, and live in device buffers allocated by `compile()`, so they never
+// leave the device. Partitions execute in order like a `GraphSequence`.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(PartitionedGraph partitioned,
+//                            PartitionedGraph::create(std::move(graph), 64));
+//   FUSILLI_CHECK_ERROR(partitioned.compile(handle));
+//   FUSILLI_ASSIGN_OR_RETURN(size_t workspaceSize,
+//                            partitioned.getWorkspaceSize());
+//   ...
+//   FUSILLI_CHECK_ERROR(partitioned.execute(handle, variantPack, workspace));
+class PartitionedGraph {
+public:
+  // Splits the validated `graph` into partitions of at most
+  // `maxNodesPerPartition` nodes. The partitions take over the nodes and
+  // tensors of `graph`, which is left empty. The variant pack of `graph`
+  // executes the partitioned graph.
+  //
+  // Graphs with in-place outputs are not supported, nor are cuts crossed by
+  // intermediates with dynamic dims (no cut is placed there).
+  static ErrorOr<PartitionedGraph> create(Graph &&graph,
+                                          size_t maxNodesPerPartition) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Partitioning Graph '" << graph.getName()
+                                                        << "'");
+    FUSILLI_RETURN_ERROR_IF(
+        !graph.isValidated_, ErrorCode::NotValidated,
+        "Graph must be validated before being partitioned");
+    FUSILLI_RETURN_ERROR_IF(maxNodesPerPartition == 0,
+                            ErrorCode::InvalidArgument,
+                            "Partitions must hold at least one node");
+    FUSILLI_RETURN_ERROR_IF(
+        std::ranges::any_of(graph.fullGraphOutputs_,
+                            [](const std::shared_ptr<TensorAttr> &t) {
+                              return t->isInPlace();
+                            }),
+        ErrorCode::NotImplemented,
+        "Graphs with in-place outputs can't be partitioned");
+
+    const std::vector<std::shared_ptr<INode>> &nodes = graph.subNodes_;
+    size_t numNodes = nodes.size();
+    size_t numPartitions =
+        std::max<size_t>(1, (numNodes + maxNodesPerPartition - 1) /
+                                maxNodesPerPartition);
+
+    // The cost of cut `p` (between nodes p - 1 and p) is the size of the
+    // intermediates produced before it and consumed after it.
+    std::unordered_map<std::shared_ptr<TensorAttr>, size_t> producer;
+    std::unordered_map<std::shared_ptr<TensorAttr>, size_t> lastConsumer;
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    for (size_t i = 0; i < numNodes; ++i) {
+      ins.clear();
+      outs.clear();
+      nodes[i]->collectTensors(ins, outs);
+      for (const auto &t : outs)
+        producer[t] = i;
+      for (const auto &t : ins)
+        lastConsumer[t] = i;
+    }
+    std::vector<int64_t> cost(numNodes + 1, 0);
+    std::vector<bool> blocked(numNodes + 1, false);
+    for (const auto &[t, last] : lastConsumer) {
+      auto it = producer.find(t);
+      if (!t->isVirtual() || it == producer.end())
+        continue;
+      bool isDynamic = t->hasDynamicDims();
+      int64_t bytes = isDynamic ? 0 : getTensorBytes(*t);
+      for (size_t p = it->second + 1; p <= last; ++p) {
+        cost[p] += bytes;
+        blocked[p] = blocked[p] || isDynamic;
+      }
+    }
+
+    // Pick each cut greedily, leaving room for the remaining partitions.
+    std::vector<size_t> cuts = {0};
+    for (size_t k = 1; k < numPartitions; ++k) {
+      size_t start = cuts.back();
+      size_t remaining = numPartitions - k;
+      size_t lo = std::max(start + 1,
+                           numNodes > remaining * maxNodesPerPartition
+                               ? numNodes - remaining * maxNodesPerPartition
+                               : 0);
+      size_t hi = std::min(start + maxNodesPerPartition, numNodes - remaining);
+      size_t ideal = k * numNodes / numPartitions;
+      std::optional<size_t> best;
+      auto distance = [&](size_t p) {
+        return p > ideal ? p - ideal : ideal - p;
+      };
+      for (size_t p = lo; p <= hi; ++p) {
+        if (blocked[p])
+          continue;
+        if (!best || cost[p] < cost[*best] ||
+            (cost[p] == cost[*best] && distance(p) < distance(*best)))
+          best = p;
+      }
+      FUSILLI_RETURN_ERROR_IF(
+          !best.has_value(), ErrorCode::NotImplemented,
+          "Graph can't be partitioned without cutting through intermediate "
+          "tensors with dynamic dims");
+      cuts.push_back(*best);
+    }
+    cuts.push_back(numNodes);
+
+    PartitionedGraph partitioned;
+    for (size_t k = 0; k + 1 < cuts.size(); ++k) {
+      auto partition = std::make_unique<Graph>();
+      partition->context = graph.context;
+      partition->setName(graph.getName() + "_part" + std::to_string(k));
+      partition->compileOptions_ = graph.compileOptions_;
+      partition->compileInMemory_ = graph.compileInMemory_;
+      std::unordered_set<std::shared_ptr<TensorAttr>> produced;
+      for (size_t i = cuts[k]; i < cuts[k + 1]; ++i) {
+        partition->subNodes_.push_back(nodes[i]);
+        ins.clear();
+        outs.clear();
+        nodes[i]->collectTensors(ins, outs);
+        for (const auto &t : ins)
+          if (!produced.contains(t))
+            partition->fullGraphInputs_.insert(t);
+        for (const auto &t : outs) {
+          produced.insert(t);
+          partition->fullGraphOutputs_.insert(t);
+          // Intermediates consumed by a later partition become outputs.
+          auto it = lastConsumer.find(t);
+          if (t->isVirtual() && it != lastConsumer.end() &&
+              it->second >= cuts[k + 1]) {
+            t->setIsVirtual(false);
+            partitioned.intermediates_.push_back(t);
+          }
+        }
+      }
+      partitioned.partitions_.push_back(std::move(partition));
+    }
+    graph.subNodes_.clear();
+    graph.fullGraphInputs_.clear();
+    graph.fullGraphOutputs_.clear();
+    graph.isValidated_ = false;
+
+    for (const auto &partition : partitioned.partitions_)
+      FUSILLI_CHECK_ERROR(partition->validate());
+    FUSILLI_LOG_LABEL_ENDL("INFO: Partitioned Graph into "
+                           << partitioned.partitions_.size()
+                           << " partitions, with "
+                           << partitioned.intermediates_.size()
+                           << " intermediate tensors crossing cuts");
+    return ok(std::move(partitioned));
+  }
+
+  // Compiles the partitions concurrently (see `compileAll()`) and allocates
+  // the device buffers of the intermediates crossing cuts on `handle`.
+  // Returns the first failure, if any.
+  ErrorObject compile(const Handle &handle, size_t parallelism = 0,
+                      bool remove = false) {
+    std::vector<Graph *> graphs = getPartitionPointers();
+    std::vector<ErrorObject> statuses =
+        compileAll(graphs, handle, parallelism, remove);
+    for (ErrorObject &status : statuses)
+      FUSILLI_CHECK_ERROR(status);
+
+    intermediateBuffers_.clear();
+    for (const auto &t : intermediates_) {
+      std::vector<iree_hal_dim_t> shape;
+      for (int64_t dim : t->getStorageDim())
+        shape.push_back(static_cast<iree_hal_dim_t>(dim));
+      FUSILLI_ASSIGN_OR_RETURN(
+          Buffer buffer,
+          Buffer::allocateUninitialized(handle, shape, t->getDataType()));
+      intermediateBuffers_.emplace(t,
+                                   std::make_shared<Buffer>(std::move(buffer)));
+    }
+    return ok();
+  }
+
+  // Returns the workspace size in bytes required by `execute()`. Partitions
+  // execute one after the other and share the workspace, so this is the
+  // largest size among them.
+  ErrorOr<size_t> getWorkspaceSize() {
+    size_t workspaceSize = 0;
+    for (const auto &partition : partitions_) {
+      FUSILLI_ASSIGN_OR_RETURN(std::optional<size_t> size,
+                               partition->getWorkspaceSize());
+      workspaceSize = std::max(workspaceSize, size.value_or(0));
+    }
+    return ok(workspaceSize);
+  }
+
+  // Executes the partitions in order with the buffers of the inputs and
+  // outputs of the original graph in `variantPack`. Stops at the first
+  // failing partition, whose error is returned.
+  ErrorObject
+  execute(const Handle &handle,
+          const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                   std::shared_ptr<Buffer>> &variantPack,
+          const std::shared_ptr<Buffer> &workspace) const {
+    FUSILLI_ASSIGN_OR_RETURN(auto pack, getPartitionVariantPack(variantPack));
+    for (const auto &partition : partitions_)
+      FUSILLI_CHECK_ERROR(partition->execute(handle, pack, workspace));
+    return ok();
+  }
+
+  // Binds the partitions to `variantPack` and `workspace` (see
+  // `Graph::bind()`) and appends them to `sequence` in order, for repeated
+  // submissions without host overhead.
+  ErrorObject
+  appendTo(GraphSequence &sequence,
+           const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                    std::shared_ptr<Buffer>> &variantPack,
+           const std::shared_ptr<Buffer> &workspace) const {
+    FUSILLI_ASSIGN_OR_RETURN(auto pack, getPartitionVariantPack(variantPack));
+    for (const auto &partition : partitions_)
+      FUSILLI_CHECK_ERROR(sequence.append(*partition, pack, workspace));
+    return ok();
+  }
+
+  size_t getPartitionCount() const { return partitions_.size(); }
+
+  const Graph &getPartition(size_t index) const { return *partitions_[index]; }
+
+  // Intermediate tensors of the original graph crossing cuts.
+  const std::vector<std::shared_ptr<TensorAttr>> &getIntermediates() const {
+    return intermediates_;
+  }
+
+private:
+  PartitionedGraph() = default;
+
+  static int64_t getTensorBytes(const TensorAttr &t) {
+    ErrorOr<iree_hal_element_type_t> elementType =
+        getIreeHalElementType(t.getDataType());
+    int64_t elementBytes =
+        isError(elementType)
+            ? 1
+            : static_cast<int64_t>(
+                  iree_hal_element_dense_byte_count(*elementType));
+    return t.getVolume() * std::max<int64_t>(elementBytes, 1);
+  }
+
+  std::vector<Graph *> getPartitionPointers() const {
+    std::vector<Graph *> graphs;
+    graphs.reserve(partitions_.size());
+    for (const auto &partition : partitions_)
+      graphs.push_back(partition.get());
+    return graphs;
+  }
+
+  // Returns `variantPack` extended with the buffers of the intermediates.
+  ErrorOr<std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>>>
+  getPartitionVariantPack(
+      const std::unordered_map<std::shared_ptr<TensorAttr>,
+                               std::shared_ptr<Buffer>> &variantPack) const {
+    FUSILLI_RETURN_ERROR_IF(intermediateBuffers_.size() !=
+                                intermediates_.size(),
+                            ErrorCode::NotCompiled,
+                            "PartitionedGraph must be compiled before being "
+                            "executed");
+    auto pack = variantPack;
+    for (const auto &[t, buffer] : intermediateBuffers_) {
+      FUSILLI_RETURN_ERROR_IF(!pack.emplace(t, buffer).second,
+                              ErrorCode::VariantPackError,
+                              "Intermediate tensor '" + t->getName() +
+                                  "' found in variantPack");
+    }
+    return ok(std::move(pack));
+  }
+
+  std::vector<std::unique_ptr<Graph>> partitions_;
+  std::vector<std::shared_ptr<TensorAttr>> intermediates_;
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      intermediateBuffers_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_PARTITION_H
@@ -0,0 +1,139 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains PriorityScheduler, which routes graph executions to the
+// queues of a handle by priority class.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_PRIORITY_SCHEDULER_H
+#define FUSILLI_GRAPH_PRIORITY_SCHEDULER_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fusilli {
+
+// PriorityScheduler lets latency-critical and background graphs share a GPU
+// without the background work delaying the critical one: executions are
+// routed by their priority class to the queues of the handle whose streams
+// have that priority (see the prioritized `Handle::create()` overload), so
+// the GPU dispatches the kernels of interactive inference ahead of those of
+// bulk work queued earlier.
+//
+// Executions of a class are spread round-robin over the queues of that
+// class. A class without queues falls back to the queues of the closest
+// priority. On handles without prioritized streams (e.g. CPU handles) every
+// execution is placed like by `Graph::execute()`.
+//
+// Usage:
+//   std::vector<StreamPriority> priorities = {StreamPriority::High,
+//                                             StreamPriority::Low};
+//   FUSILLI_ASSIGN_OR_RETURN(Handle handle,
+//                            Handle::create(Backend::AMDGPU, 0, priorities));
+//   PriorityScheduler scheduler(handle);
+//   // Interactive requests:
+//   FUSILLI_CHECK_ERROR(scheduler.execute(chatGraph, StreamPriority::High,
+//                                         chatPack, nullptr));
+//   // Bulk work, e.g. from another thread:
+//   FUSILLI_CHECK_ERROR(scheduler.execute(embedGraph, StreamPriority::Low,
+//                                         embedPack, nullptr));
+class PriorityScheduler {
+public:
+  // Routes executions to the queues of `handle`, which must outlive the
+  // scheduler.
+  explicit PriorityScheduler(const Handle &handle) : handle_(handle) {
+    for (size_t queue = 0; queue < handle.getQueueCount(); ++queue)
+      prioritized_ |= handle.getQueue(queue).getStreamPriority() !=
+                      StreamPriority::Normal;
+    for (size_t cls = 0; cls < kClassCount; ++cls) {
+      // Queues of the closest priority present on the handle.
+      int bestDistance = std::numeric_limits<int>::max();
+      for (size_t queue = 0; queue < handle.getQueueCount(); ++queue) {
+        int distance = std::abs(
+            static_cast<int>(handle.getQueue(queue).getStreamPriority()) -
+            static_cast<int>(cls));
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          queues_[cls].clear();
+        }
+        if (distance == bestDistance)
+          queues_[cls].push_back(queue);
+      }
+    }
+  }
+
+  // Returns the queue index the next execution of `priority` runs on
+  // (thread-safe).
+  size_t nextQueueIndex(StreamPriority priority) {
+    if (!prioritized_)
+      return handle_.nextQueueIndex();
+    size_t cls = static_cast<size_t>(priority);
+    const std::vector<size_t> &queues = queues_[cls];
+    return queues[cursors_[cls].fetch_add(1, std::memory_order_relaxed) %
+                  queues.size()];
+  }
+
+  // Executes `graph` (compiled on the scheduler's handle) on a queue of
+  // `priority`, see `Graph::execute()`. A null `workspace` borrows the
+  // workspace arena of that queue.
+  ErrorObject
+  execute(const Graph &graph, StreamPriority priority,
+          const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                   std::shared_ptr<Buffer>> &variantPack,
+          const std::shared_ptr<Buffer> &workspace) {
+    size_t queue = nextQueueIndex(priority);
+    FUSILLI_LOG_LABEL_ENDL("INFO: Routing "
+                           << kStreamPriorityToStr.at(priority)
+                           << " priority execution of Graph '"
+                           << graph.getName() << "' to queue " << queue);
+    counts_[static_cast<size_t>(priority)].fetch_add(
+        1, std::memory_order_relaxed);
+    return graph.execute(handle_, variantPack, workspace, queue);
+  }
+
+  // Returns the number of executions routed with `priority`.
+  uint64_t getExecuteCount(StreamPriority priority) const {
+    return counts_[static_cast<size_t>(priority)].load(
+        std::memory_order_relaxed);
+  }
+
+  // Delete copy and move constructors, the atomics are shared by threads.
+  PriorityScheduler(const PriorityScheduler &) = delete;
+  PriorityScheduler &operator=(const PriorityScheduler &) = delete;
+
+private:
+  static constexpr size_t kClassCount =
+      static_cast<size_t>(StreamPriority::High) + 1;
+
+  const Handle &handle_;
+  // Whether any queue of the handle has a non-default priority.
+  bool prioritized_ = false;
+  // Queue indices of each priority class, and the round-robin cursor and
+  // execution count of each class.
+  std::array<std::vector<size_t>, kClassCount> queues_;
+  std::array<std::atomic<size_t>, kClassCount> cursors_ = {};
+  std::array<std::atomic<uint64_t>, kClassCount> counts_ = {};
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_PRIORITY_SCHEDULER_H
@@ -0,0 +1,422 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains SplitExecutor, which executes each batch of a
+// dynamic-batch graph split across several devices (e.g. the CPU and a GPU)
+// in proportion to their measured throughput.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_SPLIT_EXECUTOR_H
+#define FUSILLI_GRAPH_SPLIT_EXECUTOR_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/backend/host_transfer.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// A device of a `SplitExecutor`: a handle, the graph compiled on it and the
+// buffers of the graph's shared inputs (e.g. weights) on its device.
+struct SplitDevice {
+  // Must outlive the executor.
+  const Handle *handle = nullptr;
+  std::shared_ptr<const Graph> graph;
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      sharedBuffers;
+};
+
+// Options of a `SplitExecutor`.
+struct SplitExecutorOptions {
+  // Largest number of rows (along the batch dim) of a batch.
+  int64_t maxBatchSize = 64;
+  // Weight of the latest batch in the running throughput estimates.
+  double throughputWeight = 0.25;
+};
+
+// SplitExecutor adds the otherwise idle cores of a big host CPU to the
+// throughput of a GPU for batch inference: each batch is split between the
+// devices along its batch dim, and the slices execute concurrently, one
+// thread per device. Slices are sized in proportion to the throughput (rows
+// per second, including transfers) measured on each device over the previous
+// batches; until every device was measured, batches are split evenly.
+//
+// Each device executes its own instance of the graph, compiled for its
+// backend (a graph holds the artifact of one backend, see
+// `Graph::compile()`): build the graph once per device, or reuse artifacts
+// compiled ahead of time for each backend (see `Graph::compileToArtifact()`).
+// The instances must be structurally identical, so their tensors correspond
+// by UID; batches are keyed by the tensors of the first device's graph. As
+// with `BatchScheduler`, the batched inputs and outputs must have dim 0
+// dynamic and outermost in memory, and every other input must be bound to a
+// shared buffer on each device.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(
+//       SplitExecutor executor,
+//       SplitExecutor::create({{&gpuHandle, gpuGraph, {{gpuW, gpuWBuf}}},
+//                              {&cpuHandle, cpuGraph, {{cpuW, cpuWBuf}}}}));
+//   for (auto &batch : batches)
+//     FUSILLI_CHECK_ERROR(executor.execute(
+//         batch.rows, {{xT, std::as_bytes(std::span(batch.input))}},
+//         {{yT, std::as_writable_bytes(std::span(batch.output))}}));
+class SplitExecutor {
+public:
+  // Host memory of the batched inputs and outputs of a batch, each holding
+  // the rows of the batch back to back.
+  using HostInputs = std::unordered_map<std::shared_ptr<TensorAttr>,
+                                        std::span<const std::byte>>;
+  using HostOutputs =
+      std::unordered_map<std::shared_ptr<TensorAttr>, std::span<std::byte>>;
+
+  // Creates an executor over `devices`, whose graphs must be compiled on
+  // their handles.
+  static ErrorOr<SplitExecutor>
+  create(std::vector<SplitDevice> devices,
+         const SplitExecutorOptions &options = {}) {
+    FUSILLI_RETURN_ERROR_IF(devices.empty(), ErrorCode::InvalidArgument,
+                            "SplitExecutor requires at least one device");
+    FUSILLI_RETURN_ERROR_IF(options.maxBatchSize <= 0 ||
+                                options.throughputWeight <= 0 ||
+                                options.throughputWeight > 1,
+                            ErrorCode::InvalidArgument,
+                            "SplitExecutor requires a positive max batch size "
+                            "and a throughput weight in (0, 1]");
+    for (const SplitDevice &device : devices)
+      FUSILLI_RETURN_ERROR_IF(device.handle == nullptr ||
+                                  device.graph == nullptr,
+                              ErrorCode::InvalidArgument,
+                              "SplitExecutor device has no handle or graph");
+    SplitExecutor executor(options);
+    FUSILLI_CHECK_ERROR(executor.initialize(std::move(devices)));
+    return ok(std::move(executor));
+  }
+
+  // Executes a batch of `rows` rows split across the devices, uploading the
+  // inputs from and downloading the outputs to host memory. Every batched
+  // tensor must be in `inputs` or `outputs`, with `rows` rows. Blocks until
+  // the outputs are in host memory, and returns the first error of a device,
+  // if any.
+  ErrorObject execute(int64_t rows, const HostInputs &inputs,
+                      const HostOutputs &outputs) {
+    FUSILLI_RETURN_ERROR_IF(rows <= 0 || rows > options_.maxBatchSize,
+                            ErrorCode::InvalidArgument,
+                            "SplitExecutor batch of " + std::to_string(rows) +
+                                " rows exceeds the max batch size " +
+                                std::to_string(options_.maxBatchSize));
+    FUSILLI_RETURN_ERROR_IF(inputs.size() + outputs.size() != batched_.size(),
+                            ErrorCode::VariantPackError,
+                            "SplitExecutor batch has host memory for tensors "
+                            "that are not batched");
+    // Host memory of each batched tensor, with an empty span on the side
+    // (input or output) it is not on.
+    std::vector<std::span<const std::byte>> hostInputs(batched_.size());
+    std::vector<std::span<std::byte>> hostOutputs(batched_.size());
+    for (size_t i = 0; i < batched_.size(); ++i) {
+      const std::shared_ptr<TensorAttr> &tensor = batched_[i].tensor;
+      size_t size = 0;
+      if (auto it = inputs.find(tensor); it != inputs.end()) {
+        hostInputs[i] = it->second;
+        size = it->second.size();
+      } else if (auto it = outputs.find(tensor); it != outputs.end()) {
+        hostOutputs[i] = it->second;
+        size = it->second.size();
+      } else {
+        return error(ErrorCode::VariantPackError,
+                     "SplitExecutor batch has no host memory for tensor '" +
+                         tensor->getName() + "'");
+      }
+      size_t expected = batched_[i].rowBytes * static_cast<size_t>(rows);
+      FUSILLI_RETURN_ERROR_IF(size != expected, ErrorCode::VariantPackError,
+                              "SplitExecutor host memory of tensor '" +
+                                  tensor->getName() + "' holds " +
+                                  std::to_string(size) + " bytes, expected " +
+                                  std::to_string(expected));
+    }
+
+    std::vector<int64_t> split = getSplit(rows);
+    std::vector<ErrorObject> statuses(devices_.size(), ok());
+    std::vector<std::chrono::nanoseconds> elapsed(devices_.size());
+    auto runDevice = [&](size_t d, int64_t firstRow) {
+      auto start = std::chrono::steady_clock::now();
+      statuses[d] = executeSlice(devices_[d], firstRow, split[d], hostInputs,
+                                 hostOutputs);
+      elapsed[d] = std::chrono::steady_clock::now() - start;
+    };
+    // The first device runs on the calling thread, the others on their own.
+    std::vector<std::thread> threads;
+    int64_t firstRow = split[0];
+    for (size_t d = 1; d < devices_.size(); ++d) {
+      if (split[d] > 0)
+        threads.emplace_back(runDevice, d, firstRow);
+      firstRow += split[d];
+    }
+    if (split[0] > 0)
+      runDevice(0, 0);
+    for (std::thread &thread : threads)
+      thread.join();
+
+    for (size_t d = 0; d < devices_.size(); ++d) {
+      FUSILLI_CHECK_ERROR(statuses[d]);
+      if (split[d] > 0)
+        recordThroughput(devices_[d], split[d], elapsed[d]);
+    }
+    batchCount_++;
+    return ok();
+  }
+
+  // Returns the rows of a batch of `rows` rows each device would execute:
+  // proportional to the measured throughputs, or even until every device
+  // was measured.
+  std::vector<int64_t> getSplit(int64_t rows) const {
+    std::vector<double> shares(devices_.size(), 1.0);
+    if (std::ranges::all_of(devices_,
+                            [](const Device &d) { return d.throughput > 0; }))
+      for (size_t d = 0; d < devices_.size(); ++d)
+        shares[d] = devices_[d].throughput;
+    double total = std::accumulate(shares.begin(), shares.end(), 0.0);
+
+    // Round down, then hand the remaining rows out by largest remainder.
+    std::vector<int64_t> split(devices_.size());
+    std::vector<std::pair<double, size_t>> remainders;
+    int64_t assigned = 0;
+    for (size_t d = 0; d < devices_.size(); ++d) {
+      double exact = static_cast<double>(rows) * shares[d] / total;
+      split[d] = static_cast<int64_t>(std::floor(exact));
+      assigned += split[d];
+      remainders.emplace_back(exact - std::floor(exact), d);
+    }
+    std::ranges::stable_sort(remainders, [](const auto &a, const auto &b) {
+      return a.first > b.first;
+    });
+    for (size_t i = 0; assigned < rows; ++i, ++assigned)
+      split[remainders[i % remainders.size()].second]++;
+    return split;
+  }
+
+  // Returns the throughput estimate of each device in rows per second, 0
+  // until the device executed a slice.
+  std::vector<double> getThroughputs() const {
+    std::vector<double> throughputs;
+    for (const Device &device : devices_)
+      throughputs.push_back(device.throughput);
+    return throughputs;
+  }
+
+  // Number of executed batches.
+  uint64_t getBatchCount() const { return batchCount_; }
+
+  const SplitExecutorOptions &getOptions() const { return options_; }
+
+  // Delete copy constructors, keep move constructors.
+  SplitExecutor(const SplitExecutor &) = delete;
+  SplitExecutor &operator=(const SplitExecutor &) = delete;
+  SplitExecutor(SplitExecutor &&) noexcept = default;
+  SplitExecutor &operator=(SplitExecutor &&) noexcept = default;
+  ~SplitExecutor() = default;
+
+private:
+  // A batched graph input or output and the byte size of one of its rows.
+  struct BatchedTensor {
+    // Tensor of the first device's graph, keying the host memory.
+    std::shared_ptr<TensorAttr> tensor;
+    size_t uid;
+    std::vector<iree_hal_dim_t> rowShape;
+    size_t rowBytes;
+  };
+
+  // A device, its batch buffers (indexed like `batched_`) and its
+  // throughput estimate.
+  struct Device {
+    const Handle *handle;
+    std::shared_ptr<const Graph> graph;
+    std::vector<std::shared_ptr<Buffer>> shared;
+    // Buffers of the shared tensors indexed by UID, with null entries for
+    // the batched tensors.
+    std::vector<Buffer *> uidBuffers;
+    std::vector<std::shared_ptr<Buffer>> batchBuffers;
+    double throughput = 0;
+  };
+
+  explicit SplitExecutor(const SplitExecutorOptions &options)
+      : options_(options) {}
+
+  // Checks that the graphs of `devices` match, splits their tensors into
+  // batched and shared ones and allocates the batch buffers of each device.
+  ErrorObject initialize(std::vector<SplitDevice> devices) {
+    const auto &tensors = devices.front().graph->getTensorsByUid();
+    for (size_t uid = 0; uid < tensors.size(); ++uid) {
+      const std::shared_ptr<TensorAttr> &tensor = tensors[uid];
+      if (!tensor->hasDynamicDims())
+        continue;
+      FUSILLI_RETURN_ERROR_IF(
+          tensor->getDynamicDims() != std::vector<size_t>{0} ||
+              tensor->getLogicalToPhysicalPermuteOrder().front() != 0,
+          ErrorCode::NotImplemented,
+          "SplitExecutor requires tensor '" + tensor->getName() +
+              "' to only have its outermost dim 0 dynamic");
+      FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                               getIreeHalElementType(tensor->getDataType()));
+      FUSILLI_RETURN_ERROR_IF(
+          iree_hal_element_bit_count(elementType) % 8 != 0,
+          ErrorCode::NotImplemented,
+          "SplitExecutor requires byte-aligned elements for tensor '" +
+              tensor->getName() + "'");
+      BatchedTensor batched{tensor, uid, {}, 0};
+      for (int64_t dim : tensor->getStorageDim())
+        batched.rowShape.push_back(static_cast<iree_hal_dim_t>(dim));
+      batched.rowShape[0] = 1;
+      iree_device_size_t rowBytes = 0;
+      FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+          batched.rowShape.size(), batched.rowShape.data(), elementType,
+          IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &rowBytes));
+      batched.rowBytes = static_cast<size_t>(rowBytes);
+      batched_.push_back(std::move(batched));
+    }
+    FUSILLI_RETURN_ERROR_IF(batched_.empty(), ErrorCode::InvalidArgument,
+                            "SplitExecutor graph has no tensor with a "
+                            "dynamic batch dim");
+
+    for (SplitDevice &splitDevice : devices) {
+      const auto &deviceTensors = splitDevice.graph->getTensorsByUid();
+      FUSILLI_RETURN_ERROR_IF(deviceTensors.size() != tensors.size(),
+                              ErrorCode::InvalidArgument,
+                              "SplitExecutor device graphs differ in their "
+                              "inputs and outputs");
+      Device device{splitDevice.handle,
+                    std::move(splitDevice.graph),
+                    {},
+                    std::vector<Buffer *>(tensors.size()),
+                    {}};
+      for (size_t uid = 0; uid < tensors.size(); ++uid) {
+        const std::shared_ptr<TensorAttr> &tensor = deviceTensors[uid];
+        FUSILLI_RETURN_ERROR_IF(
+            tensor->getName() != tensors[uid]->getName() ||
+                tensor->getDim() != tensors[uid]->getDim() ||
+                tensor->getDataType() != tensors[uid]->getDataType() ||
+                tensor->getDynamicDims() != tensors[uid]->getDynamicDims(),
+            ErrorCode::InvalidArgument,
+            "SplitExecutor device graphs differ in tensor '" +
+                tensors[uid]->getName() + "'");
+        if (tensor->hasDynamicDims())
+          continue;
+        auto it = splitDevice.sharedBuffers.find(tensor);
+        FUSILLI_RETURN_ERROR_IF(
+            it == splitDevice.sharedBuffers.end() || it->second == nullptr,
+            ErrorCode::VariantPackError,
+            "SplitExecutor device has no shared buffer for tensor '" +
+                tensor->getName() + "' without a dynamic batch dim");
+        device.uidBuffers[uid] = it->second.get();
+        device.shared.push_back(it->second);
+      }
+      for (const BatchedTensor &batched : batched_) {
+        FUSILLI_ASSIGN_OR_RETURN(
+            Buffer buffer,
+            Buffer::allocateRaw(*device.handle,
+                                batched.rowBytes * static_cast<size_t>(
+                                                       options_.maxBatchSize)));
+        device.batchBuffers.push_back(
+            std::make_shared<Buffer>(std::move(buffer)));
+      }
+      devices_.push_back(std::move(device));
+    }
+    return ok();
+  }
+
+  // Executes rows [firstRow, firstRow + rows) of the batch held in
+  // `hostInputs` and `hostOutputs` (indexed like `batched_`) on `device`.
+  ErrorObject
+  executeSlice(const Device &device, int64_t firstRow, int64_t rows,
+               const std::vector<std::span<const std::byte>> &hostInputs,
+               const std::vector<std::span<std::byte>> &hostOutputs) const {
+    std::vector<Buffer> views;
+    views.reserve(batched_.size());
+    std::vector<HostTransfer> uploads;
+    for (size_t i = 0; i < batched_.size(); ++i) {
+      const BatchedTensor &batched = batched_[i];
+      std::vector<iree_hal_dim_t> shape = batched.rowShape;
+      shape[0] = static_cast<iree_hal_dim_t>(rows);
+      FUSILLI_ASSIGN_OR_RETURN(
+          Buffer view, device.batchBuffers[i]->subview(
+                           /*byteOffset=*/0, shape,
+                           batched.tensor->getDataType()));
+      views.push_back(std::move(view));
+      if (hostInputs[i].empty())
+        continue;
+      std::span<const std::byte> slice = hostInputs[i].subspan(
+          batched.rowBytes * static_cast<size_t>(firstRow),
+          batched.rowBytes * static_cast<size_t>(rows));
+      FUSILLI_ASSIGN_OR_RETURN(HostTransfer upload,
+                               views[i].writeAsync(*device.handle, slice));
+      uploads.push_back(std::move(upload));
+    }
+    for (HostTransfer &upload : uploads)
+      FUSILLI_CHECK_ERROR(upload.wait());
+
+    std::vector<Buffer *> buffers = device.uidBuffers;
+    for (size_t i = 0; i < batched_.size(); ++i)
+      buffers[batched_[i].uid] = &views[i];
+    FUSILLI_LOG_LABEL_ENDL("INFO: Executing " << rows << " rows of a split "
+                                              "batch on "
+                                              << device.handle->getBackend());
+    FUSILLI_CHECK_ERROR(device.graph->execute(*device.handle, buffers,
+                                              /*workspace=*/nullptr));
+
+    for (size_t i = 0; i < batched_.size(); ++i) {
+      if (hostOutputs[i].empty())
+        continue;
+      std::span<std::byte> slice = hostOutputs[i].subspan(
+          batched_[i].rowBytes * static_cast<size_t>(firstRow),
+          batched_[i].rowBytes * static_cast<size_t>(rows));
+      FUSILLI_CHECK_ERROR(
+          views[i].readBytes(*device.handle, slice.data(), slice.size()));
+    }
+    return ok();
+  }
+
+  // Updates the throughput estimate of `device`, which executed `rows` rows
+  // in `elapsed`.
+  void recordThroughput(Device &device, int64_t rows,
+                        std::chrono::nanoseconds elapsed) const {
+    double seconds =
+        std::max(std::chrono::duration<double>(elapsed).count(), 1e-9);
+    double throughput = static_cast<double>(rows) / seconds;
+    device.throughput =
+        device.throughput > 0
+            ? options_.throughputWeight * throughput +
+                  (1 - options_.throughputWeight) * device.throughput
+            : throughput;
+  }
+
+  SplitExecutorOptions options_;
+  std::vector<BatchedTensor> batched_;
+  std::vector<Device> devices_;
+  uint64_t batchCount_ = 0;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_SPLIT_EXECUTOR_H
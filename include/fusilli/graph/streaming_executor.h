@@ -0,0 +1,262 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains StreamingExecutor, which executes a graph over a stream
+// of host batches, overlapping their uploads, executions and downloads.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_STREAMING_EXECUTOR_H
+#define FUSILLI_GRAPH_STREAMING_EXECUTOR_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/fence.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/backend/host_transfer.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// StreamingExecutor runs a graph over a stream of host batches, e.g. for
+// offline batch processing, without leaving the device idle while batches
+// are copied: the upload of batch i+1, the execution of batch i and the
+// download of batch i-1 are all queued on the device at once, ordered by
+// fences rather than by the host (see `Buffer::writeAsync()`,
+// `Graph::executeAsync()` and `Buffer::readAsync()`).
+//
+// Each graph input or output not bound to a shared buffer at creation is
+// streamed: the executor owns `depth` rotating sets of device buffers for
+// them, and `submit()` takes the host memory of the batch's inputs and
+// outputs. Submitting a batch reuses the buffer set of batch i-depth, so it
+// first waits for that batch's downloads: at most `depth` batches are in
+// flight, and `submit()` only blocks the host when the device falls behind.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(
+//       StreamingExecutor executor,
+//       StreamingExecutor::create(handle, graph, {{wT, wBuf}}));
+//   for (size_t i = 0; i < batches; ++i)
+//     FUSILLI_CHECK_ERROR(executor.submit(
+//         {{xT, std::as_bytes(std::span(inputs[i]))}},
+//         {{yT, std::as_writable_bytes(std::span(outputs[i]))}}));
+//   FUSILLI_CHECK_ERROR(executor.flush());
+class StreamingExecutor {
+public:
+  // Host memory of the streamed inputs and outputs of a batch, each holding
+  // exactly the contents of its tensor's buffer.
+  using HostInputs = std::unordered_map<std::shared_ptr<TensorAttr>,
+                                        std::span<const std::byte>>;
+  using HostOutputs =
+      std::unordered_map<std::shared_ptr<TensorAttr>, std::span<std::byte>>;
+
+  // Creates an executor streaming batches through the compiled `graph` on
+  // `handle`, which must outlive the executor, with `depth` batches in
+  // flight. `sharedBuffers` binds the graph inputs read by all batches, e.g.
+  // weights; the other inputs and outputs are streamed and must have static
+  // dims.
+  static ErrorOr<StreamingExecutor>
+  create(const Handle &handle, std::shared_ptr<const Graph> graph,
+         const std::unordered_map<std::shared_ptr<TensorAttr>,
+                                  std::shared_ptr<Buffer>> &sharedBuffers,
+         size_t depth = 3) {
+    FUSILLI_RETURN_ERROR_IF(graph == nullptr, ErrorCode::InvalidArgument,
+                            "StreamingExecutor graph is null");
+    FUSILLI_RETURN_ERROR_IF(depth == 0, ErrorCode::InvalidArgument,
+                            "StreamingExecutor requires a positive depth");
+    StreamingExecutor executor(handle, std::move(graph), depth);
+
+    for (const std::shared_ptr<TensorAttr> &tensor :
+         executor.graph_->getTensorsByUid()) {
+      if (auto it = sharedBuffers.find(tensor); it != sharedBuffers.end()) {
+        FUSILLI_RETURN_ERROR_IF(it->second == nullptr,
+                                ErrorCode::VariantPackError,
+                                "StreamingExecutor shared buffer of tensor '" +
+                                    tensor->getName() + "' is null");
+        continue;
+      }
+      FUSILLI_RETURN_ERROR_IF(tensor->hasDynamicDims(),
+                              ErrorCode::NotImplemented,
+                              "StreamingExecutor requires streamed tensor '" +
+                                  tensor->getName() + "' to have static dims");
+      FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                               getIreeHalElementType(tensor->getDataType()));
+      FUSILLI_RETURN_ERROR_IF(
+          iree_hal_element_bit_count(elementType) % 8 != 0,
+          ErrorCode::NotImplemented,
+          "StreamingExecutor requires byte-aligned elements for streamed "
+          "tensor '" +
+              tensor->getName() + "'");
+      executor.streamed_.push_back(tensor);
+    }
+
+    for (Slot &slot : executor.slots_) {
+      slot.variantPack = sharedBuffers;
+      for (const std::shared_ptr<TensorAttr> &tensor : executor.streamed_) {
+        std::vector<iree_hal_dim_t> shape;
+        for (int64_t dim : tensor->getStorageDim())
+          shape.push_back(static_cast<iree_hal_dim_t>(dim));
+        FUSILLI_ASSIGN_OR_RETURN(iree_hal_element_type_t elementType,
+                                 getIreeHalElementType(tensor->getDataType()));
+        iree_device_size_t byteLength = 0;
+        FUSILLI_CHECK_ERROR(iree_hal_buffer_compute_view_size(
+            shape.size(), shape.data(), elementType,
+            IREE_HAL_ENCODING_TYPE_DENSE_ROW_MAJOR, &byteLength));
+        FUSILLI_ASSIGN_OR_RETURN(
+            Buffer raw,
+            Buffer::allocateRaw(handle, static_cast<size_t>(byteLength)));
+        FUSILLI_ASSIGN_OR_RETURN(
+            Buffer buffer,
+            raw.subview(/*byteOffset=*/0, shape, tensor->getDataType()));
+        slot.variantPack[tensor] = std::make_shared<Buffer>(std::move(buffer));
+      }
+    }
+    return ok(std::move(executor));
+  }
+
+  // Queues the upload of `inputs`, the execution of the graph and the
+  // download into `outputs` of the next batch, and returns its index.
+  // Every streamed tensor must be in `inputs` or `outputs`. The host memory
+  // of `inputs` may be reused right away, while `outputs` must stay alive
+  // and only holds the results after `wait()` (or `flush()`) on the batch.
+  ErrorOr<uint64_t> submit(const HostInputs &inputs,
+                           const HostOutputs &outputs) {
+    for (const std::shared_ptr<TensorAttr> &tensor : streamed_)
+      FUSILLI_RETURN_ERROR_IF(!inputs.contains(tensor) &&
+                                  !outputs.contains(tensor),
+                              ErrorCode::VariantPackError,
+                              "StreamingExecutor batch has no host memory for "
+                              "tensor '" +
+                                  tensor->getName() + "'");
+    FUSILLI_RETURN_ERROR_IF(inputs.size() + outputs.size() != streamed_.size(),
+                            ErrorCode::VariantPackError,
+                            "StreamingExecutor batch has host memory for "
+                            "tensors that are not streamed");
+
+    // The buffer set is free once the batch that last used it is read back.
+    uint64_t batch = nextBatch_;
+    Slot &slot = slots_[batch % slots_.size()];
+    FUSILLI_CHECK_ERROR(drain(slot));
+    slot.batch = batch;
+    slot.pending = true;
+    FUSILLI_LOG_LABEL_ENDL("INFO: Submitting streamed batch " << batch);
+
+    std::vector<const Fence *> uploadFences;
+    for (const auto &[tensor, data] : inputs) {
+      FUSILLI_ASSIGN_OR_RETURN(
+          HostTransfer upload,
+          slot.variantPack.at(tensor)->writeAsync(*handle_, data));
+      slot.transfers.push_back(std::move(upload));
+    }
+    for (const HostTransfer &upload : slot.transfers)
+      uploadFences.push_back(&upload.getFence());
+    FUSILLI_ASSIGN_OR_RETURN(Fence uploaded, Fence::join(uploadFences));
+
+    FUSILLI_ASSIGN_OR_RETURN(Fence executed,
+                             graph_->executeAsync(*handle_, slot.variantPack,
+                                                  /*workspace=*/nullptr,
+                                                  uploaded));
+    for (const auto &[tensor, data] : outputs) {
+      FUSILLI_ASSIGN_OR_RETURN(
+          HostTransfer download,
+          slot.variantPack.at(tensor)->readAsync(*handle_, data, executed));
+      slot.transfers.push_back(std::move(download));
+    }
+    nextBatch_++;
+    return ok(batch);
+  }
+
+  // Blocks until the outputs of the submitted `batch` are in host memory,
+  // returning the first error of its transfers, if any.
+  ErrorObject wait(uint64_t batch) {
+    FUSILLI_RETURN_ERROR_IF(batch >= nextBatch_, ErrorCode::InvalidArgument,
+                            "StreamingExecutor batch " +
+                                std::to_string(batch) +
+                                " was not submitted");
+    Slot &slot = slots_[batch % slots_.size()];
+    // Older batches were waited on when their buffer set was reused.
+    if (slot.batch != batch)
+      return ok();
+    return drain(slot);
+  }
+
+  // Blocks until all submitted batches are in host memory.
+  ErrorObject flush() {
+    uint64_t inFlight = std::min<uint64_t>(nextBatch_, slots_.size());
+    for (uint64_t batch = nextBatch_ - inFlight; batch < nextBatch_; ++batch)
+      FUSILLI_CHECK_ERROR(wait(batch));
+    return ok();
+  }
+
+  // Number of batches in flight at most.
+  size_t getDepth() const { return slots_.size(); }
+
+  // Number of submitted batches, i.e. the index of the next one.
+  uint64_t getSubmittedCount() const { return nextBatch_; }
+
+  // Delete copy constructors, keep move constructors. Destroying the executor
+  // waits for the device side of the pending batches.
+  StreamingExecutor(const StreamingExecutor &) = delete;
+  StreamingExecutor &operator=(const StreamingExecutor &) = delete;
+  StreamingExecutor(StreamingExecutor &&) noexcept = default;
+  StreamingExecutor &operator=(StreamingExecutor &&) noexcept = default;
+  ~StreamingExecutor() = default;
+
+private:
+  // A set of device buffers for the streamed tensors, and the transfers of
+  // the batch using it.
+  struct Slot {
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+        variantPack;
+    std::vector<HostTransfer> transfers;
+    uint64_t batch = 0;
+    bool pending = false;
+  };
+
+  StreamingExecutor(const Handle &handle, std::shared_ptr<const Graph> graph,
+                    size_t depth)
+      : handle_(&handle), graph_(std::move(graph)), slots_(depth) {}
+
+  // Waits for the transfers of the batch using `slot`, freeing its buffers.
+  static ErrorObject drain(Slot &slot) {
+    if (!slot.pending)
+      return ok();
+    ErrorObject status = ok();
+    for (HostTransfer &transfer : slot.transfers) {
+      ErrorObject transferStatus = transfer.wait();
+      if (isOk(status))
+        status = std::move(transferStatus);
+    }
+    slot.transfers.clear();
+    slot.pending = false;
+    return status;
+  }
+
+  const Handle *handle_;
+  std::shared_ptr<const Graph> graph_;
+  // Streamed graph inputs and outputs, in UID order.
+  std::vector<std::shared_ptr<TensorAttr>> streamed_;
+  std::vector<Slot> slots_;
+  uint64_t nextBatch_ = 0;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_STREAMING_EXECUTOR_H
@@ -0,0 +1,209 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains TrainingModule, which loads the forward and backward
+// graphs of a trainable layer as the entry points of one module, sharing its
+// weight bindings.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_TRAINING_MODULE_H
+#define FUSILLI_GRAPH_TRAINING_MODULE_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/backend/buffer.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/graph/compile_all.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// TrainingModule holds the forward and backward graphs of a trainable layer
+// compiled into one module (see `compileModule()`), so that the two load one
+// VMFB into one VM context rather than one each. On top of that:
+//   - weights and other tensors used by both graphs are bound once, by name,
+//     to one buffer (see `bindShared()`), rather than in the variant pack of
+//     each execution;
+//   - external parameters (see `TensorAttr::setParameter()`) are globals of
+//     the module, declared and loaded once for both graphs;
+//   - executions borrow workspaces from the arena of the handle (see
+//     `Handle::acquireWorkspace()`), sized for the larger of the two graphs.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(
+//       TrainingModule module,
+//       TrainingModule::create(handle, forwardGraph, backwardGraph));
+//   FUSILLI_CHECK_ERROR(module.bindShared("weight", weightBuf));
+//   for (...) {
+//     FUSILLI_CHECK_ERROR(module.forward(handle, {{xT, xBuf}, {yT, yBuf}}));
+//     FUSILLI_CHECK_ERROR(
+//         module.backward(handle, {{dyT, dyBuf}, {dxT, dxBuf}}));
+//   }
+class TrainingModule {
+public:
+  using VariantPack =
+      std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>;
+
+  // Compiles the validated `forward` and `backward` graphs into one module
+  // for `handle` and loads it. Set `remove = true` to remove the cache files
+  // of the module once compiled.
+  static ErrorOr<TrainingModule> create(const Handle &handle,
+                                        std::shared_ptr<Graph> forward,
+                                        std::shared_ptr<Graph> backward,
+                                        bool remove = false) {
+    FUSILLI_RETURN_ERROR_IF(forward == nullptr || backward == nullptr,
+                            ErrorCode::InvalidArgument,
+                            "TrainingModule requires a forward and a "
+                            "backward graph");
+    FUSILLI_RETURN_ERROR_IF(forward == backward, ErrorCode::InvalidArgument,
+                            "TrainingModule forward and backward graphs must "
+                            "differ");
+    FUSILLI_LOG_LABEL_ENDL("INFO: Loading TrainingModule of '"
+                           << forward->getName() << "' and '"
+                           << backward->getName() << "'");
+    std::vector<Graph *> graphs = {forward.get(), backward.get()};
+    FUSILLI_CHECK_ERROR(compileModule(graphs, handle, remove));
+    return ok(TrainingModule(Function(std::move(forward)),
+                             Function(std::move(backward))));
+  }
+
+  // Binds `buffer` to the graph inputs and outputs named `name` of the
+  // forward and backward graphs, replacing any previous binding. At least
+  // one of the graphs must have such a tensor, and where both do, they must
+  // agree on its dims and data type. Shared tensors must not be bound again
+  // in the variant packs of `forward()` and `backward()`.
+  ErrorObject bindShared(const std::string &name,
+                         std::shared_ptr<Buffer> buffer) {
+    FUSILLI_RETURN_ERROR_IF(buffer == nullptr, ErrorCode::InvalidArgument,
+                            "TrainingModule shared buffer of tensor '" + name +
+                                "' is null");
+    std::optional<size_t> forwardUid = forward_.findUid(name);
+    std::optional<size_t> backwardUid = backward_.findUid(name);
+    FUSILLI_RETURN_ERROR_IF(!forwardUid && !backwardUid,
+                            ErrorCode::InvalidArgument,
+                            "TrainingModule graphs have no input or output "
+                            "named '" +
+                                name + "'");
+    if (forwardUid && backwardUid) {
+      const auto &forwardTensor =
+          forward_.graph->getTensorsByUid()[*forwardUid];
+      const auto &backwardTensor =
+          backward_.graph->getTensorsByUid()[*backwardUid];
+      FUSILLI_RETURN_ERROR_IF(
+          forwardTensor->getDim() != backwardTensor->getDim() ||
+              forwardTensor->getDataType() != backwardTensor->getDataType(),
+          ErrorCode::InvalidArgument,
+          "TrainingModule graphs differ in the dims or data type of shared "
+          "tensor '" +
+              name + "'");
+    }
+    if (forwardUid)
+      forward_.sharedBuffers[*forwardUid] = buffer.get();
+    if (backwardUid)
+      backward_.sharedBuffers[*backwardUid] = buffer.get();
+    sharedBuffers_[name] = std::move(buffer);
+    return ok();
+  }
+
+  // Executes the forward (resp. backward) graph on the buffers bound with
+  // `bindShared()` and those of `variantPack`, which holds the remaining
+  // inputs and outputs of the graph. Otherwise the same as
+  // `Graph::execute()` with a null workspace.
+  ErrorObject forward(const Handle &handle,
+                      const VariantPack &variantPack) const {
+    return execute(forward_, handle, variantPack);
+  }
+  ErrorObject backward(const Handle &handle,
+                       const VariantPack &variantPack) const {
+    return execute(backward_, handle, variantPack);
+  }
+
+  const std::shared_ptr<Graph> &getForward() const { return forward_.graph; }
+  const std::shared_ptr<Graph> &getBackward() const { return backward_.graph; }
+
+  // Returns the buffer bound to shared tensor `name`, or null if none is.
+  std::shared_ptr<Buffer> getShared(const std::string &name) const {
+    auto it = sharedBuffers_.find(name);
+    return it == sharedBuffers_.end() ? nullptr : it->second;
+  }
+
+  // Delete copy constructors, keep move constructors.
+  TrainingModule(const TrainingModule &) = delete;
+  TrainingModule &operator=(const TrainingModule &) = delete;
+  TrainingModule(TrainingModule &&) noexcept = default;
+  TrainingModule &operator=(TrainingModule &&) noexcept = default;
+  ~TrainingModule() = default;
+
+private:
+  // An entry point of the module: its graph and the shared buffers bound to
+  // its inputs and outputs, indexed by UID (null where unbound).
+  struct Function {
+    explicit Function(std::shared_ptr<Graph> graph)
+        : graph(std::move(graph)),
+          sharedBuffers(this->graph->getTensorUidCount(), nullptr) {}
+
+    std::optional<size_t> findUid(const std::string &name) const {
+      const auto &tensors = graph->getTensorsByUid();
+      for (size_t uid = 0; uid < tensors.size(); ++uid)
+        if (tensors[uid]->getName() == name)
+          return uid;
+      return std::nullopt;
+    }
+
+    std::shared_ptr<Graph> graph;
+    std::vector<Buffer *> sharedBuffers;
+  };
+
+  TrainingModule(Function forward, Function backward)
+      : forward_(std::move(forward)), backward_(std::move(backward)) {}
+
+  static ErrorObject execute(const Function &function, const Handle &handle,
+                             const VariantPack &variantPack) {
+    std::vector<Buffer *> buffers = function.sharedBuffers;
+    for (const auto &[tensor, buffer] : variantPack) {
+      FUSILLI_ASSIGN_OR_RETURN(size_t uid,
+                               function.graph->getTensorUid(tensor));
+      FUSILLI_RETURN_ERROR_IF(buffers[uid] != nullptr,
+                              ErrorCode::VariantPackError,
+                              "Tensor '" + tensor->getName() +
+                                  "' is bound to a TrainingModule shared "
+                                  "buffer");
+      FUSILLI_RETURN_ERROR_IF(buffer == nullptr, ErrorCode::VariantPackError,
+                              "Buffer of tensor '" + tensor->getName() +
+                                  "' is null");
+      buffers[uid] = buffer.get();
+    }
+    const auto &tensors = function.graph->getTensorsByUid();
+    for (size_t uid = 0; uid < buffers.size(); ++uid)
+      FUSILLI_RETURN_ERROR_IF(buffers[uid] == nullptr,
+                              ErrorCode::VariantPackError,
+                              "No buffer bound to tensor '" +
+                                  tensors[uid]->getName() + "' of graph '" +
+                                  function.graph->getName() + "'");
+    return function.graph->execute(handle, buffers, /*workspace=*/nullptr);
+  }
+
+  // The forward graph owns the loaded module (see `compileModule()`).
+  Function forward_;
+  Function backward_;
+  // Keeps the buffers bound with `bindShared()` alive, by tensor name.
+  std::unordered_map<std::string, std::shared_ptr<Buffer>> sharedBuffers_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_TRAINING_MODULE_H
@@ -0,0 +1,135 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains `warmup()`, which performs the one-time process
+// initialization of the compiler and runtime on a background thread.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_GRAPH_WARMUP_H
+#define FUSILLI_GRAPH_WARMUP_H
+
+#include "fusilli/backend/backend.h"
+#include "fusilli/backend/compile_session.h"
+#include "fusilli/backend/handle.h"
+#include "fusilli/backend/runtime.h"
+#include "fusilli/graph/graph.h"
+#include "fusilli/support/logging.h"
+
+#include <chrono>
+#include <future>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// A warmup running on a background thread, see `warmup()`.
+//
+// The handles it creates are kept alive until the `Warmup` is destroyed, so
+// that handles created meanwhile on the same devices (e.g. with
+// `Handle::create(backend)`) reuse the warmed up devices rather than creating
+// them again.
+class Warmup {
+public:
+  // Blocks until the warmup is done and returns its first error, if any.
+  ErrorObject wait() {
+    if (future_.valid())
+      status_ = future_.get();
+    return status_;
+  }
+
+  // Returns whether the warmup is done, i.e. `wait()` won't block.
+  bool isDone() const {
+    return !future_.valid() || future_.wait_for(std::chrono::seconds(0)) ==
+                                   std::future_status::ready;
+  }
+
+  // Returns the handles created by the warmup, one per backend in the order
+  // they were requested. Blocks until the warmup is done. On error, only the
+  // backends warmed up before it have a handle.
+  const std::vector<Handle> &getHandles() {
+    (void)wait();
+    return *handles_;
+  }
+
+  // Delete copy constructors, keep move constructors and destructor.
+  Warmup(const Warmup &) = delete;
+  Warmup &operator=(const Warmup &) = delete;
+  Warmup(Warmup &&) noexcept = default;
+  Warmup &operator=(Warmup &&) noexcept = default;
+  // Joins the background thread.
+  ~Warmup() = default;
+
+private:
+  friend Warmup warmup(std::span<const Backend> backends);
+
+  Warmup() : handles_(std::make_unique<std::vector<Handle>>()) {}
+
+  // Heap allocated so that the background thread's reference survives moves.
+  std::unique_ptr<std::vector<Handle>> handles_;
+  std::future<ErrorObject> future_;
+  ErrorObject status_ = ok();
+};
+
+namespace detail {
+
+// Body of the background thread of `warmup()`.
+inline ErrorObject runWarmup(const std::vector<Backend> &backends,
+                             std::vector<Handle> &handles) {
+  FUSILLI_LOG_LABEL_ENDL("INFO: Warming up compiler and runtime");
+  if (!checkCompileBackendEnv())
+    FUSILLI_CHECK_ERROR(CompileContext::create());
+  FUSILLI_CHECK_ERROR(registerHalDriversOnce());
+  for (Backend backend : backends) {
+    (void)getBackendFlags(backend);
+    FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(backend));
+    handles.push_back(std::move(handle));
+  }
+  return ok();
+}
+
+} // namespace detail
+
+// Starts initializing, on a background thread, what the first `compile()`
+// and `Handle::create()` of the process otherwise do on the critical path:
+// loading and initializing the IREE compiler library (see
+// `CompileContext::create()`; skipped with the CLI compile backend),
+// registering the HAL drivers, resolving the backend flags (which detects
+// the GPU target for AMDGPU) and creating the default device of each of
+// `backends`. Application initialization can run in the meantime:
+//
+//   Warmup warm = warmup({Backend::AMDGPU});
+//   ... other initialization ...
+//   FUSILLI_CHECK_ERROR(warm.wait());
+//   FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(Backend::AMDGPU));
+//
+// Every step is idempotent and thread safe, so compiling or creating handles
+// before the warmup is done is fine; those calls then wait on (or repeat) the
+// remaining steps.
+inline Warmup warmup(std::span<const Backend> backends) {
+  Warmup result;
+  result.future_ = std::async(
+      std::launch::async,
+      [backends = std::vector<Backend>(backends.begin(), backends.end()),
+       handles = result.handles_.get()] {
+        return detail::runWarmup(backends, *handles);
+      });
+  return result;
+}
+
+// Overload of the above for a braced list of backends.
+inline Warmup warmup(std::initializer_list<Backend> backends) {
+  return warmup(std::span<const Backend>(backends.begin(), backends.size()));
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_GRAPH_WARMUP_H
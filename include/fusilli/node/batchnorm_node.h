@@ -6,8 +6,8 @@
 
 //===----------------------------------------------------------------------===//
 //
-// This file contains definitions for the batch normalization node
-// `BatchNormNode`.
+// This file contains definitions for the batch normalization nodes
+// `BatchNormNode` and `BatchNormBwdNode`.
 //
 //===----------------------------------------------------------------------===//
 
@@ -66,6 +66,28 @@ public:
   }
   Type getType() const override final { return Type::BatchNorm; }
 
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    batchnormAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    batchnormAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    batchnormAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { batchnormAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    batchnormAttr.hashTensors(fp);
+    fp.update(batchnormAttr.getForwardPhase());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating BatchNormNode '"
                            << batchnormAttr.getName() << "'");
@@ -169,7 +191,7 @@ public:
     if (yT->getDim().empty())
       yT->setDim(xDim);
     if (yT->getStride().empty())
-      yT->setStride(xT->getStride());
+      yT->setStride(xT->getCompactStride());
 
     // Infer saved statistics shapes for training.
     if (isTrainingForwardPhase()) {
@@ -246,6 +268,191 @@ private:
   int64_t getChannelDim() const { return batchnormAttr.getX()->getDim()[1]; }
 };
 
+//===----------------------------------------------------------------------===//
+// Batch normalization backward node.
+//
+// Computes DX and, with SCALE, DSCALE and DBIAS from the statistics saved by
+// the training forward (SAVED_MEAN and SAVED_INV_VARIANCE). DSCALE and DBIAS
+// are the per-channel sums of DY * xhat and DY, which DX also needs, so both
+// reductions are done once over DY and X. With the optional forward output Y,
+// the backward of a ReLU on Y is fused in (DY is zeroed where Y <= 0), as in
+// the BatchNorm + ReLU blocks of ResNets.
+//
+// SCALE, SAVED_MEAN, SAVED_INV_VARIANCE, DSCALE and DBIAS are 1D tensors of
+// shape [C].
+//===----------------------------------------------------------------------===//
+
+class BatchNormBwdNode : public NodeCRTP<BatchNormBwdNode> {
+public:
+  BatchnormBwdAttr batchnormBwdAttr;
+
+  BatchNormBwdNode(BatchnormBwdAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), batchnormBwdAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return batchnormBwdAttr.getName();
+  }
+  Type getType() const override final { return Type::BatchNormBwd; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    batchnormBwdAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    batchnormBwdAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    batchnormBwdAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final {
+    batchnormBwdAttr.archive(ar);
+  }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    batchnormBwdAttr.hashTensors(fp);
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating BatchNormBwdNode '"
+                           << batchnormBwdAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> dyT = batchnormBwdAttr.getDY();
+    std::shared_ptr<TensorAttr> xT = batchnormBwdAttr.getX();
+    std::shared_ptr<TensorAttr> yT = batchnormBwdAttr.getY();
+    std::shared_ptr<TensorAttr> sT = batchnormBwdAttr.getSCALE();
+    std::shared_ptr<TensorAttr> dxT = batchnormBwdAttr.getDX();
+
+    // Ensure mandatory input and output tensors are set.
+    FUSILLI_RETURN_ERROR_IF(!dyT, ErrorCode::AttributeNotSet,
+                            "BatchNorm backward input tensor DY not set");
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "BatchNorm backward input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(
+        !batchnormBwdAttr.getSAVED_MEAN(), ErrorCode::AttributeNotSet,
+        "BatchNorm backward input tensor SAVED_MEAN not set");
+    FUSILLI_RETURN_ERROR_IF(
+        !batchnormBwdAttr.getSAVED_INV_VARIANCE(), ErrorCode::AttributeNotSet,
+        "BatchNorm backward input tensor SAVED_INV_VARIANCE not set");
+    FUSILLI_RETURN_ERROR_IF(!dxT, ErrorCode::AttributeNotSet,
+                            "BatchNorm backward output tensor DX not set");
+    FUSILLI_RETURN_ERROR_IF(
+        static_cast<bool>(sT) !=
+                static_cast<bool>(batchnormBwdAttr.getDSCALE()) ||
+            static_cast<bool>(sT) !=
+                static_cast<bool>(batchnormBwdAttr.getDBIAS()),
+        ErrorCode::AttributeNotSet,
+        "BatchNorm backward SCALE, DSCALE and DBIAS tensors must be set "
+        "together");
+
+    // Shape and layout checks on input tensors.
+    FUSILLI_RETURN_ERROR_IF(
+        xT->getDim().size() < 2, ErrorCode::InvalidAttribute,
+        "BatchNorm backward input tensor X must have a rank of at least 2");
+    FUSILLI_RETURN_ERROR_IF(
+        dyT->getDim() != xT->getDim(), ErrorCode::InvalidAttribute,
+        "BatchNorm backward input tensor DY must have the same shape as "
+        "input X tensor");
+    FUSILLI_RETURN_ERROR_IF(
+        yT && yT->getDim() != xT->getDim(), ErrorCode::InvalidAttribute,
+        "BatchNorm backward input tensor Y must have the same shape as "
+        "input X tensor");
+    for (const auto &t : {xT, dyT, yT})
+      FUSILLI_RETURN_ERROR_IF(t && !t->isContiguous() && !t->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + t->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for BatchNormBwdNode '"
+                           << batchnormBwdAttr.getName() << "'");
+
+    batchnormBwdAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> xT = batchnormBwdAttr.getX();
+    std::shared_ptr<TensorAttr> dxT = batchnormBwdAttr.getDX();
+    const std::vector<int64_t> &xDim = xT->getDim();
+
+    // Infer 1D channel tensors.
+    for (std::shared_ptr<TensorAttr> t :
+         {batchnormBwdAttr.getSCALE(), batchnormBwdAttr.getSAVED_MEAN(),
+          batchnormBwdAttr.getSAVED_INV_VARIANCE(),
+          batchnormBwdAttr.getDSCALE(), batchnormBwdAttr.getDBIAS()}) {
+      if (!t)
+        continue;
+      if (t->getDim().empty())
+        t->setDim({xDim[1]});
+      if (t->getStride().empty())
+        t->setStride({1});
+    }
+
+    // Infer shape and stride of output DX tensor (same as X).
+    if (dxT->getDim().empty())
+      dxT->setDim(xDim);
+    if (dxT->getStride().empty())
+      dxT->setStride(xT->getCompactStride());
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating BatchNormBwdNode '"
+                           << batchnormBwdAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = batchnormBwdAttr.getX();
+    std::shared_ptr<TensorAttr> dxT = batchnormBwdAttr.getDX();
+    const std::vector<int64_t> &xDim = xT->getDim();
+    const std::vector<int64_t> expectedCDim = {xDim[1]};
+
+    // Shape and layout checks for output DX tensor.
+    FUSILLI_RETURN_ERROR_IF(xDim != dxT->getDim(), ErrorCode::InvalidAttribute,
+                            "BatchNorm backward output DX tensor must have "
+                            "the same shape as input X tensor");
+    FUSILLI_RETURN_ERROR_IF(!dxT->isContiguous() && !dxT->isChannelsLast(),
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + dxT->getName() +
+                                "' is neither contiguous nor channels-last as "
+                                "defined by its stride");
+
+    // Shape checks for 1D channel tensors.
+    auto check1DShape = [&](const std::shared_ptr<TensorAttr> &t,
+                            const std::string &name) -> ErrorObject {
+      if (!t)
+        return ok();
+      FUSILLI_RETURN_ERROR_IF(
+          t->getDim() != expectedCDim, ErrorCode::InvalidAttribute,
+          "BatchNorm backward tensor " + name +
+              " must be 1D with size equal to channel dimension C");
+      FUSILLI_RETURN_ERROR_IF(t->getStride() != std::vector<int64_t>{1},
+                              ErrorCode::InvalidAttribute,
+                              "BatchNorm backward tensor " + name +
+                                  " must have unit stride");
+      return ok();
+    };
+
+    FUSILLI_CHECK_ERROR(check1DShape(batchnormBwdAttr.getSCALE(), "SCALE"));
+    FUSILLI_CHECK_ERROR(
+        check1DShape(batchnormBwdAttr.getSAVED_MEAN(), "SAVED_MEAN"));
+    FUSILLI_CHECK_ERROR(check1DShape(batchnormBwdAttr.getSAVED_INV_VARIANCE(),
+                                     "SAVED_INV_VARIANCE"));
+    FUSILLI_CHECK_ERROR(check1DShape(batchnormBwdAttr.getDSCALE(), "DSCALE"));
+    FUSILLI_CHECK_ERROR(check1DShape(batchnormBwdAttr.getDBIAS(), "DBIAS"));
+
+    return ok();
+  }
+};
+
 } // namespace fusilli
 
 #endif // FUSILLI_NODE_BATCHNORM_NODE_H
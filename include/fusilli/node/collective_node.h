@@ -0,0 +1,227 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the collective communication node
+// `CollectiveNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_COLLECTIVE_NODE_H
+#define FUSILLI_NODE_COLLECTIVE_NODE_H
+
+#include "fusilli/attributes/collective_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+//===----------------------------------------------------------------------===//
+// Collective node.
+//
+// All-reduce, all-gather or reduce-scatter of X over a group of ranks, one
+// process (and handle) per rank, e.g. around the column- and row-parallel
+// matmuls of tensor parallelism. It lowers to the `c10d_functional` ops,
+// which IREE turns into collectives over the default channel of the device
+// (RCCL on AMDGPU, with the rank and group of the process). Being in the
+// same graph as the adjacent matmuls lets the compiler schedule the
+// communication concurrently with independent compute, instead of
+// serializing the two at graph boundaries.
+//===----------------------------------------------------------------------===//
+
+class CollectiveNode : public NodeCRTP<CollectiveNode> {
+public:
+  CollectiveAttr collectiveAttr;
+
+  CollectiveNode(CollectiveAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), collectiveAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  // Returns the axis as a non-negative logical dimension index.
+  int64_t getNormalizedAxis() const {
+    int64_t axis = collectiveAttr.getAxis();
+    int64_t rank = static_cast<int64_t>(collectiveAttr.getX()->getDim().size());
+    return axis < 0 ? axis + rank : axis;
+  }
+
+  // Returns whether `mode` has a lowering, see `emitNodePreAsm()`. Other
+  // values, e.g. read from a corrupt serialized graph, are rejected by
+  // `preValidateNode()`.
+  static bool isSupportedMode(CollectiveAttr::Mode mode) {
+    switch (mode) {
+    case CollectiveAttr::Mode::ALL_REDUCE:
+    case CollectiveAttr::Mode::ALL_GATHER:
+    case CollectiveAttr::Mode::REDUCE_SCATTER:
+      return true;
+    case CollectiveAttr::Mode::NOT_SET:
+      return false;
+    }
+    return false;
+  }
+
+  // Returns the logical dims of Y: those of X, with the axis multiplied
+  // (ALL_GATHER) or divided (REDUCE_SCATTER) by the group size.
+  std::vector<int64_t> getOutputDim() const {
+    std::vector<int64_t> yDim = collectiveAttr.getX()->getDim();
+    size_t axis = static_cast<size_t>(getNormalizedAxis());
+    if (collectiveAttr.getMode() == CollectiveAttr::Mode::ALL_GATHER)
+      yDim[axis] *= collectiveAttr.getGroupSize();
+    else if (collectiveAttr.getMode() == CollectiveAttr::Mode::REDUCE_SCATTER)
+      yDim[axis] /= collectiveAttr.getGroupSize();
+    return yDim;
+  }
+
+  const std::string &getName() const override final {
+    return collectiveAttr.getName();
+  }
+  Type getType() const override final { return Type::Collective; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    collectiveAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    collectiveAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    collectiveAttr.replaceOutput(from, to);
+  }
+
+  void archiveNode(Archive &ar) override final { collectiveAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    collectiveAttr.hashTensors(fp);
+    fp.update(collectiveAttr.getMode())
+        .update(collectiveAttr.getReduceOp())
+        .update(collectiveAttr.getRanks())
+        .update(collectiveAttr.getAxis());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating CollectiveNode '"
+                           << collectiveAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = collectiveAttr.getX();
+    CollectiveAttr::Mode mode = collectiveAttr.getMode();
+
+    FUSILLI_RETURN_ERROR_IF(mode == CollectiveAttr::Mode::NOT_SET,
+                            ErrorCode::AttributeNotSet,
+                            "Collective mode not set");
+    FUSILLI_RETURN_ERROR_IF(!isSupportedMode(mode), ErrorCode::NotImplemented,
+                            "Collective mode " +
+                                std::to_string(static_cast<int>(mode)) +
+                                " is not supported");
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Collective input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!collectiveAttr.getY(), ErrorCode::AttributeNotSet,
+                            "Collective output tensor Y not set");
+    FUSILLI_RETURN_ERROR_IF(xT->getDim().empty(), ErrorCode::AttributeNotSet,
+                            "Collective input tensor X dimensions not set");
+
+    // The group lists distinct ranks.
+    std::vector<int64_t> ranks = collectiveAttr.getRanks();
+    FUSILLI_RETURN_ERROR_IF(ranks.empty(), ErrorCode::AttributeNotSet,
+                            "Collective ranks not set");
+    std::sort(ranks.begin(), ranks.end());
+    FUSILLI_RETURN_ERROR_IF(
+        ranks.front() < 0 ||
+            std::adjacent_find(ranks.begin(), ranks.end()) != ranks.end(),
+        ErrorCode::InvalidAttribute,
+        "Collective ranks must be distinct and non-negative");
+
+    // The reduction of the group is independent of the axis.
+    if (mode == CollectiveAttr::Mode::ALL_REDUCE)
+      return ok();
+
+    int64_t rank = static_cast<int64_t>(xT->getDim().size());
+    int64_t axis = collectiveAttr.getAxis();
+    FUSILLI_RETURN_ERROR_IF(axis < -rank || axis >= rank,
+                            ErrorCode::InvalidAttribute,
+                            "Collective axis " + std::to_string(axis) +
+                                " is out of range for input tensor X of rank " +
+                                std::to_string(rank));
+    size_t normalizedAxis = static_cast<size_t>(getNormalizedAxis());
+    FUSILLI_RETURN_ERROR_IF(xT->isDynamicDim(normalizedAxis),
+                            ErrorCode::NotImplemented,
+                            "Collective along a dynamic dim is not supported");
+    FUSILLI_RETURN_ERROR_IF(
+        mode == CollectiveAttr::Mode::REDUCE_SCATTER &&
+            xT->getDim()[normalizedAxis] % collectiveAttr.getGroupSize() != 0,
+        ErrorCode::InvalidAttribute,
+        "Collective REDUCE_SCATTER input tensor X dim " +
+            std::to_string(normalizedAxis) +
+            " must be divisible by the group size " +
+            std::to_string(collectiveAttr.getGroupSize()));
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for CollectiveNode '"
+                           << collectiveAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = collectiveAttr.getX();
+    std::shared_ptr<TensorAttr> yT = collectiveAttr.getY();
+
+    // Collectives move data in the data type of X.
+    if (yT->getDataType() == DataType::NotSet)
+      yT->setDataType(xT->getDataType());
+    collectiveAttr.fillFromContext(context);
+
+    if (yT->getDim().empty())
+      yT->setDim(getOutputDim());
+    if (yT->getStride().empty())
+      yT->setStride(generateStrideFromDim(
+          yT->getDim(), getContiguousStrideOrder(yT->getDim().size())));
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating CollectiveNode '"
+                           << collectiveAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = collectiveAttr.getX();
+    std::shared_ptr<TensorAttr> yT = collectiveAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != getOutputDim(), ErrorCode::InvalidAttribute,
+        "Collective output tensor Y dimensions do not match input tensor X "
+        "and the group size");
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDataType() != xT->getDataType(), ErrorCode::InvalidAttribute,
+        "Collective output tensor Y must have the data type of input tensor "
+        "X");
+    FUSILLI_RETURN_ERROR_IF(
+        collectiveAttr.getMode() != CollectiveAttr::Mode::ALL_GATHER &&
+            collectiveAttr.getReduceOp() == CollectiveAttr::ReduceOp::AVG &&
+            isIntegralOrBoolType(xT->getDataType()),
+        ErrorCode::InvalidAttribute,
+        "Collective AVG is not supported for integral or boolean tensors");
+
+    return ok();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_COLLECTIVE_NODE_H
@@ -14,17 +14,25 @@
 #ifndef FUSILLI_NODE_CONV_NODE_H
 #define FUSILLI_NODE_CONV_NODE_H
 
+#include "fusilli/attributes/batchnorm_attributes.h"
+#include "fusilli/attributes/common.h"
 #include "fusilli/attributes/conv_attributes.h"
 #include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
 #include "fusilli/graph/context.h"
 #include "fusilli/node/node.h"
 #include "fusilli/support/logging.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace fusilli {
@@ -55,6 +63,100 @@ inline std::vector<int64_t> getConvInferredOutputShape(
   return yDim;
 }
 
+// Infer the output shape of a transposed convolution from the input and
+// (transposed layout) weight shapes, dilation, padding, stride, output padding
+// and group count. This is the shape of the input of the forward convolution
+// that maps the output to the input.
+inline std::vector<int64_t> getConvTransposeInferredOutputShape(
+    const std::vector<int64_t> &xDim, const std::vector<int64_t> &wDim,
+    const std::vector<int64_t> &dilation, const std::vector<int64_t> &padding,
+    const std::vector<int64_t> &stride,
+    const std::vector<int64_t> &outputPadding, int64_t groupCount) {
+  constexpr size_t kSpatialStartIdx = 2;
+  std::vector<int64_t> yDim(xDim.size());
+
+  // N (batch dim)
+  yDim[0] = xDim[0];
+  // K (channel dim)
+  yDim[1] = wDim[1] * groupCount;
+  // HW... (spatial dims)
+  for (size_t i = kSpatialStartIdx; i < xDim.size(); ++i) {
+    size_t j = i - kSpatialStartIdx;
+    yDim[i] = (xDim[i] - 1) * stride[j] - 2 * padding[j] +
+              dilation[j] * (wDim[i] - 1) + outputPadding[j] + 1;
+  }
+  return yDim;
+}
+
+namespace detail {
+
+// Byte size of the floating point types `ConvFPropNode::foldBatchNorm()`
+// computes on the host, or 0 for the other types.
+inline size_t getHostFloatSize(DataType type) {
+  switch (type) {
+  case DataType::Half:
+  case DataType::BFloat16:
+    return 2;
+  case DataType::Float:
+    return 4;
+  case DataType::Double:
+    return 8;
+  default:
+    return 0;
+  }
+}
+
+// Reads or writes the element at `p` of a host float type (see
+// `getHostFloatSize()`) as a double.
+inline double loadHostFloat(const uint8_t *p, DataType type) {
+  switch (type) {
+  case DataType::Half: {
+    uint16_t bits;
+    std::memcpy(&bits, p, sizeof(bits));
+    return Float16::fromBits(bits).toFloat();
+  }
+  case DataType::BFloat16: {
+    uint16_t bits;
+    std::memcpy(&bits, p, sizeof(bits));
+    return BFloat16::fromBits(bits).toFloat();
+  }
+  case DataType::Float: {
+    float value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+  default: {
+    double value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+  }
+}
+inline void storeHostFloat(uint8_t *p, DataType type, double value) {
+  switch (type) {
+  case DataType::Half: {
+    uint16_t bits = Float16(static_cast<float>(value)).toBits();
+    std::memcpy(p, &bits, sizeof(bits));
+    return;
+  }
+  case DataType::BFloat16: {
+    uint16_t bits = BFloat16(static_cast<float>(value)).toBits();
+    std::memcpy(p, &bits, sizeof(bits));
+    return;
+  }
+  case DataType::Float: {
+    auto narrowed = static_cast<float>(value);
+    std::memcpy(p, &narrowed, sizeof(narrowed));
+    return;
+  }
+  default:
+    std::memcpy(p, &value, sizeof(value));
+    return;
+  }
+}
+
+} // namespace detail
+
 //===----------------------------------------------------------------------===//
 // Convolution nodes.
 //===----------------------------------------------------------------------===//
@@ -76,12 +178,171 @@ public:
   std::string getStrideOpsAsm() const;
   std::string getPaddingOpsAsm() const;
   std::string getDilationOpsAsm() const;
+  std::string getDepthwiseInputOpsAsm() const;
+
+  // A depthwise convolution convolves every input channel with its own
+  // filters: the filter has a single input channel and there is more than
+  // one group (the group count equals the input channels).
+  bool isDepthwise() const {
+    constexpr size_t channelsIdx = 1;
+    return convFPropAttr.getW()->getDim()[channelsIdx] == 1 &&
+           convFPropAttr.getX()->getDim()[channelsIdx] > 1;
+  }
+
+  // Number of output channels per input channel of a depthwise convolution.
+  int64_t getDepthwiseMultiplier() const {
+    constexpr size_t inChannelsIdx = 1;
+    constexpr size_t outChannelsIdx = 0;
+    return convFPropAttr.getW()->getDim()[outChannelsIdx] /
+           convFPropAttr.getX()->getDim()[inChannelsIdx];
+  }
 
   const std::string &getName() const override final {
     return convFPropAttr.getName();
   }
   Type getType() const override final { return Type::Convolution; }
 
+  // Two operations (a multiply and an add) per output element and filter
+  // element of its group.
+  double estimateFlops() const override final {
+    const auto &w = convFPropAttr.getW();
+    return 2.0 * static_cast<double>(convFPropAttr.getY()->getVolume()) *
+           static_cast<double>(w->getVolume() / w->getDim()[0]);
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    convFPropAttr.collectTensors(ins, outs);
+    if (foldedBias_)
+      ins.push_back(foldedBias_);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    convFPropAttr.replaceInput(from, to);
+    if (foldedBias_ == from)
+      foldedBias_ = to;
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    convFPropAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final {
+    convFPropAttr.archive(ar);
+    ar.io(foldedBias_);
+  }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    convFPropAttr.hashTensors(fp);
+    fp.update(convFPropAttr.getPadding())
+        .update(convFPropAttr.getStride())
+        .update(convFPropAttr.getDilation())
+        .update(convFPropAttr.getLoweringHint())
+        .tensor(foldedBias_);
+  }
+
+  // Folds the inference batch normalization `bn` of this node's output into
+  // the convolution on the host, see `Graph::foldConvBatchNorms()`. With
+  // k = SCALE / sqrt(VAR + EPSILON) per output channel, the node reads a new
+  // constant filter scaled by k and the constant bias BIAS - MEAN * k, and
+  // produces the output Y of `bn` directly, so no normalization work is left
+  // in the graph. Returns false, leaving the node unchanged, unless `bn` is
+  // in inference mode with an inlined epsilon, and the filter, statistics,
+  // scale and bias (if set) hold constant data (see
+  // `TensorAttr::setConstantData()`) of the output's floating point type.
+  bool foldBatchNorm(const BatchnormAttr &bn) {
+    std::shared_ptr<TensorAttr> wT = convFPropAttr.getW();
+    std::shared_ptr<TensorAttr> yT = convFPropAttr.getY();
+    std::shared_ptr<TensorAttr> epsilonT = bn.getEpsilon();
+    DataType type = wT->getDataType();
+    size_t elementSize = detail::getHostFloatSize(type);
+    if (bn.getForwardPhase() != NormFwdPhase::INFERENCE || bn.getX() != yT ||
+        !bn.getY() || !epsilonT || !epsilonT->isInlinedScalar() ||
+        !epsilonT->getScalarValue() || convFPropAttr.hasScales() ||
+        elementSize == 0 || yT->getDataType() != type ||
+        bn.getY()->getDataType() != type)
+      return false;
+
+    // Constant data packed as the tensor's buffer (see `validateInput()`,
+    // which only runs after this pass), so element offsets follow the
+    // strides.
+    auto hasData = [&](const std::shared_ptr<TensorAttr> &t) {
+      return t && t->hasConstantData() && t->getDataType() == type &&
+             !t->isBlocked() && !t->hasBroadcastDims() &&
+             !t->hasPaddedStrides() &&
+             t->getConstantData()->size() ==
+                 static_cast<size_t>(t->getVolume()) * elementSize;
+    };
+    if (!hasData(wT) || !hasData(bn.getMEAN()) || !hasData(bn.getVAR()) ||
+        (bn.getSCALE() && !hasData(bn.getSCALE())) ||
+        (bn.getBIAS() && !hasData(bn.getBIAS())))
+      return false;
+
+    FUSILLI_LOG_LABEL_ENDL("INFO: Folding BatchNormNode '"
+                           << bn.getName() << "' into ConvFPropNode '"
+                           << convFPropAttr.getName() << "'");
+    // Per channel scale k and bias, the channel tensors being 1D.
+    double epsilon = std::visit(
+        [](auto value) { return static_cast<double>(value); },
+        *epsilonT->getScalarValue());
+    auto channel = [&](const std::shared_ptr<TensorAttr> &t, int64_t c) {
+      return detail::loadHostFloat(
+          t->getConstantData()->data() + c * elementSize, type);
+    };
+    const int64_t channels = wT->getDim()[0];
+    std::vector<double> k(channels);
+    std::vector<uint8_t> bias(channels * elementSize);
+    for (int64_t c = 0; c < channels; ++c) {
+      k[c] = 1.0 / std::sqrt(channel(bn.getVAR(), c) + epsilon);
+      if (bn.getSCALE())
+        k[c] *= channel(bn.getSCALE(), c);
+      double shift = bn.getBIAS() ? channel(bn.getBIAS(), c) : 0.0;
+      detail::storeHostFloat(bias.data() + c * elementSize, type,
+                             shift - channel(bn.getMEAN(), c) * k[c]);
+    }
+
+    // Scale every filter element by the k of its output channel (logical
+    // dim 0), walking the logical indices.
+    const std::vector<int64_t> &dim = wT->getDim();
+    const std::vector<int64_t> &stride = wT->getStride();
+    std::vector<uint8_t> filter = *wT->getConstantData();
+    std::vector<int64_t> index(dim.size(), 0);
+    for (int64_t e = 0; e < wT->getVolume(); ++e) {
+      int64_t offset = 0;
+      for (size_t i = 0; i < dim.size(); ++i)
+        offset += index[i] * stride[i];
+      uint8_t *p = filter.data() + offset * elementSize;
+      detail::storeHostFloat(p, type,
+                             detail::loadHostFloat(p, type) * k[index[0]]);
+      for (size_t i = dim.size(); i-- > 0;) {
+        if (++index[i] < dim[i])
+          break;
+        index[i] = 0;
+      }
+    }
+
+    auto foldedW = std::make_shared<TensorAttr>(*wT);
+    foldedW->setName(bn.getName() + "_FOLDED_W")
+        .setConstantData(std::move(filter));
+    foldedBias_ = std::make_shared<TensorAttr>(
+        TensorAttr()
+            .setName(bn.getName() + "_FOLDED_BIAS")
+            .setDataType(type)
+            .setDim({channels})
+            .setStride({1})
+            .setConstantData(std::move(bias)));
+    convFPropAttr.setW(foldedW).setY(bn.getY());
+    return true;
+  }
+
+  // The constant bias of a batch normalization folded by `foldBatchNorm()`,
+  // or null.
+  const std::shared_ptr<TensorAttr> &getFoldedBias() const {
+    return foldedBias_;
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ConvFPropNode '"
                            << convFPropAttr.getName() << "'");
@@ -165,6 +426,30 @@ public:
         outChannels % groupCount != 0, ErrorCode::InvalidAttribute,
         "Conv output channels must be divisible by the group count");
 
+    // Lowering hint checks, the Winograd and im2col rewrites only match
+    // ungrouped 2D convolutions on unscaled operands.
+    ConvFPropAttr::LoweringHint hint = convFPropAttr.getLoweringHint();
+    if (hint == ConvFPropAttr::LoweringHint::WINOGRAD ||
+        hint == ConvFPropAttr::LoweringHint::IM2COL) {
+      const std::string &hintStr =
+          ConvFPropAttr::kLoweringHintToStr.at(hint);
+      FUSILLI_RETURN_ERROR_IF(
+          numSpatialDims != 2 || groupCount != 1 || convFPropAttr.hasScales(),
+          ErrorCode::NotImplemented,
+          "Conv lowering hint " + hintStr +
+              " requires an ungrouped, unquantized 2D convolution");
+    }
+    if (hint == ConvFPropAttr::LoweringHint::WINOGRAD) {
+      auto isOne = [](int64_t v) { return v == 1; };
+      const std::vector<int64_t> &wDim = wT->getDim();
+      FUSILLI_RETURN_ERROR_IF(
+          wDim[2] != 3 || wDim[3] != 3 || !std::ranges::all_of(stride, isOne) ||
+              !std::ranges::all_of(dilation, isOne),
+          ErrorCode::NotImplemented,
+          "Conv lowering hint WINOGRAD requires a 3x3 filter with unit "
+          "stride and dilation");
+    }
+
     return ok();
   }
 
@@ -172,6 +457,12 @@ public:
     FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for ConvFPropNode '"
                            << convFPropAttr.getName() << "'");
 
+    // Scales are f32 unless set otherwise.
+    for (const std::shared_ptr<TensorAttr> &scaleT :
+         {convFPropAttr.getSCALE_X(), convFPropAttr.getSCALE_W()})
+      if (scaleT && scaleT->getDataType() == DataType::NotSet)
+        scaleT->setDataType(DataType::Float);
+
     convFPropAttr.fillFromContext(context);
 
     // Logical layout is always channels-first (NCHW if 4D).
@@ -248,8 +539,46 @@ public:
                                 "' is neither contiguous nor channels-last as "
                                 "defined by its stride");
 
+    if (convFPropAttr.hasScales()) {
+      DataType xType = xT->getDataType();
+      FUSILLI_RETURN_ERROR_IF(
+          xType != wT->getDataType() ||
+              getQuantizedAccumulatorType(xType) == DataType::NotSet,
+          ErrorCode::InvalidAttribute,
+          "Conv scales require input tensor X and weight tensor W of the same "
+          "FP8 or Int8 data type");
+      // SCALE_X is per tensor, SCALE_W may vary along the output channels.
+      constexpr size_t channelsIdx = 1;
+      const std::vector<int64_t> &yDim = yT->getDim();
+      for (const auto &[t, name, perChannel, shape] :
+           {std::tuple{convFPropAttr.getSCALE_X(), "SCALE_X", false,
+                       "per tensor (all dims 1)"},
+            std::tuple{convFPropAttr.getSCALE_W(), "SCALE_W", true,
+                       "per tensor or per output channel [1, K, 1, ...]"}}) {
+        if (!t)
+          continue;
+        const std::vector<int64_t> &scaleDim = t->getDim();
+        bool isBroadcastable = scaleDim.size() == yRank;
+        for (size_t i = 0; isBroadcastable && i < yRank; ++i)
+          isBroadcastable =
+              scaleDim[i] == 1 ||
+              (perChannel && i == channelsIdx && scaleDim[i] == yDim[i]);
+        FUSILLI_RETURN_ERROR_IF(!isBroadcastable, ErrorCode::InvalidAttribute,
+                                std::string("Conv scale tensor ") + name +
+                                    " must be " + shape);
+        FUSILLI_RETURN_ERROR_IF(t->getDataType() != DataType::Float,
+                                ErrorCode::InvalidAttribute,
+                                std::string("Conv scale tensor ") + name +
+                                    " must have data type Float");
+      }
+    }
+
     return ok();
   }
+
+private:
+  // Set by `foldBatchNorm()`.
+  std::shared_ptr<TensorAttr> foldedBias_;
 };
 
 class ConvWGradNode : public NodeCRTP<ConvWGradNode> {
@@ -276,6 +605,37 @@ public:
   }
   Type getType() const override final { return Type::WGrad; }
 
+  // Same as the forward convolution: two operations per element of DY and
+  // filter element of its group.
+  double estimateFlops() const override final {
+    const auto &dw = convWGradAttr.getDW();
+    return 2.0 * static_cast<double>(convWGradAttr.getDY()->getVolume()) *
+           static_cast<double>(dw->getVolume() / dw->getDim()[0]);
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    convWGradAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    convWGradAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    convWGradAttr.replaceOutput(from, to);
+  }
+
+  void archiveNode(Archive &ar) override final { convWGradAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    convWGradAttr.hashTensors(fp);
+    fp.update(convWGradAttr.getPadding())
+        .update(convWGradAttr.getStride())
+        .update(convWGradAttr.getDilation());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ConvWGradNode '"
                            << convWGradAttr.getName() << "'");
@@ -386,6 +746,15 @@ public:
       dwT->setStride(std::move(wStride));
     }
 
+    // The bias gradient has one value per output channel.
+    if (std::shared_ptr<TensorAttr> dbT = convWGradAttr.getDBIAS()) {
+      constexpr size_t channelsIdx = 1;
+      if (dbT->getDim().empty())
+        dbT->setDim({dyT->getDim()[channelsIdx]});
+      if (dbT->getStride().empty())
+        dbT->setStride({1});
+    }
+
     return ok();
   }
 
@@ -421,6 +790,19 @@ public:
                                 "' is neither contiguous nor channels-last as "
                                 "defined by its stride");
 
+    if (std::shared_ptr<TensorAttr> dbT = convWGradAttr.getDBIAS()) {
+      constexpr size_t channelsIdx = 1;
+      FUSILLI_RETURN_ERROR_IF(
+          dbT->getDim() != std::vector<int64_t>{dyT->getDim()[channelsIdx]},
+          ErrorCode::InvalidAttribute,
+          "ConvWGrad bias gradient tensor DBIAS must be 1D with size equal "
+          "to the DY channel dimension");
+      FUSILLI_RETURN_ERROR_IF(!dbT->isContiguous(), ErrorCode::NotImplemented,
+                              "Tensor '" + dbT->getName() +
+                                  "' is not contiguous as defined by its "
+                                  "stride");
+    }
+
     return ok();
   }
 };
@@ -449,6 +831,37 @@ public:
   }
   Type getType() const override final { return Type::DGrad; }
 
+  // Same as the forward convolution: two operations per element of DY and
+  // filter element of its group.
+  double estimateFlops() const override final {
+    const auto &w = convDGradAttr.getW();
+    return 2.0 * static_cast<double>(convDGradAttr.getDY()->getVolume()) *
+           static_cast<double>(w->getVolume() / w->getDim()[0]);
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    convDGradAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    convDGradAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    convDGradAttr.replaceOutput(from, to);
+  }
+
+  void archiveNode(Archive &ar) override final { convDGradAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    convDGradAttr.hashTensors(fp);
+    fp.update(convDGradAttr.getPadding())
+        .update(convDGradAttr.getStride())
+        .update(convDGradAttr.getDilation());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ConvDGradNode '"
                            << convDGradAttr.getName() << "'");
@@ -597,6 +1010,244 @@ public:
   }
 };
 
+class ConvTransposeNode : public NodeCRTP<ConvTransposeNode> {
+public:
+  ConvTransposeAttr convTransposeAttr;
+
+  ConvTransposeNode(ConvTransposeAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), convTransposeAttr(std::move(attr)) {}
+
+  // MLIR assembly emitter helper methods.
+  std::string emitNodePreAsm() const override final;
+  std::string getOperandNamesAsm() const;
+  std::string getOperandTypesAsm() const;
+  std::string getResultNamesAsm() const;
+  std::string getResultTypesAsm() const;
+  std::string getGroupOpsAsm() const;
+  std::string getStrideOpsAsm() const;
+  std::string getPaddingOpsAsm() const;
+  std::string getDilationOpsAsm() const;
+  std::string getOutputPaddingOpsAsm() const;
+
+  // The output padding of every spatial dim, zeros when not set.
+  std::vector<int64_t> getOutputPadding() const {
+    const std::vector<int64_t> &outputPadding =
+        convTransposeAttr.getOutputPadding();
+    if (!outputPadding.empty())
+      return outputPadding;
+    return std::vector<int64_t>(convTransposeAttr.getStride().size(), 0);
+  }
+
+  const std::string &getName() const override final {
+    return convTransposeAttr.getName();
+  }
+  Type getType() const override final { return Type::ConvTranspose; }
+
+  // Two operations per input element and filter element of its group, each
+  // input element being scattered over the output.
+  double estimateFlops() const override final {
+    const auto &w = convTransposeAttr.getW();
+    return 2.0 * static_cast<double>(convTransposeAttr.getX()->getVolume()) *
+           static_cast<double>(w->getVolume() / w->getDim()[0]);
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    convTransposeAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    convTransposeAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    convTransposeAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final {
+    convTransposeAttr.archive(ar);
+  }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    convTransposeAttr.hashTensors(fp);
+    fp.update(convTransposeAttr.getPadding())
+        .update(convTransposeAttr.getStride())
+        .update(convTransposeAttr.getDilation())
+        .update(getOutputPadding())
+        .update(convTransposeAttr.getGroupCount());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ConvTransposeNode '"
+                           << convTransposeAttr.getName() << "'");
+
+    const std::vector<int64_t> &padding = convTransposeAttr.getPadding();
+    const std::vector<int64_t> &stride = convTransposeAttr.getStride();
+    const std::vector<int64_t> &dilation = convTransposeAttr.getDilation();
+    const std::vector<int64_t> &outputPadding =
+        convTransposeAttr.getOutputPadding();
+    FUSILLI_RETURN_ERROR_IF(padding.empty(), ErrorCode::AttributeNotSet,
+                            "ConvTranspose padding not set");
+    FUSILLI_RETURN_ERROR_IF(stride.empty(), ErrorCode::AttributeNotSet,
+                            "ConvTranspose stride not set");
+    FUSILLI_RETURN_ERROR_IF(dilation.empty(), ErrorCode::AttributeNotSet,
+                            "ConvTranspose dilation not set");
+
+    std::shared_ptr<TensorAttr> xT = convTransposeAttr.getX();
+    std::shared_ptr<TensorAttr> wT = convTransposeAttr.getW();
+    std::shared_ptr<TensorAttr> yT = convTransposeAttr.getY();
+
+    // Ensure input and weight tensors are set.
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "ConvTranspose input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!wT, ErrorCode::AttributeNotSet,
+                            "ConvTranspose weight tensor W not set");
+    FUSILLI_RETURN_ERROR_IF(!yT, ErrorCode::AttributeNotSet,
+                            "ConvTranspose output tensor Y not set");
+
+    size_t xRank = xT->getDim().size();
+    size_t wRank = wT->getDim().size();
+
+    FUSILLI_RETURN_ERROR_IF(
+        xRank < 3, ErrorCode::InvalidAttribute,
+        "ConvTranspose input tensor X must have a rank of at least 3");
+    FUSILLI_RETURN_ERROR_IF(xRank != wRank, ErrorCode::InvalidAttribute,
+                            "ConvTranspose input tensor X and weight tensor W "
+                            "have different ranks");
+
+    // Check padding, stride, dilation and output padding match rank of conv
+    // All dims except batch and channel (feature) are spatial dims
+    size_t numSpatialDims = xRank - 2;
+    FUSILLI_RETURN_ERROR_IF(padding.size() != numSpatialDims,
+                            ErrorCode::InvalidAttribute,
+                            "ConvTranspose padding size does not match number "
+                            "of spatial dimensions");
+    FUSILLI_RETURN_ERROR_IF(stride.size() != numSpatialDims,
+                            ErrorCode::InvalidAttribute,
+                            "ConvTranspose stride size does not match number "
+                            "of spatial dimensions");
+    FUSILLI_RETURN_ERROR_IF(dilation.size() != numSpatialDims,
+                            ErrorCode::InvalidAttribute,
+                            "ConvTranspose dilation size does not match "
+                            "number of spatial dimensions");
+    FUSILLI_RETURN_ERROR_IF(
+        !outputPadding.empty() && outputPadding.size() != numSpatialDims,
+        ErrorCode::InvalidAttribute,
+        "ConvTranspose output padding size does not match number of spatial "
+        "dimensions");
+
+    // The output padding only picks one of the `stride` output sizes that
+    // convolve to the same input size, so it must be smaller than the stride
+    // or dilation.
+    for (size_t i = 0; i < outputPadding.size(); ++i)
+      FUSILLI_RETURN_ERROR_IF(
+          outputPadding[i] < 0 ||
+              outputPadding[i] >= std::max(stride[i], dilation[i]),
+          ErrorCode::InvalidAttribute,
+          "ConvTranspose output padding must be non-negative and smaller "
+          "than either the stride or the dilation");
+
+    // Layout checks on input and weight tensors.
+    FUSILLI_RETURN_ERROR_IF(!xT->isContiguous() && !xT->isChannelsLast(),
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + xT->getName() +
+                                "' is neither contiguous nor channels-last as "
+                                "defined by its stride");
+    FUSILLI_RETURN_ERROR_IF(!wT->isContiguous() && !wT->isChannelsLast(),
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + wT->getName() +
+                                "' is neither contiguous nor channels-last as "
+                                "defined by its stride");
+
+    // Group count checks, the filter is [C, K/G, ...].
+    constexpr size_t channelsIdx = 1;
+    constexpr size_t filterInChannelsIdx = 0;
+    int64_t inChannels = xT->getDim()[channelsIdx];
+    int64_t groupCount = convTransposeAttr.getGroupCount();
+    FUSILLI_RETURN_ERROR_IF(
+        wT->getDim()[filterInChannelsIdx] != inChannels,
+        ErrorCode::InvalidAttribute,
+        "ConvTranspose weight tensor W dim 0 must match the input channels");
+    FUSILLI_RETURN_ERROR_IF(groupCount <= 0 || inChannels % groupCount != 0,
+                            ErrorCode::InvalidAttribute,
+                            "ConvTranspose group count must be greater than 0 "
+                            "and divide the input channels");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for ConvTransposeNode '"
+                           << convTransposeAttr.getName() << "'");
+
+    convTransposeAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> xT = convTransposeAttr.getX();
+    std::shared_ptr<TensorAttr> wT = convTransposeAttr.getW();
+    std::shared_ptr<TensorAttr> yT = convTransposeAttr.getY();
+
+    std::vector<int64_t> yDim = yT->getDim();
+    if (yDim.empty()) {
+      yDim = getConvTransposeInferredOutputShape(
+          xT->getDim(), wT->getDim(), convTransposeAttr.getDilation(),
+          convTransposeAttr.getPadding(), convTransposeAttr.getStride(),
+          getOutputPadding(), convTransposeAttr.getGroupCount());
+      yT->setDim(yDim);
+    }
+
+    if (yT->getStride().empty()) {
+      // When unspecified, preserve the stride order of xT (input tensor).
+      yT->setStride(
+          xT->isContiguous()
+              ? generateStrideFromDim(yDim,
+                                      getContiguousStrideOrder(yDim.size()))
+              : generateStrideFromDim(
+                    yDim, getChannelsLastStrideOrder(yDim.size())));
+    }
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating ConvTransposeNode '"
+                           << convTransposeAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = convTransposeAttr.getX();
+    std::shared_ptr<TensorAttr> wT = convTransposeAttr.getW();
+    std::shared_ptr<TensorAttr> yT = convTransposeAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        xT->getDim().size() != yT->getDim().size(),
+        ErrorCode::InvalidAttribute,
+        "ConvTranspose input tensor X and output tensor Y have different "
+        "ranks");
+
+    std::vector<int64_t> yDim = getConvTransposeInferredOutputShape(
+        xT->getDim(), wT->getDim(), convTransposeAttr.getDilation(),
+        convTransposeAttr.getPadding(), convTransposeAttr.getStride(),
+        getOutputPadding(), convTransposeAttr.getGroupCount());
+    for (size_t i = 2; i < yDim.size(); ++i)
+      FUSILLI_RETURN_ERROR_IF(yDim[i] <= 0, ErrorCode::InvalidAttribute,
+                              "ConvTranspose output tensor Y has a "
+                              "non-positive spatial dimension");
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != yDim, ErrorCode::InvalidAttribute,
+        "ConvTranspose output tensor Y dimensions do not match the expected "
+        "shapes inferred based on the input and weight dimensions");
+
+    // Contiguity check for output tensor.
+    FUSILLI_RETURN_ERROR_IF(!yT->isContiguous() && !yT->isChannelsLast(),
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + yT->getName() +
+                                "' is neither contiguous nor channels-last as "
+                                "defined by its stride");
+
+    return ok();
+  }
+};
+
 } // namespace fusilli
 
 #endif // FUSILLI_NODE_CONV_NODE_H
@@ -20,10 +20,14 @@
 #include "fusilli/attributes/types.h"
 #include "fusilli/graph/context.h"
 #include "fusilli/node/node.h"
+#include "fusilli/support/cache.h"
 #include "fusilli/support/logging.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -53,13 +57,61 @@ public:
   }
   Type getType() const override final { return Type::Custom; }
 
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    ins.insert(ins.end(), inputs.begin(), inputs.end());
+    outs.insert(outs.end(), outputs.begin(), outputs.end());
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    std::replace(inputs.begin(), inputs.end(), from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    std::replace(outputs.begin(), outputs.end(), from, to);
+  }
+
+  void archiveNode(Archive &ar) override final {
+    ar.io(customOpAttr).io(inputs).io(outputs);
+  }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    fp.update(customOpAttr.getMlir()).update(customOpAttr.getNumOutputs());
+    if (const auto &kernel = customOpAttr.getExternalKernel()) {
+      fp.update(kernel->backend)
+          .update(kernel->format)
+          .update(kernel->targetArch)
+          .update(kernel->entryPoint);
+      for (size_t d = 0; d < 3; ++d)
+        fp.update(kernel->workgroupSize[d]).update(kernel->workgroupCount[d]);
+      // The object is embedded in the artifact, so a rebuilt kernel must
+      // change the fingerprint.
+      if (auto bytes = readFileBytes(kernel->objectPath); isOk(bytes))
+        fp.update(std::string_view(reinterpret_cast<const char *>(
+                                       (*bytes).data()),
+                                   (*bytes).size()));
+    }
+    fp.update(inputs.size());
+    for (const auto &input : inputs)
+      fp.tensor(input);
+    fp.update(outputs.size());
+    for (const auto &output : outputs)
+      fp.tensor(output);
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating CustomOpNode '"
                            << customOpAttr.getName() << "'");
 
-    FUSILLI_RETURN_ERROR_IF(customOpAttr.getMlir().empty(),
+    FUSILLI_RETURN_ERROR_IF(customOpAttr.getMlir().empty() &&
+                                !customOpAttr.getExternalKernel(),
                             ErrorCode::AttributeNotSet,
                             "CustomOp MLIR not set");
+    FUSILLI_RETURN_ERROR_IF(!customOpAttr.getMlir().empty() &&
+                                customOpAttr.getExternalKernel(),
+                            ErrorCode::InvalidAttribute,
+                            "CustomOp has both MLIR and an external kernel");
 
     FUSILLI_RETURN_ERROR_IF(inputs.empty(), ErrorCode::AttributeNotSet,
                             "CustomOp inputs not set");
@@ -80,20 +132,47 @@ public:
                               ErrorCode::InvalidAttribute,
                               "CustomOp output " + std::to_string(i) +
                                   " is scalar (not supported)");
+      bool sameAsInput = customOpAttr.getOutputRule(i) ==
+                         CustomOpAttr::OutputRule::SameAsInput;
+      FUSILLI_RETURN_ERROR_IF(
+          sameAsInput && customOpAttr.getOutputRuleInput(i) >= inputs.size(),
+          ErrorCode::InvalidAttribute,
+          "CustomOp output " + std::to_string(i) +
+              " is inferred from a non-existent input");
     }
 
     return ok();
   }
 
+  // Name of the function called by this node: its own, or the one of an
+  // earlier node of the graph with an identical instantiation, see
+  // `Graph::shareCustomOpFunctions()`.
+  const std::string &getCalleeName() const {
+    return sharedCallee_.empty() ? customOpAttr.getName() : sharedCallee_;
+  }
+  void setSharedCallee(const std::string &callee) { sharedCallee_ = callee; }
+
+  // Returns the key identifying the instantiation of the MLIR template: the
+  // template hash and the type signature, which determine every placeholder
+  // but `{FUNC_NAME}`. Empty for external kernels, which are not shared.
+  std::string getInstantiationKey() const;
+
   // Resolves all placeholders in the MLIR template:
   //   {FUNC_NAME}                    — node name
   //   {IN<i>_DTYPE}/{OUT<i>_DTYPE}   — element type (e.g., "f32")
   //   {IN<i>_TYPE}/{OUT<i>_TYPE}     — full value tensor type
   //   {IN<i>_DIM<j>}/{OUT<i>_DIM<j>} — logical dimension, or `?` when dynamic
   //
+  // Everything but `{FUNC_NAME}` is resolved once per instantiation key and
+  // cached process-wide, see `getCustomOpInstantiation()`.
+  //
   // Definition in asm_emitter.h (needs getTensorTypeAsm()).
   std::string resolveMlirPlaceholders() const;
 
+  // Emits the `hal.executable.source` embedding the external kernel and the
+  // function dispatching it (definition in asm_emitter.h).
+  std::string getExternalKernelAsm() const;
+
   ErrorObject inferPropertiesNode() override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for CustomOpNode '"
                            << customOpAttr.getName() << "'");
@@ -102,6 +181,124 @@ public:
     for (auto &input : inputs)
       input->fillFromContext(context);
 
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      switch (customOpAttr.getOutputRule(i)) {
+      case CustomOpAttr::OutputRule::None:
+        break;
+      case CustomOpAttr::OutputRule::SameAsInput:
+        inferSameAsInput(outputs[i],
+                         inputs[customOpAttr.getOutputRuleInput(i)]);
+        break;
+      case CustomOpAttr::OutputRule::BroadcastOfInputs:
+        FUSILLI_CHECK_ERROR(inferBroadcastOfInputs(outputs[i]));
+        break;
+      }
+    }
+    if (const auto &shapeInference = customOpAttr.getShapeInference())
+      FUSILLI_CHECK_ERROR(shapeInference(inputs, outputs));
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    if (const auto &kernel = customOpAttr.getExternalKernel())
+      FUSILLI_CHECK_ERROR(validateExternalKernel(*kernel));
+    return ok();
+  }
+
+  // The emitter converts every input to logical dim order before the call and
+  // every result back after it (see `emitNodePreAsm()`), and the custom
+  // function is written in logical dims.
+  bool isLayoutAgnostic() const override final { return true; }
+
+private:
+  std::string sharedCallee_;
+
+  ErrorObject validateExternalKernel(const ExternalKernel &kernel) const {
+    FUSILLI_RETURN_ERROR_IF(kernel.entryPoint.empty(),
+                            ErrorCode::AttributeNotSet,
+                            "CustomOp external kernel entry point not set");
+    FUSILLI_RETURN_ERROR_IF(!std::filesystem::is_regular_file(
+                                kernel.objectPath),
+                            ErrorCode::FileSystemFailure,
+                            "CustomOp external kernel object not found: '" +
+                                kernel.objectPath + "'");
+    for (size_t d = 0; d < 3; ++d) {
+      FUSILLI_RETURN_ERROR_IF(kernel.workgroupSize[d] <= 0 ||
+                                  kernel.workgroupCount[d] <= 0,
+                              ErrorCode::InvalidAttribute,
+                              "CustomOp external kernel launch dims must be "
+                              "positive");
+    }
+    // The ABI has no push constants to pass dynamic extents.
+    for (const auto &tensor : inputs) {
+      FUSILLI_RETURN_ERROR_IF(tensor->hasDynamicDims(),
+                              ErrorCode::NotImplemented,
+                              "CustomOp external kernels require static "
+                              "shapes");
+    }
+    for (const auto &tensor : outputs) {
+      FUSILLI_RETURN_ERROR_IF(tensor->hasDynamicDims(),
+                              ErrorCode::NotImplemented,
+                              "CustomOp external kernels require static "
+                              "shapes");
+    }
+    return ok();
+  }
+
+  // Fills the unset properties of `output` from `input`.
+  static void inferSameAsInput(const std::shared_ptr<TensorAttr> &output,
+                               const std::shared_ptr<TensorAttr> &input) {
+    if (output->getDim().empty())
+      output->setDim(input->getDim()).setDynamicDims(input->getDynamicDims());
+    if (output->getStride().empty() && output->getDim() == input->getDim())
+      output->setStride(input->getCompactStride());
+    if (output->getDataType() == DataType::NotSet)
+      output->setDataType(input->getDataType());
+  }
+
+  // Fills the unset properties of `output` with the broadcast of all inputs,
+  // following `PointwiseNode::inferPropertiesNode()`. An output dim is dynamic
+  // when an input dim aligned with it is.
+  ErrorObject
+  inferBroadcastOfInputs(const std::shared_ptr<TensorAttr> &output) const {
+    if (output->getDim().empty()) {
+      std::vector<std::vector<int64_t>> inputShapes;
+      inputShapes.reserve(inputs.size());
+      for (const auto &input : inputs)
+        inputShapes.push_back(input->getDim());
+      FUSILLI_ASSIGN_OR_RETURN(auto broadcastShape,
+                               computeBroadcastShape(inputShapes));
+
+      std::vector<size_t> dynamicDims;
+      for (size_t d = 0; d < broadcastShape.size(); ++d) {
+        size_t fromBack = broadcastShape.size() - d;
+        if (std::ranges::any_of(inputs, [&](const auto &input) {
+              size_t rank = input->getDim().size();
+              return fromBack <= rank && input->isDynamicDim(rank - fromBack);
+            }))
+          dynamicDims.push_back(d);
+      }
+      output->setDim(std::move(broadcastShape)).setDynamicDims(dynamicDims);
+    }
+
+    if (output->getStride().empty()) {
+      // Take the stride of the first input with the output shape, otherwise
+      // one with the same format as input 0.
+      auto it = std::ranges::find_if(inputs, [&](const auto &input) {
+        return input->getDim() == output->getDim();
+      });
+      output->setStride(
+          it != inputs.end()
+              ? (*it)->getCompactStride()
+              : generateStrideFromDim(
+                    output->getDim(),
+                    generateStrideOrderPreservingFormat(
+                        inputs[0]->getStride(), output->getDim().size())));
+    }
+
+    if (output->getDataType() == DataType::NotSet)
+      output->setDataType(inputs[0]->getDataType());
     return ok();
   }
 };
@@ -6,8 +6,8 @@
 
 //===----------------------------------------------------------------------===//
 //
-// This file contains definitions for the layer normalization node
-// `LayerNormNode`.
+// This file contains definitions for the layer normalization nodes
+// `LayerNormNode` and `LayerNormBwdNode`.
 //
 //===----------------------------------------------------------------------===//
 
@@ -56,6 +56,28 @@ public:
   }
   Type getType() const override final { return Type::LayerNorm; }
 
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    layernormAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    layernormAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    layernormAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { layernormAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    layernormAttr.hashTensors(fp);
+    fp.update(layernormAttr.getForwardPhase());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating LayerNormNode '"
                            << layernormAttr.getName() << "'");
@@ -146,6 +168,28 @@ public:
           "LayerNorm output tensor INV_VARIANCE should not be set");
     }
 
+    // Residual checks. The fused residual add normalizes X + RESIDUAL and
+    // also produces the (pre-normalization) sum as SUM.
+    std::shared_ptr<TensorAttr> resT = layernormAttr.getRESIDUAL();
+    std::shared_ptr<TensorAttr> sumT = layernormAttr.getSUM();
+    FUSILLI_RETURN_ERROR_IF(
+        static_cast<bool>(resT) != static_cast<bool>(sumT),
+        ErrorCode::AttributeNotSet,
+        "LayerNorm RESIDUAL and SUM tensors must be set together");
+    if (resT) {
+      FUSILLI_RETURN_ERROR_IF(resT == xT, ErrorCode::InvalidAttribute,
+                              "LayerNorm input tensor RESIDUAL must not be X");
+      FUSILLI_RETURN_ERROR_IF(
+          resT->getDim() != xT->getDim(), ErrorCode::InvalidAttribute,
+          "LayerNorm input tensor RESIDUAL must have the same shape as input X "
+          "tensor");
+      FUSILLI_RETURN_ERROR_IF(!resT->isContiguous() && !resT->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + resT->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+    }
+
     // Epsilon checks.
     std::shared_ptr<TensorAttr> eT = layernormAttr.getEpsilon();
     FUSILLI_RETURN_ERROR_IF(!eT, ErrorCode::AttributeNotSet,
@@ -181,7 +225,11 @@ public:
 
     // Infer shape and stride of output Y tensor.
     // When stride is unspecified, preserve the stride order of xT.
-    norm_utils::inferDimAndStride(yT, xDim, xT->getStride());
+    norm_utils::inferDimAndStride(yT, xDim, xT->getCompactStride());
+
+    // Infer shape and stride of output SUM tensor (same as X).
+    if (std::shared_ptr<TensorAttr> sumT = layernormAttr.getSUM())
+      norm_utils::inferDimAndStride(sumT, xDim, xT->getCompactStride());
 
     if (isTrainingForwardPhase()) {
       const auto &[dim, stride] =
@@ -220,6 +268,19 @@ public:
                                 "' is neither contiguous nor channels-last as "
                                 "defined by its stride");
 
+    // Shape and layout checks for output SUM tensor.
+    if (std::shared_ptr<TensorAttr> sumT = layernormAttr.getSUM()) {
+      FUSILLI_RETURN_ERROR_IF(
+          xDim != sumT->getDim(), ErrorCode::InvalidAttribute,
+          "LayerNorm output SUM tensor must have the same shape as input X "
+          "tensor");
+      FUSILLI_RETURN_ERROR_IF(!sumT->isContiguous() && !sumT->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + sumT->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+    }
+
     if (isTrainingForwardPhase()) {
       const auto &[dim, stride] =
           norm_utils::getTrainingForwardOutputDimAndStride(xDim);
@@ -261,6 +322,204 @@ private:
   std::vector<int64_t> getNormalizedShape() const {
     return norm_utils::getNormalizedShape(layernormAttr.getX()->getDim());
   }
+
+  // The normalized tensor: X, or the sum of X and RESIDUAL when fused.
+  std::shared_ptr<TensorAttr> getNormInput() const {
+    std::shared_ptr<TensorAttr> sumT = layernormAttr.getSUM();
+    return sumT ? sumT : layernormAttr.getX();
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// Layer normalization backward node.
+//===----------------------------------------------------------------------===//
+
+// Computes the gradients DX, DSCALE and DBIAS of a layer normalization in one
+// pass over DY and X, from the MEAN and INV_VARIANCE saved by the training
+// forward pass. DSCALE and DBIAS are only computed with a SCALE.
+class LayerNormBwdNode : public NodeCRTP<LayerNormBwdNode> {
+public:
+  LayernormBwdAttr layernormBwdAttr;
+
+  LayerNormBwdNode(LayernormBwdAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), layernormBwdAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return layernormBwdAttr.getName();
+  }
+  Type getType() const override final { return Type::LayerNormBwd; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    layernormBwdAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    layernormBwdAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    layernormBwdAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final {
+    layernormBwdAttr.archive(ar);
+  }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    layernormBwdAttr.hashTensors(fp);
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating LayerNormBwdNode '"
+                           << layernormBwdAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> dyT = layernormBwdAttr.getDY();
+    std::shared_ptr<TensorAttr> xT = layernormBwdAttr.getX();
+    std::shared_ptr<TensorAttr> sT = layernormBwdAttr.getSCALE();
+    std::shared_ptr<TensorAttr> mT = layernormBwdAttr.getMEAN();
+    std::shared_ptr<TensorAttr> vT = layernormBwdAttr.getINV_VARIANCE();
+    std::shared_ptr<TensorAttr> dxT = layernormBwdAttr.getDX();
+    std::shared_ptr<TensorAttr> dsT = layernormBwdAttr.getDSCALE();
+
+    // Ensure mandatory input and output tensors are set.
+    FUSILLI_RETURN_ERROR_IF(!dyT, ErrorCode::AttributeNotSet,
+                            "LayerNorm backward input tensor DY not set");
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "LayerNorm backward input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!mT, ErrorCode::AttributeNotSet,
+                            "LayerNorm backward input tensor MEAN not set");
+    FUSILLI_RETURN_ERROR_IF(
+        !vT, ErrorCode::AttributeNotSet,
+        "LayerNorm backward input tensor INV_VARIANCE not set");
+    FUSILLI_RETURN_ERROR_IF(!dxT, ErrorCode::AttributeNotSet,
+                            "LayerNorm backward output tensor DX not set");
+    FUSILLI_RETURN_ERROR_IF(
+        static_cast<bool>(sT) != static_cast<bool>(dsT),
+        ErrorCode::AttributeNotSet,
+        "LayerNorm backward SCALE and DSCALE tensors must be set together");
+
+    // Shape and layout checks on input tensors.
+    FUSILLI_RETURN_ERROR_IF(
+        xT->getDim().size() < 2, ErrorCode::InvalidAttribute,
+        "LayerNorm backward input tensor X must have a rank of at least 2");
+    FUSILLI_RETURN_ERROR_IF(
+        dyT->getDim() != xT->getDim(), ErrorCode::InvalidAttribute,
+        "LayerNorm backward input tensor DY must have the same shape as "
+        "input X tensor");
+    for (const auto &t : {xT, dyT})
+      FUSILLI_RETURN_ERROR_IF(!t->isContiguous() && !t->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + t->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+
+    // Shape and layout checks on scale tensor.
+    // If scale tensor's dims/strides are not set, they will be inferred in
+    // inferPropertiesNode().
+    if (sT) {
+      FUSILLI_RETURN_ERROR_IF(
+          !sT->getDim().empty() &&
+              sT->getDim() != norm_utils::getScaleBiasDim(xT->getDim()),
+          ErrorCode::InvalidAttribute,
+          "LayerNorm backward input tensor SCALE must have shape as tensor X "
+          "with single batch");
+      FUSILLI_RETURN_ERROR_IF(!sT->getStride().empty() &&
+                                  !sT->isContiguous() && !sT->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + sT->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+    }
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for LayerNormBwdNode '"
+                           << layernormBwdAttr.getName() << "'");
+
+    layernormBwdAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> xT = layernormBwdAttr.getX();
+    const std::vector<int64_t> &xDim = xT->getDim();
+    const std::vector<int64_t> &xStride = xT->getStride();
+
+    // Infer shape and stride of the saved statistics if they're not set.
+    const auto &[statDim, statStride] =
+        norm_utils::getTrainingForwardOutputDimAndStride(xDim);
+    std::shared_ptr<TensorAttr> mT = layernormBwdAttr.getMEAN();
+    norm_utils::inferDimAndStride(mT, statDim, statStride);
+    std::shared_ptr<TensorAttr> vT = layernormBwdAttr.getINV_VARIANCE();
+    norm_utils::inferDimAndStride(vT, statDim, statStride);
+
+    // Infer shape and stride of output DX tensor (same as X).
+    std::shared_ptr<TensorAttr> dxT = layernormBwdAttr.getDX();
+    norm_utils::inferDimAndStride(dxT, xDim, xT->getCompactStride());
+
+    // SCALE, DSCALE and DBIAS all have the shape of X with single batch.
+    for (std::shared_ptr<TensorAttr> t :
+         {layernormBwdAttr.getSCALE(), layernormBwdAttr.getDSCALE(),
+          layernormBwdAttr.getDBIAS()})
+      if (t)
+        norm_utils::inferScaleBiasDimAndStride(t, xDim, xStride);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating LayerNormBwdNode '"
+                           << layernormBwdAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = layernormBwdAttr.getX();
+    std::shared_ptr<TensorAttr> dxT = layernormBwdAttr.getDX();
+    const std::vector<int64_t> &xDim = xT->getDim();
+
+    // Shape and layout checks for output DX tensor.
+    FUSILLI_RETURN_ERROR_IF(xDim != dxT->getDim(), ErrorCode::InvalidAttribute,
+                            "LayerNorm backward output DX tensor must have "
+                            "the same shape as input X tensor");
+    FUSILLI_RETURN_ERROR_IF(!dxT->isContiguous() && !dxT->isChannelsLast(),
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + dxT->getName() +
+                                "' is neither contiguous nor channels-last as "
+                                "defined by its stride");
+
+    // Shape checks for the saved statistics.
+    std::vector<int64_t> statDim =
+        norm_utils::getTrainingForwardOutputDimAndStride(xDim).first;
+    for (const auto &t :
+         {layernormBwdAttr.getMEAN(), layernormBwdAttr.getINV_VARIANCE()})
+      FUSILLI_RETURN_ERROR_IF(
+          t->getDim() != statDim, ErrorCode::InvalidAttribute,
+          "LayerNorm backward input tensors MEAN and INV_VARIANCE must have "
+          "shape [B, 1, ..., 1] with rank equal to input X tensor's rank, and "
+          "batch dimension equal to input X tensor's batch dimension");
+
+    // Shape and layout checks for output DSCALE and DBIAS tensors.
+    for (const auto &t :
+         {layernormBwdAttr.getDSCALE(), layernormBwdAttr.getDBIAS()}) {
+      if (!t)
+        continue;
+      FUSILLI_RETURN_ERROR_IF(
+          t->getDim() != norm_utils::getScaleBiasDim(xDim),
+          ErrorCode::InvalidAttribute,
+          "LayerNorm backward output tensors DSCALE and DBIAS must have shape "
+          "as tensor X with single batch");
+      FUSILLI_RETURN_ERROR_IF(!t->isContiguous() && !t->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + t->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+    }
+
+    return ok();
+  }
 };
 
 } // namespace fusilli
@@ -15,6 +15,7 @@
 #define FUSILLI_NODE_MATMUL_NODE_H
 
 #include "fusilli/attributes/matmul_attributes.h"
+#include "fusilli/attributes/pointwise_attributes.h"
 #include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/graph/context.h"
 #include "fusilli/node/node.h"
@@ -25,6 +26,8 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -65,6 +68,21 @@ getMatmulInferredOutputShape(const std::vector<int64_t> &aDim,
   return cDim;
 }
 
+// Activations that can be fused into the matmul epilogue.
+inline bool isMatmulEpilogueActivation(PointwiseAttr::Mode mode) {
+  switch (mode) {
+  case PointwiseAttr::Mode::GELU_APPROX_TANH_FWD:
+  case PointwiseAttr::Mode::GELU_FWD:
+  case PointwiseAttr::Mode::RELU_FWD:
+  case PointwiseAttr::Mode::SIGMOID_FWD:
+  case PointwiseAttr::Mode::SWISH_FWD:
+  case PointwiseAttr::Mode::TANH_FWD:
+    return true;
+  default:
+    return false;
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // Matrix multiplication node.
 //===----------------------------------------------------------------------===//
@@ -82,12 +100,67 @@ public:
   std::string getOperandTypesAsm() const;
   std::string getResultNamesAsm() const;
   std::string getResultTypesAsm() const;
+  std::string getEpilogueOpsAsm(const std::string &product,
+                                const std::string &result) const;
+  std::string getGroupMaskOpsAsm(const std::string &unmasked) const;
+  std::string getSparseExpandOpsAsm() const;
+  std::string getGroupDequantizeOpsAsm() const;
+  std::string getBiasGradientOpsAsm() const;
+  std::string getActivationOpsAsm(PointwiseAttr::Mode activation,
+                                  std::string_view step,
+                                  const std::string &operand,
+                                  const std::string &result,
+                                  const std::string &type) const;
+  std::string getGatedProductTypeAsm() const;
+  std::string getGateOpsAsm(const std::string &product,
+                            const std::string &result) const;
+  std::string getSplitKOpsAsm(const std::string &product,
+                              const std::string &type) const;
+  std::string getTuningSpecMatcherAsm() const;
 
   const std::string &getName() const override final {
     return matmulAttr.getName();
   }
   Type getType() const override final { return Type::Matmul; }
 
+  // Two operations per element of C and of the contracted dim K; epilogues
+  // are negligible next to the product.
+  double estimateFlops() const override final {
+    return 2.0 * static_cast<double>(matmulAttr.getC()->getVolume()) *
+           static_cast<double>(matmulAttr.getA()->getDim().back());
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    matmulAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    matmulAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    matmulAttr.replaceOutput(from, to);
+  }
+
+  void archiveNode(Archive &ar) override final { matmulAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    matmulAttr.hashTensors(fp);
+    fp.update(matmulAttr.getActivation())
+        .update(matmulAttr.getAlpha())
+        .update(matmulAttr.getBeta())
+        .update(matmulAttr.getGate())
+        .update(matmulAttr.getGroupSize())
+        .update(matmulAttr.getSplitK())
+        .update(matmulAttr.getWorkgroupTile())
+        .update(matmulAttr.getReductionTile())
+        .update(matmulAttr.getWorkgroupSize())
+        .update(matmulAttr.getSubgroupSize())
+        .update(matmulAttr.getMmaIntrinsic());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating MatmulNode '"
                            << matmulAttr.getName() << "'");
@@ -125,8 +198,8 @@ public:
     // Check that inner dimensions match (K dimension).
     const std::vector<int64_t> &aDim = aT->getDim();
     const std::vector<int64_t> &bDim = bT->getDim();
-    int64_t aK = aDim[aRank - 1]; // Last dimension of A
-    int64_t bK = bDim[bRank - 2]; // Second-to-last dimension of B
+    int64_t aK = aDim[aRank - 1];           // Last dimension of A
+    int64_t bK = getDenseBDim()[bRank - 2]; // Second-to-last dimension of B
 
     FUSILLI_RETURN_ERROR_IF(
         aK != bK, ErrorCode::InvalidAttribute,
@@ -152,6 +225,74 @@ public:
     FUSILLI_CHECK_ERROR(checkBatchDims(aT, "A"));
     FUSILLI_CHECK_ERROR(checkBatchDims(bT, "B"));
 
+    // Epilogue checks.
+    PointwiseAttr::Mode activation = matmulAttr.getActivation();
+    FUSILLI_RETURN_ERROR_IF(
+        activation != PointwiseAttr::Mode::NOT_SET &&
+            !isMatmulEpilogueActivation(activation),
+        ErrorCode::NotImplemented,
+        "Matmul epilogue activation " +
+            PointwiseAttr::kModeToStr.at(activation) + " is not supported");
+    FUSILLI_RETURN_ERROR_IF(
+        matmulAttr.getBeta() != 1.0f && !matmulAttr.getRESIDUAL(),
+        ErrorCode::AttributeNotSet,
+        "Matmul epilogue beta is set but residual tensor RESIDUAL is not");
+    for (const auto &[t, name] :
+         {std::pair{matmulAttr.getBIAS(), "BIAS"},
+          std::pair{matmulAttr.getRESIDUAL(), "RESIDUAL"}}) {
+      FUSILLI_RETURN_ERROR_IF(
+          t && t->getDim().size() != aRank, ErrorCode::InvalidAttribute,
+          std::string("Matmul epilogue tensor ") + name +
+              " must have the same rank as input tensors A and B");
+    }
+
+    // Gate checks.
+    if (matmulAttr.isGated()) {
+      PointwiseAttr::Mode gate = matmulAttr.getGate();
+      FUSILLI_RETURN_ERROR_IF(!isMatmulEpilogueActivation(gate),
+                              ErrorCode::NotImplemented,
+                              "Matmul gate activation " +
+                                  PointwiseAttr::kModeToStr.at(gate) +
+                                  " is not supported");
+      FUSILLI_RETURN_ERROR_IF(
+          matmulAttr.hasEpilogue() || matmulAttr.hasScales() ||
+              matmulAttr.isGrouped() || matmulAttr.hasBiasGradient(),
+          ErrorCode::NotImplemented,
+          "Gated matmul is not supported with an epilogue, scales, groups or "
+          "a bias gradient");
+      FUSILLI_RETURN_ERROR_IF(
+          bDim[bRank - 1] % 2 != 0, ErrorCode::InvalidAttribute,
+          "Gated matmul input tensor B must pack the gate and up projections "
+          "[..., K, 2N]: B has last dim=" +
+              std::to_string(bDim[bRank - 1]));
+    }
+
+    // Sparsity checks.
+    if (std::shared_ptr<TensorAttr> metaT = matmulAttr.getB_META()) {
+      FUSILLI_RETURN_ERROR_IF(
+          metaT->getDim() != bDim, ErrorCode::InvalidAttribute,
+          "Sparse matmul tensor B_META dimensions must match input tensor B");
+      for (size_t i = 0; i < bRank; ++i)
+        FUSILLI_RETURN_ERROR_IF(
+            bT->isDynamicDim(i), ErrorCode::NotImplemented,
+            "Sparse matmul input tensor B with dynamic dims is not supported");
+      FUSILLI_RETURN_ERROR_IF(
+          bDim[bRank - 2] % 2 != 0, ErrorCode::InvalidAttribute,
+          "Sparse matmul input tensor B must hold two values per group of "
+          "four rows [..., K/2, N]: B has K/2=" +
+              std::to_string(bDim[bRank - 2]));
+    }
+
+    FUSILLI_CHECK_ERROR(checkGroupQuantization());
+
+    FUSILLI_RETURN_ERROR_IF(
+        matmulAttr.hasBiasGradient() &&
+            (matmulAttr.hasScales() || matmulAttr.isGrouped()),
+        ErrorCode::NotImplemented,
+        "Matmul bias gradient DBIAS is not supported with scales or groups");
+
+    FUSILLI_CHECK_ERROR(checkLoweringHints());
+
     // Check for mixed precision matmuls (inputs with differing element types).
     // Due to torch-mlir MLIR constraints, when element types differ:
     // - Both LHS and RHS must have rank 3 (single batch dim)
@@ -160,8 +301,10 @@ public:
     // PyTorch does not allow differing input element types for any of the
     // matmul variants. However, torch-mlir breaks conformity with pytorch in
     // the case of `torch.bmm`. So, we need to be sure that `torch.matmul` will
-    // lower to `torch.bmm` in the cases of mixed precision.
-    if (aT->getDataType() != bT->getDataType()) {
+    // lower to `torch.bmm` in the cases of mixed precision. Group-wise
+    // quantized weights are dequantized to the data type of A beforehand.
+    if (aT->getDataType() != bT->getDataType() &&
+        !matmulAttr.isGroupQuantized()) {
       constexpr int64_t kMixedPrecisionRequiredRank = 3;
       FUSILLI_RETURN_ERROR_IF(
           aRank != kMixedPrecisionRequiredRank, ErrorCode::InvalidAttribute,
@@ -183,21 +326,33 @@ public:
     FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for MatmulNode '"
                            << matmulAttr.getName() << "'");
 
+    // Scales are f32 unless set otherwise.
+    for (const std::shared_ptr<TensorAttr> &scaleT :
+         {matmulAttr.getSCALE_A(), matmulAttr.getSCALE_B()})
+      if (scaleT && scaleT->getDataType() == DataType::NotSet)
+        scaleT->setDataType(DataType::Float);
+    // Group sizes are int32 unless set otherwise.
+    if (std::shared_ptr<TensorAttr> groupSizesT = matmulAttr.getGROUP_SIZES();
+        groupSizesT && groupSizesT->getDataType() == DataType::NotSet)
+      groupSizesT->setDataType(DataType::Int32);
+    // Sparsity metadata is int8 unless set otherwise.
+    if (std::shared_ptr<TensorAttr> metaT = matmulAttr.getB_META();
+        metaT && metaT->getDataType() == DataType::NotSet)
+      metaT->setDataType(DataType::Int8);
+
     matmulAttr.fillFromContext(context);
 
     std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
-    std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
     std::shared_ptr<TensorAttr> cT = matmulAttr.getC();
 
     const std::vector<int64_t> &aDim = aT->getDim();
-    const std::vector<int64_t> &bDim = bT->getDim();
 
     const std::vector<int64_t> &cDim = cT->getDim();
     const std::vector<int64_t> &cStride = cT->getStride();
 
     // Infer shape of output tensor.
     if (cDim.empty())
-      cT->setDim(getMatmulInferredOutputShape(aDim, bDim));
+      cT->setDim(getOutputShape());
 
     // Output stride is contiguous (row-major) when unspecified.
     if (cStride.empty()) {
@@ -205,6 +360,16 @@ public:
           generateStrideFromDim(cDim, getContiguousStrideOrder(cDim.size())));
     }
 
+    // The bias gradient is A reduced over its contraction (last) dim.
+    if (std::shared_ptr<TensorAttr> dbT = matmulAttr.getDBIAS()) {
+      if (dbT->getDim().empty())
+        dbT->setDim(std::vector<int64_t>(aDim.begin(), aDim.end() - 1));
+      const std::vector<int64_t> &dbDim = dbT->getDim();
+      if (dbT->getStride().empty())
+        dbT->setStride(generateStrideFromDim(
+            dbDim, getContiguousStrideOrder(dbDim.size())));
+    }
+
     return ok();
   }
 
@@ -225,15 +390,158 @@ public:
         "Matmul output tensor C must have a rank of at least 2");
 
     FUSILLI_RETURN_ERROR_IF(
-        cT->getDim() !=
-            getMatmulInferredOutputShape(aT->getDim(), bT->getDim()),
-        ErrorCode::InvalidAttribute,
+        cT->getDim() != getOutputShape(), ErrorCode::InvalidAttribute,
         "Matmul output tensor C dimensions do not match the expected shapes "
         "inferred based on the input dimensions");
     FUSILLI_CHECK_ERROR(checkBatchDims(cT, "C"));
+
+    // The epilogue is computed in the element type of C.
+    const std::vector<int64_t> &cDim = cT->getDim();
+    if (std::shared_ptr<TensorAttr> biasT = matmulAttr.getBIAS()) {
+      const std::vector<int64_t> &biasDim = biasT->getDim();
+      for (size_t i = 0; i < cRank; ++i) {
+        FUSILLI_RETURN_ERROR_IF(
+            biasDim[i] != cDim[i] && biasDim[i] != 1,
+            ErrorCode::InvalidAttribute,
+            "Matmul epilogue tensor BIAS is not broadcastable to output "
+            "tensor C at index " +
+                std::to_string(i) + ": BIAS has dim=" +
+                std::to_string(biasDim[i]) +
+                ", C has dim=" + std::to_string(cDim[i]));
+      }
+      FUSILLI_RETURN_ERROR_IF(
+          biasT->getDataType() != cT->getDataType(),
+          ErrorCode::InvalidAttribute,
+          "Matmul epilogue tensor BIAS must have the data type of output "
+          "tensor C");
+    }
+    if (std::shared_ptr<TensorAttr> residualT = matmulAttr.getRESIDUAL()) {
+      FUSILLI_RETURN_ERROR_IF(
+          residualT->getDim() != cDim, ErrorCode::InvalidAttribute,
+          "Matmul epilogue tensor RESIDUAL dimensions do not match output "
+          "tensor C dimensions");
+      FUSILLI_RETURN_ERROR_IF(
+          residualT->getDataType() != cT->getDataType(),
+          ErrorCode::InvalidAttribute,
+          "Matmul epilogue tensor RESIDUAL must have the data type of output "
+          "tensor C");
+    }
+
+    if (matmulAttr.hasScales()) {
+      DataType aType = aT->getDataType();
+      FUSILLI_RETURN_ERROR_IF(
+          aType != bT->getDataType() ||
+              getQuantizedAccumulatorType(aType) == DataType::NotSet,
+          ErrorCode::InvalidAttribute,
+          "Matmul scales require input tensors A and B of the same FP8 or "
+          "Int8 data type");
+      // SCALE_A may only vary along M (and batch), SCALE_B along N (and
+      // batch), for them to factor out of the product.
+      for (const auto &[t, name, reducedIdx, shape] :
+           {std::tuple{matmulAttr.getSCALE_A(), "SCALE_A", cRank - 1,
+                       "per row of A [..., M, 1]"},
+            std::tuple{matmulAttr.getSCALE_B(), "SCALE_B", cRank - 2,
+                       "per column of B [..., 1, N]"}}) {
+        if (!t)
+          continue;
+        const std::vector<int64_t> &scaleDim = t->getDim();
+        bool isBroadcastable = scaleDim.size() == cRank;
+        for (size_t i = 0; isBroadcastable && i < cRank; ++i)
+          isBroadcastable = scaleDim[i] == 1 ||
+                            (i != reducedIdx && scaleDim[i] == cDim[i]);
+        FUSILLI_RETURN_ERROR_IF(!isBroadcastable, ErrorCode::InvalidAttribute,
+                                std::string("Matmul scale tensor ") + name +
+                                    " must be per tensor or " + shape);
+        FUSILLI_RETURN_ERROR_IF(t->getDataType() != DataType::Float,
+                                ErrorCode::InvalidAttribute,
+                                std::string("Matmul scale tensor ") + name +
+                                    " must have data type Float");
+      }
+    }
+    if (std::shared_ptr<TensorAttr> groupSizesT =
+            matmulAttr.getGROUP_SIZES()) {
+      constexpr size_t kGroupedRank = 3;
+      FUSILLI_RETURN_ERROR_IF(
+          cRank != kGroupedRank || aT->getDim()[0] != bT->getDim()[0],
+          ErrorCode::InvalidAttribute,
+          "Grouped matmul requires input tensors A [E, M, K] and B [E, K, N] "
+          "with the same group count E");
+      FUSILLI_RETURN_ERROR_IF(
+          groupSizesT->getDim() != std::vector<int64_t>{cDim[0]},
+          ErrorCode::InvalidAttribute,
+          "Grouped matmul tensor GROUP_SIZES must have dims [E]");
+      DataType sizesType = groupSizesT->getDataType();
+      FUSILLI_RETURN_ERROR_IF(
+          sizesType != DataType::Int32 && sizesType != DataType::Int64,
+          ErrorCode::InvalidAttribute,
+          "Grouped matmul tensor GROUP_SIZES must have data type Int32 or "
+          "Int64");
+    }
+    if (std::shared_ptr<TensorAttr> metaT = matmulAttr.getB_META())
+      FUSILLI_RETURN_ERROR_IF(
+          metaT->getDataType() != DataType::Int8, ErrorCode::InvalidAttribute,
+          "Sparse matmul tensor B_META must have data type Int8");
+    if (matmulAttr.isGroupQuantized()) {
+      DataType aType = aT->getDataType();
+      DataType bType = bT->getDataType();
+      FUSILLI_RETURN_ERROR_IF(
+          aType != DataType::Half && aType != DataType::BFloat16 &&
+              aType != DataType::Float,
+          ErrorCode::InvalidAttribute,
+          "Group-quantized matmul input tensor A must have data type Half, "
+          "BFloat16 or Float");
+      FUSILLI_RETURN_ERROR_IF(
+          bType != DataType::Int4 && bType != DataType::Int8 &&
+              bType != DataType::Uint8,
+          ErrorCode::InvalidAttribute,
+          "Group-quantized matmul input tensor B must have data type Int4, "
+          "Int8 or Uint8");
+      FUSILLI_RETURN_ERROR_IF(
+          matmulAttr.getB_SCALE()->getDataType() != aType,
+          ErrorCode::InvalidAttribute,
+          "Group-quantized matmul tensor B_SCALE must have the data type of "
+          "input tensor A");
+      if (std::shared_ptr<TensorAttr> zeroT = matmulAttr.getB_ZERO())
+        FUSILLI_RETURN_ERROR_IF(
+            zeroT->getDataType() != aType && zeroT->getDataType() != bType,
+            ErrorCode::InvalidAttribute,
+            "Group-quantized matmul tensor B_ZERO must have the data type of "
+            "input tensor A or B");
+    }
+    if (std::shared_ptr<TensorAttr> dbT = matmulAttr.getDBIAS()) {
+      const std::vector<int64_t> &aDim = aT->getDim();
+      FUSILLI_RETURN_ERROR_IF(
+          dbT->getDim() != std::vector<int64_t>(aDim.begin(), aDim.end() - 1),
+          ErrorCode::InvalidAttribute,
+          "Matmul bias gradient tensor DBIAS dimensions must be those of "
+          "input tensor A without the contraction dim [..., M]");
+      FUSILLI_RETURN_ERROR_IF(!dbT->isContiguous(), ErrorCode::NotImplemented,
+                              "Tensor '" + dbT->getName() +
+                                  "' is not contiguous as defined by its "
+                                  "stride");
+    }
     return ok();
   }
 
+  // Dims of the dense B operand of the product: those of B, where the
+  // contraction dim of sparse weights is twice that of the packed values.
+  std::vector<int64_t> getDenseBDim() const {
+    std::vector<int64_t> bDim = matmulAttr.getB()->getDim();
+    if (matmulAttr.isSparse())
+      bDim[bDim.size() - 2] *= 2;
+    return bDim;
+  }
+
+  // Output shape of the node: the shape of the product, where the gate and up
+  // halves of a gated matmul are multiplied into one.
+  std::vector<int64_t> getOutputShape() const {
+    std::vector<int64_t> cDim = getMatmulInferredOutputShape(
+        matmulAttr.getA()->getDim(), getDenseBDim());
+    if (matmulAttr.isGated())
+      cDim.back() /= 2;
+    return cDim;
+  }
+
 private:
   // Check that batch dimensions are outermost and non-transposed.
   // This is equivalent to checking that perm[i] == i for all batch dims.
@@ -250,6 +558,113 @@ private:
     }
     return ok();
   };
+
+  // Checks the group-wise quantization of B against the matmul: the group
+  // size divides K, and B_SCALE and B_ZERO hold one value per group and
+  // column of B.
+  ErrorObject checkGroupQuantization() const {
+    FUSILLI_RETURN_ERROR_IF(
+        matmulAttr.getB_ZERO() && !matmulAttr.isGroupQuantized(),
+        ErrorCode::AttributeNotSet,
+        "Matmul tensor B_ZERO is set but tensor B_SCALE is not");
+    FUSILLI_RETURN_ERROR_IF(
+        matmulAttr.getGroupSize() != 0 && !matmulAttr.isGroupQuantized(),
+        ErrorCode::AttributeNotSet,
+        "Matmul group size is set but tensor B_SCALE is not");
+    if (!matmulAttr.isGroupQuantized())
+      return ok();
+
+    std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+    const std::vector<int64_t> &bDim = bT->getDim();
+    size_t rank = bDim.size();
+    FUSILLI_RETURN_ERROR_IF(
+        matmulAttr.hasScales() || matmulAttr.isSparse(),
+        ErrorCode::NotImplemented,
+        "Group-quantized matmul is not supported with scales or sparse "
+        "weights");
+    for (size_t i = 0; i < rank; ++i)
+      FUSILLI_RETURN_ERROR_IF(
+          bT->isDynamicDim(i), ErrorCode::NotImplemented,
+          "Group-quantized matmul input tensor B with dynamic dims is not "
+          "supported");
+    int64_t groupSize = matmulAttr.getGroupSize();
+    int64_t k = bDim[rank - 2];
+    FUSILLI_RETURN_ERROR_IF(
+        groupSize <= 0 || k % groupSize != 0, ErrorCode::InvalidAttribute,
+        "Group-quantized matmul group size " + std::to_string(groupSize) +
+            " does not divide the contraction dim K=" + std::to_string(k));
+    std::vector<int64_t> groupDim = bDim;
+    groupDim[rank - 2] = k / groupSize;
+    for (const auto &[t, name] :
+         {std::pair{matmulAttr.getB_SCALE(), "B_SCALE"},
+          std::pair{matmulAttr.getB_ZERO(), "B_ZERO"}}) {
+      FUSILLI_RETURN_ERROR_IF(
+          t && t->getDim() != groupDim, ErrorCode::InvalidAttribute,
+          std::string("Group-quantized matmul tensor ") + name +
+              " must hold one value per group of B [..., K/G, N]");
+    }
+    return ok();
+  }
+
+  // Checks the split-K and lowering config hints against the matmul.
+  ErrorObject checkLoweringHints() const {
+    std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
+    std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+    size_t rank = aT->getDim().size();
+
+    FUSILLI_RETURN_ERROR_IF(matmulAttr.getSplitK() < 1,
+                            ErrorCode::InvalidAttribute,
+                            "Matmul split-K must be at least 1");
+    if (matmulAttr.isSplitK()) {
+      FUSILLI_RETURN_ERROR_IF(
+          matmulAttr.hasScales() || matmulAttr.isGrouped() ||
+              matmulAttr.isSparse() || matmulAttr.isGroupQuantized() ||
+              matmulAttr.isGated() || matmulAttr.hasBiasGradient() ||
+              matmulAttr.hasLoweringConfig(),
+          ErrorCode::NotImplemented,
+          "Matmul split-K is not supported with scales, groups, sparse, "
+          "group-quantized or gated weights, a bias gradient or tile sizes");
+      FUSILLI_RETURN_ERROR_IF(
+          aT->getDataType() != bT->getDataType(), ErrorCode::NotImplemented,
+          "Matmul split-K is not supported for mixed precision inputs");
+      for (size_t i = 0; i < rank; ++i)
+        FUSILLI_RETURN_ERROR_IF(
+            aT->isDynamicDim(i) || bT->isDynamicDim(i),
+            ErrorCode::NotImplemented,
+            "Matmul split-K is not supported with dynamic dims");
+      int64_t k = aT->getDim()[rank - 1];
+      FUSILLI_RETURN_ERROR_IF(
+          k % matmulAttr.getSplitK() != 0, ErrorCode::InvalidAttribute,
+          "Matmul split-K " + std::to_string(matmulAttr.getSplitK()) +
+              " does not divide the contraction dim K=" + std::to_string(k));
+    }
+
+    FUSILLI_RETURN_ERROR_IF(
+        !matmulAttr.getMmaIntrinsic().empty() &&
+            !matmulAttr.hasLoweringConfig(),
+        ErrorCode::AttributeNotSet,
+        "Matmul MMA intrinsic is set but tile sizes are not");
+    if (matmulAttr.hasLoweringConfig()) {
+      // The iteration space is [..., M, N, K].
+      size_t loops = rank + 1;
+      const std::vector<int64_t> &workgroupSize = matmulAttr.getWorkgroupSize();
+      FUSILLI_RETURN_ERROR_IF(
+          matmulAttr.getWorkgroupTile().size() != loops ||
+              matmulAttr.getReductionTile().size() != loops,
+          ErrorCode::InvalidAttribute,
+          "Matmul tile sizes must cover the " + std::to_string(loops) +
+              " loops [..., M, N, K] of the matmul");
+      FUSILLI_RETURN_ERROR_IF(
+          workgroupSize.empty() || workgroupSize.size() > 3 ||
+              std::ranges::any_of(workgroupSize,
+                                  [](int64_t v) { return v <= 0; }) ||
+              matmulAttr.getSubgroupSize() <= 0,
+          ErrorCode::InvalidAttribute,
+          "Matmul workgroup size must have 1 to 3 positive dims and the "
+          "subgroup size must be positive");
+    }
+    return ok();
+  }
 };
 
 } // namespace fusilli
@@ -14,14 +14,20 @@
 #ifndef FUSILLI_NODE_NODE_H
 #define FUSILLI_NODE_NODE_H
 
+#include "fusilli/attributes/tensor_attributes.h"
 #include "fusilli/graph/context.h"
+#include "fusilli/support/archive.h"
+#include "fusilli/support/fingerprint.h"
 #include "fusilli/support/logging.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace fusilli {
@@ -41,6 +47,22 @@ public:
     Reduction,
     Custom,
     Sdpa,
+    SdpaBwd,
+    Softmax,
+    Pooling,
+    Reshape,
+    Permute,
+    Slice,
+    Concat,
+    LayerNormBwd,
+    RmsNormBwd,
+    BatchNormBwd,
+    SliceUpdate,
+    IndexSelect,
+    IndexAdd,
+    Collective,
+    ConvTranspose,
+    Optimizer,
   };
 
   explicit INode(const Context &ctx) : context(ctx) {}
@@ -51,6 +73,68 @@ public:
 
   Context context;
 
+  // Appends the input and output tensors of the node to `ins` and `outs`.
+  // Graph-level passes use this to find how tensors connect nodes.
+  virtual void
+  collectTensors(std::vector<std::shared_ptr<TensorAttr>> &ins,
+                 std::vector<std::shared_ptr<TensorAttr>> &outs) const {}
+
+  // Returns true if the node converts all its tensors to and from logical dim
+  // order itself (via `getLayoutConversionOpsAsm()`) and computes in logical
+  // order in between. Virtual tensors connecting such nodes may then skip the
+  // conversions altogether, see `Graph::optimizeLayouts()`.
+  virtual bool isLayoutAgnostic() const { return false; }
+
+  // Rewires every input of the node that is `from` to `to`, a tensor with the
+  // same properties. Used by graph-level passes that merge tensors.
+  virtual void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                            const std::shared_ptr<TensorAttr> &to) {}
+
+  // Rewires every output of the node that is `from` to `to`.
+  virtual void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                             const std::shared_ptr<TensorAttr> &to) {}
+
+  // Returns a copy of the node sharing its tensors, or nullptr for nodes that
+  // can't be copied. Together with `replaceInput()` and `replaceOutput()` this
+  // lets a variant of the graph be emitted without touching the nodes or
+  // tensors of the original, see `Graph::emitSpecializedAsm()`.
+  virtual std::shared_ptr<INode> cloneNode() const { return nullptr; }
+
+  // Folds the node when it can be evaluated on the host: its outputs become
+  // scalar constants and the node can be dropped. Returns true when folded,
+  // see `Graph::foldConstants()`.
+  virtual bool foldConstants() { return false; }
+
+  // Returns the number of operations the node computes, for
+  // `Graph::estimateCost()`. Defaults to one per element of its outputs,
+  // which suits elementwise nodes; nodes doing more (or no) work per output
+  // element override it.
+  virtual double estimateFlops() const {
+    std::vector<std::shared_ptr<TensorAttr>> ins, outs;
+    collectTensors(ins, outs);
+    double flops = 0;
+    for (const auto &out : outs)
+      flops += static_cast<double>(out->getVolume());
+    return flops;
+  }
+
+  // Recursively fingerprint the node and its sub nodes.
+  void hashSubtree(Fingerprinter &fp) const {
+    fp.update(getType());
+    hashNode(fp);
+    fp.update(subNodes_.size());
+    for (const auto &subNode : subNodes_)
+      subNode->hashSubtree(fp);
+  }
+
+  // Reads or writes the node specific attributes (including its input and
+  // output tensors) from or to `ar`, see `Graph::serialize()`. Sub nodes are
+  // archived by the graph.
+  virtual void archiveNode(Archive &ar) {
+    ar.fail(ErrorCode::NotImplemented,
+            "Serialization not implemented for node '" + getName() + "'");
+  }
+
 protected:
   Type tag_;
 
@@ -80,6 +164,15 @@ protected:
       subNode->collectModuleScopeAsm(oss);
   }
 
+  // Overload of the above collecting one entry per declaring node, so that
+  // declarations repeated across graphs can be deduplicated.
+  void collectModuleScopeAsm(std::vector<std::string> &decls) const {
+    if (std::string decl = emitModuleScopeAsm(); !decl.empty())
+      decls.push_back(std::move(decl));
+    for (const auto &subNode : subNodes_)
+      subNode->collectModuleScopeAsm(decls);
+  }
+
   // Recursively validate the node and its sub nodes.
   ErrorObject validateSubtree() {
     FUSILLI_CHECK_ERROR(preValidateNode());
@@ -92,25 +185,45 @@ protected:
 
   // Recursively emit MLIR assembly for the node and its sub nodes
   // allowing for composite ops to expand into their own regions
-  // containing sub ops.
-  void emitAsmSubtree(std::ostringstream &oss) {
-    oss << emitNodePreAsm();
+  // containing sub ops. Everything is appended to the single `out` buffer,
+  // which callers should reserve up front (see `Graph::emitAsm()`).
+  void emitAsmSubtree(std::string &out) const {
+    out += emitNodePreAsm();
+    emitSubNodesAsm(out);
+    out += emitNodePostAsm();
+  }
+
+  // Emit MLIR assembly for the sub nodes only, in order.
+  void emitSubNodesAsm(std::string &out) const {
+    for (const auto &subNode : subNodes_)
+      subNode->emitAsmSubtree(out);
+  }
+
+  // Returns the number of nodes in the subtree, including this node.
+  size_t getSubtreeNodeCount() const {
+    size_t count = 1;
     for (const auto &subNode : subNodes_)
-      subNode->emitAsmSubtree(oss);
-    oss << emitNodePostAsm();
+      count += subNode->getSubtreeNodeCount();
+    return count;
   }
 
+  // Mixes the node specific attributes (including its input and output
+  // tensors) into `fp`. Every property that affects the compiled artifact must
+  // be included, otherwise structurally different graphs may share a cached
+  // artifact. Names should be left out (see `Fingerprinter`).
+  virtual void hashNode(Fingerprinter &fp) const {}
+
   // Recursively check that names of nodes and their sub nodes
   // are unique to avoid re-definition of SSA values during
-  // MLIR ASM generation.
-  ErrorObject
-  checkNodeNamesAreUnique(std::unordered_set<std::string> &usedSymbols) const {
+  // MLIR ASM generation. `usedSymbols` views the names in place, which
+  // outlive the check.
+  ErrorObject checkNodeNamesAreUnique(
+      std::unordered_set<std::string_view> &usedSymbols) const {
     for (const auto &subNode : subNodes_) {
-      FUSILLI_RETURN_ERROR_IF(usedSymbols.contains(subNode->getName()), // C++20
+      FUSILLI_RETURN_ERROR_IF(!usedSymbols.insert(subNode->getName()).second,
                               ErrorCode::InvalidAttribute,
                               "Symbol name '" + subNode->getName() +
                                   "' already in use");
-      usedSymbols.insert(subNode->getName());
       FUSILLI_CHECK_ERROR(subNode->checkNodeNamesAreUnique(usedSymbols));
     }
     return ok();
@@ -120,6 +233,11 @@ protected:
 // It uses the CRTP pattern (aka F-bound polymorphism):
 // https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern
 template <typename DerivedT> class NodeCRTP : public INode {
+public:
+  std::shared_ptr<INode> cloneNode() const override {
+    return std::make_shared<DerivedT>(self());
+  }
+
 protected:
   // Allow derived NodeCRTP classes to use the INode constructor
   using INode::INode;
@@ -0,0 +1,304 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the optimizer update node
+// `OptimizerNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_OPTIMIZER_NODE_H
+#define FUSILLI_NODE_OPTIMIZER_NODE_H
+
+#include "fusilli/attributes/optimizer_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/attributes/types.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+//===----------------------------------------------------------------------===//
+// Optimizer node.
+//
+// SGD (with optional momentum), Adam or AdamW update of a list of parameter
+// tensors, given their gradients and moments (see `OptimizerAttr::Mode`).
+// Each parameter is updated by a single elementwise expression, so each
+// fuses into one dispatch that reads P, G, M and V once and writes the new
+// P, M and V, rather than one pass per term of the update. The new tensors
+// are usually declared in-place on the old ones (see
+// `Graph::optimizerUpdate()`) so that the update needs no memory of its own,
+// and all parameters of a model are updated by one graph execution.
+//===----------------------------------------------------------------------===//
+
+class OptimizerNode : public NodeCRTP<OptimizerNode> {
+public:
+  OptimizerAttr optimizerAttr;
+
+  OptimizerNode(OptimizerAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), optimizerAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return optimizerAttr.getName();
+  }
+  Type getType() const override final { return Type::Optimizer; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    optimizerAttr.collectTensors(ins, outs);
+    for (const auto *list :
+         {&optimizerAttr.getParams(), &optimizerAttr.getGrads(),
+          &optimizerAttr.getMoments1(), &optimizerAttr.getMoments2()})
+      ins.insert(ins.end(), list->begin(), list->end());
+    for (const auto *list :
+         {&optimizerAttr.getNewParams(), &optimizerAttr.getNewMoments1(),
+          &optimizerAttr.getNewMoments2()})
+      outs.insert(outs.end(), list->begin(), list->end());
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    optimizerAttr.replaceInput(from, to);
+    auto replace = [&](OptimizerAttr::TensorList list) {
+      std::replace(list.begin(), list.end(), from, to);
+      return list;
+    };
+    optimizerAttr.setParams(replace(optimizerAttr.getParams()))
+        .setGrads(replace(optimizerAttr.getGrads()))
+        .setMoments1(replace(optimizerAttr.getMoments1()))
+        .setMoments2(replace(optimizerAttr.getMoments2()));
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    optimizerAttr.replaceOutput(from, to);
+    auto replace = [&](OptimizerAttr::TensorList list) {
+      std::replace(list.begin(), list.end(), from, to);
+      return list;
+    };
+    optimizerAttr.setNewParams(replace(optimizerAttr.getNewParams()))
+        .setNewMoments1(replace(optimizerAttr.getNewMoments1()))
+        .setNewMoments2(replace(optimizerAttr.getNewMoments2()));
+  }
+
+  // The emitter converts every tensor to logical dim order (see
+  // `emitNodePreAsm()`), and the update is elementwise.
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { optimizerAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    optimizerAttr.hashTensors(fp);
+    fp.update(optimizerAttr.getMode()).update(optimizerAttr.getNesterov());
+    for (const auto *list :
+         {&optimizerAttr.getParams(), &optimizerAttr.getGrads(),
+          &optimizerAttr.getMoments1(), &optimizerAttr.getMoments2(),
+          &optimizerAttr.getNewParams(), &optimizerAttr.getNewMoments1(),
+          &optimizerAttr.getNewMoments2()}) {
+      fp.update(list->size());
+      for (const auto &t : *list)
+        fp.tensor(t);
+    }
+  }
+
+  // About 4 operations per parameter element for SGD (decay, momentum and
+  // step) and 12 for Adam (two moment updates, the square root, the
+  // normalization and the step).
+  double estimateFlops() const override final {
+    double perElement = optimizerAttr.hasMoments2() ? 12 : 4;
+    double flops = 0;
+    for (const auto &p : optimizerAttr.getParams())
+      flops += perElement * static_cast<double>(p->getVolume());
+    return flops;
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating OptimizerNode '"
+                           << optimizerAttr.getName() << "'");
+
+    OptimizerAttr::Mode mode = optimizerAttr.getMode();
+    const auto &params = optimizerAttr.getParams();
+
+    FUSILLI_RETURN_ERROR_IF(mode == OptimizerAttr::Mode::NOT_SET,
+                            ErrorCode::AttributeNotSet,
+                            "Optimizer mode not set");
+    FUSILLI_RETURN_ERROR_IF(params.empty(), ErrorCode::AttributeNotSet,
+                            "Optimizer params not set");
+    FUSILLI_RETURN_ERROR_IF(
+        mode != OptimizerAttr::Mode::SGD && optimizerAttr.getNesterov(),
+        ErrorCode::InvalidAttribute,
+        "Optimizer Nesterov momentum is only supported by SGD");
+    FUSILLI_RETURN_ERROR_IF(
+        optimizerAttr.getNesterov() && !optimizerAttr.getMOMENTUM(),
+        ErrorCode::AttributeNotSet,
+        "Optimizer Nesterov momentum requires MOMENTUM");
+
+    // Every parameter has a gradient and the moments of the mode, and a new
+    // tensor for each of those it updates.
+    FUSILLI_CHECK_ERROR(checkList("grads", optimizerAttr.getGrads(), true));
+    FUSILLI_CHECK_ERROR(checkList("moments1", optimizerAttr.getMoments1(),
+                                  optimizerAttr.hasMoments1()));
+    FUSILLI_CHECK_ERROR(checkList("moments2", optimizerAttr.getMoments2(),
+                                  optimizerAttr.hasMoments2()));
+    FUSILLI_CHECK_ERROR(
+        checkList("new params", optimizerAttr.getNewParams(), true));
+    FUSILLI_CHECK_ERROR(checkList("new moments1",
+                                  optimizerAttr.getNewMoments1(),
+                                  optimizerAttr.hasMoments1()));
+    FUSILLI_CHECK_ERROR(checkList("new moments2",
+                                  optimizerAttr.getNewMoments2(),
+                                  optimizerAttr.hasMoments2()));
+    for (size_t i = 0; i < params.size(); ++i) {
+      FUSILLI_RETURN_ERROR_IF(!params[i], ErrorCode::AttributeNotSet,
+                              "Optimizer param " + std::to_string(i) +
+                                  " is null");
+      FUSILLI_RETURN_ERROR_IF(params[i]->isScalar() ||
+                                  params[i]->getDim().empty(),
+                              ErrorCode::InvalidAttribute,
+                              "Optimizer param " + std::to_string(i) +
+                                  " must be a non-scalar tensor with dims");
+      for (const auto *list :
+           {&optimizerAttr.getGrads(), &optimizerAttr.getMoments1(),
+            &optimizerAttr.getMoments2()}) {
+        if (list->empty())
+          continue;
+        const std::shared_ptr<TensorAttr> &t = (*list)[i];
+        FUSILLI_RETURN_ERROR_IF(t->isScalar() ||
+                                    t->getDim() != params[i]->getDim(),
+                                ErrorCode::InvalidAttribute,
+                                "Optimizer tensor '" + t->getName() +
+                                    "' must have the dims of param '" +
+                                    params[i]->getName() + "'");
+      }
+    }
+
+    // Scalar hyperparameters.
+    FUSILLI_RETURN_ERROR_IF(!optimizerAttr.getLR(), ErrorCode::AttributeNotSet,
+                            "Optimizer LR not set");
+    if (optimizerAttr.hasMoments2()) {
+      FUSILLI_RETURN_ERROR_IF(!optimizerAttr.getBETA1() ||
+                                  !optimizerAttr.getBETA2() ||
+                                  !optimizerAttr.getEPSILON() ||
+                                  !optimizerAttr.getSTEP(),
+                              ErrorCode::AttributeNotSet,
+                              "Optimizer " +
+                                  OptimizerAttr::kModeToStr.at(mode) +
+                                  " requires BETA1, BETA2, EPSILON and STEP");
+    } else {
+      FUSILLI_RETURN_ERROR_IF(optimizerAttr.getBETA1() ||
+                                  optimizerAttr.getBETA2() ||
+                                  optimizerAttr.getEPSILON() ||
+                                  optimizerAttr.getSTEP(),
+                              ErrorCode::InvalidAttribute,
+                              "Optimizer SGD takes no BETA1, BETA2, EPSILON "
+                              "or STEP");
+    }
+    FUSILLI_RETURN_ERROR_IF(
+        optimizerAttr.hasMoments2() && optimizerAttr.getMOMENTUM(),
+        ErrorCode::InvalidAttribute,
+        "Optimizer MOMENTUM is only supported by SGD, Adam uses BETA1");
+    for (const auto &[name, t] : optimizerAttr.inputs) {
+      if (!t)
+        continue;
+      FUSILLI_RETURN_ERROR_IF(!t->isScalar() ||
+                                  t->getDataType() != DataType::Float,
+                              ErrorCode::InvalidAttribute,
+                              "Optimizer hyperparameter '" + t->getName() +
+                                  "' must be a float scalar");
+    }
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for OptimizerNode '"
+                           << optimizerAttr.getName() << "'");
+
+    optimizerAttr.fillFromContext(context);
+    for (const auto *list :
+         {&optimizerAttr.getParams(), &optimizerAttr.getGrads(),
+          &optimizerAttr.getMoments1(), &optimizerAttr.getMoments2()})
+      for (const auto &t : *list)
+        t->fillFromContext(context);
+
+    // New tensors have the properties of the tensors they update.
+    auto infer = [](const OptimizerAttr::TensorList &outs,
+                    const OptimizerAttr::TensorList &ins) {
+      for (size_t i = 0; i < outs.size(); ++i) {
+        if (outs[i]->getDim().empty())
+          outs[i]->setDim(ins[i]->getDim());
+        if (outs[i]->getStride().empty())
+          outs[i]->setStride(ins[i]->getStride());
+        if (outs[i]->getDataType() == DataType::NotSet)
+          outs[i]->setDataType(ins[i]->getDataType());
+      }
+    };
+    infer(optimizerAttr.getNewParams(), optimizerAttr.getParams());
+    infer(optimizerAttr.getNewMoments1(), optimizerAttr.getMoments1());
+    infer(optimizerAttr.getNewMoments2(), optimizerAttr.getMoments2());
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating OptimizerNode '"
+                           << optimizerAttr.getName() << "'");
+
+    auto check = [](const OptimizerAttr::TensorList &outs,
+                    const OptimizerAttr::TensorList &ins) -> ErrorObject {
+      for (size_t i = 0; i < outs.size(); ++i)
+        FUSILLI_RETURN_ERROR_IF(
+            outs[i]->getDim() != ins[i]->getDim() ||
+                outs[i]->getDataType() != ins[i]->getDataType(),
+            ErrorCode::InvalidAttribute,
+            "Optimizer output tensor '" + outs[i]->getName() +
+                "' must have the dims and data type of '" + ins[i]->getName() +
+                "'");
+      return ok();
+    };
+    FUSILLI_CHECK_ERROR(
+        check(optimizerAttr.getNewParams(), optimizerAttr.getParams()));
+    FUSILLI_CHECK_ERROR(
+        check(optimizerAttr.getNewMoments1(), optimizerAttr.getMoments1()));
+    FUSILLI_CHECK_ERROR(
+        check(optimizerAttr.getNewMoments2(), optimizerAttr.getMoments2()));
+
+    return ok();
+  }
+
+private:
+  // Checks that `list` has a (non-null) tensor per parameter when `required`,
+  // and is empty otherwise.
+  ErrorObject checkList(const std::string &name,
+                        const OptimizerAttr::TensorList &list,
+                        bool required) const {
+    size_t expected = required ? optimizerAttr.getParams().size() : 0;
+    FUSILLI_RETURN_ERROR_IF(
+        list.size() != expected, ErrorCode::InvalidAttribute,
+        "Optimizer " + OptimizerAttr::kModeToStr.at(optimizerAttr.getMode()) +
+            " expects " + std::to_string(expected) + " " + name + ", got " +
+            std::to_string(list.size()));
+    FUSILLI_RETURN_ERROR_IF(
+        std::ranges::any_of(list, [](const auto &t) { return !t; }),
+        ErrorCode::AttributeNotSet, "Optimizer " + name + " has a null tensor");
+    return ok();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_OPTIMIZER_NODE_H
@@ -19,11 +19,15 @@
 #include "fusilli/node/node.h"
 #include "fusilli/support/logging.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace fusilli {
@@ -41,6 +45,62 @@ static const std::unordered_map<PointwiseAttr::Mode, DataType>
         {PointwiseAttr::Mode::LOGICAL_OR, DataType::Boolean},
 };
 
+// Evaluates a pointwise `mode` on scalar `args` on the host, as used for
+// constant folding. Returns std::nullopt for modes that are not folded.
+inline std::optional<double>
+evaluatePointwiseScalar(PointwiseAttr::Mode mode,
+                        const std::vector<double> &args) {
+  using Mode = PointwiseAttr::Mode;
+  switch (mode) {
+  case Mode::ADD:
+    return args[0] + args[1];
+  case Mode::SUB:
+    return args[0] - args[1];
+  case Mode::MUL:
+    return args[0] * args[1];
+  case Mode::DIV:
+    return args[0] / args[1];
+  case Mode::MAX_OP:
+    return std::max(args[0], args[1]);
+  case Mode::MIN_OP:
+    return std::min(args[0], args[1]);
+  case Mode::IDENTITY:
+    return args[0];
+  case Mode::NEG:
+    return -args[0];
+  case Mode::ABS:
+    return std::abs(args[0]);
+  case Mode::CEIL:
+    return std::ceil(args[0]);
+  case Mode::FLOOR:
+    return std::floor(args[0]);
+  case Mode::EXP:
+    return std::exp(args[0]);
+  case Mode::LOG:
+    return std::log(args[0]);
+  case Mode::SQRT:
+    return std::sqrt(args[0]);
+  case Mode::RSQRT:
+    return 1.0 / std::sqrt(args[0]);
+  case Mode::RECIPROCAL:
+    return 1.0 / args[0];
+  case Mode::RELU_FWD:
+    return std::max(args[0], 0.0);
+  case Mode::SIGMOID_FWD:
+    return 1.0 / (1.0 + std::exp(-args[0]));
+  case Mode::SIN:
+    return std::sin(args[0]);
+  case Mode::TAN:
+    return std::tan(args[0]);
+  case Mode::TANH_FWD:
+    return std::tanh(args[0]);
+  case Mode::ERF:
+    return std::erf(args[0]);
+  default:
+    return std::nullopt;
+  }
+}
+
 class PointwiseNode : public NodeCRTP<PointwiseNode> {
 public:
   PointwiseAttr pointwiseAttr;
@@ -65,6 +125,91 @@ public:
   }
   Type getType() const override final { return Type::Pointwise; }
 
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    pointwiseAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    pointwiseAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    pointwiseAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  // Folds the node when all its inputs are scalar constants (e.g. created with
+  // `TensorAttr(float)`) and its output is virtual, by evaluating it on the
+  // host. Integer outputs are only folded for modes that do not round (no
+  // division or transcendental functions).
+  bool foldConstants() override final {
+    const auto &out = pointwiseAttr.getOUT_0();
+    if (!out->isVirtual() || out->getDim() != std::vector<int64_t>{1})
+      return false;
+
+    std::vector<double> args;
+    for (const auto &in : {pointwiseAttr.getIN_0(), pointwiseAttr.getIN_1(),
+                           pointwiseAttr.getIN_2()}) {
+      if (!in)
+        continue;
+      if (!in->isInlinedScalar() || !in->getScalarValue().has_value())
+        return false;
+      args.push_back(std::visit([](auto v) { return static_cast<double>(v); },
+                                *in->getScalarValue()));
+    }
+
+    using Mode = PointwiseAttr::Mode;
+    Mode mode = pointwiseAttr.getMode();
+    bool isIntegerExact = mode == Mode::ADD || mode == Mode::SUB ||
+                          mode == Mode::MUL || mode == Mode::MAX_OP ||
+                          mode == Mode::MIN_OP || mode == Mode::IDENTITY ||
+                          mode == Mode::NEG || mode == Mode::ABS ||
+                          mode == Mode::RELU_FWD;
+    std::optional<double> value = evaluatePointwiseScalar(mode, args);
+    if (!value.has_value())
+      return false;
+
+    TensorAttr folded;
+    switch (out->getDataType()) {
+    case DataType::Float:
+      folded = TensorAttr(static_cast<float>(*value));
+      break;
+    case DataType::Double:
+      folded = TensorAttr(*value);
+      break;
+    case DataType::Int32:
+      if (!isIntegerExact)
+        return false;
+      folded = TensorAttr(static_cast<int32_t>(*value));
+      break;
+    case DataType::Int64:
+      if (!isIntegerExact)
+        return false;
+      folded = TensorAttr(static_cast<int64_t>(*value));
+      break;
+    default:
+      return false;
+    }
+    FUSILLI_LOG_LABEL_ENDL("INFO: Folding PointwiseNode '"
+                           << pointwiseAttr.getName() << "' into a constant");
+    folded.setName(out->getName());
+    *out = std::move(folded);
+    return true;
+  }
+
+  void archiveNode(Archive &ar) override final { pointwiseAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    pointwiseAttr.hashTensors(fp);
+    fp.update(pointwiseAttr.getMode())
+        .update(pointwiseAttr.getEluAlpha())
+        .update(pointwiseAttr.getSoftplusBeta())
+        .update(pointwiseAttr.getSoftplusThreshold())
+        .update(pointwiseAttr.getSwishBeta());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating PointwiseNode '"
                            << pointwiseAttr.getName() << "'");
@@ -145,7 +290,7 @@ public:
           continue;
         if (inTensor->getDim() != outTensor->getDim())
           continue;
-        outTensor->setStride(inTensor->getStride());
+        outTensor->setStride(inTensor->getCompactStride());
         break;
       }
 
@@ -0,0 +1,280 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the pooling node `PoolingNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_POOLING_NODE_H
+#define FUSILLI_NODE_POOLING_NODE_H
+
+#include "fusilli/attributes/pooling_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+//===----------------------------------------------------------------------===//
+// Helper functions for pooling nodes.
+//===----------------------------------------------------------------------===//
+
+// Infer the output shape of a pooling operation from the input shape, window,
+// dilation, padding, and stride. Batch and channel dims are kept.
+inline std::vector<int64_t> getPoolingInferredOutputShape(
+    const std::vector<int64_t> &xDim, const std::vector<int64_t> &window,
+    const std::vector<int64_t> &dilation, const std::vector<int64_t> &padding,
+    const std::vector<int64_t> &stride) {
+  constexpr size_t kSpatialStartIdx = 2;
+  std::vector<int64_t> yDim = xDim;
+  for (size_t i = kSpatialStartIdx; i < xDim.size(); ++i) {
+    size_t j = i - kSpatialStartIdx;
+    yDim[i] =
+        1 + (xDim[i] + 2 * padding[j] - dilation[j] * (window[j] - 1) - 1) /
+                stride[j];
+  }
+  return yDim;
+}
+
+//===----------------------------------------------------------------------===//
+// Pooling node.
+//
+// Computes the MAX or AVG of every window of the 1D, 2D or 3D spatial dims of
+// X (NCW, NCHW or NCDHW logical layout). Like the convolution nodes it
+// converts its tensors from and to their physical layout itself, so a
+// conv -> pointwise -> pooling block keeps its intermediates in logical
+// layout and compiles as one graph.
+//===----------------------------------------------------------------------===//
+
+class PoolingNode : public NodeCRTP<PoolingNode> {
+public:
+  PoolingAttr poolingAttr;
+
+  PoolingNode(PoolingAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), poolingAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+  std::string getOperandNamesAsm() const;
+  std::string getOperandTypesAsm() const;
+  std::string getResultNamesAsm() const;
+  std::string getResultTypesAsm() const;
+
+  // Returns the dilation, all 1s when not set.
+  std::vector<int64_t> getDilation() const {
+    const std::vector<int64_t> &dilation = poolingAttr.getDilation();
+    if (!dilation.empty())
+      return dilation;
+    return std::vector<int64_t>(poolingAttr.getWindow().size(), 1);
+  }
+
+  const std::string &getName() const override final {
+    return poolingAttr.getName();
+  }
+  Type getType() const override final { return Type::Pooling; }
+
+  // One operation per output element and window element.
+  double estimateFlops() const override final {
+    double window = 1;
+    for (int64_t w : poolingAttr.getWindow())
+      window *= static_cast<double>(w);
+    return static_cast<double>(poolingAttr.getY()->getVolume()) * window;
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    poolingAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    poolingAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    poolingAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { poolingAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    poolingAttr.hashTensors(fp);
+    fp.update(poolingAttr.getMode())
+        .update(poolingAttr.getWindow())
+        .update(poolingAttr.getPadding())
+        .update(poolingAttr.getStride())
+        .update(getDilation())
+        .update(poolingAttr.getCountIncludePad());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating PoolingNode '"
+                           << poolingAttr.getName() << "'");
+
+    FUSILLI_RETURN_ERROR_IF(poolingAttr.getMode() == PoolingAttr::Mode::NOT_SET,
+                            ErrorCode::AttributeNotSet,
+                            "Pooling mode not set");
+
+    const std::vector<int64_t> &window = poolingAttr.getWindow();
+    const std::vector<int64_t> &padding = poolingAttr.getPadding();
+    const std::vector<int64_t> &stride = poolingAttr.getStride();
+
+    FUSILLI_RETURN_ERROR_IF(window.empty(), ErrorCode::AttributeNotSet,
+                            "Pooling window not set");
+    FUSILLI_RETURN_ERROR_IF(padding.empty(), ErrorCode::AttributeNotSet,
+                            "Pooling padding not set");
+    FUSILLI_RETURN_ERROR_IF(stride.empty(), ErrorCode::AttributeNotSet,
+                            "Pooling stride not set");
+
+    std::shared_ptr<TensorAttr> xT = poolingAttr.getX();
+    std::shared_ptr<TensorAttr> yT = poolingAttr.getY();
+
+    // Ensure input and output tensors are set.
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Pooling input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!yT, ErrorCode::AttributeNotSet,
+                            "Pooling output tensor Y not set");
+
+    // Rank check on input tensor: 1D, 2D or 3D pooling.
+    size_t xRank = xT->getDim().size();
+    FUSILLI_RETURN_ERROR_IF(
+        xRank < 3 || xRank > 5, ErrorCode::InvalidAttribute,
+        "Pooling input tensor X must have a rank of 3, 4 or 5");
+
+    // Check window, padding, stride and dilation match the spatial dims.
+    // All dims except batch and channel (feature) are spatial dims.
+    size_t numSpatialDims = xRank - 2;
+    std::vector<int64_t> dilation = getDilation();
+    FUSILLI_RETURN_ERROR_IF(
+        window.size() != numSpatialDims, ErrorCode::InvalidAttribute,
+        "Pooling window size does not match number of spatial dimensions");
+    FUSILLI_RETURN_ERROR_IF(
+        padding.size() != numSpatialDims, ErrorCode::InvalidAttribute,
+        "Pooling padding size does not match number of spatial dimensions");
+    FUSILLI_RETURN_ERROR_IF(
+        stride.size() != numSpatialDims, ErrorCode::InvalidAttribute,
+        "Pooling stride size does not match number of spatial dimensions");
+    FUSILLI_RETURN_ERROR_IF(
+        dilation.size() != numSpatialDims, ErrorCode::InvalidAttribute,
+        "Pooling dilation size does not match number of spatial dimensions");
+
+    for (size_t i = 0; i < numSpatialDims; ++i) {
+      FUSILLI_RETURN_ERROR_IF(window[i] <= 0 || stride[i] <= 0 ||
+                                  dilation[i] <= 0,
+                              ErrorCode::InvalidAttribute,
+                              "Pooling window, stride and dilation must be "
+                              "positive");
+      // Every window must overlap the input, as in PyTorch.
+      int64_t effectiveWindow = dilation[i] * (window[i] - 1) + 1;
+      FUSILLI_RETURN_ERROR_IF(
+          padding[i] < 0 || 2 * padding[i] > effectiveWindow,
+          ErrorCode::InvalidAttribute,
+          "Pooling padding must be non-negative and at most half of the "
+          "(dilated) window size");
+      FUSILLI_RETURN_ERROR_IF(
+          xT->getDim()[i + 2] + 2 * padding[i] < effectiveWindow,
+          ErrorCode::InvalidAttribute,
+          "Pooling window does not fit the padded spatial dimensions of input "
+          "tensor X");
+    }
+
+    FUSILLI_RETURN_ERROR_IF(
+        poolingAttr.getMode() == PoolingAttr::Mode::AVG &&
+            std::ranges::any_of(dilation, [](int64_t d) { return d != 1; }),
+        ErrorCode::NotImplemented, "Pooling AVG does not support dilation");
+
+    // Layout check on input tensor.
+    FUSILLI_RETURN_ERROR_IF(!xT->isContiguous() && !xT->isChannelsLast(),
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + xT->getName() +
+                                "' is neither contiguous nor channels-last as "
+                                "defined by its stride");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for PoolingNode '"
+                           << poolingAttr.getName() << "'");
+
+    poolingAttr.fillFromContext(context);
+
+    // Logical layout is always channels-first (NCHW if 4D).
+    std::shared_ptr<TensorAttr> xT = poolingAttr.getX();
+    std::shared_ptr<TensorAttr> yT = poolingAttr.getY();
+
+    // Infer shape of output tensor.
+    if (yT->getDim().empty())
+      yT->setDim(getPoolingInferredOutputShape(
+          xT->getDim(), poolingAttr.getWindow(), getDilation(),
+          poolingAttr.getPadding(), poolingAttr.getStride()));
+
+    // Infer stride of output tensor.
+    if (yT->getStride().empty()) {
+      // When unspecified, preserve the stride order of xT (input tensor).
+      const std::vector<int64_t> &yDim = yT->getDim();
+      yT->setStride(
+          xT->isContiguous()
+              ? generateStrideFromDim(yDim,
+                                      getContiguousStrideOrder(yDim.size()))
+              : generateStrideFromDim(yDim,
+                                      getChannelsLastStrideOrder(yDim.size())));
+    }
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating PoolingNode '"
+                           << poolingAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = poolingAttr.getX();
+    std::shared_ptr<TensorAttr> yT = poolingAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != getPoolingInferredOutputShape(
+                            xT->getDim(), poolingAttr.getWindow(),
+                            getDilation(), poolingAttr.getPadding(),
+                            poolingAttr.getStride()),
+        ErrorCode::InvalidAttribute,
+        "Pooling output tensor Y dimensions do not match the expected shapes "
+        "inferred based on the input dimensions");
+
+    // Contiguity check for output tensor.
+    FUSILLI_RETURN_ERROR_IF(!yT->isContiguous() && !yT->isChannelsLast(),
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + yT->getName() +
+                                "' is neither contiguous nor channels-last as "
+                                "defined by its stride");
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDataType() != xT->getDataType(), ErrorCode::InvalidAttribute,
+        "Pooling output tensor Y must have the data type of input tensor X");
+    FUSILLI_RETURN_ERROR_IF(
+        poolingAttr.getMode() == PoolingAttr::Mode::AVG &&
+            isIntegralOrBoolType(xT->getDataType()),
+        ErrorCode::InvalidAttribute,
+        "Pooling AVG is not supported for integral or boolean tensors");
+
+    return ok();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_POOLING_NODE_H
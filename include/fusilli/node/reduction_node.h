@@ -21,6 +21,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -41,15 +42,18 @@ public:
   std::string getOperandTypesAsm() const;
   std::string getResultNamesAsm() const;
   std::string getResultTypesAsm() const;
+  std::string getMultiOutputReductionAsm() const;
 
   // Returns the list of dimension indices that are reduced.
-  // A dimension is reduced if Y[i] == 1 and X[i] > 1.
+  // A dimension is reduced if Y[i] == 1 and X[i] > 1, or for TOPK if
+  // Y[i] (= k) differs from X[i].
   std::vector<int64_t> getReductionDims() const {
     std::vector<int64_t> reductionDims;
     const auto &xDim = reductionAttr.getX()->getDim();
     const auto &yDim = reductionAttr.getY()->getDim();
+    bool isTopK = reductionAttr.getMode() == ReductionAttr::Mode::TOPK;
     for (size_t i = 0; i < xDim.size(); ++i) {
-      if (yDim[i] == 1 && xDim[i] > 1)
+      if (isTopK ? yDim[i] != xDim[i] : yDim[i] == 1 && xDim[i] > 1)
         reductionDims.push_back(static_cast<int64_t>(i));
     }
     return reductionDims;
@@ -60,6 +64,32 @@ public:
   }
   Type getType() const override final { return Type::Reduction; }
 
+  // One operation per input element.
+  double estimateFlops() const override final {
+    return static_cast<double>(reductionAttr.getX()->getVolume());
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    reductionAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    reductionAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    reductionAttr.replaceOutput(from, to);
+  }
+
+  void archiveNode(Archive &ar) override final { reductionAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    reductionAttr.hashTensors(fp);
+    fp.update(reductionAttr.getMode());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ReductionNode '"
                            << reductionAttr.getName() << "'");
@@ -79,6 +109,20 @@ public:
     FUSILLI_RETURN_ERROR_IF(reductionAttr.getX()->getDim().empty(),
                             ErrorCode::AttributeNotSet,
                             "Reduction input X dimensions not set");
+
+    // Validate output Y2 is set exactly for the multi-output modes
+    const std::string &modeStr =
+        ReductionAttr::kModeToStr.at(reductionAttr.getMode());
+    bool isMultiOutput =
+        ReductionAttr::isMultiOutputMode(reductionAttr.getMode());
+    FUSILLI_RETURN_ERROR_IF(isMultiOutput && !reductionAttr.getY2(),
+                            ErrorCode::AttributeNotSet,
+                            "Reduction mode " + modeStr +
+                                " requires Y2 output");
+    FUSILLI_RETURN_ERROR_IF(!isMultiOutput && reductionAttr.getY2(),
+                            ErrorCode::InvalidAttribute,
+                            "Reduction mode " + modeStr +
+                                " does not support Y2 output");
     return ok();
   }
 
@@ -86,6 +130,18 @@ public:
     FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for ReductionNode '"
                            << reductionAttr.getName() << "'");
 
+    // Indices are Int64, and the top-k values keep the data type of X.
+    ReductionAttr::Mode mode = reductionAttr.getMode();
+    std::shared_ptr<TensorAttr> indexTensor = mode == ReductionAttr::Mode::TOPK
+                                                  ? reductionAttr.getY2()
+                                                  : reductionAttr.getY();
+    if (ReductionAttr::isIndexMode(mode) &&
+        indexTensor->getDataType() == DataType::NotSet)
+      indexTensor->setDataType(DataType::Int64);
+    if (mode == ReductionAttr::Mode::TOPK &&
+        reductionAttr.getY()->getDataType() == DataType::NotSet)
+      reductionAttr.getY()->setDataType(reductionAttr.getX()->getDataType());
+
     // Fill missing properties from context (including data types)
     reductionAttr.fillFromContext(context);
 
@@ -104,6 +160,15 @@ public:
           yTensor->getDim(),
           getContiguousStrideOrder(yTensor->getDim().size())));
     }
+
+    // Y2 holds the second statistic of the same reduction.
+    const auto &y2Tensor = reductionAttr.getY2();
+    if (y2Tensor && y2Tensor->getDim().empty())
+      y2Tensor->setDim(yTensor->getDim());
+    if (y2Tensor && y2Tensor->getStride().empty())
+      y2Tensor->setStride(generateStrideFromDim(
+          y2Tensor->getDim(),
+          getContiguousStrideOrder(y2Tensor->getDim().size())));
     return ok();
   }
 
@@ -125,13 +190,38 @@ public:
              isIntegralOrBoolType(yTensor->getDataType())),
         ErrorCode::InvalidAttribute,
         "Reduction AVG is not supported for integral or boolean tensors");
+    FUSILLI_RETURN_ERROR_IF(
+        reductionAttr.getMode() == ReductionAttr::Mode::MEAN_VAR &&
+            (isIntegralOrBoolType(xTensor->getDataType()) ||
+             isIntegralOrBoolType(yTensor->getDataType())),
+        ErrorCode::InvalidAttribute,
+        "Reduction MEAN_VAR is not supported for integral or boolean tensors");
+
+    // Both statistics of a multi-output mode share dims and data type. The
+    // TOPK indices only share the dims.
+    ReductionAttr::Mode mode = reductionAttr.getMode();
+    bool isTopK = mode == ReductionAttr::Mode::TOPK;
+    const auto &y2Tensor = reductionAttr.getY2();
+    FUSILLI_RETURN_ERROR_IF(
+        y2Tensor && (y2Tensor->getDim() != yTensor->getDim() ||
+                     (!isTopK &&
+                      y2Tensor->getDataType() != yTensor->getDataType())),
+        ErrorCode::InvalidAttribute,
+        "Reduction output Y2 must have the dimensions and data type of Y");
 
     // Validate reduction dimensions - if Y[i] differs from X[i], Y[i] must be 1
+    // (or k, at most X[i], for TOPK)
     const auto &xDim = xTensor->getDim();
     const auto &yDim = yTensor->getDim();
     for (size_t i = 0; i < xDim.size(); ++i) {
       FUSILLI_RETURN_ERROR_IF(
-          yDim[i] != 1 && yDim[i] != xDim[i], ErrorCode::InvalidAttribute,
+          isTopK && (yDim[i] < 1 || yDim[i] > xDim[i]),
+          ErrorCode::InvalidAttribute,
+          "Reduction TOPK output dimension " + std::to_string(i) +
+              " must be between 1 and the input dimension");
+      FUSILLI_RETURN_ERROR_IF(
+          !isTopK && yDim[i] != 1 && yDim[i] != xDim[i],
+          ErrorCode::InvalidAttribute,
           "Reduction output dimension " + std::to_string(i) +
               " must be 1 or match input dimension");
     }
@@ -141,6 +231,34 @@ public:
                             ErrorCode::InvalidAttribute,
                             "Reduction requires at least one dimension to "
                             "reduce (Y[i] == 1 where X[i] > 1)");
+
+    // Index modes return positions along a single dimension.
+    if (ReductionAttr::isIndexMode(mode)) {
+      const std::string &modeStr = ReductionAttr::kModeToStr.at(mode);
+      FUSILLI_RETURN_ERROR_IF(getReductionDims().size() != 1,
+                              ErrorCode::InvalidAttribute,
+                              "Reduction mode " + modeStr +
+                                  " reduces exactly one dimension");
+      std::shared_ptr<TensorAttr> indexTensor = isTopK ? y2Tensor : yTensor;
+      FUSILLI_RETURN_ERROR_IF(
+          indexTensor->getDataType() != DataType::Int64,
+          ErrorCode::InvalidAttribute,
+          "Reduction mode " + modeStr + " requires " +
+              (isTopK ? "Y2" : "Y") + " of data type Int64");
+      FUSILLI_RETURN_ERROR_IF(
+          isTopK && yTensor->getDataType() != xTensor->getDataType(),
+          ErrorCode::InvalidAttribute,
+          "Reduction TOPK values Y must have the data type of X");
+    }
+
+    // MEAN_VAR divides by the number of reduced elements, known statically.
+    for (int64_t d : getReductionDims())
+      FUSILLI_RETURN_ERROR_IF(
+          reductionAttr.getMode() == ReductionAttr::Mode::MEAN_VAR &&
+              xTensor->isDynamicDim(static_cast<size_t>(d)),
+          ErrorCode::NotImplemented,
+          "Reduction MEAN_VAR over dynamic dimension " + std::to_string(d) +
+              " is not supported");
     return ok();
   }
 };
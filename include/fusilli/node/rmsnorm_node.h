@@ -6,8 +6,8 @@
 
 //===----------------------------------------------------------------------===//
 //
-// This file contains definitions for the RMS normalization node
-// `RmsNormNode`.
+// This file contains definitions for the RMS normalization nodes
+// `RmsNormNode` and `RmsNormBwdNode`.
 //
 //===----------------------------------------------------------------------===//
 
@@ -56,6 +56,28 @@ public:
   }
   Type getType() const override final { return Type::RmsNorm; }
 
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    rmsnormAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    rmsnormAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    rmsnormAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { rmsnormAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    rmsnormAttr.hashTensors(fp);
+    fp.update(rmsnormAttr.getForwardPhase());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating RmsNormNode '"
                            << rmsnormAttr.getName() << "'");
@@ -118,6 +140,28 @@ public:
           "RmsNorm output tensor INV_RMS should not be set");
     }
 
+    // Residual checks. The fused residual add normalizes X + RESIDUAL and
+    // also produces the (pre-normalization) sum as SUM.
+    std::shared_ptr<TensorAttr> resT = rmsnormAttr.getRESIDUAL();
+    std::shared_ptr<TensorAttr> sumT = rmsnormAttr.getSUM();
+    FUSILLI_RETURN_ERROR_IF(
+        static_cast<bool>(resT) != static_cast<bool>(sumT),
+        ErrorCode::AttributeNotSet,
+        "RmsNorm RESIDUAL and SUM tensors must be set together");
+    if (resT) {
+      FUSILLI_RETURN_ERROR_IF(resT == xT, ErrorCode::InvalidAttribute,
+                              "RmsNorm input tensor RESIDUAL must not be X");
+      FUSILLI_RETURN_ERROR_IF(
+          resT->getDim() != xT->getDim(), ErrorCode::InvalidAttribute,
+          "RmsNorm input tensor RESIDUAL must have the same shape as input X "
+          "tensor");
+      FUSILLI_RETURN_ERROR_IF(!resT->isContiguous() && !resT->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + resT->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+    }
+
     // Epsilon checks.
     std::shared_ptr<TensorAttr> eT = rmsnormAttr.getEpsilon();
     FUSILLI_RETURN_ERROR_IF(!eT, ErrorCode::AttributeNotSet,
@@ -147,7 +191,11 @@ public:
 
     // Infer shape and stride of output Y tensor.
     // When stride is unspecified, preserve the stride order of xT.
-    norm_utils::inferDimAndStride(yT, xDim, xT->getStride());
+    norm_utils::inferDimAndStride(yT, xDim, xT->getCompactStride());
+
+    // Infer shape and stride of output SUM tensor (same as X).
+    if (std::shared_ptr<TensorAttr> sumT = rmsnormAttr.getSUM())
+      norm_utils::inferDimAndStride(sumT, xDim, xT->getCompactStride());
 
     if (isTrainingForwardPhase()) {
       const auto &[dim, stride] =
@@ -182,6 +230,19 @@ public:
                                 "' is neither contiguous nor channels-last as "
                                 "defined by its stride");
 
+    // Shape and layout checks for output SUM tensor.
+    if (std::shared_ptr<TensorAttr> sumT = rmsnormAttr.getSUM()) {
+      FUSILLI_RETURN_ERROR_IF(
+          xDim != sumT->getDim(), ErrorCode::InvalidAttribute,
+          "RmsNorm output SUM tensor must have the same shape as input X "
+          "tensor");
+      FUSILLI_RETURN_ERROR_IF(!sumT->isContiguous() && !sumT->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + sumT->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+    }
+
     if (isTrainingForwardPhase()) {
       const auto &[dim, stride] =
           norm_utils::getTrainingForwardOutputDimAndStride(xDim);
@@ -216,6 +277,191 @@ private:
   std::vector<int64_t> getNormalizedShape() const {
     return norm_utils::getNormalizedShape(rmsnormAttr.getX()->getDim());
   }
+
+  // The normalized tensor: X, or the sum of X and RESIDUAL when fused.
+  std::shared_ptr<TensorAttr> getNormInput() const {
+    std::shared_ptr<TensorAttr> sumT = rmsnormAttr.getSUM();
+    return sumT ? sumT : rmsnormAttr.getX();
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// RMS normalization backward node.
+//===----------------------------------------------------------------------===//
+
+// Computes the gradients DX and DSCALE of an RMS normalization in one pass
+// over DY and X, from the INV_RMS of the forward pass. DSCALE is only computed
+// with a SCALE.
+class RmsNormBwdNode : public NodeCRTP<RmsNormBwdNode> {
+public:
+  RmsnormBwdAttr rmsnormBwdAttr;
+
+  RmsNormBwdNode(RmsnormBwdAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), rmsnormBwdAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return rmsnormBwdAttr.getName();
+  }
+  Type getType() const override final { return Type::RmsNormBwd; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    rmsnormBwdAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    rmsnormBwdAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    rmsnormBwdAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { rmsnormBwdAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    rmsnormBwdAttr.hashTensors(fp);
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating RmsNormBwdNode '"
+                           << rmsnormBwdAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> dyT = rmsnormBwdAttr.getDY();
+    std::shared_ptr<TensorAttr> xT = rmsnormBwdAttr.getX();
+    std::shared_ptr<TensorAttr> sT = rmsnormBwdAttr.getSCALE();
+    std::shared_ptr<TensorAttr> rT = rmsnormBwdAttr.getINV_RMS();
+    std::shared_ptr<TensorAttr> dxT = rmsnormBwdAttr.getDX();
+    std::shared_ptr<TensorAttr> dsT = rmsnormBwdAttr.getDSCALE();
+
+    // Ensure mandatory input and output tensors are set.
+    FUSILLI_RETURN_ERROR_IF(!dyT, ErrorCode::AttributeNotSet,
+                            "RmsNorm backward input tensor DY not set");
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "RmsNorm backward input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!rT, ErrorCode::AttributeNotSet,
+                            "RmsNorm backward input tensor INV_RMS not set");
+    FUSILLI_RETURN_ERROR_IF(!dxT, ErrorCode::AttributeNotSet,
+                            "RmsNorm backward output tensor DX not set");
+    FUSILLI_RETURN_ERROR_IF(
+        static_cast<bool>(sT) != static_cast<bool>(dsT),
+        ErrorCode::AttributeNotSet,
+        "RmsNorm backward SCALE and DSCALE tensors must be set together");
+
+    // Shape and layout checks on input tensors.
+    FUSILLI_RETURN_ERROR_IF(
+        xT->getDim().size() < 2, ErrorCode::InvalidAttribute,
+        "RmsNorm backward input tensor X must have a rank of at least 2");
+    FUSILLI_RETURN_ERROR_IF(
+        dyT->getDim() != xT->getDim(), ErrorCode::InvalidAttribute,
+        "RmsNorm backward input tensor DY must have the same shape as input X "
+        "tensor");
+    for (const auto &t : {xT, dyT})
+      FUSILLI_RETURN_ERROR_IF(!t->isContiguous() && !t->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + t->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+
+    // Shape and layout checks on scale tensor.
+    // If scale tensor's dims/strides are not set, they will be inferred in
+    // inferPropertiesNode().
+    if (sT) {
+      FUSILLI_RETURN_ERROR_IF(
+          !sT->getDim().empty() &&
+              sT->getDim() != norm_utils::getScaleBiasDim(xT->getDim()),
+          ErrorCode::InvalidAttribute,
+          "RmsNorm backward input tensor SCALE must have shape as tensor X "
+          "with single batch");
+      FUSILLI_RETURN_ERROR_IF(!sT->getStride().empty() &&
+                                  !sT->isContiguous() && !sT->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + sT->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+    }
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for RmsNormBwdNode '"
+                           << rmsnormBwdAttr.getName() << "'");
+
+    rmsnormBwdAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> xT = rmsnormBwdAttr.getX();
+    const std::vector<int64_t> &xDim = xT->getDim();
+    const std::vector<int64_t> &xStride = xT->getStride();
+
+    // Infer shape and stride of input INV_RMS tensor if they're not set.
+    const auto &[statDim, statStride] =
+        norm_utils::getTrainingForwardOutputDimAndStride(xDim);
+    std::shared_ptr<TensorAttr> rT = rmsnormBwdAttr.getINV_RMS();
+    norm_utils::inferDimAndStride(rT, statDim, statStride);
+
+    // Infer shape and stride of output DX tensor (same as X).
+    std::shared_ptr<TensorAttr> dxT = rmsnormBwdAttr.getDX();
+    norm_utils::inferDimAndStride(dxT, xDim, xT->getCompactStride());
+
+    // SCALE and DSCALE have the shape of X with single batch.
+    for (std::shared_ptr<TensorAttr> t :
+         {rmsnormBwdAttr.getSCALE(), rmsnormBwdAttr.getDSCALE()})
+      if (t)
+        norm_utils::inferScaleBiasDimAndStride(t, xDim, xStride);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating RmsNormBwdNode '"
+                           << rmsnormBwdAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = rmsnormBwdAttr.getX();
+    std::shared_ptr<TensorAttr> dxT = rmsnormBwdAttr.getDX();
+    const std::vector<int64_t> &xDim = xT->getDim();
+
+    // Shape and layout checks for output DX tensor.
+    FUSILLI_RETURN_ERROR_IF(xDim != dxT->getDim(), ErrorCode::InvalidAttribute,
+                            "RmsNorm backward output DX tensor must have the "
+                            "same shape as input X tensor");
+    FUSILLI_RETURN_ERROR_IF(!dxT->isContiguous() && !dxT->isChannelsLast(),
+                            ErrorCode::NotImplemented,
+                            "Tensor '" + dxT->getName() +
+                                "' is neither contiguous nor channels-last as "
+                                "defined by its stride");
+
+    // Shape check for input INV_RMS tensor.
+    std::vector<int64_t> statDim =
+        norm_utils::getTrainingForwardOutputDimAndStride(xDim).first;
+    FUSILLI_RETURN_ERROR_IF(
+        rmsnormBwdAttr.getINV_RMS()->getDim() != statDim,
+        ErrorCode::InvalidAttribute,
+        "RmsNorm backward input tensor INV_RMS must have shape [B, 1, ..., 1] "
+        "with rank equal to input X tensor's rank, and batch dimension equal "
+        "to input X tensor's batch dimension");
+
+    // Shape and layout checks for output DSCALE tensor.
+    if (std::shared_ptr<TensorAttr> dsT = rmsnormBwdAttr.getDSCALE()) {
+      FUSILLI_RETURN_ERROR_IF(
+          dsT->getDim() != norm_utils::getScaleBiasDim(xDim),
+          ErrorCode::InvalidAttribute,
+          "RmsNorm backward output tensor DSCALE must have shape as tensor X "
+          "with single batch");
+      FUSILLI_RETURN_ERROR_IF(!dsT->isContiguous() && !dsT->isChannelsLast(),
+                              ErrorCode::NotImplemented,
+                              "Tensor '" + dsT->getName() +
+                                  "' is neither contiguous nor channels-last "
+                                  "as defined by its stride");
+    }
+
+    return ok();
+  }
 };
 
 } // namespace fusilli
@@ -7,7 +7,7 @@
 //===----------------------------------------------------------------------===//
 //
 // This file contains definitions for the scaled dot-product attention (SDPA)
-// node `SdpaNode`.
+// nodes `SdpaNode` and `SdpaBwdNode`.
 //
 //===----------------------------------------------------------------------===//
 
@@ -20,9 +20,12 @@
 #include "fusilli/node/node.h"
 #include "fusilli/support/logging.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,7 +33,17 @@
 namespace fusilli {
 
 //===----------------------------------------------------------------------===//
-// Scaled dot-product attention node.
+// Helper functions for SDPA nodes.
+//===----------------------------------------------------------------------===//
+
+// Returns the scale applied to Q @ K^T: the attribute value when set, else
+// 1 / sqrt(head_dim) as in PyTorch SDPA.
+inline float getSdpaScale(std::optional<float> scale, int64_t headDim) {
+  return scale.value_or(1.0f / std::sqrt(static_cast<float>(headDim)));
+}
+
+//===----------------------------------------------------------------------===//
+// Scaled dot-product attention nodes.
 //===----------------------------------------------------------------------===//
 
 class SdpaNode : public NodeCRTP<SdpaNode> {
@@ -47,15 +60,105 @@ public:
   std::string getResultNamesAsm() const;
   std::string getResultTypesAsm() const;
   std::string getDropoutOpsAsm() const;
+  std::string getDropoutRngOpsAsm() const;
   std::string getIsCausalOpsAsm() const;
   std::string getScaleOpsAsm() const;
   std::string getEnableGqaOpsAsm() const;
+  std::string getPagedKvOpsAsm() const;
+  std::string getVarlenOpsAsm() const;
+  std::string getVarlenOutputOpsAsm() const;
+  std::string getStatsOpsAsm() const;
+  std::string getRopeOpsAsm() const;
+
+  // Returns the KV sequence length attended over. In paged mode this is the
+  // span of the block table, `pages_per_seq * block_size`.
+  int64_t getSeqKV() const {
+    if (!sdpaAttr.isPaged())
+      return sdpaAttr.getK()->getDim()[2];
+    return sdpaAttr.getPAGE_TABLE()->getDim()[1] * sdpaAttr.getBlockSize();
+  }
+
+  // Returns the [1, heads, total, head_dim] shape a packed varlen tensor
+  // takes as a single attention batch. A dynamic total is returned as -1.
+  std::vector<int64_t>
+  getVarlenBatchedDim(const std::shared_ptr<TensorAttr> &packedT) const {
+    const std::vector<int64_t> &dim = packedT->getDim();
+    int64_t total = packedT->isDynamicDim(0) ? -1 : dim[0];
+    return {1, dim[1], total, dim[2]};
+  }
+
+  // Returns the expected shape of O: [batch, heads_q, seq_q, head_dim_v], or
+  // [total_q, heads_q, head_dim_v] when packed varlen.
+  std::vector<int64_t> getExpectedOutputDim() const {
+    const std::vector<int64_t> &qDim = sdpaAttr.getQ()->getDim();
+    int64_t headDimV = sdpaAttr.getV()->getDim().back();
+    if (sdpaAttr.isVarlen())
+      return {qDim[0], qDim[1], headDimV};
+    return {qDim[0], qDim[1], qDim[2], headDimV};
+  }
+
+  // Returns the expected shape of STATS: [batch, heads_q, seq_q, 1].
+  std::vector<int64_t> getExpectedStatsDim() const {
+    const std::vector<int64_t> &qDim = sdpaAttr.getQ()->getDim();
+    return {qDim[0], qDim[1], qDim[2], 1};
+  }
+
+  // Returns the [batch, heads_kv, seq_kv, head_dim] shape that K or V take
+  // after the page gather (or as given, when not paged).
+  std::vector<int64_t>
+  getGatheredKvDim(const std::shared_ptr<TensorAttr> &kvT) const {
+    const std::vector<int64_t> &dim = kvT->getDim();
+    return {sdpaAttr.getQ()->getDim()[0], dim[1], getSeqKV(), dim[3]};
+  }
 
   const std::string &getName() const override final {
     return sdpaAttr.getName();
   }
   Type getType() const override final { return Type::Sdpa; }
 
+  // Two operations per element of Q and of O (the QK^T and PV products) and
+  // key attended to, halved by causal masking. Packed varlen batches attend
+  // to the average KV sequence length.
+  double estimateFlops() const override final {
+    double seqKv = static_cast<double>(getSeqKV());
+    if (sdpaAttr.isVarlen()) {
+      int64_t batch = sdpaAttr.getCU_SEQLENS_KV()->getDim()[0] - 1;
+      seqKv = static_cast<double>(sdpaAttr.getK()->getDim()[0]) /
+              static_cast<double>(std::max<int64_t>(batch, 1));
+    }
+    double flops = 2.0 * seqKv *
+                   static_cast<double>(sdpaAttr.getQ()->getVolume() +
+                                       sdpaAttr.getO()->getVolume());
+    return sdpaAttr.getIsCausal() ? flops / 2 : flops;
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    sdpaAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    sdpaAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    sdpaAttr.replaceOutput(from, to);
+  }
+
+  void archiveNode(Archive &ar) override final { sdpaAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    sdpaAttr.hashTensors(fp);
+    std::optional<float> scale = sdpaAttr.getScale();
+    fp.update(sdpaAttr.getDropout())
+        .update(sdpaAttr.getIsCausal())
+        .update(scale.has_value())
+        .update(scale.value_or(0.0f))
+        .update(sdpaAttr.getEnableGqa())
+        .update(sdpaAttr.getBlockSize());
+  }
+
   ErrorObject preValidateNode() const override final {
     FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating SdpaNode '"
                            << sdpaAttr.getName() << "'");
@@ -65,6 +168,7 @@ public:
     std::shared_ptr<TensorAttr> vT = sdpaAttr.getV();
     std::shared_ptr<TensorAttr> oT = sdpaAttr.getO();
     std::shared_ptr<TensorAttr> maskT = sdpaAttr.getMASK();
+    std::shared_ptr<TensorAttr> pageTableT = sdpaAttr.getPAGE_TABLE();
 
     // Ensure mandatory input and output tensors are set.
     FUSILLI_RETURN_ERROR_IF(!qT, ErrorCode::AttributeNotSet,
@@ -76,38 +180,73 @@ public:
     FUSILLI_RETURN_ERROR_IF(!oT, ErrorCode::AttributeNotSet,
                             "SDPA output tensor O not set");
 
-    // Rank checks: all tensors must be rank 4.
+    // Rank checks: all tensors must be rank 4 (rank 3 when packed varlen).
     constexpr size_t kRequiredRank = 4;
-    FUSILLI_RETURN_ERROR_IF(qT->getDim().size() != kRequiredRank,
-                            ErrorCode::InvalidAttribute,
-                            "SDPA input tensor Q must be rank 4 "
-                            "[batch, heads_q, seq_q, head_dim]");
-    FUSILLI_RETURN_ERROR_IF(kT->getDim().size() != kRequiredRank,
-                            ErrorCode::InvalidAttribute,
-                            "SDPA input tensor K must be rank 4 "
-                            "[batch, heads_kv, seq_kv, head_dim]");
-    FUSILLI_RETURN_ERROR_IF(vT->getDim().size() != kRequiredRank,
-                            ErrorCode::InvalidAttribute,
-                            "SDPA input tensor V must be rank 4 "
-                            "[batch, heads_kv, seq_kv, head_dim]");
+    bool varlen = sdpaAttr.isVarlen();
+    if (varlen) {
+      FUSILLI_CHECK_ERROR(preValidateVarlen());
+    } else {
+      FUSILLI_RETURN_ERROR_IF(qT->getDim().size() != kRequiredRank,
+                              ErrorCode::InvalidAttribute,
+                              "SDPA input tensor Q must be rank 4 "
+                              "[batch, heads_q, seq_q, head_dim]");
+      FUSILLI_RETURN_ERROR_IF(kT->getDim().size() != kRequiredRank,
+                              ErrorCode::InvalidAttribute,
+                              "SDPA input tensor K must be rank 4 "
+                              "[batch, heads_kv, seq_kv, head_dim]");
+      FUSILLI_RETURN_ERROR_IF(vT->getDim().size() != kRequiredRank,
+                              ErrorCode::InvalidAttribute,
+                              "SDPA input tensor V must be rank 4 "
+                              "[batch, heads_kv, seq_kv, head_dim]");
+    }
 
     const std::vector<int64_t> &qDim = qT->getDim();
     const std::vector<int64_t> &kDim = kT->getDim();
     const std::vector<int64_t> &vDim = vT->getDim();
+    size_t seqIdx = varlen ? 0 : 2;
 
-    // Batch dimension must match across Q, K, V.
+    // Paged mode: K and V are page pools indexed through the block table.
     FUSILLI_RETURN_ERROR_IF(
-        qDim[0] != kDim[0] || qDim[0] != vDim[0], ErrorCode::InvalidAttribute,
-        "SDPA input tensors Q, K, V must have matching batch dimension");
+        pageTableT && sdpaAttr.getBlockSize() <= 0,
+        ErrorCode::InvalidAttribute,
+        "SDPA paged attention requires a positive block size");
+    FUSILLI_RETURN_ERROR_IF(
+        !pageTableT && sdpaAttr.getBlockSize() != 0,
+        ErrorCode::AttributeNotSet,
+        "SDPA block size is set but page table tensor PAGE_TABLE is not");
+    if (pageTableT) {
+      const std::vector<int64_t> &ptDim = pageTableT->getDim();
+      int64_t blockSize = sdpaAttr.getBlockSize();
+      FUSILLI_RETURN_ERROR_IF(ptDim.size() != 2, ErrorCode::InvalidAttribute,
+                              "SDPA page table PAGE_TABLE must be rank 2 "
+                              "[batch, pages_per_seq]");
+      FUSILLI_RETURN_ERROR_IF(
+          ptDim[0] != qDim[0], ErrorCode::InvalidAttribute,
+          "SDPA page table PAGE_TABLE batch dim must match Q batch");
+      FUSILLI_RETURN_ERROR_IF(
+          kDim[0] != vDim[0], ErrorCode::InvalidAttribute,
+          "SDPA paged K and V must have the same number of pages");
+      FUSILLI_RETURN_ERROR_IF(
+          kDim[2] != blockSize || vDim[2] != blockSize,
+          ErrorCode::InvalidAttribute,
+          "SDPA paged K and V dim 2 must equal the block size (" +
+              std::to_string(blockSize) + ")");
+    } else if (!varlen) {
+      // Batch dimension must match across Q, K, V.
+      FUSILLI_RETURN_ERROR_IF(
+          qDim[0] != kDim[0] || qDim[0] != vDim[0],
+          ErrorCode::InvalidAttribute,
+          "SDPA input tensors Q, K, V must have matching batch dimension");
+    }
 
     // Head dimension must match across Q and K.
     FUSILLI_RETURN_ERROR_IF(
-        qDim[3] != kDim[3], ErrorCode::InvalidAttribute,
+        qDim.back() != kDim.back(), ErrorCode::InvalidAttribute,
         "SDPA input tensors Q and K must have matching head_dim");
 
     // K and V must have matching sequence length.
     FUSILLI_RETURN_ERROR_IF(
-        kDim[2] != vDim[2], ErrorCode::InvalidAttribute,
+        kDim[seqIdx] != vDim[seqIdx], ErrorCode::InvalidAttribute,
         "SDPA input tensors K and V must have matching sequence length");
 
     // Head count validation: K and V may have different head counts
@@ -145,7 +284,7 @@ public:
     if (maskT) {
       const std::vector<int64_t> &maskDim = maskT->getDim();
       int64_t seqQ = qDim[2];
-      int64_t seqKV = kDim[2];
+      int64_t seqKV = getSeqKV();
 
       // Rank check.
       FUSILLI_RETURN_ERROR_IF(maskDim.size() != kRequiredRank,
@@ -180,6 +319,36 @@ public:
                             ErrorCode::InvalidAttribute,
                             "SDPA dropout probability must be in [0, 1)");
 
+    // Runtime dropout RNG: the attention is decomposed around the generated
+    // mask, which only covers plain (optionally causal) attention.
+    if (sdpaAttr.hasDropoutRng()) {
+      FUSILLI_RETURN_ERROR_IF(
+          !sdpaAttr.getDROPOUT_SEED() || !sdpaAttr.getDROPOUT_OFFSET(),
+          ErrorCode::AttributeNotSet,
+          "SDPA runtime dropout requires both DROPOUT_SEED and "
+          "DROPOUT_OFFSET");
+      FUSILLI_RETURN_ERROR_IF(dropout == 0.0f, ErrorCode::InvalidAttribute,
+                              "SDPA DROPOUT_SEED and DROPOUT_OFFSET require a "
+                              "non-zero dropout probability");
+      FUSILLI_RETURN_ERROR_IF(
+          sdpaAttr.isPaged() || varlen || maskT || sdpaAttr.getEnableGqa(),
+          ErrorCode::NotImplemented,
+          "SDPA runtime dropout is not supported with a paged KV cache, "
+          "varlen packing, an explicit mask or GQA");
+    }
+
+    if (sdpaAttr.hasRope())
+      FUSILLI_CHECK_ERROR(preValidateRope());
+
+    // The saved logsumexp is computed from the plain scaled (and optionally
+    // causal) scores, the same ones `SdpaBwdNode` recomputes.
+    FUSILLI_RETURN_ERROR_IF(
+        sdpaAttr.hasStats() && (sdpaAttr.isPaged() || varlen || maskT ||
+                                sdpaAttr.getEnableGqa() || dropout != 0.0f),
+        ErrorCode::NotImplemented,
+        "SDPA stats output STATS is not supported with a paged KV cache, "
+        "varlen packing, an explicit mask, GQA or dropout");
+
     return ok();
   }
 
@@ -187,18 +356,42 @@ public:
     FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for SdpaNode '"
                            << sdpaAttr.getName() << "'");
 
+    // The saved logsumexp is kept in f32 unless set otherwise.
+    std::shared_ptr<TensorAttr> statsT = sdpaAttr.getSTATS();
+    if (statsT && statsT->getDataType() == DataType::NotSet)
+      statsT->setDataType(DataType::Float);
+
+    // The rotary tables are contiguous [seq, head_dim] when unspecified.
+    for (const std::shared_ptr<TensorAttr> &ropeT :
+         {sdpaAttr.getROPE_COS(), sdpaAttr.getROPE_SIN()}) {
+      if (!ropeT || !ropeT->getStride().empty())
+        continue;
+      const std::vector<int64_t> &ropeDim = ropeT->getDim();
+      ropeT->setStride(generateStrideFromDim(
+          ropeDim, getContiguousStrideOrder(ropeDim.size())));
+    }
+
+    // The dropout seed and offset are single int64 values.
+    for (const std::shared_ptr<TensorAttr> &rngT :
+         {sdpaAttr.getDROPOUT_SEED(), sdpaAttr.getDROPOUT_OFFSET()}) {
+      if (!rngT)
+        continue;
+      if (rngT->getDataType() == DataType::NotSet)
+        rngT->setDataType(DataType::Int64);
+      if (rngT->getDim().empty())
+        rngT->setDim({1});
+      if (rngT->getStride().empty())
+        rngT->setStride({1});
+    }
+
     sdpaAttr.fillFromContext(context);
 
-    std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
-    std::shared_ptr<TensorAttr> vT = sdpaAttr.getV();
     std::shared_ptr<TensorAttr> oT = sdpaAttr.getO();
 
-    const std::vector<int64_t> &qDim = qT->getDim();
-    const std::vector<int64_t> &vDim = vT->getDim();
-
-    // Output O shape: [batch, headsQ, seqQ, headDim]
+    // Output O shape: [batch, headsQ, seqQ, headDim], or
+    // [total_q, headsQ, headDim] when packed varlen.
     // headDim comes from V's last dimension.
-    std::vector<int64_t> oDim = {qDim[0], qDim[1], qDim[2], vDim[3]};
+    std::vector<int64_t> oDim = getExpectedOutputDim();
 
     if (oT->getDim().empty())
       oT->setDim(oDim);
@@ -209,6 +402,15 @@ public:
           generateStrideFromDim(oDim, getContiguousStrideOrder(oDim.size())));
     }
 
+    if (statsT) {
+      std::vector<int64_t> statsDim = getExpectedStatsDim();
+      if (statsT->getDim().empty())
+        statsT->setDim(statsDim);
+      if (statsT->getStride().empty())
+        statsT->setStride(generateStrideFromDim(
+            statsDim, getContiguousStrideOrder(statsDim.size())));
+    }
+
     return ok();
   }
 
@@ -216,20 +418,331 @@ public:
     FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating SdpaNode '"
                            << sdpaAttr.getName() << "'");
 
-    std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
-    std::shared_ptr<TensorAttr> vT = sdpaAttr.getV();
     std::shared_ptr<TensorAttr> oT = sdpaAttr.getO();
+    std::shared_ptr<TensorAttr> pageTableT = sdpaAttr.getPAGE_TABLE();
+
+    if (sdpaAttr.isVarlen()) {
+      FUSILLI_RETURN_ERROR_IF(
+          oT->getDim() != getExpectedOutputDim(), ErrorCode::InvalidAttribute,
+          "SDPA varlen output tensor O dimensions do not match expected "
+          "shape [total_q, headsQ, headDim]");
+      FUSILLI_RETURN_ERROR_IF(
+          !isIntegerType(sdpaAttr.getCU_SEQLENS_Q()->getDataType()) ||
+              !isIntegerType(sdpaAttr.getCU_SEQLENS_KV()->getDataType()),
+          ErrorCode::InvalidAttribute,
+          "SDPA CU_SEQLENS_Q and CU_SEQLENS_KV must have an integer data type");
+    } else {
+      // Expected output shape: [batch, headsQ, seqQ, headDim]
+      FUSILLI_RETURN_ERROR_IF(
+          oT->getDim() != getExpectedOutputDim(), ErrorCode::InvalidAttribute,
+          "SDPA output tensor O dimensions do not match expected shape "
+          "[batch, headsQ, seqQ, headDim]");
+    }
+
+    FUSILLI_RETURN_ERROR_IF(
+        pageTableT && !isIntegerType(pageTableT->getDataType()),
+        ErrorCode::InvalidAttribute,
+        "SDPA page table PAGE_TABLE must have an integer data type");
+
+    for (const std::shared_ptr<TensorAttr> &rngT :
+         {sdpaAttr.getDROPOUT_SEED(), sdpaAttr.getDROPOUT_OFFSET()}) {
+      FUSILLI_RETURN_ERROR_IF(
+          rngT && (rngT->getDim() != std::vector<int64_t>{1} ||
+                   rngT->getDataType() != DataType::Int64),
+          ErrorCode::InvalidAttribute,
+          "SDPA DROPOUT_SEED and DROPOUT_OFFSET must be [1] tensors of data "
+          "type Int64");
+    }
+
+    DataType qType = sdpaAttr.getQ()->getDataType();
+    for (const std::shared_ptr<TensorAttr> &ropeT :
+         {sdpaAttr.getROPE_COS(), sdpaAttr.getROPE_SIN()})
+      FUSILLI_RETURN_ERROR_IF(
+          ropeT && ropeT->getDataType() != qType, ErrorCode::InvalidAttribute,
+          "SDPA rotary tables ROPE_COS and ROPE_SIN must have the data type "
+          "of Q");
+
+    if (std::shared_ptr<TensorAttr> statsT = sdpaAttr.getSTATS()) {
+      FUSILLI_RETURN_ERROR_IF(
+          statsT->getDim() != getExpectedStatsDim(),
+          ErrorCode::InvalidAttribute,
+          "SDPA stats tensor STATS dimensions do not match expected shape "
+          "[batch, headsQ, seqQ, 1]");
+      FUSILLI_RETURN_ERROR_IF(
+          statsT->getDataType() != DataType::Float, ErrorCode::InvalidAttribute,
+          "SDPA stats tensor STATS must have data type Float");
+    }
+
+    return ok();
+  }
+
+private:
+  // Checks of the rotary embedding: both [seq, head_dim] tables, applied to
+  // Q and K at the same positions, on plain rank-4 attention. The STATS
+  // output is excluded since `SdpaBwdNode` recomputes the scores from the
+  // unrotated Q and K.
+  ErrorObject preValidateRope() const {
+    std::shared_ptr<TensorAttr> cosT = sdpaAttr.getROPE_COS();
+    std::shared_ptr<TensorAttr> sinT = sdpaAttr.getROPE_SIN();
+
+    FUSILLI_RETURN_ERROR_IF(
+        !cosT || !sinT, ErrorCode::AttributeNotSet,
+        "SDPA rotary embedding requires both ROPE_COS and ROPE_SIN");
+    FUSILLI_RETURN_ERROR_IF(
+        sdpaAttr.isPaged() || sdpaAttr.isVarlen() || sdpaAttr.hasStats(),
+        ErrorCode::NotImplemented,
+        "SDPA rotary embedding is not supported with a paged KV cache, "
+        "varlen packing or the stats output STATS");
+
+    const std::vector<int64_t> &qDim = sdpaAttr.getQ()->getDim();
+    const std::vector<int64_t> &kDim = sdpaAttr.getK()->getDim();
+    FUSILLI_RETURN_ERROR_IF(
+        qDim[3] % 2 != 0, ErrorCode::InvalidAttribute,
+        "SDPA rotary embedding requires an even head_dim, got " +
+            std::to_string(qDim[3]));
+    FUSILLI_RETURN_ERROR_IF(
+        qDim[2] != kDim[2], ErrorCode::InvalidAttribute,
+        "SDPA rotary embedding requires Q and K to have the same sequence "
+        "length");
+    std::vector<int64_t> ropeDim = {qDim[2], qDim[3]};
+    FUSILLI_RETURN_ERROR_IF(
+        cosT->getDim() != ropeDim || sinT->getDim() != ropeDim,
+        ErrorCode::InvalidAttribute,
+        "SDPA rotary tables ROPE_COS and ROPE_SIN must have shape "
+        "[seq, head_dim]");
+
+    return ok();
+  }
+
+  // Checks specific to packed varlen mode: rank-3 Q/K/V, matching
+  // [batch + 1] cumulative sequence length tensors, and no explicit mask or
+  // paged cache (the node builds the block-diagonal mask itself).
+  ErrorObject preValidateVarlen() const {
+    std::shared_ptr<TensorAttr> cuQT = sdpaAttr.getCU_SEQLENS_Q();
+    std::shared_ptr<TensorAttr> cuKVT = sdpaAttr.getCU_SEQLENS_KV();
+
+    FUSILLI_RETURN_ERROR_IF(!cuQT || !cuKVT, ErrorCode::AttributeNotSet,
+                            "SDPA varlen mode requires both CU_SEQLENS_Q and "
+                            "CU_SEQLENS_KV");
+    FUSILLI_RETURN_ERROR_IF(
+        sdpaAttr.getMASK(), ErrorCode::InvalidAttribute,
+        "SDPA varlen mode does not take an explicit attention mask");
+    FUSILLI_RETURN_ERROR_IF(
+        sdpaAttr.isPaged(), ErrorCode::InvalidAttribute,
+        "SDPA varlen and paged KV-cache modes are mutually exclusive");
+
+    constexpr size_t kPackedRank = 3;
+    FUSILLI_RETURN_ERROR_IF(sdpaAttr.getQ()->getDim().size() != kPackedRank,
+                            ErrorCode::InvalidAttribute,
+                            "SDPA varlen input tensor Q must be rank 3 "
+                            "[total_q, heads_q, head_dim]");
+    FUSILLI_RETURN_ERROR_IF(sdpaAttr.getK()->getDim().size() != kPackedRank,
+                            ErrorCode::InvalidAttribute,
+                            "SDPA varlen input tensor K must be rank 3 "
+                            "[total_kv, heads_kv, head_dim]");
+    FUSILLI_RETURN_ERROR_IF(sdpaAttr.getV()->getDim().size() != kPackedRank,
+                            ErrorCode::InvalidAttribute,
+                            "SDPA varlen input tensor V must be rank 3 "
+                            "[total_kv, heads_kv, head_dim]");
+
+    const std::vector<int64_t> &cuQDim = cuQT->getDim();
+    const std::vector<int64_t> &cuKVDim = cuKVT->getDim();
+    FUSILLI_RETURN_ERROR_IF(
+        cuQDim.size() != 1 || cuKVDim.size() != 1 || cuQDim != cuKVDim ||
+            cuQDim[0] < 2,
+        ErrorCode::InvalidAttribute,
+        "SDPA CU_SEQLENS_Q and CU_SEQLENS_KV must both be rank 1 of the "
+        "same size [batch + 1]");
+
+    return ok();
+  }
+};
+
+// Backward of scaled dot-product attention. Computes DQ, DK and DV from the
+// forward inputs Q, K, V, its output O, the output gradient DO and the
+// per-row logsumexp STATS saved by the forward pass, so the attention
+// probabilities are recomputed rather than saved between the passes.
+class SdpaBwdNode : public NodeCRTP<SdpaBwdNode> {
+public:
+  SdpaBwdAttr sdpaBwdAttr;
+
+  SdpaBwdNode(SdpaBwdAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), sdpaBwdAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  const std::string &getName() const override final {
+    return sdpaBwdAttr.getName();
+  }
+  Type getType() const override final { return Type::SdpaBwd; }
+
+  // Five products per key attended to: recomputing QK^T, then dV, dP, dQ
+  // and dK, i.e. two operations per key and element of Q (thrice) and of O
+  // (twice), halved by causal masking.
+  double estimateFlops() const override final {
+    double seqKv = static_cast<double>(sdpaBwdAttr.getK()->getDim()[2]);
+    double flops =
+        2.0 * seqKv *
+        static_cast<double>(3 * sdpaBwdAttr.getQ()->getVolume() +
+                            2 * sdpaBwdAttr.getO()->getVolume());
+    return sdpaBwdAttr.getIsCausal() ? flops / 2 : flops;
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    sdpaBwdAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    sdpaBwdAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    sdpaBwdAttr.replaceOutput(from, to);
+  }
+
+  void archiveNode(Archive &ar) override final { sdpaBwdAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    sdpaBwdAttr.hashTensors(fp);
+    std::optional<float> scale = sdpaBwdAttr.getScale();
+    fp.update(sdpaBwdAttr.getIsCausal())
+        .update(scale.has_value())
+        .update(scale.value_or(0.0f));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating SdpaBwdNode '"
+                           << sdpaBwdAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> qT = sdpaBwdAttr.getQ();
+    std::shared_ptr<TensorAttr> kT = sdpaBwdAttr.getK();
+    std::shared_ptr<TensorAttr> vT = sdpaBwdAttr.getV();
+    std::shared_ptr<TensorAttr> oT = sdpaBwdAttr.getO();
+    std::shared_ptr<TensorAttr> doT = sdpaBwdAttr.getDO();
+    std::shared_ptr<TensorAttr> statsT = sdpaBwdAttr.getSTATS();
+
+    // Ensure mandatory input and output tensors are set.
+    FUSILLI_RETURN_ERROR_IF(!qT, ErrorCode::AttributeNotSet,
+                            "SDPA backward input tensor Q not set");
+    FUSILLI_RETURN_ERROR_IF(!kT, ErrorCode::AttributeNotSet,
+                            "SDPA backward input tensor K not set");
+    FUSILLI_RETURN_ERROR_IF(!vT, ErrorCode::AttributeNotSet,
+                            "SDPA backward input tensor V not set");
+    FUSILLI_RETURN_ERROR_IF(!oT, ErrorCode::AttributeNotSet,
+                            "SDPA backward input tensor O not set");
+    FUSILLI_RETURN_ERROR_IF(!doT, ErrorCode::AttributeNotSet,
+                            "SDPA backward gradient tensor DO not set");
+    FUSILLI_RETURN_ERROR_IF(!statsT, ErrorCode::AttributeNotSet,
+                            "SDPA backward stats tensor STATS not set");
+    FUSILLI_RETURN_ERROR_IF(!sdpaBwdAttr.getDQ() || !sdpaBwdAttr.getDK() ||
+                                !sdpaBwdAttr.getDV(),
+                            ErrorCode::AttributeNotSet,
+                            "SDPA backward output tensors DQ, DK, DV not set");
+
+    // Rank checks: all inputs must be rank 4.
+    constexpr size_t kRequiredRank = 4;
+    for (const std::shared_ptr<TensorAttr> &t : {qT, kT, vT, oT, doT, statsT})
+      FUSILLI_RETURN_ERROR_IF(t->getDim().size() != kRequiredRank,
+                              ErrorCode::InvalidAttribute,
+                              "SDPA backward input tensor '" + t->getName() +
+                                  "' must be rank 4");
 
     const std::vector<int64_t> &qDim = qT->getDim();
+    const std::vector<int64_t> &kDim = kT->getDim();
     const std::vector<int64_t> &vDim = vT->getDim();
 
-    // Expected output shape: [batch, headsQ, seqQ, headDim]
-    std::vector<int64_t> expectedDim = {qDim[0], qDim[1], qDim[2], vDim[3]};
+    FUSILLI_RETURN_ERROR_IF(
+        qDim[0] != kDim[0] || qDim[0] != vDim[0], ErrorCode::InvalidAttribute,
+        "SDPA backward input tensors Q, K, V must have matching batch "
+        "dimension");
+    FUSILLI_RETURN_ERROR_IF(
+        qDim[1] != kDim[1] || qDim[1] != vDim[1], ErrorCode::InvalidAttribute,
+        "SDPA backward requires Q, K and V to have the same number of heads");
+    FUSILLI_RETURN_ERROR_IF(
+        qDim[3] != kDim[3], ErrorCode::InvalidAttribute,
+        "SDPA backward input tensors Q and K must have matching head_dim");
+    FUSILLI_RETURN_ERROR_IF(
+        kDim[2] != vDim[2], ErrorCode::InvalidAttribute,
+        "SDPA backward input tensors K and V must have matching sequence "
+        "length");
+
+    // O and DO: [batch, heads, seq_q, head_dim_v]; STATS: [.., seq_q, 1].
+    std::vector<int64_t> expectedODim = {qDim[0], qDim[1], qDim[2], vDim[3]};
+    FUSILLI_RETURN_ERROR_IF(oT->getDim() != expectedODim ||
+                                doT->getDim() != expectedODim,
+                            ErrorCode::InvalidAttribute,
+                            "SDPA backward tensors O and DO must have shape "
+                            "[batch, heads, seqQ, headDimV]");
+    FUSILLI_RETURN_ERROR_IF(
+        statsT->getDim() !=
+            std::vector<int64_t>({qDim[0], qDim[1], qDim[2], 1}),
+        ErrorCode::InvalidAttribute,
+        "SDPA backward stats tensor STATS must have shape "
+        "[batch, heads, seqQ, 1]");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for SdpaBwdNode '"
+                           << sdpaBwdAttr.getName() << "'");
+
+    // STATS is saved in Float by the forward pass, not in the IO data type.
+    std::shared_ptr<TensorAttr> statsT = sdpaBwdAttr.getSTATS();
+    if (statsT->getDataType() == DataType::NotSet)
+      statsT->setDataType(DataType::Float);
+
+    sdpaBwdAttr.fillFromContext(context);
+
+    // Each gradient takes the shape of the tensor it is the gradient of,
+    // with a contiguous stride when unspecified.
+    auto inferGrad = [](const std::shared_ptr<TensorAttr> &gradT,
+                        const std::shared_ptr<TensorAttr> &t) {
+      const std::vector<int64_t> &dim = t->getDim();
+      if (gradT->getDim().empty())
+        gradT->setDim(dim);
+      if (gradT->getStride().empty())
+        gradT->setStride(
+            generateStrideFromDim(dim, getContiguousStrideOrder(dim.size())));
+    };
+    inferGrad(sdpaBwdAttr.getDQ(), sdpaBwdAttr.getQ());
+    inferGrad(sdpaBwdAttr.getDK(), sdpaBwdAttr.getK());
+    inferGrad(sdpaBwdAttr.getDV(), sdpaBwdAttr.getV());
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating SdpaBwdNode '"
+                           << sdpaBwdAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> qT = sdpaBwdAttr.getQ();
+    DataType dtype = qT->getDataType();
+
+    FUSILLI_RETURN_ERROR_IF(
+        sdpaBwdAttr.getDQ()->getDim() != qT->getDim() ||
+            sdpaBwdAttr.getDK()->getDim() != sdpaBwdAttr.getK()->getDim() ||
+            sdpaBwdAttr.getDV()->getDim() != sdpaBwdAttr.getV()->getDim(),
+        ErrorCode::InvalidAttribute,
+        "SDPA backward gradients DQ, DK, DV must match the shapes of Q, K, V");
+
+    // The matmuls of the backward pass run in the element type of Q.
+    for (const std::shared_ptr<TensorAttr> &t :
+         {sdpaBwdAttr.getK(), sdpaBwdAttr.getV(), sdpaBwdAttr.getO(),
+          sdpaBwdAttr.getDO(), sdpaBwdAttr.getDQ(), sdpaBwdAttr.getDK(),
+          sdpaBwdAttr.getDV()})
+      FUSILLI_RETURN_ERROR_IF(t->getDataType() != dtype,
+                              ErrorCode::InvalidAttribute,
+                              "SDPA backward tensor '" + t->getName() +
+                                  "' must have the data type of Q");
 
     FUSILLI_RETURN_ERROR_IF(
-        oT->getDim() != expectedDim, ErrorCode::InvalidAttribute,
-        "SDPA output tensor O dimensions do not match expected shape "
-        "[batch, headsQ, seqQ, headDim]");
+        sdpaBwdAttr.getSTATS()->getDataType() != DataType::Float,
+        ErrorCode::InvalidAttribute,
+        "SDPA backward stats tensor STATS must have data type Float");
 
     return ok();
   }
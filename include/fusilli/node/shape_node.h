@@ -0,0 +1,1079 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the shape manipulation nodes
+// `ReshapeNode`, `PermuteNode`, `SliceNode`, `ConcatNode`,
+// `SliceUpdateNode`, `IndexSelectNode` and `IndexAddNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_SHAPE_NODE_H
+#define FUSILLI_NODE_SHAPE_NODE_H
+
+#include "fusilli/attributes/shape_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+//===----------------------------------------------------------------------===//
+// Helper functions for shape manipulation nodes.
+//===----------------------------------------------------------------------===//
+
+// Number of elements of a tensor with (static) logical dims `dim`.
+inline int64_t getNumElements(const std::vector<int64_t> &dim) {
+  return std::accumulate(dim.begin(), dim.end(), int64_t{1},
+                         std::multiplies<>());
+}
+
+// Sets contiguous strides on `yT` when unspecified. The shape nodes compute
+// in logical dim order, so that is the layout their outputs default to.
+inline void inferContiguousStride(const std::shared_ptr<TensorAttr> &yT) {
+  if (yT->getStride().empty())
+    yT->setStride(generateStrideFromDim(
+        yT->getDim(), getContiguousStrideOrder(yT->getDim().size())));
+}
+
+// Sets the data type of `yT` to that of `xT` when unspecified. The shape
+// nodes move data without converting it.
+inline void inferDataTypeFromInput(const std::shared_ptr<TensorAttr> &xT,
+                                   const std::shared_ptr<TensorAttr> &yT) {
+  if (yT->getDataType() == DataType::NotSet)
+    yT->setDataType(xT->getDataType());
+}
+
+// Returns `dim` with the entry at `axis` replaced by the entries of
+// `indexDim`: the dims of gathering along `axis` by an index of dims
+// `indexDim`.
+inline std::vector<int64_t>
+replaceAxisDims(const std::vector<int64_t> &dim, size_t axis,
+                const std::vector<int64_t> &indexDim) {
+  std::vector<int64_t> result(dim.begin(), dim.begin() + axis);
+  result.insert(result.end(), indexDim.begin(), indexDim.end());
+  result.insert(result.end(), dim.begin() + axis + 1, dim.end());
+  return result;
+}
+
+//===----------------------------------------------------------------------===//
+// Shape manipulation nodes.
+//
+// The nodes are emitted as torch view ops (`torch.aten.view`, `permute`,
+// `slice.Tensor` and `cat`) on logical tensors, which the compiler folds
+// into the producing and consuming dispatches rather than materializing
+// them as copies. Their outputs are contiguous unless specified otherwise.
+//===----------------------------------------------------------------------===//
+
+class ReshapeNode : public NodeCRTP<ReshapeNode> {
+public:
+  ReshapeAttr reshapeAttr;
+
+  ReshapeNode(ReshapeAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), reshapeAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  // Returns the shape with its -1 entry (if any) inferred from the element
+  // count of X.
+  std::vector<int64_t> getInferredShape() const {
+    std::vector<int64_t> shape = reshapeAttr.getShape();
+    auto inferred = std::ranges::find(shape, -1);
+    if (inferred != shape.end()) {
+      *inferred = 1;
+      *inferred = getNumElements(reshapeAttr.getX()->getDim()) /
+                  getNumElements(shape);
+    }
+    return shape;
+  }
+
+  const std::string &getName() const override final {
+    return reshapeAttr.getName();
+  }
+  Type getType() const override final { return Type::Reshape; }
+
+  // Only moves data.
+  double estimateFlops() const override final { return 0; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    reshapeAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    reshapeAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    reshapeAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { reshapeAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    reshapeAttr.hashTensors(fp);
+    fp.update(reshapeAttr.getShape());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ReshapeNode '"
+                           << reshapeAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = reshapeAttr.getX();
+    std::shared_ptr<TensorAttr> yT = reshapeAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Reshape input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!yT, ErrorCode::AttributeNotSet,
+                            "Reshape output tensor Y not set");
+    FUSILLI_RETURN_ERROR_IF(xT->getDim().empty(), ErrorCode::AttributeNotSet,
+                            "Reshape input tensor X dimensions not set");
+    FUSILLI_RETURN_ERROR_IF(
+        reshapeAttr.getShape().empty() && yT->getDim().empty(),
+        ErrorCode::AttributeNotSet,
+        "Reshape shape not set and output tensor Y dimensions not set");
+    FUSILLI_RETURN_ERROR_IF(
+        xT->hasDynamicDims() || yT->hasDynamicDims(), ErrorCode::NotImplemented,
+        "Reshape of tensors with dynamic dimensions is not supported");
+
+    const std::vector<int64_t> &shape = reshapeAttr.getShape();
+    FUSILLI_RETURN_ERROR_IF(std::ranges::count(shape, -1) > 1,
+                            ErrorCode::InvalidAttribute,
+                            "Reshape shape can have at most one -1 entry");
+    FUSILLI_RETURN_ERROR_IF(
+        std::ranges::any_of(shape, [](int64_t d) { return d == 0 || d < -1; }),
+        ErrorCode::InvalidAttribute,
+        "Reshape shape entries must be positive or -1");
+
+    int64_t numElements = getNumElements(xT->getDim());
+    int64_t knownElements = -getNumElements(shape);
+    FUSILLI_RETURN_ERROR_IF(
+        !shape.empty() &&
+            (std::ranges::count(shape, -1) == 1
+                 ? numElements % knownElements != 0
+                 : numElements != getNumElements(shape)),
+        ErrorCode::InvalidAttribute,
+        "Reshape shape is incompatible with the number of elements of input "
+        "tensor X");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for ReshapeNode '"
+                           << reshapeAttr.getName() << "'");
+
+    inferDataTypeFromInput(reshapeAttr.getX(), reshapeAttr.getY());
+    reshapeAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> yT = reshapeAttr.getY();
+    if (yT->getDim().empty())
+      yT->setDim(getInferredShape());
+    inferContiguousStride(yT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating ReshapeNode '"
+                           << reshapeAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = reshapeAttr.getX();
+    std::shared_ptr<TensorAttr> yT = reshapeAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        getNumElements(yT->getDim()) != getNumElements(xT->getDim()),
+        ErrorCode::InvalidAttribute,
+        "Reshape output tensor Y must have the number of elements of input "
+        "tensor X");
+    FUSILLI_RETURN_ERROR_IF(
+        !reshapeAttr.getShape().empty() && yT->getDim() != getInferredShape(),
+        ErrorCode::InvalidAttribute,
+        "Reshape output tensor Y dimensions do not match the shape");
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDataType() != xT->getDataType(), ErrorCode::InvalidAttribute,
+        "Reshape output tensor Y must have the data type of input tensor X");
+
+    return ok();
+  }
+};
+
+class PermuteNode : public NodeCRTP<PermuteNode> {
+public:
+  PermuteAttr permuteAttr;
+
+  PermuteNode(PermuteAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), permuteAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  // Returns the logical dims of X in the permuted order.
+  std::vector<int64_t> getPermutedDim() const {
+    const std::vector<int64_t> &xDim = permuteAttr.getX()->getDim();
+    std::vector<int64_t> yDim;
+    yDim.reserve(xDim.size());
+    for (int64_t d : permuteAttr.getOrder())
+      yDim.push_back(xDim[d]);
+    return yDim;
+  }
+
+  const std::string &getName() const override final {
+    return permuteAttr.getName();
+  }
+  Type getType() const override final { return Type::Permute; }
+
+  // Only moves data.
+  double estimateFlops() const override final { return 0; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    permuteAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    permuteAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    permuteAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { permuteAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    permuteAttr.hashTensors(fp);
+    fp.update(permuteAttr.getOrder());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating PermuteNode '"
+                           << permuteAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = permuteAttr.getX();
+    std::shared_ptr<TensorAttr> yT = permuteAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Permute input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!yT, ErrorCode::AttributeNotSet,
+                            "Permute output tensor Y not set");
+
+    // The order must be a permutation of the logical dims of X.
+    std::vector<int64_t> order = permuteAttr.getOrder();
+    std::ranges::sort(order);
+    std::vector<int64_t> expected(xT->getDim().size());
+    std::iota(expected.begin(), expected.end(), 0);
+    FUSILLI_RETURN_ERROR_IF(
+        order != expected, ErrorCode::InvalidAttribute,
+        "Permute order must be a permutation of the dimensions of input "
+        "tensor X");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for PermuteNode '"
+                           << permuteAttr.getName() << "'");
+
+    inferDataTypeFromInput(permuteAttr.getX(), permuteAttr.getY());
+    permuteAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> yT = permuteAttr.getY();
+    if (yT->getDim().empty())
+      yT->setDim(getPermutedDim());
+    inferContiguousStride(yT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating PermuteNode '"
+                           << permuteAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = permuteAttr.getX();
+    std::shared_ptr<TensorAttr> yT = permuteAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != getPermutedDim(), ErrorCode::InvalidAttribute,
+        "Permute output tensor Y dimensions do not match the permuted "
+        "dimensions of input tensor X");
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDataType() != xT->getDataType(), ErrorCode::InvalidAttribute,
+        "Permute output tensor Y must have the data type of input tensor X");
+
+    return ok();
+  }
+};
+
+class SliceNode : public NodeCRTP<SliceNode> {
+public:
+  SliceAttr sliceAttr;
+
+  SliceNode(SliceAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), sliceAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  // Returns the step, all 1s when not set.
+  std::vector<int64_t> getStep() const {
+    const std::vector<int64_t> &step = sliceAttr.getStep();
+    if (!step.empty())
+      return step;
+    return std::vector<int64_t>(sliceAttr.getStart().size(), 1);
+  }
+
+  // Returns the logical dims of the slice.
+  std::vector<int64_t> getSlicedDim() const {
+    const std::vector<int64_t> &start = sliceAttr.getStart();
+    const std::vector<int64_t> &end = sliceAttr.getEnd();
+    std::vector<int64_t> step = getStep();
+    std::vector<int64_t> yDim(start.size());
+    for (size_t i = 0; i < yDim.size(); ++i)
+      yDim[i] = (end[i] - start[i] + step[i] - 1) / step[i];
+    return yDim;
+  }
+
+  const std::string &getName() const override final {
+    return sliceAttr.getName();
+  }
+  Type getType() const override final { return Type::Slice; }
+
+  // Only moves data.
+  double estimateFlops() const override final { return 0; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    sliceAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    sliceAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    sliceAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { sliceAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    sliceAttr.hashTensors(fp);
+    fp.update(sliceAttr.getStart())
+        .update(sliceAttr.getEnd())
+        .update(getStep());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating SliceNode '"
+                           << sliceAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = sliceAttr.getX();
+    std::shared_ptr<TensorAttr> yT = sliceAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Slice input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!yT, ErrorCode::AttributeNotSet,
+                            "Slice output tensor Y not set");
+
+    const std::vector<int64_t> &xDim = xT->getDim();
+    const std::vector<int64_t> &start = sliceAttr.getStart();
+    const std::vector<int64_t> &end = sliceAttr.getEnd();
+    std::vector<int64_t> step = getStep();
+    FUSILLI_RETURN_ERROR_IF(
+        start.size() != xDim.size() || end.size() != xDim.size() ||
+            step.size() != xDim.size(),
+        ErrorCode::InvalidAttribute,
+        "Slice start, end and step sizes must match the rank of input "
+        "tensor X");
+
+    for (size_t i = 0; i < xDim.size(); ++i) {
+      FUSILLI_RETURN_ERROR_IF(
+          start[i] < 0 || start[i] >= end[i] || end[i] > xDim[i] ||
+              step[i] <= 0,
+          ErrorCode::InvalidAttribute,
+          "Slice of dim " + std::to_string(i) +
+              " must satisfy 0 <= start < end <= " + std::to_string(xDim[i]) +
+              " and step > 0");
+      FUSILLI_RETURN_ERROR_IF(
+          xT->isDynamicDim(i) && (start[i] != 0 || end[i] != xDim[i] ||
+                                  step[i] != 1),
+          ErrorCode::NotImplemented,
+          "Slice of dynamic dim " + std::to_string(i) + " is not supported");
+    }
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for SliceNode '"
+                           << sliceAttr.getName() << "'");
+
+    inferDataTypeFromInput(sliceAttr.getX(), sliceAttr.getY());
+    sliceAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> yT = sliceAttr.getY();
+    if (yT->getDim().empty())
+      yT->setDim(getSlicedDim());
+    inferContiguousStride(yT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating SliceNode '"
+                           << sliceAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = sliceAttr.getX();
+    std::shared_ptr<TensorAttr> yT = sliceAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != getSlicedDim(), ErrorCode::InvalidAttribute,
+        "Slice output tensor Y dimensions do not match the slice");
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDataType() != xT->getDataType(), ErrorCode::InvalidAttribute,
+        "Slice output tensor Y must have the data type of input tensor X");
+
+    return ok();
+  }
+};
+
+class ConcatNode : public NodeCRTP<ConcatNode> {
+public:
+  ConcatAttr concatAttr;
+
+  ConcatNode(ConcatAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), concatAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  // Returns the concat axis as a non-negative logical dimension index.
+  int64_t getNormalizedAxis() const {
+    int64_t axis = concatAttr.getAxis();
+    int64_t rank = static_cast<int64_t>(concatAttr.getX()[0]->getDim().size());
+    return axis < 0 ? axis + rank : axis;
+  }
+
+  // Returns the logical dims of the concatenation of the inputs.
+  std::vector<int64_t> getConcatDim() const {
+    std::vector<std::shared_ptr<TensorAttr>> xs = concatAttr.getX();
+    size_t axis = static_cast<size_t>(getNormalizedAxis());
+    std::vector<int64_t> yDim = xs[0]->getDim();
+    for (size_t i = 1; i < xs.size(); ++i)
+      yDim[axis] += xs[i]->getDim()[axis];
+    return yDim;
+  }
+
+  const std::string &getName() const override final {
+    return concatAttr.getName();
+  }
+  Type getType() const override final { return Type::Concat; }
+
+  // Only moves data.
+  double estimateFlops() const override final { return 0; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    concatAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    concatAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    concatAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { concatAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    concatAttr.hashTensors(fp);
+    fp.update(concatAttr.getAxis());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating ConcatNode '"
+                           << concatAttr.getName() << "'");
+
+    std::vector<std::shared_ptr<TensorAttr>> xs = concatAttr.getX();
+    FUSILLI_RETURN_ERROR_IF(xs.empty(), ErrorCode::AttributeNotSet,
+                            "Concat input tensors X not set");
+    for (size_t i = 0; i < xs.size(); ++i)
+      FUSILLI_RETURN_ERROR_IF(!xs[i], ErrorCode::AttributeNotSet,
+                              "Concat input tensor " + std::to_string(i) +
+                                  " is null");
+    FUSILLI_RETURN_ERROR_IF(!concatAttr.getY(), ErrorCode::AttributeNotSet,
+                            "Concat output tensor Y not set");
+
+    const std::vector<int64_t> &firstDim = xs[0]->getDim();
+    int64_t rank = static_cast<int64_t>(firstDim.size());
+    int64_t axis = concatAttr.getAxis();
+    FUSILLI_RETURN_ERROR_IF(axis < -rank || axis >= rank,
+                            ErrorCode::InvalidAttribute,
+                            "Concat axis " + std::to_string(axis) +
+                                " is out of range for input tensors of rank " +
+                                std::to_string(rank));
+
+    // All inputs match outside of the concat axis.
+    size_t normalizedAxis = static_cast<size_t>(getNormalizedAxis());
+    for (size_t i = 1; i < xs.size(); ++i) {
+      std::vector<int64_t> dim = xs[i]->getDim();
+      FUSILLI_RETURN_ERROR_IF(
+          dim.size() != firstDim.size(), ErrorCode::InvalidAttribute,
+          "Concat input tensors must have the same rank");
+      dim[normalizedAxis] = firstDim[normalizedAxis];
+      FUSILLI_RETURN_ERROR_IF(
+          dim != firstDim, ErrorCode::InvalidAttribute,
+          "Concat input tensor " + std::to_string(i) +
+              " dimensions do not match input tensor 0 outside of the axis");
+    }
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for ConcatNode '"
+                           << concatAttr.getName() << "'");
+
+    inferDataTypeFromInput(concatAttr.getX()[0], concatAttr.getY());
+    concatAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> yT = concatAttr.getY();
+    if (yT->getDim().empty())
+      yT->setDim(getConcatDim());
+    inferContiguousStride(yT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating ConcatNode '"
+                           << concatAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> yT = concatAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != getConcatDim(), ErrorCode::InvalidAttribute,
+        "Concat output tensor Y dimensions do not match the concatenation of "
+        "the input tensors");
+    for (const std::shared_ptr<TensorAttr> &xT : concatAttr.getX())
+      FUSILLI_RETURN_ERROR_IF(
+          xT->getDataType() != yT->getDataType(), ErrorCode::InvalidAttribute,
+          "Concat input tensors must have the data type of output tensor Y");
+
+    return ok();
+  }
+};
+
+// Writes UPDATE into X along the axis, at the offset held by the runtime
+// [1] int64 tensor START: Y is X with
+// Y[..., start:start + update_len, ...] = UPDATE. START is read at execution,
+// so one compiled graph serves every offset (e.g. each decode step appending
+// the new K or V to a KV cache). Out of range offsets are clamped at runtime
+// to [0, axis dim of X - update_len], so UPDATE is always written within X:
+// negative offsets write at the start of the axis, and offsets past the end
+// write at its end.
+//
+// When Y is declared in-place on a graph input X (see
+// `TensorAttr::setInPlace()`), UPDATE is written into the buffer of X
+// directly and the rest of X is neither read nor copied.
+class SliceUpdateNode : public NodeCRTP<SliceUpdateNode> {
+public:
+  SliceUpdateAttr sliceUpdateAttr;
+
+  SliceUpdateNode(SliceUpdateAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), sliceUpdateAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  // Returns the axis as a non-negative logical dimension index.
+  int64_t getNormalizedAxis() const {
+    int64_t axis = sliceUpdateAttr.getAxis();
+    int64_t rank =
+        static_cast<int64_t>(sliceUpdateAttr.getX()->getDim().size());
+    return axis < 0 ? axis + rank : axis;
+  }
+
+  const std::string &getName() const override final {
+    return sliceUpdateAttr.getName();
+  }
+  Type getType() const override final { return Type::SliceUpdate; }
+
+  // Only moves data.
+  double estimateFlops() const override final { return 0; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    sliceUpdateAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    sliceUpdateAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    sliceUpdateAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { sliceUpdateAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    sliceUpdateAttr.hashTensors(fp);
+    fp.update(sliceUpdateAttr.getAxis());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating SliceUpdateNode '"
+                           << sliceUpdateAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = sliceUpdateAttr.getX();
+    std::shared_ptr<TensorAttr> updateT = sliceUpdateAttr.getUPDATE();
+
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Slice update input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!updateT, ErrorCode::AttributeNotSet,
+                            "Slice update input tensor UPDATE not set");
+    FUSILLI_RETURN_ERROR_IF(!sliceUpdateAttr.getSTART(),
+                            ErrorCode::AttributeNotSet,
+                            "Slice update input tensor START not set");
+    FUSILLI_RETURN_ERROR_IF(!sliceUpdateAttr.getY(),
+                            ErrorCode::AttributeNotSet,
+                            "Slice update output tensor Y not set");
+    FUSILLI_RETURN_ERROR_IF(
+        xT == updateT, ErrorCode::InvalidAttribute,
+        "Slice update input tensors X and UPDATE must be distinct");
+
+    const std::vector<int64_t> &xDim = xT->getDim();
+    const std::vector<int64_t> &updateDim = updateT->getDim();
+    int64_t rank = static_cast<int64_t>(xDim.size());
+    int64_t axis = sliceUpdateAttr.getAxis();
+    FUSILLI_RETURN_ERROR_IF(axis < -rank || axis >= rank,
+                            ErrorCode::InvalidAttribute,
+                            "Slice update axis " + std::to_string(axis) +
+                                " is out of range for input tensor X of rank " +
+                                std::to_string(rank));
+
+    // UPDATE matches X outside of the axis, and fits in it.
+    size_t normalizedAxis = static_cast<size_t>(getNormalizedAxis());
+    FUSILLI_RETURN_ERROR_IF(
+        updateDim.size() != xDim.size(), ErrorCode::InvalidAttribute,
+        "Slice update tensor UPDATE must have the rank of input tensor X");
+    std::vector<int64_t> dim = updateDim;
+    dim[normalizedAxis] = xDim[normalizedAxis];
+    FUSILLI_RETURN_ERROR_IF(
+        dim != xDim || updateDim[normalizedAxis] > xDim[normalizedAxis],
+        ErrorCode::InvalidAttribute,
+        "Slice update tensor UPDATE dimensions must match input tensor X "
+        "outside of the axis and fit in X along it");
+    FUSILLI_RETURN_ERROR_IF(
+        xT->isDynamicDim(normalizedAxis) ||
+            updateT->isDynamicDim(normalizedAxis),
+        ErrorCode::NotImplemented,
+        "Slice update along a dynamic dim is not supported");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for SliceUpdateNode '"
+                           << sliceUpdateAttr.getName() << "'");
+
+    // The offset is a single int64 value.
+    std::shared_ptr<TensorAttr> startT = sliceUpdateAttr.getSTART();
+    if (startT->getDataType() == DataType::NotSet)
+      startT->setDataType(DataType::Int64);
+    if (startT->getDim().empty())
+      startT->setDim({1});
+    if (startT->getStride().empty())
+      startT->setStride({1});
+
+    std::shared_ptr<TensorAttr> xT = sliceUpdateAttr.getX();
+    std::shared_ptr<TensorAttr> yT = sliceUpdateAttr.getY();
+    inferDataTypeFromInput(xT, yT);
+    sliceUpdateAttr.fillFromContext(context);
+
+    // Y takes the layout of X, so that it can be written in-place into X.
+    if (yT->getDim().empty())
+      yT->setDim(xT->getDim());
+    if (yT->getStride().empty())
+      yT->setStride(xT->getStride());
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating SliceUpdateNode '"
+                           << sliceUpdateAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = sliceUpdateAttr.getX();
+    std::shared_ptr<TensorAttr> yT = sliceUpdateAttr.getY();
+    std::shared_ptr<TensorAttr> startT = sliceUpdateAttr.getSTART();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != xT->getDim(), ErrorCode::InvalidAttribute,
+        "Slice update output tensor Y must have the dimensions of input "
+        "tensor X");
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDataType() != xT->getDataType() ||
+            sliceUpdateAttr.getUPDATE()->getDataType() != xT->getDataType(),
+        ErrorCode::InvalidAttribute,
+        "Slice update tensors UPDATE and Y must have the data type of input "
+        "tensor X");
+    FUSILLI_RETURN_ERROR_IF(
+        startT->getDim() != std::vector<int64_t>{1} ||
+            startT->getDataType() != DataType::Int64,
+        ErrorCode::InvalidAttribute,
+        "Slice update offset START must be a [1] tensor of data type Int64");
+
+    return ok();
+  }
+};
+
+// Gathers the slices of X at INDEX along the axis, as `torch.index_select`
+// extended to an INDEX of any rank: Y has the dims of X with the axis
+// replaced by the dims of INDEX. An embedding lookup of [batch, seq] token
+// ids in a [vocab, hidden] table thus yields [batch, seq, hidden]. Indices
+// are not bounds-checked.
+class IndexSelectNode : public NodeCRTP<IndexSelectNode> {
+public:
+  IndexSelectAttr indexSelectAttr;
+
+  IndexSelectNode(IndexSelectAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), indexSelectAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  // Returns the axis as a non-negative logical dimension index.
+  int64_t getNormalizedAxis() const {
+    int64_t axis = indexSelectAttr.getAxis();
+    int64_t rank =
+        static_cast<int64_t>(indexSelectAttr.getX()->getDim().size());
+    return axis < 0 ? axis + rank : axis;
+  }
+
+  // Returns the logical dims of the gathered slices.
+  std::vector<int64_t> getGatheredDim() const {
+    return replaceAxisDims(indexSelectAttr.getX()->getDim(),
+                           static_cast<size_t>(getNormalizedAxis()),
+                           indexSelectAttr.getINDEX()->getDim());
+  }
+
+  const std::string &getName() const override final {
+    return indexSelectAttr.getName();
+  }
+  Type getType() const override final { return Type::IndexSelect; }
+
+  // Only moves data.
+  double estimateFlops() const override final { return 0; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    indexSelectAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    indexSelectAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    indexSelectAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { indexSelectAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    indexSelectAttr.hashTensors(fp);
+    fp.update(indexSelectAttr.getAxis());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating IndexSelectNode '"
+                           << indexSelectAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = indexSelectAttr.getX();
+    std::shared_ptr<TensorAttr> indexT = indexSelectAttr.getINDEX();
+
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Index select input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!indexT, ErrorCode::AttributeNotSet,
+                            "Index select input tensor INDEX not set");
+    FUSILLI_RETURN_ERROR_IF(!indexSelectAttr.getY(),
+                            ErrorCode::AttributeNotSet,
+                            "Index select output tensor Y not set");
+
+    int64_t rank = static_cast<int64_t>(xT->getDim().size());
+    int64_t axis = indexSelectAttr.getAxis();
+    FUSILLI_RETURN_ERROR_IF(axis < -rank || axis >= rank,
+                            ErrorCode::InvalidAttribute,
+                            "Index select axis " + std::to_string(axis) +
+                                " is out of range for input tensor X of rank " +
+                                std::to_string(rank));
+    FUSILLI_RETURN_ERROR_IF(
+        indexT->getDim().empty(), ErrorCode::InvalidAttribute,
+        "Index select tensor INDEX must have rank at least 1");
+    FUSILLI_RETURN_ERROR_IF(
+        xT->hasDynamicDims() || indexT->hasDynamicDims(),
+        ErrorCode::NotImplemented,
+        "Index select with dynamic dims is not supported");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for IndexSelectNode '"
+                           << indexSelectAttr.getName() << "'");
+
+    // Indices are int64 unless set otherwise.
+    std::shared_ptr<TensorAttr> indexT = indexSelectAttr.getINDEX();
+    if (indexT->getDataType() == DataType::NotSet)
+      indexT->setDataType(DataType::Int64);
+
+    inferDataTypeFromInput(indexSelectAttr.getX(), indexSelectAttr.getY());
+    indexSelectAttr.fillFromContext(context);
+
+    std::shared_ptr<TensorAttr> yT = indexSelectAttr.getY();
+    if (yT->getDim().empty())
+      yT->setDim(getGatheredDim());
+    inferContiguousStride(yT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating IndexSelectNode '"
+                           << indexSelectAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = indexSelectAttr.getX();
+    std::shared_ptr<TensorAttr> yT = indexSelectAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != getGatheredDim(), ErrorCode::InvalidAttribute,
+        "Index select output tensor Y dimensions must be those of input "
+        "tensor X with the axis replaced by the dimensions of INDEX");
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDataType() != xT->getDataType(), ErrorCode::InvalidAttribute,
+        "Index select output tensor Y must have the data type of input "
+        "tensor X");
+    FUSILLI_RETURN_ERROR_IF(
+        !isIntegerType(indexSelectAttr.getINDEX()->getDataType()),
+        ErrorCode::InvalidAttribute,
+        "Index select tensor INDEX must have an integer data type");
+
+    return ok();
+  }
+};
+
+// Accumulates the slices of SOURCE into Y at INDEX along the axis, as
+// `torch.index_add` extended to an INDEX of any rank like `IndexSelectNode`,
+// of which it is the gradient. SOURCE has the dims of Y with the axis
+// replaced by the dims of INDEX, and the slices of repeated indices are
+// summed. Y starts from X when set, else from zeros of `getSize()` along the
+// axis. The accumulation is in f32.
+class IndexAddNode : public NodeCRTP<IndexAddNode> {
+public:
+  IndexAddAttr indexAddAttr;
+
+  IndexAddNode(IndexAddAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), indexAddAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+
+  // Returns the rank of Y.
+  int64_t getRank() const {
+    if (std::shared_ptr<TensorAttr> xT = indexAddAttr.getX())
+      return static_cast<int64_t>(xT->getDim().size());
+    return static_cast<int64_t>(indexAddAttr.getSOURCE()->getDim().size() -
+                                indexAddAttr.getINDEX()->getDim().size()) +
+           1;
+  }
+
+  // Returns the axis as a non-negative logical dimension index.
+  int64_t getNormalizedAxis() const {
+    int64_t axis = indexAddAttr.getAxis();
+    return axis < 0 ? axis + getRank() : axis;
+  }
+
+  // Returns the logical dims of Y: those of X when set, else those of
+  // SOURCE with the dims of INDEX replaced by the size.
+  std::vector<int64_t> getOutputDim() const {
+    if (std::shared_ptr<TensorAttr> xT = indexAddAttr.getX())
+      return xT->getDim();
+    const std::vector<int64_t> &sourceDim = indexAddAttr.getSOURCE()->getDim();
+    size_t axis = static_cast<size_t>(getNormalizedAxis());
+    size_t indexRank = indexAddAttr.getINDEX()->getDim().size();
+    std::vector<int64_t> yDim(sourceDim.begin(), sourceDim.begin() + axis);
+    yDim.push_back(indexAddAttr.getSize());
+    yDim.insert(yDim.end(), sourceDim.begin() + axis + indexRank,
+                sourceDim.end());
+    return yDim;
+  }
+
+  const std::string &getName() const override final {
+    return indexAddAttr.getName();
+  }
+  Type getType() const override final { return Type::IndexAdd; }
+
+  // One addition per element of SOURCE.
+  double estimateFlops() const override final {
+    return static_cast<double>(indexAddAttr.getSOURCE()->getVolume());
+  }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    indexAddAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    indexAddAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    indexAddAttr.replaceOutput(from, to);
+  }
+  bool isLayoutAgnostic() const override final { return true; }
+
+  void archiveNode(Archive &ar) override final { indexAddAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    indexAddAttr.hashTensors(fp);
+    fp.update(indexAddAttr.getAxis()).update(indexAddAttr.getSize());
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating IndexAddNode '"
+                           << indexAddAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = indexAddAttr.getX();
+    std::shared_ptr<TensorAttr> indexT = indexAddAttr.getINDEX();
+    std::shared_ptr<TensorAttr> sourceT = indexAddAttr.getSOURCE();
+
+    FUSILLI_RETURN_ERROR_IF(!indexT, ErrorCode::AttributeNotSet,
+                            "Index add input tensor INDEX not set");
+    FUSILLI_RETURN_ERROR_IF(!sourceT, ErrorCode::AttributeNotSet,
+                            "Index add input tensor SOURCE not set");
+    FUSILLI_RETURN_ERROR_IF(!indexAddAttr.getY(), ErrorCode::AttributeNotSet,
+                            "Index add output tensor Y not set");
+    FUSILLI_RETURN_ERROR_IF(
+        !xT && indexAddAttr.getSize() <= 0, ErrorCode::AttributeNotSet,
+        "Index add requires input tensor X or a positive size along the "
+        "axis");
+    FUSILLI_RETURN_ERROR_IF(
+        xT && indexAddAttr.getSize() != 0, ErrorCode::InvalidAttribute,
+        "Index add size must not be set together with input tensor X");
+
+    const std::vector<int64_t> &indexDim = indexT->getDim();
+    const std::vector<int64_t> &sourceDim = sourceT->getDim();
+    FUSILLI_RETURN_ERROR_IF(
+        indexDim.empty() || sourceDim.size() < indexDim.size(),
+        ErrorCode::InvalidAttribute,
+        "Index add tensor INDEX must have rank at least 1 and at most the "
+        "rank of SOURCE");
+
+    int64_t rank = getRank();
+    int64_t axis = indexAddAttr.getAxis();
+    FUSILLI_RETURN_ERROR_IF(axis < -rank || axis >= rank,
+                            ErrorCode::InvalidAttribute,
+                            "Index add axis " + std::to_string(axis) +
+                                " is out of range for output tensor Y of "
+                                "rank " +
+                                std::to_string(rank));
+    FUSILLI_RETURN_ERROR_IF(
+        (xT && xT->hasDynamicDims()) || indexT->hasDynamicDims() ||
+            sourceT->hasDynamicDims(),
+        ErrorCode::NotImplemented,
+        "Index add with dynamic dims is not supported");
+    FUSILLI_RETURN_ERROR_IF(
+        sourceDim != replaceAxisDims(getOutputDim(),
+                                     static_cast<size_t>(getNormalizedAxis()),
+                                     indexDim),
+        ErrorCode::InvalidAttribute,
+        "Index add tensor SOURCE dimensions must be those of Y with the axis "
+        "replaced by the dimensions of INDEX");
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for IndexAddNode '"
+                           << indexAddAttr.getName() << "'");
+
+    // Indices are int64 unless set otherwise.
+    std::shared_ptr<TensorAttr> indexT = indexAddAttr.getINDEX();
+    if (indexT->getDataType() == DataType::NotSet)
+      indexT->setDataType(DataType::Int64);
+
+    std::shared_ptr<TensorAttr> xT = indexAddAttr.getX();
+    std::shared_ptr<TensorAttr> yT = indexAddAttr.getY();
+    inferDataTypeFromInput(xT ? xT : indexAddAttr.getSOURCE(), yT);
+    indexAddAttr.fillFromContext(context);
+
+    if (yT->getDim().empty())
+      yT->setDim(getOutputDim());
+    inferContiguousStride(yT);
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating IndexAddNode '"
+                           << indexAddAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = indexAddAttr.getX();
+    std::shared_ptr<TensorAttr> yT = indexAddAttr.getY();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != getOutputDim(), ErrorCode::InvalidAttribute,
+        "Index add output tensor Y dimensions do not match input tensor X "
+        "or the size along the axis");
+    FUSILLI_RETURN_ERROR_IF(
+        (xT && xT->getDataType() != yT->getDataType()) ||
+            indexAddAttr.getSOURCE()->getDataType() != yT->getDataType(),
+        ErrorCode::InvalidAttribute,
+        "Index add tensors X and SOURCE must have the data type of output "
+        "tensor Y");
+    FUSILLI_RETURN_ERROR_IF(
+        !isIntegerType(indexAddAttr.getINDEX()->getDataType()),
+        ErrorCode::InvalidAttribute,
+        "Index add tensor INDEX must have an integer data type");
+
+    return ok();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_SHAPE_NODE_H
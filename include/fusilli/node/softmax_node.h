@@ -0,0 +1,184 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains definitions for the softmax node `SoftmaxNode`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_NODE_SOFTMAX_NODE_H
+#define FUSILLI_NODE_SOFTMAX_NODE_H
+
+#include "fusilli/attributes/softmax_attributes.h"
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/graph/context.h"
+#include "fusilli/node/node.h"
+#include "fusilli/support/logging.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+//===----------------------------------------------------------------------===//
+// Softmax node.
+//
+// Computes Y = softmax(scale * X + MASK) (or its log) along one axis. The
+// scale and mask are elementwise producers of a single softmax op, which
+// the compiler lowers to one online-softmax dispatch instead of the
+// max / sub / exp / sum / div chain built from separate nodes.
+//===----------------------------------------------------------------------===//
+
+class SoftmaxNode : public NodeCRTP<SoftmaxNode> {
+public:
+  SoftmaxAttr softmaxAttr;
+
+  SoftmaxNode(SoftmaxAttr &&attr, const Context &ctx)
+      : NodeCRTP(ctx), softmaxAttr(std::move(attr)) {}
+
+  // ASM emitter methods.
+  std::string emitNodePreAsm() const override final;
+  std::string getOperandNamesAsm() const;
+  std::string getOperandTypesAsm() const;
+  std::string getResultNamesAsm() const;
+  std::string getResultTypesAsm() const;
+
+  // Returns the softmax axis as a non-negative logical dimension index.
+  int64_t getNormalizedAxis() const {
+    int64_t axis = softmaxAttr.getAxis();
+    int64_t rank = static_cast<int64_t>(softmaxAttr.getX()->getDim().size());
+    return axis < 0 ? axis + rank : axis;
+  }
+
+  const std::string &getName() const override final {
+    return softmaxAttr.getName();
+  }
+  Type getType() const override final { return Type::Softmax; }
+
+  void collectTensors(
+      std::vector<std::shared_ptr<TensorAttr>> &ins,
+      std::vector<std::shared_ptr<TensorAttr>> &outs) const override final {
+    softmaxAttr.collectTensors(ins, outs);
+  }
+  void replaceInput(const std::shared_ptr<TensorAttr> &from,
+                    const std::shared_ptr<TensorAttr> &to) override final {
+    softmaxAttr.replaceInput(from, to);
+  }
+  void replaceOutput(const std::shared_ptr<TensorAttr> &from,
+                     const std::shared_ptr<TensorAttr> &to) override final {
+    softmaxAttr.replaceOutput(from, to);
+  }
+
+  void archiveNode(Archive &ar) override final { softmaxAttr.archive(ar); }
+
+  void hashNode(Fingerprinter &fp) const override final {
+    softmaxAttr.hashTensors(fp);
+    std::optional<float> scale = softmaxAttr.getScale();
+    fp.update(softmaxAttr.getAxis())
+        .update(softmaxAttr.getLogSoftmax())
+        .update(scale.has_value())
+        .update(scale.value_or(0.0f));
+  }
+
+  ErrorObject preValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Pre-Validating SoftmaxNode '"
+                           << softmaxAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = softmaxAttr.getX();
+    std::shared_ptr<TensorAttr> yT = softmaxAttr.getY();
+    std::shared_ptr<TensorAttr> maskT = softmaxAttr.getMASK();
+
+    // Ensure mandatory input and output tensors are set.
+    FUSILLI_RETURN_ERROR_IF(!xT, ErrorCode::AttributeNotSet,
+                            "Softmax input tensor X not set");
+    FUSILLI_RETURN_ERROR_IF(!yT, ErrorCode::AttributeNotSet,
+                            "Softmax output tensor Y not set");
+    FUSILLI_RETURN_ERROR_IF(xT->getDim().empty(), ErrorCode::AttributeNotSet,
+                            "Softmax input tensor X dimensions not set");
+
+    // Axis range check.
+    int64_t rank = static_cast<int64_t>(xT->getDim().size());
+    int64_t axis = softmaxAttr.getAxis();
+    FUSILLI_RETURN_ERROR_IF(axis < -rank || axis >= rank,
+                            ErrorCode::InvalidAttribute,
+                            "Softmax axis " + std::to_string(axis) +
+                                " is out of range for input tensor X of rank " +
+                                std::to_string(rank));
+
+    // Mask validation: same rank as X and broadcastable to it.
+    if (maskT) {
+      const std::vector<int64_t> &xDim = xT->getDim();
+      const std::vector<int64_t> &maskDim = maskT->getDim();
+      FUSILLI_RETURN_ERROR_IF(
+          maskDim.size() != xDim.size(), ErrorCode::InvalidAttribute,
+          "Softmax mask tensor MASK must have the same rank as input tensor X");
+      for (size_t i = 0; i < xDim.size(); ++i) {
+        FUSILLI_RETURN_ERROR_IF(
+            maskDim[i] != 1 && maskDim[i] != xDim[i],
+            ErrorCode::InvalidAttribute,
+            "Softmax mask tensor MASK dim " + std::to_string(i) + " (" +
+                std::to_string(maskDim[i]) +
+                ") must be 1 or match input tensor X (" +
+                std::to_string(xDim[i]) + ")");
+      }
+    }
+
+    return ok();
+  }
+
+  ErrorObject inferPropertiesNode() override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Inferring properties for SoftmaxNode '"
+                           << softmaxAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = softmaxAttr.getX();
+    std::shared_ptr<TensorAttr> yT = softmaxAttr.getY();
+
+    softmaxAttr.fillFromContext(context);
+
+    // Output keeps the shape and layout of X when unspecified.
+    if (yT->getDim().empty())
+      yT->setDim(xT->getDim());
+    if (yT->getStride().empty())
+      yT->setStride(xT->getCompactStride());
+
+    return ok();
+  }
+
+  ErrorObject postValidateNode() const override final {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Post-Validating SoftmaxNode '"
+                           << softmaxAttr.getName() << "'");
+
+    std::shared_ptr<TensorAttr> xT = softmaxAttr.getX();
+    std::shared_ptr<TensorAttr> yT = softmaxAttr.getY();
+    std::shared_ptr<TensorAttr> maskT = softmaxAttr.getMASK();
+
+    FUSILLI_RETURN_ERROR_IF(
+        yT->getDim() != xT->getDim(), ErrorCode::InvalidAttribute,
+        "Softmax output tensor Y dimensions do not match input tensor X");
+    FUSILLI_RETURN_ERROR_IF(
+        isIntegralOrBoolType(xT->getDataType()), ErrorCode::InvalidAttribute,
+        "Softmax input tensor X must have a floating point data type");
+    FUSILLI_RETURN_ERROR_IF(
+        isIntegralOrBoolType(yT->getDataType()), ErrorCode::InvalidAttribute,
+        "Softmax output tensor Y must have a floating point data type");
+    FUSILLI_RETURN_ERROR_IF(
+        maskT && maskT->getDataType() != xT->getDataType(),
+        ErrorCode::InvalidAttribute,
+        "Softmax mask tensor MASK must have the data type of input tensor X");
+
+    return ok();
+  }
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_NODE_SOFTMAX_NODE_H
@@ -0,0 +1,392 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the `Archive` used to serialize graphs to (and
+// deserialize them from) a compact binary format, see `Graph::serialize()`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_ARCHIVE_H
+#define FUSILLI_SUPPORT_ARCHIVE_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/support/logging.h"
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace fusilli {
+
+// A symmetric binary archive: the same `io()` calls either write a value to
+// the archive or read it back into the value, depending on the mode, so every
+// serializable type describes its format once.
+//
+// Integers (and enums) are encoded as LEB128 varints (zig-zag for signed
+// types), floating point values by their IEEE bits, little-endian. Tensors
+// are identified by the order in which they are first seen (as in
+// `Fingerprinter`), so tensors shared between nodes are restored shared.
+//
+// Reading never throws: the first malformed or truncated value sets the
+// (sticky) `status()`, after which reads yield default values.
+class Archive {
+public:
+  static Archive writer() { return Archive({}, /*reading=*/false); }
+
+  static Archive reader(std::span<const uint8_t> bytes) {
+    return Archive(bytes, /*reading=*/true);
+  }
+
+  bool isReading() const { return reading_; }
+
+  const ErrorObject &status() const { return status_; }
+
+  // Records the first error, which is then reported by `status()`.
+  void fail(ErrorCode code, std::string msg) {
+    if (status_.isOk())
+      status_ = ErrorObject(code, std::move(msg));
+    pos_ = input_.size();
+  }
+
+  // Returns true once all bytes of a reading archive have been consumed.
+  bool atEnd() const { return pos_ == input_.size(); }
+
+  // Moves out the bytes written so far.
+  std::vector<uint8_t> takeBytes() { return std::move(bytes_); }
+
+  template <typename T>
+    requires std::integral<T> || std::is_enum_v<T> // C++20
+  Archive &io(T &value) {
+    if constexpr (std::is_enum_v<T>) {
+      auto raw = static_cast<std::underlying_type_t<T>>(value);
+      io(raw);
+      value = static_cast<T>(raw);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      uint64_t raw = value ? 1 : 0;
+      varint(raw);
+      if (raw > 1)
+        fail(ErrorCode::InvalidArgument, "Archive: malformed boolean");
+      value = raw == 1;
+    } else if constexpr (std::is_signed_v<T>) {
+      auto zigzag = (static_cast<uint64_t>(value) << 1) ^
+                    static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+      varint(zigzag);
+      value = static_cast<T>(static_cast<int64_t>(zigzag >> 1) ^
+                             -static_cast<int64_t>(zigzag & 1));
+    } else {
+      uint64_t raw = value;
+      varint(raw);
+      value = static_cast<T>(raw);
+    }
+    return *this;
+  }
+
+  Archive &io(float &value) {
+    auto bits = std::bit_cast<uint32_t>(value); // C++20
+    fixed(bits);
+    value = std::bit_cast<float>(bits);
+    return *this;
+  }
+
+  Archive &io(double &value) {
+    auto bits = std::bit_cast<uint64_t>(value); // C++20
+    fixed(bits);
+    value = std::bit_cast<double>(bits);
+    return *this;
+  }
+
+  Archive &io(std::string &value) {
+    size_t size = value.size();
+    io(size);
+    if (!reading_) {
+      bytes_.insert(bytes_.end(), value.begin(), value.end());
+    } else if (checkAvailable(size)) {
+      value.assign(reinterpret_cast<const char *>(input_.data() + pos_), size);
+      pos_ += size;
+    }
+    return *this;
+  }
+
+  // Reads or writes `values` as a size followed by the raw bytes, e.g. for
+  // artifacts or tensor contents, which `io()` would encode byte by byte.
+  Archive &ioBytes(std::vector<uint8_t> &values) {
+    size_t size = values.size();
+    io(size);
+    if (!reading_) {
+      bytes_.insert(bytes_.end(), values.begin(), values.end());
+    } else if (checkAvailable(size)) {
+      values.assign(input_.begin() + static_cast<std::ptrdiff_t>(pos_),
+                    input_.begin() + static_cast<std::ptrdiff_t>(pos_ + size));
+      pos_ += size;
+    } else {
+      values.clear();
+    }
+    return *this;
+  }
+
+  template <typename T> Archive &io(std::vector<T> &values) {
+    size_t size = values.size();
+    io(size);
+    if (reading_) {
+      values.clear();
+      // Every element takes at least a byte, which bounds corrupt sizes.
+      if (checkAvailable(size))
+        values.resize(size);
+    }
+    for (auto &value : values)
+      io(value);
+    return *this;
+  }
+
+  template <typename T, size_t N> Archive &io(std::array<T, N> &values) {
+    for (auto &value : values)
+      io(value);
+    return *this;
+  }
+
+  template <typename T> Archive &io(std::optional<T> &value) {
+    bool hasValue = value.has_value();
+    io(hasValue);
+    if (!hasValue) {
+      value.reset();
+      return *this;
+    }
+    if (!value.has_value())
+      value.emplace();
+    return io(*value);
+  }
+
+  // Types describing their own format through an `archive(Archive &)` member.
+  template <typename T>
+    requires requires(T &t, Archive &ar) { t.archive(ar); } // C++20
+  Archive &io(T &value) {
+    value.archive(*this);
+    return *this;
+  }
+
+  // Reads or writes a (possibly null) tensor. The first time a tensor is seen
+  // its properties are written, subsequent references only write its id.
+  Archive &io(std::shared_ptr<TensorAttr> &t);
+
+private:
+  Archive(std::span<const uint8_t> input, bool reading)
+      : reading_(reading), input_(input) {}
+
+  bool checkAvailable(size_t size) {
+    if (pos_ <= input_.size() && size <= input_.size() - pos_)
+      return true;
+    fail(ErrorCode::InvalidArgument, "Archive: unexpected end of data");
+    return false;
+  }
+
+  void varint(uint64_t &value) {
+    if (!reading_) {
+      uint64_t rest = value;
+      do {
+        uint8_t byte = rest & 0x7f;
+        rest >>= 7;
+        bytes_.push_back(rest ? byte | 0x80 : byte);
+      } while (rest);
+      return;
+    }
+    uint64_t result = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (!checkAvailable(1)) {
+        value = 0;
+        return;
+      }
+      uint8_t byte = input_[pos_++];
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        value = result;
+        return;
+      }
+    }
+    fail(ErrorCode::InvalidArgument, "Archive: malformed varint");
+    value = 0;
+  }
+
+  template <std::unsigned_integral T> void fixed(T &value) {
+    if (!reading_) {
+      for (size_t i = 0; i < sizeof(T); ++i)
+        bytes_.push_back(static_cast<uint8_t>(value >> (8 * i)));
+      return;
+    }
+    if (!checkAvailable(sizeof(T))) {
+      value = 0;
+      return;
+    }
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+      value |= static_cast<T>(input_[pos_++]) << (8 * i);
+  }
+
+  bool reading_;
+  ErrorObject status_;
+  std::vector<uint8_t> bytes_;
+  std::span<const uint8_t> input_;
+  size_t pos_ = 0;
+
+  std::unordered_map<const TensorAttr *, size_t> tensorIds_;
+  std::vector<std::shared_ptr<TensorAttr>> tensors_;
+};
+
+inline Archive &Archive::io(std::shared_ptr<TensorAttr> &t) {
+  // Tags: 0 is a null tensor, 1 a reference to a tensor seen before, 2 a
+  // tensor seen for the first time (followed by its properties).
+  uint8_t tag = 0;
+  size_t id = 0;
+  if (!reading_ && t) {
+    auto [it, inserted] = tensorIds_.try_emplace(t.get(), tensorIds_.size());
+    tag = inserted ? 2 : 1;
+    id = it->second;
+  }
+  io(tag);
+  if (tag == 0) {
+    t.reset();
+    return *this;
+  }
+  if (tag == 1) {
+    io(id);
+    if (reading_) {
+      if (id >= tensors_.size()) {
+        fail(ErrorCode::InvalidArgument, "Archive: unknown tensor reference");
+        t.reset();
+        return *this;
+      }
+      t = tensors_[id];
+    }
+    return *this;
+  }
+  if (tag != 2) {
+    fail(ErrorCode::InvalidArgument, "Archive: malformed tensor tag");
+    t.reset();
+    return *this;
+  }
+
+  // Scalars are restored through the scalar constructors, which also set the
+  // matching data type, before the remaining properties overwrite it.
+  std::optional<TensorAttr::scalar_t> value;
+  size_t index = 0;
+  if (!reading_) {
+    value = t->getScalarValue();
+    index = value ? value->index() + 1 : 0;
+  }
+  io(index);
+  if (index > std::variant_size_v<TensorAttr::scalar_t>) {
+    fail(ErrorCode::InvalidArgument, "Archive: malformed scalar value");
+    t.reset();
+    return *this;
+  }
+  if (reading_) {
+    switch (index) {
+    case 1:
+      value.emplace(std::in_place_index<0>);
+      break;
+    case 2:
+      value.emplace(std::in_place_index<1>);
+      break;
+    case 3:
+      value.emplace(std::in_place_index<2>);
+      break;
+    case 4:
+      value.emplace(std::in_place_index<3>);
+      break;
+    default:
+      break;
+    }
+  }
+  if (value)
+    std::visit([&](auto &v) { io(v); }, *value);
+  if (reading_) {
+    t = value ? std::visit(
+                    [](auto v) { return std::make_shared<TensorAttr>(v); },
+                    *value)
+              : std::make_shared<TensorAttr>();
+    tensors_.push_back(t);
+  }
+
+  std::string name = t->getName();
+  DataType dataType = t->getDataType();
+  std::vector<int64_t> dim = t->getDim();
+  std::vector<int64_t> stride = t->getStride();
+  std::vector<size_t> dynamicDims = t->getDynamicDims();
+  bool isVirtual = t->isVirtual();
+  bool isScalar = t->isScalar();
+  bool isRuntimeScalar = t->isRuntimeScalar();
+  bool isConstant = t->isConstant();
+  std::shared_ptr<TensorAttr> inPlace = t->getInPlace();
+  io(name).io(dataType).io(dim).io(stride).io(dynamicDims);
+  // Dynamic dim hints as flat (index, min, max, divisor) entries.
+  std::vector<int64_t> dynamicDimHints;
+  for (const auto &[index, hint] : t->getDynamicDimHints())
+    dynamicDimHints.insert(dynamicDimHints.end(),
+                           {static_cast<int64_t>(index), hint.min, hint.max,
+                            hint.divisor});
+  io(dynamicDimHints);
+  if (reading_)
+    for (size_t i = 0; i + 3 < dynamicDimHints.size(); i += 4)
+      t->setDynamicDimHint(static_cast<size_t>(dynamicDimHints[i]),
+                           {.min = dynamicDimHints[i + 1],
+                            .max = dynamicDimHints[i + 2],
+                            .divisor = dynamicDimHints[i + 3]});
+  io(isVirtual).io(isScalar).io(isRuntimeScalar).io(isConstant).io(inPlace);
+  bool hasConstantData = t->hasConstantData();
+  io(hasConstantData);
+  if (hasConstantData) {
+    std::vector<uint8_t> constantData;
+    if (!reading_)
+      constantData = *t->getConstantData();
+    ioBytes(constantData);
+    if (reading_)
+      t->setConstantData(std::move(constantData));
+  }
+  std::string parameterKey = t->getParameterKey();
+  std::string parameterScope = t->getParameterScope();
+  io(parameterKey).io(parameterScope);
+  if (reading_ && !parameterKey.empty())
+    t->setParameter(parameterKey, parameterScope);
+  size_t alignment = t->getAlignment();
+  io(alignment);
+  // The blocked layout as (dim, block size), empty if none.
+  std::vector<int64_t> blockedLayout;
+  if (const auto &layout = t->getBlockedLayout())
+    blockedLayout = {static_cast<int64_t>(layout->dim), layout->blockSize};
+  io(blockedLayout);
+  if (reading_ && blockedLayout.size() == 2)
+    t->setBlockedLayout({.dim = static_cast<size_t>(blockedLayout[0]),
+                         .blockSize = blockedLayout[1]});
+  if (reading_)
+    t->setName(name)
+        .setDataType(dataType)
+        .setDim(dim)
+        .setStride(stride)
+        .setDynamicDims(dynamicDims)
+        .setIsVirtual(isVirtual)
+        .setIsScalar(isScalar)
+        .setRuntimeScalar(isRuntimeScalar)
+        .setConstant(isConstant)
+        .setInPlace(inPlace)
+        .setAlignment(alignment);
+  return *this;
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_ARCHIVE_H
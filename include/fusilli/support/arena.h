@@ -0,0 +1,81 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the `Arena` used to allocate the nodes and tensors of a
+// graph in bulk, see `Graph::setArenaSize()`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_ARENA_H
+#define FUSILLI_SUPPORT_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace fusilli {
+
+// A bump allocator handing out memory from blocks of geometrically growing
+// size: allocations are a pointer increment, and memory is only released,
+// all at once, when the arena is destroyed.
+//
+// Objects are allocated with `makeShared()`, which stores the object and its
+// `shared_ptr` control block in the arena. Each control block keeps the arena
+// alive, so handles stay valid (and stable) after the owner of the arena is
+// gone. Not thread-safe: allocate from one thread at a time.
+class Arena : public std::enable_shared_from_this<Arena> {
+public:
+  static std::shared_ptr<Arena> create(size_t initialBytes) {
+    return std::shared_ptr<Arena>(new Arena(initialBytes));
+  }
+
+  // STL allocator drawing from an arena it shares ownership of.
+  template <typename T> class Allocator {
+  public:
+    using value_type = T;
+
+    explicit Allocator(std::shared_ptr<Arena> arena)
+        : arena_(std::move(arena)) {}
+    template <typename U>
+    Allocator(const Allocator<U> &other) : arena_(other.arena_) {}
+
+    T *allocate(size_t n) {
+      return static_cast<T *>(
+          arena_->resource_.allocate(n * sizeof(T), alignof(T)));
+    }
+    // Memory is reclaimed when the arena is destroyed.
+    void deallocate(T *, size_t) {}
+
+    template <typename U> bool operator==(const Allocator<U> &other) const {
+      return arena_ == other.arena_;
+    }
+
+  private:
+    template <typename U> friend class Allocator;
+    std::shared_ptr<Arena> arena_;
+  };
+
+  template <typename T, typename... Args>
+  std::shared_ptr<T> makeShared(Args &&...args) {
+    return std::allocate_shared<T>(Allocator<T>(shared_from_this()),
+                                   std::forward<Args>(args)...);
+  }
+
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+private:
+  explicit Arena(size_t initialBytes) : resource_(initialBytes) {}
+
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_ARENA_H
@@ -33,25 +33,40 @@
 #include "fusilli/external/torch_types.h"
 #include "fusilli/graph/graph.h"
 #include "fusilli/node/batchnorm_node.h"
+#include "fusilli/node/collective_node.h"
 #include "fusilli/node/conv_node.h"
 #include "fusilli/node/custom_op_node.h"
 #include "fusilli/node/layernorm_node.h"
+#include "fusilli/node/norm_utils.h"
+#include "fusilli/node/optimizer_node.h"
 #include "fusilli/node/pointwise_node.h"
+#include "fusilli/node/pooling_node.h"
 #include "fusilli/node/rmsnorm_node.h"
 #include "fusilli/node/sdpa_node.h"
+#include "fusilli/node/shape_node.h"
+#include "fusilli/node/softmax_node.h"
 #include "fusilli/support/extras.h"
 
+#include <algorithm>
 #include <bit> // C++20
 #include <cassert>
 #include <cctype>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <format> // C++20
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace fusilli {
@@ -77,56 +92,70 @@ namespace fusilli {
 // The prefix is generally what attribute this refers to (e.g.
 // padding, stride, dilation etc.) and the suffix is the node's
 // unique name (for SSA disambiguation).
-inline std::string getListOfIntOpsAsm(const std::vector<int64_t> &listOfInts,
-                                      const std::string &prefix,
-                                      const std::string &suffix) {
-  std::ostringstream oss;
-  std::vector<std::string> ssaValueNames;
+inline void appendListOfIntOpsAsm(std::string &out,
+                                  const std::vector<int64_t> &listOfInts,
+                                  std::string_view prefix,
+                                  std::string_view suffix) {
+  auto it = std::back_inserter(out);
 
   // Emit `torch.constant.int` ops for each int value.
-  for (size_t i = 0; i < listOfInts.size(); ++i) {
-    std::string ssaValueName =
-        "%" + prefix + "_val_" + std::to_string(i) + "_" + suffix;
-    oss << ssaValueName << " = torch.constant.int " << listOfInts[i]
-        << "\n    ";
-    ssaValueNames.push_back(ssaValueName);
-  }
+  for (size_t i = 0; i < listOfInts.size(); ++i)
+    it = std::format_to(it, "%{}_val_{}_{} = torch.constant.int {}\n    ",
+                        prefix, i, suffix, listOfInts[i]);
 
   // Emit the ListConstruct op.
-  oss << "%" + prefix + "_" + suffix << " = torch.prim.ListConstruct ";
+  it = std::format_to(it, "%{}_{} = torch.prim.ListConstruct ", prefix,
+                      suffix);
   // %val_0, %val_1, ...
-  interleave(
-      ssaValueNames.begin(), ssaValueNames.end(),
-      // each_fn:
-      [&](const std::string &name) { oss << name; },
-      // between_fn:
-      [&] { oss << ", "; });
-  oss << " : (";
+  for (size_t i = 0; i < listOfInts.size(); ++i)
+    it = std::format_to(it, "{}%{}_val_{}_{}", i ? ", " : "", prefix, i,
+                        suffix);
+  out += " : (";
   // !torch.int, !torch.int, ...
-  interleave(
-      ssaValueNames.begin(), ssaValueNames.end(),
-      // each_fn:
-      [&](const std::string &name) { oss << "!torch.int"; },
-      // between_fn:
-      [&] { oss << ", "; });
-  oss << ") -> !torch.list<int>\n";
+  for (size_t i = 0; i < listOfInts.size(); ++i)
+    out += i ? ", !torch.int" : "!torch.int";
+  out += ") -> !torch.list<int>\n";
+}
 
-  return oss.str();
+// Returning variant of `appendListOfIntOpsAsm()`.
+inline std::string getListOfIntOpsAsm(const std::vector<int64_t> &listOfInts,
+                                      const std::string &prefix,
+                                      const std::string &suffix) {
+  std::string out;
+  appendListOfIntOpsAsm(out, listOfInts, prefix, suffix);
+  return out;
+}
+
+// Appends the dims of a tensor type (`2,?,3`) to `out`. Dims at positions for
+// which `isDynamic` returns true are emitted as dynamic (`?`).
+template <typename IsDynamicFn>
+inline void appendTensorDimsAsm(std::string &out,
+                                const std::vector<int64_t> &dims,
+                                IsDynamicFn isDynamic) {
+  auto it = std::back_inserter(out);
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (i)
+      out += ',';
+    if (isDynamic(i))
+      out += '?';
+    else
+      it = std::format_to(it, "{}", dims[i]);
+  }
 }
 
 // Builds a tensor type string from explicit dims and dtype, without requiring
 // a TensorAttr. Used when the type differs from what a TensorAttr stores
-// (e.g., unexpanded dims for broadcast tensors).
+// (e.g., unexpanded dims for broadcast tensors). Negative dims are emitted
+// as dynamic (`?`).
 inline std::string buildTensorTypeStr(const std::vector<int64_t> &dims,
                                       DataType dtype,
                                       bool isValueTensor = true) {
-  std::ostringstream oss;
-  oss << (isValueTensor ? "!torch.vtensor<[" : "!torch.tensor<[");
-  interleave(
-      dims.begin(), dims.end(), [&](int64_t dim) { oss << dim; },
-      [&] { oss << ","; });
-  oss << "]," << kDataTypeToMlirTypeAsm.at(dtype) << ">";
-  return oss.str();
+  std::string out(isValueTensor ? "!torch.vtensor<[" : "!torch.tensor<[");
+  appendTensorDimsAsm(out, dims, [&](size_t i) { return dims[i] < 0; });
+  out += "],";
+  out += kDataTypeToMlirTypeAsm.at(dtype);
+  out += '>';
+  return out;
 }
 
 // ---------------------------------------------------------------------------
@@ -157,6 +186,104 @@ inline std::string torchIntAsm(std::string_view name, std::string_view suffix,
   return std::format("%{}_{} = torch.constant.int {}", name, suffix, value);
 }
 
+// Emits the layout conversion ops of a tensor with a blocked layout (see
+// `TensorAttr::setBlockedLayout()`), named as `getLayoutConversionOpsAsm()`
+// names them. The physical dims are permuted to the logical dims with the
+// blocked dim split in two (e.g. NCHW16c to [N, C/16, 16, H, W]), which a view
+// merges into the logical dims. Outputs take the reverse path.
+//
+// Example output (input x of dims [2, 32, 4, 4] in NCHW16c, suffix conv):
+//   %permute_X_val_0_conv = torch.constant.int 0
+//   ...
+//   %permute_X_conv = torch.prim.ListConstruct ... -> !torch.list<int>
+//   %x_conv_perm_blocked = torch.aten.permute %x, %permute_X_conv
+//       : !torch.vtensor<[2,2,4,4,16],f32>, !torch.list<int>
+//       -> !torch.vtensor<[2,2,16,4,4],f32>
+//   %permute_X_shape_val_0_conv = torch.constant.int 2
+//   ...
+//   %x_conv_perm = torch.aten.view %x_conv_perm_blocked, %permute_X_shape_conv
+//       : !torch.vtensor<[2,2,16,4,4],f32>, !torch.list<int>
+//       -> !torch.vtensor<[2,32,4,4],f32>
+inline std::string
+getBlockedLayoutConversionOpsAsm(const std::shared_ptr<TensorAttr> &tensor,
+                                 const std::string &prefix,
+                                 const std::string &suffix, bool isInput,
+                                 const std::string &operandOverride) {
+  const BlockedLayout &layout = *tensor->getBlockedLayout();
+  const std::vector<int64_t> &dims = tensor->getDim();
+  std::vector<int64_t> logicalToPhysical =
+      tensor->getLogicalToPhysicalPermuteOrder();
+  auto rank = static_cast<int64_t>(dims.size());
+  auto blocked = static_cast<int64_t>(layout.dim);
+
+  // Logical dims with the blocked dim split into blocks and block elements.
+  std::vector<int64_t> splitDims = dims;
+  splitDims[layout.dim] /= layout.blockSize;
+  splitDims.insert(splitDims.begin() + blocked + 1, layout.blockSize);
+  // Position of logical dim `l` among the split dims.
+  auto splitIndex = [&](int64_t l) { return l <= blocked ? l : l + 1; };
+
+  std::vector<int64_t> permuteOrder;
+  if (isInput) {
+    // Split dim j is read from physical dim permuteOrder[j]; the block
+    // elements from the innermost one.
+    std::vector<int64_t> physicalToLogical =
+        tensor->getPhysicalToLogicalPermuteOrder();
+    for (int64_t j = 0; j <= rank; ++j) {
+      if (j == blocked + 1)
+        permuteOrder.push_back(rank);
+      else
+        permuteOrder.push_back(physicalToLogical[static_cast<size_t>(
+            j <= blocked ? j : j - 1)]);
+    }
+  } else {
+    // Physical dim i is read from split dim permuteOrder[i].
+    for (int64_t l : logicalToPhysical)
+      permuteOrder.push_back(splitIndex(l));
+    permuteOrder.push_back(blocked + 1);
+  }
+
+  std::string name = tensor->getValueNameAsm();
+  std::string splitType = buildTensorTypeStr(splitDims, tensor->getDataType());
+  std::string physicalType = tensor->getTensorTypeAsm(/*isValueTensor=*/true);
+  std::string logicalType = tensor->getTensorTypeAsm(
+      /*isValueTensor=*/true, /*useLogicalDims=*/true);
+  std::string splitName = name + "_" + suffix + "_perm_blocked";
+  std::string shapePrefix = prefix + "_shape";
+
+  constexpr std::string_view permuteSchema = R"(
+    {0} = torch.aten.permute {1}, {2} : {3}, !torch.list<int> -> {4}
+  )";
+  constexpr std::string_view viewSchema = R"(
+    {0} = torch.aten.view {1}, {2} : {3}, !torch.list<int> -> {4}
+  )";
+  std::string out;
+  out.reserve(1024);
+  if (isInput) {
+    appendListOfIntOpsAsm(out, permuteOrder, prefix, suffix);
+    std::string operand = operandOverride.empty() ? name : operandOverride;
+    std::format_to(std::back_inserter(out), permuteSchema, splitName, operand,
+                   "%" + prefix + "_" + suffix, physicalType, splitType);
+    out += "  ";
+    appendListOfIntOpsAsm(out, dims, shapePrefix, suffix);
+    std::format_to(std::back_inserter(out), viewSchema,
+                   name + "_" + suffix + "_perm", splitName,
+                   "%" + shapePrefix + "_" + suffix, splitType, logicalType);
+  } else {
+    std::string operand = operandOverride.empty()
+                              ? name + "_" + suffix + "_perm"
+                              : operandOverride;
+    appendListOfIntOpsAsm(out, splitDims, shapePrefix, suffix);
+    std::format_to(std::back_inserter(out), viewSchema, splitName, operand,
+                   "%" + shapePrefix + "_" + suffix, logicalType, splitType);
+    out += "  ";
+    appendListOfIntOpsAsm(out, permuteOrder, prefix, suffix);
+    std::format_to(std::back_inserter(out), permuteSchema, name, splitName,
+                   "%" + prefix + "_" + suffix, splitType, physicalType);
+  }
+  return out;
+}
+
 // Emits layout conversion ops (permute + broadcast expand if needed) for a
 // tensor in MLIR assembly format. Handles both directions:
 //
@@ -171,20 +298,23 @@ inline std::string torchIntAsm(std::string_view name, std::string_view suffix,
 //
 // The suffix is used to ensure unique SSA names when the same tensor is used
 // by multiple different operations in a graph.
+//
+// Tensors with a blocked layout are converted by
+// `getBlockedLayoutConversionOpsAsm()`.
+//
+// Virtual tensors kept in logical layout (see `Graph::optimizeLayouts()`) are
+// not permuted: a no-op `torch.tensor_static_info_cast` (folded away by the
+// compiler) binds the same result name to the operand instead.
 inline std::string
 getLayoutConversionOpsAsm(const std::shared_ptr<TensorAttr> &tensor,
                           const std::string &prefix, const std::string &suffix,
                           bool isInput,
                           const std::string &operandOverride = "") {
-  std::ostringstream oss;
-  bool hasBroadcast = isInput && tensor->hasBroadcastDims();
-
-  // Permute
-  std::vector<int64_t> permuteOrder =
-      isInput ? tensor->getPhysicalToLogicalPermuteOrder()
-              : tensor->getLogicalToPhysicalPermuteOrder();
+  if (tensor->isBlocked())
+    return getBlockedLayoutConversionOpsAsm(tensor, prefix, suffix, isInput,
+                                            operandOverride);
 
-  oss << getListOfIntOpsAsm(permuteOrder, prefix, suffix);
+  bool hasBroadcast = isInput && tensor->hasBroadcastDims();
 
   std::string permuteResultName =
       tensor->getValueNameAsm() +
@@ -196,6 +326,24 @@ getLayoutConversionOpsAsm(const std::shared_ptr<TensorAttr> &tensor,
           ? tensor->getValueNameAsm() + (isInput ? "" : "_" + suffix + "_perm")
           : operandOverride;
 
+  if (tensor->isLogicalLayout()) {
+    constexpr std::string_view castSchema = R"(
+    {0} = torch.tensor_static_info_cast {1} : {2} to {2}
+  )";
+    return std::format(castSchema, permuteResultName, permuteOperandName,
+                       tensor->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                /*useLogicalDims=*/true));
+  }
+
+  // Permute
+  std::vector<int64_t> permuteOrder =
+      isInput ? tensor->getPhysicalToLogicalPermuteOrder()
+              : tensor->getLogicalToPhysicalPermuteOrder();
+
+  std::string out;
+  out.reserve(512);
+  appendListOfIntOpsAsm(out, permuteOrder, prefix, suffix);
+
   std::string permuteFromType = tensor->getTensorTypeAsm(
       /*isValueTensor=*/true, /*useLogicalDims=*/!isInput);
   std::string permuteToType =
@@ -207,19 +355,20 @@ getLayoutConversionOpsAsm(const std::shared_ptr<TensorAttr> &tensor,
   constexpr std::string_view permuteSchema = R"(
     {0} = torch.aten.permute {1}, {2} : {3}, !torch.list<int> -> {4}
   )";
-  oss << std::format(permuteSchema, permuteResultName, permuteOperandName,
-                     "%" + prefix + "_" + suffix, permuteFromType,
-                     permuteToType);
+  std::format_to(std::back_inserter(out), permuteSchema, permuteResultName,
+                 permuteOperandName, "%" + prefix + "_" + suffix,
+                 permuteFromType, permuteToType);
   if (!hasBroadcast) {
-    return oss.str();
+    return out;
   }
 
   // Expand broadcast dims (input direction only)
   std::string expandSizePrefix = "expand_size_" + prefix;
   std::string expandImplicitName = "%expand_implicit_" + prefix + "_" + suffix;
-  oss << "    "
-      << getListOfIntOpsAsm(tensor->getDim(), expandSizePrefix, suffix);
-  oss << expandImplicitName << " = torch.constant.bool false\n    ";
+  out += "    ";
+  appendListOfIntOpsAsm(out, tensor->getDim(), expandSizePrefix, suffix);
+  out += expandImplicitName;
+  out += " = torch.constant.bool false\n    ";
 
   std::string expandResult = tensor->getValueNameAsm() + "_" + suffix + "_perm";
   std::string expandFromType =
@@ -230,10 +379,10 @@ getLayoutConversionOpsAsm(const std::shared_ptr<TensorAttr> &tensor,
   constexpr std::string_view expandSchema =
       R"({0} = torch.aten.expand {1}, {2}, {3} : {4}, !torch.list<int>, !torch.bool -> {5}
   )";
-  oss << std::format(expandSchema, expandResult, permuteResultName,
-                     "%" + expandSizePrefix + "_" + suffix, expandImplicitName,
-                     expandFromType, expandToType);
-  return oss.str();
+  std::format_to(std::back_inserter(out), expandSchema, expandResult,
+                 permuteResultName, "%" + expandSizePrefix + "_" + suffix,
+                 expandImplicitName, expandFromType, expandToType);
+  return out;
 }
 
 // Emits a scalar TensorAttr as a constant tensor literal in MLIR assembly.
@@ -275,6 +424,82 @@ getScalarConstantAsm(const std::shared_ptr<TensorAttr> &tensor) {
           .value()); // std::variant<int64_t, int32_t, float, double>
 }
 
+// Returns the builtin tensor type of the physical layout of `tensor`, e.g.
+// `tensor<1x4xf32>`, for the graph inputs that are not function arguments.
+inline std::string
+getBuiltinTensorTypeAsm(const std::shared_ptr<TensorAttr> &tensor) {
+  std::string out("tensor<");
+  for (int64_t dim : tensor->getPhysicalDim())
+    out += std::to_string(dim) + "x";
+  out += kDataTypeToMlirTypeAsm.at(tensor->getDataType());
+  out += '>';
+  return out;
+}
+
+// Emits a graph input with constant data (see `TensorAttr::setConstantData()`)
+// as a tensor literal of its physical type, in place of the function argument
+// of the same name. The bytes are emitted as a hex string of the raw
+// (little-endian) element data.
+//
+// Example output:
+//   %w = torch.vtensor.literal(dense<"0x0000803F00000040"> : tensor<2xf32>)
+//       : !torch.vtensor<[2],f32>
+inline std::string
+getConstantDataAsm(const std::shared_ptr<TensorAttr> &tensor) {
+  assert(tensor->hasConstantData() &&
+         "getConstantDataAsm called with tensor without constant data");
+  const std::vector<uint8_t> &data = *tensor->getConstantData();
+  constexpr std::string_view kHexDigits = "0123456789ABCDEF";
+  std::string hex;
+  hex.reserve(2 * data.size());
+  for (uint8_t byte : data) {
+    hex += kHexDigits[byte >> 4];
+    hex += kHexDigits[byte & 0xF];
+  }
+
+  constexpr std::string_view schema = R"(
+    {0} = torch.vtensor.literal(dense<"0x{1}"> : {2}) : {3}
+)";
+  return std::format(schema,
+                     tensor->getValueNameAsm(),          // {0}
+                     hex,                                // {1}
+                     getBuiltinTensorTypeAsm(tensor),    // {2}
+                     tensor->getTensorTypeAsm()          // {3}
+  );
+}
+
+// Returns the symbol of the global holding the external parameter of a graph
+// input (see `TensorAttr::setParameter()`). Globals are named after the
+// parameter, so graphs of one module referencing it share the global.
+inline std::string
+getParameterGlobalAsm(const std::shared_ptr<TensorAttr> &tensor) {
+  return std::format("@\"{}::{}\"", tensor->getParameterScope(),
+                     tensor->getParameterKey());
+}
+
+// Emits a graph input read from an external parameter (see
+// `TensorAttr::setParameter()`) as a load of its global (see
+// `Graph::emitModuleScopeAsm()`), in place of the function argument of the
+// same name.
+//
+// Example output:
+//   %w_param = util.global.load @"model::w" : tensor<1x4xf32>
+//   %w = torch_c.from_builtin_tensor %w_param : tensor<1x4xf32>
+//       -> !torch.vtensor<[1,4],f32>
+inline std::string
+getParameterLoadAsm(const std::shared_ptr<TensorAttr> &tensor) {
+  constexpr std::string_view schema = R"(
+    {0}_param = util.global.load {1} : {2}
+    {0} = torch_c.from_builtin_tensor {0}_param : {2} -> {3}
+)";
+  return std::format(schema,
+                     tensor->getValueNameAsm(),       // {0}
+                     getParameterGlobalAsm(tensor),   // {1}
+                     getBuiltinTensorTypeAsm(tensor), // {2}
+                     tensor->getTensorTypeAsm()       // {3}
+  );
+}
+
 // Emits a `torch.aten.item` op to extract a scalar float from a tensor.
 // The result SSA name is `%<prefix>_<suffix>`.
 //
@@ -301,6 +526,87 @@ inline std::string getScalarItemOpsAsm(const std::string &prefix,
   );
 }
 
+// Emits the ops dequantizing the accumulator `acc` (of element type
+// `accType`) of a matmul or convolution over FP8 or int8 operands in MLIR
+// assembly format. The accumulator is widened to f32 when it is int32,
+// multiplied by each of the named, broadcastable `scales` tensors and
+// converted to the element type of `resultT` as `resultName`, e.g.
+//
+//   %dequant_acc_f32_mm = torch.aten.to.dtype %matmul_acc_mm, ...
+//   %dequant_SCALE_A_mm = torch.aten.mul.Tensor %dequant_acc_f32_mm, ...
+//   %c_mm_perm = torch.aten.mul.Tensor %dequant_SCALE_A_mm, ...
+//
+// All of it is elementwise on the accumulator, so it fuses into the dispatch
+// of the matmul or convolution.
+inline std::string getDequantizeOpsAsm(
+    const std::string &acc, DataType accType,
+    const std::vector<std::pair<std::string, std::shared_ptr<TensorAttr>>>
+        &scales,
+    const std::shared_ptr<TensorAttr> &resultT, const std::string &resultName,
+    const std::string &suffix) {
+  const std::vector<int64_t> &dims = resultT->getDim();
+  DataType resultType = resultT->getDataType();
+  std::string f32Type = buildTensorTypeStr(dims, DataType::Float);
+  auto dtypeCode = [](DataType type) {
+    return static_cast<int64_t>(kDataTypeToTorchType.at(type));
+  };
+
+  std::ostringstream oss;
+  if (accType != DataType::Float || resultType != DataType::Float) {
+    oss << std::format(R"(
+    {0}
+    {1}
+)",
+                       torchNoneAsm("dequant_none", suffix),
+                       torchBoolAsm("dequant_false", suffix, false));
+  }
+
+  std::string current = acc;
+  if (accType != DataType::Float) {
+    oss << std::format(R"(
+    {1}
+    %dequant_acc_f32_{0} = torch.aten.to.dtype {2}, %dequant_f32_{0}, %dequant_false_{0}, %dequant_false_{0}, %dequant_none_{0} : {3}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {4}
+)",
+                       suffix,
+                       torchIntAsm("dequant_f32", suffix,
+                                   dtypeCode(DataType::Float)),
+                       current, buildTensorTypeStr(dims, accType), f32Type);
+    current = "%dequant_acc_f32_" + suffix;
+  }
+
+  for (size_t i = 0; i < scales.size(); ++i) {
+    const auto &[name, scaleT] = scales[i];
+    std::string next = i + 1 == scales.size() && resultType == DataType::Float
+                           ? resultName
+                           : std::format("%dequant_{}_{}", name, suffix);
+    oss << std::format(R"(
+    {0}
+    {1} = torch.aten.mul.Tensor {2}, {3}_{4}_perm : {5}, {6} -> {5}
+)",
+                       getLayoutConversionOpsAsm(scaleT, "permute_" + name,
+                                                 suffix, /*isInput=*/true),
+                       next, current, scaleT->getValueNameAsm(), suffix,
+                       f32Type,
+                       scaleT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                /*useLogicalDims=*/true));
+    current = next;
+  }
+
+  if (resultType != DataType::Float) {
+    oss << std::format(R"(
+    {1}
+    {2} = torch.aten.to.dtype {3}, %dequant_dtype_{0}, %dequant_false_{0}, %dequant_false_{0}, %dequant_none_{0} : {4}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {5}
+)",
+                       suffix,
+                       torchIntAsm("dequant_dtype", suffix,
+                                   dtypeCode(resultType)),
+                       resultName, current, f32Type,
+                       resultT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                 /*useLogicalDims=*/true));
+  }
+  return oss.str();
+}
+
 //===----------------------------------------------------------------------===//
 //
 // TensorAttr ASM Emitter Methods
@@ -378,34 +684,25 @@ inline std::string TensorAttr::getTensorTypeAsm(bool isValueTensor,
   assert(getDataType() != DataType::NotSet &&
          "TensorAttr::getTensorTypeAsm expects a valid data type");
 
-  std::ostringstream oss;
-  oss << (isValueTensor ? "!torch.vtensor<[" : "!torch.tensor<[");
-
-  std::vector<int64_t> dims = useLogicalDims ? getDim() : getPhysicalDim();
-  std::vector<int64_t> logicalDimIndices(dims.size());
-  if (useLogicalDims)
-    std::iota(logicalDimIndices.begin(), logicalDimIndices.end(), 0);
-  else
-    logicalDimIndices = getLogicalToPhysicalPermuteOrder();
-  std::vector<size_t> dimPositions(dims.size());
-  std::iota(dimPositions.begin(), dimPositions.end(), 0);
+  std::string out(isValueTensor ? "!torch.vtensor<[" : "!torch.tensor<[");
+  out.reserve(out.size() + 8 * getDim().size() + 8);
 
-  interleave(
-      dimPositions.begin(), dimPositions.end(),
-      [&](size_t dimPosition) {
-        int64_t logicalDimIndex = logicalDimIndices[dimPosition];
-        if (isDynamicDim(static_cast<size_t>(logicalDimIndex))) {
-          oss << "?";
-          return;
-        }
-        oss << std::to_string(dims[dimPosition]);
-      },
-      // between_fn:
-      [&] { oss << ","; });
-  oss << "],";
-  oss << kDataTypeToMlirTypeAsm.at(getDataType());
-  oss << ">";
-  return oss.str();
+  if (useLogicalDims) {
+    appendTensorDimsAsm(out, getDim(),
+                        [&](size_t i) { return isDynamicDim(i); });
+  } else {
+    std::vector<int64_t> logicalDimIndices =
+        getLogicalToPhysicalPermuteOrder();
+    // The innermost dim of a blocked layout has no logical counterpart.
+    appendTensorDimsAsm(out, getPhysicalDim(), [&](size_t i) {
+      return i < logicalDimIndices.size() &&
+             isDynamicDim(static_cast<size_t>(logicalDimIndices[i]));
+    });
+  }
+  out += "],";
+  out += kDataTypeToMlirTypeAsm.at(getDataType());
+  out += '>';
+  return out;
 }
 
 // Emits an MLIR SSA value name starting with the `%` sigil based off the
@@ -441,22 +738,36 @@ inline std::string TensorAttr::getValueNameAsm(bool isOutputAliased) const {
 // Order of operands is made to be deterministic, and it is
 // determined by the sorting order used in `fullGraphInputsSorted_`
 // which sorts based on the name on the TensorAttrs.
+//
+// An input overwritten by an in-place output (see
+// `TensorAttr::setInPlace()`) is mutable, like the outputs:
+//      "%arg0_image_: !torch.tensor<[16,128,64,64],f32>"
+// Its value is read by `emitNodePreAsm()`, and the output overwrites it in
+// `emitNodePostAsm()`, which IREE lowers to a tied operand.
 inline std::string Graph::getOperandNamesAndTypesAsm() const {
   std::ostringstream oss;
   interleave(
       fullGraphInputsSorted_.begin(), fullGraphInputsSorted_.end(),
       // each_fn:
       [&](const std::shared_ptr<TensorAttr> &input) {
-        oss << input->getValueNameAsm() << ": " << input->getTensorTypeAsm();
+        if (isInPlaceDonor(input))
+          oss << input->getValueNameAsm(/*isOutputAliased=*/true) << ": "
+              << input->getTensorTypeAsm(/*isValueTensor=*/false);
+        else if (input->hasPaddedStrides())
+          oss << input->getValueNameAsm() << "_storage: "
+              << getStorageTypeAsm(input);
+        else
+          oss << input->getValueNameAsm() << ": " << input->getTensorTypeAsm();
       },
       // between_fn:
       [&] { oss << ", "; },
       // skip_fn:
       [&](const std::shared_ptr<TensorAttr> &input) {
-        // We only use the tensor inputs and not scalar (constants) as those
-        // wouldn't be part of the main func.func signature but embedded as
-        // constants in the IR.
-        return input->isScalar();
+        // We only use the tensor inputs and not scalar (constants) or tensors
+        // with constant data as those wouldn't be part of the main func.func
+        // signature but embedded as constants in the IR. Runtime scalars are
+        // regular arguments.
+        return input->isEmbedded();
       });
   return oss.str();
 }
@@ -478,15 +789,18 @@ inline std::string Graph::getResultNamesAndTypesAsm() const {
       // each_fn:
       [&](const std::shared_ptr<TensorAttr> &output) {
         oss << output->getValueNameAsm(/*isOutputAliased=*/true) << ": "
-            << output->getTensorTypeAsm(/*isValueTensor=*/false);
+            << (output->hasPaddedStrides()
+                    ? getStorageTypeAsm(output, /*isValueTensor=*/false)
+                    : output->getTensorTypeAsm(/*isValueTensor=*/false));
       },
       // between_fn:
       [&] { oss << ", "; },
       // skip_fn:
       [&](const std::shared_ptr<TensorAttr> &output) {
         // We only want the final outputs in the return so ignore any virtual
-        // tensors here as they're intermediates.
-        return output->isVirtual();
+        // tensors here as they're intermediates. In-place outputs overwrite
+        // an input instead.
+        return output->isVirtual() || output->isInPlace();
       });
   return oss.str();
 }
@@ -505,23 +819,314 @@ inline std::string Graph::emitNodePreAsm() const {
 
   constexpr std::string_view schema = R"(
 module @module {{
-  {0}
-  func.func @main({1}, {2}) attributes {{torch.assume_strict_symbolic_shapes}} {{
+  {0})";
+
+  std::string output = std::format(schema,
+                                   moduleScopeOss.str() // {0}
+  );
+
+  return output + getFunctionPreAsm("main");
+}
+
+// Returns the type of the buffer holding a graph input or output with padded
+// strides (see `TensorAttr::hasPaddedStrides()`), e.g.
+// `!torch.vtensor<[4,8],f32>` for dim={4, 6}, stride={8, 1}.
+inline std::string
+getStorageTypeAsm(const std::shared_ptr<TensorAttr> &tensor,
+                  bool isValueTensor = true) {
+  return buildTensorTypeStr(tensor->getStorageDim(), tensor->getDataType(),
+                            isValueTensor);
+}
+
+// Emits the constants shared by the slices of a tensor with padded strides
+// out of (or into) its storage, see `getPaddedInputAsm()`. Returns the dims
+// padded in the storage, in physical order.
+inline std::vector<size_t>
+appendPaddedSliceConstantsAsm(std::string &out,
+                              const std::shared_ptr<TensorAttr> &tensor) {
+  std::string name = tensor->getValueNameAsm();
+  std::vector<int64_t> physicalDims = tensor->getPhysicalDim();
+  std::vector<int64_t> storageDims = tensor->getStorageDim();
+  std::vector<size_t> paddedDims;
+  auto it = std::back_inserter(out);
+  it = std::format_to(it, "\n    {}_slice_start = torch.constant.int 0",
+                      name);
+  it = std::format_to(it, "\n    {}_slice_step = torch.constant.int 1", name);
+  for (size_t i = 0; i < storageDims.size(); ++i) {
+    if (storageDims[i] == physicalDims[i])
+      continue;
+    paddedDims.push_back(i);
+    it = std::format_to(it, "\n    {}_slice_dim_{} = torch.constant.int {}",
+                        name, i, i);
+    it = std::format_to(it, "\n    {}_slice_end_{} = torch.constant.int {}",
+                        name, i, physicalDims[i]);
+  }
+  out += '\n';
+  return paddedDims;
+}
+
+// Emits the slices reading a graph input with padded strides (see
+// `TensorAttr::hasPaddedStrides()`) out of its storage argument
+// `%{name}_storage`, one per padded dim, so nodes read it in place like any
+// other input named `%{name}`.
+//
+// Example output for dim={4, 6}, stride={8, 1}:
+//   %x = torch.aten.slice.Tensor %x_storage, %x_slice_dim_1,
+//       %x_slice_start, %x_slice_end_1, %x_slice_step
+//       : !torch.vtensor<[4,8],f32>, !torch.int, !torch.int, !torch.int,
+//         !torch.int -> !torch.vtensor<[4,6],f32>
+inline std::string
+getPaddedInputAsm(const std::shared_ptr<TensorAttr> &tensor) {
+  constexpr std::string_view schema = R"(
+    {0} = torch.aten.slice.Tensor {1}, {2}_slice_dim_{3}, {2}_slice_start, {2}_slice_end_{3}, {2}_slice_step : {4}, !torch.int, !torch.int, !torch.int, !torch.int -> {5}
+)";
+  std::string name = tensor->getValueNameAsm();
+  std::string out;
+  std::vector<size_t> paddedDims = appendPaddedSliceConstantsAsm(out, tensor);
+  std::vector<int64_t> dims = tensor->getStorageDim();
+  std::vector<int64_t> physicalDims = tensor->getPhysicalDim();
+  std::string operand = name + "_storage";
+  for (size_t i = 0; i < paddedDims.size(); ++i) {
+    size_t dim = paddedDims[i];
+    std::string fromType = buildTensorTypeStr(dims, tensor->getDataType());
+    dims[dim] = physicalDims[dim];
+    std::string result = i + 1 == paddedDims.size()
+                             ? name
+                             : name + "_slice_" + std::to_string(dim);
+    std::format_to(std::back_inserter(out), schema,
+                   result,                                        // {0}
+                   operand,                                       // {1}
+                   name,                                          // {2}
+                   dim,                                           // {3}
+                   fromType,                                      // {4}
+                   buildTensorTypeStr(dims, tensor->getDataType()) // {5}
+    );
+    operand = result;
+  }
+  return out;
+}
+
+// Emits the scatter of a graph output with padded strides (see
+// `TensorAttr::hasPaddedStrides()`) into the current contents of its storage
+// argument `%{name}_`, so the padding is preserved. The result,
+// `%{name}_padded`, overwrites the storage argument.
+//
+// Example output for dim={4, 6}, stride={8, 1}:
+//   %y_storage = torch.copy.to_vtensor %y_ : !torch.vtensor<[4,8],f32>
+//   %y_padded = torch.aten.slice_scatter %y_storage, %y, %y_slice_dim_1,
+//       %y_slice_start, %y_slice_end_1, %y_slice_step
+//       : !torch.vtensor<[4,8],f32>, !torch.vtensor<[4,6],f32>, !torch.int,
+//         !torch.int, !torch.int, !torch.int -> !torch.vtensor<[4,8],f32>
+inline std::string
+getPaddedOutputAsm(const std::shared_ptr<TensorAttr> &tensor) {
+  constexpr std::string_view copySchema = R"(
+    {0}_storage = torch.copy.to_vtensor {1} : {2}
+)";
+  constexpr std::string_view sliceSchema = R"(
+    {0} = torch.aten.slice.Tensor {1}, {2}_slice_dim_{3}, {2}_slice_start, {2}_slice_end_{3}, {2}_slice_step : {4}, !torch.int, !torch.int, !torch.int, !torch.int -> {5}
+)";
+  constexpr std::string_view scatterSchema = R"(
+    {0} = torch.aten.slice_scatter {1}, {2}, {3}_slice_dim_{4}, {3}_slice_start, {3}_slice_end_{4}, {3}_slice_step : {5}, {6}, !torch.int, !torch.int, !torch.int, !torch.int -> {5}
+)";
+  std::string name = tensor->getValueNameAsm();
+  std::string out = std::format(
+      copySchema, name, tensor->getValueNameAsm(/*isOutputAliased=*/true),
+      getStorageTypeAsm(tensor));
+  std::vector<size_t> paddedDims = appendPaddedSliceConstantsAsm(out, tensor);
+  std::vector<int64_t> physicalDims = tensor->getPhysicalDim();
+
+  // Slice the storage down one padded dim at a time (all but the last), then
+  // scatter back up: the value scattered along each padded dim is the slice
+  // taken along it, with the output scattered in last.
+  std::vector<std::string> slices = {name + "_storage"};
+  std::vector<std::vector<int64_t>> sliceDims = {tensor->getStorageDim()};
+  for (size_t i = 0; i + 1 < paddedDims.size(); ++i) {
+    size_t dim = paddedDims[i];
+    std::vector<int64_t> dims = sliceDims.back();
+    dims[dim] = physicalDims[dim];
+    std::string result = name + "_slice_" + std::to_string(dim);
+    std::format_to(std::back_inserter(out), sliceSchema,
+                   result,                                             // {0}
+                   slices.back(),                                      // {1}
+                   name,                                               // {2}
+                   dim,                                                // {3}
+                   buildTensorTypeStr(sliceDims.back(),
+                                      tensor->getDataType()),          // {4}
+                   buildTensorTypeStr(dims, tensor->getDataType())     // {5}
+    );
+    slices.push_back(result);
+    sliceDims.push_back(std::move(dims));
+  }
+  std::string source = name;
+  std::string sourceType = tensor->getTensorTypeAsm();
+  for (size_t i = paddedDims.size(); i-- > 0;) {
+    size_t dim = paddedDims[i];
+    std::string result =
+        i == 0 ? name + "_padded" : name + "_scatter_" + std::to_string(dim);
+    std::string resultType =
+        buildTensorTypeStr(sliceDims[i], tensor->getDataType());
+    std::format_to(std::back_inserter(out), scatterSchema,
+                   result,     // {0}
+                   slices[i],  // {1}
+                   source,     // {2}
+                   name,       // {3}
+                   dim,        // {4}
+                   resultType, // {5}
+                   sourceType  // {6}
+    );
+    source = result;
+    sourceType = resultType;
+  }
+  return out;
+}
+
+// Emits the globals of the external parameters the graph reads (see
+// `TensorAttr::setParameter()`), one entry per parameter, e.g.
+//   util.global private @"model::w" =
+//       #stream.parameter.named<"model"::"w"> : tensor<1x4xf32>
+inline std::vector<std::string> Graph::getParameterGlobalsAsm() const {
+  constexpr std::string_view schema = R"(
+  util.global private {0} = #stream.parameter.named<"{1}"::"{2}"> : {3}
+)";
+  std::set<std::string> seen;
+  std::vector<std::string> globals;
+  for (const auto &input : fullGraphInputsSorted_) {
+    if (!input->isParameter() ||
+        !seen.insert(getParameterGlobalAsm(input)).second)
+      continue;
+    globals.push_back(std::format(schema,
+                                  getParameterGlobalAsm(input),  // {0}
+                                  input->getParameterScope(),    // {1}
+                                  input->getParameterKey(),      // {2}
+                                  getBuiltinTensorTypeAsm(input) // {3}
+                                  ));
+  }
+  return globals;
+}
+
+inline std::string Graph::emitModuleScopeAsm() const {
+  std::string output;
+  for (const auto &global : getParameterGlobalsAsm())
+    output += global;
+  return output;
+}
+
+// Emits the range and divisibility hints of the dynamic dims of graph input
+// `input` (see `TensorAttr::setDynamicDimHint()`) in MLIR assembly format, or
+// an empty string if it has none. Each dynamic dim gets a symbol ranging over
+// its extents divided by the divisor, and the shape of the function argument
+// is bound to the symbols times the divisors in physical dim order, e.g.
+//
+//   %x_dim0 = torch.symbolic_int "x_dim0" {min_val = 1, max_val = 256} : ...
+//   torch.bind_symbolic_shape %x, [%x_dim0],
+//       affine_map<()[s0] -> (s0 * 16, 64)> : !torch.vtensor<[?,64],f16>
+//
+// which the compiler turns into `util.assume.int` ops on the dims.
+inline std::string getDynamicDimHintsAsm(const TensorAttr &input) {
+  const std::map<size_t, DynamicDimHint> &hints = input.getDynamicDimHints();
+  if (std::ranges::none_of(hints, [&](const auto &entry) {
+        return input.isDynamicDim(entry.first);
+      }))
+    return "";
+
+  std::string name = input.getValueNameAsm();
+  std::string out;
+  std::vector<std::string> symbols;
+  std::vector<std::string> shape;
+  std::vector<int64_t> perm = input.getLogicalToPhysicalPermuteOrder();
+  std::vector<int64_t> physicalDim = input.getPhysicalDim();
+  for (size_t i = 0; i < perm.size(); ++i) {
+    auto logical = static_cast<size_t>(perm[i]);
+    if (!input.isDynamicDim(logical)) {
+      shape.push_back(std::to_string(physicalDim[i]));
+      continue;
+    }
+    DynamicDimHint hint = input.getDynamicDimHint(logical);
+    std::string symbol = std::format("{}_dim{}", name, logical);
+    std::format_to(std::back_inserter(out),
+                   "\n    {0} = torch.symbolic_int \"{1}\" {{min_val = {2}, "
+                   "max_val = {3}}} : !torch.int",
+                   symbol, symbol.substr(1),
+                   (hint.min + hint.divisor - 1) / hint.divisor,
+                   hint.max / hint.divisor);
+    std::string expr = std::format("s{}", symbols.size());
+    if (hint.divisor != 1)
+      expr += std::format(" * {}", hint.divisor);
+    shape.push_back(std::move(expr));
+    symbols.push_back(std::move(symbol));
+  }
+
+  auto join = [](const std::vector<std::string> &values) {
+    std::string joined;
+    for (size_t i = 0; i < values.size(); ++i)
+      joined += (i == 0 ? "" : ", ") + values[i];
+    return joined;
+  };
+  std::vector<std::string> symbolIds;
+  for (size_t i = 0; i < symbols.size(); ++i)
+    symbolIds.push_back(std::format("s{}", i));
+  std::format_to(std::back_inserter(out),
+                 "\n    torch.bind_symbolic_shape {0}, [{1}], "
+                 "affine_map<()[{2}] -> ({3})> : {4}\n",
+                 name, join(symbols), join(symbolIds), join(shape),
+                 input.getTensorTypeAsm());
+  return out;
+}
+
+// Emits the signature of the graph function `@entryPoint` and the start of
+// its body. Shared by `emitNodePreAsm()` and `emitFunctionAsm()`, which emits
+// the graph as one function of a multi-function module.
+inline std::string
+Graph::getFunctionPreAsm(const std::string &entryPoint) const {
+  constexpr std::string_view schema = R"(
+  func.func @{0}({1}) attributes {{torch.assume_strict_symbolic_shapes}} {{
   )";
 
+  // Results come first. There are none when every output is in-place.
+  std::string arguments = getResultNamesAndTypesAsm();
+  if (!arguments.empty())
+    arguments += ", ";
+  arguments += getOperandNamesAndTypesAsm();
+
   std::string output = std::format(schema,
-                                   moduleScopeOss.str(),        // {0}
-                                   getResultNamesAndTypesAsm(), // {1}
-                                   getOperandNamesAndTypesAsm() // {2}
+                                   entryPoint, // {0}
+                                   arguments   // {1}
   );
 
-  // Emit scalar constants (`torch.vtensor.literal`) for all scalar graph inputs
-  // at the top of the function body.
+  // Emit scalar constants (`torch.vtensor.literal`) for all scalar graph
+  // inputs, tensor literals for inputs with constant data, global loads for
+  // parameters and slices of inputs with padded strides at the top of the
+  // function body.
   for (const auto &input : fullGraphInputsSorted_) {
-    if (input->isScalar())
+    if (input->isInlinedScalar())
       output += getScalarConstantAsm(input);
+    else if (input->hasConstantData())
+      output += getConstantDataAsm(input);
+    else if (input->isParameter())
+      output += getParameterLoadAsm(input);
+    else if (input->hasPaddedStrides())
+      output += getPaddedInputAsm(input);
+  }
+
+  // Read the value of inputs overwritten by in-place outputs.
+  constexpr std::string_view copySchema = R"(
+    {0} = torch.copy.to_vtensor {1} : {2}
+)";
+  for (const auto &input : fullGraphInputsSorted_) {
+    if (isInPlaceDonor(input))
+      output += std::format(
+          copySchema,
+          input->getValueNameAsm(),                          // {0}
+          input->getValueNameAsm(/*isOutputAliased=*/true),  // {1}
+          input->getTensorTypeAsm(/*isValueTensor=*/true)    // {2}
+      );
   }
 
+  // Bind the hints of dynamic dims to the arguments they constrain.
+  for (const auto &input : fullGraphInputsSorted_)
+    if (!input->isEmbedded())
+      output += getDynamicDimHintsAsm(*input);
+
   return output;
 }
 
@@ -532,15 +1137,39 @@ module @module {{
 // schema, take extra caution about double bracing the curly brackets
 // (refer to the comments at the top of this file for details).
 inline std::string Graph::emitNodePostAsm() const {
+  constexpr std::string_view schema = R"(
+}}
+  )";
+
+  return getFunctionPostAsm() + std::format(schema);
+}
+
+// Emits the end of the body of the graph function, see `getFunctionPreAsm()`.
+inline std::string Graph::getFunctionPostAsm() const {
   std::ostringstream oss;
+  // Outputs with padded strides are scattered into their storage first.
+  for (const auto &output : fullGraphOutputsSorted_)
+    if (!output->isVirtual() && output->hasPaddedStrides())
+      oss << getPaddedOutputAsm(output);
   interleave(
       fullGraphOutputsSorted_.begin(), fullGraphOutputsSorted_.end(),
       // each_fn:
       [&](const std::shared_ptr<TensorAttr> &output) {
+        // An in-place output overwrites its input.
+        const std::shared_ptr<TensorAttr> &target =
+            output->isInPlace() ? output->getInPlace() : output;
+        if (output->hasPaddedStrides()) {
+          oss << "torch.overwrite.tensor.contents "
+              << output->getValueNameAsm() << "_padded overwrites "
+              << output->getValueNameAsm(/*isOutputAliased=*/true) << " : "
+              << getStorageTypeAsm(output) << ", "
+              << getStorageTypeAsm(output, /*isValueTensor=*/false);
+          return;
+        }
         oss << "torch.overwrite.tensor.contents "
             << output->getValueNameAsm(/*isOutputAliased=*/false)
             << " overwrites "
-            << output->getValueNameAsm(/*isOutputAliased=*/true) << " : "
+            << target->getValueNameAsm(/*isOutputAliased=*/true) << " : "
             << output->getTensorTypeAsm(/*isValueTensor=*/true) << ", "
             << output->getTensorTypeAsm(/*isValueTensor=*/false);
       },
@@ -557,9 +1186,7 @@ inline std::string Graph::emitNodePostAsm() const {
     {0}
 
     return
-  }}
-}}
-  )";
+  }})";
 
   std::string output = std::format(schema,
                                    oss.str() // {0}
@@ -583,11 +1210,18 @@ inline std::string Graph::emitNodePostAsm() const {
 //
 // The unique suffix is included to ensure SSA uniqueness when the same
 // tensor is used by multiple operations.
+//
+// A depthwise convolution with a channel multiplier greater than 1 takes the
+// replicated input `%dw_x_{suffix}` (see `getDepthwiseInputOpsAsm()`).
 inline std::string ConvFPropNode::getOperandNamesAsm() const {
   std::string suffix = convFPropAttr.getName();
-  return convFPropAttr.getX()->getValueNameAsm() + "_" + suffix + "_perm" +
-         ", " + convFPropAttr.getW()->getValueNameAsm() + "_" + suffix +
-         "_perm";
+  std::string filterName =
+      convFPropAttr.getW()->getValueNameAsm() + "_" + suffix + "_perm";
+  std::string inputName =
+      isDepthwise() && getDepthwiseMultiplier() > 1
+          ? "%dw_x_" + suffix
+          : convFPropAttr.getX()->getValueNameAsm() + "_" + suffix + "_perm";
+  return inputName + ", " + filterName;
 }
 
 // Emits ConvFPropNode's operand types in MLIR assembly format.
@@ -597,9 +1231,17 @@ inline std::string ConvFPropNode::getOperandNamesAsm() const {
 // with
 //      "!torch.vtensor<[16,128,64,64],f32>, !torch.vtensor<[256,128,1,1],f32>"
 inline std::string ConvFPropNode::getOperandTypesAsm() const {
-  return convFPropAttr.getX()->getTensorTypeAsm(/*isValueTensor=*/true,
-                                                /*useLogicalDims=*/true) +
-         ", " +
+  std::shared_ptr<TensorAttr> xT = convFPropAttr.getX();
+  std::string inputType;
+  if (isDepthwise() && getDepthwiseMultiplier() > 1) {
+    std::vector<int64_t> dim = xT->getDim();
+    dim[1] = convFPropAttr.getW()->getDim()[0];
+    inputType = buildTensorTypeStr(dim, xT->getDataType());
+  } else {
+    inputType = xT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                     /*useLogicalDims=*/true);
+  }
+  return inputType + ", " +
          convFPropAttr.getW()->getTensorTypeAsm(/*isValueTensor=*/true,
                                                 /*useLogicalDims=*/true);
 }
@@ -636,10 +1278,71 @@ inline std::string ConvFPropNode::getGroupOpsAsm() const {
   int64_t inChannels = convFPropAttr.getX()->getDim()[channelsIdx];
   int64_t filterChannels = convFPropAttr.getW()->getDim()[channelsIdx];
   int64_t groupCount = inChannels / filterChannels;
+  // The replicated input of a depthwise convolution (see
+  // `getDepthwiseInputOpsAsm()`) has a group per output channel.
+  if (isDepthwise())
+    groupCount *= getDepthwiseMultiplier();
 
   return torchIntAsm("groups", convFPropAttr.getName(), groupCount);
 }
 
+// Emits the input of a depthwise convolution with a channel multiplier m > 1
+// in MLIR assembly format. torch-mlir only lowers a depthwise convolution to
+// the dedicated `linalg.depthwise_conv_*` ops when every group has a single
+// output channel, and to the generic grouped convolution otherwise. Repeating
+// every input channel m times, e.g. for X [N,C,H,W]
+//
+//   %dw_unsqueeze_conv = torch.aten.view %x_conv_perm, %dw_unsqueeze_shape_conv
+//                          -> [N,C,1,H,W]
+//   %dw_expand_conv = torch.aten.expand %dw_unsqueeze_conv, ... -> [N,C,m,H,W]
+//   %dw_x_conv = torch.aten.view %dw_expand_conv, ... -> [N,C*m,H,W]
+//
+// makes it a depthwise convolution with a multiplier of 1 and C*m groups
+// whose group k reads input channel k / m, as before. The expansion is a
+// broadcast that is fused into the convolution, so the replicated input is
+// not materialized.
+inline std::string ConvFPropNode::getDepthwiseInputOpsAsm() const {
+  if (!isDepthwise() || getDepthwiseMultiplier() == 1)
+    return "";
+
+  std::string suffix = convFPropAttr.getName();
+  std::shared_ptr<TensorAttr> xT = convFPropAttr.getX();
+  const std::vector<int64_t> &xDim = xT->getDim();
+  int64_t multiplier = getDepthwiseMultiplier();
+
+  std::vector<int64_t> unsqueezeDim = xDim;
+  unsqueezeDim.insert(unsqueezeDim.begin() + 2, 1);
+  std::vector<int64_t> expandDim = unsqueezeDim;
+  expandDim[2] = multiplier;
+  std::vector<int64_t> replicatedDim = xDim;
+  replicatedDim[1] = xDim[1] * multiplier;
+
+  constexpr std::string_view schema = R"(
+    {1}
+    %dw_unsqueeze_{0} = torch.aten.view {2}_{0}_perm, %dw_unsqueeze_shape_{0} : {3}, !torch.list<int> -> {4}
+    {5}
+    %dw_implicit_{0} = torch.constant.bool false
+    %dw_expand_{0} = torch.aten.expand %dw_unsqueeze_{0}, %dw_expand_shape_{0}, %dw_implicit_{0} : {4}, !torch.list<int>, !torch.bool -> {6}
+    {7}
+    %dw_x_{0} = torch.aten.view %dw_expand_{0}, %dw_x_shape_{0} : {6}, !torch.list<int> -> {8}
+    )";
+
+  DataType dataType = xT->getDataType();
+  return std::format(
+      schema,
+      suffix,                                                             // {0}
+      getListOfIntOpsAsm(unsqueezeDim, "dw_unsqueeze_shape", suffix),     // {1}
+      xT->getValueNameAsm(),                                              // {2}
+      xT->getTensorTypeAsm(/*isValueTensor=*/true,
+                           /*useLogicalDims=*/true),                      // {3}
+      buildTensorTypeStr(unsqueezeDim, dataType),                         // {4}
+      getListOfIntOpsAsm(expandDim, "dw_expand_shape", suffix),           // {5}
+      buildTensorTypeStr(expandDim, dataType),                            // {6}
+      getListOfIntOpsAsm(replicatedDim, "dw_x_shape", suffix),            // {7}
+      buildTensorTypeStr(replicatedDim, dataType)                         // {8}
+  );
+}
+
 // Get strides in MLIR assembly format.
 inline std::string ConvFPropNode::getStrideOpsAsm() const {
   return getListOfIntOpsAsm(convFPropAttr.getStride(), /*prefix=*/"stride",
@@ -688,7 +1391,7 @@ inline std::string ConvFPropNode::emitNodePreAsm() const {
   //    );
   //   ...
   constexpr std::string_view schema = R"(
-    %bias_{0} = torch.constant.none
+    {14}
     %transposed_{0} = torch.constant.bool false
     %output_padding_{0} = torch.prim.ListConstruct  : () -> !torch.list<int>
     {1}
@@ -697,7 +1400,9 @@ inline std::string ConvFPropNode::emitNodePreAsm() const {
     {4}
     {5}
     {6}
-    {7} = torch.aten.convolution {8}, %bias_{0}, %stride_{0}, %padding_{0}, %dilation_{0}, %transposed_{0}, %output_padding_{0}, %groups_{0} : {9}, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> {10}
+    {16}
+    {7} = torch.aten.convolution {8}, {12}, %stride_{0}, %padding_{0}, %dilation_{0}, %transposed_{0}, %output_padding_{0}, %groups_{0} : {9}, {13}, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> {10}
+    {15}
     {11}
     )";
 
@@ -711,20 +1416,53 @@ inline std::string ConvFPropNode::emitNodePreAsm() const {
       convFPropAttr.getW(), "permute_W", uniqueSSASuffix, /*isInput=*/true);
   std::string permuteY = getLayoutConversionOpsAsm(
       convFPropAttr.getY(), "permute_Y", uniqueSSASuffix, /*isInput=*/false);
+  // The bias is the constant of a folded batch normalization (see
+  // `ConvFPropNode::foldBatchNorm()`), emitted with the graph inputs, or none.
+  std::string biasName =
+      foldedBias_ ? foldedBias_->getValueNameAsm() : "%bias_" + uniqueSSASuffix;
+  std::string biasType =
+      foldedBias_ ? foldedBias_->getTensorTypeAsm() : "!torch.none";
+  std::string biasNone =
+      foldedBias_ ? "" : torchNoneAsm("bias", uniqueSSASuffix);
+
+  // With scales the convolution accumulates the quantized operands in a
+  // wider type, and the dequantized accumulator is the result.
+  std::string convName = getResultNamesAsm();
+  std::string convType = getResultTypesAsm();
+  std::string dequantize;
+  if (convFPropAttr.hasScales()) {
+    std::shared_ptr<TensorAttr> yT = convFPropAttr.getY();
+    DataType accType =
+        getQuantizedAccumulatorType(convFPropAttr.getX()->getDataType());
+    std::vector<std::pair<std::string, std::shared_ptr<TensorAttr>>> scales;
+    if (convFPropAttr.getSCALE_X())
+      scales.emplace_back("SCALE_X", convFPropAttr.getSCALE_X());
+    if (convFPropAttr.getSCALE_W())
+      scales.emplace_back("SCALE_W", convFPropAttr.getSCALE_W());
+    convName = "%conv_acc_" + uniqueSSASuffix;
+    convType = buildTensorTypeStr(yT->getDim(), accType);
+    dequantize = getDequantizeOpsAsm(convName, accType, scales, yT,
+                                     getResultNamesAsm(), uniqueSSASuffix);
+  }
 
   std::string output = std::format(schema,
-                                   uniqueSSASuffix,      // {0}
-                                   getGroupOpsAsm(),     // {1}
-                                   getStrideOpsAsm(),    // {2}
-                                   getPaddingOpsAsm(),   // {3}
-                                   getDilationOpsAsm(),  // {4}
-                                   permuteX,             // {5}
-                                   permuteW,             // {6}
-                                   getResultNamesAsm(),  // {7}
-                                   getOperandNamesAsm(), // {8}
-                                   getOperandTypesAsm(), // {9}
-                                   getResultTypesAsm(),  // {10}
-                                   permuteY              // {11}
+                                   uniqueSSASuffix,            // {0}
+                                   getGroupOpsAsm(),           // {1}
+                                   getStrideOpsAsm(),          // {2}
+                                   getPaddingOpsAsm(),         // {3}
+                                   getDilationOpsAsm(),        // {4}
+                                   permuteX,                   // {5}
+                                   permuteW,                   // {6}
+                                   convName,                   // {7}
+                                   getOperandNamesAsm(),       // {8}
+                                   getOperandTypesAsm(),       // {9}
+                                   convType,                   // {10}
+                                   permuteY,                   // {11}
+                                   biasName,                   // {12}
+                                   biasType,                   // {13}
+                                   biasNone,                   // {14}
+                                   dequantize,                 // {15}
+                                   getDepthwiseInputOpsAsm()   // {16}
   );
 
   return output;
@@ -855,7 +1593,7 @@ inline std::string ConvWGradNode::getPermuteEmptyWOpsAsm() const {
 
 inline std::string ConvWGradNode::emitNodePreAsm() const {
   constexpr std::string_view schema = R"(
-    %bias_{0} = torch.constant.none
+    {13}
     %transposed_{0} = torch.constant.bool false
     %output_padding_{0} = torch.prim.ListConstruct  : () -> !torch.list<int>
     {1}
@@ -867,9 +1605,10 @@ inline std::string ConvWGradNode::emitNodePreAsm() const {
     {7}
     %true_{0} = torch.constant.bool true
     %false_{0} = torch.constant.bool false
-    %output_mask_{0} = torch.prim.ListConstruct %false_{0}, %true_{0}, %false_{0} : (!torch.bool, !torch.bool, !torch.bool) -> !torch.list<bool>
-    %grad_input_{0}, {8}, %grad_bias_{0} = torch.aten.convolution_backward {9}, %bias_{0}, %stride_{0}, %padding_{0}, %dilation_{0}, %transposed_{0}, %output_padding_{0}, %groups_{0}, %output_mask_{0} : {10}, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int, !torch.list<bool> -> !torch.none, {11}, !torch.none
+    %output_mask_{0} = torch.prim.ListConstruct %false_{0}, %true_{0}, {14} : (!torch.bool, !torch.bool, !torch.bool) -> !torch.list<bool>
+    %grad_input_{0}, {8}, {15} = torch.aten.convolution_backward {9}, %bias_{0}, %stride_{0}, %padding_{0}, %dilation_{0}, %transposed_{0}, %output_padding_{0}, %groups_{0}, %output_mask_{0} : {10}, {16}, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int, !torch.list<bool> -> !torch.none, {11}, {17}
     {12}
+    {18}
     )";
 
   // Suffix the SSA names of internal values (constant attributes) using
@@ -883,6 +1622,25 @@ inline std::string ConvWGradNode::emitNodePreAsm() const {
   std::string permuteDW = getLayoutConversionOpsAsm(
       convWGradAttr.getDW(), "permute_DW", uniqueSSASuffix, /*isInput=*/false);
 
+  // With a bias gradient the op also reduces DY into DBIAS, enabled by the
+  // last element of the output mask and the bias sizes [K].
+  std::string biasSizes = "%bias_" + uniqueSSASuffix + " = torch.constant.none";
+  std::string biasMask = "%false_" + uniqueSSASuffix;
+  std::string gradBiasName = "%grad_bias_" + uniqueSSASuffix;
+  std::string biasSizesType = "!torch.none";
+  std::string gradBiasType = "!torch.none";
+  std::string permuteDB;
+  if (std::shared_ptr<TensorAttr> dbT = convWGradAttr.getDBIAS()) {
+    biasSizes = getListOfIntOpsAsm(dbT->getDim(), "bias", uniqueSSASuffix);
+    biasMask = "%true_" + uniqueSSASuffix;
+    gradBiasName = dbT->getValueNameAsm() + "_" + uniqueSSASuffix + "_perm";
+    biasSizesType = "!torch.list<int>";
+    gradBiasType =
+        dbT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+    permuteDB = getLayoutConversionOpsAsm(dbT, "permute_DBIAS",
+                                          uniqueSSASuffix, /*isInput=*/false);
+  }
+
   std::string output = std::format(schema,
                                    uniqueSSASuffix,          // {0}
                                    getGroupOpsAsm(),         // {1}
@@ -896,7 +1654,13 @@ inline std::string ConvWGradNode::emitNodePreAsm() const {
                                    getOperandNamesAsm(),     // {9}
                                    getOperandTypesAsm(),     // {10}
                                    getResultTypesAsm(),      // {11}
-                                   permuteDW                 // {12}
+                                   permuteDW,                // {12}
+                                   biasSizes,                // {13}
+                                   biasMask,                 // {14}
+                                   gradBiasName,             // {15}
+                                   biasSizesType,            // {16}
+                                   gradBiasType,             // {17}
+                                   permuteDB                 // {18}
   );
 
   return output;
@@ -1065,45 +1829,169 @@ inline std::string ConvDGradNode::emitNodePreAsm() const {
 
 //===----------------------------------------------------------------------===//
 //
-// BatchNormNode ASM Emitter Methods
-//
-// Both inference and training modes emit `torch.aten.native_batch_norm`, which
-// always returns three results: (output, saved_mean, saved_invstd). For
-// inference, training=false and the last two results are discarded. For
-// training, training=true and all three results are named outputs.
-//
-// Example (inference, NCHW [4,16,8,8] input, no scale/bias):
-//
-//   %eps_bn = torch.aten.item %EPSILON : !torch.vtensor<[1],f32> ->
-//   !torch.float %momentum_bn = torch.aten.item %MOMENTUM :
-//   !torch.vtensor<[1],f32> -> !torch.float %permute_x_val_0_bn =
-//   torch.constant.int 0
-//   ...
-//   %X_bn_perm = torch.aten.permute %X, %permute_x_bn : ...
-//   %none_scale_bn = torch.constant.none
-//   %none_bias_bn = torch.constant.none
-//   %training_bn = torch.constant.bool false
-//   %Y_bn_perm, %_infer_saved_mean_bn_perm, %_infer_saved_invstd_bn_perm =
-//       torch.aten.native_batch_norm %X_bn_perm, %none_scale_bn, %none_bias_bn,
-//           %MEAN, %VAR, %training_bn, %momentum_bn, %eps_bn : ... -> ...
-//   %Y = torch.aten.permute %Y_bn_perm, %permute_y_bn : ...
+// ConvTransposeNode ASM Emitter Methods
 //
 //===----------------------------------------------------------------------===//
 
-// Emits BatchNormNode's operand names in MLIR assembly format.
-//
-// The operand order for torch.aten.batch_norm / torch.aten.native_batch_norm:
-//   input, weight?, bias?, running_mean?, running_var?, training, momentum, eps
-//   (batch_norm also takes cudnn_enabled)
+// Emits ConvTransposeNode's operand names in MLIR assembly format.
 //
-// For 1D tensors (scale, bias, mean, var) no permutation is applied; they are
-// referenced directly by their SSA value name.
-inline std::string BatchNormNode::getOperandNamesAsm() const {
-  std::ostringstream oss;
-  std::string suffix = batchnormAttr.getName();
+// The unique suffix is included to ensure SSA uniqueness when the same
+// tensor is used by multiple operations.
+inline std::string ConvTransposeNode::getOperandNamesAsm() const {
+  std::string suffix = convTransposeAttr.getName();
+  return convTransposeAttr.getX()->getValueNameAsm() + "_" + suffix +
+         "_perm, " + convTransposeAttr.getW()->getValueNameAsm() + "_" +
+         suffix + "_perm";
+}
 
-  // Input X (permuted to logical NCHW).
-  oss << batchnormAttr.getX()->getValueNameAsm() << "_" << suffix << "_perm, ";
+// Emits ConvTransposeNode's operand types in MLIR assembly format.
+inline std::string ConvTransposeNode::getOperandTypesAsm() const {
+  return convTransposeAttr.getX()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                    /*useLogicalDims=*/true) +
+         ", " +
+         convTransposeAttr.getW()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                    /*useLogicalDims=*/true);
+}
+
+// Emits ConvTransposeNode's result names in MLIR assembly format.
+//
+// The unique suffix and "_perm" are included to ensure SSA uniqueness when
+// the same tensor is used by multiple operations. This intermediate result
+// is then used by the output permute.
+inline std::string ConvTransposeNode::getResultNamesAsm() const {
+  return convTransposeAttr.getY()->getValueNameAsm() + "_" +
+         convTransposeAttr.getName() + "_perm";
+}
+
+// Emits ConvTransposeNode's result types in MLIR assembly format.
+inline std::string ConvTransposeNode::getResultTypesAsm() const {
+  return convTransposeAttr.getY()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                    /*useLogicalDims=*/true);
+}
+
+// Get groups in MLIR assembly format.
+inline std::string ConvTransposeNode::getGroupOpsAsm() const {
+  return torchIntAsm("groups", convTransposeAttr.getName(),
+                     convTransposeAttr.getGroupCount());
+}
+
+// Get strides in MLIR assembly format.
+inline std::string ConvTransposeNode::getStrideOpsAsm() const {
+  return getListOfIntOpsAsm(convTransposeAttr.getStride(), /*prefix=*/"stride",
+                            /*suffix=*/convTransposeAttr.getName());
+}
+
+// Get padding in MLIR assembly format.
+inline std::string ConvTransposeNode::getPaddingOpsAsm() const {
+  return getListOfIntOpsAsm(convTransposeAttr.getPadding(),
+                            /*prefix=*/"padding",
+                            /*suffix=*/convTransposeAttr.getName());
+}
+
+// Get dilation in MLIR assembly format.
+inline std::string ConvTransposeNode::getDilationOpsAsm() const {
+  return getListOfIntOpsAsm(convTransposeAttr.getDilation(),
+                            /*prefix=*/"dilation",
+                            /*suffix=*/convTransposeAttr.getName());
+}
+
+// Get output padding in MLIR assembly format.
+inline std::string ConvTransposeNode::getOutputPaddingOpsAsm() const {
+  return getListOfIntOpsAsm(getOutputPadding(), /*prefix=*/"output_padding",
+                            /*suffix=*/convTransposeAttr.getName());
+}
+
+// Emits a single `torch.aten.convolution` with `transposed` set, which
+// torch-mlir lowers to a convolution over the input dilated by the stride
+// with the flipped filter, instead of the `convolution_backward` with an
+// empty image operand that `ConvDGradNode` needs. The filter keeps the
+// transposed layout [C, K/G, ...] of torch.
+inline std::string ConvTransposeNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    %bias_{0} = torch.constant.none
+    %transposed_{0} = torch.constant.bool true
+    {1}
+    {2}
+    {3}
+    {4}
+    {5}
+    {6}
+    {7}
+    {8} = torch.aten.convolution {9}, %bias_{0}, %stride_{0}, %padding_{0}, %dilation_{0}, %transposed_{0}, %output_padding_{0}, %groups_{0} : {10}, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> {11}
+    {12}
+    )";
+
+  // Suffix the SSA names of internal values (constant attributes) using
+  // the unique ConvTransposeAttr name to avoid re-definition of names across
+  // the overall MLIR assembly.
+  std::string uniqueSSASuffix = convTransposeAttr.getName();
+  std::string permuteX = getLayoutConversionOpsAsm(
+      convTransposeAttr.getX(), "permute_X", uniqueSSASuffix, /*isInput=*/true);
+  std::string permuteW = getLayoutConversionOpsAsm(
+      convTransposeAttr.getW(), "permute_W", uniqueSSASuffix, /*isInput=*/true);
+  std::string permuteY =
+      getLayoutConversionOpsAsm(convTransposeAttr.getY(), "permute_Y",
+                                uniqueSSASuffix, /*isInput=*/false);
+
+  std::string output = std::format(schema,
+                                   uniqueSSASuffix,          // {0}
+                                   getGroupOpsAsm(),         // {1}
+                                   getStrideOpsAsm(),        // {2}
+                                   getPaddingOpsAsm(),       // {3}
+                                   getDilationOpsAsm(),      // {4}
+                                   getOutputPaddingOpsAsm(), // {5}
+                                   permuteX,                 // {6}
+                                   permuteW,                 // {7}
+                                   getResultNamesAsm(),      // {8}
+                                   getOperandNamesAsm(),     // {9}
+                                   getOperandTypesAsm(),     // {10}
+                                   getResultTypesAsm(),      // {11}
+                                   permuteY                  // {12}
+  );
+  return output;
+}
+
+//===----------------------------------------------------------------------===//
+//
+// BatchNormNode ASM Emitter Methods
+//
+// Both inference and training modes emit `torch.aten.native_batch_norm`, which
+// always returns three results: (output, saved_mean, saved_invstd). For
+// inference, training=false and the last two results are discarded. For
+// training, training=true and all three results are named outputs.
+//
+// Example (inference, NCHW [4,16,8,8] input, no scale/bias):
+//
+//   %eps_bn = torch.aten.item %EPSILON : !torch.vtensor<[1],f32> ->
+//   !torch.float %momentum_bn = torch.aten.item %MOMENTUM :
+//   !torch.vtensor<[1],f32> -> !torch.float %permute_x_val_0_bn =
+//   torch.constant.int 0
+//   ...
+//   %X_bn_perm = torch.aten.permute %X, %permute_x_bn : ...
+//   %none_scale_bn = torch.constant.none
+//   %none_bias_bn = torch.constant.none
+//   %training_bn = torch.constant.bool false
+//   %Y_bn_perm, %_infer_saved_mean_bn_perm, %_infer_saved_invstd_bn_perm =
+//       torch.aten.native_batch_norm %X_bn_perm, %none_scale_bn, %none_bias_bn,
+//           %MEAN, %VAR, %training_bn, %momentum_bn, %eps_bn : ... -> ...
+//   %Y = torch.aten.permute %Y_bn_perm, %permute_y_bn : ...
+//
+//===----------------------------------------------------------------------===//
+
+// Emits BatchNormNode's operand names in MLIR assembly format.
+//
+// The operand order for torch.aten.batch_norm / torch.aten.native_batch_norm:
+//   input, weight?, bias?, running_mean?, running_var?, training, momentum, eps
+//   (batch_norm also takes cudnn_enabled)
+//
+// For 1D tensors (scale, bias, mean, var) no permutation is applied; they are
+// referenced directly by their SSA value name.
+inline std::string BatchNormNode::getOperandNamesAsm() const {
+  std::ostringstream oss;
+  std::string suffix = batchnormAttr.getName();
+
+  // Input X (permuted to logical NCHW).
+  oss << batchnormAttr.getX()->getValueNameAsm() << "_" << suffix << "_perm, ";
 
   // Optional scale / bias (1D, referenced directly).
   auto getOptional1DName = [&](const std::shared_ptr<TensorAttr> &t,
@@ -1307,12 +2195,266 @@ inline std::string BatchNormNode::emitNodePreAsm() const {
   );
 }
 
+//===----------------------------------------------------------------------===//
+//
+// BatchNormBwdNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits the MLIR assembly for the BatchNormBwdNode. The gradients are computed
+// in f32 on the permuted (logical NCHW) operands. With
+// xhat = (X - SAVED_MEAN) * SAVED_INV_VARIANCE and M the element count per
+// channel,
+//   DBIAS = sum(DY),  DSCALE = sum(DY * xhat),
+//   DX = SCALE * SAVED_INV_VARIANCE * (DY - DBIAS / M - xhat * DSCALE / M),
+// where the sums are over all but the channel dimension: DX reuses the two
+// reductions of the parameter gradients, which read DY and X in a single pass.
+// With Y, DY is first masked by the ReLU backward (`threshold_backward` at 0).
+// The 1D channel tensors are viewed as [1, C, 1, ...] to broadcast.
+inline std::string BatchNormBwdNode::emitNodePreAsm() const {
+  std::string suffix = batchnormBwdAttr.getName();
+  std::shared_ptr<TensorAttr> dyT = batchnormBwdAttr.getDY();
+  std::shared_ptr<TensorAttr> xT = batchnormBwdAttr.getX();
+  std::shared_ptr<TensorAttr> yT = batchnormBwdAttr.getY();
+  std::shared_ptr<TensorAttr> sT = batchnormBwdAttr.getSCALE();
+  std::shared_ptr<TensorAttr> dxT = batchnormBwdAttr.getDX();
+  std::shared_ptr<TensorAttr> dsT = batchnormBwdAttr.getDSCALE();
+  std::shared_ptr<TensorAttr> dbT = batchnormBwdAttr.getDBIAS();
+
+  const std::vector<int64_t> &xDim = xT->getDim();
+  int64_t channels = xDim[1];
+  std::vector<int64_t> reduceDims = {0};
+  std::vector<int64_t> channelDim(xDim.size(), 1);
+  channelDim[1] = channels;
+  int64_t count = xDim[0];
+  for (size_t d = 2; d < xDim.size(); ++d) {
+    reduceDims.push_back(static_cast<int64_t>(d));
+    count *= xDim[d];
+  }
+  std::string xType = buildTensorTypeStr(xDim, DataType::Float);
+  std::string channelType = buildTensorTypeStr(channelDim, DataType::Float);
+  std::string vectorType = buildTensorTypeStr({channels}, DataType::Float);
+
+  // Each group of layout conversion ops is followed by a line break so that
+  // the next one starts at op indentation.
+  auto permute = [&](const std::shared_ptr<TensorAttr> &t,
+                     const std::string &prefix, bool isInput) {
+    return t ? getLayoutConversionOpsAsm(t, prefix, suffix, isInput) + "\n    "
+             : "";
+  };
+  std::string permuteInputs = permute(dyT, "permute_dy", /*isInput=*/true) +
+                              permute(xT, "permute_x", /*isInput=*/true) +
+                              permute(yT, "permute_y", /*isInput=*/true);
+  std::string permuteOutputs =
+      permute(dxT, "permute_dx", /*isInput=*/false) +
+      permute(dsT, "permute_dscale", /*isInput=*/false) +
+      permute(dbT, "permute_dbias", /*isInput=*/false);
+
+  constexpr std::string_view setupSchema = R"(
+    %bwd_int1_{0} = torch.constant.int 1
+    %bwd_f32_{0} = torch.constant.int {1}
+    %bwd_false_{0} = torch.constant.bool false
+    %bwd_true_{0} = torch.constant.bool true
+    %bwd_none_{0} = torch.constant.none
+    %bwd_count_{0} = torch.constant.float {2:e}
+    {3}
+    {4}
+    {5}
+)";
+  std::string ops = std::format(
+      setupSchema, suffix,
+      static_cast<int>(kDataTypeToTorchType.at(DataType::Float)),
+      static_cast<double>(count),
+      getListOfIntOpsAsm(reduceDims, "bwd_reduce_dims", suffix),
+      getListOfIntOpsAsm(channelDim, "bwd_channel_shape", suffix),
+      getListOfIntOpsAsm({channels}, "bwd_vector_shape", suffix));
+
+  auto append = [&](std::string_view line) {
+    ops += "    ";
+    ops += line;
+    ops += '\n';
+  };
+  auto value = [&](const std::string &name) {
+    return "%bwd_" + name + "_" + suffix;
+  };
+  // Casts `operand` of input `t` to f32 into `%bwd_{name}_{suffix}`.
+  auto toF32 = [&](const std::string &name, const std::string &operand,
+                   const std::shared_ptr<TensorAttr> &t) {
+    append(std::format(
+        "{0} = torch.aten.to.dtype {1}, %bwd_f32_{2}, %bwd_false_{2}, "
+        "%bwd_false_{2}, %bwd_none_{2} : {3}, !torch.int, !torch.bool, "
+        "!torch.bool, !torch.none -> {4}",
+        value(name), operand, suffix,
+        t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true),
+        buildTensorTypeStr(t->getDim(), DataType::Float)));
+    return value(name);
+  };
+  auto permuted = [&](const std::shared_ptr<TensorAttr> &t) {
+    return t->getValueNameAsm() + "_" + suffix + "_perm";
+  };
+  // Casts the f32 `operand` to the permuted result of the output `t`.
+  auto fromF32 = [&](const std::string &name, const std::string &operand,
+                     const std::shared_ptr<TensorAttr> &t) {
+    append(std::format(
+        "{0} = torch.constant.int {1}", value(name + "_dtype"),
+        static_cast<int>(kDataTypeToTorchType.at(t->getDataType()))));
+    append(std::format(
+        "{0} = torch.aten.to.dtype {1}, {2}, %bwd_false_{3}, "
+        "%bwd_false_{3}, %bwd_none_{3} : {4}, !torch.int, !torch.bool, "
+        "!torch.bool, !torch.none -> {5}",
+        permuted(t), operand, value(name + "_dtype"), suffix,
+        buildTensorTypeStr(t->getDim(), DataType::Float),
+        t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true)));
+  };
+  // Views `operand` of type `fromType` with the shape list `shape`.
+  auto view = [&](const std::string &name, const std::string &operand,
+                  const std::string &fromType, std::string_view shape,
+                  const std::string &toType) {
+    append(std::format("{0} = torch.aten.view {1}, %bwd_{2}_{3} : {4}, "
+                       "!torch.list<int> -> {5}",
+                       value(name), operand, shape, suffix, fromType, toType));
+    return value(name);
+  };
+  // Elementwise `op` of `a` and `b` (broadcast to `a`) into
+  // `%bwd_{name}_{suffix}`.
+  auto binary = [&](std::string_view op, const std::string &name,
+                    const std::string &a, const std::string &aType,
+                    const std::string &b, const std::string &bType) {
+    bool isSub = op == "sub";
+    append(std::format("{0} = torch.aten.{1}.Tensor {2}, {3}{4} : {5}, {6}{7} "
+                       "-> {5}",
+                       value(name), op, a, b,
+                       isSub ? ", %bwd_int1_" + suffix : "", aType, bType,
+                       isSub ? ", !torch.int" : ""));
+    return value(name);
+  };
+  // Sum of `operand` over all but the channel dim, keeping them.
+  auto sum = [&](const std::string &name, const std::string &operand) {
+    append(std::format("{0} = torch.aten.sum.dim_IntList {1}, "
+                       "%bwd_reduce_dims_{2}, %bwd_true_{2}, %bwd_none_{2} : "
+                       "{3}, !torch.list<int>, !torch.bool, !torch.none -> {4}",
+                       value(name), operand, suffix, xType, channelType));
+    return value(name);
+  };
+  // Per channel `operand` divided by the element count per channel.
+  auto perElement = [&](const std::string &name, const std::string &operand) {
+    append(std::format("{0} = torch.aten.div.Scalar {1}, %bwd_count_{2} : "
+                       "{3}, !torch.float -> {3}",
+                       value(name), operand, suffix, channelType));
+    return value(name);
+  };
+  // Casts the 1D channel input `t` to f32 and views it as [1, C, 1, ...].
+  auto channelInput = [&](const std::string &name,
+                          const std::shared_ptr<TensorAttr> &t) {
+    return view(name, toF32(name + "_1d", t->getValueNameAsm(), t),
+                vectorType, "channel_shape", channelType);
+  };
+
+  std::string dy = toF32("dy", permuted(dyT), dyT);
+  if (yT) {
+    std::string y = toF32("y", permuted(yT), yT);
+    append(std::format("{0} = torch.constant.int 0", value("relu_threshold")));
+    append(std::format("{0} = torch.aten.threshold_backward {1}, {2}, {3} : "
+                       "{4}, {4}, !torch.int -> {4}",
+                       value("dy_relu"), dy, y, value("relu_threshold"),
+                       xType));
+    dy = value("dy_relu");
+  }
+  std::string x = toF32("x", permuted(xT), xT);
+  std::string mean = channelInput("mean", batchnormBwdAttr.getSAVED_MEAN());
+  std::string invStd =
+      channelInput("inv_std", batchnormBwdAttr.getSAVED_INV_VARIANCE());
+  std::string centered = binary("sub", "centered", x, xType, mean, channelType);
+  std::string xhat =
+      binary("mul", "xhat", centered, xType, invStd, channelType);
+
+  // The two reductions, shared by DX and the parameter gradients.
+  std::string dbias = sum("dbias_f32", dy);
+  std::string dscale =
+      sum("dscale_f32", binary("mul", "dy_xhat", dy, xType, xhat, xType));
+
+  std::string proj = binary("mul", "proj", xhat, xType,
+                            perElement("dscale_mean", dscale), channelType);
+  std::string dyCentered = binary("sub", "dy_centered", dy, xType,
+                                  perElement("dbias_mean", dbias), channelType);
+  std::string dxUnscaled =
+      binary("sub", "dx_unscaled", dyCentered, xType, proj, xType);
+  std::string dxScale = invStd;
+  if (sT)
+    dxScale = binary("mul", "dx_scale", channelInput("scale", sT), channelType,
+                     invStd, channelType);
+  fromF32("dx",
+          binary("mul", "dx_f32", dxUnscaled, xType, dxScale, channelType),
+          dxT);
+  if (dsT)
+    fromF32("dscale",
+            view("dscale_1d", dscale, channelType, "vector_shape", vectorType),
+            dsT);
+  if (dbT)
+    fromF32("dbias",
+            view("dbias_1d", dbias, channelType, "vector_shape", vectorType),
+            dbT);
+
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+  )";
+
+  return std::format(schema, permuteInputs, ops, permuteOutputs);
+}
+
 //===----------------------------------------------------------------------===//
 //
 // LayerNormNode ASM Emitter Methods
 //
 //===----------------------------------------------------------------------===//
 
+// Emits the residual add of a fused residual-add + normalization node in MLIR
+// assembly format, or nothing when `residual` is not set. The sum of `x`
+// (permuted to logical order by the node) and `residual` is named after
+// `sum` like a node result: it's normalized by the node and permuted out to
+// `sum`, e.g.
+//
+//   %sum_ln_perm = torch.aten.add.Tensor %x_ln_perm, %residual_ln_perm,
+//       %alpha_residual_ln : ... -> ...
+//   %sum = torch.aten.permute %sum_ln_perm, %permute_sum_ln : ... -> ...
+inline std::string
+getResidualAddOpsAsm(const std::shared_ptr<TensorAttr> &x,
+                     const std::shared_ptr<TensorAttr> &residual,
+                     const std::shared_ptr<TensorAttr> &sum,
+                     const std::string &suffix) {
+  if (!residual)
+    return "";
+
+  constexpr std::string_view schema = R"(
+    {0}
+    %alpha_residual_{1} = torch.constant.int 1
+    {2}_{1}_perm = torch.aten.add.Tensor {3}_{1}_perm, {4}_{1}_perm, %alpha_residual_{1} : {5}, {6}, !torch.int -> {7}
+    {8}
+)";
+
+  std::string permuteResidual = getLayoutConversionOpsAsm(
+      residual, "permute_residual", suffix, /*isInput=*/true);
+  std::string permuteSum = getLayoutConversionOpsAsm(sum, "permute_sum", suffix,
+                                                     /*isInput=*/false);
+  auto typeAsm = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  };
+
+  return std::format(schema,
+                     permuteResidual,             // {0}
+                     suffix,                      // {1}
+                     sum->getValueNameAsm(),      // {2}
+                     x->getValueNameAsm(),        // {3}
+                     residual->getValueNameAsm(), // {4}
+                     typeAsm(x),                  // {5}
+                     typeAsm(residual),           // {6}
+                     typeAsm(sum),                // {7}
+                     permuteSum                   // {8}
+  );
+}
+
 // Emits LayerNormNode's operand names in MLIR assembly format.
 //
 // The unique suffix is included to ensure SSA uniqueness when the same
@@ -1321,7 +2463,7 @@ inline std::string LayerNormNode::getOperandNamesAsm() const {
   std::ostringstream oss;
   std::string suffix = layernormAttr.getName();
 
-  oss << layernormAttr.getX()->getValueNameAsm() << "_" << suffix << "_perm, ";
+  oss << getNormInput()->getValueNameAsm() << "_" << suffix << "_perm, ";
   oss << "%normalized_shape_" << suffix << ", ";
 
   auto getOptionalOperandNameAsm = [&](const std::shared_ptr<TensorAttr> &t,
@@ -1341,8 +2483,8 @@ inline std::string LayerNormNode::getOperandNamesAsm() const {
 inline std::string LayerNormNode::getOperandTypesAsm() const {
   std::ostringstream oss;
 
-  oss << layernormAttr.getX()->getTensorTypeAsm(/*isValueTensor=*/true,
-                                                /*useLogicalDims=*/true)
+  oss << getNormInput()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true)
       << ", ";
   oss << "!torch.list<int>" << ", ";
 
@@ -1440,6 +2582,9 @@ inline std::string LayerNormNode::emitNodePreAsm() const {
           ? getLayoutConversionOpsAsm(layernormAttr.getBIAS(), "permute_bias",
                                       uniqueSSASuffix, /*isInput=*/true)
           : torchNoneAsm("none_bias", uniqueSSASuffix);
+  std::string residualAdd = getResidualAddOpsAsm(
+      layernormAttr.getX(), layernormAttr.getRESIDUAL(), layernormAttr.getSUM(),
+      uniqueSSASuffix);
 
   if (isTrainingForwardPhase()) {
     std::string permuteMean =
@@ -1453,6 +2598,7 @@ inline std::string LayerNormNode::emitNodePreAsm() const {
     {0}
     {1}
     {2}
+    {12}
     {3}
     {4}
     {5} = torch.aten.native_layer_norm {6} : {7} -> {8}
@@ -1473,7 +2619,8 @@ inline std::string LayerNormNode::emitNodePreAsm() const {
                        getResultTypesAsm(),        // {8}
                        permuteY,                   // {9}
                        permuteMean,                // {10}
-                       permuteInvVariance          // {11}
+                       permuteInvVariance,         // {11}
+                       residualAdd                 // {12}
     );
   }
 
@@ -1481,6 +2628,7 @@ inline std::string LayerNormNode::emitNodePreAsm() const {
     {1}
     {2}
     {3}
+    {11}
     {4}
     {5}
     %cudnn_enable_{0} = torch.constant.bool false
@@ -1498,7 +2646,8 @@ inline std::string LayerNormNode::emitNodePreAsm() const {
                      getOperandNamesAsm(),       // {7}
                      getOperandTypesAsm(),       // {8}
                      getResultTypesAsm(),        // {9}
-                     permuteY                    // {10}
+                     permuteY,                   // {10}
+                     residualAdd                 // {11}
   );
 }
 
@@ -1516,7 +2665,7 @@ inline std::string RmsNormNode::getOperandNamesAsm() const {
   std::ostringstream oss;
   std::string suffix = rmsnormAttr.getName();
 
-  oss << rmsnormAttr.getX()->getValueNameAsm() << "_" << suffix << "_perm, ";
+  oss << getNormInput()->getValueNameAsm() << "_" << suffix << "_perm, ";
   oss << "%normalized_shape_" << suffix << ", ";
 
   auto sT = rmsnormAttr.getSCALE();
@@ -1531,8 +2680,8 @@ inline std::string RmsNormNode::getOperandNamesAsm() const {
 inline std::string RmsNormNode::getOperandTypesAsm() const {
   std::ostringstream oss;
 
-  oss << rmsnormAttr.getX()->getTensorTypeAsm(/*isValueTensor=*/true,
-                                              /*useLogicalDims=*/true)
+  oss << getNormInput()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true)
       << ", ";
   oss << "!torch.list<int>" << ", ";
 
@@ -1603,11 +2752,15 @@ inline std::string RmsNormNode::emitNodePreAsm() const {
           ? getLayoutConversionOpsAsm(rmsnormAttr.getSCALE(), "permute_scale",
                                       uniqueSSASuffix, /*isInput=*/true)
           : torchNoneAsm("none_scale", uniqueSSASuffix);
+  std::string residualAdd = getResidualAddOpsAsm(
+      rmsnormAttr.getX(), rmsnormAttr.getRESIDUAL(), rmsnormAttr.getSUM(),
+      uniqueSSASuffix);
 
   constexpr std::string_view schema = R"(
     {0}
     {1}
     {2}
+    {9}
     {3}
     {4} = torch.aten.rms_norm {5} : {6} -> {7}
     {8}
@@ -1621,10 +2774,241 @@ inline std::string RmsNormNode::emitNodePreAsm() const {
                      getOperandNamesAsm(),               // {5}
                      getOperandTypesAsm(),               // {6}
                      getResultTypesAsm(),                // {7}
-                     permuteY                            // {8}
+                     permuteY,                           // {8}
+                     residualAdd                         // {9}
   );
 }
 
+//===----------------------------------------------------------------------===//
+//
+// LayerNormBwdNode and RmsNormBwdNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits the gradients of a normalization over all but the batch dimension in
+// MLIR assembly format, from the statistics saved by the forward pass. With
+// xhat = (X - MEAN) * INV_STD and G = DY * SCALE,
+//   DX = INV_STD * (G - mean(G) - xhat * mean(G * xhat)),
+//   DSCALE = sum_batch(DY * xhat),  DBIAS = sum_batch(DY),
+// where the means are over the normalized dims. Without `mean` (RmsNorm),
+// xhat = X * INV_STD and the mean(G) term is dropped; without `scale`,
+// G = DY. The math is done in f32 on the permuted (logical order) operands,
+// and the gradients are cast to their own data types.
+inline std::string getNormBwdOpsAsm(const std::shared_ptr<TensorAttr> &dy,
+                                    const std::shared_ptr<TensorAttr> &x,
+                                    const std::shared_ptr<TensorAttr> &scale,
+                                    const std::shared_ptr<TensorAttr> &mean,
+                                    const std::shared_ptr<TensorAttr> &invStd,
+                                    const std::shared_ptr<TensorAttr> &dx,
+                                    const std::shared_ptr<TensorAttr> &dscale,
+                                    const std::shared_ptr<TensorAttr> &dbias,
+                                    const std::string &suffix) {
+  const std::vector<int64_t> &xDim = x->getDim();
+  std::vector<int64_t> normDims(xDim.size() - 1);
+  std::iota(normDims.begin(), normDims.end(), 1);
+  std::string xType = buildTensorTypeStr(xDim, DataType::Float);
+  std::string statType = buildTensorTypeStr(invStd->getDim(), DataType::Float);
+  std::string scaleType = buildTensorTypeStr(
+      norm_utils::getScaleBiasDim(xDim), DataType::Float);
+
+  constexpr std::string_view setupSchema = R"(
+    %bwd_int1_{0} = torch.constant.int 1
+    %bwd_f32_{0} = torch.constant.int {1}
+    %bwd_false_{0} = torch.constant.bool false
+    %bwd_true_{0} = torch.constant.bool true
+    %bwd_none_{0} = torch.constant.none
+    {2}
+    {3}
+)";
+  std::string ops = std::format(
+      setupSchema, suffix,
+      static_cast<int>(kDataTypeToTorchType.at(DataType::Float)),
+      getListOfIntOpsAsm(normDims, "bwd_norm_dims", suffix),
+      getListOfIntOpsAsm({0}, "bwd_batch_dims", suffix));
+
+  auto append = [&](std::string_view line) {
+    ops += "    ";
+    ops += line;
+    ops += '\n';
+  };
+  auto value = [&](const std::string &name) {
+    return "%bwd_" + name + "_" + suffix;
+  };
+  // Casts the permuted input `t` to f32 into `%bwd_{name}_{suffix}`.
+  auto toF32 = [&](const std::string &name,
+                   const std::shared_ptr<TensorAttr> &t) {
+    append(std::format(
+        "{0} = torch.aten.to.dtype {1}_{2}_perm, %bwd_f32_{2}, %bwd_false_{2}, "
+        "%bwd_false_{2}, %bwd_none_{2} : {3}, !torch.int, !torch.bool, "
+        "!torch.bool, !torch.none -> {4}",
+        value(name), t->getValueNameAsm(), suffix,
+        t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true),
+        buildTensorTypeStr(t->getDim(), DataType::Float)));
+    return value(name);
+  };
+  // Casts the f32 `operand` to the permuted result of the output `t`.
+  auto fromF32 = [&](const std::string &name, const std::string &operand,
+                     const std::shared_ptr<TensorAttr> &t) {
+    append(std::format(
+        "{0} = torch.constant.int {1}", value(name + "_dtype"),
+        static_cast<int>(kDataTypeToTorchType.at(t->getDataType()))));
+    append(std::format(
+        "{0}_{1}_perm = torch.aten.to.dtype {2}, {3}, %bwd_false_{1}, "
+        "%bwd_false_{1}, %bwd_none_{1} : {4}, !torch.int, !torch.bool, "
+        "!torch.bool, !torch.none -> {5}",
+        t->getValueNameAsm(), suffix, operand, value(name + "_dtype"),
+        buildTensorTypeStr(t->getDim(), DataType::Float),
+        t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true)));
+  };
+  // Elementwise `op` of `a` and `b` (broadcast to `a`) into
+  // `%bwd_{name}_{suffix}`.
+  auto binary = [&](std::string_view op, const std::string &name,
+                    const std::string &a, const std::string &aType,
+                    const std::string &b, const std::string &bType) {
+    bool isSub = op == "sub";
+    append(std::format("{0} = torch.aten.{1}.Tensor {2}, {3}{4} : {5}, {6}{7} "
+                       "-> {5}",
+                       value(name), op, a, b,
+                       isSub ? ", %bwd_int1_" + suffix : "", aType, bType,
+                       isSub ? ", !torch.int" : ""));
+    return value(name);
+  };
+  // Reduction `op` of `operand` over the dims `dims`, keeping them.
+  auto reduce = [&](std::string_view op, const std::string &name,
+                    const std::string &operand, const std::string &dims,
+                    const std::string &resultType) {
+    append(std::format("{0} = torch.aten.{1} {2}, {3}, %bwd_true_{4}, "
+                       "%bwd_none_{4} : {5}, !torch.list<int>, !torch.bool, "
+                       "!torch.none -> {6}",
+                       value(name), op, operand, dims, suffix, xType,
+                       resultType));
+    return value(name);
+  };
+  std::string normDimsList = "%bwd_norm_dims_" + suffix;
+  std::string batchDimsList = "%bwd_batch_dims_" + suffix;
+
+  std::string dyF32 = toF32("dy", dy);
+  std::string xhat = toF32("x", x);
+  std::string invStdF32 = toF32("inv_std", invStd);
+  if (mean)
+    xhat = binary("sub", "centered", xhat, xType, toF32("mean", mean),
+                  statType);
+  xhat = binary("mul", "xhat", xhat, xType, invStdF32, statType);
+
+  std::string g = dyF32;
+  if (scale)
+    g = binary("mul", "g", dyF32, xType, toF32("scale", scale), scaleType);
+  std::string gXhat = binary("mul", "g_xhat", g, xType, xhat, xType);
+  std::string gXhatMean =
+      reduce("mean.dim", "g_xhat_mean", gXhat, normDimsList, statType);
+  std::string proj = binary("mul", "proj", xhat, xType, gXhatMean, statType);
+  if (mean) {
+    std::string gMean = reduce("mean.dim", "g_mean", g, normDimsList, statType);
+    g = binary("sub", "g_centered", g, xType, gMean, statType);
+  }
+  std::string dxUnscaled =
+      binary("sub", "dx_unscaled", g, xType, proj, xType);
+  std::string dxF32 =
+      binary("mul", "dx_f32", dxUnscaled, xType, invStdF32, statType);
+  fromF32("dx", dxF32, dx);
+
+  if (dscale) {
+    std::string dyXhat = binary("mul", "dy_xhat", dyF32, xType, xhat, xType);
+    fromF32("dscale",
+            reduce("sum.dim_IntList", "dscale_f32", dyXhat, batchDimsList,
+                   scaleType),
+            dscale);
+  }
+  if (dbias)
+    fromF32("dbias",
+            reduce("sum.dim_IntList", "dbias_f32", dyF32, batchDimsList,
+                   scaleType),
+            dbias);
+
+  return ops;
+}
+
+// This gets called by the recursive `emitAsmSubtree()` method to emit
+// the pre-assembly for each node (including the main Graph). The inputs are
+// permuted to logical order, the gradients computed by `getNormBwdOpsAsm()`
+// and permuted out.
+inline std::string LayerNormBwdNode::emitNodePreAsm() const {
+  std::string suffix = layernormBwdAttr.getName();
+  std::shared_ptr<TensorAttr> sT = layernormBwdAttr.getSCALE();
+  std::shared_ptr<TensorAttr> dsT = layernormBwdAttr.getDSCALE();
+  std::shared_ptr<TensorAttr> dbT = layernormBwdAttr.getDBIAS();
+
+  // Each group of layout conversion ops is followed by a line break so that
+  // the next one starts at op indentation.
+  auto permute = [&](const std::shared_ptr<TensorAttr> &t,
+                     const std::string &prefix, bool isInput) {
+    return t ? getLayoutConversionOpsAsm(t, prefix, suffix, isInput) + "\n    "
+             : "";
+  };
+  std::string permuteInputs =
+      permute(layernormBwdAttr.getDY(), "permute_dy", /*isInput=*/true) +
+      permute(layernormBwdAttr.getX(), "permute_x", /*isInput=*/true) +
+      permute(sT, "permute_scale", /*isInput=*/true) +
+      permute(layernormBwdAttr.getMEAN(), "permute_mean", /*isInput=*/true) +
+      permute(layernormBwdAttr.getINV_VARIANCE(), "permute_inv_variance",
+              /*isInput=*/true);
+  std::string permuteOutputs =
+      permute(layernormBwdAttr.getDX(), "permute_dx", /*isInput=*/false) +
+      permute(dsT, "permute_dscale", /*isInput=*/false) +
+      permute(dbT, "permute_dbias", /*isInput=*/false);
+
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+  )";
+
+  return std::format(
+      schema, permuteInputs,
+      getNormBwdOpsAsm(layernormBwdAttr.getDY(), layernormBwdAttr.getX(), sT,
+                       layernormBwdAttr.getMEAN(),
+                       layernormBwdAttr.getINV_VARIANCE(),
+                       layernormBwdAttr.getDX(), dsT, dbT, suffix),
+      permuteOutputs);
+}
+
+// Same as `LayerNormBwdNode::emitNodePreAsm()`, without MEAN and DBIAS.
+inline std::string RmsNormBwdNode::emitNodePreAsm() const {
+  std::string suffix = rmsnormBwdAttr.getName();
+  std::shared_ptr<TensorAttr> sT = rmsnormBwdAttr.getSCALE();
+  std::shared_ptr<TensorAttr> dsT = rmsnormBwdAttr.getDSCALE();
+
+  auto permute = [&](const std::shared_ptr<TensorAttr> &t,
+                     const std::string &prefix, bool isInput) {
+    return t ? getLayoutConversionOpsAsm(t, prefix, suffix, isInput) + "\n    "
+             : "";
+  };
+  std::string permuteInputs =
+      permute(rmsnormBwdAttr.getDY(), "permute_dy", /*isInput=*/true) +
+      permute(rmsnormBwdAttr.getX(), "permute_x", /*isInput=*/true) +
+      permute(sT, "permute_scale", /*isInput=*/true) +
+      permute(rmsnormBwdAttr.getINV_RMS(), "permute_inv_rms",
+              /*isInput=*/true);
+  std::string permuteOutputs =
+      permute(rmsnormBwdAttr.getDX(), "permute_dx", /*isInput=*/false) +
+      permute(dsT, "permute_dscale", /*isInput=*/false);
+
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+  )";
+
+  return std::format(schema, permuteInputs,
+                     getNormBwdOpsAsm(rmsnormBwdAttr.getDY(),
+                                      rmsnormBwdAttr.getX(), sT,
+                                      /*mean=*/nullptr,
+                                      rmsnormBwdAttr.getINV_RMS(),
+                                      rmsnormBwdAttr.getDX(), dsT,
+                                      /*dbias=*/nullptr, suffix),
+                     permuteOutputs);
+}
+
 //===----------------------------------------------------------------------===//
 //
 // MatmulNode ASM Emitter Methods
@@ -1635,19 +3019,33 @@ inline std::string RmsNormNode::emitNodePreAsm() const {
 //
 // The unique suffix is included to ensure SSA uniqueness when the same
 // tensor is used by multiple operations.
+//
+// Sparse weights are the dense B expanded by `getSparseExpandOpsAsm()`, and
+// group-quantized weights B dequantized by `getGroupDequantizeOpsAsm()`.
 inline std::string MatmulNode::getOperandNamesAsm() const {
   std::string suffix = matmulAttr.getName();
+  std::string bName =
+      matmulAttr.getB()->getValueNameAsm() + "_" + suffix + "_perm";
+  if (matmulAttr.isSparse())
+    bName = "%sparse_b_" + suffix;
+  else if (matmulAttr.isGroupQuantized())
+    bName = "%gq_b_" + suffix;
   return matmulAttr.getA()->getValueNameAsm() + "_" + suffix + "_perm" + ", " +
-         matmulAttr.getB()->getValueNameAsm() + "_" + suffix + "_perm";
+         bName;
 }
 
 // Emits MatmulNode's operand types in MLIR assembly format.
 inline std::string MatmulNode::getOperandTypesAsm() const {
+  std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+  std::string bType = bT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true);
+  if (matmulAttr.isSparse())
+    bType = buildTensorTypeStr(getDenseBDim(), bT->getDataType());
+  else if (matmulAttr.isGroupQuantized())
+    bType = buildTensorTypeStr(bT->getDim(), matmulAttr.getA()->getDataType());
   return matmulAttr.getA()->getTensorTypeAsm(/*isValueTensor=*/true,
                                              /*useLogicalDims=*/true) +
-         ", " +
-         matmulAttr.getB()->getTensorTypeAsm(/*isValueTensor=*/true,
-                                             /*useLogicalDims=*/true);
+         ", " + bType;
 }
 
 // Emits MatmulNode's result names in MLIR assembly format.
@@ -1666,60 +3064,651 @@ inline std::string MatmulNode::getResultTypesAsm() const {
                                              /*useLogicalDims=*/true);
 }
 
-inline std::string MatmulNode::emitNodePreAsm() const {
-  constexpr std::string_view schema = R"(
-    {0}
-    {1}
-    {2} = torch.aten.matmul {3} : {4} -> {5}
-    {6}
-  )";
+// Emits the MatmulNode epilogue ops applied to `product` in MLIR assembly
+// format, in the order
+//   C = activation(alpha * product + BIAS) + beta * RESIDUAL
+// skipping the steps that are not set. The last op defines `result`. All
+// ops are elementwise on the matmul result so they fuse into the matmul
+// dispatch.
+inline std::string
+MatmulNode::getEpilogueOpsAsm(const std::string &product,
+                              const std::string &result) const {
+  std::string suffix = matmulAttr.getName();
+  std::shared_ptr<TensorAttr> biasT = matmulAttr.getBIAS();
+  std::shared_ptr<TensorAttr> residualT = matmulAttr.getRESIDUAL();
+  PointwiseAttr::Mode activation = matmulAttr.getActivation();
+  bool hasAlpha = matmulAttr.getAlpha() != 1.0f;
+  bool hasActivation = activation != PointwiseAttr::Mode::NOT_SET;
+
+  // Intermediates are named after their step, the last one defines the
+  // matmul result.
+  int steps = hasAlpha + (biasT != nullptr) + hasActivation +
+              (residualT != nullptr);
+  auto nextName = [&](std::string_view step) {
+    return --steps == 0 ? result
+                        : std::format("%epilogue_{}_{}", step, suffix);
+  };
+  auto typeAsm = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  };
+  std::string cType = getResultTypesAsm();
 
-  std::string uniqueSSASuffix = matmulAttr.getName();
-  std::string permuteA = getLayoutConversionOpsAsm(
-      matmulAttr.getA(), "permute_A", uniqueSSASuffix, /*isInput=*/true);
-  std::string permuteB = getLayoutConversionOpsAsm(
-      matmulAttr.getB(), "permute_B", uniqueSSASuffix, /*isInput=*/true);
-  std::string permuteC = getLayoutConversionOpsAsm(
-      matmulAttr.getC(), "permute_C", uniqueSSASuffix, /*isInput=*/false);
+  std::ostringstream oss;
+  std::string current = product;
+  if (hasAlpha) {
+    std::string next = nextName("alpha");
+    oss << std::format(R"(
+    %epilogue_alpha_val_{0} = torch.constant.float {1:e}
+    {2} = torch.aten.mul.Scalar {3}, %epilogue_alpha_val_{0} : {4}, !torch.float -> {4}
+)",
+                       suffix, matmulAttr.getAlpha(), next, current, cType);
+    current = next;
+  }
+  if (biasT) {
+    std::string next = nextName("bias");
+    oss << getLayoutConversionOpsAsm(biasT, "permute_BIAS", suffix,
+                                     /*isInput=*/true);
+    oss << std::format(R"(
+    %epilogue_bias_alpha_{0} = torch.constant.int 1
+    {1} = torch.aten.add.Tensor {2}, {3}_{0}_perm, %epilogue_bias_alpha_{0} : {4}, {5}, !torch.int -> {4}
+)",
+                       suffix, next, current, biasT->getValueNameAsm(), cType,
+                       typeAsm(biasT));
+    current = next;
+  }
+  if (hasActivation) {
+    std::string next = nextName("activation");
+    oss << getActivationOpsAsm(activation, "epilogue", current, next, cType);
+    current = next;
+  }
+  if (residualT) {
+    std::string next = nextName("residual");
+    oss << getLayoutConversionOpsAsm(residualT, "permute_RESIDUAL", suffix,
+                                     /*isInput=*/true);
+    oss << std::format(R"(
+    %epilogue_beta_val_{0} = torch.constant.float {1:e}
+    {2} = torch.aten.add.Tensor {3}, {4}_{0}_perm, %epilogue_beta_val_{0} : {5}, {6}, !torch.float -> {5}
+)",
+                       suffix, matmulAttr.getBeta(), next, current,
+                       residualT->getValueNameAsm(), cType,
+                       typeAsm(residualT));
+  }
+  return oss.str();
+}
 
-  std::string output = std::format(schema,
-                                   permuteA,             // {0}
-                                   permuteB,             // {1}
-                                   getResultNamesAsm(),  // {2}
-                                   getOperandNamesAsm(), // {3}
-                                   getOperandTypesAsm(), // {4}
-                                   getResultTypesAsm(),  // {5}
-                                   permuteC              // {6}
-  );
+// Emits the MatmulNode ops applying the epilogue `activation` to `operand` of
+// type `type` into `result` in MLIR assembly format. Constants are prefixed
+// with `step`.
+inline std::string MatmulNode::getActivationOpsAsm(
+    PointwiseAttr::Mode activation, std::string_view step,
+    const std::string &operand, const std::string &result,
+    const std::string &type) const {
+  std::string_view op;
+  switch (activation) {
+  case PointwiseAttr::Mode::RELU_FWD:
+    op = "torch.aten.relu";
+    break;
+  case PointwiseAttr::Mode::SIGMOID_FWD:
+    op = "torch.aten.sigmoid";
+    break;
+  case PointwiseAttr::Mode::SWISH_FWD:
+    op = "torch.aten.silu";
+    break;
+  case PointwiseAttr::Mode::TANH_FWD:
+    op = "torch.aten.tanh";
+    break;
+  default:
+    break;
+  }
+  if (!op.empty())
+    return std::format(R"(
+    {0} = {1} {2} : {3} -> {3}
+)",
+                       result, op, operand, type);
+
+  // GELU_FWD or GELU_APPROX_TANH_FWD.
+  return std::format(R"(
+    %{0}_gelu_approximate_{1} = torch.constant.str "{2}"
+    {3} = torch.aten.gelu {4}, %{0}_gelu_approximate_{1} : {5}, !torch.str -> {5}
+)",
+                     step, matmulAttr.getName(),
+                     activation == PointwiseAttr::Mode::GELU_FWD ? "none"
+                                                                 : "tanh",
+                     result, operand, type);
+}
 
-  return output;
+// Emits the type of the gated MatmulNode product in MLIR assembly format: C
+// with both the gate and up halves, dynamic where C is.
+inline std::string MatmulNode::getGatedProductTypeAsm() const {
+  std::shared_ptr<TensorAttr> cT = matmulAttr.getC();
+  std::vector<int64_t> productDim = cT->getDim();
+  productDim.back() *= 2;
+  for (size_t i = 0; i < productDim.size(); ++i)
+    if (cT->isDynamicDim(i))
+      productDim[i] = -1;
+  return buildTensorTypeStr(productDim, cT->getDataType());
 }
 
-//===----------------------------------------------------------------------===//
-//
-// PointwiseNode ASM Emitter Methods
-//
-//===----------------------------------------------------------------------===//
+// Emits the gated MatmulNode ops in MLIR assembly format: `product` packs
+// the gate and up halves along its last dim, which are sliced, and the
+// activated gate is multiplied with the up half into `result`. The slices
+// and the product fuse into the matmul dispatch.
+inline std::string MatmulNode::getGateOpsAsm(const std::string &product,
+                                             const std::string &result) const {
+  constexpr std::string_view schema = R"(
+    %gate_dim_{0} = torch.constant.int {1}
+    %gate_start_{0} = torch.constant.int 0
+    %gate_mid_{0} = torch.constant.int {2}
+    %gate_end_{0} = torch.constant.int {3}
+    %gate_step_{0} = torch.constant.int 1
+    %gate_{0} = torch.aten.slice.Tensor {4}, %gate_dim_{0}, %gate_start_{0}, %gate_mid_{0}, %gate_step_{0} : {5}, !torch.int, !torch.int, !torch.int, !torch.int -> {6}
+    %gate_up_{0} = torch.aten.slice.Tensor {4}, %gate_dim_{0}, %gate_mid_{0}, %gate_end_{0}, %gate_step_{0} : {5}, !torch.int, !torch.int, !torch.int, !torch.int -> {6}
+    {7}
+    {8} = torch.aten.mul.Tensor %gate_act_{0}, %gate_up_{0} : {6}, {6} -> {6}
+  )";
 
-// Emits the SSA name for a single PointwiseNode input in MLIR assembly
-// format.
-//
-// The unique suffix is included to ensure SSA uniqueness when the same
-// tensor is used by multiple operations in a graph.
-inline std::string PointwiseNode::getInputNameAsm(size_t inputIndex) const {
-  const auto &in = pointwiseAttr.inputs.at(
-      static_cast<PointwiseAttr::InputNames>(inputIndex));
-  return in->getValueNameAsm() + "_" + pointwiseAttr.getName() + "_perm";
-}
+  std::string suffix = matmulAttr.getName();
+  const std::vector<int64_t> &cDim = matmulAttr.getC()->getDim();
+  int64_t n = cDim.back();
+  std::string productType = getGatedProductTypeAsm();
+  std::string cType = getResultTypesAsm();
+  std::string activation =
+      getActivationOpsAsm(matmulAttr.getGate(), "gate", "%gate_" + suffix,
+                          "%gate_act_" + suffix, cType);
 
-// Emits the type for a single PointwiseNode input in MLIR assembly format.
-inline std::string PointwiseNode::getInputTypeAsm(size_t inputIndex) const {
-  const auto &in = pointwiseAttr.inputs.at(
-      static_cast<PointwiseAttr::InputNames>(inputIndex));
-  return in->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  return std::format(schema,
+                     suffix,          // {0}
+                     cDim.size() - 1, // {1}
+                     n,               // {2}
+                     2 * n,           // {3}
+                     product,         // {4}
+                     productType,     // {5}
+                     cType,           // {6}
+                     activation,      // {7}
+                     result           // {8}
+  );
 }
 
-// Emits PointwiseNode's operand names in MLIR assembly format.
+// Emits the grouped MatmulNode ops that zero the rows of `unmasked` past
+// each group's size in MLIR assembly format. The row index is compared with
+// GROUP_SIZES into an [E, M, 1] mask, which is selected against zero into
+// the matmul result; the select fuses into the matmul dispatch.
+inline std::string
+MatmulNode::getGroupMaskOpsAsm(const std::string &unmasked) const {
+  if (!matmulAttr.isGrouped())
+    return "";
+
+  std::string suffix = matmulAttr.getName();
+  std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
+  std::shared_ptr<TensorAttr> groupSizesT = matmulAttr.getGROUP_SIZES();
+  int64_t groups = aT->getDim()[0];
+  int64_t rows = aT->isDynamicDim(1) ? -1 : aT->getDim()[1];
+
+  constexpr std::string_view schema = R"(
+    %group_int1_{0} = torch.constant.int 1
+    %group_int2_{0} = torch.constant.int 2
+    %group_long_{0} = torch.constant.int {1}
+    %group_none_{0} = torch.constant.none
+    %group_zero_{0} = torch.constant.int 0
+    %group_rows_len_{0} = torch.aten.size.int {2}_{0}_perm, %group_int1_{0} : {3}, !torch.int -> !torch.int
+    %group_rows_{0} = torch.aten.arange %group_rows_len_{0}, %group_long_{0}, %group_none_{0}, %group_none_{0}, %group_none_{0} : !torch.int, !torch.int, !torch.none, !torch.none, !torch.none -> {4}
+    {5}
+    %group_sizes_col_{0} = torch.aten.unsqueeze {6}_{0}_perm, %group_int1_{0} : {7}, !torch.int -> {8}
+    %group_valid_{0} = torch.aten.lt.Tensor %group_rows_{0}, %group_sizes_col_{0} : {4}, {8} -> {9}
+    %group_mask_{0} = torch.aten.unsqueeze %group_valid_{0}, %group_int2_{0} : {9}, !torch.int -> {10}
+    {11} = torch.aten.where.ScalarOther %group_mask_{0}, {12}, %group_zero_{0} : {10}, {13}, !torch.int -> {13}
+)";
+
+  DataType sizesType = groupSizesT->getDataType();
+  return std::format(
+      schema,
+      suffix,                                                        // {0}
+      static_cast<int>(torch_upstream::ScalarType::Long),            // {1}
+      aT->getValueNameAsm(),                                         // {2}
+      aT->getTensorTypeAsm(/*isValueTensor=*/true,
+                           /*useLogicalDims=*/true),                 // {3}
+      buildTensorTypeStr({rows}, DataType::Int64),                   // {4}
+      getLayoutConversionOpsAsm(groupSizesT, "permute_GROUP_SIZES", suffix,
+                                /*isInput=*/true),                   // {5}
+      groupSizesT->getValueNameAsm(),                                // {6}
+      groupSizesT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                    /*useLogicalDims=*/true),        // {7}
+      buildTensorTypeStr({groups, 1}, sizesType),                    // {8}
+      buildTensorTypeStr({groups, rows}, DataType::Boolean),         // {9}
+      buildTensorTypeStr({groups, rows, 1}, DataType::Boolean),      // {10}
+      getResultNamesAsm(),                                           // {11}
+      unmasked,                                                      // {12}
+      getResultTypesAsm()                                            // {13}
+  );
+}
+
+// Emits the ops expanding the 2:4 sparse weights B and B_META into the
+// dense B operand `%sparse_b` in MLIR assembly format. Each pair of kept
+// values is compared with the four positions of its group, selected against
+// zero and summed over the pair into the group. The ops are elementwise up
+// to the sum over two values, so they fuse into the producer of the matmul
+// operand instead of materializing the dense weights.
+inline std::string MatmulNode::getSparseExpandOpsAsm() const {
+  if (!matmulAttr.isSparse())
+    return "";
+
+  constexpr std::string_view schema = R"(
+    {1}
+    %sparse_pos_{0} = torch.vtensor.literal(dense<[[0], [1], [2], [3]]> : tensor<4x1xsi8>) : !torch.vtensor<[4,1],si8>
+    %sparse_zero_{0} = torch.constant.int 0
+    %sparse_keepdim_{0} = torch.constant.bool false
+    %sparse_dtype_{0} = torch.constant.int {2}
+    {3}
+    %sparse_meta_{0} = torch.aten.view {4}_{0}_perm, %sparse_split_shape_{0} : {5}, !torch.list<int> -> {6}
+    %sparse_values_{0} = torch.aten.view {7}_{0}_perm, %sparse_split_shape_{0} : {8}, !torch.list<int> -> {9}
+    %sparse_mask_{0} = torch.aten.eq.Tensor %sparse_meta_{0}, %sparse_pos_{0} : {6}, !torch.vtensor<[4,1],si8> -> {10}
+    %sparse_select_{0} = torch.aten.where.ScalarOther %sparse_mask_{0}, %sparse_values_{0}, %sparse_zero_{0} : {10}, {9}, !torch.int -> {11}
+    %sparse_groups_{0} = torch.aten.sum.dim_IntList %sparse_select_{0}, %sparse_pair_dims_{0}, %sparse_keepdim_{0}, %sparse_dtype_{0} : {11}, !torch.list<int>, !torch.bool, !torch.int -> {12}
+    %sparse_b_{0} = torch.aten.view %sparse_groups_{0}, %sparse_dense_shape_{0} : {12}, !torch.list<int> -> {13}
+)";
+
+  std::string suffix = matmulAttr.getName();
+  std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+  std::shared_ptr<TensorAttr> metaT = matmulAttr.getB_META();
+  DataType bType = bT->getDataType();
+
+  // B [..., K/2, N] is split into [..., K/4, 2, 1, N] pairs, broadcast
+  // against the positions into [..., K/4, 2, 4, N] and summed over the pair.
+  std::vector<int64_t> bDim = bT->getDim();
+  size_t rank = bDim.size();
+  int64_t n = bDim[rank - 1];
+  std::vector<int64_t> batch(bDim.begin(), bDim.end() - 2);
+  auto withBatch = [&](const std::vector<int64_t> &dims) {
+    std::vector<int64_t> out = batch;
+    out.insert(out.end(), dims.begin(), dims.end());
+    return out;
+  };
+  int64_t groups = bDim[rank - 2] / 2;
+  std::vector<int64_t> splitDim = withBatch({groups, 2, 1, n});
+  std::vector<int64_t> selectDim = withBatch({groups, 2, 4, n});
+
+  std::string shapeOps = getListOfIntOpsAsm(
+      {static_cast<int64_t>(rank) - 1}, "sparse_pair_dims", suffix);
+  shapeOps += "    ";
+  appendListOfIntOpsAsm(shapeOps, splitDim, "sparse_split_shape", suffix);
+  shapeOps += "    ";
+  appendListOfIntOpsAsm(shapeOps, getDenseBDim(), "sparse_dense_shape",
+                        suffix);
+  auto logicalType = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true,
+                               /*useLogicalDims=*/true);
+  };
+
+  return std::format(
+      schema,
+      suffix,                                                      // {0}
+      getLayoutConversionOpsAsm(metaT, "permute_B_META", suffix,
+                                /*isInput=*/true),                 // {1}
+      static_cast<int>(kDataTypeToTorchType.at(bType)),            // {2}
+      shapeOps,                                                    // {3}
+      metaT->getValueNameAsm(),                                    // {4}
+      logicalType(metaT),                                          // {5}
+      buildTensorTypeStr(splitDim, DataType::Int8),                // {6}
+      bT->getValueNameAsm(),                                       // {7}
+      logicalType(bT),                                             // {8}
+      buildTensorTypeStr(splitDim, bType),                         // {9}
+      buildTensorTypeStr(selectDim, DataType::Boolean),            // {10}
+      buildTensorTypeStr(selectDim, bType),                        // {11}
+      buildTensorTypeStr(withBatch({groups, 4, n}), bType),        // {12}
+      buildTensorTypeStr(getDenseBDim(), bType)                    // {13}
+  );
+}
+
+// Emits the ops dequantizing the group-wise quantized weights B with B_SCALE
+// and the optional B_ZERO into the B operand `%gq_b` in the data type of A in
+// MLIR assembly format. B [..., K, N] is viewed as its groups
+// [..., K/G, G, N], against which the unsqueezed scales and zero points
+// [..., K/G, 1, N] broadcast. Up to the views the ops are elementwise, so they
+// fuse into the producer of the matmul operand instead of materializing the
+// weights in full precision.
+inline std::string MatmulNode::getGroupDequantizeOpsAsm() const {
+  if (!matmulAttr.isGroupQuantized())
+    return "";
+
+  std::string suffix = matmulAttr.getName();
+  std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+  std::shared_ptr<TensorAttr> scaleT = matmulAttr.getB_SCALE();
+  std::shared_ptr<TensorAttr> zeroT = matmulAttr.getB_ZERO();
+  DataType type = matmulAttr.getA()->getDataType();
+
+  const std::vector<int64_t> &bDim = bT->getDim();
+  size_t rank = bDim.size();
+  int64_t groupSize = matmulAttr.getGroupSize();
+  std::vector<int64_t> splitDim(bDim.begin(), bDim.end() - 2);
+  splitDim.insert(splitDim.end(),
+                  {bDim[rank - 2] / groupSize, groupSize, bDim[rank - 1]});
+  std::vector<int64_t> groupDim = splitDim;
+  groupDim[rank - 1] = 1;
+  std::string splitType = buildTensorTypeStr(splitDim, type);
+  std::string groupType = buildTensorTypeStr(groupDim, type);
+  auto logicalType = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true,
+                               /*useLogicalDims=*/true);
+  };
+
+  auto dtypeCode = static_cast<int64_t>(kDataTypeToTorchType.at(type));
+  auto groupAxis = static_cast<int64_t>(rank) - 1;
+  std::string shapeOps;
+  appendListOfIntOpsAsm(shapeOps, splitDim, "gq_split_shape", suffix);
+  shapeOps += "    ";
+  appendListOfIntOpsAsm(shapeOps, bDim, "gq_dense_shape", suffix);
+
+  std::ostringstream oss;
+  oss << std::format(R"(
+    {1}
+    {2}
+    {3}
+    {4}
+    {5}
+    {6}
+    %gq_split_{0} = torch.aten.view {7}_{0}_perm, %gq_split_shape_{0} : {8}, !torch.list<int> -> {9}
+    %gq_values_{0} = torch.aten.to.dtype %gq_split_{0}, %gq_dtype_{0}, %gq_false_{0}, %gq_false_{0}, %gq_none_{0} : {9}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {10}
+    %gq_scale_{0} = torch.aten.unsqueeze {11}_{0}_perm, %gq_group_dim_{0} : {12}, !torch.int -> {13}
+)",
+                     suffix,                                          // {0}
+                     getLayoutConversionOpsAsm(scaleT, "permute_B_SCALE",
+                                               suffix,
+                                               /*isInput=*/true),     // {1}
+                     torchIntAsm("gq_dtype", suffix, dtypeCode),      // {2}
+                     torchBoolAsm("gq_false", suffix, false),         // {3}
+                     torchNoneAsm("gq_none", suffix),                 // {4}
+                     torchIntAsm("gq_group_dim", suffix, groupAxis),  // {5}
+                     shapeOps,                                        // {6}
+                     bT->getValueNameAsm(),                           // {7}
+                     logicalType(bT),                                 // {8}
+                     buildTensorTypeStr(splitDim, bT->getDataType()), // {9}
+                     splitType,                                       // {10}
+                     scaleT->getValueNameAsm(),                       // {11}
+                     logicalType(scaleT),                             // {12}
+                     groupType                                        // {13}
+  );
+
+  std::string values = "%gq_values_" + suffix;
+  if (zeroT) {
+    oss << std::format(R"(
+    {1}
+    {2}
+    %gq_zero_cast_{0} = torch.aten.to.dtype {3}_{0}_perm, %gq_dtype_{0}, %gq_false_{0}, %gq_false_{0}, %gq_none_{0} : {4}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {5}
+    %gq_zero_{0} = torch.aten.unsqueeze %gq_zero_cast_{0}, %gq_group_dim_{0} : {5}, !torch.int -> {6}
+    %gq_centered_{0} = torch.aten.sub.Tensor %gq_values_{0}, %gq_zero_{0}, %gq_one_{0} : {7}, {6}, !torch.int -> {7}
+)",
+                       suffix,                                          // {0}
+                       getLayoutConversionOpsAsm(zeroT, "permute_B_ZERO",
+                                                 suffix,
+                                                 /*isInput=*/true),     // {1}
+                       torchIntAsm("gq_one", suffix, 1),                // {2}
+                       zeroT->getValueNameAsm(),                        // {3}
+                       logicalType(zeroT),                              // {4}
+                       buildTensorTypeStr(zeroT->getDim(), type),       // {5}
+                       groupType,                                       // {6}
+                       splitType                                        // {7}
+    );
+    values = "%gq_centered_" + suffix;
+  }
+
+  oss << std::format(R"(
+    %gq_scaled_{0} = torch.aten.mul.Tensor {1}, %gq_scale_{0} : {2}, {3} -> {2}
+    %gq_b_{0} = torch.aten.view %gq_scaled_{0}, %gq_dense_shape_{0} : {2}, !torch.list<int> -> {4}
+)",
+                     suffix, values, splitType, groupType,
+                     buildTensorTypeStr(bDim, type));
+  return oss.str();
+}
+
+// Emits the ops reducing the permuted A over its contraction dim into the
+// bias gradient DBIAS, accumulated in f32, in MLIR assembly format. They read
+// the same operand as the matmul, so both are fused over a single read of A.
+inline std::string MatmulNode::getBiasGradientOpsAsm() const {
+  std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
+  std::shared_ptr<TensorAttr> dbT = matmulAttr.getDBIAS();
+  if (!dbT)
+    return "";
+
+  constexpr std::string_view schema = R"(
+    %dbias_keepdim_{0} = torch.constant.bool false
+    %dbias_f32_{0} = torch.constant.int {1}
+    %dbias_dtype_{0} = torch.constant.int {2}
+    %dbias_none_{0} = torch.constant.none
+    {3}
+    %dbias_acc_{0} = torch.aten.sum.dim_IntList {4}, %dbias_dims_{0}, %dbias_keepdim_{0}, %dbias_f32_{0} : {5}, !torch.list<int>, !torch.bool, !torch.int -> {6}
+    {7} = torch.aten.to.dtype %dbias_acc_{0}, %dbias_dtype_{0}, %dbias_keepdim_{0}, %dbias_keepdim_{0}, %dbias_none_{0} : {6}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {8}
+    {9}
+  )";
+
+  std::string suffix = matmulAttr.getName();
+  int64_t contractionDim = static_cast<int64_t>(aT->getDim().size()) - 1;
+  int f32 = static_cast<int>(kDataTypeToTorchType.at(DataType::Float));
+  int dtype = static_cast<int>(kDataTypeToTorchType.at(dbT->getDataType()));
+  std::string dimsOps =
+      getListOfIntOpsAsm({contractionDim}, "dbias_dims", suffix);
+  std::string aName = aT->getValueNameAsm() + "_" + suffix + "_perm";
+  std::string aType =
+      aT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  std::string accType = buildTensorTypeStr(dbT->getDim(), DataType::Float);
+  std::string dbName = dbT->getValueNameAsm() + "_" + suffix + "_perm";
+  std::string dbType =
+      dbT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  std::string permuteDB = getLayoutConversionOpsAsm(
+      dbT, "permute_DBIAS", suffix, /*isInput=*/false);
+
+  return std::format(schema,
+                     suffix,   // {0}
+                     f32,      // {1}
+                     dtype,    // {2}
+                     dimsOps,  // {3}
+                     aName,    // {4}
+                     aType,    // {5}
+                     accType,  // {6}
+                     dbName,   // {7}
+                     dbType,   // {8}
+                     permuteDB // {9}
+  );
+}
+
+// Emits the split-K form of the matmul, defining `product` of type `type`,
+// in MLIR assembly format. A [..., M, K] is viewed as [..., M, S, K/S] and
+// transposed to [..., S, M, K/S], B [..., K, N] is viewed as
+// [..., S, K/S, N], and one batched matmul computes the S partial products
+// [..., S, M, N], which are summed in f32.
+inline std::string
+MatmulNode::getSplitKOpsAsm(const std::string &product,
+                            const std::string &type) const {
+  constexpr std::string_view schema = R"(
+    %splitk_keepdim_{0} = torch.constant.bool false
+    %splitk_f32_{0} = torch.constant.int {1}
+    %splitk_dtype_{0} = torch.constant.int {2}
+    %splitk_none_{0} = torch.constant.none
+    %splitk_m_{0} = torch.constant.int {3}
+    %splitk_s_{0} = torch.constant.int {4}
+    {5}
+    %splitk_a_view_{0} = torch.aten.view {6}, %splitk_a_shape_{0} : {7}, !torch.list<int> -> {8}
+    %splitk_a_{0} = torch.aten.transpose.int %splitk_a_view_{0}, %splitk_m_{0}, %splitk_s_{0} : {8}, !torch.int, !torch.int -> {9}
+    %splitk_b_{0} = torch.aten.view {10}, %splitk_b_shape_{0} : {11}, !torch.list<int> -> {12}
+    %splitk_partial_{0} = torch.aten.matmul %splitk_a_{0}, %splitk_b_{0} : {9}, {12} -> {13}
+    %splitk_acc_{0} = torch.aten.sum.dim_IntList %splitk_partial_{0}, %splitk_dims_{0}, %splitk_keepdim_{0}, %splitk_f32_{0} : {13}, !torch.list<int>, !torch.bool, !torch.int -> {14}
+    {15} = torch.aten.to.dtype %splitk_acc_{0}, %splitk_dtype_{0}, %splitk_keepdim_{0}, %splitk_keepdim_{0}, %splitk_none_{0} : {14}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {16}
+)";
+
+  std::string suffix = matmulAttr.getName();
+  std::shared_ptr<TensorAttr> aT = matmulAttr.getA();
+  std::shared_ptr<TensorAttr> bT = matmulAttr.getB();
+  std::shared_ptr<TensorAttr> cT = matmulAttr.getC();
+  DataType inType = aT->getDataType();
+  DataType outType = cT->getDataType();
+
+  const std::vector<int64_t> &aDim = aT->getDim();
+  const std::vector<int64_t> &bDim = bT->getDim();
+  size_t rank = aDim.size();
+  int64_t splitK = matmulAttr.getSplitK();
+  int64_t sliceK = aDim[rank - 1] / splitK;
+  // Inserts `dims` in place of the last `count` dims of `base`.
+  auto replaceTail = [](const std::vector<int64_t> &base, size_t count,
+                        const std::vector<int64_t> &dims) {
+    std::vector<int64_t> out(base.begin(), base.end() - count);
+    out.insert(out.end(), dims.begin(), dims.end());
+    return out;
+  };
+  std::vector<int64_t> aViewDim =
+      replaceTail(aDim, 2, {aDim[rank - 2], splitK, sliceK});
+  std::vector<int64_t> aSplitDim =
+      replaceTail(aDim, 2, {splitK, aDim[rank - 2], sliceK});
+  std::vector<int64_t> bSplitDim =
+      replaceTail(bDim, 2, {splitK, sliceK, bDim[rank - 1]});
+  const std::vector<int64_t> &cDim = cT->getDim();
+  std::vector<int64_t> partialDim =
+      replaceTail(cDim, 2, {splitK, cDim[rank - 2], cDim[rank - 1]});
+
+  std::string shapeOps = getListOfIntOpsAsm(
+      {static_cast<int64_t>(rank) - 2}, "splitk_dims", suffix);
+  shapeOps += "    ";
+  appendListOfIntOpsAsm(shapeOps, aViewDim, "splitk_a_shape", suffix);
+  shapeOps += "    ";
+  appendListOfIntOpsAsm(shapeOps, bSplitDim, "splitk_b_shape", suffix);
+  auto logicalType = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true,
+                               /*useLogicalDims=*/true);
+  };
+
+  return std::format(
+      schema,
+      suffix,                                                     // {0}
+      static_cast<int>(kDataTypeToTorchType.at(DataType::Float)), // {1}
+      static_cast<int>(kDataTypeToTorchType.at(outType)),         // {2}
+      static_cast<int64_t>(rank) - 2,                             // {3}
+      static_cast<int64_t>(rank) - 1,                             // {4}
+      shapeOps,                                                   // {5}
+      aT->getValueNameAsm() + "_" + suffix + "_perm",             // {6}
+      logicalType(aT),                                            // {7}
+      buildTensorTypeStr(aViewDim, inType),                       // {8}
+      buildTensorTypeStr(aSplitDim, inType),                      // {9}
+      bT->getValueNameAsm() + "_" + suffix + "_perm",             // {10}
+      logicalType(bT),                                            // {11}
+      buildTensorTypeStr(bSplitDim, inType),                      // {12}
+      buildTensorTypeStr(partialDim, outType),                    // {13}
+      buildTensorTypeStr(cDim, DataType::Float),                  // {14}
+      product,                                                    // {15}
+      type                                                        // {16}
+  );
+}
+
+inline std::string MatmulNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {8}
+    {9}
+    {7}
+    {2}
+    {5}
+    {4}
+    {6}
+    {3}
+  )";
+
+  std::string uniqueSSASuffix = matmulAttr.getName();
+  std::string permuteA = getLayoutConversionOpsAsm(
+      matmulAttr.getA(), "permute_A", uniqueSSASuffix, /*isInput=*/true);
+  std::string permuteB = getLayoutConversionOpsAsm(
+      matmulAttr.getB(), "permute_B", uniqueSSASuffix, /*isInput=*/true);
+  std::string permuteC = getLayoutConversionOpsAsm(
+      matmulAttr.getC(), "permute_C", uniqueSSASuffix, /*isInput=*/false);
+
+  // With an epilogue the matmul product is an intermediate of the node, and
+  // when grouped so is the epilogue result before the group mask.
+  std::string resultName = matmulAttr.isGrouped()
+                               ? "%matmul_unmasked_" + uniqueSSASuffix
+                               : getResultNamesAsm();
+  std::string productName = matmulAttr.hasEpilogue()
+                                ? "%matmul_product_" + uniqueSSASuffix
+                                : resultName;
+  std::string epilogue = matmulAttr.hasEpilogue()
+                             ? getEpilogueOpsAsm(productName, resultName)
+                             : "";
+
+  // With scales the matmul accumulates the quantized operands in a wider
+  // type, and the dequantized accumulator is the product.
+  std::string matmulName = productName;
+  std::string matmulType = getResultTypesAsm();
+  // Gated, the matmul computes both halves, which the gate ops (in place of
+  // the epilogue) multiply into the result.
+  if (matmulAttr.isGated()) {
+    matmulName = "%matmul_gate_up_" + uniqueSSASuffix;
+    matmulType = getGatedProductTypeAsm();
+    epilogue = getGateOpsAsm(matmulName, resultName);
+  }
+  std::string dequantize;
+  if (matmulAttr.hasScales()) {
+    std::shared_ptr<TensorAttr> cT = matmulAttr.getC();
+    DataType accType =
+        getQuantizedAccumulatorType(matmulAttr.getA()->getDataType());
+    std::vector<std::pair<std::string, std::shared_ptr<TensorAttr>>> scales;
+    if (matmulAttr.getSCALE_A())
+      scales.emplace_back("SCALE_A", matmulAttr.getSCALE_A());
+    if (matmulAttr.getSCALE_B())
+      scales.emplace_back("SCALE_B", matmulAttr.getSCALE_B());
+    matmulName = "%matmul_acc_" + uniqueSSASuffix;
+    matmulType = buildTensorTypeStr(cT->getDim(), accType);
+    dequantize = getDequantizeOpsAsm(matmulName, accType, scales, cT,
+                                     productName, uniqueSSASuffix);
+  }
+
+  std::string matmul =
+      matmulAttr.isSplitK()
+          ? getSplitKOpsAsm(matmulName, matmulType)
+          : std::format("{} = torch.aten.matmul {} : {} -> {}", matmulName,
+                        getOperandNamesAsm(), getOperandTypesAsm(),
+                        matmulType);
+  std::string groupMask = getGroupMaskOpsAsm(resultName);
+  std::string biasGradient = getBiasGradientOpsAsm();
+  std::string sparseExpand = getSparseExpandOpsAsm();
+  std::string groupDequantize = getGroupDequantizeOpsAsm();
+
+  std::string output = std::format(schema,
+                                   permuteA,       // {0}
+                                   permuteB,       // {1}
+                                   matmul,         // {2}
+                                   permuteC,       // {3}
+                                   epilogue,       // {4}
+                                   dequantize,     // {5}
+                                   groupMask,      // {6}
+                                   biasGradient,   // {7}
+                                   sparseExpand,   // {8}
+                                   groupDequantize // {9}
+  );
+
+  return output;
+}
+
+//===----------------------------------------------------------------------===//
+//
+// PointwiseNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits the SSA name for a single PointwiseNode input in MLIR assembly
+// format.
+//
+// The unique suffix is included to ensure SSA uniqueness when the same
+// tensor is used by multiple operations in a graph.
+inline std::string PointwiseNode::getInputNameAsm(size_t inputIndex) const {
+  const auto &in = pointwiseAttr.inputs.at(
+      static_cast<PointwiseAttr::InputNames>(inputIndex));
+  return in->getValueNameAsm() + "_" + pointwiseAttr.getName() + "_perm";
+}
+
+// Emits the type for a single PointwiseNode input in MLIR assembly format.
+inline std::string PointwiseNode::getInputTypeAsm(size_t inputIndex) const {
+  const auto &in = pointwiseAttr.inputs.at(
+      static_cast<PointwiseAttr::InputNames>(inputIndex));
+  return in->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+}
+
+// Emits PointwiseNode's operand names in MLIR assembly format.
 inline std::string PointwiseNode::getOperandNamesAsm() const {
   std::ostringstream oss;
   oss << getInputNameAsm(0);
@@ -1879,6 +3868,18 @@ inline std::string PointwiseNode::emitNodePreAsm() const {
     {5}
 )";
 
+  // `torch.aten.clone` keeps the data type, so identities converting between
+  // data types (e.g. the casts inserted by `Graph::autocast()`) convert
+  // explicitly.
+  constexpr std::string_view kCastSchema = R"(
+    {0}
+    %cast_dtype_{7} = torch.constant.int {6}
+    %cast_false_{7} = torch.constant.bool false
+    %cast_none_{7} = torch.constant.none
+    {1} = torch.aten.to.dtype {2}, %cast_dtype_{7}, %cast_false_{7}, %cast_false_{7}, %cast_none_{7} : {3}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {4}
+    {5}
+)";
+
   constexpr std::string_view kEluSchema = R"(
     {0}
     %elu_alpha_{7} = torch.constant.float {8:e}
@@ -2041,8 +4042,31 @@ inline std::string PointwiseNode::emitNodePreAsm() const {
                        getInputTypeAsm(1)            /* {10} x type */
     );
   }
-    FUSILLI_DECLARE_UNARY_POINTWISE_EMITTER(IDENTITY, kIdentitySchema,
-                                            torch.aten.clone)
+  case PointwiseAttr::Mode::IDENTITY: {
+    DataType outType = pointwiseAttr.getOUT_0()->getDataType();
+    if (pointwiseAttr.getIN_0()->getDataType() != outType) {
+      int64_t torchType =
+          static_cast<int64_t>(kDataTypeToTorchType.at(outType));
+      return std::format(kCastSchema, permuteIN0, /* {0} */
+                         getResultNamesAsm(),     /* {1} */
+                         getOperandNamesAsm(),    /* {2} */
+                         getOperandTypesAsm(),    /* {3} */
+                         getResultTypesAsm(),     /* {4} */
+                         permuteOUT0,             /* {5} */
+                         torchType,               /* {6} */
+                         getName()                /* {7} */
+      );
+    }
+    return std::format(kIdentitySchema, permuteIN0, /* {0} */
+                       getResultNamesAsm(),         /* {1} */
+                       getOperandNamesAsm(),        /* {2} */
+                       getOperandTypesAsm(),        /* {3} */
+                       getResultTypesAsm(),         /* {4} */
+                       permuteOUT0,                 /* {5} */
+                       "torch.aten.clone",          /* {6} */
+                       getName()                    /* {7} */
+    );
+  }
     FUSILLI_DECLARE_UNARY_TORCH_EMITTER(ERF, torch.aten.erf)
     FUSILLI_DECLARE_UNARY_TORCH_EMITTER(EXP, torch.aten.exp)
     FUSILLI_DECLARE_UNARY_TORCH_EMITTER(FLOOR, torch.aten.floor)
@@ -2246,6 +4270,26 @@ inline std::string ReductionNode::emitNodePreAsm() const {
     {7}
     )";
 
+  constexpr std::string_view kArgReductionSchema = R"(
+    {0}
+    %reduction_dim_{1} = torch.constant.int {2}
+    %keepdim_{1} = torch.constant.bool true
+    {3}_{1}_perm = {4} {5}, %reduction_dim_{1}, %keepdim_{1} : {6}, !torch.int, !torch.bool -> {7}
+    {8}
+    )";
+
+  // The k largest values along the reduced dim, sorted in descending order.
+  constexpr std::string_view kTopKSchema = R"(
+    {0}
+    %topk_k_{1} = torch.constant.int {2}
+    %reduction_dim_{1} = torch.constant.int {3}
+    %topk_largest_{1} = torch.constant.bool true
+    %topk_sorted_{1} = torch.constant.bool true
+    {4}_{1}_perm, {5}_{1}_perm = torch.aten.topk {6}, %topk_k_{1}, %reduction_dim_{1}, %topk_largest_{1}, %topk_sorted_{1} : {7}, !torch.int, !torch.int, !torch.bool, !torch.bool -> {8}, {9}
+    {10}
+    {11}
+    )";
+
 #define FUSILLI_DECLARE_REDUCTION_EMITTER(MODE, SCHEMA, OPIR)                  \
   case ReductionAttr::Mode::MODE: {                                            \
     return std::format(SCHEMA, permuteX,     /* {0} */                         \
@@ -2315,6 +4359,45 @@ inline std::string ReductionNode::emitNodePreAsm() const {
                        boolType                     /* {8} */
     );
   }
+  case ReductionAttr::Mode::MIN_MAX:
+  case ReductionAttr::Mode::SUM_SUMSQ:
+  case ReductionAttr::Mode::MEAN_VAR:
+    return getMultiOutputReductionAsm();
+  case ReductionAttr::Mode::ARGMAX:
+  case ReductionAttr::Mode::ARGMIN: {
+    bool isMax = reductionAttr.getMode() == ReductionAttr::Mode::ARGMAX;
+    return std::format(kArgReductionSchema, permuteX, /* {0} */
+                       suffix,                        /* {1} */
+                       reductionDims[0],              /* {2} */
+                       getResultNamesAsm(),           /* {3} */
+                       isMax ? "torch.aten.argmax"
+                             : "torch.aten.argmin",   /* {4} */
+                       getOperandNamesAsm(),          /* {5} */
+                       getOperandTypesAsm(),          /* {6} */
+                       getResultTypesAsm(),           /* {7} */
+                       permuteY                       /* {8} */
+    );
+  }
+  case ReductionAttr::Mode::TOPK: {
+    const auto &y2T = reductionAttr.getY2();
+    int64_t dim = reductionDims[0];
+    return std::format(
+        kTopKSchema, permuteX,                                 /* {0} */
+        suffix,                                                /* {1} */
+        yT->getDim()[static_cast<size_t>(dim)],                /* {2} */
+        dim,                                                   /* {3} */
+        getResultNamesAsm(),                                   /* {4} */
+        y2T->getValueNameAsm(),                                /* {5} */
+        getOperandNamesAsm(),                                  /* {6} */
+        getOperandTypesAsm(),                                  /* {7} */
+        getResultTypesAsm(),                                   /* {8} */
+        y2T->getTensorTypeAsm(/*isValueTensor=*/true,
+                              /*useLogicalDims=*/true),        /* {9} */
+        permuteY,                                              /* {10} */
+        getLayoutConversionOpsAsm(y2T, "permute_Y2", suffix,
+                                  /*isInput=*/false)           /* {11} */
+    );
+  }
   default:
     assert(false && "Unsupported reduction mode");
     return "";
@@ -2326,12 +4409,212 @@ inline std::string ReductionNode::emitNodePreAsm() const {
 #undef FUSILLI_DECLARE_KEEPDIM_DTYPE_REDUCTION_EMITTER
 #undef FUSILLI_DECLARE_CUSTOM_REDUCTION_EMITTER
 
+// Emits the multi-output reduction modes. Both statistics are reductions of
+// the same (logical) X over the same dims, which the compiler fuses into a
+// single dispatch reading X once:
+//
+//   MIN_MAX:   Y = amin(X), Y2 = amax(X)
+//   SUM_SUMSQ: Y = sum(X), Y2 = sum(X * X)
+//   MEAN_VAR:  Y = sum(X) / N, Y2 = max(sum(X * X) / N - Y * Y, 0)
+//
+// The sums accumulate in the element type of Y, so a low precision X can be
+// summed in f32 by setting the data type of Y (and Y2).
+inline std::string ReductionNode::getMultiOutputReductionAsm() const {
+  const auto &xT = reductionAttr.getX();
+  const auto &yT = reductionAttr.getY();
+  const auto &y2T = reductionAttr.getY2();
+  std::string suffix = reductionAttr.getName();
+  std::string yName = yT->getValueNameAsm() + "_" + suffix + "_perm";
+  std::string y2Name = y2T->getValueNameAsm() + "_" + suffix + "_perm";
+  std::string yType = getResultTypesAsm();
+
+  std::ostringstream oss;
+  oss << "\n    "
+      << getLayoutConversionOpsAsm(xT, "permute_X", suffix, /*isInput=*/true);
+  oss << "\n    "
+      << getListOfIntOpsAsm(getReductionDims(), "reduction_dims", suffix);
+  oss << "\n    " << torchBoolAsm("keepdim", suffix, true);
+
+  if (reductionAttr.getMode() == ReductionAttr::Mode::MIN_MAX) {
+    constexpr std::string_view schema = R"(
+    {0} = torch.aten.amin {2}, %reduction_dims_{4}, %keepdim_{4} : {3}, !torch.list<int>, !torch.bool -> {5}
+    {1} = torch.aten.amax {2}, %reduction_dims_{4}, %keepdim_{4} : {3}, !torch.list<int>, !torch.bool -> {5}
+)";
+    oss << std::format(schema,
+                       yName,                // {0}
+                       y2Name,               // {1}
+                       getOperandNamesAsm(), // {2}
+                       getOperandTypesAsm(), // {3}
+                       suffix,               // {4}
+                       yType                 // {5}
+    );
+  } else {
+    // Convert X to the element type of the sums first, so squares of a low
+    // precision X do not overflow.
+    std::string acc = getOperandNamesAsm();
+    std::string accType = getOperandTypesAsm();
+    if (xT->getDataType() != yT->getDataType()) {
+      std::vector<int64_t> accDim = xT->getDim();
+      for (size_t i = 0; i < accDim.size(); ++i)
+        if (xT->isDynamicDim(i))
+          accDim[i] = -1;
+      accType = buildTensorTypeStr(accDim, yT->getDataType());
+      constexpr std::string_view convertSchema = R"(
+    {0}
+    {1}
+    {2}
+    %acc_{3} = torch.aten.to.dtype {4}, %acc_dtype_{3}, %acc_false_{3}, %acc_false_{3}, %acc_none_{3} : {5}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {6})";
+      int64_t accDtype =
+          static_cast<int64_t>(kDataTypeToTorchType.at(yT->getDataType()));
+      oss << std::format(convertSchema,
+                         torchIntAsm("acc_dtype", suffix, accDtype), // {0}
+                         torchBoolAsm("acc_false", suffix, false),   // {1}
+                         torchNoneAsm("acc_none", suffix),           // {2}
+                         suffix,                                     // {3}
+                         acc,                                        // {4}
+                         getOperandTypesAsm(),                       // {5}
+                         accType                                     // {6}
+      );
+      acc = "%acc_" + suffix;
+    }
+
+    bool isMeanVar = reductionAttr.getMode() == ReductionAttr::Mode::MEAN_VAR;
+    constexpr std::string_view sumsSchema = R"(
+    %dtype_{0} = torch.constant.none
+    %sq_{0} = torch.aten.mul.Tensor {1}, {1} : {2}, {2} -> {2}
+    {3} = torch.aten.sum.dim_IntList {1}, %reduction_dims_{0}, %keepdim_{0}, %dtype_{0} : {2}, !torch.list<int>, !torch.bool, !torch.none -> {5}
+    {4} = torch.aten.sum.dim_IntList %sq_{0}, %reduction_dims_{0}, %keepdim_{0}, %dtype_{0} : {2}, !torch.list<int>, !torch.bool, !torch.none -> {5}
+)";
+    std::string sumName = isMeanVar ? "%sum_" + suffix : yName;
+    std::string sumSqName = isMeanVar ? "%sumsq_" + suffix : y2Name;
+    oss << std::format(sumsSchema,
+                       suffix,    // {0}
+                       acc,       // {1}
+                       accType,   // {2}
+                       sumName,   // {3}
+                       sumSqName, // {4}
+                       yType      // {5}
+    );
+
+    if (isMeanVar) {
+      int64_t count = 1;
+      for (int64_t d : getReductionDims())
+        count *= xT->getDim()[static_cast<size_t>(d)];
+      constexpr std::string_view meanVarSchema = R"(
+    %count_{0} = torch.constant.int {1}
+    {2} = torch.aten.div.Scalar %sum_{0}, %count_{0} : {4}, !torch.int -> {4}
+    %meansq_{0} = torch.aten.div.Scalar %sumsq_{0}, %count_{0} : {4}, !torch.int -> {4}
+    %sqmean_{0} = torch.aten.mul.Tensor {2}, {2} : {4}, {4} -> {4}
+    %alpha_{0} = torch.constant.int 1
+    %var_{0} = torch.aten.sub.Tensor %meansq_{0}, %sqmean_{0}, %alpha_{0} : {4}, {4}, !torch.int -> {4}
+    {3} = torch.aten.relu %var_{0} : {4} -> {4}
+)";
+      oss << std::format(meanVarSchema,
+                         suffix, // {0}
+                         count,  // {1}
+                         yName,  // {2}
+                         y2Name, // {3}
+                         yType   // {4}
+      );
+    }
+  }
+
+  oss << "    "
+      << getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false);
+  oss << "\n    "
+      << getLayoutConversionOpsAsm(y2T, "permute_Y2", suffix,
+                                   /*isInput=*/false)
+      << "\n    ";
+  return oss.str();
+}
+
 //===----------------------------------------------------------------------===//
 //
 // SdpaNode ASM Emitter Methods
 //
 //===----------------------------------------------------------------------===//
 
+// Emits the f32 attention scores `%scores_{suffix}` = scale * Q @ K^T of
+// the permuted Q [batch, heads, seq_q, head_dim] and K
+// [batch, heads, seq_kv, head_dim]. When causal, the scores above the
+// (top-left aligned) diagonal are filled with -inf. Shared by the forward
+// stats and the backward pass, which must see identical scores.
+inline std::string
+getSdpaScoresOpsAsm(const std::shared_ptr<TensorAttr> &qT,
+                    const std::shared_ptr<TensorAttr> &kT, float scale,
+                    bool isCausal, const std::string &suffix) {
+  const std::vector<int64_t> &qDim = qT->getDim();
+  const std::vector<int64_t> &kDim = kT->getDim();
+  DataType dtype = qT->getDataType();
+  std::vector<int64_t> scoresDim = {qDim[0], qDim[1], qDim[2], kDim[2]};
+  std::string scoresType = buildTensorTypeStr(scoresDim, dtype);
+  std::string scoresF32Type = buildTensorTypeStr(scoresDim, DataType::Float);
+
+  constexpr std::string_view schema = R"(
+    %scores_int1_{0} = torch.constant.int 1
+    %scores_int2_{0} = torch.constant.int 2
+    %scores_int3_{0} = torch.constant.int 3
+    %scores_none_{0} = torch.constant.none
+    %scores_false_{0} = torch.constant.bool false
+    %scores_f32_{0} = torch.constant.int {1}
+    {2}
+    %scores_kt_{0} = torch.aten.transpose.int {3}_{0}_perm, %scores_int2_{0}, %scores_int3_{0} : {4}, !torch.int, !torch.int -> {5}
+    %scores_qk_{0} = torch.aten.matmul {6}_{0}_perm, %scores_kt_{0} : {7}, {5} -> {8}
+    %scores_qk_f32_{0} = torch.aten.to.dtype %scores_qk_{0}, %scores_f32_{0}, %scores_false_{0}, %scores_false_{0}, %scores_none_{0} : {8}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {9}
+    {10} = torch.aten.mul.Scalar %scores_qk_f32_{0}, %scores_scale_{0} : {9}, !torch.float -> {9}
+)";
+  std::string kType =
+      kT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  std::string kTransposedType =
+      buildTensorTypeStr({kDim[0], kDim[1], kDim[3], kDim[2]},
+                         kT->getDataType());
+  std::string qType =
+      qT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  std::string resultName =
+      (isCausal ? "%scores_unmasked_" : "%scores_") + suffix;
+
+  std::string ops = std::format(
+      schema,
+      suffix,                                              // {0}
+      static_cast<int>(torch_upstream::ScalarType::Float), // {1}
+      torchFloatAsm("scores_scale", suffix, scale),        // {2}
+      kT->getValueNameAsm(),                               // {3}
+      kType,                                               // {4}
+      kTransposedType,                                     // {5}
+      qT->getValueNameAsm(),                               // {6}
+      qType,                                               // {7}
+      scoresType,                                          // {8}
+      scoresF32Type,                                       // {9}
+      resultName                                           // {10}
+  );
+  if (!isCausal)
+    return ops;
+
+  // -inf is spelled as its f64 bit pattern, as torch-mlir prints it.
+  constexpr std::string_view causalSchema = R"(
+    {1}
+    %scores_bool_{0} = torch.constant.int {2}
+    %scores_ones_{0} = torch.aten.ones %scores_causal_shape_{0}, %scores_bool_{0}, %scores_none_{0}, %scores_none_{0}, %scores_none_{0} : !torch.list<int>, !torch.int, !torch.none, !torch.none, !torch.none -> {3}
+    %scores_future_{0} = torch.aten.triu %scores_ones_{0}, %scores_int1_{0} : {3}, !torch.int -> {3}
+    %scores_neg_inf_{0} = torch.constant.float 0xFFF0000000000000
+    %scores_{0} = torch.aten.masked_fill.Scalar %scores_unmasked_{0}, %scores_future_{0}, %scores_neg_inf_{0} : {4}, {3}, !torch.float -> {4}
+)";
+  std::string causalShape =
+      getListOfIntOpsAsm({qDim[2], kDim[2]}, "scores_causal_shape", suffix);
+  std::string causalType =
+      buildTensorTypeStr({qDim[2], kDim[2]}, DataType::Boolean);
+
+  int boolType = static_cast<int>(torch_upstream::ScalarType::Bool);
+
+  return ops + std::format(causalSchema,
+                           suffix,       // {0}
+                           causalShape,  // {1}
+                           boolType,     // {2}
+                           causalType,   // {3}
+                           scoresF32Type // {4}
+               );
+}
+
 // Emits SdpaNode's operand names in MLIR assembly format.
 //
 // The unique suffix is included to ensure SSA uniqueness when the same
@@ -2339,9 +4622,16 @@ inline std::string ReductionNode::emitNodePreAsm() const {
 inline std::string SdpaNode::getOperandNamesAsm() const {
   std::string suffix = sdpaAttr.getName();
   std::ostringstream oss;
-  oss << sdpaAttr.getQ()->getValueNameAsm() << "_" << suffix << "_perm, "
-      << sdpaAttr.getK()->getValueNameAsm() << "_" << suffix << "_perm, "
-      << sdpaAttr.getV()->getValueNameAsm() << "_" << suffix << "_perm";
+  if (sdpaAttr.isVarlen())
+    return std::format("%varlen_q_{0}, %varlen_k_{0}, %varlen_v_{0}, "
+                       "%varlen_mask_{0}",
+                       suffix);
+  oss << sdpaAttr.getQ()->getValueNameAsm() << "_" << suffix << "_perm, ";
+  if (sdpaAttr.isPaged())
+    oss << "%paged_k_" << suffix << ", %paged_v_" << suffix;
+  else
+    oss << sdpaAttr.getK()->getValueNameAsm() << "_" << suffix << "_perm, "
+        << sdpaAttr.getV()->getValueNameAsm() << "_" << suffix << "_perm";
   if (sdpaAttr.getMASK())
     oss << ", " << sdpaAttr.getMASK()->getValueNameAsm() << "_" << suffix
         << "_perm";
@@ -2351,16 +4641,35 @@ inline std::string SdpaNode::getOperandNamesAsm() const {
 }
 
 // Emits SdpaNode's operand types in MLIR assembly format.
+//
+// In paged mode K and V are the gathered [batch, heads_kv, seq_kv, head_dim]
+// values rather than the page pools. In varlen mode Q, K and V are the
+// packed tensors viewed as one batch, followed by the boolean mask.
 inline std::string SdpaNode::getOperandTypesAsm() const {
+  if (sdpaAttr.isVarlen()) {
+    std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
+    std::shared_ptr<TensorAttr> kT = sdpaAttr.getK();
+    std::shared_ptr<TensorAttr> vT = sdpaAttr.getV();
+    std::vector<int64_t> qDim = getVarlenBatchedDim(qT);
+    std::vector<int64_t> kDim = getVarlenBatchedDim(kT);
+    std::vector<int64_t> maskDim = {1, 1, qDim[2], kDim[2]};
+    return std::format(
+        "{}, {}, {}, {}", buildTensorTypeStr(qDim, qT->getDataType()),
+        buildTensorTypeStr(kDim, kT->getDataType()),
+        buildTensorTypeStr(getVarlenBatchedDim(vT), vT->getDataType()),
+        buildTensorTypeStr(maskDim, DataType::Boolean));
+  }
+
+  auto kvType = [&](const std::shared_ptr<TensorAttr> &kvT) {
+    if (sdpaAttr.isPaged())
+      return buildTensorTypeStr(getGatheredKvDim(kvT), kvT->getDataType());
+    return kvT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                 /*useLogicalDims=*/true);
+  };
   std::ostringstream oss;
   oss << sdpaAttr.getQ()->getTensorTypeAsm(/*isValueTensor=*/true,
                                            /*useLogicalDims=*/true)
-      << ", "
-      << sdpaAttr.getK()->getTensorTypeAsm(/*isValueTensor=*/true,
-                                           /*useLogicalDims=*/true)
-      << ", "
-      << sdpaAttr.getV()->getTensorTypeAsm(/*isValueTensor=*/true,
-                                           /*useLogicalDims=*/true)
+      << ", " << kvType(sdpaAttr.getK()) << ", " << kvType(sdpaAttr.getV())
       << ", ";
   if (sdpaAttr.getMASK())
     oss << sdpaAttr.getMASK()->getTensorTypeAsm(/*isValueTensor=*/true,
@@ -2387,9 +4696,193 @@ inline std::string SdpaNode::getDropoutOpsAsm() const {
   return torchFloatAsm("dropout", sdpaAttr.getName(), sdpaAttr.getDropout());
 }
 
-// Emits the is_causal boolean constant.
+// Emits attention with dropout driven by the runtime DROPOUT_SEED and
+// DROPOUT_OFFSET tensors (see `SdpaAttr::hasDropoutRng()`) into the result.
+// The fused op only takes a compile-time probability, so the attention is
+// decomposed into the f32 scores, their softmax, the dropout and the product
+// with V.
+//
+// Element i of the flattened [batch, heads, seq_q, seq_kv] probabilities is
+// dropped when the first output word of Philox4x32-10, keyed by the seed's
+// low and high words and with counter (i_lo, i_hi, offset_lo, offset_hi), is
+// below p * 2^32; kept probabilities are scaled by 1 / (1 - p). The words are
+// held in si64 tensors: the 32x32-bit products of a round wrap modulo 2^64,
+// and their high and low words are recovered with a shift and a mask.
+inline std::string SdpaNode::getDropoutRngOpsAsm() const {
+  std::string suffix = sdpaAttr.getName();
+  std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
+  std::shared_ptr<TensorAttr> vT = sdpaAttr.getV();
+  std::shared_ptr<TensorAttr> seedT = sdpaAttr.getDROPOUT_SEED();
+  std::shared_ptr<TensorAttr> offsetT = sdpaAttr.getDROPOUT_OFFSET();
+  const std::vector<int64_t> &qDim = qT->getDim();
+  float dropout = sdpaAttr.getDropout();
+
+  std::vector<int64_t> probsDim = {qDim[0], qDim[1], qDim[2], getSeqKV()};
+  int64_t numel = probsDim[0] * probsDim[1] * probsDim[2] * probsDim[3];
+  std::string probsType = buildTensorTypeStr(probsDim, DataType::Float);
+  std::string maskType = buildTensorTypeStr(probsDim, DataType::Boolean);
+  std::string wordsType = buildTensorTypeStr({numel}, DataType::Int64);
+  std::string flagsType = buildTensorTypeStr({numel}, DataType::Boolean);
+  std::string keyType = buildTensorTypeStr({1}, DataType::Int64);
+  // Dropped when the word is below the threshold, i.e. with probability p.
+  auto threshold = static_cast<int64_t>(
+      std::llround(static_cast<double>(dropout) * 4294967296.0));
+
+  std::string ops = getSdpaScoresOpsAsm(
+      qT, sdpaAttr.getK(), getSdpaScale(sdpaAttr.getScale(), qDim[3]),
+      sdpaAttr.getIsCausal(), suffix);
+
+  constexpr std::string_view setupSchema = R"(
+    %rng_int1_{0} = torch.constant.int 1
+    %rng_long_{0} = torch.constant.int {1}
+    %rng_numel_{0} = torch.constant.int {2}
+    %rng_mask32_{0} = torch.constant.int 4294967295
+    %rng_mul0_{0} = torch.constant.int 3528531795
+    %rng_mul1_{0} = torch.constant.int 3449720151
+    %rng_weyl0_{0} = torch.constant.int 2654435769
+    %rng_weyl1_{0} = torch.constant.int 3144134277
+    %rng_threshold_{0} = torch.constant.int {3}
+    %rng_shift32_{0} = torch.vtensor.literal(dense<32> : tensor<si64>) : !torch.vtensor<[],si64>
+    {4}
+    %rng_idx_{0} = torch.aten.arange %rng_numel_{0}, %rng_long_{0}, %scores_none_{0}, %scores_none_{0}, %scores_none_{0} : !torch.int, !torch.int, !torch.none, !torch.none, !torch.none -> {5}
+)";
+  ops += std::format(setupSchema,
+                     suffix,                                             // {0}
+                     static_cast<int>(torch_upstream::ScalarType::Long), // {1}
+                     numel,                                              // {2}
+                     threshold,                                          // {3}
+                     getListOfIntOpsAsm({numel}, "rng_flat_shape",
+                                        suffix),                         // {4}
+                     wordsType                                           // {5}
+  );
+
+  auto append = [&](std::string_view line) {
+    ops += "    ";
+    ops += line;
+    ops += '\n';
+  };
+  // Low and high 32-bit words of `operand` into `%{name}_{suffix}`.
+  auto lo32 = [&](const std::string &name, const std::string &operand,
+                  const std::string &type) {
+    append(std::format("%{0}_{1} = torch.aten.bitwise_and.Scalar {2}, "
+                       "%rng_mask32_{1} : {3}, !torch.int -> {3}",
+                       name, suffix, operand, type));
+    return "%" + name + "_" + suffix;
+  };
+  auto hi32 = [&](const std::string &name, const std::string &operand,
+                  const std::string &type) {
+    append(std::format("%{0}_shr_{1} = torch.aten.bitwise_right_shift.Tensor "
+                       "{2}, %rng_shift32_{1} : {3}, !torch.vtensor<[],si64> "
+                       "-> {3}",
+                       name, suffix, operand, type));
+    return lo32(name, "%" + name + "_shr_" + suffix, type);
+  };
+  auto xor3 = [&](const std::string &name, const std::string &a,
+                  const std::string &b, const std::string &key) {
+    append(std::format("%{0}_x_{1} = torch.aten.bitwise_xor.Tensor {2}, {3} "
+                       ": {4}, {4} -> {4}",
+                       name, suffix, a, b, wordsType));
+    append(std::format("%{0}_{1} = torch.aten.bitwise_xor.Tensor %{0}_x_{1}, "
+                       "{2} : {3}, {4} -> {3}",
+                       name, suffix, key, wordsType, keyType));
+    return "%" + name + "_" + suffix;
+  };
+
+  // Key from the seed, counter from the element index and the offset.
+  std::string seed = seedT->getValueNameAsm();
+  std::string offset = offsetT->getValueNameAsm();
+  std::string key0 = lo32("rng_key0", seed, keyType);
+  std::string key1 = hi32("rng_key1", seed, keyType);
+  std::string c0 = lo32("rng_c0", "%rng_idx_" + suffix, wordsType);
+  std::string c1 = hi32("rng_c1", "%rng_idx_" + suffix, wordsType);
+  std::string offsetLo = lo32("rng_offset_lo", offset, keyType);
+  std::string offsetHi = hi32("rng_offset_hi", offset, keyType);
+  std::string c2 = "%rng_c2_" + suffix, c3 = "%rng_c3_" + suffix;
+  for (const auto &[word, operand] : {std::pair{c2, offsetLo},
+                                      std::pair{c3, offsetHi}})
+    append(std::format("{0} = torch.aten.expand {1}, %rng_flat_shape_{2}, "
+                       "%scores_false_{2} : {3}, !torch.list<int>, "
+                       "!torch.bool -> {4}",
+                       word, operand, suffix, keyType, wordsType));
+
+  constexpr int kPhiloxRounds = 10;
+  for (int round = 0; round < kPhiloxRounds; ++round) {
+    std::string r = "rng_r" + std::to_string(round) + "_";
+    append(std::format("%{0}prod0_{1} = torch.aten.mul.Scalar {2}, "
+                       "%rng_mul0_{1} : {3}, !torch.int -> {3}",
+                       r, suffix, c0, wordsType));
+    append(std::format("%{0}prod1_{1} = torch.aten.mul.Scalar {2}, "
+                       "%rng_mul1_{1} : {3}, !torch.int -> {3}",
+                       r, suffix, c2, wordsType));
+    std::string hi0 =
+        hi32(r + "hi0", "%" + r + "prod0_" + suffix, wordsType);
+    std::string lo0 =
+        lo32(r + "lo0", "%" + r + "prod0_" + suffix, wordsType);
+    std::string hi1 =
+        hi32(r + "hi1", "%" + r + "prod1_" + suffix, wordsType);
+    std::string lo1 =
+        lo32(r + "lo1", "%" + r + "prod1_" + suffix, wordsType);
+    std::string next0 = xor3(r + "c0", hi1, c1, key0);
+    std::string next2 = xor3(r + "c2", hi0, c3, key1);
+    c0 = next0;
+    c1 = lo1;
+    c2 = next2;
+    c3 = lo0;
+    if (round + 1 == kPhiloxRounds)
+      break;
+    for (auto [key, weyl] : {std::pair{&key0, "weyl0"},
+                             std::pair{&key1, "weyl1"}}) {
+      std::string name = r + "k" + (key == &key0 ? "0" : "1");
+      append(std::format("%{0}_sum_{1} = torch.aten.add.Scalar {2}, "
+                         "%rng_{3}_{1}, %rng_int1_{1} : {4}, !torch.int, "
+                         "!torch.int -> {4}",
+                         name, suffix, *key, weyl, keyType));
+      *key = lo32(name, "%" + name + "_sum_" + suffix, keyType);
+    }
+  }
+
+  // Drop, rescale and apply the probabilities.
+  std::string keepScale =
+      torchFloatAsm("rng_keep_scale", suffix, 1.0f / (1.0f - dropout));
+  constexpr std::string_view applySchema = R"(
+    %rng_drop_flat_{0} = torch.aten.lt.Scalar {1}, %rng_threshold_{0} : {2}, !torch.int -> {3}
+    {4}
+    %rng_drop_{0} = torch.aten.view %rng_drop_flat_{0}, %rng_probs_shape_{0} : {3}, !torch.list<int> -> {5}
+    %rng_probs_{0} = torch.aten.softmax.int %scores_{0}, %scores_int3_{0}, %scores_none_{0} : {6}, !torch.int, !torch.none -> {6}
+    %rng_zero_{0} = torch.constant.float 0.000000e+00
+    %rng_dropped_{0} = torch.aten.masked_fill.Scalar %rng_probs_{0}, %rng_drop_{0}, %rng_zero_{0} : {6}, {5}, !torch.float -> {6}
+    {7}
+    %rng_scaled_{0} = torch.aten.mul.Scalar %rng_dropped_{0}, %rng_keep_scale_{0} : {6}, !torch.float -> {6}
+    %rng_dtype_{0} = torch.constant.int {8}
+    %rng_probs_v_{0} = torch.aten.to.dtype %rng_scaled_{0}, %rng_dtype_{0}, %scores_false_{0}, %scores_false_{0}, %scores_none_{0} : {6}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {9}
+    {10} = torch.aten.matmul %rng_probs_v_{0}, {11}_{0}_perm : {9}, {12} -> {13}
+)";
+  ops += std::format(
+      applySchema,
+      suffix,                                                       // {0}
+      c0,                                                           // {1}
+      wordsType,                                                    // {2}
+      flagsType,                                                    // {3}
+      getListOfIntOpsAsm(probsDim, "rng_probs_shape", suffix),      // {4}
+      maskType,                                                     // {5}
+      probsType,                                                    // {6}
+      keepScale,                                                    // {7}
+      static_cast<int>(kDataTypeToTorchType.at(vT->getDataType())), // {8}
+      buildTensorTypeStr(probsDim, vT->getDataType()),              // {9}
+      getResultNamesAsm(),                                          // {10}
+      vT->getValueNameAsm(),                                        // {11}
+      vT->getTensorTypeAsm(/*isValueTensor=*/true,
+                           /*useLogicalDims=*/true),                // {12}
+      getResultTypesAsm()                                           // {13}
+  );
+  return ops;
+}
+
+// Emits the is_causal boolean constant. In varlen mode causality is
+// applied per sequence through the generated mask instead.
 inline std::string SdpaNode::getIsCausalOpsAsm() const {
-  return torchBoolAsm("is_causal", sdpaAttr.getName(), sdpaAttr.getIsCausal());
+  return torchBoolAsm("is_causal", sdpaAttr.getName(),
+                      sdpaAttr.getIsCausal() && !sdpaAttr.isVarlen());
 }
 
 // Emits the scale constant (float or none).
@@ -2406,67 +4899,1580 @@ inline std::string SdpaNode::getEnableGqaOpsAsm() const {
                       sdpaAttr.getEnableGqa());
 }
 
-inline std::string SdpaNode::emitNodePreAsm() const {
+// Emits the page gather of a paged KV cache. The block table is flattened
+// and used to `index_select` each sequence's pages out of the K and V pools,
+// which are then regrouped into [batch, heads_kv, seq_kv, head_dim]. The
+// gather is a producer of the attention op, so no separately materialized
+// contiguous K/V copy is needed.
+inline std::string SdpaNode::getPagedKvOpsAsm() const {
+  if (!sdpaAttr.isPaged())
+    return "";
+
   std::string suffix = sdpaAttr.getName();
+  std::shared_ptr<TensorAttr> pageTableT = sdpaAttr.getPAGE_TABLE();
+  const std::vector<int64_t> &ptDim = pageTableT->getDim();
+  int64_t batch = ptDim[0], pagesPerSeq = ptDim[1];
+  int64_t blockSize = sdpaAttr.getBlockSize();
 
-  // Permute inputs.
-  std::string permuteQ = getLayoutConversionOpsAsm(sdpaAttr.getQ(), "permute_Q",
-                                                   suffix, /*isInput=*/true);
-  std::string permuteK = getLayoutConversionOpsAsm(sdpaAttr.getK(), "permute_K",
-                                                   suffix, /*isInput=*/true);
-  std::string permuteV = getLayoutConversionOpsAsm(sdpaAttr.getV(), "permute_V",
-                                                   suffix, /*isInput=*/true);
+  std::vector<int64_t> flatDim = {batch * pagesPerSeq};
+  std::string flatType = buildTensorTypeStr(flatDim, pageTableT->getDataType());
 
-  std::string mask;
-  if (sdpaAttr.getMASK())
-    mask = getLayoutConversionOpsAsm(sdpaAttr.getMASK(), "permute_mask", suffix,
-                                     /*isInput=*/true);
-  else
-    mask = torchNoneAsm("none_mask", suffix);
+  constexpr std::string_view tableSchema = R"(
+    {1}
+    {2}
+    %page_table_flat_{0} = torch.aten.view {3}_{0}_perm, %page_table_flat_shape_{0} : {4}, !torch.list<int> -> {5}
+    %page_dim_{0} = torch.constant.int 0
+    %page_transpose_dim0_{0} = torch.constant.int 1
+    %page_transpose_dim1_{0} = torch.constant.int 2
+)";
 
-  // Permute output.
-  std::string permuteO = getLayoutConversionOpsAsm(sdpaAttr.getO(), "permute_O",
-                                                   suffix, /*isInput=*/false);
+  std::string permutePageTable = getLayoutConversionOpsAsm(
+      pageTableT, "permute_PAGE_TABLE", suffix, /*isInput=*/true);
+  std::string pageTableType = pageTableT->getTensorTypeAsm(
+      /*isValueTensor=*/true, /*useLogicalDims=*/true);
+  std::string ops = std::format(
+      tableSchema,
+      suffix,                                                       // {0}
+      permutePageTable,                                             // {1}
+      getListOfIntOpsAsm(flatDim, "page_table_flat_shape", suffix), // {2}
+      pageTableT->getValueNameAsm(),                                // {3}
+      pageTableType,                                                // {4}
+      flatType                                                      // {5}
+  );
 
-  std::string operandNames = getOperandNamesAsm() + ", %dropout_" + suffix +
-                             ", %is_causal_" + suffix + ", %scale_" + suffix +
-                             ", %enable_gqa_" + suffix;
+  constexpr std::string_view gatherSchema = R"(
+    %paged_{1}_gather_{0} = torch.aten.index_select {2}_{0}_perm, %page_dim_{0}, %page_table_flat_{0} : {3}, !torch.int, {4} -> {5}
+    {6}
+    %paged_{1}_split_{0} = torch.aten.view %paged_{1}_gather_{0}, %paged_{1}_split_shape_{0} : {5}, !torch.list<int> -> {7}
+    %paged_{1}_transpose_{0} = torch.aten.transpose.int %paged_{1}_split_{0}, %page_transpose_dim0_{0}, %page_transpose_dim1_{0} : {7}, !torch.int, !torch.int -> {8}
+    {9}
+    %paged_{1}_{0} = torch.aten.reshape %paged_{1}_transpose_{0}, %paged_{1}_shape_{0} : {8}, !torch.list<int> -> {10}
+)";
 
-  // Scale type for the MLIR signature.
-  std::string scaleType =
-      sdpaAttr.getScale().has_value() ? "!torch.float" : "!torch.none";
+  auto gather = [&](const std::shared_ptr<TensorAttr> &poolT,
+                    const std::string &name) {
+    const std::vector<int64_t> &poolDim = poolT->getDim();
+    int64_t heads = poolDim[1], headDim = poolDim[3];
+    DataType dtype = poolT->getDataType();
+    std::vector<int64_t> pagesDim = {batch * pagesPerSeq, heads, blockSize,
+                                     headDim};
+    std::vector<int64_t> splitDim = {batch, pagesPerSeq, heads, blockSize,
+                                     headDim};
+    std::vector<int64_t> transposeDim = {batch, heads, pagesPerSeq, blockSize,
+                                         headDim};
+    std::vector<int64_t> gatheredDim = getGatheredKvDim(poolT);
+    std::string poolType = poolT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                   /*useLogicalDims=*/true);
+    std::string splitShape =
+        getListOfIntOpsAsm(splitDim, "paged_" + name + "_split_shape", suffix);
+    std::string gatheredShape =
+        getListOfIntOpsAsm(gatheredDim, "paged_" + name + "_shape", suffix);
+    return std::format(gatherSchema,
+                       suffix,                                  // {0}
+                       name,                                    // {1}
+                       poolT->getValueNameAsm(),                // {2}
+                       poolType,                                // {3}
+                       flatType,                                // {4}
+                       buildTensorTypeStr(pagesDim, dtype),     // {5}
+                       splitShape,                              // {6}
+                       buildTensorTypeStr(splitDim, dtype),     // {7}
+                       buildTensorTypeStr(transposeDim, dtype), // {8}
+                       gatheredShape,                           // {9}
+                       buildTensorTypeStr(gatheredDim, dtype)   // {10}
+    );
+  };
 
-  constexpr std::string_view schema = R"(
-    {0}
-    {1}
-    {2}
+  return ops + gather(sdpaAttr.getK(), "k") + gather(sdpaAttr.getV(), "v");
+}
+
+// Emits the varlen preamble. The packed Q, K and V are viewed as a single
+// attention batch, and each token's sequence index is recovered from the
+// cumulative sequence lengths as the number of sequence ends at or before
+// it. Tokens may only attend within their own sequence (and, when causal,
+// to earlier positions of it), which yields a block-diagonal boolean mask.
+inline std::string SdpaNode::getVarlenOpsAsm() const {
+  if (!sdpaAttr.isVarlen())
+    return "";
+
+  std::string suffix = sdpaAttr.getName();
+  std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
+  std::shared_ptr<TensorAttr> kT = sdpaAttr.getK();
+  bool isCausal = sdpaAttr.getIsCausal();
+
+  int64_t totalQ = getVarlenBatchedDim(qT)[2];
+  int64_t totalKV = getVarlenBatchedDim(kT)[2];
+  std::vector<int64_t> maskDim = {totalQ, totalKV};
+
+  constexpr std::string_view constantsSchema = R"(
+    %varlen_int0_{0} = torch.constant.int 0
+    %varlen_int1_{0} = torch.constant.int 1
+    %varlen_int2_{0} = torch.constant.int 2
+    %varlen_long_{0} = torch.constant.int {1}
+    %varlen_none_{0} = torch.constant.none
+    %varlen_false_{0} = torch.constant.bool false
+    %varlen_sum_dims_{0} = torch.prim.ListConstruct %varlen_int1_{0} : (!torch.int) -> !torch.list<int>
+)";
+  std::string ops =
+      std::format(constantsSchema, suffix,
+                  static_cast<int>(torch_upstream::ScalarType::Long));
+
+  // [total, heads, head_dim] -> [1, heads, total, head_dim]
+  constexpr std::string_view batchSchema = R"(
+    %varlen_{1}_unsqueeze_{0} = torch.aten.unsqueeze {2}_{0}_perm, %varlen_int0_{0} : {3}, !torch.int -> {4}
+    %varlen_{1}_{0} = torch.aten.transpose.int %varlen_{1}_unsqueeze_{0}, %varlen_int1_{0}, %varlen_int2_{0} : {4}, !torch.int, !torch.int -> {5}
+)";
+  auto batch = [&](const std::shared_ptr<TensorAttr> &packedT,
+                   const std::string &name) {
+    const std::vector<int64_t> &dim = packedT->getDim();
+    int64_t total = packedT->isDynamicDim(0) ? -1 : dim[0];
+    DataType dtype = packedT->getDataType();
+    return std::format(
+        batchSchema, suffix, name, packedT->getValueNameAsm(),
+        packedT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                  /*useLogicalDims=*/true),
+        buildTensorTypeStr({1, total, dim[1], dim[2]}, dtype),
+        buildTensorTypeStr(getVarlenBatchedDim(packedT), dtype));
+  };
+  ops += batch(qT, "q") + batch(kT, "k") + batch(sdpaAttr.getV(), "v");
+
+  // Sequence index (and, when causal, position within the sequence) of every
+  // packed token.
+  constexpr std::string_view segmentSchema = R"(
+    %varlen_{1}_len_{0} = torch.aten.size.int {2}_{0}_perm, %varlen_int0_{0} : {3}, !torch.int -> !torch.int
+    %varlen_{1}_pos_{0} = torch.aten.arange %varlen_{1}_len_{0}, %varlen_long_{0}, %varlen_none_{0}, %varlen_none_{0}, %varlen_none_{0} : !torch.int, !torch.int, !torch.none, !torch.none, !torch.none -> {4}
+    %varlen_{1}_ends_{0} = torch.aten.slice.Tensor {5}_{0}_perm, %varlen_int0_{0}, %varlen_int1_{0}, %varlen_none_{0}, %varlen_int1_{0} : {6}, !torch.int, !torch.int, !torch.none, !torch.int -> {7}
+    %varlen_{1}_pos_col_{0} = torch.aten.unsqueeze %varlen_{1}_pos_{0}, %varlen_int1_{0} : {4}, !torch.int -> {8}
+    %varlen_{1}_ended_{0} = torch.aten.ge.Tensor %varlen_{1}_pos_col_{0}, %varlen_{1}_ends_{0} : {8}, {7} -> {9}
+    %varlen_{1}_seg_{0} = torch.aten.sum.dim_IntList %varlen_{1}_ended_{0}, %varlen_sum_dims_{0}, %varlen_false_{0}, %varlen_long_{0} : {9}, !torch.list<int>, !torch.bool, !torch.int -> {4}
+)";
+  constexpr std::string_view localSchema = R"(
+    %varlen_{1}_start_{0} = torch.aten.index_select {2}_{0}_perm, %varlen_int0_{0}, %varlen_{1}_seg_{0} : {3}, !torch.int, {4} -> {5}
+    %varlen_{1}_local_{0} = torch.aten.sub.Tensor %varlen_{1}_pos_{0}, %varlen_{1}_start_{0}, %varlen_int1_{0} : {4}, {5}, !torch.int -> {4}
+)";
+  auto segment = [&](const std::shared_ptr<TensorAttr> &packedT,
+                     const std::shared_ptr<TensorAttr> &cuT, int64_t total,
+                     const std::string &name) {
+    int64_t batchSize = cuT->getDim()[0] - 1;
+    DataType cuType = cuT->getDataType();
+    std::string posType = buildTensorTypeStr({total}, DataType::Int64);
+    std::string cuTensorType =
+        cuT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+    std::string segOps = std::format(
+        segmentSchema, suffix, name, packedT->getValueNameAsm(),
+        packedT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                  /*useLogicalDims=*/true),
+        posType, cuT->getValueNameAsm(), cuTensorType,
+        buildTensorTypeStr({batchSize}, cuType),
+        buildTensorTypeStr({total, 1}, DataType::Int64),
+        buildTensorTypeStr({total, batchSize}, DataType::Boolean));
+    if (isCausal)
+      segOps += std::format(localSchema, suffix, name, cuT->getValueNameAsm(),
+                            cuTensorType, posType,
+                            buildTensorTypeStr({total}, cuType));
+    return segOps;
+  };
+  std::shared_ptr<TensorAttr> cuQT = sdpaAttr.getCU_SEQLENS_Q();
+  std::shared_ptr<TensorAttr> cuKVT = sdpaAttr.getCU_SEQLENS_KV();
+  // Self-attention commonly passes the same tensor for both sides.
+  constexpr std::string_view cuSchema = R"(
+    {0}
+    {1}
+)";
+  ops += std::format(
+      cuSchema,
+      getLayoutConversionOpsAsm(cuQT, "permute_CU_SEQLENS_Q", suffix,
+                                /*isInput=*/true),
+      cuKVT == cuQT ? ""
+                    : getLayoutConversionOpsAsm(cuKVT, "permute_CU_SEQLENS_KV",
+                                                suffix, /*isInput=*/true));
+  ops += segment(qT, cuQT, totalQ, "q") + segment(kT, cuKVT, totalKV, "kv");
+
+  // Block-diagonal [1, 1, total_q, total_kv] mask.
+  constexpr std::string_view maskSchema = R"(
+    %varlen_q_seg_col_{0} = torch.aten.unsqueeze %varlen_q_seg_{0}, %varlen_int1_{0} : {1}, !torch.int -> {2}
+    %varlen_same_seq_{0} = torch.aten.eq.Tensor %varlen_q_seg_col_{0}, %varlen_kv_seg_{0} : {2}, {3} -> {4}
+    {5}
+    %varlen_mask_3d_{0} = torch.aten.unsqueeze {6}, %varlen_int0_{0} : {4}, !torch.int -> {7}
+    %varlen_mask_{0} = torch.aten.unsqueeze %varlen_mask_3d_{0}, %varlen_int0_{0} : {7}, !torch.int -> {8}
+)";
+  constexpr std::string_view causalSchema = R"(
+    %varlen_q_local_col_{0} = torch.aten.unsqueeze %varlen_q_local_{0}, %varlen_int1_{0} : {1}, !torch.int -> {2}
+    %varlen_causal_{0} = torch.aten.ge.Tensor %varlen_q_local_col_{0}, %varlen_kv_local_{0} : {2}, {3} -> {4}
+    %varlen_block_{0} = torch.aten.logical_and %varlen_same_seq_{0}, %varlen_causal_{0} : {4}, {4} -> {4}
+)";
+  std::string qPosType = buildTensorTypeStr({totalQ}, DataType::Int64);
+  std::string qColType = buildTensorTypeStr({totalQ, 1}, DataType::Int64);
+  std::string kvPosType = buildTensorTypeStr({totalKV}, DataType::Int64);
+  std::string blockType = buildTensorTypeStr(maskDim, DataType::Boolean);
+  std::string causalOps =
+      isCausal ? std::format(causalSchema, suffix, qPosType, qColType,
+                             kvPosType, blockType)
+               : "";
+  std::string blockName =
+      isCausal ? "%varlen_block_" + suffix : "%varlen_same_seq_" + suffix;
+  ops += std::format(
+      maskSchema,
+      suffix,                                                        // {0}
+      qPosType,                                                      // {1}
+      qColType,                                                      // {2}
+      kvPosType,                                                     // {3}
+      blockType,                                                     // {4}
+      causalOps,                                                     // {5}
+      blockName,                                                     // {6}
+      buildTensorTypeStr({1, totalQ, totalKV}, DataType::Boolean),   // {7}
+      buildTensorTypeStr({1, 1, totalQ, totalKV}, DataType::Boolean) // {8}
+  );
+
+  return ops;
+}
+
+// Emits the unpacking of the varlen attention result
+// [1, heads_q, total_q, head_dim] back to [total_q, heads_q, head_dim].
+inline std::string SdpaNode::getVarlenOutputOpsAsm() const {
+  if (!sdpaAttr.isVarlen())
+    return "";
+
+  std::string suffix = sdpaAttr.getName();
+  std::shared_ptr<TensorAttr> oT = sdpaAttr.getO();
+  std::vector<int64_t> batchedDim = getVarlenBatchedDim(sdpaAttr.getQ());
+  batchedDim[3] = oT->getDim()[2];
+  std::vector<int64_t> transposedDim = {1, batchedDim[2], batchedDim[1],
+                                        batchedDim[3]};
+
+  constexpr std::string_view schema = R"(
+    %varlen_o_t_{0} = torch.aten.transpose.int %varlen_o_{0}, %varlen_int1_{0}, %varlen_int2_{0} : {1}, !torch.int, !torch.int -> {2}
+    {3} = torch.aten.squeeze.dim %varlen_o_t_{0}, %varlen_int0_{0} : {2}, !torch.int -> {4}
+)";
+
+  return std::format(
+      schema,
+      suffix,                                               // {0}
+      buildTensorTypeStr(batchedDim, oT->getDataType()),    // {1}
+      buildTensorTypeStr(transposedDim, oT->getDataType()), // {2}
+      getResultNamesAsm(),                                  // {3}
+      getResultTypesAsm()                                   // {4}
+  );
+}
+
+// Emits the logsumexp of the scaled scores over the KV sequence as the
+// STATS output, for the backward pass to recompute the attention
+// probabilities from.
+inline std::string SdpaNode::getStatsOpsAsm() const {
+  if (!sdpaAttr.hasStats())
+    return "";
+
+  std::string suffix = sdpaAttr.getName();
+  std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
+  std::shared_ptr<TensorAttr> statsT = sdpaAttr.getSTATS();
+  const std::vector<int64_t> &qDim = qT->getDim();
+  std::vector<int64_t> scoresDim = {qDim[0], qDim[1], qDim[2], getSeqKV()};
+
+  constexpr std::string_view schema = R"(
+    {1}
+    %stats_dims_{0} = torch.prim.ListConstruct %scores_int3_{0} : (!torch.int) -> !torch.list<int>
+    %stats_keepdim_{0} = torch.constant.bool true
+    {2}_{0}_perm = torch.aten.logsumexp %scores_{0}, %stats_dims_{0}, %stats_keepdim_{0} : {3}, !torch.list<int>, !torch.bool -> {4}
+    {5}
+)";
+
+  std::string scoresOps = getSdpaScoresOpsAsm(
+      qT, sdpaAttr.getK(), getSdpaScale(sdpaAttr.getScale(), qDim[3]),
+      sdpaAttr.getIsCausal(), suffix);
+  std::string permuteStats = getLayoutConversionOpsAsm(
+      statsT, "permute_STATS", suffix, /*isInput=*/false);
+  std::string statsType =
+      statsT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+
+  return std::format(schema,
+                     suffix,                                         // {0}
+                     scoresOps,                                      // {1}
+                     statsT->getValueNameAsm(),                      // {2}
+                     buildTensorTypeStr(scoresDim, DataType::Float), // {3}
+                     statsType,                                      // {4}
+                     permuteStats                                    // {5}
+  );
+}
+
+// Emits the rotary embedding of Q and K. Their permutes are emitted under
+// the `{suffix}_unrotated` suffix, and the rotated values take the names
+// the attention (and the decompositions around it) consume, so the rotation
+// is a producer fused into the attention rather than a separate pass over Q
+// and K.
+inline std::string SdpaNode::getRopeOpsAsm() const {
+  if (!sdpaAttr.hasRope())
+    return "";
+
+  std::string suffix = sdpaAttr.getName();
+  std::shared_ptr<TensorAttr> cosT = sdpaAttr.getROPE_COS();
+  std::shared_ptr<TensorAttr> sinT = sdpaAttr.getROPE_SIN();
+  int64_t headDim = sdpaAttr.getQ()->getDim()[3];
+
+  constexpr std::string_view tableSchema = R"(
+    {1}
+    {2}
+    %rope_dim_{0} = torch.constant.int 3
+    %rope_start_{0} = torch.constant.int 0
+    %rope_half_{0} = torch.constant.int {3}
+    %rope_end_{0} = torch.constant.int {4}
+    %rope_step_{0} = torch.constant.int 1
+    %rope_alpha_{0} = torch.constant.int 1
+)";
+  std::string permuteCos = getLayoutConversionOpsAsm(
+      cosT, "permute_ROPE_COS", suffix, /*isInput=*/true);
+  std::string permuteSin = getLayoutConversionOpsAsm(
+      sinT, "permute_ROPE_SIN", suffix, /*isInput=*/true);
+  std::string ops = std::format(tableSchema,
+                                suffix,      // {0}
+                                permuteCos,  // {1}
+                                permuteSin,  // {2}
+                                headDim / 2, // {3}
+                                headDim      // {4}
+  );
+
+  constexpr std::string_view rotateSchema = R"(
+    %rope_{1}_lo_{0} = torch.aten.slice.Tensor {2}_{0}_unrotated_perm, %rope_dim_{0}, %rope_start_{0}, %rope_half_{0}, %rope_step_{0} : {3}, !torch.int, !torch.int, !torch.int, !torch.int -> {4}
+    %rope_{1}_hi_{0} = torch.aten.slice.Tensor {2}_{0}_unrotated_perm, %rope_dim_{0}, %rope_half_{0}, %rope_end_{0}, %rope_step_{0} : {3}, !torch.int, !torch.int, !torch.int, !torch.int -> {4}
+    %rope_{1}_hi_neg_{0} = torch.aten.neg %rope_{1}_hi_{0} : {4} -> {4}
+    %rope_{1}_halves_{0} = torch.prim.ListConstruct %rope_{1}_hi_neg_{0}, %rope_{1}_lo_{0} : ({4}, {4}) -> !torch.list<vtensor>
+    %rope_{1}_rotated_{0} = torch.aten.cat %rope_{1}_halves_{0}, %rope_dim_{0} : !torch.list<vtensor>, !torch.int -> {3}
+    %rope_{1}_cos_{0} = torch.aten.mul.Tensor {2}_{0}_unrotated_perm, {5}_{0}_perm : {3}, {6} -> {3}
+    %rope_{1}_sin_{0} = torch.aten.mul.Tensor %rope_{1}_rotated_{0}, {7}_{0}_perm : {3}, {8} -> {3}
+    {2}_{0}_perm = torch.aten.add.Tensor %rope_{1}_cos_{0}, %rope_{1}_sin_{0}, %rope_alpha_{0} : {3}, {3}, !torch.int -> {3}
+)";
+  std::string cosType =
+      cosT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  std::string sinType =
+      sinT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+
+  auto rotate = [&](const std::shared_ptr<TensorAttr> &t,
+                    const std::string &name) {
+    std::vector<int64_t> halfDim = t->getDim();
+    halfDim[3] /= 2;
+    std::string type =
+        t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+    return std::format(rotateSchema,
+                       suffix,                                        // {0}
+                       name,                                          // {1}
+                       t->getValueNameAsm(),                          // {2}
+                       type,                                          // {3}
+                       buildTensorTypeStr(halfDim, t->getDataType()), // {4}
+                       cosT->getValueNameAsm(),                       // {5}
+                       cosType,                                       // {6}
+                       sinT->getValueNameAsm(),                       // {7}
+                       sinType                                        // {8}
+    );
+  };
+
+  return ops + rotate(sdpaAttr.getQ(), "q") + rotate(sdpaAttr.getK(), "k");
+}
+
+inline std::string SdpaNode::emitNodePreAsm() const {
+  std::string suffix = sdpaAttr.getName();
+
+  // Permute inputs. With a rotary embedding, Q and K are rotated into the
+  // permuted names (see `getRopeOpsAsm()`).
+  std::string qkSuffix = sdpaAttr.hasRope() ? suffix + "_unrotated" : suffix;
+  std::string permuteQ = getLayoutConversionOpsAsm(
+      sdpaAttr.getQ(), "permute_Q", qkSuffix, /*isInput=*/true);
+  std::string permuteK = getLayoutConversionOpsAsm(
+      sdpaAttr.getK(), "permute_K", qkSuffix, /*isInput=*/true);
+  std::string permuteV = getLayoutConversionOpsAsm(sdpaAttr.getV(), "permute_V",
+                                                   suffix, /*isInput=*/true);
+
+  // In varlen mode the mask is built from the cumulative sequence lengths.
+  std::string mask;
+  if (sdpaAttr.getMASK())
+    mask = getLayoutConversionOpsAsm(sdpaAttr.getMASK(), "permute_mask", suffix,
+                                     /*isInput=*/true);
+  else if (!sdpaAttr.isVarlen())
+    mask = torchNoneAsm("none_mask", suffix);
+
+  // The attention op works on the packed varlen tensors viewed as a single
+  // batch; its result is unpacked again before the output permute.
+  std::string resultName = getResultNamesAsm();
+  std::string resultType = getResultTypesAsm();
+  if (sdpaAttr.isVarlen()) {
+    std::shared_ptr<TensorAttr> qT = sdpaAttr.getQ();
+    std::shared_ptr<TensorAttr> oT = sdpaAttr.getO();
+    std::vector<int64_t> oDim = getVarlenBatchedDim(qT);
+    oDim[3] = oT->getDim()[2];
+    resultName = "%varlen_o_" + suffix;
+    resultType = buildTensorTypeStr(oDim, oT->getDataType());
+  }
+
+  // Permute output.
+  std::string permuteO = getLayoutConversionOpsAsm(sdpaAttr.getO(), "permute_O",
+                                                   suffix, /*isInput=*/false);
+
+  std::string operandNames = getOperandNamesAsm() + ", %dropout_" + suffix +
+                             ", %is_causal_" + suffix + ", %scale_" + suffix +
+                             ", %enable_gqa_" + suffix;
+
+  // Scale type for the MLIR signature.
+  std::string scaleType =
+      sdpaAttr.getScale().has_value() ? "!torch.float" : "!torch.none";
+
+  // Dropout with a runtime seed is decomposed around the generated mask.
+  constexpr std::string_view attentionSchema = R"(
+    {0} = torch.aten.scaled_dot_product_attention {1} : {2}, !torch.float, !torch.bool, {3}, !torch.bool -> {4}
+)";
+  std::string attention =
+      sdpaAttr.hasDropoutRng()
+          ? getDropoutRngOpsAsm()
+          : std::format(attentionSchema, resultName, operandNames,
+                        getOperandTypesAsm(), scaleType, resultType);
+
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
     {3}
     {4}
     {5}
     {6}
     {7}
-    {8} = torch.aten.scaled_dot_product_attention {9} : {10}, !torch.float, !torch.bool, {11}, !torch.bool -> {12}
-    {13}
+    {9}
+    {8}
+    {10}
+    {11}
+    {12}
   )";
 
   return std::format(schema,
-                     permuteQ,             // {0}
-                     permuteK,             // {1}
-                     permuteV,             // {2}
-                     mask,                 // {3}
-                     getDropoutOpsAsm(),   // {4}
-                     getIsCausalOpsAsm(),  // {5}
-                     getScaleOpsAsm(),     // {6}
-                     getEnableGqaOpsAsm(), // {7}
-                     getResultNamesAsm(),  // {8}
-                     operandNames,         // {9}
-                     getOperandTypesAsm(), // {10}
-                     scaleType,            // {11}
-                     getResultTypesAsm(),  // {12}
-                     permuteO              // {13}
+                     permuteQ,                               // {0}
+                     permuteK + getRopeOpsAsm(),             // {1}
+                     permuteV,                               // {2}
+                     mask,                                   // {3}
+                     getDropoutOpsAsm(),                     // {4}
+                     getIsCausalOpsAsm(),                    // {5}
+                     getScaleOpsAsm(),                       // {6}
+                     getEnableGqaOpsAsm(),                   // {7}
+                     attention,                              // {8}
+                     getPagedKvOpsAsm() + getVarlenOpsAsm(), // {9}
+                     getVarlenOutputOpsAsm(),                // {10}
+                     permuteO,                               // {11}
+                     getStatsOpsAsm()                        // {12}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// SdpaBwdNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// The attention probabilities are recomputed from the scores and the saved
+// logsumexp as P = exp(S - STATS), so no [seq_q, seq_kv] tensor has to be
+// kept from the forward pass. With D = rowsum(DO * O), the gradients are
+//   DV = P^T @ DO,  DS = scale * P * (DO @ V^T - D),
+//   DQ = DS @ K,    DK = DS^T @ Q.
+// Softmax-related math is done in f32; the matmuls run in the element type
+// of Q.
+inline std::string SdpaBwdNode::emitNodePreAsm() const {
+  std::string suffix = sdpaBwdAttr.getName();
+  std::shared_ptr<TensorAttr> qT = sdpaBwdAttr.getQ();
+  std::shared_ptr<TensorAttr> kT = sdpaBwdAttr.getK();
+  std::shared_ptr<TensorAttr> vT = sdpaBwdAttr.getV();
+  std::shared_ptr<TensorAttr> oT = sdpaBwdAttr.getO();
+  std::shared_ptr<TensorAttr> doT = sdpaBwdAttr.getDO();
+  std::shared_ptr<TensorAttr> statsT = sdpaBwdAttr.getSTATS();
+  std::shared_ptr<TensorAttr> dqT = sdpaBwdAttr.getDQ();
+  std::shared_ptr<TensorAttr> dkT = sdpaBwdAttr.getDK();
+  std::shared_ptr<TensorAttr> dvT = sdpaBwdAttr.getDV();
+
+  // Permute inputs and outputs. Each group of layout conversion ops is
+  // followed by a line break so that the next one starts at op indentation.
+  auto permute = [&](const std::shared_ptr<TensorAttr> &t,
+                     const std::string &prefix, bool isInput) {
+    return getLayoutConversionOpsAsm(t, prefix, suffix, isInput) + "\n    ";
+  };
+  std::string permuteInputs =
+      permute(qT, "permute_Q", /*isInput=*/true) +
+      permute(kT, "permute_K", /*isInput=*/true) +
+      permute(vT, "permute_V", /*isInput=*/true) +
+      permute(oT, "permute_O", /*isInput=*/true) +
+      permute(doT, "permute_DO", /*isInput=*/true) +
+      permute(statsT, "permute_STATS", /*isInput=*/true);
+  std::string permuteOutputs = permute(dqT, "permute_DQ", /*isInput=*/false) +
+                               permute(dkT, "permute_DK", /*isInput=*/false) +
+                               permute(dvT, "permute_DV", /*isInput=*/false);
+
+  const std::vector<int64_t> &qDim = qT->getDim();
+  const std::vector<int64_t> &vDim = vT->getDim();
+  int64_t seqKV = kT->getDim()[2];
+  DataType dtype = qT->getDataType();
+  auto typeOf = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  };
+
+  std::string scoresOps = getSdpaScoresOpsAsm(
+      qT, kT, getSdpaScale(sdpaBwdAttr.getScale(), qDim[3]),
+      sdpaBwdAttr.getIsCausal(), suffix);
+
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    %bwd_shifted_{2} = torch.aten.sub.Tensor %scores_{2}, {3}_{2}_perm, %scores_int1_{2} : {4}, {5}, !torch.int -> {4}
+    %bwd_p_f32_{2} = torch.aten.exp %bwd_shifted_{2} : {4} -> {4}
+    %bwd_dtype_{2} = torch.constant.int {6}
+    %bwd_p_{2} = torch.aten.to.dtype %bwd_p_f32_{2}, %bwd_dtype_{2}, %scores_false_{2}, %scores_false_{2}, %scores_none_{2} : {4}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {7}
+    %bwd_pt_{2} = torch.aten.transpose.int %bwd_p_{2}, %scores_int2_{2}, %scores_int3_{2} : {7}, !torch.int, !torch.int -> {8}
+    {9}_{2}_perm = torch.aten.matmul %bwd_pt_{2}, {10}_{2}_perm : {8}, {11} -> {12}
+    %bwd_vt_{2} = torch.aten.transpose.int {13}_{2}_perm, %scores_int2_{2}, %scores_int3_{2} : {14}, !torch.int, !torch.int -> {15}
+    %bwd_dp_{2} = torch.aten.matmul {10}_{2}_perm, %bwd_vt_{2} : {11}, {15} -> {7}
+    %bwd_dp_f32_{2} = torch.aten.to.dtype %bwd_dp_{2}, %scores_f32_{2}, %scores_false_{2}, %scores_false_{2}, %scores_none_{2} : {7}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {4}
+    %bwd_do_o_{2} = torch.aten.mul.Tensor {10}_{2}_perm, {16}_{2}_perm : {11}, {17} -> {11}
+    %bwd_do_o_f32_{2} = torch.aten.to.dtype %bwd_do_o_{2}, %scores_f32_{2}, %scores_false_{2}, %scores_false_{2}, %scores_none_{2} : {11}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {18}
+    %bwd_dims_{2} = torch.prim.ListConstruct %scores_int3_{2} : (!torch.int) -> !torch.list<int>
+    %bwd_keepdim_{2} = torch.constant.bool true
+    %bwd_delta_{2} = torch.aten.sum.dim_IntList %bwd_do_o_f32_{2}, %bwd_dims_{2}, %bwd_keepdim_{2}, %scores_none_{2} : {18}, !torch.list<int>, !torch.bool, !torch.none -> {5}
+    %bwd_dp_centered_{2} = torch.aten.sub.Tensor %bwd_dp_f32_{2}, %bwd_delta_{2}, %scores_int1_{2} : {4}, {5}, !torch.int -> {4}
+    %bwd_ds_unscaled_{2} = torch.aten.mul.Tensor %bwd_p_f32_{2}, %bwd_dp_centered_{2} : {4}, {4} -> {4}
+    %bwd_ds_f32_{2} = torch.aten.mul.Scalar %bwd_ds_unscaled_{2}, %scores_scale_{2} : {4}, !torch.float -> {4}
+    %bwd_ds_{2} = torch.aten.to.dtype %bwd_ds_f32_{2}, %bwd_dtype_{2}, %scores_false_{2}, %scores_false_{2}, %scores_none_{2} : {4}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {7}
+    {19}_{2}_perm = torch.aten.matmul %bwd_ds_{2}, {20}_{2}_perm : {7}, {21} -> {22}
+    %bwd_dst_{2} = torch.aten.transpose.int %bwd_ds_{2}, %scores_int2_{2}, %scores_int3_{2} : {7}, !torch.int, !torch.int -> {8}
+    {23}_{2}_perm = torch.aten.matmul %bwd_dst_{2}, {24}_{2}_perm : {8}, {25} -> {26}
+    {27}
+  )";
+
+  std::vector<int64_t> scoresDim = {qDim[0], qDim[1], qDim[2], seqKV};
+  std::vector<int64_t> transposedDim = {qDim[0], qDim[1], seqKV, qDim[2]};
+  std::vector<int64_t> vTransposedDim = {vDim[0], vDim[1], vDim[3], vDim[2]};
+
+  return std::format(
+      schema,
+      permuteInputs,                                         // {0}
+      scoresOps,                                             // {1}
+      suffix,                                                // {2}
+      statsT->getValueNameAsm(),                             // {3}
+      buildTensorTypeStr(scoresDim, DataType::Float),        // {4}
+      typeOf(statsT),                                        // {5}
+      static_cast<int>(kDataTypeToTorchType.at(dtype)),      // {6}
+      buildTensorTypeStr(scoresDim, dtype),                  // {7}
+      buildTensorTypeStr(transposedDim, dtype),              // {8}
+      dvT->getValueNameAsm(),                                // {9}
+      doT->getValueNameAsm(),                                // {10}
+      typeOf(doT),                                           // {11}
+      typeOf(dvT),                                           // {12}
+      vT->getValueNameAsm(),                                 // {13}
+      typeOf(vT),                                            // {14}
+      buildTensorTypeStr(vTransposedDim, vT->getDataType()), // {15}
+      oT->getValueNameAsm(),                                 // {16}
+      typeOf(oT),                                            // {17}
+      buildTensorTypeStr(doT->getDim(), DataType::Float),    // {18}
+      dqT->getValueNameAsm(),                                // {19}
+      kT->getValueNameAsm(),                                 // {20}
+      typeOf(kT),                                            // {21}
+      typeOf(dqT),                                           // {22}
+      dkT->getValueNameAsm(),                                // {23}
+      qT->getValueNameAsm(),                                 // {24}
+      typeOf(qT),                                            // {25}
+      typeOf(dkT),                                           // {26}
+      permuteOutputs                                         // {27}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// SoftmaxNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits SoftmaxNode's operand names in MLIR assembly format.
+//
+// The operand of the softmax op is the logical X, or the scaled and / or
+// masked value computed from it by the node.
+inline std::string SoftmaxNode::getOperandNamesAsm() const {
+  std::string suffix = softmaxAttr.getName();
+  if (softmaxAttr.getMASK())
+    return "%softmax_masked_" + suffix;
+  if (softmaxAttr.getScale().has_value())
+    return "%softmax_scaled_" + suffix;
+  return softmaxAttr.getX()->getValueNameAsm() + "_" + suffix + "_perm";
+}
+
+// Emits SoftmaxNode's operand types in MLIR assembly format.
+inline std::string SoftmaxNode::getOperandTypesAsm() const {
+  return softmaxAttr.getX()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                              /*useLogicalDims=*/true);
+}
+
+// Emits SoftmaxNode's result names in MLIR assembly format.
+inline std::string SoftmaxNode::getResultNamesAsm() const {
+  return softmaxAttr.getY()->getValueNameAsm() + "_" + softmaxAttr.getName() +
+         "_perm";
+}
+
+// Emits SoftmaxNode's result types in MLIR assembly format.
+inline std::string SoftmaxNode::getResultTypesAsm() const {
+  return softmaxAttr.getY()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                              /*useLogicalDims=*/true);
+}
+
+// The optional scale and mask are emitted as elementwise producers of a
+// single `torch.aten.softmax.int` (or `torch.aten.log_softmax.int`), which
+// the compiler lowers to one fused online-softmax dispatch. The dtype
+// operand computes the softmax in the element type of Y.
+inline std::string SoftmaxNode::emitNodePreAsm() const {
+  std::string suffix = softmaxAttr.getName();
+  std::shared_ptr<TensorAttr> xT = softmaxAttr.getX();
+  std::shared_ptr<TensorAttr> maskT = softmaxAttr.getMASK();
+  std::string xType = getOperandTypesAsm();
+
+  std::string permuteX = getLayoutConversionOpsAsm(xT, "permute_X", suffix,
+                                                   /*isInput=*/true);
+  std::string permuteY = getLayoutConversionOpsAsm(
+      softmaxAttr.getY(), "permute_Y", suffix, /*isInput=*/false);
+
+  std::string current = xT->getValueNameAsm() + "_" + suffix + "_perm";
+
+  std::string scaleOps;
+  if (softmaxAttr.getScale().has_value()) {
+    constexpr std::string_view scaleSchema = R"(
+    {0}
+    %softmax_scaled_{1} = torch.aten.mul.Scalar {2}, %softmax_scale_{1} : {3}, !torch.float -> {3}
+)";
+    std::string scale =
+        torchFloatAsm("softmax_scale", suffix, *softmaxAttr.getScale());
+    scaleOps = std::format(scaleSchema,
+                           scale,   // {0}
+                           suffix,  // {1}
+                           current, // {2}
+                           xType    // {3}
+    );
+    current = "%softmax_scaled_" + suffix;
+  }
+
+  std::string maskOps;
+  if (maskT) {
+    constexpr std::string_view maskSchema = R"(
+    {0}
+    %softmax_mask_alpha_{1} = torch.constant.int 1
+    %softmax_masked_{1} = torch.aten.add.Tensor {2}, {3}_{1}_perm, %softmax_mask_alpha_{1} : {4}, {5}, !torch.int -> {4}
+)";
+    std::string permuteMask = getLayoutConversionOpsAsm(
+        maskT, "permute_MASK", suffix, /*isInput=*/true);
+    std::string maskType = maskT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                   /*useLogicalDims=*/true);
+    maskOps = std::format(maskSchema,
+                          permuteMask,              // {0}
+                          suffix,                   // {1}
+                          current,                  // {2}
+                          maskT->getValueNameAsm(), // {3}
+                          xType,                    // {4}
+                          maskType                  // {5}
+    );
+  }
+
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+    %dim_{3} = torch.constant.int {4}
+    %dtype_{3} = torch.constant.int {5}
+    {6} = {7} {8}, %dim_{3}, %dtype_{3} : {9}, !torch.int, !torch.int -> {10}
+    {11}
+  )";
+
+  std::string_view op = softmaxAttr.getLogSoftmax()
+                            ? "torch.aten.log_softmax.int"
+                            : "torch.aten.softmax.int";
+  torch_upstream::ScalarType dataType =
+      kDataTypeToTorchType.at(softmaxAttr.getY()->getDataType());
+
+  return std::format(schema,
+                     permuteX,                   // {0}
+                     scaleOps,                   // {1}
+                     maskOps,                    // {2}
+                     suffix,                     // {3}
+                     getNormalizedAxis(),        // {4}
+                     static_cast<int>(dataType), // {5}
+                     getResultNamesAsm(),        // {6}
+                     op,                         // {7}
+                     getOperandNamesAsm(),       // {8}
+                     xType,                      // {9}
+                     getResultTypesAsm(),        // {10}
+                     permuteY                    // {11}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// PoolingNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits PoolingNode's operand names in MLIR assembly format.
+inline std::string PoolingNode::getOperandNamesAsm() const {
+  return poolingAttr.getX()->getValueNameAsm() + "_" + poolingAttr.getName() +
+         "_perm";
+}
+
+// Emits PoolingNode's operand types in MLIR assembly format.
+inline std::string PoolingNode::getOperandTypesAsm() const {
+  return poolingAttr.getX()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                              /*useLogicalDims=*/true);
+}
+
+// Emits PoolingNode's result names in MLIR assembly format.
+inline std::string PoolingNode::getResultNamesAsm() const {
+  return poolingAttr.getY()->getValueNameAsm() + "_" + poolingAttr.getName() +
+         "_perm";
+}
+
+// Emits PoolingNode's result types in MLIR assembly format.
+inline std::string PoolingNode::getResultTypesAsm() const {
+  return poolingAttr.getY()->getTensorTypeAsm(/*isValueTensor=*/true,
+                                              /*useLogicalDims=*/true);
+}
+
+// Emits `torch.aten.max_pool{1,2,3}d` or `torch.aten.avg_pool{1,2,3}d` on the
+// logical (channels-first) X, picked by the number of spatial dims:
+//
+//   max_poolNd(x, kernel_size, stride, padding, dilation, ceil_mode)
+//   avg_pool1d(x, kernel_size, stride, padding, ceil_mode, count_include_pad)
+//   avg_pool{2,3}d(x, kernel_size, stride, padding, ceil_mode,
+//                  count_include_pad, divisor_override)
+//
+// The output shape is always rounded down (ceil_mode = false).
+inline std::string PoolingNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+    {3}
+    {4}
+    %ceil_mode_{5} = torch.constant.bool false
+    {6} = torch.aten.{7}_pool{8}d {9}, %kernel_{5}, %stride_{5}, %padding_{5}, {10} : {11}, !torch.list<int>, !torch.list<int>, !torch.list<int>, {12} -> {13}
+    {14}
+  )";
+
+  std::string suffix = poolingAttr.getName();
+  size_t numSpatialDims = poolingAttr.getWindow().size();
+  std::string permuteX = getLayoutConversionOpsAsm(
+      poolingAttr.getX(), "permute_X", suffix, /*isInput=*/true);
+  std::string permuteY = getLayoutConversionOpsAsm(
+      poolingAttr.getY(), "permute_Y", suffix, /*isInput=*/false);
+
+  // Mode specific constants and trailing operands.
+  std::string modeOps, operands, operandTypes;
+  if (poolingAttr.getMode() == PoolingAttr::Mode::MAX) {
+    modeOps = getListOfIntOpsAsm(getDilation(), /*prefix=*/"dilation", suffix);
+    operands = std::format("%dilation_{0}, %ceil_mode_{0}", suffix);
+    operandTypes = "!torch.list<int>, !torch.bool";
+  } else {
+    modeOps = torchBoolAsm("count_include_pad", suffix,
+                           poolingAttr.getCountIncludePad());
+    operands = std::format("%ceil_mode_{0}, %count_include_pad_{0}", suffix);
+    operandTypes = "!torch.bool, !torch.bool";
+    // Only avg_pool2d and avg_pool3d take a divisor override.
+    if (numSpatialDims > 1) {
+      modeOps += "\n    " + torchNoneAsm("divisor_override", suffix);
+      operands += ", %divisor_override_" + suffix;
+      operandTypes += ", !torch.none";
+    }
+  }
+
+  std::string_view op =
+      poolingAttr.getMode() == PoolingAttr::Mode::MAX ? "max" : "avg";
+
+  std::string kernel =
+      getListOfIntOpsAsm(poolingAttr.getWindow(), /*prefix=*/"kernel", suffix);
+  std::string stride =
+      getListOfIntOpsAsm(poolingAttr.getStride(), /*prefix=*/"stride", suffix);
+  std::string padding = getListOfIntOpsAsm(poolingAttr.getPadding(),
+                                           /*prefix=*/"padding", suffix);
+
+  return std::format(schema,
+                     permuteX,             // {0}
+                     kernel,               // {1}
+                     stride,               // {2}
+                     padding,              // {3}
+                     modeOps,              // {4}
+                     suffix,               // {5}
+                     getResultNamesAsm(),  // {6}
+                     op,                   // {7}
+                     numSpatialDims,       // {8}
+                     getOperandNamesAsm(), // {9}
+                     operands,             // {10}
+                     getOperandTypesAsm(), // {11}
+                     operandTypes,         // {12}
+                     getResultTypesAsm(),  // {13}
+                     permuteY              // {14}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// ReshapeNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits `torch.aten.view` from the logical X to the logical dims of Y.
+// Logical tensors are contiguous, so the view never needs a copy.
+inline std::string ReshapeNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}_{3}_perm = torch.aten.view {4}_{3}_perm, %shape_{3} : {5}, !torch.list<int> -> {6}
+    {7}
+  )";
+
+  std::string suffix = reshapeAttr.getName();
+  std::shared_ptr<TensorAttr> xT = reshapeAttr.getX();
+  std::shared_ptr<TensorAttr> yT = reshapeAttr.getY();
+  std::string permuteX =
+      getLayoutConversionOpsAsm(xT, "permute_X", suffix, /*isInput=*/true);
+  std::string permuteY =
+      getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false);
+  std::string shape =
+      getListOfIntOpsAsm(yT->getDim(), /*prefix=*/"shape", suffix);
+
+  return std::format(schema,
+                     permuteX,              // {0}
+                     shape,                 // {1}
+                     yT->getValueNameAsm(), // {2}
+                     suffix,                // {3}
+                     xT->getValueNameAsm(), // {4}
+                     xT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {5}
+                     yT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {6}
+                     permuteY                                       // {7}
   );
 }
 
+//===----------------------------------------------------------------------===//
+//
+// PermuteNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits `torch.aten.permute` of the logical X by the permute order.
+inline std::string PermuteNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}_{3}_perm = torch.aten.permute {4}_{3}_perm, %order_{3} : {5}, !torch.list<int> -> {6}
+    {7}
+  )";
+
+  std::string suffix = permuteAttr.getName();
+  std::shared_ptr<TensorAttr> xT = permuteAttr.getX();
+  std::shared_ptr<TensorAttr> yT = permuteAttr.getY();
+  std::string permuteX =
+      getLayoutConversionOpsAsm(xT, "permute_X", suffix, /*isInput=*/true);
+  std::string permuteY =
+      getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false);
+  std::string order =
+      getListOfIntOpsAsm(permuteAttr.getOrder(), /*prefix=*/"order", suffix);
+
+  return std::format(schema,
+                     permuteX,              // {0}
+                     order,                 // {1}
+                     yT->getValueNameAsm(), // {2}
+                     suffix,                // {3}
+                     xT->getValueNameAsm(), // {4}
+                     xT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {5}
+                     yT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {6}
+                     permuteY                                       // {7}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// SliceNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits a chain of `torch.aten.slice.Tensor`, one per sliced logical dim of
+// X. A slice that keeps all of X still slices dim 0, so the chain is never
+// empty.
+inline std::string SliceNode::emitNodePreAsm() const {
+  constexpr std::string_view sliceSchema = R"(
+    %slice_dim_{0}_{1} = torch.constant.int {0}
+    %slice_start_{0}_{1} = torch.constant.int {2}
+    %slice_end_{0}_{1} = torch.constant.int {3}
+    %slice_step_{0}_{1} = torch.constant.int {4}
+    {5} = torch.aten.slice.Tensor {6}, %slice_dim_{0}_{1}, %slice_start_{0}_{1}, %slice_end_{0}_{1}, %slice_step_{0}_{1} : {7}, !torch.int, !torch.int, !torch.int, !torch.int -> {8})";
+
+  std::string suffix = sliceAttr.getName();
+  std::shared_ptr<TensorAttr> xT = sliceAttr.getX();
+  std::shared_ptr<TensorAttr> yT = sliceAttr.getY();
+  const std::vector<int64_t> &xDim = xT->getDim();
+  const std::vector<int64_t> &start = sliceAttr.getStart();
+  const std::vector<int64_t> &end = sliceAttr.getEnd();
+  std::vector<int64_t> step = getStep();
+  std::string result = yT->getValueNameAsm() + "_" + suffix + "_perm";
+
+  // Dims of the intermediate results, dynamic dims (never sliced) as -1.
+  std::vector<int64_t> dims = xDim;
+  for (size_t d = 0; d < dims.size(); ++d)
+    if (xT->isDynamicDim(d))
+      dims[d] = -1;
+
+  std::vector<size_t> slicedDims;
+  for (size_t d = 0; d < xDim.size(); ++d)
+    if (start[d] != 0 || end[d] != xDim[d] || step[d] != 1)
+      slicedDims.push_back(d);
+  if (slicedDims.empty())
+    slicedDims.push_back(0);
+
+  std::ostringstream oss;
+  oss << "\n    "
+      << getLayoutConversionOpsAsm(xT, "permute_X", suffix, /*isInput=*/true);
+  std::string current = xT->getValueNameAsm() + "_" + suffix + "_perm";
+  for (size_t d : slicedDims) {
+    std::string operandType = buildTensorTypeStr(dims, xT->getDataType());
+    if (!xT->isDynamicDim(d))
+      dims[d] = (end[d] - start[d] + step[d] - 1) / step[d];
+    std::string name = d == slicedDims.back()
+                           ? result
+                           : std::format("%slice_{}_{}", d, suffix);
+    oss << std::format(sliceSchema,
+                       d,                                          // {0}
+                       suffix,                                     // {1}
+                       start[d],                                   // {2}
+                       end[d],                                     // {3}
+                       step[d],                                    // {4}
+                       name,                                       // {5}
+                       current,                                    // {6}
+                       operandType,                                // {7}
+                       buildTensorTypeStr(dims, xT->getDataType()) // {8}
+    );
+    current = name;
+  }
+  oss << "\n    "
+      << getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false)
+      << "\n  ";
+  return oss.str();
+}
+
+//===----------------------------------------------------------------------===//
+//
+// ConcatNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits `torch.aten.cat` of the logical inputs along the concat axis. Like
+// CustomOpNode, the layout conversion of each input uses an indexed suffix
+// so the same tensor can be concatenated more than once.
+inline std::string ConcatNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {0}
+    %concat_list_{1} = torch.prim.ListConstruct {2} : ({3}) -> !torch.list<vtensor>
+    %dim_{1} = torch.constant.int {4}
+    {5}_{1}_perm = torch.aten.cat %concat_list_{1}, %dim_{1} : !torch.list<vtensor>, !torch.int -> {6}
+    {7}
+  )";
+
+  std::string suffix = concatAttr.getName();
+  std::shared_ptr<TensorAttr> yT = concatAttr.getY();
+  std::vector<std::shared_ptr<TensorAttr>> xs = concatAttr.getX();
+
+  std::ostringstream permuteXs, names, types;
+  for (size_t i = 0; i < xs.size(); ++i) {
+    std::string inputSuffix = suffix + "_i" + std::to_string(i);
+    if (i > 0) {
+      permuteXs << "\n    ";
+      names << ", ";
+      types << ", ";
+    }
+    permuteXs << getLayoutConversionOpsAsm(xs[i],
+                                           "permute_X_" + std::to_string(i),
+                                           inputSuffix, /*isInput=*/true);
+    names << xs[i]->getValueNameAsm() << "_" << inputSuffix << "_perm";
+    types << xs[i]->getTensorTypeAsm(/*isValueTensor=*/true,
+                                     /*useLogicalDims=*/true);
+  }
+  std::string permuteY =
+      getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false);
+
+  return std::format(schema,
+                     permuteXs.str(),       // {0}
+                     suffix,                // {1}
+                     names.str(),           // {2}
+                     types.str(),           // {3}
+                     getNormalizedAxis(),   // {4}
+                     yT->getValueNameAsm(), // {5}
+                     yT->getTensorTypeAsm(/*isValueTensor=*/true,
+                                          /*useLogicalDims=*/true), // {6}
+                     permuteY                                       // {7}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// SliceUpdateNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits `torch.aten.slice_scatter` of UPDATE into X along the axis, between
+// the runtime START and START + update_len. With Y written in-place into X,
+// IREE lowers it to an `insert_slice` into the tied buffer of X.
+inline std::string SliceUpdateNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {1}
+    {2}
+    {3}
+    %slice_update_dim_{0} = torch.constant.int {4}
+    %slice_update_offset_{0} = torch.aten.item {5}_{0}_perm : {6} -> !torch.int
+    %slice_update_first_{0} = torch.constant.int 0
+    %slice_update_last_{0} = torch.constant.int {15}
+    %slice_update_nonneg_{0} = torch.prim.max.int %slice_update_offset_{0}, %slice_update_first_{0} : !torch.int, !torch.int -> !torch.int
+    %slice_update_start_{0} = torch.prim.min.int %slice_update_nonneg_{0}, %slice_update_last_{0} : !torch.int, !torch.int -> !torch.int
+    %slice_update_len_{0} = torch.constant.int {7}
+    %slice_update_end_{0} = torch.aten.add.int %slice_update_start_{0}, %slice_update_len_{0} : !torch.int, !torch.int -> !torch.int
+    %slice_update_step_{0} = torch.constant.int 1
+    {8}_{0}_perm = torch.aten.slice_scatter {9}_{0}_perm, {10}_{0}_perm, %slice_update_dim_{0}, %slice_update_start_{0}, %slice_update_end_{0}, %slice_update_step_{0} : {11}, {12}, !torch.int, !torch.int, !torch.int, !torch.int -> {13}
+    {14}
+  )";
+
+  std::string suffix = sliceUpdateAttr.getName();
+  std::shared_ptr<TensorAttr> xT = sliceUpdateAttr.getX();
+  std::shared_ptr<TensorAttr> updateT = sliceUpdateAttr.getUPDATE();
+  std::shared_ptr<TensorAttr> startT = sliceUpdateAttr.getSTART();
+  std::shared_ptr<TensorAttr> yT = sliceUpdateAttr.getY();
+  int64_t axis = getNormalizedAxis();
+  int64_t updateLen = updateT->getDim()[static_cast<size_t>(axis)];
+  // The last offset at which UPDATE fits in X, which START is clamped to.
+  int64_t lastStart = xT->getDim()[static_cast<size_t>(axis)] - updateLen;
+
+  std::string permuteX =
+      getLayoutConversionOpsAsm(xT, "permute_X", suffix, /*isInput=*/true);
+  std::string permuteUpdate = getLayoutConversionOpsAsm(
+      updateT, "permute_UPDATE", suffix, /*isInput=*/true);
+  std::string permuteStart = getLayoutConversionOpsAsm(
+      startT, "permute_START", suffix, /*isInput=*/true);
+  std::string permuteY =
+      getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false);
+  auto logicalType = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true,
+                               /*useLogicalDims=*/true);
+  };
+
+  return std::format(schema,
+                     suffix,                     // {0}
+                     permuteX,                   // {1}
+                     permuteUpdate,              // {2}
+                     permuteStart,               // {3}
+                     axis,                       // {4}
+                     startT->getValueNameAsm(),  // {5}
+                     logicalType(startT),        // {6}
+                     updateLen,                  // {7}
+                     yT->getValueNameAsm(),      // {8}
+                     xT->getValueNameAsm(),      // {9}
+                     updateT->getValueNameAsm(), // {10}
+                     logicalType(xT),            // {11}
+                     logicalType(updateT),       // {12}
+                     logicalType(yT),            // {13}
+                     permuteY,                   // {14}
+                     lastStart                   // {15}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// IndexSelectNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits `torch.aten.index_select` of X along the axis. The op takes a 1D
+// index, so INDEX is flattened first and the gathered slices are viewed back
+// to the dims of Y.
+inline std::string IndexSelectNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {1}
+    {2}
+    {3}
+    {4}
+    %index_select_dim_{0} = torch.constant.int {5}
+    %index_select_index_{0} = torch.aten.view {6}_{0}_perm, %index_select_index_shape_{0} : {7}, !torch.list<int> -> {8}
+    %index_select_gathered_{0} = torch.aten.index_select {9}_{0}_perm, %index_select_dim_{0}, %index_select_index_{0} : {10}, !torch.int, {8} -> {11}
+    {12}_{0}_perm = torch.aten.view %index_select_gathered_{0}, %index_select_y_shape_{0} : {11}, !torch.list<int> -> {13}
+    {14}
+  )";
+
+  std::string suffix = indexSelectAttr.getName();
+  std::shared_ptr<TensorAttr> xT = indexSelectAttr.getX();
+  std::shared_ptr<TensorAttr> indexT = indexSelectAttr.getINDEX();
+  std::shared_ptr<TensorAttr> yT = indexSelectAttr.getY();
+  size_t axis = static_cast<size_t>(getNormalizedAxis());
+  int64_t numIndices = getNumElements(indexT->getDim());
+  std::vector<int64_t> gatheredDim =
+      replaceAxisDims(xT->getDim(), axis, {numIndices});
+
+  std::string permuteX =
+      getLayoutConversionOpsAsm(xT, "permute_X", suffix, /*isInput=*/true);
+  std::string permuteIndex = getLayoutConversionOpsAsm(
+      indexT, "permute_INDEX", suffix, /*isInput=*/true);
+  std::string permuteY =
+      getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false);
+  auto logicalType = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true,
+                               /*useLogicalDims=*/true);
+  };
+
+  return std::format(
+      schema,
+      suffix,                                                        // {0}
+      permuteX,                                                      // {1}
+      permuteIndex,                                                  // {2}
+      getListOfIntOpsAsm({numIndices}, "index_select_index_shape",
+                         suffix),                                    // {3}
+      getListOfIntOpsAsm(yT->getDim(), "index_select_y_shape",
+                         suffix),                                    // {4}
+      axis,                                                          // {5}
+      indexT->getValueNameAsm(),                                     // {6}
+      logicalType(indexT),                                           // {7}
+      buildTensorTypeStr({numIndices}, indexT->getDataType()),       // {8}
+      xT->getValueNameAsm(),                                         // {9}
+      logicalType(xT),                                               // {10}
+      buildTensorTypeStr(gatheredDim, xT->getDataType()),            // {11}
+      yT->getValueNameAsm(),                                         // {12}
+      logicalType(yT),                                               // {13}
+      permuteY                                                       // {14}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// IndexAddNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits `torch.aten.index_add` of SOURCE into X, or into zeros when X is not
+// set, along the axis. As for `IndexSelectNode`, INDEX is flattened and
+// SOURCE viewed accordingly. The accumulation is in f32 so that the sums of
+// repeated indices (e.g. the gradient of a frequent token's embedding) keep
+// their precision with f16 or bf16 tensors.
+inline std::string IndexAddNode::emitNodePreAsm() const {
+  constexpr std::string_view schema = R"(
+    {1}
+    {2}
+    {3}
+    {4}
+    %index_add_dim_{0} = torch.constant.int {5}
+    %index_add_f32_{0} = torch.constant.int {6}
+    %index_add_false_{0} = torch.constant.bool false
+    %index_add_none_{0} = torch.constant.none
+    %index_add_alpha_{0} = torch.constant.int 1
+    {7}
+    %index_add_index_{0} = torch.aten.view {8}_{0}_perm, %index_add_index_shape_{0} : {9}, !torch.list<int> -> {10}
+    %index_add_source_flat_{0} = torch.aten.view {11}_{0}_perm, %index_add_source_shape_{0} : {12}, !torch.list<int> -> {13}
+    %index_add_source_{0} = torch.aten.to.dtype %index_add_source_flat_{0}, %index_add_f32_{0}, %index_add_false_{0}, %index_add_false_{0}, %index_add_none_{0} : {13}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {14}
+    %index_add_acc_{0} = torch.aten.index_add %index_add_base_{0}, %index_add_dim_{0}, %index_add_index_{0}, %index_add_source_{0}, %index_add_alpha_{0} : {15}, !torch.int, {10}, {14}, !torch.int -> {15}
+    %index_add_dtype_{0} = torch.constant.int {16}
+    {17}_{0}_perm = torch.aten.to.dtype %index_add_acc_{0}, %index_add_dtype_{0}, %index_add_false_{0}, %index_add_false_{0}, %index_add_none_{0} : {15}, !torch.int, !torch.bool, !torch.bool, !torch.none -> {18}
+    {19}
+  )";
+
+  std::string suffix = indexAddAttr.getName();
+  std::shared_ptr<TensorAttr> xT = indexAddAttr.getX();
+  std::shared_ptr<TensorAttr> indexT = indexAddAttr.getINDEX();
+  std::shared_ptr<TensorAttr> sourceT = indexAddAttr.getSOURCE();
+  std::shared_ptr<TensorAttr> yT = indexAddAttr.getY();
+  size_t axis = static_cast<size_t>(getNormalizedAxis());
+  int64_t numIndices = getNumElements(indexT->getDim());
+  std::vector<int64_t> sourceFlatDim =
+      replaceAxisDims(yT->getDim(), axis, {numIndices});
+  std::string accType = buildTensorTypeStr(yT->getDim(), DataType::Float);
+
+  std::string shapeOps =
+      getListOfIntOpsAsm({numIndices}, "index_add_index_shape", suffix);
+  shapeOps += "    ";
+  appendListOfIntOpsAsm(shapeOps, sourceFlatDim, "index_add_source_shape",
+                        suffix);
+  std::string permuteX, baseOp;
+  if (xT) {
+    permuteX =
+        getLayoutConversionOpsAsm(xT, "permute_X", suffix, /*isInput=*/true);
+    baseOp = std::format(
+        "%index_add_base_{0} = torch.aten.to.dtype {1}_{0}_perm, "
+        "%index_add_f32_{0}, %index_add_false_{0}, %index_add_false_{0}, "
+        "%index_add_none_{0} : {2}, !torch.int, !torch.bool, !torch.bool, "
+        "!torch.none -> {3}",
+        suffix, xT->getValueNameAsm(),
+        xT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true),
+        accType);
+  } else {
+    shapeOps += "    ";
+    appendListOfIntOpsAsm(shapeOps, yT->getDim(), "index_add_base_shape",
+                          suffix);
+    baseOp = std::format(
+        "%index_add_base_{0} = torch.aten.zeros %index_add_base_shape_{0}, "
+        "%index_add_f32_{0}, %index_add_none_{0}, %index_add_none_{0}, "
+        "%index_add_none_{0} : !torch.list<int>, !torch.int, !torch.none, "
+        "!torch.none, !torch.none -> {1}",
+        suffix, accType);
+  }
+  std::string permuteIndex = getLayoutConversionOpsAsm(
+      indexT, "permute_INDEX", suffix, /*isInput=*/true);
+  std::string permuteSource = getLayoutConversionOpsAsm(
+      sourceT, "permute_SOURCE", suffix, /*isInput=*/true);
+  std::string permuteY =
+      getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false);
+  auto logicalType = [](const std::shared_ptr<TensorAttr> &t) {
+    return t->getTensorTypeAsm(/*isValueTensor=*/true,
+                               /*useLogicalDims=*/true);
+  };
+
+  return std::format(
+      schema,
+      suffix,                                                        // {0}
+      permuteX,                                                      // {1}
+      permuteIndex,                                                  // {2}
+      permuteSource,                                                 // {3}
+      shapeOps,                                                      // {4}
+      axis,                                                          // {5}
+      static_cast<int>(kDataTypeToTorchType.at(DataType::Float)),    // {6}
+      baseOp,                                                        // {7}
+      indexT->getValueNameAsm(),                                     // {8}
+      logicalType(indexT),                                           // {9}
+      buildTensorTypeStr({numIndices}, indexT->getDataType()),       // {10}
+      sourceT->getValueNameAsm(),                                    // {11}
+      logicalType(sourceT),                                          // {12}
+      buildTensorTypeStr(sourceFlatDim, sourceT->getDataType()),     // {13}
+      buildTensorTypeStr(sourceFlatDim, DataType::Float),            // {14}
+      accType,                                                       // {15}
+      static_cast<int>(kDataTypeToTorchType.at(yT->getDataType())),  // {16}
+      yT->getValueNameAsm(),                                         // {17}
+      logicalType(yT),                                               // {18}
+      permuteY                                                       // {19}
+  );
+}
+
+//===----------------------------------------------------------------------===//
+//
+// CollectiveNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits the `c10d_functional` op of the mode, then the `wait_tensor` giving
+// its result. The ops gather and scatter along dim 0, so another axis is
+// transposed to the front before and back after.
+inline std::string CollectiveNode::emitNodePreAsm() const {
+  constexpr std::string_view kTransposeSchema = R"(
+    %collective_axis_{0} = torch.constant.int {1}
+    %collective_dim0_{0} = torch.constant.int 0
+    {2} = torch.aten.transpose.int {3}, %collective_dim0_{0}, %collective_axis_{0} : {4}, !torch.int, !torch.int -> {5}
+)";
+
+  constexpr std::string_view kCollectiveSchema = R"(
+    %collective_tag_{0} = torch.constant.str ""
+    %collective_group_size_{0} = torch.constant.int {1}
+    {2}
+    %collective_async_{0} = torch.c10d_functional.{3} {4}, {5}%collective_tag_{0}, %collective_ranks_{0}, %collective_group_size_{0} : {6}, {7}!torch.str, !torch.list<int>, !torch.int -> {8}
+    {9} = torch.c10d_functional.wait_tensor %collective_async_{0} : {8} -> {8}
+)";
+
+  std::string suffix = collectiveAttr.getName();
+  std::shared_ptr<TensorAttr> xT = collectiveAttr.getX();
+  std::shared_ptr<TensorAttr> yT = collectiveAttr.getY();
+  CollectiveAttr::Mode mode = collectiveAttr.getMode();
+  DataType dataType = xT->getDataType();
+  std::string xName = xT->getValueNameAsm() + "_" + suffix + "_perm";
+  std::string yName = yT->getValueNameAsm() + "_" + suffix + "_perm";
+  std::string xType =
+      xT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+  std::string yType =
+      yT->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true);
+
+  int64_t axis =
+      mode == CollectiveAttr::Mode::ALL_REDUCE ? 0 : getNormalizedAxis();
+  std::vector<int64_t> inDim = xT->getDim();
+  std::vector<int64_t> outDim = yT->getDim();
+  std::swap(inDim[0], inDim[static_cast<size_t>(axis)]);
+  std::swap(outDim[0], outDim[static_cast<size_t>(axis)]);
+  std::string inName = axis ? "%collective_in_" + suffix : xName;
+  std::string inType = axis ? buildTensorTypeStr(inDim, dataType) : xType;
+  std::string outName = axis ? "%collective_out_" + suffix : yName;
+  std::string outType = axis ? buildTensorTypeStr(outDim, dataType) : yType;
+
+  std::string opName, reduceOp, reduceOpArg, reduceOpType;
+  switch (mode) {
+  case CollectiveAttr::Mode::ALL_REDUCE:
+    opName = "all_reduce";
+    break;
+  case CollectiveAttr::Mode::ALL_GATHER:
+    opName = "all_gather_into_tensor";
+    break;
+  case CollectiveAttr::Mode::REDUCE_SCATTER:
+    opName = "reduce_scatter_tensor";
+    break;
+  case CollectiveAttr::Mode::NOT_SET:
+    // Rejected by `preValidateNode()`, along with unknown modes.
+    break;
+  }
+  if (mode != CollectiveAttr::Mode::ALL_GATHER) {
+    reduceOp = std::format(
+        "%collective_op_{} = torch.constant.str \"{}\"", suffix,
+        CollectiveAttr::kReduceOpToStr.at(collectiveAttr.getReduceOp()));
+    reduceOpArg = "%collective_op_" + suffix + ", ";
+    reduceOpType = "!torch.str, ";
+  }
+
+  std::ostringstream oss;
+  oss << "\n    "
+      << getLayoutConversionOpsAsm(xT, "permute_X", suffix, /*isInput=*/true);
+  oss << "\n    "
+      << getListOfIntOpsAsm(collectiveAttr.getRanks(), "collective_ranks",
+                            suffix);
+  if (axis)
+    oss << std::format(kTransposeSchema,
+                       suffix, // {0}
+                       axis,   // {1}
+                       inName, // {2}
+                       xName,  // {3}
+                       xType,  // {4}
+                       inType  // {5}
+    );
+  oss << std::format(kCollectiveSchema,
+                     suffix,                        // {0}
+                     collectiveAttr.getGroupSize(), // {1}
+                     reduceOp,                      // {2}
+                     opName,                        // {3}
+                     inName,                        // {4}
+                     reduceOpArg,                   // {5}
+                     inType,                        // {6}
+                     reduceOpType,                  // {7}
+                     outType,                       // {8}
+                     outName                        // {9}
+  );
+  if (axis)
+    oss << "    "
+        << std::format("{0} = torch.aten.transpose.int {1}, "
+                       "%collective_dim0_{2}, %collective_axis_{2} : {3}, "
+                       "!torch.int, !torch.int -> {4}\n",
+                       yName, outName, suffix, outType, yType);
+  oss << "    "
+      << getLayoutConversionOpsAsm(yT, "permute_Y", suffix, /*isInput=*/false)
+      << "\n    ";
+  return oss.str();
+}
+
+//===----------------------------------------------------------------------===//
+//
+// OptimizerNode ASM Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits the MLIR assembly for the OptimizerNode. The update of each
+// parameter is computed in f32 on the permuted (logical) operands, as one
+// elementwise expression of P, G, M and V (see `OptimizerAttr::Mode`) that
+// fuses into a single dispatch per parameter. The hyperparameters stay [1]
+// tensors that broadcast; the terms shared by all parameters (1 - BETA1,
+// the bias corrections, ...) are computed once, e.g. for Adam
+//
+//   %opt_bc1_adam = torch.aten.rsub.Scalar %opt_beta1_pow_adam, ...
+//   %opt_step_size_adam = torch.aten.div.Tensor %lr, %opt_bc1_adam : ...
+//   %opt_m_new_0_adam = torch.aten.add.Tensor %opt_m_decay_0_adam, ...
+//   %opt_v_new_0_adam = torch.aten.add.Tensor %opt_v_decay_0_adam, ...
+//   %opt_p_new_0_adam = torch.aten.sub.Tensor %opt_p_0_adam, ...
+inline std::string OptimizerNode::emitNodePreAsm() const {
+  std::string suffix = optimizerAttr.getName();
+  OptimizerAttr::Mode mode = optimizerAttr.getMode();
+  const auto &params = optimizerAttr.getParams();
+  const auto &grads = optimizerAttr.getGrads();
+  const auto &moments1 = optimizerAttr.getMoments1();
+  const auto &moments2 = optimizerAttr.getMoments2();
+  const auto &newParams = optimizerAttr.getNewParams();
+  const auto &newMoments1 = optimizerAttr.getNewMoments1();
+  const auto &newMoments2 = optimizerAttr.getNewMoments2();
+  std::shared_ptr<TensorAttr> wdT = optimizerAttr.getWEIGHT_DECAY();
+  std::shared_ptr<TensorAttr> muT = optimizerAttr.getMOMENTUM();
+  std::string scalarType = buildTensorTypeStr({1}, DataType::Float);
+
+  // Each group of layout conversion ops is followed by a line break so that
+  // the next one starts at op indentation.
+  std::string permuteInputs, permuteOutputs;
+  auto permute = [&](const OptimizerAttr::TensorList &list,
+                     const std::string &prefix, bool isInput) {
+    for (size_t i = 0; i < list.size(); ++i)
+      (isInput ? permuteInputs : permuteOutputs) +=
+          getLayoutConversionOpsAsm(list[i], prefix + std::to_string(i),
+                                    suffix, isInput) +
+          "\n    ";
+  };
+  permute(params, "permute_p", /*isInput=*/true);
+  permute(grads, "permute_g", /*isInput=*/true);
+  permute(moments1, "permute_m", /*isInput=*/true);
+  permute(moments2, "permute_v", /*isInput=*/true);
+  permute(newParams, "permute_p_new", /*isInput=*/false);
+  permute(newMoments1, "permute_m_new", /*isInput=*/false);
+  permute(newMoments2, "permute_v_new", /*isInput=*/false);
+
+  constexpr std::string_view setupSchema = R"(
+    %opt_int1_{0} = torch.constant.int 1
+    %opt_one_{0} = torch.constant.float 1.000000e+00
+    %opt_f32_{0} = torch.constant.int {1}
+    %opt_false_{0} = torch.constant.bool false
+    %opt_none_{0} = torch.constant.none
+)";
+  std::string ops =
+      std::format(setupSchema, suffix,
+                  static_cast<int>(kDataTypeToTorchType.at(DataType::Float)));
+
+  auto append = [&](std::string_view line) {
+    ops += "    ";
+    ops += line;
+    ops += '\n';
+  };
+  auto value = [&](const std::string &name) {
+    return "%opt_" + name + "_" + suffix;
+  };
+  // Casts the permuted input `t` to f32 into `%opt_{name}_{suffix}`.
+  auto toF32 = [&](const std::string &name,
+                   const std::shared_ptr<TensorAttr> &t) {
+    append(std::format(
+        "{0} = torch.aten.to.dtype {1}_{2}_perm, %opt_f32_{2}, "
+        "%opt_false_{2}, %opt_false_{2}, %opt_none_{2} : {3}, !torch.int, "
+        "!torch.bool, !torch.bool, !torch.none -> {4}",
+        value(name), t->getValueNameAsm(), suffix,
+        t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true),
+        buildTensorTypeStr(t->getDim(), DataType::Float)));
+    return value(name);
+  };
+  // Casts the f32 `operand` to the permuted result of the output `t`.
+  auto fromF32 = [&](const std::string &name, const std::string &operand,
+                     const std::shared_ptr<TensorAttr> &t) {
+    append(std::format(
+        "{0} = torch.constant.int {1}", value(name + "_dtype"),
+        static_cast<int>(kDataTypeToTorchType.at(t->getDataType()))));
+    append(std::format(
+        "{0}_{1}_perm = torch.aten.to.dtype {2}, {3}, %opt_false_{1}, "
+        "%opt_false_{1}, %opt_none_{1} : {4}, !torch.int, !torch.bool, "
+        "!torch.bool, !torch.none -> {5}",
+        t->getValueNameAsm(), suffix, operand, value(name + "_dtype"),
+        buildTensorTypeStr(t->getDim(), DataType::Float),
+        t->getTensorTypeAsm(/*isValueTensor=*/true, /*useLogicalDims=*/true)));
+  };
+  // Elementwise `op` of `a` (of type `type`) and `b` (of type `type`, or a
+  // hyperparameter of type `scalarType` when `isScalar`) into
+  // `%opt_{name}_{suffix}`.
+  auto binary = [&](std::string_view op, const std::string &name,
+                    const std::string &a, const std::string &b,
+                    const std::string &type, bool isScalar) {
+    bool hasAlpha = op == "add" || op == "sub";
+    append(std::format("{0} = torch.aten.{1}.{2} {3}, {4}{5} : {6}, {7}{8} "
+                       "-> {6}",
+                       value(name), op,
+                       op == "pow" ? "Tensor_Tensor" : "Tensor", a, b,
+                       hasAlpha ? ", %opt_int1_" + suffix : "", type,
+                       isScalar ? scalarType : type,
+                       hasAlpha ? ", !torch.int" : ""));
+    return value(name);
+  };
+  // 1 - `operand`, of a hyperparameter.
+  auto oneMinus = [&](const std::string &name, const std::string &operand) {
+    append(std::format("{0} = torch.aten.rsub.Scalar {1}, %opt_one_{2}, "
+                       "%opt_one_{2} : {3}, !torch.float, !torch.float -> {3}",
+                       value(name), operand, suffix, scalarType));
+    return value(name);
+  };
+  auto squareRoot = [&](const std::string &name, const std::string &operand,
+                        const std::string &type) {
+    append(std::format("{0} = torch.aten.sqrt {1} : {2} -> {2}", value(name),
+                       operand, type));
+    return value(name);
+  };
+  auto hyperparameter = [](const std::shared_ptr<TensorAttr> &t) {
+    return t ? t->getValueNameAsm() : "";
+  };
+
+  std::string lr = hyperparameter(optimizerAttr.getLR());
+  std::string wd = hyperparameter(wdT);
+  std::string mu = hyperparameter(muT);
+  std::string beta1 = hyperparameter(optimizerAttr.getBETA1());
+  std::string beta2 = hyperparameter(optimizerAttr.getBETA2());
+  std::string eps = hyperparameter(optimizerAttr.getEPSILON());
+
+  // Terms shared by all parameters.
+  std::string oneMinusBeta1, oneMinusBeta2, stepSize, sqrtBc2, decay;
+  if (optimizerAttr.hasMoments2()) {
+    std::string step = hyperparameter(optimizerAttr.getSTEP());
+    oneMinusBeta1 = oneMinus("one_minus_beta1", beta1);
+    oneMinusBeta2 = oneMinus("one_minus_beta2", beta2);
+    std::string bc1 = oneMinus("bc1", binary("pow", "beta1_pow", beta1, step,
+                                             scalarType, true));
+    std::string bc2 = oneMinus("bc2", binary("pow", "beta2_pow", beta2, step,
+                                             scalarType, true));
+    stepSize = binary("div", "step_size", lr, bc1, scalarType, true);
+    sqrtBc2 = squareRoot("sqrt_bc2", bc2, scalarType);
+    if (mode == OptimizerAttr::Mode::ADAMW && wdT)
+      decay = oneMinus("decay",
+                       binary("mul", "lr_wd", lr, wd, scalarType, true));
+  }
+
+  for (size_t i = 0; i < params.size(); ++i) {
+    std::string n = "_" + std::to_string(i);
+    std::string type = buildTensorTypeStr(params[i]->getDim(), DataType::Float);
+    std::string p = toF32("p" + n, params[i]);
+    std::string g = toF32("g" + n, grads[i]);
+
+    // Adam and SGD decay the gradient, AdamW the parameter.
+    if (wdT && mode == OptimizerAttr::Mode::ADAMW) {
+      p = binary("mul", "p_decayed" + n, p, decay, type, true);
+    } else if (wdT) {
+      std::string pDecay = binary("mul", "p_wd" + n, p, wd, type, true);
+      g = binary("add", "g_decayed" + n, g, pDecay, type, false);
+    }
+
+    std::string update;
+    if (optimizerAttr.hasMoments2()) {
+      std::string m = toF32("m" + n, moments1[i]);
+      std::string v = toF32("v" + n, moments2[i]);
+      std::string mDecay = binary("mul", "m_decay" + n, m, beta1, type, true);
+      std::string gScaled =
+          binary("mul", "g_scaled" + n, g, oneMinusBeta1, type, true);
+      std::string mNew =
+          binary("add", "m_new" + n, mDecay, gScaled, type, false);
+      std::string vDecay = binary("mul", "v_decay" + n, v, beta2, type, true);
+      std::string gSquared = binary("mul", "g_sq" + n, g, g, type, false);
+      std::string gSquaredScaled = binary("mul", "g_sq_scaled" + n, gSquared,
+                                          oneMinusBeta2, type, true);
+      std::string vNew =
+          binary("add", "v_new" + n, vDecay, gSquaredScaled, type, false);
+      std::string vHatSqrt =
+          binary("div", "v_hat_sqrt" + n, squareRoot("v_sqrt" + n, vNew, type),
+                 sqrtBc2, type, true);
+      std::string denom = binary("add", "denom" + n, vHatSqrt, eps, type, true);
+      std::string ratio = binary("div", "ratio" + n, mNew, denom, type, false);
+      update = binary("mul", "update" + n, ratio, stepSize, type, true);
+      fromF32("m_out" + n, mNew, newMoments1[i]);
+      fromF32("v_out" + n, vNew, newMoments2[i]);
+    } else {
+      update = g;
+      if (muT) {
+        std::string m = toF32("m" + n, moments1[i]);
+        std::string mDecay = binary("mul", "m_decay" + n, m, mu, type, true);
+        std::string mNew = binary("add", "m_new" + n, mDecay, g, type, false);
+        update = mNew;
+        if (optimizerAttr.getNesterov()) {
+          std::string mNewMu =
+              binary("mul", "m_new_mu" + n, mNew, mu, type, true);
+          update = binary("add", "nesterov" + n, g, mNewMu, type, false);
+        }
+        fromF32("m_out" + n, mNew, newMoments1[i]);
+      }
+      update = binary("mul", "update" + n, update, lr, type, true);
+    }
+    fromF32("p_out" + n, binary("sub", "p_new" + n, p, update, type, false),
+            newParams[i]);
+  }
+
+  constexpr std::string_view schema = R"(
+    {0}
+    {1}
+    {2}
+  )";
+
+  return std::format(schema, permuteInputs, ops, permuteOutputs);
+}
+
 //===----------------------------------------------------------------------===//
 //
 // CustomOpNode ASM Emitter Methods
@@ -2482,38 +6488,231 @@ inline void replaceAll(std::string &str, const std::string &from,
   }
 }
 
+// Returns the instantiation of a custom op MLIR template under `key` (see
+// `CustomOpNode::getInstantiationKey()`), calling `instantiate` on a miss.
+// The cache is process-wide, so a template used with the same types across
+// many graphs is only instantiated once. It is cleared when it grows past
+// `kMaxEntries`, which only costs re-instantiation.
+template <typename InstantiateFn>
+inline std::shared_ptr<const std::string>
+getCustomOpInstantiation(const std::string &key, InstantiateFn instantiate) {
+  static constexpr size_t kMaxEntries = 4096;
+  static std::mutex cacheMutex;
+  static std::unordered_map<std::string, std::shared_ptr<const std::string>>
+      cache;
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  if (auto it = cache.find(key); it != cache.end())
+    return it->second;
+  if (cache.size() >= kMaxEntries)
+    cache.clear();
+  auto instantiation = std::make_shared<const std::string>(instantiate());
+  cache.emplace(key, instantiation);
+  return instantiation;
+}
+
+inline std::string CustomOpNode::getInstantiationKey() const {
+  if (customOpAttr.getExternalKernel())
+    return "";
+  std::string key = Hasher::toHex(customOpAttr.getMlirHash());
+  for (const auto &input : inputs) {
+    key += '|';
+    key += input->getTensorTypeAsm(/*isValueTensor=*/true,
+                                   /*useLogicalDims=*/true);
+  }
+  key += "->";
+  for (const auto &output : outputs) {
+    key += '|';
+    key += output->getTensorTypeAsm(/*isValueTensor=*/true,
+                                    /*useLogicalDims=*/true);
+  }
+  return key;
+}
+
 inline std::string CustomOpNode::resolveMlirPlaceholders() const {
-  std::string mlir = customOpAttr.getMlir();
-  replaceAll(mlir, "{FUNC_NAME}", customOpAttr.getName());
+  auto instantiation = getCustomOpInstantiation(getInstantiationKey(), [&] {
+    std::string mlir = customOpAttr.getMlir();
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      std::string iStr = std::to_string(i);
+      replaceAll(mlir, "{IN" + iStr + "_DTYPE}",
+                 kDataTypeToMlirTypeAsm.at(inputs[i]->getDataType()));
+      replaceAll(mlir, "{IN" + iStr + "_TYPE}",
+                 inputs[i]->getTensorTypeAsm(/*isValueTensor=*/true,
+                                             /*useLogicalDims=*/true));
+      const auto &dims = inputs[i]->getDim();
+      for (size_t d = 0; d < dims.size(); ++d)
+        replaceAll(mlir, "{IN" + iStr + "_DIM" + std::to_string(d) + "}",
+                   inputs[i]->isDynamicDim(d) ? "?" : std::to_string(dims[d]));
+    }
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      std::string iStr = std::to_string(i);
+      replaceAll(mlir, "{OUT" + iStr + "_DTYPE}",
+                 kDataTypeToMlirTypeAsm.at(outputs[i]->getDataType()));
+      replaceAll(mlir, "{OUT" + iStr + "_TYPE}",
+                 outputs[i]->getTensorTypeAsm(/*isValueTensor=*/true,
+                                              /*useLogicalDims=*/true));
+      const auto &dims = outputs[i]->getDim();
+      for (size_t d = 0; d < dims.size(); ++d)
+        replaceAll(mlir, "{OUT" + iStr + "_DIM" + std::to_string(d) + "}",
+                   outputs[i]->isDynamicDim(d) ? "?"
+                                               : std::to_string(dims[d]));
+    }
+    return mlir;
+  });
+  std::string mlir = *instantiation;
+  replaceAll(mlir, "{FUNC_NAME}", getCalleeName());
+  return mlir;
+}
+
+// Emits the builtin tensor type of `tensor` in logical dims (e.g.
+// `tensor<4x8xf32>`), as seen by dispatches across the torch boundary.
+// Integer element types are signless.
+inline std::string getBuiltinTensorTypeAsm(const TensorAttr &tensor) {
+  std::string out = "tensor<";
+  auto it = std::back_inserter(out);
+  for (int64_t dim : tensor.getDim())
+    it = std::format_to(it, "{}x", dim);
+  std::string_view elementType = kDataTypeToMlirTypeAsm.at(
+      tensor.getDataType());
+  if (elementType.starts_with("si") || elementType.starts_with("ui"))
+    elementType.remove_prefix(1);
+  out += elementType;
+  out += '>';
+  return out;
+}
+
+// Emits the module-scope assembly of a CustomOpNode implemented by an
+// external kernel (see `CustomOpAttr::setExternalKernel()`): an executable
+// source referencing the code object, and the function `@<name>` crossing
+// into builtin tensors to `flow.dispatch` it. For example:
+//
+//   hal.executable.source private @my_op_executable attributes {
+//     objects = #hal.executable.objects<{
+//       #hal.executable.target<"rocm", "rocm-hsaco-fb",
+//                              {target_arch = "gfx942"}> = [
+//         #hal.executable.object<{path = "/path/to/kernel.co"}>
+//       ]
+//     }>
+//   } {
+//     hal.executable.export public @my_kernel ordinal(0)
+//         layout(#hal.pipeline.layout<bindings = [
+//           #hal.pipeline.binding<storage_buffer, ReadOnly>,
+//           #hal.pipeline.binding<storage_buffer>
+//         ]>)
+//         count(%device: !hal.device) -> (index, index, index) {
+//       %x = arith.constant 4 : index
+//       %y = arith.constant 1 : index
+//       %z = arith.constant 1 : index
+//       hal.return %x, %y, %z : index, index, index
+//     } attributes {workgroup_size = [64 : index, 1 : index, 1 : index]}
+//   }
+//   func.func private @my_op(%arg0: !torch.vtensor<[256],f32>)
+//       -> !torch.vtensor<[256],f32> {
+//     %in0 = torch_c.to_builtin_tensor %arg0
+//         : !torch.vtensor<[256],f32> -> tensor<256xf32>
+//     %res = flow.dispatch @my_op_executable::@my_kernel(%in0)
+//         : (tensor<256xf32>) -> tensor<256xf32>
+//     %out0 = torch_c.from_builtin_tensor %res
+//         : tensor<256xf32> -> !torch.vtensor<[256],f32>
+//     return %out0 : !torch.vtensor<[256],f32>
+//   }
+inline std::string CustomOpNode::getExternalKernelAsm() const {
+  const ExternalKernel &kernel = *customOpAttr.getExternalKernel();
+  const std::string &name = customOpAttr.getName();
+
+  std::string bindings;
+  for (size_t i = 0; i < inputs.size() + outputs.size(); ++i)
+    bindings += std::format(
+        "{}\n          #hal.pipeline.binding<storage_buffer{}>",
+        i ? "," : "", i < inputs.size() ? ", ReadOnly" : "");
+
+  std::string args, argTypes, converts, dispatchOperands, dispatchTypes;
   for (size_t i = 0; i < inputs.size(); ++i) {
-    std::string iStr = std::to_string(i);
-    replaceAll(mlir, "{IN" + iStr + "_DTYPE}",
-               kDataTypeToMlirTypeAsm.at(inputs[i]->getDataType()));
-    replaceAll(mlir, "{IN" + iStr + "_TYPE}",
-               inputs[i]->getTensorTypeAsm(/*isValueTensor=*/true,
-                                           /*useLogicalDims=*/true));
-    const auto &dims = inputs[i]->getDim();
-    for (size_t d = 0; d < dims.size(); ++d)
-      replaceAll(mlir, "{IN" + iStr + "_DIM" + std::to_string(d) + "}",
-                 inputs[i]->isDynamicDim(d) ? "?" : std::to_string(dims[d]));
+    std::string type = inputs[i]->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                   /*useLogicalDims=*/true);
+    std::string builtinType = getBuiltinTensorTypeAsm(*inputs[i]);
+    args += std::format("{}%arg{}: {}", i ? ", " : "", i, type);
+    converts += std::format("\n    %in{0} = torch_c.to_builtin_tensor %arg{0} "
+                            ": {1} -> {2}",
+                            i, type, builtinType);
+    dispatchOperands += std::format("{}%in{}", i ? ", " : "", i);
+    dispatchTypes += std::format("{}{}", i ? ", " : "", builtinType);
   }
+
+  bool multiResult = outputs.size() > 1;
+  std::string resultTypes, builtinResultTypes, results, resultConverts;
   for (size_t i = 0; i < outputs.size(); ++i) {
-    std::string iStr = std::to_string(i);
-    replaceAll(mlir, "{OUT" + iStr + "_DTYPE}",
-               kDataTypeToMlirTypeAsm.at(outputs[i]->getDataType()));
-    replaceAll(mlir, "{OUT" + iStr + "_TYPE}",
-               outputs[i]->getTensorTypeAsm(/*isValueTensor=*/true,
-                                            /*useLogicalDims=*/true));
-    const auto &dims = outputs[i]->getDim();
-    for (size_t d = 0; d < dims.size(); ++d)
-      replaceAll(mlir, "{OUT" + iStr + "_DIM" + std::to_string(d) + "}",
-                 outputs[i]->isDynamicDim(d) ? "?" : std::to_string(dims[d]));
+    std::string type = outputs[i]->getTensorTypeAsm(/*isValueTensor=*/true,
+                                                    /*useLogicalDims=*/true);
+    std::string builtinType = getBuiltinTensorTypeAsm(*outputs[i]);
+    resultTypes += std::format("{}{}", i ? ", " : "", type);
+    builtinResultTypes += std::format("{}{}", i ? ", " : "", builtinType);
+    results += std::format("{}%out{}", i ? ", " : "", i);
+    resultConverts += std::format(
+        "\n    %out{0} = torch_c.from_builtin_tensor %res{1} : {2} -> {3}", i,
+        multiResult ? "#" + std::to_string(i) : "", builtinType, type);
   }
-  return mlir;
+  std::string funcResultTypes =
+      multiResult ? "(" + resultTypes + ")" : resultTypes;
+
+  constexpr std::string_view schema = R"(
+  hal.executable.source private @{0}_executable attributes {{
+    objects = #hal.executable.objects<{{
+      #hal.executable.target<"{1}", "{2}", {{target_arch = "{3}"}}> = [
+        #hal.executable.object<{{path = "{4}"}}>
+      ]
+    }}>
+  }} {{
+    hal.executable.export public @{5} ordinal(0)
+        layout(#hal.pipeline.layout<bindings = [{6}
+        ]>)
+        count(%device: !hal.device) -> (index, index, index) {{
+      %x = arith.constant {10} : index
+      %y = arith.constant {11} : index
+      %z = arith.constant {12} : index
+      hal.return %x, %y, %z : index, index, index
+    }} attributes {{workgroup_size = [{7} : index, {8} : index, {9} : index]}}
+  }}
+  func.func private @{0}({13}) -> {14} {{{15}
+    %res{16} = flow.dispatch @{0}_executable::@{5}({17}) : ({18}) -> {19}{20}
+    return {21} : {22}
+  }}
+)";
+  return std::format(
+      schema,
+      name,                                                            // {0}
+      kernel.backend,                                                  // {1}
+      kernel.format,                                                   // {2}
+      kernel.targetArch,                                               // {3}
+      std::filesystem::absolute(kernel.objectPath).generic_string(),   // {4}
+      kernel.entryPoint,                                               // {5}
+      bindings,                                                        // {6}
+      kernel.workgroupSize[0],                                         // {7}
+      kernel.workgroupSize[1],                                         // {8}
+      kernel.workgroupSize[2],                                         // {9}
+      kernel.workgroupCount[0],                                        // {10}
+      kernel.workgroupCount[1],                                        // {11}
+      kernel.workgroupCount[2],                                        // {12}
+      args,                                                            // {13}
+      funcResultTypes,                                                 // {14}
+      converts,                                                        // {15}
+      multiResult ? std::format(":{}", outputs.size()) : std::string(), // {16}
+      dispatchOperands,                                                // {17}
+      dispatchTypes,                                                   // {18}
+      multiResult ? "(" + builtinResultTypes + ")"
+                  : builtinResultTypes,                                // {19}
+      resultConverts,                                                  // {20}
+      results,                                                         // {21}
+      resultTypes                                                      // {22}
+  );
 }
 
 inline std::string CustomOpNode::emitModuleScopeAsm() const {
-  std::string mlir = resolveMlirPlaceholders();
+  // The function of a shared instantiation is emitted by its first caller.
+  if (getCalleeName() != customOpAttr.getName())
+    return "";
+  std::string mlir = customOpAttr.getExternalKernel()
+                         ? getExternalKernelAsm()
+                         : resolveMlirPlaceholders();
   if (!mlir.empty() && mlir.back() != '\n')
     mlir += '\n';
   return mlir;
@@ -2594,8 +6793,8 @@ inline std::string CustomOpNode::emitNodePreAsm() const {
                                      /*isInput=*/true);
   }
 
-  // 2. func.call — use the node name as the callee (matches {FUNC_NAME}
-  // resolved in the module-scope definition).
+  // 2. func.call — use the callee name (the node name unless the function is
+  // shared, matching {FUNC_NAME} resolved in the module-scope definition).
   std::string resultTypes = getCallResultTypesAsm();
   if (outputs.size() > 1)
     resultTypes = "(" + resultTypes + ")";
@@ -2604,7 +6803,7 @@ inline std::string CustomOpNode::emitNodePreAsm() const {
     {0} = func.call @{1}({2}) : ({3}) -> {4})";
   oss << std::format(kCallSchema,
                      getCallResultNamesAsm(),  // {0}
-                     customOpAttr.getName(),   // {1}
+                     getCalleeName(),          // {1}
                      getCallOperandNamesAsm(), // {2}
                      getCallOperandTypesAsm(), // {3}
                      resultTypes               // {4}
@@ -2629,6 +6828,105 @@ inline std::string CustomOpNode::emitNodePreAsm() const {
   return oss.str();
 }
 
+//===----------------------------------------------------------------------===//
+//
+// Tuning Spec Emitter Methods
+//
+//===----------------------------------------------------------------------===//
+
+// Emits the transform dialect matcher of the lowering config of the matmul
+// (see `MatmulAttr::setTileSizes()`), or an empty string if it has none. The
+// matcher recognizes the matmul dispatch by the types of its root op's LHS
+// and RHS operands, so matmuls with the same operand types share a config.
+inline std::string MatmulNode::getTuningSpecMatcherAsm() const {
+  if (!matmulAttr.hasLoweringConfig())
+    return "";
+
+  constexpr std::string_view schema = R"(
+  transform.named_sequence @match_{0}(%op: !transform.any_op {{transform.readonly}}) -> (!transform.any_op, !transform.any_param) {{
+    transform.match.operation_name %op ["linalg.matmul", "linalg.batch_matmul", "linalg.generic"] : !transform.any_op
+    %lhs = transform.get_operand %op[0] : (!transform.any_op) -> !transform.any_value
+    %rhs = transform.get_operand %op[1] : (!transform.any_op) -> !transform.any_value
+    transform.iree.match.cast_compatible_type %lhs = {1} : !transform.any_value
+    transform.iree.match.cast_compatible_type %rhs = {2} : !transform.any_value
+    %config = transform.param.constant #iree_codegen.compilation_info<lowering_config = #iree_gpu.lowering_config<{{workgroup = [{3}], reduction = [{4}]{5}}}>, translation_info = #iree_codegen.translation_info<pipeline = LLVMGPUTileAndFuse workgroup_size = [{6}] subgroup_size = {7}>> -> !transform.any_param
+    transform.yield %op, %config : !transform.any_op, !transform.any_param
+  }}
+)";
+
+  auto join = [](const std::vector<int64_t> &values) {
+    std::string out;
+    for (size_t i = 0; i < values.size(); ++i)
+      out += (i == 0 ? "" : ", ") + std::to_string(values[i]);
+    return out;
+  };
+  const std::string &intrinsic = matmulAttr.getMmaIntrinsic();
+  std::string mmaKind =
+      intrinsic.empty()
+          ? ""
+          : ", mma_kind = #iree_gpu.mma_layout<" + intrinsic + ">";
+
+  // The RHS of group-quantized weights is B dequantized to the type of A.
+  TensorAttr rhs = *matmulAttr.getB();
+  if (matmulAttr.isGroupQuantized())
+    rhs.setDataType(matmulAttr.getA()->getDataType());
+
+  return std::format(schema,
+                     matmulAttr.getName(),                        // {0}
+                     getBuiltinTensorTypeAsm(*matmulAttr.getA()), // {1}
+                     getBuiltinTensorTypeAsm(rhs),                // {2}
+                     join(matmulAttr.getWorkgroupTile()),         // {3}
+                     join(matmulAttr.getReductionTile()),         // {4}
+                     mmaKind,                                     // {5}
+                     join(matmulAttr.getWorkgroupSize()),         // {6}
+                     matmulAttr.getSubgroupSize()                 // {7}
+  );
+}
+
+// Emits the tuning spec applying the lowering configs of the nodes of the
+// graph, or std::nullopt if none has one. Each matcher annotates the root op
+// of its dispatch with the node's `compilation_info`.
+inline ErrorOr<std::optional<std::string>> Graph::emitTuningSpecAsm() const {
+  FUSILLI_RETURN_ERROR_IF(
+      !isValidated_, ErrorCode::NotValidated,
+      "Graph must be validated before emitting a tuning spec");
+
+  std::string matchers;
+  std::vector<std::string> names;
+  for (const auto &node : subNodes_) {
+    if (node->getType() != Type::Matmul)
+      continue;
+    const auto &matmul = static_cast<const MatmulNode &>(*node);
+    std::string matcher = matmul.getTuningSpecMatcherAsm();
+    if (matcher.empty())
+      continue;
+    matchers += matcher;
+    names.push_back(matmul.getName());
+  }
+  if (names.empty())
+    return ok(std::optional<std::string>());
+
+  constexpr std::string_view schema = R"(
+module attributes {{iree_codegen.tuning_spec_with_default_entrypoint, transform.with_named_sequence}} {{
+  transform.named_sequence @apply_op_config(%op: !transform.any_op {{transform.readonly}}, %config: !transform.any_param {{transform.readonly}}) {{
+    transform.annotate %op "compilation_info" = %config : !transform.any_op, !transform.any_param
+    transform.yield
+  }}
+{0}
+  transform.named_sequence @__kernel_config(%variant_op: !transform.any_op {{transform.consumed}}) -> !transform.any_op attributes {{iree_codegen.tuning_spec_entrypoint}} {{
+    %res = transform.foreach_match in %variant_op{1}
+      : (!transform.any_op) -> !transform.any_op
+    transform.yield %res : !transform.any_op
+  }}
+}}
+)";
+
+  std::string actions;
+  for (const std::string &name : names)
+    actions += "\n        @match_" + name + " -> @apply_op_config";
+  return ok(std::optional<std::string>(std::format(schema, matchers, actions)));
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_SUPPORT_ASM_EMITTER_H
@@ -13,20 +13,26 @@
 #ifndef FUSILLI_SUPPORT_CACHE_H
 #define FUSILLI_SUPPORT_CACHE_H
 
+#include "fusilli/support/compression.h"
 #include "fusilli/support/logging.h"
 #include "fusilli/support/target_platform.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <ios>
 #include <iostream>
+#include <optional>
+#include <span>
 #include <string>
 #include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -74,7 +80,13 @@ public:
   // returns an ErrorObject if file could not be created.
   static ErrorOr<CacheFile> create(const std::string &graphName,
                                    const std::string &fileName, bool remove) {
-    std::filesystem::path path = CacheFile::getPath(graphName, fileName);
+    return create(CacheFile::getPath(graphName, fileName), remove);
+  }
+
+  // Overload of the above taking a fully-formed path, used for files that do
+  // not live in a per-graph directory (e.g. the kernel cache).
+  static ErrorOr<CacheFile> create(const std::filesystem::path &path,
+                                   bool remove) {
     FUSILLI_LOG_LABEL_ENDL("INFO: Creating Cache file");
     FUSILLI_LOG_ENDL(path);
 
@@ -95,12 +107,48 @@ public:
     return ok(CacheFile(path, remove));
   }
 
+  // Creates or replaces the file at `path` with `content`, creating its
+  // parent directories if needed. Unlike `create()` followed by `write()`, an
+  // existing file is never truncated in place, so other processes reading
+  // shared files (e.g. kernel cache aliases or tuning specs) always observe
+  // complete contents. With a `compressionLevel`, `content` is stored
+  // compressed (see `compressArtifact()`); `read()` decompresses it.
+  static ErrorObject publish(const std::filesystem::path &path,
+                             const std::string &content,
+                             std::optional<int> compressionLevel = {}) {
+    return publish(path,
+                   std::span(reinterpret_cast<const uint8_t *>(content.data()),
+                             content.size()),
+                   compressionLevel);
+  }
+
+  // Overload of the above for binary contents, e.g. an artifact mapped from
+  // disk, which are written (or compressed) without an intermediate copy.
+  static ErrorObject publish(const std::filesystem::path &path,
+                             std::span<const uint8_t> bytes,
+                             std::optional<int> compressionLevel = {}) {
+    std::filesystem::path cacheDir = path.parent_path();
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDir, ec);
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to create cache directory: " +
+                                cacheDir.string() + " - " + ec.message());
+    if (!compressionLevel.has_value())
+      return CacheFile(path, /*remove=*/false).write(bytes);
+    FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> compressed,
+                             compressArtifact(bytes, *compressionLevel));
+    return CacheFile(path, /*remove=*/false).write(compressed);
+  }
+
   // Factory constructor that opens an existing file and returns ErrorObject if
   // the file does not exist.
   static ErrorOr<CacheFile> open(const std::string &graphName,
                                  const std::string &fileName) {
-    std::filesystem::path path = CacheFile::getPath(graphName, fileName);
+    return open(CacheFile::getPath(graphName, fileName));
+  }
 
+  // Overload of the above taking a fully-formed path.
+  static ErrorOr<CacheFile> open(const std::filesystem::path &path) {
     // Check if the file exists.
     FUSILLI_RETURN_ERROR_IF(!std::filesystem::exists(path),
                             ErrorCode::FileSystemFailure,
@@ -109,6 +157,12 @@ public:
     return ok(CacheFile(path, /*remove=*/false));
   }
 
+  // Opens the file at `path` known to exist, e.g. from the kernel cache index
+  // (see `detail::KernelCacheIndex`), without checking for it.
+  static CacheFile openUnchecked(const std::filesystem::path &path) {
+    return CacheFile(path, /*remove=*/false);
+  }
+
   static std::filesystem::path getCacheDir() {
     // Defaults to "${HOME}/.cache/fusilli" but having it set via
     // ${FUSILLI_CACHE_DIR} to "/tmp" helps bypass permission issues on
@@ -170,6 +224,81 @@ public:
     return cacheDir / sanitizedGraphName / fileName;
   }
 
+  // Utility method to build the path to a file in the content-addressed kernel
+  // cache given a cache `key` (see `Graph::getKernelCacheKey`).
+  //
+  // Format: ${HOME}/.cache/fusilli/kernels/<key>/<fileName>
+  //
+  // Keys are lowercase hex digests so they never need sanitization, and
+  // entries are shared by every graph (in any process) with the same key.
+  static std::filesystem::path getKernelCachePath(const std::string &key,
+                                                  const std::string &fileName) {
+    return getCacheDir() / "kernels" / key / fileName;
+  }
+
+  // Utility method to build the path to the file recording the autotuned
+  // compile options (see `fusilli::autotune`) for a graph fingerprint key (see
+  // `Graph::getFingerprintCacheKey`).
+  //
+  // Format: ${HOME}/.cache/fusilli/kernels/tuned/<fingerprintKey>
+  static std::filesystem::path
+  getKernelCacheTunedPath(const std::string &fingerprintKey) {
+    return getCacheDir() / "kernels" / "tuned" / fingerprintKey;
+  }
+
+  // Utility method to build the path to the file recording the execution
+  // time measured when autotuning a graph (see `fusilli::autotune`), next to
+  // its autotuned compile options.
+  //
+  // Format: ${HOME}/.cache/fusilli/kernels/tuned/<fingerprintKey>.time
+  static std::filesystem::path
+  getKernelCacheMeasuredTimePath(const std::string &fingerprintKey) {
+    return getCacheDir() / "kernels" / "tuned" / (fingerprintKey + ".time");
+  }
+
+  // Utility method to build the path to a tuning spec given the digest `key`
+  // of its contents (see `CompileOptions::setTuningSpecAsm`).
+  //
+  // Format: ${HOME}/.cache/fusilli/tuning_specs/<key>.mlir
+  //
+  // Specs are content-addressed because IREE caches parsed tuning specs by
+  // path for the lifetime of the process.
+  static std::filesystem::path getTuningSpecPath(const std::string &key) {
+    return getCacheDir() / "tuning_specs" / (key + ".mlir");
+  }
+
+  // Returns whether `path` names a file in a kernel cache entry (see
+  // `getKernelCachePath()`).
+  static bool isKernelCachePath(const std::filesystem::path &path) {
+    std::filesystem::path entryDir = path.parent_path();
+    return entryDir.parent_path() == getCacheDir() / "kernels" &&
+           entryDir.filename() != "aliases" && entryDir.filename() != "tuned";
+  }
+
+  // Utility method to build the path to the alias file mapping a structural
+  // graph fingerprint key (see `Graph::getFingerprintCacheKey`) to the kernel
+  // cache key of its compiled artifact.
+  //
+  // Format: ${HOME}/.cache/fusilli/kernels/aliases/<fingerprintKey>
+  static std::filesystem::path
+  getKernelCacheAliasPath(const std::string &fingerprintKey) {
+    return getCacheDir() / "kernels" / "aliases" / fingerprintKey;
+  }
+
+  // Utility method to build the path of a temporary sibling of `path`, unique
+  // to the calling process and thread. Files are written there and then
+  // renamed over `path` to publish them atomically.
+  //
+  // Format: <path>.tmp.<pid>.<thread hash>
+  static std::filesystem::path getTempPath(const std::filesystem::path &path) {
+    size_t threadHash =
+        std::hash<std::thread::id>{}(std::this_thread::get_id());
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp." + std::to_string(getProcessId()) + "." +
+                std::to_string(threadHash);
+    return tempPath;
+  }
+
   // Move constructors.
   CacheFile(CacheFile &&other) noexcept
       : path(std::move(other.path)), remove_(other.remove_) {
@@ -208,16 +337,41 @@ public:
   // Path of file this class wraps.
   std::filesystem::path path;
 
-  // Write to cache file.
+  // Write to cache file. The contents are written to a temporary sibling file
+  // (see `getTempPath()`) that is then renamed over `path`, so concurrent
+  // readers in this or other processes observe either the previous or the new
+  // contents, never a partial write.
   ErrorObject write(const std::string &content) {
-    std::ofstream file(path, std::ios::out | std::ios::binary);
-    FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
-                            "Failed to open file: " + path.string());
+    return write(std::span(reinterpret_cast<const uint8_t *>(content.data()),
+                           content.size()));
+  }
 
-    file << content;
-    FUSILLI_RETURN_ERROR_IF(!file.good(), ErrorCode::FileSystemFailure,
-                            "Failed to write to file: " + path.string());
+  // Overload of the above for binary contents.
+  ErrorObject write(std::span<const uint8_t> bytes) {
+    std::filesystem::path tempPath = getTempPath(path);
+    {
+      std::ofstream file(tempPath, std::ios::out | std::ios::binary);
+      FUSILLI_RETURN_ERROR_IF(!file.is_open(), ErrorCode::FileSystemFailure,
+                              "Failed to open file: " + tempPath.string());
+
+      file.write(reinterpret_cast<const char *>(bytes.data()),
+                 static_cast<std::streamsize>(bytes.size()));
+      file.close();
+      if (!file.good()) {
+        std::filesystem::remove(tempPath);
+        return error(ErrorCode::FileSystemFailure,
+                     "Failed to write to file: " + path.string());
+      }
+    }
 
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+      std::filesystem::remove(tempPath);
+      return error(ErrorCode::FileSystemFailure,
+                   "Failed to write to file: " + path.string() + " - " +
+                       ec.message());
+    }
     return ok();
   }
 
@@ -237,6 +391,14 @@ public:
     FUSILLI_RETURN_ERROR_IF(!file.good(), ErrorCode::FileSystemFailure,
                             "Failed to read file: " + path.string());
 
+    // Files published compressed are returned decompressed.
+    std::span<const uint8_t> bytes(
+        reinterpret_cast<const uint8_t *>(buffer.data()), buffer.size());
+    if (isCompressedArtifact(bytes)) {
+      FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> decompressed,
+                               decompressArtifact(bytes));
+      return ok(std::string(decompressed.begin(), decompressed.end()));
+    }
     return ok(buffer);
   }
 
@@ -269,6 +431,16 @@ readFileBytes(const std::filesystem::path &path) {
   return ok(std::move(buffer));
 }
 
+// Reads the artifact at `path` like `readFileBytes()`, decompressing it if it
+// was stored compressed (see `isCompressedArtifact()`).
+inline ErrorOr<std::vector<uint8_t>>
+readArtifactBytes(const std::filesystem::path &path) {
+  FUSILLI_ASSIGN_OR_RETURN(std::vector<uint8_t> bytes, readFileBytes(path));
+  if (!isCompressedArtifact(bytes))
+    return ok(std::move(bytes));
+  return decompressArtifact(bytes);
+}
+
 // CleanupCacheDirectory removes a sub-directory from the main cache directory
 // if it's empty. When used as a base class, C++ destructor ordering (explained
 // below) ensures that the directory cleanup in CleanupCacheDirectory destructor
@@ -309,27 +481,47 @@ enum class CachedAssetsType : uint8_t {
   Output,
   Command,
   Statistics,
+  Digest,
 };
 
 // Holds cached assets. If `CacheFiles` are set to be removed RAII based removal
 // will be tied to the lifetime of this object.
+//
+// Only `output` is always present. The assets to inspect and reproduce the
+// compilation are only written by the diagnostic compile profile (see
+// `CompileProfile`), and are either all present or all absent.
 struct CachedAssets : CleanupCacheDirectory {
-  CacheFile input;
   CacheFile output;
-  CacheFile command;
-  CacheFile statistics;
+  // Kernel cache key (see `Graph::getKernelCacheKey()`) of the inputs that
+  // produced `output`, used for cheap cache validation.
+  std::string key;
+  std::optional<CacheFile> input;
+  std::optional<CacheFile> command;
+  std::optional<CacheFile> statistics;
+  // Sidecar holding `key`, so the assets can be validated by other processes.
+  std::optional<CacheFile> digest;
+
+  // Assets written by the production compile profile.
+  CachedAssets(CacheFile &&out, std::string cacheKey)
+      : CleanupCacheDirectory(out.path.parent_path()), output(std::move(out)),
+        key(std::move(cacheKey)) {
+    assert(std::filesystem::is_directory(output.path.parent_path()));
+  }
 
+  // Assets written by the diagnostic compile profile.
   CachedAssets(CacheFile &&in, CacheFile &&out, CacheFile &&cmd,
-               CacheFile &&stats)
-      : CleanupCacheDirectory(in.path.parent_path()), input(std::move(in)),
-        output(std::move(out)), command(std::move(cmd)),
-        statistics(std::move(stats)) {
+               CacheFile &&stats, CacheFile &&dgst, std::string cacheKey)
+      : CleanupCacheDirectory(in.path.parent_path()), output(std::move(out)),
+        key(std::move(cacheKey)), input(std::move(in)),
+        command(std::move(cmd)), statistics(std::move(stats)),
+        digest(std::move(dgst)) {
     // sanity checks:
-    assert(input.path.parent_path() == output.path.parent_path() &&
-           input.path.parent_path() == command.path.parent_path() &&
-           input.path.parent_path() == statistics.path.parent_path() &&
+    assert(input->path.parent_path() == output.path.parent_path() &&
+           input->path.parent_path() == command->path.parent_path() &&
+           input->path.parent_path() == statistics->path.parent_path() &&
+           input->path.parent_path() == digest->path.parent_path() &&
            "Cached assets should be in the same directory.");
-    assert(std::filesystem::is_directory(input.path.parent_path()));
+    assert(std::filesystem::is_directory(input->path.parent_path()));
   }
 
   // Default move constructors + destructor.
@@ -0,0 +1,167 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the optional zstd compression of stored artifacts (kernel
+// cache entries and artifact bundles), available when built with
+// `-DFUSILLI_ENABLE_ZSTD=ON`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_COMPRESSION_H
+#define FUSILLI_SUPPORT_COMPRESSION_H
+
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifdef FUSILLI_ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace fusilli {
+
+// Compressed artifacts are zstd frames. They are told apart from VMFBs (and
+// any other stored file) by the frame magic, so compressed and uncompressed
+// artifacts can be mixed freely and need no separate format version.
+inline constexpr uint8_t kZstdFrameMagic[4] = {0x28, 0xB5, 0x2F, 0xFD};
+
+// Returns whether `bytes` hold a compressed artifact.
+inline bool isCompressedArtifact(std::span<const uint8_t> bytes) {
+  return bytes.size() >= sizeof(kZstdFrameMagic) &&
+         std::equal(std::begin(kZstdFrameMagic), std::end(kZstdFrameMagic),
+                    bytes.begin());
+}
+
+// Returns whether this build of fusilli can compress and decompress artifacts.
+inline constexpr bool isArtifactCompressionAvailable() {
+#ifdef FUSILLI_ENABLE_ZSTD
+  return true;
+#else
+  return false;
+#endif
+}
+
+// zstd level at which artifacts are compressed when stored, or std::nullopt
+// to store them uncompressed (the default). Initialized from
+// `FUSILLI_CACHE_COMPRESSION_LEVEL` (e.g. "3", or up to "19" for the smallest
+// artifacts at the cost of compile time); assign to it to override the
+// environment. Compressed artifacts are always readable, whatever the level.
+inline std::optional<int> &getArtifactCompressionLevel() {
+  static std::optional<int> level = []() -> std::optional<int> {
+    const char *envVal = std::getenv("FUSILLI_CACHE_COMPRESSION_LEVEL");
+    if (!envVal || std::string(envVal).empty())
+      return std::nullopt;
+    std::string str(envVal);
+    int parsed = 0;
+    auto [ptr, errc] =
+        std::from_chars(str.data(), str.data() + str.size(), parsed);
+    if (errc != std::errc() || ptr != str.data() + str.size()) {
+      FUSILLI_LOG_LABEL_ENDL(
+          "WARNING: Ignoring invalid FUSILLI_CACHE_COMPRESSION_LEVEL="
+          << envVal);
+      return std::nullopt;
+    }
+    if (!isArtifactCompressionAvailable()) {
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Ignoring "
+                             "FUSILLI_CACHE_COMPRESSION_LEVEL, fusilli was "
+                             "built without zstd (FUSILLI_ENABLE_ZSTD)");
+      return std::nullopt;
+    }
+    return parsed;
+  }();
+  return level;
+}
+
+// Compresses `bytes` into a single zstd frame at `level`.
+inline ErrorOr<std::vector<uint8_t>>
+compressArtifact(std::span<const uint8_t> bytes, int level) {
+#ifdef FUSILLI_ENABLE_ZSTD
+  std::vector<uint8_t> compressed(ZSTD_compressBound(bytes.size()));
+  size_t size = ZSTD_compress(compressed.data(), compressed.size(),
+                              bytes.data(), bytes.size(), level);
+  FUSILLI_RETURN_ERROR_IF(ZSTD_isError(size), ErrorCode::RuntimeFailure,
+                          std::string("Failed to compress artifact: ") +
+                              ZSTD_getErrorName(size));
+  compressed.resize(size);
+  compressed.shrink_to_fit();
+  return ok(std::move(compressed));
+#else
+  (void)bytes;
+  (void)level;
+  return error(ErrorCode::NotImplemented,
+               "Artifact compression requires building with "
+               "FUSILLI_ENABLE_ZSTD");
+#endif
+}
+
+// Decompresses the compressed artifact `bytes` (see `isCompressedArtifact()`).
+// The frames are decoded in a streaming fashion straight into the returned
+// buffer, sized up front from the frame header, so `bytes` may be a mapping
+// of the file that is only paged in as it is consumed.
+inline ErrorOr<std::vector<uint8_t>>
+decompressArtifact(std::span<const uint8_t> bytes) {
+#ifdef FUSILLI_ENABLE_ZSTD
+  std::vector<uint8_t> decompressed;
+  unsigned long long contentSize =
+      ZSTD_getFrameContentSize(bytes.data(), bytes.size());
+  FUSILLI_RETURN_ERROR_IF(contentSize == ZSTD_CONTENTSIZE_ERROR,
+                          ErrorCode::InvalidArgument,
+                          "Corrupt compressed artifact");
+  if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN)
+    decompressed.resize(static_cast<size_t>(contentSize));
+
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(
+      ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  FUSILLI_RETURN_ERROR_IF(!context, ErrorCode::RuntimeFailure,
+                          "Failed to create zstd decompression context");
+  ZSTD_inBuffer input = {bytes.data(), bytes.size(), 0};
+  ZSTD_outBuffer output = {decompressed.data(), decompressed.size(), 0};
+  // A non-zero status means the current frame still has data to flush.
+  size_t status = 0;
+  while (input.pos < input.size || status != 0) {
+    // Grow the buffer for frames without a content size (or concatenated
+    // frames), keeping what was decoded so far.
+    if (output.pos == output.size) {
+      decompressed.resize(decompressed.size() + ZSTD_DStreamOutSize());
+      output.dst = decompressed.data();
+      output.size = decompressed.size();
+    }
+    size_t consumed = input.pos;
+    size_t produced = output.pos;
+    status = ZSTD_decompressStream(context.get(), &output, &input);
+    FUSILLI_RETURN_ERROR_IF(ZSTD_isError(status), ErrorCode::InvalidArgument,
+                            std::string("Failed to decompress artifact: ") +
+                                ZSTD_getErrorName(status));
+    FUSILLI_RETURN_ERROR_IF(input.pos == consumed && output.pos == produced,
+                            ErrorCode::InvalidArgument,
+                            "Truncated compressed artifact");
+  }
+  decompressed.resize(output.pos);
+  return ok(std::move(decompressed));
+#else
+  (void)bytes;
+  return error(ErrorCode::NotImplemented,
+               "Decompressing a compressed artifact requires building with "
+               "FUSILLI_ENABLE_ZSTD");
+#endif
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_COMPRESSION_H
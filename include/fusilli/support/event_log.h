@@ -0,0 +1,368 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the binary event log of Fusilli: a process-wide ring
+// buffer of fixed-size records, one per validation, compilation or execution
+// of a graph, with its start time, duration, graph fingerprint, shape and
+// error code.
+//
+// Unlike text logging (see `fusilli/support/logging.h`), recording an event
+// formats nothing and writes nothing to disk: it fills one 64-byte slot of an
+// in-memory ring, overwriting the oldest events once the ring is full. This
+// keeps diagnostics cheap enough to leave on in production.
+//
+// The log is enabled by setting `FUSILLI_EVENT_LOG` to a file path, where it
+// is written at process exit (or on `EventLog::write()`). The ring holds
+// `FUSILLI_EVENT_LOG_CAPACITY` events (65536, i.e. 4 MiB, by default). The
+// `fusilli_event_log_dump` tool prints a written log as text.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_EVENT_LOG_H
+#define FUSILLI_SUPPORT_EVENT_LOG_H
+
+#include "fusilli/support/logging.h"
+#include "fusilli/support/target_platform.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// What an event record covers.
+enum class EventPhase : uint8_t {
+  Validate,     // `Graph::validate()`
+  Compile,      // `Graph::compile()`
+  Execute,      // `Graph::execute()` and `Graph::executeTimed()`
+  ExecuteAsync, // `Graph::executeAsync()`
+  PlanRun,      // `ExecutionPlan::run()`
+};
+
+inline constexpr std::array<std::string_view, 5> kEventPhaseToStr = {
+    "validate", "compile", "execute", "execute_async", "plan_run",
+};
+
+// Maximum number of dims recorded per event. Higher ranks keep their
+// innermost dims.
+inline constexpr size_t kEventMaxDims = 4;
+
+// One event of the log, written to disk as is (in native byte order).
+struct EventRecord {
+  // Start of the phase in nanoseconds since the Unix epoch, and its length.
+  uint64_t startNs = 0;
+  uint64_t durationNs = 0;
+  // Structural fingerprint of the graph (see `Graph::getFingerprint()`).
+  uint64_t fingerprint = 0;
+  // Dims of the graph's first argument (its first output in name order),
+  // see `kEventMaxDims`.
+  std::array<int64_t, kEventMaxDims> dims = {};
+  // Hash of the recording thread's id, to tell threads apart.
+  uint32_t thread = 0;
+  EventPhase phase = EventPhase::Validate;
+  // First error returned through the error macros while the phase ran, even
+  // if it was handled, or `ErrorCode::OK`.
+  ErrorCode code = ErrorCode::OK;
+  uint8_t rank = 0;
+  uint8_t reserved = 0;
+};
+static_assert(sizeof(EventRecord) == 64);
+
+// What a graph contributes to its events, computed once by `validate()` so
+// that recording an event does not touch the graph's tensors.
+struct EventTag {
+  uint64_t fingerprint = 0;
+  std::array<int64_t, kEventMaxDims> dims = {};
+  uint8_t rank = 0;
+
+  // `fingerprint` as the hex digest returned by `Graph::getFingerprint()`.
+  static EventTag of(std::string_view fingerprint,
+                     const std::vector<int64_t> &dims) {
+    EventTag tag;
+    (void)std::from_chars(fingerprint.data(),
+                          fingerprint.data() + fingerprint.size(),
+                          tag.fingerprint, 16);
+    tag.rank = static_cast<uint8_t>(dims.size());
+    size_t kept = std::min(dims.size(), kEventMaxDims);
+    std::copy(dims.end() - static_cast<std::ptrdiff_t>(kept), dims.end(),
+              tag.dims.begin());
+    return tag;
+  }
+};
+
+// Header of an event log file, followed by the events oldest first.
+struct EventLogHeader {
+  std::array<char, 8> magic = {'F', 'U', 'S', 'I', 'E', 'V', 'T', '1'};
+  uint32_t recordSize = sizeof(EventRecord);
+  uint32_t reserved = 0;
+  // Events recorded since the log was enabled, including those overwritten
+  // in the ring.
+  uint64_t recorded = 0;
+  uint64_t count = 0;
+};
+
+// Contents of an event log file read by `EventLog::read()`.
+struct EventLogContents {
+  uint64_t recorded = 0;
+  std::vector<EventRecord> events;
+};
+
+// Process-wide ring of events. `record()` may be called from any thread;
+// `enable()` and `disable()` must not race with it.
+class EventLog {
+public:
+  inline static constexpr size_t kDefaultCapacity = 65536;
+
+  // The log of the process, enabled from `FUSILLI_EVENT_LOG` and
+  // `FUSILLI_EVENT_LOG_CAPACITY` on first use.
+  static EventLog &get() {
+    static EventLog log;
+    return log;
+  }
+
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // Clears the log and starts recording into a ring of `capacity` events.
+  void enable(size_t capacity = kDefaultCapacity) {
+    capacity_ = std::max<size_t>(capacity, 1);
+    ring_ = std::make_unique<EventRecord[]>(capacity_);
+    next_.store(0, std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_relaxed);
+  }
+
+  // Stops recording. Recorded events are kept until the next `enable()`.
+  void disable() { enabled_.store(false, std::memory_order_relaxed); }
+
+  void record(const EventRecord &event) {
+    if (!isEnabled())
+      return;
+    uint64_t slot = next_.fetch_add(1, std::memory_order_relaxed);
+    ring_[slot % capacity_] = event;
+  }
+
+  // Events recorded since the log was enabled, including overwritten ones.
+  uint64_t getRecordedCount() const {
+    return next_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the events still in the ring, oldest first.
+  std::vector<EventRecord> getEvents() const {
+    uint64_t recorded = getRecordedCount();
+    if (!ring_)
+      return {};
+    uint64_t count = std::min<uint64_t>(recorded, capacity_);
+    std::vector<EventRecord> events;
+    events.reserve(count);
+    for (uint64_t i = recorded - count; i < recorded; ++i)
+      events.push_back(ring_[i % capacity_]);
+    return events;
+  }
+
+  // Writes the events still in the ring to `path`, see `read()`.
+  ErrorObject write(const std::filesystem::path &path) const {
+    std::vector<EventRecord> events = getEvents();
+    EventLogHeader header;
+    header.recorded = getRecordedCount();
+    header.count = events.size();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    FUSILLI_RETURN_ERROR_IF(!file, ErrorCode::FileSystemFailure,
+                            "Failed to open event log: " + path.string());
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(events.data()),
+               static_cast<std::streamsize>(events.size() *
+                                            sizeof(EventRecord)));
+    FUSILLI_RETURN_ERROR_IF(!file, ErrorCode::FileSystemFailure,
+                            "Failed to write event log: " + path.string());
+    return ok();
+  }
+
+  // Reads an event log written by `write()` on a machine of the same byte
+  // order.
+  static ErrorOr<EventLogContents> read(const std::filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    FUSILLI_RETURN_ERROR_IF(!file, ErrorCode::FileSystemFailure,
+                            "Failed to open event log: " + path.string());
+    EventLogHeader header;
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    FUSILLI_RETURN_ERROR_IF(!file || header.magic != EventLogHeader().magic ||
+                                header.recordSize != sizeof(EventRecord),
+                            ErrorCode::InvalidArgument,
+                            "Not a Fusilli event log: " + path.string());
+    EventLogContents contents;
+    contents.recorded = header.recorded;
+    contents.events.resize(header.count);
+    file.read(reinterpret_cast<char *>(contents.events.data()),
+              static_cast<std::streamsize>(header.count *
+                                           sizeof(EventRecord)));
+    FUSILLI_RETURN_ERROR_IF(!file, ErrorCode::InvalidArgument,
+                            "Truncated event log: " + path.string());
+    return ok(std::move(contents));
+  }
+
+  // Formats `event` as one line of text, e.g.
+  //   2026-10-15T09:30:12.123456Z thread=1a2b3c4d execute
+  //   fingerprint=0123456789abcdef dims=[16,128,128] 12.5us OK
+  // (on one line).
+  static std::string format(const EventRecord &event) {
+    std::ostringstream os;
+    auto seconds = static_cast<std::time_t>(event.startNs / 1000000000);
+    std::tm utc{};
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    os << std::put_time(&utc, "%Y-%m-%dT%H:%M:%S") << '.' << std::setfill('0')
+       << std::setw(6) << (event.startNs % 1000000000) / 1000 << "Z"
+       << std::setfill(' ') << " thread=" << std::hex << std::setw(8)
+       << std::setfill('0') << event.thread << ' ';
+    auto phase = static_cast<size_t>(event.phase);
+    if (phase < kEventPhaseToStr.size())
+      os << kEventPhaseToStr[phase];
+    else
+      os << "unknown_phase";
+    os << " fingerprint=" << std::setw(16) << event.fingerprint << std::dec
+       << std::setfill(' ') << " dims=[";
+    size_t kept = std::min<size_t>(event.rank, kEventMaxDims);
+    if (kept < event.rank)
+      os << "...,";
+    for (size_t i = 0; i < kept; ++i)
+      os << (i ? "," : "") << event.dims[i];
+    os << "] " << std::fixed << std::setprecision(1)
+       << static_cast<double>(event.durationNs) / 1000.0 << "us "
+       << event.code;
+    return os.str();
+  }
+
+  EventLog(const EventLog &) = delete;
+  EventLog &operator=(const EventLog &) = delete;
+
+private:
+  EventLog() {
+    const char *path = std::getenv("FUSILLI_EVENT_LOG");
+    if (!path || *path == '\0')
+      return;
+    path_ = path;
+    size_t capacity = kDefaultCapacity;
+    if (const char *envVal = std::getenv("FUSILLI_EVENT_LOG_CAPACITY")) {
+      const char *end = envVal + std::strlen(envVal);
+      auto [ptr, errc] = std::from_chars(envVal, end, capacity);
+      if (errc != std::errc() || ptr != end || capacity == 0)
+        capacity = kDefaultCapacity;
+    }
+    enable(capacity);
+  }
+
+  // Writes the log to `FUSILLI_EVENT_LOG` at process exit.
+  ~EventLog() {
+    if (path_.empty())
+      return;
+    ErrorObject status = write(path_);
+    if (isError(status))
+      std::cerr << "[FUSILLI] " << status << std::endl;
+  }
+
+  std::atomic<bool> enabled_{false};
+  size_t capacity_ = 0;
+  std::unique_ptr<EventRecord[]> ring_;
+  std::atomic<uint64_t> next_{0};
+  std::filesystem::path path_;
+};
+
+namespace detail {
+
+// Records an event of `phase` for the graph tagged `tag` spanning the
+// enclosing scope, when the event log is enabled. The tag is read when the
+// scope ends, so the tag of a graph being validated is already up to date.
+class EventScope {
+public:
+  EventScope(EventPhase phase, const EventTag &tag)
+      : tag_(EventLog::get().isEnabled() ? &tag : nullptr), phase_(phase) {
+    if (!tag_)
+      return;
+    outerError_ = std::exchange(pendingEventError(), ErrorCode::OK);
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  ~EventScope() {
+    if (!tag_)
+      return;
+    auto end = std::chrono::steady_clock::now();
+    ErrorCode code = pendingEventError();
+    EventRecord event;
+    event.startNs = toUnixNs(start_);
+    event.durationNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+            .count());
+    event.fingerprint = tag_->fingerprint;
+    event.dims = tag_->dims;
+    event.rank = tag_->rank;
+    event.thread = threadHash();
+    event.phase = phase_;
+    event.code = code;
+    EventLog::get().record(event);
+    // An error of this phase is usually returned from the enclosing one too.
+    pendingEventError() = outerError_ != ErrorCode::OK ? outerError_ : code;
+  }
+
+  EventScope(const EventScope &) = delete;
+  EventScope &operator=(const EventScope &) = delete;
+
+private:
+  // Converts a steady clock time point to wall time, through the offset
+  // between both clocks sampled once.
+  static uint64_t toUnixNs(std::chrono::steady_clock::time_point time) {
+    static const std::chrono::nanoseconds offset =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()) -
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+    return static_cast<uint64_t>(
+        (std::chrono::duration_cast<std::chrono::nanoseconds>(
+             time.time_since_epoch()) +
+         offset)
+            .count());
+  }
+
+  static uint32_t threadHash() {
+    thread_local uint32_t hash = static_cast<uint32_t>(
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    return hash;
+  }
+
+  const EventTag *tag_;
+  EventPhase phase_;
+  ErrorCode outerError_ = ErrorCode::OK;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace detail
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_EVENT_LOG_H
@@ -90,6 +90,8 @@ inline bool needsShellQuoting(const std::string &arg) {
 #endif
     case ' ':
     case '\t':
+    case '\n':
+    case '\r':
     case '"':
     case '(':
     case ')':
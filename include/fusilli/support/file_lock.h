@@ -0,0 +1,186 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file provides a cross-platform, cross-process exclusive file lock.
+//
+// The FileLock class holds an advisory lock on a lock file for as long as it
+// is alive, and removes the lock file (and its directory, if left empty) when
+// released so lock files never accumulate in the cache directory. The
+// implementation is selected at compile time based on the target platform:
+// - Linux (glibc) systems: Uses open/flock
+// - Windows: Uses CreateFile (delete on close)/LockFileEx
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_FILE_LOCK_H
+#define FUSILLI_SUPPORT_FILE_LOCK_H
+
+#include "fusilli/support/logging.h"
+#include "fusilli/support/target_platform.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fusilli {
+
+// FileLock is an exclusive lock shared between processes (and threads) that
+// agree on the path of a lock file. It is used to serialize compilation of
+// the same graph across processes sharing a cache directory, e.g. ranks of a
+// distributed job that all compile the same kernels at startup.
+//
+// Usage:
+//   {
+//     FUSILLI_ASSIGN_OR_RETURN(FileLock lock, FileLock::acquire(path));
+//     // ... exclusive access ...
+//   } // Released (and lock file removed) here.
+//
+class FileLock {
+public:
+  // Blocks until the lock at `path` is acquired, creating the lock file and
+  // its parent directories if needed.
+  static ErrorOr<FileLock> acquire(const std::filesystem::path &path) {
+    for (size_t attempt = 0;; ++attempt) {
+      // The directory is re-created on every attempt, as the previous holder
+      // removes it when it is left empty (see `release()`). That may also
+      // race with creating it, so failures are retried a few times.
+      std::error_code ec;
+      std::filesystem::create_directories(path.parent_path(), ec);
+      if (ec) {
+        FUSILLI_RETURN_ERROR_IF(attempt >= kMaxCreateDirectoryAttempts,
+                                ErrorCode::FileSystemFailure,
+                                "Failed to create lock file directory: " +
+                                    path.parent_path().string() + " - " +
+                                    ec.message());
+        continue;
+      }
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+      // The lock file is deleted once its last handle closes. Opening it
+      // fails while a released lock file is pending deletion, so retry.
+      HANDLE handle = CreateFileW(
+          path.c_str(), GENERIC_READ | GENERIC_WRITE,
+          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+          OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_DELETE_ON_CLOSE,
+          nullptr);
+      if (handle == INVALID_HANDLE_VALUE) {
+        DWORD lastError = GetLastError();
+        FUSILLI_RETURN_ERROR_IF(lastError != ERROR_ACCESS_DENIED &&
+                                    lastError != ERROR_PATH_NOT_FOUND,
+                                ErrorCode::FileSystemFailure,
+                                "Failed to open lock file: " + path.string());
+        Sleep(1);
+        continue;
+      }
+      OVERLAPPED overlapped = {};
+      if (!LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD,
+                      &overlapped)) {
+        CloseHandle(handle);
+        return error(ErrorCode::FileSystemFailure,
+                     "Failed to lock file: " + path.string());
+      }
+      return ok(FileLock(handle, path));
+#else
+      int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+      if (fd < 0 && errno == ENOENT)
+        continue;
+      FUSILLI_RETURN_ERROR_IF(fd < 0, ErrorCode::FileSystemFailure,
+                              "Failed to open lock file: " + path.string());
+      if (flock(fd, LOCK_EX) != 0) {
+        ::close(fd);
+        return error(ErrorCode::FileSystemFailure,
+                     "Failed to lock file: " + path.string());
+      }
+      // The previous holder removes the lock file when releasing it, so we may
+      // have locked a file that no longer exists at `path` (or that has been
+      // replaced by a new one). The lock is only held if `path` still refers
+      // to the file we locked.
+      struct stat fdStat, pathStat;
+      if (fstat(fd, &fdStat) == 0 && ::stat(path.c_str(), &pathStat) == 0 &&
+          fdStat.st_dev == pathStat.st_dev && fdStat.st_ino == pathStat.st_ino)
+        return ok(FileLock(fd, path));
+      ::close(fd);
+#endif
+    }
+  }
+
+  // Non-copyable.
+  FileLock(const FileLock &) = delete;
+  FileLock &operator=(const FileLock &) = delete;
+
+  // Movable.
+  FileLock(FileLock &&other) noexcept
+      : handle_(std::exchange(other.handle_, kInvalidHandle)),
+        path_(std::move(other.path_)) {}
+
+  FileLock &operator=(FileLock &&other) noexcept {
+    if (this != &other) {
+      release();
+      handle_ = std::exchange(other.handle_, kInvalidHandle);
+      path_ = std::move(other.path_);
+    }
+    return *this;
+  }
+
+  ~FileLock() { release(); }
+
+  // Returns the path of the lock file.
+  const std::filesystem::path &getPath() const { return path_; }
+
+private:
+  static constexpr size_t kMaxCreateDirectoryAttempts = 100;
+
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+  using NativeHandle = HANDLE;
+  static inline const NativeHandle kInvalidHandle = INVALID_HANDLE_VALUE;
+#else
+  using NativeHandle = int;
+  static constexpr NativeHandle kInvalidHandle = -1;
+#endif
+
+  // Class should be constructed using the `acquire()` factory function.
+  FileLock(NativeHandle handle, std::filesystem::path path)
+      : handle_(handle), path_(std::move(path)) {}
+
+  void release() {
+    if (handle_ == kInvalidHandle)
+      return;
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+    OVERLAPPED overlapped = {};
+    UnlockFileEx(handle_, 0, MAXDWORD, MAXDWORD, &overlapped);
+    CloseHandle(handle_);
+#else
+    // Remove the lock file while still holding the lock, so waiters that
+    // locked the removed file notice and retry (see `acquire()`).
+    ::unlink(path_.c_str());
+    ::close(handle_);
+#endif
+    handle_ = kInvalidHandle;
+    // Only removes the directory if it is empty.
+    std::error_code ec;
+    std::filesystem::remove(path_.parent_path(), ec);
+  }
+
+  NativeHandle handle_ = kInvalidHandle;
+  std::filesystem::path path_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_FILE_LOCK_H
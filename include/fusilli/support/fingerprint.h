@@ -0,0 +1,125 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the `Fingerprinter` used to compute structural graph
+// fingerprints for cache lookups that don't require emitting MLIR assembly.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_FINGERPRINT_H
+#define FUSILLI_SUPPORT_FINGERPRINT_H
+
+#include "fusilli/attributes/tensor_attributes.h"
+#include "fusilli/support/hash.h"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace fusilli {
+
+// Accumulates a structural fingerprint of a graph: everything that determines
+// the compiled artifact, without having to emit MLIR assembly. Nodes mix in
+// their type, attributes and tensors through `INode::hashNode`.
+//
+// Tensors are identified by the order in which they are first seen, so the
+// fingerprint captures how nodes are connected in addition to what each tensor
+// looks like. Node and tensor names are deliberately left out: they only
+// surface as SSA value names in the emitted assembly, so graphs that differ
+// only in names compile to interchangeable artifacts.
+class Fingerprinter {
+public:
+  Fingerprinter &update(std::string_view str) {
+    hasher_.update(str);
+    return *this;
+  }
+
+  template <typename T>
+    requires std::integral<T> || std::is_enum_v<T> // C++20
+  Fingerprinter &update(T value) {
+    hasher_.update(value);
+    return *this;
+  }
+
+  Fingerprinter &update(float value) {
+    return update(std::bit_cast<uint32_t>(value)); // C++20
+  }
+
+  Fingerprinter &update(double value) {
+    return update(std::bit_cast<uint64_t>(value)); // C++20
+  }
+
+  template <typename T> Fingerprinter &update(const std::vector<T> &values) {
+    update(values.size());
+    for (const auto &value : values)
+      update(value);
+    return *this;
+  }
+
+  // Mixes in a (possibly null) tensor. The first time a tensor is seen its
+  // structural properties are hashed, subsequent references only hash its id.
+  Fingerprinter &tensor(const std::shared_ptr<TensorAttr> &t) {
+    if (!t)
+      return update(uint8_t{0});
+    auto [it, inserted] = tensorIds_.try_emplace(t.get(), tensorIds_.size());
+    update(uint8_t{1}).update(it->second);
+    if (!inserted)
+      return *this;
+    update(t->getDataType())
+        .update(t->getDim())
+        .update(t->getStride())
+        .update(t->getDynamicDims())
+        .update(t->isVirtual())
+        .update(t->isScalar())
+        .update(t->isRuntimeScalar())
+        .update(t->isConstant());
+    update(t->getDynamicDimHints().size());
+    for (const auto &[index, hint] : t->getDynamicDimHints())
+      update(index).update(hint.min).update(hint.max).update(hint.divisor);
+    tensor(t->getInPlace());
+    // Alignments select compiler flags, see `Graph::getBufferAlignment()`.
+    update(t->getAlignment());
+    // Blocked layouts change the function signature.
+    update(t->isBlocked());
+    if (const auto &layout = t->getBlockedLayout())
+      update(layout->dim).update(layout->blockSize);
+    // Constant data is embedded in the emitted assembly.
+    update(t->hasConstantData());
+    if (const auto &data = t->getConstantData())
+      update(std::string_view(reinterpret_cast<const char *>(data->data()),
+                              data->size()));
+    // Parameters are referenced by name.
+    update(t->getParameterKey()).update(t->getParameterScope());
+    // The value of a runtime scalar is bound at execution.
+    if (std::optional<TensorAttr::scalar_t> value = t->getScalarValue();
+        value.has_value() && !t->isRuntimeScalar()) {
+      update(value->index());
+      std::visit([&](auto v) { update(v); }, *value);
+    }
+    return *this;
+  }
+
+  std::string hexDigest() const { return hasher_.hexDigest(); }
+
+private:
+  Hasher hasher_;
+  std::unordered_map<const TensorAttr *, size_t> tensorIds_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_FINGERPRINT_H
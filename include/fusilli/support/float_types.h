@@ -7,8 +7,9 @@
 //===----------------------------------------------------------------------===//
 //
 // This file contains portable Float16 and BFloat16 implementations represented
-// as structs with uint16_t storage. These types support conversion to/from
-// float and perform arithmetic operations in 32-bit float precision.
+// as structs with uint16_t storage, and the FP8 formats with uint8_t storage.
+// These types support conversion to/from float and perform arithmetic
+// operations in 32-bit float precision.
 //
 //===----------------------------------------------------------------------===//
 
@@ -19,7 +20,13 @@
 
 #include <iree/base/internal/math.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
 
 namespace fusilli {
 
@@ -86,6 +93,63 @@ struct BFloat16 {
   [[nodiscard]] constexpr uint16_t toBits() const { return data; }
 };
 
+// 8-bit floating point (FP8) formats.
+// E5M2 and E4M3FN are the OCP formats, the FNUZ variants (no negative zero,
+// NaN encoded as 0x80) are the native FP8 formats of gfx942 (MI300).
+enum class Float8Format : uint8_t { E5M2, E4M3FN, E5M2FNUZ, E4M3FNUZ };
+
+// FP8 value of format `F` with uint8_t storage. Conversions from float round
+// to nearest even.
+//
+// Like Float16, this type provides implicit conversions to/from float and
+// performs all operations in float precision through these conversions.
+template <Float8Format F> struct Float8 {
+  uint8_t data = 0;
+
+  constexpr Float8() {}
+
+  // Construct from float (handles double via implicit conversion)
+  Float8(float f) {
+    if constexpr (F == Float8Format::E5M2)
+      data = iree_math_f32_to_f8e5m2(f);
+    else if constexpr (F == Float8Format::E4M3FN)
+      data = iree_math_f32_to_f8e4m3fn(f);
+    else if constexpr (F == Float8Format::E5M2FNUZ)
+      data = iree_math_f32_to_f8e5m2fnuz(f);
+    else
+      data = iree_math_f32_to_f8e4m3fnuz(f);
+  }
+
+  // Convert to float
+  [[nodiscard]] float toFloat() const {
+    if constexpr (F == Float8Format::E5M2)
+      return iree_math_f8e5m2_to_f32(data);
+    else if constexpr (F == Float8Format::E4M3FN)
+      return iree_math_f8e4m3fn_to_f32(data);
+    else if constexpr (F == Float8Format::E5M2FNUZ)
+      return iree_math_f8e5m2fnuz_to_f32(data);
+    else
+      return iree_math_f8e4m3fnuz_to_f32(data);
+  }
+
+  // Implicit conversion to float for seamless interoperability
+  [[nodiscard]] operator float() const { return toFloat(); }
+
+  [[nodiscard]] static constexpr Float8 fromBits(uint8_t bits) {
+    Float8 result;
+    result.data = bits;
+    return result;
+  }
+
+  // Get raw bits
+  [[nodiscard]] constexpr uint8_t toBits() const { return data; }
+};
+
+using fp8e5m2 = Float8<Float8Format::E5M2>;
+using fp8e4m3fn = Float8<Float8Format::E4M3FN>;
+using fp8e5m2fnuz = Float8<Float8Format::E5M2FNUZ>;
+using fp8e4m3fnuz = Float8<Float8Format::E4M3FNUZ>;
+
 // Half precision floating point types.
 // On Windows, use portable struct implementations with uint16_t storage.
 // On other platforms, use compiler extensions for native support.
@@ -102,6 +166,118 @@ using half = _Float16;
 using bf16 = __bf16;
 #endif
 
+// Storage of `half` and `bf16` is the 16-bit pattern, so arrays of them are
+// converted as 16-bit lanes by the bulk conversion kernels below.
+static_assert(sizeof(half) == 2 && sizeof(bf16) == 2);
+
+namespace detail {
+
+// SIMD prefixes of the bulk conversions, selected at compile time from the
+// target ISA (e.g. `-march=native` or `-mf16c`). Each returns the number of
+// elements converted, leaving the tail to the scalar conversions. All round
+// to nearest even, like the scalar conversions.
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+inline size_t convertF32ToF16Simd(const float *src, size_t count, void *dst) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(
+                         static_cast<uint16_t *>(dst) + i),
+                     h);
+  }
+  return i;
+}
+
+inline size_t convertF16ToF32Simd(const void *src, size_t count, float *dst) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+        static_cast<const uint16_t *>(src) + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+  return i;
+}
+#else
+inline size_t convertF32ToF16Simd(const float *, size_t, void *) { return 0; }
+inline size_t convertF16ToF32Simd(const void *, size_t, float *) { return 0; }
+#endif
+
+#if defined(__AVX512BF16__)
+inline size_t convertF32ToBF16Simd(const float *src, size_t count, void *dst) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256bh b = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(
+                            static_cast<uint16_t *>(dst) + i),
+                        reinterpret_cast<__m256i &>(b));
+  }
+  return i;
+}
+#else
+inline size_t convertF32ToBF16Simd(const float *, size_t, void *) { return 0; }
+#endif
+
+// Widening bf16 to f32 places the 16 bits in the high half of each lane.
+#if defined(__SSE2__) || defined(_M_X64)
+inline size_t convertBF16ToF32Simd(const void *src, size_t count, float *dst) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+        static_cast<const uint16_t *>(src) + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_unpacklo_epi16(zero, b));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4),
+                     _mm_unpackhi_epi16(zero, b));
+  }
+  return i;
+}
+#else
+inline size_t convertBF16ToF32Simd(const void *, size_t, float *) { return 0; }
+#endif
+
+} // namespace detail
+
+// Bulk conversions between f32 and `half` / `bf16` arrays, e.g. to build
+// `Buffer::allocate` inputs or check outputs. `src` and `dst` must have the
+// same size; returns false (converting nothing) otherwise.
+inline bool convert(std::span<const float> src, std::span<half> dst) {
+  if (src.size() != dst.size())
+    return false;
+  size_t i = detail::convertF32ToF16Simd(src.data(), src.size(), dst.data());
+  for (; i < src.size(); ++i)
+    dst[i] = half(src[i]);
+  return true;
+}
+
+inline bool convert(std::span<const half> src, std::span<float> dst) {
+  if (src.size() != dst.size())
+    return false;
+  size_t i = detail::convertF16ToF32Simd(src.data(), src.size(), dst.data());
+  for (; i < src.size(); ++i)
+    dst[i] = static_cast<float>(src[i]);
+  return true;
+}
+
+inline bool convert(std::span<const float> src, std::span<bf16> dst) {
+  if (src.size() != dst.size())
+    return false;
+  size_t i = detail::convertF32ToBF16Simd(src.data(), src.size(), dst.data());
+  for (; i < src.size(); ++i)
+    dst[i] = bf16(src[i]);
+  return true;
+}
+
+inline bool convert(std::span<const bf16> src, std::span<float> dst) {
+  if (src.size() != dst.size())
+    return false;
+  size_t i = detail::convertBF16ToF32Simd(src.data(), src.size(), dst.data());
+  for (; i < src.size(); ++i)
+    dst[i] = static_cast<float>(src[i]);
+  return true;
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_SUPPORT_FLOAT_TYPES_H
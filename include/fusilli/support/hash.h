@@ -0,0 +1,97 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains a small, stable (across processes and platforms) hashing
+// utility used to derive content-addressed keys for cached artifacts.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_HASH_H
+#define FUSILLI_SUPPORT_HASH_H
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace fusilli {
+
+// Incremental 64-bit FNV-1a hasher. Unlike `std::hash`, the digest produced
+// here is stable across processes, compilers and runs, which makes it usable
+// as a key for on-disk caches.
+//
+//   Hasher h;
+//   h.update("some text").update(int64_t{42});
+//   std::string key = h.hexDigest(); // 16 lowercase hex characters
+//
+// Each `update` on a string mixes in the length before the bytes, so
+// `update("ab").update("c")` and `update("a").update("bc")` produce different
+// digests.
+class Hasher {
+public:
+  Hasher &update(std::span<const uint8_t> bytes) {
+    for (uint8_t byte : bytes) {
+      state_ ^= byte;
+      state_ *= kFnvPrime;
+    }
+    return *this;
+  }
+
+  Hasher &update(std::string_view str) {
+    updateRaw(static_cast<uint64_t>(str.size()));
+    return update(std::span<const uint8_t>(
+        reinterpret_cast<const uint8_t *>(str.data()), str.size()));
+  }
+
+  // Disambiguate string literals from the integral overload below.
+  Hasher &update(const char *str) { return update(std::string_view(str)); }
+
+  template <typename T>
+    requires std::integral<T> || std::is_enum_v<T> // C++20
+  Hasher &update(T value) {
+    return updateRaw(static_cast<uint64_t>(value));
+  }
+
+  uint64_t digest() const { return state_; }
+
+  // Zero padded, lowercase hex representation of `digest()`.
+  std::string hexDigest() const { return toHex(state_); }
+
+  static std::string toHex(uint64_t value) {
+    static constexpr char kHexChars[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i) {
+      hex[i] = kHexChars[value & 0xf];
+      value >>= 4;
+    }
+    return hex;
+  }
+
+private:
+  // Mixes in the little-endian bytes of `value` so digests do not depend on
+  // host endianness.
+  Hasher &updateRaw(uint64_t value) {
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+      state_ ^= static_cast<uint8_t>(value >> (8 * i));
+      state_ *= kFnvPrime;
+    }
+    return *this;
+  }
+
+  static constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+  static constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+  uint64_t state_ = kFnvOffsetBasis;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_HASH_H
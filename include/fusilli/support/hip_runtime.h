@@ -0,0 +1,160 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the loader of the subset of the HIP runtime API Fusilli
+// calls directly on the streams of AMDGPU handles (graph capture, events), to
+// create streams, to share device memory between processes (IPC handles) and
+// to detect the ROCm target of a device.
+//
+// The HIP runtime is loaded dynamically (see `DynamicLibrary`), so Fusilli
+// does not link against it and builds without AMDGPU support are unaffected.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_HIP_RUNTIME_H
+#define FUSILLI_SUPPORT_HIP_RUNTIME_H
+
+#include "fusilli/support/dllib.h"
+#include "fusilli/support/logging.h"
+#include "fusilli/support/target_platform.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace fusilli {
+
+namespace detail {
+
+// The subset of the HIP runtime API used by Fusilli, with the HIP handle
+// types reduced to opaque pointers.
+struct HipApi {
+  using hipError_t = int;
+  using hipStream_t = void *;
+  using hipEvent_t = void *;
+  using hipGraph_t = void *;
+  using hipGraphExec_t = void *;
+  using hipGraphNode_t = void *;
+
+  // Opaque IPC handle to a device allocation, passed between processes.
+  static constexpr size_t hipIpcMemHandleSize = 64;
+  struct hipIpcMemHandle_t {
+    char reserved[hipIpcMemHandleSize];
+  };
+
+  static constexpr hipError_t hipSuccess = 0;
+  static constexpr hipError_t hipErrorNotReady = 600;
+  // Only capture work issued by the capturing thread, so other threads keep
+  // using their own streams while a graph is being captured.
+  static constexpr int hipStreamCaptureModeThreadLocal = 1;
+  // Enable peer access to the memory of an IPC handle opened on another
+  // device than the one it was allocated on.
+  static constexpr unsigned int hipIpcMemLazyEnablePeerAccess = 1;
+  // Create streams that don't synchronize with the default (null) stream.
+  static constexpr unsigned int hipStreamNonBlocking = 1;
+
+  DynamicLibrary lib;
+  hipError_t (*hipSetDevice)(int) = nullptr;
+  hipError_t (*hipGetDeviceCount)(int *) = nullptr;
+  hipError_t (*hipStreamCreate)(hipStream_t *) = nullptr;
+  hipError_t (*hipStreamCreateWithPriority)(hipStream_t *, unsigned int,
+                                            int) = nullptr;
+  hipError_t (*hipStreamDestroy)(hipStream_t) = nullptr;
+  hipError_t (*hipDeviceGetStreamPriorityRange)(int *, int *) = nullptr;
+  hipError_t (*hipStreamBeginCapture)(hipStream_t, int) = nullptr;
+  hipError_t (*hipStreamEndCapture)(hipStream_t, hipGraph_t *) = nullptr;
+  hipError_t (*hipGraphInstantiate)(hipGraphExec_t *, hipGraph_t,
+                                    hipGraphNode_t *, char *,
+                                    size_t) = nullptr;
+  hipError_t (*hipGraphLaunch)(hipGraphExec_t, hipStream_t) = nullptr;
+  hipError_t (*hipGraphExecDestroy)(hipGraphExec_t) = nullptr;
+  hipError_t (*hipGraphDestroy)(hipGraph_t) = nullptr;
+  hipError_t (*hipEventCreate)(hipEvent_t *) = nullptr;
+  hipError_t (*hipEventRecord)(hipEvent_t, hipStream_t) = nullptr;
+  hipError_t (*hipEventQuery)(hipEvent_t) = nullptr;
+  hipError_t (*hipEventSynchronize)(hipEvent_t) = nullptr;
+  hipError_t (*hipEventElapsedTime)(float *, hipEvent_t, hipEvent_t) = nullptr;
+  hipError_t (*hipEventDestroy)(hipEvent_t) = nullptr;
+  hipError_t (*hipMemGetAddressRange)(void **, size_t *, void *) = nullptr;
+  hipError_t (*hipIpcGetMemHandle)(hipIpcMemHandle_t *, void *) = nullptr;
+  hipError_t (*hipIpcOpenMemHandle)(void **, hipIpcMemHandle_t,
+                                    unsigned int) = nullptr;
+  hipError_t (*hipIpcCloseMemHandle)(void *) = nullptr;
+  const char *(*hipGetErrorString)(hipError_t) = nullptr;
+  // Optional device queries, null when the runtime does not export them.
+  hipError_t (*hipDeviceGetName)(char *, int, int) = nullptr;
+  hipError_t (*hipGetDevicePropertiesR0600)(void *, int) = nullptr;
+
+  // Returns an error carrying the HIP error string when `err` is not
+  // `hipSuccess`.
+  ErrorObject check(hipError_t err, const std::string &call) const {
+    if (err == hipSuccess)
+      return ok();
+    return error(ErrorCode::RuntimeFailure,
+                 call + " failed: " + hipGetErrorString(err));
+  }
+};
+
+// Loads the HIP runtime once per process.
+inline ErrorOr<const HipApi *> getHipApi() {
+  static ErrorOr<std::unique_ptr<HipApi>> api =
+      []() -> ErrorOr<std::unique_ptr<HipApi>> {
+    auto hip = std::make_unique<HipApi>();
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+    FUSILLI_CHECK_ERROR(hip->lib.load("amdhip64_6.dll"));
+#else
+    FUSILLI_CHECK_ERROR(hip->lib.load("libamdhip64.so"));
+#endif
+#define FUSILLI_LOAD_HIP_SYMBOL(name)                                          \
+  FUSILLI_ASSIGN_OR_RETURN(hip->name,                                          \
+                           hip->lib.getSymbol<decltype(hip->name)>(#name))
+    FUSILLI_LOAD_HIP_SYMBOL(hipSetDevice);
+    FUSILLI_LOAD_HIP_SYMBOL(hipGetDeviceCount);
+    FUSILLI_LOAD_HIP_SYMBOL(hipStreamCreate);
+    FUSILLI_LOAD_HIP_SYMBOL(hipStreamCreateWithPriority);
+    FUSILLI_LOAD_HIP_SYMBOL(hipStreamDestroy);
+    FUSILLI_LOAD_HIP_SYMBOL(hipDeviceGetStreamPriorityRange);
+    FUSILLI_LOAD_HIP_SYMBOL(hipStreamBeginCapture);
+    FUSILLI_LOAD_HIP_SYMBOL(hipStreamEndCapture);
+    FUSILLI_LOAD_HIP_SYMBOL(hipGraphInstantiate);
+    FUSILLI_LOAD_HIP_SYMBOL(hipGraphLaunch);
+    FUSILLI_LOAD_HIP_SYMBOL(hipGraphExecDestroy);
+    FUSILLI_LOAD_HIP_SYMBOL(hipGraphDestroy);
+    FUSILLI_LOAD_HIP_SYMBOL(hipEventCreate);
+    FUSILLI_LOAD_HIP_SYMBOL(hipEventRecord);
+    FUSILLI_LOAD_HIP_SYMBOL(hipEventQuery);
+    FUSILLI_LOAD_HIP_SYMBOL(hipEventSynchronize);
+    FUSILLI_LOAD_HIP_SYMBOL(hipEventElapsedTime);
+    FUSILLI_LOAD_HIP_SYMBOL(hipEventDestroy);
+    FUSILLI_LOAD_HIP_SYMBOL(hipMemGetAddressRange);
+    FUSILLI_LOAD_HIP_SYMBOL(hipIpcGetMemHandle);
+    FUSILLI_LOAD_HIP_SYMBOL(hipIpcOpenMemHandle);
+    FUSILLI_LOAD_HIP_SYMBOL(hipIpcCloseMemHandle);
+    FUSILLI_LOAD_HIP_SYMBOL(hipGetErrorString);
+#undef FUSILLI_LOAD_HIP_SYMBOL
+#define FUSILLI_LOAD_OPTIONAL_HIP_SYMBOL(name)                                 \
+  if (auto symbol = hip->lib.getSymbol<decltype(hip->name)>(#name);            \
+      !isError(symbol))                                                        \
+  hip->name = *symbol
+    FUSILLI_LOAD_OPTIONAL_HIP_SYMBOL(hipDeviceGetName);
+    FUSILLI_LOAD_OPTIONAL_HIP_SYMBOL(hipGetDevicePropertiesR0600);
+#undef FUSILLI_LOAD_OPTIONAL_HIP_SYMBOL
+    return ok(std::move(hip));
+  }();
+  FUSILLI_RETURN_ERROR_IF(isError(api), ErrorCode::RuntimeFailure,
+                          "Failed to load the HIP runtime: " +
+                              ErrorObject(api).getMessage());
+  return ok(static_cast<const HipApi *>(api->get()));
+}
+
+} // namespace detail
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_HIP_RUNTIME_H
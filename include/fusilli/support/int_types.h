@@ -19,6 +19,12 @@
 #include <cstdint>
 #include <vector>
 
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace fusilli {
 
 // Signed 4-bit integer. Range: [-8, 7].
@@ -56,30 +62,182 @@ struct Int4 {
   // Pack N elements into ceil(N/2) bytes.
   // Convention: element[2k] in low nibble, element[2k+1] in high nibble.
   static std::vector<uint8_t> pack(const std::vector<Int4> &elements) {
-    size_t packedSize = (elements.size() + 1) / 2;
-    std::vector<uint8_t> packed(packedSize, 0);
-    for (size_t i = 0; i < elements.size(); ++i) {
-      unsigned slot = i % 2;
-      packed[i / 2] |= static_cast<uint8_t>(elements[i].toBits() << (slot * 4));
-    }
+    std::vector<uint8_t> packed((elements.size() + 1) / 2);
+    pack(elements.data(), elements.size(), packed.data());
     return packed;
   }
 
+  // Pack `count` elements into the ceil(count/2) bytes at `packed`.
+  // Definition below.
+  static void pack(const Int4 *elements, size_t count, uint8_t *packed);
+
   // Unpack bytes into N elements.
   static std::vector<Int4> unpack(const uint8_t *data, size_t count) {
     std::vector<Int4> elements(count);
-    for (size_t i = 0; i < count; ++i) {
-      unsigned slot = i % 2;
-      elements[i] =
-          Int4::fromBits(static_cast<uint8_t>(data[i / 2] >> (slot * 4)));
-    }
+    unpack(data, count, elements.data());
     return elements;
   }
 
+  // Unpack bytes into the `count` elements at `elements`.
+  // Definition below.
+  static void unpack(const uint8_t *data, size_t count, Int4 *elements);
+
 private:
   uint8_t data_ = 0;
 };
 
+// Int4 is a byte holding the element in its low nibble (the high nibble may
+// hold sign bits of the clamped input), so arrays of Int4 are viewed as bytes
+// by the pack and unpack kernels.
+static_assert(sizeof(Int4) == 1 && alignof(Int4) == 1);
+
+namespace detail {
+
+// Scalar pack and unpack, for tails and targets without SIMD kernels.
+inline void packInt4Scalar(const uint8_t *elements, size_t count,
+                           uint8_t *packed) {
+  for (size_t i = 0; i + 1 < count; i += 2)
+    packed[i / 2] =
+        static_cast<uint8_t>((elements[i] & 0x0F) | (elements[i + 1] << 4));
+  if (count % 2)
+    packed[count / 2] = elements[count - 1] & 0x0F;
+}
+
+inline void unpackInt4Scalar(const uint8_t *data, size_t count,
+                             uint8_t *elements) {
+  for (size_t i = 0; i + 1 < count; i += 2) {
+    elements[i] = data[i / 2] & 0x0F;
+    elements[i + 1] = data[i / 2] >> 4;
+  }
+  if (count % 2)
+    elements[count - 1] = data[count / 2] & 0x0F;
+}
+
+// SIMD kernels, selected at compile time from the target ISA. Each processes
+// a prefix of whole vectors and returns the number of elements processed,
+// leaving the tail to the scalar kernels.
+#if defined(__AVX2__)
+inline size_t packInt4Simd(const uint8_t *elements, size_t count,
+                           uint8_t *packed) {
+  const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+  const __m256i lowBytes = _mm256_set1_epi16(0x00FF);
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i v = _mm256_and_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(elements + i)),
+        lowNibbles);
+    // Each 16-bit lane holds (e[2k+1] << 8 | e[2k]): fold the high byte into
+    // the high nibble of the low byte and clear the high byte, so the
+    // saturating narrowing below keeps the low bytes.
+    v = _mm256_and_si256(_mm256_or_si256(v, _mm256_srli_epi16(v, 4)),
+                         lowBytes);
+    __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(v),
+                                     _mm256_extracti128_si256(v, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(packed + i / 2), bytes);
+  }
+  return i;
+}
+
+inline size_t unpackInt4Simd(const uint8_t *data, size_t count,
+                             uint8_t *elements) {
+  const __m128i lowNibbles = _mm_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i / 2));
+    __m128i lo = _mm_and_si128(bytes, lowNibbles);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowNibbles);
+    __m256i interleaved = _mm256_set_m128i(_mm_unpackhi_epi8(lo, hi),
+                                           _mm_unpacklo_epi8(lo, hi));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(elements + i),
+                        interleaved);
+  }
+  return i;
+}
+#elif defined(__SSE2__) || defined(_M_X64)
+inline size_t packInt4Simd(const uint8_t *elements, size_t count,
+                           uint8_t *packed) {
+  const __m128i lowNibbles = _mm_set1_epi8(0x0F);
+  const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m128i a = _mm_and_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(elements + i)),
+        lowNibbles);
+    __m128i b = _mm_and_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(elements + i + 16)),
+        lowNibbles);
+    // See the AVX2 kernel.
+    a = _mm_and_si128(_mm_or_si128(a, _mm_srli_epi16(a, 4)), lowBytes);
+    b = _mm_and_si128(_mm_or_si128(b, _mm_srli_epi16(b, 4)), lowBytes);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(packed + i / 2),
+                     _mm_packus_epi16(a, b));
+  }
+  return i;
+}
+
+inline size_t unpackInt4Simd(const uint8_t *data, size_t count,
+                             uint8_t *elements) {
+  const __m128i lowNibbles = _mm_set1_epi8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i / 2));
+    __m128i lo = _mm_and_si128(bytes, lowNibbles);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowNibbles);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(elements + i),
+                     _mm_unpacklo_epi8(lo, hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(elements + i + 16),
+                     _mm_unpackhi_epi8(lo, hi));
+  }
+  return i;
+}
+#elif defined(__ARM_NEON)
+inline size_t packInt4Simd(const uint8_t *elements, size_t count,
+                           uint8_t *packed) {
+  const uint8x16_t lowNibbles = vdupq_n_u8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    // De-interleaving load: even elements in val[0], odd ones in val[1].
+    uint8x16x2_t v = vld2q_u8(elements + i);
+    uint8x16_t bytes =
+        vorrq_u8(vandq_u8(v.val[0], lowNibbles), vshlq_n_u8(v.val[1], 4));
+    vst1q_u8(packed + i / 2, bytes);
+  }
+  return i;
+}
+
+inline size_t unpackInt4Simd(const uint8_t *data, size_t count,
+                             uint8_t *elements) {
+  const uint8x16_t lowNibbles = vdupq_n_u8(0x0F);
+  size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    uint8x16_t bytes = vld1q_u8(data + i / 2);
+    uint8x16x2_t v = {{vandq_u8(bytes, lowNibbles), vshrq_n_u8(bytes, 4)}};
+    // Interleaving store: val[0] to even elements, val[1] to odd ones.
+    vst2q_u8(elements + i, v);
+  }
+  return i;
+}
+#else
+inline size_t packInt4Simd(const uint8_t *, size_t, uint8_t *) { return 0; }
+inline size_t unpackInt4Simd(const uint8_t *, size_t, uint8_t *) { return 0; }
+#endif
+
+} // namespace detail
+
+inline void Int4::pack(const Int4 *elements, size_t count, uint8_t *packed) {
+  const auto *bytes = reinterpret_cast<const uint8_t *>(elements);
+  size_t done = detail::packInt4Simd(bytes, count, packed);
+  detail::packInt4Scalar(bytes + done, count - done, packed + done / 2);
+}
+
+inline void Int4::unpack(const uint8_t *data, size_t count, Int4 *elements) {
+  auto *bytes = reinterpret_cast<uint8_t *>(elements);
+  size_t done = detail::unpackInt4Simd(data, count, bytes);
+  detail::unpackInt4Scalar(data + done / 2, count - done, bytes + done);
+}
+
 // True if T requires sub-byte packing for IREE HAL buffers.
 template <typename T> inline constexpr bool kIsSubByteElement = false;
 template <> inline constexpr bool kIsSubByteElement<Int4> = true;
@@ -0,0 +1,365 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the size cap, least recently used eviction and usage
+// statistics of the persistent kernel cache in `${FUSILLI_CACHE_DIR}/kernels`
+// (see `CacheFile::getKernelCachePath()`), and the upkeep of its index (see
+// `detail::KernelCacheIndex`).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_KERNEL_CACHE_H
+#define FUSILLI_SUPPORT_KERNEL_CACHE_H
+
+#include "fusilli/support/cache.h"
+#include "fusilli/support/file_lock.h"
+#include "fusilli/support/kernel_cache_index.h"
+#include "fusilli/support/logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Kernel cache usage of this process, see `getKernelCacheStats()`.
+struct KernelCacheStats {
+  // Compilations served by an entry in the kernel cache.
+  uint64_t hits = 0;
+
+  // Compilations that invoked the compiler because no entry existed.
+  uint64_t misses = 0;
+
+  // Hits served by an entry fetched from the remote kernel cache (see
+  // `getRemoteKernelCache()`), included in `hits`.
+  uint64_t remoteHits = 0;
+
+  // Entries removed by `evictKernelCache()`, and their total size.
+  uint64_t evictions = 0;
+  uint64_t evictedBytes = 0;
+};
+
+// Contents of the kernel cache across all processes, see
+// `getKernelCacheUsage()`.
+struct KernelCacheUsage {
+  uint64_t entries = 0;
+  uint64_t bytes = 0;
+};
+
+namespace detail {
+
+struct KernelCacheCounters {
+  std::atomic<uint64_t> hits = 0;
+  std::atomic<uint64_t> misses = 0;
+  std::atomic<uint64_t> remoteHits = 0;
+  std::atomic<uint64_t> evictions = 0;
+  std::atomic<uint64_t> evictedBytes = 0;
+};
+
+inline KernelCacheCounters &getKernelCacheCounters() {
+  static KernelCacheCounters counters;
+  return counters;
+}
+
+// Parses a size in bytes with an optional binary unit suffix, e.g. "512",
+// "64K", "10G" or "1T".
+inline std::optional<uintmax_t> parseKernelCacheSize(const std::string &str) {
+  uintmax_t size = 0;
+  const char *begin = str.data();
+  const char *end = str.data() + str.size();
+  auto [ptr, errc] = std::from_chars(begin, end, size);
+  if (errc != std::errc() || ptr == begin)
+    return std::nullopt;
+  if (ptr == end)
+    return size;
+  if (ptr + 1 != end)
+    return std::nullopt;
+  switch (std::toupper(static_cast<unsigned char>(*ptr))) {
+  case 'K':
+    return size << 10;
+  case 'M':
+    return size << 20;
+  case 'G':
+    return size << 30;
+  case 'T':
+    return size << 40;
+  default:
+    return std::nullopt;
+  }
+}
+
+// Marks the kernel cache entry for `key` as used now, see
+// `evictKernelCache()`. Entries the index has no record of yet are marked
+// through the modification time of their directory.
+inline void touchKernelCacheEntry(const std::string &key) {
+  if (KernelCacheIndex::touch(key))
+    return;
+  std::error_code ec;
+  std::filesystem::last_write_time(
+      CacheFile::getKernelCachePath(key, "").parent_path(),
+      std::filesystem::file_time_type::clock::now(), ec);
+}
+
+// Returns the index record of the kernel cache entry in `dir`, last used at
+// `lastUsed`, summing the sizes of its files.
+inline KernelCacheIndexSlot
+scanKernelCacheEntry(const std::filesystem::path &dir,
+                     std::filesystem::file_time_type lastUsed) {
+  KernelCacheIndexSlot slot = {};
+  slot.kind = KernelCacheIndexKind::Entry;
+  KernelCacheIndexSlot::setString(slot.key, dir.filename().string());
+  slot.lastUsed = static_cast<int64_t>(lastUsed.time_since_epoch().count());
+  size_t fileCount = 0;
+  std::error_code ec;
+  using DirIt = std::filesystem::directory_iterator;
+  for (DirIt file(dir, ec); !ec && file != DirIt(); file.increment(ec)) {
+    std::error_code sizeEc;
+    uintmax_t fileSize = file->file_size(sizeEc);
+    if (sizeEc)
+      continue;
+    slot.size += fileSize;
+    ++fileCount;
+  }
+  // Complete entries of the production compile profile only hold the output.
+  slot.outputOnly = fileCount == 1;
+  return slot;
+}
+
+// Records the complete kernel cache entry for `key` in the index as used now.
+inline ErrorObject indexKernelCacheEntry(const std::string &key) {
+  if (!KernelCacheIndexSlot::fits(key))
+    return ok();
+  return KernelCacheIndex::insert(scanKernelCacheEntry(
+      CacheFile::getKernelCachePath(key, "").parent_path(),
+      std::filesystem::file_time_type::clock::now()));
+}
+
+// Records the alias from `fingerprintKey` to the kernel cache entry for `key`
+// in the index.
+inline ErrorObject indexKernelCacheAlias(const std::string &fingerprintKey,
+                                         const std::string &key) {
+  if (!KernelCacheIndexSlot::fits(fingerprintKey) ||
+      !KernelCacheIndexSlot::fits(key))
+    return ok();
+  KernelCacheIndexSlot slot = {};
+  slot.kind = KernelCacheIndexKind::Alias;
+  KernelCacheIndexSlot::setString(slot.key, fingerprintKey);
+  KernelCacheIndexSlot::setString(slot.target, key);
+  return KernelCacheIndex::insert(slot);
+}
+
+// Brings `records` in line with the entries and aliases in `kernelsDir`,
+// which other processes (or versions of fusilli without the index) may have
+// added or removed, and returns whether any record changed. Only new entries
+// and aliases are read; known ones cost a directory listing. Entries being
+// published (holding a lock file) are recorded once they are published.
+inline bool
+reconcileKernelCacheIndex(const std::filesystem::path &kernelsDir,
+                          KernelCacheIndexRecords &records) {
+  std::set<std::pair<KernelCacheIndexKind, std::string>> present;
+  bool changed = false;
+  // Other processes may be modifying the cache concurrently, so iteration
+  // errors are tolerated rather than reported (or thrown).
+  std::error_code ec;
+  using DirIt = std::filesystem::directory_iterator;
+  for (DirIt it(kernelsDir, ec); !ec && it != DirIt(); it.increment(ec)) {
+    std::filesystem::path dir = it->path();
+    std::string key = dir.filename().string();
+    std::error_code entryEc;
+    if (!it->is_directory(entryEc) || key == "aliases" || key == "tuned" ||
+        !KernelCacheIndexSlot::fits(key))
+      continue;
+    auto id = std::pair(KernelCacheIndexKind::Entry, key);
+    present.insert(id);
+    if (records.contains(id) ||
+        std::filesystem::exists(dir / ".lock", entryEc))
+      continue;
+    std::filesystem::file_time_type lastUsed =
+        std::filesystem::last_write_time(dir, entryEc);
+    if (entryEc)
+      continue;
+    records.emplace(id, scanKernelCacheEntry(dir, lastUsed));
+    changed = true;
+  }
+  for (DirIt it(kernelsDir / "aliases", ec); !ec && it != DirIt();
+       it.increment(ec)) {
+    std::string fingerprintKey = it->path().filename().string();
+    auto id = std::pair(KernelCacheIndexKind::Alias, fingerprintKey);
+    present.insert(id);
+    if (records.contains(id) || !KernelCacheIndexSlot::fits(fingerprintKey))
+      continue;
+    ErrorOr<CacheFile> alias = CacheFile::open(it->path());
+    if (isError(alias))
+      continue;
+    ErrorOr<std::string> key = alias->read();
+    if (isError(key) || !KernelCacheIndexSlot::fits(*key))
+      continue;
+    KernelCacheIndexSlot slot = {};
+    slot.kind = KernelCacheIndexKind::Alias;
+    KernelCacheIndexSlot::setString(slot.key, fingerprintKey);
+    KernelCacheIndexSlot::setString(slot.target, *key);
+    records.emplace(id, slot);
+    changed = true;
+  }
+  // Drop records of entries and aliases removed behind the index's back.
+  changed |= std::erase_if(records, [&](const auto &record) {
+               return !present.contains(record.first);
+             }) > 0;
+  return changed;
+}
+
+} // namespace detail
+
+// Returns the kernel cache usage of this process so far.
+inline KernelCacheStats getKernelCacheStats() {
+  const detail::KernelCacheCounters &counters =
+      detail::getKernelCacheCounters();
+  return KernelCacheStats{
+      .hits = counters.hits.load(), // C++20
+      .misses = counters.misses.load(),
+      .remoteHits = counters.remoteHits.load(),
+      .evictions = counters.evictions.load(),
+      .evictedBytes = counters.evictedBytes.load(),
+  };
+}
+
+// Resets the counters returned by `getKernelCacheStats()`.
+inline void resetKernelCacheStats() {
+  detail::KernelCacheCounters &counters = detail::getKernelCacheCounters();
+  counters.hits = 0;
+  counters.misses = 0;
+  counters.remoteHits = 0;
+  counters.evictions = 0;
+  counters.evictedBytes = 0;
+}
+
+// Size cap of the kernel cache in bytes, or std::nullopt for no cap (the
+// default). Initialized from `FUSILLI_CACHE_MAX_SIZE` (e.g. "10G"); assign to
+// it to override the environment. The cap is enforced by evicting least
+// recently used entries whenever this process publishes a new one.
+inline std::optional<uintmax_t> &getKernelCacheMaxSize() {
+  static std::optional<uintmax_t> maxSize = []() -> std::optional<uintmax_t> {
+    const char *envVal = std::getenv("FUSILLI_CACHE_MAX_SIZE");
+    if (!envVal || std::string(envVal).empty())
+      return std::nullopt;
+    std::optional<uintmax_t> size = detail::parseKernelCacheSize(envVal);
+    if (!size.has_value())
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Ignoring invalid FUSILLI_CACHE_MAX_SIZE="
+                             << envVal);
+    return size;
+  }();
+  return maxSize;
+}
+
+// Returns the number of entries in the kernel cache and their total size, as
+// recorded by its index. Entries not published through `Graph::compile()` are
+// counted once `evictKernelCache()` has seen them.
+inline KernelCacheUsage getKernelCacheUsage() {
+  std::optional<detail::KernelCacheIndexHeader> header =
+      detail::KernelCacheIndex::getHeader();
+  if (!header.has_value())
+    return KernelCacheUsage{};
+  return KernelCacheUsage{
+      .entries = header->entryCount, // C++20
+      .bytes = header->totalSize,
+  };
+}
+
+// Removes least recently used kernel cache entries until the entries total at
+// most `maxSize` bytes, and returns the number of entries removed. Entries are
+// ordered by their last use by `Graph::compile()` (or publication) from any
+// process. Entries being published (holding a lock file) are never removed,
+// and aliases left pointing at removed entries are removed with them.
+//
+// Sizes and last uses are taken from the index of the kernel cache, which is
+// reconciled with the cache directory first, so entries are only sized once.
+//
+// Artifacts already loaded from removed entries stay valid; later compiles
+// simply miss and recompile.
+inline ErrorOr<size_t> evictKernelCache(uintmax_t maxSize) {
+  std::filesystem::path kernelsDir = CacheFile::getCacheDir() / "kernels";
+  std::error_code ec;
+  if (!std::filesystem::is_directory(kernelsDir, ec))
+    return ok(size_t(0));
+
+  FUSILLI_ASSIGN_OR_RETURN(
+      FileLock indexLock,
+      FileLock::acquire(detail::KernelCacheIndex::getLockPath()));
+  detail::KernelCacheIndexRecords records =
+      detail::KernelCacheIndex::read(detail::KernelCacheIndex::getPath());
+  bool changed = detail::reconcileKernelCacheIndex(kernelsDir, records);
+
+  std::vector<const detail::KernelCacheIndexSlot *> entries;
+  uintmax_t totalSize = 0;
+  for (const auto &[id, slot] : records) {
+    if (slot.kind != detail::KernelCacheIndexKind::Entry)
+      continue;
+    entries.push_back(&slot);
+    totalSize += slot.size;
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const detail::KernelCacheIndexSlot *a,
+               const detail::KernelCacheIndexSlot *b) {
+              return a->lastUsed < b->lastUsed;
+            });
+
+  detail::KernelCacheCounters &counters = detail::getKernelCacheCounters();
+  std::set<std::string> evictedKeys;
+  for (const detail::KernelCacheIndexSlot *entry : entries) {
+    if (totalSize <= maxSize)
+      break;
+    std::filesystem::path dir = kernelsDir / entry->getKey();
+    std::error_code removeEc;
+    if (std::filesystem::exists(dir / ".lock", removeEc))
+      continue;
+    // Another process may be evicting (or using, on Windows) the same entry.
+    std::filesystem::remove_all(dir, removeEc);
+    if (removeEc)
+      continue;
+    FUSILLI_LOG_LABEL_ENDL("INFO: Evicted kernel cache entry "
+                           << entry->getKey());
+    totalSize -= entry->size;
+    ++counters.evictions;
+    counters.evictedBytes += entry->size;
+    evictedKeys.emplace(entry->getKey());
+  }
+  if (evictedKeys.empty()) {
+    if (changed)
+      FUSILLI_CHECK_ERROR(detail::KernelCacheIndex::write(records));
+    return ok(size_t(0));
+  }
+
+  // Remove the evicted entries and the aliases to them.
+  std::erase_if(records, [&](const auto &record) {
+    const detail::KernelCacheIndexSlot &slot = record.second;
+    if (slot.kind == detail::KernelCacheIndexKind::Entry)
+      return evictedKeys.contains(std::string(slot.getKey()));
+    if (!evictedKeys.contains(std::string(slot.getTarget())))
+      return false;
+    std::error_code aliasEc;
+    std::filesystem::remove(kernelsDir / "aliases" / slot.getKey(), aliasEc);
+    return true;
+  });
+  FUSILLI_CHECK_ERROR(detail::KernelCacheIndex::write(records));
+  return ok(evictedKeys.size());
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_KERNEL_CACHE_H
@@ -0,0 +1,364 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the index of the persistent kernel cache, a memory-mapped
+// hash table recording the entries and aliases of the cache with their sizes
+// and last use, so lookups, eviction and usage statistics don't have to walk
+// the cache directory or stat the files of each entry.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_KERNEL_CACHE_INDEX_H
+#define FUSILLI_SUPPORT_KERNEL_CACHE_INDEX_H
+
+#include "fusilli/support/cache.h"
+#include "fusilli/support/file_lock.h"
+#include "fusilli/support/hash.h"
+#include "fusilli/support/logging.h"
+#include "fusilli/support/mapped_file.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace fusilli {
+
+namespace detail {
+
+// On-disk layout of the kernel cache index `kernels/index` (host endianness,
+// all offsets from the start of the file):
+//
+//   Header: magic (8 bytes) | version (uint32) | capacity (uint32) |
+//           generation | entry count | total size (uint64 each)
+//   Slots:  `capacity` (a power of two) `KernelCacheIndexSlot`s
+//
+// The slots form an open addressing hash table with linear probing, keyed by
+// the kind and key of each record. The index is rewritten as a whole under
+// `kernels/index.lock` when records are added or removed, and replaced
+// atomically, so readers map it without locking. Only the last use of an
+// entry is updated in place, guarded by the generation of the file.
+inline constexpr char kKernelCacheIndexMagic[8] = {'F', 'U', 'S', 'I',
+                                                    'L', 'L', 'I', 'X'};
+inline constexpr uint32_t kKernelCacheIndexVersion = 1;
+inline constexpr uint32_t kKernelCacheIndexMinCapacity = 1024;
+
+enum class KernelCacheIndexKind : uint32_t {
+  Empty = 0,
+  // A kernel cache entry (see `CacheFile::getKernelCachePath()`).
+  Entry = 1,
+  // An alias from a fingerprint key to an entry (see
+  // `CacheFile::getKernelCacheAliasPath()`).
+  Alias = 2,
+};
+
+struct KernelCacheIndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t capacity;
+  // Random, identifies this version of the file for in place updates.
+  uint64_t generation;
+  uint64_t entryCount;
+  uint64_t totalSize;
+};
+
+struct KernelCacheIndexSlot {
+  KernelCacheIndexKind kind;
+  // Whether the entry only holds the output artifact (see
+  // `CompileProfile::Production`).
+  uint32_t outputOnly;
+  // Kernel cache key of an entry, or fingerprint key of an alias, NUL padded.
+  char key[32];
+  // Kernel cache key an alias maps to, NUL padded.
+  char target[32];
+  // Size of the files of an entry in bytes.
+  uint64_t size;
+  // Last use of an entry, in `std::filesystem::file_time_type` ticks.
+  int64_t lastUsed;
+
+  std::string_view getKey() const { return getString(key); }
+  std::string_view getTarget() const { return getString(target); }
+
+  // Returns whether `str` fits in a key field.
+  static bool fits(std::string_view str) {
+    return !str.empty() && str.size() <= sizeof(key);
+  }
+
+  static void setString(char (&field)[32], std::string_view str) {
+    std::memset(field, 0, sizeof(field));
+    std::memcpy(field, str.data(), std::min(str.size(), sizeof(field)));
+  }
+
+  static std::string_view getString(const char (&field)[32]) {
+    std::string_view str(field, sizeof(field));
+    return str.substr(0, str.find('\0'));
+  }
+};
+
+// Records of the kernel cache index, keyed by kind and key.
+using KernelCacheIndexRecords =
+    std::map<std::pair<KernelCacheIndexKind, std::string>,
+             KernelCacheIndexSlot>;
+
+// Returns the current time in `KernelCacheIndexSlot::lastUsed` ticks.
+inline int64_t getKernelCacheIndexTime() {
+  return static_cast<int64_t>(std::filesystem::file_time_type::clock::now()
+                                  .time_since_epoch()
+                                  .count());
+}
+
+// KernelCacheIndex provides the process wide view of the kernel cache index
+// of the current cache directory (see `CacheFile::getCacheDir()`). The index
+// is an accelerator: the files of the cache remain authoritative, so a
+// missing, stale or corrupt index only costs the lookups it would have saved.
+class KernelCacheIndex {
+public:
+  static std::filesystem::path getPath() {
+    return CacheFile::getCacheDir() / "kernels" / "index";
+  }
+
+  static std::filesystem::path getLockPath() {
+    return CacheFile::getCacheDir() / "kernels" / "index.lock";
+  }
+
+  // Returns the record of `kind` for `key`, or std::nullopt if the index has
+  // none. A miss remaps the index once, in case another process rewrote it.
+  static std::optional<KernelCacheIndexSlot> find(KernelCacheIndexKind kind,
+                                                  const std::string &key) {
+    if (!KernelCacheIndexSlot::fits(key))
+      return std::nullopt;
+    for (bool remap : {false, true}) {
+      std::shared_ptr<const MappedFile> mapping = getMapping(remap);
+      if (!mapping)
+        return std::nullopt;
+      std::optional<size_t> slot = probe(mapping->bytes(), kind, key);
+      if (slot.has_value())
+        return readSlot(mapping->bytes(), *slot);
+    }
+    return std::nullopt;
+  }
+
+  // Records the use of the entry for `key` now, in place. Returns false if
+  // the index has no record of it.
+  static bool touch(const std::string &key) {
+    if (!KernelCacheIndexSlot::fits(key))
+      return false;
+    // A stale mapping is refreshed once, like in `find()`.
+    for (bool remap : {false, true}) {
+      std::shared_ptr<const MappedFile> mapping = getMapping(remap);
+      if (!mapping)
+        return false;
+      std::optional<size_t> slot =
+          probe(mapping->bytes(), KernelCacheIndexKind::Entry, key);
+      if (!slot.has_value())
+        continue;
+      KernelCacheIndexHeader header;
+      std::memcpy(&header, mapping->bytes().data(), sizeof(header));
+      if (touchSlot(header.generation, *slot))
+        return true;
+    }
+    return false;
+  }
+
+  // Returns the header of the index, or std::nullopt without a valid index.
+  static std::optional<KernelCacheIndexHeader> getHeader() {
+    std::shared_ptr<const MappedFile> mapping = getMapping(/*remap=*/true);
+    if (!mapping)
+      return std::nullopt;
+    KernelCacheIndexHeader header;
+    std::memcpy(&header, mapping->bytes().data(), sizeof(header));
+    return header;
+  }
+
+  // Reads all records of the index at `path`. A missing or invalid index
+  // yields no records. Must be called with the index lock held when the
+  // records are written back.
+  static KernelCacheIndexRecords read(const std::filesystem::path &path) {
+    KernelCacheIndexRecords records;
+    ErrorOr<MappedFile> file = MappedFile::open(path);
+    if (isError(file) || !isValid(file->bytes()))
+      return records;
+    std::span<const uint8_t> bytes = file->bytes();
+    KernelCacheIndexHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    for (size_t i = 0; i < header.capacity; ++i) {
+      KernelCacheIndexSlot slot = readSlot(bytes, i);
+      if (slot.kind != KernelCacheIndexKind::Empty)
+        records.emplace(std::pair(slot.kind, std::string(slot.getKey())),
+                        slot);
+    }
+    return records;
+  }
+
+  // Replaces the index with `records`. Must be called with the index lock
+  // held.
+  static ErrorObject write(const KernelCacheIndexRecords &records) {
+    uint32_t capacity = std::max(
+        kKernelCacheIndexMinCapacity,
+        std::bit_ceil(static_cast<uint32_t>(records.size() * 2)));
+    KernelCacheIndexHeader header = {};
+    std::memcpy(header.magic, kKernelCacheIndexMagic, sizeof(header.magic));
+    header.version = kKernelCacheIndexVersion;
+    header.capacity = capacity;
+    header.generation = (uint64_t(std::random_device()()) << 32) ^
+                        static_cast<uint64_t>(getKernelCacheIndexTime());
+    std::string contents(getSlotOffset(capacity), '\0');
+    for (const auto &[id, slot] : records) {
+      if (slot.kind == KernelCacheIndexKind::Entry) {
+        ++header.entryCount;
+        header.totalSize += slot.size;
+      }
+      // Records are unique, so probe for the first empty slot.
+      std::span<const uint8_t> bytes(
+          reinterpret_cast<const uint8_t *>(contents.data()), contents.size());
+      size_t i = getHome(slot.kind, slot.getKey(), capacity);
+      while (readSlot(bytes, i).kind != KernelCacheIndexKind::Empty)
+        i = (i + 1) & (capacity - 1);
+      std::memcpy(contents.data() + getSlotOffset(i), &slot, sizeof(slot));
+    }
+    std::memcpy(contents.data(), &header, sizeof(header));
+    // Unmap the index before replacing it, which Windows requires.
+    unmap();
+    return CacheFile::publish(getPath(), contents);
+  }
+
+  // Adds or replaces the record of `slot` in the index.
+  static ErrorObject insert(const KernelCacheIndexSlot &slot) {
+    FUSILLI_ASSIGN_OR_RETURN(FileLock lock, FileLock::acquire(getLockPath()));
+    KernelCacheIndexRecords records = read(getPath());
+    records.insert_or_assign(
+        std::pair(slot.kind, std::string(slot.getKey())), slot);
+    return write(records);
+  }
+
+private:
+  // Writes the current time to the last use of `slot` if the index still has
+  // `generation`. A rewritten index has another generation, and one replaced
+  // after the check is a different file than the opened one.
+  static bool touchSlot(uint64_t generation, size_t slot) {
+    std::fstream file(getPath(),
+                      std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open())
+      return false;
+    uint64_t fileGeneration = 0;
+    file.seekg(offsetof(KernelCacheIndexHeader, generation));
+    file.read(reinterpret_cast<char *>(&fileGeneration),
+              sizeof(fileGeneration));
+    if (!file.good() || fileGeneration != generation)
+      return false;
+    int64_t now = getKernelCacheIndexTime();
+    file.seekp(static_cast<std::streamoff>(
+        getSlotOffset(slot) + offsetof(KernelCacheIndexSlot, lastUsed)));
+    file.write(reinterpret_cast<const char *>(&now), sizeof(now));
+    return file.good();
+  }
+
+  static size_t getSlotOffset(size_t slot) {
+    return sizeof(KernelCacheIndexHeader) +
+           slot * sizeof(KernelCacheIndexSlot);
+  }
+
+  static size_t getHome(KernelCacheIndexKind kind, std::string_view key,
+                        uint32_t capacity) {
+    return static_cast<size_t>(Hasher().update(kind).update(key).digest() &
+                               (capacity - 1));
+  }
+
+  static KernelCacheIndexSlot readSlot(std::span<const uint8_t> bytes,
+                                       size_t slot) {
+    KernelCacheIndexSlot result;
+    std::memcpy(&result, bytes.data() + getSlotOffset(slot), sizeof(result));
+    return result;
+  }
+
+  static bool isValid(std::span<const uint8_t> bytes) {
+    KernelCacheIndexHeader header;
+    if (bytes.size() < sizeof(header))
+      return false;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    return std::memcmp(header.magic, kKernelCacheIndexMagic,
+                       sizeof(header.magic)) == 0 &&
+           header.version == kKernelCacheIndexVersion &&
+           std::has_single_bit(header.capacity) &&
+           bytes.size() >= getSlotOffset(header.capacity);
+  }
+
+  // Returns the slot holding the record of `kind` for `key` in the (valid)
+  // index `bytes`, if any.
+  static std::optional<size_t> probe(std::span<const uint8_t> bytes,
+                                     KernelCacheIndexKind kind,
+                                     std::string_view key) {
+    KernelCacheIndexHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    size_t i = getHome(kind, key, header.capacity);
+    for (size_t n = 0; n < header.capacity; ++n) {
+      KernelCacheIndexSlot slot = readSlot(bytes, i);
+      if (slot.kind == KernelCacheIndexKind::Empty)
+        return std::nullopt;
+      if (slot.kind == kind && slot.getKey() == key)
+        return i;
+      i = (i + 1) & (header.capacity - 1);
+    }
+    return std::nullopt;
+  }
+
+  struct MappingState {
+    std::mutex mutex;
+    std::filesystem::path path;
+    std::shared_ptr<const MappedFile> mapping;
+  };
+
+  static MappingState &getMappingState() {
+    static MappingState state;
+    return state;
+  }
+
+  // Returns the mapping of the index of the current cache directory, mapping
+  // it again if `remap` is set, or null without a valid index.
+  static std::shared_ptr<const MappedFile> getMapping(bool remap) {
+    std::filesystem::path path = getPath();
+    MappingState &state = getMappingState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (remap || !state.mapping || path != state.path) {
+      state.path = path;
+      state.mapping.reset();
+      ErrorOr<MappedFile> file = MappedFile::open(path);
+      if (isOk(file) && isValid(file->bytes()))
+        state.mapping = std::make_shared<const MappedFile>(std::move(*file));
+    }
+    return state.mapping;
+  }
+
+  // Drops the cached mapping. Lookups in flight keep theirs alive.
+  static void unmap() {
+    MappingState &state = getMappingState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.mapping.reset();
+  }
+};
+
+} // namespace detail
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_KERNEL_CACHE_INDEX_H
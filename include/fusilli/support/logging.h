@@ -358,6 +358,36 @@ inline ConditionalStreamer &getLogger() {
   return logger;
 }
 
+// Whether the logging macros below are compiled in. Building with
+// `-DFUSILLI_DISABLE_LOGGING=ON` compiles them out, so they cost nothing
+// (their messages are still type checked).
+#if defined(FUSILLI_DISABLE_LOGGING)
+inline constexpr bool kLoggingCompiledIn = false;
+#else
+inline constexpr bool kLoggingCompiledIn = true;
+#endif
+
+// Whether a logging macro formats and emits its message. The message is only
+// evaluated when this holds, so a filtered log statement costs a flag check.
+inline bool shouldLog() { return kLoggingCompiledIn && isLoggingEnabled(); }
+
+namespace detail {
+
+// The first error returned through the error macros below on this thread
+// since the innermost event scope began, see `fusilli/support/event_log.h`.
+inline ErrorCode &pendingEventError() {
+  thread_local ErrorCode code = ErrorCode::OK;
+  return code;
+}
+
+inline void notePendingEventError(ErrorCode code) {
+  ErrorCode &pending = pendingEventError();
+  if (pending == ErrorCode::OK)
+    pending = code;
+}
+
+} // namespace detail
+
 } // namespace fusilli
 
 // Macros for logging and error handling
@@ -366,19 +396,41 @@ inline ConditionalStreamer &getLogger() {
 #define FUSILLI_COLOR_YELLOW "\033[33m"
 #define FUSILLI_COLOR_RESET "\033[0m"
 
-#define FUSILLI_LOG(X) fusilli::getLogger() << X
-#define FUSILLI_LOG_ENDL(X) fusilli::getLogger() << X << std::endl
+// Logging macros, statements evaluating `X` (a chain of `<<` operands) only
+// when logging is enabled, see `shouldLog()`.
+#define FUSILLI_LOG(X)                                                         \
+  do {                                                                         \
+    if (fusilli::shouldLog())                                                  \
+      fusilli::getLogger() << X;                                               \
+  } while (false)
+#define FUSILLI_LOG_ENDL(X)                                                    \
+  do {                                                                         \
+    if (fusilli::shouldLog())                                                  \
+      fusilli::getLogger() << X << std::endl;                                  \
+  } while (false)
 #define FUSILLI_LOG_LABEL_RED(X)                                               \
-  fusilli::getLogger() << FUSILLI_COLOR_RED << "[FUSILLI] " << X               \
-                       << FUSILLI_COLOR_RESET
+  do {                                                                         \
+    if (fusilli::shouldLog())                                                  \
+      fusilli::getLogger() << FUSILLI_COLOR_RED << "[FUSILLI] " << X           \
+                           << FUSILLI_COLOR_RESET;                             \
+  } while (false)
 #define FUSILLI_LOG_LABEL_GREEN(X)                                             \
-  fusilli::getLogger() << FUSILLI_COLOR_GREEN << "[FUSILLI] " << X             \
-                       << FUSILLI_COLOR_RESET
+  do {                                                                         \
+    if (fusilli::shouldLog())                                                  \
+      fusilli::getLogger() << FUSILLI_COLOR_GREEN << "[FUSILLI] " << X         \
+                           << FUSILLI_COLOR_RESET;                             \
+  } while (false)
 #define FUSILLI_LOG_LABEL_YELLOW(X)                                            \
-  fusilli::getLogger() << FUSILLI_COLOR_YELLOW << "[FUSILLI] " << X            \
-                       << FUSILLI_COLOR_RESET
+  do {                                                                         \
+    if (fusilli::shouldLog())                                                  \
+      fusilli::getLogger() << FUSILLI_COLOR_YELLOW << "[FUSILLI] " << X        \
+                           << FUSILLI_COLOR_RESET;                             \
+  } while (false)
 #define FUSILLI_LOG_LABEL_ENDL(X)                                              \
-  fusilli::getLogger() << "[FUSILLI] " << X << std::endl
+  do {                                                                         \
+    if (fusilli::shouldLog())                                                  \
+      fusilli::getLogger() << "[FUSILLI] " << X << std::endl;                  \
+  } while (false)
 
 #define FUSILLI_RETURN_ERROR_IF(cond, retval, message)                         \
   do {                                                                         \
@@ -389,6 +441,7 @@ inline ConditionalStreamer &getLogger() {
         FUSILLI_LOG_LABEL_RED("ERROR: ");                                      \
       FUSILLI_LOG_ENDL(retval << ": " << message << ": (" << #cond ") at "     \
                               << __FILE__ << ":" << __LINE__);                 \
+      fusilli::detail::notePendingEventError(retval);                          \
       return error(retval, message);                                           \
     }                                                                          \
   } while (false)
@@ -410,6 +463,7 @@ inline ConditionalStreamer &getLogger() {
     if (isError(_error)) {                                                     \
       FUSILLI_LOG_LABEL_RED("ERROR: " << _error << " ");                       \
       FUSILLI_LOG_ENDL(#expr << " at " << __FILE__ << ":" << __LINE__);        \
+      fusilli::detail::notePendingEventError(_error.getCode());                \
       return _error;                                                           \
     }                                                                          \
   } while (false)
@@ -419,7 +473,9 @@ inline ConditionalStreamer &getLogger() {
   if (isError(errorOr)) {                                                      \
     FUSILLI_LOG_LABEL_RED("ERROR: " << errorOr << " ");                        \
     FUSILLI_LOG_ENDL(#expr << " at " << __FILE__ << ":" << __LINE__);          \
-    return fusilli::ErrorObject(errorOr);                                      \
+    fusilli::ErrorObject errorObject(errorOr);                                 \
+    fusilli::detail::notePendingEventError(errorObject.getCode());             \
+    return errorObject;                                                        \
   }                                                                            \
   var = std::move(*errorOr);
 
@@ -0,0 +1,162 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file provides a cross-platform read-only memory-mapped file utility.
+//
+// The MappedFile class maps the contents of a file into the address space of
+// the process so they can be used in place without reading them into a heap
+// buffer. The implementation is selected at compile time based on the target
+// platform:
+// - Linux (glibc) systems: Uses open/mmap/munmap
+// - Windows: Uses CreateFile/CreateFileMapping/MapViewOfFile
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_MAPPED_FILE_H
+#define FUSILLI_SUPPORT_MAPPED_FILE_H
+
+#include "fusilli/support/logging.h"
+#include "fusilli/support/target_platform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <utility>
+
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fusilli {
+
+// MappedFile is a read-only view of a file mapped into memory. Pages are
+// backed by the file (and shared with other mappings of it) rather than by
+// anonymous memory, so mapping large artifacts does not grow the resident set
+// size of the process until, and only for as long as, they are touched.
+//
+// The file must not be truncated or rewritten in place while it is mapped.
+// Removing or atomically replacing it (rename over it) is fine on POSIX
+// systems.
+//
+// Usage:
+//   FUSILLI_ASSIGN_OR_RETURN(MappedFile file, MappedFile::open(path));
+//   std::span<const uint8_t> bytes = file.bytes();
+//
+class MappedFile {
+public:
+  // Maps the whole file at `path` read-only. Empty files yield an empty view
+  // without creating a mapping.
+  static ErrorOr<MappedFile> open(const std::filesystem::path &path) {
+    MappedFile file;
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+    HANDLE fileHandle =
+        CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    FUSILLI_RETURN_ERROR_IF(fileHandle == INVALID_HANDLE_VALUE,
+                            ErrorCode::FileSystemFailure,
+                            "Failed to open file: " + path.string());
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size)) {
+      CloseHandle(fileHandle);
+      return error(ErrorCode::FileSystemFailure,
+                   "Failed to get file size: " + path.string());
+    }
+    if (size.QuadPart > 0) {
+      HANDLE mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY,
+                                          0, 0, nullptr);
+      CloseHandle(fileHandle);
+      FUSILLI_RETURN_ERROR_IF(mapping == nullptr, ErrorCode::FileSystemFailure,
+                              "Failed to map file: " + path.string());
+      void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+      FUSILLI_RETURN_ERROR_IF(data == nullptr, ErrorCode::FileSystemFailure,
+                              "Failed to map file: " + path.string());
+      file.data_ = static_cast<const uint8_t *>(data);
+      file.size_ = static_cast<size_t>(size.QuadPart);
+    } else {
+      CloseHandle(fileHandle);
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    FUSILLI_RETURN_ERROR_IF(fd < 0, ErrorCode::FileSystemFailure,
+                            "Failed to open file: " + path.string());
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      ::close(fd);
+      return error(ErrorCode::FileSystemFailure,
+                   "Failed to get file size: " + path.string());
+    }
+    if (st.st_size > 0) {
+      void *data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                        MAP_PRIVATE, fd, 0);
+      // The mapping keeps its own reference to the file.
+      ::close(fd);
+      FUSILLI_RETURN_ERROR_IF(data == MAP_FAILED, ErrorCode::FileSystemFailure,
+                              "Failed to map file: " + path.string());
+      file.data_ = static_cast<const uint8_t *>(data);
+      file.size_ = static_cast<size_t>(st.st_size);
+    } else {
+      ::close(fd);
+    }
+#endif
+    return ok(std::move(file));
+  }
+
+  // Non-copyable.
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // Movable.
+  MappedFile(MappedFile &&other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)) {}
+
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~MappedFile() { unmap(); }
+
+  // Returns the mapped contents of the file.
+  std::span<const uint8_t> bytes() const { return {data_, size_}; }
+
+private:
+  // Class should be constructed using the `open()` factory function.
+  MappedFile() = default;
+
+  void unmap() {
+    if (data_ == nullptr)
+      return;
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+    UnmapViewOfFile(data_);
+#else
+    munmap(const_cast<uint8_t *>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_MAPPED_FILE_H
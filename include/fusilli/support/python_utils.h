@@ -13,11 +13,15 @@
 #ifndef FUSILLI_SUPPORT_PYTHON_UTILS_H
 #define FUSILLI_SUPPORT_PYTHON_UTILS_H
 
+#include "fusilli/support/cache.h"
+#include "fusilli/support/hash.h"
+#include "fusilli/support/logging.h"
 #include "fusilli/support/process.h"
 #include "fusilli/support/target_platform.h"
 
 #include <array>
 #include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <memory>
 #include <mutex>
@@ -85,15 +89,45 @@ findInSitePackages(const std::string &relativePathPattern) {
   return std::nullopt;
 }
 
+// Builds the path of the file persisting the result of `findIreeCompilerLib()`
+// across processes. The file is keyed on the environment variables selecting
+// the Python interpreter and its site-packages, so activating another virtual
+// environment resolves the library again.
+//
+// Format: ${HOME}/.cache/fusilli/iree_compiler_lib/<environment hash>
+inline std::filesystem::path getIreeCompilerLibCachePath() {
+  Hasher hasher;
+  for (const char *var : {"PATH", "VIRTUAL_ENV", "CONDA_PREFIX", "PYTHONPATH",
+                          "PYTHONHOME", "PYTHONUSERBASE"}) {
+    const char *value = std::getenv(var);
+    hasher.update(value ? value : "");
+  }
+  return CacheFile::getCacheDir() / "iree_compiler_lib" / hasher.hexDigest();
+}
+
 // Searches for the IREE compiler library in Python site-packages.
 // Specifically looks in the iree/compiler/_mlir_libs/ subdirectory
 // where it's typically installed by pip.
+//
+// Listing site-packages spawns a Python interpreter, so the path found is
+// persisted (see `getIreeCompilerLibCachePath()`) and reused by later
+// processes for as long as the library exists there.
 inline std::optional<std::string> findIreeCompilerLib() {
   static std::mutex lock;
   std::lock_guard<std::mutex> guard(lock);
   static std::optional<std::string> libPath;
   if (libPath.has_value())
     return libPath;
+
+  std::filesystem::path cachePath = getIreeCompilerLibCachePath();
+  if (auto cached = CacheFile::open(cachePath); isOk(cached)) {
+    if (auto contents = cached->read();
+        isOk(contents) && !contents->empty() &&
+        std::filesystem::exists(*contents)) {
+      libPath = *contents;
+      return libPath;
+    }
+  }
 #if defined(FUSILLI_PLATFORM_WINDOWS)
   const char *libRelPath = "iree\\compiler\\_mlir_libs\\IREECompiler.dll";
   const char *libRelPathUnd = "iree_compiler\\_mlir_libs\\IREECompiler.dll";
@@ -104,11 +138,19 @@ inline std::optional<std::string> findIreeCompilerLib() {
 
   // Try the standard pip install location
   libPath = findInSitePackages(libRelPath);
-  if (libPath.has_value())
-    return libPath;
 
   // Try alternative locations
-  libPath = findInSitePackages(libRelPathUnd);
+  if (!libPath.has_value())
+    libPath = findInSitePackages(libRelPathUnd);
+
+  // Failing to persist the path only costs the next process the search.
+  if (libPath.has_value()) {
+    if (ErrorObject status = CacheFile::publish(cachePath, *libPath);
+        isError(status))
+      FUSILLI_LOG_LABEL_ENDL("WARNING: Failed to cache IREE compiler library "
+                             "path: "
+                             << status);
+  }
   return libPath;
 }
 
@@ -0,0 +1,243 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains RemoteKernelCache, the storage interface through which
+// kernel cache entries (see `CacheFile::getKernelCachePath()`) are shared
+// beyond the local cache directory, e.g. across the nodes of a fleet, and its
+// implementations:
+// - DirectoryRemoteKernelCache: a directory on a shared file system (or a
+//   mounted object storage bucket)
+// - CommandRemoteKernelCache: user provided shell commands, e.g. `curl` or
+//   `aws s3 cp`, for HTTP or object storage without linking a client library
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_REMOTE_KERNEL_CACHE_H
+#define FUSILLI_SUPPORT_REMOTE_KERNEL_CACHE_H
+
+#include "fusilli/support/cache.h"
+#include "fusilli/support/extras.h"
+#include "fusilli/support/logging.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace fusilli {
+
+// RemoteKernelCache is consulted by `Graph::compile()` after a miss in the
+// local kernel cache, and receives every entry the process publishes. All
+// files of an entry are transferred; entries are content-addressed, so an
+// entry stored once never needs to be updated.
+//
+// Usage:
+//   setRemoteKernelCache(
+//       std::make_shared<DirectoryRemoteKernelCache>("/mnt/shared/fusilli"));
+class RemoteKernelCache {
+public:
+  virtual ~RemoteKernelCache() = default;
+
+  // Copies the files of the entry for `key` into the existing, empty
+  // directory `dir`. Returns false if the remote does not hold the entry.
+  virtual ErrorOr<bool> fetch(const std::string &key,
+                              const std::filesystem::path &dir) = 0;
+
+  // Copies the files of the complete local entry in `entryDir` to the remote
+  // entry for `key`.
+  virtual ErrorObject store(const std::string &key,
+                            const std::filesystem::path &entryDir) = 0;
+};
+
+// Shares entries through `root`/<key>/ directories. Entries are copied to a
+// temporary directory and renamed into place, so concurrent readers (from any
+// node) never observe partial entries.
+class DirectoryRemoteKernelCache : public RemoteKernelCache {
+public:
+  explicit DirectoryRemoteKernelCache(std::filesystem::path root)
+      : root_(std::move(root)) {}
+
+  ErrorOr<bool> fetch(const std::string &key,
+                      const std::filesystem::path &dir) override {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root_ / key, ec))
+      return ok(false);
+    FUSILLI_CHECK_ERROR(copyFiles(root_ / key, dir));
+    return ok(true);
+  }
+
+  ErrorObject store(const std::string &key,
+                    const std::filesystem::path &entryDir) override {
+    std::filesystem::path remoteDir = root_ / key;
+    std::error_code ec;
+    if (std::filesystem::exists(remoteDir, ec))
+      return ok();
+    std::filesystem::path tempDir = CacheFile::getTempPath(remoteDir);
+    std::filesystem::create_directories(tempDir, ec);
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to create remote kernel cache directory: " +
+                                tempDir.string() + " - " + ec.message());
+    ErrorObject status = copyFiles(entryDir, tempDir);
+    // Another node may have stored the same entry in the meantime, which
+    // fails the rename; its entry is identical by construction.
+    if (isOk(status))
+      std::filesystem::rename(tempDir, remoteDir, ec);
+    std::error_code removeEc;
+    std::filesystem::remove_all(tempDir, removeEc);
+    return status;
+  }
+
+  // Returns the directory holding the remote entries.
+  const std::filesystem::path &getRoot() const { return root_; }
+
+private:
+  // Copies the regular files of `from` into `to`, skipping lock files and
+  // temporary files of writers in progress.
+  static ErrorObject copyFiles(const std::filesystem::path &from,
+                               const std::filesystem::path &to) {
+    std::error_code ec;
+    using DirIt = std::filesystem::directory_iterator;
+    for (DirIt it(from, ec); !ec && it != DirIt(); it.increment(ec)) {
+      std::string fileName = it->path().filename().string();
+      std::error_code fileEc;
+      if (!it->is_regular_file(fileEc) || fileName.starts_with(".") ||
+          fileName.find(".tmp.") != std::string::npos) // C++20
+        continue;
+      std::filesystem::copy_file(
+          it->path(), to / fileName,
+          std::filesystem::copy_options::overwrite_existing, fileEc);
+      FUSILLI_RETURN_ERROR_IF(fileEc, ErrorCode::FileSystemFailure,
+                              "Failed to copy " + it->path().string() + " - " +
+                                  fileEc.message());
+    }
+    FUSILLI_RETURN_ERROR_IF(ec, ErrorCode::FileSystemFailure,
+                            "Failed to list " + from.string() + " - " +
+                                ec.message());
+    return ok();
+  }
+
+  std::filesystem::path root_;
+};
+
+// Shares entries through shell commands in which `{key}` is replaced by the
+// cache key and `{dir}` by the local directory, each quoted as a single shell
+// word (see `escapeArgument()`), so placeholders must not be quoted in the
+// commands themselves. The fetch command exits with a non-zero status when
+// the remote does not hold the entry.
+//
+// Example, for an HTTP server storing entries as tarballs:
+//   fetch: curl -fsS https://cache/{key}.tar | tar -x -C {dir}
+//   store: tar -c -C {dir} . | curl -fsS -T - https://cache/{key}.tar
+class CommandRemoteKernelCache : public RemoteKernelCache {
+public:
+  CommandRemoteKernelCache(std::string fetchCommand, std::string storeCommand)
+      : fetchCommand_(std::move(fetchCommand)),
+        storeCommand_(std::move(storeCommand)) {}
+
+  ErrorOr<bool> fetch(const std::string &key,
+                      const std::filesystem::path &dir) override {
+    if (fetchCommand_.empty())
+      return ok(false);
+    int returnCode = std::system(expand(fetchCommand_, key, dir).c_str());
+    return ok(returnCode == 0);
+  }
+
+  ErrorObject store(const std::string &key,
+                    const std::filesystem::path &entryDir) override {
+    if (storeCommand_.empty())
+      return ok();
+    int returnCode = std::system(expand(storeCommand_, key, entryDir).c_str());
+    FUSILLI_RETURN_ERROR_IF(returnCode, ErrorCode::RuntimeFailure,
+                            "Remote kernel cache store command failed");
+    return ok();
+  }
+
+private:
+  static std::string expand(std::string command, const std::string &key,
+                            const std::filesystem::path &dir) {
+    auto replaceAll = [&](std::string_view placeholder,
+                          const std::string &value) {
+      for (size_t pos = command.find(placeholder); pos != std::string::npos;
+           pos = command.find(placeholder, pos + value.size()))
+        command.replace(pos, placeholder.size(), value);
+    };
+    // Quote both values: keys are passed through from callers and must not
+    // be able to inject shell syntax any more than paths.
+    replaceAll("{key}", escapeArgument(key));
+    replaceAll("{dir}", escapeArgument(dir.string()));
+    return command;
+  }
+
+  std::string fetchCommand_;
+  std::string storeCommand_;
+};
+
+namespace detail {
+
+// Remote kernel cache shared by this process and the mutex guarding it, see
+// `getRemoteKernelCache()`.
+struct RemoteKernelCacheSlot {
+  std::mutex mutex;
+  std::shared_ptr<RemoteKernelCache> remote;
+};
+
+// Returns the slot, initialized from the environment:
+// - `FUSILLI_REMOTE_CACHE_DIR`: a `DirectoryRemoteKernelCache` at that path
+// - otherwise `FUSILLI_REMOTE_CACHE_FETCH_COMMAND` and/or
+//   `FUSILLI_REMOTE_CACHE_STORE_COMMAND`: a `CommandRemoteKernelCache`
+inline RemoteKernelCacheSlot &getRemoteKernelCacheSlot() {
+  static RemoteKernelCacheSlot slot{
+      {}, []() -> std::shared_ptr<RemoteKernelCache> {
+        auto getEnv = [](const char *name) {
+          const char *envVal = std::getenv(name);
+          return std::string(envVal ? envVal : "");
+        };
+        std::string dir = getEnv("FUSILLI_REMOTE_CACHE_DIR");
+        if (!dir.empty())
+          return std::make_shared<DirectoryRemoteKernelCache>(dir);
+        std::string fetchCommand =
+            getEnv("FUSILLI_REMOTE_CACHE_FETCH_COMMAND");
+        std::string storeCommand =
+            getEnv("FUSILLI_REMOTE_CACHE_STORE_COMMAND");
+        if (!fetchCommand.empty() || !storeCommand.empty())
+          return std::make_shared<CommandRemoteKernelCache>(
+              std::move(fetchCommand), std::move(storeCommand));
+        return nullptr;
+      }()};
+  return slot;
+}
+
+} // namespace detail
+
+// Returns the remote kernel cache shared by this process, or nullptr (the
+// default) to only use the local kernel cache. Initialized from the
+// environment (see `detail::getRemoteKernelCacheSlot()`) unless overridden
+// with `setRemoteKernelCache()`. Safe to call from any thread; the returned
+// pointer keeps the cache alive across a concurrent override.
+inline std::shared_ptr<RemoteKernelCache> getRemoteKernelCache() {
+  detail::RemoteKernelCacheSlot &slot = detail::getRemoteKernelCacheSlot();
+  std::lock_guard<std::mutex> lock(slot.mutex);
+  return slot.remote;
+}
+
+// Overrides the environment with `remote`, e.g. a custom storage, or nullptr
+// to disable the remote kernel cache. Compilations in progress on other
+// threads keep the cache they started with.
+inline void setRemoteKernelCache(std::shared_ptr<RemoteKernelCache> remote) {
+  detail::RemoteKernelCacheSlot &slot = detail::getRemoteKernelCacheSlot();
+  std::lock_guard<std::mutex> lock(slot.mutex);
+  slot.remote = std::move(remote);
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_REMOTE_KERNEL_CACHE_H
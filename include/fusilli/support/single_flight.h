@@ -0,0 +1,146 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains SingleFlight, which deduplicates concurrent work on the
+// same key within a process.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_SINGLE_FLIGHT_H
+#define FUSILLI_SUPPORT_SINGLE_FLIGHT_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace fusilli {
+
+// SingleFlight lets concurrent callers doing the same work (e.g. compiling
+// graphs of identical structure) do it once: the first caller to `join()` a
+// key leads the flight and does the work, while callers joining the key
+// before it finishes wait for it and receive its result. Callers joining
+// after the flight finished start a new one, so the result is never cached
+// beyond the callers that overlapped with the work.
+//
+// Usage:
+//   SingleFlight<Result>::Ticket ticket = flights.join(key);
+//   if (!ticket.isLeader()) {
+//     if (std::shared_ptr<const Result> result = ticket.wait())
+//       return *result;
+//     // The leader gave up without a result, do the work after all.
+//   }
+//   Result result = doWork();
+//   ticket.finish([&] { return result; });
+//   return result;
+template <typename T> class SingleFlight {
+  struct Flight {
+    std::condition_variable finished;
+    bool done = false;
+    size_t waiters = 0;
+    std::shared_ptr<const T> result;
+  };
+
+public:
+  // A caller's membership in the flight for a key.
+  class Ticket {
+  public:
+    // Whether this caller leads the flight, i.e. must do the work.
+    bool isLeader() const { return leader_; }
+
+    // Blocks until the leader finishes and returns its result, or null if it
+    // finished without one. Only valid for callers not leading the flight.
+    std::shared_ptr<const T> wait() {
+      std::unique_lock<std::mutex> lock(owner_->mutex_);
+      flight_->finished.wait(lock, [&] { return flight_->done; });
+      return flight_->result;
+    }
+
+    // Completes the flight led by this caller. `share` is only called, once,
+    // if other callers wait for the result, so producing it may be costly.
+    template <typename Fn> void finish(Fn &&share) {
+      if (!leader_ || !flight_)
+        return;
+      size_t waiters = detach();
+      std::shared_ptr<const T> result;
+      if (waiters > 0)
+        result = std::make_shared<const T>(share());
+      complete(std::move(result));
+    }
+
+    // Delete copy constructors, keep move constructors. A leader destroyed
+    // without `finish()` completes the flight without a result.
+    Ticket(const Ticket &) = delete;
+    Ticket &operator=(const Ticket &) = delete;
+    Ticket(Ticket &&other) noexcept
+        : owner_(other.owner_), key_(std::move(other.key_)),
+          flight_(std::move(other.flight_)), leader_(other.leader_) {}
+    Ticket &operator=(Ticket &&) = delete;
+
+    ~Ticket() {
+      if (leader_ && flight_) {
+        detach();
+        complete(nullptr);
+      }
+    }
+
+  private:
+    friend class SingleFlight;
+
+    Ticket(SingleFlight *owner, std::string key,
+           std::shared_ptr<Flight> flight, bool leader)
+        : owner_(owner), key_(std::move(key)), flight_(std::move(flight)),
+          leader_(leader) {}
+
+    // Removes the flight from its key, so later callers start a new one, and
+    // returns the number of callers waiting for it.
+    size_t detach() {
+      std::lock_guard<std::mutex> lock(owner_->mutex_);
+      owner_->flights_.erase(key_);
+      return flight_->waiters;
+    }
+
+    void complete(std::shared_ptr<const T> result) {
+      {
+        std::lock_guard<std::mutex> lock(owner_->mutex_);
+        flight_->result = std::move(result);
+        flight_->done = true;
+      }
+      flight_->finished.notify_all();
+      flight_.reset();
+    }
+
+    SingleFlight *owner_;
+    std::string key_;
+    std::shared_ptr<Flight> flight_;
+    bool leader_;
+  };
+
+  // Joins the flight for `key`, leading a new one if none is in flight.
+  Ticket join(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = flights_.try_emplace(key);
+    if (!inserted) {
+      ++it->second->waiters;
+      return Ticket(this, key, it->second, /*leader=*/false);
+    }
+    it->second = std::make_shared<Flight>();
+    return Ticket(this, key, it->second, /*leader=*/true);
+  }
+
+private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;
+};
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_SINGLE_FLIGHT_H
@@ -0,0 +1,94 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the host-side packing of 2:4 structured-sparse matmul
+// weights (see `MatmulAttr::isSparse()`).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_SPARSITY_H
+#define FUSILLI_SUPPORT_SPARSITY_H
+
+#include "fusilli/support/logging.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fusilli {
+
+// Packed 2:4 sparse weights: the kept values [..., K/2, N] of B and the
+// position (0-3) of each within its group of four rows along K.
+template <typename T> struct Sparse24Weights {
+  std::vector<T> values;
+  std::vector<int8_t> meta;
+};
+
+// Packs the dense row-major weights `dense` [..., K, N] of a matmul B
+// operand, pruned to 2:4 sparsity along K, into the values and metadata of
+// the B and B_META tensors of a sparse matmul. Groups with fewer than two
+// non-zeros keep zeros at unused positions, so the positions of a pair are
+// always distinct. Returns an error if a group holds more than two non-zeros.
+template <typename T>
+inline ErrorOr<Sparse24Weights<T>> packSparse24(const std::vector<T> &dense,
+                                                int64_t k, int64_t n) {
+  FUSILLI_RETURN_ERROR_IF(k <= 0 || n <= 0 || k % 4 != 0,
+                          ErrorCode::InvalidAttribute,
+                          "2:4 sparse weights require a positive contraction "
+                          "dim K divisible by 4 and a positive N");
+  size_t rows = static_cast<size_t>(k), cols = static_cast<size_t>(n);
+  FUSILLI_RETURN_ERROR_IF(dense.size() % (rows * cols) != 0,
+                          ErrorCode::InvalidAttribute,
+                          "2:4 sparse weights size is not a multiple of K * N");
+
+  Sparse24Weights<T> packed;
+  packed.values.resize(dense.size() / 2);
+  packed.meta.resize(dense.size() / 2);
+  size_t batch = dense.size() / (rows * cols);
+  for (size_t b = 0; b < batch; ++b) {
+    const T *src = dense.data() + b * rows * cols;
+    size_t dst = b * rows / 2 * cols;
+    for (size_t group = 0; group < rows / 4; ++group) {
+      for (size_t col = 0; col < cols; ++col) {
+        // Positions of the non-zeros, then of the zeros filling the pair.
+        std::array<size_t, 4> order;
+        size_t kept = 0, filled = 4;
+        for (size_t pos = 0; pos < 4; ++pos) {
+          bool isZero =
+              static_cast<float>(src[(group * 4 + pos) * cols + col]) == 0.0f;
+          if (isZero)
+            order[--filled] = pos;
+          else if (kept < 2)
+            order[kept++] = pos;
+          else
+            return error(ErrorCode::InvalidAttribute,
+                         "2:4 sparse weights have more than two non-zeros in "
+                         "group " +
+                             std::to_string(group) + " of column " +
+                             std::to_string(col));
+        }
+        // Kept in increasing position order.
+        if (order[0] > order[1])
+          std::swap(order[0], order[1]);
+        for (size_t i = 0; i < 2; ++i) {
+          size_t idx = dst + (group * 2 + i) * cols + col;
+          packed.values[idx] = src[(group * 4 + order[i]) * cols + col];
+          packed.meta[idx] = static_cast<int8_t>(order[i]);
+        }
+      }
+    }
+  }
+  return ok(std::move(packed));
+}
+
+} // namespace fusilli
+
+#endif // FUSILLI_SUPPORT_SPARSITY_H
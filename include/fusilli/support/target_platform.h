@@ -29,6 +29,12 @@
 #error "Unsupported platform"
 #endif // all archs
 
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
 //==============================================================================
 // Platform-independent environment variable utilities
 //==============================================================================
@@ -53,6 +59,19 @@ inline int unsetEnv(const char *name) {
 #endif
 }
 
+//==============================================================================
+// Platform-independent process utilities
+//==============================================================================
+
+// Returns the identifier of the calling process.
+inline unsigned long getProcessId() {
+#if defined(FUSILLI_PLATFORM_WINDOWS)
+  return static_cast<unsigned long>(_getpid());
+#else
+  return static_cast<unsigned long>(getpid());
+#endif
+}
+
 } // namespace fusilli
 
 #endif // FUSILLI_SUPPORT_TARGET_PLATFORM_H
@@ -0,0 +1,79 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// This file contains the trace zone macros instrumenting the compile and
+// execute paths of Fusilli.
+//
+// Zones are emitted through IREE's tracing API, so they land on the same
+// timeline (Tracy by default, see `IREE_TRACING_PROVIDER`) as the zones of
+// the IREE runtime itself. They are compiled in when building with
+// `-DFUSILLI_ENABLE_TRACING=ON`, which also enables IREE's runtime tracing,
+// and compile to nothing otherwise.
+//
+// Usage:
+//   ErrorObject Graph::validate() {
+//     FUSILLI_TRACE_ZONE("fusilli::Graph::validate");
+//     FUSILLI_TRACE_ZONE_TEXT(getName());
+//     ...
+//   }
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef FUSILLI_SUPPORT_TRACING_H
+#define FUSILLI_SUPPORT_TRACING_H
+
+#include <iree/base/tracing.h>
+
+#include <string_view>
+
+#if defined(FUSILLI_ENABLE_TRACING) &&                                         \
+    (IREE_TRACING_FEATURES & IREE_TRACING_FEATURE_INSTRUMENTATION)
+
+namespace fusilli {
+
+namespace detail {
+
+// Ends a trace zone when leaving the scope it was begun in, so zones also
+// close on the early returns of the error macros.
+class TraceZone {
+public:
+  explicit TraceZone(iree_zone_id_t id) : id_(id) {}
+  ~TraceZone() { IREE_TRACE_ZONE_END(id_); }
+
+  void appendText(std::string_view text) const {
+    IREE_TRACE_ZONE_APPEND_TEXT(id_, text.data(), text.size());
+  }
+
+  TraceZone(const TraceZone &) = delete;
+  TraceZone &operator=(const TraceZone &) = delete;
+
+private:
+  iree_zone_id_t id_;
+};
+
+} // namespace detail
+
+} // namespace fusilli
+
+// Begins a zone named `name` (a string literal) spanning the rest of the
+// enclosing scope. At most one zone per scope.
+#define FUSILLI_TRACE_ZONE(name)                                               \
+  IREE_TRACE_ZONE_BEGIN_NAMED(fusilliTraceZoneId, name);                       \
+  const ::fusilli::detail::TraceZone fusilliTraceZone(fusilliTraceZoneId)
+
+// Attaches `text` (e.g. the graph name) to the zone of the enclosing scope.
+#define FUSILLI_TRACE_ZONE_TEXT(text) fusilliTraceZone.appendText(text)
+
+#else
+
+#define FUSILLI_TRACE_ZONE(name)
+#define FUSILLI_TRACE_ZONE_TEXT(text)
+
+#endif
+
+#endif // FUSILLI_SUPPORT_TRACING_H
@@ -0,0 +1,123 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+namespace {
+
+struct PointwiseGraph {
+  std::shared_ptr<Graph> graph;
+  std::shared_ptr<TensorAttr> x0;
+  std::shared_ptr<TensorAttr> x1;
+  std::shared_ptr<TensorAttr> y;
+};
+
+PointwiseGraph buildPointwiseAddGraph(const std::string &graphName) {
+  const std::vector<int64_t> dims = {4};
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName(graphName);
+  graph->setIODataType(DataType::Int32).setComputeDataType(DataType::Int32);
+
+  auto x0T =
+      graph->tensor(TensorAttr().setName("lhs").setDim(dims).setStride({1}));
+  auto x1T =
+      graph->tensor(TensorAttr().setName("rhs").setDim(dims).setStride({1}));
+
+  auto pointwiseAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::ADD);
+  auto yT = graph->pointwise(x0T, x1T, pointwiseAttr);
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+  return {graph, x0T, x1T, yT};
+}
+
+} // namespace
+
+TEST_CASE("AOT artifact bundle compile/load/execute round trip",
+          "[aot][graph]") {
+  std::filesystem::path bundlePath =
+      CacheFile::getPath("aot_bundle", "kernels.fusilli");
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup = ScopeExit(
+      [&] { std::filesystem::remove_all(bundlePath.parent_path()); });
+
+  // Build Step: compile every graph the application needs and write them all
+  // to a single bundle file to ship with it.
+  {
+    auto compileGraph = buildPointwiseAddGraph("aot_bundle_compile_graph");
+    ArtifactBundleWriter writer;
+    FUSILLI_REQUIRE_OK(writer.compileAndAdd(*compileGraph.graph,
+                                            kDefaultBackend));
+    REQUIRE(writer.size() == 1);
+    FUSILLI_REQUIRE_OK(writer.write(bundlePath));
+  }
+
+  // Deploy Phase: map the bundle once and load graphs from it by their
+  // structural fingerprint, without invoking the compiler.
+  FUSILLI_REQUIRE_ASSIGN(ArtifactBundle bundle,
+                         ArtifactBundle::open(bundlePath));
+  REQUIRE(bundle.size() == 1);
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  // Graph names do not participate in the lookup.
+  auto runtimeGraph = buildPointwiseAddGraph("aot_bundle_runtime_graph");
+  FUSILLI_REQUIRE_OK(bundle.load(*runtimeGraph.graph, handle));
+
+  // Many graphs load concurrently at startup.
+  auto startupGraph1 = buildPointwiseAddGraph("aot_bundle_startup_graph_1");
+  auto startupGraph2 = buildPointwiseAddGraph("aot_bundle_startup_graph_2");
+  std::vector<Graph *> startupGraphs = {startupGraph1.graph.get(),
+                                        startupGraph2.graph.get()};
+  for (ErrorObject &status : bundle.loadAll(startupGraphs, handle))
+    FUSILLI_REQUIRE_OK(status);
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto x0Buf,
+      allocateBufferOfType(handle, runtimeGraph.x0, DataType::Int32, 2));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto x1Buf,
+      allocateBufferOfType(handle, runtimeGraph.x1, DataType::Int32, 3));
+  FUSILLI_REQUIRE_ASSIGN(auto yBuf, allocateBufferOfType(handle, runtimeGraph.y,
+                                                         DataType::Int32, 0));
+
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {runtimeGraph.x0, x0Buf},
+          {runtimeGraph.x1, x1Buf},
+          {runtimeGraph.y, yBuf},
+      };
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize,
+                         runtimeGraph.graph->getWorkspaceSize());
+  REQUIRE(workspaceSize.has_value());
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  FUSILLI_REQUIRE_OK(
+      runtimeGraph.graph->execute(handle, variantPack, workspace));
+
+  std::vector<int> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == 5);
+}
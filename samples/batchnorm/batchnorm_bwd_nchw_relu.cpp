@@ -0,0 +1,110 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "batchnorm_utils.h"
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Batch normalization; backward with ReLU; NCHW layout; scale, bias",
+          "[batchnorm][graph]") {
+  constexpr int64_t n = 2, c = 4, h = 8, w = 8;
+  constexpr float eps = 1e-5f;
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("batchnorm_bwd_sample_nchw_relu");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto tensor = [&](const std::string &name) {
+    return graph->tensor(TensorAttr()
+                             .setName(name)
+                             .setDim({n, c, h, w})
+                             .setStride({c * h * w, h * w, w, 1})); // NCHW
+  };
+  auto dyT = tensor("dy");
+  auto xT = tensor("x");
+  auto yT = tensor("y");
+
+  // Shape and strides will be inferred later in inferPropertiesNode()
+  auto sT = graph->tensor(TensorAttr().setName("scale"));
+  auto mT = graph->tensor(TensorAttr().setName("saved_mean"));
+  auto vT = graph->tensor(TensorAttr().setName("saved_inv_variance"));
+
+  // The forward output Y went through a ReLU, whose backward is fused in.
+  auto batchnormBwdAttr = BatchnormBwdAttr().setY(yT).setName("batchnorm_bwd");
+  auto [dxT, dsT, dbT] =
+      graph->batchnormBackward(dyT, xT, sT, mT, vT, batchnormBwdAttr);
+
+  dxT->setName("dx").setOutput(true);
+  dsT->setName("dscale").setOutput(true);
+  dbT->setName("dbias").setOutput(true);
+
+  // Validate, infer missing properties
+  FUSILLI_REQUIRE_OK(graph->validate());
+
+  // Create handle for the target backend and compile.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  auto t = batchnorm_utils::generateIOTensorsForBackward(n, c, h * w, eps);
+
+  FUSILLI_REQUIRE_ASSIGN(auto dyBuf, allocateBufferOfType(handle, dyT, t.dy));
+  FUSILLI_REQUIRE_ASSIGN(auto xBuf, allocateBufferOfType(handle, xT, t.x));
+  FUSILLI_REQUIRE_ASSIGN(auto yBuf, allocateBufferOfType(handle, yT, t.y));
+  FUSILLI_REQUIRE_ASSIGN(auto sBuf, allocateBufferOfType(handle, sT, t.scale));
+  FUSILLI_REQUIRE_ASSIGN(auto mBuf,
+                         allocateBufferOfType(handle, mT, t.savedMean));
+  FUSILLI_REQUIRE_ASSIGN(auto vBuf,
+                         allocateBufferOfType(handle, vT, t.savedInvVariance));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dxBuf, allocateBufferOfType(handle, dxT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dsBuf, allocateBufferOfType(handle, dsT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dbBuf, allocateBufferOfType(handle, dbT, DataType::Float, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {dyT, dyBuf}, {xT, xBuf},   {yT, yBuf},   {sT, sBuf},   {mT, mBuf},
+          {vT, vBuf},   {dxT, dxBuf}, {dsT, dsBuf}, {dbT, dbBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<float> dxVals, dsVals, dbVals;
+  FUSILLI_REQUIRE_OK(dxBuf->read(handle, dxVals));
+  FUSILLI_REQUIRE_OK(dsBuf->read(handle, dsVals));
+  FUSILLI_REQUIRE_OK(dbBuf->read(handle, dbVals));
+
+  REQUIRE(dxVals.size() == t.dx.size());
+  REQUIRE(dsVals.size() == t.dscale.size());
+  REQUIRE(dbVals.size() == t.dbias.size());
+  constexpr float tolerance = 1e-4f;
+  for (size_t i = 0; i < dxVals.size(); ++i)
+    REQUIRE(std::abs(dxVals[i] - t.dx[i]) < tolerance);
+  for (size_t i = 0; i < dsVals.size(); ++i) {
+    REQUIRE(std::abs(dsVals[i] - t.dscale[i]) < tolerance);
+    REQUIRE(std::abs(dbVals[i] - t.dbias[i]) < tolerance);
+  }
+}
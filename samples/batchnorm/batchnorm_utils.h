@@ -100,6 +100,84 @@ generateNchwForTrainForward(int64_t n, int64_t c, int64_t h, int64_t w,
   return {inputVals, expectedVals, savedMeanVals, savedInvVarVals};
 }
 
+// Inputs and expected gradients of the BatchNorm backward node with a fused
+// ReLU backward, in NCHW physical memory order.
+struct BackwardTensors {
+  std::vector<float> x, y, dy, scale, savedMean, savedInvVariance;
+  std::vector<float> dx, dscale, dbias;
+};
+
+// Generates inputs and expected gradients for BatchNorm backward with a fused
+// ReLU backward, over `hw` spatial elements per channel. The inputs are
+// sinusoids so that the gradients do not cancel out, Y is the forward output
+// (with a zero bias, so about half of it is masked by the ReLU), and the saved
+// statistics and gradients are computed on the host in double precision. With
+// g = DY where Y > 0 (else 0), xhat = (x - mean) * inv_variance and M = N*HW:
+//   dbias = sum(g),  dscale = sum(g * xhat),
+//   dx = scale * inv_variance * (g - dbias / M - xhat * dscale / M)
+inline BackwardTensors generateIOTensorsForBackward(int64_t n, int64_t c,
+                                                    int64_t hw, float eps) {
+  BackwardTensors t;
+  int64_t size = n * c * hw;
+  t.x.resize(size);
+  t.y.resize(size);
+  t.dy.resize(size);
+  t.dx.resize(size);
+  t.scale.resize(c);
+  t.savedMean.resize(c);
+  t.savedInvVariance.resize(c);
+  t.dscale.resize(c);
+  t.dbias.resize(c);
+  for (int64_t i = 0; i < size; ++i) {
+    t.x[i] = std::sin(0.37f * static_cast<float>(i)) + 0.1f;
+    t.dy[i] = std::cos(0.11f * static_cast<float>(i));
+  }
+
+  auto index = [&](int64_t b, int64_t ch, int64_t j) {
+    return (b * c + ch) * hw + j;
+  };
+  double count = static_cast<double>(n * hw);
+  for (int64_t ch = 0; ch < c; ++ch) {
+    t.scale[ch] = 0.5f + 0.25f * static_cast<float>(ch);
+    double mean = 0.0, var = 0.0;
+    for (int64_t b = 0; b < n; ++b)
+      for (int64_t j = 0; j < hw; ++j)
+        mean += t.x[index(b, ch, j)];
+    mean /= count;
+    for (int64_t b = 0; b < n; ++b)
+      for (int64_t j = 0; j < hw; ++j)
+        var += (t.x[index(b, ch, j)] - mean) * (t.x[index(b, ch, j)] - mean);
+    var /= count;
+    double invStd = 1.0 / std::sqrt(var + eps);
+    t.savedMean[ch] = static_cast<float>(mean);
+    t.savedInvVariance[ch] = static_cast<float>(invStd);
+
+    double dbias = 0.0, dscale = 0.0;
+    for (int64_t b = 0; b < n; ++b) {
+      for (int64_t j = 0; j < hw; ++j) {
+        int64_t i = index(b, ch, j);
+        double xhat = (t.x[i] - mean) * invStd;
+        t.y[i] = static_cast<float>(t.scale[ch] * xhat);
+        double g = t.y[i] > 0.0f ? t.dy[i] : 0.0;
+        dbias += g;
+        dscale += g * xhat;
+      }
+    }
+    t.dbias[ch] = static_cast<float>(dbias);
+    t.dscale[ch] = static_cast<float>(dscale);
+    for (int64_t b = 0; b < n; ++b) {
+      for (int64_t j = 0; j < hw; ++j) {
+        int64_t i = index(b, ch, j);
+        double xhat = (t.x[i] - mean) * invStd;
+        double g = t.y[i] > 0.0f ? t.dy[i] : 0.0;
+        double centered = g - dbias / count - xhat * dscale / count;
+        t.dx[i] = static_cast<float>(t.scale[ch] * invStd * centered);
+      }
+    }
+  }
+  return t;
+}
+
 } // namespace fusilli::batchnorm_utils
 
 #endif // FUSILLI_SAMPLES_BATCHNORM_BATCHNORM_UTILS_H
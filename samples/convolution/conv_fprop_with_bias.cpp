@@ -61,6 +61,10 @@ TEST_CASE("Convolution fprop; X (NHWC), W (KRSC); 1x1 conv; no padding; bias",
     // Compile
     FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
 
+    // Check the bias stays fused into the convolution.
+    FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(
+        *graph, 1 + kContractionLayoutDispatchCount);
+
     return std::make_tuple(graph, xT, wT, bT, biasResult);
   };
 
@@ -57,6 +57,10 @@ TEST_CASE("Convolution fprop; X (NHWC), W (KRSC); 1x1 conv; no padding; relu",
     // Compile
     FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
 
+    // Check the relu stays fused into the convolution.
+    FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(
+        *graph, 1 + kContractionLayoutDispatchCount);
+
     return std::make_tuple(graph, xT, wT, reluResult);
   };
 
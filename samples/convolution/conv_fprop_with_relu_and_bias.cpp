@@ -66,6 +66,10 @@ TEST_CASE(
     // Compile
     FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
 
+    // Check the bias and relu stay fused into the convolution.
+    FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(
+        *graph, 1 + kContractionLayoutDispatchCount);
+
     return std::make_tuple(graph, xT, wT, bT, reluResult);
   };
 
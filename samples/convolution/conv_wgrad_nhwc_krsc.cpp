@@ -234,3 +234,94 @@ TEST_CASE("Convolution wgrad; DY/X (NHWC), DW (KRSC); 1x1; no padding; bias",
   for (auto val : dbVals)
     REQUIRE(val == expectedDb);
 }
+
+TEST_CASE("Convolution wgrad; DY/X (NHWC), DW (KRSC); 1x1; no padding; fused "
+          "bias gradient",
+          "[conv][graph]") {
+  int64_t n = 4, c = 8, h = 8, w = 8, k = 16, r = 1, s = 1;
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("conv_wgrad_sample_nhwc_krsc_1x1_nopad_fused_bias");
+    graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+    auto dyT = graph->tensor(TensorAttr()
+                                 .setName("dy")
+                                 .setDim({n, k, h, w})
+                                 .setStride({k * h * w, 1, k * w, k})); // NHWC
+
+    auto xT = graph->tensor(TensorAttr()
+                                .setName("x")
+                                .setDim({n, c, h, w})
+                                .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+    auto wgradAttr = ConvWGradAttr()
+                         .setStride({1, 1})
+                         .setPadding({0, 0})
+                         .setDilation({1, 1})
+                         .setName("conv_wgrad");
+
+    // DW and DB [K] from the same op, reading DY once.
+    auto [dwT, dbT] = graph->convWGradWithBias(dyT, xT, wgradAttr);
+    dwT->setName("dw").setOutput(true).setDim({k, c, r, s});
+    dbT->setName("db").setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, dyT, xT, dbT, dwT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  auto [graph, dyT, xT, dbT, dwT] = buildNewGraph(handle);
+
+  // Allocate input and output buffers.
+  const float inputScalar = 1.0f;
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dyBuf,
+      allocateBufferOfType(handle, dyT, DataType::Float, inputScalar));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf,
+      allocateBufferOfType(handle, xT, DataType::Float, inputScalar));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dbBuf, allocateBufferOfType(handle, dbT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dwBuf, allocateBufferOfType(handle, dwT, DataType::Float, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {dyT, dyBuf},
+          {xT, xBuf},
+          {dbT, dbBuf},
+          {dwT, dwBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph once.
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  // DW and DB: each element equals N*H*W = 256.
+  std::vector<float> dwVals;
+  FUSILLI_REQUIRE_OK(dwBuf->read(handle, dwVals));
+  const float expectedDw =
+      static_cast<float>(n * h * w) * inputScalar * inputScalar;
+  for (auto val : dwVals)
+    REQUIRE(val == expectedDw);
+
+  std::vector<float> dbVals;
+  FUSILLI_REQUIRE_OK(dbBuf->read(handle, dbVals));
+  REQUIRE(dbVals.size() == static_cast<size_t>(k));
+  const float expectedDb = static_cast<float>(n * h * w) * inputScalar;
+  for (auto val : dbVals)
+    REQUIRE(val == expectedDb);
+}
@@ -69,8 +69,9 @@ TEST_CASE("Custom op: compose built-in pointwise add with custom negate",
 
     auto outs = graph->customOp({pwOut}, negAttr);
 
-    // IMPORTANT: Unlike built-in ops, custom op outputs cannot be inferred.
-    // You must manually set dim, stride, and dataType on each output.
+    // IMPORTANT: Unlike built-in ops, custom op outputs are not inferred
+    // unless the attribute says how (see custom_op_inferred_outputs.cpp), so
+    // dim, stride, and dataType are set manually on each output here.
     outs[0]->setDim(dim).setStride(stride).setDataType(dt).setOutput(true);
 
     FUSILLI_REQUIRE_OK(graph->validate());
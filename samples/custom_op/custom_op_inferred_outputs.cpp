@@ -0,0 +1,199 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+// MLIR template for a custom (broadcasting) add function.
+static std::string getCustomAddMlir() {
+  return R"(
+  func.func private @{FUNC_NAME}(%arg0: {IN0_TYPE},
+                                   %arg1: {IN1_TYPE})
+                                   -> {OUT0_TYPE} {
+    %int1 = torch.constant.int 1
+    %0 = torch.aten.add.Tensor %arg0, %arg1, %int1
+        : {IN0_TYPE}, {IN1_TYPE}, !torch.int
+        -> {OUT0_TYPE}
+    return %0 : {OUT0_TYPE}
+  }
+)";
+}
+
+// MLIR template for a custom negate function.
+static std::string getCustomNegateMlir() {
+  return R"(
+  func.func private @{FUNC_NAME}(%arg0: {IN0_TYPE})
+                                    -> {OUT0_TYPE} {
+    %0 = torch.aten.neg %arg0 : {IN0_TYPE}
+        -> {OUT0_TYPE}
+    return %0 : {OUT0_TYPE}
+  }
+)";
+}
+
+// Computes -(a + bias) with two custom ops whose outputs are inferred rather
+// than set by hand: the add broadcasts its inputs, including the dynamic
+// batch dim of `a`, and the negate takes the dims of its input.
+TEST_CASE("Custom op: outputs inferred from rules",
+          "[dynamic][custom_op][graph]") {
+  const int64_t n = 4, c = 8;
+  const std::vector<int64_t> runtimeNs = {1, n};
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("custom_op_inferred_outputs")
+      .setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
+
+  auto aT = graph->tensor(TensorAttr()
+                              .setName("a")
+                              .setDim({n, c})
+                              .setDynamicDims({0})
+                              .setStride({c, 1}));
+  auto biasT =
+      graph->tensor(TensorAttr().setName("bias").setDim({1, c}).setStride(
+          {c, 1}));
+
+  CustomOpAttr addAttr;
+  addAttr.setName("my_bias_add")
+      .setMlir(getCustomAddMlir())
+      .setNumOutputs(1)
+      .setOutputBroadcastOfInputs(/*output=*/0);
+  auto sum = graph->customOp({aT, biasT}, addAttr)[0];
+
+  CustomOpAttr negAttr;
+  negAttr.setName("my_neg")
+      .setMlir(getCustomNegateMlir())
+      .setNumOutputs(1)
+      .setOutputSameAsInput(/*output=*/0, /*input=*/0);
+  auto outT = graph->customOp({sum}, negAttr)[0];
+  outT->setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+  REQUIRE(outT->getDim() == std::vector<int64_t>{n, c});
+  REQUIRE(outT->getDynamicDims() == std::vector<size_t>{0});
+  REQUIRE(outT->getDataType() == DataType::Float);
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  std::vector<float> biasData(c);
+  for (int64_t j = 0; j < c; ++j)
+    biasData[j] = static_cast<float>(100 + j);
+  FUSILLI_REQUIRE_ASSIGN(auto biasRawBuf,
+                         Buffer::allocate(handle, castToSizeT({1, c}),
+                                          biasData));
+  auto biasBuf = std::make_shared<Buffer>(std::move(biasRawBuf));
+
+  for (auto runtimeN : runtimeNs) {
+    std::vector<float> aData(runtimeN * c);
+    for (int64_t i = 0; i < runtimeN * c; ++i)
+      aData[i] = static_cast<float>(i);
+
+    FUSILLI_REQUIRE_ASSIGN(
+        auto aRawBuf,
+        Buffer::allocate(handle, castToSizeT({runtimeN, c}), aData));
+    auto aBuf = std::make_shared<Buffer>(std::move(aRawBuf));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto outRawBuf,
+        Buffer::allocate(handle, castToSizeT({runtimeN, c}),
+                         std::vector<float>(runtimeN * c, 0.0f)));
+    auto outBuf = std::make_shared<Buffer>(std::move(outRawBuf));
+
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>>
+        variantPack = {{aT, aBuf}, {biasT, biasBuf}, {outT, outBuf}};
+    FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+    FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+    FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(outBuf->read(handle, result));
+    REQUIRE(result.size() == static_cast<size_t>(runtimeN * c));
+    for (size_t i = 0; i < result.size(); ++i)
+      REQUIRE(result[i] == -(aData[i] + biasData[i % c]));
+  }
+}
+
+// The same -(a + bias) on static shapes, with the output of the add inferred
+// by a callback instead.
+TEST_CASE("Custom op: outputs inferred by a callback", "[custom_op][graph]") {
+  const int64_t n = 2, c = 4;
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("custom_op_inferred_outputs_callback")
+      .setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
+
+  auto aT =
+      graph->tensor(TensorAttr().setName("a").setDim({n, c}).setStride({c, 1}));
+  auto biasT =
+      graph->tensor(TensorAttr().setName("bias").setDim({1, c}).setStride(
+          {c, 1}));
+
+  CustomOpAttr addAttr;
+  addAttr.setName("my_bias_add")
+      .setMlir(getCustomAddMlir())
+      .setNumOutputs(1)
+      .setShapeInference(
+          [](std::span<const std::shared_ptr<TensorAttr>> ins,
+             std::span<const std::shared_ptr<TensorAttr>> outs) {
+            outs[0]
+                ->setDim(ins[0]->getDim())
+                .setStride(ins[0]->getStride())
+                .setDataType(ins[0]->getDataType());
+            return ok();
+          });
+  auto sum = graph->customOp({aT, biasT}, addAttr)[0];
+
+  CustomOpAttr negAttr;
+  negAttr.setName("my_neg")
+      .setMlir(getCustomNegateMlir())
+      .setNumOutputs(1)
+      .setOutputSameAsInput(/*output=*/0, /*input=*/0);
+  auto outT = graph->customOp({sum}, negAttr)[0];
+  outT->setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+  REQUIRE(outT->getDim() == std::vector<int64_t>{n, c});
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto aBuf, allocateBufferOfType(handle, aT, DataType::Float, 1.0));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto biasBuf, allocateBufferOfType(handle, biasT, DataType::Float, 2.0));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto outBuf, allocateBufferOfType(handle, outT, DataType::Float, 0.0));
+  const std::unordered_map<std::shared_ptr<TensorAttr>,
+                           std::shared_ptr<Buffer>>
+      variantPack = {{aT, aBuf}, {biasT, biasBuf}, {outT, outBuf}};
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(outBuf->read(handle, result));
+  REQUIRE(result.size() == static_cast<size_t>(n * c));
+  for (float val : result)
+    REQUIRE(val == -3.0f);
+}
@@ -95,3 +95,154 @@ TEST_CASE("Dynamic batch convolution fprop with zero workspace",
       REQUIRE(val == half(4.0f));
   }
 }
+
+TEST_CASE("Dynamic batch convolution fprop with shape buckets",
+          "[dynamic][conv][graph]") {
+  const int64_t n = 4, c = 4, h = 4, w = 4, k = 4;
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("dynamic_conv_fprop_nchw_kcrs_1x1_nopad_buckets");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("image")
+                              .setDim({n, c, h, w})
+                              .setDynamicDims({0})
+                              .setStride({c * h * w, h * w, w, 1}));
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("filter")
+                              .setDim({k, c, 1, 1})
+                              .setStride({c, 1, 1, 1}));
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({0, 0})
+                      .setStride({1, 1})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+  auto yT = graph->convFProp(xT, wT, convAttr);
+  yT->setDynamicDims({0}).setOutput(true);
+  FUSILLI_REQUIRE_OK(graph->validate());
+
+  // Specialize batch sizes 2 and 8; the others run the dynamic artifact.
+  auto bucket = [&](int64_t batch) {
+    return ShapeBucket{{xT, {batch, c, h, w}}, {yT, {batch, k, h, w}}};
+  };
+  graph->setShapeBuckets({bucket(2), bucket(8)});
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+  REQUIRE(graph->getSpecializationCount() == 2);
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  for (int64_t runtimeN : {1, 2, 8}) {
+    FUSILLI_LOG_LABEL_ENDL("INFO: Running runtimeN=" << runtimeN);
+    FUSILLI_REQUIRE_ASSIGN(
+        auto xRawBuf,
+        Buffer::allocate(handle, castToSizeT({runtimeN, c, h, w}),
+                         std::vector<half>(runtimeN * c * h * w, half(1.0f))));
+    auto xBuf = std::make_shared<Buffer>(std::move(xRawBuf));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto wBuf, allocateBufferOfType(handle, wT, DataType::Half, 1.0f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto yRawBuf,
+        Buffer::allocate(handle, castToSizeT({runtimeN, k, h, w}),
+                         std::vector<half>(runtimeN * k * h * w, half(0.0f))));
+    auto yBuf = std::make_shared<Buffer>(std::move(yRawBuf));
+
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>>
+        variantPack = {{xT, xBuf}, {wT, wBuf}, {yT, yBuf}};
+    FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+    REQUIRE(result.size() == static_cast<size_t>(runtimeN * k * h * w));
+    for (auto val : result)
+      REQUIRE(val == half(4.0f));
+  }
+
+  // Static dims of a bucket must match the graph.
+  graph->setShapeBuckets(
+      {ShapeBucket{{xT, {2, c + 1, h, w}}, {yT, {2, k, h, w}}}});
+  ErrorObject status = graph->compile(handle, /*remove=*/true);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("Dynamic batch convolution fprop with hot-shape specialization",
+          "[dynamic][conv][graph]") {
+  const int64_t n = 4, c = 4, h = 4, w = 4, k = 4;
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("dynamic_conv_fprop_nchw_kcrs_1x1_nopad_hot_shapes");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("image")
+                              .setDim({n, c, h, w})
+                              .setDynamicDims({0})
+                              .setStride({c * h * w, h * w, w, 1}));
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("filter")
+                              .setDim({k, c, 1, 1})
+                              .setStride({c, 1, 1, 1}));
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({0, 0})
+                      .setStride({1, 1})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+  auto yT = graph->convFProp(xT, wT, convAttr);
+  yT->setDynamicDims({0}).setOutput(true);
+  FUSILLI_REQUIRE_OK(graph->validate());
+  graph->setHotShapeThreshold(/*threshold=*/2, /*maxSpecializations=*/1);
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  REQUIRE(workspaceSize == 0);
+
+  auto run = [&](int64_t runtimeN) {
+    FUSILLI_REQUIRE_ASSIGN(
+        auto xRawBuf,
+        Buffer::allocate(handle, castToSizeT({runtimeN, c, h, w}),
+                         std::vector<half>(runtimeN * c * h * w, half(1.0f))));
+    auto xBuf = std::make_shared<Buffer>(std::move(xRawBuf));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto wBuf, allocateBufferOfType(handle, wT, DataType::Half, 1.0f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto yRawBuf,
+        Buffer::allocate(handle, castToSizeT({runtimeN, k, h, w}),
+                         std::vector<half>(runtimeN * k * h * w, half(0.0f))));
+    auto yBuf = std::make_shared<Buffer>(std::move(yRawBuf));
+
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>>
+        variantPack = {{xT, xBuf}, {wT, wBuf}, {yT, yBuf}};
+    FUSILLI_REQUIRE_OK(
+        graph->execute(handle, variantPack, /*workspace=*/nullptr));
+
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+    REQUIRE(result.size() == static_cast<size_t>(runtimeN * k * h * w));
+    for (auto val : result)
+      REQUIRE(val == half(4.0f));
+  };
+
+  // The second execution with batch size 2 starts specializing it, batch
+  // size 3 isn't hot enough and batch size 1 would exceed the limit.
+  run(2);
+  run(3);
+  run(2);
+  run(1);
+  run(1);
+  graph->waitForHotSpecializations();
+  REQUIRE(graph->getHotSpecializationCount() == 1);
+
+  // The specialization is emitted from copies of the tensors, leaving the
+  // representative dims of the graph untouched.
+  REQUIRE(xT->getDim() == std::vector<int64_t>{n, c, h, w});
+  REQUIRE(xT->isDynamicDim(0));
+  REQUIRE(yT->getDim() == std::vector<int64_t>{n, k, h, w});
+  REQUIRE(yT->isDynamicDim(0));
+  run(2);
+  run(3);
+}
@@ -0,0 +1,120 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Dynamic batch convolution fprop with a batch scheduler",
+          "[dynamic][conv][graph]") {
+  const int64_t n = 4, c = 4, h = 4, w = 4, k = 4;
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("dynamic_conv_fprop_nchw_kcrs_1x1_nopad_batch_scheduler");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("image")
+                              .setDim({n, c, h, w})
+                              .setDynamicDims({0})
+                              .setStride({c * h * w, h * w, w, 1}));
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("filter")
+                              .setDim({k, c, 1, 1})
+                              .setStride({c, 1, 1, 1}));
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({0, 0})
+                      .setStride({1, 1})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+  auto yT = graph->convFProp(xT, wT, convAttr);
+  yT->setDynamicDims({0}).setOutput(true);
+  FUSILLI_REQUIRE_OK(graph->validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, wT, DataType::Half, 1.0f));
+
+  // A deadline long enough for all requests to join the first batch.
+  BatchSchedulerOptions options;
+  options.maxBatchSize = n;
+  options.maxDelay = std::chrono::seconds(10);
+  FUSILLI_REQUIRE_ASSIGN(
+      auto scheduler,
+      BatchScheduler::create(handle, graph, {{wT, wBuf}}, options));
+
+  // Each request of batch 1 reads back the sum over channels of its input.
+  const size_t rowSize = static_cast<size_t>(c * h * w);
+  std::vector<ErrorObject> statuses(n, ok());
+  std::vector<std::vector<half>> results(n);
+  auto serve = [&](size_t i) -> ErrorObject {
+    FUSILLI_ASSIGN_OR_RETURN(BatchRequest request, scheduler->acquire());
+    FUSILLI_ASSIGN_OR_RETURN(auto xBuf, request.getBuffer(xT));
+    std::vector<half> input(rowSize, half(static_cast<float>(i + 1)));
+    FUSILLI_ASSIGN_OR_RETURN(auto upload,
+                             xBuf->writeAsync(handle, std::span(input)));
+    FUSILLI_CHECK_ERROR(upload.wait());
+    FUSILLI_CHECK_ERROR(request.submit());
+    FUSILLI_CHECK_ERROR(request.wait());
+    FUSILLI_ASSIGN_OR_RETURN(auto yBuf, request.getBuffer(yT));
+    return yBuf->read(handle, results[i]);
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < static_cast<size_t>(n); ++i)
+    threads.emplace_back([&, i] { statuses[i] = serve(i); });
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (size_t i = 0; i < static_cast<size_t>(n); ++i) {
+    FUSILLI_REQUIRE_OK(statuses[i]);
+    REQUIRE(results[i].size() == static_cast<size_t>(k * h * w));
+    for (auto val : results[i])
+      REQUIRE(val == half(static_cast<float>(c * (i + 1))));
+  }
+  REQUIRE(scheduler->getBatchCount() == 1);
+  REQUIRE(scheduler->getRequestCount() == static_cast<uint64_t>(n));
+
+  // A request that doesn't fit executes the batch being filled right away,
+  // while the next batch executes after the deadline.
+  options.maxDelay = std::chrono::milliseconds(1);
+  FUSILLI_REQUIRE_ASSIGN(
+      scheduler, BatchScheduler::create(handle, graph, {{wT, wBuf}}, options));
+  {
+    FUSILLI_REQUIRE_ASSIGN(BatchRequest first, scheduler->acquire(n - 1));
+    FUSILLI_REQUIRE_OK(first.submit());
+    FUSILLI_REQUIRE_ASSIGN(BatchRequest second, scheduler->acquire(2));
+    REQUIRE(second.getRows() == 2);
+    FUSILLI_REQUIRE_OK(first.wait());
+    FUSILLI_REQUIRE_OK(second.submit());
+    FUSILLI_REQUIRE_OK(second.wait());
+  }
+  REQUIRE(scheduler->getBatchCount() == 2);
+  REQUIRE(scheduler->getRequestCount() == 2);
+
+  // Requests are bounded by the max batch size, and shared tensors have no
+  // per-request rows.
+  REQUIRE(isError(scheduler->acquire(n + 1)));
+  {
+    FUSILLI_REQUIRE_ASSIGN(BatchRequest request, scheduler->acquire());
+    REQUIRE(isError(request.getBuffer(wT)));
+    FUSILLI_REQUIRE_OK(request.submit());
+  }
+
+  // Tensors without a dynamic batch dim must be bound to shared buffers.
+  REQUIRE(isError(BatchScheduler::create(handle, graph, {}, options)));
+}
@@ -0,0 +1,142 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+namespace {
+
+constexpr int64_t kN = 16, kC = 4, kH = 4, kW = 4, kK = 4;
+
+struct ConvGraph {
+  std::shared_ptr<Graph> graph;
+  std::shared_ptr<TensorAttr> x;
+  std::shared_ptr<TensorAttr> w;
+  std::shared_ptr<TensorAttr> y;
+};
+
+// Builds the dynamic batch 1x1 convolution executed on every device.
+ConvGraph buildConvGraph(const std::string &graphName) {
+  auto graph = std::make_shared<Graph>();
+  graph->setName(graphName);
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("image")
+                              .setDim({kN, kC, kH, kW})
+                              .setDynamicDims({0})
+                              .setStride({kC * kH * kW, kH * kW, kW, 1}));
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("filter")
+                              .setDim({kK, kC, 1, 1})
+                              .setStride({kC, 1, 1, 1}));
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({0, 0})
+                      .setStride({1, 1})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+  auto yT = graph->convFProp(xT, wT, convAttr);
+  yT->setName("result").setDynamicDims({0}).setOutput(true);
+  FUSILLI_REQUIRE_OK(graph->validate());
+  return {graph, xT, wT, yT};
+}
+
+} // namespace
+
+TEST_CASE("Dynamic batch convolution fprop split across devices",
+          "[dynamic][conv][graph]") {
+  // Each device loads its own instance of the graph, compiled ahead of time
+  // for its backend (see samples/aot/multi_backend.cpp). Without a GPU, two
+  // CPU devices still exercise the split.
+#if defined(FUSILLI_ENABLE_AMDGPU)
+  const std::vector<Backend> backends = {Backend::AMDGPU, Backend::CPU};
+#else
+  const std::vector<Backend> backends = {Backend::CPU, Backend::CPU};
+#endif
+  std::vector<Handle> handles;
+  std::vector<ConvGraph> graphs;
+  std::vector<SplitDevice> devices;
+  handles.reserve(backends.size());
+  for (size_t d = 0; d < backends.size(); ++d) {
+    auto compileGraph = buildConvGraph("dynamic_conv_fprop_split_compile");
+    FUSILLI_REQUIRE_ASSIGN(auto artifact,
+                           compileGraph.graph->compileToArtifact(
+                               backends[d], /*remove=*/true));
+    FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(backends[d]));
+    handles.push_back(std::move(handle));
+    graphs.push_back(
+        buildConvGraph("dynamic_conv_fprop_split_" + std::to_string(d)));
+    FUSILLI_REQUIRE_OK(
+        graphs[d].graph->loadFromArtifact(handles[d], artifact));
+    FUSILLI_REQUIRE_ASSIGN(auto wBuf,
+                           allocateBufferOfType(handles[d], graphs[d].w,
+                                                DataType::Half, 1.0f));
+    devices.push_back({&handles[d], graphs[d].graph, {{graphs[d].w, wBuf}}});
+  }
+
+  SplitExecutorOptions options;
+  options.maxBatchSize = kN;
+  FUSILLI_REQUIRE_ASSIGN(SplitExecutor executor,
+                         SplitExecutor::create(std::move(devices), options));
+
+  // Until every device was measured, batches are split evenly.
+  std::vector<int64_t> split = executor.getSplit(kN);
+  REQUIRE(split == std::vector<int64_t>{kN / 2, kN / 2});
+
+  // Row i of each batch holds i + 1, so output row i holds c * (i + 1).
+  const ConvGraph &first = graphs.front();
+  const size_t inRow = static_cast<size_t>(kC * kH * kW);
+  const size_t outRow = static_cast<size_t>(kK * kH * kW);
+  for (int64_t rows : {kN, kN - 3, int64_t(1)}) {
+    std::vector<half> input(inRow * static_cast<size_t>(rows));
+    for (size_t i = 0; i < input.size(); ++i)
+      input[i] = half(static_cast<float>(i / inRow + 1));
+    std::vector<half> output(outRow * static_cast<size_t>(rows));
+    FUSILLI_REQUIRE_OK(executor.execute(
+        rows, {{first.x, std::as_bytes(std::span(input))}},
+        {{first.y, std::as_writable_bytes(std::span(output))}}));
+    for (size_t i = 0; i < output.size(); ++i)
+      REQUIRE(output[i] == half(static_cast<float>(kC * (i / outRow + 1))));
+
+    // Later batches are split by the measured throughputs.
+    split = executor.getSplit(rows);
+    REQUIRE(std::accumulate(split.begin(), split.end(), int64_t(0)) == rows);
+  }
+  REQUIRE(executor.getBatchCount() == 3);
+  for (double throughput : executor.getThroughputs())
+    REQUIRE(throughput > 0);
+
+  // Batches are bounded by the max batch size, and must hold `rows` rows of
+  // every batched tensor.
+  std::vector<half> input(inRow * static_cast<size_t>(kN + 1));
+  std::vector<half> output(outRow * static_cast<size_t>(kN + 1));
+  REQUIRE(isError(executor.execute(
+      kN + 1, {{first.x, std::as_bytes(std::span(input))}},
+      {{first.y, std::as_writable_bytes(std::span(output))}})));
+  REQUIRE(isError(executor.execute(
+      kN, {{first.x, std::as_bytes(std::span(input))}},
+      {{first.y, std::as_writable_bytes(std::span(output))}})));
+  std::span<const half> rowsIn =
+      std::span(input).first(inRow * static_cast<size_t>(kN));
+  REQUIRE(isError(
+      executor.execute(kN, {{first.x, std::as_bytes(rowsIn)}}, {})));
+
+  // Tensors without a dynamic batch dim must be bound to shared buffers.
+  REQUIRE(isError(SplitExecutor::create(
+      {{&handles.front(), graphs.front().graph, {}}}, options)));
+}
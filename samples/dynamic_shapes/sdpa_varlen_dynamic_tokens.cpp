@@ -0,0 +1,145 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Dynamic token count varlen SDPA f16", "[dynamic][sdpa][graph]") {
+  const int64_t batch = 3;
+  const int64_t heads = 4;
+  const int64_t representativeTotal = 64;
+  const int64_t headDim = 32;
+  // Sequence lengths of the three packed sequences for every run.
+  const std::vector<std::vector<int32_t>> runtimeSeqLens = {
+      {4, 4, 8}, {5, 11, 16}, {1, 30, 33}};
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("dynamic_sdpa_varlen")
+      .setIODataType(DataType::Half)
+      .setIntermediateDataType(DataType::Half);
+
+  // Packed [total_tokens, heads, head_dim] with a dynamic token count.
+  std::vector<int64_t> dims = {representativeTotal, heads, headDim};
+  std::vector<int64_t> stride =
+      generateStrideFromDim(dims, getContiguousStrideOrder(dims.size()));
+
+  auto qT = graph->tensor(
+      TensorAttr().setName("q").setDim(dims).setDynamicDims({0}).setStride(
+          stride));
+  auto kT = graph->tensor(
+      TensorAttr().setName("k").setDim(dims).setDynamicDims({0}).setStride(
+          stride));
+  auto vT = graph->tensor(
+      TensorAttr().setName("v").setDim(dims).setDynamicDims({0}).setStride(
+          stride));
+  auto cuSeqlensT = graph->tensor(TensorAttr()
+                                      .setName("cu_seqlens")
+                                      .setDim({batch + 1})
+                                      .setStride({1})
+                                      .setDataType(DataType::Int32));
+
+  // Queries and keys share their sequence boundaries.
+  SdpaAttr sdpaAttr;
+  sdpaAttr.setName("sdpa")
+      .setCU_SEQLENS_Q(cuSeqlensT)
+      .setCU_SEQLENS_KV(cuSeqlensT)
+      .setIsCausal(true);
+
+  auto oT = graph->sdpa(qT, kT, vT, /*mask=*/nullptr, sdpaAttr);
+  oT->setDynamicDims({0}).setOutput(true);
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  for (const std::vector<int32_t> &seqLens : runtimeSeqLens) {
+    std::vector<int32_t> cuSeqlens = {0};
+    for (int32_t len : seqLens)
+      cuSeqlens.push_back(cuSeqlens.back() + len);
+    int64_t total = cuSeqlens.back();
+    FUSILLI_LOG_LABEL_ENDL("INFO: Running total tokens=" << total);
+
+    std::vector<int64_t> runtimeDims = {total, heads, headDim};
+    size_t tokenSize = static_cast<size_t>(heads * headDim);
+    size_t runtimeSize = static_cast<size_t>(total) * tokenSize;
+
+    // Every token of sequence `s` carries the value `(s + 1) / 4` in V, so
+    // each output token must equal the value of its own sequence if the
+    // attention stays within sequence boundaries.
+    std::vector<half> vVals(runtimeSize);
+    std::vector<float> expected(static_cast<size_t>(total));
+    for (size_t s = 0; s < seqLens.size(); ++s) {
+      float val = static_cast<float>(s + 1) * 0.25f;
+      for (int32_t t = cuSeqlens[s]; t < cuSeqlens[s + 1]; ++t) {
+        expected[t] = val;
+        for (size_t i = 0; i < tokenSize; ++i)
+          vVals[t * tokenSize + i] = half(val);
+      }
+    }
+
+    FUSILLI_REQUIRE_ASSIGN(
+        auto qRawBuf,
+        Buffer::allocate(handle, castToSizeT(runtimeDims),
+                         std::vector<half>(runtimeSize, half(0.01f))));
+    auto qBuf = std::make_shared<Buffer>(std::move(qRawBuf));
+
+    FUSILLI_REQUIRE_ASSIGN(
+        auto kRawBuf,
+        Buffer::allocate(handle, castToSizeT(runtimeDims),
+                         std::vector<half>(runtimeSize, half(0.01f))));
+    auto kBuf = std::make_shared<Buffer>(std::move(kRawBuf));
+
+    FUSILLI_REQUIRE_ASSIGN(
+        auto vRawBuf,
+        Buffer::allocate(handle, castToSizeT(runtimeDims), vVals));
+    auto vBuf = std::make_shared<Buffer>(std::move(vRawBuf));
+
+    FUSILLI_REQUIRE_ASSIGN(
+        auto cuRawBuf, Buffer::allocate(handle, castToSizeT({batch + 1}),
+                                        cuSeqlens));
+    auto cuBuf = std::make_shared<Buffer>(std::move(cuRawBuf));
+
+    FUSILLI_REQUIRE_ASSIGN(
+        auto oRawBuf,
+        Buffer::allocate(handle, castToSizeT(runtimeDims),
+                         std::vector<half>(runtimeSize, half(0.0f))));
+    auto oBuf = std::make_shared<Buffer>(std::move(oRawBuf));
+
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>>
+        variantPack = {{qT, qBuf},
+                       {kT, kBuf},
+                       {vT, vBuf},
+                       {cuSeqlensT, cuBuf},
+                       {oT, oBuf}};
+
+    FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+    FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+
+    FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(oBuf->read(handle, result));
+    REQUIRE(result.size() == runtimeSize);
+    for (size_t i = 0; i < runtimeSize; ++i)
+      REQUIRE(std::abs(static_cast<float>(result[i]) -
+                       expected[i / tokenSize]) < 1e-2f);
+  }
+}
@@ -81,6 +81,77 @@ generateIOTensorsForTrainForward(int64_t n, int64_t c, int64_t h, int64_t w,
                          expectedVariances);
 }
 
+// Inputs and expected gradients of the LayerNorm backward node over `n`
+// batches of `size` elements each, with a per-element scale.
+struct BackwardTensors {
+  std::vector<float> x, dy, scale, mean, invVariance;
+  std::vector<float> dx, dscale, dbias;
+};
+
+// Generates inputs and expected gradients for LayerNorm node backward. The
+// inputs are sinusoids so that the gradients do not cancel out, and the saved
+// statistics and gradients are computed on the host in double precision:
+//   xhat = (x - mean) * inv_variance, g = dy * scale
+//   dx = inv_variance * (g - mean(g) - xhat * mean(g * xhat))
+//   dscale = sum_batch(dy * xhat), dbias = sum_batch(dy)
+inline BackwardTensors generateIOTensorsForBackward(int64_t n, int64_t size,
+                                                    float eps) {
+  BackwardTensors t;
+  t.x.resize(n * size);
+  t.dy.resize(n * size);
+  t.scale.resize(size);
+  t.mean.resize(n);
+  t.invVariance.resize(n);
+  t.dx.resize(n * size);
+  t.dscale.assign(size, 0.0f);
+  t.dbias.assign(size, 0.0f);
+  for (int64_t i = 0; i < n * size; ++i) {
+    t.x[i] = std::sin(0.37f * static_cast<float>(i)) + 0.1f;
+    t.dy[i] = std::cos(0.11f * static_cast<float>(i));
+  }
+  for (int64_t j = 0; j < size; ++j)
+    t.scale[j] = 0.5f + 0.01f * static_cast<float>(j % 64);
+
+  std::vector<double> dscale(size, 0.0), dbias(size, 0.0);
+  for (int64_t b = 0; b < n; ++b) {
+    const float *x = t.x.data() + b * size;
+    const float *dy = t.dy.data() + b * size;
+    double mean = 0.0, var = 0.0;
+    for (int64_t j = 0; j < size; ++j)
+      mean += x[j];
+    mean /= static_cast<double>(size);
+    for (int64_t j = 0; j < size; ++j)
+      var += (x[j] - mean) * (x[j] - mean);
+    var /= static_cast<double>(size);
+    double invStd = 1.0 / std::sqrt(var + eps);
+    t.mean[b] = static_cast<float>(mean);
+    t.invVariance[b] = static_cast<float>(invStd);
+
+    double gMean = 0.0, gXhatMean = 0.0;
+    for (int64_t j = 0; j < size; ++j) {
+      double xhat = (x[j] - mean) * invStd;
+      double g = dy[j] * t.scale[j];
+      gMean += g;
+      gXhatMean += g * xhat;
+      dscale[j] += dy[j] * xhat;
+      dbias[j] += dy[j];
+    }
+    gMean /= static_cast<double>(size);
+    gXhatMean /= static_cast<double>(size);
+    for (int64_t j = 0; j < size; ++j) {
+      double xhat = (x[j] - mean) * invStd;
+      double g = dy[j] * t.scale[j];
+      t.dx[b * size + j] =
+          static_cast<float>(invStd * (g - gMean - xhat * gXhatMean));
+    }
+  }
+  for (int64_t j = 0; j < size; ++j) {
+    t.dscale[j] = static_cast<float>(dscale[j]);
+    t.dbias[j] = static_cast<float>(dbias[j]);
+  }
+  return t;
+}
+
 } // namespace fusilli::layernorm_utils
 
 #endif // FUSILLI_SAMPLES_LAYERNORM_LAYERNORM_UTILS_H
@@ -55,6 +55,10 @@ TEST_CASE("Matrix multiplication with bias; A (M, K), B (K, N), bias (1, N); "
     // Compile
     FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
 
+    // Check the bias stays fused into the matmul.
+    FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(
+        *graph, 1 + kContractionLayoutDispatchCount);
+
     return std::make_tuple(graph, aT, bT, biasT, resultT);
   };
 
@@ -151,6 +155,10 @@ TEST_CASE("Matrix multiplication with bias; A (M, K), B^T (N, K), bias (1, N); "
     // Compile
     FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
 
+    // Check the bias stays fused into the matmul.
+    FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(
+        *graph, 1 + kContractionLayoutDispatchCount);
+
     return std::make_tuple(graph, aT, bT, biasT, resultT);
   };
 
@@ -0,0 +1,132 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Matrix multiplication with fused epilogue; A (M, K), B (K, N), "
+          "bias (1, N), residual (M, N); relu(alpha * A @ B + bias) + "
+          "beta * residual",
+          "[matmul][graph][epilogue]") {
+  int64_t m = 64, k = 128, n = 256;
+  constexpr float alpha = 0.5f, beta = 2.0f;
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("matmul_basic_with_epilogue_sample");
+    graph->setIODataType(DataType::Float)
+        .setComputeDataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float);
+
+    auto aT = graph->tensor(
+        TensorAttr().setName("matrix_a").setDim({m, k}).setStride({k, 1}));
+
+    auto bT = graph->tensor(
+        TensorAttr().setName("matrix_b").setDim({k, n}).setStride({n, 1}));
+
+    // Bias vector with shape (1, N) that broadcasts to (M, N).
+    auto biasT = graph->tensor(
+        TensorAttr().setName("bias").setDim({1, n}).setStride({n, 1}));
+
+    auto residualT = graph->tensor(
+        TensorAttr().setName("residual").setDim({m, n}).setStride({n, 1}));
+
+    auto matmulAttr = MatmulAttr()
+                          .setBIAS(biasT)
+                          .setRESIDUAL(residualT)
+                          .setActivation(PointwiseAttr::Mode::RELU_FWD)
+                          .setAlpha(alpha)
+                          .setBeta(beta)
+                          .setName("matmul");
+
+    auto resultT = graph->matmul(aT, bT, matmulAttr);
+    resultT->setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    // Check the epilogue stays fused into the matmul.
+    FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(
+        *graph, 1 + kContractionLayoutDispatchCount);
+
+    return std::make_tuple(graph, aT, bT, biasT, residualT, resultT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  // Build graph for the given handle (device), validate and compile it.
+  auto [graph, aT, bT, biasT, residualT, resultT] = buildNewGraph(handle);
+
+  // Allocate input buffers for A and B.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto aBuf, allocateBufferOfType(handle, aT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto bBuf, allocateBufferOfType(handle, bT, DataType::Float, 1.0f));
+
+  // Allocate epilogue buffers.
+  float biasValue = -60.0f, residualValue = 0.5f;
+  FUSILLI_REQUIRE_ASSIGN(
+      auto biasBuf,
+      allocateBufferOfType(handle, biasT, DataType::Float, biasValue));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto residualBuf,
+      allocateBufferOfType(handle, residualT, DataType::Float, residualValue));
+
+  // Allocate output buffer for result.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto resultBuf,
+      allocateBufferOfType(handle, resultT, DataType::Float, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {aT, aBuf},
+          {bT, bBuf},
+          {biasT, biasBuf},
+          {residualT, residualBuf},
+          {resultT, resultBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph once.
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  // Read output buffers.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(resultBuf->read(handle, result));
+
+  // Verify output.
+  // When A and B are all ones, A @ B has all elements equal to k, so the
+  // result is relu(alpha * k + bias) + beta * residual.
+  float expected =
+      std::max(alpha * static_cast<float>(k) + biasValue, 0.0f) +
+      beta * residualValue;
+  REQUIRE(result.size() == static_cast<size_t>(m * n));
+  for (size_t i = 0; i < result.size(); ++i) {
+    REQUIRE(result[i] == expected);
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Matrix multiplication; gated SwiGLU; A (M, K), B gate|up (K, 2N)",
+          "[matmul][graph]") {
+  int64_t m = 64, k = 128, n = 256;
+
+  Graph graph;
+  graph.setName("matmul_gated_swiglu_sample");
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT =
+      graph.tensor(TensorAttr().setName("x").setDim({m, k}).setStride({k, 1}));
+  auto wT = graph.tensor(TensorAttr()
+                             .setName("w_gate_up")
+                             .setDim({k, 2 * n})
+                             .setStride({2 * n, 1}));
+
+  auto matmulAttr =
+      MatmulAttr().setName("swiglu").setGate(PointwiseAttr::Mode::SWISH_FWD);
+  auto yT = graph.matmul(xT, wT, matmulAttr);
+  yT->setName("y").setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph.validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  // With X all ones, the gate columns of W at 1 / K and the up columns at
+  // 2 / K, the gate and up halves are 1 and 2, so Y = silu(1) * 2.
+  std::vector<float> wData(k * 2 * n);
+  for (int64_t row = 0; row < k; ++row)
+    for (int64_t col = 0; col < 2 * n; ++col)
+      wData[row * 2 * n + col] =
+          (col < n ? 1.0f : 2.0f) / static_cast<float>(k);
+  FUSILLI_REQUIRE_ASSIGN(Buffer wBuffer,
+                         Buffer::allocate(handle, castToSizeT({k, 2 * n}),
+                                          wData));
+  auto wBuf = std::make_shared<Buffer>(std::move(wBuffer));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, xT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {wT, wBuf},
+          {yT, yBuf},
+      };
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  FUSILLI_REQUIRE_OK(graph.execute(handle, variantPack, workspace));
+
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  REQUIRE(result.size() == static_cast<size_t>(m * n));
+  float expected = 2.0f / (1.0f + std::exp(-1.0f));
+  for (float val : result)
+    REQUIRE(val == Catch::Approx(expected).epsilon(1e-4));
+}
@@ -0,0 +1,122 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Grouped matrix multiplication; A (E, M, K), B (E, K, N), group "
+          "sizes (E); rows past each group's size are zero",
+          "[matmul][graph][grouped]") {
+  constexpr int64_t e = 4, m = 16, k = 32, n = 8;
+  // Valid rows of each group, including a full and an empty one.
+  const std::vector<int32_t> groupSizes = {16, 5, 0, 9};
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("matmul_grouped_sample");
+    graph->setIODataType(DataType::Float)
+        .setComputeDataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float);
+
+    auto aT = graph->tensor(TensorAttr()
+                                .setName("tokens")
+                                .setDim({e, m, k})
+                                .setStride({m * k, k, 1}));
+
+    auto bT = graph->tensor(TensorAttr()
+                                .setName("experts")
+                                .setDim({e, k, n})
+                                .setStride({k * n, n, 1}));
+
+    auto groupSizesT = graph->tensor(TensorAttr()
+                                         .setName("group_sizes")
+                                         .setDim({e})
+                                         .setStride({1})
+                                         .setDataType(DataType::Int32));
+
+    auto matmulAttr =
+        MatmulAttr().setGROUP_SIZES(groupSizesT).setName("matmul");
+
+    auto resultT = graph->matmul(aT, bT, matmulAttr);
+    resultT->setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, aT, bT, groupSizesT, resultT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  // Build graph for the given handle (device), validate and compile it.
+  auto [graph, aT, bT, groupSizesT, resultT] = buildNewGraph(handle);
+
+  // Allocate input buffers for A and B.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto aBuf, allocateBufferOfType(handle, aT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto bBuf, allocateBufferOfType(handle, bT, DataType::Float, 0.5f));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto groupSizesRawBuf,
+      Buffer::allocate(handle, castToSizeT({e}), groupSizes));
+  auto groupSizesBuf = std::make_shared<Buffer>(std::move(groupSizesRawBuf));
+
+  // Allocate output buffer for result, filled with garbage to check the
+  // masked rows are written.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto resultBuf,
+      allocateBufferOfType(handle, resultT, DataType::Float, -1.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {aT, aBuf},
+          {bT, bBuf},
+          {groupSizesT, groupSizesBuf},
+          {resultT, resultBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph once.
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  // Read output buffers.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(resultBuf->read(handle, result));
+
+  // Verify output.
+  // Valid rows hold k * 0.5, the rows past the size of their group are zero.
+  REQUIRE(result.size() == static_cast<size_t>(e * m * n));
+  for (size_t i = 0; i < result.size(); ++i) {
+    int64_t group = static_cast<int64_t>(i) / (m * n);
+    int64_t row = static_cast<int64_t>(i) / n % m;
+    float expected = row < groupSizes[group] ? static_cast<float>(k) * 0.5f
+                                             : 0.0f;
+    REQUIRE(result[i] == expected);
+  }
+}
@@ -0,0 +1,121 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Group-wise quantized matrix multiplication; A fp16 (M, K), B int4 "
+          "(K, N) with fp16 scales and int4 zero points (K/G, N)",
+          "[matmul][graph][int4]") {
+  // The layout of GPTQ and AWQ checkpoints: one scale and zero point per
+  // group of 128 rows of the weights and column.
+  constexpr int64_t m = 8, k = 256, n = 16, groupSize = 128;
+  constexpr int64_t groups = k / groupSize;
+
+  std::vector<int4> bData(static_cast<size_t>(k * n));
+  for (int64_t row = 0; row < k; ++row)
+    for (int64_t col = 0; col < n; ++col)
+      bData[row * n + col] = int4(static_cast<int8_t>((row + col) % 5 - 2));
+  std::vector<half> scaleData(static_cast<size_t>(groups * n));
+  std::vector<int4> zeroData(static_cast<size_t>(groups * n));
+  for (int64_t group = 0; group < groups; ++group) {
+    for (int64_t col = 0; col < n; ++col) {
+      scaleData[group * n + col] = half(static_cast<float>(1 + col % 2));
+      zeroData[group * n + col] =
+          int4(static_cast<int8_t>((group + col) % 3 - 1));
+    }
+  }
+  std::vector<half> aData(static_cast<size_t>(m * k));
+  for (int64_t row = 0; row < m; ++row)
+    for (int64_t col = 0; col < k; ++col)
+      aData[row * k + col] = half(static_cast<float>((row + col) % 2));
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_int4_group_quant_sample");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(
+      TensorAttr().setName("activations").setDim({m, k}).setStride({k, 1}));
+  auto bT = graph->tensor(TensorAttr()
+                              .setName("weights")
+                              .setDim({k, n})
+                              .setStride({n, 1})
+                              .setDataType(DataType::Int4));
+  auto scaleT = graph->tensor(TensorAttr()
+                                  .setName("weights_scale")
+                                  .setDim({groups, n})
+                                  .setStride({n, 1}));
+  auto zeroT = graph->tensor(TensorAttr()
+                                 .setName("weights_zero")
+                                 .setDim({groups, n})
+                                 .setStride({n, 1})
+                                 .setDataType(DataType::Int4));
+
+  auto matmulAttr = MatmulAttr()
+                        .setB_SCALE(scaleT)
+                        .setB_ZERO(zeroT)
+                        .setGroupSize(groupSize)
+                        .setName("matmul");
+  auto resultT = graph->matmul(aT, bT, matmulAttr);
+  resultT->setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  auto makeBuffer = [&](const std::vector<int64_t> &dim, auto data) {
+    FUSILLI_REQUIRE_ASSIGN(Buffer buffer,
+                           Buffer::allocate(handle, castToSizeT(dim), data));
+    return std::make_shared<Buffer>(std::move(buffer));
+  };
+  auto resultBuf = makeBuffer({m, n}, std::vector<half>(m * n));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {aT, makeBuffer({m, k}, aData)},
+          {bT, makeBuffer({k, n}, bData)},
+          {scaleT, makeBuffer({groups, n}, scaleData)},
+          {zeroT, makeBuffer({groups, n}, zeroData)},
+          {resultT, resultBuf},
+      };
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(resultBuf->read(handle, result));
+
+  // The product is the one with the dequantized weights
+  // (B - B_ZERO) * B_SCALE. All values are small integers, exact in fp16.
+  REQUIRE(result.size() == static_cast<size_t>(m * n));
+  for (int64_t row = 0; row < m; ++row) {
+    for (int64_t col = 0; col < n; ++col) {
+      float expected = 0.0f;
+      for (int64_t i = 0; i < k; ++i) {
+        int64_t group = i / groupSize;
+        float weight =
+            static_cast<float>((i + col) % 5 - 2 - ((group + col) % 3 - 1)) *
+            static_cast<float>(1 + col % 2);
+        expected += static_cast<float>(aData[row * k + i]) * weight;
+      }
+      REQUIRE(static_cast<float>(result[row * n + col]) == expected);
+    }
+  }
+}
@@ -0,0 +1,97 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("2:4 sparse matrix multiplication; A (M, K), B packed (K/2, N) "
+          "with metadata (K/2, N)",
+          "[matmul][graph][sparse]") {
+  constexpr int64_t m = 16, k = 64, n = 32;
+
+  // Dense weights pruned to 2:4 along K, with the kept pair of each group
+  // varying over the columns.
+  std::vector<float> denseB(static_cast<size_t>(k * n), 0.0f);
+  for (int64_t row = 0; row < k; ++row)
+    for (int64_t col = 0; col < n; ++col)
+      if (int64_t pos = row % 4, first = col % 3;
+          pos == first || pos == first + 1)
+        denseB[row * n + col] = static_cast<float>((row + col) % 5 - 2);
+  FUSILLI_REQUIRE_ASSIGN(auto packed, packSparse24(denseB, k, n));
+
+  std::vector<float> aData(static_cast<size_t>(m * k));
+  for (int64_t row = 0; row < m; ++row)
+    for (int64_t col = 0; col < k; ++col)
+      aData[row * k + col] = static_cast<float>((row + col) % 3);
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_sparse24_sample");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(
+      TensorAttr().setName("activations").setDim({m, k}).setStride({k, 1}));
+  auto bT = graph->tensor(
+      TensorAttr().setName("weights").setDim({k / 2, n}).setStride({n, 1}));
+  auto metaT = graph->tensor(TensorAttr()
+                                 .setName("weights_meta")
+                                 .setDim({k / 2, n})
+                                 .setStride({n, 1})
+                                 .setDataType(DataType::Int8));
+
+  auto matmulAttr = MatmulAttr().setB_META(metaT).setName("matmul");
+  auto resultT = graph->matmul(aT, bT, matmulAttr);
+  resultT->setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  auto makeBuffer = [&](const std::vector<int64_t> &dim, auto data) {
+    FUSILLI_REQUIRE_ASSIGN(Buffer buffer,
+                           Buffer::allocate(handle, castToSizeT(dim), data));
+    return std::make_shared<Buffer>(std::move(buffer));
+  };
+  auto resultBuf = makeBuffer({m, n}, std::vector<float>(m * n));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {aT, makeBuffer({m, k}, aData)},
+          {bT, makeBuffer({k / 2, n}, packed.values)},
+          {metaT, makeBuffer({k / 2, n}, packed.meta)},
+          {resultT, resultBuf},
+      };
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(resultBuf->read(handle, result));
+
+  // The product with the packed weights is the one with the dense weights.
+  REQUIRE(result.size() == static_cast<size_t>(m * n));
+  for (int64_t row = 0; row < m; ++row) {
+    for (int64_t col = 0; col < n; ++col) {
+      float expected = 0.0f;
+      for (int64_t i = 0; i < k; ++i)
+        expected += aData[row * k + i] * denseB[i * n + col];
+      REQUIRE(result[row * n + col] == expected);
+    }
+  }
+}
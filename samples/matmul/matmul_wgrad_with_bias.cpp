@@ -0,0 +1,85 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Matrix multiplication; linear weight gradient with fused bias "
+          "gradient; DY^T (N, M), X (M, K)",
+          "[matmul][graph]") {
+  int64_t m = 64, k = 32, n = 16;
+
+  Graph graph;
+  graph.setName("matmul_wgrad_with_bias_sample");
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  // DY [M, N] is stored row-major and read as DY^T [N, M].
+  auto dyT = graph.tensor(
+      TensorAttr().setName("dy").setDim({n, m}).setStride({1, n}));
+  auto xT =
+      graph.tensor(TensorAttr().setName("x").setDim({m, k}).setStride({k, 1}));
+
+  auto matmulAttr = MatmulAttr().setName("matmul_wgrad");
+  auto [dwT, dbT] = graph.matmulWithBiasGrad(dyT, xT, matmulAttr);
+  dwT->setName("dw").setOutput(true);
+  dbT->setName("db").setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph.validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  // DY[i][j] = j + 1 and X all ones, so DW[j][*] and DB[j] are M * (j + 1).
+  std::vector<float> dyData(m * n);
+  for (int64_t i = 0; i < m; ++i)
+    for (int64_t j = 0; j < n; ++j)
+      dyData[i * n + j] = static_cast<float>(j + 1);
+  FUSILLI_REQUIRE_ASSIGN(Buffer dyBuffer,
+                         Buffer::allocate(handle, castToSizeT({m, n}), dyData));
+  auto dyBuf = std::make_shared<Buffer>(std::move(dyBuffer));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, xT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dwBuf, allocateBufferOfType(handle, dwT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dbBuf, allocateBufferOfType(handle, dbT, DataType::Float, 0.0f));
+
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {dyT, dyBuf},
+          {xT, xBuf},
+          {dwT, dwBuf},
+          {dbT, dbBuf},
+      };
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  FUSILLI_REQUIRE_OK(graph.execute(handle, variantPack, workspace));
+
+  std::vector<float> dw, db;
+  FUSILLI_REQUIRE_OK(dwBuf->read(handle, dw));
+  FUSILLI_REQUIRE_OK(dbBuf->read(handle, db));
+  REQUIRE(db.size() == static_cast<size_t>(n));
+  for (int64_t j = 0; j < n; ++j) {
+    float expected = static_cast<float>(m * (j + 1));
+    REQUIRE(db[j] == expected);
+    for (int64_t i = 0; i < k; ++i)
+      REQUIRE(dw[j * k + i] == expected);
+  }
+}
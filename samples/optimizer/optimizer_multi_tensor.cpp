@@ -0,0 +1,185 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+using VariantPack =
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>;
+
+static std::shared_ptr<TensorAttr> makeTensor(Graph &graph,
+                                              const std::string &name,
+                                              const std::vector<int64_t> &dim) {
+  return graph.tensor(TensorAttr().setName(name).setDim(dim).setStride(
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+}
+
+// Binds a buffer of `value` to each of `tensors`.
+static void bindAll(const Handle &handle,
+                    const std::vector<std::shared_ptr<TensorAttr>> &tensors,
+                    float value, VariantPack &variantPack) {
+  for (const auto &t : tensors) {
+    FUSILLI_REQUIRE_ASSIGN(
+        auto buf, allocateBufferOfType(handle, t, DataType::Float, value));
+    variantPack[t] = buf;
+  }
+}
+
+// Checks that every element of the buffers of `tensors` is close to
+// `expected`.
+static void checkAll(const Handle &handle, const VariantPack &variantPack,
+                     const std::vector<std::shared_ptr<TensorAttr>> &tensors,
+                     float expected) {
+  for (const auto &t : tensors) {
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(variantPack.at(t)->read(handle, result));
+    for (float val : result)
+      REQUIRE(std::abs(val - expected) <= 1e-5f * std::abs(expected) + 1e-7f);
+  }
+}
+
+// AdamW over the parameters of a small layer: the weight, bias and norm scale
+// are updated by one graph execution, in-place in their buffers and those of
+// their moments. The learning rate and the step count are runtime scalars, so
+// every step runs the same compiled graph.
+TEST_CASE("AdamW update of several parameters in one execution",
+          "[optimizer][in_place][graph]") {
+  const float lr = 0.1f, beta1 = 0.9f, beta2 = 0.999f, eps = 1e-8f;
+  const float weightDecay = 0.1f, grad = 0.5f;
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("optimizer_adamw_multi_tensor_sample");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  const std::vector<std::vector<int64_t>> dims = {{64, 32}, {64}, {32}};
+  std::vector<std::shared_ptr<TensorAttr>> params, grads, moments1, moments2;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    std::string name = "param" + std::to_string(i);
+    params.push_back(makeTensor(*graph, name, dims[i]));
+    grads.push_back(makeTensor(*graph, name + "_grad", dims[i]));
+    moments1.push_back(makeTensor(*graph, name + "_m", dims[i]));
+    moments2.push_back(makeTensor(*graph, name + "_v", dims[i]));
+  }
+  auto lrT = graph->tensor(TensorAttr(lr).setName("lr").setRuntimeScalar());
+  auto stepT =
+      graph->tensor(TensorAttr(1.0f).setName("step").setRuntimeScalar());
+
+  auto adamwAttr = OptimizerAttr()
+                       .setMode(OptimizerAttr::Mode::ADAMW)
+                       .setLR(lrT)
+                       .setBETA1(graph->tensor(TensorAttr(beta1)))
+                       .setBETA2(graph->tensor(TensorAttr(beta2)))
+                       .setEPSILON(graph->tensor(TensorAttr(eps)))
+                       .setWEIGHT_DECAY(graph->tensor(TensorAttr(weightDecay)))
+                       .setSTEP(stepT)
+                       .setName("adamw");
+  graph->optimizerUpdate(params, grads, moments1, moments2, adamwAttr);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  // The results have no buffers of their own.
+  VariantPack variantPack;
+  bindAll(handle, params, 1.0f, variantPack);
+  bindAll(handle, grads, grad, variantPack);
+  bindAll(handle, moments1, 0.0f, variantPack);
+  bindAll(handle, moments2, 0.0f, variantPack);
+  FUSILLI_REQUIRE_ASSIGN(
+      variantPack[lrT],
+      allocateBufferOfType(handle, lrT, DataType::Float, lr));
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Reference update of the (uniform) parameters on the host.
+  float p = 1.0f, m = 0.0f, v = 0.0f;
+  for (int step = 1; step <= 3; ++step) {
+    FUSILLI_REQUIRE_ASSIGN(
+        variantPack[stepT],
+        allocateBufferOfType(handle, stepT, DataType::Float, step));
+    FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+    p *= 1.0f - lr * weightDecay;
+    m = beta1 * m + (1.0f - beta1) * grad;
+    v = beta2 * v + (1.0f - beta2) * grad * grad;
+    float bc1 = 1.0f - std::pow(beta1, static_cast<float>(step));
+    float bc2 = 1.0f - std::pow(beta2, static_cast<float>(step));
+    p -= lr / bc1 * m / (std::sqrt(v) / std::sqrt(bc2) + eps);
+
+    checkAll(handle, variantPack, params, p);
+    checkAll(handle, variantPack, moments1, m);
+    checkAll(handle, variantPack, moments2, v);
+  }
+}
+
+// SGD with Nesterov momentum and weight decay over two parameters.
+TEST_CASE("SGD momentum update of several parameters in one execution",
+          "[optimizer][in_place][graph]") {
+  const float lr = 0.1f, momentum = 0.9f, weightDecay = 0.01f, grad = 0.5f;
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("optimizer_sgd_multi_tensor_sample");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  const std::vector<std::vector<int64_t>> dims = {{16, 8, 3, 3}, {16}};
+  std::vector<std::shared_ptr<TensorAttr>> params, grads, moments1;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    std::string name = "param" + std::to_string(i);
+    params.push_back(makeTensor(*graph, name, dims[i]));
+    grads.push_back(makeTensor(*graph, name + "_grad", dims[i]));
+    moments1.push_back(makeTensor(*graph, name + "_momentum", dims[i]));
+  }
+
+  auto sgdAttr = OptimizerAttr()
+                     .setMode(OptimizerAttr::Mode::SGD)
+                     .setNesterov(true)
+                     .setLR(graph->tensor(TensorAttr(lr)))
+                     .setMOMENTUM(graph->tensor(TensorAttr(momentum)))
+                     .setWEIGHT_DECAY(graph->tensor(TensorAttr(weightDecay)))
+                     .setName("sgd");
+  graph->optimizerUpdate(params, grads, moments1, {}, sgdAttr);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  VariantPack variantPack;
+  bindAll(handle, params, 1.0f, variantPack);
+  bindAll(handle, grads, grad, variantPack);
+  bindAll(handle, moments1, 0.0f, variantPack);
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  float p = 1.0f, buf = 0.0f;
+  for (int step = 1; step <= 3; ++step) {
+    FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+    float g = grad + weightDecay * p;
+    buf = momentum * buf + g;
+    p -= lr * (g + momentum * buf);
+
+    checkAll(handle, variantPack, params, p);
+    checkAll(handle, variantPack, moments1, buf);
+  }
+}
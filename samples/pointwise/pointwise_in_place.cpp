@@ -0,0 +1,82 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+// In-place pointwise chain: x = relu(x * alpha + bias), written into the
+// buffer of x without a buffer for the result.
+TEST_CASE("Pointwise chain written in-place into its input",
+          "[pointwise][in_place][graph]") {
+  const float inputVal = -3.0f;
+  const float alphaVal = -2.0f;
+  const float biasVal = 1.0f;
+  const float expectedVal = 7.0f; // relu(-3 * -2 + 1)
+
+  const std::vector<int64_t> dims = {2, 16, 64, 64};
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  // Build graph.
+  auto graph = std::make_shared<Graph>();
+  graph->setName("pointwise_in_place_sample");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr().setName("x").setDim(dims).setStride(
+      generateStrideFromDim(dims, getContiguousStrideOrder(dims.size()))));
+
+  auto alphaT = graph->tensor(TensorAttr(alphaVal));
+  alphaT->setName("alpha");
+  auto biasT = graph->tensor(TensorAttr(biasVal));
+  biasT->setName("bias");
+
+  auto mulT = graph->pointwise(
+      xT, alphaT, PointwiseAttr().setMode(PointwiseAttr::Mode::MUL));
+  auto addT = graph->pointwise(
+      mulT, biasT, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  auto yT = graph->pointwise(
+      addT, PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD));
+  yT->setName("result").setOutput(true).setInPlace(xT);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  // Check the chain compiles into a single dispatch.
+  FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(*graph, 1);
+
+  // Allocate input buffer (all elements = inputVal).
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, xT, DataType::Float, inputVal));
+
+  // The result has no buffer of its own.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  // Verify output, read from the buffer of x.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(xBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == expectedVal);
+}
@@ -0,0 +1,173 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Convolution fprop + relu + max pooling; X (NHWC), W (KRSC); 3x3 "
+          "conv; padding; 2x2 pooling",
+          "[pooling][conv][graph]") {
+  int64_t n = 4, c = 16, h = 32, w = 32, k = 32, r = 3, s = 3;
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("pooling_sample_conv_relu_max_nhwc");
+    graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+    auto xT = graph->tensor(TensorAttr()
+                                .setName("image")
+                                .setDim({n, c, h, w})
+                                .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+    auto wT = graph->tensor(TensorAttr()
+                                .setName("filter")
+                                .setDim({k, c, r, s})
+                                .setStride({c * r * s, 1, c * s, c})); // KRSC
+
+    auto convAttr = ConvFPropAttr()
+                        .setStride({1, 1})
+                        .setPadding({1, 1})
+                        .setDilation({1, 1})
+                        .setName("conv_fprop");
+    auto convResult = graph->convFProp(xT, wT, convAttr);
+    convResult->setName("conv_result").setDataType(DataType::Float);
+
+    auto reluAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD);
+    auto reluResult = graph->pointwise(convResult, reluAttr);
+    reluResult->setName("relu_result").setDataType(DataType::Float);
+
+    auto poolingAttr = PoolingAttr()
+                           .setMode(PoolingAttr::Mode::MAX)
+                           .setWindow({2, 2})
+                           .setStride({2, 2})
+                           .setPadding({0, 0})
+                           .setName("pooling");
+    auto yT = graph->pooling(reluResult, poolingAttr);
+    yT->setName("result").setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, xT, wT, yT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  // Build graph for the given handle (device), validate and compile it.
+  auto [graph, xT, wT, yT] = buildNewGraph(handle);
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, xT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, wT, DataType::Float, 0.5f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {wT, wBuf},
+          {yT, yBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph once.
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  // Every 2x2 window holds a pixel away from the border, whose convolution
+  // sums all c * r * s taps, and the border pixels sum fewer.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  REQUIRE(result.size() == static_cast<size_t>(n * k * (h / 2) * (w / 2)));
+  for (auto val : result)
+    REQUIRE(val == static_cast<float>(c * r * s) * 0.5f);
+}
+
+TEST_CASE("Average pooling; X (NCHW); 3x3 window; padding excluded from the "
+          "divisor",
+          "[pooling][graph]") {
+  int64_t n = 2, c = 8, h = 16, w = 16;
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("pooling_sample_avg_nchw");
+    graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+    auto xT = graph->tensor(TensorAttr()
+                                .setName("x")
+                                .setDim({n, c, h, w})
+                                .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+    auto poolingAttr = PoolingAttr()
+                           .setMode(PoolingAttr::Mode::AVG)
+                           .setWindow({3, 3})
+                           .setStride({1, 1})
+                           .setPadding({1, 1})
+                           .setCountIncludePad(false)
+                           .setName("pooling");
+    auto yT = graph->pooling(xT, poolingAttr);
+    yT->setName("y").setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, xT, yT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  auto [graph, xT, yT] = buildNewGraph(handle);
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, xT, DataType::Float, 2.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {yT, yBuf},
+      };
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  // Without the padded elements in the divisor, the border windows average
+  // to the input value as well.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  REQUIRE(result.size() == static_cast<size_t>(n * c * h * w));
+  for (auto val : result)
+    REQUIRE(val == 2.0f);
+}
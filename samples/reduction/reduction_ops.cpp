@@ -271,3 +271,190 @@ TEST_CASE("Reduction ops", "[reduction][graph]") {
   // fp32
   execute(handle, DataType::Float, getInitValue.template operator()<float>());
 }
+
+TEST_CASE("Multi-output reduction ops", "[reduction][graph]") {
+  const auto xDims = std::vector<int64_t>{2, 16, 8, 8};
+  const auto yDims = std::vector<int64_t>{2, 1, 8, 1};
+
+  const auto mode =
+      GENERATE(ReductionAttr::Mode::MIN_MAX, ReductionAttr::Mode::SUM_SUMSQ,
+               ReductionAttr::Mode::MEAN_VAR);
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  // Create graph.
+  auto graph = std::make_shared<Graph>();
+  graph->setName(generateName(mode, DataType::Float, xDims, yDims));
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr().setName("x").setDim(xDims).setStride(
+      generateStrideFromDim(xDims, getContiguousStrideOrder(xDims.size()))));
+
+  // Reduce over the dims 1 and 3, both statistics in one node.
+  auto reductionAttr = ReductionAttr().setMode(mode);
+  auto [yT, y2T] = graph->multiOutputReduction(xT, reductionAttr);
+  yT->setDim(yDims).setName("result").setOutput(true);
+  y2T->setName("result2").setOutput(true);
+
+  // Validate and compile.
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  int64_t xSize = 2 * 16 * 8 * 8;
+  std::vector<float> xData = generateReductionInputData<float>(mode, xSize);
+
+  FUSILLI_REQUIRE_ASSIGN(auto xBuf, allocateBufferOfType(handle, xT, xData));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto y2Buf, allocateBufferOfType(handle, y2T, DataType::Float, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {yT, yBuf},
+          {y2T, y2Buf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph once
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  // Compute both statistics manually for every output value.
+  std::vector<float> result, result2;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  FUSILLI_REQUIRE_OK(y2Buf->read(handle, result2));
+  REQUIRE(result.size() == 2 * 8);
+  REQUIRE(result2.size() == 2 * 8);
+
+  for (int64_t d0 = 0; d0 < 2; ++d0) {
+    for (int64_t d2 = 0; d2 < 8; ++d2) {
+      double lo = std::numeric_limits<double>::max();
+      double hi = std::numeric_limits<double>::lowest();
+      double sum = 0.0, sumSq = 0.0;
+      for (int64_t d1 = 0; d1 < 16; ++d1) {
+        for (int64_t d3 = 0; d3 < 8; ++d3) {
+          double v = xData[((d0 * 16 + d1) * 8 + d2) * 8 + d3];
+          lo = std::min(lo, v);
+          hi = std::max(hi, v);
+          sum += v;
+          sumSq += v * v;
+        }
+      }
+
+      double expected = 0.0, expected2 = 0.0;
+      switch (mode) {
+      case ReductionAttr::Mode::MIN_MAX:
+        expected = lo;
+        expected2 = hi;
+        break;
+      case ReductionAttr::Mode::SUM_SUMSQ:
+        expected = sum;
+        expected2 = sumSq;
+        break;
+      default: {
+        // Population variance over the 16 * 8 reduced elements.
+        double mean = sum / 128.0;
+        expected = mean;
+        expected2 = sumSq / 128.0 - mean * mean;
+        break;
+      }
+      }
+
+      int64_t outIdx = d0 * 8 + d2;
+      REQUIRE(std::abs(result[outIdx] - expected) <
+              1e-4 * std::max(1.0, std::abs(expected)));
+      REQUIRE(std::abs(result2[outIdx] - expected2) <
+              1e-4 * std::max(1.0, std::abs(expected2)));
+    }
+  }
+}
+
+TEST_CASE("Index reduction ops for on-device sampling",
+          "[reduction][graph]") {
+  constexpr int64_t kBatch = 4, kVocab = 64, kTopK = 5;
+  const auto logitsDims = std::vector<int64_t>{kBatch, kVocab};
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  // Greedy (ARGMAX) and top-k sampling from the same logits, so only the
+  // selected tokens leave the device.
+  auto graph = std::make_shared<Graph>();
+  graph->setName("reduction_argmax_topk_sampling");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto logitsT = graph->tensor(
+      TensorAttr().setName("logits").setDim(logitsDims).setStride(
+          generateStrideFromDim(logitsDims, getContiguousStrideOrder(2))));
+
+  auto argmaxAttr = ReductionAttr().setMode(ReductionAttr::Mode::ARGMAX);
+  auto tokenT = graph->reduction(logitsT, argmaxAttr);
+  tokenT->setDim({kBatch, 1}).setName("token").setOutput(true);
+
+  auto topkAttr = ReductionAttr().setMode(ReductionAttr::Mode::TOPK);
+  auto [valuesT, idsT] = graph->multiOutputReduction(logitsT, topkAttr);
+  valuesT->setDim({kBatch, kTopK}).setName("top_logits").setOutput(true);
+  idsT->setName("top_ids").setOutput(true);
+
+  // Validate and compile.
+  FUSILLI_REQUIRE_OK(graph->validate());
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  // Every row is a permutation of -32 to 31, so the top-k is unique.
+  std::vector<float> logits(kBatch * kVocab);
+  for (int64_t r = 0; r < kBatch; ++r)
+    for (int64_t i = 0; i < kVocab; ++i)
+      logits[r * kVocab + i] =
+          static_cast<float>((i * 37 + r * 11) % kVocab - kVocab / 2);
+
+  FUSILLI_REQUIRE_ASSIGN(auto logitsBuf,
+                         allocateBufferOfType(handle, logitsT, logits));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto tokenBuf,
+      allocateBufferOfType(handle, tokenT, std::vector<int64_t>(kBatch)));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto valuesBuf,
+      allocateBufferOfType(handle, valuesT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto idsBuf, allocateBufferOfType(handle, idsT,
+                                        std::vector<int64_t>(kBatch * kTopK)));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {logitsT, logitsBuf},
+          {tokenT, tokenBuf},
+          {valuesT, valuesBuf},
+          {idsT, idsBuf},
+      };
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<int64_t> token, ids;
+  std::vector<float> values;
+  FUSILLI_REQUIRE_OK(tokenBuf->read(handle, token));
+  FUSILLI_REQUIRE_OK(valuesBuf->read(handle, values));
+  FUSILLI_REQUIRE_OK(idsBuf->read(handle, ids));
+
+  for (int64_t r = 0; r < kBatch; ++r) {
+    // Token ids by decreasing logit.
+    std::vector<int64_t> order(kVocab);
+    for (int64_t i = 0; i < kVocab; ++i)
+      order[i] = i;
+    const float *row = logits.data() + r * kVocab;
+    std::sort(order.begin(), order.end(),
+              [&](int64_t a, int64_t b) { return row[a] > row[b]; });
+
+    REQUIRE(token[r] == order[0]);
+    for (int64_t j = 0; j < kTopK; ++j) {
+      REQUIRE(ids[r * kTopK + j] == order[j]);
+      REQUIRE(values[r * kTopK + j] == row[order[j]]);
+    }
+  }
+}
@@ -0,0 +1,94 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "rmsnorm_utils.h"
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("RMS normalization; backward; NCHW layout; scale",
+          "[rmsnorm][graph]") {
+  constexpr int64_t n = 2, c = 3, h = 8, w = 8;
+  constexpr float eps = 1e-5f;
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("rmsnorm_bwd_sample_nchw_scale");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto dyT = graph->tensor(TensorAttr()
+                               .setName("dy")
+                               .setDim({n, c, h, w})
+                               .setStride({c * h * w, h * w, w, 1})); // NCHW
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+  // Shape and strides will be inferred later in inferPropertiesNode()
+  auto sT = graph->tensor(TensorAttr().setName("scale"));
+  auto rT = graph->tensor(TensorAttr().setName("inv_rms"));
+
+  auto rmsnormBwdAttr = RmsnormBwdAttr().setName("rmsnorm_bwd");
+  auto [dxT, dsT] = graph->rmsnormBackward(dyT, xT, sT, rT, rmsnormBwdAttr);
+
+  dxT->setName("dx").setOutput(true);
+  dsT->setName("dscale").setOutput(true);
+
+  // Validate, infer missing properties
+  FUSILLI_REQUIRE_OK(graph->validate());
+
+  // Create handle for the target backend and compile.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  auto t = rmsnorm_utils::generateIOTensorsForBackward(n, c * h * w, eps);
+
+  FUSILLI_REQUIRE_ASSIGN(auto dyBuf, allocateBufferOfType(handle, dyT, t.dy));
+  FUSILLI_REQUIRE_ASSIGN(auto xBuf, allocateBufferOfType(handle, xT, t.x));
+  FUSILLI_REQUIRE_ASSIGN(auto sBuf, allocateBufferOfType(handle, sT, t.scale));
+  FUSILLI_REQUIRE_ASSIGN(auto rBuf, allocateBufferOfType(handle, rT, t.invRms));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dxBuf, allocateBufferOfType(handle, dxT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dsBuf, allocateBufferOfType(handle, dsT, DataType::Float, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {dyT, dyBuf}, {xT, xBuf},   {sT, sBuf},
+          {rT, rBuf},   {dxT, dxBuf}, {dsT, dsBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<float> dxVals, dsVals;
+  FUSILLI_REQUIRE_OK(dxBuf->read(handle, dxVals));
+  FUSILLI_REQUIRE_OK(dsBuf->read(handle, dsVals));
+
+  REQUIRE(dxVals.size() == t.dx.size());
+  REQUIRE(dsVals.size() == t.dscale.size());
+  constexpr float tolerance = 1e-4f;
+  for (size_t i = 0; i < dxVals.size(); ++i)
+    REQUIRE(std::abs(dxVals[i] - t.dx[i]) < tolerance);
+  for (size_t i = 0; i < dsVals.size(); ++i)
+    REQUIRE(std::abs(dsVals[i] - t.dscale[i]) < tolerance);
+}
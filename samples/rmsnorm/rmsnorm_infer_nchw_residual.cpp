@@ -0,0 +1,115 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("RMS normalization; inference mode; NCHW layout; fused residual add",
+          "[rmsnorm][graph]") {
+  constexpr int64_t n = 2, c = 3, h = 32, w = 32;
+  constexpr float eps = 1e-5f;
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("rmsnorm_infer_sample_nchw_residual");
+    graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+    auto xT = graph->tensor(TensorAttr()
+                                .setName("x")
+                                .setDim({n, c, h, w})
+                                .setStride({c * h * w, h * w, w, 1})); // NCHW
+    auto residualT =
+        graph->tensor(TensorAttr()
+                          .setName("residual")
+                          .setDim({n, c, h, w})
+                          .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+    auto epsilonT = graph->tensor(TensorAttr(eps));
+
+    auto rmsnormAttr = RmsnormAttr()
+                           .setForwardPhase(NormFwdPhase::INFERENCE)
+                           .setEpsilon(epsilonT)
+                           .setName("rmsnorm");
+
+    // RmsNorm of x + residual, also writing the sum.
+    auto [yT, rT, sumT] =
+        graph->rmsnorm(xT, residualT, /*scale=*/nullptr, rmsnormAttr);
+
+    yT->setName("y").setDataType(DataType::Float).setOutput(true);
+    sumT->setName("sum").setDataType(DataType::Float).setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, xT, residualT, yT, sumT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  auto [graph, xT, residualT, yT, sumT] = buildNewGraph(handle);
+
+  // Every row of the sum is constant, so its RMS is the value itself.
+  constexpr float xVal = 1.5f, residualVal = 0.5f;
+  constexpr float sumVal = xVal + residualVal;
+  const float yVal = sumVal / std::sqrt(sumVal * sumVal + eps);
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, xT, DataType::Float, xVal));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto residualBuf,
+      allocateBufferOfType(handle, residualT, DataType::Float, residualVal));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto sumBuf, allocateBufferOfType(handle, sumT, DataType::Float, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {residualT, residualBuf},
+          {yT, yBuf},
+          {sumT, sumBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph once.
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<float> yVals, sumVals;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, yVals));
+  FUSILLI_REQUIRE_OK(sumBuf->read(handle, sumVals));
+
+  constexpr size_t size = n * c * h * w;
+  REQUIRE(yVals.size() == size);
+  REQUIRE(sumVals.size() == size);
+  constexpr float tolerance = 1e-4f;
+  for (size_t i = 0; i < size; ++i) {
+    REQUIRE(std::abs(yVals[i] - yVal) < tolerance);
+    REQUIRE(sumVals[i] == sumVal);
+  }
+}
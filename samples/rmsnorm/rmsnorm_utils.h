@@ -89,6 +89,64 @@ generateIOTensorsForTrainForward(int64_t n, int64_t c, int64_t h, int64_t w,
   return std::make_tuple(inputVals, expectedVals, expectedInvRms);
 }
 
+// Inputs and expected gradients of the RmsNorm backward node over `n` batches
+// of `size` elements each, with a per-element scale.
+struct BackwardTensors {
+  std::vector<float> x, dy, scale, invRms;
+  std::vector<float> dx, dscale;
+};
+
+// Generates inputs and expected gradients for RmsNorm node backward. The
+// inputs are sinusoids so that the gradients do not cancel out, and the
+// inverse RMS and gradients are computed on the host in double precision:
+//   xhat = x * inv_rms, g = dy * scale
+//   dx = inv_rms * (g - xhat * mean(g * xhat))
+//   dscale = sum_batch(dy * xhat)
+inline BackwardTensors generateIOTensorsForBackward(int64_t n, int64_t size,
+                                                    float eps) {
+  BackwardTensors t;
+  t.x.resize(n * size);
+  t.dy.resize(n * size);
+  t.scale.resize(size);
+  t.invRms.resize(n);
+  t.dx.resize(n * size);
+  t.dscale.assign(size, 0.0f);
+  for (int64_t i = 0; i < n * size; ++i) {
+    t.x[i] = std::sin(0.37f * static_cast<float>(i)) + 0.1f;
+    t.dy[i] = std::cos(0.11f * static_cast<float>(i));
+  }
+  for (int64_t j = 0; j < size; ++j)
+    t.scale[j] = 0.5f + 0.01f * static_cast<float>(j % 64);
+
+  std::vector<double> dscale(size, 0.0);
+  for (int64_t b = 0; b < n; ++b) {
+    const float *x = t.x.data() + b * size;
+    const float *dy = t.dy.data() + b * size;
+    double meanSq = 0.0;
+    for (int64_t j = 0; j < size; ++j)
+      meanSq += static_cast<double>(x[j]) * x[j];
+    meanSq /= static_cast<double>(size);
+    double invRms = 1.0 / std::sqrt(meanSq + eps);
+    t.invRms[b] = static_cast<float>(invRms);
+
+    double gXhatMean = 0.0;
+    for (int64_t j = 0; j < size; ++j) {
+      double xhat = x[j] * invRms;
+      gXhatMean += dy[j] * t.scale[j] * xhat;
+      dscale[j] += dy[j] * xhat;
+    }
+    gXhatMean /= static_cast<double>(size);
+    for (int64_t j = 0; j < size; ++j) {
+      double xhat = x[j] * invRms;
+      double g = dy[j] * t.scale[j];
+      t.dx[b * size + j] = static_cast<float>(invRms * (g - xhat * gXhatMean));
+    }
+  }
+  for (int64_t j = 0; j < size; ++j)
+    t.dscale[j] = static_cast<float>(dscale[j]);
+  return t;
+}
+
 } // namespace fusilli::rmsnorm_utils
 
 #endif // FUSILLI_SAMPLES_RMSNORM_RMSNORM_UTILS_H
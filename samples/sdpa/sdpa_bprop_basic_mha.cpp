@@ -0,0 +1,162 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("SDPA training: forward with stats, then backward f32",
+          "[sdpa][graph]") {
+  constexpr int64_t b = 1, h = 2, s = 64, d = 32;
+  const std::vector<int64_t> dim = {b, h, s, d};
+  const std::vector<int64_t> statsDim = {b, h, s, 1};
+
+  auto tensor = [](const std::shared_ptr<Graph> &graph, const std::string &name,
+                   const std::vector<int64_t> &tDim) {
+    return graph->tensor(TensorAttr().setName(name).setDim(tDim).setStride(
+        generateStrideFromDim(tDim, getContiguousStrideOrder(tDim.size()))));
+  };
+
+  // Forward graph: writes O and the logsumexp STATS saved for backward.
+  auto buildFwdGraph = [&](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("sdpa_bprop_sample_fwd");
+    graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+    auto qT = tensor(graph, "q", dim);
+    auto kT = tensor(graph, "k", dim);
+    auto vT = tensor(graph, "v", dim);
+
+    auto sdpaAttr = SdpaAttr().setName("sdpa");
+    auto [oT, statsT] =
+        graph->sdpaWithStats(qT, kT, vT, /*mask=*/nullptr, sdpaAttr);
+    oT->setName("o").setOutput(true);
+    statsT->setName("stats").setOutput(true);
+
+    FUSILLI_REQUIRE_OK(graph->validate());
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, qT, kT, vT, oT, statsT);
+  };
+
+  // Backward graph: recomputes the probabilities from Q, K and STATS.
+  auto buildBwdGraph = [&](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("sdpa_bprop_sample_bwd");
+    graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+    auto qT = tensor(graph, "q", dim);
+    auto kT = tensor(graph, "k", dim);
+    auto vT = tensor(graph, "v", dim);
+    auto oT = tensor(graph, "o", dim);
+    auto dOT = tensor(graph, "d_o", dim);
+    auto statsT = tensor(graph, "stats", statsDim);
+
+    auto sdpaBwdAttr = SdpaBwdAttr().setName("sdpa_bwd");
+    auto [dQT, dKT, dVT] =
+        graph->sdpaBackward(qT, kT, vT, oT, dOT, statsT, sdpaBwdAttr);
+    dQT->setName("dq").setOutput(true);
+    dKT->setName("dk").setOutput(true);
+    dVT->setName("dv").setOutput(true);
+
+    FUSILLI_REQUIRE_OK(graph->validate());
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, qT, kT, vT, oT, dOT, statsT, dQT, dKT, dVT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  auto [fwdGraph, qT, kT, vT, oT, statsT] = buildFwdGraph(handle);
+  auto [bwdGraph, bwdQT, bwdKT, bwdVT, bwdOT, dOT, bwdStatsT, dQT, dKT, dVT] =
+      buildBwdGraph(handle);
+
+  // Constant inputs give uniform probabilities 1/s, so O = V, each STATS row
+  // is log(s) + scale * d * qVal * kVal, dV = dO and dS (hence dQ, dK) is 0.
+  constexpr float qkVal = 0.1f, vVal = 0.5f, dOVal = 0.5f;
+  const float statsVal = std::log(static_cast<float>(s)) +
+                         d * qkVal * qkVal / std::sqrt(static_cast<float>(d));
+
+  auto allocate = [&](const std::shared_ptr<TensorAttr> &t, float init) {
+    FUSILLI_REQUIRE_ASSIGN(
+        auto buf, allocateBufferOfType(handle, t, DataType::Float, init));
+    return buf;
+  };
+  auto qBuf = allocate(qT, qkVal);
+  auto kBuf = allocate(kT, qkVal);
+  auto vBuf = allocate(vT, vVal);
+  auto oBuf = allocate(oT, 0.0f);
+  auto statsBuf = allocate(statsT, 0.0f);
+  auto dOBuf = allocate(dOT, dOVal);
+  auto dQBuf = allocate(dQT, 1.0f);
+  auto dKBuf = allocate(dKT, 1.0f);
+  auto dVBuf = allocate(dVT, 0.0f);
+
+  // Execute forward, then feed its O and STATS buffers to backward.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      fwdVariantPack = {
+          {qT, qBuf},
+          {kT, kBuf},
+          {vT, vBuf},
+          {oT, oBuf},
+          {statsT, statsBuf},
+      };
+  FUSILLI_REQUIRE_ASSIGN(auto fwdWorkspaceSize, fwdGraph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto fwdWorkspace,
+                         allocateWorkspace(handle, fwdWorkspaceSize));
+  FUSILLI_REQUIRE_OK(fwdGraph->execute(handle, fwdVariantPack, fwdWorkspace));
+
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      bwdVariantPack = {
+          {bwdQT, qBuf},
+          {bwdKT, kBuf},
+          {bwdVT, vBuf},
+          {bwdOT, oBuf},
+          {dOT, dOBuf},
+          {bwdStatsT, statsBuf},
+          {dQT, dQBuf},
+          {dKT, dKBuf},
+          {dVT, dVBuf},
+      };
+  FUSILLI_REQUIRE_ASSIGN(auto bwdWorkspaceSize, bwdGraph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto bwdWorkspace,
+                         allocateWorkspace(handle, bwdWorkspaceSize));
+  FUSILLI_REQUIRE_OK(bwdGraph->execute(handle, bwdVariantPack, bwdWorkspace));
+
+  std::vector<float> oVals, statsVals, dQVals, dKVals, dVVals;
+  FUSILLI_REQUIRE_OK(oBuf->read(handle, oVals));
+  FUSILLI_REQUIRE_OK(statsBuf->read(handle, statsVals));
+  FUSILLI_REQUIRE_OK(dQBuf->read(handle, dQVals));
+  FUSILLI_REQUIRE_OK(dKBuf->read(handle, dKVals));
+  FUSILLI_REQUIRE_OK(dVBuf->read(handle, dVVals));
+
+  constexpr size_t size = b * h * s * d;
+  REQUIRE(oVals.size() == size);
+  REQUIRE(statsVals.size() == b * h * s);
+  constexpr float tolerance = 1e-4f;
+  for (float val : statsVals)
+    REQUIRE(std::abs(val - statsVal) < tolerance);
+  for (size_t i = 0; i < size; ++i) {
+    REQUIRE(std::abs(oVals[i] - vVal) < tolerance);
+    REQUIRE(std::abs(dQVals[i]) < tolerance);
+    REQUIRE(std::abs(dKVals[i]) < tolerance);
+    REQUIRE(std::abs(dVVals[i] - dOVal) < tolerance);
+  }
+}
@@ -0,0 +1,130 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+// Host reference of the dropout mask: element `idx` of the attention
+// probabilities is kept when the first word of Philox4x32-10, keyed by the
+// seed and with counter (idx, offset), is at least p * 2^32.
+static bool referenceKeep(uint64_t seed, uint64_t offset, uint64_t idx,
+                          float p) {
+  uint32_t c0 = static_cast<uint32_t>(idx);
+  uint32_t c1 = static_cast<uint32_t>(idx >> 32);
+  uint32_t c2 = static_cast<uint32_t>(offset);
+  uint32_t c3 = static_cast<uint32_t>(offset >> 32);
+  uint32_t k0 = static_cast<uint32_t>(seed);
+  uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+  for (int round = 0; round < 10; ++round) {
+    uint64_t prod0 = uint64_t{0xD2511F53} * c0;
+    uint64_t prod1 = uint64_t{0xCD9E8D57} * c2;
+    uint32_t hi0 = static_cast<uint32_t>(prod0 >> 32);
+    uint32_t hi1 = static_cast<uint32_t>(prod1 >> 32);
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = static_cast<uint32_t>(prod1);
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = static_cast<uint32_t>(prod0);
+    k0 += 0x9E3779B9;
+    k1 += 0xBB67AE85;
+  }
+  double threshold = std::round(static_cast<double>(p) * 4294967296.0);
+  return static_cast<double>(c0) >= threshold;
+}
+
+TEST_CASE("SDPA forward: dropout with runtime seed and offset f32",
+          "[sdpa][graph]") {
+  constexpr int64_t kBatch = 1, kHeads = 2, kSeqQ = 8, kSeqKV = 16,
+                    kHeadDim = 4;
+  constexpr float kDropout = 0.25f;
+  std::vector<int64_t> qDim = {kBatch, kHeads, kSeqQ, kHeadDim};
+  std::vector<int64_t> kvDim = {kBatch, kHeads, kSeqKV, kHeadDim};
+
+  Graph graph;
+  graph.setName("sdpa_fprop_dropout_rng");
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto q = graph.tensor(TensorAttr().setName("q").setDim(qDim).setStride(
+      generateStrideFromDim(qDim, getContiguousStrideOrder(4))));
+  auto k = graph.tensor(TensorAttr().setName("k").setDim(kvDim).setStride(
+      generateStrideFromDim(kvDim, getContiguousStrideOrder(4))));
+  auto v = graph.tensor(TensorAttr().setName("v").setDim(kvDim).setStride(
+      generateStrideFromDim(kvDim, getContiguousStrideOrder(4))));
+  auto seed = graph.tensor(TensorAttr().setName("seed"));
+  auto offset = graph.tensor(TensorAttr().setName("offset"));
+  auto sdpaAttr = SdpaAttr()
+                      .setName("sdpa")
+                      .setDropout(kDropout)
+                      .setDROPOUT_SEED(seed)
+                      .setDROPOUT_OFFSET(offset);
+  auto o = graph.sdpa(q, k, v, /*mask=*/nullptr, sdpaAttr);
+  o->setName("o").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  // Zero Q and K give uniform probabilities 1 / seq_kv, and V holds the KV
+  // position, so each output is the scaled sum of the kept positions.
+  std::vector<float> vData;
+  for (int64_t i = 0; i < kBatch * kHeads * kSeqKV; ++i)
+    vData.insert(vData.end(), kHeadDim, static_cast<float>(i % kSeqKV + 1));
+  auto makeBuffer = [&](const std::vector<int64_t> &dim, auto data) {
+    FUSILLI_REQUIRE_ASSIGN(Buffer buffer,
+                           Buffer::allocate(handle, castToSizeT(dim), data));
+    return std::make_shared<Buffer>(std::move(buffer));
+  };
+
+  // Runs the graph with `seedValue` and `offsetValue` and checks O against
+  // the host reference.
+  auto run = [&](int64_t seedValue, int64_t offsetValue) {
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+        variantPack = {
+            {q, makeBuffer(qDim, std::vector<float>(
+                                     kBatch * kHeads * kSeqQ * kHeadDim))},
+            {k, makeBuffer(kvDim, std::vector<float>(vData.size()))},
+            {v, makeBuffer(kvDim, vData)},
+            {seed, makeBuffer({1}, std::vector<int64_t>{seedValue})},
+            {offset, makeBuffer({1}, std::vector<int64_t>{offsetValue})},
+            {o, makeBuffer(qDim, std::vector<float>(
+                                     kBatch * kHeads * kSeqQ * kHeadDim))},
+        };
+    FUSILLI_REQUIRE_OK(graph.execute(handle, variantPack, nullptr));
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(variantPack.at(o)->read(handle, result));
+
+    float scale = 1.0f / (static_cast<float>(kSeqKV) * (1.0f - kDropout));
+    for (int64_t row = 0; row < kBatch * kHeads * kSeqQ; ++row) {
+      float expected = 0.0f;
+      for (int64_t j = 0; j < kSeqKV; ++j)
+        if (referenceKeep(static_cast<uint64_t>(seedValue),
+                          static_cast<uint64_t>(offsetValue),
+                          static_cast<uint64_t>(row * kSeqKV + j), kDropout))
+          expected += static_cast<float>(j + 1) * scale;
+      for (int64_t d = 0; d < kHeadDim; ++d)
+        REQUIRE(result[row * kHeadDim + d] ==
+                Catch::Approx(expected).epsilon(1e-4));
+    }
+    return result;
+  };
+
+  // The same seed and offset reproduce the mask, and a new offset draws a
+  // new one from the same compiled graph.
+  std::vector<float> first = run(1234, 0);
+  REQUIRE(run(1234, 0) == first);
+  REQUIRE(run(1234, 1) != first);
+  REQUIRE(run(int64_t{0x123456789}, 7) != first);
+}
@@ -0,0 +1,121 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("SDPA forward: rotary position embedding f32", "[sdpa][graph]") {
+  constexpr int64_t kSeq = 8, kHeadDim = 4, kHalf = kHeadDim / 2;
+  std::vector<int64_t> dim = {1, 1, kSeq, kHeadDim};
+  std::vector<int64_t> tableDim = {kSeq, kHeadDim};
+
+  Graph graph;
+  graph.setName("sdpa_fprop_rope");
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto makeTensor = [&](const char *name, const std::vector<int64_t> &d) {
+    return graph.tensor(TensorAttr().setName(name).setDim(d).setStride(
+        generateStrideFromDim(d, getContiguousStrideOrder(d.size()))));
+  };
+  auto q = makeTensor("q", dim);
+  auto k = makeTensor("k", dim);
+  auto v = makeTensor("v", dim);
+  auto cos = makeTensor("cos", tableDim);
+  auto sin = makeTensor("sin", tableDim);
+  auto sdpaAttr =
+      SdpaAttr().setName("sdpa").setROPE_COS(cos).setROPE_SIN(sin);
+  auto o = graph.sdpa(q, k, v, /*mask=*/nullptr, sdpaAttr);
+  o->setName("o").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  // Llama-style tables: position p rotates the pair (i, i + head_dim / 2)
+  // by p * 10000^(-2i / head_dim).
+  std::vector<float> cosData(kSeq * kHeadDim), sinData(kSeq * kHeadDim);
+  for (int64_t p = 0; p < kSeq; ++p)
+    for (int64_t i = 0; i < kHeadDim; ++i) {
+      double freq = std::pow(10000.0, -2.0 * static_cast<double>(i % kHalf) /
+                                          static_cast<double>(kHeadDim));
+      cosData[p * kHeadDim + i] = static_cast<float>(std::cos(p * freq));
+      sinData[p * kHeadDim + i] = static_cast<float>(std::sin(p * freq));
+    }
+  std::vector<float> qData(kSeq * kHeadDim), kData(kSeq * kHeadDim),
+      vData(kSeq * kHeadDim);
+  for (int64_t i = 0; i < kSeq * kHeadDim; ++i) {
+    qData[i] = 0.1f * static_cast<float>(i % 5) - 0.2f;
+    kData[i] = 0.1f * static_cast<float>(i % 3);
+    vData[i] = static_cast<float>(i / kHeadDim);
+  }
+
+  auto makeBuffer = [&](const std::vector<int64_t> &d,
+                        const std::vector<float> &data) {
+    FUSILLI_REQUIRE_ASSIGN(Buffer buffer,
+                           Buffer::allocate(handle, castToSizeT(d), data));
+    return std::make_shared<Buffer>(std::move(buffer));
+  };
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {q, makeBuffer(dim, qData)},
+          {k, makeBuffer(dim, kData)},
+          {v, makeBuffer(dim, vData)},
+          {cos, makeBuffer(tableDim, cosData)},
+          {sin, makeBuffer(tableDim, sinData)},
+          {o, makeBuffer(dim, std::vector<float>(kSeq * kHeadDim))},
+      };
+  FUSILLI_REQUIRE_OK(graph.execute(handle, variantPack, nullptr));
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(variantPack.at(o)->read(handle, result));
+
+  // Host reference: rotate Q and K, then plain attention.
+  auto rotate = [&](const std::vector<float> &x) {
+    std::vector<float> y(x.size());
+    for (int64_t p = 0; p < kSeq; ++p)
+      for (int64_t i = 0; i < kHeadDim; ++i) {
+        int64_t idx = p * kHeadDim + i;
+        float rotated = i < kHalf ? -x[idx + kHalf] : x[idx - kHalf];
+        y[idx] = x[idx] * cosData[idx] + rotated * sinData[idx];
+      }
+    return y;
+  };
+  std::vector<float> qRot = rotate(qData), kRot = rotate(kData);
+  float scale = 1.0f / std::sqrt(static_cast<float>(kHeadDim));
+  for (int64_t i = 0; i < kSeq; ++i) {
+    std::vector<float> scores(kSeq);
+    float maxScore = -INFINITY, sum = 0.0f;
+    for (int64_t j = 0; j < kSeq; ++j) {
+      for (int64_t d = 0; d < kHeadDim; ++d)
+        scores[j] += qRot[i * kHeadDim + d] * kRot[j * kHeadDim + d];
+      scores[j] *= scale;
+      maxScore = std::max(maxScore, scores[j]);
+    }
+    for (float &s : scores) {
+      s = std::exp(s - maxScore);
+      sum += s;
+    }
+    for (int64_t d = 0; d < kHeadDim; ++d) {
+      float expected = 0.0f;
+      for (int64_t j = 0; j < kSeq; ++j)
+        expected += scores[j] / sum * vData[j * kHeadDim + d];
+      REQUIRE(result[i * kHeadDim + d] ==
+              Catch::Approx(expected).epsilon(1e-4));
+    }
+  }
+}
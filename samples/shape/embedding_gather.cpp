@@ -0,0 +1,99 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+// Token embedding lookup from a [batch, seq] tensor of ids, and its gradient
+// with respect to the table, in which the rows of repeated ids accumulate.
+TEST_CASE("Embedding lookup and its gradient",
+          "[shape][index_select][graph]") {
+  constexpr int64_t kVocab = 8, kHidden = 4, kBatch = 2, kSeq = 3;
+  const std::vector<int64_t> tableDim = {kVocab, kHidden};
+  const std::vector<int64_t> idsDim = {kBatch, kSeq};
+  const std::vector<int64_t> embDim = {kBatch, kSeq, kHidden};
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("embedding_gather_sample");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto makeTensor = [&](const char *name, const std::vector<int64_t> &dim) {
+    return graph->tensor(TensorAttr().setName(name).setDim(dim).setStride(
+        generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+  auto tableT = makeTensor("table", tableDim);
+  auto idsT = makeTensor("ids", idsDim);
+  auto dyT = makeTensor("dy", embDim);
+
+  auto lookupAttr = IndexSelectAttr().setName("lookup");
+  auto embT = graph->indexSelect(tableT, idsT, lookupAttr);
+  embT->setName("emb").setOutput(true);
+
+  auto gradAttr = IndexAddAttr().setSize(kVocab).setName("grad");
+  auto dtableT = graph->indexAdd(/*x=*/nullptr, idsT, dyT, gradAttr);
+  dtableT->setName("dtable").setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  // Row `v` of the table holds `v`, and DY is all ones, so the gradient of
+  // row `v` counts the occurrences of `v` in the ids.
+  std::vector<float> table;
+  for (int64_t v = 0; v < kVocab; ++v)
+    table.insert(table.end(), kHidden, static_cast<float>(v));
+  const std::vector<int64_t> ids = {5, 1, 5, 0, 7, 5};
+
+  FUSILLI_REQUIRE_ASSIGN(auto tableBuf,
+                         allocateBufferOfType(handle, tableT, table));
+  FUSILLI_REQUIRE_ASSIGN(auto idsBuf, allocateBufferOfType(handle, idsT, ids));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dyBuf, allocateBufferOfType(handle, dyT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto embBuf, allocateBufferOfType(handle, embT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dtableBuf,
+      allocateBufferOfType(handle, dtableT, DataType::Float, 0.0f));
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  const std::unordered_map<std::shared_ptr<TensorAttr>,
+                           std::shared_ptr<Buffer>>
+      variantPack = {
+          {tableT, tableBuf}, {idsT, idsBuf},       {dyT, dyBuf},
+          {embT, embBuf},     {dtableT, dtableBuf},
+      };
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<float> emb;
+  FUSILLI_REQUIRE_OK(embBuf->read(handle, emb));
+  for (int64_t i = 0; i < kBatch * kSeq; ++i)
+    for (int64_t d = 0; d < kHidden; ++d)
+      REQUIRE(emb[i * kHidden + d] == static_cast<float>(ids[i]));
+
+  std::vector<float> dtable;
+  FUSILLI_REQUIRE_OK(dtableBuf->read(handle, dtable));
+  for (int64_t v = 0; v < kVocab; ++v) {
+    float count = 0.0f;
+    for (int64_t id : ids)
+      count += id == v ? 1.0f : 0.0f;
+    for (int64_t d = 0; d < kHidden; ++d)
+      REQUIRE(dtable[v * kHidden + d] == count);
+  }
+}
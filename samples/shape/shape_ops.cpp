@@ -0,0 +1,104 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Permute, slice, concat and reshape; X (2, 3) -> Y (8)",
+          "[shape][graph]") {
+  constexpr int64_t m = 2, n = 3;
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("shape_ops_sample");
+    graph->setIODataType(DataType::Float)
+        .setComputeDataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float);
+
+    auto xT = graph->tensor(
+        TensorAttr().setName("x").setDim({m, n}).setStride({n, 1}));
+
+    // (2, 3) -> (3, 2)
+    auto permuteAttr = PermuteAttr().setOrder({1, 0}).setName("transpose");
+    auto transposedT = graph->permute(xT, permuteAttr);
+
+    // (3, 2) -> (2, 2): drops the first row.
+    auto sliceAttr =
+        SliceAttr().setStart({1, 0}).setEnd({n, m}).setName("slice");
+    auto slicedT = graph->slice(transposedT, sliceAttr);
+
+    // (2, 2) -> (2, 4)
+    auto concatAttr = ConcatAttr().setAxis(1).setName("concat");
+    auto concatT = graph->concat({slicedT, slicedT}, concatAttr);
+
+    // (2, 4) -> (8)
+    auto reshapeAttr = ReshapeAttr().setShape({-1}).setName("flatten");
+    auto yT = graph->reshape(concatT, reshapeAttr);
+    yT->setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, xT, yT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  // Build graph for the given handle (device), validate and compile it.
+  auto [graph, xT, yT] = buildNewGraph(handle);
+
+  // Allocate input buffer for X = [[0, 1, 2], [3, 4, 5]].
+  const std::vector<float> xData = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+  FUSILLI_REQUIRE_ASSIGN(auto xRawBuf,
+                         Buffer::allocate(handle, castToSizeT({m, n}), xData));
+  auto xBuf = std::make_shared<Buffer>(std::move(xRawBuf));
+
+  // Allocate output buffer for Y.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {yT, yBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph once.
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  // Read output buffers.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+
+  // Verify output.
+  // transpose(X) = [[0, 3], [1, 4], [2, 5]], sliced to [[1, 4], [2, 5]] and
+  // concatenated with itself to [[1, 4, 1, 4], [2, 5, 2, 5]].
+  const std::vector<float> expected = {1.0f, 4.0f, 1.0f, 4.0f,
+                                       2.0f, 5.0f, 2.0f, 5.0f};
+  REQUIRE(result == expected);
+}
@@ -0,0 +1,125 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+// Decode step: the K and V of the new token are appended in-place to the KV
+// cache at a runtime position, and the query attends over the updated cache,
+// all in one graph.
+TEST_CASE("Decode step appending to a KV cache in-place",
+          "[shape][sdpa][in_place][graph]") {
+  constexpr int64_t kMaxSeq = 8, kHeadDim = 4;
+  const std::vector<int64_t> cacheDim = {1, 1, kMaxSeq, kHeadDim};
+  const std::vector<int64_t> tokenDim = {1, 1, 1, kHeadDim};
+
+  auto graph = std::make_shared<Graph>();
+  graph->setName("slice_update_kv_cache_sample");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto makeTensor = [&](const char *name, const std::vector<int64_t> &dim) {
+    return graph->tensor(TensorAttr().setName(name).setDim(dim).setStride(
+        generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+  auto qT = makeTensor("q", tokenDim);
+  auto kCacheT = makeTensor("k_cache", cacheDim);
+  auto vCacheT = makeTensor("v_cache", cacheDim);
+  auto kNewT = makeTensor("k_new", tokenDim);
+  auto vNewT = makeTensor("v_new", tokenDim);
+  auto posT = graph->tensor(TensorAttr().setName("pos"));
+
+  auto appendK = SliceUpdateAttr().setAxis(2).setName("append_k");
+  auto kT = graph->sliceUpdate(kCacheT, kNewT, posT, appendK);
+  kT->setName("k").setOutput(true).setInPlace(kCacheT);
+  auto appendV = SliceUpdateAttr().setAxis(2).setName("append_v");
+  auto vT = graph->sliceUpdate(vCacheT, vNewT, posT, appendV);
+  vT->setName("v").setOutput(true).setInPlace(vCacheT);
+
+  auto sdpaAttr = SdpaAttr().setName("sdpa");
+  auto oT = graph->sdpa(qT, kT, vT, /*mask=*/nullptr, sdpaAttr);
+  oT->setName("o").setOutput(true);
+
+  FUSILLI_REQUIRE_OK(graph->validate());
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+  // Zero Q and K give uniform attention, so O is the mean of the V cache,
+  // which starts out as all ones.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto qBuf, allocateBufferOfType(handle, qT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto kCacheBuf,
+      allocateBufferOfType(handle, kCacheT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto vCacheBuf,
+      allocateBufferOfType(handle, vCacheT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto kNewBuf, allocateBufferOfType(handle, kNewT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto oBuf, allocateBufferOfType(handle, oT, DataType::Float, 0.0f));
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Runs a decode step writing `vNew` at `pos` and returns O.
+  auto step = [&](int64_t pos, float vNew) {
+    FUSILLI_REQUIRE_ASSIGN(
+        auto vNewBuf,
+        allocateBufferOfType(handle, vNewT, DataType::Float, vNew));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto posBuf,
+        allocateBufferOfType(handle, posT, std::vector<int64_t>{pos}));
+    // The caches have no output buffers of their own.
+    const std::unordered_map<std::shared_ptr<TensorAttr>,
+                             std::shared_ptr<Buffer>>
+        variantPack = {
+            {qT, qBuf},
+            {kCacheT, kCacheBuf},
+            {vCacheT, vCacheBuf},
+            {kNewT, kNewBuf},
+            {vNewT, vNewBuf},
+            {posT, posBuf},
+            {oT, oBuf},
+        };
+    FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(oBuf->read(handle, result));
+    return result;
+  };
+
+  // (7 * 1 + 9) / 8
+  REQUIRE(step(2, 9.0f) == std::vector<float>(kHeadDim, 2.0f));
+  // The first token stays in the cache: (6 * 1 + 9 + 17) / 8
+  REQUIRE(step(5, 17.0f) == std::vector<float>(kHeadDim, 4.0f));
+  // Out of range positions are clamped into the cache: past the end to the
+  // last slot, (5 * 1 + 9 + 17 + 33) / 8, and negative ones to the first,
+  // (4 * 1 + 9 + 9 + 17 + 33) / 8.
+  REQUIRE(step(kMaxSeq + 3, 33.0f) == std::vector<float>(kHeadDim, 8.0f));
+  REQUIRE(step(-4, 9.0f) == std::vector<float>(kHeadDim, 9.0f));
+
+  std::vector<float> vCache;
+  FUSILLI_REQUIRE_OK(vCacheBuf->read(handle, vCache));
+  for (int64_t i = 0; i < kMaxSeq; ++i) {
+    float expected = i == 0 || i == 2 ? 9.0f
+                     : i == 5         ? 17.0f
+                     : i == 7         ? 33.0f
+                                      : 1.0f;
+    for (int64_t d = 0; d < kHeadDim; ++d)
+      REQUIRE(vCache[i * kHeadDim + d] == expected);
+  }
+}
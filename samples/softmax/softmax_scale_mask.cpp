@@ -0,0 +1,97 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("Softmax; last axis; fused scale and additive mask",
+          "[softmax][graph]") {
+  constexpr int64_t b = 2, h = 4, n = 64;
+
+  auto buildNewGraph = [=](const Handle &handle) {
+    auto graph = std::make_shared<Graph>();
+    graph->setName("softmax_sample_scale_mask");
+    graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+    auto xT = graph->tensor(TensorAttr()
+                                .setName("x")
+                                .setDim({b, h, n})
+                                .setStride({h * n, n, 1}));
+    auto maskT = graph->tensor(TensorAttr()
+                                   .setName("mask")
+                                   .setDim({b, 1, n})
+                                   .setStride({n, n, 1})); // Broadcast on h
+
+    auto softmaxAttr =
+        SoftmaxAttr().setAxis(-1).setScale(0.5f).setName("softmax");
+
+    // softmax(0.5 * x + mask) along the last axis.
+    auto yT = graph->softmax(xT, maskT, softmaxAttr);
+    yT->setName("y").setDataType(DataType::Float).setOutput(true);
+
+    // Validate, infer missing properties
+    FUSILLI_REQUIRE_OK(graph->validate());
+
+    // Compile
+    FUSILLI_REQUIRE_OK(graph->compile(handle, /*remove=*/true));
+
+    return std::make_tuple(graph, xT, maskT, yT);
+  };
+
+  // Create handle for the target backend.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  auto [graph, xT, maskT, yT] = buildNewGraph(handle);
+
+  // Every row of the (scaled, masked) input is constant, so the softmax is
+  // uniform along the reduced axis.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, xT, DataType::Float, 3.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto maskBuf,
+      allocateBufferOfType(handle, maskT, DataType::Float, -1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+
+  // Create variant pack.
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {xT, xBuf},
+          {maskT, maskBuf},
+          {yT, yBuf},
+      };
+
+  // Allocate workspace buffer if needed.
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  // Execute graph once.
+  FUSILLI_REQUIRE_OK(graph->execute(handle, variantPack, workspace));
+
+  std::vector<float> yVals;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, yVals));
+
+  constexpr size_t size = b * h * n;
+  REQUIRE(yVals.size() == size);
+  constexpr float expected = 1.0f / static_cast<float>(n);
+  constexpr float tolerance = 1e-6f;
+  for (size_t i = 0; i < size; ++i)
+    REQUIRE(std::abs(yVals[i] - expected) < tolerance);
+}
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <vector>
 
 using namespace fusilli;
@@ -204,3 +205,77 @@ TEST_CASE("Buffer read async allocated and populated buffer",
   HIP_REQUIRE_SUCCESS(hipFree(devicePtr));
   HIP_REQUIRE_SUCCESS(hipStreamDestroy(stream));
 }
+
+TEST_CASE("Buffer::importDevicePtr and DLPack round trip",
+          "[buffer][hip_tests]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(Backend::AMDGPU));
+
+  constexpr size_t elementCount = 24;
+  std::vector<float> hostData(elementCount);
+  for (size_t i = 0; i < elementCount; ++i)
+    hostData[i] = static_cast<float>(i);
+  void *devicePtr = nullptr;
+  HIP_REQUIRE_SUCCESS(hipMalloc(&devicePtr, elementCount * sizeof(float)));
+  HIP_REQUIRE_SUCCESS(hipMemcpy(devicePtr, hostData.data(),
+                                elementCount * sizeof(float),
+                                hipMemcpyHostToDevice));
+
+  {
+    // Imported without copying: the buffer aliases the HIP allocation.
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer imported,
+        Buffer::importDevicePtr(handle, devicePtr, castToSizeT({2, 3, 4}),
+                                DataType::Float, {12, 4, 1}));
+    std::vector<float> readData;
+    FUSILLI_REQUIRE_OK(imported.read(handle, readData));
+    REQUIRE(readData == hostData);
+
+    // Export and re-import through DLPack.
+    FUSILLI_REQUIRE_ASSIGN(DLManagedTensor * tensor, imported.toDLPack(handle));
+    REQUIRE(tensor->dl_tensor.device.device_type == kDLROCM);
+    REQUIRE(tensor->dl_tensor.ndim == 3);
+    REQUIRE(tensor->dl_tensor.shape[2] == 4);
+    REQUIRE(tensor->dl_tensor.dtype.code == kDLFloat);
+    REQUIRE(static_cast<uint8_t *>(tensor->dl_tensor.data) +
+                tensor->dl_tensor.byte_offset ==
+            devicePtr);
+    FUSILLI_REQUIRE_ASSIGN(Buffer roundTrip,
+                           Buffer::importDLPack(handle, tensor));
+    std::vector<float> roundTripData;
+    FUSILLI_REQUIRE_OK(roundTrip.read(handle, roundTripData));
+    REQUIRE(roundTripData == hostData);
+  }
+
+  HIP_REQUIRE_SUCCESS(hipFree(devicePtr));
+}
+
+TEST_CASE("Buffer IPC handle export", "[buffer][hip_tests]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(Backend::AMDGPU));
+
+  void *ptr;
+  const size_t elementCount = 64;
+  HIP_REQUIRE_SUCCESS(hipMalloc(&ptr, sizeof(float) * elementCount));
+  {
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer buffer,
+        Buffer::importDevicePtr(handle, ptr, {elementCount}, DataType::Float));
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer view, buffer.subview(/*byteOffset=*/64, {16}, DataType::Float));
+
+    // The handle refers to the HIP allocation, and locates the subview in it.
+    FUSILLI_REQUIRE_ASSIGN(BufferIpcHandle ipc, view.exportIpcHandle(handle));
+    hipIpcMemHandle_t expected;
+    HIP_REQUIRE_SUCCESS(hipIpcGetMemHandle(&expected, ptr));
+    REQUIRE(std::memcmp(ipc.memHandle.data(), &expected, sizeof(expected)) ==
+            0);
+    REQUIRE(ipc.byteOffset == 64);
+    REQUIRE(ipc.byteLength == 16 * sizeof(float));
+
+    // The shape must fit in the exported memory.
+    ErrorOr<Buffer> tooLarge =
+        Buffer::importIpcHandle(handle, ipc, {32}, DataType::Float);
+    REQUIRE(isError(tooLarge));
+    REQUIRE(ErrorObject(tooLarge).getCode() == ErrorCode::InvalidArgument);
+  }
+  HIP_REQUIRE_SUCCESS(hipFree(ptr));
+}
@@ -0,0 +1,99 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+#include <hip_utils.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <hip/hip_runtime.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+// c = a + b
+static Graph makeAddGraph(const std::string &name,
+                          std::shared_ptr<TensorAttr> &a,
+                          std::shared_ptr<TensorAttr> &b,
+                          std::shared_ptr<TensorAttr> &c) {
+  Graph graph;
+  graph.setName(name);
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  a = graph.tensor(TensorAttr().setName("a").setDim({1024}).setStride({1}));
+  b = graph.tensor(TensorAttr().setName("b").setDim({1024}).setStride({1}));
+  c = graph.pointwise(a, b, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  c->setName("c").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  return graph;
+}
+
+TEST_CASE("Graph `executeTimed` records HIP events on the handle's stream",
+          "[execution_timing][hip_tests]") {
+  hipStream_t stream;
+  HIP_REQUIRE_SUCCESS(hipStreamCreate(&stream));
+  auto cleanup = ScopeExit([&] { (void)hipStreamDestroy(stream); });
+  FUSILLI_REQUIRE_ASSIGN(
+      Handle handle,
+      Handle::create(Backend::AMDGPU, /*deviceId=*/0,
+                     /*stream=*/reinterpret_cast<uintptr_t>(stream)));
+
+  std::shared_ptr<TensorAttr> a, b, c;
+  Graph graph = makeAddGraph("execute_timed_add", a, b, c);
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(auto aBuf,
+                         allocateBufferOfType(handle, a, DataType::Float, 1.0));
+  FUSILLI_REQUIRE_ASSIGN(auto bBuf,
+                         allocateBufferOfType(handle, b, DataType::Float, 2.0));
+  FUSILLI_REQUIRE_ASSIGN(auto cBuf,
+                         allocateBufferOfType(handle, c, DataType::Float, 0.0));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {{a, aBuf}, {b, bBuf}, {c, cBuf}};
+
+  std::vector<ExecutionTiming> timings;
+  for (int i = 0; i < 3; ++i) {
+    FUSILLI_REQUIRE_ASSIGN(ExecutionTiming timing,
+                           graph.executeTimed(handle, variantPack, workspace));
+    // Polling never blocks, whether or not the execution completed.
+    FUSILLI_REQUIRE_OK(timing.isReady());
+    timings.push_back(std::move(timing));
+  }
+  HIP_REQUIRE_SUCCESS(hipStreamSynchronize(stream));
+
+  for (const ExecutionTiming &timing : timings) {
+    FUSILLI_REQUIRE_ASSIGN(bool ready, timing.isReady());
+    REQUIRE(ready);
+    FUSILLI_REQUIRE_ASSIGN(float milliseconds,
+                           timing.getElapsedMilliseconds());
+    REQUIRE(milliseconds >= 0.0f);
+  }
+
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(cBuf->read(handle, result));
+  for (float val : result)
+    REQUIRE(val == 3.0f);
+}
+
+TEST_CASE("Graph `executeTimed` requires a non-default stream",
+          "[execution_timing][hip_tests]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(Backend::AMDGPU));
+  std::shared_ptr<TensorAttr> a, b, c;
+  Graph graph = makeAddGraph("execute_timed_default_stream", a, b, c);
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  ErrorOr<ExecutionTiming> timing = graph.executeTimed(handle, {}, nullptr);
+  REQUIRE(isError(timing));
+  REQUIRE(ErrorObject(timing).getCode() == ErrorCode::InvalidArgument);
+}
@@ -140,3 +140,152 @@ TEST_CASE("Handle creation with stream and deviceId", "[handle][hip_tests]") {
     HIP_REQUIRE_SUCCESS(hipStreamDestroy(stream2));
   }
 }
+
+TEST_CASE("Handle creation with multiple streams", "[handle][hip_tests]") {
+  hipStream_t stream1, stream2;
+  HIP_REQUIRE_SUCCESS(hipStreamCreate(&stream1));
+  HIP_REQUIRE_SUCCESS(hipStreamCreate(&stream2));
+  std::vector<uintptr_t> streams = {reinterpret_cast<uintptr_t>(stream1),
+                                    reinterpret_cast<uintptr_t>(stream2)};
+  {
+    FUSILLI_REQUIRE_ASSIGN(
+        Handle handle,
+        Handle::create(Backend::AMDGPU, /*deviceId=*/0, streams));
+    REQUIRE(handle.getQueueCount() == 2);
+    REQUIRE(handle.getStream() == streams[0]);
+    REQUIRE(handle.nextQueueIndex() != handle.nextQueueIndex());
+
+    // c = a + b, executed once on each queue.
+    Graph graph;
+    graph.setName("multi_stream_handle_add");
+    graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+    auto a =
+        graph.tensor(TensorAttr().setName("a").setDim({64}).setStride({1}));
+    auto b =
+        graph.tensor(TensorAttr().setName("b").setDim({64}).setStride({1}));
+    auto c = graph.pointwise(a, b,
+                             PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+    c->setName("c").setOutput(true);
+    FUSILLI_REQUIRE_OK(graph.validate());
+    FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+    FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph.getWorkspaceSize());
+
+    for (size_t queue = 0; queue < handle.getQueueCount(); ++queue) {
+      FUSILLI_REQUIRE_ASSIGN(
+          auto aBuf, allocateBufferOfType(handle, a, DataType::Float, 1.0));
+      FUSILLI_REQUIRE_ASSIGN(
+          auto bBuf, allocateBufferOfType(handle, b, DataType::Float, 2.0));
+      FUSILLI_REQUIRE_ASSIGN(
+          auto cBuf, allocateBufferOfType(handle, c, DataType::Float, 0.0));
+      FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                             allocateWorkspace(handle, workspaceSize));
+      FUSILLI_REQUIRE_OK(graph.execute(
+          handle, {{a, aBuf}, {b, bBuf}, {c, cBuf}}, workspace, queue));
+      FUSILLI_REQUIRE_OK(handle.synchronize());
+      std::vector<float> result;
+      FUSILLI_REQUIRE_OK(cBuf->read(handle, result));
+      for (float val : result)
+        REQUIRE(val == 3.0f);
+    }
+
+    ErrorObject status = graph.execute(handle, {}, nullptr, /*queueIndex=*/2);
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+  }
+  HIP_REQUIRE_SUCCESS(hipStreamDestroy(stream1));
+  HIP_REQUIRE_SUCCESS(hipStreamDestroy(stream2));
+}
+
+TEST_CASE("Handle creation with stream priorities", "[handle][hip_tests]") {
+  std::vector<StreamPriority> priorities = {
+      StreamPriority::High, StreamPriority::Low, StreamPriority::Low};
+  FUSILLI_REQUIRE_ASSIGN(
+      Handle handle,
+      Handle::create(Backend::AMDGPU, /*deviceId=*/0, priorities));
+  REQUIRE(handle.getQueueCount() == 3);
+  for (size_t queue = 0; queue < priorities.size(); ++queue) {
+    REQUIRE(handle.getQueue(queue).getStreamPriority() == priorities[queue]);
+    REQUIRE(handle.getQueue(queue).getStream() != 0);
+  }
+
+  // Low priority work alternates between its queues, and normal priority
+  // work falls back to the closest class with queues.
+  PriorityScheduler scheduler(handle);
+  REQUIRE(scheduler.nextQueueIndex(StreamPriority::High) == 0);
+  REQUIRE(scheduler.nextQueueIndex(StreamPriority::Low) == 1);
+  REQUIRE(scheduler.nextQueueIndex(StreamPriority::Low) == 2);
+  size_t normalQueue = scheduler.nextQueueIndex(StreamPriority::Normal);
+  REQUIRE(normalQueue < 3);
+
+  // c = a + b, executed on each class.
+  Graph graph;
+  graph.setName("prioritized_handle_add");
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto a = graph.tensor(TensorAttr().setName("a").setDim({64}).setStride({1}));
+  auto b = graph.tensor(TensorAttr().setName("b").setDim({64}).setStride({1}));
+  auto c =
+      graph.pointwise(a, b, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  c->setName("c").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  for (StreamPriority priority : {StreamPriority::Low, StreamPriority::High}) {
+    FUSILLI_REQUIRE_ASSIGN(
+        auto aBuf, allocateBufferOfType(handle, a, DataType::Float, 1.0));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto bBuf, allocateBufferOfType(handle, b, DataType::Float, 2.0));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto cBuf, allocateBufferOfType(handle, c, DataType::Float, 0.0));
+    FUSILLI_REQUIRE_OK(scheduler.execute(
+        graph, priority, {{a, aBuf}, {b, bBuf}, {c, cBuf}}, nullptr));
+    FUSILLI_REQUIRE_OK(handle.synchronize());
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(cBuf->read(handle, result));
+    for (float val : result)
+      REQUIRE(val == 3.0f);
+  }
+}
+
+TEST_CASE("Handle creation with multiple devices", "[handle][hip_tests]") {
+  int deviceCount;
+  HIP_REQUIRE_SUCCESS(hipGetDeviceCount(&deviceCount));
+  std::vector<int> deviceIds = {0, deviceCount - 1};
+  FUSILLI_REQUIRE_ASSIGN(Handle handle,
+                         Handle::create(Backend::AMDGPU, deviceIds));
+  REQUIRE(handle.getQueueCount() == 2);
+  // Queues of handles spanning devices are selected explicitly.
+  REQUIRE(handle.nextQueueIndex() == 0);
+  REQUIRE(handle.nextQueueIndex() == 0);
+
+  // c = a + b, compiled once and executed on each device.
+  Graph graph;
+  graph.setName("multi_device_handle_add");
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto a = graph.tensor(TensorAttr().setName("a").setDim({64}).setStride({1}));
+  auto b = graph.tensor(TensorAttr().setName("b").setDim({64}).setStride({1}));
+  auto c =
+      graph.pointwise(a, b, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  c->setName("c").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph.getWorkspaceSize());
+
+  for (size_t queue = 0; queue < handle.getQueueCount(); ++queue) {
+    // Buffers are allocated on the device of the queue.
+    const Handle &device = handle.getQueue(queue);
+    FUSILLI_REQUIRE_ASSIGN(
+        auto aBuf, allocateBufferOfType(device, a, DataType::Float, 1.0));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto bBuf, allocateBufferOfType(device, b, DataType::Float, 2.0));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto cBuf, allocateBufferOfType(device, c, DataType::Float, 0.0));
+    FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                           allocateWorkspace(device, workspaceSize));
+    FUSILLI_REQUIRE_OK(graph.execute(
+        handle, {{a, aBuf}, {b, bBuf}, {c, cBuf}}, workspace, queue));
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(cBuf->read(device, result));
+    for (float val : result)
+      REQUIRE(val == 3.0f);
+  }
+}
@@ -0,0 +1,80 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+#include <hip_utils.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <hip/hip_runtime.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("HipGraph captures and replays a GraphSequence",
+          "[hip_graph][hip_tests]") {
+  hipStream_t stream;
+  HIP_REQUIRE_SUCCESS(hipStreamCreate(&stream));
+  auto cleanup = ScopeExit([&] { (void)hipStreamDestroy(stream); });
+  FUSILLI_REQUIRE_ASSIGN(
+      Handle handle,
+      Handle::create(Backend::AMDGPU, /*deviceId=*/0,
+                     /*stream=*/reinterpret_cast<uintptr_t>(stream)));
+  REQUIRE(handle.getStream() == reinterpret_cast<uintptr_t>(stream));
+
+  // c = a + b
+  Graph graph;
+  graph.setName("hip_graph_add");
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto a = graph.tensor(TensorAttr().setName("a").setDim({64}).setStride({1}));
+  auto b = graph.tensor(TensorAttr().setName("b").setDim({64}).setStride({1}));
+  auto c =
+      graph.pointwise(a, b, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  c->setName("c").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(auto aBuf,
+                         allocateBufferOfType(handle, a, DataType::Float, 1.0));
+  FUSILLI_REQUIRE_ASSIGN(auto bBuf,
+                         allocateBufferOfType(handle, b, DataType::Float, 2.0));
+  FUSILLI_REQUIRE_ASSIGN(auto cBuf,
+                         allocateBufferOfType(handle, c, DataType::Float, 0.0));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, graph.getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  GraphSequence sequence;
+  FUSILLI_REQUIRE_OK(
+      sequence.append(graph, {{a, aBuf}, {b, bBuf}, {c, cBuf}}, workspace));
+  // Warm up outside of the capture.
+  FUSILLI_REQUIRE_OK(sequence.submit(handle));
+  FUSILLI_REQUIRE_OK(handle.synchronize());
+
+  FUSILLI_REQUIRE_ASSIGN(HipGraph step,
+                         HipGraph::capture(handle, std::move(sequence)));
+  for (int i = 0; i < 3; ++i)
+    FUSILLI_REQUIRE_OK(step.replay(handle));
+  HIP_REQUIRE_SUCCESS(hipStreamSynchronize(stream));
+
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(cBuf->read(handle, result));
+  for (float val : result)
+    REQUIRE(val == 3.0f);
+}
+
+TEST_CASE("HipGraph requires a non-default stream", "[hip_graph][hip_tests]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(Backend::AMDGPU));
+  ErrorOr<HipGraph> captured = HipGraph::capture(handle, GraphSequence());
+  REQUIRE(isError(captured));
+  REQUIRE(ErrorObject(captured).getCode() == ErrorCode::InvalidArgument);
+}
@@ -0,0 +1,83 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Range and divisibility hints of the dynamic dims of `x` [B, S, C], stored
+// as [B, C, S], are bound to its argument in physical dim order. `y` has no
+// hints and is left unbound.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[?,32,?],f16>, %x: !torch.vtensor<[?,32,?],f16>, %y: !torch.vtensor<[?,32,?],f16>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %x_dim0 = torch.symbolic_int "x_dim0" {min_val = 1, max_val = 8} : !torch.int
+// TORCH-CHECK:       %x_dim1 = torch.symbolic_int "x_dim1" {min_val = 1, max_val = 256} : !torch.int
+// TORCH-CHECK:       torch.bind_symbolic_shape %x, [%x_dim0, %x_dim1], affine_map<()[s0, s1] -> (s0, 32, s1 * 16)> : !torch.vtensor<[?,32,?],f16>
+// TORCH-CHECK-NOT:   torch.bind_symbolic_shape %y
+// TORCH-CHECK:       %result_pointwise_add_perm = torch.aten.add.Tensor
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testAsmEmitterDynamicDimHints() {
+  int64_t b = 4, s = 64, c = 32;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("asm_emitter_dynamic_dim_hints")
+      .setIODataType(DataType::Half)
+      .setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(
+      TensorAttr()
+          .setName("x")
+          .setDim({b, s, c})
+          .setStride({s * c, 1, s})
+          .setDynamicDims({0, 1})
+          .setDynamicDimHint(0, {.max = 8})
+          .setDynamicDimHint(1, {.min = 16, .max = 4096, .divisor = 16}));
+  auto yT = graph->tensor(TensorAttr()
+                              .setName("y")
+                              .setDim({b, s, c})
+                              .setStride({s * c, 1, s})
+                              .setDynamicDims({0, 1}));
+
+  auto pointwiseAttr = PointwiseAttr()
+                           .setMode(PointwiseAttr::Mode::ADD)
+                           .setName("pointwise_add");
+  auto resultT = graph->pointwise(xT, yT, pointwiseAttr);
+  resultT->setName("result").setDynamicDims({0, 1}).setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testAsmEmitterDynamicDimHints();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
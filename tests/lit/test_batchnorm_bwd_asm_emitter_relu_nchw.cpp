@@ -0,0 +1,113 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// BatchNorm backward with a fused ReLU backward on the forward output Y. DX
+// reuses the two per-channel sums that produce DBIAS and DSCALE.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%dbias_: !torch.tensor<[4],f32>, %dscale_: !torch.tensor<[4],f32>, %dx_: !torch.tensor<[2,4,2,2],f32>, %dy: !torch.vtensor<[2,4,2,2],f32>, %saved_inv_variance: !torch.vtensor<[4],f32>, %saved_mean: !torch.vtensor<[4],f32>, %scale: !torch.vtensor<[4],f32>, %x: !torch.vtensor<[2,4,2,2],f32>, %y: !torch.vtensor<[2,4,2,2],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %dy_batchnorm_bwd_perm = torch.aten.permute %dy, %permute_dy_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.list<int> -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %y_batchnorm_bwd_perm = torch.aten.permute %y, %permute_y_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.list<int> -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_count_batchnorm_bwd = torch.constant.float 8.000000e+00
+// TORCH-CHECK:       %bwd_reduce_dims_batchnorm_bwd = torch.prim.ListConstruct %bwd_reduce_dims_val_0_batchnorm_bwd, %bwd_reduce_dims_val_1_batchnorm_bwd, %bwd_reduce_dims_val_2_batchnorm_bwd : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %bwd_channel_shape_batchnorm_bwd = torch.prim.ListConstruct %bwd_channel_shape_val_0_batchnorm_bwd, %bwd_channel_shape_val_1_batchnorm_bwd, %bwd_channel_shape_val_2_batchnorm_bwd, %bwd_channel_shape_val_3_batchnorm_bwd : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %bwd_vector_shape_batchnorm_bwd = torch.prim.ListConstruct %bwd_vector_shape_val_0_batchnorm_bwd : (!torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %bwd_dy_batchnorm_bwd = torch.aten.to.dtype %dy_batchnorm_bwd_perm, %bwd_f32_batchnorm_bwd, %bwd_false_batchnorm_bwd, %bwd_false_batchnorm_bwd, %bwd_none_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_relu_threshold_batchnorm_bwd = torch.constant.int 0
+// TORCH-CHECK:       %bwd_dy_relu_batchnorm_bwd = torch.aten.threshold_backward %bwd_dy_batchnorm_bwd, %bwd_y_batchnorm_bwd, %bwd_relu_threshold_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.vtensor<[2,4,2,2],f32>, !torch.int -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_mean_1d_batchnorm_bwd = torch.aten.to.dtype %saved_mean, %bwd_f32_batchnorm_bwd, %bwd_false_batchnorm_bwd, %bwd_false_batchnorm_bwd, %bwd_none_batchnorm_bwd : !torch.vtensor<[4],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[4],f32>
+// TORCH-CHECK:       %bwd_mean_batchnorm_bwd = torch.aten.view %bwd_mean_1d_batchnorm_bwd, %bwd_channel_shape_batchnorm_bwd : !torch.vtensor<[4],f32>, !torch.list<int> -> !torch.vtensor<[1,4,1,1],f32>
+// TORCH-CHECK:       %bwd_inv_std_batchnorm_bwd = torch.aten.view %bwd_inv_std_1d_batchnorm_bwd, %bwd_channel_shape_batchnorm_bwd : !torch.vtensor<[4],f32>, !torch.list<int> -> !torch.vtensor<[1,4,1,1],f32>
+// TORCH-CHECK:       %bwd_centered_batchnorm_bwd = torch.aten.sub.Tensor %bwd_x_batchnorm_bwd, %bwd_mean_batchnorm_bwd, %bwd_int1_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.vtensor<[1,4,1,1],f32>, !torch.int -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_xhat_batchnorm_bwd = torch.aten.mul.Tensor %bwd_centered_batchnorm_bwd, %bwd_inv_std_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.vtensor<[1,4,1,1],f32> -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_dbias_f32_batchnorm_bwd = torch.aten.sum.dim_IntList %bwd_dy_relu_batchnorm_bwd, %bwd_reduce_dims_batchnorm_bwd, %bwd_true_batchnorm_bwd, %bwd_none_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[1,4,1,1],f32>
+// TORCH-CHECK:       %bwd_dy_xhat_batchnorm_bwd = torch.aten.mul.Tensor %bwd_dy_relu_batchnorm_bwd, %bwd_xhat_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.vtensor<[2,4,2,2],f32> -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_dscale_f32_batchnorm_bwd = torch.aten.sum.dim_IntList %bwd_dy_xhat_batchnorm_bwd, %bwd_reduce_dims_batchnorm_bwd, %bwd_true_batchnorm_bwd, %bwd_none_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[1,4,1,1],f32>
+// TORCH-CHECK:       %bwd_dscale_mean_batchnorm_bwd = torch.aten.div.Scalar %bwd_dscale_f32_batchnorm_bwd, %bwd_count_batchnorm_bwd : !torch.vtensor<[1,4,1,1],f32>, !torch.float -> !torch.vtensor<[1,4,1,1],f32>
+// TORCH-CHECK:       %bwd_proj_batchnorm_bwd = torch.aten.mul.Tensor %bwd_xhat_batchnorm_bwd, %bwd_dscale_mean_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.vtensor<[1,4,1,1],f32> -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_dbias_mean_batchnorm_bwd = torch.aten.div.Scalar %bwd_dbias_f32_batchnorm_bwd, %bwd_count_batchnorm_bwd : !torch.vtensor<[1,4,1,1],f32>, !torch.float -> !torch.vtensor<[1,4,1,1],f32>
+// TORCH-CHECK:       %bwd_dy_centered_batchnorm_bwd = torch.aten.sub.Tensor %bwd_dy_relu_batchnorm_bwd, %bwd_dbias_mean_batchnorm_bwd, %bwd_int1_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.vtensor<[1,4,1,1],f32>, !torch.int -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_dx_unscaled_batchnorm_bwd = torch.aten.sub.Tensor %bwd_dy_centered_batchnorm_bwd, %bwd_proj_batchnorm_bwd, %bwd_int1_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.vtensor<[2,4,2,2],f32>, !torch.int -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_scale_batchnorm_bwd = torch.aten.view %bwd_scale_1d_batchnorm_bwd, %bwd_channel_shape_batchnorm_bwd : !torch.vtensor<[4],f32>, !torch.list<int> -> !torch.vtensor<[1,4,1,1],f32>
+// TORCH-CHECK:       %bwd_dx_scale_batchnorm_bwd = torch.aten.mul.Tensor %bwd_scale_batchnorm_bwd, %bwd_inv_std_batchnorm_bwd : !torch.vtensor<[1,4,1,1],f32>, !torch.vtensor<[1,4,1,1],f32> -> !torch.vtensor<[1,4,1,1],f32>
+// TORCH-CHECK:       %bwd_dx_f32_batchnorm_bwd = torch.aten.mul.Tensor %bwd_dx_unscaled_batchnorm_bwd, %bwd_dx_scale_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.vtensor<[1,4,1,1],f32> -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %dx_batchnorm_bwd_perm = torch.aten.to.dtype %bwd_dx_f32_batchnorm_bwd, %bwd_dx_dtype_batchnorm_bwd, %bwd_false_batchnorm_bwd, %bwd_false_batchnorm_bwd, %bwd_none_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %bwd_dscale_1d_batchnorm_bwd = torch.aten.view %bwd_dscale_f32_batchnorm_bwd, %bwd_vector_shape_batchnorm_bwd : !torch.vtensor<[1,4,1,1],f32>, !torch.list<int> -> !torch.vtensor<[4],f32>
+// TORCH-CHECK:       %dscale_batchnorm_bwd_perm = torch.aten.to.dtype %bwd_dscale_1d_batchnorm_bwd, %bwd_dscale_dtype_batchnorm_bwd, %bwd_false_batchnorm_bwd, %bwd_false_batchnorm_bwd, %bwd_none_batchnorm_bwd : !torch.vtensor<[4],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[4],f32>
+// TORCH-CHECK:       %bwd_dbias_1d_batchnorm_bwd = torch.aten.view %bwd_dbias_f32_batchnorm_bwd, %bwd_vector_shape_batchnorm_bwd : !torch.vtensor<[1,4,1,1],f32>, !torch.list<int> -> !torch.vtensor<[4],f32>
+// TORCH-CHECK:       %dx = torch.aten.permute %dx_batchnorm_bwd_perm, %permute_dx_batchnorm_bwd : !torch.vtensor<[2,4,2,2],f32>, !torch.list<int> -> !torch.vtensor<[2,4,2,2],f32>
+// TORCH-CHECK:       %dscale = torch.aten.permute %dscale_batchnorm_bwd_perm, %permute_dscale_batchnorm_bwd : !torch.vtensor<[4],f32>, !torch.list<int> -> !torch.vtensor<[4],f32>
+// TORCH-CHECK:       %dbias = torch.aten.permute %dbias_batchnorm_bwd_perm, %permute_dbias_batchnorm_bwd : !torch.vtensor<[4],f32>, !torch.list<int> -> !torch.vtensor<[4],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dbias overwrites %dbias_ : !torch.vtensor<[4],f32>, !torch.tensor<[4],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dscale overwrites %dscale_ : !torch.vtensor<[4],f32>, !torch.tensor<[4],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dx overwrites %dx_ : !torch.vtensor<[2,4,2,2],f32>, !torch.tensor<[2,4,2,2],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testBatchnormBwdAsmEmitterReluNchw() {
+  int64_t n = 2, c = 4, h = 2, w = 2;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("batchnorm_bwd_asm_emitter_relu_nchw");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto tensor = [&](const std::string &name) {
+    return graph->tensor(TensorAttr()
+                             .setName(name)
+                             .setDim({n, c, h, w})
+                             .setStride({c * h * w, h * w, w, 1})); // NCHW
+  };
+  auto channelTensor = [&](const std::string &name) {
+    return graph->tensor(TensorAttr().setName(name).setDim({c}).setStride({1}));
+  };
+
+  auto dyT = tensor("dy");
+  auto xT = tensor("x");
+  auto batchnormBwdAttr =
+      BatchnormBwdAttr().setY(tensor("y")).setName("batchnorm_bwd");
+  auto [dxT, dsT, dbT] = graph->batchnormBackward(
+      dyT, xT, channelTensor("scale"), channelTensor("saved_mean"),
+      channelTensor("saved_inv_variance"), batchnormBwdAttr);
+  dxT->setName("dx").setOutput(true);
+  dsT->setName("dscale").setOutput(true);
+  dbT->setName("dbias").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testBatchnormBwdAsmEmitterReluNchw();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,111 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Row-parallel matmul whose partial products are summed over the group by an
+// all-reduce, next to an all-gather along the last dim, which is transposed to
+// the front around the gather.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%g_: !torch.tensor<[4,16],f32>, %y_: !torch.tensor<[4,16],f32>, %a: !torch.vtensor<[4,8],f32>, %b: !torch.vtensor<[8,16],f32>, %h: !torch.vtensor<[4,8],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %partial_matmul_perm = torch.aten.matmul %a_matmul_perm, %b_matmul_perm : !torch.vtensor<[4,8],f32>, !torch.vtensor<[8,16],f32> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %partial_allreduce_perm = torch.aten.permute %partial, %permute_X_allreduce : !torch.vtensor<[4,16],f32>, !torch.list<int> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %collective_ranks_val_0_allreduce = torch.constant.int 0
+// TORCH-CHECK:       %collective_ranks_val_1_allreduce = torch.constant.int 1
+// TORCH-CHECK:       %collective_ranks_allreduce = torch.prim.ListConstruct %collective_ranks_val_0_allreduce, %collective_ranks_val_1_allreduce : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %collective_tag_allreduce = torch.constant.str ""
+// TORCH-CHECK:       %collective_group_size_allreduce = torch.constant.int 2
+// TORCH-CHECK:       %collective_op_allreduce = torch.constant.str "sum"
+// TORCH-CHECK:       %collective_async_allreduce = torch.c10d_functional.all_reduce %partial_allreduce_perm, %collective_op_allreduce, %collective_tag_allreduce, %collective_ranks_allreduce, %collective_group_size_allreduce : !torch.vtensor<[4,16],f32>, !torch.str, !torch.str, !torch.list<int>, !torch.int -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %y_allreduce_perm = torch.c10d_functional.wait_tensor %collective_async_allreduce : !torch.vtensor<[4,16],f32> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %y = torch.aten.permute %y_allreduce_perm, %permute_Y_allreduce : !torch.vtensor<[4,16],f32>, !torch.list<int> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %h_allgather_perm = torch.aten.permute %h, %permute_X_allgather : !torch.vtensor<[4,8],f32>, !torch.list<int> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %collective_axis_allgather = torch.constant.int 1
+// TORCH-CHECK:       %collective_dim0_allgather = torch.constant.int 0
+// TORCH-CHECK:       %collective_in_allgather = torch.aten.transpose.int %h_allgather_perm, %collective_dim0_allgather, %collective_axis_allgather : !torch.vtensor<[4,8],f32>, !torch.int, !torch.int -> !torch.vtensor<[8,4],f32>
+// TORCH-CHECK:       %collective_group_size_allgather = torch.constant.int 2
+// TORCH-CHECK-NOT:   %collective_op_allgather
+// TORCH-CHECK:       %collective_async_allgather = torch.c10d_functional.all_gather_into_tensor %collective_in_allgather, %collective_tag_allgather, %collective_ranks_allgather, %collective_group_size_allgather : !torch.vtensor<[8,4],f32>, !torch.str, !torch.list<int>, !torch.int -> !torch.vtensor<[16,4],f32>
+// TORCH-CHECK:       %collective_out_allgather = torch.c10d_functional.wait_tensor %collective_async_allgather : !torch.vtensor<[16,4],f32> -> !torch.vtensor<[16,4],f32>
+// TORCH-CHECK:       %g_allgather_perm = torch.aten.transpose.int %collective_out_allgather, %collective_dim0_allgather, %collective_axis_allgather : !torch.vtensor<[16,4],f32>, !torch.int, !torch.int -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %g = torch.aten.permute %g_allgather_perm, %permute_Y_allgather : !torch.vtensor<[4,16],f32>, !torch.list<int> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %g overwrites %g_ : !torch.vtensor<[4,16],f32>, !torch.tensor<[4,16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %y overwrites %y_ : !torch.vtensor<[4,16],f32>, !torch.tensor<[4,16],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testCollectiveAsmEmitter() {
+  auto graph = std::make_shared<Graph>();
+  graph->setName("collective_asm_emitter")
+      .setIODataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+
+  auto makeTensor = [&](const std::string &name,
+                        const std::vector<int64_t> &dim) {
+    return graph->tensor(TensorAttr().setName(name).setDim(dim).setStride(
+        generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+  auto a = makeTensor("a", {4, 8});
+  auto b = makeTensor("b", {8, 16});
+  auto h = makeTensor("h", {4, 8});
+
+  // Each rank holds a slice of the reduction dim of A and B.
+  auto matmulAttr = MatmulAttr().setName("matmul");
+  auto partial = graph->matmul(a, b, matmulAttr);
+  partial->setName("partial");
+
+  auto allReduceAttr = CollectiveAttr()
+                           .setMode(CollectiveAttr::Mode::ALL_REDUCE)
+                           .setReduceOp(CollectiveAttr::ReduceOp::SUM)
+                           .setRanks({0, 1})
+                           .setName("allreduce");
+  auto y = graph->collective(partial, allReduceAttr);
+  y->setName("y").setOutput(true);
+
+  auto allGatherAttr = CollectiveAttr()
+                           .setMode(CollectiveAttr::Mode::ALL_GATHER)
+                           .setRanks({0, 1})
+                           .setAxis(-1)
+                           .setName("allgather");
+  auto g = graph->collective(h, allGatherAttr);
+  g->setName("g").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testCollectiveAsmEmitter();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,138 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | iree-compile - --compile-to=input | \
+// RUN:             FileCheck %s --check-prefix=LINALG-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[16,64,32,32],f32>, %arg0_image: !torch.vtensor<[16,32,32,32],f32>, %arg1_filter: !torch.vtensor<[64,1,3,3],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %bias_conv_fprop = torch.constant.none
+// TORCH-CHECK:       %transposed_conv_fprop = torch.constant.bool false
+// TORCH-CHECK:       %output_padding_conv_fprop = torch.prim.ListConstruct  : () -> !torch.list<int>
+// TORCH-CHECK:       %groups_conv_fprop = torch.constant.int 64
+// TORCH-CHECK:       %stride_val_0_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %stride_val_1_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %stride_conv_fprop = torch.prim.ListConstruct %stride_val_0_conv_fprop, %stride_val_1_conv_fprop : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %padding_val_0_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %padding_val_1_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %padding_conv_fprop = torch.prim.ListConstruct %padding_val_0_conv_fprop, %padding_val_1_conv_fprop : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %dilation_val_0_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %dilation_val_1_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %dilation_conv_fprop = torch.prim.ListConstruct %dilation_val_0_conv_fprop, %dilation_val_1_conv_fprop : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %permute_X_val_0_conv_fprop = torch.constant.int 0
+// TORCH-CHECK:       %permute_X_val_1_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %permute_X_val_2_conv_fprop = torch.constant.int 2
+// TORCH-CHECK:       %permute_X_val_3_conv_fprop = torch.constant.int 3
+// TORCH-CHECK:       %permute_X_conv_fprop = torch.prim.ListConstruct %permute_X_val_0_conv_fprop, %permute_X_val_1_conv_fprop, %permute_X_val_2_conv_fprop, %permute_X_val_3_conv_fprop : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %arg0_image_conv_fprop_perm = torch.aten.permute %arg0_image, %permute_X_conv_fprop : !torch.vtensor<[16,32,32,32],f32>, !torch.list<int> -> !torch.vtensor<[16,32,32,32],f32>
+// TORCH-CHECK:       %permute_W_val_0_conv_fprop = torch.constant.int 0
+// TORCH-CHECK:       %permute_W_val_1_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %permute_W_val_2_conv_fprop = torch.constant.int 2
+// TORCH-CHECK:       %permute_W_val_3_conv_fprop = torch.constant.int 3
+// TORCH-CHECK:       %permute_W_conv_fprop = torch.prim.ListConstruct %permute_W_val_0_conv_fprop, %permute_W_val_1_conv_fprop, %permute_W_val_2_conv_fprop, %permute_W_val_3_conv_fprop : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %arg1_filter_conv_fprop_perm = torch.aten.permute %arg1_filter, %permute_W_conv_fprop : !torch.vtensor<[64,1,3,3],f32>, !torch.list<int> -> !torch.vtensor<[64,1,3,3],f32>
+// TORCH-CHECK:       %dw_unsqueeze_shape_val_0_conv_fprop = torch.constant.int 16
+// TORCH-CHECK:       %dw_unsqueeze_shape_val_1_conv_fprop = torch.constant.int 32
+// TORCH-CHECK:       %dw_unsqueeze_shape_val_2_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %dw_unsqueeze_shape_val_3_conv_fprop = torch.constant.int 32
+// TORCH-CHECK:       %dw_unsqueeze_shape_val_4_conv_fprop = torch.constant.int 32
+// TORCH-CHECK:       %dw_unsqueeze_shape_conv_fprop = torch.prim.ListConstruct %dw_unsqueeze_shape_val_0_conv_fprop, %dw_unsqueeze_shape_val_1_conv_fprop, %dw_unsqueeze_shape_val_2_conv_fprop, %dw_unsqueeze_shape_val_3_conv_fprop, %dw_unsqueeze_shape_val_4_conv_fprop : (!torch.int, !torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %dw_unsqueeze_conv_fprop = torch.aten.view %arg0_image_conv_fprop_perm, %dw_unsqueeze_shape_conv_fprop : !torch.vtensor<[16,32,32,32],f32>, !torch.list<int> -> !torch.vtensor<[16,32,1,32,32],f32>
+// TORCH-CHECK:       %dw_expand_shape_val_0_conv_fprop = torch.constant.int 16
+// TORCH-CHECK:       %dw_expand_shape_val_1_conv_fprop = torch.constant.int 32
+// TORCH-CHECK:       %dw_expand_shape_val_2_conv_fprop = torch.constant.int 2
+// TORCH-CHECK:       %dw_expand_shape_val_3_conv_fprop = torch.constant.int 32
+// TORCH-CHECK:       %dw_expand_shape_val_4_conv_fprop = torch.constant.int 32
+// TORCH-CHECK:       %dw_expand_shape_conv_fprop = torch.prim.ListConstruct %dw_expand_shape_val_0_conv_fprop, %dw_expand_shape_val_1_conv_fprop, %dw_expand_shape_val_2_conv_fprop, %dw_expand_shape_val_3_conv_fprop, %dw_expand_shape_val_4_conv_fprop : (!torch.int, !torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %dw_implicit_conv_fprop = torch.constant.bool false
+// TORCH-CHECK:       %dw_expand_conv_fprop = torch.aten.expand %dw_unsqueeze_conv_fprop, %dw_expand_shape_conv_fprop, %dw_implicit_conv_fprop : !torch.vtensor<[16,32,1,32,32],f32>, !torch.list<int>, !torch.bool -> !torch.vtensor<[16,32,2,32,32],f32>
+// TORCH-CHECK:       %dw_x_shape_val_0_conv_fprop = torch.constant.int 16
+// TORCH-CHECK:       %dw_x_shape_val_1_conv_fprop = torch.constant.int 64
+// TORCH-CHECK:       %dw_x_shape_val_2_conv_fprop = torch.constant.int 32
+// TORCH-CHECK:       %dw_x_shape_val_3_conv_fprop = torch.constant.int 32
+// TORCH-CHECK:       %dw_x_shape_conv_fprop = torch.prim.ListConstruct %dw_x_shape_val_0_conv_fprop, %dw_x_shape_val_1_conv_fprop, %dw_x_shape_val_2_conv_fprop, %dw_x_shape_val_3_conv_fprop : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %dw_x_conv_fprop = torch.aten.view %dw_expand_conv_fprop, %dw_x_shape_conv_fprop : !torch.vtensor<[16,32,2,32,32],f32>, !torch.list<int> -> !torch.vtensor<[16,64,32,32],f32>
+// TORCH-CHECK:       %result_conv_fprop_perm = torch.aten.convolution %dw_x_conv_fprop, %arg1_filter_conv_fprop_perm, %bias_conv_fprop, %stride_conv_fprop, %padding_conv_fprop, %dilation_conv_fprop, %transposed_conv_fprop, %output_padding_conv_fprop, %groups_conv_fprop : !torch.vtensor<[16,64,32,32],f32>, !torch.vtensor<[64,1,3,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[16,64,32,32],f32>
+// TORCH-CHECK:       %permute_Y_val_0_conv_fprop = torch.constant.int 0
+// TORCH-CHECK:       %permute_Y_val_1_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %permute_Y_val_2_conv_fprop = torch.constant.int 2
+// TORCH-CHECK:       %permute_Y_val_3_conv_fprop = torch.constant.int 3
+// TORCH-CHECK:       %permute_Y_conv_fprop = torch.prim.ListConstruct %permute_Y_val_0_conv_fprop, %permute_Y_val_1_conv_fprop, %permute_Y_val_2_conv_fprop, %permute_Y_val_3_conv_fprop : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result = torch.aten.permute %result_conv_fprop_perm, %permute_Y_conv_fprop : !torch.vtensor<[16,64,32,32],f32>, !torch.list<int> -> !torch.vtensor<[16,64,32,32],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[16,64,32,32],f32>, !torch.tensor<[16,64,32,32],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// The replicated input makes it a depthwise convolution with a channel
+// multiplier of 1, lowered to the dedicated depthwise op rather than the
+// generic grouped convolution.
+// LINALG-CHECK:    util.func public @main$async(
+// LINALG-CHECK-NOT:  linalg.conv_2d_ngchw_gfchw
+// LINALG-CHECK:      linalg.depthwise_conv_2d_nchw_chw
+// LINALG-CHECK-SAME:   -> tensor<16x64x32x32xf32>
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testConvAsmEmitterXNchwWKcrsDepthwise() {
+  // Depthwise with a channel multiplier of k / c = 2.
+  int64_t n = 16, c = 32, h = 32, w = 32, k = 64, r = 3, s = 3;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_asm_emitter_x_nchw_w_kcrs_depthwise");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_image")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("arg1_filter")
+                              .setDim({k, 1, r, s})
+                              .setStride({r * s, r * s, s, 1})); // KCRS
+
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({1, 1})
+                      .setStride({1, 1})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+
+  auto yT = graph->convFProp(xT, wT, convAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testConvAsmEmitterXNchwWKcrsDepthwise();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -40,18 +40,8 @@
 // TORCH-CHECK:       %permute_W_conv_fprop = torch.prim.ListConstruct %permute_W_val_0_conv_fprop, %permute_W_val_1_conv_fprop, %permute_W_val_2_conv_fprop, %permute_W_val_3_conv_fprop : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
 // TORCH-CHECK:       %arg1_filter_conv_fprop_perm = torch.aten.permute %arg1_filter, %permute_W_conv_fprop : !torch.vtensor<[256,128,1,1],f32>, !torch.list<int> -> !torch.vtensor<[256,128,1,1],f32>
 // TORCH-CHECK:       %conv_result_conv_fprop_perm = torch.aten.convolution %arg0_image_conv_fprop_perm, %arg1_filter_conv_fprop_perm, %bias_conv_fprop, %stride_conv_fprop, %padding_conv_fprop, %dilation_conv_fprop, %transposed_conv_fprop, %output_padding_conv_fprop, %groups_conv_fprop : !torch.vtensor<[16,128,64,32],f32>, !torch.vtensor<[256,128,1,1],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[16,256,64,32],f32>
-// TORCH-CHECK:       %permute_Y_val_0_conv_fprop = torch.constant.int 0
-// TORCH-CHECK:       %permute_Y_val_1_conv_fprop = torch.constant.int 2
-// TORCH-CHECK:       %permute_Y_val_2_conv_fprop = torch.constant.int 3
-// TORCH-CHECK:       %permute_Y_val_3_conv_fprop = torch.constant.int 1
-// TORCH-CHECK:       %permute_Y_conv_fprop = torch.prim.ListConstruct %permute_Y_val_0_conv_fprop, %permute_Y_val_1_conv_fprop, %permute_Y_val_2_conv_fprop, %permute_Y_val_3_conv_fprop : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
-// TORCH-CHECK:       %conv_result = torch.aten.permute %conv_result_conv_fprop_perm, %permute_Y_conv_fprop : !torch.vtensor<[16,256,64,32],f32>, !torch.list<int> -> !torch.vtensor<[16,64,32,256],f32>
-// TORCH-CHECK:       %permute_IN_0_val_0_pointwise_1 = torch.constant.int 0
-// TORCH-CHECK:       %permute_IN_0_val_1_pointwise_1 = torch.constant.int 3
-// TORCH-CHECK:       %permute_IN_0_val_2_pointwise_1 = torch.constant.int 1
-// TORCH-CHECK:       %permute_IN_0_val_3_pointwise_1 = torch.constant.int 2
-// TORCH-CHECK:       %permute_IN_0_pointwise_1 = torch.prim.ListConstruct %permute_IN_0_val_0_pointwise_1, %permute_IN_0_val_1_pointwise_1, %permute_IN_0_val_2_pointwise_1, %permute_IN_0_val_3_pointwise_1 : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
-// TORCH-CHECK:       %conv_result_pointwise_1_perm = torch.aten.permute %conv_result, %permute_IN_0_pointwise_1 : !torch.vtensor<[16,64,32,256],f32>, !torch.list<int> -> !torch.vtensor<[16,256,64,32],f32>
+// TORCH-CHECK:       %conv_result = torch.tensor_static_info_cast %conv_result_conv_fprop_perm : !torch.vtensor<[16,256,64,32],f32> to !torch.vtensor<[16,256,64,32],f32>
+// TORCH-CHECK:       %conv_result_pointwise_1_perm = torch.tensor_static_info_cast %conv_result : !torch.vtensor<[16,256,64,32],f32> to !torch.vtensor<[16,256,64,32],f32>
 // TORCH-CHECK:       %permute_IN_1_val_0_pointwise_1 = torch.constant.int 0
 // TORCH-CHECK:       %permute_IN_1_val_1_pointwise_1 = torch.constant.int 1
 // TORCH-CHECK:       %permute_IN_1_val_2_pointwise_1 = torch.constant.int 2
@@ -60,18 +50,8 @@
 // TORCH-CHECK:       %bias_pointwise_1_perm = torch.aten.permute %bias, %permute_IN_1_pointwise_1 : !torch.vtensor<[1,256,1,1],f32>, !torch.list<int> -> !torch.vtensor<[1,256,1,1],f32>
 // TORCH-CHECK:       %alpha_pointwise_1 = torch.constant.int 1
 // TORCH-CHECK:       %bias_result_pointwise_1_perm = torch.aten.add.Tensor %conv_result_pointwise_1_perm, %bias_pointwise_1_perm, %alpha_pointwise_1 : !torch.vtensor<[16,256,64,32],f32>, !torch.vtensor<[1,256,1,1],f32>, !torch.int -> !torch.vtensor<[16,256,64,32],f32>
-// TORCH-CHECK:       %permute_OUT_0_val_0_pointwise_1 = torch.constant.int 0
-// TORCH-CHECK:       %permute_OUT_0_val_1_pointwise_1 = torch.constant.int 2
-// TORCH-CHECK:       %permute_OUT_0_val_2_pointwise_1 = torch.constant.int 3
-// TORCH-CHECK:       %permute_OUT_0_val_3_pointwise_1 = torch.constant.int 1
-// TORCH-CHECK:       %permute_OUT_0_pointwise_1 = torch.prim.ListConstruct %permute_OUT_0_val_0_pointwise_1, %permute_OUT_0_val_1_pointwise_1, %permute_OUT_0_val_2_pointwise_1, %permute_OUT_0_val_3_pointwise_1 : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
-// TORCH-CHECK:       %bias_result = torch.aten.permute %bias_result_pointwise_1_perm, %permute_OUT_0_pointwise_1 : !torch.vtensor<[16,256,64,32],f32>, !torch.list<int> -> !torch.vtensor<[16,64,32,256],f32>
-// TORCH-CHECK:       %permute_IN_0_val_0_pointwise_2 = torch.constant.int 0
-// TORCH-CHECK:       %permute_IN_0_val_1_pointwise_2 = torch.constant.int 3
-// TORCH-CHECK:       %permute_IN_0_val_2_pointwise_2 = torch.constant.int 1
-// TORCH-CHECK:       %permute_IN_0_val_3_pointwise_2 = torch.constant.int 2
-// TORCH-CHECK:       %permute_IN_0_pointwise_2 = torch.prim.ListConstruct %permute_IN_0_val_0_pointwise_2, %permute_IN_0_val_1_pointwise_2, %permute_IN_0_val_2_pointwise_2, %permute_IN_0_val_3_pointwise_2 : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
-// TORCH-CHECK:       %bias_result_pointwise_2_perm = torch.aten.permute %bias_result, %permute_IN_0_pointwise_2 : !torch.vtensor<[16,64,32,256],f32>, !torch.list<int> -> !torch.vtensor<[16,256,64,32],f32>
+// TORCH-CHECK:       %bias_result = torch.tensor_static_info_cast %bias_result_pointwise_1_perm : !torch.vtensor<[16,256,64,32],f32> to !torch.vtensor<[16,256,64,32],f32>
+// TORCH-CHECK:       %bias_result_pointwise_2_perm = torch.tensor_static_info_cast %bias_result : !torch.vtensor<[16,256,64,32],f32> to !torch.vtensor<[16,256,64,32],f32>
 // TORCH-CHECK:       %result_pointwise_2_perm = torch.aten.relu %bias_result_pointwise_2_perm : !torch.vtensor<[16,256,64,32],f32> -> !torch.vtensor<[16,256,64,32],f32>
 // TORCH-CHECK:       %permute_OUT_0_val_0_pointwise_2 = torch.constant.int 0
 // TORCH-CHECK:       %permute_OUT_0_val_1_pointwise_2 = torch.constant.int 2
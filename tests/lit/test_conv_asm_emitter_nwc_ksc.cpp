@@ -0,0 +1,93 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// 1D convolution in channels-last layout, emitted directly as a rank 3
+// convolution instead of a 2D one with a unit H dim.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[4,128,32],f32>, %arg0_x: !torch.vtensor<[4,128,16],f32>, %arg1_w: !torch.vtensor<[32,3,16],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %bias_conv_fprop = torch.constant.none
+// TORCH-CHECK:       %transposed_conv_fprop = torch.constant.bool false
+// TORCH-CHECK:       %groups_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %stride_val_0_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %stride_conv_fprop = torch.prim.ListConstruct %stride_val_0_conv_fprop : (!torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %padding_val_0_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %padding_conv_fprop = torch.prim.ListConstruct %padding_val_0_conv_fprop : (!torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %dilation_val_0_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %dilation_conv_fprop = torch.prim.ListConstruct %dilation_val_0_conv_fprop : (!torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %permute_X_val_0_conv_fprop = torch.constant.int 0
+// TORCH-CHECK:       %permute_X_val_1_conv_fprop = torch.constant.int 2
+// TORCH-CHECK:       %permute_X_val_2_conv_fprop = torch.constant.int 1
+// TORCH-CHECK:       %arg0_x_conv_fprop_perm = torch.aten.permute %arg0_x, %permute_X_conv_fprop : !torch.vtensor<[4,128,16],f32>, !torch.list<int> -> !torch.vtensor<[4,16,128],f32>
+// TORCH-CHECK:       %arg1_w_conv_fprop_perm = torch.aten.permute %arg1_w, %permute_W_conv_fprop : !torch.vtensor<[32,3,16],f32>, !torch.list<int> -> !torch.vtensor<[32,16,3],f32>
+// TORCH-CHECK:       %result_conv_fprop_perm = torch.aten.convolution %arg0_x_conv_fprop_perm, %arg1_w_conv_fprop_perm, %bias_conv_fprop, %stride_conv_fprop, %padding_conv_fprop, %dilation_conv_fprop, %transposed_conv_fprop, %output_padding_conv_fprop, %groups_conv_fprop : !torch.vtensor<[4,16,128],f32>, !torch.vtensor<[32,16,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[4,32,128],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_conv_fprop_perm, %permute_Y_conv_fprop : !torch.vtensor<[4,32,128],f32>, !torch.list<int> -> !torch.vtensor<[4,128,32],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[4,128,32],f32>, !torch.tensor<[4,128,32],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testConvAsmEmitterXNwcWKsc() {
+  int64_t n = 4, c = 16, w = 128, k = 32, s = 3;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_asm_emitter_x_nwc_w_ksc");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_x")
+                              .setDim({n, c, w})
+                              .setStride({c * w, 1, c})); // NWC
+
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("arg1_w")
+                              .setDim({k, c, s})
+                              .setStride({c * s, 1, c})); // KSC
+
+  auto convAttr = ConvFPropAttr()
+                      .setPadding({1})
+                      .setStride({1})
+                      .setDilation({1})
+                      .setName("conv_fprop");
+
+  auto yT = graph->convFProp(xT, wT, convAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testConvAsmEmitterXNwcWKsc();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,125 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=FOLD-CHECK
+
+// The inference batchnorm `bn` with embedded statistics is folded on the host
+// into a constant filter and bias of the convolution `conv`, which writes its
+// output. Only the input is left as an argument, and no normalization or
+// filter scaling is emitted.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%fold_Y_: !torch.tensor<[4,16,8,8],f32>, %fold_X: !torch.vtensor<[4,8,8,8],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %bn_FOLDED_BIAS = torch.vtensor.literal(dense<"0x{{[0-9A-F]+}}"> : tensor<16xf32>) : !torch.vtensor<[16],f32>
+// TORCH-CHECK:       %bn_FOLDED_W = torch.vtensor.literal(dense<"0x{{[0-9A-F]+}}"> : tensor<16x8x1x1xf32>) : !torch.vtensor<[16,8,1,1],f32>
+// TORCH-CHECK:       %fold_X_conv_perm = torch.aten.permute %fold_X, %permute_X_conv : !torch.vtensor<[4,8,8,8],f32>, !torch.list<int> -> !torch.vtensor<[4,8,8,8],f32>
+// TORCH-CHECK:       %bn_FOLDED_W_conv_perm = torch.aten.permute %bn_FOLDED_W, %permute_W_conv : !torch.vtensor<[16,8,1,1],f32>, !torch.list<int> -> !torch.vtensor<[16,8,1,1],f32>
+// TORCH-CHECK:       %fold_Y_conv_perm = torch.aten.convolution %fold_X_conv_perm, %bn_FOLDED_W_conv_perm, %bn_FOLDED_BIAS, %stride_conv, %padding_conv, %dilation_conv, %transposed_conv, %output_padding_conv, %groups_conv : !torch.vtensor<[4,8,8,8],f32>, !torch.vtensor<[16,8,1,1],f32>, !torch.vtensor<[16],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[4,16,8,8],f32>
+// TORCH-CHECK:       %fold_Y = torch.aten.permute %fold_Y_conv_perm, %permute_Y_conv : !torch.vtensor<[4,16,8,8],f32>, !torch.list<int> -> !torch.vtensor<[4,16,8,8],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %fold_Y overwrites %fold_Y_ : !torch.vtensor<[4,16,8,8],f32>, !torch.tensor<[4,16,8,8],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// FOLD-CHECK-NOT:    torch.constant.none
+// FOLD-CHECK-NOT:    torch.aten.native_batch_norm
+// FOLD-CHECK-NOT:    torch.aten.rsqrt
+// FOLD-CHECK-NOT:    torch.aten.mul.Tensor
+// FOLD-CHECK-NOT:    fold_MEAN
+// FOLD-CHECK-NOT:    fold_MOMENTUM
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testConvBatchnormFoldAsmEmitterNchw() {
+  int64_t n = 4, c = 8, h = 8, w = 8, k = 16, r = 1, s = 1;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_batchnorm_fold_asm_emitter_nchw");
+  graph->setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("fold_X")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+  auto constantData = [](size_t volume, float value) {
+    std::vector<float> values(volume, value);
+    std::vector<uint8_t> bytes(volume * sizeof(float));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    return bytes;
+  };
+
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("fold_W")
+                              .setDim({k, c, r, s})
+                              .setStride({c * r * s, r * s, s, 1}) // KCRS
+                              .setConstantData(constantData(k * c, 0.5f)));
+
+  auto convAttr = ConvFPropAttr()
+                      .setStride({1, 1})
+                      .setPadding({0, 0})
+                      .setDilation({1, 1})
+                      .setName("conv");
+  auto convT = graph->convFProp(xT, wT, convAttr);
+
+  auto channelTensor = [&](const std::string &name, float value) {
+    return graph->tensor(TensorAttr()
+                             .setName(name)
+                             .setDim({k})
+                             .setStride({1})
+                             .setConstantData(constantData(k, value)));
+  };
+  auto scaleT = channelTensor("fold_SCALE", 2.0f);
+  auto biasT = channelTensor("fold_BIAS", 1.0f);
+  auto meanT = channelTensor("fold_MEAN", 0.5f);
+  auto varT = channelTensor("fold_VAR", 4.0f);
+  auto epsilonT = graph->tensor(TensorAttr(1e-5f).setName("fold_EPSILON"));
+  auto momentumT = graph->tensor(TensorAttr(0.1f).setName("fold_MOMENTUM"));
+
+  auto batchnormAttr = BatchnormAttr()
+                           .setForwardPhase(NormFwdPhase::INFERENCE)
+                           .setEpsilon(epsilonT)
+                           .setMomentum(momentumT)
+                           .setName("bn");
+  auto [yT, smT, sivT] =
+      graph->batchnorm(convT, scaleT, biasT, meanT, varT, batchnormAttr);
+  yT->setName("fold_Y").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testConvBatchnormFoldAsmEmitterNchw();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
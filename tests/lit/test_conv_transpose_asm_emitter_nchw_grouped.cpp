@@ -0,0 +1,99 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Grouped 2x upsampling transposed convolution, where the output padding
+// picks the even output size 8 over 7.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[2,4,8,8],f32>, %arg0_x: !torch.vtensor<[2,8,4,4],f32>, %arg1_w: !torch.vtensor<[8,2,3,3],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %bias_conv_transpose = torch.constant.none
+// TORCH-CHECK:       %transposed_conv_transpose = torch.constant.bool true
+// TORCH-CHECK:       %groups_conv_transpose = torch.constant.int 2
+// TORCH-CHECK:       %stride_val_0_conv_transpose = torch.constant.int 2
+// TORCH-CHECK:       %stride_val_1_conv_transpose = torch.constant.int 2
+// TORCH-CHECK:       %stride_conv_transpose = torch.prim.ListConstruct %stride_val_0_conv_transpose, %stride_val_1_conv_transpose : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %padding_val_0_conv_transpose = torch.constant.int 1
+// TORCH-CHECK:       %padding_val_1_conv_transpose = torch.constant.int 1
+// TORCH-CHECK:       %padding_conv_transpose = torch.prim.ListConstruct %padding_val_0_conv_transpose, %padding_val_1_conv_transpose : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %dilation_val_0_conv_transpose = torch.constant.int 1
+// TORCH-CHECK:       %dilation_val_1_conv_transpose = torch.constant.int 1
+// TORCH-CHECK:       %dilation_conv_transpose = torch.prim.ListConstruct %dilation_val_0_conv_transpose, %dilation_val_1_conv_transpose : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %output_padding_val_0_conv_transpose = torch.constant.int 1
+// TORCH-CHECK:       %output_padding_val_1_conv_transpose = torch.constant.int 1
+// TORCH-CHECK:       %output_padding_conv_transpose = torch.prim.ListConstruct %output_padding_val_0_conv_transpose, %output_padding_val_1_conv_transpose : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %arg0_x_conv_transpose_perm = torch.aten.permute %arg0_x, %permute_X_conv_transpose : !torch.vtensor<[2,8,4,4],f32>, !torch.list<int> -> !torch.vtensor<[2,8,4,4],f32>
+// TORCH-CHECK:       %arg1_w_conv_transpose_perm = torch.aten.permute %arg1_w, %permute_W_conv_transpose : !torch.vtensor<[8,2,3,3],f32>, !torch.list<int> -> !torch.vtensor<[8,2,3,3],f32>
+// TORCH-CHECK:       %result_conv_transpose_perm = torch.aten.convolution %arg0_x_conv_transpose_perm, %arg1_w_conv_transpose_perm, %bias_conv_transpose, %stride_conv_transpose, %padding_conv_transpose, %dilation_conv_transpose, %transposed_conv_transpose, %output_padding_conv_transpose, %groups_conv_transpose : !torch.vtensor<[2,8,4,4],f32>, !torch.vtensor<[8,2,3,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[2,4,8,8],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_conv_transpose_perm, %permute_Y_conv_transpose : !torch.vtensor<[2,4,8,8],f32>, !torch.list<int> -> !torch.vtensor<[2,4,8,8],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[2,4,8,8],f32>, !torch.tensor<[2,4,8,8],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testConvTransposeAsmEmitterNchwGrouped() {
+  int64_t n = 2, c = 8, h = 4, w = 4, k = 4, r = 3, s = 3, g = 2;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_transpose_asm_emitter_nchw_grouped");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_x")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+  // Transposed filter layout [C, K/G, R, S].
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("arg1_w")
+                              .setDim({c, k / g, r, s})
+                              .setStride({k / g * r * s, r * s, s, 1}));
+
+  auto convTransposeAttr = ConvTransposeAttr()
+                               .setPadding({1, 1})
+                               .setStride({2, 2})
+                               .setDilation({1, 1})
+                               .setOutputPadding({1, 1})
+                               .setGroupCount(g)
+                               .setName("conv_transpose");
+
+  auto yT = graph->convTranspose(xT, wT, convTransposeAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testConvTransposeAsmEmitterNchwGrouped();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
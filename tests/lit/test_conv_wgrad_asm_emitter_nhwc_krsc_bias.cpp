@@ -0,0 +1,85 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Weight gradient with the bias gradient: the same convolution_backward op
+// computes both, with the bias sizes [K] and the last output mask element
+// set, so DY is read once.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%db_: !torch.tensor<[16],f32>, %dw_: !torch.tensor<[16,8,1,1],f32>, %dy: !torch.vtensor<[2,4,4,16],f32>, %x: !torch.vtensor<[2,4,4,8],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %bias_val_0_conv_wgrad = torch.constant.int 16
+// TORCH-CHECK:       %bias_conv_wgrad = torch.prim.ListConstruct %bias_val_0_conv_wgrad : (!torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %output_mask_conv_wgrad = torch.prim.ListConstruct %false_conv_wgrad, %true_conv_wgrad, %true_conv_wgrad : (!torch.bool, !torch.bool, !torch.bool) -> !torch.list<bool>
+// TORCH-CHECK:       %grad_input_conv_wgrad, %dw_conv_wgrad_perm, %db_conv_wgrad_perm = torch.aten.convolution_backward %dy_conv_wgrad_perm, %x_conv_wgrad_perm, %empty_w_conv_wgrad, %bias_conv_wgrad, %stride_conv_wgrad, %padding_conv_wgrad, %dilation_conv_wgrad, %transposed_conv_wgrad, %output_padding_conv_wgrad, %groups_conv_wgrad, %output_mask_conv_wgrad : !torch.vtensor<[2,16,4,4],f32>, !torch.vtensor<[2,8,4,4],f32>, !torch.vtensor<[16,8,1,1],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int, !torch.list<bool> -> !torch.none, !torch.vtensor<[16,8,1,1],f32>, !torch.vtensor<[16],f32>
+// TORCH-CHECK:       %dw = torch.aten.permute %dw_conv_wgrad_perm, %permute_DW_conv_wgrad : !torch.vtensor<[16,8,1,1],f32>, !torch.list<int> -> !torch.vtensor<[16,8,1,1],f32>
+// TORCH-CHECK:       %db = torch.aten.permute %db_conv_wgrad_perm, %permute_DBIAS_conv_wgrad : !torch.vtensor<[16],f32>, !torch.list<int> -> !torch.vtensor<[16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %db overwrites %db_ : !torch.vtensor<[16],f32>, !torch.tensor<[16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dw overwrites %dw_ : !torch.vtensor<[16,8,1,1],f32>, !torch.tensor<[16,8,1,1],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testConvWgradAsmEmitterBias() {
+  int64_t n = 2, c = 8, h = 4, w = 4, k = 16, r = 1, s = 1;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("conv_wgrad_asm_emitter_nhwc_krsc_bias");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto dyT = graph->tensor(TensorAttr()
+                               .setName("dy")
+                               .setDim({n, k, h, w})
+                               .setStride({k * h * w, 1, k * w, k})); // NHWC
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+  auto convWGradAttr = ConvWGradAttr()
+                           .setPadding({0, 0})
+                           .setStride({1, 1})
+                           .setDilation({1, 1})
+                           .setName("conv_wgrad");
+
+  auto [dwT, dbT] = graph->convWGradWithBias(dyT, xT, convWGradAttr);
+
+  dwT->setName("dw").setOutput(true).setDim({k, c, r, s});
+  dbT->setName("db").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testConvWgradAsmEmitterBias();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,98 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s
+
+// clang-format off
+//
+// CHECK:       module @module {
+// CHECK:         hal.executable.source private @my_scale_executable attributes {
+// CHECK:           objects = #hal.executable.objects<{
+// CHECK:             #hal.executable.target<"rocm", "rocm-hsaco-fb", {target_arch = "gfx942"}> = [
+// CHECK:               #hal.executable.object<{path = "{{.*}}fusilli_lit_external_kernel.co"}>
+// CHECK:           hal.executable.export public @scale_kernel ordinal(0)
+// CHECK:               #hal.pipeline.binding<storage_buffer, ReadOnly>,
+// CHECK-NEXT:          #hal.pipeline.binding<storage_buffer, ReadOnly>,
+// CHECK-NEXT:          #hal.pipeline.binding<storage_buffer>
+// CHECK:             count(%device: !hal.device) -> (index, index, index) {
+// CHECK:             %x = arith.constant 8 : index
+// CHECK:             hal.return %x, %y, %z : index, index, index
+// CHECK:           } attributes {workgroup_size = [64 : index, 1 : index, 1 : index]}
+// CHECK:         func.func private @my_scale(%arg0: !torch.vtensor<[4,128],f32>, %arg1: !torch.vtensor<[4,128],si32>) -> !torch.vtensor<[4,128],f32> {
+// CHECK:           %in0 = torch_c.to_builtin_tensor %arg0 : !torch.vtensor<[4,128],f32> -> tensor<4x128xf32>
+// CHECK:           %in1 = torch_c.to_builtin_tensor %arg1 : !torch.vtensor<[4,128],si32> -> tensor<4x128xi32>
+// CHECK:           %res = flow.dispatch @my_scale_executable::@scale_kernel(%in0, %in1) : (tensor<4x128xf32>, tensor<4x128xi32>) -> tensor<4x128xf32>
+// CHECK:           %out0 = torch_c.from_builtin_tensor %res : tensor<4x128xf32> -> !torch.vtensor<[4,128],f32>
+// CHECK:           return %out0 : !torch.vtensor<[4,128],f32>
+// CHECK:         func.func @main(
+// CHECK:           %{{.*}} = func.call @my_scale(%{{.*}}, %{{.*}}) : (!torch.vtensor<[4,128],f32>, !torch.vtensor<[4,128],si32>) -> !torch.vtensor<[4,128],f32>
+// CHECK:           return
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace fusilli;
+
+int main() {
+  // The emitter only references the code object, a placeholder suffices.
+  std::filesystem::path objectPath =
+      std::filesystem::temp_directory_path() / "fusilli_lit_external_kernel.co";
+  std::ofstream(objectPath, std::ios::binary) << "hsaco";
+
+  Graph g;
+  g.setName("custom_op_asm_emitter_external_kernel")
+      .setIODataType(DataType::Float);
+
+  auto x = g.tensor(
+      TensorAttr().setName("x").setDim({4, 128}).setStride({128, 1}));
+  auto s = g.tensor(TensorAttr()
+                        .setName("s")
+                        .setDim({4, 128})
+                        .setStride({128, 1})
+                        .setDataType(DataType::Int32));
+
+  CustomOpAttr scaleAttr;
+  scaleAttr.setName("my_scale")
+      .setExternalKernel({.objectPath = objectPath.string(),
+                          .entryPoint = "scale_kernel",
+                          .workgroupSize = {64, 1, 1},
+                          .workgroupCount = {8, 1, 1}})
+      .setNumOutputs(1)
+      .setOutputSameAsInput(/*output=*/0, /*input=*/0);
+
+  auto outs = g.customOp({x, s}, scaleAttr);
+  outs[0]->setOutput(true);
+
+  auto status = g.validate();
+  if (isError(status)) {
+    std::cerr << "Validation failed: " << status << std::endl;
+    return 1;
+  }
+
+  auto asmOrErr = g.emitAsm();
+  if (isError(asmOrErr)) {
+    std::cerr << "ASM emission failed: " << asmOrErr << std::endl;
+    return 1;
+  }
+
+  auto indentErr = checkMlirIndentation(*asmOrErr);
+  if (isError(indentErr)) {
+    std::cerr << "Indentation check failed: " << indentErr << std::endl;
+    return 1;
+  }
+
+  std::cout << *asmOrErr << std::endl;
+  return 0;
+}
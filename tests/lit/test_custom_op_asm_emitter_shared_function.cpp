@@ -0,0 +1,83 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s
+
+// Custom ops instantiating the same template with the same types share a
+// single function, ops with other types get their own.
+//
+// clang-format off
+//
+// CHECK:       module @module {
+// CHECK:         func.func private @neg_a(%arg0: !torch.vtensor<[4],f32>) -> !torch.vtensor<[4],f32> {
+// CHECK:         func.func private @neg_c(%arg0: !torch.vtensor<[8],f32>) -> !torch.vtensor<[8],f32> {
+// CHECK-NOT:     func.func private @neg_b
+// CHECK:         func.func @main(
+// CHECK:           %{{.*}} = func.call @neg_a(%{{.*}}) : (!torch.vtensor<[4],f32>) -> !torch.vtensor<[4],f32>
+// CHECK:           %{{.*}} = func.call @neg_a(%{{.*}}) : (!torch.vtensor<[4],f32>) -> !torch.vtensor<[4],f32>
+// CHECK:           %{{.*}} = func.call @neg_c(%{{.*}}) : (!torch.vtensor<[8],f32>) -> !torch.vtensor<[8],f32>
+// CHECK:           return
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+int main() {
+  Graph g;
+  g.setName("custom_op_asm_emitter_shared_function")
+      .setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float);
+
+  std::string negMlir = R"(
+  func.func private @{FUNC_NAME}(%arg0: {IN0_TYPE}) -> {OUT0_TYPE} {
+    %0 = torch.aten.neg %arg0 : {IN0_TYPE} -> {OUT0_TYPE}
+    return %0 : {OUT0_TYPE}
+  }
+)";
+
+  auto neg = [&](const std::shared_ptr<TensorAttr> &x,
+                 const std::string &name) {
+    CustomOpAttr attr;
+    attr.setName(name).setMlir(negMlir).setNumOutputs(1).setOutputSameAsInput(
+        /*output=*/0, /*input=*/0);
+    return g.customOp({x}, attr)[0];
+  };
+
+  auto x = g.tensor(TensorAttr().setName("x").setDim({4}).setStride({1}));
+  auto y = g.tensor(TensorAttr().setName("y").setDim({8}).setStride({1}));
+  neg(neg(x, "neg_a"), "neg_b")->setOutput(true);
+  neg(y, "neg_c")->setOutput(true);
+
+  auto status = g.validate();
+  if (isError(status)) {
+    std::cerr << "Validation failed: " << status << std::endl;
+    return 1;
+  }
+
+  auto asmOrErr = g.emitAsm();
+  if (isError(asmOrErr)) {
+    std::cerr << "ASM emission failed: " << asmOrErr << std::endl;
+    return 1;
+  }
+
+  auto indentErr = checkMlirIndentation(*asmOrErr);
+  if (isError(indentErr)) {
+    std::cerr << "Indentation check failed: " << indentErr << std::endl;
+    return 1;
+  }
+
+  std::cout << *asmOrErr << std::endl;
+  return 0;
+}
@@ -0,0 +1,94 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%dbias_: !torch.tensor<[1,4,8],f32>, %dscale_: !torch.tensor<[1,4,8],f32>, %dx_: !torch.tensor<[2,4,8],f32>, %dy: !torch.vtensor<[2,4,8],f32>, %inv_variance: !torch.vtensor<[2,1,1],f32>, %mean: !torch.vtensor<[2,1,1],f32>, %scale: !torch.vtensor<[1,4,8],f32>, %x: !torch.vtensor<[2,4,8],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %dy_layernorm_bwd_perm = torch.aten.permute %dy, %permute_dy_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.list<int> -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %inv_variance_layernorm_bwd_perm = torch.aten.permute %inv_variance, %permute_inv_variance_layernorm_bwd : !torch.vtensor<[2,1,1],f32>, !torch.list<int> -> !torch.vtensor<[2,1,1],f32>
+// TORCH-CHECK:       %bwd_norm_dims_layernorm_bwd = torch.prim.ListConstruct %bwd_norm_dims_val_0_layernorm_bwd, %bwd_norm_dims_val_1_layernorm_bwd : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %bwd_batch_dims_layernorm_bwd = torch.prim.ListConstruct %bwd_batch_dims_val_0_layernorm_bwd : (!torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %bwd_dy_layernorm_bwd = torch.aten.to.dtype %dy_layernorm_bwd_perm, %bwd_f32_layernorm_bwd, %bwd_false_layernorm_bwd, %bwd_false_layernorm_bwd, %bwd_none_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_centered_layernorm_bwd = torch.aten.sub.Tensor %bwd_x_layernorm_bwd, %bwd_mean_layernorm_bwd, %bwd_int1_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[2,1,1],f32>, !torch.int -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_xhat_layernorm_bwd = torch.aten.mul.Tensor %bwd_centered_layernorm_bwd, %bwd_inv_std_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[2,1,1],f32> -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_g_layernorm_bwd = torch.aten.mul.Tensor %bwd_dy_layernorm_bwd, %bwd_scale_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[1,4,8],f32> -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_g_xhat_mean_layernorm_bwd = torch.aten.mean.dim %bwd_g_xhat_layernorm_bwd, %bwd_norm_dims_layernorm_bwd, %bwd_true_layernorm_bwd, %bwd_none_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[2,1,1],f32>
+// TORCH-CHECK:       %bwd_g_mean_layernorm_bwd = torch.aten.mean.dim %bwd_g_layernorm_bwd, %bwd_norm_dims_layernorm_bwd, %bwd_true_layernorm_bwd, %bwd_none_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[2,1,1],f32>
+// TORCH-CHECK:       %bwd_dx_unscaled_layernorm_bwd = torch.aten.sub.Tensor %bwd_g_centered_layernorm_bwd, %bwd_proj_layernorm_bwd, %bwd_int1_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[2,4,8],f32>, !torch.int -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_dx_f32_layernorm_bwd = torch.aten.mul.Tensor %bwd_dx_unscaled_layernorm_bwd, %bwd_inv_std_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[2,1,1],f32> -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %dx_layernorm_bwd_perm = torch.aten.to.dtype %bwd_dx_f32_layernorm_bwd, %bwd_dx_dtype_layernorm_bwd, %bwd_false_layernorm_bwd, %bwd_false_layernorm_bwd, %bwd_none_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_dy_xhat_layernorm_bwd = torch.aten.mul.Tensor %bwd_dy_layernorm_bwd, %bwd_xhat_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[2,4,8],f32> -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_dscale_f32_layernorm_bwd = torch.aten.sum.dim_IntList %bwd_dy_xhat_layernorm_bwd, %bwd_batch_dims_layernorm_bwd, %bwd_true_layernorm_bwd, %bwd_none_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[1,4,8],f32>
+// TORCH-CHECK:       %bwd_dbias_f32_layernorm_bwd = torch.aten.sum.dim_IntList %bwd_dy_layernorm_bwd, %bwd_batch_dims_layernorm_bwd, %bwd_true_layernorm_bwd, %bwd_none_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[1,4,8],f32>
+// TORCH-CHECK:       %dx = torch.aten.permute %dx_layernorm_bwd_perm, %permute_dx_layernorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.list<int> -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %dscale = torch.aten.permute %dscale_layernorm_bwd_perm, %permute_dscale_layernorm_bwd : !torch.vtensor<[1,4,8],f32>, !torch.list<int> -> !torch.vtensor<[1,4,8],f32>
+// TORCH-CHECK:       %dbias = torch.aten.permute %dbias_layernorm_bwd_perm, %permute_dbias_layernorm_bwd : !torch.vtensor<[1,4,8],f32>, !torch.list<int> -> !torch.vtensor<[1,4,8],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dbias overwrites %dbias_ : !torch.vtensor<[1,4,8],f32>, !torch.tensor<[1,4,8],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dscale overwrites %dscale_ : !torch.vtensor<[1,4,8],f32>, !torch.tensor<[1,4,8],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dx overwrites %dx_ : !torch.vtensor<[2,4,8],f32>, !torch.tensor<[2,4,8],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testLayernormBwdAsmEmitterNch() {
+  int64_t n = 2, c = 4, h = 8;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("layernorm_bwd_asm_emitter_nch");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto tensor = [&](const std::string &name, const std::vector<int64_t> &dim) {
+    return graph->tensor(TensorAttr().setName(name).setDim(dim).setStride(
+        generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+  auto dyT = tensor("dy", {n, c, h});
+  auto xT = tensor("x", {n, c, h});
+  auto mT = tensor("mean", {n, 1, 1});
+  auto vT = tensor("inv_variance", {n, 1, 1});
+  // Shape and strides will be inferred later in inferPropertiesNode()
+  auto sT = graph->tensor(TensorAttr().setName("scale"));
+
+  auto layernormBwdAttr = LayernormBwdAttr().setName("layernorm_bwd");
+  auto [dxT, dsT, dbT] =
+      graph->layernormBackward(dyT, xT, sT, mT, vT, layernormBwdAttr);
+  dxT->setName("dx").setOutput(true);
+  dsT->setName("dscale").setOutput(true);
+  dbT->setName("dbias").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testLayernormBwdAsmEmitterNch();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// The residual is added to `x` before normalization, and the sum is written
+// out as a second graph output.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[16,128,64,32],f32>, %sum_: !torch.tensor<[16,128,64,32],f32>, %arg0_x: !torch.vtensor<[16,128,64,32],f32>, %arg1_residual: !torch.vtensor<[16,128,64,32],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_x_layernorm_infer_perm = torch.aten.permute %arg0_x, %permute_x_layernorm_infer : !torch.vtensor<[16,128,64,32],f32>, !torch.list<int> -> !torch.vtensor<[16,128,64,32],f32>
+// TORCH-CHECK:       %arg1_residual_layernorm_infer_perm = torch.aten.permute %arg1_residual, %permute_residual_layernorm_infer : !torch.vtensor<[16,128,64,32],f32>, !torch.list<int> -> !torch.vtensor<[16,128,64,32],f32>
+// TORCH-CHECK:       %alpha_residual_layernorm_infer = torch.constant.int 1
+// TORCH-CHECK:       %sum_layernorm_infer_perm = torch.aten.add.Tensor %arg0_x_layernorm_infer_perm, %arg1_residual_layernorm_infer_perm, %alpha_residual_layernorm_infer : !torch.vtensor<[16,128,64,32],f32>, !torch.vtensor<[16,128,64,32],f32>, !torch.int -> !torch.vtensor<[16,128,64,32],f32>
+// TORCH-CHECK:       %sum = torch.aten.permute %sum_layernorm_infer_perm, %permute_sum_layernorm_infer : !torch.vtensor<[16,128,64,32],f32>, !torch.list<int> -> !torch.vtensor<[16,128,64,32],f32>
+// TORCH-CHECK:       %result_layernorm_infer_perm = torch.aten.layer_norm %sum_layernorm_infer_perm, %normalized_shape_layernorm_infer, %none_scale_layernorm_infer, %none_bias_layernorm_infer, %eps_layernorm_infer, %cudnn_enable_layernorm_infer : !torch.vtensor<[16,128,64,32],f32>, !torch.list<int>, !torch.none, !torch.none, !torch.float, !torch.bool -> !torch.vtensor<[16,128,64,32],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_layernorm_infer_perm, %permute_y_layernorm_infer : !torch.vtensor<[16,128,64,32],f32>, !torch.list<int> -> !torch.vtensor<[16,128,64,32],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[16,128,64,32],f32>, !torch.tensor<[16,128,64,32],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %sum overwrites %sum_ : !torch.vtensor<[16,128,64,32],f32>, !torch.tensor<[16,128,64,32],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testLayernormInferAsmEmitterResidualNchw() {
+  int64_t n = 16, c = 128, h = 64, w = 32;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("layernorm_infer_asm_emitter_residual_nchw");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_x")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+  auto residualT =
+      graph->tensor(TensorAttr()
+                        .setName("arg1_residual")
+                        .setDim({n, c, h, w})
+                        .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+  auto epsilonT = graph->tensor(TensorAttr(1e-5f));
+
+  auto layernormAttr = LayernormAttr()
+                           .setForwardPhase(NormFwdPhase::INFERENCE)
+                           .setEpsilon(epsilonT)
+                           .setName("layernorm_infer");
+
+  auto [yT, mT, vT, sumT] =
+      graph->layernorm(xT, residualT, nullptr, nullptr, layernormAttr);
+
+  yT->setName("result").setOutput(true);
+  sumT->setName("sum").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testLayernormInferAsmEmitterResidualNchw();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// A conv -> relu -> conv chain reading and writing NCHW16c (channels blocked
+// by 16) buffers. The blocked input is permuted to [N, C/16, 16, H, W] and
+// viewed as NCHW, and the output takes the reverse path, so both buffers keep
+// the extra innermost dim of 16 channels.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%y_: !torch.tensor<[1,2,8,8,16],f32>, %w1: !torch.vtensor<[32,32,3,3],f32>, %w2: !torch.vtensor<[32,32,3,3],f32>, %x: !torch.vtensor<[1,2,8,8,16],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %permute_X_conv1 = torch.prim.ListConstruct %permute_X_val_0_conv1, %permute_X_val_1_conv1, %permute_X_val_2_conv1, %permute_X_val_3_conv1, %permute_X_val_4_conv1 : (!torch.int, !torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %x_conv1_perm_blocked = torch.aten.permute %x, %permute_X_conv1 : !torch.vtensor<[1,2,8,8,16],f32>, !torch.list<int> -> !torch.vtensor<[1,2,16,8,8],f32>
+// TORCH-CHECK:       %x_conv1_perm = torch.aten.view %x_conv1_perm_blocked, %permute_X_shape_conv1 : !torch.vtensor<[1,2,16,8,8],f32>, !torch.list<int> -> !torch.vtensor<[1,32,8,8],f32>
+// TORCH-CHECK:       torch.aten.convolution %x_conv1_perm
+// TORCH-CHECK:       torch.aten.relu
+// TORCH-CHECK:       torch.aten.convolution
+// TORCH-CHECK:       %y_conv2_perm_blocked = torch.aten.view %y_conv2_perm, %permute_Y_shape_conv2 : !torch.vtensor<[1,32,8,8],f32>, !torch.list<int> -> !torch.vtensor<[1,2,16,8,8],f32>
+// TORCH-CHECK:       %y = torch.aten.permute %y_conv2_perm_blocked, %permute_Y_conv2 : !torch.vtensor<[1,2,16,8,8],f32>, !torch.list<int> -> !torch.vtensor<[1,2,8,8,16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %y overwrites %y_ : !torch.vtensor<[1,2,8,8,16],f32>, !torch.tensor<[1,2,8,8,16],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testLayoutAsmEmitterBlockedConvChain() {
+  int64_t n = 1, c = 32, h = 8, w = 8, k = 32, r = 3, s = 3;
+  constexpr BlockedLayout kChannelBlocks = {.dim = 1, .blockSize = 16};
+  auto graph = std::make_shared<Graph>();
+  graph->setName("layout_asm_emitter_blocked_conv_chain");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1})
+                              .setBlockedLayout(kChannelBlocks)); // NCHW16c
+  auto w1T = graph->tensor(TensorAttr()
+                               .setName("w1")
+                               .setDim({k, c, r, s})
+                               .setStride({c * r * s, r * s, s, 1}));
+  auto w2T = graph->tensor(TensorAttr()
+                               .setName("w2")
+                               .setDim({k, k, r, s})
+                               .setStride({k * r * s, r * s, s, 1}));
+
+  auto conv1Attr = ConvFPropAttr()
+                       .setStride({1, 1})
+                       .setPadding({1, 1})
+                       .setDilation({1, 1})
+                       .setName("conv1");
+  auto conv1T = graph->convFProp(xT, w1T, conv1Attr);
+  conv1T->setName("conv1_result");
+
+  auto reluAttr =
+      PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD).setName("relu");
+  auto reluT = graph->pointwise(conv1T, reluAttr);
+  reluT->setName("relu_result");
+
+  auto conv2Attr = ConvFPropAttr()
+                       .setStride({1, 1})
+                       .setPadding({1, 1})
+                       .setDilation({1, 1})
+                       .setName("conv2");
+  auto yT = graph->convFProp(reluT, w2T, conv2Attr);
+  yT->setName("y").setOutput(true).setBlockedLayout(kChannelBlocks);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testLayoutAsmEmitterBlockedConvChain();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=CAST-CHECK
+
+// The NHWC intermediates `conv_result` and `bias_result` stay in logical
+// (NCHW) order between the layout agnostic nodes, so permutes are only emitted
+// for the graph inputs and output: 5 instead of 9.
+//
+// clang-format off
+//
+// TORCH-CHECK:       %arg0_image_conv_fprop_perm = torch.aten.permute %arg0_image
+// TORCH-CHECK:       %arg1_filter_conv_fprop_perm = torch.aten.permute %arg1_filter
+// TORCH-CHECK-NOT:   torch.aten.permute
+// TORCH-CHECK:       %bias_pointwise_1_perm = torch.aten.permute %bias
+// TORCH-CHECK-COUNT-2: torch.aten.permute
+// TORCH-CHECK-NOT:   torch.aten.permute
+//
+// CAST-CHECK:        %conv_result = torch.tensor_static_info_cast %conv_result_conv_fprop_perm : !torch.vtensor<[16,256,64,32],f32> to !torch.vtensor<[16,256,64,32],f32>
+// CAST-CHECK:        %conv_result_pointwise_1_perm = torch.tensor_static_info_cast %conv_result : !torch.vtensor<[16,256,64,32],f32> to !torch.vtensor<[16,256,64,32],f32>
+// CAST-CHECK:        %bias_result = torch.tensor_static_info_cast %bias_result_pointwise_1_perm : !torch.vtensor<[16,256,64,32],f32> to !torch.vtensor<[16,256,64,32],f32>
+// CAST-CHECK:        %bias_result_rmsnorm_infer_perm = torch.tensor_static_info_cast %bias_result : !torch.vtensor<[16,256,64,32],f32> to !torch.vtensor<[16,256,64,32],f32>
+// CAST-CHECK-NOT:    torch.tensor_static_info_cast
+// CAST-CHECK:        %result = torch.aten.permute
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject
+testLayoutAsmEmitterNhwcConvBiasRmsnorm(const std::string &mode) {
+  int64_t n = 16, c = 128, h = 64, w = 32, k = 256, r = 1, s = 1;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("layout_asm_emitter_nhwc_conv_bias_rmsnorm");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_image")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("arg1_filter")
+                              .setDim({k, c, r, s})
+                              .setStride({c * r * s, 1, c * s, c})); // KRSC
+
+  auto convAttr = ConvFPropAttr()
+                      .setStride({1, 1})
+                      .setPadding({0, 0})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+
+  auto yT = graph->convFProp(xT, wT, convAttr);
+  yT->setName("conv_result").setDataType(DataType::Float);
+
+  auto bT = graph->tensor(TensorAttr()
+                              .setName("bias")
+                              .setDim({1, k, 1, 1})
+                              .setStride({k, 1, k, k}));
+  auto biasAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::ADD);
+  auto biasResult = graph->pointwise(yT, bT, biasAttr);
+  biasResult->setName("bias_result").setDataType(DataType::Float);
+
+  auto scaleT = graph->tensor(TensorAttr().setName("arg2_scale"));
+  auto epsilonT = graph->tensor(TensorAttr(1e-5f));
+  auto rmsnormAttr = RmsnormAttr()
+                         .setForwardPhase(NormFwdPhase::INFERENCE)
+                         .setEpsilon(epsilonT)
+                         .setName("rmsnorm_infer");
+  auto [normT, rT] = graph->rmsnorm(biasResult, scaleT, rmsnormAttr);
+  normT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+    FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+    std::cout << generatedAsm << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testLayoutAsmEmitterNhwcConvBiasRmsnorm(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,77 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Weight gradient of a linear layer with the bias gradient: A is DY^T (a
+// transposed view of DY [M, N]), B is X [M, K], and DBIAS [N] is A summed
+// over the contraction dim in f32, next to the matmul reading the same A.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%db_: !torch.tensor<[16],f32>, %dw_: !torch.tensor<[16,4],f32>, %dy: !torch.vtensor<[8,16],f32>, %x: !torch.vtensor<[8,4],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %dy_matmul_wgrad_perm = torch.aten.permute %dy, %permute_A_matmul_wgrad : !torch.vtensor<[8,16],f32>, !torch.list<int> -> !torch.vtensor<[16,8],f32>
+// TORCH-CHECK:       %dbias_f32_matmul_wgrad = torch.constant.int 6
+// TORCH-CHECK:       %dbias_dims_val_0_matmul_wgrad = torch.constant.int 1
+// TORCH-CHECK:       %dbias_acc_matmul_wgrad = torch.aten.sum.dim_IntList %dy_matmul_wgrad_perm, %dbias_dims_matmul_wgrad, %dbias_keepdim_matmul_wgrad, %dbias_f32_matmul_wgrad : !torch.vtensor<[16,8],f32>, !torch.list<int>, !torch.bool, !torch.int -> !torch.vtensor<[16],f32>
+// TORCH-CHECK:       %db_matmul_wgrad_perm = torch.aten.to.dtype %dbias_acc_matmul_wgrad, %dbias_dtype_matmul_wgrad, %dbias_keepdim_matmul_wgrad, %dbias_keepdim_matmul_wgrad, %dbias_none_matmul_wgrad : !torch.vtensor<[16],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[16],f32>
+// TORCH-CHECK:       %db = torch.aten.permute %db_matmul_wgrad_perm, %permute_DBIAS_matmul_wgrad : !torch.vtensor<[16],f32>, !torch.list<int> -> !torch.vtensor<[16],f32>
+// TORCH-CHECK:       %dw_matmul_wgrad_perm = torch.aten.matmul %dy_matmul_wgrad_perm, %x_matmul_wgrad_perm : !torch.vtensor<[16,8],f32>, !torch.vtensor<[8,4],f32> -> !torch.vtensor<[16,4],f32>
+// TORCH-CHECK:       %dw = torch.aten.permute %dw_matmul_wgrad_perm, %permute_C_matmul_wgrad : !torch.vtensor<[16,4],f32>, !torch.list<int> -> !torch.vtensor<[16,4],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %db overwrites %db_ : !torch.vtensor<[16],f32>, !torch.tensor<[16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dw overwrites %dw_ : !torch.vtensor<[16,4],f32>, !torch.tensor<[16,4],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterBiasGrad() {
+  int64_t m = 8, n = 16, k = 4;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_bias_grad");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  // DY [M, N] is stored row-major and viewed as DY^T [N, M].
+  auto dyT = graph->tensor(
+      TensorAttr().setName("dy").setDim({n, m}).setStride({1, n}));
+  auto xT = graph->tensor(
+      TensorAttr().setName("x").setDim({m, k}).setStride({k, 1}));
+
+  auto matmulAttr = MatmulAttr().setName("matmul_wgrad");
+  auto [dwT, dbT] = graph->matmulWithBiasGrad(dyT, xT, matmulAttr);
+  dwT->setName("dw").setOutput(true);
+  dbT->setName("db").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testMatmulAsmEmitterBiasGrad();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
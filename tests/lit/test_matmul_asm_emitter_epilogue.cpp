@@ -0,0 +1,110 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} stats | FileCheck %s --check-prefix=%{BACKEND}-STATS-CHECK
+
+// The epilogue `relu(0.5 * (A @ B) + bias) + 2.0 * residual` is emitted by the
+// matmul node itself and fuses into a single dispatch.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[64,256],f32>, %arg0_matrix_a: !torch.vtensor<[64,128],f32>, %arg1_matrix_b: !torch.vtensor<[128,256],f32>, %arg2_bias: !torch.vtensor<[1,256],f32>, %arg3_residual: !torch.vtensor<[64,256],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %matmul_product_matmul = torch.aten.matmul %arg0_matrix_a_matmul_perm, %arg1_matrix_b_matmul_perm : !torch.vtensor<[64,128],f32>, !torch.vtensor<[128,256],f32> -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %epilogue_alpha_val_matmul = torch.constant.float 5.000000e-01
+// TORCH-CHECK:       %epilogue_alpha_matmul = torch.aten.mul.Scalar %matmul_product_matmul, %epilogue_alpha_val_matmul : !torch.vtensor<[64,256],f32>, !torch.float -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %arg2_bias_matmul_perm = torch.aten.permute %arg2_bias, %permute_BIAS_matmul : !torch.vtensor<[1,256],f32>, !torch.list<int> -> !torch.vtensor<[1,256],f32>
+// TORCH-CHECK:       %epilogue_bias_alpha_matmul = torch.constant.int 1
+// TORCH-CHECK:       %epilogue_bias_matmul = torch.aten.add.Tensor %epilogue_alpha_matmul, %arg2_bias_matmul_perm, %epilogue_bias_alpha_matmul : !torch.vtensor<[64,256],f32>, !torch.vtensor<[1,256],f32>, !torch.int -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %epilogue_activation_matmul = torch.aten.relu %epilogue_bias_matmul : !torch.vtensor<[64,256],f32> -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %arg3_residual_matmul_perm = torch.aten.permute %arg3_residual, %permute_RESIDUAL_matmul : !torch.vtensor<[64,256],f32>, !torch.list<int> -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %epilogue_beta_val_matmul = torch.constant.float 2.000000e+00
+// TORCH-CHECK:       %result_matmul_perm = torch.aten.add.Tensor %epilogue_activation_matmul, %arg3_residual_matmul_perm, %epilogue_beta_val_matmul : !torch.vtensor<[64,256],f32>, !torch.vtensor<[64,256],f32>, !torch.float -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_matmul_perm, %permute_C_matmul : !torch.vtensor<[64,256],f32>, !torch.list<int> -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[64,256],f32>, !torch.tensor<[64,256],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// AMDGPU-STATS-CHECK: "transient-memory-size": 0
+// AMDGPU-STATS-CHECK: "dispatch-count": 1
+// CPU-STATS-CHECK: "transient-memory-size": 0
+// CPU-STATS-CHECK: "dispatch-count": 1
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterEpilogue(const std::string &mode) {
+  int64_t m = 64, k = 128, n = 256;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_epilogue");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(
+      TensorAttr().setName("arg0_matrix_a").setDim({m, k}).setStride({k, 1}));
+
+  auto bT = graph->tensor(
+      TensorAttr().setName("arg1_matrix_b").setDim({k, n}).setStride({n, 1}));
+
+  auto biasT = graph->tensor(
+      TensorAttr().setName("arg2_bias").setDim({1, n}).setStride({n, 1}));
+
+  auto residualT = graph->tensor(
+      TensorAttr().setName("arg3_residual").setDim({m, n}).setStride({n, 1}));
+
+  auto matmulAttr = MatmulAttr()
+                        .setBIAS(biasT)
+                        .setRESIDUAL(residualT)
+                        .setActivation(PointwiseAttr::Mode::RELU_FWD)
+                        .setAlpha(0.5f)
+                        .setBeta(2.0f)
+                        .setName("matmul");
+
+  auto cT = graph->matmul(aT, bT, matmulAttr);
+
+  cT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+    FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+    std::cout << generatedAsm << std::endl;
+  }
+
+  if (mode == "stats") {
+    FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(kDefaultBackend));
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/true));
+    FUSILLI_ASSIGN_OR_RETURN(auto stats, graph->readCompilationCacheFile(
+                                             CachedAssetsType::Statistics));
+    std::cout << stats << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testMatmulAsmEmitterEpilogue(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
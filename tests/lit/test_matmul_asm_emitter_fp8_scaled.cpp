@@ -0,0 +1,97 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// The FP8 matmul accumulates in f32, then the per row scale of A and the per
+// column scale of B dequantize the accumulator before it is cast to f16.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[64,256],f16>, %arg0_matrix_a: !torch.vtensor<[64,128],f8E4M3FNUZ>, %arg1_matrix_b: !torch.vtensor<[128,256],f8E4M3FNUZ>, %arg2_scale_a: !torch.vtensor<[64,1],f32>, %arg3_scale_b: !torch.vtensor<[1,256],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %matmul_acc_matmul = torch.aten.matmul %arg0_matrix_a_matmul_perm, %arg1_matrix_b_matmul_perm : !torch.vtensor<[64,128],f8E4M3FNUZ>, !torch.vtensor<[128,256],f8E4M3FNUZ> -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %dequant_none_matmul = torch.constant.none
+// TORCH-CHECK:       %dequant_false_matmul = torch.constant.bool false
+// TORCH-CHECK:       %arg2_scale_a_matmul_perm = torch.aten.permute %arg2_scale_a, %permute_SCALE_A_matmul : !torch.vtensor<[64,1],f32>, !torch.list<int> -> !torch.vtensor<[64,1],f32>
+// TORCH-CHECK:       %dequant_SCALE_A_matmul = torch.aten.mul.Tensor %matmul_acc_matmul, %arg2_scale_a_matmul_perm : !torch.vtensor<[64,256],f32>, !torch.vtensor<[64,1],f32> -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %arg3_scale_b_matmul_perm = torch.aten.permute %arg3_scale_b, %permute_SCALE_B_matmul : !torch.vtensor<[1,256],f32>, !torch.list<int> -> !torch.vtensor<[1,256],f32>
+// TORCH-CHECK:       %dequant_SCALE_B_matmul = torch.aten.mul.Tensor %dequant_SCALE_A_matmul, %arg3_scale_b_matmul_perm : !torch.vtensor<[64,256],f32>, !torch.vtensor<[1,256],f32> -> !torch.vtensor<[64,256],f32>
+// TORCH-CHECK:       %dequant_dtype_matmul = torch.constant.int 5
+// TORCH-CHECK:       %result_matmul_perm = torch.aten.to.dtype %dequant_SCALE_B_matmul, %dequant_dtype_matmul, %dequant_false_matmul, %dequant_false_matmul, %dequant_none_matmul : !torch.vtensor<[64,256],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[64,256],f16>
+// TORCH-CHECK:       %result = torch.aten.permute %result_matmul_perm, %permute_C_matmul : !torch.vtensor<[64,256],f16>, !torch.list<int> -> !torch.vtensor<[64,256],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[64,256],f16>, !torch.tensor<[64,256],f16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterFp8Scaled() {
+  int64_t m = 64, k = 128, n = 256;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_fp8_scaled");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(TensorAttr()
+                              .setName("arg0_matrix_a")
+                              .setDim({m, k})
+                              .setStride({k, 1})
+                              .setDataType(DataType::FP8E4M3FNUZ));
+
+  auto bT = graph->tensor(TensorAttr()
+                              .setName("arg1_matrix_b")
+                              .setDim({k, n})
+                              .setStride({n, 1})
+                              .setDataType(DataType::FP8E4M3FNUZ));
+
+  auto scaleAT = graph->tensor(TensorAttr()
+                                   .setName("arg2_scale_a")
+                                   .setDim({m, 1})
+                                   .setStride({1, 1})
+                                   .setDataType(DataType::Float));
+
+  auto scaleBT = graph->tensor(TensorAttr()
+                                   .setName("arg3_scale_b")
+                                   .setDim({1, n})
+                                   .setStride({n, 1})
+                                   .setDataType(DataType::Float));
+
+  auto matmulAttr =
+      MatmulAttr().setSCALE_A(scaleAT).setSCALE_B(scaleBT).setName("matmul");
+
+  auto cT = graph->matmul(aT, bT, matmulAttr);
+
+  cT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testMatmulAsmEmitterFp8Scaled();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
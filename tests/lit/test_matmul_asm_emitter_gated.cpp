@@ -0,0 +1,78 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// SwiGLU: B packs the gate and up projections [K, 2N], so X is read by one
+// matmul, whose halves are sliced and multiplied after SiLU on the gate. Only
+// the gated product [M, N] is an output.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%y_: !torch.tensor<[4,16],f32>, %w_gate_up: !torch.vtensor<[8,32],f32>, %x: !torch.vtensor<[4,8],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %matmul_gate_up_swiglu = torch.aten.matmul %x_swiglu_perm, %w_gate_up_swiglu_perm : !torch.vtensor<[4,8],f32>, !torch.vtensor<[8,32],f32> -> !torch.vtensor<[4,32],f32>
+// TORCH-CHECK:       %gate_dim_swiglu = torch.constant.int 1
+// TORCH-CHECK:       %gate_mid_swiglu = torch.constant.int 16
+// TORCH-CHECK:       %gate_end_swiglu = torch.constant.int 32
+// TORCH-CHECK:       %gate_swiglu = torch.aten.slice.Tensor %matmul_gate_up_swiglu, %gate_dim_swiglu, %gate_start_swiglu, %gate_mid_swiglu, %gate_step_swiglu : !torch.vtensor<[4,32],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %gate_up_swiglu = torch.aten.slice.Tensor %matmul_gate_up_swiglu, %gate_dim_swiglu, %gate_mid_swiglu, %gate_end_swiglu, %gate_step_swiglu : !torch.vtensor<[4,32],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %gate_act_swiglu = torch.aten.silu %gate_swiglu : !torch.vtensor<[4,16],f32> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %y_swiglu_perm = torch.aten.mul.Tensor %gate_act_swiglu, %gate_up_swiglu : !torch.vtensor<[4,16],f32>, !torch.vtensor<[4,16],f32> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %y = torch.aten.permute %y_swiglu_perm, %permute_C_swiglu : !torch.vtensor<[4,16],f32>, !torch.list<int> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %y overwrites %y_ : !torch.vtensor<[4,16],f32>, !torch.tensor<[4,16],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterGated() {
+  int64_t m = 4, k = 8, n = 16;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_gated");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(
+      TensorAttr().setName("x").setDim({m, k}).setStride({k, 1}));
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("w_gate_up")
+                              .setDim({k, 2 * n})
+                              .setStride({2 * n, 1}));
+
+  auto matmulAttr =
+      MatmulAttr().setName("swiglu").setGate(PointwiseAttr::Mode::SWISH_FWD);
+  auto yT = graph->matmul(xT, wT, matmulAttr);
+  yT->setName("y").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testMatmulAsmEmitterGated();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
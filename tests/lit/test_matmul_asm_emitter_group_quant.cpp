@@ -0,0 +1,98 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Group-wise quantized weights: Int4 B [K, N] with one f16 scale and Int4
+// zero point per group of 4 rows, dequantized into the f16 B operand of the
+// matmul.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%c_: !torch.tensor<[4,16],f16>, %a: !torch.vtensor<[4,8],f16>, %b: !torch.vtensor<[8,16],si4>, %b_scale: !torch.vtensor<[2,16],f16>, %b_zero: !torch.vtensor<[2,16],si4>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %b_matmul_perm = torch.aten.permute %b, %permute_B_matmul : !torch.vtensor<[8,16],si4>, !torch.list<int> -> !torch.vtensor<[8,16],si4>
+// TORCH-CHECK:       %b_scale_matmul_perm = torch.aten.permute %b_scale, %permute_B_SCALE_matmul : !torch.vtensor<[2,16],f16>, !torch.list<int> -> !torch.vtensor<[2,16],f16>
+// TORCH-CHECK:       %gq_dtype_matmul = torch.constant.int 5
+// TORCH-CHECK:       %gq_group_dim_matmul = torch.constant.int 1
+// TORCH-CHECK:       %gq_split_matmul = torch.aten.view %b_matmul_perm, %gq_split_shape_matmul : !torch.vtensor<[8,16],si4>, !torch.list<int> -> !torch.vtensor<[2,4,16],si4>
+// TORCH-CHECK:       %gq_values_matmul = torch.aten.to.dtype %gq_split_matmul, %gq_dtype_matmul, %gq_false_matmul, %gq_false_matmul, %gq_none_matmul : !torch.vtensor<[2,4,16],si4>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,4,16],f16>
+// TORCH-CHECK:       %gq_scale_matmul = torch.aten.unsqueeze %b_scale_matmul_perm, %gq_group_dim_matmul : !torch.vtensor<[2,16],f16>, !torch.int -> !torch.vtensor<[2,1,16],f16>
+// TORCH-CHECK:       %b_zero_matmul_perm = torch.aten.permute %b_zero, %permute_B_ZERO_matmul : !torch.vtensor<[2,16],si4>, !torch.list<int> -> !torch.vtensor<[2,16],si4>
+// TORCH-CHECK:       %gq_zero_cast_matmul = torch.aten.to.dtype %b_zero_matmul_perm, %gq_dtype_matmul, %gq_false_matmul, %gq_false_matmul, %gq_none_matmul : !torch.vtensor<[2,16],si4>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,16],f16>
+// TORCH-CHECK:       %gq_zero_matmul = torch.aten.unsqueeze %gq_zero_cast_matmul, %gq_group_dim_matmul : !torch.vtensor<[2,16],f16>, !torch.int -> !torch.vtensor<[2,1,16],f16>
+// TORCH-CHECK:       %gq_centered_matmul = torch.aten.sub.Tensor %gq_values_matmul, %gq_zero_matmul, %gq_one_matmul : !torch.vtensor<[2,4,16],f16>, !torch.vtensor<[2,1,16],f16>, !torch.int -> !torch.vtensor<[2,4,16],f16>
+// TORCH-CHECK:       %gq_scaled_matmul = torch.aten.mul.Tensor %gq_centered_matmul, %gq_scale_matmul : !torch.vtensor<[2,4,16],f16>, !torch.vtensor<[2,1,16],f16> -> !torch.vtensor<[2,4,16],f16>
+// TORCH-CHECK:       %gq_b_matmul = torch.aten.view %gq_scaled_matmul, %gq_dense_shape_matmul : !torch.vtensor<[2,4,16],f16>, !torch.list<int> -> !torch.vtensor<[8,16],f16>
+// TORCH-CHECK:       %c_matmul_perm = torch.aten.matmul %a_matmul_perm, %gq_b_matmul : !torch.vtensor<[4,8],f16>, !torch.vtensor<[8,16],f16> -> !torch.vtensor<[4,16],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %c overwrites %c_ : !torch.vtensor<[4,16],f16>, !torch.tensor<[4,16],f16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterGroupQuant() {
+  int64_t m = 4, k = 8, n = 16, groupSize = 4;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_group_quant")
+      .setIODataType(DataType::Half)
+      .setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(
+      TensorAttr().setName("a").setDim({m, k}).setStride({k, 1}));
+  auto bT = graph->tensor(TensorAttr()
+                              .setName("b")
+                              .setDim({k, n})
+                              .setStride({n, 1})
+                              .setDataType(DataType::Int4));
+  auto scaleT = graph->tensor(TensorAttr()
+                                  .setName("b_scale")
+                                  .setDim({k / groupSize, n})
+                                  .setStride({n, 1}));
+  auto zeroT = graph->tensor(TensorAttr()
+                                 .setName("b_zero")
+                                 .setDim({k / groupSize, n})
+                                 .setStride({n, 1})
+                                 .setDataType(DataType::Int4));
+
+  auto matmulAttr = MatmulAttr()
+                        .setName("matmul")
+                        .setB_SCALE(scaleT)
+                        .setB_ZERO(zeroT)
+                        .setGroupSize(groupSize);
+  auto cT = graph->matmul(aT, bT, matmulAttr);
+  cT->setName("c").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testMatmulAsmEmitterGroupQuant();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
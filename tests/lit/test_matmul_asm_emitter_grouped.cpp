@@ -0,0 +1,93 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// A grouped matmul over 8 experts with a dynamic number of rows per expert is
+// one batched matmul whose rows past each group's size are selected to zero.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[8,?,256],f32>, %arg0_tokens: !torch.vtensor<[8,?,128],f32>, %arg1_experts: !torch.vtensor<[8,128,256],f32>, %arg2_group_sizes: !torch.vtensor<[8],si32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %matmul_unmasked_matmul = torch.aten.matmul %arg0_tokens_matmul_perm, %arg1_experts_matmul_perm : !torch.vtensor<[8,?,128],f32>, !torch.vtensor<[8,128,256],f32> -> !torch.vtensor<[8,?,256],f32>
+// TORCH-CHECK:       %group_int1_matmul = torch.constant.int 1
+// TORCH-CHECK:       %group_int2_matmul = torch.constant.int 2
+// TORCH-CHECK:       %group_long_matmul = torch.constant.int 4
+// TORCH-CHECK:       %group_none_matmul = torch.constant.none
+// TORCH-CHECK:       %group_zero_matmul = torch.constant.int 0
+// TORCH-CHECK:       %group_rows_len_matmul = torch.aten.size.int %arg0_tokens_matmul_perm, %group_int1_matmul : !torch.vtensor<[8,?,128],f32>, !torch.int -> !torch.int
+// TORCH-CHECK:       %group_rows_matmul = torch.aten.arange %group_rows_len_matmul, %group_long_matmul, %group_none_matmul, %group_none_matmul, %group_none_matmul : !torch.int, !torch.int, !torch.none, !torch.none, !torch.none -> !torch.vtensor<[?],si64>
+// TORCH-CHECK:       %arg2_group_sizes_matmul_perm = torch.aten.permute %arg2_group_sizes, %permute_GROUP_SIZES_matmul : !torch.vtensor<[8],si32>, !torch.list<int> -> !torch.vtensor<[8],si32>
+// TORCH-CHECK:       %group_sizes_col_matmul = torch.aten.unsqueeze %arg2_group_sizes_matmul_perm, %group_int1_matmul : !torch.vtensor<[8],si32>, !torch.int -> !torch.vtensor<[8,1],si32>
+// TORCH-CHECK:       %group_valid_matmul = torch.aten.lt.Tensor %group_rows_matmul, %group_sizes_col_matmul : !torch.vtensor<[?],si64>, !torch.vtensor<[8,1],si32> -> !torch.vtensor<[8,?],i1>
+// TORCH-CHECK:       %group_mask_matmul = torch.aten.unsqueeze %group_valid_matmul, %group_int2_matmul : !torch.vtensor<[8,?],i1>, !torch.int -> !torch.vtensor<[8,?,1],i1>
+// TORCH-CHECK:       %result_matmul_perm = torch.aten.where.ScalarOther %group_mask_matmul, %matmul_unmasked_matmul, %group_zero_matmul : !torch.vtensor<[8,?,1],i1>, !torch.vtensor<[8,?,256],f32>, !torch.int -> !torch.vtensor<[8,?,256],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_matmul_perm, %permute_C_matmul : !torch.vtensor<[8,?,256],f32>, !torch.list<int> -> !torch.vtensor<[8,?,256],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[8,?,256],f32>, !torch.tensor<[8,?,256],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterGrouped() {
+  int64_t e = 8, m = 64, k = 128, n = 256;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_grouped");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(TensorAttr()
+                              .setName("arg0_tokens")
+                              .setDim({e, m, k})
+                              .setDynamicDims({1})
+                              .setStride({m * k, k, 1}));
+
+  auto bT = graph->tensor(TensorAttr()
+                              .setName("arg1_experts")
+                              .setDim({e, k, n})
+                              .setStride({k * n, n, 1}));
+
+  auto groupSizesT = graph->tensor(TensorAttr()
+                                       .setName("arg2_group_sizes")
+                                       .setDim({e})
+                                       .setStride({1})
+                                       .setDataType(DataType::Int32));
+
+  auto matmulAttr = MatmulAttr().setGROUP_SIZES(groupSizesT).setName("matmul");
+
+  auto cT = graph->matmul(aT, bT, matmulAttr);
+
+  cT->setName("result").setDynamicDims({1}).setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testMatmulAsmEmitterGrouped();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
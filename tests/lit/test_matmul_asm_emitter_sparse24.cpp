@@ -0,0 +1,81 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// 2:4 sparse weights: B holds the kept values [K/2, N] and B_META their
+// positions, expanded into the dense B operand of the matmul.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%c_: !torch.tensor<[4,16],f16>, %a: !torch.vtensor<[4,8],f16>, %b: !torch.vtensor<[4,16],f16>, %b_meta: !torch.vtensor<[4,16],si8>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %b_matmul_perm = torch.aten.permute %b, %permute_B_matmul : !torch.vtensor<[4,16],f16>, !torch.list<int> -> !torch.vtensor<[4,16],f16>
+// TORCH-CHECK:       %b_meta_matmul_perm = torch.aten.permute %b_meta, %permute_B_META_matmul : !torch.vtensor<[4,16],si8>, !torch.list<int> -> !torch.vtensor<[4,16],si8>
+// TORCH-CHECK:       %sparse_pos_matmul = torch.vtensor.literal(dense<{{\[\[}}0], [1], [2], [3]]> : tensor<4x1xsi8>) : !torch.vtensor<[4,1],si8>
+// TORCH-CHECK:       %sparse_dtype_matmul = torch.constant.int 5
+// TORCH-CHECK:       %sparse_pair_dims_val_0_matmul = torch.constant.int 1
+// TORCH-CHECK:       %sparse_meta_matmul = torch.aten.view %b_meta_matmul_perm, %sparse_split_shape_matmul : !torch.vtensor<[4,16],si8>, !torch.list<int> -> !torch.vtensor<[2,2,1,16],si8>
+// TORCH-CHECK:       %sparse_values_matmul = torch.aten.view %b_matmul_perm, %sparse_split_shape_matmul : !torch.vtensor<[4,16],f16>, !torch.list<int> -> !torch.vtensor<[2,2,1,16],f16>
+// TORCH-CHECK:       %sparse_mask_matmul = torch.aten.eq.Tensor %sparse_meta_matmul, %sparse_pos_matmul : !torch.vtensor<[2,2,1,16],si8>, !torch.vtensor<[4,1],si8> -> !torch.vtensor<[2,2,4,16],i1>
+// TORCH-CHECK:       %sparse_select_matmul = torch.aten.where.ScalarOther %sparse_mask_matmul, %sparse_values_matmul, %sparse_zero_matmul : !torch.vtensor<[2,2,4,16],i1>, !torch.vtensor<[2,2,1,16],f16>, !torch.int -> !torch.vtensor<[2,2,4,16],f16>
+// TORCH-CHECK:       %sparse_groups_matmul = torch.aten.sum.dim_IntList %sparse_select_matmul, %sparse_pair_dims_matmul, %sparse_keepdim_matmul, %sparse_dtype_matmul : !torch.vtensor<[2,2,4,16],f16>, !torch.list<int>, !torch.bool, !torch.int -> !torch.vtensor<[2,4,16],f16>
+// TORCH-CHECK:       %sparse_b_matmul = torch.aten.view %sparse_groups_matmul, %sparse_dense_shape_matmul : !torch.vtensor<[2,4,16],f16>, !torch.list<int> -> !torch.vtensor<[8,16],f16>
+// TORCH-CHECK:       %c_matmul_perm = torch.aten.matmul %a_matmul_perm, %sparse_b_matmul : !torch.vtensor<[4,8],f16>, !torch.vtensor<[8,16],f16> -> !torch.vtensor<[4,16],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %c overwrites %c_ : !torch.vtensor<[4,16],f16>, !torch.tensor<[4,16],f16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterSparse24() {
+  int64_t m = 4, k = 8, n = 16;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_sparse24")
+      .setIODataType(DataType::Half)
+      .setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(
+      TensorAttr().setName("a").setDim({m, k}).setStride({k, 1}));
+  auto bT = graph->tensor(
+      TensorAttr().setName("b").setDim({k / 2, n}).setStride({n, 1}));
+  auto metaT = graph->tensor(
+      TensorAttr().setName("b_meta").setDim({k / 2, n}).setStride({n, 1}));
+
+  auto matmulAttr = MatmulAttr().setName("matmul").setB_META(metaT);
+  auto cT = graph->matmul(aT, bT, matmulAttr);
+  cT->setName("c").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testMatmulAsmEmitterSparse24();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
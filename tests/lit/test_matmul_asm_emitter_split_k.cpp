@@ -0,0 +1,82 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Skinny batched matmul with a long contraction dim split 4 ways: the
+// partial products of the K slices come from one batched matmul and are
+// summed in f32.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%c_: !torch.tensor<[2,8,16],f16>, %a: !torch.vtensor<[2,8,64],f16>, %b: !torch.vtensor<[2,64,16],f16>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %splitk_f32_matmul = torch.constant.int 6
+// TORCH-CHECK:       %splitk_dtype_matmul = torch.constant.int 5
+// TORCH-CHECK:       %splitk_m_matmul = torch.constant.int 1
+// TORCH-CHECK:       %splitk_s_matmul = torch.constant.int 2
+// TORCH-CHECK:       %splitk_dims_val_0_matmul = torch.constant.int 1
+// TORCH-CHECK:       %splitk_a_view_matmul = torch.aten.view %a_matmul_perm, %splitk_a_shape_matmul : !torch.vtensor<[2,8,64],f16>, !torch.list<int> -> !torch.vtensor<[2,8,4,16],f16>
+// TORCH-CHECK:       %splitk_a_matmul = torch.aten.transpose.int %splitk_a_view_matmul, %splitk_m_matmul, %splitk_s_matmul : !torch.vtensor<[2,8,4,16],f16>, !torch.int, !torch.int -> !torch.vtensor<[2,4,8,16],f16>
+// TORCH-CHECK:       %splitk_b_matmul = torch.aten.view %b_matmul_perm, %splitk_b_shape_matmul : !torch.vtensor<[2,64,16],f16>, !torch.list<int> -> !torch.vtensor<[2,4,16,16],f16>
+// TORCH-CHECK:       %splitk_partial_matmul = torch.aten.matmul %splitk_a_matmul, %splitk_b_matmul : !torch.vtensor<[2,4,8,16],f16>, !torch.vtensor<[2,4,16,16],f16> -> !torch.vtensor<[2,4,8,16],f16>
+// TORCH-CHECK:       %splitk_acc_matmul = torch.aten.sum.dim_IntList %splitk_partial_matmul, %splitk_dims_matmul, %splitk_keepdim_matmul, %splitk_f32_matmul : !torch.vtensor<[2,4,8,16],f16>, !torch.list<int>, !torch.bool, !torch.int -> !torch.vtensor<[2,8,16],f32>
+// TORCH-CHECK:       %c_matmul_perm = torch.aten.to.dtype %splitk_acc_matmul, %splitk_dtype_matmul, %splitk_keepdim_matmul, %splitk_keepdim_matmul, %splitk_none_matmul : !torch.vtensor<[2,8,16],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,8,16],f16>
+// TORCH-CHECK:       %c = torch.aten.permute %c_matmul_perm, %permute_C_matmul : !torch.vtensor<[2,8,16],f16>, !torch.list<int> -> !torch.vtensor<[2,8,16],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %c overwrites %c_ : !torch.vtensor<[2,8,16],f16>, !torch.tensor<[2,8,16],f16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testMatmulAsmEmitterSplitK() {
+  int64_t b = 2, m = 8, n = 16, k = 64;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("matmul_asm_emitter_split_k");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto aT = graph->tensor(TensorAttr()
+                              .setName("a")
+                              .setDim({b, m, k})
+                              .setStride({m * k, k, 1}));
+  auto bT = graph->tensor(TensorAttr()
+                              .setName("b")
+                              .setDim({b, k, n})
+                              .setStride({k * n, n, 1}));
+
+  auto matmulAttr = MatmulAttr().setSplitK(4).setName("matmul");
+  auto cT = graph->matmul(aT, bT, matmulAttr);
+  cT->setName("c").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testMatmulAsmEmitterSplitK();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,123 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// AdamW update of two parameters. The terms shared by both parameters are
+// computed once from the [1] hyperparameters; each parameter is then updated
+// by one elementwise expression of P, G, M and V, whose results overwrite the
+// buffers of P, M and V.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(
+// TORCH-CHECK:       %w_adamw_perm = torch.aten.permute %w, %permute_p0_adamw : !torch.vtensor<[4,8],f32>, !torch.list<int> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %b_adamw_perm = torch.aten.permute %b, %permute_p1_adamw : !torch.vtensor<[8],f32>, !torch.list<int> -> !torch.vtensor<[8],f32>
+// TORCH-CHECK:       %opt_f32_adamw = torch.constant.int 6
+// TORCH-CHECK:       %opt_one_minus_beta1_adamw = torch.aten.rsub.Scalar %beta1, %opt_one_adamw, %opt_one_adamw : !torch.vtensor<[1],f32>, !torch.float, !torch.float -> !torch.vtensor<[1],f32>
+// TORCH-CHECK:       %opt_one_minus_beta2_adamw = torch.aten.rsub.Scalar %beta2, %opt_one_adamw, %opt_one_adamw : !torch.vtensor<[1],f32>, !torch.float, !torch.float -> !torch.vtensor<[1],f32>
+// TORCH-CHECK:       %opt_beta1_pow_adamw = torch.aten.pow.Tensor_Tensor %beta1, %step : !torch.vtensor<[1],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[1],f32>
+// TORCH-CHECK:       %opt_bc1_adamw = torch.aten.rsub.Scalar %opt_beta1_pow_adamw, %opt_one_adamw, %opt_one_adamw : !torch.vtensor<[1],f32>, !torch.float, !torch.float -> !torch.vtensor<[1],f32>
+// TORCH-CHECK:       %opt_step_size_adamw = torch.aten.div.Tensor %lr, %opt_bc1_adamw : !torch.vtensor<[1],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[1],f32>
+// TORCH-CHECK:       %opt_sqrt_bc2_adamw = torch.aten.sqrt %opt_bc2_adamw : !torch.vtensor<[1],f32> -> !torch.vtensor<[1],f32>
+// TORCH-CHECK:       %opt_lr_wd_adamw = torch.aten.mul.Tensor %lr, %wd : !torch.vtensor<[1],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[1],f32>
+// TORCH-CHECK:       %opt_decay_adamw = torch.aten.rsub.Scalar %opt_lr_wd_adamw, %opt_one_adamw, %opt_one_adamw : !torch.vtensor<[1],f32>, !torch.float, !torch.float -> !torch.vtensor<[1],f32>
+// TORCH-CHECK:       %opt_p_0_adamw = torch.aten.to.dtype %w_adamw_perm, %opt_f32_adamw, %opt_false_adamw, %opt_false_adamw, %opt_none_adamw : !torch.vtensor<[4,8],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_p_decayed_0_adamw = torch.aten.mul.Tensor %opt_p_0_adamw, %opt_decay_adamw : !torch.vtensor<[4,8],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_m_decay_0_adamw = torch.aten.mul.Tensor %opt_m_0_adamw, %beta1 : !torch.vtensor<[4,8],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_g_scaled_0_adamw = torch.aten.mul.Tensor %opt_g_0_adamw, %opt_one_minus_beta1_adamw : !torch.vtensor<[4,8],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_m_new_0_adamw = torch.aten.add.Tensor %opt_m_decay_0_adamw, %opt_g_scaled_0_adamw, %opt_int1_adamw : !torch.vtensor<[4,8],f32>, !torch.vtensor<[4,8],f32>, !torch.int -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_g_sq_0_adamw = torch.aten.mul.Tensor %opt_g_0_adamw, %opt_g_0_adamw : !torch.vtensor<[4,8],f32>, !torch.vtensor<[4,8],f32> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_v_new_0_adamw = torch.aten.add.Tensor %opt_v_decay_0_adamw, %opt_g_sq_scaled_0_adamw, %opt_int1_adamw : !torch.vtensor<[4,8],f32>, !torch.vtensor<[4,8],f32>, !torch.int -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_v_sqrt_0_adamw = torch.aten.sqrt %opt_v_new_0_adamw : !torch.vtensor<[4,8],f32> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_denom_0_adamw = torch.aten.add.Tensor %opt_v_hat_sqrt_0_adamw, %eps, %opt_int1_adamw : !torch.vtensor<[4,8],f32>, !torch.vtensor<[1],f32>, !torch.int -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %opt_update_0_adamw = torch.aten.mul.Tensor %opt_ratio_0_adamw, %opt_step_size_adamw : !torch.vtensor<[4,8],f32>, !torch.vtensor<[1],f32> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %adamw_NEW_MOMENT1_0_adamw_perm = torch.aten.to.dtype %opt_m_new_0_adamw, %opt_m_out_0_dtype_adamw
+// TORCH-CHECK:       %adamw_NEW_MOMENT2_0_adamw_perm = torch.aten.to.dtype %opt_v_new_0_adamw, %opt_v_out_0_dtype_adamw
+// TORCH-CHECK:       %opt_p_new_0_adamw = torch.aten.sub.Tensor %opt_p_decayed_0_adamw, %opt_update_0_adamw, %opt_int1_adamw : !torch.vtensor<[4,8],f32>, !torch.vtensor<[4,8],f32>, !torch.int -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %adamw_NEW_PARAM_0_adamw_perm = torch.aten.to.dtype %opt_p_new_0_adamw, %opt_p_out_0_dtype_adamw
+// TORCH-CHECK:       %opt_p_new_1_adamw = torch.aten.sub.Tensor %opt_p_decayed_1_adamw, %opt_update_1_adamw, %opt_int1_adamw : !torch.vtensor<[8],f32>, !torch.vtensor<[8],f32>, !torch.int -> !torch.vtensor<[8],f32>
+// TORCH-CHECK:       %adamw_NEW_PARAM_0 = torch.aten.permute %adamw_NEW_PARAM_0_adamw_perm, %permute_p_new0_adamw : !torch.vtensor<[4,8],f32>, !torch.list<int> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK-DAG:   torch.overwrite.tensor.contents %adamw_NEW_PARAM_0 overwrites %w_ : !torch.vtensor<[4,8],f32>, !torch.tensor<[4,8],f32>
+// TORCH-CHECK-DAG:   torch.overwrite.tensor.contents %adamw_NEW_PARAM_1 overwrites %b_ : !torch.vtensor<[8],f32>, !torch.tensor<[8],f32>
+// TORCH-CHECK-DAG:   torch.overwrite.tensor.contents %adamw_NEW_MOMENT1_0 overwrites %w_m_ : !torch.vtensor<[4,8],f32>, !torch.tensor<[4,8],f32>
+// TORCH-CHECK-DAG:   torch.overwrite.tensor.contents %adamw_NEW_MOMENT2_1 overwrites %b_v_ : !torch.vtensor<[8],f32>, !torch.tensor<[8],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testOptimizerAsmEmitterAdamw() {
+  auto graph = std::make_shared<Graph>();
+  graph->setName("optimizer_asm_emitter_adamw")
+      .setIODataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+
+  auto makeTensor = [&](const std::string &name,
+                        const std::vector<int64_t> &dim) {
+    return graph->tensor(TensorAttr().setName(name).setDim(dim).setStride(
+        generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+  auto makeScalar = [&](const std::string &name, float value) {
+    auto t = graph->tensor(TensorAttr(value));
+    t->setName(name);
+    return t;
+  };
+
+  std::vector<std::shared_ptr<TensorAttr>> params, grads, moments1, moments2;
+  for (const auto &[name, dim] :
+       {std::pair<std::string, std::vector<int64_t>>{"w", {4, 8}},
+        std::pair<std::string, std::vector<int64_t>>{"b", {8}}}) {
+    params.push_back(makeTensor(name, dim));
+    grads.push_back(makeTensor(name + "_g", dim));
+    moments1.push_back(makeTensor(name + "_m", dim));
+    moments2.push_back(makeTensor(name + "_v", dim));
+  }
+
+  auto adamwAttr = OptimizerAttr()
+                       .setMode(OptimizerAttr::Mode::ADAMW)
+                       .setLR(makeScalar("lr", 1e-3f))
+                       .setBETA1(makeScalar("beta1", 0.9f))
+                       .setBETA2(makeScalar("beta2", 0.999f))
+                       .setEPSILON(makeScalar("eps", 1e-8f))
+                       .setWEIGHT_DECAY(makeScalar("wd", 0.01f))
+                       .setSTEP(makeScalar("step", 1.0f))
+                       .setName("adamw");
+  graph->optimizerUpdate(params, grads, moments1, moments2, adamwAttr);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testOptimizerAsmEmitterAdamw();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
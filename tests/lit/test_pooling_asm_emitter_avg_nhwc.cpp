@@ -0,0 +1,79 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[4,8,8,32],f32>, %arg0_input: !torch.vtensor<[4,16,16,32],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_input_pooling_perm = torch.aten.permute %arg0_input, %permute_X_pooling : !torch.vtensor<[4,16,16,32],f32>, !torch.list<int> -> !torch.vtensor<[4,32,16,16],f32>
+// TORCH-CHECK:       %kernel_pooling = torch.prim.ListConstruct %kernel_val_0_pooling, %kernel_val_1_pooling : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %stride_pooling = torch.prim.ListConstruct %stride_val_0_pooling, %stride_val_1_pooling : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %padding_pooling = torch.prim.ListConstruct %padding_val_0_pooling, %padding_val_1_pooling : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %count_include_pad_pooling = torch.constant.bool false
+// TORCH-CHECK:       %divisor_override_pooling = torch.constant.none
+// TORCH-CHECK:       %ceil_mode_pooling = torch.constant.bool false
+// TORCH-CHECK:       %result_pooling_perm = torch.aten.avg_pool2d %arg0_input_pooling_perm, %kernel_pooling, %stride_pooling, %padding_pooling, %ceil_mode_pooling, %count_include_pad_pooling, %divisor_override_pooling : !torch.vtensor<[4,32,16,16],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[4,32,8,8],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_pooling_perm, %permute_Y_pooling : !torch.vtensor<[4,32,8,8],f32>, !torch.list<int> -> !torch.vtensor<[4,8,8,32],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[4,8,8,32],f32>, !torch.tensor<[4,8,8,32],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testPoolingAsmEmitterAvgNhwc() {
+  int64_t n = 4, c = 32, h = 16, w = 16;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("pooling_asm_emitter_avg_nhwc");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_input")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+  auto poolingAttr = PoolingAttr()
+                         .setMode(PoolingAttr::Mode::AVG)
+                         .setWindow({2, 2})
+                         .setStride({2, 2})
+                         .setPadding({0, 0})
+                         .setCountIncludePad(false)
+                         .setName("pooling");
+
+  auto yT = graph->pooling(xT, poolingAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testPoolingAsmEmitterAvgNhwc();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
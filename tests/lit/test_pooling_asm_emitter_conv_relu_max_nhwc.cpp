@@ -0,0 +1,98 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// A conv -> relu -> max pool block on NHWC tensors. The intermediates stay in
+// logical (NCHW) layout, so the only permutes are on the graph inputs and
+// the output.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[8,16,16,64],f32>, %arg0_image: !torch.vtensor<[8,32,32,64],f32>, %arg1_filter: !torch.vtensor<[64,3,3,64],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_image_conv_fprop_perm = torch.aten.permute %arg0_image, %permute_X_conv_fprop : !torch.vtensor<[8,32,32,64],f32>, !torch.list<int> -> !torch.vtensor<[8,64,32,32],f32>
+// TORCH-CHECK:       %arg1_filter_conv_fprop_perm = torch.aten.permute %arg1_filter, %permute_W_conv_fprop : !torch.vtensor<[64,3,3,64],f32>, !torch.list<int> -> !torch.vtensor<[64,64,3,3],f32>
+// TORCH-CHECK:       %conv_result_conv_fprop_perm = torch.aten.convolution %arg0_image_conv_fprop_perm, %arg1_filter_conv_fprop_perm, %bias_conv_fprop, %stride_conv_fprop, %padding_conv_fprop, %dilation_conv_fprop, %transposed_conv_fprop, %output_padding_conv_fprop, %groups_conv_fprop : !torch.vtensor<[8,64,32,32],f32>, !torch.vtensor<[64,64,3,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[8,64,32,32],f32>
+// TORCH-CHECK:       %conv_result = torch.tensor_static_info_cast %conv_result_conv_fprop_perm : !torch.vtensor<[8,64,32,32],f32> to !torch.vtensor<[8,64,32,32],f32>
+// TORCH-CHECK:       %conv_result_relu_perm = torch.tensor_static_info_cast %conv_result : !torch.vtensor<[8,64,32,32],f32> to !torch.vtensor<[8,64,32,32],f32>
+// TORCH-CHECK:       %relu_result_relu_perm = torch.aten.relu %conv_result_relu_perm : !torch.vtensor<[8,64,32,32],f32> -> !torch.vtensor<[8,64,32,32],f32>
+// TORCH-CHECK:       %relu_result = torch.tensor_static_info_cast %relu_result_relu_perm : !torch.vtensor<[8,64,32,32],f32> to !torch.vtensor<[8,64,32,32],f32>
+// TORCH-CHECK:       %relu_result_pooling_perm = torch.tensor_static_info_cast %relu_result : !torch.vtensor<[8,64,32,32],f32> to !torch.vtensor<[8,64,32,32],f32>
+// TORCH-CHECK:       %result_pooling_perm = torch.aten.max_pool2d %relu_result_pooling_perm, %kernel_pooling, %stride_pooling, %padding_pooling, %dilation_pooling, %ceil_mode_pooling : !torch.vtensor<[8,64,32,32],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool -> !torch.vtensor<[8,64,16,16],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_pooling_perm, %permute_Y_pooling : !torch.vtensor<[8,64,16,16],f32>, !torch.list<int> -> !torch.vtensor<[8,16,16,64],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[8,16,16,64],f32>, !torch.tensor<[8,16,16,64],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testPoolingAsmEmitterConvReluMaxNhwc() {
+  int64_t n = 8, c = 64, h = 32, w = 32, k = 64, r = 3, s = 3;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("pooling_asm_emitter_conv_relu_max_nhwc");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_image")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, 1, c * w, c})); // NHWC
+
+  auto wT = graph->tensor(TensorAttr()
+                              .setName("arg1_filter")
+                              .setDim({k, c, r, s})
+                              .setStride({c * r * s, 1, c * s, c})); // KRSC
+
+  auto convAttr = ConvFPropAttr()
+                      .setStride({1, 1})
+                      .setPadding({1, 1})
+                      .setDilation({1, 1})
+                      .setName("conv_fprop");
+  auto convT = graph->convFProp(xT, wT, convAttr);
+  convT->setName("conv_result").setDataType(DataType::Float);
+
+  auto reluAttr =
+      PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD).setName("relu");
+  auto reluT = graph->pointwise(convT, reluAttr);
+  reluT->setName("relu_result").setDataType(DataType::Float);
+
+  auto poolingAttr = PoolingAttr()
+                         .setMode(PoolingAttr::Mode::MAX)
+                         .setWindow({2, 2})
+                         .setStride({2, 2})
+                         .setPadding({0, 0})
+                         .setName("pooling");
+  graph->pooling(reluT, poolingAttr)->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testPoolingAsmEmitterConvReluMaxNhwc();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} stats | FileCheck %s --check-prefix=%{BACKEND}-STATS-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[16,64,28,28],f32>, %arg0_input: !torch.vtensor<[16,64,56,56],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_input_pooling_perm = torch.aten.permute %arg0_input, %permute_X_pooling : !torch.vtensor<[16,64,56,56],f32>, !torch.list<int> -> !torch.vtensor<[16,64,56,56],f32>
+// TORCH-CHECK:       %kernel_val_0_pooling = torch.constant.int 3
+// TORCH-CHECK:       %kernel_val_1_pooling = torch.constant.int 3
+// TORCH-CHECK:       %kernel_pooling = torch.prim.ListConstruct %kernel_val_0_pooling, %kernel_val_1_pooling : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %stride_val_0_pooling = torch.constant.int 2
+// TORCH-CHECK:       %stride_val_1_pooling = torch.constant.int 2
+// TORCH-CHECK:       %stride_pooling = torch.prim.ListConstruct %stride_val_0_pooling, %stride_val_1_pooling : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %padding_val_0_pooling = torch.constant.int 1
+// TORCH-CHECK:       %padding_val_1_pooling = torch.constant.int 1
+// TORCH-CHECK:       %padding_pooling = torch.prim.ListConstruct %padding_val_0_pooling, %padding_val_1_pooling : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %dilation_val_0_pooling = torch.constant.int 1
+// TORCH-CHECK:       %dilation_val_1_pooling = torch.constant.int 1
+// TORCH-CHECK:       %dilation_pooling = torch.prim.ListConstruct %dilation_val_0_pooling, %dilation_val_1_pooling : (!torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %ceil_mode_pooling = torch.constant.bool false
+// TORCH-CHECK:       %result_pooling_perm = torch.aten.max_pool2d %arg0_input_pooling_perm, %kernel_pooling, %stride_pooling, %padding_pooling, %dilation_pooling, %ceil_mode_pooling : !torch.vtensor<[16,64,56,56],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool -> !torch.vtensor<[16,64,28,28],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_pooling_perm, %permute_Y_pooling : !torch.vtensor<[16,64,28,28],f32>, !torch.list<int> -> !torch.vtensor<[16,64,28,28],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[16,64,28,28],f32>, !torch.tensor<[16,64,28,28],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// AMDGPU-STATS-CHECK: "dispatch-count": 1
+// CPU-STATS-CHECK: "dispatch-count": 1
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testPoolingAsmEmitterMaxNchw(const std::string &mode) {
+  int64_t n = 16, c = 64, h = 56, w = 56;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("pooling_asm_emitter_max_nchw");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_input")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1})); // NCHW
+
+  auto poolingAttr = PoolingAttr()
+                         .setMode(PoolingAttr::Mode::MAX)
+                         .setWindow({3, 3})
+                         .setStride({2, 2})
+                         .setPadding({1, 1})
+                         .setName("pooling");
+
+  auto yT = graph->pooling(xT, poolingAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+    FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+    std::cout << generatedAsm << std::endl;
+  }
+
+  if (mode == "stats") {
+    FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(kDefaultBackend));
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/true));
+    FUSILLI_ASSIGN_OR_RETURN(auto stats, graph->readCompilationCacheFile(
+                                             CachedAssetsType::Statistics));
+    std::cout << stats << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testPoolingAsmEmitterMaxNchw(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Greedy and top-k sampling of [2, 16] logits: the argmax token and the 4
+// largest logits with their token ids, returned as Int64 indices.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%token_: !torch.tensor<[2,1],si64>, %top_ids_: !torch.tensor<[2,4],si64>, %top_logits_: !torch.tensor<[2,4],f32>, %logits: !torch.vtensor<[2,16],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %logits_argmax_perm = torch.aten.permute %logits, %permute_X_argmax : !torch.vtensor<[2,16],f32>, !torch.list<int> -> !torch.vtensor<[2,16],f32>
+// TORCH-CHECK:       %reduction_dim_argmax = torch.constant.int 1
+// TORCH-CHECK:       %keepdim_argmax = torch.constant.bool true
+// TORCH-CHECK:       %token_argmax_perm = torch.aten.argmax %logits_argmax_perm, %reduction_dim_argmax, %keepdim_argmax : !torch.vtensor<[2,16],f32>, !torch.int, !torch.bool -> !torch.vtensor<[2,1],si64>
+// TORCH-CHECK:       %token = torch.aten.permute %token_argmax_perm, %permute_Y_argmax : !torch.vtensor<[2,1],si64>, !torch.list<int> -> !torch.vtensor<[2,1],si64>
+// TORCH-CHECK:       %logits_topk_perm = torch.aten.permute %logits, %permute_X_topk : !torch.vtensor<[2,16],f32>, !torch.list<int> -> !torch.vtensor<[2,16],f32>
+// TORCH-CHECK:       %topk_k_topk = torch.constant.int 4
+// TORCH-CHECK:       %reduction_dim_topk = torch.constant.int 1
+// TORCH-CHECK:       %top_logits_topk_perm, %top_ids_topk_perm = torch.aten.topk %logits_topk_perm, %topk_k_topk, %reduction_dim_topk, %topk_largest_topk, %topk_sorted_topk : !torch.vtensor<[2,16],f32>, !torch.int, !torch.int, !torch.bool, !torch.bool -> !torch.vtensor<[2,4],f32>, !torch.vtensor<[2,4],si64>
+// TORCH-CHECK:       %top_logits = torch.aten.permute %top_logits_topk_perm, %permute_Y_topk : !torch.vtensor<[2,4],f32>, !torch.list<int> -> !torch.vtensor<[2,4],f32>
+// TORCH-CHECK:       %top_ids = torch.aten.permute %top_ids_topk_perm, %permute_Y2_topk : !torch.vtensor<[2,4],si64>, !torch.list<int> -> !torch.vtensor<[2,4],si64>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testReductionAsmEmitterArgmaxTopk() {
+  auto graph = std::make_shared<Graph>();
+  graph->setName("reduction_asm_emitter_argmax_topk");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  std::vector<int64_t> logitsDim = {2, 16};
+  auto logitsT = graph->tensor(
+      TensorAttr().setName("logits").setDim(logitsDim).setStride(
+          generateStrideFromDim(logitsDim, getContiguousStrideOrder(2))));
+
+  auto argmaxAttr =
+      ReductionAttr().setMode(ReductionAttr::Mode::ARGMAX).setName("argmax");
+  auto tokenT = graph->reduction(logitsT, argmaxAttr);
+  tokenT->setDim({2, 1}).setName("token").setOutput(true);
+
+  auto topkAttr =
+      ReductionAttr().setMode(ReductionAttr::Mode::TOPK).setName("topk");
+  auto [valuesT, idsT] = graph->multiOutputReduction(logitsT, topkAttr);
+  valuesT->setDim({2, 4}).setName("top_logits").setOutput(true);
+  idsT->setName("top_ids").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testReductionAsmEmitterArgmaxTopk();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} stats | FileCheck %s --check-prefix=%{BACKEND}-STATS-CHECK
+
+// Mean and variance over the C, H and W axes of an f16 X, accumulated in
+// f32, in a single dispatch.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%mean_: !torch.tensor<[16,1,1,1],f32>, %var_: !torch.tensor<[16,1,1,1],f32>, %arg0_input: !torch.vtensor<[16,128,32,32],f16>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_input_reduction_mean_var_perm = torch.aten.permute %arg0_input, %permute_X_reduction_mean_var : !torch.vtensor<[16,128,32,32],f16>, !torch.list<int> -> !torch.vtensor<[16,128,32,32],f16>
+// TORCH-CHECK:       %reduction_dims_reduction_mean_var = torch.prim.ListConstruct %reduction_dims_val_0_reduction_mean_var, %reduction_dims_val_1_reduction_mean_var, %reduction_dims_val_2_reduction_mean_var : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %keepdim_reduction_mean_var = torch.constant.bool true
+// TORCH-CHECK:       %acc_dtype_reduction_mean_var = torch.constant.int 6
+// TORCH-CHECK:       %acc_reduction_mean_var = torch.aten.to.dtype %arg0_input_reduction_mean_var_perm, %acc_dtype_reduction_mean_var, %acc_false_reduction_mean_var, %acc_false_reduction_mean_var, %acc_none_reduction_mean_var : !torch.vtensor<[16,128,32,32],f16>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[16,128,32,32],f32>
+// TORCH-CHECK:       %sq_reduction_mean_var = torch.aten.mul.Tensor %acc_reduction_mean_var, %acc_reduction_mean_var : !torch.vtensor<[16,128,32,32],f32>, !torch.vtensor<[16,128,32,32],f32> -> !torch.vtensor<[16,128,32,32],f32>
+// TORCH-CHECK:       %sum_reduction_mean_var = torch.aten.sum.dim_IntList %acc_reduction_mean_var, %reduction_dims_reduction_mean_var, %keepdim_reduction_mean_var, %dtype_reduction_mean_var : !torch.vtensor<[16,128,32,32],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       %sumsq_reduction_mean_var = torch.aten.sum.dim_IntList %sq_reduction_mean_var, %reduction_dims_reduction_mean_var, %keepdim_reduction_mean_var, %dtype_reduction_mean_var : !torch.vtensor<[16,128,32,32],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       %count_reduction_mean_var = torch.constant.int 131072
+// TORCH-CHECK:       %mean_reduction_mean_var_perm = torch.aten.div.Scalar %sum_reduction_mean_var, %count_reduction_mean_var : !torch.vtensor<[16,1,1,1],f32>, !torch.int -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       %meansq_reduction_mean_var = torch.aten.div.Scalar %sumsq_reduction_mean_var, %count_reduction_mean_var : !torch.vtensor<[16,1,1,1],f32>, !torch.int -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       %sqmean_reduction_mean_var = torch.aten.mul.Tensor %mean_reduction_mean_var_perm, %mean_reduction_mean_var_perm : !torch.vtensor<[16,1,1,1],f32>, !torch.vtensor<[16,1,1,1],f32> -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       %var_reduction_mean_var = torch.aten.sub.Tensor %meansq_reduction_mean_var, %sqmean_reduction_mean_var, %alpha_reduction_mean_var : !torch.vtensor<[16,1,1,1],f32>, !torch.vtensor<[16,1,1,1],f32>, !torch.int -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       %var_reduction_mean_var_perm = torch.aten.relu %var_reduction_mean_var : !torch.vtensor<[16,1,1,1],f32> -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       %mean = torch.aten.permute %mean_reduction_mean_var_perm, %permute_Y_reduction_mean_var : !torch.vtensor<[16,1,1,1],f32>, !torch.list<int> -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       %var = torch.aten.permute %var_reduction_mean_var_perm, %permute_Y2_reduction_mean_var : !torch.vtensor<[16,1,1,1],f32>, !torch.list<int> -> !torch.vtensor<[16,1,1,1],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %mean overwrites %mean_ : !torch.vtensor<[16,1,1,1],f32>, !torch.tensor<[16,1,1,1],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %var overwrites %var_ : !torch.vtensor<[16,1,1,1],f32>, !torch.tensor<[16,1,1,1],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// AMDGPU-STATS-CHECK: "transient-memory-size": 0
+// AMDGPU-STATS-CHECK: "dispatch-count": 1
+// CPU-STATS-CHECK: "transient-memory-size": 0
+// CPU-STATS-CHECK: "dispatch-count": 1
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testReductionAsmEmitterMeanVar(const std::string &mode) {
+  int64_t n = 16, c = 128, h = 32, w = 32;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("reduction_asm_emitter_mean_var");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_input")
+                              .setDim({n, c, h, w})
+                              .setStride({c * h * w, h * w, w, 1}));
+  auto reductionAttr = ReductionAttr()
+                           .setMode(ReductionAttr::Mode::MEAN_VAR)
+                           .setName("reduction_mean_var");
+  auto [meanT, varT] = graph->multiOutputReduction(xT, reductionAttr);
+  meanT->setDim({n, 1, 1, 1}).setStride({1, 1, 1, 1});
+  meanT->setName("mean").setDataType(DataType::Float).setOutput(true);
+  varT->setName("var").setDataType(DataType::Float).setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+    FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+    std::cout << generatedAsm << std::endl;
+  }
+
+  if (mode == "stats") {
+    FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(kDefaultBackend));
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/true));
+    FUSILLI_ASSIGN_OR_RETURN(auto stats, graph->readCompilationCacheFile(
+                                             CachedAssetsType::Statistics));
+    std::cout << stats << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testReductionAsmEmitterMeanVar(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
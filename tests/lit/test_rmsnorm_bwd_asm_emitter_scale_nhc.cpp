@@ -0,0 +1,89 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%dscale_: !torch.tensor<[1,8,4],f16>, %dx_: !torch.tensor<[2,8,4],f16>, %dy: !torch.vtensor<[2,8,4],f16>, %inv_rms: !torch.vtensor<[2,1,1],f32>, %scale: !torch.vtensor<[1,8,4],f16>, %x: !torch.vtensor<[2,8,4],f16>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %x_rmsnorm_bwd_perm = torch.aten.permute %x, %permute_x_rmsnorm_bwd : !torch.vtensor<[2,8,4],f16>, !torch.list<int> -> !torch.vtensor<[2,4,8],f16>
+// TORCH-CHECK:       %bwd_f32_rmsnorm_bwd = torch.constant.int 6
+// TORCH-CHECK:       %bwd_x_rmsnorm_bwd = torch.aten.to.dtype %x_rmsnorm_bwd_perm, %bwd_f32_rmsnorm_bwd, %bwd_false_rmsnorm_bwd, %bwd_false_rmsnorm_bwd, %bwd_none_rmsnorm_bwd : !torch.vtensor<[2,4,8],f16>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK-NOT:   %bwd_centered_rmsnorm_bwd
+// TORCH-CHECK:       %bwd_xhat_rmsnorm_bwd = torch.aten.mul.Tensor %bwd_x_rmsnorm_bwd, %bwd_inv_std_rmsnorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[2,1,1],f32> -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_g_xhat_mean_rmsnorm_bwd = torch.aten.mean.dim %bwd_g_xhat_rmsnorm_bwd, %bwd_norm_dims_rmsnorm_bwd, %bwd_true_rmsnorm_bwd, %bwd_none_rmsnorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[2,1,1],f32>
+// TORCH-CHECK-NOT:   %bwd_g_mean_rmsnorm_bwd
+// TORCH-CHECK:       %bwd_dx_unscaled_rmsnorm_bwd = torch.aten.sub.Tensor %bwd_g_rmsnorm_bwd, %bwd_proj_rmsnorm_bwd, %bwd_int1_rmsnorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[2,4,8],f32>, !torch.int -> !torch.vtensor<[2,4,8],f32>
+// TORCH-CHECK:       %bwd_dx_dtype_rmsnorm_bwd = torch.constant.int 5
+// TORCH-CHECK:       %dx_rmsnorm_bwd_perm = torch.aten.to.dtype %bwd_dx_f32_rmsnorm_bwd, %bwd_dx_dtype_rmsnorm_bwd, %bwd_false_rmsnorm_bwd, %bwd_false_rmsnorm_bwd, %bwd_none_rmsnorm_bwd : !torch.vtensor<[2,4,8],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,4,8],f16>
+// TORCH-CHECK:       %dscale_rmsnorm_bwd_perm = torch.aten.to.dtype %bwd_dscale_f32_rmsnorm_bwd, %bwd_dscale_dtype_rmsnorm_bwd, %bwd_false_rmsnorm_bwd, %bwd_false_rmsnorm_bwd, %bwd_none_rmsnorm_bwd : !torch.vtensor<[1,4,8],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[1,4,8],f16>
+// TORCH-CHECK-NOT:   %bwd_dbias_f32_rmsnorm_bwd
+// TORCH-CHECK:       %dx = torch.aten.permute %dx_rmsnorm_bwd_perm, %permute_dx_rmsnorm_bwd : !torch.vtensor<[2,4,8],f16>, !torch.list<int> -> !torch.vtensor<[2,8,4],f16>
+// TORCH-CHECK:       %dscale = torch.aten.permute %dscale_rmsnorm_bwd_perm, %permute_dscale_rmsnorm_bwd : !torch.vtensor<[1,4,8],f16>, !torch.list<int> -> !torch.vtensor<[1,8,4],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dscale overwrites %dscale_ : !torch.vtensor<[1,8,4],f16>, !torch.tensor<[1,8,4],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dx overwrites %dx_ : !torch.vtensor<[2,8,4],f16>, !torch.tensor<[2,8,4],f16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testRmsnormBwdAsmEmitterScaleNhc() {
+  int64_t n = 2, c = 4, h = 8;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("rmsnorm_bwd_asm_emitter_scale_nhc");
+  graph->setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto dyT = graph->tensor(TensorAttr()
+                               .setName("dy")
+                               .setDim({n, c, h})
+                               .setStride({c * h, 1, c})); // NHC
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("x")
+                              .setDim({n, c, h})
+                              .setStride({c * h, 1, c})); // NHC
+  auto rT = graph->tensor(TensorAttr()
+                              .setName("inv_rms")
+                              .setDim({n, 1, 1})
+                              .setStride({1, 1, 1})
+                              .setDataType(DataType::Float));
+  // Shape and strides will be inferred later in inferPropertiesNode()
+  auto sT = graph->tensor(TensorAttr().setName("scale"));
+
+  auto rmsnormBwdAttr = RmsnormBwdAttr().setName("rmsnorm_bwd");
+  auto [dxT, dsT] = graph->rmsnormBackward(dyT, xT, sT, rT, rmsnormBwdAttr);
+  dxT->setName("dx").setOutput(true);
+  dsT->setName("dscale").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testRmsnormBwdAsmEmitterScaleNhc();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Dropout with a runtime seed and offset. The dropout mask is drawn from a
+// Philox4x32-10 generator over the element index, so the attention is
+// decomposed into scores, softmax, dropout and the product with V instead of
+// the fused op.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%o_: !torch.tensor<[1,2,4,8],f32>, %k: !torch.vtensor<[1,2,4,8],f32>, %offset: !torch.vtensor<[1],si64>, %q: !torch.vtensor<[1,2,4,8],f32>, %seed: !torch.vtensor<[1],si64>, %v: !torch.vtensor<[1,2,4,8],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK-NOT:   torch.aten.scaled_dot_product_attention
+// TORCH-CHECK:       %scores_qk_sdpa = torch.aten.matmul %q_sdpa_perm, %scores_kt_sdpa : !torch.vtensor<[1,2,4,8],f32>, !torch.vtensor<[1,2,8,4],f32> -> !torch.vtensor<[1,2,4,4],f32>
+// TORCH-CHECK:       %rng_threshold_sdpa = torch.constant.int 1073741824
+// TORCH-CHECK:       %rng_shift32_sdpa = torch.vtensor.literal(dense<32> : tensor<si64>) : !torch.vtensor<[],si64>
+// TORCH-CHECK:       %rng_idx_sdpa = torch.aten.arange %rng_numel_sdpa, %rng_long_sdpa, %scores_none_sdpa, %scores_none_sdpa, %scores_none_sdpa : !torch.int, !torch.int, !torch.none, !torch.none, !torch.none -> !torch.vtensor<[32],si64>
+// TORCH-CHECK:       %rng_key0_sdpa = torch.aten.bitwise_and.Scalar %seed, %rng_mask32_sdpa : !torch.vtensor<[1],si64>, !torch.int -> !torch.vtensor<[1],si64>
+// TORCH-CHECK:       %rng_key1_shr_sdpa = torch.aten.bitwise_right_shift.Tensor %seed, %rng_shift32_sdpa : !torch.vtensor<[1],si64>, !torch.vtensor<[],si64> -> !torch.vtensor<[1],si64>
+// TORCH-CHECK:       %rng_offset_lo_sdpa = torch.aten.bitwise_and.Scalar %offset, %rng_mask32_sdpa : !torch.vtensor<[1],si64>, !torch.int -> !torch.vtensor<[1],si64>
+// TORCH-CHECK:       %rng_c2_sdpa = torch.aten.expand %rng_offset_lo_sdpa, %rng_flat_shape_sdpa, %scores_false_sdpa : !torch.vtensor<[1],si64>, !torch.list<int>, !torch.bool -> !torch.vtensor<[32],si64>
+// TORCH-CHECK:       %rng_r0_prod0_sdpa = torch.aten.mul.Scalar %rng_c0_sdpa, %rng_mul0_sdpa : !torch.vtensor<[32],si64>, !torch.int -> !torch.vtensor<[32],si64>
+// TORCH-CHECK:       %rng_r0_c0_sdpa = torch.aten.bitwise_xor.Tensor %rng_r0_c0_x_sdpa, %rng_key0_sdpa : !torch.vtensor<[32],si64>, !torch.vtensor<[1],si64> -> !torch.vtensor<[32],si64>
+// TORCH-CHECK:       %rng_r0_k0_sum_sdpa = torch.aten.add.Scalar %rng_key0_sdpa, %rng_weyl0_sdpa, %rng_int1_sdpa : !torch.vtensor<[1],si64>, !torch.int, !torch.int -> !torch.vtensor<[1],si64>
+// TORCH-CHECK:       %rng_r9_c0_sdpa = torch.aten.bitwise_xor.Tensor %rng_r9_c0_x_sdpa, %rng_r8_k0_sdpa : !torch.vtensor<[32],si64>, !torch.vtensor<[1],si64> -> !torch.vtensor<[32],si64>
+// TORCH-CHECK-NOT:   %rng_r9_k0_sum_sdpa
+// TORCH-CHECK:       %rng_drop_flat_sdpa = torch.aten.lt.Scalar %rng_r9_c0_sdpa, %rng_threshold_sdpa : !torch.vtensor<[32],si64>, !torch.int -> !torch.vtensor<[32],i1>
+// TORCH-CHECK:       %rng_drop_sdpa = torch.aten.view %rng_drop_flat_sdpa, %rng_probs_shape_sdpa : !torch.vtensor<[32],i1>, !torch.list<int> -> !torch.vtensor<[1,2,4,4],i1>
+// TORCH-CHECK:       %rng_probs_sdpa = torch.aten.softmax.int %scores_sdpa, %scores_int3_sdpa, %scores_none_sdpa : !torch.vtensor<[1,2,4,4],f32>, !torch.int, !torch.none -> !torch.vtensor<[1,2,4,4],f32>
+// TORCH-CHECK:       %rng_dropped_sdpa = torch.aten.masked_fill.Scalar %rng_probs_sdpa, %rng_drop_sdpa, %rng_zero_sdpa : !torch.vtensor<[1,2,4,4],f32>, !torch.vtensor<[1,2,4,4],i1>, !torch.float -> !torch.vtensor<[1,2,4,4],f32>
+// TORCH-CHECK:       %rng_keep_scale_sdpa = torch.constant.float 1.333333e+00
+// TORCH-CHECK:       %o_sdpa_perm = torch.aten.matmul %rng_probs_v_sdpa, %v_sdpa_perm : !torch.vtensor<[1,2,4,4],f32>, !torch.vtensor<[1,2,4,8],f32> -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %o = torch.aten.permute %o_sdpa_perm, %permute_O_sdpa : !torch.vtensor<[1,2,4,8],f32>, !torch.list<int> -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %o overwrites %o_ : !torch.vtensor<[1,2,4,8],f32>, !torch.tensor<[1,2,4,8],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testSdpaAsmEmitterDropoutRng() {
+  auto graph = std::make_shared<Graph>();
+  graph->setName("sdpa_asm_emitter_dropout_rng")
+      .setIODataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+
+  std::vector<int64_t> dim = {1, 2, 4, 8};
+  auto stride =
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+
+  auto q =
+      graph->tensor(TensorAttr().setName("q").setDim(dim).setStride(stride));
+  auto k =
+      graph->tensor(TensorAttr().setName("k").setDim(dim).setStride(stride));
+  auto v =
+      graph->tensor(TensorAttr().setName("v").setDim(dim).setStride(stride));
+  auto seed = graph->tensor(TensorAttr().setName("seed"));
+  auto offset = graph->tensor(TensorAttr().setName("offset"));
+
+  auto sdpaAttr = SdpaAttr()
+                      .setName("sdpa")
+                      .setDropout(0.25f)
+                      .setDROPOUT_SEED(seed)
+                      .setDROPOUT_OFFSET(offset);
+  auto o = graph->sdpa(q, k, v, /*mask=*/nullptr, sdpaAttr);
+  o->setName("o").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testSdpaAsmEmitterDropoutRng();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Decode attention (one query token) over a paged KV cache: each sequence's
+// pages are gathered from the K/V pools through the block table and fed
+// straight into the attention op.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%sdpa_O_: !torch.tensor<[2,8,1,64],f16>, %k_pool: !torch.vtensor<[16,8,16,64],f16>, %page_table: !torch.vtensor<[2,4],si32>, %q: !torch.vtensor<[2,8,1,64],f16>, %v_pool: !torch.vtensor<[16,8,16,64],f16>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %q_sdpa_perm = torch.aten.permute %q, %permute_Q_sdpa : !torch.vtensor<[2,8,1,64],f16>, !torch.list<int> -> !torch.vtensor<[2,8,1,64],f16>
+// TORCH-CHECK:       %k_pool_sdpa_perm = torch.aten.permute %k_pool, %permute_K_sdpa : !torch.vtensor<[16,8,16,64],f16>, !torch.list<int> -> !torch.vtensor<[16,8,16,64],f16>
+// TORCH-CHECK:       %v_pool_sdpa_perm = torch.aten.permute %v_pool, %permute_V_sdpa : !torch.vtensor<[16,8,16,64],f16>, !torch.list<int> -> !torch.vtensor<[16,8,16,64],f16>
+// TORCH-CHECK:       %none_mask_sdpa = torch.constant.none
+// TORCH-CHECK:       %enable_gqa_sdpa = torch.constant.bool false
+// TORCH-CHECK:       %page_table_sdpa_perm = torch.aten.permute %page_table, %permute_PAGE_TABLE_sdpa : !torch.vtensor<[2,4],si32>, !torch.list<int> -> !torch.vtensor<[2,4],si32>
+// TORCH-CHECK:       %page_table_flat_shape_val_0_sdpa = torch.constant.int 8
+// TORCH-CHECK:       %page_table_flat_shape_sdpa = torch.prim.ListConstruct %page_table_flat_shape_val_0_sdpa : (!torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %page_table_flat_sdpa = torch.aten.view %page_table_sdpa_perm, %page_table_flat_shape_sdpa : !torch.vtensor<[2,4],si32>, !torch.list<int> -> !torch.vtensor<[8],si32>
+// TORCH-CHECK:       %page_dim_sdpa = torch.constant.int 0
+// TORCH-CHECK:       %page_transpose_dim0_sdpa = torch.constant.int 1
+// TORCH-CHECK:       %page_transpose_dim1_sdpa = torch.constant.int 2
+// TORCH-CHECK:       %paged_k_gather_sdpa = torch.aten.index_select %k_pool_sdpa_perm, %page_dim_sdpa, %page_table_flat_sdpa : !torch.vtensor<[16,8,16,64],f16>, !torch.int, !torch.vtensor<[8],si32> -> !torch.vtensor<[8,8,16,64],f16>
+// TORCH-CHECK:       %paged_k_split_shape_sdpa = torch.prim.ListConstruct
+// TORCH-CHECK:       %paged_k_split_sdpa = torch.aten.view %paged_k_gather_sdpa, %paged_k_split_shape_sdpa : !torch.vtensor<[8,8,16,64],f16>, !torch.list<int> -> !torch.vtensor<[2,4,8,16,64],f16>
+// TORCH-CHECK:       %paged_k_transpose_sdpa = torch.aten.transpose.int %paged_k_split_sdpa, %page_transpose_dim0_sdpa, %page_transpose_dim1_sdpa : !torch.vtensor<[2,4,8,16,64],f16>, !torch.int, !torch.int -> !torch.vtensor<[2,8,4,16,64],f16>
+// TORCH-CHECK:       %paged_k_shape_sdpa = torch.prim.ListConstruct
+// TORCH-CHECK:       %paged_k_sdpa = torch.aten.reshape %paged_k_transpose_sdpa, %paged_k_shape_sdpa : !torch.vtensor<[2,8,4,16,64],f16>, !torch.list<int> -> !torch.vtensor<[2,8,64,64],f16>
+// TORCH-CHECK:       %paged_v_gather_sdpa = torch.aten.index_select %v_pool_sdpa_perm, %page_dim_sdpa, %page_table_flat_sdpa : !torch.vtensor<[16,8,16,64],f16>, !torch.int, !torch.vtensor<[8],si32> -> !torch.vtensor<[8,8,16,64],f16>
+// TORCH-CHECK:       %paged_v_sdpa = torch.aten.reshape %paged_v_transpose_sdpa, %paged_v_shape_sdpa : !torch.vtensor<[2,8,4,16,64],f16>, !torch.list<int> -> !torch.vtensor<[2,8,64,64],f16>
+// TORCH-CHECK:       %sdpa_O_sdpa_perm = torch.aten.scaled_dot_product_attention %q_sdpa_perm, %paged_k_sdpa, %paged_v_sdpa, %none_mask_sdpa, %dropout_sdpa, %is_causal_sdpa, %scale_sdpa, %enable_gqa_sdpa : !torch.vtensor<[2,8,1,64],f16>, !torch.vtensor<[2,8,64,64],f16>, !torch.vtensor<[2,8,64,64],f16>, !torch.none, !torch.float, !torch.bool, !torch.none, !torch.bool -> !torch.vtensor<[2,8,1,64],f16>
+// TORCH-CHECK:       %sdpa_O = torch.aten.permute %sdpa_O_sdpa_perm, %permute_O_sdpa : !torch.vtensor<[2,8,1,64],f16>, !torch.list<int> -> !torch.vtensor<[2,8,1,64],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %sdpa_O overwrites %sdpa_O_ : !torch.vtensor<[2,8,1,64],f16>, !torch.tensor<[2,8,1,64],f16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testSdpaAsmEmitterPagedDecode() {
+  int64_t batch = 2, heads = 8, headDim = 64;
+  int64_t numPages = 16, blockSize = 16, pagesPerSeq = 4;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("sdpa_asm_emitter_paged_decode").setIODataType(DataType::Half);
+
+  std::vector<int64_t> qDim = {batch, heads, 1, headDim};
+  auto qStride =
+      generateStrideFromDim(qDim, getContiguousStrideOrder(qDim.size()));
+  std::vector<int64_t> poolDim = {numPages, heads, blockSize, headDim};
+  auto poolStride =
+      generateStrideFromDim(poolDim, getContiguousStrideOrder(poolDim.size()));
+
+  auto q = graph->tensor(
+      TensorAttr().setName("q").setDim(qDim).setStride(qStride).setDataType(
+          DataType::Half));
+  auto kPool = graph->tensor(TensorAttr()
+                                 .setName("k_pool")
+                                 .setDim(poolDim)
+                                 .setStride(poolStride)
+                                 .setDataType(DataType::Half));
+  auto vPool = graph->tensor(TensorAttr()
+                                 .setName("v_pool")
+                                 .setDim(poolDim)
+                                 .setStride(poolStride)
+                                 .setDataType(DataType::Half));
+  auto pageTable = graph->tensor(TensorAttr()
+                                     .setName("page_table")
+                                     .setDim({batch, pagesPerSeq})
+                                     .setStride({pagesPerSeq, 1})
+                                     .setDataType(DataType::Int32));
+
+  auto sdpaAttr = SdpaAttr()
+                      .setPAGE_TABLE(pageTable)
+                      .setBlockSize(blockSize)
+                      .setName("sdpa");
+  auto o = graph->sdpa(q, kPool, vPool, /*mask=*/nullptr, sdpaAttr);
+  o->setDataType(DataType::Half).setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testSdpaAsmEmitterPagedDecode();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
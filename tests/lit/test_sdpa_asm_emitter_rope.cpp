@@ -0,0 +1,94 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Rotary position embedding of Q and K from [seq, head_dim] cos/sin tables.
+// The rotated Q and K take the permuted names the attention op consumes.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%o_: !torch.tensor<[1,2,4,8],f32>, %cos: !torch.vtensor<[4,8],f32>, %k: !torch.vtensor<[1,2,4,8],f32>, %q: !torch.vtensor<[1,2,4,8],f32>, %sin: !torch.vtensor<[4,8],f32>, %v: !torch.vtensor<[1,2,4,8],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %q_sdpa_unrotated_perm = torch.aten.permute %q, %permute_Q_sdpa_unrotated : !torch.vtensor<[1,2,4,8],f32>, !torch.list<int> -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %k_sdpa_unrotated_perm = torch.aten.permute %k, %permute_K_sdpa_unrotated : !torch.vtensor<[1,2,4,8],f32>, !torch.list<int> -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %cos_sdpa_perm = torch.aten.permute %cos, %permute_ROPE_COS_sdpa : !torch.vtensor<[4,8],f32>, !torch.list<int> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %sin_sdpa_perm = torch.aten.permute %sin, %permute_ROPE_SIN_sdpa : !torch.vtensor<[4,8],f32>, !torch.list<int> -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %rope_half_sdpa = torch.constant.int 4
+// TORCH-CHECK:       %rope_end_sdpa = torch.constant.int 8
+// TORCH-CHECK:       %rope_q_lo_sdpa = torch.aten.slice.Tensor %q_sdpa_unrotated_perm, %rope_dim_sdpa, %rope_start_sdpa, %rope_half_sdpa, %rope_step_sdpa : !torch.vtensor<[1,2,4,8],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[1,2,4,4],f32>
+// TORCH-CHECK:       %rope_q_hi_sdpa = torch.aten.slice.Tensor %q_sdpa_unrotated_perm, %rope_dim_sdpa, %rope_half_sdpa, %rope_end_sdpa, %rope_step_sdpa : !torch.vtensor<[1,2,4,8],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[1,2,4,4],f32>
+// TORCH-CHECK:       %rope_q_hi_neg_sdpa = torch.aten.neg %rope_q_hi_sdpa : !torch.vtensor<[1,2,4,4],f32> -> !torch.vtensor<[1,2,4,4],f32>
+// TORCH-CHECK:       %rope_q_halves_sdpa = torch.prim.ListConstruct %rope_q_hi_neg_sdpa, %rope_q_lo_sdpa : (!torch.vtensor<[1,2,4,4],f32>, !torch.vtensor<[1,2,4,4],f32>) -> !torch.list<vtensor>
+// TORCH-CHECK:       %rope_q_rotated_sdpa = torch.aten.cat %rope_q_halves_sdpa, %rope_dim_sdpa : !torch.list<vtensor>, !torch.int -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %rope_q_cos_sdpa = torch.aten.mul.Tensor %q_sdpa_unrotated_perm, %cos_sdpa_perm : !torch.vtensor<[1,2,4,8],f32>, !torch.vtensor<[4,8],f32> -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %rope_q_sin_sdpa = torch.aten.mul.Tensor %rope_q_rotated_sdpa, %sin_sdpa_perm : !torch.vtensor<[1,2,4,8],f32>, !torch.vtensor<[4,8],f32> -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %q_sdpa_perm = torch.aten.add.Tensor %rope_q_cos_sdpa, %rope_q_sin_sdpa, %rope_alpha_sdpa : !torch.vtensor<[1,2,4,8],f32>, !torch.vtensor<[1,2,4,8],f32>, !torch.int -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %k_sdpa_perm = torch.aten.add.Tensor %rope_k_cos_sdpa, %rope_k_sin_sdpa, %rope_alpha_sdpa : !torch.vtensor<[1,2,4,8],f32>, !torch.vtensor<[1,2,4,8],f32>, !torch.int -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %o_sdpa_perm = torch.aten.scaled_dot_product_attention %q_sdpa_perm, %k_sdpa_perm, %v_sdpa_perm, %none_mask_sdpa, %dropout_sdpa, %is_causal_sdpa, %scale_sdpa, %enable_gqa_sdpa : !torch.vtensor<[1,2,4,8],f32>, !torch.vtensor<[1,2,4,8],f32>, !torch.vtensor<[1,2,4,8],f32>, !torch.none, !torch.float, !torch.bool, !torch.none, !torch.bool -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       %o = torch.aten.permute %o_sdpa_perm, %permute_O_sdpa : !torch.vtensor<[1,2,4,8],f32>, !torch.list<int> -> !torch.vtensor<[1,2,4,8],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %o overwrites %o_ : !torch.vtensor<[1,2,4,8],f32>, !torch.tensor<[1,2,4,8],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testSdpaAsmEmitterRope() {
+  auto graph = std::make_shared<Graph>();
+  graph->setName("sdpa_asm_emitter_rope")
+      .setIODataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+
+  std::vector<int64_t> dim = {1, 2, 4, 8};
+  auto stride =
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+
+  auto q =
+      graph->tensor(TensorAttr().setName("q").setDim(dim).setStride(stride));
+  auto k =
+      graph->tensor(TensorAttr().setName("k").setDim(dim).setStride(stride));
+  auto v =
+      graph->tensor(TensorAttr().setName("v").setDim(dim).setStride(stride));
+  auto cos = graph->tensor(
+      TensorAttr().setName("cos").setDim({4, 8}).setStride({8, 1}));
+  auto sin = graph->tensor(
+      TensorAttr().setName("sin").setDim({4, 8}).setStride({8, 1}));
+
+  auto sdpaAttr = SdpaAttr().setName("sdpa").setROPE_COS(cos).setROPE_SIN(sin);
+  auto o = graph->sdpa(q, k, v, /*mask=*/nullptr, sdpaAttr);
+  o->setName("o").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testSdpaAsmEmitterRope();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
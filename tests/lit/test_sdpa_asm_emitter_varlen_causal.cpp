@@ -0,0 +1,112 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Causal attention over sequences packed back to back without padding. The
+// per-sequence causal structure is carried by a block-diagonal mask derived
+// from the cumulative sequence lengths, so `is_causal` itself stays false.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%o_: !torch.tensor<[16,4,32],f32>, %cu_seqlens_kv: !torch.vtensor<[4],si32>, %cu_seqlens_q: !torch.vtensor<[4],si32>, %k: !torch.vtensor<[16,4,32],f32>, %q: !torch.vtensor<[16,4,32],f32>, %v: !torch.vtensor<[16,4,32],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %is_causal_sdpa = torch.constant.bool false
+// TORCH-CHECK:       %varlen_q_unsqueeze_sdpa = torch.aten.unsqueeze %q_sdpa_perm, %varlen_int0_sdpa : !torch.vtensor<[16,4,32],f32>, !torch.int -> !torch.vtensor<[1,16,4,32],f32>
+// TORCH-CHECK:       %varlen_q_sdpa = torch.aten.transpose.int %varlen_q_unsqueeze_sdpa, %varlen_int1_sdpa, %varlen_int2_sdpa : !torch.vtensor<[1,16,4,32],f32>, !torch.int, !torch.int -> !torch.vtensor<[1,4,16,32],f32>
+// TORCH-CHECK:       %varlen_k_sdpa = torch.aten.transpose.int
+// TORCH-CHECK:       %varlen_v_sdpa = torch.aten.transpose.int
+// TORCH-CHECK:       %cu_seqlens_q_sdpa_perm = torch.aten.permute %cu_seqlens_q, %permute_CU_SEQLENS_Q_sdpa : !torch.vtensor<[4],si32>, !torch.list<int> -> !torch.vtensor<[4],si32>
+// TORCH-CHECK:       %cu_seqlens_kv_sdpa_perm = torch.aten.permute %cu_seqlens_kv, %permute_CU_SEQLENS_KV_sdpa : !torch.vtensor<[4],si32>, !torch.list<int> -> !torch.vtensor<[4],si32>
+// TORCH-CHECK:       %varlen_q_len_sdpa = torch.aten.size.int %q_sdpa_perm, %varlen_int0_sdpa : !torch.vtensor<[16,4,32],f32>, !torch.int -> !torch.int
+// TORCH-CHECK:       %varlen_q_pos_sdpa = torch.aten.arange %varlen_q_len_sdpa, %varlen_long_sdpa, %varlen_none_sdpa, %varlen_none_sdpa, %varlen_none_sdpa : !torch.int, !torch.int, !torch.none, !torch.none, !torch.none -> !torch.vtensor<[16],si64>
+// TORCH-CHECK:       %varlen_q_ends_sdpa = torch.aten.slice.Tensor %cu_seqlens_q_sdpa_perm, %varlen_int0_sdpa, %varlen_int1_sdpa, %varlen_none_sdpa, %varlen_int1_sdpa : !torch.vtensor<[4],si32>, !torch.int, !torch.int, !torch.none, !torch.int -> !torch.vtensor<[3],si32>
+// TORCH-CHECK:       %varlen_q_ended_sdpa = torch.aten.ge.Tensor %varlen_q_pos_col_sdpa, %varlen_q_ends_sdpa : !torch.vtensor<[16,1],si64>, !torch.vtensor<[3],si32> -> !torch.vtensor<[16,3],i1>
+// TORCH-CHECK:       %varlen_q_seg_sdpa = torch.aten.sum.dim_IntList %varlen_q_ended_sdpa, %varlen_sum_dims_sdpa, %varlen_false_sdpa, %varlen_long_sdpa : !torch.vtensor<[16,3],i1>, !torch.list<int>, !torch.bool, !torch.int -> !torch.vtensor<[16],si64>
+// TORCH-CHECK:       %varlen_q_start_sdpa = torch.aten.index_select %cu_seqlens_q_sdpa_perm, %varlen_int0_sdpa, %varlen_q_seg_sdpa : !torch.vtensor<[4],si32>, !torch.int, !torch.vtensor<[16],si64> -> !torch.vtensor<[16],si32>
+// TORCH-CHECK:       %varlen_q_local_sdpa = torch.aten.sub.Tensor %varlen_q_pos_sdpa, %varlen_q_start_sdpa, %varlen_int1_sdpa : !torch.vtensor<[16],si64>, !torch.vtensor<[16],si32>, !torch.int -> !torch.vtensor<[16],si64>
+// TORCH-CHECK:       %varlen_kv_seg_sdpa = torch.aten.sum.dim_IntList
+// TORCH-CHECK:       %varlen_kv_local_sdpa = torch.aten.sub.Tensor
+// TORCH-CHECK:       %varlen_same_seq_sdpa = torch.aten.eq.Tensor %varlen_q_seg_col_sdpa, %varlen_kv_seg_sdpa : !torch.vtensor<[16,1],si64>, !torch.vtensor<[16],si64> -> !torch.vtensor<[16,16],i1>
+// TORCH-CHECK:       %varlen_causal_sdpa = torch.aten.ge.Tensor %varlen_q_local_col_sdpa, %varlen_kv_local_sdpa : !torch.vtensor<[16,1],si64>, !torch.vtensor<[16],si64> -> !torch.vtensor<[16,16],i1>
+// TORCH-CHECK:       %varlen_block_sdpa = torch.aten.logical_and %varlen_same_seq_sdpa, %varlen_causal_sdpa : !torch.vtensor<[16,16],i1>, !torch.vtensor<[16,16],i1> -> !torch.vtensor<[16,16],i1>
+// TORCH-CHECK:       %varlen_mask_3d_sdpa = torch.aten.unsqueeze %varlen_block_sdpa, %varlen_int0_sdpa : !torch.vtensor<[16,16],i1>, !torch.int -> !torch.vtensor<[1,16,16],i1>
+// TORCH-CHECK:       %varlen_mask_sdpa = torch.aten.unsqueeze %varlen_mask_3d_sdpa, %varlen_int0_sdpa : !torch.vtensor<[1,16,16],i1>, !torch.int -> !torch.vtensor<[1,1,16,16],i1>
+// TORCH-CHECK:       %varlen_o_sdpa = torch.aten.scaled_dot_product_attention %varlen_q_sdpa, %varlen_k_sdpa, %varlen_v_sdpa, %varlen_mask_sdpa, %dropout_sdpa, %is_causal_sdpa, %scale_sdpa, %enable_gqa_sdpa : !torch.vtensor<[1,4,16,32],f32>, !torch.vtensor<[1,4,16,32],f32>, !torch.vtensor<[1,4,16,32],f32>, !torch.vtensor<[1,1,16,16],i1>, !torch.float, !torch.bool, !torch.none, !torch.bool -> !torch.vtensor<[1,4,16,32],f32>
+// TORCH-CHECK:       %varlen_o_t_sdpa = torch.aten.transpose.int %varlen_o_sdpa, %varlen_int1_sdpa, %varlen_int2_sdpa : !torch.vtensor<[1,4,16,32],f32>, !torch.int, !torch.int -> !torch.vtensor<[1,16,4,32],f32>
+// TORCH-CHECK:       %o_sdpa_perm = torch.aten.squeeze.dim %varlen_o_t_sdpa, %varlen_int0_sdpa : !torch.vtensor<[1,16,4,32],f32>, !torch.int -> !torch.vtensor<[16,4,32],f32>
+// TORCH-CHECK:       %o = torch.aten.permute %o_sdpa_perm, %permute_O_sdpa : !torch.vtensor<[16,4,32],f32>, !torch.list<int> -> !torch.vtensor<[16,4,32],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %o overwrites %o_ : !torch.vtensor<[16,4,32],f32>, !torch.tensor<[16,4,32],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testSdpaAsmEmitterVarlenCausal() {
+  int64_t total = 16, heads = 4, headDim = 32, batch = 3;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("sdpa_asm_emitter_varlen_causal");
+  graph->setIODataType(DataType::Float);
+
+  std::vector<int64_t> dim = {total, heads, headDim};
+  auto stride =
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+
+  auto packed = [&](const std::string &name) {
+    return graph->tensor(
+        TensorAttr().setName(name).setDim(dim).setStride(stride));
+  };
+  auto cuSeqlens = [&](const std::string &name) {
+    return graph->tensor(TensorAttr()
+                             .setName(name)
+                             .setDim({batch + 1})
+                             .setStride({1})
+                             .setDataType(DataType::Int32));
+  };
+
+  auto q = packed("q");
+  auto k = packed("k");
+  auto v = packed("v");
+
+  auto sdpaAttr = SdpaAttr()
+                      .setCU_SEQLENS_Q(cuSeqlens("cu_seqlens_q"))
+                      .setCU_SEQLENS_KV(cuSeqlens("cu_seqlens_kv"))
+                      .setIsCausal(true)
+                      .setName("sdpa");
+  auto o = graph->sdpa(q, k, v, /*mask=*/nullptr, sdpaAttr);
+  o->setName("o").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testSdpaAsmEmitterVarlenCausal();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=BWD-CHECK
+
+// The backward pass recomputes the attention probabilities from Q, K and the
+// saved logsumexp STATS instead of reading a stored [seq_q, seq_kv] matrix.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%dk_: !torch.tensor<[1,4,32,64],f16>, %dq_: !torch.tensor<[1,4,16,64],f16>, %dv_: !torch.tensor<[1,4,32,64],f16>, %d_o: !torch.vtensor<[1,4,16,64],f16>, %k: !torch.vtensor<[1,4,32,64],f16>, %o: !torch.vtensor<[1,4,16,64],f16>, %q: !torch.vtensor<[1,4,16,64],f16>, %stats: !torch.vtensor<[1,4,16,1],f32>, %v: !torch.vtensor<[1,4,32,64],f16>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %stats_sdpa_bwd_perm = torch.aten.permute %stats, %permute_STATS_sdpa_bwd : !torch.vtensor<[1,4,16,1],f32>, !torch.list<int> -> !torch.vtensor<[1,4,16,1],f32>
+// TORCH-CHECK:       %scores_scale_sdpa_bwd = torch.constant.float 1.250000e-01
+// TORCH-CHECK:       %scores_sdpa_bwd = torch.aten.mul.Scalar %scores_qk_f32_sdpa_bwd, %scores_scale_sdpa_bwd : !torch.vtensor<[1,4,16,32],f32>, !torch.float -> !torch.vtensor<[1,4,16,32],f32>
+// TORCH-CHECK:       %bwd_shifted_sdpa_bwd = torch.aten.sub.Tensor %scores_sdpa_bwd, %stats_sdpa_bwd_perm, %scores_int1_sdpa_bwd : !torch.vtensor<[1,4,16,32],f32>, !torch.vtensor<[1,4,16,1],f32>, !torch.int -> !torch.vtensor<[1,4,16,32],f32>
+// TORCH-CHECK:       %bwd_p_f32_sdpa_bwd = torch.aten.exp %bwd_shifted_sdpa_bwd : !torch.vtensor<[1,4,16,32],f32> -> !torch.vtensor<[1,4,16,32],f32>
+// TORCH-CHECK:       %dv_sdpa_bwd_perm = torch.aten.matmul %bwd_pt_sdpa_bwd, %d_o_sdpa_bwd_perm : !torch.vtensor<[1,4,32,16],f16>, !torch.vtensor<[1,4,16,64],f16> -> !torch.vtensor<[1,4,32,64],f16>
+// TORCH-CHECK:       %bwd_dp_sdpa_bwd = torch.aten.matmul %d_o_sdpa_bwd_perm, %bwd_vt_sdpa_bwd : !torch.vtensor<[1,4,16,64],f16>, !torch.vtensor<[1,4,64,32],f16> -> !torch.vtensor<[1,4,16,32],f16>
+// TORCH-CHECK:       %bwd_delta_sdpa_bwd = torch.aten.sum.dim_IntList %bwd_do_o_f32_sdpa_bwd, %bwd_dims_sdpa_bwd, %bwd_keepdim_sdpa_bwd, %scores_none_sdpa_bwd : !torch.vtensor<[1,4,16,64],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[1,4,16,1],f32>
+// TORCH-CHECK:       %bwd_dp_centered_sdpa_bwd = torch.aten.sub.Tensor %bwd_dp_f32_sdpa_bwd, %bwd_delta_sdpa_bwd, %scores_int1_sdpa_bwd : !torch.vtensor<[1,4,16,32],f32>, !torch.vtensor<[1,4,16,1],f32>, !torch.int -> !torch.vtensor<[1,4,16,32],f32>
+// TORCH-CHECK:       %bwd_ds_unscaled_sdpa_bwd = torch.aten.mul.Tensor %bwd_p_f32_sdpa_bwd, %bwd_dp_centered_sdpa_bwd : !torch.vtensor<[1,4,16,32],f32>, !torch.vtensor<[1,4,16,32],f32> -> !torch.vtensor<[1,4,16,32],f32>
+// TORCH-CHECK:       %bwd_ds_f32_sdpa_bwd = torch.aten.mul.Scalar %bwd_ds_unscaled_sdpa_bwd, %scores_scale_sdpa_bwd : !torch.vtensor<[1,4,16,32],f32>, !torch.float -> !torch.vtensor<[1,4,16,32],f32>
+// TORCH-CHECK:       %bwd_ds_sdpa_bwd = torch.aten.to.dtype %bwd_ds_f32_sdpa_bwd, %bwd_dtype_sdpa_bwd, %scores_false_sdpa_bwd, %scores_false_sdpa_bwd, %scores_none_sdpa_bwd : !torch.vtensor<[1,4,16,32],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[1,4,16,32],f16>
+// TORCH-CHECK:       %dq_sdpa_bwd_perm = torch.aten.matmul %bwd_ds_sdpa_bwd, %k_sdpa_bwd_perm : !torch.vtensor<[1,4,16,32],f16>, !torch.vtensor<[1,4,32,64],f16> -> !torch.vtensor<[1,4,16,64],f16>
+// TORCH-CHECK:       %bwd_dst_sdpa_bwd = torch.aten.transpose.int %bwd_ds_sdpa_bwd, %scores_int2_sdpa_bwd, %scores_int3_sdpa_bwd : !torch.vtensor<[1,4,16,32],f16>, !torch.int, !torch.int -> !torch.vtensor<[1,4,32,16],f16>
+// TORCH-CHECK:       %dk_sdpa_bwd_perm = torch.aten.matmul %bwd_dst_sdpa_bwd, %q_sdpa_bwd_perm : !torch.vtensor<[1,4,32,16],f16>, !torch.vtensor<[1,4,16,64],f16> -> !torch.vtensor<[1,4,32,64],f16>
+// TORCH-CHECK:       %dq = torch.aten.permute %dq_sdpa_bwd_perm, %permute_DQ_sdpa_bwd : !torch.vtensor<[1,4,16,64],f16>, !torch.list<int> -> !torch.vtensor<[1,4,16,64],f16>
+// TORCH-CHECK:       %dk = torch.aten.permute %dk_sdpa_bwd_perm, %permute_DK_sdpa_bwd : !torch.vtensor<[1,4,32,64],f16>, !torch.list<int> -> !torch.vtensor<[1,4,32,64],f16>
+// TORCH-CHECK:       %dv = torch.aten.permute %dv_sdpa_bwd_perm, %permute_DV_sdpa_bwd : !torch.vtensor<[1,4,32,64],f16>, !torch.list<int> -> !torch.vtensor<[1,4,32,64],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dk overwrites %dk_ : !torch.vtensor<[1,4,32,64],f16>, !torch.tensor<[1,4,32,64],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dq overwrites %dq_ : !torch.vtensor<[1,4,16,64],f16>, !torch.tensor<[1,4,16,64],f16>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %dv overwrites %dv_ : !torch.vtensor<[1,4,32,64],f16>, !torch.tensor<[1,4,32,64],f16>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// BWD-CHECK-NOT:     torch.aten.softmax
+// BWD-CHECK-NOT:     torch.aten.scaled_dot_product_attention
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testSdpaBwdAsmEmitter() {
+  int64_t b = 1, h = 4, sq = 16, skv = 32, d = 64;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("sdpa_bwd_asm_emitter");
+  graph->setIODataType(DataType::Half)
+      .setIntermediateDataType(DataType::Half)
+      .setComputeDataType(DataType::Float);
+
+  auto bhsd = [&](const std::string &name, int64_t s, int64_t e) {
+    std::vector<int64_t> dim = {b, h, s, e};
+    return graph->tensor(TensorAttr().setName(name).setDim(dim).setStride(
+        generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+
+  auto q = bhsd("q", sq, d);
+  auto k = bhsd("k", skv, d);
+  auto v = bhsd("v", skv, d);
+  auto o = bhsd("o", sq, d);
+  auto dO = bhsd("d_o", sq, d);
+  auto stats = bhsd("stats", sq, 1);
+
+  auto sdpaBwdAttr = SdpaBwdAttr().setScale(0.125f).setName("sdpa_bwd");
+  auto [dq, dk, dv] = graph->sdpaBackward(q, k, v, o, dO, stats, sdpaBwdAttr);
+  dq->setName("dq").setOutput(true);
+  dk->setName("dk").setOutput(true);
+  dv->setName("dv").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testSdpaBwdAsmEmitter();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Embedding lookup of [2, 3] token ids in an [8, 4] table, and its gradient
+// accumulated into a zero table. The 2D ids are flattened for the 1D index of
+// `torch.aten.index_select` and `torch.aten.index_add`.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%dtable_: !torch.tensor<[8,4],f32>, %emb_: !torch.tensor<[2,3,4],f32>, %dy: !torch.vtensor<[2,3,4],f32>, %ids: !torch.vtensor<[2,3],si64>, %table: !torch.vtensor<[8,4],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %index_select_dim_lookup = torch.constant.int 0
+// TORCH-CHECK:       %index_select_index_lookup = torch.aten.view %ids_lookup_perm, %index_select_index_shape_lookup : !torch.vtensor<[2,3],si64>, !torch.list<int> -> !torch.vtensor<[6],si64>
+// TORCH-CHECK:       %index_select_gathered_lookup = torch.aten.index_select %table_lookup_perm, %index_select_dim_lookup, %index_select_index_lookup : !torch.vtensor<[8,4],f32>, !torch.int, !torch.vtensor<[6],si64> -> !torch.vtensor<[6,4],f32>
+// TORCH-CHECK:       %emb_lookup_perm = torch.aten.view %index_select_gathered_lookup, %index_select_y_shape_lookup : !torch.vtensor<[6,4],f32>, !torch.list<int> -> !torch.vtensor<[2,3,4],f32>
+// TORCH-CHECK:       %emb = torch.aten.permute %emb_lookup_perm, %permute_Y_lookup : !torch.vtensor<[2,3,4],f32>, !torch.list<int> -> !torch.vtensor<[2,3,4],f32>
+// TORCH-CHECK:       %index_add_dim_grad = torch.constant.int 0
+// TORCH-CHECK:       %index_add_f32_grad = torch.constant.int 6
+// TORCH-CHECK:       %index_add_base_grad = torch.aten.zeros %index_add_base_shape_grad, %index_add_f32_grad, %index_add_none_grad, %index_add_none_grad, %index_add_none_grad : !torch.list<int>, !torch.int, !torch.none, !torch.none, !torch.none -> !torch.vtensor<[8,4],f32>
+// TORCH-CHECK:       %index_add_index_grad = torch.aten.view %ids_grad_perm, %index_add_index_shape_grad : !torch.vtensor<[2,3],si64>, !torch.list<int> -> !torch.vtensor<[6],si64>
+// TORCH-CHECK:       %index_add_source_flat_grad = torch.aten.view %dy_grad_perm, %index_add_source_shape_grad : !torch.vtensor<[2,3,4],f32>, !torch.list<int> -> !torch.vtensor<[6,4],f32>
+// TORCH-CHECK:       %index_add_acc_grad = torch.aten.index_add %index_add_base_grad, %index_add_dim_grad, %index_add_index_grad, %index_add_source_grad, %index_add_alpha_grad : !torch.vtensor<[8,4],f32>, !torch.int, !torch.vtensor<[6],si64>, !torch.vtensor<[6,4],f32>, !torch.int -> !torch.vtensor<[8,4],f32>
+// TORCH-CHECK:       %dtable_grad_perm = torch.aten.to.dtype %index_add_acc_grad, %index_add_dtype_grad, %index_add_false_grad, %index_add_false_grad, %index_add_none_grad : !torch.vtensor<[8,4],f32>, !torch.int, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[8,4],f32>
+// TORCH-CHECK:       %dtable = torch.aten.permute %dtable_grad_perm, %permute_Y_grad : !torch.vtensor<[8,4],f32>, !torch.list<int> -> !torch.vtensor<[8,4],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testShapeAsmEmitterIndexSelectAdd() {
+  auto graph = std::make_shared<Graph>();
+  graph->setName("shape_asm_emitter_index_select_add");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  std::vector<int64_t> tableDim = {8, 4};
+  std::vector<int64_t> idsDim = {2, 3};
+  std::vector<int64_t> embDim = {2, 3, 4};
+  auto tableT = graph->tensor(
+      TensorAttr().setName("table").setDim(tableDim).setStride(
+          generateStrideFromDim(tableDim, getContiguousStrideOrder(2))));
+  auto idsT = graph->tensor(
+      TensorAttr().setName("ids").setDim(idsDim).setStride(
+          generateStrideFromDim(idsDim, getContiguousStrideOrder(2))));
+  auto dyT = graph->tensor(
+      TensorAttr().setName("dy").setDim(embDim).setStride(
+          generateStrideFromDim(embDim, getContiguousStrideOrder(3))));
+
+  auto indexSelectAttr = IndexSelectAttr().setName("lookup");
+  auto embT = graph->indexSelect(tableT, idsT, indexSelectAttr);
+  embT->setName("emb").setOutput(true);
+
+  auto indexAddAttr = IndexAddAttr().setSize(8).setName("grad");
+  auto dtableT = graph->indexAdd(/*x=*/nullptr, idsT, dyT, indexAddAttr);
+  dtableT->setName("dtable").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testShapeAsmEmitterIndexSelectAdd();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Splits the hidden dim of a (B, S, H * D) tensor into heads and moves them
+// before the sequence dim, as done before attention. The intermediate stays
+// in logical layout.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[2,4,8,16],f32>, %arg0_hidden: !torch.vtensor<[2,8,64],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_hidden_reshape_perm = torch.aten.permute %arg0_hidden, %permute_X_reshape : !torch.vtensor<[2,8,64],f32>, !torch.list<int> -> !torch.vtensor<[2,8,64],f32>
+// TORCH-CHECK:       %shape_val_0_reshape = torch.constant.int 2
+// TORCH-CHECK:       %shape_val_1_reshape = torch.constant.int 8
+// TORCH-CHECK:       %shape_val_2_reshape = torch.constant.int 4
+// TORCH-CHECK:       %shape_val_3_reshape = torch.constant.int 16
+// TORCH-CHECK:       %shape_reshape = torch.prim.ListConstruct %shape_val_0_reshape, %shape_val_1_reshape, %shape_val_2_reshape, %shape_val_3_reshape : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %heads_reshape_perm = torch.aten.view %arg0_hidden_reshape_perm, %shape_reshape : !torch.vtensor<[2,8,64],f32>, !torch.list<int> -> !torch.vtensor<[2,8,4,16],f32>
+// TORCH-CHECK:       %heads = torch.tensor_static_info_cast %heads_reshape_perm : !torch.vtensor<[2,8,4,16],f32> to !torch.vtensor<[2,8,4,16],f32>
+// TORCH-CHECK:       %heads_permute_perm = torch.tensor_static_info_cast %heads : !torch.vtensor<[2,8,4,16],f32> to !torch.vtensor<[2,8,4,16],f32>
+// TORCH-CHECK:       %order_val_0_permute = torch.constant.int 0
+// TORCH-CHECK:       %order_val_1_permute = torch.constant.int 2
+// TORCH-CHECK:       %order_val_2_permute = torch.constant.int 1
+// TORCH-CHECK:       %order_val_3_permute = torch.constant.int 3
+// TORCH-CHECK:       %order_permute = torch.prim.ListConstruct %order_val_0_permute, %order_val_1_permute, %order_val_2_permute, %order_val_3_permute : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+// TORCH-CHECK:       %result_permute_perm = torch.aten.permute %heads_permute_perm, %order_permute : !torch.vtensor<[2,8,4,16],f32>, !torch.list<int> -> !torch.vtensor<[2,4,8,16],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_permute_perm, %permute_Y_permute : !torch.vtensor<[2,4,8,16],f32>, !torch.list<int> -> !torch.vtensor<[2,4,8,16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[2,4,8,16],f32>, !torch.tensor<[2,4,8,16],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testShapeAsmEmitterReshapePermute() {
+  int64_t b = 2, s = 8, h = 4, d = 16;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("shape_asm_emitter_reshape_permute");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_hidden")
+                              .setDim({b, s, h * d})
+                              .setStride({s * h * d, h * d, 1}));
+
+  auto reshapeAttr = ReshapeAttr().setShape({b, s, h, -1}).setName("reshape");
+  auto headsT = graph->reshape(xT, reshapeAttr);
+  headsT->setName("heads");
+
+  auto permuteAttr = PermuteAttr().setOrder({0, 2, 1, 3}).setName("permute");
+  graph->permute(headsT, permuteAttr)->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testShapeAsmEmitterReshapePermute();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
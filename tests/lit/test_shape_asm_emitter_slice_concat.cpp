@@ -0,0 +1,89 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Slices the first half of the columns of X (every other row) and
+// concatenates it with itself along the columns. The same tensor feeds both
+// concat operands.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[4,16],f32>, %arg0_x: !torch.vtensor<[8,16],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_x_slice_perm = torch.aten.permute %arg0_x, %permute_X_slice : !torch.vtensor<[8,16],f32>, !torch.list<int> -> !torch.vtensor<[8,16],f32>
+// TORCH-CHECK:       %slice_dim_0_slice = torch.constant.int 0
+// TORCH-CHECK:       %slice_start_0_slice = torch.constant.int 0
+// TORCH-CHECK:       %slice_end_0_slice = torch.constant.int 8
+// TORCH-CHECK:       %slice_step_0_slice = torch.constant.int 2
+// TORCH-CHECK:       %slice_0_slice = torch.aten.slice.Tensor %arg0_x_slice_perm, %slice_dim_0_slice, %slice_start_0_slice, %slice_end_0_slice, %slice_step_0_slice : !torch.vtensor<[8,16],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %slice_dim_1_slice = torch.constant.int 1
+// TORCH-CHECK:       %slice_start_1_slice = torch.constant.int 0
+// TORCH-CHECK:       %slice_end_1_slice = torch.constant.int 8
+// TORCH-CHECK:       %slice_step_1_slice = torch.constant.int 1
+// TORCH-CHECK:       %half_slice_perm = torch.aten.slice.Tensor %slice_0_slice, %slice_dim_1_slice, %slice_start_1_slice, %slice_end_1_slice, %slice_step_1_slice : !torch.vtensor<[4,16],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %half = torch.tensor_static_info_cast %half_slice_perm : !torch.vtensor<[4,8],f32> to !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %half_concat_i0_perm = torch.tensor_static_info_cast %half : !torch.vtensor<[4,8],f32> to !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %half_concat_i1_perm = torch.tensor_static_info_cast %half : !torch.vtensor<[4,8],f32> to !torch.vtensor<[4,8],f32>
+// TORCH-CHECK:       %concat_list_concat = torch.prim.ListConstruct %half_concat_i0_perm, %half_concat_i1_perm : (!torch.vtensor<[4,8],f32>, !torch.vtensor<[4,8],f32>) -> !torch.list<vtensor>
+// TORCH-CHECK:       %dim_concat = torch.constant.int 1
+// TORCH-CHECK:       %result_concat_perm = torch.aten.cat %concat_list_concat, %dim_concat : !torch.list<vtensor>, !torch.int -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_concat_perm, %permute_Y_concat : !torch.vtensor<[4,16],f32>, !torch.list<int> -> !torch.vtensor<[4,16],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[4,16],f32>, !torch.tensor<[4,16],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+using namespace fusilli;
+
+static ErrorObject testShapeAsmEmitterSliceConcat() {
+  int64_t m = 8, n = 16;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("shape_asm_emitter_slice_concat");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(
+      TensorAttr().setName("arg0_x").setDim({m, n}).setStride({n, 1}));
+
+  auto sliceAttr = SliceAttr()
+                       .setStart({0, 0})
+                       .setEnd({m, n / 2})
+                       .setStep({2, 1})
+                       .setName("slice");
+  auto halfT = graph->slice(xT, sliceAttr);
+  halfT->setName("half");
+
+  auto concatAttr = ConcatAttr().setAxis(1).setName("concat");
+  graph->concat({halfT, halfT}, concatAttr)->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testShapeAsmEmitterSliceConcat();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
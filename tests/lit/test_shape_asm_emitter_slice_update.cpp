@@ -0,0 +1,87 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+
+// Appends the K of a decode step to a KV cache at a runtime position, clamped
+// so the new K always lands within the cache. The result is written in-place
+// into the cache, which is a mutable argument overwritten at the end of the
+// function.
+//
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%k_cache_: !torch.tensor<[1,2,8,4],f32>, %k_new: !torch.vtensor<[1,2,1,4],f32>, %pos: !torch.vtensor<[1],si64>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %k_cache = torch.copy.to_vtensor %k_cache_ : !torch.vtensor<[1,2,8,4],f32>
+// TORCH-CHECK:       %k_cache_append_perm = torch.aten.permute %k_cache, %permute_X_append : !torch.vtensor<[1,2,8,4],f32>, !torch.list<int> -> !torch.vtensor<[1,2,8,4],f32>
+// TORCH-CHECK:       %k_new_append_perm = torch.aten.permute %k_new, %permute_UPDATE_append : !torch.vtensor<[1,2,1,4],f32>, !torch.list<int> -> !torch.vtensor<[1,2,1,4],f32>
+// TORCH-CHECK:       %pos_append_perm = torch.aten.permute %pos, %permute_START_append : !torch.vtensor<[1],si64>, !torch.list<int> -> !torch.vtensor<[1],si64>
+// TORCH-CHECK:       %slice_update_dim_append = torch.constant.int 2
+// TORCH-CHECK:       %slice_update_offset_append = torch.aten.item %pos_append_perm : !torch.vtensor<[1],si64> -> !torch.int
+// TORCH-CHECK:       %slice_update_first_append = torch.constant.int 0
+// TORCH-CHECK:       %slice_update_last_append = torch.constant.int 7
+// TORCH-CHECK:       %slice_update_nonneg_append = torch.prim.max.int %slice_update_offset_append, %slice_update_first_append : !torch.int, !torch.int -> !torch.int
+// TORCH-CHECK:       %slice_update_start_append = torch.prim.min.int %slice_update_nonneg_append, %slice_update_last_append : !torch.int, !torch.int -> !torch.int
+// TORCH-CHECK:       %slice_update_len_append = torch.constant.int 1
+// TORCH-CHECK:       %slice_update_end_append = torch.aten.add.int %slice_update_start_append, %slice_update_len_append : !torch.int, !torch.int -> !torch.int
+// TORCH-CHECK:       %slice_update_step_append = torch.constant.int 1
+// TORCH-CHECK:       %k_cache_out_append_perm = torch.aten.slice_scatter %k_cache_append_perm, %k_new_append_perm, %slice_update_dim_append, %slice_update_start_append, %slice_update_end_append, %slice_update_step_append : !torch.vtensor<[1,2,8,4],f32>, !torch.vtensor<[1,2,1,4],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[1,2,8,4],f32>
+// TORCH-CHECK:       %k_cache_out = torch.aten.permute %k_cache_out_append_perm, %permute_Y_append : !torch.vtensor<[1,2,8,4],f32>, !torch.list<int> -> !torch.vtensor<[1,2,8,4],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %k_cache_out overwrites %k_cache_ : !torch.vtensor<[1,2,8,4],f32>, !torch.tensor<[1,2,8,4],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject testShapeAsmEmitterSliceUpdate() {
+  auto graph = std::make_shared<Graph>();
+  graph->setName("shape_asm_emitter_slice_update");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  std::vector<int64_t> cacheDim = {1, 2, 8, 4};
+  std::vector<int64_t> newDim = {1, 2, 1, 4};
+  auto cacheT = graph->tensor(
+      TensorAttr().setName("k_cache").setDim(cacheDim).setStride(
+          generateStrideFromDim(cacheDim, getContiguousStrideOrder(4))));
+  auto newT = graph->tensor(
+      TensorAttr().setName("k_new").setDim(newDim).setStride(
+          generateStrideFromDim(newDim, getContiguousStrideOrder(4))));
+  auto posT = graph->tensor(TensorAttr().setName("pos"));
+
+  auto sliceUpdateAttr = SliceUpdateAttr().setAxis(2).setName("append");
+  auto yT = graph->sliceUpdate(cacheT, newT, posT, sliceUpdateAttr);
+  yT->setName("k_cache_out").setOutput(true).setInPlace(cacheT);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+  FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+  std::cout << generatedAsm << std::endl;
+
+  return ok();
+}
+
+int main() {
+  auto status = testShapeAsmEmitterSliceUpdate();
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
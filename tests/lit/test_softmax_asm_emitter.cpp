@@ -0,0 +1,86 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: %{TEST_EXE} | iree-opt --verify-roundtrip
+// RUN: %{TEST_EXE} | FileCheck %s --check-prefix=TORCH-CHECK
+// RUN: %{TEST_EXE} stats | FileCheck %s --check-prefix=%{BACKEND}-STATS-CHECK
+
+// clang-format off
+//
+// TORCH-CHECK:   module @module {
+// TORCH-CHECK:     func.func @main(%result_: !torch.tensor<[4,16,128],f32>, %arg0_input: !torch.vtensor<[4,16,128],f32>) attributes {torch.assume_strict_symbolic_shapes} {
+// TORCH-CHECK:       %arg0_input_softmax_perm = torch.aten.permute %arg0_input, %permute_X_softmax : !torch.vtensor<[4,16,128],f32>, !torch.list<int> -> !torch.vtensor<[4,16,128],f32>
+// TORCH-CHECK:       %dim_softmax = torch.constant.int 2
+// TORCH-CHECK:       %dtype_softmax = torch.constant.int 6
+// TORCH-CHECK:       %result_softmax_perm = torch.aten.softmax.int %arg0_input_softmax_perm, %dim_softmax, %dtype_softmax : !torch.vtensor<[4,16,128],f32>, !torch.int, !torch.int -> !torch.vtensor<[4,16,128],f32>
+// TORCH-CHECK:       %result = torch.aten.permute %result_softmax_perm, %permute_Y_softmax : !torch.vtensor<[4,16,128],f32>, !torch.list<int> -> !torch.vtensor<[4,16,128],f32>
+// TORCH-CHECK:       torch.overwrite.tensor.contents %result overwrites %result_ : !torch.vtensor<[4,16,128],f32>, !torch.tensor<[4,16,128],f32>
+// TORCH-CHECK:       return
+// TORCH-CHECK:     }
+// TORCH-CHECK:   }
+//
+// AMDGPU-STATS-CHECK: "dispatch-count": 1
+// CPU-STATS-CHECK: "dispatch-count": 1
+//
+// clang-format on
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static ErrorObject testSoftmaxAsmEmitter(const std::string &mode) {
+  int64_t b = 4, h = 16, n = 128;
+  auto graph = std::make_shared<Graph>();
+  graph->setName("softmax_asm_emitter");
+  graph->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto xT = graph->tensor(TensorAttr()
+                              .setName("arg0_input")
+                              .setDim({b, h, n})
+                              .setStride({h * n, n, 1}));
+
+  auto softmaxAttr = SoftmaxAttr().setName("softmax");
+
+  auto yT = graph->softmax(xT, /*mask=*/nullptr, softmaxAttr);
+
+  yT->setName("result").setOutput(true);
+
+  FUSILLI_CHECK_ERROR(graph->validate());
+
+  if (mode == "default") {
+    FUSILLI_ASSIGN_OR_RETURN(auto generatedAsm, graph->emitAsm());
+    FUSILLI_CHECK_ERROR(checkMlirIndentation(generatedAsm));
+    std::cout << generatedAsm << std::endl;
+  }
+
+  if (mode == "stats") {
+    FUSILLI_ASSIGN_OR_RETURN(Handle handle, Handle::create(kDefaultBackend));
+    FUSILLI_CHECK_ERROR(graph->compile(handle, /*remove=*/true));
+    FUSILLI_ASSIGN_OR_RETURN(auto stats, graph->readCompilationCacheFile(
+                                             CachedAssetsType::Statistics));
+    std::cout << stats << std::endl;
+  }
+
+  return ok();
+}
+
+int main(int argc, char **argv) {
+  std::string mode = (argc > 1) ? argv[1] : "default";
+
+  auto status = testSoftmaxAsmEmitter(mode);
+  if (isError(status)) {
+    std::cerr << "Test failed: " << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_artifact_bundle";
+
+static Graph testAddGraph(const std::string &name, int64_t size) {
+  Graph graph;
+  graph.setName(name);
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto a =
+      graph.tensor(TensorAttr().setName("a").setDim({size}).setStride({1}));
+  auto b =
+      graph.tensor(TensorAttr().setName("b").setDim({size}).setStride({1}));
+  auto c = graph.pointwise(a, b,
+                           PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  c->setName("c").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  return graph;
+}
+
+TEST_CASE("ArtifactBundle round trips artifacts by graph structure",
+          "[ArtifactBundle]") {
+  std::filesystem::path path = CacheFile::getPath(kGraphName, "bundle");
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(path.parent_path()); });
+
+  // Artifacts are opaque to the bundle, so placeholders suffice.
+  Graph small = testAddGraph("small", 4);
+  Graph large = testAddGraph("large", 8);
+  std::vector<uint8_t> smallCpu = {1, 2, 3};
+  std::vector<uint8_t> largeCpu = {4, 5, 6, 7};
+  std::vector<uint8_t> smallGpu = {8};
+
+  ArtifactBundleWriter writer;
+  FUSILLI_REQUIRE_OK(writer.add(small, Backend::CPU, smallCpu));
+  FUSILLI_REQUIRE_OK(writer.add(large, Backend::CPU, largeCpu));
+  FUSILLI_REQUIRE_OK(writer.add(small, Backend::AMDGPU, smallGpu));
+  REQUIRE(writer.size() == 3);
+
+  // Graphs with the same structure and backend share an entry.
+  ErrorObject status =
+      writer.add(testAddGraph("renamed", 4), Backend::CPU, smallCpu);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+  FUSILLI_REQUIRE_OK(writer.write(path));
+
+  FUSILLI_REQUIRE_ASSIGN(ArtifactBundle bundle, ArtifactBundle::open(path));
+  REQUIRE(bundle.size() == 3);
+
+  auto bytes = [](std::optional<std::span<const uint8_t>> view) {
+    REQUIRE(view.has_value());
+    // Artifacts are aligned within the mapping.
+    REQUIRE(reinterpret_cast<uintptr_t>(view->data()) %
+                kArtifactBundleAlignment ==
+            0);
+    return std::vector<uint8_t>(view->begin(), view->end());
+  };
+  FUSILLI_REQUIRE_ASSIGN(auto found,
+                         bundle.find(testAddGraph("other", 4), Backend::CPU));
+  REQUIRE(bytes(found) == smallCpu);
+  FUSILLI_REQUIRE_ASSIGN(found, bundle.find(large, Backend::CPU));
+  REQUIRE(bytes(found) == largeCpu);
+  FUSILLI_REQUIRE_ASSIGN(found, bundle.find(small, Backend::AMDGPU));
+  REQUIRE(bytes(found) == smallGpu);
+  FUSILLI_REQUIRE_ASSIGN(found, bundle.find(large, Backend::AMDGPU));
+  REQUIRE(!found.has_value());
+}
+
+TEST_CASE("ArtifactBundle holds AMDGPU artifacts per ROCm target",
+          "[ArtifactBundle]") {
+  std::filesystem::path path = CacheFile::getPath(kGraphName, "targets");
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(path.parent_path()); });
+
+  Graph graph = testAddGraph("targets", 4);
+  std::vector<uint8_t> gfx942 = {1, 2};
+  std::vector<uint8_t> gfx90a = {3, 4, 5};
+  std::vector<uint8_t> mi300x = {6};
+
+  ArtifactBundleWriter writer;
+  FUSILLI_REQUIRE_OK(writer.add(graph, Backend::AMDGPU, gfx942, "gfx942"));
+  FUSILLI_REQUIRE_OK(writer.add(graph, Backend::AMDGPU, gfx90a, "gfx90a"));
+  FUSILLI_REQUIRE_OK(writer.add(graph, Backend::AMDGPU, mi300x, "mi300x"));
+  ErrorObject status = writer.add(graph, Backend::AMDGPU, gfx942, "gfx942");
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+  FUSILLI_REQUIRE_OK(writer.write(path));
+
+  FUSILLI_REQUIRE_ASSIGN(ArtifactBundle bundle, ArtifactBundle::open(path));
+  REQUIRE(bundle.size() == 3);
+  for (const auto &[target, vmfb] :
+       {std::pair{"gfx942", gfx942}, std::pair{"gfx90a", gfx90a},
+        std::pair{"mi300x", mi300x}}) {
+    FUSILLI_REQUIRE_ASSIGN(auto found,
+                           bundle.find(graph, Backend::AMDGPU, target));
+    REQUIRE(found.has_value());
+    REQUIRE(std::vector<uint8_t>(found->begin(), found->end()) == vmfb);
+  }
+
+  // Targets are not interchangeable.
+  FUSILLI_REQUIRE_ASSIGN(auto found,
+                         bundle.find(graph, Backend::AMDGPU, "gfx1100"));
+  REQUIRE(!found.has_value());
+  FUSILLI_REQUIRE_ASSIGN(found, bundle.find(graph, Backend::AMDGPU));
+  REQUIRE(!found.has_value());
+}
+
+TEST_CASE("ArtifactBundle stores compressed artifacts", "[ArtifactBundle]") {
+  if (!isArtifactCompressionAvailable())
+    return;
+  std::filesystem::path path = CacheFile::getPath(kGraphName, "compressed");
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(path.parent_path()); });
+
+  Graph graph = testAddGraph("compressed", 4);
+  std::vector<uint8_t> vmfb(4096, 7);
+  ArtifactBundleWriter writer;
+  writer.setCompressionLevel(3);
+  FUSILLI_REQUIRE_OK(writer.add(graph, Backend::CPU, vmfb));
+  FUSILLI_REQUIRE_OK(writer.write(path));
+
+  FUSILLI_REQUIRE_ASSIGN(ArtifactBundle bundle, ArtifactBundle::open(path));
+  FUSILLI_REQUIRE_ASSIGN(auto found, bundle.find(graph, Backend::CPU));
+  REQUIRE(found.has_value());
+  REQUIRE(isCompressedArtifact(*found));
+  REQUIRE(found->size() < vmfb.size());
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> decompressed,
+                         decompressArtifact(*found));
+  REQUIRE(decompressed == vmfb);
+}
+
+TEST_CASE("ArtifactBundle::open rejects invalid files", "[ArtifactBundle]") {
+  auto cleanup = ScopeExit([&] {
+    std::filesystem::remove_all(
+        CacheFile::getPath(kGraphName, "a").parent_path());
+  });
+
+  ErrorOr<ArtifactBundle> missing =
+      ArtifactBundle::open(CacheFile::getPath(kGraphName, "missing"));
+  REQUIRE(isError(missing));
+  REQUIRE(ErrorObject(missing).getCode() == ErrorCode::FileSystemFailure);
+
+  FUSILLI_REQUIRE_ASSIGN(CacheFile file,
+                         CacheFile::create(kGraphName, "invalid",
+                                           /*remove=*/true));
+  for (const std::string &contents :
+       {std::string(), std::string("FUSILLIB"), std::string(64, 'x')}) {
+    FUSILLI_REQUIRE_OK(file.write(contents));
+    ErrorOr<ArtifactBundle> bundle = ArtifactBundle::open(file.path);
+    REQUIRE(isError(bundle));
+    REQUIRE(ErrorObject(bundle).getCode() == ErrorCode::InvalidArgument);
+  }
+}
@@ -270,6 +270,30 @@ TEST_CASE("getIreeRocmTargetForAmdgpu prefers SKU over architecture",
   // If marketing name is empty or unrecognized, we can't verify this
 }
 
+TEST_CASE("getIreeRocmTargetForAmdgpu is cached per device",
+          "[backend][rocm-target]") {
+  // Repeated lookups return the detected target of the device without
+  // querying the GPU again.
+  REQUIRE(getIreeRocmTargetForAmdgpu(0) == getIreeRocmTargetForAmdgpu());
+  REQUIRE(getIreeRocmTargetForAmdgpu(0) == getIreeRocmTargetForAmdgpu(0));
+}
+
+//===----------------------------------------------------------------------===//
+// Tests for getGpuInfoFromHipRuntime
+//
+// NOTE: These tests require the HIP runtime (libamdhip64) to be loadable.
+//===----------------------------------------------------------------------===//
+
+TEST_CASE("getGpuInfoFromHipRuntime returns valid info or empty",
+          "[backend][hip]") {
+  // On systems without the HIP runtime or a GPU, both fields are empty.
+  GpuInfo info = getGpuInfoFromHipRuntime(0);
+  REQUIRE(info.arch != "gfx000");
+  if (!info.arch.empty())
+    REQUIRE(info.arch.find("gfx") == 0);
+  REQUIRE(info.arch.find(':') == std::string::npos);
+}
+
 //===----------------------------------------------------------------------===//
 // Tests for getArchFromRocmAgentEnumerator
 //
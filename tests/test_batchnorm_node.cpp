@@ -11,6 +11,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -434,3 +435,96 @@ TEST_CASE("BatchNormNode postValidateNode validates output shapes",
     FUSILLI_REQUIRE_OK(node.postValidateNode());
   }
 }
+
+TEST_CASE("BatchNormBwdNode validation and gradient inference",
+          "[batchnorm_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  int64_t n = 2, c = 3, h = 4, w = 5;
+  auto tensor = [](const std::string &name, const std::vector<int64_t> &dim) {
+    return std::make_shared<TensorAttr>(
+        TensorAttr().setName(name).setDim(dim).setStride(
+            generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+
+  BatchnormBwdAttr attr;
+  attr.setName("batchnorm_bwd");
+  attr.setDY(tensor("DY", {n, c, h, w}));
+  attr.setX(tensor("X", {n, c, h, w}));
+  attr.setY(tensor("Y", {n, c, h, w}));
+  attr.setSCALE(std::make_shared<TensorAttr>());
+  attr.setSAVED_MEAN(std::make_shared<TensorAttr>());
+  attr.setSAVED_INV_VARIANCE(std::make_shared<TensorAttr>());
+  attr.setDX(std::make_shared<TensorAttr>());
+  attr.setDSCALE(std::make_shared<TensorAttr>());
+  attr.setDBIAS(std::make_shared<TensorAttr>());
+
+  SECTION("Gradients take the shapes of X and the channel dimension") {
+    BatchNormBwdNode node(std::move(attr), ctx);
+    REQUIRE(node.getType() == INode::Type::BatchNormBwd);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    const BatchnormBwdAttr &bwdAttr = node.batchnormBwdAttr;
+    REQUIRE(bwdAttr.getDX()->getDim() == std::vector<int64_t>{n, c, h, w});
+    REQUIRE(bwdAttr.getDX()->getStride() == bwdAttr.getX()->getStride());
+    for (const auto &t : {bwdAttr.getSCALE(), bwdAttr.getSAVED_MEAN(),
+                          bwdAttr.getSAVED_INV_VARIANCE(),
+                          bwdAttr.getDSCALE(), bwdAttr.getDBIAS()}) {
+      REQUIRE(t->getDim() == std::vector<int64_t>{c});
+      REQUIRE(t->getStride() == std::vector<int64_t>{1});
+    }
+    REQUIRE(bwdAttr.getDX()->getDataType() == DataType::Half);
+  }
+
+  SECTION("SCALE without DBIAS") {
+    attr.setDBIAS(nullptr);
+    BatchNormBwdNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "BatchNorm backward SCALE, DSCALE and "
+                                   "DBIAS tensors must be set together");
+  }
+
+  SECTION("SAVED_MEAN missing") {
+    attr.setSAVED_MEAN(nullptr);
+    BatchNormBwdNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "BatchNorm backward input tensor SAVED_MEAN not set");
+  }
+
+  SECTION("Y must match X") {
+    attr.setY(tensor("Y", {n, c, h, w + 1}));
+    BatchNormBwdNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "BatchNorm backward input tensor Y must have the same shape as "
+            "input X tensor");
+  }
+
+  SECTION("SAVED_INV_VARIANCE must be 1D over channels") {
+    attr.setSAVED_INV_VARIANCE(tensor("SAVED_INV_VARIANCE", {1, c, 1, 1}));
+    BatchNormBwdNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "BatchNorm backward tensor SAVED_INV_VARIANCE must be 1D with size "
+            "equal to channel dimension C");
+  }
+}
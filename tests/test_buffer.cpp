@@ -12,6 +12,11 @@
 #include <iree/hal/api.h>
 
 #include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -255,3 +260,474 @@ TEST_CASE("Buffer::allocateRaw errors", "[buffer]") {
             "Buffer::allocateRaw failed: cannot allocate zero-size buffer");
   }
 }
+
+TEST_CASE("Buffer allocation with the caching allocator", "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  REQUIRE_FALSE(handle.isCachingAllocatorEnabled());
+  handle.enableCachingAllocator();
+  REQUIRE(handle.isCachingAllocatorEnabled());
+
+  {
+    std::vector<float> data(100, 1.0f); // 400 bytes -> 512 byte size class
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocate(handle, castToSizeT({100}), data));
+    AllocatorStats stats = handle.getAllocatorStats();
+    REQUIRE(stats.allocations == 1);
+    REQUIRE(stats.cacheHits == 0);
+    REQUIRE(stats.bytesReserved == 512);
+    REQUIRE(stats.bytesCached == 0);
+  }
+  REQUIRE(handle.getAllocatorStats().bytesCached == 512);
+
+  // A buffer of the same size class reuses the cached device memory, and
+  // views only its requested size.
+  {
+    std::vector<float> data(120, 2.0f);
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocate(handle, castToSizeT({120}), data));
+    REQUIRE(iree_hal_buffer_view_byte_length(buf) == 480);
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(buf.read(handle, result));
+    REQUIRE(result == data);
+
+    // Raw buffers share the free lists with typed ones.
+    FUSILLI_REQUIRE_ASSIGN(Buffer raw, Buffer::allocateRaw(handle, 300));
+    REQUIRE(iree_hal_buffer_view_byte_length(raw) == 300);
+
+    AllocatorStats stats = handle.getAllocatorStats();
+    REQUIRE(stats.allocations == 3);
+    REQUIRE(stats.cacheHits == 1);
+    REQUIRE(stats.bytesReserved == 1024);
+    REQUIRE(stats.bytesCached == 0);
+  }
+  REQUIRE(handle.getAllocatorStats().bytesCached == 1024);
+
+  handle.trimCachingAllocator();
+  AllocatorStats stats = handle.getAllocatorStats();
+  REQUIRE(stats.bytesReserved == 0);
+  REQUIRE(stats.bytesCached == 0);
+}
+
+TEST_CASE("Buffer allocations are accounted in Handle::getMemoryStats",
+          "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  MemoryStats stats = handle.getMemoryStats();
+  REQUIRE(stats.total.liveBytes == 0);
+
+  {
+    std::vector<float> data(100, 1.0f); // 400 bytes
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocate(handle, castToSizeT({100}), data));
+    FUSILLI_REQUIRE_ASSIGN(Buffer raw, Buffer::allocateRaw(handle, 300));
+    stats = handle.getMemoryStats();
+    REQUIRE(stats.buffers.liveBytes == 400);
+    REQUIRE(stats.workspace.liveBytes == 300);
+    REQUIRE(stats.total.liveBytes == 700);
+
+    // Subviews share the memory of their buffer.
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer view, raw.subview(64, castToSizeT({16}), DataType::Float));
+    REQUIRE(handle.getMemoryStats().total.liveBytes == 700);
+  }
+  stats = handle.getMemoryStats();
+  REQUIRE(stats.buffers.liveBytes == 0);
+  REQUIRE(stats.workspace.liveBytes == 0);
+  REQUIRE(stats.total.liveBytes == 0);
+  REQUIRE(stats.buffers.peakBytes == 400);
+  REQUIRE(stats.workspace.peakBytes == 300);
+  REQUIRE(stats.total.peakBytes == 700);
+
+  // Peaks restart from the live bytes.
+  {
+    std::vector<float> data(50, 1.0f); // 200 bytes
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocate(handle, castToSizeT({50}), data));
+    handle.resetPeakMemoryStats();
+    stats = handle.getMemoryStats();
+    REQUIRE(stats.buffers.peakBytes == 200);
+    REQUIRE(stats.workspace.peakBytes == 0);
+    REQUIRE(stats.total.peakBytes == 200);
+  }
+  handle.resetPeakMemoryStats();
+  REQUIRE(handle.getMemoryStats().total.peakBytes == 0);
+
+  // Buffers from the caching allocator count their size class while in use.
+  handle.enableCachingAllocator();
+  {
+    std::vector<float> data(100, 1.0f); // 400 bytes -> 512 byte size class
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocate(handle, castToSizeT({100}), data));
+    REQUIRE(handle.getMemoryStats().buffers.liveBytes == 512);
+  }
+  REQUIRE(handle.getMemoryStats().buffers.liveBytes == 0);
+  REQUIRE(handle.getAllocatorStats().bytesCached == 512);
+}
+
+TEST_CASE("Buffer::allocateUninitialized and Buffer::allocateFilled",
+          "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  SECTION("Uninitialized") {
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocateUninitialized(
+                               handle, castToSizeT({4, 8}), DataType::Half));
+    iree_hal_buffer_view_t *bufferView = buf;
+    REQUIRE(iree_hal_buffer_view_element_type(bufferView) ==
+            IREE_HAL_ELEMENT_TYPE_FLOAT_16);
+    REQUIRE(iree_hal_buffer_view_byte_length(bufferView) == 64);
+  }
+
+  SECTION("Filled float") {
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer buf, Buffer::allocateFilled(handle, castToSizeT({3, 5}),
+                                           DataType::Float, 2.5));
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(buf.read(handle, result));
+    REQUIRE(result == std::vector<float>(15, 2.5f));
+  }
+
+  SECTION("Filled int8") {
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocateFilled(handle, castToSizeT({7}),
+                                                  DataType::Int8, -3));
+    std::vector<int8_t> result;
+    FUSILLI_REQUIRE_OK(buf.read(handle, result));
+    REQUIRE(result == std::vector<int8_t>(7, -3));
+  }
+
+  SECTION("Filled int4") {
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocateFilled(handle, castToSizeT({2, 4}),
+                                                  DataType::Int4, -2));
+    std::vector<int4> result;
+    FUSILLI_REQUIRE_OK(buf.read(handle, result));
+    REQUIRE(result.size() == 8);
+    for (int4 val : result)
+      REQUIRE(val.toInt() == -2);
+  }
+
+  SECTION("Errors") {
+    ErrorOr<Buffer> empty = Buffer::allocateUninitialized(
+        handle, castToSizeT({0}), DataType::Float);
+    REQUIRE(isError(empty));
+    ErrorOr<Buffer> wide = Buffer::allocateFilled(handle, castToSizeT({4}),
+                                                  DataType::Int64, 1);
+    REQUIRE(isError(wide));
+    REQUIRE(ErrorObject(wide).getCode() == ErrorCode::NotImplemented);
+  }
+}
+
+TEST_CASE("Buffer::allocateFromFile", "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_ASSIGN(CacheFile file,
+                         CacheFile::create("test_buffer", "weights.bin",
+                                           /*remove=*/true));
+  auto cleanup = ScopeExit(
+      [&] { std::filesystem::remove_all(file.path.parent_path()); });
+
+  // A header of 8 bytes followed by 2x3 floats.
+  std::vector<float> weights = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::string contents(8, 'h');
+  contents.append(reinterpret_cast<const char *>(weights.data()),
+                  weights.size() * sizeof(float));
+  FUSILLI_REQUIRE_OK(file.write(contents));
+
+  FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                         Buffer::allocateFromFile(handle, file.path,
+                                                  /*offset=*/8,
+                                                  castToSizeT({2, 3}),
+                                                  DataType::Float));
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(buf.read(handle, result));
+  REQUIRE(result == weights);
+
+  // The region must lie within the file.
+  ErrorOr<Buffer> past = Buffer::allocateFromFile(
+      handle, file.path, /*offset=*/12, castToSizeT({2, 3}), DataType::Float);
+  REQUIRE(isError(past));
+  REQUIRE(ErrorObject(past).getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("Buffer::readAsync and Buffer::writeAsync", "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                         Buffer::allocateUninitialized(
+                             handle, castToSizeT({2, 8}), DataType::Float));
+
+  std::vector<float> input(16);
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = float(i);
+  FUSILLI_REQUIRE_ASSIGN(HostTransfer upload,
+                         buf.writeAsync(handle, std::span(input)));
+
+  // The download is ordered after the upload on the device.
+  std::vector<float> output(16, -1.0f);
+  FUSILLI_REQUIRE_ASSIGN(
+      HostTransfer download,
+      buf.readAsync(handle, std::span(output), upload.getFence()));
+  FUSILLI_REQUIRE_OK(download.wait());
+  REQUIRE(output == input);
+  FUSILLI_REQUIRE_ASSIGN(bool ready, upload.isReady());
+  REQUIRE(ready);
+  FUSILLI_REQUIRE_OK(upload.wait());
+
+  // A transfer must cover the whole buffer.
+  std::vector<float> tooSmall(4);
+  ErrorOr<HostTransfer> mismatched =
+      buf.readAsync(handle, std::span(tooSmall));
+  REQUIRE(isError(mismatched));
+  REQUIRE(ErrorObject(mismatched).getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("Buffer::allocateAsync and Buffer::deallocateAsync", "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_ASSIGN(
+      QueueAllocation allocation,
+      Buffer::allocateAsync(handle, castToSizeT({2, 8}), DataType::Float));
+  Buffer &buf = allocation.buffer;
+  REQUIRE(handle.getMemoryStats().buffers.liveBytes == 64);
+
+  // Work on the buffer is ordered after its allocation on the device.
+  std::vector<float> input(16);
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = float(i);
+  FUSILLI_REQUIRE_ASSIGN(
+      HostTransfer upload,
+      buf.writeAsync(handle, std::span(input), allocation.readyFence));
+  std::vector<float> output(16, -1.0f);
+  FUSILLI_REQUIRE_ASSIGN(
+      HostTransfer download,
+      buf.readAsync(handle, std::span(output), upload.getFence()));
+
+  // So is its deallocation after the last use.
+  FUSILLI_REQUIRE_ASSIGN(Fence released,
+                         buf.deallocateAsync(handle, download.getFence()));
+  FUSILLI_REQUIRE_OK(download.wait());
+  REQUIRE(output == input);
+  FUSILLI_REQUIRE_OK(released.wait());
+  REQUIRE(handle.getMemoryStats().buffers.liveBytes == 0);
+
+  // The buffer is empty once deallocated, and allocations can't be empty.
+  REQUIRE(isError(buf.deallocateAsync(handle)));
+  REQUIRE(isError(Buffer::allocateAsync(handle, castToSizeT({0, 8}),
+                                        DataType::Float)));
+}
+
+TEST_CASE("Buffer::read into caller-owned memory", "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+
+  std::vector<float> data = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                         Buffer::allocate(handle, castToSizeT({2, 3}), data));
+
+  // The same storage is reused across reads.
+  std::vector<float> out(6, 0.0f);
+  for (int i = 0; i < 2; ++i) {
+    FUSILLI_REQUIRE_OK(buf.read(handle, std::span(out)));
+    REQUIRE(out == data);
+  }
+
+  std::vector<float> raw(6, 0.0f);
+  FUSILLI_REQUIRE_OK(buf.readBytes(handle, raw.data(), 6 * sizeof(float)));
+  REQUIRE(raw == data);
+
+  // Sub-byte element types are unpacked into the span.
+  std::vector<int4> int4Data = {int4(1), int4(-2), int4(3), int4(-4)};
+  FUSILLI_REQUIRE_ASSIGN(
+      Buffer int4Buf, Buffer::allocate(handle, castToSizeT({4}), int4Data));
+  std::vector<int4> int4Out(4);
+  FUSILLI_REQUIRE_OK(int4Buf.read(handle, std::span(int4Out)));
+  for (size_t i = 0; i < int4Data.size(); ++i)
+    REQUIRE(int4Out[i].toInt() == int4Data[i].toInt());
+
+  // Sizes must match the buffer.
+  std::vector<float> tooSmall(5);
+  ErrorObject spanStatus = buf.read(handle, std::span(tooSmall));
+  REQUIRE(isError(spanStatus));
+  REQUIRE(spanStatus.getCode() == ErrorCode::InvalidArgument);
+  ErrorObject bytesStatus = buf.readBytes(handle, raw.data(), 4);
+  REQUIRE(isError(bytesStatus));
+  REQUIRE(bytesStatus.getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("Buffer::subview shares one allocation", "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  handle.enableCachingAllocator();
+
+  // Two tensors packed into one upload: 16 floats, then 32 halves at a
+  // 64 byte aligned offset.
+  std::vector<float> packed(32, 0.0f);
+  for (size_t i = 0; i < 16; ++i)
+    packed[i] = float(i);
+  std::shared_ptr<Buffer> parent;
+  {
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer buf, Buffer::allocate(handle, castToSizeT({32}), packed));
+    parent = std::make_shared<Buffer>(std::move(buf));
+  }
+  FUSILLI_REQUIRE_ASSIGN(
+      Buffer first, parent->subview(0, castToSizeT({4, 4}), DataType::Float));
+  FUSILLI_REQUIRE_ASSIGN(
+      Buffer second, parent->subview(64, castToSizeT({32}), DataType::Half));
+  REQUIRE(iree_hal_buffer_view_byte_length(second) == 64);
+
+  // Views outlive the parent and keep the pooled memory reserved.
+  parent.reset();
+  REQUIRE(handle.getAllocatorStats().bytesCached == 0);
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(first.read(handle, result));
+  REQUIRE(result == std::vector<float>(packed.begin(), packed.begin() + 16));
+
+  SECTION("Out of range") {
+    ErrorOr<Buffer> tooLarge =
+        first.subview(32, castToSizeT({16}), DataType::Float);
+    REQUIRE(isError(tooLarge));
+    REQUIRE(ErrorObject(tooLarge).getCode() == ErrorCode::InvalidArgument);
+  }
+}
+
+TEST_CASE("Buffer::wrapHost executes in host memory in place", "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(Backend::CPU));
+  Graph graph;
+  graph.setName("buffer_wrap_host");
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto a = graph.tensor(TensorAttr().setName("a").setDim({4}).setStride({1}));
+  auto b = graph.tensor(TensorAttr().setName("b").setDim({4}).setStride({1}));
+  auto c = graph.pointwise(a, b,
+                           PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  c->setName("c").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  alignas(64) float aData[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+  alignas(64) float bData[4] = {10.0f, 20.0f, 30.0f, 40.0f};
+  alignas(64) float cData[4] = {};
+  FUSILLI_REQUIRE_ASSIGN(
+      Buffer aBuf, Buffer::wrapHost(handle, std::span<float>(aData), {4}));
+  FUSILLI_REQUIRE_ASSIGN(
+      Buffer bBuf, Buffer::wrapHost(handle, std::span<float>(bData), {4}));
+  FUSILLI_REQUIRE_ASSIGN(
+      Buffer cBuf, Buffer::wrapHost(handle, std::span<float>(cData), {4}));
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {a, std::make_shared<Buffer>(std::move(aBuf))},
+          {b, std::make_shared<Buffer>(std::move(bBuf))},
+          {c, std::make_shared<Buffer>(std::move(cBuf))},
+      };
+  FUSILLI_REQUIRE_OK(graph.execute(handle, variantPack, nullptr));
+  FUSILLI_REQUIRE_OK(handle.synchronize());
+  REQUIRE(std::vector<float>(cData, cData + 4) ==
+          std::vector<float>{11.0f, 22.0f, 33.0f, 44.0f});
+
+  // Inputs are read in place too.
+  aData[0] = 100.0f;
+  FUSILLI_REQUIRE_OK(graph.execute(handle, variantPack, nullptr));
+  FUSILLI_REQUIRE_OK(handle.synchronize());
+  REQUIRE(cData[0] == 110.0f);
+
+  // The shape must cover the memory exactly.
+  ErrorOr<Buffer> mismatched =
+      Buffer::wrapHost(handle, std::span<float>(aData), {2, 3});
+  REQUIRE(isError(mismatched));
+  REQUIRE(ErrorObject(mismatched).getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("Buffer alignment", "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(Backend::CPU));
+  REQUIRE(handle.getBufferAlignment() == Handle::kDefaultBufferAlignment);
+  ErrorObject notPowerOfTwo = handle.setBufferAlignment(96);
+  REQUIRE(isError(notPowerOfTwo));
+  REQUIRE(notPowerOfTwo.getCode() == ErrorCode::InvalidArgument);
+  FUSILLI_REQUIRE_OK(handle.setBufferAlignment(256));
+
+  SECTION("Allocations are aligned") {
+    FUSILLI_REQUIRE_ASSIGN(Buffer raw, Buffer::allocateRaw(handle, 100));
+    FUSILLI_REQUIRE_ASSIGN(uintptr_t rawAddress, raw.getAddress(handle));
+    REQUIRE(rawAddress % 256 == 0);
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer typed,
+        Buffer::allocate(handle, castToSizeT({3}),
+                         std::vector<float>{1.0f, 2.0f, 3.0f}));
+    FUSILLI_REQUIRE_ASSIGN(uintptr_t typedAddress, typed.getAddress(handle));
+    REQUIRE(typedAddress % 256 == 0);
+  }
+
+  SECTION("Execution checks declared alignments") {
+    Graph graph;
+    graph.setName("buffer_alignment");
+    graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+    auto a = graph.tensor(
+        TensorAttr().setName("a").setDim({4}).setStride({1}).setAlignment(64));
+    auto b = graph.tensor(TensorAttr().setName("b").setDim({4}).setStride({1}));
+    auto c = graph.pointwise(
+        a, b, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+    c->setName("c").setOutput(true);
+    FUSILLI_REQUIRE_OK(graph.validate());
+    FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+    alignas(64) float aData[5] = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+    alignas(64) float bData[4] = {10.0f, 20.0f, 30.0f, 40.0f};
+    alignas(64) float cData[4] = {};
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer aBuf, Buffer::wrapHost(handle, std::span<float>(aData, 4), {4}));
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer misalignedBuf,
+        Buffer::wrapHost(handle, std::span<float>(aData + 1, 4), {4}));
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer bBuf, Buffer::wrapHost(handle, std::span<float>(bData), {4}));
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer cBuf, Buffer::wrapHost(handle, std::span<float>(cData), {4}));
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+        variantPack = {
+            {a, std::make_shared<Buffer>(std::move(aBuf))},
+            {b, std::make_shared<Buffer>(std::move(bBuf))},
+            {c, std::make_shared<Buffer>(std::move(cBuf))},
+        };
+    FUSILLI_REQUIRE_OK(graph.execute(handle, variantPack, nullptr));
+    FUSILLI_REQUIRE_OK(handle.synchronize());
+    REQUIRE(std::vector<float>(cData, cData + 4) ==
+            std::vector<float>{10.0f, 21.0f, 32.0f, 43.0f});
+
+    variantPack[a] = std::make_shared<Buffer>(std::move(misalignedBuf));
+    ErrorObject misaligned = graph.execute(handle, variantPack, nullptr);
+    REQUIRE(isError(misaligned));
+    REQUIRE(misaligned.getCode() == ErrorCode::VariantPackError);
+  }
+}
+
+TEST_CASE("Buffer::importDevicePtr and Buffer::importDLPack errors",
+          "[buffer]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  std::vector<float> storage(6);
+
+  // Only dense row-major layouts can be wrapped.
+  ErrorOr<Buffer> transposed = Buffer::importDevicePtr(
+      handle, storage.data(), castToSizeT({2, 3}), DataType::Float, {1, 2});
+  REQUIRE(isError(transposed));
+  REQUIRE(ErrorObject(transposed).getCode() == ErrorCode::NotImplemented);
+
+  ErrorOr<Buffer> nullPtr = Buffer::importDevicePtr(
+      handle, nullptr, castToSizeT({2, 3}), DataType::Float);
+  REQUIRE(isError(nullPtr));
+
+  // IPC handles are AMDGPU only.
+  if (kDefaultBackend != Backend::AMDGPU) {
+    FUSILLI_REQUIRE_ASSIGN(
+        Buffer buf, Buffer::allocate(handle, castToSizeT({2, 3}), storage));
+    ErrorOr<BufferIpcHandle> ipc = buf.exportIpcHandle(handle);
+    REQUIRE(isError(ipc));
+    REQUIRE(ErrorObject(ipc).getCode() == ErrorCode::NotImplemented);
+  }
+
+  // Tensors on other devices are rejected.
+  int64_t shape[] = {6};
+  DLManagedTensor tensor = {};
+  tensor.dl_tensor.data = storage.data();
+  tensor.dl_tensor.device = {kDLVulkan, 0};
+  tensor.dl_tensor.ndim = 1;
+  tensor.dl_tensor.dtype = {kDLFloat, 32, 1};
+  tensor.dl_tensor.shape = shape;
+  ErrorOr<Buffer> wrongDevice = Buffer::importDLPack(handle, &tensor);
+  REQUIRE(isError(wrongDevice));
+  REQUIRE(ErrorObject(wrongDevice).getCode() == ErrorCode::InvalidArgument);
+}
@@ -12,9 +12,13 @@
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 
+#include <cstdint>
 #include <filesystem>
+#include <span>
 #include <string>
+#include <system_error>
 #include <utility>
+#include <vector>
 
 using namespace fusilli;
 
@@ -211,3 +215,92 @@ TEST_CASE("CacheFile directory sanitization", "[CacheFile]") {
   // Verify the file was actually created.
   REQUIRE(std::filesystem::exists(cacheFile.path));
 }
+
+TEST_CASE("CacheFile kernel cache paths", "[CacheFile]") {
+  std::filesystem::path path =
+      CacheFile::getKernelCachePath("0123456789abcdef", "test_file.txt");
+  REQUIRE(path == CacheFile::getCacheDir() / "kernels" / "0123456789abcdef" /
+                      "test_file.txt");
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    std::filesystem::remove_all(path.parent_path());
+    // Only removes the kernel cache root if no other entries remain.
+    std::error_code ec;
+    std::filesystem::remove(path.parent_path().parent_path(), ec);
+  });
+
+  // Path based factories round trip through the same file.
+  {
+    FUSILLI_REQUIRE_ASSIGN(CacheFile cf,
+                           CacheFile::create(path, /*remove=*/true));
+    FUSILLI_REQUIRE_OK(cf.write("kernel"));
+    FUSILLI_REQUIRE_ASSIGN(CacheFile opened, CacheFile::open(path));
+    FUSILLI_REQUIRE_ASSIGN(std::string content, opened.read());
+    REQUIRE(content == "kernel");
+  }
+  REQUIRE(!std::filesystem::exists(path));
+}
+
+TEST_CASE("CacheFile::write replaces contents atomically", "[CacheFile]") {
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    std::filesystem::remove_all(
+        CacheFile::getPath(kGraphName, "a").parent_path());
+  });
+
+  FUSILLI_REQUIRE_ASSIGN(CacheFile cf, CacheFile::create(
+                                           /*graphName=*/kGraphName,
+                                           /*filename=*/"atomic_file",
+                                           /*remove=*/true));
+  FUSILLI_REQUIRE_OK(cf.write("first"));
+  FUSILLI_REQUIRE_OK(cf.write("second"));
+  FUSILLI_REQUIRE_ASSIGN(std::string content, cf.read());
+  REQUIRE(content == "second");
+
+  // The temporary file used for the write has been renamed into place.
+  REQUIRE(CacheFile::getTempPath(cf.path).parent_path() ==
+          cf.path.parent_path());
+  REQUIRE(!std::filesystem::exists(CacheFile::getTempPath(cf.path)));
+  size_t entries = 0;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(cf.path.parent_path())) {
+    (void)entry;
+    ++entries;
+  }
+  REQUIRE(entries == 1);
+}
+
+TEST_CASE("CacheFile::publish", "[CacheFile]") {
+  std::filesystem::path path =
+      CacheFile::getPath(kGraphName, "published_dir") / "published_file";
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    std::filesystem::remove_all(
+        CacheFile::getPath(kGraphName, "a").parent_path());
+  });
+
+  // Parent directories are created as needed.
+  FUSILLI_REQUIRE_OK(CacheFile::publish(path, "first"));
+  FUSILLI_REQUIRE_OK(CacheFile::publish(path, "second"));
+  FUSILLI_REQUIRE_ASSIGN(CacheFile opened, CacheFile::open(path));
+  FUSILLI_REQUIRE_ASSIGN(std::string content, opened.read());
+  REQUIRE(content == "second");
+
+  // Binary contents, e.g. a mapped artifact, are published byte for byte.
+  const std::vector<uint8_t> bytes = {0x00, 0xff, 0x0a, 0x00};
+  FUSILLI_REQUIRE_OK(CacheFile::publish(path, std::span(bytes)));
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> published, readFileBytes(path));
+  REQUIRE(published == bytes);
+}
+
+TEST_CASE("IREE compiler library cache path", "[CacheFile]") {
+  // The resolved library path persists under the cache directory, keyed on
+  // the Python environment of the process.
+  std::filesystem::path path = getIreeCompilerLibCachePath();
+  REQUIRE(path.parent_path() ==
+          CacheFile::getCacheDir() / "iree_compiler_lib");
+  REQUIRE(path.filename().string().size() == 16);
+  REQUIRE(getIreeCompilerLibCachePath() == path);
+}
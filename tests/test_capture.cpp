@@ -0,0 +1,108 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_capture";
+
+TEST_CASE("ExecutionCapture replays a captured execution", "[capture]") {
+  std::filesystem::path path = CacheFile::getPath(kGraphName, "capture");
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(path.parent_path()); });
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  Graph graph;
+  graph.setName(kGraphName);
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto a = graph.tensor(TensorAttr().setName("a").setDim({4}).setStride({1}));
+  auto b = graph.tensor(TensorAttr().setName("b").setDim({4}).setStride({1}));
+  auto c = graph.pointwise(a, b,
+                           PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  c->setName("c").setOutput(true);
+  FUSILLI_REQUIRE_OK(graph.validate());
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(auto aBuf,
+                         allocateBufferOfType(handle, a, DataType::Float, 2.0));
+  FUSILLI_REQUIRE_ASSIGN(auto bBuf,
+                         allocateBufferOfType(handle, b, DataType::Float, 3.0));
+  FUSILLI_REQUIRE_ASSIGN(auto cBuf,
+                         allocateBufferOfType(handle, c, DataType::Float, 0.0));
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {{a, aBuf}, {b, bBuf}, {c, cBuf}};
+
+  // Replays the capture at `path` and returns the elements of `c`.
+  auto replay = [&]() -> std::vector<float> {
+    FUSILLI_REQUIRE_ASSIGN(ExecutionCapture capture,
+                           ExecutionCapture::read(path));
+    FUSILLI_REQUIRE_ASSIGN(std::unique_ptr<Graph> replayed,
+                           capture.loadGraph(handle));
+    FUSILLI_REQUIRE_ASSIGN(auto replayPack,
+                           capture.allocateBuffers(handle, *replayed));
+    REQUIRE(replayPack.size() == 3);
+    FUSILLI_REQUIRE_OK(replayed->execute(handle, replayPack, nullptr));
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(
+        replayPack.at(replayed->getTensor("c"))->read(handle, result));
+    return result;
+  };
+
+  SECTION("with data") {
+    FUSILLI_REQUIRE_ASSIGN(
+        ExecutionCapture capture,
+        ExecutionCapture::capture(graph, handle, variantPack,
+                                  CaptureOptions{.data = true}));
+    REQUIRE(capture.graphName == kGraphName);
+    REQUIRE(capture.backend == kDefaultBackend);
+    REQUIRE(!capture.asmSource.empty());
+    REQUIRE(!capture.artifact.empty());
+    REQUIRE(capture.buffers.size() == 3);
+    REQUIRE(capture.buffers[0].name == "a");
+    REQUIRE(capture.buffers[0].dims == std::vector<int64_t>{4});
+    REQUIRE(capture.buffers[0].data->size() == 4 * sizeof(float));
+    FUSILLI_REQUIRE_OK(capture.write(path));
+    REQUIRE(replay() == std::vector<float>(4, 5.0f));
+  }
+
+  SECTION("without data or artifact") {
+    FUSILLI_REQUIRE_ASSIGN(
+        ExecutionCapture capture,
+        ExecutionCapture::capture(graph, handle, variantPack,
+                                  CaptureOptions{.artifact = false}));
+    REQUIRE(capture.artifact.empty());
+    REQUIRE(!capture.buffers[0].data.has_value());
+    FUSILLI_REQUIRE_OK(capture.write(path));
+    // Inputs are replayed as ones, and the graph is compiled again.
+    REQUIRE(replay() == std::vector<float>(4, 2.0f));
+  }
+}
+
+TEST_CASE("ExecutionCapture::read rejects other files", "[capture]") {
+  auto cleanup = ScopeExit([&] {
+    std::filesystem::remove_all(
+        CacheFile::getPath(kGraphName, "a").parent_path());
+  });
+  FUSILLI_REQUIRE_ASSIGN(CacheFile file,
+                         CacheFile::create(kGraphName, "invalid",
+                                           /*remove=*/true));
+  FUSILLI_REQUIRE_OK(file.write("not a capture"));
+  ErrorOr<ExecutionCapture> capture = ExecutionCapture::read(file.path);
+  REQUIRE(isError(capture));
+  REQUIRE(ErrorObject(capture).getCode() == ErrorCode::InvalidArgument);
+}
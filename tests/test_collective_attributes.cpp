@@ -0,0 +1,59 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("CollectiveAttr default constructor", "[collective_attr]") {
+  CollectiveAttr attr;
+  REQUIRE(attr.getMode() == CollectiveAttr::Mode::NOT_SET);
+  REQUIRE(attr.getReduceOp() == CollectiveAttr::ReduceOp::SUM);
+  REQUIRE(attr.getRanks().empty());
+  REQUIRE(attr.getGroupSize() == 0);
+  REQUIRE(attr.getAxis() == 0);
+  REQUIRE(attr.inputs.empty());
+  REQUIRE(attr.outputs.empty());
+}
+
+TEST_CASE("CollectiveAttr setters and getters", "[collective_attr]") {
+  CollectiveAttr attr;
+  attr.setMode(CollectiveAttr::Mode::REDUCE_SCATTER)
+      .setReduceOp(CollectiveAttr::ReduceOp::MAX)
+      .setRanks({0, 1, 2, 3})
+      .setAxis(-1);
+
+  REQUIRE(attr.getMode() == CollectiveAttr::Mode::REDUCE_SCATTER);
+  REQUIRE(attr.getReduceOp() == CollectiveAttr::ReduceOp::MAX);
+  REQUIRE(attr.getRanks() == std::vector<int64_t>{0, 1, 2, 3});
+  REQUIRE(attr.getGroupSize() == 4);
+  REQUIRE(attr.getAxis() == -1);
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto y = std::make_shared<TensorAttr>(2.0f);
+  attr.setX(x).setY(y);
+
+  REQUIRE(attr.inputs.size() == 1);
+  REQUIRE(attr.outputs.size() == 1);
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getY() == y);
+}
+
+TEST_CASE("CollectiveAttr reduce op names", "[collective_attr]") {
+  REQUIRE(CollectiveAttr::kReduceOpToStr.at(CollectiveAttr::ReduceOp::SUM) ==
+          "sum");
+  REQUIRE(CollectiveAttr::kReduceOpToStr.at(CollectiveAttr::ReduceOp::AVG) ==
+          "avg");
+  REQUIRE(CollectiveAttr::kReduceOpToStr.at(CollectiveAttr::ReduceOp::MIN) ==
+          "min");
+  REQUIRE(CollectiveAttr::kReduceOpToStr.at(CollectiveAttr::ReduceOp::MAX) ==
+          "max");
+}
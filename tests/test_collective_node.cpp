@@ -0,0 +1,186 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+// Helper to create a contiguous tensor.
+static std::shared_ptr<TensorAttr> makeTensor(const std::string &name,
+                                              const std::vector<int64_t> &dim) {
+  auto stride =
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+  return std::make_shared<TensorAttr>(
+      TensorAttr().setName(name).setDim(dim).setStride(stride));
+}
+
+TEST_CASE("CollectiveNode getName and getType", "[collective_node]") {
+  Context ctx;
+  CollectiveAttr attr;
+  attr.setName("foo_collective");
+
+  CollectiveNode node(std::move(attr), ctx);
+  REQUIRE(node.getName() == "foo_collective");
+  REQUIRE(node.getType() == INode::Type::Collective);
+}
+
+TEST_CASE("CollectiveNode preValidateNode detects invalid attributes",
+          "[collective_node]") {
+  Context ctx;
+
+  SECTION("Mode missing") {
+    CollectiveAttr attr;
+    attr.setX(makeTensor("X", {4, 8}))
+        .setY(std::make_shared<TensorAttr>())
+        .setRanks({0, 1});
+    CollectiveNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Collective mode not set");
+  }
+
+  SECTION("Mode unknown") {
+    CollectiveAttr attr;
+    attr.setMode(static_cast<CollectiveAttr::Mode>(42))
+        .setX(makeTensor("X", {4, 8}))
+        .setY(std::make_shared<TensorAttr>())
+        .setRanks({0, 1});
+    CollectiveNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() == "Collective mode 42 is not supported");
+  }
+
+  SECTION("Ranks missing") {
+    CollectiveAttr attr;
+    attr.setMode(CollectiveAttr::Mode::ALL_REDUCE)
+        .setX(makeTensor("X", {4, 8}))
+        .setY(std::make_shared<TensorAttr>());
+    CollectiveNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Collective ranks not set");
+  }
+
+  SECTION("Duplicate ranks") {
+    CollectiveAttr attr;
+    attr.setMode(CollectiveAttr::Mode::ALL_REDUCE)
+        .setX(makeTensor("X", {4, 8}))
+        .setY(std::make_shared<TensorAttr>())
+        .setRanks({0, 1, 1});
+    CollectiveNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Collective ranks must be distinct and non-negative");
+  }
+
+  SECTION("Axis out of range") {
+    CollectiveAttr attr;
+    attr.setMode(CollectiveAttr::Mode::ALL_GATHER)
+        .setX(makeTensor("X", {4, 8}))
+        .setY(std::make_shared<TensorAttr>())
+        .setRanks({0, 1})
+        .setAxis(2);
+    CollectiveNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Collective axis 2 is out of range for input tensor X of rank 2");
+  }
+
+  SECTION("Reduce scatter dim not divisible") {
+    CollectiveAttr attr;
+    attr.setMode(CollectiveAttr::Mode::REDUCE_SCATTER)
+        .setX(makeTensor("X", {6, 8}))
+        .setY(std::make_shared<TensorAttr>())
+        .setRanks({0, 1, 2, 3});
+    CollectiveNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Collective REDUCE_SCATTER input tensor X "
+                                   "dim 0 must be divisible by the group "
+                                   "size 4");
+  }
+}
+
+TEST_CASE("CollectiveNode inferPropertiesNode infers output shape",
+          "[collective_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto x = makeTensor("X", {4, 8});
+  auto y = std::make_shared<TensorAttr>();
+  CollectiveAttr attr;
+  attr.setX(x).setY(y).setRanks({0, 1});
+
+  std::vector<int64_t> expected;
+  SECTION("All reduce keeps the shape") {
+    attr.setMode(CollectiveAttr::Mode::ALL_REDUCE);
+    expected = {4, 8};
+  }
+  SECTION("All gather grows the axis") {
+    attr.setMode(CollectiveAttr::Mode::ALL_GATHER).setAxis(-1);
+    expected = {4, 16};
+  }
+  SECTION("Reduce scatter shrinks the axis") {
+    attr.setMode(CollectiveAttr::Mode::REDUCE_SCATTER);
+    expected = {2, 8};
+  }
+
+  CollectiveNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  REQUIRE(y->getDim() == expected);
+  REQUIRE(y->getStride() == std::vector<int64_t>{expected[1], 1});
+  REQUIRE(y->getDataType() == DataType::Half);
+}
+
+TEST_CASE("CollectiveNode postValidateNode rejects AVG on integers",
+          "[collective_node]") {
+  Context ctx;
+  auto x = makeTensor("X", {4, 8});
+  x->setDataType(DataType::Int32);
+
+  CollectiveAttr attr;
+  attr.setMode(CollectiveAttr::Mode::ALL_REDUCE)
+      .setReduceOp(CollectiveAttr::ReduceOp::AVG)
+      .setX(x)
+      .setY(std::make_shared<TensorAttr>())
+      .setRanks({0, 1});
+  CollectiveNode node(std::move(attr), ctx);
+
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  auto status = node.postValidateNode();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  REQUIRE(status.getMessage() ==
+          "Collective AVG is not supported for integral or boolean tensors");
+}
@@ -190,6 +190,32 @@ TEST_CASE("CompileCommand::toString format", "[CompileCommand]") {
   REQUIRE_THAT(cmdStr, Catch::Matchers::ContainsSubstring("-o"));
 }
 
+TEST_CASE("CompileCommand::build without statistics", "[CompileCommand]") {
+  // Create temporary cache files.
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile input,
+      CacheFile::create(kGraphName, "input.mlir", /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile output,
+      CacheFile::create(kGraphName, "output.vmfb", /*remove=*/true));
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(input.path.parent_path()); });
+
+  CompileOptions options;
+  options.setProfile(CompileProfile::Production);
+  CompileCommand cmd =
+      CompileCommand::build(Backend::CPU, input, output, options);
+
+  std::string cmdStr = cmd.toString();
+  REQUIRE_THAT(cmdStr, Catch::Matchers::ContainsSubstring(input.path.string()));
+  REQUIRE_THAT(cmdStr,
+               Catch::Matchers::ContainsSubstring(output.path.string()));
+  REQUIRE_THAT(cmdStr, !Catch::Matchers::ContainsSubstring(
+                           "--iree-scheduling-dump-statistics"));
+}
+
 TEST_CASE("CompileCommand::writeTo", "[CompileCommand]") {
   // Create temporary cache files.
   FUSILLI_REQUIRE_ASSIGN(
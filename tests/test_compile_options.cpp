@@ -0,0 +1,235 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_compile_options";
+
+static bool contains(const std::vector<std::string> &flags,
+                     const std::string &flag) {
+  return std::find(flags.begin(), flags.end(), flag) != flags.end();
+}
+
+TEST_CASE("CompileOptions default resolves to backend flags",
+          "[CompileOptions]") {
+  CompileOptions options;
+  REQUIRE(options.getFlags().empty());
+  std::span<const std::string> defaults = getBackendFlags(Backend::CPU);
+  REQUIRE(options.resolveFlags(Backend::CPU) ==
+          std::vector<std::string>(defaults.begin(), defaults.end()));
+}
+
+TEST_CASE("CompileOptions setFlag replaces flags with the same name",
+          "[CompileOptions]") {
+  CompileOptions options;
+  options.setFlag("--iree-opt-level=O3").setOptLevel("O1");
+  REQUIRE(options.getFlags() ==
+          std::vector<std::string>{"--iree-opt-level=O1"});
+
+  options.setSplitReduction(false).setFlag("--iree-flag-without-value");
+  REQUIRE(options.getFlags() ==
+          std::vector<std::string>{
+              "--iree-opt-level=O1",
+              "--iree-dispatch-creation-enable-split-reduction=false",
+              "--iree-flag-without-value",
+          });
+}
+
+TEST_CASE("CompileOptions resolveFlags overrides backend defaults",
+          "[CompileOptions]") {
+  CompileOptions options;
+  options.setFlag("--iree-llvmcpu-target-cpu=generic").setOptLevel("O0");
+  std::vector<std::string> flags = options.resolveFlags(Backend::CPU);
+
+  REQUIRE(contains(flags, "--iree-hal-target-backends=llvm-cpu"));
+  REQUIRE(contains(flags, "--iree-llvmcpu-target-cpu=generic"));
+  REQUIRE(!contains(flags, "--iree-llvmcpu-target-cpu=host"));
+  REQUIRE(contains(flags, "--iree-opt-level=O0"));
+  // Options are appended after the remaining defaults.
+  REQUIRE(flags.back() == "--iree-opt-level=O0");
+}
+
+TEST_CASE("CompileOptions getSplitReduction reads the resolved flag",
+          "[CompileOptions]") {
+  CompileOptions options;
+  // The CPU backend defaults leave split reductions to the compiler.
+  REQUIRE(!options.getSplitReduction(Backend::CPU).has_value());
+  options.setSplitReduction(false);
+  REQUIRE(options.getSplitReduction(Backend::CPU) == false);
+  options.setSplitReduction(true);
+  REQUIRE(options.getSplitReduction(Backend::CPU) == true);
+  options.setFlag("--iree-dispatch-creation-enable-split-reduction");
+  REQUIRE(options.getSplitReduction(Backend::CPU) == true);
+}
+
+TEST_CASE("CompileOptions equality", "[CompileOptions]") {
+  CompileOptions a, b;
+  REQUIRE(a == b);
+  a.setOptLevel("O2");
+  REQUIRE(a != b);
+  b.setOptLevel("O2");
+  REQUIRE(a == b);
+}
+
+TEST_CASE("CompileOptions profile defaults to diagnostic",
+          "[CompileOptions]") {
+  CompileOptions options;
+  REQUIRE(options.getProfile() == CompileProfile::Diagnostic);
+  options.setProfile(CompileProfile::Production);
+  REQUIRE(options.getProfile() == CompileProfile::Production);
+  REQUIRE(options != CompileOptions());
+  // The profile is not a compiler flag.
+  REQUIRE(options.getFlags().empty());
+  REQUIRE(CompileOptions::fastCompile(options).getProfile() ==
+          CompileProfile::Production);
+}
+
+TEST_CASE("CompileOptions fastCompile overrides optimization flags",
+          "[CompileOptions]") {
+  CompileOptions base;
+  base.setOptLevel("O3").setFlag("--iree-llvmcpu-target-cpu=generic");
+  CompileOptions fast = CompileOptions::fastCompile(base);
+
+  REQUIRE(contains(fast.getFlags(), "--iree-opt-level=O1"));
+  REQUIRE(!contains(fast.getFlags(), "--iree-opt-level=O3"));
+  REQUIRE(contains(fast.getFlags(),
+                   "--iree-dispatch-creation-enable-split-reduction=false"));
+  // Unrelated flags of the base options are kept.
+  REQUIRE(contains(fast.getFlags(), "--iree-llvmcpu-target-cpu=generic"));
+  REQUIRE(fast != base);
+}
+
+TEST_CASE("CompileOptions cpuPerformance enables data tiling and ukernels",
+          "[CompileOptions]") {
+  CompileOptions base;
+  base.setOptLevel("O1").setFlag("--iree-llvmcpu-target-cpu=generic");
+  CompileOptions perf = CompileOptions::cpuPerformance(base);
+
+  REQUIRE(contains(perf.getFlags(), "--iree-opt-level=O3"));
+  REQUIRE(!contains(perf.getFlags(), "--iree-opt-level=O1"));
+  REQUIRE(contains(perf.getFlags(), "--iree-opt-data-tiling=true"));
+  REQUIRE(contains(perf.getFlags(), "--iree-llvmcpu-enable-ukernels=all"));
+  REQUIRE(contains(perf.getFlags(), "--iree-opt-const-eval=true"));
+  // Unrelated flags of the base options are kept.
+  REQUIRE(contains(perf.getFlags(), "--iree-llvmcpu-target-cpu=generic"));
+  REQUIRE(perf != base);
+
+  // Without a target CPU of their own, the options target the host.
+  std::vector<std::string> flags =
+      CompileOptions::cpuPerformance().resolveFlags(Backend::CPU);
+  REQUIRE(contains(flags, "--iree-llvmcpu-target-cpu=host"));
+  REQUIRE(contains(flags, "--iree-opt-data-tiling=true"));
+}
+
+TEST_CASE("CompileCommand::build applies CompileOptions", "[CompileOptions]") {
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile input,
+      CacheFile::create(kGraphName, "input.mlir", /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile output,
+      CacheFile::create(kGraphName, "output.vmfb", /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile statistics,
+      CacheFile::create(kGraphName, "statistics.json", /*remove=*/true));
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(input.path.parent_path()); });
+
+  CompileOptions options;
+  options.setFlag("--iree-llvmcpu-target-cpu=generic");
+  CompileCommand cmd =
+      CompileCommand::build(Backend::CPU, input, output, statistics, options);
+
+  REQUIRE(contains(cmd.getArgs(), "--iree-llvmcpu-target-cpu=generic"));
+  REQUIRE(!contains(cmd.getArgs(), "--iree-llvmcpu-target-cpu=host"));
+}
+
+TEST_CASE("CompileOptions setTuningSpecAsm is content-addressed",
+          "[CompileOptions]") {
+  auto specFlag = [](const CompileOptions &options) {
+    for (const auto &flag : options.getFlags())
+      if (flag.starts_with("--iree-codegen-tuning-spec-path=")) // C++20
+        return flag;
+    return std::string();
+  };
+
+  CompileOptions a, b, c;
+  a.setTuningSpecAsm("module {}");
+  b.setTuningSpecAsm("module {}");
+  c.setTuningSpecAsm("module { }");
+  REQUIRE(a.getTuningSpecAsm() == std::optional<std::string>("module {}"));
+  REQUIRE(!specFlag(a).empty());
+  REQUIRE(specFlag(a) == specFlag(b));
+  REQUIRE(specFlag(a) != specFlag(c));
+
+  // Replacing the attached spec keeps a single tuning spec flag.
+  a.setTuningSpecAsm("module { }");
+  REQUIRE(a.getFlags().size() == 1);
+  REQUIRE(specFlag(a) == specFlag(c));
+
+  // Setting the flag directly detaches the spec contents.
+  a.setFlag("--iree-codegen-tuning-spec-path=/path/to/spec.mlir");
+  REQUIRE(!a.getTuningSpecAsm().has_value());
+  FUSILLI_REQUIRE_OK(a.writeTuningSpec());
+}
+
+TEST_CASE("CompileOptions setTuningSpec reads the spec file",
+          "[CompileOptions]") {
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile spec,
+      CacheFile::create(kGraphName, "spec.mlir", /*remove=*/true));
+  std::filesystem::path writtenPath;
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    std::filesystem::remove_all(spec.path.parent_path());
+    if (!writtenPath.empty()) {
+      std::error_code ec;
+      std::filesystem::remove(writtenPath, ec);
+      std::filesystem::remove(writtenPath.parent_path(), ec);
+    }
+  });
+
+  // A unique spec ensures the content-addressed file is ours to remove.
+  const std::string mlir = "// test_compile_options\nmodule {}\n";
+  FUSILLI_REQUIRE_OK(spec.write(mlir));
+
+  CompileOptions options;
+  FUSILLI_REQUIRE_OK(options.setTuningSpec(spec.path));
+  REQUIRE(options.getTuningSpecAsm() == std::optional<std::string>(mlir));
+
+  writtenPath =
+      CacheFile::getTuningSpecPath(Hasher().update(mlir).hexDigest());
+  REQUIRE(options.getFlags() ==
+          std::vector<std::string>{"--iree-codegen-tuning-spec-path=" +
+                                   writtenPath.string()});
+  FUSILLI_REQUIRE_OK(options.writeTuningSpec());
+  FUSILLI_REQUIRE_ASSIGN(CacheFile written, CacheFile::open(writtenPath));
+  FUSILLI_REQUIRE_ASSIGN(std::string contents, written.read());
+  REQUIRE(contents == mlir);
+
+  CompileOptions missing;
+  ErrorObject status = missing.setTuningSpec(
+      CacheFile::getPath(kGraphName, "missing_spec.mlir"));
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::FileSystemFailure);
+  REQUIRE(!missing.getTuningSpecAsm().has_value());
+}
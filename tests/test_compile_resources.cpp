@@ -0,0 +1,90 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(FUSILLI_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace fusilli;
+
+TEST_CASE("CompileResourceLimits parses CPU lists", "[compile_resources]") {
+  FUSILLI_REQUIRE_ASSIGN(std::vector<unsigned> cpus,
+                         CompileResourceLimits::parseCpuList("0-2,5,7-8"));
+  REQUIRE(cpus == std::vector<unsigned>{0, 1, 2, 5, 7, 8});
+
+  FUSILLI_REQUIRE_ASSIGN(std::vector<unsigned> empty,
+                         CompileResourceLimits::parseCpuList(""));
+  REQUIRE(empty.empty());
+
+  for (const char *invalid : {"a", "1,", "3-1", "1-", "-1", "1;2"}) {
+    ErrorOr<std::vector<unsigned>> parsed =
+        CompileResourceLimits::parseCpuList(invalid);
+    REQUIRE(isError(parsed));
+    REQUIRE(ErrorObject(parsed).getCode() == ErrorCode::InvalidArgument);
+  }
+}
+
+TEST_CASE("CompileResourceLimits resolves the cores to compile on",
+          "[compile_resources]") {
+  std::vector<unsigned> allowed = {0, 1, 2, 3, 4, 5, 6, 7};
+
+  // No limits on cores leaves the affinity unchanged.
+  REQUIRE(CompileResourceLimits().resolveCpus(allowed).empty());
+  REQUIRE(CompileResourceLimits{.niceness = 10}.resolveCpus(allowed).empty());
+  REQUIRE(CompileResourceLimits{.maxThreads = 8}.resolveCpus(allowed).empty());
+
+  // Thread caps keep the last cores.
+  REQUIRE(CompileResourceLimits{.maxThreads = 2}.resolveCpus(allowed) ==
+          std::vector<unsigned>{6, 7});
+
+  // Cores unavailable to the process are dropped.
+  CompileResourceLimits pinned{.cpus = {9, 3, 1, 3}};
+  REQUIRE(pinned.resolveCpus(allowed) == std::vector<unsigned>{1, 3});
+  pinned.maxThreads = 1;
+  REQUIRE(pinned.resolveCpus(allowed) == std::vector<unsigned>{3});
+  REQUIRE(CompileResourceLimits{.cpus = {9}}.resolveCpus(allowed).empty());
+}
+
+TEST_CASE("runWithCompileResourceLimits applies limits on another thread",
+          "[compile_resources]") {
+  std::thread::id caller = std::this_thread::get_id();
+
+  // Without limits, the work runs on the calling thread.
+  REQUIRE(runWithCompileResourceLimits(CompileResourceLimits(), [] {
+            return std::this_thread::get_id();
+          }) == caller);
+
+  CompileResourceLimits limits{.maxThreads = 1, .niceness = 1};
+  REQUIRE(limits.toString() == "maxThreads=1 niceness=1 cpus=all");
+  // Catch2 assertions are not thread safe, so check the worker afterwards.
+  ErrorOr<int> result = runWithCompileResourceLimits(
+      limits, [&]() -> ErrorOr<int> {
+        if (std::this_thread::get_id() == caller)
+          return error(ErrorCode::RuntimeFailure, "Ran on the caller");
+#if defined(FUSILLI_PLATFORM_LINUX)
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask) != 0)
+          return error(ErrorCode::RuntimeFailure, "Failed to get affinity");
+        return ok(CPU_COUNT(&mask));
+#else
+        return ok(1);
+#endif
+      });
+  FUSILLI_REQUIRE_OK(result);
+  REQUIRE(*result == 1);
+}
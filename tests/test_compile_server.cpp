@@ -0,0 +1,141 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(FUSILLI_PLATFORM_WINDOWS)
+#include <unistd.h>
+#endif
+
+using namespace fusilli;
+
+#if !defined(FUSILLI_PLATFORM_WINDOWS)
+
+static std::string kGraphName = "test_compile_server";
+
+// Returns a socket path unique to this process, as tests run in parallel.
+static std::filesystem::path getTestSocketPath() {
+  return std::filesystem::temp_directory_path() /
+         ("fusilli_test_compile_server_" + std::to_string(::getpid()) +
+          ".sock");
+}
+
+TEST_CASE("CompileCommand::execute on compile server",
+          "[CompileServer][integration]") {
+  FUSILLI_REQUIRE_ASSIGN(CompileServer server,
+                         CompileServer::listen(getTestSocketPath()));
+  // Catch2 assertions are not thread-safe, so the result is only logged.
+  std::thread serving([&] {
+    ErrorObject status = server.serve(/*parallelism=*/2);
+    if (isError(status))
+      std::cerr << status << std::endl;
+  });
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile input,
+      CacheFile::create(kGraphName, "input.mlir", /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile output,
+      CacheFile::create(kGraphName, "output.vmfb", /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile statistics,
+      CacheFile::create(kGraphName, "statistics.json", /*remove=*/true));
+  auto cleanup = ScopeExit([&] {
+    unsetEnv("FUSILLI_COMPILE_SERVER_SOCKET");
+    server.stop();
+    serving.join();
+    std::filesystem::remove_all(input.path.parent_path());
+  });
+  setEnv("FUSILLI_COMPILE_SERVER_SOCKET",
+         server.getSocketPath().string().c_str());
+
+  SECTION("Valid MLIR") {
+    FUSILLI_REQUIRE_OK(input.write(getSimpleMLIRModule()));
+    CompileCommand cmd =
+        CompileCommand::build(kDefaultBackend, input, output, statistics);
+    FUSILLI_REQUIRE_OK(cmd.execute());
+    REQUIRE(std::filesystem::file_size(output.path) > 0);
+    REQUIRE(std::filesystem::file_size(statistics.path) > 0);
+  }
+
+  SECTION("Invalid MLIR") {
+    FUSILLI_REQUIRE_OK(input.write("this is not valid MLIR syntax!"));
+    CompileCommand cmd =
+        CompileCommand::build(kDefaultBackend, input, output, statistics);
+    ErrorObject status = cmd.execute();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::CompileFailure);
+  }
+}
+
+TEST_CASE("compileOnServer without a server", "[CompileServer]") {
+  std::vector<std::string> args = {"iree-compile", "input.mlir", "-o",
+                                   "output.vmfb"};
+  ErrorObject status = compileOnServer(getTestSocketPath().string(), args);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::RuntimeFailure);
+}
+
+TEST_CASE("CompileServer rejects malformed requests", "[CompileServer]") {
+  FUSILLI_REQUIRE_ASSIGN(auto *context, CompileContext::create());
+  std::vector<std::string> args = {"iree-compile", "input.mlir"};
+  ErrorObject status = CompileServer::compileRequest(context, args);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("CompileServer only writes into the cache directory",
+          "[CompileServer]") {
+  FUSILLI_REQUIRE_ASSIGN(auto *context, CompileContext::create());
+  std::filesystem::path cacheDir = CacheFile::getCacheDir();
+  std::string outside = (cacheDir.parent_path() / "outside.vmfb").string();
+  std::string inside = (cacheDir / kGraphName / "output.vmfb").string();
+
+  SECTION("Output file") {
+    std::vector<std::string> args = {"iree-compile", "input.mlir", "-o",
+                                     outside};
+    ErrorObject status = CompileServer::compileRequest(context, args);
+    REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+  }
+
+  SECTION("Output file escaping the cache directory") {
+    std::string escaping = (cacheDir / ".." / "outside.vmfb").string();
+    std::vector<std::string> args = {"iree-compile", "input.mlir", "-o",
+                                     escaping};
+    ErrorObject status = CompileServer::compileRequest(context, args);
+    REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+  }
+
+  SECTION("Statistics file") {
+    std::vector<std::string> args = {
+        "iree-compile", "input.mlir",
+        "--iree-scheduling-dump-statistics-file=" + outside, "-o", inside};
+    ErrorObject status = CompileServer::compileRequest(context, args);
+    REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+  }
+  REQUIRE(!std::filesystem::exists(outside));
+}
+
+TEST_CASE("CompileServer socket is private to its user", "[CompileServer]") {
+  FUSILLI_REQUIRE_ASSIGN(CompileServer server,
+                         CompileServer::listen(getTestSocketPath()));
+  std::filesystem::perms perms =
+      std::filesystem::status(server.getSocketPath()).permissions();
+  REQUIRE((perms & std::filesystem::perms::all) ==
+          (std::filesystem::perms::owner_read |
+           std::filesystem::perms::owner_write));
+}
+
+#endif // !defined(FUSILLI_PLATFORM_WINDOWS)
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <string>
@@ -137,6 +138,116 @@ TEST_CASE("CompileContext supports multiple sessions",
   SUCCEED("Multiple sessions created successfully");
 }
 
+TEST_CASE("CompileContext pools sessions with the same flags",
+          "[CompileContext][CompileSession][integration]") {
+  FUSILLI_REQUIRE_ASSIGN(auto *context, CompileContext::create());
+  REQUIRE(context != nullptr);
+  CompileOptions options;
+  options.setFlag("--iree-vm-bytecode-module-strip-source-map=true");
+
+  std::vector<std::string> flags;
+  {
+    FUSILLI_REQUIRE_ASSIGN(auto session,
+                           context->createSession(kDefaultBackend, options));
+    flags = session.getArgs();
+  }
+  // The released session is idle until a session with the same flags is
+  // created again.
+  size_t idleCount = context->getIdleSessionCount();
+  REQUIRE(idleCount > 0);
+  FUSILLI_REQUIRE_ASSIGN(auto session,
+                         context->createSession(kDefaultBackend, options));
+  REQUIRE(context->getIdleSessionCount() == idleCount - 1);
+  REQUIRE(session.getArgs() == flags);
+
+  // The reused session still compiles.
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes,
+                         session.compileToMemory(getSimpleMLIRModule()));
+  REQUIRE(!bytes.empty());
+
+  // Sessions with flags added after creation are not reused.
+  {
+    FUSILLI_REQUIRE_ASSIGN(auto modified,
+                           context->createSession(kDefaultBackend, options));
+    FUSILLI_REQUIRE_OK(modified.addFlag("--iree-opt-level=O1"));
+  }
+  REQUIRE(context->getIdleSessionCount() == idleCount - 1);
+}
+
+TEST_CASE("CompileSession::build pools sessions across graphs",
+          "[CompileContext][CompileSession][integration]") {
+  FUSILLI_REQUIRE_ASSIGN(auto *context, CompileContext::create());
+  REQUIRE(context != nullptr);
+
+  // Compiles a graph named `graphName` the way `Graph::compile()` does, and
+  // returns its statistics file.
+  auto compileGraph =
+      [&](const std::string &graphName) -> ErrorOr<std::filesystem::path> {
+    FUSILLI_ASSIGN_OR_RETURN(
+        CacheFile input,
+        CacheFile::create(graphName, "input.mlir", /*remove=*/true));
+    FUSILLI_ASSIGN_OR_RETURN(
+        CacheFile output,
+        CacheFile::create(graphName, "output.vmfb", /*remove=*/true));
+    FUSILLI_ASSIGN_OR_RETURN(
+        CacheFile statistics,
+        CacheFile::create(graphName, "statistics.json", /*remove=*/false));
+    FUSILLI_CHECK_ERROR(input.write(getSimpleMLIRModule()));
+    FUSILLI_ASSIGN_OR_RETURN(
+        CompileSession session,
+        CompileSession::build(kDefaultBackend, input, output, statistics));
+    FUSILLI_CHECK_ERROR(session.execute());
+    return ok(statistics.path);
+  };
+  std::filesystem::path firstDir, secondDir;
+  auto cleanup = ScopeExit([&] {
+    if (!firstDir.empty())
+      std::filesystem::remove_all(firstDir);
+    if (!secondDir.empty())
+      std::filesystem::remove_all(secondDir);
+  });
+
+  FUSILLI_REQUIRE_ASSIGN(std::filesystem::path first,
+                         compileGraph(kGraphName + "_pool_first"));
+  firstDir = first.parent_path();
+  size_t idleCount = context->getIdleSessionCount();
+  REQUIRE(idleCount > 0);
+
+  // A graph with another name (and cache directory) reuses the session of
+  // the first one, and dumps its statistics into its own directory.
+  FUSILLI_REQUIRE_ASSIGN(std::filesystem::path second,
+                         compileGraph(kGraphName + "_pool_second"));
+  secondDir = second.parent_path();
+  REQUIRE(context->getIdleSessionCount() == idleCount);
+  REQUIRE(first != second);
+  REQUIRE(std::filesystem::exists(first));
+  REQUIRE(std::filesystem::exists(second));
+  REQUIRE(std::filesystem::file_size(second) > 0);
+
+  // A pooled session handed out again only carries the statistics file of
+  // its current graph.
+  {
+    FUSILLI_REQUIRE_ASSIGN(CacheFile input,
+                           CacheFile::create(kGraphName + "_pool_first",
+                                             "input.mlir", /*remove=*/true));
+    FUSILLI_REQUIRE_ASSIGN(CacheFile output,
+                           CacheFile::create(kGraphName + "_pool_first",
+                                             "output.vmfb", /*remove=*/true));
+    FUSILLI_REQUIRE_ASSIGN(
+        CacheFile statistics,
+        CacheFile::create(kGraphName + "_pool_first", "statistics.json",
+                          /*remove=*/false));
+    FUSILLI_REQUIRE_ASSIGN(
+        CompileSession session,
+        CompileSession::build(kDefaultBackend, input, output, statistics));
+    REQUIRE(context->getIdleSessionCount() == idleCount - 1);
+    REQUIRE(std::ranges::count(session.getArgs(),
+                               "--iree-scheduling-dump-statistics-file=" +
+                                   statistics.path.string()) == 1);
+  }
+  REQUIRE(context->getIdleSessionCount() == idleCount);
+}
+
 TEST_CASE("CompileSession::addFlag", "[CompileSession]") {
   // Get the shared compiler context and create a session.
   FUSILLI_REQUIRE_ASSIGN(auto *context, CompileContext::create());
@@ -200,6 +311,47 @@ TEST_CASE("CompileSession::compile with valid MLIR",
   REQUIRE(std::filesystem::file_size(output.path) > 0);
 }
 
+TEST_CASE("CompileSession::compileToMemory with valid MLIR",
+          "[CompileSession][integration]") {
+  // Get the shared compiler context and create a session.
+  FUSILLI_REQUIRE_ASSIGN(auto *context, CompileContext::create());
+  REQUIRE(context != nullptr);
+  FUSILLI_REQUIRE_ASSIGN(auto session, context->createSession(kDefaultBackend));
+
+  // Compile the module without any input or output files.
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes,
+                         session.compileToMemory(getSimpleMLIRModule()));
+  REQUIRE(!bytes.empty());
+
+  // The in-memory output matches compiling through files.
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile input,
+      CacheFile::create(kGraphName, "input_mem.mlir", /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile output,
+      CacheFile::create(kGraphName, "output_mem.vmfb", /*remove=*/true));
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(input.path.parent_path()); });
+  FUSILLI_REQUIRE_OK(input.write(getSimpleMLIRModule()));
+  FUSILLI_REQUIRE_OK(
+      session.compile(input.path.string(), output.path.string()));
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> fileBytes,
+                         readFileBytes(output.path));
+  REQUIRE(fileBytes == bytes);
+}
+
+TEST_CASE("CompileSession::compileToMemory with invalid MLIR",
+          "[CompileSession][error]") {
+  FUSILLI_REQUIRE_ASSIGN(auto *context, CompileContext::create());
+  REQUIRE(context != nullptr);
+  FUSILLI_REQUIRE_ASSIGN(auto session, context->createSession(kDefaultBackend));
+
+  ErrorOr<std::vector<uint8_t>> result =
+      session.compileToMemory("this is not valid MLIR syntax!");
+  REQUIRE(isError(result));
+  REQUIRE(ErrorObject(result).getCode() == ErrorCode::CompileFailure);
+}
+
 TEST_CASE("CompileSession::compile with custom flags",
           "[CompileSession][integration]") {
   // Get the shared compiler context and create a session.
@@ -0,0 +1,52 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+using namespace fusilli;
+
+TEST_CASE("CompileStatistics::parse extracts counters", "[CompileStatistics]") {
+  std::string json = R"({
+  "stream-aggregate": {
+    "execution": {
+      "transient-memory-size": 4096,
+      "dispatch-count": 3
+    },
+    "executables": {
+      "executable-count": 2
+    }
+  }
+})";
+  FUSILLI_REQUIRE_ASSIGN(CompileStatistics stats,
+                         CompileStatistics::parse(json));
+  REQUIRE(stats.dispatchCount == 3);
+  REQUIRE(stats.executableCount == 2);
+  REQUIRE(stats.transientMemorySize == 4096);
+}
+
+TEST_CASE("CompileStatistics::parse defaults optional counters",
+          "[CompileStatistics]") {
+  FUSILLI_REQUIRE_ASSIGN(CompileStatistics stats,
+                         CompileStatistics::parse(R"({"dispatch-count":1})"));
+  REQUIRE(stats == CompileStatistics{.dispatchCount = 1}); // C++20
+}
+
+TEST_CASE("CompileStatistics::parse rejects malformed dumps",
+          "[CompileStatistics]") {
+  REQUIRE(isError(CompileStatistics::parse("")));
+  REQUIRE(isError(CompileStatistics::parse(R"({"dispatch-count": "x"})")));
+
+  ErrorOr<CompileStatistics> stats =
+      CompileStatistics::parse(R"({"transient-memory-size": 0})");
+  REQUIRE(isError(stats));
+  REQUIRE(ErrorObject(stats).getCode() == ErrorCode::InvalidArgument);
+}
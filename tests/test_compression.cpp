@@ -0,0 +1,76 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_compression";
+
+TEST_CASE("isCompressedArtifact detects zstd frames", "[Compression]") {
+  std::vector<uint8_t> frame = {0x28, 0xB5, 0x2F, 0xFD, 0x00};
+  REQUIRE(isCompressedArtifact(frame));
+  REQUIRE(!isCompressedArtifact(std::span(frame).first(3)));
+  std::vector<uint8_t> vmfb = {0x20, 0x00, 0x00, 0x00, 'I', 'R', 'E', 'E'};
+  REQUIRE(!isCompressedArtifact(vmfb));
+}
+
+TEST_CASE("compressArtifact and decompressArtifact round trip",
+          "[Compression]") {
+  std::vector<uint8_t> bytes(1 << 20);
+  for (size_t i = 0; i < bytes.size(); ++i)
+    bytes[i] = static_cast<uint8_t>(i % 251);
+
+  if (!isArtifactCompressionAvailable()) {
+    ErrorOr<std::vector<uint8_t>> compressed = compressArtifact(bytes, 3);
+    REQUIRE(isError(compressed));
+    REQUIRE(ErrorObject(compressed).getCode() == ErrorCode::NotImplemented);
+    return;
+  }
+
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> compressed,
+                         compressArtifact(bytes, 3));
+  REQUIRE(isCompressedArtifact(compressed));
+  REQUIRE(compressed.size() < bytes.size());
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> decompressed,
+                         decompressArtifact(compressed));
+  REQUIRE(decompressed == bytes);
+
+  // Truncated frames are rejected rather than silently cut short.
+  REQUIRE(isError(
+      decompressArtifact(std::span(compressed).first(compressed.size() / 2))));
+}
+
+TEST_CASE("CacheFile::publish stores compressed contents", "[Compression]") {
+  if (!isArtifactCompressionAvailable())
+    return;
+  std::filesystem::path path = CacheFile::getPath(kGraphName, "artifact");
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(path.parent_path()); });
+
+  std::string content(4096, 'x');
+  FUSILLI_REQUIRE_OK(CacheFile::publish(path, content, /*level=*/3));
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> stored, readFileBytes(path));
+  REQUIRE(isCompressedArtifact(stored));
+  REQUIRE(stored.size() < content.size());
+
+  // Readers see the original contents.
+  FUSILLI_REQUIRE_ASSIGN(CacheFile file, CacheFile::open(path));
+  FUSILLI_REQUIRE_ASSIGN(std::string read, file.read());
+  REQUIRE(read == content);
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes, readArtifactBytes(path));
+  REQUIRE(std::string(bytes.begin(), bytes.end()) == content);
+}
@@ -70,6 +70,33 @@ TEST_CASE("ConvFPropAttr setters and getters", "[conv_fprop_attr]") {
   REQUIRE(attr.getY()->isVirtual() == false);
 }
 
+TEST_CASE("ConvFPropAttr scale setters and getters", "[conv_fprop_attr]") {
+  ConvFPropAttr attr;
+
+  REQUIRE(attr.getSCALE_X() == nullptr);
+  REQUIRE(attr.getSCALE_W() == nullptr);
+  REQUIRE(!attr.hasScales());
+
+  auto scaleX = std::make_shared<TensorAttr>(0.5f);
+  auto scaleW = std::make_shared<TensorAttr>(0.25f);
+  attr.setSCALE_X(scaleX).setSCALE_W(scaleW);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getSCALE_X() == scaleX);
+  REQUIRE(attr.getSCALE_W() == scaleW);
+  REQUIRE(attr.hasScales());
+}
+
+TEST_CASE("ConvFPropAttr lowering hint", "[conv_fprop_attr]") {
+  ConvFPropAttr attr;
+  REQUIRE(attr.getLoweringHint() == ConvFPropAttr::LoweringHint::AUTO);
+
+  attr.setLoweringHint(ConvFPropAttr::LoweringHint::WINOGRAD);
+  REQUIRE(attr.getLoweringHint() == ConvFPropAttr::LoweringHint::WINOGRAD);
+  REQUIRE(ConvFPropAttr::kLoweringHintToStr.at(attr.getLoweringHint()) ==
+          "WINOGRAD");
+}
+
 TEST_CASE("ConvFPropAttr setter templated overrides", "[conv_fprop_attr]") {
   ConvFPropAttr attr;
   std::vector<int64_t> strideVec = {1, 2};
@@ -238,3 +265,49 @@ TEST_CASE("ConvDGradAttr setter templated overrides", "[conv_dgrad_attr]") {
   REQUIRE(attr.getPadding() == paddingVec);
   REQUIRE(attr.getDilation() == dilationVec);
 }
+
+TEST_CASE("ConvTransposeAttr default constructor",
+          "[conv_transpose_attr]") {
+  ConvTransposeAttr attr;
+  REQUIRE(attr.getStride().empty());
+  REQUIRE(attr.getPadding().empty());
+  REQUIRE(attr.getDilation().empty());
+  REQUIRE(attr.getOutputPadding().empty());
+  REQUIRE(attr.getGroupCount() == 1);
+}
+
+TEST_CASE("ConvTransposeAttr setters and getters", "[conv_transpose_attr]") {
+  ConvTransposeAttr attr;
+  std::vector<int64_t> stride = {2, 2};
+  std::vector<int64_t> padding = {0, 1};
+  std::vector<int64_t> dilation = {1, 1};
+  std::vector<int64_t> outputPadding = {1, 0};
+
+  attr.setStride(stride)
+      .setPadding(padding)
+      .setDilation(dilation)
+      .setOutputPadding(outputPadding)
+      .setGroupCount(4);
+
+  REQUIRE(attr.getStride() == stride);
+  REQUIRE(attr.getPadding() == padding);
+  REQUIRE(attr.getDilation() == dilation);
+  REQUIRE(attr.getOutputPadding() == outputPadding);
+  REQUIRE(attr.getGroupCount() == 4);
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto w = std::make_shared<TensorAttr>(2.0f);
+  auto y = std::make_shared<TensorAttr>(3.0f);
+  attr.setX(x).setW(w).setY(y);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.outputs.size() == 1);
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getW() == w);
+  REQUIRE(attr.getY() == y);
+
+  // std::span should call the templated override.
+  std::span<int64_t> strideSpan(stride);
+  attr.setOutputPadding(strideSpan);
+  REQUIRE(attr.getOutputPadding() == stride);
+}
@@ -500,6 +500,47 @@ TEST_CASE("ConvFPropNode group count checks", "[conv_node]") {
   }
 }
 
+TEST_CASE("ConvFPropNode depthwise detection", "[conv_node]") {
+  Context ctx;
+  int64_t n = 8, c = 16, h = 16, w = 16, r = 3, s = 3;
+
+  auto makeNode = [&](int64_t k, int64_t fc) {
+    ConvFPropAttr attr;
+    attr.setPadding({1, 1}).setStride({1, 1}).setDilation({1, 1});
+    attr.setX(std::make_shared<TensorAttr>(
+                  TensorAttr()
+                      .setDim({n, c, h, w})
+                      .setStride({c * h * w, h * w, w, 1})
+                      .setName("X")))
+        .setW(std::make_shared<TensorAttr>(
+            TensorAttr()
+                .setDim({k, fc, r, s})
+                .setStride({fc * r * s, r * s, s, 1})
+                .setName("W")))
+        .setY(std::make_shared<TensorAttr>(TensorAttr().setName("Y")));
+    return ConvFPropNode(std::move(attr), ctx);
+  };
+
+  SECTION("A group per input channel is depthwise") {
+    ConvFPropNode node = makeNode(/*k=*/c, /*fc=*/1);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    REQUIRE(node.isDepthwise());
+    REQUIRE(node.getDepthwiseMultiplier() == 1);
+  }
+
+  SECTION("Depthwise with a channel multiplier") {
+    ConvFPropNode node = makeNode(/*k=*/4 * c, /*fc=*/1);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    REQUIRE(node.isDepthwise());
+    REQUIRE(node.getDepthwiseMultiplier() == 4);
+  }
+
+  SECTION("Grouped and dense convolutions are not depthwise") {
+    REQUIRE_FALSE(makeNode(/*k=*/c, /*fc=*/4).isDepthwise());
+    REQUIRE_FALSE(makeNode(/*k=*/c, /*fc=*/c).isDepthwise());
+  }
+}
+
 TEST_CASE("ConvWGradNode preValidateNode detects missing attributes",
           "[conv_wgrad_node]") {
   Context ctx;
@@ -792,6 +833,52 @@ TEST_CASE("ConvWGradNode postValidateNode dimension validation",
           "inferred based on input dimensions");
 }
 
+TEST_CASE("ConvWGradNode bias gradient inference and validation",
+          "[conv_wgrad_node]") {
+  Context ctx;
+  ConvWGradAttr attr;
+  int64_t n = 4, c = 8, h = 16, w = 16, k = 32, r = 3, s = 3;
+  attr.setPadding({1, 1}).setStride({1, 1}).setDilation({1, 1});
+
+  auto dyT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({n, k, h, w}).setName("DY"));
+  dyT->setStride(
+      generateStrideFromDim(dyT->getDim(), getContiguousStrideOrder(4)));
+  auto xT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({n, c, h, w}).setName("X"));
+  xT->setStride(
+      generateStrideFromDim(xT->getDim(), getContiguousStrideOrder(4)));
+  auto dwT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({k, c, r, s}).setName("DW"));
+  auto dbT = std::make_shared<TensorAttr>(TensorAttr().setName("DBIAS"));
+  attr.setDY(dyT).setX(xT).setDW(dwT).setDBIAS(dbT);
+  ctx.setIODataType(DataType::Float);
+
+  SECTION("DBIAS is inferred as [K] - pass") {
+    ConvWGradNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(dbT->getDim() == std::vector<int64_t>{k});
+    REQUIRE(dbT->getStride() == std::vector<int64_t>{1});
+    REQUIRE(dbT->getDataType() == DataType::Float);
+  }
+
+  SECTION("DBIAS of the wrong size - fail") {
+    dbT->setDim({c}).setStride({1});
+
+    ConvWGradNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "ConvWGrad bias gradient tensor DBIAS must be 1D with size equal "
+            "to the DY channel dimension");
+  }
+}
+
 TEST_CASE("ConvWGradNode group count checks", "[conv_wgrad_node]") {
   Context ctx;
   ConvWGradAttr attr;
@@ -1331,3 +1418,289 @@ TEST_CASE("ConvDGradNode group count checks", "[conv_dgrad_node]") {
         "to the numbers of input and outputs channels");
   }
 }
+
+TEST_CASE("ConvFPropNode scale checks", "[conv_node]") {
+  Context ctx;
+  ConvFPropAttr attr;
+
+  int64_t n = 4, c = 8, h = 16, w = 16, k = 32, r = 1, s = 1;
+  attr.setPadding({0, 0}).setStride({1, 1}).setDilation({1, 1});
+
+  auto xT = std::make_shared<TensorAttr>(
+      TensorAttr()
+          .setDim({n, c, h, w})
+          .setStride({c * h * w, h * w, w, 1})
+          .setDataType(DataType::Int8)
+          .setName("X"));
+  auto wT = std::make_shared<TensorAttr>(
+      TensorAttr()
+          .setDim({k, c, r, s})
+          .setStride({c * r * s, r * s, s, 1})
+          .setDataType(DataType::Int8)
+          .setName("W"));
+  auto scaleXT = std::make_shared<TensorAttr>(TensorAttr()
+                                                  .setDim({1, 1, 1, 1})
+                                                  .setStride({1, 1, 1, 1})
+                                                  .setName("scale_x"));
+  attr.setX(xT).setW(wT).setY(std::make_shared<TensorAttr>()).setSCALE_X(
+      scaleXT);
+  ctx.setIODataType(DataType::Half);
+
+  SECTION("Per output channel weight scale - pass") {
+    auto scaleWT = std::make_shared<TensorAttr>(TensorAttr()
+                                                    .setDim({1, k, 1, 1})
+                                                    .setStride({k, 1, 1, 1})
+                                                    .setName("scale_w"));
+    attr.setSCALE_W(scaleWT);
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+  }
+
+  SECTION("Per channel input scale - fail") {
+    auto badScaleXT = std::make_shared<TensorAttr>(TensorAttr()
+                                                       .setDim({1, c, 1, 1})
+                                                       .setStride({c, 1, 1, 1})
+                                                       .setName("scale_x"));
+    attr.setSCALE_X(badScaleXT);
+
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Conv scale tensor SCALE_X must be per tensor (all dims 1)");
+  }
+}
+
+TEST_CASE("ConvFPropNode 1D convolution", "[conv_node]") {
+  Context ctx;
+  ConvFPropAttr attr;
+
+  int64_t n = 4, c = 16, w = 128, k = 32, s = 3;
+  attr.setPadding({1}).setStride({2}).setDilation({1});
+
+  auto yT = std::make_shared<TensorAttr>();
+  attr.setX(std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({n, c, w})
+                                             .setStride({c * w, 1, c})
+                                             .setName("X"))) // NWC
+      .setW(std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({k, c, s})
+                                             .setStride({c * s, s, 1})
+                                             .setName("W")))
+      .setY(yT);
+
+  ConvFPropNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  REQUIRE(yT->getDim() == std::vector<int64_t>{n, k, w / 2});
+  // The output keeps the channels-last layout of X.
+  REQUIRE(yT->getStride() == std::vector<int64_t>{k * w / 2, 1, k});
+}
+
+TEST_CASE("ConvFPropNode lowering hint checks", "[conv_node]") {
+  Context ctx;
+  ConvFPropAttr attr;
+
+  int64_t n = 4, c = 8, h = 16, w = 16, k = 32, r = 3, s = 3;
+  attr.setPadding({1, 1}).setStride({1, 1}).setDilation({1, 1});
+  attr.setX(std::make_shared<TensorAttr>(
+                TensorAttr()
+                    .setDim({n, c, h, w})
+                    .setStride({c * h * w, h * w, w, 1})
+                    .setName("X")))
+      .setW(std::make_shared<TensorAttr>(
+          TensorAttr()
+              .setDim({k, c, r, s})
+              .setStride({c * r * s, r * s, s, 1})
+              .setName("W")))
+      .setY(std::make_shared<TensorAttr>());
+
+  SECTION("3x3 unit stride Winograd - pass") {
+    attr.setLoweringHint(ConvFPropAttr::LoweringHint::WINOGRAD);
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+
+  SECTION("Strided Winograd - fail") {
+    attr.setStride({2, 2}).setLoweringHint(
+        ConvFPropAttr::LoweringHint::WINOGRAD);
+    ConvFPropNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Conv lowering hint WINOGRAD requires a 3x3 filter with unit "
+            "stride and dilation");
+  }
+
+  SECTION("Strided im2col - pass") {
+    attr.setStride({2, 2}).setLoweringHint(
+        ConvFPropAttr::LoweringHint::IM2COL);
+    ConvFPropNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+
+  SECTION("Grouped im2col - fail") {
+    attr.setW(std::make_shared<TensorAttr>(
+                  TensorAttr()
+                      .setDim({k, c / 2, r, s})
+                      .setStride({c / 2 * r * s, r * s, s, 1})
+                      .setName("W")))
+        .setLoweringHint(ConvFPropAttr::LoweringHint::IM2COL);
+    ConvFPropNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Conv lowering hint IM2COL requires an ungrouped, unquantized 2D "
+            "convolution");
+  }
+}
+
+TEST_CASE("ConvTransposeNode getName and getType", "[conv_transpose_node]") {
+  Context ctx;
+  ConvTransposeAttr attr;
+  attr.setName("foo_conv_transpose");
+
+  ConvTransposeNode node(std::move(attr), ctx);
+  REQUIRE(node.getName() == "foo_conv_transpose");
+  REQUIRE(node.getType() == INode::Type::ConvTranspose);
+}
+
+TEST_CASE("ConvTransposeNode preValidateNode detects invalid attributes",
+          "[conv_transpose_node]") {
+  Context ctx;
+  ConvTransposeAttr attr;
+
+  int64_t n = 2, c = 8, h = 4, w = 4, k = 4, r = 3, s = 3;
+  attr.setPadding({1, 1}).setStride({2, 2}).setDilation({1, 1});
+  attr.setX(std::make_shared<TensorAttr>(
+                TensorAttr()
+                    .setDim({n, c, h, w})
+                    .setStride({c * h * w, h * w, w, 1})
+                    .setName("X")))
+      .setW(std::make_shared<TensorAttr>(
+          TensorAttr()
+              .setDim({c, k, r, s})
+              .setStride({k * r * s, r * s, s, 1})
+              .setName("W")))
+      .setY(std::make_shared<TensorAttr>());
+
+  SECTION("Stride missing") {
+    attr.setStride(std::vector<int64_t>{});
+    ConvTransposeNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "ConvTranspose stride not set");
+  }
+
+  SECTION("Output padding size mismatch") {
+    attr.setOutputPadding({1});
+    ConvTransposeNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "ConvTranspose output padding size does not match number of "
+            "spatial dimensions");
+  }
+
+  SECTION("Output padding not smaller than the stride") {
+    attr.setOutputPadding({1, 2});
+    ConvTransposeNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "ConvTranspose output padding must be non-negative and smaller "
+            "than either the stride or the dilation");
+  }
+
+  SECTION("Group count does not divide the input channels") {
+    attr.setGroupCount(3);
+    ConvTransposeNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "ConvTranspose group count must be greater than 0 and divide the "
+            "input channels");
+  }
+
+  SECTION("Filter does not match the input channels") {
+    attr.setW(std::make_shared<TensorAttr>(
+        TensorAttr()
+            .setDim({k, c, r, s})
+            .setStride({c * r * s, r * s, s, 1})
+            .setName("W")));
+    ConvTransposeNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "ConvTranspose weight tensor W dim 0 must match the input "
+            "channels");
+  }
+}
+
+TEST_CASE("ConvTransposeNode infers the output shape",
+          "[conv_transpose_node]") {
+  Context ctx;
+  ConvTransposeAttr attr;
+
+  int64_t n = 2, c = 8, h = 4, w = 4, k = 4, r = 3, s = 3;
+  auto yT = std::make_shared<TensorAttr>();
+  attr.setPadding({1, 1})
+      .setStride({2, 2})
+      .setDilation({1, 1})
+      .setX(std::make_shared<TensorAttr>(
+          TensorAttr()
+              .setDim({n, c, h, w})
+              .setStride({c * h * w, 1, c * w, c}) // NHWC
+              .setName("X")));
+  attr.setY(yT);
+
+  std::vector<int64_t> expected;
+  SECTION("Without output padding") {
+    attr.setW(std::make_shared<TensorAttr>(
+        TensorAttr()
+            .setDim({c, k, r, s})
+            .setStride({k * r * s, r * s, s, 1})
+            .setName("W")));
+    // (4 - 1) * 2 - 2 * 1 + (3 - 1) + 1
+    expected = {n, k, 7, 7};
+  }
+  SECTION("Grouped with output padding") {
+    attr.setW(std::make_shared<TensorAttr>(
+                  TensorAttr()
+                      .setDim({c, k / 2, r, s})
+                      .setStride({k / 2 * r * s, r * s, s, 1})
+                      .setName("W")))
+        .setOutputPadding({1, 0})
+        .setGroupCount(2);
+    expected = {n, k, 8, 7};
+  }
+
+  ConvTransposeNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  REQUIRE(yT->getDim() == expected);
+  // The output keeps the channels-last layout of X.
+  REQUIRE(yT->isChannelsLast());
+}
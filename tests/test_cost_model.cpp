@@ -0,0 +1,58 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <optional>
+
+using namespace fusilli;
+
+TEST_CASE("DeviceCostModel::getPeakFlops falls back to wider types",
+          "[DeviceCostModel]") {
+  DeviceCostModel device{.matrixFp16Flops = 4, .vectorFp32Flops = 1};
+  // No FP8 or FP32 matrix rates: FP8 and int8 run at the FP16 rate, FP32 at
+  // the vector rate.
+  REQUIRE(device.getPeakFlops(DataType::FP8E4M3FNUZ, /*matrix=*/true) == 4);
+  REQUIRE(device.getPeakFlops(DataType::Int8, /*matrix=*/true) == 4);
+  REQUIRE(device.getPeakFlops(DataType::BFloat16, /*matrix=*/true) == 4);
+  REQUIRE(device.getPeakFlops(DataType::Float, /*matrix=*/true) == 1);
+  REQUIRE(device.getPeakFlops(DataType::Half, /*matrix=*/false) == 1);
+
+  device.matrixFp8Flops = 8;
+  device.matrixFp32Flops = 2;
+  REQUIRE(device.getPeakFlops(DataType::FP8E5M2, /*matrix=*/true) == 8);
+  REQUIRE(device.getPeakFlops(DataType::Float, /*matrix=*/true) == 2);
+}
+
+TEST_CASE("getDeviceCostModel knows SKUs and architectures",
+          "[DeviceCostModel]") {
+  std::optional<DeviceCostModel> mi300x = getDeviceCostModel("mi300x");
+  REQUIRE(mi300x.has_value());
+  REQUIRE(mi300x->memoryBandwidth > 0);
+  REQUIRE(mi300x->matrixFp8Flops > mi300x->matrixFp16Flops);
+  REQUIRE(mi300x->matrixFp16Flops > mi300x->vectorFp32Flops);
+
+  // Architectures stand for their flagship SKU.
+  std::optional<DeviceCostModel> gfx942 = getDeviceCostModel("gfx942");
+  REQUIRE(gfx942.has_value());
+  REQUIRE(gfx942->matrixFp16Flops == mi300x->matrixFp16Flops);
+
+  REQUIRE(!getDeviceCostModel("").has_value());
+  REQUIRE(!getDeviceCostModel("not-a-gpu").has_value());
+}
+
+TEST_CASE("CostEstimate prefers measured times", "[CostEstimate]") {
+  CostEstimate estimate{.flops = 100, .bytes = 50};
+  estimate.time = std::chrono::microseconds(10);
+  REQUIRE(estimate.getArithmeticIntensity() == 2);
+  REQUIRE(estimate.getTime() == std::chrono::microseconds(10));
+  estimate.measuredTime = std::chrono::microseconds(25);
+  REQUIRE(estimate.getTime() == std::chrono::microseconds(25));
+  REQUIRE(CostEstimate().getArithmeticIntensity() == 0);
+}
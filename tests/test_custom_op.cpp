@@ -10,7 +10,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -221,6 +224,106 @@ TEST_CASE("CustomOp composition: built-in op -> custom op", "[custom_op]") {
   REQUIRE(result[3] == -12.0f);
 }
 
+TEST_CASE("CustomOp infers outputs from rules and callbacks", "[custom_op]") {
+  Graph g;
+  g.setName("custom_op_inference").setIODataType(DataType::Float);
+
+  auto a = g.tensor(TensorAttr()
+                        .setName("a")
+                        .setDim({2, 4})
+                        .setDynamicDims({0})
+                        .setStride({4, 1}));
+  auto b = g.tensor(TensorAttr().setName("b").setDim({1, 4}).setStride({4, 1}));
+
+  CustomOpAttr attr;
+  attr.setName("my_op")
+      .setMlir("mlir")
+      .setNumOutputs(3)
+      .setOutputSameAsInput(/*output=*/0, /*input=*/1)
+      .setOutputBroadcastOfInputs(/*output=*/1)
+      .setShapeInference(
+          [](std::span<const std::shared_ptr<TensorAttr>> ins,
+             std::span<const std::shared_ptr<TensorAttr>> outs) {
+            outs[2]
+                ->setDim({ins[0]->getDim()[1]})
+                .setStride({1})
+                .setDataType(DataType::Half);
+            return ok();
+          });
+
+  auto outs = g.customOp({a, b}, attr);
+  for (const auto &out : outs)
+    out->setOutput(true);
+  // Properties set by the caller are kept.
+  outs[0]->setDataType(DataType::Half);
+
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  REQUIRE(outs[0]->getDim() == std::vector<int64_t>{1, 4});
+  REQUIRE(outs[0]->getStride() == std::vector<int64_t>{4, 1});
+  REQUIRE(outs[0]->getDataType() == DataType::Half);
+  REQUIRE(!outs[0]->hasDynamicDims());
+
+  REQUIRE(outs[1]->getDim() == std::vector<int64_t>{2, 4});
+  REQUIRE(outs[1]->getDynamicDims() == std::vector<size_t>{0});
+  REQUIRE(outs[1]->getStride() == std::vector<int64_t>{4, 1});
+  REQUIRE(outs[1]->getDataType() == DataType::Float);
+
+  REQUIRE(outs[2]->getDim() == std::vector<int64_t>{4});
+  REQUIRE(outs[2]->getDataType() == DataType::Half);
+}
+
+TEST_CASE("CustomOp error: output inferred from a missing input",
+          "[custom_op]") {
+  Graph g;
+  g.setName("error_rule_input").setIODataType(DataType::Float);
+
+  auto a =
+      g.tensor(TensorAttr().setName("a").setDim({4}).setStride({1}).setDataType(
+          DataType::Float));
+
+  CustomOpAttr attr;
+  attr.setName("bad_op")
+      .setMlir("mlir")
+      .setNumOutputs(1)
+      .setOutputSameAsInput(/*output=*/0, /*input=*/1);
+
+  auto outs = g.customOp({a}, attr);
+  outs[0]->setOutput(true);
+
+  auto status = g.validate();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  REQUIRE(status.getMessage() ==
+          "CustomOp output 0 is inferred from a non-existent input");
+}
+
+TEST_CASE("CustomOp error: external kernel object not found",
+          "[custom_op]") {
+  Graph g;
+  g.setName("error_external_kernel").setIODataType(DataType::Float);
+
+  auto a =
+      g.tensor(TensorAttr().setName("a").setDim({4}).setStride({1}).setDataType(
+          DataType::Float));
+
+  CustomOpAttr attr;
+  attr.setName("bad_op")
+      .setExternalKernel({.objectPath = "/nonexistent/kernel.co",
+                          .entryPoint = "kernel"})
+      .setNumOutputs(1)
+      .setOutputSameAsInput(/*output=*/0, /*input=*/0);
+
+  auto outs = g.customOp({a}, attr);
+  outs[0]->setOutput(true);
+
+  auto status = g.validate();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::FileSystemFailure);
+  REQUIRE(status.getMessage() ==
+          "CustomOp external kernel object not found: '/nonexistent/kernel.co'");
+}
+
 TEST_CASE("CustomOp error: missing MLIR", "[custom_op]") {
   Graph g;
   g.setName("error_no_mlir").setIODataType(DataType::Float);
@@ -0,0 +1,93 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static ErrorObject failInScope(const EventTag &tag, bool fail) {
+  detail::EventScope eventScope(EventPhase::Execute, tag);
+  FUSILLI_RETURN_ERROR_IF(fail, ErrorCode::RuntimeFailure, "failed");
+  return ok();
+}
+
+TEST_CASE("EventLog records events into a ring", "[EventLog]") {
+  EventLog &log = EventLog::get();
+  auto cleanup = ScopeExit([&] { log.disable(); });
+  log.enable(/*capacity=*/2);
+
+  EventTag tag = EventTag::of("00000000000000ff", {2, 3, 4, 5, 6});
+  REQUIRE(tag.fingerprint == 0xff);
+  REQUIRE(tag.rank == 5);
+  REQUIRE(tag.dims == std::array<int64_t, kEventMaxDims>{3, 4, 5, 6});
+
+  REQUIRE(isOk(failInScope(tag, /*fail=*/false)));
+  REQUIRE(isError(failInScope(tag, /*fail=*/true)));
+  {
+    // Errors of a phase are attributed to the enclosing phase as well.
+    detail::EventScope outer(EventPhase::Compile, tag);
+    REQUIRE(isError(failInScope(tag, /*fail=*/true)));
+  }
+
+  // The ring keeps the two newest of four events.
+  REQUIRE(log.getRecordedCount() == 4);
+  std::vector<EventRecord> events = log.getEvents();
+  REQUIRE(events.size() == 2);
+  REQUIRE(events[0].phase == EventPhase::Execute);
+  REQUIRE(events[0].code == ErrorCode::RuntimeFailure);
+  REQUIRE(events[1].phase == EventPhase::Compile);
+  REQUIRE(events[1].code == ErrorCode::RuntimeFailure);
+  REQUIRE(events[1].fingerprint == 0xff);
+  REQUIRE(events[1].durationNs >= events[0].durationNs);
+
+  std::string line = EventLog::format(events[0]);
+  REQUIRE(line.find(" execute fingerprint=00000000000000ff") !=
+          std::string::npos);
+  REQUIRE(line.find(" dims=[...,3,4,5,6] ") != std::string::npos);
+  REQUIRE(line.ends_with("us RUNTIME_FAILURE"));
+
+  SECTION("written logs read back") {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "fusilli_test_event_log.bin";
+    auto removeFile = ScopeExit([&] { std::filesystem::remove(path); });
+    FUSILLI_REQUIRE_OK(log.write(path));
+    FUSILLI_REQUIRE_ASSIGN(EventLogContents contents, EventLog::read(path));
+    REQUIRE(contents.recorded == 4);
+    REQUIRE(contents.events.size() == 2);
+    REQUIRE(EventLog::format(contents.events[1]) ==
+            EventLog::format(events[1]));
+  }
+
+  SECTION("disabled logs record nothing") {
+    log.disable();
+    REQUIRE(isError(failInScope(tag, /*fail=*/true)));
+    REQUIRE(log.getRecordedCount() == 4);
+  }
+}
+
+TEST_CASE("EventLog::read rejects other files", "[EventLog]") {
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "fusilli_test_not_event_log";
+  auto removeFile = ScopeExit([&] { std::filesystem::remove(path); });
+  {
+    std::ofstream file(path);
+    file << "not an event log";
+  }
+  ErrorOr<EventLogContents> contents = EventLog::read(path);
+  REQUIRE(isError(contents));
+  REQUIRE(ErrorObject(contents).getCode() == ErrorCode::InvalidArgument);
+}
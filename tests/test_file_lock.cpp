@@ -0,0 +1,72 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <utility>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_file_lock";
+
+TEST_CASE("FileLock::acquire creates and removes the lock file",
+          "[FileLock]") {
+  std::filesystem::path path = CacheFile::getPath(kGraphName, ".lock");
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(path.parent_path()); });
+
+  {
+    FUSILLI_REQUIRE_ASSIGN(FileLock lock, FileLock::acquire(path));
+    REQUIRE(lock.getPath() == path);
+    REQUIRE(std::filesystem::exists(path));
+
+    SECTION("move construction transfers the lock") {
+      FileLock moved(std::move(lock));
+      REQUIRE(moved.getPath() == path);
+      REQUIRE(std::filesystem::exists(path));
+    }
+  }
+
+  // Released locks leave neither the lock file nor its (empty) directory.
+  REQUIRE(!std::filesystem::exists(path));
+  REQUIRE(!std::filesystem::exists(path.parent_path()));
+}
+
+TEST_CASE("FileLock::acquire waits for the current holder", "[FileLock]") {
+  std::filesystem::path path = CacheFile::getPath(kGraphName, ".lock");
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup =
+      ScopeExit([&] { std::filesystem::remove_all(path.parent_path()); });
+
+  std::atomic<bool> released = false;
+  std::atomic<bool> acquiredAfterRelease = false;
+  std::thread waiter;
+  {
+    FUSILLI_REQUIRE_ASSIGN(FileLock lock, FileLock::acquire(path));
+    waiter = std::thread([&] {
+      ErrorOr<FileLock> other = FileLock::acquire(path);
+      acquiredAfterRelease = isOk(other) && released;
+    });
+    // Give the waiter ample opportunity to (incorrectly) take the lock.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    released = true;
+  }
+  waiter.join();
+  REQUIRE(acquiredAfterRelease);
+  REQUIRE(!std::filesystem::exists(path));
+}
@@ -8,7 +8,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <cmath>
+#include <cstddef>
 #include <limits>
+#include <span>
+#include <vector>
 
 using namespace fusilli;
 
@@ -292,3 +295,65 @@ TEST_CASE("Float16 has more precision but smaller range than BFloat16",
   // Float16 has better precision for small values
   REQUIRE(float16Err <= bfloat16Err);
 }
+
+TEST_CASE("Bulk conversions match element-wise conversions",
+          "[Float16][BFloat16]") {
+  // Sizes around the vector widths exercise both the SIMD body and the
+  // scalar tail.
+  const size_t sizes[] = {0, 1, 7, 8, 9, 16, 17, 33, 1001};
+  for (size_t size : sizes) {
+    std::vector<float> source(size);
+    for (size_t i = 0; i < size; ++i)
+      source[i] = (static_cast<float>(i) - 500.0f) * 1.37f;
+
+    std::vector<half> f16(size);
+    std::vector<float> fromF16(size);
+    REQUIRE(convert(std::span<const float>(source), std::span<half>(f16)));
+    REQUIRE(convert(std::span<const half>(f16), std::span<float>(fromF16)));
+    std::vector<bf16> bf(size);
+    std::vector<float> fromBF16(size);
+    REQUIRE(convert(std::span<const float>(source), std::span<bf16>(bf)));
+    REQUIRE(convert(std::span<const bf16>(bf), std::span<float>(fromBF16)));
+
+    for (size_t i = 0; i < size; ++i) {
+      REQUIRE(fromF16[i] == static_cast<float>(half(source[i])));
+      REQUIRE(fromBF16[i] == static_cast<float>(bf16(source[i])));
+    }
+  }
+}
+
+TEST_CASE("Bulk conversions reject mismatched sizes", "[Float16][BFloat16]") {
+  std::vector<float> source(8, 1.0f);
+  std::vector<half> f16(7);
+  std::vector<bf16> bf(9);
+  REQUIRE(!convert(std::span<const float>(source), std::span<half>(f16)));
+  REQUIRE(!convert(std::span<const float>(source), std::span<bf16>(bf)));
+}
+
+// =============================================================================
+// Float8 Tests
+// =============================================================================
+
+TEST_CASE("Float8 fromBits and toBits", "[Float8]") {
+  // 1.0 in each format: exponent bias 15 (E5M2), 7 (E4M3FN), 16 (E5M2FNUZ)
+  // and 8 (E4M3FNUZ).
+  REQUIRE(fp8e5m2::fromBits(0x3C).toFloat() == 1.0f);
+  REQUIRE(fp8e4m3fn::fromBits(0x38).toFloat() == 1.0f);
+  REQUIRE(fp8e5m2fnuz::fromBits(0x40).toFloat() == 1.0f);
+  REQUIRE(fp8e4m3fnuz::fromBits(0x40).toFloat() == 1.0f);
+
+  REQUIRE(fp8e5m2(1.0f).toBits() == 0x3C);
+  REQUIRE(fp8e4m3fn(1.0f).toBits() == 0x38);
+  REQUIRE(fp8e5m2fnuz(1.0f).toBits() == 0x40);
+  REQUIRE(fp8e4m3fnuz(1.0f).toBits() == 0x40);
+}
+
+TEST_CASE("Float8 conversion from float", "[Float8]") {
+  // Exactly representable values, including each format's largest finite.
+  for (float f : {0.0f, 0.5f, -2.0f, 3.0f, 448.0f})
+    REQUIRE(fp8e4m3fn(f).toFloat() == f);
+  for (float f : {0.0f, 0.5f, -2.0f, 3.0f, 57344.0f})
+    REQUIRE(fp8e5m2(f).toFloat() == f);
+  for (float f : {0.0f, 0.5f, -2.0f, 3.0f, 240.0f})
+    REQUIRE(fp8e4m3fnuz(f).toFloat() == f);
+}
@@ -10,14 +10,24 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -298,14 +308,145 @@ TEST_CASE("Graph `getCompiledArtifact` cache generation and invalidation",
   REQUIRE(reCompiled.value());
 }
 
-TEST_CASE("Graph `getCompiledArtifact` should not read cached items from "
+TEST_CASE("Graph `getCompiledArtifact` validates cache against the digest "
+          "sidecar",
+          "[graph]") {
+  Graph g = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+
+  std::optional<bool> reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(reCompiled.value());
+
+  // The digest sidecar records the cache key of the compiled artifact.
+  FUSILLI_REQUIRE_ASSIGN(std::string digest,
+                         g.readCompilationCacheFile(CachedAssetsType::Digest));
+  FUSILLI_REQUIRE_ASSIGN(std::string cacheKey,
+                         g.getKernelCacheKey(kDefaultBackend, generatedAsm));
+  REQUIRE(digest == cacheKey);
+
+  // A stale digest invalidates the cache.
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile digestFile,
+      CacheFile::open(g.getName(), IREE_COMPILE_DIGEST_FILENAME));
+  FUSILLI_REQUIRE_OK(digestFile.write("stale"));
+  reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(reCompiled.value());
+
+  // Recompilation restores the digest and the cache hits again.
+  reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(!reCompiled.value());
+}
+
+TEST_CASE("Graph production compile profile writes only the output",
+          "[graph]") {
+  // Bypass the kernel cache so only the per-graph assets are involved.
+  REQUIRE(setEnv("FUSILLI_DISABLE_KERNEL_CACHE", "1") == 0);
+  auto cleanup = ScopeExit([] { unsetEnv("FUSILLI_DISABLE_KERNEL_CACHE"); });
+
+  Graph g = testGraph(/*validate=*/true);
+  g.setName("production_compile_profile");
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  CompileOptions diagnostic;
+  CompileOptions production;
+  production.setProfile(CompileProfile::Production);
+
+  // The profile participates in the cache key.
+  FUSILLI_REQUIRE_ASSIGN(
+      std::string diagnosticKey,
+      g.getKernelCacheKey(kDefaultBackend, diagnostic, generatedAsm));
+  FUSILLI_REQUIRE_ASSIGN(
+      std::string productionKey,
+      g.getKernelCacheKey(kDefaultBackend, production, generatedAsm));
+  REQUIRE(diagnosticKey != productionKey);
+
+  std::optional<bool> reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_ASSIGN(auto vmfbPath,
+                         g.getCompiledArtifact(kDefaultBackend, production,
+                                               generatedAsm, /*remove=*/true,
+                                               &reCompiled));
+  REQUIRE(reCompiled.value());
+  REQUIRE(std::filesystem::exists(vmfbPath));
+  for (const char *fileName :
+       {IREE_COMPILE_INPUT_FILENAME, IREE_COMPILE_COMMAND_FILENAME,
+        IREE_COMPILE_STATISTICS_FILENAME, IREE_COMPILE_DIGEST_FILENAME})
+    REQUIRE(
+        !std::filesystem::exists(CacheFile::getPath(g.getName(), fileName)));
+  FUSILLI_REQUIRE_OK(g.readCompilationCacheFile(CachedAssetsType::Output));
+  REQUIRE(isError(g.readCompilationCacheFile(CachedAssetsType::Statistics)));
+
+  // The cache key kept in memory validates the cache.
+  reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, production,
+                                           generatedAsm, /*remove=*/true,
+                                           &reCompiled));
+  REQUIRE(!reCompiled.value());
+
+  // The diagnostic profile does not reuse the production assets.
+  reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, diagnostic,
+                                           generatedAsm, /*remove=*/true,
+                                           &reCompiled));
+  REQUIRE(reCompiled.value());
+  FUSILLI_REQUIRE_OK(g.readCompilationCacheFile(CachedAssetsType::Statistics));
+}
+
+TEST_CASE("Graph CPU performance profile participates in the cache key",
+          "[graph]") {
+  Graph g = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  CompileOptions defaults;
+  CompileOptions perf = CompileOptions::cpuPerformance();
+
+  FUSILLI_REQUIRE_ASSIGN(
+      std::string defaultKey,
+      g.getKernelCacheKey(Backend::CPU, defaults, generatedAsm));
+  FUSILLI_REQUIRE_ASSIGN(
+      std::string perfKey,
+      g.getKernelCacheKey(Backend::CPU, perf, generatedAsm));
+  REQUIRE(defaultKey != perfKey);
+
+  FUSILLI_REQUIRE_ASSIGN(std::string defaultFingerprint,
+                         g.getFingerprintCacheKey(Backend::CPU, defaults));
+  FUSILLI_REQUIRE_ASSIGN(std::string perfFingerprint,
+                         g.getFingerprintCacheKey(Backend::CPU, perf));
+  REQUIRE(defaultFingerprint != perfFingerprint);
+}
+
+TEST_CASE("Graph `getCompiledArtifact` should reuse kernel cache entries from "
           "other/previous Graph instances",
           "[graph]") {
   std::string generatedAsm;
+  std::string kernelCacheKey;
+  std::filesystem::path graphCacheDir;
+
+  // Artifacts are compiled with `remove = false` below, ensure cleanup happens
+  // even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    if (!graphCacheDir.empty())
+      std::filesystem::remove_all(graphCacheDir);
+    if (!kernelCacheKey.empty()) {
+      std::filesystem::path entryDir =
+          CacheFile::getKernelCachePath(kernelCacheKey, "").parent_path();
+      std::filesystem::remove_all(entryDir);
+      // Only removes the kernel cache root if no other entries remain.
+      std::error_code ec;
+      std::filesystem::remove(entryDir.parent_path(), ec);
+    }
+  });
+
   {
     Graph g = testGraph(/*validate=*/true);
+    graphCacheDir = CacheFile::getPath(g.getName(), "").parent_path();
 
     FUSILLI_REQUIRE_ASSIGN(generatedAsm, g.emitAsm());
+    FUSILLI_REQUIRE_ASSIGN(kernelCacheKey,
+                           g.getKernelCacheKey(kDefaultBackend, generatedAsm));
 
     // Cache should be empty.
     std::optional<bool> reCompiled = std::nullopt;
@@ -322,6 +463,22 @@ TEST_CASE("Graph `getCompiledArtifact` should not read cached items from "
     REQUIRE(!reCompiled.value());
   }
 
+  // Artifacts compiled with `remove = false` are published to the kernel
+  // cache.
+  REQUIRE(std::filesystem::exists(CacheFile::getKernelCachePath(
+      kernelCacheKey, IREE_COMPILE_OUTPUT_FILENAME)));
+  // Along with the content digest of the output, which fetches from the
+  // remote kernel cache verify.
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile outputDigest,
+      CacheFile::open(CacheFile::getKernelCachePath(
+          kernelCacheKey, IREE_COMPILE_OUTPUT_DIGEST_FILENAME)));
+  FUSILLI_REQUIRE_ASSIGN(std::string digest, outputDigest.read());
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> vmfbBytes,
+                         readArtifactBytes(CacheFile::getKernelCachePath(
+                             kernelCacheKey, IREE_COMPILE_OUTPUT_FILENAME)));
+  REQUIRE(digest == Hasher().update(vmfbBytes).hexDigest());
+
   Graph g = testGraph(/*validate=*/true);
 
   // Check that the generated asm matches the cache.
@@ -331,14 +488,1706 @@ TEST_CASE("Graph `getCompiledArtifact` should not read cached items from "
   FUSILLI_REQUIRE_ASSIGN(std::string asmContent, asmCache.read());
   REQUIRE(asmContent == generatedAsm);
 
-  // Nonetheless a new instance should regenerate cache.
+  // A new instance should reuse the kernel cache entry without compiling.
   std::optional<bool> reCompiled = std::nullopt;
-  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, generatedAsm,
+  FUSILLI_REQUIRE_ASSIGN(auto vmfbPath,
+                         g.getCompiledArtifact(kDefaultBackend, generatedAsm,
+                                               /*remove=*/true, &reCompiled));
+  REQUIRE(reCompiled.has_value());
+  REQUIRE(!reCompiled.value());
+  REQUIRE(vmfbPath == CacheFile::getKernelCachePath(
+                          kernelCacheKey, IREE_COMPILE_OUTPUT_FILENAME));
+
+  // Statistics remain readable for kernel cache hits.
+  FUSILLI_REQUIRE_OK(
+      g.readCompilationCacheFile(CachedAssetsType::Statistics));
+  FUSILLI_REQUIRE_ASSIGN(CompileStatistics stats, g.getCompileStatistics());
+  REQUIRE(stats.dispatchCount >= 1);
+
+  // Different assembly maps to a different key and must compile.
+  reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, generatedAsm + " ",
                                            /*remove=*/true, &reCompiled));
   REQUIRE(reCompiled.has_value());
   REQUIRE(reCompiled.value());
 }
 
+TEST_CASE("Graph `getKernelCacheKey` is stable and content-addressed",
+          "[graph]") {
+  Graph g1 = testGraph(/*validate=*/true);
+  Graph g2 = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_ASSIGN(std::string asm1, g1.emitAsm());
+  FUSILLI_REQUIRE_ASSIGN(std::string asm2, g2.emitAsm());
+
+  FUSILLI_REQUIRE_ASSIGN(std::string key1,
+                         g1.getKernelCacheKey(kDefaultBackend, asm1));
+  FUSILLI_REQUIRE_ASSIGN(std::string key2,
+                         g2.getKernelCacheKey(kDefaultBackend, asm2));
+  REQUIRE(key1.size() == 16);
+  REQUIRE(key1 == key2);
+
+  FUSILLI_REQUIRE_ASSIGN(std::string key3,
+                         g1.getKernelCacheKey(kDefaultBackend, asm1 + " "));
+  REQUIRE(key1 != key3);
+
+#if defined(FUSILLI_ENABLE_AMDGPU)
+  FUSILLI_REQUIRE_ASSIGN(std::string key4,
+                         g1.getKernelCacheKey(Backend::AMDGPU, asm1));
+  REQUIRE(key1 != key4);
+#endif
+}
+
+TEST_CASE("Graph validation eliminates duplicate and dead nodes", "[graph]") {
+  Graph g;
+  g.setName("cse_dce_graph");
+  g.setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+  auto x = g.tensor(TensorAttr().setName("x").setDim({4, 8}).setStride({8, 1}));
+  auto w = g.tensor(TensorAttr().setName("w").setDim({4, 8}).setStride({8, 1}));
+
+  // Two identical relus feeding different consumers are merged.
+  auto reluAttr = PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD);
+  auto a = g.pointwise(x, PointwiseAttr(reluAttr).setName("relu_a"));
+  auto b = g.pointwise(x, PointwiseAttr(reluAttr).setName("relu_b"));
+  g.pointwise(a, w, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD))
+      ->setName("sum")
+      .setOutput(true);
+  g.pointwise(b, w, PointwiseAttr().setMode(PointwiseAttr::Mode::MUL))
+      ->setName("product")
+      .setOutput(true);
+
+  // A chain only feeding a virtual output nothing consumes is dropped.
+  auto dead = g.pointwise(
+      x, PointwiseAttr().setMode(PointwiseAttr::Mode::SIGMOID_FWD));
+  g.pointwise(dead, PointwiseAttr().setMode(PointwiseAttr::Mode::TANH_FWD));
+
+  FUSILLI_REQUIRE_OK(g.validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+
+  auto count = [&](std::string_view needle) {
+    size_t n = 0;
+    for (size_t pos = generatedAsm.find(needle); pos != std::string::npos;
+         pos = generatedAsm.find(needle, pos + needle.size()))
+      ++n;
+    return n;
+  };
+  REQUIRE(count("torch.aten.relu ") == 1);
+  REQUIRE(count("torch.aten.sigmoid ") == 0);
+  REQUIRE(count("torch.aten.tanh ") == 0);
+  REQUIRE(count("torch.aten.add.Tensor ") == 1);
+  REQUIRE(count("torch.aten.mul.Tensor ") == 1);
+}
+
+TEST_CASE("Graph validation folds scalar-only subgraphs", "[graph]") {
+  Graph g;
+  g.setName("constant_folding_graph");
+  g.setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+  auto x = g.tensor(TensorAttr().setName("x").setDim({4, 8}).setStride({8, 1}));
+  auto scale = g.tensor(TensorAttr(2.0f));
+  auto bias = g.tensor(TensorAttr(0.5f));
+
+  // (2.0 + 0.5) * 2.0 folds into a single 5.0 constant.
+  auto sum = g.pointwise(scale, bias,
+                         PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  auto factor = g.pointwise(sum, scale,
+                            PointwiseAttr().setMode(PointwiseAttr::Mode::MUL));
+  g.pointwise(x, factor, PointwiseAttr().setMode(PointwiseAttr::Mode::MUL))
+      ->setName("y")
+      .setOutput(true);
+
+  FUSILLI_REQUIRE_OK(g.validate());
+  REQUIRE(factor->isScalar());
+  REQUIRE(factor->getScalarValue() == TensorAttr::scalar_t(5.0f));
+
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  REQUIRE(generatedAsm.find("torch.aten.add.Tensor") == std::string::npos);
+  REQUIRE(generatedAsm.find("dense<0x40A00000>") != std::string::npos);
+  // The folded inputs are no longer emitted.
+  REQUIRE(generatedAsm.find("dense<0x40000000>") == std::string::npos);
+  REQUIRE(generatedAsm.find("dense<0x3F000000>") == std::string::npos);
+}
+
+TEST_CASE("Graph runtime scalars are function arguments", "[graph]") {
+  auto buildGraph = [](float alphaValue) {
+    Graph g;
+    g.setName("runtime_scalar_graph");
+    g.setIODataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float)
+        .setComputeDataType(DataType::Float);
+    auto x =
+        g.tensor(TensorAttr().setName("x").setDim({4, 8}).setStride({8, 1}));
+    auto alpha =
+        g.tensor(TensorAttr(alphaValue).setName("alpha").setRuntimeScalar());
+    g.pointwise(x, alpha, PointwiseAttr().setMode(PointwiseAttr::Mode::MUL))
+        ->setName("y")
+        .setOutput(true);
+    return std::make_pair(std::move(g), alpha);
+  };
+
+  auto [g1, alpha1] = buildGraph(2.0f);
+  Graph g2 = buildGraph(3.0f).first;
+  FUSILLI_REQUIRE_OK(g1.validate());
+  FUSILLI_REQUIRE_OK(g2.validate());
+
+  // The value isn't baked into the assembly, so both graphs share a kernel.
+  FUSILLI_REQUIRE_ASSIGN(std::string asm1, g1.emitAsm());
+  FUSILLI_REQUIRE_ASSIGN(std::string asm2, g2.emitAsm());
+  REQUIRE(asm1 == asm2);
+  REQUIRE(asm1.find("torch.vtensor.literal") == std::string::npos);
+  REQUIRE(asm1.find("%alpha: !torch.vtensor<[1],f32>") != std::string::npos);
+  FUSILLI_REQUIRE_ASSIGN(std::string key1,
+                         g1.getFingerprintCacheKey(kDefaultBackend));
+  FUSILLI_REQUIRE_ASSIGN(std::string key2,
+                         g2.getFingerprintCacheKey(kDefaultBackend));
+  REQUIRE(key1 == key2);
+
+  // Runtime scalars are bound through the variant pack: y, then alpha and x.
+  REQUIRE(g1.getTensorUidCount() == 3);
+  FUSILLI_REQUIRE_ASSIGN(size_t alphaUid, g1.getTensorUid(alpha1));
+  REQUIRE(alphaUid == 1);
+
+  // Inlined scalars still specialize the kernel.
+  REQUIRE(alpha1->isInlinedScalar() == false);
+  REQUIRE(TensorAttr(2.0f).isInlinedScalar());
+
+  // Only scalars can be runtime scalars.
+  TensorAttr notScalar =
+      TensorAttr().setName("t").setDim({1}).setStride({1}).setRuntimeScalar();
+  REQUIRE(notScalar.validate().getCode() == ErrorCode::InvalidAttribute);
+}
+
+TEST_CASE("Graph constant data is embedded in the compiled graph",
+          "[graph]") {
+  auto toBytes = [](const std::vector<float> &values) {
+    std::vector<uint8_t> bytes(values.size() * sizeof(float));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    return bytes;
+  };
+  auto buildGraph = [&](const std::vector<float> &weights) {
+    Graph g;
+    g.setName("constant_data_graph");
+    g.setIODataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float)
+        .setComputeDataType(DataType::Float);
+    auto x =
+        g.tensor(TensorAttr().setName("x").setDim({2, 4}).setStride({4, 1}));
+    auto w = g.tensor(TensorAttr()
+                          .setName("w")
+                          .setDim({1, 4})
+                          .setStride({4, 1})
+                          .setConstantData(toBytes(weights)));
+    auto y =
+        g.pointwise(x, w, PointwiseAttr().setMode(PointwiseAttr::Mode::MUL));
+    y->setName("y").setOutput(true);
+    return std::make_tuple(std::move(g), x, w, y);
+  };
+
+  auto [g, x, w, y] = buildGraph({1.0f, 2.0f, 3.0f, 4.0f});
+  REQUIRE(w->isConstant());
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  // The weights are a literal instead of a function argument.
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  REQUIRE(generatedAsm.find("func.func @main(%y_: !torch.tensor<[2,4],f32>, "
+                            "%x: !torch.vtensor<[2,4],f32>)") !=
+          std::string::npos);
+  REQUIRE(generatedAsm.find("%w = torch.vtensor.literal(dense<\"0x0000803F"
+                            "000000400000404000008040\"> : tensor<1x4xf32>) "
+                            ": !torch.vtensor<[1,4],f32>") !=
+          std::string::npos);
+
+  // Only y and x are bound through the variant pack.
+  REQUIRE(g.getTensorUidCount() == 2);
+  REQUIRE(isError(g.getTensorUid(w)));
+
+  // Each set of weights has its own fingerprint.
+  Graph other = std::get<0>(buildGraph({1.0f, 2.0f, 3.0f, 5.0f}));
+  FUSILLI_REQUIRE_OK(other.validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string fp1, g.getFingerprint());
+  FUSILLI_REQUIRE_ASSIGN(std::string fp2, other.getFingerprint());
+  REQUIRE(fp1 != fp2);
+
+  // Constant data survives serialization.
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes, g.serialize());
+  FUSILLI_REQUIRE_ASSIGN(std::unique_ptr<Graph> restored,
+                         Graph::deserialize(bytes));
+  restored->setName("constant_data_graph");
+  FUSILLI_REQUIRE_OK(restored->validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string fp3, restored->getFingerprint());
+  REQUIRE(fp3 == fp1);
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(g.compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(auto xBuf,
+                         allocateBufferOfType(handle, x, DataType::Float, 2.0));
+  FUSILLI_REQUIRE_ASSIGN(auto yBuf,
+                         allocateBufferOfType(handle, y, DataType::Float, 0.0));
+  FUSILLI_REQUIRE_ASSIGN(auto wBuf,
+                         allocateBufferOfType(handle, w, DataType::Float, 0.0));
+
+  // Binding the embedded tensor is an error.
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {{x, xBuf}, {y, yBuf}, {w, wBuf}};
+  REQUIRE(isError(g.execute(handle, variantPack, nullptr)));
+
+  variantPack.erase(w);
+  FUSILLI_REQUIRE_OK(g.execute(handle, variantPack, nullptr));
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  REQUIRE(result == std::vector<float>{2.0f, 4.0f, 6.0f, 8.0f, 2.0f, 4.0f,
+                                       6.0f, 8.0f});
+
+  SECTION("The data must hold exactly the tensor's elements") {
+    auto [bad, bx, bw, by] = buildGraph({1.0f, 2.0f, 3.0f});
+    auto status = bad.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Constant data of tensor 'w' has 12 bytes, expected 16");
+  }
+}
+
+TEST_CASE("Graph reads and writes padded strides in place", "[graph]") {
+  Graph g;
+  g.setName("padded_stride_graph");
+  g.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  // `x` is a slice `[:, :3]` of a [2, 4] tensor, and `z` is written into one.
+  auto x = g.tensor(TensorAttr().setName("x").setDim({2, 3}).setStride({4, 1}));
+  auto y = g.tensor(TensorAttr().setName("y").setDim({2, 3}).setStride({3, 1}));
+  auto z = g.pointwise(x, y, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  z->setName("z").setStride({4, 1}).setOutput(true);
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  // The arguments are the padded storage, sliced in the function body.
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  REQUIRE(generatedAsm.find("func.func @main(%z_: !torch.tensor<[2,4],f32>, "
+                            "%x_storage: !torch.vtensor<[2,4],f32>, "
+                            "%y: !torch.vtensor<[2,3],f32>)") !=
+          std::string::npos);
+  REQUIRE(generatedAsm.find("%x = torch.aten.slice.Tensor %x_storage") !=
+          std::string::npos);
+  REQUIRE(generatedAsm.find("%z_padded = torch.aten.slice_scatter "
+                            "%z_storage, %z") != std::string::npos);
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  FUSILLI_REQUIRE_OK(g.compile(handle, /*remove=*/true));
+  REQUIRE(x->getStorageDim() == std::vector<int64_t>{2, 4});
+  FUSILLI_REQUIRE_ASSIGN(
+      Buffer xBuf,
+      Buffer::allocate(handle, castToSizeT(x->getStorageDim()),
+                       std::vector<float>{1, 2, 3, -1, 4, 5, 6, -1}));
+  FUSILLI_REQUIRE_ASSIGN(auto yBuf,
+                         allocateBufferOfType(handle, y, DataType::Float, 1.0));
+  FUSILLI_REQUIRE_ASSIGN(
+      Buffer zBuf, Buffer::allocate(handle, castToSizeT(z->getStorageDim()),
+                                    std::vector<float>(8, -1.0f)));
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {x, std::make_shared<Buffer>(std::move(xBuf))},
+          {y, yBuf},
+          {z, std::make_shared<Buffer>(std::move(zBuf))},
+      };
+  FUSILLI_REQUIRE_OK(g.execute(handle, variantPack, nullptr));
+
+  // The padding of `z` is left untouched.
+  std::vector<float> result;
+  FUSILLI_REQUIRE_OK(variantPack.at(z)->read(handle, result));
+  REQUIRE(result == std::vector<float>{2, 3, 4, -1, 5, 6, 7, -1});
+}
+
+TEST_CASE("Graph parameters are read from the handle's archives",
+          "[graph]") {
+  auto buildGraph = [](const std::string &key) {
+    Graph g;
+    g.setName("parameter_graph");
+    g.setIODataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float)
+        .setComputeDataType(DataType::Float);
+    auto x =
+        g.tensor(TensorAttr().setName("x").setDim({2, 4}).setStride({4, 1}));
+    auto w = g.tensor(TensorAttr()
+                          .setName("w")
+                          .setDim({1, 4})
+                          .setStride({4, 1})
+                          .setParameter(key));
+    auto y =
+        g.pointwise(x, w, PointwiseAttr().setMode(PointwiseAttr::Mode::MUL));
+    y->setName("y").setOutput(true);
+    return std::make_tuple(std::move(g), x, w, y);
+  };
+
+  auto [g, x, w, y] = buildGraph("layer0.w");
+  REQUIRE(w->isConstant());
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  // The weights are loaded from a global instead of a function argument.
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  REQUIRE(generatedAsm.find("func.func @main(%y_: !torch.tensor<[2,4],f32>, "
+                            "%x: !torch.vtensor<[2,4],f32>)") !=
+          std::string::npos);
+  REQUIRE(generatedAsm.find(
+              "util.global private @\"model::layer0.w\" = "
+              "#stream.parameter.named<\"model\"::\"layer0.w\"> : "
+              "tensor<1x4xf32>") != std::string::npos);
+  REQUIRE(generatedAsm.find("%w_param = util.global.load "
+                            "@\"model::layer0.w\" : tensor<1x4xf32>") !=
+          std::string::npos);
+
+  // Only y and x are bound through the variant pack.
+  REQUIRE(g.getTensorUidCount() == 2);
+  REQUIRE(isError(g.getTensorUid(w)));
+
+  // Each parameter has its own fingerprint.
+  Graph other = std::get<0>(buildGraph("layer1.w"));
+  FUSILLI_REQUIRE_OK(other.validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string fp1, g.getFingerprint());
+  FUSILLI_REQUIRE_ASSIGN(std::string fp2, other.getFingerprint());
+  REQUIRE(fp1 != fp2);
+
+  // Parameters survive serialization.
+  FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes, g.serialize());
+  FUSILLI_REQUIRE_ASSIGN(std::unique_ptr<Graph> restored,
+                         Graph::deserialize(bytes));
+  restored->setName("parameter_graph");
+  FUSILLI_REQUIRE_OK(restored->validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string fp3, restored->getFingerprint());
+  REQUIRE(fp3 == fp1);
+
+  SECTION("Loading needs a parameter archive on the handle") {
+    FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+    auto status = g.compile(handle, /*remove=*/true);
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotFound);
+  }
+
+  SECTION("Keys are emitted as quoted strings") {
+    auto [bad, bx, bw, by] = buildGraph("layer\"0");
+    auto status = bad.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+}
+
+TEST_CASE("Graph in-place outputs overwrite their input", "[graph]") {
+  auto makeGraph = [](Graph &g) {
+    g.setName("in_place_graph");
+    g.setIODataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float)
+        .setComputeDataType(DataType::Float);
+    auto x =
+        g.tensor(TensorAttr().setName("x").setDim({4, 8}).setStride({8, 1}));
+    auto b =
+        g.tensor(TensorAttr().setName("b").setDim({1, 8}).setStride({8, 1}));
+    auto sum =
+        g.pointwise(x, b, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+    auto y = g.pointwise(
+        sum, PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD));
+    y->setName("y").setOutput(true);
+    return std::make_tuple(x, b, sum, y);
+  };
+
+  SECTION("The output is written into the input's buffer") {
+    Graph g;
+    auto [x, b, sum, y] = makeGraph(g);
+    y->setInPlace(x);
+    FUSILLI_REQUIRE_OK(g.validate());
+
+    FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+    REQUIRE(generatedAsm.find("func.func @main(%b: "
+                              "!torch.vtensor<[1,8],f32>, %x_: "
+                              "!torch.tensor<[4,8],f32>)") !=
+            std::string::npos);
+    REQUIRE(generatedAsm.find("%x = torch.copy.to_vtensor %x_ : "
+                              "!torch.vtensor<[4,8],f32>") !=
+            std::string::npos);
+    REQUIRE(generatedAsm.find("torch.overwrite.tensor.contents %y overwrites "
+                              "%x_") != std::string::npos);
+
+    // Only the inputs are bound: b, then x.
+    REQUIRE(g.getTensorUidCount() == 2);
+    REQUIRE(isError(g.getTensorUid(y)));
+
+    // In-place outputs participate in the fingerprint.
+    Graph outOfPlace;
+    makeGraph(outOfPlace);
+    FUSILLI_REQUIRE_OK(outOfPlace.validate());
+    FUSILLI_REQUIRE_ASSIGN(std::string fp1, g.getFingerprint());
+    FUSILLI_REQUIRE_ASSIGN(std::string fp2, outOfPlace.getFingerprint());
+    REQUIRE(fp1 != fp2);
+  }
+
+  SECTION("The input must have the dims of the output") {
+    Graph g;
+    auto [x, b, sum, y] = makeGraph(g);
+    y->setInPlace(b);
+    auto status = g.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "In-place tensor 'y' must have the dims, stride and data type of "
+            "'b'");
+  }
+
+  SECTION("Only graph inputs can be overwritten") {
+    Graph g;
+    auto [x, b, sum, y] = makeGraph(g);
+    sum->setName("sum");
+    y->setInPlace(sum);
+    auto status = g.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "In-place tensor 'y' is written into "
+                                   "'sum', which is not a non-scalar graph "
+                                   "input");
+  }
+
+  SECTION("An input is overwritten by at most one output") {
+    Graph g;
+    auto [x, b, sum, y] = makeGraph(g);
+    auto z = g.pointwise(
+        sum, PointwiseAttr().setMode(PointwiseAttr::Mode::TANH_FWD));
+    z->setName("z").setOutput(true);
+    y->setInPlace(x);
+    z->setInPlace(x);
+    auto status = g.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'x' is written into by more than one in-place output");
+  }
+}
+
+// Raw bytes of `values`, as `TensorAttr::setConstantData()` takes them.
+static std::vector<uint8_t> floatBytes(const std::vector<float> &values) {
+  std::vector<uint8_t> bytes(values.size() * sizeof(float));
+  std::memcpy(bytes.data(), values.data(), bytes.size());
+  return bytes;
+}
+
+TEST_CASE("Graph validation folds BatchNorm into ConvFProp", "[graph]") {
+  // The filter and statistics must be embedded for the fold to apply, as
+  // constant contents bound at execution are unknown when compiling.
+  for (bool isEmbedded : {true, false}) {
+    Graph g;
+    g.setName("conv_batchnorm_fold_graph");
+    g.setIODataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float)
+        .setComputeDataType(DataType::Float);
+    auto x = g.tensor(TensorAttr()
+                          .setName("x")
+                          .setDim({2, 4, 8, 8})
+                          .setStride({256, 64, 8, 1}));
+    auto constant = [&](TensorAttr t, size_t volume) {
+      if (isEmbedded)
+        t.setConstantData(floatBytes(std::vector<float>(volume, 1.0f)));
+      else
+        t.setConstant();
+      return g.tensor(t);
+    };
+    auto w = constant(
+        TensorAttr().setName("w").setDim({8, 4, 1, 1}).setStride({4, 1, 1, 1}),
+        32);
+    auto conv = g.convFProp(x, w,
+                            ConvFPropAttr()
+                                .setStride({1, 1})
+                                .setPadding({0, 0})
+                                .setDilation({1, 1})
+                                .setName("conv"));
+    auto mean =
+        constant(TensorAttr().setName("mean").setDim({8}).setStride({1}), 8);
+    auto var =
+        constant(TensorAttr().setName("var").setDim({8}).setStride({1}), 8);
+    auto [y, savedMean, savedInvVariance] =
+        g.batchnorm(conv, nullptr, nullptr, mean, var,
+                    BatchnormAttr()
+                        .setForwardPhase(NormFwdPhase::INFERENCE)
+                        .setEpsilon(g.tensor(TensorAttr(1e-5f)))
+                        .setMomentum(g.tensor(TensorAttr(0.1f)))
+                        .setName("bn"));
+    y->setName("y").setOutput(true);
+
+    FUSILLI_REQUIRE_OK(g.validate());
+    FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+    auto contains = [&](const std::string &text) {
+      return generatedAsm.find(text) != std::string::npos;
+    };
+    if (isEmbedded) {
+      // The convolution reads the folded constants and produces y.
+      REQUIRE(!contains("torch.aten.native_batch_norm"));
+      REQUIRE(contains("%bn_FOLDED_BIAS = torch.vtensor.literal"));
+      REQUIRE(contains("%y_conv_perm = torch.aten.convolution %x_conv_perm, "
+                       "%bn_FOLDED_W_conv_perm, %bn_FOLDED_BIAS"));
+      REQUIRE(g.getTensor("w") == nullptr);
+      REQUIRE(g.getTensor("mean") == nullptr);
+    } else {
+      REQUIRE(contains("torch.aten.native_batch_norm"));
+      REQUIRE(contains("%bias_conv = torch.constant.none"));
+    }
+  }
+}
+
+TEST_CASE("Graph BatchNorm fold computes the filter and bias on the host",
+          "[graph]") {
+  constexpr int64_t k = 8, c = 4;
+  std::vector<float> weights(k * c), scales(k), biases(k), means(k), vars(k);
+  for (int64_t o = 0; o < k; ++o) {
+    for (int64_t i = 0; i < c; ++i)
+      weights[o * c + i] = static_cast<float>(o * c + i) / 8.0f;
+    scales[o] = 0.5f + static_cast<float>(o);
+    biases[o] = static_cast<float>(o) - 2.0f;
+    means[o] = 0.25f * static_cast<float>(o);
+    vars[o] = 1.0f + static_cast<float>(o);
+  }
+  const float epsilon = 1e-5f;
+
+  Graph g;
+  g.setName("conv_batchnorm_fold_ops_graph");
+  g.setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+  auto x = g.tensor(TensorAttr()
+                        .setName("x")
+                        .setDim({2, c, 8, 8})
+                        .setStride({256, 64, 8, 1}));
+  auto w = g.tensor(TensorAttr()
+                        .setName("w")
+                        .setDim({k, c, 1, 1})
+                        .setStride({c, 1, 1, 1})
+                        .setConstantData(floatBytes(weights)));
+  auto conv = g.convFProp(x, w,
+                          ConvFPropAttr()
+                              .setStride({1, 1})
+                              .setPadding({0, 0})
+                              .setDilation({1, 1})
+                              .setName("conv"));
+  auto channelTensor = [&](const std::string &name,
+                           const std::vector<float> &values) {
+    return g.tensor(TensorAttr()
+                        .setName(name)
+                        .setDim({k})
+                        .setStride({1})
+                        .setConstantData(floatBytes(values)));
+  };
+  auto [y, savedMean, savedInvVariance] =
+      g.batchnorm(conv, channelTensor("scale", scales),
+                  channelTensor("bias", biases), channelTensor("mean", means),
+                  channelTensor("var", vars),
+                  BatchnormAttr()
+                      .setForwardPhase(NormFwdPhase::INFERENCE)
+                      .setEpsilon(g.tensor(TensorAttr(epsilon)))
+                      .setMomentum(g.tensor(TensorAttr(0.1f)))
+                      .setName("bn"));
+  y->setName("y").setOutput(true);
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  // The folded filter and bias hold W * k and BIAS - MEAN * k, with
+  // k = SCALE / sqrt(VAR + EPSILON), computed in the same order.
+  std::vector<float> foldedWeights(k * c), foldedBiases(k);
+  for (int64_t o = 0; o < k; ++o) {
+    double scale = 1.0 / std::sqrt(static_cast<double>(vars[o]) + epsilon);
+    scale *= scales[o];
+    for (int64_t i = 0; i < c; ++i)
+      foldedWeights[o * c + i] =
+          static_cast<float>(static_cast<double>(weights[o * c + i]) * scale);
+    foldedBiases[o] = static_cast<float>(static_cast<double>(biases[o]) -
+                                         static_cast<double>(means[o]) * scale);
+  }
+  auto foldedW = g.getTensor("bn_FOLDED_W");
+  auto foldedBias = g.getTensor("bn_FOLDED_BIAS");
+  REQUIRE(foldedW != nullptr);
+  REQUIRE(foldedBias != nullptr);
+  REQUIRE(*foldedW->getConstantData() == floatBytes(foldedWeights));
+  REQUIRE(*foldedBias->getConstantData() == floatBytes(foldedBiases));
+
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  auto contains = [&](const std::string &text) {
+    return generatedAsm.find(text) != std::string::npos;
+  };
+  // Only x is an argument; the former filter and per channel tensors are
+  // dropped, and no normalization or filter scaling runs per execution.
+  REQUIRE(contains("func.func @main(%y_: !torch.tensor<[2,8,8,8],f32>, "
+                   "%x: !torch.vtensor<[2,4,8,8],f32>)"));
+  for (const char *dropped : {"%w ", "%scale ", "%bias ", "%mean ", "%var "})
+    REQUIRE(!contains(dropped));
+  REQUIRE(!contains("torch.aten.native_batch_norm"));
+  REQUIRE(!contains("torch.aten.rsqrt"));
+  REQUIRE(!contains("torch.aten.mul.Tensor"));
+  REQUIRE(contains("torch.aten.convolution %x_conv_perm, "
+                   "%bn_FOLDED_W_conv_perm, %bn_FOLDED_BIAS"));
+}
+
+TEST_CASE("Graph validation fuses matmuls sharing an input", "[graph]") {
+  // Only embedded weights are concatenated, see `fuseHorizontalMatmuls()`.
+  for (bool isEmbedded : {true, false}) {
+    Graph g;
+    g.setName("horizontal_matmul_fusion_graph");
+    g.setIODataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float)
+        .setComputeDataType(DataType::Float);
+    auto x =
+        g.tensor(TensorAttr().setName("x").setDim({8, 16}).setStride({16, 1}));
+    std::vector<std::shared_ptr<TensorAttr>> ys;
+    std::vector<std::pair<std::string, int64_t>> projections = {
+        {"q", 16}, {"k", 8}, {"v", 8}};
+    for (const auto &[name, n] : projections) {
+      auto w = g.tensor(TensorAttr()
+                            .setName("w" + name)
+                            .setDim({16, n})
+                            .setStride({n, 1}));
+      if (isEmbedded)
+        w->setConstantData(std::vector<uint8_t>(16 * n * sizeof(float), 0));
+      auto attr = MatmulAttr().setName(name + "_proj");
+      auto y = g.matmul(x, w, attr);
+      y->setName(name).setOutput(true);
+      ys.push_back(y);
+    }
+
+    FUSILLI_REQUIRE_OK(g.validate());
+    FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+    auto count = [&](const std::string &op) {
+      size_t n = 0;
+      for (size_t pos = generatedAsm.find(op); pos != std::string::npos;
+           pos = generatedAsm.find(op, pos + 1))
+        n++;
+      return n;
+    };
+    // The outputs keep their dims either way.
+    REQUIRE(ys[0]->getDim() == std::vector<int64_t>{8, 16});
+    REQUIRE(ys[2]->getDim() == std::vector<int64_t>{8, 8});
+    if (isEmbedded) {
+      REQUIRE(count("torch.aten.matmul") == 1);
+      REQUIRE(count("torch.aten.cat") == 1);
+      REQUIRE(count("torch.aten.slice.Tensor") == 3);
+      // Only x and the three outputs are bound through the variant pack.
+      REQUIRE(g.getTensorUidCount() == 4);
+    } else {
+      REQUIRE(count("torch.aten.matmul") == 3);
+      REQUIRE(count("torch.aten.cat") == 0);
+      REQUIRE(g.getTensorUidCount() == 7);
+    }
+  }
+}
+
+TEST_CASE("Graph compile options participate in cache keys", "[graph]") {
+  Graph g = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  FUSILLI_REQUIRE_ASSIGN(std::string defaultKey,
+                         g.getKernelCacheKey(kDefaultBackend, generatedAsm));
+  FUSILLI_REQUIRE_ASSIGN(std::string defaultFingerprintKey,
+                         g.getFingerprintCacheKey(kDefaultBackend));
+
+  CompileOptions options;
+  options.setOptLevel("O1");
+  FUSILLI_REQUIRE_ASSIGN(
+      std::string optionsKey,
+      g.getKernelCacheKey(kDefaultBackend, options, generatedAsm));
+  FUSILLI_REQUIRE_ASSIGN(std::string optionsFingerprintKey,
+                         g.getFingerprintCacheKey(kDefaultBackend, options));
+  REQUIRE(optionsKey != defaultKey);
+  REQUIRE(optionsFingerprintKey != defaultFingerprintKey);
+
+  // Attached options are used by the overloads without options.
+  g.setCompileOptions(options);
+  REQUIRE(g.getCompileOptions() == options);
+  FUSILLI_REQUIRE_ASSIGN(std::string attachedKey,
+                         g.getKernelCacheKey(kDefaultBackend, generatedAsm));
+  REQUIRE(attachedKey == optionsKey);
+}
+
+TEST_CASE("Graph `getCompiledArtifact` recompiles when compile options change",
+          "[graph]") {
+  Graph g = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+
+  std::optional<bool> reCompiled = std::nullopt;
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(reCompiled.value());
+
+  CompileOptions options;
+  options.setOptLevel("O1");
+  g.setCompileOptions(options);
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(reCompiled.value());
+  FUSILLI_REQUIRE_ASSIGN(std::string command,
+                         g.readCompilationCacheFile(CachedAssetsType::Command));
+  REQUIRE(command.find("--iree-opt-level=O1") != std::string::npos);
+
+  FUSILLI_REQUIRE_OK(g.getCompiledArtifact(kDefaultBackend, generatedAsm,
+                                           /*remove=*/true, &reCompiled));
+  REQUIRE(!reCompiled.value());
+
+  // Passing options explicitly overrides the attached ones.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto artifactBytes,
+      g.compileToArtifact(kDefaultBackend, CompileOptions(), /*remove=*/true));
+  REQUIRE(!artifactBytes.empty());
+  FUSILLI_REQUIRE_ASSIGN(command,
+                         g.readCompilationCacheFile(CachedAssetsType::Command));
+  REQUIRE(command.find("--iree-opt-level=O1") == std::string::npos);
+}
+
+TEST_CASE("Graph `setTuningSpecAsm` threads the spec into compilation",
+          "[graph]") {
+  // A no-op tuning spec, unique to this test so its content-addressed file is
+  // ours to remove. IREE caches parsed tuning specs by path for the lifetime
+  // of the process, so only remove it at exit.
+  const std::string spec = R"(// test_graph tuning spec
+module attributes {transform.with_named_sequence} {
+  transform.named_sequence @__kernel_config(%arg0: !transform.any_op {transform.consumed})
+    -> !transform.any_op attributes {iree_codegen.tuning_spec_entrypoint} {
+    transform.yield %arg0 : !transform.any_op
+  }
+}
+)";
+  static std::filesystem::path specPath;
+  static auto cleanup = ScopeExit([] {
+    std::error_code ec;
+    std::filesystem::remove(specPath, ec);
+    std::filesystem::remove(specPath.parent_path(), ec);
+  });
+  specPath = CacheFile::getTuningSpecPath(Hasher().update(spec).hexDigest());
+
+  Graph g = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_ASSIGN(std::string untunedKey,
+                         g.getFingerprintCacheKey(kDefaultBackend));
+  g.setTuningSpecAsm(spec);
+  FUSILLI_REQUIRE_ASSIGN(std::string tunedKey,
+                         g.getFingerprintCacheKey(kDefaultBackend));
+  REQUIRE(tunedKey != untunedKey);
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto artifactBytes,
+      g.compileToArtifact(kDefaultBackend, /*remove=*/true));
+  REQUIRE(!artifactBytes.empty());
+  REQUIRE(std::filesystem::exists(specPath));
+  FUSILLI_REQUIRE_ASSIGN(std::string command,
+                         g.readCompilationCacheFile(CachedAssetsType::Command));
+  REQUIRE(command.find(specPath.filename().string()) != std::string::npos);
+}
+
+// Helper function to create a validated single conv graph with `padding`.
+static Graph testConvGraph(const std::string &name,
+                           const std::vector<int64_t> &padding,
+                           const std::string &xName = "x",
+                           const std::string &convName = "conv") {
+  Graph g;
+  g.setName(name);
+  g.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+  auto xT = g.tensor(TensorAttr()
+                         .setName(xName)
+                         .setDim({1, 8, 8, 8})
+                         .setStride({512, 64, 8, 1}));
+  auto wT = g.tensor(
+      TensorAttr().setName("w").setDim({8, 8, 1, 1}).setStride({8, 1, 1, 1}));
+  auto yT = g.convFProp(xT, wT,
+                        ConvFPropAttr()
+                            .setPadding(padding)
+                            .setStride({1, 1})
+                            .setDilation({1, 1})
+                            .setName(convName));
+  yT->setOutput(true);
+  FUSILLI_REQUIRE_OK(g.validate());
+  return g;
+}
+
+static Graph
+testConvLoweringGraph(ConvFPropAttr::LoweringHint hint,
+                      ConvFPropAttr::LoweringHint secondHint =
+                          ConvFPropAttr::LoweringHint::AUTO) {
+  Graph g;
+  g.setName("conv_lowering_graph");
+  g.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+  auto xT = g.tensor(TensorAttr()
+                         .setName("x")
+                         .setDim({1, 8, 8, 8})
+                         .setStride({512, 64, 8, 1}));
+  auto w1T = g.tensor(TensorAttr()
+                          .setName("w1")
+                          .setDim({8, 8, 3, 3})
+                          .setStride({72, 9, 3, 1}));
+  auto w2T = g.tensor(TensorAttr()
+                          .setName("w2")
+                          .setDim({8, 8, 3, 3})
+                          .setStride({72, 9, 3, 1}));
+  auto convAttr = [](ConvFPropAttr::LoweringHint h, const std::string &name) {
+    return ConvFPropAttr()
+        .setPadding({1, 1})
+        .setStride({1, 1})
+        .setDilation({1, 1})
+        .setLoweringHint(h)
+        .setName(name);
+  };
+  auto yT = g.convFProp(xT, w1T, convAttr(hint, "conv1"));
+  auto zT = g.convFProp(yT, w2T, convAttr(secondHint, "conv2"));
+  zT->setOutput(true);
+  return g;
+}
+
+TEST_CASE("Graph conv lowering hints map onto compile options", "[graph]") {
+  using LoweringHint = ConvFPropAttr::LoweringHint;
+  const std::string kPipelineFlag = "--iree-preprocessing-pass-pipeline=";
+
+  SECTION("AUTO leaves the options unchanged") {
+    Graph g = testConvLoweringGraph(LoweringHint::AUTO);
+    FUSILLI_REQUIRE_OK(g.validate());
+    FUSILLI_REQUIRE_ASSIGN(LoweringHint hint, g.getConvLoweringHint());
+    REQUIRE(hint == LoweringHint::AUTO);
+    FUSILLI_REQUIRE_ASSIGN(
+        CompileOptions options,
+        g.applyConvLoweringHint(Backend::CPU, CompileOptions()));
+    REQUIRE(options == CompileOptions());
+  }
+
+  SECTION("DIRECT disables implicit GEMM on AMDGPU only") {
+    Graph g = testConvLoweringGraph(LoweringHint::DIRECT);
+    FUSILLI_REQUIRE_OK(g.validate());
+    FUSILLI_REQUIRE_ASSIGN(
+        CompileOptions amdgpu,
+        g.applyConvLoweringHint(Backend::AMDGPU, CompileOptions()));
+    REQUIRE(amdgpu.getFlags() == std::vector<std::string>{
+                                     "--iree-codegen-llvmgpu-use-igemm=false"});
+    FUSILLI_REQUIRE_ASSIGN(
+        CompileOptions cpu,
+        g.applyConvLoweringHint(Backend::CPU, CompileOptions()));
+    REQUIRE(cpu.getFlags().empty());
+  }
+
+  SECTION("WINOGRAD and IM2COL extend the preprocessing pipeline") {
+    // The second convolution doesn't request a strategy and follows the
+    // first.
+    Graph winograd = testConvLoweringGraph(LoweringHint::WINOGRAD);
+    FUSILLI_REQUIRE_OK(winograd.validate());
+    FUSILLI_REQUIRE_ASSIGN(
+        CompileOptions options,
+        winograd.applyConvLoweringHint(Backend::CPU, CompileOptions()));
+    REQUIRE(options.getFlags() ==
+            std::vector<std::string>{
+                kPipelineFlag +
+                "builtin.module(util.func(iree-linalg-ext-convert-conv2d-to-"
+                "winograd{replace-all-convs=true}))"});
+
+    Graph im2col =
+        testConvLoweringGraph(LoweringHint::IM2COL, LoweringHint::IM2COL);
+    FUSILLI_REQUIRE_OK(im2col.validate());
+    FUSILLI_REQUIRE_ASSIGN(
+        options, im2col.applyConvLoweringHint(Backend::CPU, CompileOptions()));
+    REQUIRE(options.getFlags() ==
+            std::vector<std::string>{
+                kPipelineFlag + "builtin.module(util.func(iree-preprocessing-"
+                                "convert-conv2d-to-img2col))"});
+
+    // An explicitly set pipeline wins over the hint.
+    CompileOptions existing;
+    existing.setFlag(kPipelineFlag + "builtin.module(foo)");
+    FUSILLI_REQUIRE_ASSIGN(
+        options, im2col.applyConvLoweringHint(Backend::CPU, existing));
+    REQUIRE(options == existing);
+  }
+
+  SECTION("Hints participate in the fingerprint") {
+    Graph autoGraph = testConvLoweringGraph(LoweringHint::AUTO);
+    Graph winograd = testConvLoweringGraph(LoweringHint::WINOGRAD);
+    FUSILLI_REQUIRE_OK(autoGraph.validate());
+    FUSILLI_REQUIRE_OK(winograd.validate());
+    FUSILLI_REQUIRE_ASSIGN(std::string fpAuto, autoGraph.getFingerprint());
+    FUSILLI_REQUIRE_ASSIGN(std::string fpWinograd, winograd.getFingerprint());
+    REQUIRE(fpAuto != fpWinograd);
+  }
+
+  SECTION("Conflicting hints fail validation") {
+    Graph g =
+        testConvLoweringGraph(LoweringHint::WINOGRAD, LoweringHint::IM2COL);
+    ErrorObject status = g.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Conv lowering hint IM2COL of 'conv2' conflicts with WINOGRAD "
+            "requested by another convolution of the graph");
+  }
+}
+
+TEST_CASE("Graph buffer alignments map onto compile options", "[graph]") {
+  const std::string kAlignmentFlag =
+      "--iree-stream-resource-min-offset-alignment=";
+  auto makeGraph = [](Graph &g, size_t xAlignment, size_t outAlignment) {
+    g.setName("buffer_alignment_graph");
+    g.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+    auto x = g.tensor(TensorAttr()
+                          .setName("x")
+                          .setDim({4, 64})
+                          .setStride({64, 1})
+                          .setAlignment(xAlignment));
+    auto y = g.tensor(TensorAttr()
+                          .setName("y")
+                          .setDim({4, 64})
+                          .setStride({64, 1})
+                          .setAlignment(256));
+    auto out = g.pointwise(x, y,
+                           PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+    out->setName("out").setOutput(true).setAlignment(outAlignment);
+    FUSILLI_REQUIRE_OK(g.validate());
+  };
+
+  SECTION("The smallest declared alignment is passed on") {
+    Graph g;
+    makeGraph(g, 128, 256);
+    REQUIRE(g.getBufferAlignment() == 128);
+    CompileOptions options = g.applyBufferAlignment(CompileOptions());
+    REQUIRE(options.getFlags() ==
+            std::vector<std::string>{kAlignmentFlag + "128"});
+
+    // An explicitly set alignment wins.
+    CompileOptions existing;
+    existing.setFlag(kAlignmentFlag + "64");
+    REQUIRE(g.applyBufferAlignment(existing) == existing);
+  }
+
+  SECTION("Undeclared or default alignments leave the options unchanged") {
+    Graph undeclared;
+    makeGraph(undeclared, 256, 0);
+    REQUIRE(undeclared.getBufferAlignment() == 0);
+    REQUIRE(undeclared.applyBufferAlignment(CompileOptions()) ==
+            CompileOptions());
+
+    Graph small;
+    makeGraph(small, 16, 256);
+    REQUIRE(small.getBufferAlignment() == 16);
+    REQUIRE(small.applyBufferAlignment(CompileOptions()) == CompileOptions());
+  }
+}
+
+TEST_CASE("Graph `emitTuningSpecAsm` covers matmul lowering configs",
+          "[graph]") {
+  auto makeGraph = [](bool withConfig) {
+    Graph g;
+    g.setName("tuning_spec_graph");
+    g.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+    auto aT = g.tensor(
+        TensorAttr().setName("a").setDim({16, 256}).setStride({256, 1}));
+    auto bT = g.tensor(
+        TensorAttr().setName("b").setDim({256, 8}).setStride({8, 1}));
+    auto dT =
+        g.tensor(TensorAttr().setName("d").setDim({8, 8}).setStride({8, 1}));
+    MatmulAttr tuned = MatmulAttr().setName("tuned");
+    if (withConfig)
+      tuned.setTileSizes({16, 8, 0}, {0, 0, 64}, {64, 1, 1})
+          .setMmaIntrinsic("MFMA_F32_16x16x16_F16");
+    auto cT = g.matmul(aT, bT, tuned);
+    auto eT = g.matmul(cT, dT, MatmulAttr().setName("default"));
+    eT->setOutput(true);
+    FUSILLI_REQUIRE_OK(g.validate());
+    return g;
+  };
+
+  Graph plain = makeGraph(/*withConfig=*/false);
+  FUSILLI_REQUIRE_ASSIGN(std::optional<std::string> none,
+                         plain.emitTuningSpecAsm());
+  REQUIRE(!none.has_value());
+
+  Graph g = makeGraph(/*withConfig=*/true);
+  FUSILLI_REQUIRE_ASSIGN(std::optional<std::string> spec,
+                         g.emitTuningSpecAsm());
+  REQUIRE(spec.has_value());
+  auto contains = [&](std::string_view needle) {
+    return spec->find(needle) != std::string::npos;
+  };
+  // Only the matmul with a lowering config gets a matcher.
+  REQUIRE(contains("@match_tuned -> @apply_op_config"));
+  REQUIRE(!contains("@match_default"));
+  REQUIRE(contains(
+      "transform.iree.match.cast_compatible_type %lhs = tensor<16x256xf16>"));
+  REQUIRE(contains(
+      "transform.iree.match.cast_compatible_type %rhs = tensor<256x8xf16>"));
+  REQUIRE(contains(
+      "#iree_gpu.lowering_config<{workgroup = [16, 8, 0], reduction = [0, "
+      "0, 64], mma_kind = #iree_gpu.mma_layout<MFMA_F32_16x16x16_F16>}>"));
+  REQUIRE(contains("workgroup_size = [64, 1, 1] subgroup_size = 64"));
+
+  // Lowering configs participate in the fingerprint.
+  FUSILLI_REQUIRE_ASSIGN(std::string fpPlain, plain.getFingerprint());
+  FUSILLI_REQUIRE_ASSIGN(std::string fpTuned, g.getFingerprint());
+  REQUIRE(fpPlain != fpTuned);
+}
+
+TEST_CASE("Graph `getFingerprint` is structural", "[graph]") {
+  Graph unvalidated = testGraph(/*validate=*/false);
+  ErrorOr<std::string> notValidated = unvalidated.getFingerprint();
+  REQUIRE(isError(notValidated));
+  REQUIRE(ErrorObject(notValidated).getCode() == ErrorCode::NotValidated);
+
+  // Structurally identical graphs share a fingerprint.
+  Graph g1 = testConvGraph("fingerprint_graph", {0, 0});
+  Graph g2 = testConvGraph("fingerprint_graph", {0, 0});
+  FUSILLI_REQUIRE_ASSIGN(std::string fp1, g1.getFingerprint());
+  FUSILLI_REQUIRE_ASSIGN(std::string fp2, g2.getFingerprint());
+  REQUIRE(fp1.size() == 16);
+  REQUIRE(fp1 == fp2);
+
+  // Attributes participate.
+  Graph g3 = testConvGraph("fingerprint_graph", {1, 1});
+  FUSILLI_REQUIRE_ASSIGN(std::string fp3, g3.getFingerprint());
+  REQUIRE(fp1 != fp3);
+
+  // Names don't, as long as inputs keep their positional (sorted) order:
+  // "w" < "x" and "w" < "z", but "a" < "w".
+  Graph g4 =
+      testConvGraph("fingerprint_graph_renamed", {0, 0}, "z", "conv_renamed");
+  Graph g5 = testConvGraph("fingerprint_graph", {0, 0}, "a");
+  FUSILLI_REQUIRE_ASSIGN(std::string fp4, g4.getFingerprint());
+  FUSILLI_REQUIRE_ASSIGN(std::string fp5, g5.getFingerprint());
+  REQUIRE(fp1 == fp4);
+  REQUIRE(fp1 != fp5);
+
+  // Fingerprint cache keys additionally depend on the compile environment.
+  FUSILLI_REQUIRE_ASSIGN(std::string key1,
+                         g1.getFingerprintCacheKey(kDefaultBackend));
+  FUSILLI_REQUIRE_ASSIGN(std::string key2,
+                         g2.getFingerprintCacheKey(kDefaultBackend));
+  REQUIRE(key1 == key2);
+  REQUIRE(key1 != fp1);
+}
+
+TEST_CASE("Graph `estimateCost` follows node attributes and shapes",
+          "[graph]") {
+  auto makeGraph = [](bool validate) {
+    Graph g;
+    g.setName("estimate_cost_graph");
+    g.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+    auto aT = g.tensor(
+        TensorAttr().setName("a").setDim({64, 128}).setStride({128, 1}));
+    auto bT = g.tensor(
+        TensorAttr().setName("b").setDim({128, 32}).setStride({32, 1}));
+    auto cT = g.matmul(aT, bT, MatmulAttr().setName("matmul"));
+    auto reluT = g.pointwise(
+        cT, PointwiseAttr().setName("relu").setMode(
+                PointwiseAttr::Mode::RELU_FWD));
+    reluT->setOutput(true);
+    if (validate)
+      FUSILLI_REQUIRE_OK(g.validate());
+    return g;
+  };
+
+  Graph unvalidated = makeGraph(/*validate=*/false);
+  ErrorOr<CostEstimate> notValidated =
+      unvalidated.estimateCost(DeviceCostModel());
+  REQUIRE(isError(notValidated));
+  REQUIRE(ErrorObject(notValidated).getCode() == ErrorCode::NotValidated);
+
+  Graph g = makeGraph(/*validate=*/true);
+  // Compute bound: 2 * 64 * 32 * 128 matmul operations at 1 GFLOP/s, plus
+  // 64 * 32 relu operations at half that.
+  DeviceCostModel device{.matrixFp16Flops = 1e9,
+                         .vectorFp32Flops = 0.5e9,
+                         .memoryBandwidth = 1e12,
+                         .launchLatency = std::chrono::microseconds(1)};
+  FUSILLI_REQUIRE_ASSIGN(CostEstimate estimate, g.estimateCost(device));
+  REQUIRE(estimate.flops == 2.0 * 64 * 32 * 128 + 64 * 32);
+  // The inputs and the output in f16; the intermediate stays on chip.
+  REQUIRE(estimate.bytes == (64 * 128 + 128 * 32 + 64 * 32) * 2);
+  REQUIRE(estimate.time == std::chrono::microseconds(1) +
+                               std::chrono::nanoseconds(524288 + 4096));
+  REQUIRE(!estimate.measuredTime.has_value());
+  REQUIRE(estimate.getTime() == estimate.time);
+
+  // Memory bound: the bytes at 1 GB/s.
+  device.memoryBandwidth = 1e9;
+  device.matrixFp16Flops = 1e15;
+  device.vectorFp32Flops = 1e15;
+  FUSILLI_REQUIRE_ASSIGN(estimate, g.estimateCost(device));
+  REQUIRE(estimate.time == std::chrono::microseconds(1) +
+                               std::chrono::nanoseconds(estimate.bytes));
+
+  // Known targets use their datasheet rates, unknown ones are an error.
+  FUSILLI_REQUIRE_ASSIGN(CostEstimate mi300x, g.estimateCost("mi300x"));
+  FUSILLI_REQUIRE_ASSIGN(CostEstimate gfx942, g.estimateCost("gfx942"));
+  REQUIRE(mi300x.time == gfx942.time);
+  ErrorOr<CostEstimate> unknown = g.estimateCost("not-a-gpu");
+  REQUIRE(isError(unknown));
+  REQUIRE(ErrorObject(unknown).getCode() == ErrorCode::NotImplemented);
+}
+
+TEST_CASE("Graph `compileToArtifact` reuses artifacts by fingerprint",
+          "[graph]") {
+  std::string fingerprintKey;
+  std::string kernelCacheKey;
+  std::filesystem::path graphCacheDir;
+
+  // Artifacts are compiled with `remove = false` below, ensure cleanup happens
+  // even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    if (!graphCacheDir.empty())
+      std::filesystem::remove_all(graphCacheDir);
+    std::error_code ec;
+    if (!fingerprintKey.empty()) {
+      std::filesystem::path aliasPath =
+          CacheFile::getKernelCacheAliasPath(fingerprintKey);
+      std::filesystem::remove(aliasPath, ec);
+      std::filesystem::remove(aliasPath.parent_path(), ec);
+    }
+    if (!kernelCacheKey.empty()) {
+      std::filesystem::path entryDir =
+          CacheFile::getKernelCachePath(kernelCacheKey, "").parent_path();
+      std::filesystem::remove_all(entryDir, ec);
+      // Only removes the kernel cache root if no other entries remain.
+      std::filesystem::remove(entryDir.parent_path(), ec);
+    }
+  });
+
+  std::vector<uint8_t> artifact;
+  {
+    Graph g = testGraph(/*validate=*/true);
+    graphCacheDir = CacheFile::getPath(g.getName(), "").parent_path();
+    FUSILLI_REQUIRE_ASSIGN(fingerprintKey,
+                           g.getFingerprintCacheKey(kDefaultBackend));
+    FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+    FUSILLI_REQUIRE_ASSIGN(kernelCacheKey,
+                           g.getKernelCacheKey(kDefaultBackend, generatedAsm));
+
+    FUSILLI_REQUIRE_ASSIGN(
+        artifact, g.compileToArtifact(kDefaultBackend, /*remove=*/false));
+    REQUIRE(!artifact.empty());
+
+    // An in-process fingerprint hit returns the same artifact.
+    FUSILLI_REQUIRE_ASSIGN(
+        auto again, g.compileToArtifact(kDefaultBackend, /*remove=*/false));
+    REQUIRE(again == artifact);
+  }
+
+  // The alias maps the fingerprint key to the kernel cache key.
+  FUSILLI_REQUIRE_ASSIGN(
+      CacheFile alias,
+      CacheFile::open(CacheFile::getKernelCacheAliasPath(fingerprintKey)));
+  FUSILLI_REQUIRE_ASSIGN(std::string aliasContent, alias.read());
+  REQUIRE(aliasContent == kernelCacheKey);
+
+  // A new instance resolves the alias without compiling, and the kernel cache
+  // assets backing it are readable.
+  Graph g = testGraph(/*validate=*/true);
+  FUSILLI_REQUIRE_ASSIGN(auto reused,
+                         g.compileToArtifact(kDefaultBackend, /*remove=*/true));
+  REQUIRE(reused == artifact);
+  FUSILLI_REQUIRE_ASSIGN(std::string digest,
+                         g.readCompilationCacheFile(CachedAssetsType::Digest));
+  REQUIRE(digest == kernelCacheKey);
+}
+
+TEST_CASE("Graph `compileToArtifact` shares artifacts between graphs that "
+          "differ only in names",
+          "[graph]") {
+  std::string fingerprintKey;
+  std::string kernelCacheKey;
+  std::vector<std::filesystem::path> graphCacheDirs;
+
+  // Artifacts are compiled with `remove = false` below, ensure cleanup happens
+  // even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    std::error_code ec;
+    for (const auto &dir : graphCacheDirs)
+      std::filesystem::remove_all(dir, ec);
+    if (!fingerprintKey.empty()) {
+      std::filesystem::path aliasPath =
+          CacheFile::getKernelCacheAliasPath(fingerprintKey);
+      std::filesystem::remove(aliasPath, ec);
+      std::filesystem::remove(aliasPath.parent_path(), ec);
+    }
+    if (!kernelCacheKey.empty()) {
+      std::filesystem::path entryDir =
+          CacheFile::getKernelCachePath(kernelCacheKey, "").parent_path();
+      std::filesystem::remove_all(entryDir, ec);
+      // Only removes the kernel cache root if no other entries remain.
+      std::filesystem::remove(entryDir.parent_path(), ec);
+    }
+  });
+
+  Graph g1 = testConvGraph("name_sharing_a", {0, 0});
+  graphCacheDirs.push_back(CacheFile::getPath(g1.getName(), "").parent_path());
+  FUSILLI_REQUIRE_ASSIGN(fingerprintKey,
+                         g1.getFingerprintCacheKey(kDefaultBackend));
+  FUSILLI_REQUIRE_ASSIGN(
+      std::vector<uint8_t> artifact1,
+      g1.compileToArtifact(kDefaultBackend, /*remove=*/false));
+  FUSILLI_REQUIRE_ASSIGN(kernelCacheKey,
+                         g1.readCompilationCacheFile(CachedAssetsType::Digest));
+
+  // Different graph, node and tensor names, same structure.
+  Graph g2 = testConvGraph("name_sharing_b", {0, 0}, "z", "conv_b");
+  graphCacheDirs.push_back(CacheFile::getPath(g2.getName(), "").parent_path());
+  FUSILLI_REQUIRE_ASSIGN(std::string fingerprintKey2,
+                         g2.getFingerprintCacheKey(kDefaultBackend));
+  REQUIRE(fingerprintKey2 == fingerprintKey);
+  resetKernelCacheStats();
+  FUSILLI_REQUIRE_ASSIGN(
+      std::vector<uint8_t> artifact2,
+      g2.compileToArtifact(kDefaultBackend, /*remove=*/true));
+  REQUIRE(artifact2 == artifact1);
+  KernelCacheStats stats = getKernelCacheStats();
+  REQUIRE(stats.hits == 1);
+  REQUIRE(stats.misses == 0);
+  FUSILLI_REQUIRE_ASSIGN(std::string digest2,
+                         g2.readCompilationCacheFile(CachedAssetsType::Digest));
+  REQUIRE(digest2 == kernelCacheKey);
+
+  // Nothing was generated in the per-graph directory of the second graph.
+  REQUIRE(!std::filesystem::exists(graphCacheDirs.back()));
+}
+
+TEST_CASE("compileAllToArtifacts reports per-graph results", "[graph]") {
+  Graph conv = testGraph(/*validate=*/true);
+  Graph unvalidated = testGraph(/*validate=*/false);
+  Graph small1 = testConvGraph("compile_all_small_1", {0, 0});
+  Graph small2 = testConvGraph("compile_all_small_2", {1, 1});
+  std::vector<Graph *> graphs = {&conv, &unvalidated, nullptr, &small1,
+                                 &small2};
+
+  std::vector<ErrorOr<std::vector<uint8_t>>> results = compileAllToArtifacts(
+      graphs, kDefaultBackend, /*parallelism=*/2, /*remove=*/true);
+  REQUIRE(results.size() == graphs.size());
+
+  FUSILLI_REQUIRE_OK(results[0]);
+  REQUIRE(!results[0]->empty());
+  REQUIRE(isError(results[1]));
+  REQUIRE(ErrorObject(results[1]).getCode() == ErrorCode::NotValidated);
+  REQUIRE(isError(results[2]));
+  REQUIRE(ErrorObject(results[2]).getCode() == ErrorCode::InvalidArgument);
+  FUSILLI_REQUIRE_OK(results[3]);
+  FUSILLI_REQUIRE_OK(results[4]);
+
+  // Results match compiling the graphs one at a time.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto serial, small1.compileToArtifact(kDefaultBackend, /*remove=*/true));
+  REQUIRE(serial == *results[3]);
+}
+
+TEST_CASE("Graph `compileToArtifact` shares concurrent compiles of the same "
+          "structure",
+          "[graph]") {
+  // Differently named graphs of identical structure, compiled on two threads:
+  // whichever starts second waits for the first and shares its artifact.
+  Graph first = testConvGraph("concurrent_compile_1", {0, 0});
+  Graph second = testConvGraph("concurrent_compile_2", {0, 0});
+  std::future<ErrorOr<std::vector<uint8_t>>> pending =
+      std::async(std::launch::async, [&] {
+        return first.compileToArtifact(kDefaultBackend, /*remove=*/true);
+      });
+  ErrorOr<std::vector<uint8_t>> secondResult =
+      second.compileToArtifact(kDefaultBackend, /*remove=*/true);
+  ErrorOr<std::vector<uint8_t>> firstResult = pending.get();
+  FUSILLI_REQUIRE_OK(firstResult);
+  FUSILLI_REQUIRE_OK(secondResult);
+  REQUIRE(!firstResult->empty());
+  REQUIRE(*firstResult == *secondResult);
+}
+
+TEST_CASE("compileAll loads every graph for execution", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  std::vector<ExecutableGraph> ctxs;
+  std::vector<Graph *> graphs;
+  for (const char *name : {"compile_all_a", "compile_all_b", "compile_all_c"}) {
+    ctxs.push_back(makeTestExecutableGraph(name));
+    graphs.push_back(ctxs.back().graph.get());
+  }
+
+  std::vector<ErrorObject> statuses =
+      compileAll(graphs, handle, /*parallelism=*/0, /*remove=*/true);
+  REQUIRE(statuses.size() == graphs.size());
+  for (auto &status : statuses)
+    FUSILLI_REQUIRE_OK(status);
+  for (auto &ctx : ctxs)
+    executeAndCheckGraph(handle, ctx);
+
+  // Failures are reported per graph.
+  Graph unvalidated = testGraph(/*validate=*/false);
+  std::vector<Graph *> invalid = {&unvalidated, nullptr};
+  statuses = compileAll(invalid, handle, /*parallelism=*/2, /*remove=*/true);
+  REQUIRE(statuses.size() == invalid.size());
+  REQUIRE(statuses[0].getCode() == ErrorCode::NotValidated);
+  REQUIRE(statuses[1].getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("CompileQueue compiles and loads graphs by priority", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  std::vector<ExecutableGraph> ctxs;
+  for (const char *name : {"compile_queue_a", "compile_queue_b",
+                           "compile_queue_c"})
+    ctxs.push_back(makeTestExecutableGraph(name));
+
+  std::vector<std::shared_future<ErrorOr<CompileQueueResult>>> futures;
+  {
+    CompileQueue queue(handle, {.parallelism = 2, .remove = true});
+    for (size_t i = 0; i < ctxs.size(); ++i)
+      futures.push_back(
+          queue.enqueue(*ctxs[i].graph, /*priority=*/static_cast<int>(i)));
+    queue.wait();
+    REQUIRE(queue.getPendingCount() == 0);
+  }
+  for (auto &future : futures) {
+    const ErrorOr<CompileQueueResult> &result = future.get();
+    FUSILLI_REQUIRE_OK(result);
+    REQUIRE(!result->fastCompiled);
+  }
+  for (auto &ctx : ctxs)
+    executeAndCheckGraph(handle, ctx);
+}
+
+TEST_CASE("CompileQueue compiles graphs over budget fast", "[graph]") {
+  // Bypass the kernel cache so the optimized artifact is never cached.
+  REQUIRE(setEnv("FUSILLI_DISABLE_KERNEL_CACHE", "1") == 0);
+  auto cleanup = ScopeExit([] { unsetEnv("FUSILLI_DISABLE_KERNEL_CACHE"); });
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  ExecutableGraph ctx = makeTestExecutableGraph("compile_queue_budget");
+  CompileQueue queue(handle, {.parallelism = 1, .remove = true});
+  std::shared_future<ErrorOr<CompileQueueResult>> future = queue.enqueue(
+      *ctx.graph, /*priority=*/0, /*budget=*/std::chrono::nanoseconds(0));
+  const ErrorOr<CompileQueueResult> &result = future.get();
+  FUSILLI_REQUIRE_OK(result);
+  REQUIRE(result->fastCompiled);
+  executeAndCheckGraph(handle, ctx);
+}
+
+TEST_CASE("compileModule loads every graph from one module", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  std::vector<ExecutableGraph> ctxs;
+  std::vector<Graph *> graphs;
+  for (const char *name : {"module_a", "module_b", "module_c"}) {
+    ctxs.push_back(makeTestExecutableGraph(name));
+    graphs.push_back(ctxs.back().graph.get());
+  }
+
+  // One module with a function per graph.
+  FUSILLI_REQUIRE_ASSIGN(std::string moduleAsm, emitModuleAsm(graphs));
+  REQUIRE(moduleAsm.find("module @module") ==
+          moduleAsm.rfind("module @module"));
+  for (size_t i = 0; i < graphs.size(); ++i)
+    REQUIRE(moduleAsm.find("func.func @" + getModuleEntryPoint(i) + "(") !=
+            std::string::npos);
+
+  FUSILLI_REQUIRE_OK(compileModule(graphs, handle, /*remove=*/true));
+  for (auto &ctx : ctxs)
+    executeAndCheckGraph(handle, ctx);
+
+  // Graphs must be validated, and a graph can't share its own module.
+  Graph unvalidated = testGraph(/*validate=*/false);
+  std::vector<Graph *> invalid = {graphs[0], &unvalidated};
+  REQUIRE(ErrorObject(emitModuleAsm(invalid)).getCode() ==
+          ErrorCode::NotValidated);
+  REQUIRE(graphs[0]->loadFromModule(handle, *graphs[0], "main_0").getCode() ==
+          ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("TrainingModule shares weight bindings between forward and backward",
+          "[graph]") {
+  int64_t n = 2, c = 4, h = 4, w = 4, k = 8;
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto makeFilter = [&](Graph &graph) {
+    return graph.tensor(TensorAttr()
+                            .setName("filter")
+                            .setDim({k, c, 1, 1})
+                            .setStride({c, 1, 1, 1}));
+  };
+  auto convAttr = [](auto attr) {
+    return attr.setPadding({0, 0}).setStride({1, 1}).setDilation({1, 1});
+  };
+
+  auto forward = std::make_shared<Graph>();
+  forward->setName("training_module_fprop");
+  forward->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto xT = forward->tensor(TensorAttr()
+                                .setName("x")
+                                .setDim({n, c, h, w})
+                                .setStride({c * h * w, h * w, w, 1}));
+  auto filterT = makeFilter(*forward);
+  auto yT = forward->convFProp(xT, filterT,
+                               convAttr(ConvFPropAttr().setName("fprop")));
+  yT->setName("y").setOutput(true);
+  FUSILLI_REQUIRE_OK(forward->validate());
+
+  auto backward = std::make_shared<Graph>();
+  backward->setName("training_module_dgrad");
+  backward->setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto dyT = backward->tensor(TensorAttr()
+                                  .setName("dy")
+                                  .setDim({n, k, h, w})
+                                  .setStride({k * h * w, h * w, w, 1}));
+  auto dxT = backward->convDGrad(dyT, makeFilter(*backward),
+                                 convAttr(ConvDGradAttr().setName("dgrad")));
+  dxT->setName("dx").setDim({n, c, h, w}).setOutput(true);
+  FUSILLI_REQUIRE_OK(backward->validate());
+
+  FUSILLI_REQUIRE_ASSIGN(
+      TrainingModule module,
+      TrainingModule::create(handle, forward, backward, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto filterBuf,
+      allocateBufferOfType(handle, filterT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_OK(module.bindShared("filter", filterBuf));
+  REQUIRE(module.getShared("filter") == filterBuf);
+
+  // With unit filters, the 1x1 fprop sums over c and the dgrad over k.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, xT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, yT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dyBuf, allocateBufferOfType(handle, dyT, DataType::Float, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto dxBuf, allocateBufferOfType(handle, dxT, DataType::Float, 0.0f));
+  FUSILLI_REQUIRE_OK(module.forward(handle, {{xT, xBuf}, {yT, yBuf}}));
+  FUSILLI_REQUIRE_OK(module.backward(handle, {{dyT, dyBuf}, {dxT, dxBuf}}));
+  std::vector<float> y, dx;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, y));
+  FUSILLI_REQUIRE_OK(dxBuf->read(handle, dx));
+  for (float val : y)
+    REQUIRE(val == static_cast<float>(c));
+  for (float val : dx)
+    REQUIRE(val == static_cast<float>(k));
+
+  // Shared tensors can't be rebound per execution, and every other tensor
+  // must be bound.
+  REQUIRE(
+      module.forward(handle, {{xT, xBuf}, {yT, yBuf}, {filterT, filterBuf}})
+          .getCode() == ErrorCode::VariantPackError);
+  REQUIRE(module.backward(handle, {{dyT, dyBuf}}).getCode() ==
+          ErrorCode::VariantPackError);
+  REQUIRE(module.bindShared("missing", filterBuf).getCode() ==
+          ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("warmup creates the default devices in the background",
+          "[graph]") {
+  Warmup warm = warmup({kDefaultBackend});
+  FUSILLI_REQUIRE_OK(warm.wait());
+  REQUIRE(warm.isDone());
+  REQUIRE(warm.getHandles().size() == 1);
+
+  // Handles created afterwards reuse the warmed up device.
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  REQUIRE(static_cast<iree_hal_device_t *>(handle) ==
+          static_cast<iree_hal_device_t *>(warm.getHandles()[0]));
+  auto ctx = makeTestExecutableGraph("warmup");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+  executeAndCheckGraph(handle, ctx);
+}
+
+TEST_CASE("autotune picks and records the fastest candidate", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("autotune");
+  // Attach options no other test uses, so the tuned record is ours alone.
+  ctx.graph->setCompileOptions(CompileOptions().setOptLevel("O2"));
+
+  FUSILLI_REQUIRE_ASSIGN(std::string fingerprintKey,
+                         ctx.graph->getFingerprintCacheKey(kDefaultBackend));
+  std::filesystem::path recordPath =
+      CacheFile::getKernelCacheTunedPath(fingerprintKey);
+  // The tuned record is persisted, ensure cleanup happens even if REQUIRE()
+  // fails.
+  auto cleanup = ScopeExit([&] {
+    std::error_code ec;
+    std::filesystem::remove(recordPath, ec);
+    std::filesystem::remove(
+        CacheFile::getKernelCacheMeasuredTimePath(fingerprintKey), ec);
+    std::filesystem::remove(recordPath.parent_path(), ec);
+    std::filesystem::remove(recordPath.parent_path().parent_path(), ec);
+  });
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}};
+
+  const std::vector<CompileOptions> candidates = {
+      CompileOptions().setOptLevel("O2"),
+      CompileOptions().setOptLevel("O1"),
+      // Fails to compile and is skipped.
+      CompileOptions().setFlag("--iree-not-a-real-flag"),
+  };
+  AutotuneConfig config;
+  config.warmupIterations = 1;
+  config.iterations = 2;
+  config.remove = true;
+  FUSILLI_REQUIRE_ASSIGN(
+      AutotuneResult result,
+      autotune(*ctx.graph, handle, candidates, variantPack, config));
+  REQUIRE(result.timings.size() == candidates.size());
+  REQUIRE(result.bestIndex < 2);
+  REQUIRE(result.timings[result.bestIndex].has_value());
+  REQUIRE(!result.timings[2].has_value());
+
+  // The graph is left loaded with the winner.
+  executeAndCheckGraph(handle, ctx);
+
+  // Structurally identical graphs with the same attached options pick the
+  // winner up.
+  auto other = makeTestExecutableGraph("autotune_other");
+  other.graph->setCompileOptions(CompileOptions().setOptLevel("O2"));
+  if (!checkKernelCacheDisabledEnv()) {
+    FUSILLI_REQUIRE_ASSIGN(
+        std::optional<CompileOptions> tuned,
+        other.graph->loadTunedCompileOptions(kDefaultBackend));
+    REQUIRE(tuned == std::optional(candidates[result.bestIndex]));
+    // So does the winner's timing.
+    FUSILLI_REQUIRE_ASSIGN(
+        std::optional<std::chrono::nanoseconds> measured,
+        other.graph->loadMeasuredTime(kDefaultBackend));
+    REQUIRE(measured == result.timings[result.bestIndex]);
+  }
+  FUSILLI_REQUIRE_OK(other.graph->compile(handle, /*remove=*/true));
+  executeAndCheckGraph(handle, other);
+}
+
+TEST_CASE("autotune rejects empty candidates", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("autotune_empty");
+  auto result = autotune(*ctx.graph, handle, std::span<const CompileOptions>(),
+                         /*variantPack=*/{});
+  REQUIRE(isError(result));
+  REQUIRE(ErrorObject(result).getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("Graph `compileAsync` compiles in the background", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("compile_async");
+
+  std::shared_future<ErrorObject> compiled =
+      ctx.graph->compileAsync(handle, /*remove=*/true);
+  REQUIRE(compiled.valid());
+
+  // Runtime methods report NotCompiled (rather than racing with the
+  // background compilation) until the future is ready.
+  if (compiled.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready) {
+    ErrorObject status = ctx.graph->execute(handle, {}, nullptr);
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotCompiled);
+  }
+
+  FUSILLI_REQUIRE_OK(compiled.get());
+  executeAndCheckGraph(handle, ctx);
+}
+
+TEST_CASE("Graph `compileTiered` executes before tiering up", "[graph]") {
+  // Bypass the kernel cache so no optimized artifact from another test lets
+  // compileTiered() skip the fast tier.
+  REQUIRE(setEnv("FUSILLI_DISABLE_KERNEL_CACHE", "1") == 0);
+  auto cleanup = ScopeExit([] { unsetEnv("FUSILLI_DISABLE_KERNEL_CACHE"); });
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("compile_tiered");
+
+  FUSILLI_REQUIRE_OK(ctx.graph->compileTiered(handle, /*remove=*/true));
+  // The fast artifact executes while the optimized one compiles.
+  executeAndCheckGraph(handle, ctx);
+
+  // Only one tiered compilation may be pending at a time.
+  ErrorObject status = ctx.graph->compileTiered(handle, /*remove=*/true);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+
+  FUSILLI_REQUIRE_ASSIGN(bool swapped,
+                         ctx.graph->tierUp(handle, /*wait=*/true));
+  REQUIRE(swapped);
+  executeAndCheckGraph(handle, ctx);
+
+  // Nothing left to swap in.
+  FUSILLI_REQUIRE_ASSIGN(swapped, ctx.graph->tierUp(handle, /*wait=*/true));
+  REQUIRE(!swapped);
+}
+
+TEST_CASE("Graph `compileLazy` compiles on first use", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  for (bool prefetch : {false, true}) {
+    auto ctx = makeTestExecutableGraph("compile_lazy");
+    FUSILLI_REQUIRE_OK(
+        ctx.graph->compileLazy(handle, /*remove=*/true, prefetch));
+    // Nothing is compiled nor loaded before the graph is used.
+    REQUIRE(handle.getExecutionStats().compiles == 0);
+
+    // Querying the workspace size compiles the graph, once.
+    executeAndCheckGraph(handle, ctx);
+    REQUIRE(handle.getExecutionStats().compiles == 1);
+    executeAndCheckGraph(handle, ctx);
+    REQUIRE(handle.getExecutionStats().compiles == 1);
+    handle.resetExecutionStats();
+  }
+
+  // Only validated graphs can be compiled lazily.
+  Graph g = testGraph(/*validate=*/false);
+  ErrorObject status = g.compileLazy(handle, /*remove=*/true);
+  REQUIRE(status.getCode() == ErrorCode::NotValidated);
+}
+
+TEST_CASE("Graph `getWorkspaceReport` attributes intermediates to nodes",
+          "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  Graph g;
+  g.setName("workspace_report_graph");
+  g.setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+  auto a =
+      g.tensor(TensorAttr().setName("a").setDim({32, 64}).setStride({64, 1}));
+  auto b =
+      g.tensor(TensorAttr().setName("b").setDim({64, 16}).setStride({16, 1}));
+  auto c = g.matmul(a, b, MatmulAttr().setName("matmul"));
+  c->setName("c");
+  auto reluAttr =
+      PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD).setName("relu");
+  auto d = g.pointwise(c, reluAttr);
+  d->setName("d").setOutput(true);
+  g.setMaxWorkspaceSize(size_t(1) << 30);
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  // The report describes the loaded artifact.
+  ErrorOr<WorkspaceReport> notCompiled = g.getWorkspaceReport();
+  REQUIRE(ErrorObject(notCompiled).getCode() == ErrorCode::NotCompiled);
+
+  FUSILLI_REQUIRE_OK(g.compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(WorkspaceReport report, g.getWorkspaceReport());
+  FUSILLI_REQUIRE_ASSIGN(std::optional<size_t> workspaceSize,
+                         g.getWorkspaceSize());
+  REQUIRE(report.workspaceSize == *workspaceSize);
+  // The workspace fits the cap with split reductions.
+  REQUIRE(!report.splitReductionDisabled);
+  // Only the matmul result is an intermediate, the relu result is an output.
+  REQUIRE(report.intermediates.size() == 1);
+  REQUIRE(report.intermediates[0].node == "matmul");
+  REQUIRE(report.intermediates[0].tensor == "c");
+  REQUIRE(report.intermediates[0].bytes == 32 * 16 * sizeof(float));
+  REQUIRE(report.getIntermediateBytes() == 32 * 16 * sizeof(float));
+  REQUIRE(report.toString().find("matmul -> c") != std::string::npos);
+}
+
+TEST_CASE("WorkspaceReport attributes the remainder to compiler scratch",
+          "[graph]") {
+  WorkspaceReport report;
+  report.workspaceSize = 1000;
+  report.intermediates = {{.node = "conv", .tensor = "y", .bytes = 600},
+                          {.node = "relu", .tensor = "z", .bytes = 100}};
+  REQUIRE(report.getIntermediateBytes() == 700);
+  REQUIRE(report.getCompilerScratchBytes() == 300);
+  // Fused intermediates take no workspace, so they may exceed it.
+  report.workspaceSize = 500;
+  REQUIRE(report.getCompilerScratchBytes() == 0);
+}
+
+TEST_CASE("Graph `compileAsync` reports compilation errors", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  Graph g = testGraph(/*validate=*/false);
+
+  ErrorObject status = g.compileAsync(handle, /*remove=*/true).get();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::NotValidated);
+}
+
 TEST_CASE("Graph `getCompiledArtifact` invalid input IR", "[graph]") {
   std::string graphName;
   {
@@ -380,6 +2229,31 @@ TEST_CASE("Graph `compileToArtifact` produces artifact without loading runtime",
   REQUIRE(!artifactBytes.empty());
 }
 
+TEST_CASE("Graph `setCompileInMemory` compiles without cache files",
+          "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("compile_in_memory");
+  ctx.graph->setCompileInMemory(true);
+
+  FUSILLI_REQUIRE_ASSIGN(
+      std::vector<uint8_t> artifactBytes,
+      ctx.graph->compileToArtifact(handle.getBackend(), /*remove=*/true));
+  REQUIRE(!artifactBytes.empty());
+
+  // Nothing was written to the per-graph cache directory. The CLI compile
+  // backend always goes through files.
+  if (!checkCompileBackendEnv()) {
+    REQUIRE(!std::filesystem::exists(
+        CacheFile::getPath(ctx.graph->getName(), "").parent_path()));
+    REQUIRE(isError(
+        ctx.graph->readCompilationCacheFile(CachedAssetsType::Output)));
+  }
+
+  FUSILLI_REQUIRE_OK(
+      ctx.graph->loadFromArtifact(handle, std::move(artifactBytes)));
+  executeAndCheckGraph(handle, ctx);
+}
+
 TEST_CASE("Graph `loadFromArtifact` after compileToArtifact enables execute",
           "[graph]") {
   FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
@@ -422,6 +2296,161 @@ TEST_CASE("Graph `execute` requires prior workspace size query", "[graph]") {
           "workspace allocation and execution");
 }
 
+TEST_CASE("Graph with static shapes has a constant workspace size",
+          "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("static_workspace_size");
+  REQUIRE(!ctx.graph->hasDynamicWorkspaceSize());
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+
+  // The size is known after compilation and doesn't depend on the bound
+  // buffers.
+  REQUIRE(!ctx.graph->hasDynamicWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+  REQUIRE(workspaceSize.has_value());
+  executeAndCheckGraph(handle, ctx);
+}
+
+TEST_CASE("Graph `compile` fills a CompileReport", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("compile_report");
+
+  CompileReport first;
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true, &first));
+  // Another test (or process) may have published the artifact already.
+  if (!first.cacheHit) {
+    REQUIRE(first.asmEmission.count() > 0);
+    REQUIRE(first.compilerPipeline.count() > 0);
+  }
+  REQUIRE(first.vmContextCreation.count() > 0);
+  REQUIRE(first.total() >= first.vmContextCreation);
+
+  // The second compilation hits the in-process cache.
+  CompileReport second;
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true, &second));
+  REQUIRE(second.cacheHit);
+  REQUIRE(second.compilerParse.count() == 0);
+  REQUIRE(second.compilerPipeline.count() == 0);
+  REQUIRE(second.vmContextCreation.count() > 0);
+
+  // Artifacts compiled without loading them leave the runtime phases at 0.
+  CompileReport artifactOnly;
+  FUSILLI_REQUIRE_ASSIGN(auto artifactBytes,
+                         ctx.graph->compileToArtifact(handle.getBackend(),
+                                                      /*remove=*/true,
+                                                      &artifactOnly));
+  REQUIRE(!artifactBytes.empty());
+  REQUIRE(artifactOnly.cacheHit);
+  REQUIRE(artifactOnly.artifactRead.count() > 0);
+  REQUIRE(artifactOnly.vmContextCreation.count() == 0);
+  REQUIRE(artifactOnly.workspaceQuery.count() == 0);
+  executeAndCheckGraph(handle, ctx);
+}
+
+TEST_CASE("Loaded graphs are accounted in Handle::getMemoryStats",
+          "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  {
+    auto ctx = makeTestExecutableGraph("memory_stats");
+    FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+    FUSILLI_REQUIRE_ASSIGN(std::optional<size_t> workspaceSize,
+                           ctx.graph->getWorkspaceSize());
+    MemoryStats stats = handle.getMemoryStats();
+    REQUIRE(stats.modules.liveBytes > 0);
+    REQUIRE(stats.graphWorkspaceBytes == workspaceSize.value_or(0));
+    executeAndCheckGraph(handle, ctx);
+  }
+  MemoryStats stats = handle.getMemoryStats();
+  REQUIRE(stats.modules.liveBytes == 0);
+  REQUIRE(stats.modules.peakBytes > 0);
+  REQUIRE(stats.graphWorkspaceBytes == 0);
+}
+
+TEST_CASE("Handle::getExecutionStats counts compiles, executes and transfers",
+          "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("execution_stats");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+  // The second compilation hits the in-process cache.
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+  ExecutionStats stats = handle.getExecutionStats();
+  REQUIRE(stats.compiles == 2);
+  REQUIRE(stats.cacheHits + stats.cacheMisses == 2);
+  REQUIRE(stats.cacheHits >= 1);
+  REQUIRE(stats.compileNs > 0);
+  REQUIRE(stats.executes == 0);
+
+  // One execution of the graph, uploading x and w and reading y back.
+  executeAndCheckGraph(handle, ctx);
+  stats = handle.getExecutionStats();
+  REQUIRE(stats.executes == 1);
+  REQUIRE(stats.executeHostNs > 0);
+  REQUIRE(ctx.graph->getExecuteCount() == 1);
+  size_t bytes = 0;
+  for (const auto &tensor : {ctx.x, ctx.w, ctx.y})
+    bytes += static_cast<size_t>(tensor->getVolume()) * sizeof(half);
+  REQUIRE(stats.bytesUploaded == bytes);
+  REQUIRE(stats.bytesRead ==
+          static_cast<size_t>(ctx.y->getVolume()) * sizeof(half));
+
+  // Executions of a bound plan count for the graph.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  FUSILLI_REQUIRE_ASSIGN(
+      ExecutionPlan plan,
+      ctx.graph->bind({{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}},
+                      workspace));
+  FUSILLI_REQUIRE_OK(plan.run(handle));
+  REQUIRE(handle.getExecutionStats().executes == 2);
+  REQUIRE(ctx.graph->getExecuteCount() == 2);
+
+  handle.resetExecutionStats();
+  stats = handle.getExecutionStats();
+  REQUIRE(stats.executes == 0);
+  REQUIRE(stats.compiles == 0);
+  REQUIRE(stats.bytesUploaded == 0);
+  // Per-graph counts are not reset with the handle's.
+  REQUIRE(ctx.graph->getExecuteCount() == 2);
+}
+
+TEST_CASE("Graph `executeTimed` measures synchronous executions", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(Backend::CPU));
+  auto ctx = makeTestExecutableGraph("execute_timed_cpu");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      ExecutionTiming timing,
+      ctx.graph->executeTimed(
+          handle, {{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}}, workspace));
+  // CPU executions complete before `executeTimed` returns.
+  FUSILLI_REQUIRE_ASSIGN(bool ready, timing.isReady());
+  REQUIRE(ready);
+  FUSILLI_REQUIRE_ASSIGN(float milliseconds, timing.getElapsedMilliseconds());
+  REQUIRE(milliseconds > 0.0f);
+
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == half(128.0f));
+}
+
 TEST_CASE("Graph `compileToArtifact` preserves loaded runtime state",
           "[graph]") {
   FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
@@ -460,10 +2489,67 @@ TEST_CASE("Graph `loadFromArtifact` accepts another Graph instance's artifact",
     FUSILLI_REQUIRE_OK(consumer.graph->loadFromArtifact(handle, artifactBytes));
   }
 
-  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize,
-                         consumer.graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize,
+                         consumer.graph->getWorkspaceSize());
+  REQUIRE(workspaceSize.has_value());
+  executeAndCheckGraph(handle, consumer);
+}
+
+TEST_CASE("Graph `loadFromArtifact` shares caller-owned artifact bytes",
+          "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto first = makeTestExecutableGraph("aot_artifact_shared_first");
+  auto second = makeTestExecutableGraph("aot_artifact_shared_second");
+
+  {
+    FUSILLI_REQUIRE_ASSIGN(
+        auto artifactBytes,
+        first.graph->compileToArtifact(handle.getBackend(), /*remove=*/true));
+    auto shared = std::make_shared<const std::vector<uint8_t>>(
+        std::move(artifactBytes));
+    FUSILLI_REQUIRE_OK(first.graph->loadFromArtifact(handle, *shared, shared));
+    FUSILLI_REQUIRE_OK(second.graph->loadFromArtifact(handle, *shared, shared));
+    // Both graphs retain the buffer, nothing was copied.
+    REQUIRE(shared.use_count() == 3);
+  }
+
+  for (auto *ctx : {&first, &second}) {
+    FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx->graph->getWorkspaceSize());
+    REQUIRE(workspaceSize.has_value());
+    executeAndCheckGraph(handle, *ctx);
+  }
+
+  auto status = first.graph->loadFromArtifact(
+      handle, std::span<const uint8_t>(), /*owner=*/nullptr);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidArgument);
+}
+
+TEST_CASE("Graph `loadFromArtifactFile` maps a VMFB file", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("aot_artifact_mapped_file");
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto artifactBytes,
+      ctx.graph->compileToArtifact(handle.getBackend(), /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(CacheFile vmfb,
+                         CacheFile::create(ctx.graph->getName(),
+                                           "mapped.vmfb", /*remove=*/true));
+  FUSILLI_REQUIRE_OK(
+      vmfb.write(std::string(artifactBytes.begin(), artifactBytes.end())));
+
+  FUSILLI_REQUIRE_OK(ctx.graph->loadFromArtifactFile(handle, vmfb.path));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
   REQUIRE(workspaceSize.has_value());
-  executeAndCheckGraph(handle, consumer);
+  executeAndCheckGraph(handle, ctx);
+
+  auto status = ctx.graph->loadFromArtifactFile(
+      handle, CacheFile::getPath(ctx.graph->getName(), "missing.vmfb"));
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::FileSystemFailure);
+  FUSILLI_REQUIRE_ASSIGN(auto clearedWorkspaceSize,
+                         ctx.graph->getWorkspaceSize());
+  REQUIRE(!clearedWorkspaceSize.has_value());
 }
 
 TEST_CASE("Graph failed `loadFromArtifact` clears loaded runtime state",
@@ -646,6 +2732,563 @@ TEST_CASE("Graph `execute`", "[graph]") {
     REQUIRE(val == half(128.0f));
 }
 
+TEST_CASE("Graph `bind` runs a prebound execution plan", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("execution_plan");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+  const std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {
+          {ctx.x, xBuf},
+          {ctx.w, wBuf},
+          {ctx.y, yBuf},
+      };
+
+  // Binding reports the same errors as `execute()`.
+  ErrorOr<ExecutionPlan> unqueried =
+      ctx.graph->bind(variantPack, /*workspace=*/nullptr);
+  REQUIRE(isError(unqueried));
+  REQUIRE(ErrorObject(unqueried).getCode() == ErrorCode::InvalidArgument);
+
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  ErrorOr<ExecutionPlan> incomplete =
+      ctx.graph->bind({{ctx.x, xBuf}, {ctx.y, yBuf}}, workspace);
+  REQUIRE(isError(incomplete));
+  REQUIRE(ErrorObject(incomplete).getCode() == ErrorCode::VariantPackError);
+
+  FUSILLI_REQUIRE_ASSIGN(ExecutionPlan plan,
+                         ctx.graph->bind(variantPack, workspace));
+  // The plan keeps the artifact alive after the graph is destroyed.
+  ctx.graph.reset();
+  for (int i = 0; i < 3; ++i)
+    FUSILLI_REQUIRE_OK(plan.run(handle));
+
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == half(128.0f));
+}
+
+TEST_CASE("Graph `execute` with buffers indexed by tensor UID", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("execute_by_uid");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+
+  // Outputs come first, then inputs sorted by name.
+  REQUIRE(ctx.graph->getTensorUidCount() == 3);
+  FUSILLI_REQUIRE_ASSIGN(size_t yUid, ctx.graph->getTensorUid(ctx.y));
+  FUSILLI_REQUIRE_ASSIGN(size_t wUid, ctx.graph->getTensorUid(ctx.w));
+  FUSILLI_REQUIRE_ASSIGN(size_t xUid, ctx.graph->getTensorUid(ctx.x));
+  REQUIRE(yUid == 0);
+  REQUIRE(wUid == 1);
+  REQUIRE(xUid == 2);
+  ErrorOr<size_t> unknown =
+      ctx.graph->getTensorUid(std::make_shared<TensorAttr>());
+  REQUIRE(isError(unknown));
+  REQUIRE(ErrorObject(unknown).getCode() == ErrorCode::InvalidArgument);
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  std::vector<Buffer *> buffers(ctx.graph->getTensorUidCount());
+  buffers[xUid] = xBuf.get();
+  buffers[wUid] = wBuf.get();
+  buffers[yUid] = yBuf.get();
+  FUSILLI_REQUIRE_OK(ctx.graph->execute(handle, buffers, workspace.get()));
+
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == half(128.0f));
+
+  // The number of buffers must match.
+  buffers.pop_back();
+  ErrorObject status = ctx.graph->execute(handle, buffers, workspace.get());
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::VariantPackError);
+}
+
+TEST_CASE("Graph `executeBatch` executes many variant packs", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("execute_batch");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  using VariantPack =
+      std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>;
+  std::vector<VariantPack> variantPacks;
+  std::vector<std::shared_ptr<Buffer>> yBufs;
+  for (float x : {1.0f, 2.0f, 3.0f}) {
+    FUSILLI_REQUIRE_ASSIGN(
+        auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, x));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+    variantPacks.push_back({{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}});
+    yBufs.push_back(yBuf);
+  }
+  FUSILLI_REQUIRE_OK(ctx.graph->executeBatch(handle, variantPacks));
+  FUSILLI_REQUIRE_OK(ctx.graph->executeBatch(handle, {}));
+
+  for (size_t i = 0; i < yBufs.size(); ++i) {
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(yBufs[i]->read(handle, result));
+    for (auto val : result)
+      REQUIRE(val == half(128.0f * static_cast<float>(i + 1)));
+  }
+
+  // An invalid pack fails the batch before anything executes.
+  FUSILLI_REQUIRE_ASSIGN(
+      auto freshBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+  variantPacks.front()[ctx.y] = freshBuf;
+  variantPacks.back().erase(ctx.x);
+  ErrorObject status = ctx.graph->executeBatch(handle, variantPacks);
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::VariantPackError);
+  std::vector<half> untouched;
+  FUSILLI_REQUIRE_OK(freshBuf->read(handle, untouched));
+  for (auto val : untouched)
+    REQUIRE(val == half(0.0f));
+}
+
+TEST_CASE("Graph `executeAsync` chains fences", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("execute_async");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}};
+
+  // The second execution waits on the first one on the device.
+  FUSILLI_REQUIRE_ASSIGN(
+      Fence first,
+      ctx.graph->executeAsync(handle, variantPack, workspace, Fence()));
+  FUSILLI_REQUIRE_ASSIGN(
+      Fence second,
+      ctx.graph->executeAsync(handle, variantPack, workspace, first));
+  FUSILLI_REQUIRE_OK(second.wait());
+  FUSILLI_REQUIRE_ASSIGN(bool signaled, second.isSignaled());
+  REQUIRE(signaled);
+
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == half(128.0f));
+
+  // Joining fences (some of them empty) waits on all of them.
+  const Fence empty;
+  std::vector<const Fence *> fences = {&first, &empty, &second};
+  FUSILLI_REQUIRE_ASSIGN(Fence joined, Fence::join(fences));
+  FUSILLI_REQUIRE_OK(joined.wait());
+}
+
+TEST_CASE("Graph `executeAsync` reports completions to a CompletionPoller",
+          "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("execute_async_poller");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+  std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+      variantPack = {{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}};
+
+  REQUIRE(isError(CompletionPoller::create({.pollInterval = {}})));
+
+  const size_t executions = 16;
+  std::atomic<size_t> succeeded = 0;
+  {
+    FUSILLI_REQUIRE_ASSIGN(auto poller, CompletionPoller::create());
+    for (size_t i = 0; i < executions; ++i)
+      FUSILLI_REQUIRE_OK(ctx.graph->executeAsync(
+          handle, variantPack, workspace, Fence(), *poller,
+          [&](ErrorObject status) {
+            if (isOk(status))
+              succeeded++;
+          }));
+    REQUIRE(isError(poller->notify(Fence(), nullptr)));
+    // Destroying the poller waits for the pending callbacks.
+  }
+  REQUIRE(succeeded == executions);
+
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == half(128.0f));
+}
+
+TEST_CASE("StreamingExecutor pipelines host batches", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("streaming_executor");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+
+  FUSILLI_REQUIRE_ASSIGN(StreamingExecutor executor,
+                         StreamingExecutor::create(handle, ctx.graph,
+                                                   {{ctx.w, wBuf}},
+                                                   /*depth=*/2));
+  REQUIRE(executor.getDepth() == 2);
+
+  // More batches than buffer sets, so the sets are reused.
+  const size_t batches = 5;
+  std::vector<std::vector<half>> outputs(
+      batches, std::vector<half>(ctx.y->getVolume()));
+  for (size_t i = 0; i < batches; ++i) {
+    std::vector<half> input(ctx.x->getVolume(),
+                            half(static_cast<float>(i + 1)));
+    FUSILLI_REQUIRE_ASSIGN(
+        uint64_t batch,
+        executor.submit({{ctx.x, std::as_bytes(std::span(input))}},
+                        {{ctx.y, std::as_writable_bytes(
+                                     std::span(outputs[i]))}}));
+    REQUIRE(batch == i);
+  }
+  REQUIRE(executor.getSubmittedCount() == batches);
+  FUSILLI_REQUIRE_OK(executor.wait(batches - 2));
+  FUSILLI_REQUIRE_OK(executor.flush());
+  for (size_t i = 0; i < batches; ++i)
+    for (auto val : outputs[i])
+      REQUIRE(val == half(128.0f * static_cast<float>(i + 1)));
+
+  // Every streamed tensor needs host memory, and only those.
+  std::vector<half> input(ctx.x->getVolume(), half(1.0f));
+  REQUIRE(isError(
+      executor.submit({{ctx.x, std::as_bytes(std::span(input))}}, {})));
+  REQUIRE(isError(executor.submit(
+      {{ctx.x, std::as_bytes(std::span(input))},
+       {ctx.w, std::as_bytes(std::span(input))}},
+      {{ctx.y, std::as_writable_bytes(std::span(outputs[0]))}})));
+  REQUIRE(isError(executor.wait(batches)));
+}
+
+TEST_CASE("PriorityScheduler routes executions by priority", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("priority_scheduler");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+
+  // Without prioritized streams, every class runs on the handle's queue.
+  PriorityScheduler scheduler(handle);
+  for (StreamPriority priority :
+       {StreamPriority::Low, StreamPriority::Normal, StreamPriority::High})
+    REQUIRE(scheduler.nextQueueIndex(priority) == 0);
+
+  for (StreamPriority priority : {StreamPriority::High, StreamPriority::Low,
+                                  StreamPriority::High}) {
+    FUSILLI_REQUIRE_OK(scheduler.execute(
+        *ctx.graph, priority, {{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}},
+        /*workspace=*/nullptr));
+  }
+  REQUIRE(scheduler.getExecuteCount(StreamPriority::High) == 2);
+  REQUIRE(scheduler.getExecuteCount(StreamPriority::Normal) == 0);
+  REQUIRE(scheduler.getExecuteCount(StreamPriority::Low) == 1);
+
+  std::vector<half> result;
+  FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+  for (auto val : result)
+    REQUIRE(val == half(128.0f));
+}
+
+TEST_CASE("Graph `execute` borrows the handle workspace arena", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  REQUIRE(handle.getWorkspaceArenaSize() == 0);
+  size_t maxWorkspaceSize = 0;
+  for (const char *name : {"workspace_arena_a", "workspace_arena_b"}) {
+    auto ctx = makeTestExecutableGraph(name);
+    FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+    FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+    maxWorkspaceSize = std::max(maxWorkspaceSize, workspaceSize.value_or(0));
+
+    // No workspace is passed: the graph borrows the arena if it needs one.
+    FUSILLI_REQUIRE_OK(ctx.graph->execute(
+        handle, {{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}},
+        /*workspace=*/nullptr));
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+    for (auto val : result)
+      REQUIRE(val == half(128.0f));
+  }
+  REQUIRE(handle.getWorkspaceArenaSize() == maxWorkspaceSize);
+
+  // The arena only grows.
+  size_t arenaSize = std::max<size_t>(64, maxWorkspaceSize);
+  Buffer *released = nullptr;
+  {
+    FUSILLI_REQUIRE_ASSIGN(auto lease, handle.acquireWorkspace(64));
+    REQUIRE(lease.get() != nullptr);
+    REQUIRE(handle.getWorkspaceArenaSize() == arenaSize);
+
+    // Overlapping executions borrow distinct workspaces.
+    FUSILLI_REQUIRE_ASSIGN(auto other, handle.acquireWorkspace(64));
+    REQUIRE(other.get() != nullptr);
+    REQUIRE(other.get() != lease.get());
+    released = lease.get().get();
+  }
+
+  // Released workspaces are reused.
+  FUSILLI_REQUIRE_ASSIGN(auto lease, handle.acquireWorkspace(arenaSize));
+  FUSILLI_REQUIRE_ASSIGN(auto other, handle.acquireWorkspace(arenaSize));
+  REQUIRE((lease.get().get() == released || other.get().get() == released));
+  REQUIRE(handle.getWorkspaceArenaSize() == arenaSize);
+}
+
+TEST_CASE("Graph `execute` from concurrent threads", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("execute_concurrent");
+  FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(
+      auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(
+      auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+
+  // Each thread writes its own output and workspace buffers.
+  constexpr size_t kNumThreads = 4;
+  constexpr int kIterations = 8;
+  std::vector<std::shared_ptr<Buffer>> outputs;
+  std::vector<std::shared_ptr<Buffer>> workspaces;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    FUSILLI_REQUIRE_ASSIGN(
+        auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+    FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+    outputs.push_back(yBuf);
+    workspaces.push_back(workspace);
+  }
+
+  // Catch2 assertions are not thread-safe, so statuses are checked after the
+  // threads join.
+  std::vector<ErrorObject> statuses(kNumThreads, ok());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i] {
+      std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+          variantPack = {{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, outputs[i]}};
+      for (int iter = 0; iter < kIterations && isOk(statuses[i]); ++iter)
+        statuses[i] = ctx.graph->execute(handle, variantPack, workspaces[i]);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  for (auto &status : statuses)
+    FUSILLI_REQUIRE_OK(status);
+
+  for (auto &yBuf : outputs) {
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+    for (auto val : result)
+      REQUIRE(val == half(128.0f));
+  }
+}
+
+TEST_CASE("GraphSequence submits bound graphs in order", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  std::vector<ExecutableGraph> ctxs;
+  std::vector<std::shared_ptr<Buffer>> outputs;
+  GraphSequence sequence;
+  REQUIRE(sequence.empty());
+  for (const char *name : {"graph_sequence_a", "graph_sequence_b"}) {
+    ctxs.push_back(makeTestExecutableGraph(name));
+    auto &ctx = ctxs.back();
+    FUSILLI_REQUIRE_OK(ctx.graph->compile(handle, /*remove=*/true));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, 1.0f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+    FUSILLI_REQUIRE_ASSIGN(auto workspaceSize, ctx.graph->getWorkspaceSize());
+    FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+    FUSILLI_REQUIRE_OK(sequence.append(
+        *ctx.graph, {{ctx.x, xBuf}, {ctx.w, wBuf}, {ctx.y, yBuf}}, workspace));
+    outputs.push_back(yBuf);
+  }
+  REQUIRE(sequence.size() == 2);
+
+  // The sequence stays valid after the graphs are destroyed.
+  ctxs.clear();
+  FUSILLI_REQUIRE_OK(sequence.submit(handle));
+  for (auto &yBuf : outputs) {
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+    for (auto val : result)
+      REQUIRE(val == half(128.0f));
+  }
+
+  // Graphs that can't be bound are not appended.
+  auto uncompiled = makeTestExecutableGraph("graph_sequence_uncompiled");
+  REQUIRE(isError(sequence.append(*uncompiled.graph, {}, nullptr)));
+  REQUIRE(sequence.size() == 2);
+  sequence.clear();
+  REQUIRE(sequence.empty());
+}
+
+TEST_CASE("GraphTemplate instances share the compiled graph", "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  auto ctx = makeTestExecutableGraph("graph_template");
+  FUSILLI_REQUIRE_ASSIGN(
+      GraphTemplate tmpl,
+      GraphTemplate::create(handle, ctx.graph, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(auto workspaceSize,
+                         tmpl.getGraph().getWorkspaceSize());
+  FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                         allocateWorkspace(handle, workspaceSize));
+
+  std::vector<GraphInstance> instances;
+  std::vector<std::shared_ptr<Buffer>> outputs;
+  for (float value : {1.0f, 2.0f}) {
+    GraphInstance instance = tmpl.instantiate();
+    FUSILLI_REQUIRE_ASSIGN(
+        auto xBuf, allocateBufferOfType(handle, ctx.x, DataType::Half, value));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto wBuf, allocateBufferOfType(handle, ctx.w, DataType::Half, 1.0f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto yBuf, allocateBufferOfType(handle, ctx.y, DataType::Half, 0.0f));
+    FUSILLI_REQUIRE_OK(instance.bind(ctx.x, xBuf));
+    FUSILLI_REQUIRE_OK(instance.bind("filter", wBuf));
+    // Executing with unbound buffers fails.
+    REQUIRE(isError(instance.execute(handle, workspace)));
+    FUSILLI_REQUIRE_OK(instance.bind(ctx.y, yBuf));
+    instances.push_back(std::move(instance));
+    outputs.push_back(yBuf);
+  }
+
+  // Instances outlive the template and its graph handle.
+  ctx.graph.reset();
+  for (const GraphInstance &instance : instances)
+    FUSILLI_REQUIRE_OK(instance.execute(handle, workspace));
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    std::vector<half> result;
+    FUSILLI_REQUIRE_OK(outputs[i]->read(handle, result));
+    for (auto val : result)
+      REQUIRE(val == half(128.0f * static_cast<float>(i + 1)));
+  }
+
+  GraphInstance instance = tmpl.instantiate();
+  ErrorObject status = instance.bind("missing", outputs[0]);
+  REQUIRE(isError(status));
+  REQUIRE(status.getMessage() == "Graph has no input or output named "
+                                 "'missing'");
+  REQUIRE(isError(instance.bind(std::make_shared<TensorAttr>(), outputs[0])));
+}
+
+TEST_CASE("PartitionedGraph splits a graph and links its partitions",
+          "[graph]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  Graph g;
+  g.setName("partitioned_graph");
+  g.setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Float);
+  auto x = g.tensor(TensorAttr().setName("x").setDim({4, 8}).setStride({8, 1}));
+  auto b = g.tensor(TensorAttr().setName("b").setDim({1, 8}).setStride({8, 1}));
+  // y = relu(x + b) * b + b, four nodes.
+  auto sum =
+      g.pointwise(x, b, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  auto relu =
+      g.pointwise(sum, PointwiseAttr().setMode(PointwiseAttr::Mode::RELU_FWD));
+  auto scaled =
+      g.pointwise(relu, b, PointwiseAttr().setMode(PointwiseAttr::Mode::MUL));
+  auto y =
+      g.pointwise(scaled, b, PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  y->setName("y").setOutput(true);
+  FUSILLI_REQUIRE_OK(g.validate());
+
+  SECTION("Graphs must be validated") {
+    Graph unvalidated;
+    auto result = PartitionedGraph::create(std::move(unvalidated), 2);
+    REQUIRE(isError(result));
+    REQUIRE(ErrorObject(result).getCode() == ErrorCode::NotValidated);
+  }
+
+  SECTION("Partitions execute back to back") {
+    FUSILLI_REQUIRE_ASSIGN(PartitionedGraph partitioned,
+                           PartitionedGraph::create(std::move(g), 2));
+    REQUIRE(partitioned.getPartitionCount() == 2);
+    // The balanced cut between the relu and the scaling is crossed by one
+    // intermediate only.
+    REQUIRE(partitioned.getIntermediates().size() == 1);
+    REQUIRE(partitioned.getIntermediates()[0] == relu);
+    REQUIRE(!relu->isVirtual());
+
+    // Executing before compiling fails.
+    REQUIRE(partitioned.execute(handle, {}, nullptr).getCode() ==
+            ErrorCode::NotCompiled);
+
+    FUSILLI_REQUIRE_OK(partitioned.compile(handle, /*parallelism=*/0,
+                                           /*remove=*/true));
+    FUSILLI_REQUIRE_ASSIGN(size_t workspaceSize,
+                           partitioned.getWorkspaceSize());
+    FUSILLI_REQUIRE_ASSIGN(auto workspace,
+                           allocateWorkspace(handle, workspaceSize));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto xBuf, allocateBufferOfType(handle, x, DataType::Float, 1.0f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto bBuf, allocateBufferOfType(handle, b, DataType::Float, 0.5f));
+    FUSILLI_REQUIRE_ASSIGN(
+        auto yBuf, allocateBufferOfType(handle, y, DataType::Float, 0.0f));
+    std::unordered_map<std::shared_ptr<TensorAttr>, std::shared_ptr<Buffer>>
+        variantPack = {{x, xBuf}, {b, bBuf}, {y, yBuf}};
+    FUSILLI_REQUIRE_OK(partitioned.execute(handle, variantPack, workspace));
+
+    std::vector<float> result;
+    FUSILLI_REQUIRE_OK(yBuf->read(handle, result));
+    for (float val : result)
+      REQUIRE(val == 1.25f);
+
+    // The same partitions can be submitted as a sequence.
+    GraphSequence sequence;
+    FUSILLI_REQUIRE_OK(partitioned.appendTo(sequence, variantPack, workspace));
+    REQUIRE(sequence.size() == 2);
+    FUSILLI_REQUIRE_OK(sequence.submit(handle));
+  }
+}
+
 // collectModuleScopeAsm recursively walks the sub-node tree and gathers
 // module-scope declarations. This test constructs a nested tree using
 // TestNode to verify the traversal reaches all depths:
@@ -791,3 +3434,267 @@ TEST_CASE("Graph validate rejects broadcast strides on intermediate operation "
   REQUIRE(status.getMessage().find("broadcast strides") != std::string::npos);
   REQUIRE(status.getMessage().find("intermediate") != std::string::npos);
 }
+
+TEST_CASE("Graph `serialize` and `deserialize` round trip", "[graph]") {
+  auto makeGraph = [](Graph &g) {
+    g.setName("serialized_graph")
+        .setIODataType(DataType::Float)
+        .setComputeDataType(DataType::Float)
+        .setIntermediateDataType(DataType::Float);
+    auto x = g.tensor(TensorAttr()
+                          .setName("x")
+                          .setDim({2, 8, 16, 16})
+                          .setStride({2048, 1, 128, 8}));
+    auto w = g.tensor(TensorAttr()
+                          .setName("w")
+                          .setDim({4, 8, 3, 3})
+                          .setStride({72, 1, 24, 8}));
+    auto y = g.convFProp(x, w,
+                         ConvFPropAttr()
+                             .setPadding({1, 1})
+                             .setStride({1, 1})
+                             .setDilation({1, 1})
+                             .setName("conv"));
+    auto scale = g.tensor(TensorAttr(0.5f).setName("half"));
+    auto z = g.pointwise(y, scale,
+                         PointwiseAttr()
+                             .setMode(PointwiseAttr::Mode::MUL)
+                             .setName("scale"));
+    auto out = g.pointwise(z, PointwiseAttr()
+                                  .setMode(PointwiseAttr::Mode::ELU_FWD)
+                                  .setEluAlpha(0.25f)
+                                  .setName("elu"));
+    out->setName("out").setOutput(true);
+  };
+
+  SECTION("An unvalidated graph compiles like the original") {
+    Graph g;
+    makeGraph(g);
+    FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes, g.serialize());
+    FUSILLI_REQUIRE_ASSIGN(std::unique_ptr<Graph> copy,
+                           Graph::deserialize(bytes));
+
+    FUSILLI_REQUIRE_OK(g.validate());
+    FUSILLI_REQUIRE_OK(copy->validate());
+    REQUIRE(copy->getName() == "serialized_graph");
+    FUSILLI_REQUIRE_ASSIGN(std::string fp1, g.getFingerprint());
+    FUSILLI_REQUIRE_ASSIGN(std::string fp2, copy->getFingerprint());
+    REQUIRE(fp1 == fp2);
+    FUSILLI_REQUIRE_ASSIGN(std::string asm1, g.emitAsm());
+    FUSILLI_REQUIRE_ASSIGN(std::string asm2, copy->emitAsm());
+    REQUIRE(asm1 == asm2);
+
+    // Tensors are restored with their names and shared between nodes.
+    auto x = copy->getTensor("x");
+    REQUIRE(x != nullptr);
+    REQUIRE(x->getStride() == std::vector<int64_t>{2048, 1, 128, 8});
+    REQUIRE(copy->getTensor("out") != nullptr);
+    REQUIRE(copy->getTensor("missing") == nullptr);
+  }
+
+  SECTION("A validated graph serializes to the same bytes again") {
+    Graph g;
+    makeGraph(g);
+    FUSILLI_REQUIRE_OK(g.validate());
+    FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes, g.serialize());
+    FUSILLI_REQUIRE_ASSIGN(std::unique_ptr<Graph> copy,
+                           Graph::deserialize(bytes));
+    FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes2, copy->serialize());
+    REQUIRE(bytes == bytes2);
+    FUSILLI_REQUIRE_OK(copy->validate());
+  }
+
+  SECTION("Malformed bytes are rejected") {
+    Graph g;
+    makeGraph(g);
+    FUSILLI_REQUIRE_ASSIGN(std::vector<uint8_t> bytes, g.serialize());
+
+    auto truncated = Graph::deserialize(
+        std::span<const uint8_t>(bytes.data(), bytes.size() / 2));
+    REQUIRE(isError(truncated));
+    REQUIRE(ErrorObject(truncated).getCode() == ErrorCode::InvalidArgument);
+
+    std::vector<uint8_t> garbage = {1, 2, 3, 4};
+    auto status = Graph::deserialize(garbage);
+    REQUIRE(isError(status));
+    REQUIRE(ErrorObject(status).getMessage() ==
+            "Not a serialized graph, or serialized by an unsupported version "
+            "of Fusilli");
+
+    bytes.push_back(0);
+    REQUIRE(isError(Graph::deserialize(bytes)));
+  }
+}
+
+TEST_CASE("Graph `setArenaSize` allocates nodes and tensors from an arena",
+          "[graph]") {
+  auto makeGraph = [](Graph &g) {
+    g.setName("arena_graph").setIODataType(DataType::Float);
+    auto x = g.tensor(
+        TensorAttr().setName("x").setDim({4, 8}).setStride({8, 1}));
+    auto y = g.pointwise(x, PointwiseAttr()
+                                .setMode(PointwiseAttr::Mode::RELU_FWD)
+                                .setName("relu"));
+    y->setName("y").setOutput(true);
+    return y;
+  };
+
+  Graph heap;
+  makeGraph(heap);
+  FUSILLI_REQUIRE_OK(heap.validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string heapAsm, heap.emitAsm());
+
+  std::shared_ptr<TensorAttr> y;
+  {
+    Graph arena;
+    arena.setArenaSize(4096);
+    y = makeGraph(arena);
+    FUSILLI_REQUIRE_OK(arena.validate());
+    FUSILLI_REQUIRE_ASSIGN(std::string arenaAsm, arena.emitAsm());
+    REQUIRE(arenaAsm == heapAsm);
+  }
+  // Handles keep the arena alive after the graph is gone.
+  REQUIRE(y->getName() == "y");
+  REQUIRE(y->getDim() == std::vector<int64_t>{4, 8});
+}
+
+TEST_CASE("Graph validation scales to large graphs", "[graph]") {
+  constexpr int64_t kNodes = 10000;
+  auto makeGraph = [](Graph &g, const std::string &lastName) {
+    g.setName("large_graph")
+        .setIODataType(DataType::Float)
+        .setComputeDataType(DataType::Float);
+    auto x = g.tensor(
+        TensorAttr().setName("x").setDim({2, 16}).setStride({16, 1}));
+    auto b = g.tensor(
+        TensorAttr().setName("b").setDim({2, 16}).setStride({16, 1}));
+    auto y = x;
+    for (int64_t i = 0; i < kNodes; ++i) {
+      std::string name =
+          i + 1 == kNodes ? lastName : "node_" + std::to_string(i);
+      if (i % 2 == 0)
+        y = g.pointwise(
+            y, b,
+            PointwiseAttr().setMode(PointwiseAttr::Mode::ADD).setName(name));
+      else
+        y = g.pointwise(y, PointwiseAttr()
+                               .setMode(PointwiseAttr::Mode::RELU_FWD)
+                               .setName(name));
+    }
+    y->setName("y").setOutput(true).setInPlace(x);
+  };
+
+  SECTION("Valid graph") {
+    Graph g;
+    makeGraph(g, "last");
+    FUSILLI_REQUIRE_OK(g.validate());
+    FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+    REQUIRE(generatedAsm.find("node_0") != std::string::npos);
+    REQUIRE(generatedAsm.find("last") != std::string::npos);
+  }
+
+  SECTION("Duplicate node name") {
+    Graph g;
+    makeGraph(g, "node_0");
+    auto status = g.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Symbol name 'node_0' already in use");
+  }
+}
+
+TEST_CASE("Graph `markDirty` revalidates downstream of edited tensors",
+          "[graph]") {
+  auto makeGraph = [](Graph &g, const std::vector<int64_t> &dim,
+                      const std::vector<int64_t> &stride) {
+    g.setName("dirty_graph")
+        .setIODataType(DataType::Float)
+        .setComputeDataType(DataType::Float);
+    auto x = g.tensor(TensorAttr().setName("x").setDim(dim).setStride(stride));
+    auto t = g.pointwise(x, PointwiseAttr()
+                                .setMode(PointwiseAttr::Mode::RELU_FWD)
+                                .setName("relu"));
+    auto y = g.pointwise(t, PointwiseAttr()
+                                .setMode(PointwiseAttr::Mode::TANH_FWD)
+                                .setName("tanh"));
+    y->setName("y").setOutput(true);
+    return std::pair{x, y};
+  };
+
+  Graph g;
+  auto [x, y] = makeGraph(g, {4, 8}, {8, 1});
+  FUSILLI_REQUIRE_OK(g.validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string before, g.getFingerprint());
+
+  x->setDim({2, 16}).setStride({16, 1});
+  g.markDirty(x);
+  REQUIRE(ErrorObject(g.getFingerprint()).getCode() ==
+          ErrorCode::NotValidated);
+  FUSILLI_REQUIRE_OK(g.validate());
+  REQUIRE(y->getDim() == std::vector<int64_t>{2, 16});
+  REQUIRE(y->getStride() == std::vector<int64_t>{16, 1});
+
+  Graph fresh;
+  makeGraph(fresh, {2, 16}, {16, 1});
+  FUSILLI_REQUIRE_OK(fresh.validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string after, g.getFingerprint());
+  FUSILLI_REQUIRE_ASSIGN(std::string expected, fresh.getFingerprint());
+  REQUIRE(after != before);
+  REQUIRE(after == expected);
+  FUSILLI_REQUIRE_ASSIGN(std::string asm0, g.emitAsm());
+  FUSILLI_REQUIRE_ASSIGN(std::string asm1, fresh.emitAsm());
+  REQUIRE(asm0 == asm1);
+
+  // Invalid edits are caught by the revalidation, and can be fixed.
+  x->setDim({2, 16, 1});
+  REQUIRE(isError(g.markDirty(x).validate()));
+  x->setDim({4, 8}).setStride({8, 1});
+  FUSILLI_REQUIRE_OK(g.markDirty(x).validate());
+  FUSILLI_REQUIRE_ASSIGN(std::string restored, g.getFingerprint());
+  REQUIRE(restored == before);
+}
+
+TEST_CASE("Graph `setAutocast` runs safe operations in low precision",
+          "[graph]") {
+  Graph g;
+  g.setName("autocast_graph")
+      .setIODataType(DataType::Float)
+      .setIntermediateDataType(DataType::Float)
+      .setComputeDataType(DataType::Half)
+      .setAutocast(true);
+  auto a =
+      g.tensor(TensorAttr().setName("a").setDim({16, 32}).setStride({32, 1}));
+  auto b =
+      g.tensor(TensorAttr().setName("b").setDim({32, 8}).setStride({8, 1}));
+  auto c = g.matmul(a, b, MatmulAttr().setName("matmul"));
+  auto r = g.pointwise(c, PointwiseAttr()
+                              .setMode(PointwiseAttr::Mode::RELU_FWD)
+                              .setName("relu"));
+  auto y = g.reduction(
+      r, ReductionAttr().setMode(ReductionAttr::Mode::ADD).setName("sum"));
+  y->setName("y").setDim({16, 1}).setStride({1, 1}).setOutput(true);
+
+  FUSILLI_REQUIRE_OK(g.validate());
+  REQUIRE(a->getDataType() == DataType::Float);
+  REQUIRE(c->getDataType() == DataType::Half);
+  REQUIRE(r->getDataType() == DataType::Half);
+  REQUIRE(y->getDataType() == DataType::Float);
+
+  // A and B are cast down for the matmul, the ReLU output back up for the
+  // reduction.
+  FUSILLI_REQUIRE_ASSIGN(std::string generatedAsm, g.emitAsm());
+  size_t casts = 0;
+  for (size_t pos = generatedAsm.find("torch.aten.to.dtype");
+       pos != std::string::npos;
+       pos = generatedAsm.find("torch.aten.to.dtype", pos + 1))
+    ++casts;
+  REQUIRE(casts == 3);
+
+  Graph unsupported;
+  unsupported.setName("autocast_float")
+      .setComputeDataType(DataType::Float)
+      .setAutocast(true);
+  auto status = unsupported.validate();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+}
@@ -12,7 +12,9 @@
 #include <barrier>
 #include <catch2/catch_test_macros.hpp>
 #include <cstddef>
+#include <cstdint>
 #include <mutex>
+#include <span>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -44,6 +46,27 @@ TEST_CASE("Multiple Handle creation", "[handle]") {
 #endif
 }
 
+TEST_CASE("Handles on the same device share it", "[handle]") {
+  std::vector<float> data = {1.0f, 2.0f, 3.0f, 4.0f};
+  std::vector<float> result;
+  FUSILLI_REQUIRE_ASSIGN(Handle second, Handle::create(kDefaultBackend));
+  {
+    FUSILLI_REQUIRE_ASSIGN(Handle first, Handle::create(kDefaultBackend));
+    FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                           Buffer::allocate(first, castToSizeT({4}), data));
+    // Buffers of one handle are usable on the other.
+    FUSILLI_REQUIRE_OK(buf.read(second, result));
+    REQUIRE(result == data);
+  }
+  // The device remains alive while any handle holds it.
+  FUSILLI_REQUIRE_ASSIGN(Buffer buf,
+                         Buffer::allocate(second, castToSizeT({4}), data));
+  FUSILLI_REQUIRE_OK(second.synchronize());
+  result.clear();
+  FUSILLI_REQUIRE_OK(buf.read(second, result));
+  REQUIRE(result == data);
+}
+
 TEST_CASE("Multi-threaded Handle creation", "[handle][thread]") {
   constexpr int kNumThreads = 32;
 
@@ -84,6 +107,45 @@ TEST_CASE("Multi-threaded Handle creation", "[handle][thread]") {
   REQUIRE(handles.size() == kNumThreads);
 }
 
+TEST_CASE("CPU Handle creation with CpuOptions", "[handle]") {
+  SECTION("Restricted topology") {
+    FUSILLI_REQUIRE_ASSIGN(
+        Handle handle,
+        Handle::create(Backend::CPU, CpuOptions{.threads = 2, .numaNode = 0}));
+    REQUIRE(handle.getBackend() == Backend::CPU);
+  }
+  SECTION("Unpinned threads") {
+    FUSILLI_REQUIRE_ASSIGN(
+        Handle handle,
+        Handle::create(Backend::CPU, CpuOptions{.pinThreads = false}));
+  }
+  SECTION("Inline execution") {
+    FUSILLI_REQUIRE_ASSIGN(
+        Handle handle,
+        Handle::create(Backend::CPU, CpuOptions{.inlineExecution = true}));
+  }
+  SECTION("Inline execution with a topology should fail") {
+    auto handleOrError = Handle::create(
+        Backend::CPU, CpuOptions{.threads = 2, .inlineExecution = true});
+    REQUIRE(isError(handleOrError));
+    ErrorObject error = handleOrError;
+    REQUIRE(error.getCode() == ErrorCode::InvalidArgument);
+  }
+  SECTION("Out of range NUMA node") {
+    auto handleOrError =
+        Handle::create(Backend::CPU, CpuOptions{.numaNode = 1u << 20});
+    REQUIRE(isError(handleOrError));
+    ErrorObject error = handleOrError;
+    REQUIRE(error.getCode() == ErrorCode::InvalidArgument);
+  }
+  SECTION("AMDGPU backend should fail") {
+    auto handleOrError = Handle::create(Backend::AMDGPU, CpuOptions{});
+    REQUIRE(isError(handleOrError));
+    ErrorObject error = handleOrError;
+    REQUIRE(error.getCode() == ErrorCode::InvalidArgument);
+  }
+}
+
 TEST_CASE("Handle creation with deviceId and stream, CPU backend should fail",
           "[handle]") {
   // Attempting to create CPU handle with with a specific deviceId and stream
@@ -103,3 +165,50 @@ TEST_CASE("Handle creation with deviceId, CPU backend should fail",
   ErrorObject error = handleOrError;
   REQUIRE(error.getCode() == ErrorCode::InvalidArgument);
 }
+
+TEST_CASE("Handle queues", "[handle]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  REQUIRE(handle.getQueueCount() == 1);
+  REQUIRE(handle.nextQueueIndex() == 0);
+  REQUIRE(handle.nextQueueIndex() == 0);
+
+  // Multiple streams are only supported on AMDGPU, and at least one is
+  // required.
+  std::vector<uintptr_t> streams = {0, 0};
+  auto handleOrError = Handle::create(Backend::CPU, /*deviceId=*/0, streams);
+  REQUIRE(isError(handleOrError));
+  ErrorObject error = handleOrError;
+  REQUIRE(error.getCode() == ErrorCode::InvalidArgument);
+  auto noStreams = Handle::create(kDefaultBackend, /*deviceId=*/0,
+                                  std::span<const uintptr_t>());
+  REQUIRE(isError(noStreams));
+}
+
+TEST_CASE("Handle stream priorities", "[handle]") {
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  REQUIRE(handle.getStreamPriority() == StreamPriority::Normal);
+
+  // Prioritized streams are only supported on AMDGPU, and at least one is
+  // required.
+  std::vector<StreamPriority> priorities = {StreamPriority::High,
+                                            StreamPriority::Low};
+  auto handleOrError =
+      Handle::create(Backend::CPU, /*deviceId=*/0, priorities);
+  REQUIRE(isError(handleOrError));
+  ErrorObject error = handleOrError;
+  REQUIRE(error.getCode() == ErrorCode::InvalidArgument);
+  auto noPriorities = Handle::create(kDefaultBackend, /*deviceId=*/0,
+                                     std::span<const StreamPriority>());
+  REQUIRE(isError(noPriorities));
+}
+
+TEST_CASE("Handle creation with multiple devices, CPU backend should fail",
+          "[handle]") {
+  std::vector<int> deviceIds = {0, 1};
+  auto handleOrError = Handle::create(Backend::CPU, deviceIds);
+  REQUIRE(isError(handleOrError));
+  ErrorObject error = handleOrError;
+  REQUIRE(error.getCode() == ErrorCode::InvalidArgument);
+  auto noDevices = Handle::create(kDefaultBackend, std::span<const int>());
+  REQUIRE(isError(noDevices));
+}
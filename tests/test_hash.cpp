@@ -0,0 +1,46 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+using namespace fusilli;
+
+TEST_CASE("Hasher matches FNV-1a reference values", "[Hasher]") {
+  // No input yields the FNV-1a 64-bit offset basis.
+  REQUIRE(Hasher().digest() == 0xcbf29ce484222325ULL);
+
+  // Raw byte updates match the published FNV-1a 64-bit test vector for "a".
+  const uint8_t a[] = {'a'};
+  REQUIRE(Hasher().update(std::span<const uint8_t>(a)).digest() ==
+          0xaf63dc4c8601ec8cULL);
+}
+
+TEST_CASE("Hasher hexDigest formatting", "[Hasher]") {
+  REQUIRE(Hasher().hexDigest() == "cbf29ce484222325");
+  REQUIRE(Hasher::toHex(0) == "0000000000000000");
+  REQUIRE(Hasher::toHex(0xabcULL) == "0000000000000abc");
+  REQUIRE(Hasher().update("fusilli").hexDigest().size() == 16);
+}
+
+TEST_CASE("Hasher is deterministic and order sensitive", "[Hasher]") {
+  REQUIRE(Hasher().update("abc").update(int64_t{42}).digest() ==
+          Hasher().update("abc").update(int64_t{42}).digest());
+  REQUIRE(Hasher().update("abc").digest() != Hasher().update("abd").digest());
+  REQUIRE(Hasher().update(1).update(2).digest() !=
+          Hasher().update(2).update(1).digest());
+}
+
+TEST_CASE("Hasher string updates are length prefixed", "[Hasher]") {
+  REQUIRE(Hasher().update("ab").update("c").digest() !=
+          Hasher().update("a").update("bc").digest());
+  REQUIRE(Hasher().update(std::string("")).digest() != Hasher().digest());
+}
@@ -172,3 +172,25 @@ TEST_CASE("Int4::pack all values roundtrip", "[Int4]") {
   for (size_t i = 0; i < elements.size(); ++i)
     REQUIRE(unpacked[i].toInt() == elements[i].toInt());
 }
+
+TEST_CASE("Int4::pack and Int4::unpack match the scalar kernels", "[Int4]") {
+  // Sizes around the 32 element vector width of the SIMD kernels, so both
+  // the vector body and the scalar tail are covered.
+  for (size_t count : {31, 32, 33, 64, 95, 1000, 1025}) {
+    std::vector<Int4> elements;
+    for (size_t i = 0; i < count; ++i)
+      elements.push_back(
+          Int4(static_cast<int8_t>(static_cast<int>(i * 7 % 16) - 8)));
+
+    std::vector<uint8_t> expected((count + 1) / 2);
+    detail::packInt4Scalar(reinterpret_cast<const uint8_t *>(elements.data()),
+                           count, expected.data());
+    std::vector<uint8_t> packed = Int4::pack(elements);
+    REQUIRE(packed == expected);
+
+    std::vector<Int4> unpacked(count);
+    Int4::unpack(packed.data(), count, unpacked.data());
+    for (size_t i = 0; i < count; ++i)
+      REQUIRE(unpacked[i].toInt() == elements[i].toInt());
+  }
+}
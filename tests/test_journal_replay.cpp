@@ -0,0 +1,138 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_journal_replay";
+
+static Graph buildGraph() {
+  Graph graph;
+  graph.setName(kGraphName);
+  graph.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+  auto a = graph.tensor(TensorAttr().setName("a").setDim({4}).setStride({1}));
+  auto b = graph.tensor(TensorAttr().setName("b").setDim({4}).setStride({1}));
+  auto c = graph.pointwise(a, b,
+                           PointwiseAttr().setMode(PointwiseAttr::Mode::ADD));
+  c->setName("c").setOutput(true);
+  return graph;
+}
+
+TEST_CASE("UsageJournal records each distinct graph once", "[journal]") {
+  std::filesystem::path dir =
+      CacheFile::getPath(kGraphName, "journal").parent_path() / "journal";
+  auto cleanup = ScopeExit([&] {
+    UsageJournal::get().disable();
+    std::filesystem::remove_all(dir.parent_path());
+  });
+  UsageJournal::get().enable(dir);
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  Graph graph = buildGraph();
+  FUSILLI_REQUIRE_OK(graph.validate());
+  FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+  // Compiling the same graph again writes no new entry.
+  Graph again = buildGraph();
+  FUSILLI_REQUIRE_OK(again.validate());
+  FUSILLI_REQUIRE_OK(again.compile(handle, /*remove=*/true));
+
+  FUSILLI_REQUIRE_ASSIGN(std::vector<UsageJournalEntry> entries,
+                         UsageJournal::read(dir));
+  REQUIRE(entries.size() == 1);
+  FUSILLI_REQUIRE_ASSIGN(std::string fingerprint, graph.getFingerprint());
+  REQUIRE(entries[0].graphName == kGraphName);
+  REQUIRE(entries[0].fingerprint == fingerprint);
+  REQUIRE(entries[0].backend == kDefaultBackend);
+  REQUIRE(entries[0].target.empty() == (kDefaultBackend == Backend::CPU));
+
+  // Other compile options are another entry.
+  Graph tuned = buildGraph();
+  tuned.setCompileOptions(CompileOptions().setOptLevel("O1"));
+  FUSILLI_REQUIRE_OK(tuned.validate());
+  FUSILLI_REQUIRE_OK(tuned.compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(entries, UsageJournal::read(dir));
+  REQUIRE(entries.size() == 2);
+
+  // Nothing is recorded once disabled.
+  UsageJournal::get().disable();
+  Graph other = buildGraph();
+  other.setCompileOptions(CompileOptions().setOptLevel("O2"));
+  FUSILLI_REQUIRE_OK(other.validate());
+  FUSILLI_REQUIRE_OK(other.compile(handle, /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(entries, UsageJournal::read(dir));
+  REQUIRE(entries.size() == 2);
+}
+
+TEST_CASE("replayUsageJournal prebuilds an artifact bundle", "[journal]") {
+  std::filesystem::path root =
+      CacheFile::getPath(kGraphName, "journal").parent_path();
+  std::filesystem::path dir = root / "journal";
+  std::filesystem::path bundlePath = root / "kernels.fusilli";
+  auto cleanup = ScopeExit([&] {
+    UsageJournal::get().disable();
+    std::filesystem::remove_all(root);
+  });
+
+  FUSILLI_REQUIRE_ASSIGN(Handle handle, Handle::create(kDefaultBackend));
+  UsageJournal::get().enable(dir);
+  for (const char *level : {"O2", "O3"}) {
+    Graph graph = buildGraph();
+    graph.setCompileOptions(CompileOptions().setOptLevel(level));
+    FUSILLI_REQUIRE_OK(graph.validate());
+    FUSILLI_REQUIRE_OK(graph.compile(handle, /*remove=*/true));
+  }
+  UsageJournal::get().disable();
+
+  FUSILLI_REQUIRE_ASSIGN(std::vector<UsageJournalEntry> entries,
+                         UsageJournal::read(dir));
+  REQUIRE(entries.size() == 2);
+
+  SECTION("entries of other backends are skipped") {
+    Backend other =
+        kDefaultBackend == Backend::CPU ? Backend::AMDGPU : Backend::CPU;
+    ArtifactBundleWriter writer;
+    std::vector<ErrorObject> statuses = replayUsageJournal(
+        entries, {.backend = other, .bundle = &writer});
+    REQUIRE(statuses.size() == 2);
+    REQUIRE(isOk(statuses[0]));
+    REQUIRE(writer.size() == 0);
+  }
+
+  SECTION("the bundle serves the journaled graph") {
+    // Both entries share a graph structure, so the bundle holds it once.
+    ArtifactBundleWriter writer;
+    std::vector<ErrorObject> statuses =
+        replayUsageJournal(entries, {.bundle = &writer});
+    REQUIRE(statuses.size() == 2);
+    REQUIRE(isOk(statuses[0]));
+    REQUIRE(isOk(statuses[1]));
+    REQUIRE(writer.size() == 1);
+    FUSILLI_REQUIRE_OK(writer.write(bundlePath));
+
+    FUSILLI_REQUIRE_ASSIGN(ArtifactBundle bundle,
+                           ArtifactBundle::open(bundlePath));
+    Graph graph = buildGraph();
+    FUSILLI_REQUIRE_OK(graph.validate());
+    FUSILLI_REQUIRE_OK(bundle.load(graph, handle));
+  }
+
+  SECTION("a mismatching fingerprint fails its entry only") {
+    entries[0].fingerprint = "stale";
+    std::vector<ErrorObject> statuses = replayUsageJournal(entries);
+    REQUIRE(statuses[0].getCode() == ErrorCode::InvalidArgument);
+    REQUIRE(isOk(statuses[1]));
+  }
+}
@@ -0,0 +1,210 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_kernel_cache";
+
+TEST_CASE("parseKernelCacheSize", "[KernelCache]") {
+  REQUIRE(detail::parseKernelCacheSize("512") == std::optional<uintmax_t>(512));
+  REQUIRE(detail::parseKernelCacheSize("64K") ==
+          std::optional<uintmax_t>(64 << 10));
+  REQUIRE(detail::parseKernelCacheSize("3m") ==
+          std::optional<uintmax_t>(3 << 20));
+  REQUIRE(detail::parseKernelCacheSize("10G") ==
+          std::optional<uintmax_t>(uintmax_t(10) << 30));
+  REQUIRE(!detail::parseKernelCacheSize("").has_value());
+  REQUIRE(!detail::parseKernelCacheSize("G").has_value());
+  REQUIRE(!detail::parseKernelCacheSize("-1").has_value());
+  REQUIRE(!detail::parseKernelCacheSize("10GB").has_value());
+  REQUIRE(!detail::parseKernelCacheSize("10X").has_value());
+}
+
+TEST_CASE("evictKernelCache removes least recently used entries",
+          "[KernelCache]") {
+  // Evict from a private cache directory so entries of concurrently running
+  // tests are left alone.
+  std::filesystem::path root =
+      CacheFile::getPath(kGraphName, "a").parent_path();
+  const char *cacheDirEnv = std::getenv("FUSILLI_CACHE_DIR");
+  std::optional<std::string> prevCacheDir;
+  if (cacheDirEnv)
+    prevCacheDir = cacheDirEnv;
+  REQUIRE(setEnv("FUSILLI_CACHE_DIR", root.string().c_str()) == 0);
+
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    if (prevCacheDir.has_value())
+      setEnv("FUSILLI_CACHE_DIR", prevCacheDir->c_str());
+    else
+      unsetEnv("FUSILLI_CACHE_DIR");
+    std::filesystem::remove_all(root);
+  });
+
+  // Three 100 byte entries, "a" least and "c" most recently used.
+  auto now = std::filesystem::file_time_type::clock::now();
+  int age = 3;
+  for (const char *key : {"a", "b", "c"}) {
+    FUSILLI_REQUIRE_OK(CacheFile::publish(
+        CacheFile::getKernelCachePath(key, "output"), std::string(100, 'x')));
+    std::filesystem::last_write_time(
+        CacheFile::getKernelCachePath(key, "").parent_path(),
+        now - std::chrono::hours(age--));
+  }
+  FUSILLI_REQUIRE_OK(
+      CacheFile::publish(CacheFile::getKernelCacheAliasPath("alias_a"), "a"));
+  FUSILLI_REQUIRE_OK(
+      CacheFile::publish(CacheFile::getKernelCacheAliasPath("alias_c"), "c"));
+
+  resetKernelCacheStats();
+
+  // Nothing to evict within the cap.
+  FUSILLI_REQUIRE_ASSIGN(size_t evicted, evictKernelCache(300));
+  REQUIRE(evicted == 0);
+
+  // Using "a" makes "b" the least recently used entry.
+  detail::touchKernelCacheEntry("a");
+  FUSILLI_REQUIRE_ASSIGN(evicted, evictKernelCache(250));
+  REQUIRE(evicted == 1);
+  REQUIRE(!std::filesystem::exists(
+      CacheFile::getKernelCachePath("b", "").parent_path()));
+  REQUIRE(
+      std::filesystem::exists(CacheFile::getKernelCachePath("a", "output")));
+  REQUIRE(
+      std::filesystem::exists(CacheFile::getKernelCachePath("c", "output")));
+
+  FUSILLI_REQUIRE_ASSIGN(evicted, evictKernelCache(0));
+  REQUIRE(evicted == 2);
+  // Aliases to evicted entries are removed with them.
+  REQUIRE(
+      !std::filesystem::exists(CacheFile::getKernelCacheAliasPath("alias_a")));
+  REQUIRE(
+      !std::filesystem::exists(CacheFile::getKernelCacheAliasPath("alias_c")));
+
+  KernelCacheStats stats = getKernelCacheStats();
+  REQUIRE(stats.evictions == 3);
+  REQUIRE(stats.evictedBytes == 300);
+
+  resetKernelCacheStats();
+  REQUIRE(getKernelCacheStats().evictions == 0);
+}
+
+TEST_CASE("evictKernelCache skips locked entries", "[KernelCache]") {
+  std::filesystem::path root =
+      CacheFile::getPath(kGraphName, "a").parent_path();
+  const char *cacheDirEnv = std::getenv("FUSILLI_CACHE_DIR");
+  std::optional<std::string> prevCacheDir;
+  if (cacheDirEnv)
+    prevCacheDir = cacheDirEnv;
+  REQUIRE(setEnv("FUSILLI_CACHE_DIR", root.string().c_str()) == 0);
+
+  auto cleanup = ScopeExit([&] {
+    if (prevCacheDir.has_value())
+      setEnv("FUSILLI_CACHE_DIR", prevCacheDir->c_str());
+    else
+      unsetEnv("FUSILLI_CACHE_DIR");
+    std::filesystem::remove_all(root);
+  });
+
+  FUSILLI_REQUIRE_OK(CacheFile::publish(
+      CacheFile::getKernelCachePath("locked", "output"), std::string(8, 'x')));
+  {
+    FUSILLI_REQUIRE_ASSIGN(
+        FileLock lock,
+        FileLock::acquire(CacheFile::getKernelCachePath("locked", ".lock")));
+    FUSILLI_REQUIRE_ASSIGN(size_t evicted, evictKernelCache(0));
+    REQUIRE(evicted == 0);
+  }
+  FUSILLI_REQUIRE_ASSIGN(size_t evicted, evictKernelCache(0));
+  REQUIRE(evicted == 1);
+}
+
+TEST_CASE("Kernel cache index records entries and aliases", "[KernelCache]") {
+  std::filesystem::path root =
+      CacheFile::getPath(kGraphName, "a").parent_path();
+  const char *cacheDirEnv = std::getenv("FUSILLI_CACHE_DIR");
+  std::optional<std::string> prevCacheDir;
+  if (cacheDirEnv)
+    prevCacheDir = cacheDirEnv;
+  REQUIRE(setEnv("FUSILLI_CACHE_DIR", root.string().c_str()) == 0);
+
+  auto cleanup = ScopeExit([&] {
+    if (prevCacheDir.has_value())
+      setEnv("FUSILLI_CACHE_DIR", prevCacheDir->c_str());
+    else
+      unsetEnv("FUSILLI_CACHE_DIR");
+    std::filesystem::remove_all(root);
+  });
+
+  using detail::KernelCacheIndex;
+  using detail::KernelCacheIndexKind;
+
+  // "a" only holds the output, "b" the output and a sidecar.
+  FUSILLI_REQUIRE_OK(CacheFile::publish(
+      CacheFile::getKernelCachePath("a", "output"), std::string(100, 'x')));
+  FUSILLI_REQUIRE_OK(CacheFile::publish(
+      CacheFile::getKernelCachePath("b", "output"), std::string(50, 'x')));
+  FUSILLI_REQUIRE_OK(CacheFile::publish(
+      CacheFile::getKernelCachePath("b", "digest"), std::string(10, 'x')));
+  REQUIRE(getKernelCacheUsage().entries == 0);
+  REQUIRE(!KernelCacheIndex::find(KernelCacheIndexKind::Entry, "a"));
+
+  // Eviction records entries published behind the index's back.
+  FUSILLI_REQUIRE_ASSIGN(size_t evicted, evictKernelCache(1000));
+  REQUIRE(evicted == 0);
+  KernelCacheUsage usage = getKernelCacheUsage();
+  REQUIRE(usage.entries == 2);
+  REQUIRE(usage.bytes == 160);
+  auto a = KernelCacheIndex::find(KernelCacheIndexKind::Entry, "a");
+  REQUIRE(a.has_value());
+  REQUIRE(a->size == 100);
+  REQUIRE(a->outputOnly);
+  auto b = KernelCacheIndex::find(KernelCacheIndexKind::Entry, "b");
+  REQUIRE(b.has_value());
+  REQUIRE(b->size == 60);
+  REQUIRE(!b->outputOnly);
+
+  // Aliases resolve through the index.
+  FUSILLI_REQUIRE_OK(
+      CacheFile::publish(CacheFile::getKernelCacheAliasPath("alias_a"), "a"));
+  FUSILLI_REQUIRE_OK(detail::indexKernelCacheAlias("alias_a", "a"));
+  auto alias = KernelCacheIndex::find(KernelCacheIndexKind::Alias, "alias_a");
+  REQUIRE(alias.has_value());
+  REQUIRE(alias->getTarget() == "a");
+  REQUIRE(KernelCacheIndex::touch("a"));
+  REQUIRE(!KernelCacheIndex::touch("alias_a"));
+
+  // Entries removed behind the index's back are dropped from it.
+  std::filesystem::remove_all(
+      CacheFile::getKernelCachePath("b", "").parent_path());
+  FUSILLI_REQUIRE_ASSIGN(evicted, evictKernelCache(1000));
+  REQUIRE(evicted == 0);
+  REQUIRE(getKernelCacheUsage().entries == 1);
+  REQUIRE(!KernelCacheIndex::find(KernelCacheIndexKind::Entry, "b"));
+
+  // Evicting an entry removes its aliases from the index too.
+  FUSILLI_REQUIRE_ASSIGN(evicted, evictKernelCache(0));
+  REQUIRE(evicted == 1);
+  REQUIRE(getKernelCacheUsage().entries == 0);
+  REQUIRE(getKernelCacheUsage().bytes == 0);
+  REQUIRE(!KernelCacheIndex::find(KernelCacheIndexKind::Alias, "alias_a"));
+  REQUIRE(
+      !std::filesystem::exists(CacheFile::getKernelCacheAliasPath("alias_a")));
+}
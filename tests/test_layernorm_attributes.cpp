@@ -62,3 +62,22 @@ TEST_CASE("LayernormAttr setters and getters", "[layernorm_attr]") {
 
 #undef CHECK_TENSOR_PROPERTIES
 }
+
+TEST_CASE("LayernormAttr residual setters and getters", "[layernorm_attr]") {
+  LayernormAttr attr;
+
+  REQUIRE(attr.getRESIDUAL() == nullptr);
+  REQUIRE(attr.getSUM() == nullptr);
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto res = std::make_shared<TensorAttr>(2.0f);
+  auto y = std::make_shared<TensorAttr>(3.0f);
+  auto sum = std::make_shared<TensorAttr>(4.0f);
+
+  attr.setX(x).setRESIDUAL(res).setY(y).setSUM(sum);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.outputs.size() == 2);
+  REQUIRE(attr.getRESIDUAL() == res);
+  REQUIRE(attr.getSUM() == sum);
+}
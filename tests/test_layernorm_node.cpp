@@ -11,6 +11,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -571,3 +572,77 @@ TEST_CASE("LayerNormNode postValidateNode detects incorrect shapes and strides",
             "LayerNorm output INV_VARIANCE tensor must have unit strides");
   }
 }
+
+TEST_CASE("LayerNormBwdNode validation and gradient inference",
+          "[layernorm_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  int64_t n = 2, c = 3, d = 4;
+  auto tensor = [](const std::string &name, const std::vector<int64_t> &dim) {
+    return std::make_shared<TensorAttr>(
+        TensorAttr().setName(name).setDim(dim).setStride(
+            generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+
+  LayernormBwdAttr attr;
+  attr.setName("layernorm_bwd");
+  attr.setDY(tensor("DY", {n, c, d}));
+  attr.setX(tensor("X", {n, c, d}));
+  attr.setSCALE(std::make_shared<TensorAttr>());
+  attr.setMEAN(tensor("MEAN", {n, 1, 1}));
+  attr.setINV_VARIANCE(tensor("INV_VARIANCE", {n, 1, 1}));
+  attr.setDX(std::make_shared<TensorAttr>());
+  attr.setDSCALE(std::make_shared<TensorAttr>());
+  attr.setDBIAS(std::make_shared<TensorAttr>());
+
+  SECTION("Gradients take the shapes of X and SCALE") {
+    LayerNormBwdNode node(std::move(attr), ctx);
+    REQUIRE(node.getType() == INode::Type::LayerNormBwd);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    const LayernormBwdAttr &bwdAttr = node.layernormBwdAttr;
+    REQUIRE(bwdAttr.getDX()->getDim() == std::vector<int64_t>{n, c, d});
+    REQUIRE(bwdAttr.getDSCALE()->getDim() == std::vector<int64_t>{1, c, d});
+    REQUIRE(bwdAttr.getDBIAS()->getDim() == std::vector<int64_t>{1, c, d});
+    REQUIRE(bwdAttr.getSCALE()->getDim() == std::vector<int64_t>{1, c, d});
+    REQUIRE(bwdAttr.getDX()->getDataType() == DataType::Half);
+  }
+
+  SECTION("SCALE without DSCALE") {
+    attr.setDSCALE(nullptr);
+    LayerNormBwdNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "LayerNorm backward SCALE and DSCALE tensors must be set together");
+  }
+
+  SECTION("DY must match X") {
+    attr.setDY(tensor("DY", {n, c, d + 1}));
+    LayerNormBwdNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "LayerNorm backward input tensor DY must have the same shape as "
+            "input X tensor");
+  }
+
+  SECTION("MEAN must have the shape of the saved statistics") {
+    attr.setMEAN(tensor("MEAN", {n, c, 1}));
+    LayerNormBwdNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+}
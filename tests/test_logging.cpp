@@ -53,6 +53,28 @@ TEST_CASE("ConditionalStreamer conditioned on isLoggingEnabled", "[logging]") {
   REQUIRE(!isLoggingEnabled());
 }
 
+TEST_CASE("Logging macros only evaluate their message when logging",
+          "[logging]") {
+  int evaluations = 0;
+  auto message = [&]() {
+    ++evaluations;
+    return "lazy";
+  };
+  // Initialize the stream first, which disables logging when
+  // FUSILLI_LOG_FILE is not set (see `getStream()`).
+  (void)getLogger();
+
+  isLoggingEnabled() = false;
+  FUSILLI_LOG_LABEL_ENDL("message: " << message());
+  REQUIRE(evaluations == 0);
+
+  // Compiled out logging never evaluates messages.
+  isLoggingEnabled() = true;
+  FUSILLI_LOG_LABEL_ENDL("message: " << message());
+  REQUIRE(evaluations == (kLoggingCompiledIn ? 1 : 0));
+  isLoggingEnabled() = false;
+}
+
 // This test is disabled because getStream() statically initializes
 // the stream ref picking the first snapshot of FUSILLI_LOG_FILE
 // env variable. So subsequent tests that change the env variable (in
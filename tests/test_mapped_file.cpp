@@ -0,0 +1,75 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_mapped_file";
+
+TEST_CASE("MappedFile::open maps file contents", "[MappedFile]") {
+  // Ensure cleanup happens even if REQUIRE() fails.
+  auto cleanup = ScopeExit([&] {
+    std::filesystem::remove_all(
+        CacheFile::getPath(kGraphName, "a").parent_path());
+  });
+
+  FUSILLI_REQUIRE_ASSIGN(CacheFile cf, CacheFile::create(
+                                           /*graphName=*/kGraphName,
+                                           /*filename=*/"contents",
+                                           /*remove=*/true));
+  FUSILLI_REQUIRE_OK(cf.write("fusilli"));
+
+  FUSILLI_REQUIRE_ASSIGN(MappedFile file, MappedFile::open(cf.path));
+  std::vector<uint8_t> expected = {'f', 'u', 's', 'i', 'l', 'l', 'i'};
+  REQUIRE(std::vector<uint8_t>(file.bytes().begin(), file.bytes().end()) ==
+          expected);
+
+  SECTION("move construction transfers the mapping") {
+    MappedFile moved(std::move(file));
+    REQUIRE(moved.bytes().size() == expected.size());
+    REQUIRE(file.bytes().empty());
+  }
+
+#if !defined(FUSILLI_PLATFORM_WINDOWS)
+  SECTION("mapping outlives removal of the file") {
+    std::filesystem::remove(cf.path);
+    REQUIRE(std::vector<uint8_t>(file.bytes().begin(), file.bytes().end()) ==
+            expected);
+  }
+#endif
+}
+
+TEST_CASE("MappedFile::open empty file", "[MappedFile]") {
+  auto cleanup = ScopeExit([&] {
+    std::filesystem::remove_all(
+        CacheFile::getPath(kGraphName, "a").parent_path());
+  });
+
+  FUSILLI_REQUIRE_ASSIGN(CacheFile cf, CacheFile::create(
+                                           /*graphName=*/kGraphName,
+                                           /*filename=*/"empty",
+                                           /*remove=*/true));
+  FUSILLI_REQUIRE_ASSIGN(MappedFile file, MappedFile::open(cf.path));
+  REQUIRE(file.bytes().empty());
+}
+
+TEST_CASE("MappedFile::open missing file", "[MappedFile]") {
+  ErrorOr<MappedFile> file =
+      MappedFile::open(CacheFile::getPath(kGraphName, "does_not_exist"));
+  REQUIRE(isError(file));
+  REQUIRE(ErrorObject(file).getCode() == ErrorCode::FileSystemFailure);
+}
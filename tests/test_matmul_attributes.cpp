@@ -59,6 +59,126 @@ TEST_CASE("MatmulAttr setters and getters", "[matmul_attr]") {
   REQUIRE(attr.getC()->isVirtual() == false);
 }
 
+TEST_CASE("MatmulAttr epilogue setters and getters", "[matmul_attr]") {
+  MatmulAttr attr;
+
+  REQUIRE(attr.getBIAS() == nullptr);
+  REQUIRE(attr.getRESIDUAL() == nullptr);
+  REQUIRE(attr.getActivation() == PointwiseAttr::Mode::NOT_SET);
+  REQUIRE(attr.getAlpha() == 1.0f);
+  REQUIRE(attr.getBeta() == 1.0f);
+  REQUIRE(!attr.hasEpilogue());
+
+  attr.setAlpha(0.5f);
+  REQUIRE(attr.getAlpha() == 0.5f);
+  REQUIRE(attr.hasEpilogue());
+
+  auto bias = std::make_shared<TensorAttr>(1.0f);
+  auto residual = std::make_shared<TensorAttr>(2.0f);
+  attr.setBIAS(bias)
+      .setRESIDUAL(residual)
+      .setActivation(PointwiseAttr::Mode::RELU_FWD)
+      .setBeta(2.0f);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getBIAS() == bias);
+  REQUIRE(attr.getRESIDUAL() == residual);
+  REQUIRE(attr.getActivation() == PointwiseAttr::Mode::RELU_FWD);
+  REQUIRE(attr.getBeta() == 2.0f);
+}
+
+TEST_CASE("MatmulAttr scale setters and getters", "[matmul_attr]") {
+  MatmulAttr attr;
+
+  REQUIRE(attr.getSCALE_A() == nullptr);
+  REQUIRE(attr.getSCALE_B() == nullptr);
+  REQUIRE(!attr.hasScales());
+
+  auto scaleA = std::make_shared<TensorAttr>(0.5f);
+  auto scaleB = std::make_shared<TensorAttr>(0.25f);
+  attr.setSCALE_A(scaleA).setSCALE_B(scaleB);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getSCALE_A() == scaleA);
+  REQUIRE(attr.getSCALE_B() == scaleB);
+  REQUIRE(attr.hasScales());
+}
+
+TEST_CASE("MatmulAttr group sizes setter and getter", "[matmul_attr]") {
+  MatmulAttr attr;
+
+  REQUIRE(attr.getGROUP_SIZES() == nullptr);
+  REQUIRE(!attr.isGrouped());
+
+  auto groupSizes = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({8}).setStride({1}).setName("group_sizes"));
+  attr.setGROUP_SIZES(groupSizes);
+
+  REQUIRE(attr.inputs.size() == 1);
+  REQUIRE(attr.getGROUP_SIZES() == groupSizes);
+  REQUIRE(attr.isGrouped());
+}
+
+TEST_CASE("MatmulAttr sparsity metadata setter and getter", "[matmul_attr]") {
+  MatmulAttr attr;
+
+  REQUIRE(attr.getB_META() == nullptr);
+  REQUIRE(!attr.isSparse());
+
+  auto meta = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({16, 8}).setStride({8, 1}).setName("b_meta"));
+  attr.setB_META(meta);
+
+  REQUIRE(attr.inputs.size() == 1);
+  REQUIRE(attr.getB_META() == meta);
+  REQUIRE(attr.isSparse());
+}
+
+TEST_CASE("MatmulAttr group quantization setters and getters",
+          "[matmul_attr]") {
+  MatmulAttr attr;
+
+  REQUIRE(attr.getB_SCALE() == nullptr);
+  REQUIRE(attr.getB_ZERO() == nullptr);
+  REQUIRE(attr.getGroupSize() == 0);
+  REQUIRE(!attr.isGroupQuantized());
+
+  auto scale = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({2, 8}).setStride({8, 1}).setName("b_scale"));
+  auto zero = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({2, 8}).setStride({8, 1}).setName("b_zero"));
+  attr.setB_SCALE(scale).setB_ZERO(zero).setGroupSize(128);
+
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getB_SCALE() == scale);
+  REQUIRE(attr.getB_ZERO() == zero);
+  REQUIRE(attr.getGroupSize() == 128);
+  REQUIRE(attr.isGroupQuantized());
+}
+
+TEST_CASE("MatmulAttr lowering hint setters and getters", "[matmul_attr]") {
+  MatmulAttr attr;
+
+  REQUIRE(attr.getSplitK() == 1);
+  REQUIRE(!attr.isSplitK());
+  REQUIRE(!attr.hasLoweringConfig());
+  REQUIRE(attr.getSubgroupSize() == 64);
+  REQUIRE(attr.getMmaIntrinsic().empty());
+
+  attr.setSplitK(4)
+      .setTileSizes({64, 64, 0}, {0, 0, 32}, {256, 1, 1}, 32)
+      .setMmaIntrinsic("MFMA_F32_16x16x16_F16");
+
+  REQUIRE(attr.getSplitK() == 4);
+  REQUIRE(attr.isSplitK());
+  REQUIRE(attr.hasLoweringConfig());
+  REQUIRE(attr.getWorkgroupTile() == std::vector<int64_t>{64, 64, 0});
+  REQUIRE(attr.getReductionTile() == std::vector<int64_t>{0, 0, 32});
+  REQUIRE(attr.getWorkgroupSize() == std::vector<int64_t>{256, 1, 1});
+  REQUIRE(attr.getSubgroupSize() == 32);
+  REQUIRE(attr.getMmaIntrinsic() == "MFMA_F32_16x16x16_F16");
+}
+
 TEST_CASE("MatmulAttr with matrix tensors", "[matmul_attr]") {
   MatmulAttr attr;
 
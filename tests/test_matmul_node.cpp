@@ -766,3 +766,625 @@ TEST_CASE("MatmulNode mixed precision constraints", "[matmul_node]") {
             "batch dim=8");
   }
 }
+
+TEST_CASE("MatmulNode epilogue checks", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  int64_t m = 16, k = 32, n = 64;
+
+  auto aT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({m, k}).setStride({k, 1}).setName("A"));
+  auto bT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({k, n}).setStride({n, 1}).setName("B"));
+  auto cT = std::make_shared<TensorAttr>(TensorAttr().setName("C"));
+  attr.setA(aT).setB(bT).setC(cT);
+  ctx.setIODataType(DataType::Float);
+
+  SECTION("Supported epilogue - pass") {
+    auto biasT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({1, n}).setStride({n, 1}).setName("bias"));
+    auto residualT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({m, n}).setStride({n, 1}).setName("residual"));
+    attr.setBIAS(biasT)
+        .setRESIDUAL(residualT)
+        .setActivation(PointwiseAttr::Mode::GELU_FWD)
+        .setAlpha(0.5f)
+        .setBeta(2.0f);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+  }
+
+  SECTION("Unsupported activation - fail") {
+    attr.setActivation(PointwiseAttr::Mode::ADD);
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Matmul epilogue activation ADD is not supported");
+  }
+
+  SECTION("Beta without residual - fail") {
+    attr.setBeta(2.0f);
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "Matmul epilogue beta is set but residual tensor RESIDUAL is not");
+  }
+
+  SECTION("Bias not broadcastable - fail") {
+    auto biasT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({1, n / 2}).setStride({n / 2, 1}).setName("bias"));
+    attr.setBIAS(biasT);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul epilogue tensor BIAS is not broadcastable to output tensor "
+            "C at index 1: BIAS has dim=32, C has dim=64");
+  }
+
+  SECTION("Residual shape mismatch - fail") {
+    auto residualT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({1, n}).setStride({n, 1}).setName("residual"));
+    attr.setRESIDUAL(residualT);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul epilogue tensor RESIDUAL dimensions do not match output "
+            "tensor C dimensions");
+  }
+}
+
+TEST_CASE("MatmulNode scale checks", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  int64_t m = 16, k = 32, n = 64;
+
+  auto aT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({m, k})
+                                             .setStride({k, 1})
+                                             .setDataType(DataType::FP8E4M3FN)
+                                             .setName("A"));
+  auto bT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({k, n})
+                                             .setStride({n, 1})
+                                             .setDataType(DataType::FP8E4M3FN)
+                                             .setName("B"));
+  auto cT = std::make_shared<TensorAttr>(TensorAttr().setName("C"));
+  attr.setA(aT).setB(bT).setC(cT);
+  ctx.setIODataType(DataType::Half);
+
+  SECTION("Per tensor and per column scales - pass") {
+    auto scaleAT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({1, 1}).setStride({1, 1}).setName("scale_a"));
+    auto scaleBT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({1, n}).setStride({n, 1}).setName("scale_b"));
+    attr.setSCALE_A(scaleAT).setSCALE_B(scaleBT);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.matmulAttr.getSCALE_A()->getDataType() == DataType::Float);
+  }
+
+  SECTION("Non-quantized inputs - fail") {
+    aT->setDataType(DataType::Half);
+    bT->setDataType(DataType::Half);
+    auto scaleAT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({1, 1}).setStride({1, 1}).setName("scale_a"));
+    attr.setSCALE_A(scaleAT);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul scales require input tensors A and B of the same FP8 or "
+            "Int8 data type");
+  }
+
+  SECTION("Scale varying along K - fail") {
+    auto scaleAT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({m, k}).setStride({k, 1}).setName("scale_a"));
+    attr.setSCALE_A(scaleAT);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Matmul scale tensor SCALE_A must be per "
+                                   "tensor or per row of A [..., M, 1]");
+  }
+}
+
+TEST_CASE("MatmulNode grouped checks", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  int64_t e = 8, m = 16, k = 32, n = 64;
+
+  auto aT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({e, m, k})
+                                             .setStride({m * k, k, 1})
+                                             .setName("A"));
+  auto bT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({e, k, n})
+                                             .setStride({k * n, n, 1})
+                                             .setName("B"));
+  auto cT = std::make_shared<TensorAttr>(TensorAttr().setName("C"));
+  auto groupSizesT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({e}).setStride({1}).setName("group_sizes"));
+  attr.setA(aT).setB(bT).setC(cT).setGROUP_SIZES(groupSizesT);
+  ctx.setIODataType(DataType::Float);
+
+  SECTION("Group sizes default to Int32 - pass") {
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(groupSizesT->getDataType() == DataType::Int32);
+    REQUIRE(node.matmulAttr.getC()->getDim() ==
+            std::vector<int64_t>{e, m, n});
+  }
+
+  SECTION("Broadcast group count - fail") {
+    bT->setDim({1, k, n}).setStride({k * n, n, 1});
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Grouped matmul requires input tensors A [E, M, K] and B [E, K, "
+            "N] with the same group count E");
+  }
+
+  SECTION("Group sizes of the wrong length - fail") {
+    groupSizesT->setDim({e / 2});
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Grouped matmul tensor GROUP_SIZES must have dims [E]");
+  }
+
+  SECTION("Floating point group sizes - fail") {
+    groupSizesT->setDataType(DataType::Float);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Grouped matmul tensor GROUP_SIZES must "
+                                   "have data type Int32 or Int64");
+  }
+}
+
+TEST_CASE("MatmulNode bias gradient checks", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  int64_t b = 2, m = 16, k = 32, n = 64;
+
+  // A is DY^T [B, N, M], viewed from a row-major DY [B, M, N].
+  auto aT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({b, n, m})
+                                             .setStride({m * n, 1, n})
+                                             .setName("A"));
+  auto bT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({b, m, k})
+                                             .setStride({m * k, k, 1})
+                                             .setName("B"));
+  auto cT = std::make_shared<TensorAttr>(TensorAttr().setName("C"));
+  auto dbT = std::make_shared<TensorAttr>(TensorAttr().setName("DBIAS"));
+  attr.setA(aT).setB(bT).setC(cT).setDBIAS(dbT);
+  ctx.setIODataType(DataType::Float);
+
+  SECTION("DBIAS is inferred as A without the contraction dim - pass") {
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.matmulAttr.hasBiasGradient());
+    REQUIRE(dbT->getDim() == std::vector<int64_t>{b, n});
+    REQUIRE(dbT->getStride() == std::vector<int64_t>{n, 1});
+  }
+
+  SECTION("DBIAS of the wrong shape - fail") {
+    dbT->setDim({b, m}).setStride({m, 1});
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul bias gradient tensor DBIAS dimensions must be those of "
+            "input tensor A without the contraction dim [..., M]");
+  }
+
+  SECTION("DBIAS with scales - fail") {
+    auto scaleT = std::make_shared<TensorAttr>(
+        TensorAttr().setDim({1, 1, 1}).setStride({1, 1, 1}).setName("S"));
+    attr.setSCALE_A(scaleT);
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() == "Matmul bias gradient DBIAS is not "
+                                   "supported with scales or groups");
+  }
+}
+
+TEST_CASE("MatmulNode gate checks", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  int64_t m = 16, k = 32, n = 64;
+
+  auto aT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({m, k}).setStride({k, 1}).setName("A"));
+  auto bT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({k, 2 * n}).setStride({2 * n, 1}).setName("B"));
+  auto cT = std::make_shared<TensorAttr>(TensorAttr().setName("C"));
+  attr.setA(aT).setB(bT).setC(cT).setGate(PointwiseAttr::Mode::SWISH_FWD);
+  ctx.setIODataType(DataType::Half);
+
+  SECTION("C is inferred as one half of the product - pass") {
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.matmulAttr.isGated());
+    REQUIRE(cT->getDim() == std::vector<int64_t>{m, n});
+    REQUIRE(cT->getStride() == std::vector<int64_t>{n, 1});
+  }
+
+  SECTION("Unsupported gate activation - fail") {
+    attr.setGate(PointwiseAttr::Mode::ADD);
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Matmul gate activation ADD is not supported");
+  }
+
+  SECTION("Gate with an epilogue - fail") {
+    attr.setActivation(PointwiseAttr::Mode::RELU_FWD);
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Gated matmul is not supported with an epilogue, scales, groups "
+            "or a bias gradient");
+  }
+
+  SECTION("Odd packed projections - fail") {
+    bT->setDim({k, 2 * n + 1}).setStride({2 * n + 1, 1});
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Gated matmul input tensor B must pack the gate and up "
+            "projections [..., K, 2N]: B has last dim=129");
+  }
+
+  SECTION("C of the product shape - fail") {
+    cT->setDim({m, 2 * n});
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+}
+
+TEST_CASE("MatmulNode sparse checks", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  int64_t m = 16, k = 32, n = 64;
+
+  auto aT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({m, k}).setStride({k, 1}).setName("A"));
+  auto bT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({k / 2, n}).setStride({n, 1}).setName("B"));
+  auto cT = std::make_shared<TensorAttr>(TensorAttr().setName("C"));
+  auto metaT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({k / 2, n}).setStride({n, 1}).setName("B_META"));
+  attr.setA(aT).setB(bT).setC(cT).setB_META(metaT);
+  ctx.setIODataType(DataType::Half);
+
+  SECTION("Packed B and Int8 metadata - pass") {
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(metaT->getDataType() == DataType::Int8);
+    REQUIRE(node.getDenseBDim() == std::vector<int64_t>{k, n});
+    REQUIRE(node.matmulAttr.getC()->getDim() == std::vector<int64_t>{m, n});
+  }
+
+  SECTION("Dense B - fail") {
+    bT->setDim({k, n});
+    metaT->setDim({k, n});
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul input tensors A and B have incompatible inner dimensions "
+            "(K): A has K=32, B has K=64");
+  }
+
+  SECTION("Metadata dims mismatch - fail") {
+    metaT->setDim({k / 4, n});
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Sparse matmul tensor B_META dimensions must match input tensor B");
+  }
+
+  SECTION("Odd packed contraction dim - fail") {
+    aT->setDim({m, 6}).setStride({6, 1});
+    bT->setDim({3, n});
+    metaT->setDim({3, n});
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Sparse matmul input tensor B must hold two values per group of "
+            "four rows [..., K/2, N]: B has K/2=3");
+  }
+
+  SECTION("Int32 metadata - fail") {
+    metaT->setDataType(DataType::Int32);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Sparse matmul tensor B_META must have data type Int8");
+  }
+}
+
+TEST_CASE("MatmulNode group quantization checks", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  int64_t m = 16, k = 256, n = 64, groupSize = 128;
+
+  auto aT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({m, k}).setStride({k, 1}).setName("A"));
+  auto bT = std::make_shared<TensorAttr>(TensorAttr()
+                                             .setDim({k, n})
+                                             .setStride({n, 1})
+                                             .setDataType(DataType::Int4)
+                                             .setName("B"));
+  auto cT = std::make_shared<TensorAttr>(TensorAttr().setName("C"));
+  auto scaleT = std::make_shared<TensorAttr>(TensorAttr()
+                                                 .setDim({k / groupSize, n})
+                                                 .setStride({n, 1})
+                                                 .setName("B_SCALE"));
+  auto zeroT = std::make_shared<TensorAttr>(TensorAttr()
+                                                .setDim({k / groupSize, n})
+                                                .setStride({n, 1})
+                                                .setDataType(DataType::Int4)
+                                                .setName("B_ZERO"));
+  attr.setA(aT).setB(bT).setC(cT).setB_SCALE(scaleT).setB_ZERO(zeroT);
+  attr.setGroupSize(groupSize);
+  ctx.setIODataType(DataType::Half);
+
+  SECTION("Int4 B with Half scales and Int4 zeros - pass") {
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(scaleT->getDataType() == DataType::Half);
+    REQUIRE(node.matmulAttr.getC()->getDim() == std::vector<int64_t>{m, n});
+  }
+
+  SECTION("Batched mixed precision without zeros - pass") {
+    aT->setDim({2, m, k}).setStride({m * k, k, 1});
+    bT->setDim({1, k, n}).setStride({k * n, n, 1});
+    scaleT->setDim({1, k / groupSize, n}).setStride({k / groupSize * n, n, 1});
+    attr.setB_ZERO(nullptr);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+
+  SECTION("Group size not dividing K - fail") {
+    attr.setGroupSize(96);
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Group-quantized matmul group size 96 does not divide the "
+            "contraction dim K=256");
+  }
+
+  SECTION("Scale dims mismatch - fail") {
+    scaleT->setDim({k / groupSize, 1}).setStride({1, 1});
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Group-quantized matmul tensor B_SCALE must hold one value per "
+            "group of B [..., K/G, N]");
+  }
+
+  SECTION("Zeros without scales - fail") {
+    attr.setB_SCALE(nullptr);
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "Matmul tensor B_ZERO is set but tensor B_SCALE is not");
+  }
+
+  SECTION("Float scales with Half A - fail") {
+    scaleT->setDataType(DataType::Float);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Group-quantized matmul tensor B_SCALE must have the data type of "
+            "input tensor A");
+  }
+
+  SECTION("Half B - fail") {
+    bT->setDataType(DataType::Half);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Group-quantized matmul input tensor B must have data type Int4, "
+            "Int8 or Uint8");
+  }
+}
+
+TEST_CASE("MatmulNode lowering hint checks", "[matmul_node]") {
+  Context ctx;
+  MatmulAttr attr;
+
+  int64_t m = 16, k = 256, n = 8;
+
+  auto aT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({m, k}).setStride({k, 1}).setName("A"));
+  auto bT = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({k, n}).setStride({n, 1}).setName("B"));
+  auto cT = std::make_shared<TensorAttr>(TensorAttr().setName("C"));
+  attr.setA(aT).setB(bT).setC(cT);
+  ctx.setIODataType(DataType::Half);
+
+  SECTION("Split-K dividing K - pass") {
+    attr.setSplitK(8);
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(cT->getDim() == std::vector<int64_t>{m, n});
+  }
+
+  SECTION("Split-K not dividing K - fail") {
+    attr.setSplitK(3);
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul split-K 3 does not divide the contraction dim K=256");
+  }
+
+  SECTION("Split-K with tile sizes - fail") {
+    attr.setSplitK(2).setTileSizes({16, 8, 0}, {0, 0, 64}, {64, 1, 1});
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() ==
+            "Matmul split-K is not supported with scales, groups, sparse, "
+            "group-quantized or gated weights, a bias gradient or tile "
+            "sizes");
+  }
+
+  SECTION("Tile sizes covering [M, N, K] - pass") {
+    attr.setTileSizes({16, 8, 0}, {0, 0, 64}, {64, 1, 1})
+        .setMmaIntrinsic("MFMA_F32_16x16x16_F16");
+
+    MatmulNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+
+  SECTION("Tile sizes of the wrong rank - fail") {
+    attr.setTileSizes({16, 8}, {0, 64}, {64, 1, 1});
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Matmul tile sizes must cover the 3 loops [..., M, N, K] of the "
+            "matmul");
+  }
+
+  SECTION("MMA intrinsic without tile sizes - fail") {
+    attr.setMmaIntrinsic("MFMA_F32_16x16x16_F16");
+
+    MatmulNode node(std::move(attr), ctx);
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "Matmul MMA intrinsic is set but tile sizes are not");
+  }
+}
@@ -0,0 +1,74 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("OptimizerAttr default constructor", "[optimizer_attr]") {
+  OptimizerAttr attr;
+  REQUIRE(attr.getMode() == OptimizerAttr::Mode::NOT_SET);
+  REQUIRE_FALSE(attr.getNesterov());
+  REQUIRE(attr.getParams().empty());
+  REQUIRE(attr.getGrads().empty());
+  REQUIRE(attr.getMoments1().empty());
+  REQUIRE(attr.getMoments2().empty());
+  REQUIRE(attr.getNewParams().empty());
+  REQUIRE(attr.inputs.empty());
+  REQUIRE(attr.outputs.empty());
+}
+
+TEST_CASE("OptimizerAttr setters and getters", "[optimizer_attr]") {
+  OptimizerAttr attr;
+  attr.setMode(OptimizerAttr::Mode::SGD).setNesterov(true);
+  REQUIRE(attr.getMode() == OptimizerAttr::Mode::SGD);
+  REQUIRE(attr.getNesterov());
+
+  auto lr = std::make_shared<TensorAttr>(0.1f);
+  auto wd = std::make_shared<TensorAttr>(0.01f);
+  attr.setLR(lr).setWEIGHT_DECAY(wd);
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getLR() == lr);
+  REQUIRE(attr.getWEIGHT_DECAY() == wd);
+  REQUIRE(attr.getMOMENTUM() == nullptr);
+
+  std::vector<std::shared_ptr<TensorAttr>> params = {
+      std::make_shared<TensorAttr>(), std::make_shared<TensorAttr>()};
+  std::vector<std::shared_ptr<TensorAttr>> grads = {
+      std::make_shared<TensorAttr>(), std::make_shared<TensorAttr>()};
+  attr.setParams(params).setGrads(grads).setNewParams(params);
+  REQUIRE(attr.getParams() == params);
+  REQUIRE(attr.getGrads() == grads);
+  REQUIRE(attr.getNewParams() == params);
+}
+
+TEST_CASE("OptimizerAttr moments of each mode", "[optimizer_attr]") {
+  OptimizerAttr attr;
+  attr.setMode(OptimizerAttr::Mode::SGD);
+  REQUIRE_FALSE(attr.hasMoments1());
+  REQUIRE_FALSE(attr.hasMoments2());
+
+  attr.setMOMENTUM(std::make_shared<TensorAttr>(0.9f));
+  REQUIRE(attr.hasMoments1());
+  REQUIRE_FALSE(attr.hasMoments2());
+
+  for (auto mode : {OptimizerAttr::Mode::ADAM, OptimizerAttr::Mode::ADAMW}) {
+    attr.setMode(mode);
+    REQUIRE(attr.hasMoments1());
+    REQUIRE(attr.hasMoments2());
+  }
+}
+
+TEST_CASE("OptimizerAttr mode names", "[optimizer_attr]") {
+  REQUIRE(OptimizerAttr::kModeToStr.at(OptimizerAttr::Mode::SGD) == "SGD");
+  REQUIRE(OptimizerAttr::kModeToStr.at(OptimizerAttr::Mode::ADAM) == "ADAM");
+  REQUIRE(OptimizerAttr::kModeToStr.at(OptimizerAttr::Mode::ADAMW) ==
+          "ADAMW");
+}
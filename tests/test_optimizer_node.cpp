@@ -0,0 +1,172 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+using TensorList = std::vector<std::shared_ptr<TensorAttr>>;
+
+// Helper to create a contiguous tensor.
+static std::shared_ptr<TensorAttr> makeTensor(const std::string &name,
+                                              const std::vector<int64_t> &dim) {
+  auto stride =
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+  return std::make_shared<TensorAttr>(
+      TensorAttr().setName(name).setDim(dim).setStride(stride));
+}
+
+// Helper to create one tensor of each of `dims`, named `prefix` + index.
+static TensorList makeTensors(const std::string &prefix,
+                              const std::vector<std::vector<int64_t>> &dims) {
+  TensorList tensors;
+  for (size_t i = 0; i < dims.size(); ++i)
+    tensors.push_back(makeTensor(prefix + std::to_string(i), dims[i]));
+  return tensors;
+}
+
+// Helper to create `count` tensors to be inferred.
+static TensorList makeOutputs(size_t count) {
+  TensorList tensors;
+  for (size_t i = 0; i < count; ++i)
+    tensors.push_back(std::make_shared<TensorAttr>());
+  return tensors;
+}
+
+// Returns Adam attributes updating two parameters.
+static OptimizerAttr makeAdamAttr() {
+  const std::vector<std::vector<int64_t>> dims = {{4, 8}, {8}};
+  OptimizerAttr attr;
+  attr.setMode(OptimizerAttr::Mode::ADAM)
+      .setLR(std::make_shared<TensorAttr>(1e-3f))
+      .setBETA1(std::make_shared<TensorAttr>(0.9f))
+      .setBETA2(std::make_shared<TensorAttr>(0.999f))
+      .setEPSILON(std::make_shared<TensorAttr>(1e-8f))
+      .setSTEP(std::make_shared<TensorAttr>(1.0f));
+  attr.setParams(makeTensors("p", dims))
+      .setGrads(makeTensors("g", dims))
+      .setMoments1(makeTensors("m", dims))
+      .setMoments2(makeTensors("v", dims))
+      .setNewParams(makeOutputs(2))
+      .setNewMoments1(makeOutputs(2))
+      .setNewMoments2(makeOutputs(2));
+  return attr;
+}
+
+TEST_CASE("OptimizerNode getName and getType", "[optimizer_node]") {
+  Context ctx;
+  OptimizerAttr attr;
+  attr.setName("foo_optimizer");
+
+  OptimizerNode node(std::move(attr), ctx);
+  REQUIRE(node.getName() == "foo_optimizer");
+  REQUIRE(node.getType() == INode::Type::Optimizer);
+}
+
+TEST_CASE("OptimizerNode preValidateNode detects invalid attributes",
+          "[optimizer_node]") {
+  Context ctx;
+  OptimizerAttr attr = makeAdamAttr();
+  ErrorCode code = ErrorCode::InvalidAttribute;
+  std::string message;
+
+  SECTION("Mode missing") {
+    attr.setMode(OptimizerAttr::Mode::NOT_SET);
+    code = ErrorCode::AttributeNotSet;
+    message = "Optimizer mode not set";
+  }
+
+  SECTION("Moments missing") {
+    attr.setMoments2({});
+    message = "Optimizer ADAM expects 2 moments2, got 0";
+  }
+
+  SECTION("Moments without momentum") {
+    attr.setMode(OptimizerAttr::Mode::SGD);
+    message = "Optimizer SGD expects 0 moments1, got 2";
+  }
+
+  SECTION("Gradient dims mismatch") {
+    attr.setGrads({makeTensor("g0", {4, 8}), makeTensor("g1", {4})});
+    message = "Optimizer tensor 'g1' must have the dims of param 'p1'";
+  }
+
+  SECTION("Adam hyperparameter missing") {
+    attr.setSTEP(nullptr);
+    code = ErrorCode::AttributeNotSet;
+    message = "Optimizer ADAM requires BETA1, BETA2, EPSILON and STEP";
+  }
+
+  SECTION("Non-scalar hyperparameter") {
+    attr.setLR(makeTensor("lr", {2}));
+    message = "Optimizer hyperparameter 'lr' must be a float scalar";
+  }
+
+  SECTION("Nesterov without SGD") {
+    attr.setNesterov(true);
+    message = "Optimizer Nesterov momentum is only supported by SGD";
+  }
+
+  OptimizerNode node(std::move(attr), ctx);
+  auto status = node.preValidateNode();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == code);
+  REQUIRE(status.getMessage() == message);
+}
+
+TEST_CASE("OptimizerNode inferPropertiesNode infers the new tensors",
+          "[optimizer_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  OptimizerAttr attr = makeAdamAttr();
+  OptimizerNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  const OptimizerAttr &inferred = node.optimizerAttr;
+  for (size_t i = 0; i < 2; ++i) {
+    for (const auto &[out, in] :
+         {std::pair{inferred.getNewParams()[i], inferred.getParams()[i]},
+          std::pair{inferred.getNewMoments1()[i], inferred.getMoments1()[i]},
+          std::pair{inferred.getNewMoments2()[i],
+                    inferred.getMoments2()[i]}}) {
+      REQUIRE(out->getDim() == in->getDim());
+      REQUIRE(out->getStride() == in->getStride());
+      REQUIRE(out->getDataType() == DataType::Float);
+    }
+  }
+
+  // Both parameters (40 elements) at 12 operations per element.
+  REQUIRE(node.estimateFlops() == 480);
+}
+
+TEST_CASE("OptimizerNode collectTensors lists all tensors",
+          "[optimizer_node]") {
+  Context ctx;
+  OptimizerAttr attr = makeAdamAttr();
+  OptimizerNode node(std::move(attr), ctx);
+
+  TensorList ins, outs;
+  node.collectTensors(ins, outs);
+  // 5 hyperparameters, then P, G, M and V of both parameters.
+  REQUIRE(ins.size() == 13);
+  REQUIRE(outs.size() == 6);
+
+  auto replacement = makeTensor("g0_cast", {4, 8});
+  node.replaceInput(node.optimizerAttr.getGrads()[0], replacement);
+  REQUIRE(node.optimizerAttr.getGrads()[0] == replacement);
+}
@@ -0,0 +1,66 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("PoolingAttr default constructor", "[pooling_attr]") {
+  PoolingAttr attr;
+  REQUIRE(attr.inputs.empty());
+  REQUIRE(attr.outputs.empty());
+  REQUIRE(attr.getMode() == PoolingAttr::Mode::NOT_SET);
+  REQUIRE(attr.getWindow().empty());
+  REQUIRE(attr.getPadding().empty());
+  REQUIRE(attr.getStride().empty());
+  REQUIRE(attr.getDilation().empty());
+  REQUIRE(attr.getCountIncludePad() == true);
+}
+
+TEST_CASE("PoolingAttr setters and getters", "[pooling_attr]") {
+  PoolingAttr attr;
+  std::vector<int64_t> window = {3, 3};
+  std::vector<int64_t> padding = {1, 1};
+  std::vector<int64_t> stride = {2, 2};
+  std::vector<int64_t> dilation = {1, 2};
+
+  attr.setMode(PoolingAttr::Mode::MAX)
+      .setWindow(window)
+      .setPadding(padding)
+      .setStride(stride)
+      .setDilation(std::span<const int64_t>(dilation))
+      .setCountIncludePad(false);
+
+  REQUIRE(attr.getMode() == PoolingAttr::Mode::MAX);
+  REQUIRE(attr.getWindow() == window);
+  REQUIRE(attr.getPadding() == padding);
+  REQUIRE(attr.getStride() == stride);
+  REQUIRE(attr.getDilation() == dilation);
+  REQUIRE(attr.getCountIncludePad() == false);
+
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto y = std::make_shared<TensorAttr>(2.0f);
+
+  attr.setX(x).setY(y).setName("pooling_test");
+
+  REQUIRE(attr.inputs.size() == 1);
+  REQUIRE(attr.outputs.size() == 1);
+  REQUIRE(attr.getName() == "pooling_test");
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getY() == y);
+}
+
+TEST_CASE("PoolingAttr mode names", "[pooling_attr]") {
+  REQUIRE(PoolingAttr::kModeToStr.at(PoolingAttr::Mode::NOT_SET) == "NOT_SET");
+  REQUIRE(PoolingAttr::kModeToStr.at(PoolingAttr::Mode::MAX) == "MAX");
+  REQUIRE(PoolingAttr::kModeToStr.at(PoolingAttr::Mode::AVG) == "AVG");
+}
@@ -0,0 +1,273 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+// Helper to create a contiguous tensor.
+static std::shared_ptr<TensorAttr> makeTensor(const std::string &name,
+                                              const std::vector<int64_t> &dim) {
+  auto stride =
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+  return std::make_shared<TensorAttr>(
+      TensorAttr().setName(name).setDim(dim).setStride(stride));
+}
+
+// Helper to create a 3x3 / stride 2 / padding 1 pooling attribute.
+static PoolingAttr makeAttr(PoolingAttr::Mode mode) {
+  PoolingAttr attr;
+  attr.setMode(mode).setWindow({3, 3}).setStride({2, 2}).setPadding({1, 1});
+  return attr;
+}
+
+TEST_CASE("PoolingNode getName correctly propagates the attribute name",
+          "[pooling_node]") {
+  Context ctx;
+  PoolingAttr attr;
+  attr.setName("foo_pooling");
+
+  PoolingNode node(std::move(attr), ctx);
+  REQUIRE(node.getName() == "foo_pooling");
+}
+
+TEST_CASE("PoolingNode getType returns correct type", "[pooling_node]") {
+  Context ctx;
+  PoolingAttr attr;
+  attr.setName("test_pooling");
+
+  PoolingNode node(std::move(attr), ctx);
+  REQUIRE(node.getType() == INode::Type::Pooling);
+}
+
+TEST_CASE("PoolingNode preValidateNode detects missing attributes",
+          "[pooling_node]") {
+  Context ctx;
+
+  SECTION("Mode missing") {
+    PoolingAttr attr;
+    PoolingNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Pooling mode not set");
+  }
+
+  SECTION("Window missing") {
+    PoolingAttr attr;
+    attr.setMode(PoolingAttr::Mode::MAX);
+    PoolingNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Pooling window not set");
+  }
+
+  SECTION("Input X missing") {
+    PoolingNode node(makeAttr(PoolingAttr::Mode::MAX), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Pooling input tensor X not set");
+  }
+
+  SECTION("Output Y missing") {
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+    attr.setX(makeTensor("X", {2, 8, 16, 16}));
+    PoolingNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Pooling output tensor Y not set");
+  }
+}
+
+TEST_CASE("PoolingNode preValidateNode window checks", "[pooling_node]") {
+  Context ctx;
+
+  SECTION("Rank out of range") {
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+    attr.setX(makeTensor("X", {2, 8})).setY(std::make_shared<TensorAttr>());
+    PoolingNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Pooling input tensor X must have a rank of 3, 4 or 5");
+  }
+
+  SECTION("Window size mismatch") {
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+    attr.setX(makeTensor("X", {2, 8, 16, 16, 16}))
+        .setY(std::make_shared<TensorAttr>());
+    PoolingNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Pooling window size does not match "
+                                   "number of spatial dimensions");
+  }
+
+  SECTION("Padding larger than half the window") {
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+    attr.setPadding({2, 1})
+        .setX(makeTensor("X", {2, 8, 16, 16}))
+        .setY(std::make_shared<TensorAttr>());
+    PoolingNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Pooling padding must be non-negative and at most half of the "
+            "(dilated) window size");
+  }
+
+  SECTION("Window larger than input") {
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+    attr.setPadding({0, 0})
+        .setX(makeTensor("X", {2, 8, 2, 16}))
+        .setY(std::make_shared<TensorAttr>());
+    PoolingNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Pooling window does not fit the padded spatial dimensions of "
+            "input tensor X");
+  }
+
+  SECTION("AVG with dilation") {
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::AVG);
+    attr.setDilation({2, 2})
+        .setX(makeTensor("X", {2, 8, 16, 16}))
+        .setY(std::make_shared<TensorAttr>());
+    PoolingNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+    REQUIRE(status.getMessage() == "Pooling AVG does not support dilation");
+  }
+
+  SECTION("MAX with dilation accepted") {
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+    attr.setDilation({2, 2})
+        .setX(makeTensor("X", {2, 8, 16, 16}))
+        .setY(std::make_shared<TensorAttr>());
+    PoolingNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+}
+
+TEST_CASE("PoolingNode inferPropertiesNode infers output shape and layout",
+          "[pooling_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto y = std::make_shared<TensorAttr>();
+  PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+  std::vector<int64_t> expectedStride;
+
+  SECTION("NCHW input") {
+    attr.setX(makeTensor("X", {2, 8, 16, 15}));
+    expectedStride = {512, 64, 8, 1};
+  }
+
+  SECTION("NHWC input") {
+    std::vector<int64_t> xDim = {2, 8, 16, 15};
+    attr.setX(std::make_shared<TensorAttr>(
+        TensorAttr().setName("X").setDim(xDim).setStride(
+            generateStrideFromDim(xDim, getChannelsLastStrideOrder(4)))));
+    expectedStride = {512, 1, 64, 8};
+  }
+
+  attr.setY(y);
+  PoolingNode node(std::move(attr), ctx);
+
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  // 1 + (16 + 2 - 3) / 2 = 8 and 1 + (15 + 2 - 3) / 2 = 8.
+  REQUIRE(y->getDim() == std::vector<int64_t>{2, 8, 8, 8});
+  REQUIRE(y->getStride() == expectedStride);
+  REQUIRE(y->getDataType() == DataType::Float);
+  REQUIRE(node.getDilation() == std::vector<int64_t>{1, 1});
+}
+
+TEST_CASE("PoolingNode postValidateNode checks output", "[pooling_node]") {
+  Context ctx;
+  auto x = makeTensor("X", {2, 8, 16, 16});
+  x->setDataType(DataType::Float);
+
+  SECTION("Output dims mismatch") {
+    auto y = makeTensor("Y", {2, 8, 16, 16});
+    y->setDataType(DataType::Float);
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+    attr.setX(x).setY(y);
+    PoolingNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Pooling output tensor Y dimensions do not match the expected "
+            "shapes inferred based on the input dimensions");
+  }
+
+  SECTION("Output data type mismatch") {
+    auto y = makeTensor("Y", {2, 8, 8, 8});
+    y->setDataType(DataType::Half);
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::MAX);
+    attr.setX(x).setY(y);
+    PoolingNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Pooling output tensor Y must have the "
+                                   "data type of input tensor X");
+  }
+
+  SECTION("AVG on integers") {
+    x->setDataType(DataType::Int32);
+    auto y = makeTensor("Y", {2, 8, 8, 8});
+    y->setDataType(DataType::Int32);
+    PoolingAttr attr = makeAttr(PoolingAttr::Mode::AVG);
+    attr.setX(x).setY(y);
+    PoolingNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Pooling AVG is not supported for integral or boolean tensors");
+  }
+}
@@ -57,3 +57,26 @@ TEST_CASE("ReductionAttr setters and getters", "[reduction_attr]") {
   REQUIRE(attr.getX()->isVirtual() == false);
   REQUIRE(attr.getY()->isVirtual() == false);
 }
+
+TEST_CASE("ReductionAttr multi-output modes", "[reduction_attr]") {
+  REQUIRE(ReductionAttr::isMultiOutputMode(ReductionAttr::Mode::MIN_MAX));
+  REQUIRE(ReductionAttr::isMultiOutputMode(ReductionAttr::Mode::SUM_SUMSQ));
+  REQUIRE(ReductionAttr::isMultiOutputMode(ReductionAttr::Mode::MEAN_VAR));
+  REQUIRE_FALSE(ReductionAttr::isMultiOutputMode(ReductionAttr::Mode::SUM));
+  REQUIRE(ReductionAttr::isMultiOutputMode(ReductionAttr::Mode::TOPK));
+  REQUIRE(ReductionAttr::isIndexMode(ReductionAttr::Mode::ARGMAX));
+  REQUIRE(ReductionAttr::isIndexMode(ReductionAttr::Mode::ARGMIN));
+  REQUIRE(ReductionAttr::isIndexMode(ReductionAttr::Mode::TOPK));
+  REQUIRE_FALSE(ReductionAttr::isIndexMode(ReductionAttr::Mode::MAX));
+  REQUIRE(ReductionAttr::kModeToStr.at(ReductionAttr::Mode::MEAN_VAR) ==
+          "MEAN_VAR");
+
+  ReductionAttr attr;
+  auto y = std::make_shared<TensorAttr>(1.0f);
+  auto y2 = std::make_shared<TensorAttr>(2.0f);
+  attr.setY(y).setY2(y2);
+
+  REQUIRE(attr.outputs.size() == 2);
+  REQUIRE(attr.getY() == y);
+  REQUIRE(attr.getY2() == y2);
+}
@@ -214,3 +214,198 @@ TEST_CASE("ReductionNode with MAX mode full tensor reduction",
   FUSILLI_REQUIRE_OK(node.preValidateNode());
   FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
 }
+
+TEST_CASE("ReductionNode multi-output modes require Y2 output",
+          "[reduction_node]") {
+  Context ctx;
+  ReductionAttr attr;
+
+  auto x = std::make_shared<TensorAttr>();
+  x->setDim({2, 3}).setStride({3, 1}).setDataType(DataType::Float);
+  auto y = std::make_shared<TensorAttr>();
+  y->setDim({2, 1}).setStride({1, 1}).setDataType(DataType::Float);
+
+  SECTION("Y2 missing") {
+    attr.setMode(ReductionAttr::Mode::MEAN_VAR).setX(x).setY(y);
+    ReductionNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "Reduction mode MEAN_VAR requires Y2 output");
+  }
+
+  SECTION("Y2 on a single-output mode") {
+    attr.setMode(ReductionAttr::Mode::SUM)
+        .setX(x)
+        .setY(y)
+        .setY2(std::make_shared<TensorAttr>());
+    ReductionNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Reduction mode SUM does not support Y2 output");
+  }
+}
+
+TEST_CASE("ReductionNode multi-output mode infers Y2 from Y",
+          "[reduction_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float);
+  ReductionAttr attr;
+  attr.setMode(ReductionAttr::Mode::MIN_MAX);
+
+  auto x = std::make_shared<TensorAttr>();
+  x->setDim({4, 8, 16}).setStride({128, 16, 1});
+  auto y = std::make_shared<TensorAttr>();
+  // Reduce over the first and last dims.
+  y->setDim({1, 8, 1});
+  auto y2 = std::make_shared<TensorAttr>();
+
+  attr.setX(x).setY(y).setY2(y2);
+
+  ReductionNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  REQUIRE(node.getReductionDims() == std::vector<int64_t>{0, 2});
+  REQUIRE(y2->getDim() == std::vector<int64_t>{1, 8, 1});
+  REQUIRE(y2->getStride() == std::vector<int64_t>{8, 1, 1});
+}
+
+TEST_CASE("ReductionNode rejects MEAN_VAR on integral tensors",
+          "[reduction_node]") {
+  Context ctx;
+  ReductionAttr attr;
+  attr.setMode(ReductionAttr::Mode::MEAN_VAR);
+
+  auto x = std::make_shared<TensorAttr>();
+  x->setDim({2, 3}).setStride({3, 1}).setDataType(DataType::Int32);
+  auto y = std::make_shared<TensorAttr>();
+  y->setDim({2, 1}).setStride({1, 1}).setDataType(DataType::Float);
+  auto y2 = std::make_shared<TensorAttr>();
+  y2->setDataType(DataType::Float);
+
+  attr.setX(x).setY(y).setY2(y2);
+
+  ReductionNode node(std::move(attr), ctx);
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+
+  auto status = node.postValidateNode();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  REQUIRE(status.getMessage() ==
+          "Reduction MEAN_VAR is not supported for integral or boolean "
+          "tensors");
+}
+
+TEST_CASE("ReductionNode ARGMAX infers Int64 indices", "[reduction_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half);
+  ReductionAttr attr;
+  attr.setMode(ReductionAttr::Mode::ARGMAX);
+
+  auto x = std::make_shared<TensorAttr>();
+  x->setDim({4, 1000}).setStride({1000, 1});
+  auto y = std::make_shared<TensorAttr>();
+  y->setDim({4, 1});
+
+  attr.setX(x).setY(y);
+
+  SECTION("Over a single dimension") {
+    ReductionNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.getReductionDims() == std::vector<int64_t>{1});
+    REQUIRE(x->getDataType() == DataType::Half);
+    REQUIRE(y->getDataType() == DataType::Int64);
+  }
+
+  SECTION("Over more than one dimension") {
+    y->setDim({1, 1});
+    ReductionNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Reduction mode ARGMAX reduces exactly one dimension");
+  }
+
+  SECTION("Into non-index data type") {
+    y->setDataType(DataType::Float);
+    ReductionNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Reduction mode ARGMAX requires Y of data type Int64");
+  }
+}
+
+TEST_CASE("ReductionNode TOPK infers values and indices",
+          "[reduction_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float);
+  ReductionAttr attr;
+  attr.setMode(ReductionAttr::Mode::TOPK);
+
+  auto x = std::make_shared<TensorAttr>();
+  x->setDim({4, 1000}).setStride({1000, 1}).setDataType(DataType::BFloat16);
+  auto y = std::make_shared<TensorAttr>();
+  y->setDim({4, 8});
+  auto y2 = std::make_shared<TensorAttr>();
+
+  attr.setX(x).setY(y).setY2(y2);
+
+  SECTION("k along the reduced dimension") {
+    ReductionNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.getReductionDims() == std::vector<int64_t>{1});
+    REQUIRE(y->getDataType() == DataType::BFloat16);
+    REQUIRE(y2->getDim() == std::vector<int64_t>{4, 8});
+    REQUIRE(y2->getStride() == std::vector<int64_t>{8, 1});
+    REQUIRE(y2->getDataType() == DataType::Int64);
+  }
+
+  SECTION("k larger than the input dimension") {
+    y->setDim({4, 1001});
+    ReductionNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Reduction TOPK output dimension 1 must "
+                                   "be between 1 and the input dimension");
+  }
+
+  SECTION("Values in another data type") {
+    y->setDataType(DataType::Float);
+    ReductionNode node(std::move(attr), ctx);
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Reduction TOPK values Y must have the data type of X");
+  }
+}
@@ -0,0 +1,116 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+
+using namespace fusilli;
+
+static std::string kGraphName = "test_remote_kernel_cache";
+
+// Creates a local kernel cache entry with an output and a lock file in `dir`.
+static void writeLocalEntry(const std::filesystem::path &dir) {
+  FUSILLI_REQUIRE_OK(CacheFile::publish(dir / "output.vmfb", "vmfb"));
+  FUSILLI_REQUIRE_OK(CacheFile::publish(dir / "input.mlir", "mlir"));
+  FUSILLI_REQUIRE_OK(CacheFile::publish(dir / ".lock", ""));
+}
+
+static std::string readFile(const std::filesystem::path &path) {
+  ErrorOr<CacheFile> file = CacheFile::open(path);
+  REQUIRE(isOk(file));
+  ErrorOr<std::string> contents = file->read();
+  REQUIRE(isOk(contents));
+  return *contents;
+}
+
+TEST_CASE("DirectoryRemoteKernelCache round trip", "[RemoteKernelCache]") {
+  std::filesystem::path root =
+      CacheFile::getPath(kGraphName, "a").parent_path() / "directory";
+  auto cleanup = ScopeExit([&] { std::filesystem::remove_all(root); });
+  writeLocalEntry(root / "local");
+
+  DirectoryRemoteKernelCache remote(root / "remote");
+  FUSILLI_REQUIRE_OK(remote.store("abc", root / "local"));
+  REQUIRE(readFile(root / "remote" / "abc" / "output.vmfb") == "vmfb");
+  // Lock files are not shared.
+  REQUIRE(!std::filesystem::exists(root / "remote" / "abc" / ".lock"));
+  // Storing an existing entry is a no-op.
+  FUSILLI_REQUIRE_OK(remote.store("abc", root / "local"));
+
+  std::filesystem::create_directories(root / "fetched");
+  FUSILLI_REQUIRE_ASSIGN(bool fetched, remote.fetch("abc", root / "fetched"));
+  REQUIRE(fetched);
+  REQUIRE(readFile(root / "fetched" / "output.vmfb") == "vmfb");
+  REQUIRE(readFile(root / "fetched" / "input.mlir") == "mlir");
+
+  FUSILLI_REQUIRE_ASSIGN(fetched, remote.fetch("missing", root / "fetched"));
+  REQUIRE(!fetched);
+}
+
+#if !defined(FUSILLI_PLATFORM_WINDOWS)
+TEST_CASE("CommandRemoteKernelCache round trip", "[RemoteKernelCache]") {
+  std::filesystem::path root =
+      CacheFile::getPath(kGraphName, "a").parent_path() / "command";
+  auto cleanup = ScopeExit([&] { std::filesystem::remove_all(root); });
+  writeLocalEntry(root / "local");
+  std::filesystem::create_directories(root / "remote");
+
+  std::string remoteDir = escapeArgument((root / "remote").string());
+  CommandRemoteKernelCache remote(
+      /*fetchCommand=*/"cp " + remoteDir + "/{key}/* {dir}/",
+      /*storeCommand=*/"cp -r {dir} " + remoteDir + "/{key}");
+  FUSILLI_REQUIRE_OK(remote.store("abc", root / "local"));
+  REQUIRE(readFile(root / "remote" / "abc" / "output.vmfb") == "vmfb");
+
+  std::filesystem::create_directories(root / "fetched");
+  FUSILLI_REQUIRE_ASSIGN(bool fetched, remote.fetch("abc", root / "fetched"));
+  REQUIRE(fetched);
+  REQUIRE(readFile(root / "fetched" / "output.vmfb") == "vmfb");
+
+  // A failing fetch command is a miss.
+  FUSILLI_REQUIRE_ASSIGN(fetched, remote.fetch("missing", root / "fetched"));
+  REQUIRE(!fetched);
+}
+
+TEST_CASE("CommandRemoteKernelCache quotes expanded arguments",
+          "[RemoteKernelCache]") {
+  std::filesystem::path root =
+      CacheFile::getPath(kGraphName, "a").parent_path() / "quoting";
+  auto cleanup = ScopeExit([&] { std::filesystem::remove_all(root); });
+  std::filesystem::path dir = root / "dir with 'quotes' $(x)";
+  std::filesystem::create_directories(dir);
+
+  // Shell syntax in the key and directory is passed through literally.
+  std::string key = "k; touch " + (root / "injected").string() + "\n";
+  CommandRemoteKernelCache remote(
+      /*fetchCommand=*/"printf '%s' {key} > {dir}/key.txt",
+      /*storeCommand=*/"");
+  FUSILLI_REQUIRE_ASSIGN(bool fetched, remote.fetch(key, dir));
+  REQUIRE(fetched);
+  REQUIRE(readFile(dir / "key.txt") == key);
+  REQUIRE(!std::filesystem::exists(root / "injected"));
+}
+#endif
+
+TEST_CASE("getRemoteKernelCache can be overridden", "[RemoteKernelCache]") {
+  std::shared_ptr<RemoteKernelCache> prev = getRemoteKernelCache();
+  auto cleanup = ScopeExit([&] { setRemoteKernelCache(prev); });
+  setRemoteKernelCache(
+      std::make_shared<DirectoryRemoteKernelCache>("/tmp/fusilli_remote"));
+  std::shared_ptr<RemoteKernelCache> remote = getRemoteKernelCache();
+  REQUIRE(dynamic_cast<DirectoryRemoteKernelCache *>(remote.get()) != nullptr);
+  setRemoteKernelCache(nullptr);
+  REQUIRE(getRemoteKernelCache() == nullptr);
+  // References taken before the override stay valid.
+  REQUIRE(dynamic_cast<DirectoryRemoteKernelCache *>(remote.get()) != nullptr);
+}
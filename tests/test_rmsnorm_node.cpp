@@ -11,6 +11,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -418,3 +419,65 @@ TEST_CASE("RmsNormNode postValidateNode detects incorrect shapes and strides",
     REQUIRE(status.getCode() == ErrorCode::NotImplemented);
   }
 }
+
+TEST_CASE("RmsNormBwdNode validation and gradient inference",
+          "[rmsnorm_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  int64_t n = 2, c = 3, d = 4;
+  auto tensor = [](const std::string &name, const std::vector<int64_t> &dim) {
+    return std::make_shared<TensorAttr>(
+        TensorAttr().setName(name).setDim(dim).setStride(
+            generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()))));
+  };
+
+  RmsnormBwdAttr attr;
+  attr.setName("rmsnorm_bwd");
+  attr.setDY(tensor("DY", {n, c, d}));
+  attr.setX(tensor("X", {n, c, d}));
+  attr.setINV_RMS(std::make_shared<TensorAttr>());
+  attr.setDX(std::make_shared<TensorAttr>());
+
+  SECTION("Gradients take the shapes of X and SCALE") {
+    attr.setSCALE(tensor("SCALE", {1, c, d}));
+    attr.setDSCALE(std::make_shared<TensorAttr>());
+    RmsNormBwdNode node(std::move(attr), ctx);
+    REQUIRE(node.getType() == INode::Type::RmsNormBwd);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    const RmsnormBwdAttr &bwdAttr = node.rmsnormBwdAttr;
+    REQUIRE(bwdAttr.getDX()->getDim() == std::vector<int64_t>{n, c, d});
+    REQUIRE(bwdAttr.getDSCALE()->getDim() == std::vector<int64_t>{1, c, d});
+    REQUIRE(bwdAttr.getINV_RMS()->getDim() == std::vector<int64_t>{n, 1, 1});
+    REQUIRE(bwdAttr.getINV_RMS()->getStride() ==
+            std::vector<int64_t>{1, 1, 1});
+  }
+
+  SECTION("INV_RMS missing") {
+    attr.setINV_RMS(nullptr);
+    RmsNormBwdNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "RmsNorm backward input tensor INV_RMS not set");
+  }
+
+  SECTION("SCALE must have the shape of X with single batch") {
+    attr.setSCALE(tensor("SCALE", {n, c, d}));
+    attr.setDSCALE(std::make_shared<TensorAttr>());
+    RmsNormBwdNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "RmsNorm backward input tensor SCALE must have shape as tensor X "
+            "with single batch");
+  }
+}
@@ -22,6 +22,9 @@ TEST_CASE("SdpaAttr default constructor", "[sdpa_attr]") {
   REQUIRE(attr.getIsCausal() == false);
   REQUIRE(attr.getScale() == std::nullopt);
   REQUIRE(attr.getEnableGqa() == false);
+  REQUIRE(attr.getBlockSize() == 0);
+  REQUIRE(attr.isPaged() == false);
+  REQUIRE(attr.isVarlen() == false);
 }
 
 TEST_CASE("SdpaAttr scalar setters and getters", "[sdpa_attr]") {
@@ -89,3 +92,74 @@ TEST_CASE("SdpaAttr scale can be reset to nullopt", "[sdpa_attr]") {
   attr.setScale(std::nullopt);
   REQUIRE(!attr.getScale().has_value());
 }
+
+TEST_CASE("SdpaAttr paged KV cache", "[sdpa_attr]") {
+  SdpaAttr attr;
+
+  auto pageTable = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({4, 8}).setName("PAGE_TABLE"));
+
+  attr.setPAGE_TABLE(pageTable).setBlockSize(16);
+
+  REQUIRE(attr.inputs.size() == 1);
+  REQUIRE(attr.isPaged() == true);
+  REQUIRE(attr.getPAGE_TABLE() == pageTable);
+  REQUIRE(attr.getBlockSize() == 16);
+}
+
+TEST_CASE("SdpaAttr varlen cumulative sequence lengths", "[sdpa_attr]") {
+  SdpaAttr attr;
+
+  auto cuQ = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({5}).setName("CU_SEQLENS_Q"));
+  auto cuKV = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({5}).setName("CU_SEQLENS_KV"));
+
+  attr.setCU_SEQLENS_Q(cuQ);
+  REQUIRE(attr.isVarlen() == true);
+
+  attr.setCU_SEQLENS_KV(cuKV);
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getCU_SEQLENS_Q() == cuQ);
+  REQUIRE(attr.getCU_SEQLENS_KV() == cuKV);
+  REQUIRE(attr.isPaged() == false);
+}
+
+TEST_CASE("SdpaAttr stats output", "[sdpa_attr]") {
+  SdpaAttr attr;
+  REQUIRE(attr.hasStats() == false);
+
+  auto stats = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({1, 8, 64, 1}).setName("STATS"));
+  attr.setSTATS(stats);
+
+  REQUIRE(attr.outputs.size() == 1);
+  REQUIRE(attr.hasStats() == true);
+  REQUIRE(attr.getSTATS() == stats);
+}
+
+TEST_CASE("SdpaBwdAttr setters and getters", "[sdpa_attr]") {
+  SdpaBwdAttr attr;
+
+  REQUIRE(attr.getIsCausal() == false);
+  REQUIRE(attr.getScale() == std::nullopt);
+
+  auto q = std::make_shared<TensorAttr>(1.0f);
+  auto dO = std::make_shared<TensorAttr>(2.0f);
+  auto stats = std::make_shared<TensorAttr>(3.0f);
+  auto dq = std::make_shared<TensorAttr>(4.0f);
+
+  attr.setQ(q).setDO(dO).setSTATS(stats).setDQ(dq);
+  attr.setIsCausal(true).setScale(0.125f);
+
+  REQUIRE(attr.inputs.size() == 3);
+  REQUIRE(attr.outputs.size() == 1);
+  REQUIRE(attr.getQ() == q);
+  REQUIRE(attr.getDO() == dO);
+  REQUIRE(attr.getSTATS() == stats);
+  REQUIRE(attr.getDQ() == dq);
+  REQUIRE(attr.getK() == nullptr);
+  REQUIRE(attr.getDK() == nullptr);
+  REQUIRE(attr.getIsCausal() == true);
+  REQUIRE(attr.getScale() == 0.125f);
+}
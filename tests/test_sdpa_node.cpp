@@ -513,3 +513,432 @@ TEST_CASE("SdpaNode causal flag passes validation", "[sdpa_node]") {
   FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
   FUSILLI_REQUIRE_OK(node.postValidateNode());
 }
+
+TEST_CASE("SdpaNode paged KV cache validation", "[sdpa_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  // Decode: one query token per sequence, K/V pools of 32 pages of 16 rows.
+  SdpaAttr attr;
+  attr.setQ(makeTensor4D("Q", 4, 8, 1, 64));
+  attr.setK(makeTensor4D("K", 32, 8, 16, 64));
+  attr.setV(makeTensor4D("V", 32, 8, 16, 64));
+  attr.setO(std::make_shared<TensorAttr>());
+
+  auto pageTable = std::make_shared<TensorAttr>(TensorAttr()
+                                                    .setName("PAGE_TABLE")
+                                                    .setDim({4, 8})
+                                                    .setStride({8, 1}));
+
+  SECTION("Valid paged configuration") {
+    pageTable->setDataType(DataType::Int32);
+    attr.setPAGE_TABLE(pageTable).setBlockSize(16);
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.getSeqKV() == 8 * 16);
+    REQUIRE(node.getGatheredKvDim(node.sdpaAttr.getK()) ==
+            std::vector<int64_t>{4, 8, 128, 64});
+    REQUIRE(node.sdpaAttr.getO()->getDim() ==
+            std::vector<int64_t>{4, 8, 1, 64});
+  }
+
+  SECTION("Page table without block size") {
+    attr.setPAGE_TABLE(pageTable);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA paged attention requires a positive block size");
+  }
+
+  SECTION("Block size without page table") {
+    attr.setBlockSize(16);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "SDPA block size is set but page table tensor PAGE_TABLE is not");
+  }
+
+  SECTION("Pool rows must equal block size") {
+    attr.setPAGE_TABLE(pageTable).setBlockSize(32);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA paged K and V dim 2 must equal the block size (32)");
+  }
+
+  SECTION("Page table batch must match Q") {
+    pageTable->setDim({2, 8}).setStride({8, 1});
+    attr.setPAGE_TABLE(pageTable).setBlockSize(16);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA page table PAGE_TABLE batch dim must match Q batch");
+  }
+
+  SECTION("Page table must be integer typed") {
+    attr.setPAGE_TABLE(pageTable).setBlockSize(16);
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA page table PAGE_TABLE must have an integer data type");
+  }
+}
+
+TEST_CASE("SdpaNode varlen validation", "[sdpa_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  // 16 packed tokens split across three sequences.
+  auto makePacked = [](const std::string &name, int64_t total, int64_t heads,
+                       int64_t headDim) {
+    std::vector<int64_t> dim = {total, heads, headDim};
+    auto stride =
+        generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+    return std::make_shared<TensorAttr>(
+        TensorAttr().setName(name).setDim(dim).setStride(stride));
+  };
+  auto makeCuSeqlens = [](const std::string &name, int64_t size) {
+    return std::make_shared<TensorAttr>(TensorAttr()
+                                            .setName(name)
+                                            .setDim({size})
+                                            .setStride({1})
+                                            .setDataType(DataType::Int32));
+  };
+
+  SdpaAttr attr;
+  attr.setQ(makePacked("Q", 16, 8, 64));
+  attr.setK(makePacked("K", 16, 8, 64));
+  attr.setV(makePacked("V", 16, 8, 64));
+  attr.setO(std::make_shared<TensorAttr>());
+
+  SECTION("Valid varlen configuration") {
+    attr.setCU_SEQLENS_Q(makeCuSeqlens("CU_Q", 4))
+        .setCU_SEQLENS_KV(makeCuSeqlens("CU_KV", 4))
+        .setIsCausal(true);
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.sdpaAttr.getO()->getDim() ==
+            std::vector<int64_t>{16, 8, 64});
+    REQUIRE(node.getVarlenBatchedDim(node.sdpaAttr.getQ()) ==
+            std::vector<int64_t>{1, 8, 16, 64});
+  }
+
+  SECTION("Missing CU_SEQLENS_KV") {
+    attr.setCU_SEQLENS_Q(makeCuSeqlens("CU_Q", 4));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "SDPA varlen mode requires both CU_SEQLENS_Q and CU_SEQLENS_KV");
+  }
+
+  SECTION("Mismatched batch in cumulative lengths") {
+    attr.setCU_SEQLENS_Q(makeCuSeqlens("CU_Q", 4))
+        .setCU_SEQLENS_KV(makeCuSeqlens("CU_KV", 3));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA CU_SEQLENS_Q and CU_SEQLENS_KV must both be rank 1 of the "
+            "same size [batch + 1]");
+  }
+
+  SECTION("Packed inputs must be rank 3") {
+    attr.setQ(makeTensor4D("Q", 1, 8, 16, 64))
+        .setCU_SEQLENS_Q(makeCuSeqlens("CU_Q", 4))
+        .setCU_SEQLENS_KV(makeCuSeqlens("CU_KV", 4));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "SDPA varlen input tensor Q must be rank 3 "
+                                   "[total_q, heads_q, head_dim]");
+  }
+
+  SECTION("Explicit mask is rejected") {
+    attr.setMASK(makeTensor4D("MASK", 1, 1, 16, 16))
+        .setCU_SEQLENS_Q(makeCuSeqlens("CU_Q", 4))
+        .setCU_SEQLENS_KV(makeCuSeqlens("CU_KV", 4));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA varlen mode does not take an explicit attention mask");
+  }
+}
+
+TEST_CASE("SdpaNode stats output", "[sdpa_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  SdpaAttr attr;
+  attr.setQ(makeTensor4D("Q", 2, 8, 64, 32));
+  attr.setK(makeTensor4D("K", 2, 8, 128, 32));
+  attr.setV(makeTensor4D("V", 2, 8, 128, 32));
+  attr.setO(std::make_shared<TensorAttr>());
+  attr.setSTATS(std::make_shared<TensorAttr>());
+
+  SECTION("STATS shape and data type are inferred") {
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    auto stats = node.sdpaAttr.getSTATS();
+    REQUIRE(stats->getDim() == std::vector<int64_t>{2, 8, 64, 1});
+    REQUIRE(stats->getStride() == std::vector<int64_t>{512, 64, 1, 1});
+    REQUIRE(stats->getDataType() == DataType::Float);
+    REQUIRE(node.sdpaAttr.getO()->getDataType() == DataType::Half);
+  }
+
+  SECTION("GQA is rejected") {
+    attr.setK(makeTensor4D("K", 2, 2, 128, 32))
+        .setV(makeTensor4D("V", 2, 2, 128, 32))
+        .setEnableGqa(true);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+  }
+}
+
+TEST_CASE("SdpaNode runtime dropout seed and offset", "[sdpa_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  SdpaAttr attr;
+  attr.setQ(makeTensor4D("Q", 2, 8, 64, 32));
+  attr.setK(makeTensor4D("K", 2, 8, 128, 32));
+  attr.setV(makeTensor4D("V", 2, 8, 128, 32));
+  attr.setO(std::make_shared<TensorAttr>());
+  attr.setDropout(0.1f);
+  attr.setDROPOUT_SEED(std::make_shared<TensorAttr>());
+  attr.setDROPOUT_OFFSET(std::make_shared<TensorAttr>());
+
+  SECTION("Seed and offset are inferred as [1] int64 tensors") {
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.sdpaAttr.hasDropoutRng());
+    for (const auto &rng : {node.sdpaAttr.getDROPOUT_SEED(),
+                            node.sdpaAttr.getDROPOUT_OFFSET()}) {
+      REQUIRE(rng->getDim() == std::vector<int64_t>{1});
+      REQUIRE(rng->getDataType() == DataType::Int64);
+    }
+  }
+
+  SECTION("Both seed and offset are required") {
+    attr.setDROPOUT_OFFSET(nullptr);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+  }
+
+  SECTION("A dropout probability is required") {
+    attr.setDropout(0.0f);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  SECTION("GQA is rejected") {
+    attr.setK(makeTensor4D("K", 2, 2, 128, 32))
+        .setV(makeTensor4D("V", 2, 2, 128, 32))
+        .setEnableGqa(true);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+  }
+
+  SECTION("Seed must be a single int64") {
+    attr.setDROPOUT_SEED(std::make_shared<TensorAttr>(
+        TensorAttr().setDim({2}).setStride({1}).setDataType(DataType::Int64)));
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+}
+
+TEST_CASE("SdpaNode rotary embedding", "[sdpa_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  auto makeTable = [](const std::string &name, int64_t seq, int64_t d) {
+    return std::make_shared<TensorAttr>(
+        TensorAttr().setName(name).setDim({seq, d}).setStride({d, 1}));
+  };
+
+  SdpaAttr attr;
+  attr.setQ(makeTensor4D("Q", 2, 8, 64, 32));
+  attr.setK(makeTensor4D("K", 2, 8, 64, 32));
+  attr.setV(makeTensor4D("V", 2, 8, 64, 32));
+  attr.setO(std::make_shared<TensorAttr>());
+  attr.setROPE_COS(makeTable("COS", 64, 32));
+  attr.setROPE_SIN(makeTable("SIN", 64, 32));
+
+  SECTION("Tables take the IO data type") {
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.sdpaAttr.hasRope());
+    REQUIRE(node.sdpaAttr.getROPE_COS()->getDataType() == DataType::Half);
+    REQUIRE(node.sdpaAttr.getROPE_SIN()->getDataType() == DataType::Half);
+  }
+
+  SECTION("Both tables are required") {
+    attr.setROPE_SIN(nullptr);
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+  }
+
+  SECTION("Tables must be [seq, head_dim]") {
+    attr.setROPE_COS(makeTable("COS", 64, 16));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  SECTION("Q and K must share positions") {
+    attr.setK(makeTensor4D("K", 2, 8, 128, 32))
+        .setV(makeTensor4D("V", 2, 8, 128, 32));
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  SECTION("STATS is rejected") {
+    attr.setSTATS(std::make_shared<TensorAttr>());
+    SdpaNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::NotImplemented);
+  }
+
+  SECTION("Tables must have the data type of Q") {
+    attr.getROPE_COS()->setDataType(DataType::Float);
+    SdpaNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+}
+
+TEST_CASE("SdpaBwdNode validation and gradient inference", "[sdpa_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half).setComputeDataType(DataType::Float);
+
+  SdpaBwdAttr attr;
+  attr.setName("sdpa_bwd");
+  attr.setQ(makeTensor4D("Q", 1, 4, 16, 64));
+  attr.setK(makeTensor4D("K", 1, 4, 32, 64));
+  attr.setV(makeTensor4D("V", 1, 4, 32, 64));
+  attr.setO(makeTensor4D("O", 1, 4, 16, 64));
+  attr.setDO(makeTensor4D("DO", 1, 4, 16, 64));
+  attr.setSTATS(makeTensor4D("STATS", 1, 4, 16, 1));
+  attr.setDQ(std::make_shared<TensorAttr>());
+  attr.setDK(std::make_shared<TensorAttr>());
+  attr.setDV(std::make_shared<TensorAttr>());
+
+  SECTION("Gradients take the shapes of Q, K, V") {
+    SdpaBwdNode node(std::move(attr), ctx);
+    REQUIRE(node.getType() == INode::Type::SdpaBwd);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    REQUIRE(node.sdpaBwdAttr.getDQ()->getDim() ==
+            std::vector<int64_t>{1, 4, 16, 64});
+    REQUIRE(node.sdpaBwdAttr.getDK()->getDim() ==
+            std::vector<int64_t>{1, 4, 32, 64});
+    REQUIRE(node.sdpaBwdAttr.getDV()->getDim() ==
+            std::vector<int64_t>{1, 4, 32, 64});
+    REQUIRE(node.sdpaBwdAttr.getDQ()->getDataType() == DataType::Half);
+    REQUIRE(node.sdpaBwdAttr.getSTATS()->getDataType() == DataType::Float);
+  }
+
+  SECTION("DO must match O") {
+    attr.setDO(makeTensor4D("DO", 1, 4, 32, 64));
+    SdpaBwdNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "SDPA backward tensors O and DO must have "
+                                   "shape [batch, heads, seqQ, headDimV]");
+  }
+
+  SECTION("STATS must be Float") {
+    attr.getSTATS()->setDataType(DataType::Half);
+    SdpaBwdNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "SDPA backward stats tensor STATS must have data type Float");
+  }
+}
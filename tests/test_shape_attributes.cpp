@@ -0,0 +1,113 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("ReshapeAttr setters and getters", "[shape_attr]") {
+  ReshapeAttr attr;
+  REQUIRE(attr.getShape().empty());
+
+  std::vector<int64_t> shape = {2, -1};
+  auto x = std::make_shared<TensorAttr>(1.0f);
+  auto y = std::make_shared<TensorAttr>(2.0f);
+  attr.setShape(std::span<const int64_t>(shape)).setX(x).setY(y).setName("r");
+
+  REQUIRE(attr.getShape() == shape);
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getY() == y);
+  REQUIRE(attr.getName() == "r");
+}
+
+TEST_CASE("PermuteAttr setters and getters", "[shape_attr]") {
+  PermuteAttr attr;
+  REQUIRE(attr.getOrder().empty());
+
+  std::vector<int64_t> order = {0, 2, 1};
+  attr.setOrder(order);
+  REQUIRE(attr.getOrder() == order);
+}
+
+TEST_CASE("SliceAttr setters and getters", "[shape_attr]") {
+  SliceAttr attr;
+  REQUIRE(attr.getStart().empty());
+  REQUIRE(attr.getEnd().empty());
+  REQUIRE(attr.getStep().empty());
+
+  std::vector<int64_t> start = {0, 1};
+  std::vector<int64_t> end = {2, 5};
+  std::vector<int64_t> step = {1, 2};
+  attr.setStart(start).setEnd(end).setStep(std::span<const int64_t>(step));
+
+  REQUIRE(attr.getStart() == start);
+  REQUIRE(attr.getEnd() == end);
+  REQUIRE(attr.getStep() == step);
+}
+
+TEST_CASE("ConcatAttr keeps inputs in order", "[shape_attr]") {
+  ConcatAttr attr;
+  REQUIRE(attr.getX().empty());
+  REQUIRE(attr.getAxis() == 0);
+
+  auto a = std::make_shared<TensorAttr>(1.0f);
+  auto b = std::make_shared<TensorAttr>(2.0f);
+  attr.setX({a, b, a}).setAxis(-1);
+
+  REQUIRE(attr.inputs.size() == 3);
+  REQUIRE(attr.getX() == std::vector<std::shared_ptr<TensorAttr>>{a, b, a});
+  REQUIRE(attr.getAxis() == -1);
+
+  // Setting the inputs again replaces them.
+  attr.setX({b});
+  REQUIRE(attr.getX() == std::vector<std::shared_ptr<TensorAttr>>{b});
+}
+
+TEST_CASE("SliceUpdateAttr setters and getters", "[shape_attr]") {
+  SliceUpdateAttr attr;
+  REQUIRE(attr.getAxis() == 0);
+  REQUIRE(attr.getSTART() == nullptr);
+
+  auto x = std::make_shared<TensorAttr>();
+  auto update = std::make_shared<TensorAttr>();
+  auto start = std::make_shared<TensorAttr>();
+  attr.setX(x).setUPDATE(update).setSTART(start).setAxis(-2);
+
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getUPDATE() == update);
+  REQUIRE(attr.getSTART() == start);
+  REQUIRE(attr.getAxis() == -2);
+}
+
+TEST_CASE("IndexSelectAttr and IndexAddAttr setters and getters",
+          "[shape_attr]") {
+  auto x = std::make_shared<TensorAttr>();
+  auto index = std::make_shared<TensorAttr>();
+  auto source = std::make_shared<TensorAttr>();
+
+  IndexSelectAttr selectAttr;
+  REQUIRE(selectAttr.getAxis() == 0);
+  selectAttr.setX(x).setINDEX(index).setAxis(-1);
+  REQUIRE(selectAttr.getX() == x);
+  REQUIRE(selectAttr.getINDEX() == index);
+  REQUIRE(selectAttr.getAxis() == -1);
+
+  IndexAddAttr addAttr;
+  REQUIRE(addAttr.getAxis() == 0);
+  REQUIRE(addAttr.getSize() == 0);
+  REQUIRE(addAttr.getX() == nullptr);
+  addAttr.setINDEX(index).setSOURCE(source).setAxis(1).setSize(32);
+  REQUIRE(addAttr.getINDEX() == index);
+  REQUIRE(addAttr.getSOURCE() == source);
+  REQUIRE(addAttr.getAxis() == 1);
+  REQUIRE(addAttr.getSize() == 32);
+}
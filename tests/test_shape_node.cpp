@@ -0,0 +1,441 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+// Helper to create a contiguous tensor.
+static std::shared_ptr<TensorAttr> makeTensor(const std::string &name,
+                                              const std::vector<int64_t> &dim) {
+  auto stride =
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+  return std::make_shared<TensorAttr>(
+      TensorAttr().setName(name).setDim(dim).setStride(stride));
+}
+
+TEST_CASE("Shape nodes getType return correct types", "[shape_node]") {
+  Context ctx;
+  REQUIRE(ReshapeNode(ReshapeAttr(), ctx).getType() == INode::Type::Reshape);
+  REQUIRE(PermuteNode(PermuteAttr(), ctx).getType() == INode::Type::Permute);
+  REQUIRE(SliceNode(SliceAttr(), ctx).getType() == INode::Type::Slice);
+  REQUIRE(ConcatNode(ConcatAttr(), ctx).getType() == INode::Type::Concat);
+  REQUIRE(SliceUpdateNode(SliceUpdateAttr(), ctx).getType() ==
+          INode::Type::SliceUpdate);
+  REQUIRE(IndexSelectNode(IndexSelectAttr(), ctx).getType() ==
+          INode::Type::IndexSelect);
+  REQUIRE(IndexAddNode(IndexAddAttr(), ctx).getType() ==
+          INode::Type::IndexAdd);
+}
+
+TEST_CASE("ReshapeNode infers a -1 entry of the shape", "[shape_node]") {
+  Context ctx;
+  ReshapeAttr attr;
+  attr.setShape({4, -1})
+      .setX(makeTensor("X", {2, 3, 4}))
+      .setY(std::make_shared<TensorAttr>());
+  ReshapeNode node(std::move(attr), ctx);
+
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  auto yT = node.reshapeAttr.getY();
+  REQUIRE(yT->getDim() == std::vector<int64_t>{4, 6});
+  REQUIRE(yT->getStride() == std::vector<int64_t>{6, 1});
+}
+
+TEST_CASE("ReshapeNode preValidateNode checks the shape", "[shape_node]") {
+  Context ctx;
+
+  SECTION("Shape and Y dims missing") {
+    ReshapeAttr attr;
+    attr.setX(makeTensor("X", {2, 3})).setY(std::make_shared<TensorAttr>());
+    ReshapeNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() ==
+            "Reshape shape not set and output tensor Y dimensions not set");
+  }
+
+  SECTION("Two -1 entries") {
+    ReshapeAttr attr;
+    attr.setShape({-1, -1})
+        .setX(makeTensor("X", {2, 3}))
+        .setY(std::make_shared<TensorAttr>());
+    ReshapeNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Reshape shape can have at most one -1 entry");
+  }
+
+  SECTION("Element count mismatch") {
+    ReshapeAttr attr;
+    attr.setShape({4, -1})
+        .setX(makeTensor("X", {2, 3}))
+        .setY(std::make_shared<TensorAttr>());
+    ReshapeNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Reshape shape is incompatible with the "
+                                   "number of elements of input tensor X");
+  }
+}
+
+TEST_CASE("PermuteNode infers permuted dims", "[shape_node]") {
+  Context ctx;
+
+  SECTION("Valid order") {
+    PermuteAttr attr;
+    attr.setOrder({0, 2, 3, 1})
+        .setX(makeTensor("X", {2, 8, 4, 6}))
+        .setY(std::make_shared<TensorAttr>());
+    PermuteNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.permuteAttr.getY()->getDim() ==
+            std::vector<int64_t>{2, 4, 6, 8});
+  }
+
+  SECTION("Order is not a permutation") {
+    PermuteAttr attr;
+    attr.setOrder({0, 1, 1})
+        .setX(makeTensor("X", {2, 8, 4}))
+        .setY(std::make_shared<TensorAttr>());
+    PermuteNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Permute order must be a permutation of "
+                                   "the dimensions of input tensor X");
+  }
+}
+
+TEST_CASE("SliceNode infers sliced dims", "[shape_node]") {
+  Context ctx;
+
+  SECTION("Strided slice") {
+    SliceAttr attr;
+    attr.setStart({0, 1, 0})
+        .setEnd({2, 7, 5})
+        .setStep({1, 1, 2})
+        .setX(makeTensor("X", {2, 8, 5}))
+        .setY(std::make_shared<TensorAttr>());
+    SliceNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.sliceAttr.getY()->getDim() == std::vector<int64_t>{2, 6, 3});
+  }
+
+  SECTION("End out of bounds") {
+    SliceAttr attr;
+    attr.setStart({0, 0})
+        .setEnd({2, 9})
+        .setX(makeTensor("X", {2, 8}))
+        .setY(std::make_shared<TensorAttr>());
+    SliceNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Slice of dim 1 must satisfy 0 <= start < end <= 8 and step > 0");
+  }
+
+  SECTION("Rank mismatch") {
+    SliceAttr attr;
+    attr.setStart({0})
+        .setEnd({2})
+        .setX(makeTensor("X", {2, 8}))
+        .setY(std::make_shared<TensorAttr>());
+    SliceNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Slice start, end and step sizes must "
+                                   "match the rank of input tensor X");
+  }
+}
+
+TEST_CASE("ConcatNode infers concatenated dims", "[shape_node]") {
+  Context ctx;
+
+  SECTION("Negative axis") {
+    auto a = makeTensor("A", {2, 3});
+    ConcatAttr attr;
+    attr.setX({a, makeTensor("B", {2, 5}), a})
+        .setAxis(-1)
+        .setY(std::make_shared<TensorAttr>());
+    ConcatNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.concatAttr.getY()->getDim() == std::vector<int64_t>{2, 11});
+  }
+
+  SECTION("Inputs missing") {
+    ConcatAttr attr;
+    attr.setY(std::make_shared<TensorAttr>());
+    ConcatNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Concat input tensors X not set");
+  }
+
+  SECTION("Axis out of range") {
+    ConcatAttr attr;
+    attr.setX({makeTensor("A", {2, 3})})
+        .setAxis(2)
+        .setY(std::make_shared<TensorAttr>());
+    ConcatNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Concat axis 2 is out of range for input tensors of rank 2");
+  }
+
+  SECTION("Mismatched dims outside of the axis") {
+    ConcatAttr attr;
+    attr.setX({makeTensor("A", {2, 3}), makeTensor("B", {4, 3})})
+        .setAxis(1)
+        .setY(std::make_shared<TensorAttr>());
+    ConcatNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Concat input tensor 1 dimensions do not "
+                                   "match input tensor 0 outside of the axis");
+  }
+}
+
+TEST_CASE("SliceUpdateNode infers Y and the START offset", "[shape_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half);
+
+  SliceUpdateAttr attr;
+  attr.setX(makeTensor("X", {1, 2, 16, 8}))
+      .setUPDATE(makeTensor("UPDATE", {1, 2, 3, 8}))
+      .setSTART(std::make_shared<TensorAttr>())
+      .setAxis(-2)
+      .setY(std::make_shared<TensorAttr>());
+
+  SECTION("Y takes the layout of X") {
+    attr.getX()->setStride({256, 8, 16, 1});
+    SliceUpdateNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.getNormalizedAxis() == 2);
+
+    auto yT = node.sliceUpdateAttr.getY();
+    REQUIRE(yT->getDim() == std::vector<int64_t>{1, 2, 16, 8});
+    REQUIRE(yT->getStride() == std::vector<int64_t>{256, 8, 16, 1});
+    REQUIRE(yT->getDataType() == DataType::Half);
+
+    auto startT = node.sliceUpdateAttr.getSTART();
+    REQUIRE(startT->getDim() == std::vector<int64_t>{1});
+    REQUIRE(startT->getDataType() == DataType::Int64);
+  }
+
+  SECTION("START missing") {
+    attr.setSTART(nullptr);
+    SliceUpdateNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Slice update input tensor START not set");
+  }
+
+  SECTION("UPDATE does not fit in X") {
+    attr.setUPDATE(makeTensor("UPDATE", {1, 2, 32, 8}));
+    SliceUpdateNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  SECTION("UPDATE mismatches X outside of the axis") {
+    attr.setUPDATE(makeTensor("UPDATE", {1, 4, 3, 8}));
+    SliceUpdateNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  SECTION("START must be a single int64") {
+    attr.setSTART(std::make_shared<TensorAttr>(
+        TensorAttr().setDim({1}).setStride({1}).setDataType(DataType::Int32)));
+    SliceUpdateNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+}
+
+TEST_CASE("IndexSelectNode gathers along the axis by an index of any rank",
+          "[shape_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Half);
+
+  IndexSelectAttr attr;
+  attr.setX(makeTensor("X", {32, 16}))
+      .setINDEX(std::make_shared<TensorAttr>(
+          TensorAttr().setDim({2, 5}).setStride({5, 1})))
+      .setY(std::make_shared<TensorAttr>());
+
+  SECTION("Embedding lookup") {
+    IndexSelectNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+    auto yT = node.indexSelectAttr.getY();
+    REQUIRE(yT->getDim() == std::vector<int64_t>{2, 5, 16});
+    REQUIRE(yT->getStride() == std::vector<int64_t>{80, 16, 1});
+    REQUIRE(yT->getDataType() == DataType::Half);
+    REQUIRE(node.indexSelectAttr.getINDEX()->getDataType() ==
+            DataType::Int64);
+  }
+
+  SECTION("Negative axis") {
+    attr.setAxis(-1);
+    IndexSelectNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    REQUIRE(node.getNormalizedAxis() == 1);
+    REQUIRE(node.indexSelectAttr.getY()->getDim() ==
+            std::vector<int64_t>{32, 2, 5});
+  }
+
+  SECTION("Axis out of range") {
+    attr.setAxis(2);
+    IndexSelectNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Index select axis 2 is out of range for "
+                                   "input tensor X of rank 2");
+  }
+
+  SECTION("INDEX must be an integer tensor") {
+    attr.getINDEX()->setDataType(DataType::Float);
+    IndexSelectNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    auto status = node.postValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Index select tensor INDEX must have an integer data type");
+  }
+}
+
+TEST_CASE("IndexAddNode accumulates into X or into zeros", "[shape_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::BFloat16);
+
+  IndexAddAttr attr;
+  attr.setINDEX(std::make_shared<TensorAttr>(
+          TensorAttr().setDim({2, 5}).setStride({5, 1})))
+      .setSOURCE(makeTensor("SOURCE", {2, 5, 16}))
+      .setY(std::make_shared<TensorAttr>());
+
+  SECTION("Into zeros of the given size") {
+    attr.setSize(32);
+    IndexAddNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.getRank() == 2);
+
+    auto yT = node.indexAddAttr.getY();
+    REQUIRE(yT->getDim() == std::vector<int64_t>{32, 16});
+    REQUIRE(yT->getStride() == std::vector<int64_t>{16, 1});
+    REQUIRE(yT->getDataType() == DataType::BFloat16);
+  }
+
+  SECTION("Into X") {
+    attr.setX(makeTensor("X", {32, 16}));
+    IndexAddNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+    FUSILLI_REQUIRE_OK(node.postValidateNode());
+    REQUIRE(node.indexAddAttr.getY()->getDim() ==
+            std::vector<int64_t>{32, 16});
+  }
+
+  SECTION("Neither X nor a size") {
+    IndexAddNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Index add requires input tensor X or a "
+                                   "positive size along the axis");
+  }
+
+  SECTION("Both X and a size") {
+    attr.setX(makeTensor("X", {32, 16})).setSize(32);
+    IndexAddNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  SECTION("SOURCE mismatches X outside of the axis") {
+    attr.setX(makeTensor("X", {32, 8}));
+    IndexAddNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Index add tensor SOURCE dimensions must be those of Y with the "
+            "axis replaced by the dimensions of INDEX");
+  }
+}
@@ -0,0 +1,72 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+
+using namespace fusilli;
+
+TEST_CASE("SingleFlight shares the leader's result with waiters",
+          "[single_flight]") {
+  SingleFlight<std::string> flights;
+  SingleFlight<std::string>::Ticket leader = flights.join("key");
+  REQUIRE(leader.isLeader());
+
+  // Other keys get flights of their own.
+  SingleFlight<std::string>::Ticket other = flights.join("other");
+  REQUIRE(other.isLeader());
+
+  SingleFlight<std::string>::Ticket follower = flights.join("key");
+  REQUIRE(!follower.isLeader());
+  std::future<std::shared_ptr<const std::string>> shared = std::async(
+      std::launch::async, [&follower] { return follower.wait(); });
+
+  int calls = 0;
+  leader.finish([&] {
+    ++calls;
+    return std::string("result");
+  });
+  REQUIRE(calls == 1);
+  std::shared_ptr<const std::string> result = shared.get();
+  REQUIRE(result);
+  REQUIRE(*result == "result");
+
+  // The finished flight is gone, the next caller leads a new one.
+  REQUIRE(flights.join("key").isLeader());
+}
+
+TEST_CASE("SingleFlight only produces the result for waiters",
+          "[single_flight]") {
+  SingleFlight<std::string> flights;
+  SingleFlight<std::string>::Ticket leader = flights.join("key");
+  REQUIRE(leader.isLeader());
+  bool called = false;
+  leader.finish([&] {
+    called = true;
+    return std::string("result");
+  });
+  REQUIRE(!called);
+}
+
+TEST_CASE("SingleFlight waiters get no result when the leader gives up",
+          "[single_flight]") {
+  SingleFlight<std::string> flights;
+  std::optional<SingleFlight<std::string>::Ticket> leader;
+  leader.emplace(flights.join("key"));
+  REQUIRE(leader->isLeader());
+
+  SingleFlight<std::string>::Ticket follower = flights.join("key");
+  REQUIRE(!follower.isLeader());
+  leader.reset();
+  REQUIRE(follower.wait() == nullptr);
+  REQUIRE(flights.join("key").isLeader());
+}
@@ -0,0 +1,57 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <optional>
+
+using namespace fusilli;
+
+TEST_CASE("SoftmaxAttr default constructor", "[softmax_attr]") {
+  SoftmaxAttr attr;
+  REQUIRE(attr.inputs.empty());
+  REQUIRE(attr.outputs.empty());
+  REQUIRE(attr.getAxis() == -1);
+  REQUIRE(attr.getLogSoftmax() == false);
+  REQUIRE(attr.getScale() == std::nullopt);
+}
+
+TEST_CASE("SoftmaxAttr scalar setters and getters", "[softmax_attr]") {
+  SoftmaxAttr attr;
+
+  attr.setAxis(1).setLogSoftmax(true).setScale(0.125f);
+
+  REQUIRE(attr.getAxis() == 1);
+  REQUIRE(attr.getLogSoftmax() == true);
+  REQUIRE(attr.getScale().has_value());
+  REQUIRE(*attr.getScale() == 0.125f);
+}
+
+TEST_CASE("SoftmaxAttr tensor setters and getters", "[softmax_attr]") {
+  SoftmaxAttr attr;
+
+  auto x = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({2, 8, 64}).setName("X"));
+  auto mask = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({1, 1, 64}).setName("MASK"));
+  auto y = std::make_shared<TensorAttr>(
+      TensorAttr().setDim({2, 8, 64}).setName("Y"));
+
+  attr.setX(x).setY(y).setName("softmax_test");
+
+  REQUIRE(attr.inputs.size() == 1);
+  REQUIRE(attr.outputs.size() == 1);
+  REQUIRE(attr.getName() == "softmax_test");
+  REQUIRE(attr.getX() == x);
+  REQUIRE(attr.getY() == y);
+  REQUIRE(attr.getMASK() == nullptr);
+
+  attr.setMASK(mask);
+  REQUIRE(attr.inputs.size() == 2);
+  REQUIRE(attr.getMASK() == mask);
+}
@@ -0,0 +1,181 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace fusilli;
+
+// Helper to create a contiguous tensor.
+static std::shared_ptr<TensorAttr> makeTensor(const std::string &name,
+                                              const std::vector<int64_t> &dim) {
+  auto stride =
+      generateStrideFromDim(dim, getContiguousStrideOrder(dim.size()));
+  return std::make_shared<TensorAttr>(
+      TensorAttr().setName(name).setDim(dim).setStride(stride));
+}
+
+TEST_CASE("SoftmaxNode getName correctly propagates the attribute name",
+          "[softmax_node]") {
+  Context ctx;
+  SoftmaxAttr attr;
+  attr.setName("foo_softmax");
+
+  SoftmaxNode node(std::move(attr), ctx);
+  REQUIRE(node.getName() == "foo_softmax");
+}
+
+TEST_CASE("SoftmaxNode getType returns correct type", "[softmax_node]") {
+  Context ctx;
+  SoftmaxAttr attr;
+  attr.setName("test_softmax");
+
+  SoftmaxNode node(std::move(attr), ctx);
+  REQUIRE(node.getType() == INode::Type::Softmax);
+}
+
+TEST_CASE("SoftmaxNode preValidateNode detects missing attributes",
+          "[softmax_node]") {
+  Context ctx;
+
+  SECTION("Input X missing") {
+    SoftmaxAttr attr;
+    SoftmaxNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Softmax input tensor X not set");
+  }
+
+  SECTION("Output Y missing") {
+    SoftmaxAttr attr;
+    attr.setX(makeTensor("X", {2, 8}));
+    SoftmaxNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::AttributeNotSet);
+    REQUIRE(status.getMessage() == "Softmax output tensor Y not set");
+  }
+}
+
+TEST_CASE("SoftmaxNode preValidateNode axis and mask checks",
+          "[softmax_node]") {
+  Context ctx;
+
+  SECTION("Axis out of range") {
+    SoftmaxAttr attr;
+    attr.setX(makeTensor("X", {2, 8}))
+        .setY(std::make_shared<TensorAttr>())
+        .setAxis(2);
+    SoftmaxNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Softmax axis 2 is out of range for input tensor X of rank 2");
+  }
+
+  SECTION("Negative axis in range") {
+    SoftmaxAttr attr;
+    attr.setX(makeTensor("X", {2, 8}))
+        .setY(std::make_shared<TensorAttr>())
+        .setAxis(-2);
+    SoftmaxNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+    REQUIRE(node.getNormalizedAxis() == 0);
+  }
+
+  SECTION("Mask rank mismatch") {
+    SoftmaxAttr attr;
+    attr.setX(makeTensor("X", {2, 8}))
+        .setMASK(makeTensor("MASK", {8}))
+        .setY(std::make_shared<TensorAttr>());
+    SoftmaxNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Softmax mask tensor MASK must have the "
+                                   "same rank as input tensor X");
+  }
+
+  SECTION("Mask not broadcastable") {
+    SoftmaxAttr attr;
+    attr.setX(makeTensor("X", {2, 8}))
+        .setMASK(makeTensor("MASK", {1, 4}))
+        .setY(std::make_shared<TensorAttr>());
+    SoftmaxNode node(std::move(attr), ctx);
+
+    auto status = node.preValidateNode();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Softmax mask tensor MASK dim 1 (4) must "
+                                   "be 1 or match input tensor X (8)");
+  }
+
+  SECTION("Broadcast mask accepted") {
+    SoftmaxAttr attr;
+    attr.setX(makeTensor("X", {2, 8}))
+        .setMASK(makeTensor("MASK", {1, 8}))
+        .setY(std::make_shared<TensorAttr>());
+    SoftmaxNode node(std::move(attr), ctx);
+
+    FUSILLI_REQUIRE_OK(node.preValidateNode());
+  }
+}
+
+TEST_CASE("SoftmaxNode inferPropertiesNode infers output from input",
+          "[softmax_node]") {
+  Context ctx;
+  ctx.setIODataType(DataType::Float).setComputeDataType(DataType::Float);
+
+  auto y = std::make_shared<TensorAttr>();
+  SoftmaxAttr attr;
+  attr.setX(makeTensor("X", {2, 4, 8})).setY(y);
+  SoftmaxNode node(std::move(attr), ctx);
+
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  FUSILLI_REQUIRE_OK(node.postValidateNode());
+
+  REQUIRE(y->getDim() == std::vector<int64_t>{2, 4, 8});
+  REQUIRE(y->getStride() == std::vector<int64_t>{32, 8, 1});
+  REQUIRE(y->getDataType() == DataType::Float);
+}
+
+TEST_CASE("SoftmaxNode postValidateNode rejects non-floating point types",
+          "[softmax_node]") {
+  Context ctx;
+  auto x = makeTensor("X", {2, 8});
+  auto y = makeTensor("Y", {2, 8});
+  x->setDataType(DataType::Float);
+  y->setDataType(DataType::Float);
+
+  SECTION("integer input") { x->setDataType(DataType::Int32); }
+  SECTION("integer output") { y->setDataType(DataType::Int32); }
+
+  SoftmaxAttr attr;
+  attr.setX(x).setY(y);
+  SoftmaxNode node(std::move(attr), ctx);
+
+  FUSILLI_REQUIRE_OK(node.preValidateNode());
+  FUSILLI_REQUIRE_OK(node.inferPropertiesNode());
+  auto status = node.postValidateNode();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+}
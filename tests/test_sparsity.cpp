@@ -0,0 +1,79 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <fusilli.h>
+
+#include "utils.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace fusilli;
+
+TEST_CASE("packSparse24 packs values and positions", "[sparsity]") {
+  // K = 8, N = 2: column 0 keeps positions {1, 3} then {0, 2}, column 1
+  // keeps {2} then nothing.
+  std::vector<float> dense = {
+      0, 0, //
+      1, 0, //
+      0, 5, //
+      2, 0, //
+      3, 0, //
+      0, 0, //
+      4, 0, //
+      0, 0, //
+  };
+  FUSILLI_REQUIRE_ASSIGN(auto packed, packSparse24(dense, 8, 2));
+
+  REQUIRE(packed.values == std::vector<float>{1, 5, 2, 0, 3, 0, 4, 0});
+  REQUIRE(packed.meta == std::vector<int8_t>{1, 2, 3, 3, 0, 2, 2, 3});
+
+  // Expanding the packed weights recovers the dense weights.
+  std::vector<float> expanded(dense.size(), 0.0f);
+  for (size_t i = 0; i < packed.values.size(); ++i) {
+    size_t row = i / 2, col = i % 2;
+    size_t denseRow = row / 2 * 4 + static_cast<size_t>(packed.meta[i]);
+    expanded[denseRow * 2 + col] += packed.values[i];
+  }
+  REQUIRE(expanded == dense);
+}
+
+TEST_CASE("packSparse24 packs batched weights", "[sparsity]") {
+  std::vector<int8_t> dense = {0, 7, 0, 0, /**/ 0, 0, -1, 2};
+  FUSILLI_REQUIRE_ASSIGN(auto packed, packSparse24(dense, 4, 1));
+
+  REQUIRE(packed.values == std::vector<int8_t>{7, 0, -1, 2});
+  REQUIRE(packed.meta == std::vector<int8_t>{1, 3, 2, 3});
+}
+
+TEST_CASE("packSparse24 rejects dense groups and bad shapes", "[sparsity]") {
+  SECTION("Three non-zeros in a group") {
+    std::vector<float> dense = {1, 2, 3, 0};
+    auto result = packSparse24(dense, 4, 1);
+    REQUIRE(isError(result));
+    REQUIRE(ErrorObject(result).getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(ErrorObject(result).getMessage() ==
+            "2:4 sparse weights have more than two non-zeros in group 0 of "
+            "column 0");
+  }
+
+  SECTION("K not divisible by 4") {
+    std::vector<float> dense(6);
+    auto result = packSparse24(dense, 6, 1);
+    REQUIRE(isError(result));
+    REQUIRE(ErrorObject(result).getCode() == ErrorCode::InvalidAttribute);
+  }
+
+  SECTION("Size not a multiple of K * N") {
+    std::vector<float> dense(12);
+    auto result = packSparse24(dense, 8, 1);
+    REQUIRE(isError(result));
+    REQUIRE(ErrorObject(result).getCode() == ErrorCode::InvalidAttribute);
+  }
+}
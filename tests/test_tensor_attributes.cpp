@@ -162,6 +162,159 @@ TEST_CASE("TensorAttr dynamic dimension metadata", "[TensorAttr]") {
   }
 }
 
+TEST_CASE("TensorAttr dynamic dimension hints", "[TensorAttr]") {
+  TensorAttr t;
+  t.setName("tokens")
+      .setDataType(DataType::Half)
+      .setDim({64, 32})
+      .setStride({32, 1})
+      .setDynamicDim(0);
+
+  SECTION("Unhinted dynamic dims are unconstrained") {
+    REQUIRE(t.getDynamicDimHints().empty());
+    REQUIRE(t.getDynamicDimHint(0) == DynamicDimHint{});
+    REQUIRE(t.getDynamicDimHint(0).max == DynamicDimHint::kUnbounded);
+  }
+
+  SECTION("Satisfied hint passes validation") {
+    auto &result =
+        t.setDynamicDimHint(0, {.min = 16, .max = 4096, .divisor = 16});
+
+    REQUIRE(&result == &t);
+    DynamicDimHint hint = t.getDynamicDimHint(0);
+    REQUIRE(hint.min == 16);
+    REQUIRE(hint.max == 4096);
+    REQUIRE(hint.divisor == 16);
+    REQUIRE(hint.isSatisfiedBy(4096));
+    REQUIRE_FALSE(hint.isSatisfiedBy(40));
+    REQUIRE_FALSE(hint.isSatisfiedBy(4112));
+    FUSILLI_REQUIRE_OK(t.validate());
+  }
+
+  SECTION("Hint on a static dim fails validation") {
+    t.setDynamicDimHint(1, {.divisor = 8});
+
+    auto status = t.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'tokens' has a hint for dim 1, which is not dynamic");
+  }
+
+  SECTION("Empty range fails validation") {
+    t.setDynamicDimHint(0, {.min = 128, .max = 64});
+
+    auto status = t.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'tokens' has an invalid hint for dynamic dim 0: it needs "
+            "1 <= min <= max and a positive divisor");
+  }
+
+  SECTION("Representative size not satisfying the hint fails validation") {
+    t.setDynamicDimHint(0, {.divisor = 48});
+
+    auto status = t.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'tokens' has representative size 64 at dynamic dim 0, "
+            "which doesn't satisfy its hint");
+  }
+}
+
+TEST_CASE("TensorAttr buffer alignment", "[TensorAttr]") {
+  TensorAttr t;
+  t.setName("weights")
+      .setDataType(DataType::Float)
+      .setDim({16, 16})
+      .setStride({16, 1});
+  REQUIRE(t.getAlignment() == 0);
+
+  SECTION("Power of two alignment passes validation") {
+    auto &result = t.setAlignment(128);
+    REQUIRE(&result == &t);
+    REQUIRE(t.getAlignment() == 128);
+    FUSILLI_REQUIRE_OK(t.validate());
+  }
+
+  SECTION("Other alignments fail validation") {
+    t.setAlignment(48);
+    auto status = t.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'weights' has alignment 48, which is not a power of two");
+  }
+
+  SECTION("Tensors without buffers fail validation") {
+    t.setAlignment(64).setIsVirtual(true);
+    auto status = t.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() == "Tensor 'weights' declares a buffer "
+                                   "alignment but is not bound to a buffer");
+  }
+}
+
+TEST_CASE("TensorAttr blocked layout", "[TensorAttr]") {
+  // NCHW16c: channels blocked by 16 on a contiguous NCHW tensor.
+  TensorAttr t;
+  t.setName("x")
+      .setDataType(DataType::Float)
+      .setDim({2, 32, 4, 4})
+      .setStride({512, 16, 4, 1});
+  REQUIRE(!t.isBlocked());
+
+  SECTION("Blocked dim moves its block innermost") {
+    auto &result = t.setBlockedLayout({.dim = 1, .blockSize = 16});
+    REQUIRE(&result == &t);
+    REQUIRE(t.isBlocked());
+    REQUIRE(t.getBlockedLayout()->blockSize == 16);
+    FUSILLI_REQUIRE_OK(t.validate());
+    REQUIRE(t.getPhysicalDim() == std::vector<int64_t>{2, 2, 4, 4, 16});
+    REQUIRE(t.getStorageDim() == std::vector<int64_t>{2, 2, 4, 4, 16});
+    REQUIRE(t.getTensorTypeAsm() == "!torch.vtensor<[2,2,4,4,16],f32>");
+    REQUIRE(t.getTensorTypeAsm(/*isValueTensor=*/true,
+                               /*useLogicalDims=*/true) ==
+            "!torch.vtensor<[2,32,4,4],f32>");
+    t.clearBlockedLayout();
+    REQUIRE(t.getPhysicalDim() == std::vector<int64_t>{2, 32, 4, 4});
+  }
+
+  SECTION("Outer dims follow the strides") {
+    // NHWC8c: channels last, then blocked by 8.
+    t.setStride({512, 1, 128, 32}).setBlockedLayout({.dim = 1, .blockSize = 8});
+    FUSILLI_REQUIRE_OK(t.validate());
+    REQUIRE(t.getPhysicalDim() == std::vector<int64_t>{2, 4, 4, 4, 8});
+  }
+
+  SECTION("Block sizes must divide the blocked dim") {
+    t.setBlockedLayout({.dim = 1, .blockSize = 24});
+    auto status = t.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'x' has an invalid blocked layout: the block size must "
+            "be at least 2 and divide the blocked dim");
+    t.setBlockedLayout({.dim = 4, .blockSize = 2});
+    REQUIRE(isError(t.validate()));
+  }
+
+  SECTION("Tensors without buffers fail validation") {
+    t.setBlockedLayout({.dim = 1, .blockSize = 16}).setIsVirtual(true);
+    auto status = t.validate();
+    REQUIRE(isError(status));
+    REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+    REQUIRE(status.getMessage() ==
+            "Tensor 'x' with a blocked layout must be bound to a buffer, "
+            "without dynamic or broadcast dims or padded strides");
+    t.setIsVirtual(false).setDynamicDims({0});
+    REQUIRE(isError(t.validate()));
+  }
+}
+
 TEST_CASE("TensorAttr validation edge cases", "[TensorAttr]") {
   SECTION("Unspecified dim fails validation") {
     TensorAttr t;
@@ -650,8 +803,9 @@ TEST_CASE("TensorAttr hasValidPhysicalRepresentation", "[TensorAttr]") {
   t.setDim({8, 16, 32}).setStride({512, 1, 16});
   REQUIRE(t.hasValidPhysicalRepresentation());
 
-  // Invalid: Gap in stride values
-  t.setDim({2, 3, 4}).setStride({24, 4, 1});
+  // Invalid: Gap in stride values that is not a multiple of the next faster
+  // stride (a gap of a multiple is a padded stride, see below)
+  t.setDim({2, 3, 4}).setStride({26, 4, 1});
   REQUIRE_FALSE(t.hasValidPhysicalRepresentation());
 
   // Valid: unit length dims mixed with valid non-unit dims
@@ -708,6 +862,66 @@ TEST_CASE("TensorAttr hasValidPhysicalRepresentation", "[TensorAttr]") {
   REQUIRE(t.hasValidPhysicalRepresentation());
 }
 
+TEST_CASE("TensorAttr padded strides", "[TensorAttr]") {
+  TensorAttr t;
+
+  // Dense layouts are not padded.
+  t.setDim({2, 3, 4}).setStride({12, 1, 3});
+  REQUIRE_FALSE(t.hasPaddedStrides());
+  REQUIRE(t.getCompactStride() == std::vector<int64_t>{12, 1, 3});
+  REQUIRE(t.getStorageDim() == std::vector<int64_t>{2, 4, 3});
+
+  // Padded rows, e.g. a slice `x[:, :6]` of a [4, 8] tensor.
+  t.setDim({4, 6}).setStride({8, 1});
+  REQUIRE(t.hasValidPhysicalRepresentation());
+  REQUIRE(t.hasPaddedStrides());
+  REQUIRE(t.isContiguous());
+  REQUIRE(t.getCompactStride() == std::vector<int64_t>{6, 1});
+  REQUIRE(t.getPhysicalDim() == std::vector<int64_t>{4, 6});
+  REQUIRE(t.getStorageDim() == std::vector<int64_t>{4, 8});
+
+  // Padding on several dims.
+  t.setDim({2, 3, 4}).setStride({24, 6, 1});
+  REQUIRE(t.hasPaddedStrides());
+  REQUIRE(t.getCompactStride() == std::vector<int64_t>{12, 4, 1});
+  REQUIRE(t.getStorageDim() == std::vector<int64_t>{2, 4, 6});
+
+  // Padded channels-last.
+  t.setDim({2, 3, 4}).setStride({64, 1, 16});
+  REQUIRE(t.hasPaddedStrides());
+  REQUIRE(t.isChannelsLast());
+  REQUIRE(t.getCompactStride() == std::vector<int64_t>{12, 1, 3});
+  REQUIRE(t.getStorageDim() == std::vector<int64_t>{2, 4, 16});
+
+  // Unit dims keep their stride.
+  t.setDim({4, 1, 6}).setStride({8, 1, 1});
+  REQUIRE(t.hasPaddedStrides());
+  REQUIRE(t.getCompactStride() == std::vector<int64_t>{6, 1, 1});
+  REQUIRE(t.getStorageDim() == std::vector<int64_t>{4, 1, 8});
+
+  // The fastest-changing dim can't be padded.
+  t.setDim({4, 6}).setStride({12, 2});
+  REQUIRE_FALSE(t.hasValidPhysicalRepresentation());
+  REQUIRE_FALSE(t.hasPaddedStrides());
+
+  // Padding isn't combined with broadcast dims.
+  t.setDim({2, 4, 6}).setStride({0, 8, 1});
+  REQUIRE_FALSE(t.hasValidPhysicalRepresentation());
+  REQUIRE_FALSE(t.hasPaddedStrides());
+
+  // Padded tensors can't have dynamic dims.
+  TensorAttr padded;
+  padded.setName("padded")
+      .setDataType(DataType::Float)
+      .setDim({4, 6})
+      .setStride({8, 1});
+  FUSILLI_REQUIRE_OK(padded.validate());
+  padded.setDynamicDim(0);
+  ErrorObject status = padded.validate();
+  REQUIRE(isError(status));
+  REQUIRE(status.getCode() == ErrorCode::InvalidAttribute);
+}
+
 TEST_CASE("TensorAttr hasBroadcastDims", "[TensorAttr]") {
   TensorAttr t;
 
@@ -16,6 +16,7 @@
 
 #include <fusilli.h>
 
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_tostring.hpp>
 
@@ -108,6 +109,26 @@ public:
 #define FUSILLI_REQUIRE_ASSIGN(varDecl, expr)                                  \
   FUSILLI_REQUIRE_ASSIGN_IMPL(FUSILLI_ERROR_VAR(_errorOr), varDecl, expr)
 
+// Fail the test if the most recent compilation of `graph` launches more than
+// `maxDispatchCount` dispatches per execution, as read from the scheduling
+// statistics the compiler dumped (see `Graph::getCompileStatistics()`).
+// Samples relying on IREE fusing their nodes use it to catch compiler
+// updates that silently break fusion.
+//
+// Usage:
+//   FUSILLI_REQUIRE_OK(graph.compile(handle));
+//   // Bias and relu fuse into the matmul.
+//   FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(graph, 1);
+#define FUSILLI_REQUIRE_MAX_DISPATCH_COUNT(graph, maxDispatchCount)            \
+  do {                                                                         \
+    FUSILLI_REQUIRE_ASSIGN(fusilli::CompileStatistics stats,                   \
+                           (graph).getCompileStatistics());                    \
+    INFO("Graph '" << (graph).getName() << "' compiled into "                  \
+                   << stats.dispatchCount << " dispatches, expected at most "  \
+                   << (maxDispatchCount));                                     \
+    REQUIRE(stats.dispatchCount <= (maxDispatchCount));                        \
+  } while (false)
+
 // Utility to convert vector of dims from int64_t to size_t (unsigned long)
 // which is compatible with `iree_hal_dim_t` and fixes narrowing conversion
 // warnings.
@@ -129,6 +150,12 @@ constexpr Backend kDefaultBackend = Backend::AMDGPU;
 constexpr Backend kDefaultBackend = Backend::CPU;
 #endif
 
+// Dispatches the compiler adds around each matmul or convolution on
+// `kDefaultBackend`: on CPU, data tiling packs both operands and unpacks the
+// result in dispatches of their own. For `FUSILLI_REQUIRE_MAX_DISPATCH_COUNT`.
+constexpr uint64_t kContractionLayoutDispatchCount =
+    kDefaultBackend == Backend::CPU ? 3 : 0;
+
 // Helper to create a simple MLIR module for testing.
 inline std::string getSimpleMLIRModule() {
   return R"mlir(
@@ -142,7 +169,8 @@ module {
 }
 
 inline ErrorOr<std::shared_ptr<Buffer>>
-allocateBufferOfType(Handle &handle, const std::shared_ptr<TensorAttr> &tensor,
+allocateBufferOfType(const Handle &handle,
+                     const std::shared_ptr<TensorAttr> &tensor,
                      DataType type, double initVal) {
   FUSILLI_RETURN_ERROR_IF(!tensor, ErrorCode::AttributeNotSet,
                           "Tensor is not set");
@@ -211,6 +239,44 @@ allocateBufferOfType(Handle &handle, const std::shared_ptr<TensorAttr> &tensor,
             std::vector<int4>(tensor->getVolume(), int4(int8_t(initVal)))));
     return std::make_shared<Buffer>(std::move(buffer));
   }
+  case DataType::FP8E5M2: {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto buffer,
+        Buffer::allocate(
+            handle, /*bufferShape=*/castToSizeT(tensor->getPhysicalDim()),
+            /*bufferData=*/
+            std::vector<fp8e5m2>(tensor->getVolume(), fp8e5m2(initVal))));
+    return std::make_shared<Buffer>(std::move(buffer));
+  }
+  case DataType::FP8E4M3FN: {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto buffer,
+        Buffer::allocate(
+            handle, /*bufferShape=*/castToSizeT(tensor->getPhysicalDim()),
+            /*bufferData=*/
+            std::vector<fp8e4m3fn>(tensor->getVolume(), fp8e4m3fn(initVal))));
+    return std::make_shared<Buffer>(std::move(buffer));
+  }
+  case DataType::FP8E5M2FNUZ: {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto buffer,
+        Buffer::allocate(
+            handle, /*bufferShape=*/castToSizeT(tensor->getPhysicalDim()),
+            /*bufferData=*/
+            std::vector<fp8e5m2fnuz>(tensor->getVolume(),
+                                     fp8e5m2fnuz(initVal))));
+    return std::make_shared<Buffer>(std::move(buffer));
+  }
+  case DataType::FP8E4M3FNUZ: {
+    FUSILLI_ASSIGN_OR_RETURN(
+        auto buffer,
+        Buffer::allocate(
+            handle, /*bufferShape=*/castToSizeT(tensor->getPhysicalDim()),
+            /*bufferData=*/
+            std::vector<fp8e4m3fnuz>(tensor->getVolume(),
+                                     fp8e4m3fnuz(initVal))));
+    return std::make_shared<Buffer>(std::move(buffer));
+  }
   case DataType::Boolean: {
     FUSILLI_ASSIGN_OR_RETURN(
         auto buffer,
@@ -229,7 +295,8 @@ allocateBufferOfType(Handle &handle, const std::shared_ptr<TensorAttr> &tensor,
 // deduced from the vector, avoiding the need for a DataType switch.
 template <typename T>
 inline ErrorOr<std::shared_ptr<Buffer>>
-allocateBufferOfType(Handle &handle, const std::shared_ptr<TensorAttr> &tensor,
+allocateBufferOfType(const Handle &handle,
+                     const std::shared_ptr<TensorAttr> &tensor,
                      const std::vector<T> &data) {
   FUSILLI_RETURN_ERROR_IF(!tensor, ErrorCode::AttributeNotSet,
                           "Tensor is not set");
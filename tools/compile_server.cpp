@@ -0,0 +1,75 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// Long-lived compile daemon for the CLI compile backend.
+//
+// Usage:
+//   fusilli_compile_server <socket> [parallelism]
+//
+// and point clients at it with FUSILLI_COMPILE_SERVER_SOCKET=<socket>. The
+// server exits on SIGINT or SIGTERM once the requests in flight are done.
+//
+//===----------------------------------------------------------------------===//
+
+#include <fusilli.h>
+
+#include <charconv>
+#include <csignal>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <system_error>
+#include <thread>
+
+#include <pthread.h>
+
+using namespace fusilli;
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0] << " <socket> [parallelism]" << std::endl;
+    return 1;
+  }
+  size_t parallelism = std::thread::hardware_concurrency();
+  if (argc == 3) {
+    const char *end = argv[2] + std::strlen(argv[2]);
+    auto [ptr, errc] = std::from_chars(argv[2], end, parallelism);
+    if (errc != std::errc() || ptr != end || parallelism == 0) {
+      std::cerr << "Invalid parallelism: " << argv[2] << std::endl;
+      return 1;
+    }
+  }
+
+  // Handle termination signals on a dedicated thread, as `stop()` is not
+  // async-signal-safe. Blocked before any other thread starts, so all threads
+  // inherit the mask.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  ErrorOr<CompileServer> server = CompileServer::listen(argv[1]);
+  if (isError(server)) {
+    std::cerr << ErrorObject(server) << std::endl;
+    return 1;
+  }
+  std::thread stopper([&] {
+    int signal = 0;
+    sigwait(&signals, &signal);
+    server->stop();
+  });
+  stopper.detach();
+
+  ErrorObject status = server->serve(parallelism);
+  if (isError(status)) {
+    std::cerr << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,39 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// Prints a binary event log written through FUSILLI_EVENT_LOG (see
+// event_log.h) as text, one event per line, oldest first.
+//
+// Usage:
+//   fusilli_event_log_dump <log>
+//
+//===----------------------------------------------------------------------===//
+
+#include <fusilli.h>
+
+#include <iostream>
+
+using namespace fusilli;
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <log>" << std::endl;
+    return 1;
+  }
+  ErrorOr<EventLogContents> contents = EventLog::read(argv[1]);
+  if (isError(contents)) {
+    std::cerr << ErrorObject(contents) << std::endl;
+    return 1;
+  }
+  if (contents->recorded > contents->events.size())
+    std::cout << "# " << contents->recorded - contents->events.size()
+              << " older events were overwritten" << std::endl;
+  for (const EventRecord &event : contents->events)
+    std::cout << EventLog::format(event) << "\n";
+  return 0;
+}
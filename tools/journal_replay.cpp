@@ -0,0 +1,102 @@
+// Copyright 2026 Advanced Micro Devices, Inc.
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+//===----------------------------------------------------------------------===//
+//
+// Compiles every graph of a usage journal written through
+// FUSILLI_USAGE_JOURNAL (see usage_journal.h), leaving the artifacts in the
+// kernel cache and, with --bundle, writing them to an artifact bundle.
+//
+// Usage:
+//   fusilli_journal_replay <journal> [--bundle <path>] [--backend cpu|amdgpu]
+//                          [--parallelism <n>]
+//
+// Exits with 1 if any graph failed to replay; the others are still compiled
+// and bundled.
+//
+//===----------------------------------------------------------------------===//
+
+#include <fusilli.h>
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace fusilli;
+
+int main(int argc, char **argv) {
+  auto usage = [&]() {
+    std::cerr << "Usage: " << argv[0]
+              << " <journal> [--bundle <path>] [--backend cpu|amdgpu]"
+                 " [--parallelism <n>]"
+              << std::endl;
+    return 1;
+  };
+  if (argc < 2)
+    return usage();
+
+  std::filesystem::path journal = argv[1];
+  std::optional<std::filesystem::path> bundlePath;
+  JournalReplayOptions options;
+  for (int i = 2; i < argc; i += 2) {
+    if (i + 1 >= argc)
+      return usage();
+    std::string flag = argv[i];
+    const char *value = argv[i + 1];
+    if (flag == "--bundle") {
+      bundlePath = value;
+    } else if (flag == "--backend" && std::strcmp(value, "cpu") == 0) {
+      options.backend = Backend::CPU;
+    } else if (flag == "--backend" && std::strcmp(value, "amdgpu") == 0) {
+      options.backend = Backend::AMDGPU;
+    } else if (flag == "--parallelism") {
+      const char *end = value + std::strlen(value);
+      auto [ptr, errc] = std::from_chars(value, end, options.parallelism);
+      if (errc != std::errc() || ptr != end) {
+        std::cerr << "Invalid parallelism: " << value << std::endl;
+        return 1;
+      }
+    } else {
+      return usage();
+    }
+  }
+
+  ErrorOr<std::vector<UsageJournalEntry>> entries = UsageJournal::read(journal);
+  if (isError(entries)) {
+    std::cerr << ErrorObject(entries) << std::endl;
+    return 1;
+  }
+  ArtifactBundleWriter writer;
+  if (bundlePath.has_value())
+    options.bundle = &writer;
+  std::vector<ErrorObject> statuses = replayUsageJournal(*entries, options);
+
+  size_t failed = 0;
+  for (size_t i = 0; i < statuses.size(); ++i) {
+    if (isOk(statuses[i]))
+      continue;
+    std::cerr << (*entries)[i].graphName << ": " << statuses[i] << std::endl;
+    failed++;
+  }
+  std::cout << "Replayed " << statuses.size() - failed << " of "
+            << statuses.size() << " journaled graphs" << std::endl;
+  if (bundlePath.has_value()) {
+    ErrorObject status = writer.write(*bundlePath);
+    if (isError(status)) {
+      std::cerr << status << std::endl;
+      return 1;
+    }
+    std::cout << "Wrote " << writer.size() << " artifacts to " << *bundlePath
+              << std::endl;
+  }
+  return failed == 0 ? 0 : 1;
+}